@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+
+"""Time pygame.mask overlap tests
+
+Runs Mask.overlap, Mask.overlap_area and Mask.overlap_mask of a small
+mask over a large one, at every offset in a range, and prints the time
+for each. Run it before and after a change to the mask code to compare.
+
+    python maskbench.py [repeats]
+"""
+
+import sys, time, random
+import pygame, pygame.mask
+
+
+def random_mask(size, density):
+    mask = pygame.mask.Mask(size)
+    w, h = size
+    for i in range(int(w * h * density)):
+        mask.set_at((random.randrange(w), random.randrange(h)), 1)
+    return mask
+
+
+def SpeedTest(name, function, big, small, repeats):
+    offsets = [(x, y) for y in range(0, 280, 7) for x in range(-50, 480, 3)]
+    start = time.time()
+    for i in range(repeats):
+        for offset in offsets:
+            function(big, small, offset)
+    duration = time.time() - start
+    print ("%-14s %8.3f ms per %d tests" %
+           (name, duration * 1000.0 / repeats, len(offsets)))
+
+
+def main(repeats=10):
+    random.seed(1)
+    big = random_mask((640, 480), 0.3)
+    small = random_mask((160, 200), 0.01)
+    empty = pygame.mask.Mask((160, 200))
+
+    print ("Mask Speed Test - %s over %s\n" % (small.get_size(),
+                                                big.get_size()))
+    SpeedTest("overlap", lambda a, b, o: a.overlap(b, o),
+              big, small, repeats)
+    SpeedTest("overlap (miss)", lambda a, b, o: a.overlap(b, o),
+              big, empty, repeats)
+    SpeedTest("overlap_area", lambda a, b, o: a.overlap_area(b, o),
+              big, small, repeats)
+    SpeedTest("overlap_mask", lambda a, b, o: a.overlap_mask(b, o),
+              big, small, repeats)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        main(int(sys.argv[1]))
+    else:
+        main()
@@ -81,6 +81,7 @@ class MissingModule:
     _NOT_IMPLEMENTED_ = True
 
     def __init__(self, name, info='', urgent=0):
+        import sys
         self.name = name
         self.info = str(info)
         try:
@@ -133,84 +134,147 @@ class MissingModule:
 from pygame.base import *
 from pygame.constants import *
 from pygame.version import *
-from pygame.rect import Rect
+from pygame.rect import Rect, RectArray
 from pygame.compat import geterror, PY_MAJOR_VERSION
-from pygame.rwobject import encode_string, encode_file_path
+from pygame.rwobject import encode_string, encode_file_path, \
+     get_io_buffer_size, set_io_buffer_size
 import pygame.surflock
 import pygame.color
 Color = color.Color
+ColorArray = color.ColorArray
 import pygame.bufferproxy
 BufferProxy = bufferproxy.BufferProxy
 
 __version__ = ver
 
-# next, the "standard" modules
-# we still allow them to be missing for stripped down pygame distributions
-try:
-    import pygame.math
-except (ImportError, IOError):
-    math = MissingModule("math", geterror(), 1)
+class LazyModule(object):
+    """Stands in for a pygame submodule until it is first used
 
-try:
-    import pygame.cdrom
-except (ImportError, IOError):
-    cdrom = MissingModule("cdrom", geterror(), 1)
+    The first attribute access imports the module, or makes a
+    MissingModule for it if it is not available, and puts it in the
+    pygame namespace in place of the LazyModule. References to the
+    LazyModule taken before then keep working.
+    """
 
-try:
-    import pygame.cursors
-except (ImportError, IOError):
-    cursors = MissingModule("cursors", geterror(), 1)
+    def __init__(self, name, loader, urgent):
+        self.__dict__.update(_name=name, _loader=loader, _urgent=urgent,
+                             _module=None)
 
-try:
-    import pygame.display
-except (ImportError, IOError):
-    display = MissingModule("display", geterror(), 1)
+    def _load(self):
+        module = self.__dict__['_module']
+        if module is None:
+            import sys
+            name = self.__dict__['_name']
+            try:
+                module = self.__dict__['_loader'](name)
+            except (ImportError, IOError):
+                from pygame.compat import geterror
+                module = self._missing(name, geterror(),
+                                       self.__dict__['_urgent'])
+            self.__dict__['_module'] = module
+            setattr(sys.modules['pygame'], name, module)
+        return module
 
-try:
-    import pygame.draw
-except (ImportError, IOError):
-    draw = MissingModule("draw", geterror(), 1)
+    def __getattr__(self, var):
+        return getattr(self._load(), var)
 
-try:
-    import pygame.event
-except (ImportError, IOError):
-    event = MissingModule("event", geterror(), 1)
+    def __setattr__(self, var, value):
+        setattr(self._load(), var, value)
 
-try:
-    import pygame.image
-except (ImportError, IOError):
-    image = MissingModule("image", geterror(), 1)
+    def __delattr__(self, var):
+        delattr(self._load(), var)
 
-try:
-    import pygame.joystick
-except (ImportError, IOError):
-    joystick = MissingModule("joystick", geterror(), 1)
+    def __dir__(self):
+        return dir(self._load())
 
-try:
-    import pygame.key
-except (ImportError, IOError):
-    key = MissingModule("key", geterror(), 1)
+    def __nonzero__(self):
+        return bool(self._load())
+    __bool__ = __nonzero__
 
-try:
-    import pygame.mouse
-except (ImportError, IOError):
-    mouse = MissingModule("mouse", geterror(), 1)
+    def __repr__(self):
+        return "<lazy module 'pygame.%s'>" % self.__dict__['_name']
 
-try:
-    import pygame.sprite
-except (ImportError, IOError):
-    sprite = MissingModule("sprite", geterror(), 1)
+LazyModule._missing = MissingModule
 
 
-try:
-    import pygame.threads
-except (ImportError, IOError):
-    threads = MissingModule("threads", geterror(), 1)
+def _import_submodule(name):
+    import sys
+    __import__('pygame.' + name)
+    return sys.modules['pygame.' + name]
 
-try:
-    import pygame.pixelcopy
-except (ImportError, IOError):
-    pixelcopy = MissingModule("pixelcopy", geterror(), 1)
+
+def _import_font(name):
+    import os
+    import sys
+    if 'PYGAME_FREETYPE' in os.environ:
+        try:
+            import pygame.ftfont
+            sys.modules['pygame.font'] = pygame.ftfont
+        except (ImportError, IOError):
+            pass
+    import pygame.font
+    import pygame.sysfont
+    font = sys.modules['pygame.font']
+    font.SysFont = pygame.sysfont.SysFont
+    font.get_fonts = pygame.sysfont.get_fonts
+    font.match_font = pygame.sysfont.match_font
+    return font
+
+
+def _import_mixer(name):
+    # try and load pygame.mixer_music before mixer, for py2app...
+    try:
+        import pygame.mixer_music
+    except (ImportError, IOError):
+        pass
+    import pygame.mixer
+    return pygame.mixer
+
+
+# next, the "standard" modules, then the "optional" ones. Each is imported
+# when it is first used, which keeps "import pygame" quick for programs
+# that only need a few of them. Setting PYGAME_PRELOAD in the environment
+# imports them all now instead. We still allow them to be missing for
+# stripped down pygame distributions.
+_submodules = [('math', _import_submodule, 1),
+               ('cdrom', _import_submodule, 1),
+               ('cursors', _import_submodule, 1),
+               ('display', _import_submodule, 1),
+               ('draw', _import_submodule, 1),
+               ('event', _import_submodule, 1),
+               ('image', _import_submodule, 1),
+               ('joystick', _import_submodule, 1),
+               ('key', _import_submodule, 1),
+               ('mouse', _import_submodule, 1),
+               ('sprite', _import_submodule, 1),
+               ('threads', _import_submodule, 1),
+               ('pixelcopy', _import_submodule, 1),
+               ('time', _import_submodule, 1),
+               ('transform', _import_submodule, 1),
+               ('font', _import_font, 0),
+               ('mixer', _import_mixer, 0),
+               ('movie', _import_submodule, 0),
+               ('scrap', _import_submodule, 0),
+               ('surfarray', _import_submodule, 0),
+               ('sndarray', _import_submodule, 0),
+               ('fastevent', _import_submodule, 0)]
+
+_preload = 'PYGAME_PRELOAD' in os.environ
+_lazy_modules = {}
+for _name, _loader, _urgent in _submodules:
+    _lazy_modules[_name] = LazyModule(_name, _loader, _urgent)
+    if _preload:
+        _lazy_modules[_name]._load()
+    else:
+        globals()[_name] = _lazy_modules[_name]
+
+if not _preload:
+    def init():
+        # the modules pygame.init() starts must be imported first
+        for name in ('cdrom', 'display', 'font', 'joystick', 'mixer'):
+            _lazy_modules[name]._load()
+        return base.init()
+    init.__doc__ = base.init.__doc__
 
 
 def warn_unwanted_files():
@@ -290,81 +354,25 @@ except (ImportError, IOError):
     Overlay = lambda: Missing_Function
 
 try:
-    import pygame.time
+    from pygame.commandbuffer import CommandBuffer
 except (ImportError, IOError):
-    time = MissingModule("time", geterror(), 1)
+    CommandBuffer = lambda: Missing_Function
 
 try:
-    import pygame.transform
+    from pygame.tilemap import TileMap
 except (ImportError, IOError):
-    transform = MissingModule("transform", geterror(), 1)
+    TileMap = lambda: Missing_Function
 
-# lastly, the "optional" pygame modules
-if 'PYGAME_FREETYPE' in os.environ:
+# there's also a couple "internal" modules not needed
+# by users, but putting them here helps "dependency finder"
+# programs get everything they need (like py2exe). They find the
+# submodules imported when first used in packager_imports() below.
+if _preload:
     try:
-        import pygame.ftfont as font
-        sys.modules['pygame.font'] = font
+        import pygame.imageext
+        del pygame.imageext
     except (ImportError, IOError):
         pass
-try:
-    import pygame.font
-    import pygame.sysfont
-    pygame.font.SysFont = pygame.sysfont.SysFont
-    pygame.font.get_fonts = pygame.sysfont.get_fonts
-    pygame.font.match_font = pygame.sysfont.match_font
-except (ImportError, IOError):
-    font = MissingModule("font", geterror(), 0)
-
-# try and load pygame.mixer_music before mixer, for py2app...
-try:
-    import pygame.mixer_music
-    #del pygame.mixer_music
-    #print ("NOTE2: failed importing pygame.mixer_music in lib/__init__.py")
-except (ImportError, IOError):
-    pass
-
-try:
-    import pygame.mixer
-except (ImportError, IOError):
-    mixer = MissingModule("mixer", geterror(), 0)
-
-try:
-    import pygame.movie
-except (ImportError, IOError):
-    movie = MissingModule("movie", geterror(), 0)
-
-# try: import pygame.movieext
-# except (ImportError,IOError):movieext=MissingModule("movieext",
-# geterror(), 0)
-
-try:
-    import pygame.scrap
-except (ImportError, IOError):
-    scrap = MissingModule("scrap", geterror(), 0)
-
-try:
-    import pygame.surfarray
-except (ImportError, IOError):
-    surfarray = MissingModule("surfarray", geterror(), 0)
-
-try:
-    import pygame.sndarray
-except (ImportError, IOError):
-    sndarray = MissingModule("sndarray", geterror(), 0)
-
-try:
-    import pygame.fastevent
-except (ImportError, IOError):
-    fastevent = MissingModule("fastevent", geterror(), 0)
-
-# there's also a couple "internal" modules not needed
-# by users, but putting them here helps "dependency finder"
-# programs get everything they need (like py2exe)
-try:
-    import pygame.imageext
-    del pygame.imageext
-except (ImportError, IOError):
-    pass
 
 
 def packager_imports():
@@ -376,6 +384,33 @@ def packager_imports():
     import pygame.bufferproxy
     import pygame.colordict
     import pygame._view
+    import pygame.imageext
+    # the submodules that are imported when first used
+    import pygame.math
+    import pygame.cdrom
+    import pygame.cursors
+    import pygame.display
+    import pygame.draw
+    import pygame.event
+    import pygame.image
+    import pygame.joystick
+    import pygame.key
+    import pygame.mouse
+    import pygame.sprite
+    import pygame.threads
+    import pygame.pixelcopy
+    import pygame.time
+    import pygame.transform
+    import pygame.font
+    import pygame.sysfont
+    import pygame.ftfont
+    import pygame.mixer_music
+    import pygame.mixer
+    import pygame.movie
+    import pygame.scrap
+    import pygame.surfarray
+    import pygame.sndarray
+    import pygame.fastevent
 
 # make Rects pickleable
 if PY_MAJOR_VERSION >= 3:
@@ -407,3 +442,4 @@ copy_reg.pickle(Color, __color_reduce, __color_constructor)
 
 # cleanup namespace
 del pygame, os, sys, surflock, MissingModule, copy_reg, geterror, PY_MAJOR_VERSION
+del LazyModule, _submodules, _name, _loader, _urgent, _preload
@@ -4,7 +4,7 @@ _is_init = 0
 
 
 def init():
-    global list_cameras, Camera, colorspace, _is_init
+    global list_cameras, Camera, colorspace, capture_set, _is_init
 
 
     import os,sys
@@ -41,6 +41,7 @@ def init():
     #  it will also be the default one.
     from pygame import _camera
     colorspace = _camera.colorspace
+    capture_set = _camera.capture_set
 
     if use__camera:
         list_cameras = _camera.list_cameras
@@ -131,6 +132,33 @@ class Camera:
         """
 
 
+class CameraSet:
+    """A group of started cameras read together, for stereo and multi-view
+    rigs.
+    """
+
+    def __init__(self, cameras):
+        _check_init()
+        self.cameras = list(cameras)
+
+    def start(self):
+        for camera in self.cameras:
+            camera.start()
+
+    def stop(self):
+        for camera in self.cameras:
+            camera.stop()
+
+    def get_frames(self, timeout = 1.0, max_skew = None):
+        """Returns [(surface, timestamp), ...], a frame of each camera, as
+        close together in time as can be.
+        """
+        from pygame import _camera
+        if max_skew is None:
+            max_skew = -1.0
+        return _camera.capture_set(self.cameras, timeout, max_skew)
+
+
 
 if __name__ == "__main__":
 
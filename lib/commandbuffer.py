@@ -0,0 +1,253 @@
+##    pygame - Python Game Library
+##
+##    This library is free software; you can redistribute it and/or
+##    modify it under the terms of the GNU Library General Public
+##    License as published by the Free Software Foundation; either
+##    version 2 of the License, or (at your option) any later version.
+##
+##    This library is distributed in the hope that it will be useful,
+##    but WITHOUT ANY WARRANTY; without even the implied warranty of
+##    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+##    Library General Public License for more details.
+##
+##    You should have received a copy of the GNU Library General Public
+##    License along with this library; if not, write to the Free
+##    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""pygame module for recording drawing to replay later
+
+A CommandBuffer records blits, fills, draw functions and text for one
+Surface, and draws them all when executed. Before the first execute() it
+plans the drawing: operations hidden by later opaque blits and fills are
+dropped, blits of neighbouring areas of one source are joined, and runs
+of blits and draw commands become single Surface.blits() and draw.batch()
+calls, which draw large work on worker threads. The plan is kept, so a
+buffer of unchanging drawing, such as a user interface, costs a few calls
+each frame.
+"""
+
+from pygame.rect import Rect
+from pygame.constants import SRCALPHA
+from pygame import draw
+
+_BLIT, _FILL, _DRAW = range(3)
+
+# the number of opaque rects planning tests each operation against
+_MAX_COVERS = 16
+
+
+class CommandBuffer(object):
+    """recorded drawing onto a Surface
+
+    pygame.CommandBuffer(Surface): return CommandBuffer
+
+    Records operations to draw on the Surface with execute(). The drawing
+    is the same as doing the operations in order, except that nothing is
+    drawn until execute() is called, and the Surfaces blitted are those
+    given, as they are when executed.
+
+    The plan made on the first execute() takes account of the flags,
+    colorkeys and alpha of the Surfaces blitted. Call invalidate() after
+    changing those of a recorded Surface.
+    """
+
+    def __init__(self, surface):
+        self.surface = surface
+        self._ops = []
+        self._plan = None
+
+    def __len__(self):
+        return len(self._ops)
+
+    def blit(self, source, dest, area=None, special_flags=0):
+        """record a blit
+
+        CommandBuffer.blit(source, dest, area=None, special_flags=0): return Rect
+
+        Records Surface.blit(source, dest, area, special_flags), and
+        returns the rect it will draw, before clipping to the Surface.
+        """
+        x, y = dest[0], dest[1]
+        if area is None:
+            area = source.get_rect()
+        else:
+            # as SDL clips it, moving dest with it
+            area = Rect(area)
+            clipped = area.clip(source.get_rect())
+            x += clipped.x - area.x
+            y += clipped.y - area.y
+            area = clipped
+        rect = Rect(x, y, area.w, area.h)
+        self._ops.append((_BLIT, rect, (source, area, special_flags)))
+        self._plan = None
+        return Rect(rect)
+
+    def fill(self, color, rect=None, special_flags=0):
+        """record a fill
+
+        CommandBuffer.fill(color, rect=None, special_flags=0): return None
+
+        Records Surface.fill(color, rect, special_flags).
+        """
+        if rect is not None:
+            rect = Rect(rect)
+        self._ops.append((_FILL, rect, (color, special_flags)))
+        self._plan = None
+
+    def draw(self, name, *args):
+        """record a draw function
+
+        CommandBuffer.draw(name, *args): return None
+
+        Records pygame.draw.<name>(Surface, *args), for any of the functions
+        draw.batch() can run.
+        """
+        self._ops.append((_DRAW, None, (name,) + args))
+        self._plan = None
+
+    def text(self, font, dest, text, color, background=None, antialias=True):
+        """record drawing text
+
+        CommandBuffer.text(font, dest, text, color, background=None, antialias=True): return Rect
+
+        Renders text now with a pygame.font.Font or pygame.freetype.Font,
+        and records a blit of it with its top left at dest. A buffer
+        replayed each frame renders the text once.
+        """
+        if hasattr(font, 'render_to'):
+            image = font.render(text, color, background)[0]
+        elif background is None:
+            image = font.render(text, antialias, color)
+        else:
+            image = font.render(text, antialias, color, background)
+        return self.blit(image, dest)
+
+    def clear(self):
+        """forget the operations recorded
+
+        CommandBuffer.clear(): return None
+        """
+        self._ops = []
+        self._plan = None
+
+    def invalidate(self):
+        """plan the drawing again on the next execute()
+
+        CommandBuffer.invalidate(): return None
+        """
+        self._plan = None
+
+    def execute(self):
+        """do the drawing recorded
+
+        CommandBuffer.execute(): return Rect
+
+        Returns the rect of the Surface drawn on, or a Rect of no size if
+        nothing was drawn.
+        """
+        if self._plan is None:
+            self._plan = self._make_plan()
+        steps, bounds, whole = self._plan
+        surface = self.surface
+        clip = surface.get_clip()
+        for kind, args in steps:
+            if kind == _BLIT:
+                surface.blits(args, 0)
+            elif kind == _FILL:
+                surface.fill(*args)
+            else:
+                drawn = draw.batch(surface, args)
+                if drawn.w and drawn.h:
+                    bounds = drawn.union(bounds) if bounds else drawn
+        if whole:
+            return clip
+        if bounds is None:
+            return Rect(0, 0, 0, 0)
+        return bounds.clip(clip)
+
+    def _make_plan(self):
+        ops = _cull(self._ops)
+        ops = _merge(ops)
+
+        # runs of blits and draw commands become one call each
+        steps = []
+        bounds = None
+        whole = False
+        for kind, rect, args in ops:
+            if kind == _FILL:
+                steps.append((_FILL, (args[0], rect) + args[1:]))
+                if rect is None:
+                    whole = True
+            elif kind == _BLIT:
+                source, area, flags = args
+                if not steps or steps[-1][0] != _BLIT:
+                    steps.append((_BLIT, []))
+                steps[-1][1].append((source, rect.topleft, area, flags))
+            else:
+                if not steps or steps[-1][0] != _DRAW:
+                    steps.append((_DRAW, []))
+                steps[-1][1].append(args)
+            if rect is not None:
+                bounds = rect.union(bounds) if bounds else rect
+        return steps, bounds, whole
+
+
+def _opaque(op):
+    """whether an operation sets every pixel of its rect"""
+    kind, args = op[0], op[2]
+    if kind == _FILL:
+        return not args[1]
+    if kind == _BLIT:
+        source = args[0]
+        return (not args[2] and not source.get_flags() & SRCALPHA and
+                source.get_colorkey() is None and source.get_alpha() is None)
+    return False
+
+
+def _covered(rect, covers):
+    for cover in covers:
+        if cover.contains(rect):
+            return True
+    return False
+
+
+def _cull(ops):
+    """ops less those wholly drawn over by later opaque ones"""
+    kept = []
+    covers = []
+    for op in reversed(ops):
+        kind, rect = op[0], op[1]
+        if kind == _BLIT and not (rect.w and rect.h):
+            continue
+        if rect is not None and _covered(rect, covers):
+            continue
+        kept.append(op)
+        if _opaque(op):
+            if rect is None:
+                # a fill of the whole clip rect hides all before it
+                break
+            if len(covers) < _MAX_COVERS:
+                covers.append(rect)
+    kept.reverse()
+    return kept
+
+
+def _merge(ops):
+    """ops with blits of neighbouring areas of one source joined"""
+    merged = []
+    for op in ops:
+        if op[0] == _BLIT and merged and merged[-1][0] == _BLIT:
+            kind, rect, (source, area, flags) = op
+            last_rect, (last_source, last_area, last_flags) = merged[-1][1:]
+            if (source is last_source and flags == last_flags and
+                rect.x - area.x == last_rect.x - last_area.x and
+                rect.y - area.y == last_rect.y - last_area.y):
+                joined = area.union(last_area)
+                if (joined.w * joined.h ==
+                    area.w * area.h + last_area.w * last_area.h and
+                    not area.colliderect(last_area)):
+                    merged[-1] = (_BLIT, rect.union(last_rect),
+                                  (source, joined, flags))
+                    continue
+        merged.append(op)
+    return merged
@@ -19,9 +19,6 @@ New in pygame 1.9.0.
 #TODO:
 #    - finish writing tests.
 #        - likely as interactive tests... so you'd need to plug in a midi device.
-#    - create a background thread version for input threads.
-#        - that can automatically inject input into the event queue
-#          once the input object is running.  Like joysticks.
 
 
 
@@ -36,6 +33,9 @@ import atexit
 MIDIIN = pygame.locals.USEREVENT + 10
 MIDIOUT = pygame.locals.USEREVENT + 11
 
+# the struct format of an event of Input.read_into and Output.write_buffer
+RECORD_FORMAT = "=Ii"
+
 _init = False
 _pypm = None
 
@@ -45,6 +45,7 @@ __all__ = [ "Input",
             "MIDIOUT",
             "MidiException",
             "Output",
+            "RECORD_FORMAT",
             "get_count",
             "get_default_input_id",
             "get_default_output_id",
@@ -97,6 +98,15 @@ def _check_init():
     if not _init:
         raise RuntimeError("pygame.midi not initialised.")
 
+def _check_pypm(name):
+    if not hasattr(_pypm, name):
+        raise NotImplementedError("pygame.pypm is too old for %s" % name)
+
+def _post_events(device_id, events):
+    """posts the events of the pypm poll thread to the event queue"""
+    for e in midis2events(events, device_id):
+        pygame.event.post(e)
+
 def get_count():
     """gets the number of devices.
     pygame.midi.get_count(): return num_devices
@@ -307,6 +317,49 @@ class Input(object):
         return self._input.Read(num_events)
 
 
+    def read_into(self, buffer):
+        """reads midi events into a buffer.
+        Input.read_into(buffer): return num_events
+
+        Reads as many events as fit in buffer, a writable buffer such as
+        a bytearray or array, each packed as RECORD_FORMAT: the message,
+        status in the low byte, as an unsigned 32 bit int, then the
+        timestamp as a 32 bit int.  Returns the number of events read.
+        Reading into the same buffer each time makes no list per event.
+        """
+        _check_init()
+        self._check_open()
+        _check_pypm("SetPollCallback")
+        return self._input.ReadInto(buffer)
+
+
+    def start_events(self, interval=1):
+        """posts MIDIIN events from a background thread.
+        Input.start_events(interval=1): return None
+
+        A native thread polls the Input every interval milliseconds and
+        posts a MIDIIN event, as midis2events makes, for each midi event.
+        The events come like those of joysticks, with no polling loop.
+        The interval is shared by all Inputs.  Do not call read() or
+        poll() while the events are started.
+        """
+        _check_init()
+        self._check_open()
+        _check_pypm("SetPollCallback")
+        _pypm.SetPollCallback(_post_events, interval)
+        self._input.StartPolling()
+
+
+    def stop_events(self):
+        """stops posting MIDIIN events.
+        Input.stop_events(): return None
+        """
+        _check_init()
+        self._check_open()
+        _check_pypm("SetPollCallback")
+        self._input.StopPolling()
+
+
     def poll(self):
         """returns true if there's data, or false if not.
         Input.poll(): return Bool
@@ -481,6 +534,25 @@ class Output(object):
         self._output.Write(data)
 
 
+    def write_buffer(self, buffer):
+        """writes midi events packed in a buffer to the Output
+        Output.write_buffer(buffer): return num_events
+
+        buffer is a buffer such as a bytearray, array or bytes of events
+        packed as RECORD_FORMAT: the message, status in the low byte, as
+        an unsigned 32 bit int, then the timestamp as a 32 bit int.  Unlike
+        write(), there is no limit on the number of events.
+        example: note 65 on with velocity 100, then off 500 ms later.
+             t = pygame.midi.time()
+             o.write_buffer(struct.pack("=IiIi", 0x644190, t,
+                                        0x004180, t + 500))
+        """
+        _check_init()
+        self._check_open()
+        _check_pypm("SetPollCallback")
+        return self._output.WriteBuffer(buffer)
+
+
     def write_short(self, status, data1 = 0, data2 = 0):
         """write_short(status <, data1><, data2>)
         Output.write_short(status)
@@ -0,0 +1,61 @@
+##    pygame - Python Game Library
+##
+##    This library is free software; you can redistribute it and/or
+##    modify it under the terms of the GNU Library General Public
+##    License as published by the Free Software Foundation; either
+##    version 2 of the License, or (at your option) any later version.
+##
+##    This library is distributed in the hope that it will be useful,
+##    but WITHOUT ANY WARRANTY; without even the implied warranty of
+##    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+##    Library General Public License for more details.
+##
+##    You should have received a copy of the GNU Library General Public
+##    License along with this library; if not, write to the Free
+##    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""pygame module for counting where pygame spends its time
+
+The C code of pygame counts the calls, pixels and time of blits, fills,
+smoothscale, display updates, event.get and freetype rendering while the
+counters are on. They are off until enable() is called, or from the
+start if the PYGAME_PERF environment variable is set to anything but 0.
+While off, each counted call costs one test of a flag.
+"""
+
+from pygame import base
+
+
+def enable():
+    """enable() -> None
+    turn the counters on
+    """
+    base._perf_set_enabled(1)
+
+
+def disable():
+    """disable() -> None
+    turn the counters off, keeping their counts
+    """
+    base._perf_set_enabled(0)
+
+
+def get_enabled():
+    """get_enabled() -> bool
+    are the counters on
+    """
+    return base._perf_get_enabled()
+
+
+def reset():
+    """reset() -> None
+    set all the counters to zero
+    """
+    base._perf_reset()
+
+
+def snapshot():
+    """snapshot() -> dict
+    the counts so far, by counter name
+    """
+    return base._perf_snapshot()
@@ -98,9 +98,17 @@ if 'callable' not in dir(__builtins__):
 
 # Don't depend on pygame.mask if it's not there...
 try:
-    from pygame.mask import from_surface
+    from pygame.mask import from_surface, collide_pairs
 except:
-    pass
+    collide_pairs = None
+
+# Use the C drawing loops of pygame._sprite when they have been built
+try:
+    from pygame import _sprite
+except:
+    _sprite = None
+else:
+    SpriteBatch = _sprite.SpriteBatch
 
 
 class Sprite(object):
@@ -470,9 +478,12 @@ class AbstractGroup(object):
 
         """
         sprites = self.sprites()
-        surface_blit = surface.blit
-        for spr in sprites:
-            self.spritedict[spr] = surface_blit(spr.image, spr.rect)
+        if _sprite is not None:
+            _sprite.draw(surface, sprites, self.spritedict)
+        else:
+            self.spritedict.update(
+                zip(sprites,
+                    surface.blits((spr.image, spr.rect) for spr in sprites)))
         self.lostsprites = []
 
     def clear(self, surface, bgd):
@@ -565,13 +576,15 @@ class RenderUpdates(Group):
     """
     def draw(self, surface):
        spritedict = self.spritedict
-       surface_blit = surface.blit
        dirty = self.lostsprites
        self.lostsprites = []
+       if _sprite is not None:
+           return _sprite.draw(surface, self.sprites(), spritedict, dirty)
        dirty_append = dirty.append
-       for s in self.sprites():
+       sprites = self.sprites()
+       newrects = surface.blits([(s.image, s.rect) for s in sprites])
+       for s, newrect in zip(sprites, newrects):
            r = spritedict[s]
-           newrect = surface_blit(s.image, s.rect)
            if r:
                if newrect.colliderect(r):
                    dirty_append(newrect.union(r))
@@ -662,6 +675,10 @@ class LayeredUpdates(AbstractGroup):
         sprites_layers = self._spritelayers
         sprites_layers[sprite] = layer
 
+        if _sprite is not None:
+            _sprite.layer_insert(sprites, sprites_layers, sprite, layer)
+            return
+
         # add the sprite at the right position
         # bisect algorithmus
         leng = len(sprites)
@@ -730,7 +747,10 @@ class LayeredUpdates(AbstractGroup):
         The group uses it to add a sprite.
 
         """
-        self._spritelist.remove(sprite)
+        if _sprite is not None:
+            _sprite.layer_remove(self._spritelist, self._spritelayers, sprite)
+        else:
+            self._spritelist.remove(sprite)
         # these dirty rects are suboptimal for one frame
         r = self.spritedict[sprite]
         if r is not self._init_rect:
@@ -830,6 +850,14 @@ class LayeredUpdates(AbstractGroup):
         sprites = self._spritelist # speedup
         sprites_layers = self._spritelayers # speedup
 
+        if _sprite is not None:
+            _sprite.layer_remove(sprites, sprites_layers, sprite)
+            sprites_layers[sprite] = new_layer
+            _sprite.layer_insert(sprites, sprites_layers, sprite, new_layer)
+            if hasattr(sprite, 'layer'):
+                sprite.layer = new_layer
+            return
+
         sprites.remove(sprite)
         sprites_layers.pop(sprite)
 
@@ -854,6 +882,24 @@ class LayeredUpdates(AbstractGroup):
         # add layer info
         sprites_layers[sprite] = new_layer
 
+    def sort_by_key(self, key):
+        """change the layer of every sprite to key(sprite)
+
+        LayeredUpdates.sort_by_key(key): return None
+
+        Re-layers all the sprites with one sort, for layers that change every
+        frame, like the y position of sprites in an isometric view. Sprites
+        given the same layer keep their order.
+
+        """
+        sprites = self._spritelist
+        sprites_layers = self._spritelayers
+        for spr in sprites:
+            layer = sprites_layers[spr] = key(spr)
+            if hasattr(spr, 'layer'):
+                spr.layer = layer
+        sprites.sort(key=sprites_layers.__getitem__)
+
     def get_layer_of_sprite(self, sprite):
         """return the layer that sprite is currently in
 
@@ -919,6 +965,10 @@ class LayeredUpdates(AbstractGroup):
         layer.
 
         """
+        if _sprite is not None:
+            start, stop = _sprite.layer_range(self._spritelist,
+                                              self._spritelayers, layer)
+            return self._spritelist[start:stop]
         sprites = []
         sprites_append = sprites.append
         sprite_layers = self._spritelayers
@@ -1053,7 +1103,11 @@ class LayeredDirty(LayeredUpdates):
         # -------
         # 0. decide whether to render with update or flip
         start_time = get_ticks()
-        if self._use_update: # dirty rects mode
+        if _sprite is not None:
+            _ret = _sprite.layered_dirty_draw(_surf, _sprites, _old_rect,
+                                              _update, _clip, _bgd,
+                                              init_rect, self._use_update)
+        elif self._use_update: # dirty rects mode
             # 1. find dirty area on screen and put the rects into _update
             # still not happy with that part
             for spr in _sprites:
@@ -1206,6 +1260,20 @@ class LayeredDirty(LayeredUpdates):
         if sprite.dirty == 0:
             sprite.dirty = 1
 
+    def sort_by_key(self, key):
+        """change the layer of every sprite to key(sprite)
+
+        LayeredDirty.sort_by_key(key): return None
+
+        Sprites whose layer changes are made dirty.
+
+        """
+        old_layers = dict(self._spritelayers)
+        LayeredUpdates.sort_by_key(self, key)
+        for spr, layer in self._spritelayers.items():
+            if layer != old_layers[spr] and spr.dirty == 0:
+                spr.dirty = 1
+
     def set_timing_treshold(self, time_ms):
         """set the treshold in milliseconds
 
@@ -1439,17 +1507,19 @@ class collide_circle_ratio(object):
             leftradius = left.radius * ratio
         else:
             leftrect = left.rect
-            leftradius = ratio * 0.5 * ((leftrect.width ** 2 + leftrect.height ** 2) ** 0.5)
-            # store the radius on the sprite for next time
+            leftradius = 0.5 * ((leftrect.width ** 2 + leftrect.height ** 2) ** 0.5)
+            # store the unscaled radius on the sprite for next time
             setattr(left, 'radius', leftradius)
+            leftradius *= ratio
 
         if hasattr(right, "radius"):
             rightradius = right.radius * ratio
         else:
             rightrect = right.rect
-            rightradius = ratio * 0.5 * ((rightrect.width ** 2 + rightrect.height ** 2) ** 0.5)
-            # store the radius on the sprite for next time
+            rightradius = 0.5 * ((rightrect.width ** 2 + rightrect.height ** 2) ** 0.5)
+            # store the unscaled radius on the sprite for next time
             setattr(right, 'radius', rightradius)
+            rightradius *= ratio
 
         return distancesquared <= (leftradius + rightradius) ** 2
 
@@ -1479,6 +1549,39 @@ def collide_mask(left, right):
         rightmask = from_surface(right.image)
     return leftmask.overlap(rightmask, (xoffset, yoffset))
 
+def _sprite_mask(sprite):
+    try:
+        return sprite.mask
+    except AttributeError:
+        return from_surface(sprite.image)
+
+def _collide_pairs(spritesa, spritesb, collided):
+    """the colliding (a index, b index) pairs of two lists of sprites
+
+    Done in C by pygame.mask.collide_pairs for rect and mask collision, and
+    by pygame._sprite for circle and ratio collision. Returns None for other
+    collided callbacks, which are done in Python.
+
+    """
+    if collide_pairs is not None:
+        if collided is None or collided is collide_rect:
+            return collide_pairs(spritesa, spritesb)
+        if collided is collide_mask:
+            return collide_pairs(spritesa, spritesb,
+                                 [_sprite_mask(s) for s in spritesa],
+                                 [_sprite_mask(s) for s in spritesb])
+    if _sprite is not None:
+        # subclasses may collide in their own way
+        cls = getattr(collided, '__class__', None)
+        if collided is collide_circle:
+            return _sprite.circle_pairs(spritesa, spritesb, 1.0)
+        if cls is collide_circle_ratio:
+            return _sprite.circle_pairs(spritesa, spritesb, collided.ratio)
+        if cls is collide_rect_ratio:
+            return _sprite.rect_ratio_pairs(spritesa, spritesb,
+                                            collided.ratio)
+    return None
+
 def spritecollide(sprite, group, dokill, collided=None):
     """find Sprites in a Group that intersect another Sprite
 
@@ -1499,6 +1602,15 @@ def spritecollide(sprite, group, dokill, collided=None):
     which will be used to calculate the collision.
 
     """
+    sprites = group.sprites()
+    pairs = _collide_pairs([sprite], sprites, collided)
+    if pairs is not None:
+        crashed = [sprites[j] for i, j in pairs]
+        if dokill:
+            for s in crashed:
+                s.kill()
+        return crashed
+
     if dokill:
 
         crashed = []
@@ -1543,6 +1655,13 @@ def groupcollide(groupa, groupb, dokilla, dokillb, collided=None):
     that will be used to calculate the collision.
 
     """
+    spritesa = groupa.sprites()
+    spritesb = groupb.sprites()
+    pairs = _collide_pairs(spritesa, spritesb, collided)
+    if pairs is not None:
+        return _crashed_from_pairs(spritesa, spritesb, pairs,
+                                   dokilla, dokillb)
+
     crashed = {}
     SC = spritecollide
     if dokilla:
@@ -1558,6 +1677,30 @@ def groupcollide(groupa, groupb, dokilla, dokillb, collided=None):
                 crashed[s] = c
     return crashed
 
+def _crashed_from_pairs(spritesa, spritesb, pairs, dokilla, dokillb):
+    """the groupcollide result for the colliding pairs of index
+
+    With dokillb each sprite of b is only given to the first sprite of a it
+    collides with, as it is killed then.
+
+    """
+    crashed = {}
+    killedb = set()
+    for i, j in pairs:
+        if dokillb:
+            if j in killedb:
+                continue
+            killedb.add(j)
+        crashed.setdefault(spritesa[i], []).append(spritesb[j])
+    if dokillb:
+        for j in sorted(killedb):
+            spritesb[j].kill()
+    if dokilla:
+        for s in spritesa:
+            if s in crashed:
+                s.kill()
+    return crashed
+
 def spritecollideany(sprite, group, collided=None):
     """finds any sprites in a group that collide with the given sprite
 
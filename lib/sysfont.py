@@ -24,6 +24,15 @@ import os
 import sys
 from pygame.compat import xrange_, PY_MAJOR_VERSION
 from os.path import basename, dirname, exists, join, splitext
+import tempfile
+try:
+    import json
+except ImportError:
+    json = None
+try:
+    import threading
+except ImportError:
+    threading = None
 
 
 OpenType_extensions = frozenset(('.ttf', '.ttc', '.otf'))
@@ -62,17 +71,8 @@ def _addfont(name, bold, italic, font, fontdict):
     fontdict[name][bold, italic] = font
 
 
-def initsysfonts_win32():
-    """initialize fonts dictionary on Windows"""
-
-    fontdir = join(os.environ.get('WINDIR', 'C:\\Windows'), 'Fonts')
-
-    TrueType_suffix = '(TrueType)'
-    mods = ('demibold', 'narrow', 'light', 'unicode', 'bt', 'mt')
-
-    fonts = {}
-
-    # add fonts entered in the registry
+def _win32_fonts_key():
+    """open the registry key listing the fonts on Windows"""
 
     # find valid registry keys containing font information.
     # http://docs.python.org/lib/module-sys.html
@@ -84,7 +84,21 @@ def initsysfonts_win32():
         key_name = "SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Fonts"
     else:
         key_name = "SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Fonts"
-    key = _winreg.OpenKey(_winreg.HKEY_LOCAL_MACHINE, key_name)
+    return _winreg.OpenKey(_winreg.HKEY_LOCAL_MACHINE, key_name)
+
+
+def initsysfonts_win32():
+    """initialize fonts dictionary on Windows"""
+
+    fontdir = join(os.environ.get('WINDIR', 'C:\\Windows'), 'Fonts')
+
+    TrueType_suffix = '(TrueType)'
+    mods = ('demibold', 'narrow', 'light', 'unicode', 'bt', 'mt')
+
+    fonts = {}
+
+    # add fonts entered in the registry
+    key = _win32_fonts_key()
 
     for i in xrange_(_winreg.QueryInfoKey(key)[1]):
         try:
@@ -210,6 +224,7 @@ def create_aliases():
          'georgia'),
         ('wingdings', 'wingbats'),
     )
+    aliases = {}
     for alias_set in alias_groups:
         for name in alias_set:
             if name in Sysfonts:
@@ -219,21 +234,191 @@ def create_aliases():
             continue
         for name in alias_set:
             if name not in Sysfonts:
-                Sysalias[name] = found
+                aliases[name] = found
+    _replace(Sysalias, aliases)
 
 
-# initialize it all, called once
-def initsysfonts():
+def _replace(d, new):
+    """replace the contents of a dictionary, without emptying it between"""
+    d.update(new)
+    for name in list(d):
+        if name not in new:
+            del d[name]
+
+
+def _set_fonts(fonts):
+    """make fonts the system fonts"""
+    if not fonts:  # dummy so we don't try to reinit
+        fonts = {None: None}
+    _replace(Sysfonts, fonts)
+    create_aliases()
+
+
+def _scan_fonts():
+    """find the system fonts"""
+    if sys.platform == 'win32':
+        return initsysfonts_win32()
+    elif sys.platform == 'darwin':
+        return initsysfonts_darwin()
+    return initsysfonts_unix()
+
+
+# The fonts found are kept in a cache file, so later processes only read
+# the file. It is checked against the modification times of the font
+# directories, in the background, and rebuilt if any have changed.
+
+_cache_version = 1
+_cache_thread = None
+
+
+def _cache_path():
+    """the font cache file, or None for no cache"""
+    path = os.environ.get('PYGAME_FONT_CACHE')
+    if path is not None:
+        return path or None
     if sys.platform == 'win32':
-        fonts = initsysfonts_win32()
+        cachedir = os.environ.get('LOCALAPPDATA') or os.environ.get('APPDATA')
     elif sys.platform == 'darwin':
-        fonts = initsysfonts_darwin()
+        cachedir = join(os.path.expanduser('~'), 'Library', 'Caches')
     else:
-        fonts = initsysfonts_unix()
-    Sysfonts.update(fonts)
-    create_aliases()
-    if not Sysfonts:  # dummy so we don't try to reinit
-        Sysfonts[None] = None
+        cachedir = (os.environ.get('XDG_CACHE_HOME') or
+                    join(os.path.expanduser('~'), '.cache'))
+    if not cachedir or cachedir.startswith('~'):
+        return None
+    return join(cachedir, 'pygame', 'sysfont.json')
+
+
+def _font_dirs():
+    """the directories fonts are installed in"""
+    if sys.platform == 'win32':
+        return [join(os.environ.get('WINDIR', 'C:\\Windows'), 'Fonts')]
+    home = os.path.expanduser('~')
+    dirs = ['/usr/share/fonts', '/usr/local/share/fonts',
+            '/usr/X11R6/lib/X11/fonts', join(home, '.fonts'),
+            join(home, '.local', 'share', 'fonts')]
+    if sys.platform == 'darwin':
+        dirs += ['/Library/Fonts', '/System/Library/Fonts',
+                 '/Network/Library/Fonts', join(home, 'Library', 'Fonts')]
+    return dirs
+
+
+def _cache_key():
+    """the modification times of the font directories and the registry"""
+    key = []
+    for fontdir in _font_dirs():
+        for dirpath, dirnames, filenames in os.walk(fontdir):
+            try:
+                key.append([dirpath, os.stat(dirpath).st_mtime])
+            except OSError:
+                pass
+    if sys.platform == 'win32':
+        try:
+            regkey = _win32_fonts_key()
+            key.append(['registry', _winreg.QueryInfoKey(regkey)[2]])
+        except EnvironmentError:
+            pass
+    return key
+
+
+def _fromjson(s):
+    """a str of a string from the json module, if it is ASCII"""
+    if PY_MAJOR_VERSION < 3:
+        try:
+            return str(s)
+        except UnicodeEncodeError:
+            pass
+    return s
+
+
+def _read_cache(path):
+    """return the key and fonts of a font cache file, or None"""
+    try:
+        f = open(path, 'r')
+        try:
+            cache = json.load(f)
+        finally:
+            f.close()
+        if (cache['version'] != _cache_version or
+            cache['platform'] != sys.platform):
+            return None
+        fonts = {}
+        for name, styles in cache['fonts'].items():
+            for bold, italic, font in styles:
+                _addfont(_fromjson(name), bold, italic, _fromjson(font), fonts)
+        return cache['key'], fonts
+    except Exception:
+        return None
+
+
+def _write_cache(path, key, fonts):
+    """write a font cache file, replacing any old one in one step"""
+    cache = {'version': _cache_version,
+             'platform': sys.platform,
+             'key': key,
+             'fonts': dict((name, [[int(b), int(i), font]
+                                   for (b, i), font in styles.items()])
+                           for name, styles in fonts.items())}
+    tmp = None
+    try:
+        cachedir = dirname(path) or os.curdir
+        if not exists(cachedir):
+            os.makedirs(cachedir)
+        fd, tmp = tempfile.mkstemp(prefix='.sysfont', dir=cachedir)
+        f = os.fdopen(fd, 'w')
+        try:
+            json.dump(cache, f)
+        finally:
+            f.close()
+        try:
+            os.rename(tmp, path)
+        except OSError:
+            # Windows will not rename over an existing file
+            os.remove(path)
+            os.rename(tmp, path)
+    except Exception:
+        if tmp is not None and exists(tmp):
+            try:
+                os.remove(tmp)
+            except OSError:
+                pass
+
+
+def _refresh_cache(path, key):
+    """rebuild the fonts and the cache file if the fonts have changed"""
+    try:
+        newkey = _cache_key()
+        if newkey != key:
+            fonts = _scan_fonts()
+            _set_fonts(fonts)
+            _write_cache(path, newkey, fonts)
+    except Exception:
+        # may happen at interpreter exit
+        pass
+
+
+# initialize it all, called once
+def initsysfonts():
+    global _cache_thread
+
+    path = json and _cache_path()
+    cached = path and _read_cache(path)
+    if cached:
+        _set_fonts(cached[1])
+        if threading:
+            _cache_thread = threading.Thread(target=_refresh_cache,
+                                             args=(path, cached[0]))
+            _cache_thread.daemon = True
+            _cache_thread.start()
+        else:
+            _refresh_cache(path, cached[0])
+        return
+
+    if path:
+        key = _cache_key()
+    fonts = _scan_fonts()
+    _set_fonts(fonts)
+    if path:
+        _write_cache(path, key, fonts)
 
 
 # pygame.font specific declarations
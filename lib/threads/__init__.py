@@ -308,3 +308,34 @@ def tmap(f, seq_args, num_workers = 20, worker_queue = None, wait = True, stop_o
         return map(lambda x:x.result, results)
     else:
         return [wq, results]
+
+
+# The native worker pool of pygame.base, shared with the C modules.
+
+def set_native_workers(number_of_workers, cpus = None):
+    """ Starts the native pygame worker pool with number_of_workers threads,
+          the calling thread included.  0 stops it.
+        cpus - optional CPU numbers to keep the workers on, in turn.
+          Only Linux and Windows support it.
+    """
+    import pygame.base
+    pygame.base.set_pool_affinity(cpus)
+    pygame.base.set_pool_threads(number_of_workers)
+
+
+def get_native_workers():
+    """ The number of threads of the native pygame worker pool.
+    """
+    import pygame.base
+    return pygame.base.get_pool_threads()
+
+
+def native_tmap(f, seq_args):
+    """ like map, but calls f on the threads of the native pygame worker
+          pool, see set_native_workers.  Returns a list.
+        f holds the GIL, so this only helps if f mostly runs code that
+          releases it, like pygame.transform on big surfaces.
+        The first exception raised by f is raised again.
+    """
+    import pygame.base
+    return pygame.base.pool_map(f, list(seq_args))
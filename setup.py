@@ -126,6 +126,10 @@ else:
 #headers to install
 headers = glob.glob(os.path.join('src', '*.h'))
 headers.remove(os.path.join('src', 'scale.h'))
+headers.remove(os.path.join('src', 'pgfreelist.h'))
+headers.remove(os.path.join('src', 'pgloadmany.h'))
+headers.remove(os.path.join('src', 'pgcolorspace.h'))
+headers.remove(os.path.join('src', 'simd_blitters.h'))
 
 # option for not installing the headers.
 if "-noheaders" in sys.argv:
@@ -528,6 +532,28 @@ class TestCommand(Command):
 
 cmdclass['test'] = TestCommand
 
+
+# bench command.  For doing 'python setup.py bench'
+
+class BenchCommand(Command):
+    user_options = [ ]
+
+    def initialize_options(self):
+        self._dir = os.getcwd()
+
+    def finalize_options(self):
+        pass
+
+    def run(self):
+        '''
+        runs the benchmarks with default options.
+        '''
+        import subprocess
+        return subprocess.call([sys.executable,
+                                os.path.join("test", "bench.py")])
+
+cmdclass['bench'] = BenchCommand
+
 # Prune empty file lists.
 date_files = [(path, files) for path, files in data_files if files]
 
@@ -20,6 +20,12 @@ LGPL (c) A. Schiffler
 #define DEFAULT_ALPHA_PIXEL_ROUTINE
 #undef EXPERIMENTAL_ALPHA_PIXEL_ROUTINE
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GFX_SSE2
+#include <emmintrin.h>
+#endif
+
 /* ---- Structures */
 
 /*!
@@ -44,6 +50,23 @@ typedef struct {
 	Sint16 last1x, last1y, last2x, last2y, first1x, first1y, first2x, first2y, tempx, tempy;
 } SDL_gfxMurphyIterator;
 
+/*!
+\brief The structure passed to the internal span functions.
+
+Holds the color of a primitive mapped to the destination format once, so
+that whole spans can be filled or blended without splitting the color again
+for every pixel.
+*/
+typedef struct {
+	SDL_Surface *dst;
+	Uint32 color;		/* color in the destination format */
+	Uint8 alpha;		/* 255 fills, anything less blends */
+	int simd;		/* 32 bit with the color in the low three bytes */
+	Uint32 keep;		/* color channel bits of a blended pixel */
+	Uint32 abits;		/* alpha bits of every blended pixel */
+	int blendalpha;		/* blend the alpha channel as _putPixelAlpha() does */
+} SDL_gfxSpan;
+
 /* ----- Defines for pixel clipping tests */
 
 #define clip_xmin(surface) surface->clip_rect.x
@@ -543,88 +566,173 @@ int pixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 
 
 /*!
-\brief Internal function to draw filled rectangle with alpha blending.
-
-Assumes color is in destination format.
+\brief Internal function to set up a span of a color already in the destination format.
 
+\param span The span state to set up.
 \param dst The surface to draw on.
-\param x1 X coordinate of the first corner (upper left) of the rectangle.
-\param y1 Y coordinate of the first corner (upper left) of the rectangle.
-\param x2 X coordinate of the second corner (lower right) of the rectangle.
-\param y2 Y coordinate of the second corner (lower right) of the rectangle.
-\param color The color value of the rectangle to draw (0xRRGGBBAA). 
+\param color The color value in the destination format.
 \param alpha Alpha blending amount for pixels.
+*/
+static void _gfxSpanMapped(SDL_gfxSpan *span, SDL_Surface *dst, Uint32 color, Uint8 alpha)
+{
+	SDL_PixelFormat *format = dst->format;
 
-\returns Returns 0 on success, -1 on failure.
+	span->dst = dst;
+	span->color = color;
+	span->alpha = alpha;
+
+	/*
+	* A blended pixel keeps its new color channels and gets the alpha of
+	* the color scaled by alpha, see _filledRectAlpha(), unless blendalpha
+	* is set afterwards 
+	*/
+	span->blendalpha = 0;
+	span->keep = format->Rmask | format->Gmask | format->Bmask;
+	span->abits = 0;
+	if (format->Amask) {
+		span->abits = ((((color & format->Amask) >> format->Ashift) * alpha >> 8) << format->Ashift) & format->Amask;
+	}
+
+	/*
+	* The SIMD blend matches the scalar one for byte channels below the top byte 
+	*/
+	span->simd = 0;
+#if defined(GFX_SSE2) && defined(DEFAULT_ALPHA_PIXEL_ROUTINE)
+	span->simd = (format->BytesPerPixel == 4) &&
+		(format->Rmask == (Uint32) 0xff << format->Rshift) && (format->Rshift < 24) && !(format->Rshift & 7) &&
+		(format->Gmask == (Uint32) 0xff << format->Gshift) && (format->Gshift < 24) && !(format->Gshift & 7) &&
+		(format->Bmask == (Uint32) 0xff << format->Bshift) && (format->Bshift < 24) && !(format->Bshift & 7);
+#endif
+}
+
+/*!
+\brief Internal function to set up a span of an RGBA color.
+
+\param span The span state to set up.
+\param dst The surface to draw on.
+\param color The color value of the primitive to draw (0xRRGGBBAA). 
 */
-int _filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color, Uint8 alpha)
+static void _gfxSpanSetup(SDL_gfxSpan *span, SDL_Surface *dst, Uint32 color)
 {
-	SDL_PixelFormat *format;
-	Uint32 Rmask, Bmask, Gmask, Amask;
-	Uint32 Rshift, Bshift, Gshift, Ashift;
-	Uint8 sR, sG, sB, sA;
+	Uint8 alpha = color & 0x000000ff;
+
+	_gfxSpanMapped(span, dst, 
+		SDL_MapRGBA(dst->format, (color & 0xff000000) >> 24,
+		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, alpha),
+		alpha);
+}
+
+/*!
+\brief Internal function to fill a clipped span with the opaque span color.
+
+\param span The span state.
+\param x1 X coordinate of the first point (i.e. left) of the span.
+\param x2 X coordinate of the second point (i.e. right) of the span.
+\param y Y coordinate of the span.
+*/
+static void _gfxSpanFill(const SDL_gfxSpan *span, Sint16 x1, Sint16 x2, Sint16 y)
+{
+	SDL_Surface *dst = span->dst;
+	int pixx = dst->format->BytesPerPixel;
+	Uint8 *pixel = ((Uint8 *) dst->pixels) + pixx * (int) x1 + dst->pitch * (int) y;
+	Uint8 *pixellast = pixel + pixx * (int) (x2 - x1);
+	Uint32 color = span->color;
+	Uint8 color3[3];
+
+	switch (pixx) {
+	case 1:
+		memset(pixel, color, x2 - x1 + 1);
+		break;
+	case 2:
+		for (; pixel <= pixellast; pixel += pixx) {
+			*(Uint16 *) pixel = color;
+		}
+		break;
+	case 3:
+		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+			color3[0] = (color >> 16) & 0xff;
+			color3[1] = (color >> 8) & 0xff;
+			color3[2] = color & 0xff;
+		} else {
+			color3[0] = color & 0xff;
+			color3[1] = (color >> 8) & 0xff;
+			color3[2] = (color >> 16) & 0xff;
+		}
+		for (; pixel <= pixellast; pixel += pixx) {
+			memcpy(pixel, color3, 3);
+		}
+		break;
+	default:		/* case 4 */
+		for (; pixel <= pixellast; pixel += pixx) {
+			*(Uint32 *) pixel = color;
+		}
+		break;
+	}
+}
+
+/*!
+\brief Internal function to alpha blend a clipped span with the span color.
+
+Gives the same pixels as _filledRectAlpha(), or as _putPixelAlpha() for each
+pixel if blendalpha is set. 32 bit surfaces
+with byte channels are blended four pixels at a time with SSE2, where
+p + (c - p) * a / 256 is computed as (p * (256 - a) + c * a) / 256, which
+keeps it in 16 bits.
+
+\param span The span state.
+\param x1 X coordinate of the first point (i.e. left) of the span.
+\param x2 X coordinate of the second point (i.e. right) of the span.
+\param y Y coordinate of the span.
+*/
+static void _gfxSpanBlend(const SDL_gfxSpan *span, Sint16 x1, Sint16 x2, Sint16 y)
+{
+	SDL_Surface *dst = span->dst;
+	SDL_PixelFormat *format = dst->format;
+	Uint32 color = span->color;
+	Uint32 alpha = span->alpha;
+	Uint32 Rmask = format->Rmask, Gmask = format->Gmask, Bmask = format->Bmask, Amask = format->Amask;
+	Uint32 Rshift = format->Rshift, Gshift = format->Gshift, Bshift = format->Bshift, Ashift = format->Ashift;
 	Uint32 R, G, B, A;
-	Sint16 x, y;
+	int n = x2 - x1 + 1;
 
-	format = dst->format;
 	switch (format->BytesPerPixel) {
 	case 1:
 		{			/* Assuming 8-bpp */
-			Uint8 *row, *pixel;
+			Uint8 *pixel = (Uint8 *) dst->pixels + y * dst->pitch + x1;
+			SDL_Color *colors = format->palette->colors;
+			Uint8 sR = colors[color].r, sG = colors[color].g, sB = colors[color].b;
 			Uint8 dR, dG, dB;
-			SDL_Palette *palette = format->palette;
-			SDL_Color *colors = palette->colors;
-			sR = colors[color].r;
-			sG = colors[color].g;
-			sB = colors[color].b;
-
-			for (y = y1; y <= y2; y++) {
-				row = (Uint8 *) dst->pixels + y * dst->pitch;
-				for (x = x1; x <= x2; x++) {
-					pixel = row + x;
-
-					dR = colors[*pixel].r;
-					dG = colors[*pixel].g;
-					dB = colors[*pixel].b;
-
-					dR = dR + ((sR - dR) * alpha >> 8);
-					dG = dG + ((sG - dG) * alpha >> 8);
-					dB = dB + ((sB - dB) * alpha >> 8);
-
-					*pixel = SDL_MapRGB(format, dR, dG, dB);
-				}
+
+			for (; n > 0; n--, pixel++) {
+				dR = colors[*pixel].r;
+				dG = colors[*pixel].g;
+				dB = colors[*pixel].b;
+
+				dR = dR + ((sR - dR) * alpha >> 8);
+				dG = dG + ((sG - dG) * alpha >> 8);
+				dB = dB + ((sB - dB) * alpha >> 8);
+
+				*pixel = SDL_MapRGB(format, dR, dG, dB);
 			}
 		}
 		break;
 
 	case 2:
 		{			/* Probably 15-bpp or 16-bpp */
-			Uint16 *row, *pixel;
-			Uint32 dR, dG, dB, dA;
-			Rmask = format->Rmask;
-			Gmask = format->Gmask;
-			Bmask = format->Bmask;
-			Amask = format->Amask;
-
-			dR = (color & Rmask); 
-			dG = (color & Gmask);
-			dB = (color & Bmask);
-			dA = (color & Amask);
+			Uint16 *pixel = (Uint16 *) dst->pixels + y * dst->pitch / 2 + x1;
+			Uint32 dR = color & Rmask, dG = color & Gmask, dB = color & Bmask, dA = color & Amask;
+			Uint32 dc, da;
 
-			for (y = y1; y <= y2; y++) {
-				row = (Uint16 *) dst->pixels + y * dst->pitch / 2;
-				for (x = x1; x <= x2; x++) {
-					pixel = row + x;
-
-					R = ((*pixel & Rmask) + ((dR - (*pixel & Rmask)) * alpha >> 8)) & Rmask;
-					G = ((*pixel & Gmask) + ((dG - (*pixel & Gmask)) * alpha >> 8)) & Gmask;
-					B = ((*pixel & Bmask) + ((dB - (*pixel & Bmask)) * alpha >> 8)) & Bmask;
-					*pixel = R | G | B;
-					if (Amask!=0)
-					{
-						A = ((*pixel & Amask) + ((dA - (*pixel & Amask)) * alpha >> 8)) & Amask;
-						*pixel |= A;
-					} 
+			for (; n > 0; n--, pixel++) {
+				dc = *pixel;
+				R = ((dc & Rmask) + ((dR - (dc & Rmask)) * alpha >> 8)) & Rmask;
+				G = ((dc & Gmask) + ((dG - (dc & Gmask)) * alpha >> 8)) & Gmask;
+				B = ((dc & Bmask) + ((dB - (dc & Bmask)) * alpha >> 8)) & Bmask;
+				*pixel = R | G | B;
+				if (Amask!=0) {
+					da = span->blendalpha ? (dc & Amask) : (*pixel & Amask);
+					A = (da + ((dA - da) * alpha >> 8)) & Amask;
+					*pixel |= A;
 				}
 			}
 		}
@@ -632,45 +740,27 @@ int _filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16
 
 	case 3:
 		{			/* Slow 24-bpp mode, usually not used */
-			Uint8 *row, *pix;
+			Uint8 *pix = (Uint8 *) dst->pixels + y * dst->pitch + x1 * 3;
+			Uint8 Rshift8 = Rshift / 8, Gshift8 = Gshift / 8, Bshift8 = Bshift / 8, Ashift8 = Ashift / 8;
+			Uint8 sR = (color >> Rshift) & 0xff, sG = (color >> Gshift) & 0xff;
+			Uint8 sB = (color >> Bshift) & 0xff, sA = (color >> Ashift) & 0xff;
 			Uint8 dR, dG, dB, dA;
-			Uint8 Rshift8, Gshift8, Bshift8, Ashift8;
 
-			Rshift = format->Rshift;
-			Gshift = format->Gshift;
-			Bshift = format->Bshift;
-			Ashift = format->Ashift;
+			for (; n > 0; n--, pix += 3) {
+				dR = *((pix) + Rshift8);
+				dG = *((pix) + Gshift8);
+				dB = *((pix) + Bshift8);
+				dA = *((pix) + Ashift8);
 
-			Rshift8 = Rshift / 8;
-			Gshift8 = Gshift / 8;
-			Bshift8 = Bshift / 8;
-			Ashift8 = Ashift / 8;
+				dR = dR + ((sR - dR) * alpha >> 8);
+				dG = dG + ((sG - dG) * alpha >> 8);
+				dB = dB + ((sB - dB) * alpha >> 8);
+				dA = dA + ((sA - dA) * alpha >> 8);
 
-			sR = (color >> Rshift) & 0xff;
-			sG = (color >> Gshift) & 0xff;
-			sB = (color >> Bshift) & 0xff;
-			sA = (color >> Ashift) & 0xff;
-
-			for (y = y1; y <= y2; y++) {
-				row = (Uint8 *) dst->pixels + y * dst->pitch;
-				for (x = x1; x <= x2; x++) {
-					pix = row + x * 3;
-
-					dR = *((pix) + Rshift8);
-					dG = *((pix) + Gshift8);
-					dB = *((pix) + Bshift8);
-					dA = *((pix) + Ashift8);
-
-					dR = dR + ((sR - dR) * alpha >> 8);
-					dG = dG + ((sG - dG) * alpha >> 8);
-					dB = dB + ((sB - dB) * alpha >> 8);
-					dA = dA + ((sA - dA) * alpha >> 8);
-
-					*((pix) + Rshift8) = dR;
-					*((pix) + Gshift8) = dG;
-					*((pix) + Bshift8) = dB;
-					*((pix) + Ashift8) = dA;
-				}
+				*((pix) + Rshift8) = dR;
+				*((pix) + Gshift8) = dG;
+				*((pix) + Bshift8) = dB;
+				*((pix) + Ashift8) = dA;
 			}
 		}
 		break;
@@ -678,38 +768,41 @@ int _filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16
 #ifdef DEFAULT_ALPHA_PIXEL_ROUTINE
 	case 4:
 		{			/* Probably :-) 32-bpp */
-			Uint32 *row, *pixel;
-			Uint32 dR, dG, dB, dA;
-
-			Rmask = format->Rmask;
-			Gmask = format->Gmask;
-			Bmask = format->Bmask;
-			Amask = format->Amask;
-
-			Rshift = format->Rshift;
-			Gshift = format->Gshift;
-			Bshift = format->Bshift;
-			Ashift = format->Ashift;
-
-			dR = (color & Rmask);
-			dG = (color & Gmask);
-			dB = (color & Bmask);
-			dA = (color & Amask);
+			Uint32 *pixel = (Uint32 *) dst->pixels + y * dst->pitch / 4 + x1;
+			Uint32 dR = color & Rmask, dG = color & Gmask, dB = color & Bmask, dA = color & Amask;
+			Uint32 dc, da;
+
+#ifdef GFX_SSE2
+			if (span->simd && !span->blendalpha) {
+				__m128i zero = _mm_setzero_si128();
+				__m128i inv = _mm_set1_epi16((short) (256 - alpha));
+				__m128i src = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int) color), zero), _mm_set1_epi16((short) alpha));
+				__m128i keep = _mm_set1_epi32((int) span->keep);
+				__m128i abits = _mm_set1_epi32((int) span->abits);
+				__m128i p, lo, hi;
+
+				for (; n >= 4; n -= 4, pixel += 4) {
+					p = _mm_loadu_si128((__m128i *) pixel);
+					lo = _mm_unpacklo_epi8(p, zero);
+					hi = _mm_unpackhi_epi8(p, zero);
+					lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, inv), src), 8);
+					hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, inv), src), 8);
+					p = _mm_packus_epi16(lo, hi);
+					_mm_storeu_si128((__m128i *) pixel, _mm_or_si128(_mm_and_si128(p, keep), abits));
+				}
+			}
+#endif
 
-			for (y = y1; y <= y2; y++) {
-				row = (Uint32 *) dst->pixels + y * dst->pitch / 4;
-				for (x = x1; x <= x2; x++) {
-					pixel = row + x;
-
-					R = ((*pixel & Rmask) + ((((dR - (*pixel & Rmask)) >> Rshift) * alpha >> 8) << Rshift)) & Rmask;
-					G = ((*pixel & Gmask) + ((((dG - (*pixel & Gmask)) >> Gshift) * alpha >> 8) << Gshift)) & Gmask;
-					B = ((*pixel & Bmask) + ((((dB - (*pixel & Bmask)) >> Bshift) * alpha >> 8) << Bshift)) & Bmask;
-					*pixel = R | G | B;
-					if (Amask!=0)
-					{
-						A = ((*pixel & Amask) + ((((dA - (*pixel & Amask)) >> Ashift) * alpha >> 8) << Ashift)) & Amask;
-						*pixel |= A;
-					}					
+			for (; n > 0; n--, pixel++) {
+				dc = *pixel;
+				R = ((dc & Rmask) + ((((dR - (dc & Rmask)) >> Rshift) * alpha >> 8) << Rshift)) & Rmask;
+				G = ((dc & Gmask) + ((((dG - (dc & Gmask)) >> Gshift) * alpha >> 8) << Gshift)) & Gmask;
+				B = ((dc & Bmask) + ((((dB - (dc & Bmask)) >> Bshift) * alpha >> 8) << Bshift)) & Bmask;
+				*pixel = R | G | B;
+				if (Amask!=0) {
+					da = span->blendalpha ? (dc & Amask) : (*pixel & Amask);
+					A = (da + ((((dA - da) >> Ashift) * alpha >> 8) << Ashift)) & Amask;
+					*pixel |= A;
 				}
 			}
 		}
@@ -717,38 +810,16 @@ int _filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16
 #endif
 
 #ifdef EXPERIMENTAL_ALPHA_PIXEL_ROUTINE
-	case 4:{			/* Probably :-) 32-bpp */
-		Uint32 *row, *pixel;
-		Uint32 dR, dG, dB, dA;
-		Uint32 dc;
-		Uint32 surfaceAlpha, preMultR, preMultG, preMultB;
-		Uint32 aTmp;
-
-		Rmask = format->Rmask;
-		Gmask = format->Gmask;
-		Bmask = format->Bmask;
-		Amask = format->Amask;
-
-		dR = (color & Rmask);
-		dG = (color & Gmask);
-		dB = (color & Bmask);
-		dA = (color & Amask);
-
-		Rshift = format->Rshift;
-		Gshift = format->Gshift;
-		Bshift = format->Bshift;
-		Ashift = format->Ashift;
-
-		preMultR = (alpha * (dR >> Rshift));
-		preMultG = (alpha * (dG >> Gshift));
-		preMultB = (alpha * (dB >> Bshift));
-
-		for (y = y1; y <= y2; y++) {
-			row = (Uint32 *) dst->pixels + y * dst->pitch / 4;
-			for (x = x1; x <= x2; x++) {
-				pixel = row + x;
-				dc = *pixel;
+	case 4:
+		{			/* Probably :-) 32-bpp */
+			Uint32 *pixel = (Uint32 *) dst->pixels + y * dst->pitch / 4 + x1;
+			Uint32 dc, surfaceAlpha, aTmp;
+			Uint32 preMultR = (alpha * ((color & Rmask) >> Rshift));
+			Uint32 preMultG = (alpha * ((color & Gmask) >> Gshift));
+			Uint32 preMultB = (alpha * ((color & Bmask) >> Bshift));
 
+			for (; n > 0; n--, pixel++) {
+				dc = *pixel;
 				surfaceAlpha = ((dc & Amask) >> Ashift);
 				aTmp = (255 - alpha);
 				if (A = 255 - ((aTmp * (255 - surfaceAlpha)) >> 8 )) {
@@ -758,13 +829,85 @@ int _filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16
 					B = (preMultB + ((aTmp * ((dc & Bmask) >> Bshift)) >> 8)) / A << Bshift & Bmask;
 				}
 				*pixel = R | G | B | (A << Ashift & Amask);
-
 			}
 		}
-		   }
-		   break;
+		break;
 #endif
+	}
+}
+
+/*!
+\brief Internal function to draw a horizontal span of the span color - no locking.
+
+Fills the span if the color is opaque, else blends it.
+
+\param span The span state.
+\param x1 X coordinate of the first point of the span.
+\param x2 X coordinate of the second point of the span.
+\param y Y coordinate of the span.
+
+\returns Returns 0.
+*/
+static int _gfxSpanHLine(const SDL_gfxSpan *span, Sint16 x1, Sint16 x2, Sint16 y)
+{
+	SDL_Surface *dst = span->dst;
+	Sint16 left, right, xtmp;
+
+	/*
+	* Swap x1, x2 if required to ensure x1<=x2
+	*/
+	if (x1 > x2) {
+		xtmp = x1;
+		x1 = x2;
+		x2 = xtmp;
+	}
+
+	/*
+	* Clip 
+	*/
+	left = clip_xmin(dst);
+	right = clip_xmax(dst);
+	if ((x2 < left) || (x1 > right) || (y < clip_ymin(dst)) || (y > clip_ymax(dst))) {
+		return (0);
+	}
+	if (x1 < left) {
+		x1 = left;
+	}
+	if (x2 > right) {
+		x2 = right;
+	}
+
+	if (span->alpha == 255) {
+		_gfxSpanFill(span, x1, x2, y);
+	} else {
+		_gfxSpanBlend(span, x1, x2, y);
+	}
+	return (0);
+}
+
+/*!
+\brief Internal function to draw filled rectangle with alpha blending.
+
+Assumes color is in destination format.
+
+\param dst The surface to draw on.
+\param x1 X coordinate of the first corner (upper left) of the rectangle.
+\param y1 Y coordinate of the first corner (upper left) of the rectangle.
+\param x2 X coordinate of the second corner (lower right) of the rectangle.
+\param y2 Y coordinate of the second corner (lower right) of the rectangle.
+\param color The color value of the rectangle to draw (0xRRGGBBAA). 
+\param alpha Alpha blending amount for pixels.
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int _filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color, Uint8 alpha)
+{
+	SDL_gfxSpan span;
+	Sint16 y;
 
+	_gfxSpanMapped(&span, dst, color, alpha);
+	for (y = y1; y <= y2; y++) {
+		_gfxSpanBlend(&span, x1, x2, y);
 	}
 
 	return (0);
@@ -1132,14 +1275,8 @@ int hlineRGBAStore(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint8 r, U
 */
 int hlineColor(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
 {
-	Sint16 left, right, top, bottom;
-	Uint8 *pixel, *pixellast;
-	int dx;
-	int pixx, pixy;
-	Sint16 xtmp;
-	int result = -1;
-	Uint8 *colorptr;
-	Uint8 color3[3];
+	SDL_gfxSpan span;
+	int result;
 
 	/*
 	* Check visibility of clipping rectangle
@@ -1149,144 +1286,32 @@ int hlineColor(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
 	}
 
 	/*
-	* Swap x1, x2 if required to ensure x1<=x2
+	* Lock the surface 
 	*/
-	if (x1 > x2) {
-		xtmp = x1;
-		x1 = x2;
-		x2 = xtmp;
+	if (SDL_MUSTLOCK(dst)) {
+		if (SDL_LockSurface(dst) < 0) {
+			return (-1);
+		}
 	}
 
 	/*
-	* Get clipping boundary and
-	* check visibility of hline 
+	* Draw, filling or blending the clipped span 
 	*/
-	left = dst->clip_rect.x;
-	if (x2<left) {
-		return(0);
-	}
-	right = dst->clip_rect.x + dst->clip_rect.w - 1;
-	if (x1>right) {
-		return(0);
-	}
-	top = dst->clip_rect.y;
-	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
-	if ((y<top) || (y>bottom)) {
-		return (0);
-	}
+	_gfxSpanSetup(&span, dst, color);
+	result = _gfxSpanHLine(&span, x1, x2, y);
 
 	/*
-	* Clip x 
+	* Unlock the surface 
 	*/
-	if (x1 < left) {
-		x1 = left;
-	}
-	if (x2 > right) {
-		x2 = right;
+	if (SDL_MUSTLOCK(dst)) {
+		SDL_UnlockSurface(dst);
 	}
 
-	/*
-	* Calculate width difference
-	*/
-	dx = x2 - x1;
-
-	/*
-	* Alpha check 
-	*/
-	if ((color & 255) == 255) {
+	return (result);
+}
 
-		/*
-		* No alpha-blending required 
-		*/
-
-		/*
-		* Setup color 
-		*/
-		colorptr = (Uint8 *) & color;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color = SDL_MapRGBA(dst->format, colorptr[0], colorptr[1], colorptr[2], colorptr[3]);
-		} else {
-			color = SDL_MapRGBA(dst->format, colorptr[3], colorptr[2], colorptr[1], colorptr[0]);
-		}
-
-		/*
-		* Lock the surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			if (SDL_LockSurface(dst) < 0) {
-				return (-1);
-			}
-		}
-
-		/*
-		* More variable setup 
-		*/
-		pixx = dst->format->BytesPerPixel;
-		pixy = dst->pitch;
-		pixel = ((Uint8 *) dst->pixels) + pixx * (int) x1 + pixy * (int) y;
-
-		/*
-		* Draw 
-		*/
-		switch (dst->format->BytesPerPixel) {
-	case 1:
-		memset(pixel, color, dx + 1);
-		break;
-	case 2:
-		pixellast = pixel + dx + dx;
-		for (; pixel <= pixellast; pixel += pixx) {
-			*(Uint16 *) pixel = color;
-		}
-		break;
-	case 3:
-		pixellast = pixel + dx + dx + dx;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color3[0] = (color >> 16) & 0xff;
-			color3[1] = (color >> 8) & 0xff;
-			color3[2] = color & 0xff;
-		} else {
-			color3[0] = color & 0xff;
-			color3[1] = (color >> 8) & 0xff;
-			color3[2] = (color >> 16) & 0xff;
-		}
-		for (; pixel <= pixellast; pixel += pixx) {
-			memcpy(pixel, color3, 3);
-		}
-		break;
-	default:		/* case 4 */
-		dx = dx + dx;
-		pixellast = pixel + dx + dx;
-		for (; pixel <= pixellast; pixel += pixx) {
-			*(Uint32 *) pixel = color;
-		}
-		break;
-		}
-
-		/* 
-		* Unlock surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			SDL_UnlockSurface(dst);
-		}
-
-		/*
-		* Set result code 
-		*/
-		result = 0;
-
-	} else {
-
-		/*
-		* Alpha blending blit 
-		*/
-		result = _HLineAlpha(dst, x1, x1 + dx, y, color);
-	}
-
-	return (result);
-}
-
-/*!
-\brief Draw horizontal line with blending.
+/*!
+\brief Draw horizontal line with blending.
 
 \param dst The surface to draw on.
 \param x1 X coordinate of the first point (i.e. left) of the line.
@@ -2283,6 +2308,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 	int swaptmp;
 	Uint8 *pixel;
 	Uint8 *colorptr;
+	SDL_gfxSpan span;
 
 	/*
 	* Clip line and test if we have to draw 
@@ -2423,8 +2449,11 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 	} else {
 
 		/*
-		* Alpha blending required - use single-pixel blits 
+		* Alpha blending required - blend single-pixel spans of the
+		* color set up once, as pixelColorNolock() would 
 		*/
+		_gfxSpanSetup(&span, dst, color);
+		span.blendalpha = 1;
 
 		ax = ABS(dx) << 1;
 		ay = ABS(dy) << 1;
@@ -2434,7 +2463,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 			int d = ay - (ax >> 1);
 
 			while (x != x2) {
-				pixelColorNolock (dst, x, y, color);
+				_gfxSpanHLine(&span, x, x, y);
 				if (d > 0 || (d == 0 && sx == 1)) {
 					y += sy;
 					d -= ax;
@@ -2446,7 +2475,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 			int d = ax - (ay >> 1);
 
 			while (y != y2) {
-				pixelColorNolock (dst, x, y, color);
+				_gfxSpanHLine(&span, x, x, y);
 				if (d > 0 || ((d == 0) && (sy == 1))) {
 					x += sx;
 					d -= ay;
@@ -2455,7 +2484,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 				d += ax;
 			}
 		}
-		pixelColorNolock (dst, x, y, color);
+		_gfxSpanHLine(&span, x, x, y);
 
 	}
 
@@ -3422,6 +3451,210 @@ int arcRGBA(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Sint16 start, Sin
 	return (arcColor(dst, x, y, rad, start, end, ((Uint32) r << 24) | ((Uint32) g << 16) | ((Uint32) b << 8) | (Uint32) a));
 }
 
+/* ----- Shapes */
+
+/* Number of shape items recorded on the stack by the shape based primitives */
+#define GFX_SHAPE_STACK_ITEMS 512
+
+/*!
+\brief Internal function to start recording a shape into a caller provided buffer.
+
+\param shape The shape to initialize.
+\param items Buffer for the first items of the shape, or NULL.
+\param size Number of items that fit into the buffer.
+\param rx Horizontal radius used for the visibility test of the shape.
+\param ry Vertical radius used for the visibility test of the shape.
+*/
+static void _shapeInit(SDL_gfxShape *shape, SDL_gfxShapeItem *items, int size, Sint16 rx, Sint16 ry)
+{
+	shape->items = items;
+	shape->n = 0;
+	shape->size = items ? size : 0;
+	shape->owned = 0;
+	shape->rx = rx;
+	shape->ry = ry;
+}
+
+/*!
+\brief Internal function to append a span or a weighted pixel to a shape.
+
+\param shape The shape to append to.
+\param x1 X coordinate of the first point of the span, or of the pixel.
+\param x2 X coordinate of the second point of the span.
+\param y Y coordinate of the span or pixel.
+\param weight The alpha weight of a pixel (0 to 256), or SDL_GFX_SHAPE_SPAN.
+
+\returns Returns 0 on success, -1 if the shape could not grow.
+*/
+static int _shapeAdd(SDL_gfxShape *shape, Sint16 x1, Sint16 x2, Sint16 y, Uint16 weight)
+{
+	SDL_gfxShapeItem *items, *item;
+	int size;
+
+	/*
+	* Grow the item array, leaving a caller provided buffer alone 
+	*/
+	if (shape->n == shape->size) {
+		size = (shape->size > 0) ? 2 * shape->size : 64;
+		if (shape->owned) {
+			items = (SDL_gfxShapeItem *) realloc(shape->items, sizeof(SDL_gfxShapeItem) * size);
+		} else {
+			items = (SDL_gfxShapeItem *) malloc(sizeof(SDL_gfxShapeItem) * size);
+			if ((items != NULL) && (shape->n > 0)) {
+				memcpy(items, shape->items, sizeof(SDL_gfxShapeItem) * shape->n);
+			}
+		}
+		if (items == NULL) {
+			return (-1);
+		}
+		shape->items = items;
+		shape->size = size;
+		shape->owned = 1;
+	}
+
+	item = &shape->items[shape->n++];
+	item->x1 = x1;
+	item->x2 = x2;
+	item->y = y;
+	item->weight = weight;
+	return (0);
+}
+
+/*!
+\brief Internal function to draw the items of a shape on a locked surface.
+
+Spans are drawn like hlineColor() and weighted pixels like pixelColorWeightNolock(),
+with the color mapped to the destination format only once.
+
+\param dst The surface to draw on.
+\param shape The shape to draw.
+\param x X coordinate of the center of the shape.
+\param y Y coordinate of the center of the shape.
+\param color The color value of the shape to draw (0xRRGGBBAA). 
+
+\returns Returns 0.
+*/
+static int _shapeDraw(SDL_Surface *dst, const SDL_gfxShape *shape, Sint16 x, Sint16 y, Uint32 color)
+{
+	SDL_PixelFormat *format = dst->format;
+	SDL_gfxSpan span, pixel;
+	const SDL_gfxShapeItem *item = shape->items;
+	const SDL_gfxShapeItem *last = item + shape->n;
+	Uint8 alpha = color & 0x000000ff;
+	Uint32 rgb;
+
+	_gfxSpanSetup(&span, dst, color);
+	pixel = span;
+	pixel.blendalpha = 1;
+	rgb = span.color & ~format->Amask;
+
+	for (; item < last; item++) {
+		if (item->weight == SDL_GFX_SHAPE_SPAN) {
+			_gfxSpanHLine(&span, x + item->x1, x + item->x2, y + item->y);
+		} else {
+			/*
+			* Only the alpha bits of the mapped color depend on the weight 
+			*/
+			pixel.alpha = (alpha * item->weight) >> 8;
+			pixel.color = rgb | ((((Uint32) pixel.alpha >> format->Aloss) << format->Ashift) & format->Amask);
+			_gfxSpanHLine(&pixel, x + item->x1, x + item->x1, y + item->y);
+		}
+	}
+
+	return (0);
+}
+
+/*!
+\brief Draw a recorded shape with blending.
+
+Draws exactly what the primitive that recorded the shape would draw at the given
+center, but without recomputing the outline. The shape can be drawn any number of
+times and from several threads at once.
+
+\param dst The surface to draw on.
+\param shape The shape to draw, recorded by filledCircleShape(), filledEllipseShape() or aaellipseShape().
+\param x X coordinate of the center of the shape.
+\param y Y coordinate of the center of the shape.
+\param color The color value of the shape to draw (0xRRGGBBAA). 
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int shapeColor(SDL_Surface * dst, const SDL_gfxShape * shape, Sint16 x, Sint16 y, Uint32 color)
+{
+	Sint16 left, right, top, bottom;
+	Sint16 x1, y1, x2, y2;
+
+	/*
+	* Check visibility of clipping rectangle
+	*/
+	if ((dst->clip_rect.w==0) || (dst->clip_rect.h==0)) {
+		return(0);
+	}
+
+	/*
+	* Get shape and clipping boundary and 
+	* test if bounding box of shape is visible 
+	*/
+	x2 = x + shape->rx;
+	left = dst->clip_rect.x;
+	if (x2<left) {
+		return(0);
+	} 
+	x1 = x - shape->rx;
+	right = dst->clip_rect.x + dst->clip_rect.w - 1;
+	if (x1>right) {
+		return(0);
+	} 
+	y2 = y + shape->ry;
+	top = dst->clip_rect.y;
+	if (y2<top) {
+		return(0);
+	} 
+	y1 = y - shape->ry;
+	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
+	if (y1>bottom) {
+		return(0);
+	} 
+
+	/*
+	* Lock the surface 
+	*/
+	if (SDL_MUSTLOCK(dst)) {
+		if (SDL_LockSurface(dst) < 0) {
+			return (-1);
+		}
+	}
+
+	_shapeDraw(dst, shape, x, y, color);
+
+	/*
+	* Unlock the surface 
+	*/
+	if (SDL_MUSTLOCK(dst)) {
+		SDL_UnlockSurface(dst);
+	}
+
+	return (0);
+}
+
+/*!
+\brief Free the items of a recorded shape.
+
+The shape is left empty and can be recorded again.
+
+\param shape The shape to free.
+*/
+void freeShape(SDL_gfxShape * shape)
+{
+	if (shape->owned) {
+		free(shape->items);
+	}
+	shape->items = NULL;
+	shape->n = 0;
+	shape->size = 0;
+	shape->owned = 0;
+}
+
 /* ----- AA Circle */
 
 
@@ -3468,6 +3701,92 @@ int aacircleRGBA(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint8 r, Uin
 
 /* ----- Filled Circle */
 
+/*!
+\brief Record the spans of a filled circle.
+
+The spans are recorded around (0,0), replacing any previous items of the shape,
+and can be drawn at any center with shapeColor().
+
+Note: Based on algorithms from sge library with modifications by A. Schiffler for
+multiple-hline draw removal and other minor speedup changes.
+
+\param shape The shape to record into.
+\param rad Radius in pixels of the filled circle.
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int filledCircleShape(SDL_gfxShape * shape, Sint16 rad)
+{
+	int result;
+	Sint16 cx = 0;
+	Sint16 cy = rad;
+	Sint16 ocx = (Sint16) 0xffff;
+	Sint16 ocy = (Sint16) 0xffff;
+	Sint16 df = 1 - rad;
+	Sint16 d_e = 3;
+	Sint16 d_se = -2 * rad + 5;
+
+	/*
+	* Sanity check radius 
+	*/
+	if (rad < 0) {
+		return (-1);
+	}
+	shape->n = 0;
+	shape->rx = rad;
+	shape->ry = rad;
+
+	/*
+	* Special case for rad=0 - a point 
+	*/
+	if (rad == 0) {
+		return (_shapeAdd(shape, 0, 0, 0, 256));
+	}
+
+	/*
+	* Record 
+	*/
+	result = 0;
+	do {
+		if (ocy != cy) {
+			if (cy > 0) {
+				result |= _shapeAdd(shape, -cx, cx, cy, SDL_GFX_SHAPE_SPAN);
+				result |= _shapeAdd(shape, -cx, cx, -cy, SDL_GFX_SHAPE_SPAN);
+			} else {
+				result |= _shapeAdd(shape, -cx, cx, 0, SDL_GFX_SHAPE_SPAN);
+			}
+			ocy = cy;
+		}
+		if (ocx != cx) {
+			if (cx != cy) {
+				if (cx > 0) {
+					result |= _shapeAdd(shape, -cy, cy, -cx, SDL_GFX_SHAPE_SPAN);
+					result |= _shapeAdd(shape, -cy, cy, cx, SDL_GFX_SHAPE_SPAN);
+				} else {
+					result |= _shapeAdd(shape, -cy, cy, 0, SDL_GFX_SHAPE_SPAN);
+				}
+			}
+			ocx = cx;
+		}
+		/*
+		* Update 
+		*/
+		if (df < 0) {
+			df += d_e;
+			d_e += 2;
+			d_se += 2;
+		} else {
+			df += d_se;
+			d_e += 2;
+			d_se += 4;
+			cy--;
+		}
+		cx++;
+	} while (cx <= cy);
+
+	return (result);
+}
+
 /*!
 \brief Draw filled circle with blending.
 
@@ -3486,16 +3805,9 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 {
 	Sint16 left, right, top, bottom;
 	int result;
+	SDL_gfxShapeItem items[GFX_SHAPE_STACK_ITEMS];
+	SDL_gfxShape shape;
 	Sint16 x1, y1, x2, y2;
-	Sint16 cx = 0;
-	Sint16 cy = rad;
-	Sint16 ocx = (Sint16) 0xffff;
-	Sint16 ocy = (Sint16) 0xffff;
-	Sint16 df = 1 - rad;
-	Sint16 d_e = 3;
-	Sint16 d_se = -2 * rad + 5;
-	Sint16 xpcx, xmcx, xpcy, xmcy;
-	Sint16 ypcy, ymcy, ypcx, ymcx;
 
 	/*
 	* Check visibility of clipping rectangle
@@ -3544,53 +3856,23 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 	} 
 
 	/*
-	* Draw 
+	* Record the spans, then draw them with the color set up once 
 	*/
-	result = 0;
-	do {
-		xpcx = x + cx;
-		xmcx = x - cx;
-		xpcy = x + cy;
-		xmcy = x - cy;
-		if (ocy != cy) {
-			if (cy > 0) {
-				ypcy = y + cy;
-				ymcy = y - cy;
-				result |= hlineColor(dst, xmcx, xpcx, ypcy, color);
-				result |= hlineColor(dst, xmcx, xpcx, ymcy, color);
-			} else {
-				result |= hlineColor(dst, xmcx, xpcx, y, color);
-			}
-			ocy = cy;
-		}
-		if (ocx != cx) {
-			if (cx != cy) {
-				if (cx > 0) {
-					ypcx = y + cx;
-					ymcx = y - cx;
-					result |= hlineColor(dst, xmcy, xpcy, ymcx, color);
-					result |= hlineColor(dst, xmcy, xpcy, ypcx, color);
-				} else {
-					result |= hlineColor(dst, xmcy, xpcy, y, color);
-				}
+	_shapeInit(&shape, items, GFX_SHAPE_STACK_ITEMS, rad, rad);
+	result = filledCircleShape(&shape, rad);
+	if (result == 0) {
+		if (SDL_MUSTLOCK(dst)) {
+			if (SDL_LockSurface(dst) < 0) {
+				freeShape(&shape);
+				return (-1);
 			}
-			ocx = cx;
 		}
-		/*
-		* Update 
-		*/
-		if (df < 0) {
-			df += d_e;
-			d_e += 2;
-			d_se += 2;
-		} else {
-			df += d_se;
-			d_e += 2;
-			d_se += 4;
-			cy--;
+		result = _shapeDraw(dst, &shape, x, y, color);
+		if (SDL_MUSTLOCK(dst)) {
+			SDL_UnlockSurface(dst);
 		}
-		cx++;
-	} while (cx <= cy);
+	}
+	freeShape(&shape);
 
 	return (result);
 }
@@ -4000,83 +4282,56 @@ lrint (double flt)
 #endif
 
 /*!
-\brief Draw anti-aliased ellipse with blending.
+\brief Record the weighted pixels of an anti-aliased ellipse.
+
+The pixels are recorded around (0,0), replacing any previous items of the shape,
+and can be drawn at any center with shapeColor().
 
 Note: Based on code from Anders Lindstroem, which is based on code from sge library, 
 which is based on code from TwinLib.
 
-\param dst The surface to draw on.
-\param x X coordinate of the center of the aa-ellipse.
-\param y Y coordinate of the center of the aa-ellipse.
+\param shape The shape to record into.
 \param rx Horizontal radius in pixels of the aa-ellipse.
 \param ry Vertical radius in pixels of the aa-ellipse.
-\param color The color value of the aa-ellipse to draw (0xRRGGBBAA). 
 
 \returns Returns 0 on success, -1 on failure.
 */
-int aaellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint32 color)
+int aaellipseShape(SDL_gfxShape * shape, Sint16 rx, Sint16 ry)
 {
-	Sint16 left, right, top, bottom;
-	Sint16 x1,y1,x2,y2;
 	int i;
 	int a2, b2, ds, dt, dxt, t, s, d;
-	Sint16 xp, yp, xs, ys, dyt, od, xx, yy, xc2, yc2;
+	Sint16 xp, yp, xs, ys, dyt, od, xx, yy;
 	float cp;
 	double sab;
 	Uint8 weight, iweight;
 	int result;
 
-	/*
-	* Check visibility of clipping rectangle
-	*/
-	if ((dst->clip_rect.w==0) || (dst->clip_rect.h==0)) {
-		return(0);
-	}
-
 	/*
 	* Sanity check radii 
 	*/
 	if ((rx < 0) || (ry < 0)) {
 		return (-1);
-	}
-
-	/*
-	* Special case for rx=0 - draw a vline 
-	*/
-	if (rx == 0) {
-		return (vlineColor(dst, x, y - ry, y + ry, color));
-	}
-	/*
-	* Special case for ry=0 - draw an hline 
-	*/
-	if (ry == 0) {
-		return (hlineColor(dst, x - rx, x + rx, y, color));
-	}
-
-	/*
-	* Get circle and clipping boundary and 
-	* test if bounding box of circle is visible 
-	*/
-	x2 = x + rx;
-	left = dst->clip_rect.x;
-	if (x2<left) {
-		return(0);
-	} 
-	x1 = x - rx;
-	right = dst->clip_rect.x + dst->clip_rect.w - 1;
-	if (x1>right) {
-		return(0);
-	} 
-	y2 = y + ry;
-	top = dst->clip_rect.y;
-	if (y2<top) {
-		return(0);
-	} 
-	y1 = y - ry;
-	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
-	if (y1>bottom) {
-		return(0);
-	} 
+	}
+	shape->n = 0;
+	shape->rx = rx;
+	shape->ry = ry;
+
+	/*
+	* Special case for rx=0 - a vline, as one pixel wide spans 
+	*/
+	if (rx == 0) {
+		result = 0;
+		for (i = -ry; i <= ry; i++) {
+			result |= _shapeAdd(shape, 0, 0, i, SDL_GFX_SHAPE_SPAN);
+		}
+		return (result);
+	}
+	/*
+	* Special case for ry=0 - a hline 
+	*/
+	if (ry == 0) {
+		return (_shapeAdd(shape, -rx, rx, 0, SDL_GFX_SHAPE_SPAN));
+	}
 
 	/* Variable setup */
 	a2 = rx * rx;
@@ -4085,9 +4340,6 @@ int aaellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry,
 	ds = 2 * a2;
 	dt = 2 * b2;
 
-	xc2 = 2 * x;
-	yc2 = 2 * y;
-
 	sab = sqrt((double)(a2 + b2));
 	od = (Sint16)lrint(sab*0.01) + 1; /* introduce some overdraw */
 	dxt = (Sint16)lrint((double)a2 / sab) + od;
@@ -4096,24 +4348,17 @@ int aaellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry,
 	s = -2 * a2 * ry;
 	d = 0;
 
-	xp = x;
-	yp = y - ry;
-
-	/* Lock surface */
-	if (SDL_MUSTLOCK(dst)) {
-		if (SDL_LockSurface(dst) < 0) {
-			return (-1);
-		}
-	}
+	xp = 0;
+	yp = -ry;
 
-	/* Draw */
+	/* Record */
 	result = 0;
 
 	/* "End points" */
-	result |= pixelColorNolock(dst, xp, yp, color);
-	result |= pixelColorNolock(dst, xc2 - xp, yp, color);
-	result |= pixelColorNolock(dst, xp, yc2 - yp, color);
-	result |= pixelColorNolock(dst, xc2 - xp, yc2 - yp, color);
+	result |= _shapeAdd(shape, xp, xp, yp, 256);
+	result |= _shapeAdd(shape, -xp, -xp, yp, 256);
+	result |= _shapeAdd(shape, xp, xp, -yp, 256);
+	result |= _shapeAdd(shape, -xp, -xp, -yp, 256);
 
 	for (i = 1; i <= dxt; i++) {
 		xp--;
@@ -4154,21 +4399,21 @@ int aaellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry,
 		iweight = 255 - weight;
 
 		/* Upper half */
-		xx = xc2 - xp;
-		result |= pixelColorWeightNolock(dst, xp, yp, color, iweight);
-		result |= pixelColorWeightNolock(dst, xx, yp, color, iweight);
+		xx = -xp;
+		result |= _shapeAdd(shape, xp, xp, yp, iweight);
+		result |= _shapeAdd(shape, xx, xx, yp, iweight);
 
-		result |= pixelColorWeightNolock(dst, xp, ys, color, weight);
-		result |= pixelColorWeightNolock(dst, xx, ys, color, weight);
+		result |= _shapeAdd(shape, xp, xp, ys, weight);
+		result |= _shapeAdd(shape, xx, xx, ys, weight);
 
 		/* Lower half */
-		yy = yc2 - yp;
-		result |= pixelColorWeightNolock(dst, xp, yy, color, iweight);
-		result |= pixelColorWeightNolock(dst, xx, yy, color, iweight);
+		yy = -yp;
+		result |= _shapeAdd(shape, xp, xp, yy, iweight);
+		result |= _shapeAdd(shape, xx, xx, yy, iweight);
 
-		yy = yc2 - ys;
-		result |= pixelColorWeightNolock(dst, xp, yy, color, weight);
-		result |= pixelColorWeightNolock(dst, xx, yy, color, weight);
+		yy = -ys;
+		result |= _shapeAdd(shape, xp, xp, yy, weight);
+		result |= _shapeAdd(shape, xx, xx, yy, weight);
 	}
 
 	/* Replaces original approximation code dyt = abs(yp - yc); */
@@ -4213,89 +4458,49 @@ int aaellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry,
 		iweight = 255 - weight;
 
 		/* Left half */
-		xx = xc2 - xp;
-		yy = yc2 - yp;
-		result |= pixelColorWeightNolock(dst, xp, yp, color, iweight);
-		result |= pixelColorWeightNolock(dst, xx, yp, color, iweight);
+		xx = -xp;
+		yy = -yp;
+		result |= _shapeAdd(shape, xp, xp, yp, iweight);
+		result |= _shapeAdd(shape, xx, xx, yp, iweight);
 
-		result |= pixelColorWeightNolock(dst, xp, yy, color, iweight);
-		result |= pixelColorWeightNolock(dst, xx, yy, color, iweight);
+		result |= _shapeAdd(shape, xp, xp, yy, iweight);
+		result |= _shapeAdd(shape, xx, xx, yy, iweight);
 
 		/* Right half */
-		xx = xc2 - xs;
-		result |= pixelColorWeightNolock(dst, xs, yp, color, weight);
-		result |= pixelColorWeightNolock(dst, xx, yp, color, weight);
+		xx = -xs;
+		result |= _shapeAdd(shape, xs, xs, yp, weight);
+		result |= _shapeAdd(shape, xx, xx, yp, weight);
 
-		result |= pixelColorWeightNolock(dst, xs, yy, color, weight);
-		result |= pixelColorWeightNolock(dst, xx, yy, color, weight);
+		result |= _shapeAdd(shape, xs, xs, yy, weight);
+		result |= _shapeAdd(shape, xx, xx, yy, weight);
 
 	}
 
-	/* Unlock surface */
-	if (SDL_MUSTLOCK(dst)) {
-		SDL_UnlockSurface(dst);
-	}
-
 	return (result);
 }
 
 /*!
 \brief Draw anti-aliased ellipse with blending.
 
+Note: Based on code from Anders Lindstroem, which is based on code from sge library, 
+which is based on code from TwinLib.
+
 \param dst The surface to draw on.
 \param x X coordinate of the center of the aa-ellipse.
 \param y Y coordinate of the center of the aa-ellipse.
 \param rx Horizontal radius in pixels of the aa-ellipse.
 \param ry Vertical radius in pixels of the aa-ellipse.
-\param r The red value of the aa-ellipse to draw. 
-\param g The green value of the aa-ellipse to draw. 
-\param b The blue value of the aa-ellipse to draw. 
-\param a The alpha value of the aa-ellipse to draw.
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int aaellipseRGBA(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
-{
-	/*
-	* Draw 
-	*/
-	return (aaellipseColor
-		(dst, x, y, rx, ry, ((Uint32) r << 24) | ((Uint32) g << 16) | ((Uint32) b << 8) | (Uint32) a));
-}
-
-/* ---- Filled Ellipse */
-
-/* Note: */
-/* Based on algorithm from sge library with multiple-hline draw removal */
-/* and other speedup changes. */
-
-/*!
-\brief Draw filled ellipse with blending.
-
-Note: Based on algorithm from sge library with multiple-hline draw removal
-and other speedup changes.
-
-\param dst The surface to draw on.
-\param x X coordinate of the center of the filled ellipse.
-\param y Y coordinate of the center of the filled ellipse.
-\param rx Horizontal radius in pixels of the filled ellipse.
-\param ry Vertical radius in pixels of the filled ellipse.
-\param color The color value of the filled ellipse to draw (0xRRGGBBAA). 
+\param color The color value of the aa-ellipse to draw (0xRRGGBBAA). 
 
 \returns Returns 0 on success, -1 on failure.
 */
-int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint32 color)
+int aaellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint32 color)
 {
 	Sint16 left, right, top, bottom;
+	Sint16 x1,y1,x2,y2;
+	SDL_gfxShapeItem items[GFX_SHAPE_STACK_ITEMS];
+	SDL_gfxShape shape;
 	int result;
-	Sint16 x1, y1, x2, y2;
-	int ix, iy;
-	int h, i, j, k;
-	int oh, oi, oj, ok;
-	int xmh, xph;
-	int xmi, xpi;
-	int xmj, xpj;
-	int xmk, xpk;
 
 	/*
 	* Check visibility of clipping rectangle
@@ -4318,7 +4523,7 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 		return (vlineColor(dst, x, y - ry, y + ry, color));
 	}
 	/*
-	* Special case for ry=0 - draw a hline 
+	* Special case for ry=0 - draw an hline 
 	*/
 	if (ry == 0) {
 		return (hlineColor(dst, x - rx, x + rx, y, color));
@@ -4349,13 +4554,114 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 		return(0);
 	} 
 
+	/*
+	* Record the pixels, then draw them with the color set up once 
+	*/
+	_shapeInit(&shape, items, GFX_SHAPE_STACK_ITEMS, rx, ry);
+	result = aaellipseShape(&shape, rx, ry);
+	if (result == 0) {
+		if (SDL_MUSTLOCK(dst)) {
+			if (SDL_LockSurface(dst) < 0) {
+				freeShape(&shape);
+				return (-1);
+			}
+		}
+		result = _shapeDraw(dst, &shape, x, y, color);
+		if (SDL_MUSTLOCK(dst)) {
+			SDL_UnlockSurface(dst);
+		}
+	}
+	freeShape(&shape);
+
+	return (result);
+}
+
+/*!
+\brief Draw anti-aliased ellipse with blending.
+
+\param dst The surface to draw on.
+\param x X coordinate of the center of the aa-ellipse.
+\param y Y coordinate of the center of the aa-ellipse.
+\param rx Horizontal radius in pixels of the aa-ellipse.
+\param ry Vertical radius in pixels of the aa-ellipse.
+\param r The red value of the aa-ellipse to draw. 
+\param g The green value of the aa-ellipse to draw. 
+\param b The blue value of the aa-ellipse to draw. 
+\param a The alpha value of the aa-ellipse to draw.
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int aaellipseRGBA(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	/*
+	* Draw 
+	*/
+	return (aaellipseColor
+		(dst, x, y, rx, ry, ((Uint32) r << 24) | ((Uint32) g << 16) | ((Uint32) b << 8) | (Uint32) a));
+}
+
+/* ---- Filled Ellipse */
+
+/* Note: */
+/* Based on algorithm from sge library with multiple-hline draw removal */
+/* and other speedup changes. */
+
+/*!
+\brief Record the spans of a filled ellipse.
+
+The spans are recorded around (0,0), replacing any previous items of the shape,
+and can be drawn at any center with shapeColor().
+
+Note: Based on algorithm from sge library with multiple-hline draw removal
+and other speedup changes.
+
+\param shape The shape to record into.
+\param rx Horizontal radius in pixels of the filled ellipse.
+\param ry Vertical radius in pixels of the filled ellipse.
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int filledEllipseShape(SDL_gfxShape * shape, Sint16 rx, Sint16 ry)
+{
+	int result;
+	int ix, iy;
+	int h, i, j, k;
+	int oh, oi, oj, ok;
+
+	/*
+	* Sanity check radii 
+	*/
+	if ((rx < 0) || (ry < 0)) {
+		return (-1);
+	}
+	shape->n = 0;
+	shape->rx = rx;
+	shape->ry = ry;
+
+	/*
+	* Special case for rx=0 - a vline, as one pixel wide spans 
+	*/
+	if (rx == 0) {
+		result = 0;
+		for (i = -ry; i <= ry; i++) {
+			result |= _shapeAdd(shape, 0, 0, i, SDL_GFX_SHAPE_SPAN);
+		}
+		return (result);
+	}
+	/*
+	* Special case for ry=0 - a hline 
+	*/
+	if (ry == 0) {
+		return (_shapeAdd(shape, -rx, rx, 0, SDL_GFX_SHAPE_SPAN));
+	}
+
 	/*
 	* Init vars 
 	*/
 	oh = oi = oj = ok = 0xFFFF;
 
 	/*
-	* Draw 
+	* Record 
 	*/
 	result = 0;
 	if (rx > ry) {
@@ -4369,24 +4675,20 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 			k = (i * ry) / rx;
 
 			if ((ok != k) && (oj != k)) {
-				xph = x + h;
-				xmh = x - h;
 				if (k > 0) {
-					result |= hlineColor(dst, xmh, xph, y + k, color);
-					result |= hlineColor(dst, xmh, xph, y - k, color);
+					result |= _shapeAdd(shape, -h, h, k, SDL_GFX_SHAPE_SPAN);
+					result |= _shapeAdd(shape, -h, h, -k, SDL_GFX_SHAPE_SPAN);
 				} else {
-					result |= hlineColor(dst, xmh, xph, y, color);
+					result |= _shapeAdd(shape, -h, h, 0, SDL_GFX_SHAPE_SPAN);
 				}
 				ok = k;
 			}
 			if ((oj != j) && (ok != j) && (k != j)) {
-				xmi = x - i;
-				xpi = x + i;
 				if (j > 0) {
-					result |= hlineColor(dst, xmi, xpi, y + j, color);
-					result |= hlineColor(dst, xmi, xpi, y - j, color);
+					result |= _shapeAdd(shape, -i, i, j, SDL_GFX_SHAPE_SPAN);
+					result |= _shapeAdd(shape, -i, i, -j, SDL_GFX_SHAPE_SPAN);
 				} else {
-					result |= hlineColor(dst, xmi, xpi, y, color);
+					result |= _shapeAdd(shape, -i, i, 0, SDL_GFX_SHAPE_SPAN);
 				}
 				oj = j;
 			}
@@ -4406,24 +4708,20 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 			k = (i * rx) / ry;
 
 			if ((oi != i) && (oh != i)) {
-				xmj = x - j;
-				xpj = x + j;
 				if (i > 0) {
-					result |= hlineColor(dst, xmj, xpj, y + i, color);
-					result |= hlineColor(dst, xmj, xpj, y - i, color);
+					result |= _shapeAdd(shape, -j, j, i, SDL_GFX_SHAPE_SPAN);
+					result |= _shapeAdd(shape, -j, j, -i, SDL_GFX_SHAPE_SPAN);
 				} else {
-					result |= hlineColor(dst, xmj, xpj, y, color);
+					result |= _shapeAdd(shape, -j, j, 0, SDL_GFX_SHAPE_SPAN);
 				}
 				oi = i;
 			}
 			if ((oh != h) && (oi != h) && (i != h)) {
-				xmk = x - k;
-				xpk = x + k;
 				if (h > 0) {
-					result |= hlineColor(dst, xmk, xpk, y + h, color);
-					result |= hlineColor(dst, xmk, xpk, y - h, color);
+					result |= _shapeAdd(shape, -k, k, h, SDL_GFX_SHAPE_SPAN);
+					result |= _shapeAdd(shape, -k, k, -h, SDL_GFX_SHAPE_SPAN);
 				} else {
-					result |= hlineColor(dst, xmk, xpk, y, color);
+					result |= _shapeAdd(shape, -k, k, 0, SDL_GFX_SHAPE_SPAN);
 				}
 				oh = h;
 			}
@@ -4440,6 +4738,103 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 /*!
 \brief Draw filled ellipse with blending.
 
+Note: Based on algorithm from sge library with multiple-hline draw removal
+and other speedup changes.
+
+\param dst The surface to draw on.
+\param x X coordinate of the center of the filled ellipse.
+\param y Y coordinate of the center of the filled ellipse.
+\param rx Horizontal radius in pixels of the filled ellipse.
+\param ry Vertical radius in pixels of the filled ellipse.
+\param color The color value of the filled ellipse to draw (0xRRGGBBAA). 
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint32 color)
+{
+	Sint16 left, right, top, bottom;
+	int result;
+	SDL_gfxShapeItem items[GFX_SHAPE_STACK_ITEMS];
+	SDL_gfxShape shape;
+	Sint16 x1, y1, x2, y2;
+
+	/*
+	* Check visibility of clipping rectangle
+	*/
+	if ((dst->clip_rect.w==0) || (dst->clip_rect.h==0)) {
+		return(0);
+	}
+
+	/*
+	* Sanity check radii 
+	*/
+	if ((rx < 0) || (ry < 0)) {
+		return (-1);
+	}
+
+	/*
+	* Special case for rx=0 - draw a vline 
+	*/
+	if (rx == 0) {
+		return (vlineColor(dst, x, y - ry, y + ry, color));
+	}
+	/*
+	* Special case for ry=0 - draw a hline 
+	*/
+	if (ry == 0) {
+		return (hlineColor(dst, x - rx, x + rx, y, color));
+	}
+
+	/*
+	* Get circle and clipping boundary and 
+	* test if bounding box of circle is visible 
+	*/
+	x2 = x + rx;
+	left = dst->clip_rect.x;
+	if (x2<left) {
+		return(0);
+	} 
+	x1 = x - rx;
+	right = dst->clip_rect.x + dst->clip_rect.w - 1;
+	if (x1>right) {
+		return(0);
+	} 
+	y2 = y + ry;
+	top = dst->clip_rect.y;
+	if (y2<top) {
+		return(0);
+	} 
+	y1 = y - ry;
+	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
+	if (y1>bottom) {
+		return(0);
+	} 
+
+	/*
+	* Record the spans, then draw them with the color set up once 
+	*/
+	_shapeInit(&shape, items, GFX_SHAPE_STACK_ITEMS, rx, ry);
+	result = filledEllipseShape(&shape, rx, ry);
+	if (result == 0) {
+		if (SDL_MUSTLOCK(dst)) {
+			if (SDL_LockSurface(dst) < 0) {
+				freeShape(&shape);
+				return (-1);
+			}
+		}
+		result = _shapeDraw(dst, &shape, x, y, color);
+		if (SDL_MUSTLOCK(dst)) {
+			SDL_UnlockSurface(dst);
+		}
+	}
+	freeShape(&shape);
+
+	return (result);
+}
+
+/*!
+\brief Draw filled ellipse with blending.
+
 \param dst The surface to draw on.
 \param x X coordinate of the center of the filled ellipse.
 \param y Y coordinate of the center of the filled ellipse.
@@ -5126,6 +5521,7 @@ Note: The last two parameters are optional; but are required for multithreaded o
 int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color, int **polyInts, int *polyAllocated)
 {
 	int result;
+	SDL_gfxSpan span;
 	int i;
 	int y, xa, xb;
 	int miny, maxy;
@@ -5234,6 +5630,16 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 		}
 	}
 
+	/*
+	* Lock the surface and set up the color once for all spans 
+	*/
+	if (SDL_MUSTLOCK(dst)) {
+		if (SDL_LockSurface(dst) < 0) {
+			return (-1);
+		}
+	}
+	_gfxSpanSetup(&span, dst, color);
+
 	/*
 	* Draw, scanning y 
 	*/
@@ -5273,10 +5679,17 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 			xa = (xa >> 16) + ((xa & 32768) >> 15);
 			xb = gfxPrimitivesPolyInts[i+1] - 1;
 			xb = (xb >> 16) + ((xb & 32768) >> 15);
-			result |= hlineColor(dst, xa, xb, y, color);
+			result |= _gfxSpanHLine(&span, xa, xb, y);
 		}
 	}
 
+	/*
+	* Unlock the surface 
+	*/
+	if (SDL_MUSTLOCK(dst)) {
+		SDL_UnlockSurface(dst);
+	}
+
 	return (result);
 }
 
@@ -27,6 +27,26 @@ extern "C" {
 #define SDL_GFXPRIMITIVES_MINOR	0
 #define SDL_GFXPRIMITIVES_MICRO	23
 
+	/* ---- Structures */
+
+	/* Weight of a shape item that is a span rather than a single pixel */
+
+#define SDL_GFX_SHAPE_SPAN	0xffff
+
+	/* A span from x1 to x2, or a pixel at x1 drawn with weight/256 of the alpha */
+
+	typedef struct {
+		Sint16 x1, x2, y;
+		Uint16 weight;
+	} SDL_gfxShapeItem;
+
+	/* The items of a shape around (0,0); a zeroed structure is an empty shape */
+
+	typedef struct {
+		SDL_gfxShapeItem *items;
+		int n, size, owned;
+		Sint16 rx, ry;		/* radii used for the visibility test */
+	} SDL_gfxShape;
 
 	/* ---- Function Prototypes */
 
@@ -119,6 +139,14 @@ extern "C" {
 	SDL_GFXPRIMITIVES_SCOPE int aacircleRGBA(SDL_Surface * dst, Sint16 x, Sint16 y,
 		Sint16 rad, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 
+	/* Shapes */
+
+	SDL_GFXPRIMITIVES_SCOPE int shapeColor(SDL_Surface * dst, const SDL_gfxShape * shape, Sint16 x, Sint16 y, Uint32 color);
+	SDL_GFXPRIMITIVES_SCOPE void freeShape(SDL_gfxShape * shape);
+	SDL_GFXPRIMITIVES_SCOPE int filledCircleShape(SDL_gfxShape * shape, Sint16 rad);
+	SDL_GFXPRIMITIVES_SCOPE int aaellipseShape(SDL_gfxShape * shape, Sint16 rx, Sint16 ry);
+	SDL_GFXPRIMITIVES_SCOPE int filledEllipseShape(SDL_gfxShape * shape, Sint16 rx, Sint16 ry);
+
 	/* Filled Circle */
 
 	SDL_GFXPRIMITIVES_SCOPE int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 r, Uint32 color);
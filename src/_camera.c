@@ -35,6 +35,8 @@
 
 #include "camera.h"
 #include "pgcompat.h"
+#include "pgcolorspace.h"
+#include "pgbufferproxy.h"
 
 /*
 #if defined(__unix__) || !defined(__APPLE__)
@@ -48,7 +50,7 @@
 /* functions available to pygame users */
 PyObject* surf_colorspace (PyObject* self, PyObject* arg);
 PyObject* list_cameras (PyObject* self, PyObject* arg);
-PyObject* camera_start (PyCameraObject* self);
+PyObject* camera_start (PyCameraObject* self, PyObject* arg, PyObject *kwds);
 PyObject* camera_stop (PyCameraObject* self);
 PyObject* camera_get_controls (PyCameraObject* self);
 PyObject* camera_set_controls (PyCameraObject* self, PyObject* arg, PyObject *kwds);
@@ -56,6 +58,13 @@ PyObject* camera_get_size (PyCameraObject* self);
 PyObject* camera_query_image (PyCameraObject* self);
 PyObject* camera_get_image (PyCameraObject* self, PyObject* arg);
 PyObject* camera_get_raw(PyCameraObject* self);
+PyObject* camera_get_capture_stats (PyCameraObject* self);
+PyObject* camera_get_frame_view (PyCameraObject* self);
+PyObject* camera_get_format (PyCameraObject* self);
+PyObject* camera_list_formats (PyCameraObject* self);
+PyObject* capture_set (PyObject* self, PyObject* arg, PyObject *kwds);
+
+extern PyTypeObject PyCamera_Type;
 
 /*
  * Functions available to pygame users.  The idea is to make these as simple as
@@ -97,6 +106,7 @@ PyObject* surf_colorspace (PyObject* self, PyObject* arg) {
         }
     } else {
         newsurf = PySurface_AsSurface (surfobj2);
+        PySurface_DropRLE (surfobj2);
     }
 
     /* check to see if the size is the same. */
@@ -162,8 +172,15 @@ PyObject* list_cameras (PyObject* self, PyObject* arg) {
 }
 
 /* start() - opens, inits, and starts capturing on the camera */
-PyObject* camera_start (PyCameraObject* self) {
+PyObject* camera_start (PyCameraObject* self, PyObject* arg, PyObject *kwds) {
+    int threaded = 0;
+    char *kwids[] = {"threaded", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "|i", kwids, &threaded))
+        return NULL;
 #if defined(__unix__)
+    if (self->capture_thread)
+        return RAISE (PyExc_SystemError, "the camera is already capturing");
     if (v4l2_open_device(self) == 0) {
         v4l2_close_device(self);
         return NULL;
@@ -177,6 +194,12 @@ PyObject* camera_start (PyCameraObject* self) {
             v4l2_close_device(self);
             return NULL;
         }
+        if (threaded && v4l2_start_thread(self) == 0) {
+            v4l2_stop_capturing(self);
+            v4l2_uninit_device(self);
+            v4l2_close_device(self);
+            return NULL;
+        }
     }
 #elif defined(PYGAME_MAC_CAMERA_OLD)
     if (! (mac_open_device(self) == 1 && mac_init_device(self) == 1 && mac_start_capturing(self) == 1)) {
@@ -190,6 +213,10 @@ PyObject* camera_start (PyCameraObject* self) {
 /* stop() - stops capturing, uninits, and closes the camera */
 PyObject* camera_stop (PyCameraObject* self) {
 #if defined(__unix__)
+    if (self->frame_views)
+        return RAISE (PyExc_SystemError,
+                      "the camera cannot stop while frame views are in use");
+    v4l2_stop_thread(self);
     if (v4l2_stop_capturing(self) == 0)
         return NULL;
     if (v4l2_uninit_device(self) == 0)
@@ -285,6 +312,8 @@ PyObject* camera_get_size (PyCameraObject* self) {
 /* query_image() - checks if a frame is ready */
 PyObject* camera_query_image(PyCameraObject* self) {
 #if defined(__unix__)
+    if (self->capture_thread)
+        return PyBool_FromLong(v4l2_query_thread(self));
     return PyBool_FromLong(v4l2_query_buffer(self));
 #endif
     Py_RETURN_TRUE;
@@ -305,6 +334,7 @@ PyObject* camera_get_image (PyCameraObject* self, PyObject* arg) {
                                  0xFF<<8, 0xFF, 0);
     } else {
         surf = PySurface_AsSurface (surfobj);
+        PySurface_DropRLE (surfobj);
     }
 
     if (!surf)
@@ -315,10 +345,20 @@ PyObject* camera_get_image (PyCameraObject* self, PyObject* arg) {
                       "Destination surface not the correct width or height.");
     }
 
-    Py_BEGIN_ALLOW_THREADS;
-    if (!v4l2_read_frame(self, surf))
-        return NULL;
-    Py_END_ALLOW_THREADS;
+    if (self->capture_thread) {
+        if (!v4l2_take_frame(self, surf)) {
+            if (!surfobj)
+                SDL_FreeSurface (surf);
+            return NULL;
+        }
+    } else {
+        if (!v4l2_release_frame(self))
+            return NULL;
+        Py_BEGIN_ALLOW_THREADS;
+        if (!v4l2_read_frame(self, surf))
+            return NULL;
+        Py_END_ALLOW_THREADS;
+    }
 
     if (!surf)
         return NULL;
@@ -349,6 +389,7 @@ PyObject* camera_get_image (PyCameraObject* self, PyObject* arg) {
 
         } else {
             surf = PySurface_AsSurface(surfobj);
+            PySurface_DropRLE(surfobj);
         }
 
         if (!surf)
@@ -380,6 +421,9 @@ PyObject* camera_get_image (PyCameraObject* self, PyObject* arg) {
 /* get_raw() - returns an unmodified image as a string from the buffer */
 PyObject* camera_get_raw(PyCameraObject* self) {
 #if defined(__unix__)
+    if (self->capture_thread)
+        return RAISE (PyExc_SystemError,
+                      "get_raw cannot be used while capturing on a thread");
     return v4l2_read_raw(self);
 #elif defined(PYGAME_MAC_CAMERA_OLD)
     return mac_read_raw(self);
@@ -387,6 +431,218 @@ PyObject* camera_get_raw(PyCameraObject* self) {
     Py_RETURN_NONE;
 }
 
+#if defined(__unix__)
+static char FormatUint8[] = "B";
+
+static void camera_release_frame_buffer (Py_buffer* view_p) {
+    PyCameraObject* self = (PyCameraObject*) view_p->obj;
+
+    self->frame_views--;
+    PyMem_Free (view_p->internal);
+    view_p->obj = NULL;
+    Py_DECREF (self);
+}
+
+/* exports the held buffer as a flat array of bytes */
+static int camera_get_frame_buffer (PyObject* obj, Py_buffer* view_p,
+                                    int flags) {
+    PyCameraObject* self = (PyCameraObject*) obj;
+    Py_ssize_t* internal;
+
+    view_p->obj = NULL;
+    if (self->view_index < 0) {
+        PyErr_SetString (PgExc_BufferError, "the camera frame has gone");
+        return -1;
+    }
+    if (PyBUF_HAS_FLAG (flags, PyBUF_WRITABLE)) {
+        PyErr_SetString (PgExc_BufferError, "camera frames are read-only");
+        return -1;
+    }
+    internal = PyMem_New (Py_ssize_t, 2);
+    if (!internal) {
+        PyErr_NoMemory ();
+        return -1;
+    }
+    view_p->buf = self->buffers[self->view_index].start;
+    view_p->len = (Py_ssize_t) self->view_length;
+    view_p->readonly = 1;
+    view_p->itemsize = 1;
+    view_p->format = PyBUF_HAS_FLAG (flags, PyBUF_FORMAT) ? FormatUint8 : NULL;
+    view_p->ndim = 1;
+    internal[0] = view_p->len;
+    internal[1] = 1;
+    view_p->shape = PyBUF_HAS_FLAG (flags, PyBUF_ND) ? internal : NULL;
+    view_p->strides = PyBUF_HAS_FLAG (flags, PyBUF_STRIDES) ? internal + 1
+                                                            : NULL;
+    view_p->suboffsets = NULL;
+    view_p->internal = internal;
+    ((Pg_buffer*) view_p)->release_buffer = camera_release_frame_buffer;
+    self->frame_views++;
+    Py_INCREF (obj);
+    view_p->obj = obj;
+    return 0;
+}
+#endif
+
+/* get_frame_view() - a BufferProxy of the next frame, as the driver wrote
+   it, without copying */
+PyObject* camera_get_frame_view (PyCameraObject* self) {
+#if defined(__unix__)
+    PyObject* proxy;
+
+    if (self->capture_thread)
+        return RAISE (PyExc_SystemError,
+                      "get_frame_view cannot be used while capturing on a "
+                      "thread");
+    if (self->fd == -1 || !self->buffers)
+        return RAISE (PyExc_SystemError, "the camera is not started");
+    if (!v4l2_hold_frame (self))
+        return NULL;
+    proxy = PgBufproxy_New ((PyObject*) self, camera_get_frame_buffer);
+    if (proxy && PgBufproxy_Trip (proxy)) {
+        Py_DECREF (proxy);
+        proxy = NULL;
+    }
+    return proxy;
+#else
+    return RAISE (PyExc_NotImplementedError,
+                  "get_frame_view is not available on this platform");
+#endif
+}
+
+/* get_format() - the pixelformat, size and frame rate being captured */
+PyObject* camera_get_format (PyCameraObject* self) {
+#if defined(__unix__)
+    return Py_BuildValue ("(N(ii)d)", v4l2_fourcc_string (self->pixelformat),
+                          self->width, self->height,
+                          self->fps_num ?
+                          (double) self->fps_den / self->fps_num : 0.0);
+#endif
+    Py_RETURN_NONE;
+}
+
+/* list_formats() - the pixelformats, sizes and frame rates of the device */
+PyObject* camera_list_formats (PyCameraObject* self) {
+#if defined(__unix__)
+    return v4l2_list_formats (self);
+#endif
+    return PyList_New (0);
+}
+
+/* capture_set(cameras, timeout=1.0, max_skew=-1.0) - a frame from each of
+   the cameras, taken as close together in time as can be */
+PyObject* capture_set (PyObject* self, PyObject* arg, PyObject *kwds) {
+#if defined(__unix__)
+    PyObject *cameras, *seq, *list = NULL, *surfobj, *item;
+    PyCameraObject **cams;
+    SDL_Surface* surf;
+    double timeout = 1.0, max_skew = -1.0;
+    char error[256];
+    Py_ssize_t count, i;
+    int ok;
+    char *kwids[] = {"cameras", "timeout", "max_skew", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "O|dd", kwids, &cameras,
+                                     &timeout, &max_skew))
+        return NULL;
+    seq = PySequence_Fast (cameras, "cameras must be a sequence of Cameras");
+    if (!seq)
+        return NULL;
+    count = PySequence_Fast_GET_SIZE (seq);
+    cams = PyMem_New (PyCameraObject*, count ? count : 1);
+    if (!cams) {
+        Py_DECREF (seq);
+        return PyErr_NoMemory ();
+    }
+    for (i = 0; i < count; i++) {
+        item = PySequence_Fast_GET_ITEM (seq, i);
+        if (!PyObject_TypeCheck (item, &PyCamera_Type)) {
+            PyErr_SetString (PyExc_TypeError,
+                             "cameras must be a sequence of Cameras");
+            goto end;
+        }
+        cams[i] = (PyCameraObject*) item;
+        if (cams[i]->fd == -1 || !cams[i]->buffers) {
+            PyErr_Format (PyExc_SystemError, "%s is not started",
+                          cams[i]->device_name);
+            goto end;
+        }
+        if (cams[i]->capture_thread) {
+            PyErr_Format (PyExc_SystemError,
+                          "%s is capturing on a thread",
+                          cams[i]->device_name);
+            goto end;
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    ok = v4l2_capture_set (cams, (int) count, timeout, max_skew, error,
+                           sizeof (error));
+    Py_END_ALLOW_THREADS;
+    if (!ok) {
+        PyErr_SetString (PyExc_SystemError, error);
+        goto end;
+    }
+
+    list = PyList_New (count);
+    for (i = 0; list && i < count; i++) {
+        surf = SDL_CreateRGBSurface (0, cams[i]->width, cams[i]->height, 24,
+                                     0xFF<<16, 0xFF<<8, 0xFF, 0);
+        if (!surf) {
+            PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+            Py_CLEAR (list);
+            break;
+        }
+        v4l2_process_image (cams[i],
+                            cams[i]->buffers[cams[i]->view_index].start,
+                            cams[i]->buffers[cams[i]->view_index].length,
+                            surf);
+        surfobj = PySurface_New (surf);
+        if (!surfobj) {
+            SDL_FreeSurface (surf);
+            Py_CLEAR (list);
+            break;
+        }
+        item = Py_BuildValue ("(Nd)", surfobj, cams[i]->view_timestamp);
+        if (!item) {
+            Py_CLEAR (list);
+            break;
+        }
+        PyList_SET_ITEM (list, i, item);
+    }
+    /* the frames go back to the drivers, as after get_image */
+    for (i = 0; i < count; i++) {
+        if (!v4l2_release_frame (cams[i]))
+            Py_CLEAR (list);
+    }
+
+end:
+    PyMem_Del (cams);
+    Py_DECREF (seq);
+    return list;
+#else
+    return RAISE (PyExc_NotImplementedError,
+                  "capture_set is not available on this platform");
+#endif
+}
+
+/* get_capture_stats() - frame counts of the capture thread */
+PyObject* camera_get_capture_stats (PyCameraObject* self) {
+#if defined(__unix__)
+    unsigned long captured = 0, dropped = 0, repeated = 0;
+
+    if (self->capture_thread) {
+        SDL_LockMutex (self->capture_lock);
+        captured = self->frames_captured;
+        dropped = self->frames_dropped;
+        repeated = self->frames_repeated;
+        SDL_UnlockMutex (self->capture_lock);
+    }
+    return Py_BuildValue ("(kkk)", captured, dropped, repeated);
+#endif
+    return Py_BuildValue ("(iii)", 0, 0, 0);
+}
+
 /*
  * Pixelformat conversion functions
  */
@@ -461,14 +717,14 @@ void rgb24_to_rgb (const void* src, void* dst, int length, SDL_PixelFormat* form
     }
 }
 
-/* converts packed rgb to packed hsv. formulas modified from wikipedia */
+/* converts packed rgb to packed hsv, by the formulas of pgcolorspace.h */
 void rgb_to_hsv (const void* src, void* dst, int length,
                  unsigned long source, SDL_PixelFormat* format)
 {
     Uint8 *s8, *d8;
     Uint16 *s16, *d16;
     Uint32 *s32, *d32;
-    Uint8 r, g, b, p1, p2, h, s, v, max, min, delta;
+    Uint8 r, g, b, p1, p2, h, s, v;
     int rshift, gshift, bshift, rloss, gloss, bloss;
 
     s8 = (Uint8 *) src;
@@ -493,23 +749,7 @@ void rgb_to_hsv (const void* src, void* dst, int length,
             b = p2 << 4;
             g = p1 & 0xF0;
             r = p1 << 4;
-            max = MAX(MAX(r, g), b);
-            min = MIN(MIN(r, g), b);
-            delta = max - min;
-            v = max; /* value (similar to luminosity) */
-            if (!delta) { /* grey, zero hue and saturation */
-                s = 0;
-                h = 0;
-            } else {
-                s = 255*delta/max; /* saturation */
-                if (r == max) {  /* set hue based on max color */
-                    h = 43*(g - b)/delta;
-                } else if (g == max) {
-                    h = 85 + 43*(b - r)/delta;
-                } else {
-                    h = 170 + 43*(r - g)/delta;
-                }
-            }
+            pg_rgb_to_hsv (r, g, b, &h, &s, &v);
             switch (format->BytesPerPixel) {
                 case 1:
                    *d8++ = ((h >> rloss) << rshift) | ((s >> gloss) << gshift) | ((v >> bloss) << bshift);
@@ -532,23 +772,7 @@ void rgb_to_hsv (const void* src, void* dst, int length,
             r = *s8++;
             g = *s8++;
             b = *s8++;
-            max = MAX(MAX(r, g), b);
-            min = MIN(MIN(r, g), b);
-            delta = max - min;
-            v = max; /* value (similar to luminosity) */
-            if (!delta) { /* grey, zero hue and saturation */
-                s = 0;
-                h = 0;
-            } else {
-                s = 255*delta/max; /* saturation */
-                if (r == max) {  /* set hue based on max color */
-                    h = 43*(g - b)/delta;
-                } else if (g == max) {
-                    h = 85 + 43*(b - r)/delta;
-                } else {
-                    h = 170 + 43*(r - g)/delta;
-                }
-            }
+            pg_rgb_to_hsv (r, g, b, &h, &s, &v);
             switch (format->BytesPerPixel) {
                 case 1:
                    *d8++ = ((h >> rloss) << rshift) | ((s >> gloss) << gshift) | ((v >> bloss) << bshift);
@@ -567,6 +791,23 @@ void rgb_to_hsv (const void* src, void* dst, int length,
             }
         }
     } else { /* for use as stage 2 in yuv or bayer to hsv, r and b switched */
+        if (format->BytesPerPixel == 4 && !rloss && !gloss && !bloss &&
+            !(rshift % 8) && !(gshift % 8) && !(bshift % 8)) {
+            /* whole bytes, so convert them in place, a few at a time */
+            Uint32 mask = format->Rmask | format->Gmask | format->Bmask;
+            int i;
+
+            for (i = 0; i < length; i++)
+                d32[i] = s32[i] & mask;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            pg_rgb_to_hsv_pixels ((Uint8*) d32, length, 4, rshift / 8,
+                                  gshift / 8, bshift / 8);
+#else
+            pg_rgb_to_hsv_pixels ((Uint8*) d32, length, 4, 3 - rshift / 8,
+                                  3 - gshift / 8, 3 - bshift / 8);
+#endif
+            return;
+        }
         while (length--) {
             switch (format->BytesPerPixel) {
                 case 1:
@@ -590,23 +831,7 @@ void rgb_to_hsv (const void* src, void* dst, int length,
                    b = *s32++ >> bshift << bloss;
                    break;
             }
-            max = MAX(MAX(r, g), b);
-            min = MIN(MIN(r, g), b);
-            delta = max - min;
-            v = max; /* value (similar to luminosity) */
-            if (!delta) { /* grey, zero hue and saturation */
-                s = 0;
-                h = 0;
-            } else {
-                s = 255*delta/max; /* saturation */
-                if (r == max) {  /* set hue based on max color */
-                    h = 43*(g - b)/delta;
-                } else if (g == max) {
-                    h = 85 + 43*(b - r)/delta;
-                } else {
-                    h = 170 + 43*(r - g)/delta;
-                }
-            }
+            pg_rgb_to_hsv (r, g, b, &h, &s, &v);
             switch (format->BytesPerPixel) {
                 case 1:
                    *d8++ = ((h >> rloss) << rshift) | ((s >> gloss) << gshift) | ((v >> bloss) << bshift);
@@ -825,6 +1050,13 @@ void yuyv_to_rgb (const void* src, void* dst, int length, SDL_PixelFormat* forma
     i = length >> 1;
     s = (Uint8 *) src;
 
+    /* 32 bit pixels with byte channels go through the SIMD runs of
+       pgcolorspace.h */
+    if (format->BytesPerPixel == 4 && !rloss && !gloss && !bloss) {
+        pg_yuyv_to_rgb32 (s, d32, i, rshift, gshift, bshift);
+        return;
+    }
+
     /* yuyv packs 2 pixels into every 4 bytes, sharing the u and v color
        terms between the 2, with each pixel having a unique y luminance term.
        Thus, we will operate on 2 pixels at a time. */
@@ -967,6 +1199,174 @@ void yuyv_to_yuv (const void* src, void* dst, int length, SDL_PixelFormat* forma
 /* FIXME: Seems to be grayscale and kind of dark on the OLPC XO
           Maybe the result of a different Bayer color order on the screen? */
 /* TODO: Certainly not the most efficient way of doing this conversion. */
+/* The colors of the Bayer pixel at rawpt, where i counts the pixels left
+   after it as sbggr8_to_rgb goes */
+static void sbggr8_pixel (const Uint8* rawpt, int i, int width, int height,
+                          Uint8* rp, Uint8* gp, Uint8* bp) {
+    Uint8 r, g, b;
+
+    if ( (i/width) % 2 == 0 ) {
+        /* even row (BGBGBGBG)*/
+        if ( (i % 2) == 0 ) {
+            /* B */
+            if ( (i > width) && ((i % width) > 0) ) {
+                b = *rawpt;                    /* B */
+                g = (*(rawpt-1)+*(rawpt+1)+
+                *(rawpt+width)+*(rawpt-width))/4;      /* G */
+                r = (*(rawpt-width-1)+*(rawpt-width+1)+
+                *(rawpt+width-1)+*(rawpt+width+1))/4;  /* R */
+            } else {
+                /* first line or left column */
+                b = *rawpt;                             /* B */
+                g = (*(rawpt+1)+*(rawpt+width))/2;      /* G */
+                r = *(rawpt+width+1);                   /* R */
+            }
+        } else {
+            /* (B)G */
+            if ( (i > width) && ((i % width) < (width-1)) ) {
+                b = (*(rawpt-1)+*(rawpt+1))/2;          /* B */
+                g = *rawpt;                             /* G */
+                r = (*(rawpt+width)+*(rawpt-width))/2;  /* R */
+            } else {
+                /* first line or right column */
+                b = *(rawpt-1);         /* B */
+                g = *rawpt;             /* G */
+                r = *(rawpt+width);     /* R */
+            }
+        }
+    } else {
+        /* odd row (GRGRGRGR) */
+        if ( (i % 2) == 0 ) {
+            /* G(R) */
+            if ( (i < (width*(height-1))) && ((i % width) > 0) ) {
+                b = (*(rawpt+width)+*(rawpt-width))/2;  /* B */
+                g = *rawpt;                             /* G */
+                r = (*(rawpt-1)+*(rawpt+1))/2;          /* R */
+            } else {
+                /* bottom line or left column */
+                b = *(rawpt-width);     /* B */
+                g = *rawpt;             /* G */
+                r = *(rawpt+1);         /* R */
+            }
+        } else {
+            /* R */
+            if ( i < (width*(height-1)) && ((i % width) < (width-1)) ) {
+                b = (*(rawpt-width-1)+*(rawpt-width+1)+
+                *(rawpt+width-1)+*(rawpt+width+1))/4;  /* B */
+                g = (*(rawpt-1)+*(rawpt+1)+
+                *(rawpt-width)+*(rawpt+width))/4;      /* G */
+                r = *rawpt;                    /* R */
+            } else {
+                /* bottom line or right column */
+                b = *(rawpt-width-1);                   /* B */
+                g = (*(rawpt-1)+*(rawpt-width))/2;      /* G */
+                r = *rawpt;                             /* R */
+            }
+        }
+    }
+    *rp = r;
+    *gp = g;
+    *bp = b;
+}
+
+#if defined(PG_COLORSPACE_SSE2) || defined(PG_COLORSPACE_NEON)
+/* count pixels of an inner row of sbggr8_to_rgb from rawpt on, all away
+   from the edges, to 32 bit pixels, 8 at a time; returns how many were
+   done. even_row and even_first are the (i/width) % 2 == 0 and i % 2 == 0
+   tests of sbggr8_pixel for the first of them. */
+static int sbggr8_row_simd (const Uint8* rawpt, Uint32* dst, int count,
+                            int width, int even_row, int even_first,
+                            int rshift, int gshift, int bshift) {
+    int n;
+#if defined(PG_COLORSPACE_NEON)
+    /* lanes where i % 2 == 0, going every other pixel */
+    static const Uint16 lanes[8] = {0xffff, 0, 0xffff, 0, 0xffff, 0, 0xffff, 0};
+    uint16x8_t even = vld1q_u16 (lanes);
+    uint16x8_t c, l, rr, up, dn, h2, v2, x4, d4, r, g, b;
+    int32x4_t rs = vdupq_n_s32 (rshift), gs = vdupq_n_s32 (gshift);
+    int32x4_t bs = vdupq_n_s32 (bshift);
+
+    if (!even_first)
+        even = vmvnq_u16 (even);
+    for (n = 0; n + 8 <= count; n += 8) {
+        const Uint8* p = rawpt + n;
+
+        c = vmovl_u8 (vld1_u8 (p));
+        l = vmovl_u8 (vld1_u8 (p - 1));
+        rr = vmovl_u8 (vld1_u8 (p + 1));
+        up = vmovl_u8 (vld1_u8 (p - width));
+        dn = vmovl_u8 (vld1_u8 (p + width));
+        h2 = vshrq_n_u16 (vaddq_u16 (l, rr), 1);
+        v2 = vshrq_n_u16 (vaddq_u16 (up, dn), 1);
+        x4 = vshrq_n_u16 (vaddq_u16 (vaddq_u16 (l, rr), vaddq_u16 (up, dn)), 2);
+        d4 = vshrq_n_u16 (vaddq_u16 (
+                 vaddq_u16 (vmovl_u8 (vld1_u8 (p - width - 1)),
+                            vmovl_u8 (vld1_u8 (p - width + 1))),
+                 vaddq_u16 (vmovl_u8 (vld1_u8 (p + width - 1)),
+                            vmovl_u8 (vld1_u8 (p + width + 1)))), 2);
+        if (even_row) {
+            /* B where i % 2 == 0, else (B)G */
+            b = vbslq_u16 (even, c, h2);
+            g = vbslq_u16 (even, x4, c);
+            r = vbslq_u16 (even, d4, v2);
+        } else {
+            /* G(R) where i % 2 == 0, else R */
+            b = vbslq_u16 (even, v2, d4);
+            g = vbslq_u16 (even, c, x4);
+            r = vbslq_u16 (even, h2, c);
+        }
+        pg_neon_store_rgb32 (r, g, b, dst + n, rs, gs, bs);
+    }
+#else
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i even = _mm_set_epi16 (0, -1, 0, -1, 0, -1, 0, -1);
+    __m128i c, l, rr, up, dn, h2, v2, x4, d4, r, g, b;
+    __m128i rs = _mm_cvtsi32_si128 (rshift), gs = _mm_cvtsi32_si128 (gshift);
+    __m128i bs = _mm_cvtsi32_si128 (bshift);
+
+#define SBGGR8_LOAD(q) \
+    _mm_unpacklo_epi8 (_mm_loadl_epi64 ((const __m128i*) (q)), zero)
+#define SBGGR8_PICK(mask, a, b) \
+    _mm_or_si128 (_mm_and_si128 (mask, a), _mm_andnot_si128 (mask, b))
+    if (!even_first)
+        even = _mm_xor_si128 (even, _mm_set1_epi16 (-1));
+    for (n = 0; n + 8 <= count; n += 8) {
+        const Uint8* p = rawpt + n;
+
+        c = SBGGR8_LOAD (p);
+        l = SBGGR8_LOAD (p - 1);
+        rr = SBGGR8_LOAD (p + 1);
+        up = SBGGR8_LOAD (p - width);
+        dn = SBGGR8_LOAD (p + width);
+        h2 = _mm_srli_epi16 (_mm_add_epi16 (l, rr), 1);
+        v2 = _mm_srli_epi16 (_mm_add_epi16 (up, dn), 1);
+        x4 = _mm_srli_epi16 (_mm_add_epi16 (_mm_add_epi16 (l, rr),
+                                            _mm_add_epi16 (up, dn)), 2);
+        d4 = _mm_srli_epi16 (_mm_add_epi16 (
+                 _mm_add_epi16 (SBGGR8_LOAD (p - width - 1),
+                                SBGGR8_LOAD (p - width + 1)),
+                 _mm_add_epi16 (SBGGR8_LOAD (p + width - 1),
+                                SBGGR8_LOAD (p + width + 1))), 2);
+        if (even_row) {
+            /* B where i % 2 == 0, else (B)G */
+            b = SBGGR8_PICK (even, c, h2);
+            g = SBGGR8_PICK (even, x4, c);
+            r = SBGGR8_PICK (even, d4, v2);
+        } else {
+            /* G(R) where i % 2 == 0, else R */
+            b = SBGGR8_PICK (even, v2, d4);
+            g = SBGGR8_PICK (even, c, x4);
+            r = SBGGR8_PICK (even, h2, c);
+        }
+        pg_store_rgb32_sse2 (r, g, b, dst + n, rs, gs, bs);
+    }
+#undef SBGGR8_LOAD
+#undef SBGGR8_PICK
+#endif
+    return n;
+}
+#endif
+
 void sbggr8_to_rgb (const void* src, void* dst, int width, int height, SDL_PixelFormat* format) {
     Uint8 *rawpt, *d8;
     Uint16 *d16;
@@ -974,6 +1374,12 @@ void sbggr8_to_rgb (const void* src, void* dst, int width, int height, SDL_Pixel
     Uint8 r, g, b;
     int rshift, gshift, bshift, rloss, gloss, bloss;
     int i = width * height;
+#if defined(PG_COLORSPACE_SSE2) || defined(PG_COLORSPACE_NEON)
+    int done;
+    int simd = (format->BytesPerPixel == 4 && !format->Rloss &&
+                !format->Gloss && !format->Bloss && width > 2 &&
+                pg_colorspace_get_level () >= PG_COLORSPACE_SIMD);
+#endif
     rawpt = (Uint8*) src;
     rshift = format->Rshift;
     gshift = format->Gshift;
@@ -987,65 +1393,19 @@ void sbggr8_to_rgb (const void* src, void* dst, int width, int height, SDL_Pixel
     d32 = (Uint32 *) dst;
 
     while (i--) {
-        if ( (i/width) % 2 == 0 ) {
-            /* even row (BGBGBGBG)*/
-            if ( (i % 2) == 0 ) {
-                /* B */
-                if ( (i > width) && ((i % width) > 0) ) {
-                    b = *rawpt;                    /* B */
-                    g = (*(rawpt-1)+*(rawpt+1)+
-                    *(rawpt+width)+*(rawpt-width))/4;      /* G */
-                    r = (*(rawpt-width-1)+*(rawpt-width+1)+
-                    *(rawpt+width-1)+*(rawpt+width+1))/4;  /* R */
-                } else {
-                    /* first line or left column */
-                    b = *rawpt;                             /* B */
-                    g = (*(rawpt+1)+*(rawpt+width))/2;      /* G */
-                    r = *(rawpt+width+1);                   /* R */
-                }
-            } else {
-                /* (B)G */
-                if ( (i > width) && ((i % width) < (width-1)) ) {
-                    b = (*(rawpt-1)+*(rawpt+1))/2;          /* B */
-                    g = *rawpt;                             /* G */
-                    r = (*(rawpt+width)+*(rawpt-width))/2;  /* R */
-                } else {
-                    /* first line or right column */
-                    b = *(rawpt-1);         /* B */
-                    g = *rawpt;             /* G */
-                    r = *(rawpt+width);     /* R */
-                }
-            }
-        } else {
-            /* odd row (GRGRGRGR) */
-            if ( (i % 2) == 0 ) {
-                /* G(R) */
-                if ( (i < (width*(height-1))) && ((i % width) > 0) ) {
-                    b = (*(rawpt+width)+*(rawpt-width))/2;  /* B */
-                    g = *rawpt;                             /* G */
-                    r = (*(rawpt-1)+*(rawpt+1))/2;          /* R */
-                } else {
-                    /* bottom line or left column */
-                    b = *(rawpt-width);     /* B */
-                    g = *rawpt;             /* G */
-                    r = *(rawpt+1);         /* R */
-                }
-            } else {
-                /* R */
-                if ( i < (width*(height-1)) && ((i % width) < (width-1)) ) {
-                    b = (*(rawpt-width-1)+*(rawpt-width+1)+
-                    *(rawpt+width-1)+*(rawpt+width+1))/4;  /* B */
-                    g = (*(rawpt-1)+*(rawpt+1)+
-                    *(rawpt-width)+*(rawpt+width))/4;      /* G */
-                    r = *rawpt;                    /* R */
-                } else {
-                    /* bottom line or right column */
-                    b = *(rawpt-width-1);                   /* B */
-                    g = (*(rawpt-1)+*(rawpt-width))/2;      /* G */
-                    r = *rawpt;                             /* R */
-                }
-            }
+#if defined(PG_COLORSPACE_SSE2) || defined(PG_COLORSPACE_NEON)
+        /* From the second pixel of each inner row, up to the last but one */
+        if (simd && i % width == width - 2 && i >= width &&
+            i < width * (height - 1)) {
+            done = sbggr8_row_simd (rawpt, d32, width - 2, width,
+                                    (i / width) % 2 == 0, i % 2 == 0,
+                                    rshift, gshift, bshift);
+            rawpt += done;
+            d32 += done;
+            i -= done;
         }
+#endif
+        sbggr8_pixel (rawpt, i, width, height, &r, &g, &b);
         rawpt++;
         switch (format->BytesPerPixel) {
             case 1:
@@ -1218,6 +1578,23 @@ void yuv420_to_rgb (const void* src, void* dst, int width, int height, SDL_Pixel
             }
             break;
         default:
+            if (!rloss && !gloss && !bloss) {
+                /* both rows of each pair share the u and v row */
+                i = width/2;
+                while(j--) {
+                    pg_yuv_planes_to_rgb32 (y1, u, v, d32_1, i,
+                                            rshift, gshift, bshift);
+                    pg_yuv_planes_to_rgb32 (y2, u, v, d32_2, i,
+                                            rshift, gshift, bshift);
+                    u += i;
+                    v += i;
+                    y1 = y2 + i * 2;
+                    y2 = y1 + width;
+                    d32_1 = d32_2 + i * 2;
+                    d32_2 = d32_1 + width;
+                }
+                break;
+            }
             while(j--) {
                 i = width/2;
                 while(i--) {
@@ -1366,7 +1743,7 @@ void yuv420_to_yuv (const void* src, void* dst, int width, int height, SDL_Pixel
 
 /* Camera class definition */
 PyMethodDef cameraobj_builtins[] = {
-    { "start", (PyCFunction) camera_start, METH_NOARGS, DOC_CAMERASTART },
+    { "start", (PyCFunction) camera_start, METH_VARARGS | METH_KEYWORDS, DOC_CAMERASTART },
     { "stop", (PyCFunction) camera_stop, METH_NOARGS, DOC_CAMERASTOP },
     { "get_controls", (PyCFunction) camera_get_controls, METH_NOARGS, DOC_CAMERAGETCONTROLS },
     { "set_controls", (PyCFunction) camera_set_controls, METH_KEYWORDS, DOC_CAMERASETCONTROLS },
@@ -1374,10 +1751,17 @@ PyMethodDef cameraobj_builtins[] = {
     { "query_image", (PyCFunction) camera_query_image, METH_NOARGS, DOC_CAMERAQUERYIMAGE },
     { "get_image", (PyCFunction) camera_get_image, METH_VARARGS, DOC_CAMERAGETIMAGE },
     { "get_raw", (PyCFunction) camera_get_raw, METH_NOARGS, DOC_CAMERAGETRAW },
+    { "get_capture_stats", (PyCFunction) camera_get_capture_stats, METH_NOARGS, DOC_CAMERAGETCAPTURESTATS },
+    { "get_frame_view", (PyCFunction) camera_get_frame_view, METH_NOARGS, DOC_CAMERAGETFRAMEVIEW },
+    { "get_format", (PyCFunction) camera_get_format, METH_NOARGS, DOC_CAMERAGETFORMAT },
+    { "list_formats", (PyCFunction) camera_list_formats, METH_NOARGS, DOC_CAMERALISTFORMATS },
     { NULL, NULL, 0, NULL }
 };
 
 void camera_dealloc (PyObject* self) {
+#if defined(__unix__)
+    v4l2_stop_thread((PyCameraObject*) self);
+#endif
     free(((PyCameraObject*) self)->device_name);
     PyObject_DEL (self);
 }
@@ -1424,18 +1808,25 @@ PyTypeObject PyCamera_Type = {
     0,                          /* tp_new */
 };
 
-PyObject* Camera (PyCameraObject* self, PyObject* arg) {
+PyObject* Camera (PyCameraObject* self, PyObject* arg, PyObject *kwds) {
 # if defined(__unix__)
     int w, h;
     char* dev_name = NULL;
     char* color = NULL;
+    char* pixelformat = NULL;
+    int fps = 0;
     PyCameraObject *cameraobj;
+    char *kwids[] = {"device", "size", "format", "pixelformat", "fps", NULL};
 
     w = DEFAULT_WIDTH;
     h = DEFAULT_HEIGHT;
 
-    if (!PyArg_ParseTuple(arg, "s|(ii)s", &dev_name, &w, &h, &color))
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "s|(ii)szi", kwids, &dev_name,
+                                     &w, &h, &color, &pixelformat, &fps))
         return NULL;
+    if (pixelformat && strlen(pixelformat) != 4)
+        return RAISE (PyExc_ValueError,
+                      "pixelformat must be four characters, like 'MJPG'");
 
     cameraobj = PyObject_NEW (PyCameraObject, &PyCamera_Type);
 
@@ -1464,6 +1855,28 @@ PyObject* Camera (PyCameraObject* self, PyObject* arg) {
         cameraobj->vflip = 0;
         cameraobj->brightness = 0;
         cameraobj->fd = -1;
+        cameraobj->capture_thread = NULL;
+        cameraobj->capture_lock = NULL;
+        cameraobj->capture_cond = NULL;
+        memset(cameraobj->frames, 0, sizeof(cameraobj->frames));
+        cameraobj->frame_fresh = 0;
+        cameraobj->frames_captured = 0;
+        cameraobj->frames_dropped = 0;
+        cameraobj->frames_repeated = 0;
+        cameraobj->capture_error[0] = '\0';
+        cameraobj->view_index = -1;
+        cameraobj->view_length = 0;
+        cameraobj->frame_views = 0;
+        cameraobj->request_format = pixelformat ?
+            v4l2_fourcc(pixelformat[0], pixelformat[1], pixelformat[2],
+                        pixelformat[3]) : 0;
+        cameraobj->request_fps = fps;
+        cameraobj->fps_num = 0;
+        cameraobj->fps_den = 0;
+        cameraobj->jpeg = NULL;
+        cameraobj->jpeg_width = 0;
+        cameraobj->jpeg_height = 0;
+        cameraobj->jpeg_rgb = NULL;
     }
 
     return (PyObject*)cameraobj;
@@ -1512,16 +1925,44 @@ PyObject* Camera (PyCameraObject* self, PyObject* arg) {
     # endif
 }
 
+/* The functions pygame.set_simd_backend calls for the conversions */
+static PyObject*
+camera_get_simd_backend (PyObject* self)
+{
+    return Text_FromUTF8 (pg_colorspace_get_backend ());
+}
+
+static PyObject*
+camera_set_simd_backend (PyObject* self, PyObject* arg)
+{
+    const char *type;
+
+    if (!PyArg_ParseTuple (arg, "s", &type))
+        return NULL;
+    if (pg_colorspace_set_backend (type))
+        return RAISE (PyExc_ValueError, "no such backend on this machine");
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef camera_simd_methods[] = {
+    {"get_simd_backend", (PyCFunction) camera_get_simd_backend, METH_NOARGS,
+     NULL },
+    {"set_simd_backend", camera_set_simd_backend, METH_VARARGS, NULL },
+    {NULL, NULL, 0, NULL }
+};
+
 /* Camera module definition */
 PyMethodDef camera_builtins[] = {
     {"colorspace", surf_colorspace, METH_VARARGS, DOC_PYGAMECAMERACOLORSPACE },
     {"list_cameras", list_cameras, METH_NOARGS, DOC_PYGAMECAMERALISTCAMERAS },
-    {"Camera", (PyCFunction) Camera, METH_VARARGS, DOC_PYGAMECAMERACAMERA },
+    {"Camera", (PyCFunction) Camera, METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECAMERACAMERA },
+    {"capture_set", (PyCFunction) capture_set, METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECAMERACAPTURESET },
     {NULL, NULL, 0, NULL }
 };
 
 MODINIT_DEFINE (_camera) {
-    PyObject *module;
+    PyObject *module, *get, *set;
+    int ecode;
     /* imported needed apis; Do this first so if there is an error
      * the module is not loaded.
      */
@@ -1545,6 +1986,10 @@ MODINIT_DEFINE (_camera) {
     if (PyErr_Occurred()) {
         MODINIT_ERROR;
     }
+    import_pygame_bufferproxy();
+    if (PyErr_Occurred()) {
+        MODINIT_ERROR;
+    }
 
     /* type preparation */
     //PyType_Init(PyCamera_Type);
@@ -1564,5 +2009,16 @@ MODINIT_DEFINE (_camera) {
     Py_INCREF(&PyCamera_Type);
     PyModule_AddObject(module, "CameraType", (PyObject *)&PyCamera_Type);
 
+    /* let pygame.set_simd_backend switch the conversions */
+    get = PyCFunction_New (camera_simd_methods, NULL);
+    set = PyCFunction_New (camera_simd_methods + 1, NULL);
+    ecode = !get || !set || PgSimd_Register ("camera", get, set);
+    Py_XDECREF (get);
+    Py_XDECREF (set);
+    if (ecode) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
+
     MODINIT_RETURN(module);
 }
@@ -64,7 +64,11 @@ static int _ftfont_init(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_getrect(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_getmetrics(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_render(PgFontObject *, PyObject *, PyObject *);
+static PyObject *_ftfont_render_cached(PgFontObject *, PyObject *,
+                                       PyObject *);
 static PyObject *_ftfont_render_to(PgFontObject *, PyObject *, PyObject *);
+static PyObject *_ftfont_render_many_to(PgFontObject *, PyObject *,
+                                        PyObject *);
 static PyObject *_ftfont_render_raw(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_render_raw_to(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_getsizedascender(PgFontObject *, PyObject *);
@@ -72,6 +76,7 @@ static PyObject *_ftfont_getsizeddescender(PgFontObject *, PyObject *);
 static PyObject *_ftfont_getsizedheight(PgFontObject *, PyObject *);
 static PyObject *_ftfont_getsizedglyphheight(PgFontObject *, PyObject *);
 static PyObject *_ftfont_getsizes(PgFontObject *);
+static PyObject *_ftfont_prewarm(PgFontObject *, PyObject *, PyObject *);
 
 /* static PyObject *_ftfont_copy(PgFontObject *); */
 
@@ -106,6 +111,10 @@ static int _ftfont_setstyle_flag(PgFontObject *, PyObject *, void *);
 static PyObject *_ftfont_getrender_flag(PgFontObject *, void *);
 static int _ftfont_setrender_flag(PgFontObject *, PyObject *, void *);
 
+static PyObject *_ftfont_getglyphcachebudget(PgFontObject *, void *);
+static int _ftfont_setglyphcachebudget(PgFontObject *, PyObject *, void *);
+static PyObject *_ftfont_getglyphcachestats(PgFontObject *, void *);
+static PyObject *_ftfont_getlayoutcachestats(PgFontObject *, void *);
 #if defined(PGFT_DEBUG_CACHE)
 static PyObject *_ftfont_getdebugcachestats(PgFontObject *, void *);
 #endif
@@ -535,18 +544,36 @@ static PyMethodDef _ftfont_methods[] = {
         METH_NOARGS,
         DOC_FONTGETSIZES
     },
+    {
+        "prewarm",
+        (PyCFunction) _ftfont_prewarm,
+        METH_VARARGS | METH_KEYWORDS,
+        DOC_FONTPREWARM
+    },
     {
         "render",
         (PyCFunction)_ftfont_render,
         METH_VARARGS | METH_KEYWORDS,
         DOC_FONTRENDER
     },
+    {
+        "render_cached",
+        (PyCFunction)_ftfont_render_cached,
+        METH_VARARGS | METH_KEYWORDS,
+        DOC_FONTRENDERCACHED
+    },
     {
         "render_to",
         (PyCFunction)_ftfont_render_to,
         METH_VARARGS | METH_KEYWORDS,
         DOC_FONTRENDERTO
     },
+    {
+        "render_many_to",
+        (PyCFunction)_ftfont_render_many_to,
+        METH_VARARGS | METH_KEYWORDS,
+        DOC_FONTRENDERMANYTO
+    },
     {
         "render_raw",
         (PyCFunction)_ftfont_render_raw,
@@ -721,6 +748,13 @@ static PyGetSetDef _ftfont_getsets[] = {
         DOC_FONTUSEBITMAPSTRIKES,
         (void *)FT_RFLAG_USE_BITMAP_STRIKES
     },
+    {
+        "atlas",
+        (getter)_ftfont_getrender_flag,
+        (setter)_ftfont_setrender_flag,
+        DOC_FONTATLAS,
+        (void *)FT_RFLAG_ATLAS
+    },
     {
         "resolution",
         (getter)_ftfont_getresolution,
@@ -749,6 +783,27 @@ static PyGetSetDef _ftfont_getsets[] = {
         DOC_FONTORIGIN,
         (void *)FT_RFLAG_ORIGIN
     },
+    {
+        "glyph_cache_budget",
+        (getter)_ftfont_getglyphcachebudget,
+        (setter)_ftfont_setglyphcachebudget,
+        DOC_FONTGLYPHCACHEBUDGET,
+        0
+    },
+    {
+        "glyph_cache_stats",
+        (getter)_ftfont_getglyphcachestats,
+        0,
+        DOC_FONTGLYPHCACHESTATS,
+        0
+    },
+    {
+        "_layout_cache_stats",
+        (getter)_ftfont_getlayoutcachestats,
+        0,
+        "layout cache (size, count, hits, misses) as a tuple",
+        0
+    },
 #if defined(PGFT_DEBUG_CACHE)
     {
         "_debug_cache_stats",
@@ -870,13 +925,14 @@ static int
 _ftfont_init(PgFontObject *self, PyObject *args, PyObject *kwds)
 {
     static char *kwlist[] =  {
-        "file", "size", "font_index", "resolution", "ucs4", 0
+        "file", "size", "font_index", "resolution", "ucs4", "shared_cache", 0
     };
 
     PyObject *file, *original_file;
     long font_index = 0;
     Scale_t face_size = self->face_size;
     int ucs4 = self->render_flags & FT_RFLAG_UCS4 ? 1 : 0;
+    int shared_cache = 0;
     unsigned resolution = 0;
     long size = 0;
     long height = 0;
@@ -888,10 +944,18 @@ _ftfont_init(PgFontObject *self, PyObject *args, PyObject *kwds)
     FreeTypeInstance *ft;
     ASSERT_GRAB_FREETYPE(ft, -1);
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&lIi", kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&lIii", kwlist,
                                      &file,
                                      obj_to_scale, (void *)&face_size,
-                                     &font_index, &resolution, &ucs4)) {
+                                     &font_index, &resolution, &ucs4,
+                                     &shared_cache)) {
+        return -1;
+    }
+
+    if (self->_internals && self->_internals->busy) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "cannot reload a font while it is drawing"
+                        " on another thread");
         return -1;
     }
 
@@ -949,8 +1013,8 @@ _ftfont_init(PgFontObject *self, PyObject *args, PyObject *kwds)
             goto end;
         }
 
-        if (_PGFT_TryLoadFont_Filename(ft, self,
-                                       Bytes_AS_STRING(file), font_index)) {
+        if (_PGFT_TryLoadFont_Filename(ft, self, Bytes_AS_STRING(file),
+                                       font_index, shared_cache)) {
             goto end;
         }
     }
@@ -1382,7 +1446,68 @@ _ftfont_setfgcolor(PgFontObject *self, PyObject *value, void *closure)
     return 0;
 }
 
+/** glyph cache */
+static PyObject *
+_ftfont_getglyphcachebudget(PgFontObject *self, void *closure)
+{
+    ASSERT_SELF_IS_ALIVE(self);
+    return PyLong_FromSize_t(self->_internals->glyph_cache->budget);
+}
+
+static int
+_ftfont_setglyphcachebudget(PgFontObject *self, PyObject *value,
+                            void *closure)
+{
+    Py_ssize_t budget;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError,
+                        "glyph_cache_budget cannot be deleted");
+        return -1;
+    }
+    if (!PgFont_IS_ALIVE(self)) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        MODULE_NAME "." FONT_TYPE_NAME
+                        " instance is not initialized");
+        return -1;
+    }
+    budget = PyNumber_AsSsize_t(value, PyExc_OverflowError);
+    if (budget == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (budget < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "glyph_cache_budget must not be negative");
+        return -1;
+    }
+    self->_internals->glyph_cache->budget = (size_t)budget;
+    return 0;
+}
+
+static PyObject *
+_ftfont_getglyphcachestats(PgFontObject *self, void *closure)
+{
+    const FontCache *cache;
+
+    ASSERT_SELF_IS_ALIVE(self);
+    cache = self->_internals->glyph_cache;
+    return Py_BuildValue("knkkk", (unsigned long)cache->count,
+                         (Py_ssize_t)cache->bytes, cache->hits,
+                         cache->misses, cache->evictions);
+}
+
 /** testing and debugging */
+static PyObject *
+_ftfont_getlayoutcachestats(PgFontObject *self, void *closure)
+{
+    const LayoutCache *layouts;
+
+    ASSERT_SELF_IS_ALIVE(self);
+    layouts = &self->_internals->layouts;
+    return Py_BuildValue("iikk", PGFT_LAYOUT_CACHE_SIZE, layouts->count,
+                         layouts->hits, layouts->misses);
+}
+
 #if defined(PGFT_DEBUG_CACHE)
 static PyObject *
 _ftfont_getdebugcachestats(PgFontObject *self, void *closure)
@@ -1396,11 +1521,11 @@ _ftfont_getdebugcachestats(PgFontObject *self, void *closure)
     const FontCache *cache = &PGFT_FONT_CACHE(self);
 
     return Py_BuildValue("kkkkk",
-                         (unsigned long)cache->_debug_count,
-                         (unsigned long)cache->_debug_delete_count,
-                         (unsigned long)cache->_debug_access,
-                         (unsigned long)cache->_debug_hit,
-                         (unsigned long)cache->_debug_miss);
+                         (unsigned long)cache->count,
+                         cache->evictions,
+                         cache->hits + cache->misses,
+                         cache->hits,
+                         cache->misses);
 }
 #endif
 
@@ -1694,6 +1819,47 @@ _ftfont_getsizes(PgFontObject *self)
     return 0;
 }
 
+static PyObject *
+_ftfont_prewarm(PgFontObject *self, PyObject *args, PyObject *kwds)
+{
+    /* keyword list */
+    static char *kwlist[] =  {
+        "text", "size", "style", 0
+    };
+
+    PyObject *textobj;
+    PGFT_String *text = 0;
+    Scale_t face_size = FACE_SIZE_NONE;
+    int style = FT_STYLE_DEFAULT;
+    FontRenderMode render;
+    int added;
+
+    ASSERT_SELF_IS_ALIVE(self);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&i", kwlist,
+                                     &textobj,
+                                     obj_to_scale, (void *)&face_size,
+                                     &style)) {
+        return 0;
+    }
+
+    text = _PGFT_EncodePyString(textobj, self->render_flags & FT_RFLAG_UCS4);
+    if (!text) {
+        return 0;
+    }
+    if (_PGFT_BuildRenderMode(self->freetype, self, &render,
+                              face_size, style, self->rotation)) {
+        free_string(text);
+        return 0;
+    }
+    added = _PGFT_Prewarm(self->freetype, self, &render, text);
+    free_string(text);
+    if (added < 0) {
+        return 0;
+    }
+    return PyInt_FromLong(added);
+}
+
 static PyObject *
 _ftfont_render_raw(PgFontObject *self, PyObject *args, PyObject *kwds)
 {
@@ -1715,6 +1881,7 @@ _ftfont_render_raw(PgFontObject *self, PyObject *args, PyObject *kwds)
     /* output arguments */
     PyObject *rbuffer = 0;
     PyObject *rtuple = 0;
+    Uint64 start;
     int width, height;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|iO&O&i", kwlist,
@@ -1742,10 +1909,13 @@ _ftfont_render_raw(PgFontObject *self, PyObject *args, PyObject *kwds)
                               &mode, face_size, style, rotation))
         goto error;
 
+    PG_PERF_BEGIN(start);
     rbuffer = _PGFT_Render_PixelArray(self->freetype, self,
                                       &mode, text, invert,
                                       &width, &height);
     if (!rbuffer) goto error;
+    PG_PERF_ADD(PG_PERF_FONT_CALLS, 1);
+    PG_PERF_END(start, PG_PERF_FONT_NS);
     free_string(text);
     rtuple = Py_BuildValue("O(ii)", rbuffer, width, height);
     if (!rtuple) goto error;
@@ -1784,6 +1954,7 @@ _ftfont_render_raw_to(PgFontObject *self, PyObject *args, PyObject *kwds)
 
     /* output arguments */
     SDL_Rect r;
+    Uint64 start;
 
     ASSERT_SELF_IS_ALIVE(self);
 
@@ -1814,8 +1985,11 @@ _ftfont_render_raw_to(PgFontObject *self, PyObject *args, PyObject *kwds)
                               &mode, face_size, style, rotation))
         goto error;
 
+    PG_PERF_BEGIN(start);
     if (_PGFT_Render_Array(self->freetype, self, &mode,
                            arrayobj, text, invert, xpos, ypos, &r)) goto error;
+    PG_PERF_ADD(PG_PERF_FONT_CALLS, 1);
+    PG_PERF_END(start, PG_PERF_FONT_NS);
     free_string(text);
 
     return PyRect_New(&r);
@@ -1859,6 +2033,7 @@ _ftfont_render(PgFontObject *self, PyObject *args, PyObject *kwds)
     FontColor fg_color;
     FontColor bg_color;
     FontRenderMode render;
+    Uint64 start;
 
     ASSERT_SELF_IS_ALIVE(self);
 
@@ -1908,10 +2083,13 @@ _ftfont_render(PgFontObject *self, PyObject *args, PyObject *kwds)
                               &render, face_size, style, rotation))
         goto error;
 
+    PG_PERF_BEGIN(start);
     surface = _PGFT_Render_NewSurface(self->freetype, self,
                                       &render, text, &fg_color,
                                       bg_color_obj ? &bg_color : 0, &r);
     if (!surface) goto error;
+    PG_PERF_ADD(PG_PERF_FONT_CALLS, 1);
+    PG_PERF_END(start, PG_PERF_FONT_NS);
     free_string(text);
     surface_obj = PySurface_New(surface);
     if (!surface_obj) goto error;
@@ -1940,6 +2118,118 @@ _ftfont_render(PgFontObject *self, PyObject *args, PyObject *kwds)
 #endif // HAVE_PYGAME_SDL_VIDEO
 }
 
+static PyObject *
+_ftfont_render_cached(PgFontObject *self, PyObject *args, PyObject *kwds)
+{
+#ifndef HAVE_PYGAME_SDL_VIDEO
+
+    PyErr_SetString(PyExc_RuntimeError,
+                    "SDL support is missing. Cannot render on surfonts");
+    return 0;
+
+#else
+    /* keyword list */
+    static char *kwlist[] =  {
+        "text", "fgcolor", "bgcolor", "style", "rotation", "size", 0
+    };
+
+    /* input arguments */
+    PyObject *textobj = 0;
+    PGFT_String *text = 0;
+    Scale_t face_size = FACE_SIZE_NONE;
+    PyObject *fg_color_obj = 0;
+    PyObject *bg_color_obj = 0;
+    Angle_t rotation = self->rotation;
+    int style = FT_STYLE_DEFAULT;
+
+    /* output arguments */
+    PyObject *surface_obj = 0;
+    PyObject *rtuple = 0;
+    SDL_Rect r;
+    PyObject *rect_obj = 0;
+
+    FontColor fg_color;
+    FontColor bg_color;
+    FontRenderMode render;
+    Uint64 start;
+
+    ASSERT_SELF_IS_ALIVE(self);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOiO&O&", kwlist,
+                                     /* required */
+                                     &textobj,
+                                     /* optional */
+                                     &fg_color_obj, &bg_color_obj, &style,
+                                     obj_to_rotation, (void *)&rotation,
+                                     obj_to_scale, (void *)&face_size))
+        goto error;
+
+    if (fg_color_obj == Py_None) {
+        fg_color_obj = 0;
+    }
+    if (bg_color_obj == Py_None) {
+        bg_color_obj = 0;
+    }
+
+    if (fg_color_obj) {
+        if (!RGBAFromColorObj(fg_color_obj, (Uint8 *)&fg_color)) {
+            PyErr_SetString(PyExc_TypeError, "fgcolor must be a Color");
+            goto error;
+        }
+    }
+    else {
+        fg_color.r = self->fgcolor[0];
+        fg_color.g = self->fgcolor[1];
+        fg_color.b = self->fgcolor[2];
+        fg_color.a = self->fgcolor[3];
+    }
+    if (bg_color_obj) {
+        if (!RGBAFromColorObj(bg_color_obj, (Uint8 *)&bg_color)) {
+            PyErr_SetString(PyExc_TypeError, "bgcolor must be a Color");
+            goto error;
+        }
+    }
+
+    /* Encode text */
+    if (textobj != Py_None) {
+        text = _PGFT_EncodePyString(textobj,
+                                    self->render_flags & FT_RFLAG_UCS4);
+        if (!text) goto error;
+    }
+
+    if (_PGFT_BuildRenderMode(self->freetype, self,
+                              &render, face_size, style, rotation))
+        goto error;
+
+    PG_PERF_BEGIN(start);
+    surface_obj = _PGFT_Render_Cached(self->freetype, self,
+                                      &render, text, &fg_color,
+                                      bg_color_obj ? &bg_color : 0, &r);
+    if (!surface_obj) goto error;
+    PG_PERF_ADD(PG_PERF_FONT_CALLS, 1);
+    PG_PERF_END(start, PG_PERF_FONT_NS);
+    free_string(text);
+    text = 0;
+
+    rect_obj = PyRect_New(&r);
+    if (!rect_obj) goto error;
+    rtuple = PyTuple_Pack(2, surface_obj, rect_obj);
+    if (!rtuple) goto error;
+    Py_DECREF(surface_obj);
+    Py_DECREF(rect_obj);
+
+    return rtuple;
+
+  error:
+    free_string(text);
+    Py_XDECREF(surface_obj);
+    Py_XDECREF(rect_obj);
+    Py_XDECREF(rtuple);
+    return 0;
+
+#endif // HAVE_PYGAME_SDL_VIDEO
+}
+
 static PyObject *
 _ftfont_render_to(PgFontObject *self, PyObject *args, PyObject *kwds)
 {
@@ -1976,6 +2266,7 @@ _ftfont_render_to(PgFontObject *self, PyObject *args, PyObject *kwds)
     FontColor fg_color;
     FontColor bg_color;
     FontRenderMode render;
+    Uint64 start;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!OO|OOiO&O&", kwlist,
                                      /* required */
@@ -2028,11 +2319,22 @@ _ftfont_render_to(PgFontObject *self, PyObject *args, PyObject *kwds)
         goto error;
 
     surface = PySurface_AsSurface(surface_obj);
-    if (_PGFT_Render_ExistingSurface(self->freetype, self,
-                                     &render, text, surface,
-                                     xpos, ypos, &fg_color,
-                                     bg_color_obj ? &bg_color : 0, &r))
+    PySurface_DropRLE(surface_obj);
+    PG_PERF_BEGIN(start);
+    if (render.render_flags & FT_RFLAG_ATLAS) {
+        if (_PGFT_Render_AtlasSurface(self->freetype, self,
+                                      &render, text, surface_obj,
+                                      xpos, ypos, &fg_color,
+                                      bg_color_obj ? &bg_color : 0, &r))
+            goto error;
+    }
+    else if (_PGFT_Render_ExistingSurface(self->freetype, self,
+                                          &render, text, surface,
+                                          xpos, ypos, &fg_color,
+                                          bg_color_obj ? &bg_color : 0, &r))
         goto error;
+    PG_PERF_ADD(PG_PERF_FONT_CALLS, 1);
+    PG_PERF_END(start, PG_PERF_FONT_NS);
     free_string(text);
 
     return PyRect_New(&r);
@@ -2043,6 +2345,177 @@ _ftfont_render_to(PgFontObject *self, PyObject *args, PyObject *kwds)
 #endif // HAVE_PYGAME_SDL_VIDEO
 }
 
+static PyObject *
+_ftfont_render_many_to(PgFontObject *self, PyObject *args, PyObject *kwds)
+{
+#ifndef HAVE_PYGAME_SDL_VIDEO
+
+    PyErr_SetString(PyExc_RuntimeError,
+                    "SDL support is missing. Cannot render on surfaces");
+    return 0;
+
+#else
+    /* keyword list */
+    static char *kwlist[] =  {
+        "surf", "texts", "fgcolor", "bgcolor",
+        "style", "rotation", "size", 0
+    };
+
+    /* input arguments */
+    PyObject *surface_obj = 0;
+    PyObject *textsobj = 0;
+    PyObject *seq = 0;
+    PyObject *item;
+    Uint64 start;
+    PyObject *textobj;
+    Scale_t face_size = FACE_SIZE_NONE;
+    PyObject *fg_color_obj = 0;
+    PyObject *bg_color_obj = 0;
+    Angle_t rotation = self->rotation;
+    int style = FT_STYLE_DEFAULT;
+    SDL_Surface *surface = 0;
+
+    /* output arguments */
+    PyObject *rects = 0;
+    PyObject *rectobj;
+
+    RenderManyItem *items = 0;
+    Py_ssize_t count = 0;
+    Py_ssize_t i;
+    FontColor fg_color;
+    FontColor bg_color;
+    FontRenderMode render;
+    int error;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O|OOiO&O&", kwlist,
+                                     /* required */
+                                     &PySurface_Type, &surface_obj,
+                                     &textsobj,
+                                     /* optional */
+                                     &fg_color_obj, &bg_color_obj, &style,
+                                     obj_to_rotation, (void *)&rotation,
+                                     obj_to_scale, (void *)&face_size))
+        return 0;
+
+    if (fg_color_obj == Py_None) {
+        fg_color_obj = 0;
+    }
+    if (bg_color_obj == Py_None) {
+        bg_color_obj = 0;
+    }
+
+    if (fg_color_obj) {
+        if (!RGBAFromColorObj(fg_color_obj, (Uint8 *)&fg_color)) {
+            PyErr_SetString(PyExc_TypeError, "fgcolor must be a Color");
+            return 0;
+        }
+    }
+    else {
+        fg_color.r = self->fgcolor[0];
+        fg_color.g = self->fgcolor[1];
+        fg_color.b = self->fgcolor[2];
+        fg_color.a = self->fgcolor[3];
+    }
+    if (bg_color_obj) {
+        if (!RGBAFromColorObj(bg_color_obj, (Uint8 *)&bg_color)) {
+            PyErr_SetString(PyExc_TypeError, "bgcolor must be a Color");
+            return 0;
+        }
+    }
+
+    ASSERT_SELF_IS_ALIVE(self);
+
+    seq = PySequence_Fast(textsobj,
+                          "texts must be a sequence of (dest, text) pairs");
+    if (!seq) goto error;
+    count = PySequence_Fast_GET_SIZE(seq);
+    items = _PGFT_malloc((size_t)(count ? count : 1) *
+                         sizeof(RenderManyItem));
+    if (!items) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    memset(items, 0, (size_t)(count ? count : 1) * sizeof(RenderManyItem));
+
+    /* Encode texts */
+    for (i = 0; i < count; ++i) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+            PyErr_Format(PyExc_TypeError,
+                         "Expected a (dest, text) pair for texts item %zd:"
+                         " got type %.1024s",
+                         i, Py_TYPE(item)->tp_name);
+            goto error;
+        }
+        if (parse_dest(PyTuple_GET_ITEM(item, 0),
+                       &items[i].x, &items[i].y)) goto error;
+        textobj = PyTuple_GET_ITEM(item, 1);
+        if (textobj != Py_None) {
+            items[i].text =
+                _PGFT_EncodePyString(textobj,
+                                     self->render_flags & FT_RFLAG_UCS4);
+            if (!items[i].text) goto error;
+        }
+    }
+
+    if (_PGFT_BuildRenderMode(self->freetype, self,
+                              &render, face_size, style, rotation))
+        goto error;
+
+    surface = PySurface_AsSurface(surface_obj);
+    PySurface_DropRLE(surface_obj);
+    PG_PERF_BEGIN(start);
+    if (render.render_flags & FT_RFLAG_ATLAS) {
+        /* Drawn through Surface.blit, so one text at a time */
+        for (i = 0; i < count; ++i) {
+            if (_PGFT_Render_AtlasSurface(self->freetype, self,
+                                          &render, items[i].text,
+                                          surface_obj,
+                                          items[i].x, items[i].y,
+                                          &fg_color,
+                                          bg_color_obj ? &bg_color : 0,
+                                          &items[i].r))
+                goto error;
+        }
+        error = 0;
+    }
+    else {
+        error = _PGFT_Render_Many(self->freetype, self, &render,
+                                  items, count, surface, &fg_color,
+                                  bg_color_obj ? &bg_color : 0);
+    }
+    if (error) goto error;
+    PG_PERF_ADD(PG_PERF_FONT_CALLS, count);
+    PG_PERF_END(start, PG_PERF_FONT_NS);
+
+    rects = PyList_New(count);
+    if (!rects) goto error;
+    for (i = 0; i < count; ++i) {
+        rectobj = PyRect_New(&items[i].r);
+        if (!rectobj) goto error;
+        PyList_SET_ITEM(rects, i, rectobj);
+    }
+
+    for (i = 0; i < count; ++i) {
+        free_string(items[i].text);
+    }
+    _PGFT_free(items);
+    Py_DECREF(seq);
+    return rects;
+
+  error:
+    if (items) {
+        for (i = 0; i < count; ++i) {
+            free_string(items[i].text);
+        }
+        _PGFT_free(items);
+    }
+    Py_XDECREF(seq);
+    Py_XDECREF(rects);
+    return 0;
+#endif // HAVE_PYGAME_SDL_VIDEO
+}
+
 /****************************************************
  * C API CALLS
  ****************************************************/
@@ -2065,7 +2538,7 @@ PgFont_New(const char *filename, long font_index)
         return 0;
     }
 
-    if (_PGFT_TryLoadFont_Filename(ft, font, filename, font_index)) {
+    if (_PGFT_TryLoadFont_Filename(ft, font, filename, font_index, 0)) {
         return 0;
     }
 
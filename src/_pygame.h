@@ -261,7 +261,57 @@ typedef getcharbufferproc charbufferproc;
 #define VIEW_F_ORDER       4
 
 #define PYGAMEAPI_BASE_FIRSTSLOT 0
-#define PYGAMEAPI_BASE_NUMSLOTS 19
+#define PYGAMEAPI_BASE_NUMSLOTS 25
+
+/* A job of PgPool_Run does rows first to first + n - 1 of data */
+typedef int (*PgPool_Job) (void *data, int first, int n);
+
+/* The instruction sets of PgCpu_GetFeatures */
+#define PG_CPU_MMX  0x01
+#define PG_CPU_SSE  0x02
+#define PG_CPU_SSE2 0x04
+#define PG_CPU_AVX2 0x08
+#define PG_CPU_NEON 0x10
+
+/* The counters of pygame.perf, kept by base. The blit pixel counters are
+ * one for each blend mode, at PG_PERF_BLIT_PIXELS + PG_PERF_BLEND_INDEX.
+ * The _NS counters add up nanoseconds.
+ */
+#define PG_PERF_BLEND_MODES 12
+#define PG_PERF_BLEND_INDEX(mode)                                       \
+    ((mode) <= 0x9 ? (mode) : (mode) - 0x6)
+#define PG_PERF_BLEND_VALID(mode)                                       \
+    ((mode) >= 0 && ((mode) <= 0x9 || (mode) == 0x10 || (mode) == 0x11))
+
+enum {
+    PG_PERF_BLIT_CALLS,
+    PG_PERF_BLIT_NS,
+    PG_PERF_BLIT_PIXELS,
+    PG_PERF_FILL_CALLS = PG_PERF_BLIT_PIXELS + PG_PERF_BLEND_MODES,
+    PG_PERF_FILL_PIXELS,
+    PG_PERF_FILL_NS,
+    PG_PERF_SMOOTHSCALE_CALLS,
+    PG_PERF_SMOOTHSCALE_PIXELS,
+    PG_PERF_SMOOTHSCALE_NS,
+    PG_PERF_DISPLAY_CALLS,
+    PG_PERF_DISPLAY_PIXELS,
+    PG_PERF_DISPLAY_NS,
+    PG_PERF_EVENT_CALLS,
+    PG_PERF_EVENT_EVENTS,
+    PG_PERF_EVENT_NS,
+    PG_PERF_FONT_CALLS,
+    PG_PERF_FONT_GLYPHS,
+    PG_PERF_FONT_CACHE_HITS,
+    PG_PERF_FONT_CACHE_MISSES,
+    PG_PERF_FONT_NS,
+    PG_PERF_NUMCOUNTERS
+};
+
+typedef struct {
+    int enabled;
+    Uint64 counts[PG_PERF_NUMCOUNTERS];
+} PgPerfCounters;
+
 #ifndef PYGAMEAPI_BASE_INTERNAL
 #define PyExc_SDLError ((PyObject*)PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT])
 
@@ -326,6 +376,45 @@ typedef getcharbufferproc charbufferproc;
 #define PgExc_BufferError                                               \
     ((PyObject*)PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT + 18])
 
+#define PgPool_Run                                                      \
+    (*(int(*)(PgPool_Job, void*, int, int, int))                        \
+     PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT + 19])
+
+#define PgPool_GetThreads                                               \
+    (*(int(*)(void))PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT + 20])
+
+#define PgCpu_GetFeatures                                               \
+    (*(int(*)(void))PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT + 21])
+
+#define PgSimd_Register                                                 \
+    (*(int(*)(const char*, PyObject*, PyObject*))                       \
+     PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT + 22])
+
+#define PgPerf                                                          \
+    ((PgPerfCounters*)PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT + 23])
+
+#define PgPerf_Now                                                      \
+    (*(Uint64(*)(void))PyGAME_C_API[PYGAMEAPI_BASE_FIRSTSLOT + 24])
+
+/* Count n in a counter of pygame.perf, if it is on */
+#define PG_PERF_ADD(counter, n)                                         \
+    do {                                                                \
+        if (PgPerf->enabled)                                            \
+            PgPerf->counts[counter] += (Uint64) (n);                    \
+    } while (0)
+
+/* Time from PG_PERF_BEGIN to PG_PERF_END into a _NS counter. start is a
+ * Uint64, left 0 while pygame.perf is off.
+ */
+#define PG_PERF_BEGIN(start)                                            \
+    ((start) = PgPerf->enabled ? PgPerf_Now () : 0)
+
+#define PG_PERF_END(start, counter)                                     \
+    do {                                                                \
+        if (start)                                                      \
+            PgPerf->counts[counter] += PgPerf_Now () - (start);         \
+    } while (0)
+
 #define import_pygame_base() IMPORT_PYGAME_MODULE(base, BASE)
 #endif
 
@@ -438,17 +527,109 @@ typedef struct {
 /* SURFACE */
 #define PYGAMEAPI_SURFACE_FIRSTSLOT                             \
     (PYGAMEAPI_DISPLAY_FIRSTSLOT + PYGAMEAPI_DISPLAY_NUMSLOTS)
-#define PYGAMEAPI_SURFACE_NUMSLOTS 3
+#define PYGAMEAPI_SURFACE_NUMSLOTS 8
+
+/* A copy of a Surface in the display format, that blits to the display use
+ * instead of the Surface when pygame.surface.set_auto_convert is on. It is
+ * kept while the Surface keeps the colorkey and alpha it was made with.
+ */
+typedef struct PgDisplayTwin {
+    PyObject *surface;
+    Uint32 flags;               /* SDL_SRCCOLORKEY and SDL_SRCALPHA */
+    Uint32 colorkey;
+    Uint8 alpha;
+    Uint8 display_bpp;          /* the display format it is in */
+    Uint32 display_rmask, display_gmask, display_bmask;
+} PgDisplayTwin;
+
+/* Named shared memory holding the pixels of a Surface, see surface_shm.c */
+typedef struct PgSharedPixels PgSharedPixels;
+
+/* Pixels a lazy Surface.copy shares with its source until either of them
+ * is changed, see surface_cow.c. unshare gives the Surface pixels of its
+ * own.
+ */
+typedef struct PgCowPixels {
+    void (*unshare) (PyObject *surfobj);
+} PgCowPixels;
+
+/* Pixels kept compressed by Surface.compress, see surface_pack.c. unpack
+ * decodes them, if they are not in memory, for reading or for writing.
+ * They stay in memory while pins, counting PySurface_Prep calls not yet
+ * undone by PySurface_Unprep, is above 0, or the Surface is locked or has
+ * subsurfaces, which point into them.
+ */
+typedef struct PgPackedPixels {
+    void (*unpack) (PyObject *surfobj, int write);
+    int pins;
+} PgPackedPixels;
+
 typedef struct {
     PyObject_HEAD
     SDL_Surface* surf;
     struct SubSurface_Data* subsurface;  /*ptr to subsurface data (if a
                                           * subsurface)*/
     PyObject *weakreflist;
-    PyObject *locklist;
+    PyObject *locklist;         /* weak references to other lock holders */
+    int selflocks;              /* locks held by the Surface itself */
     PyObject *dependency;
+    int premultiplied;  /* colour channels are multiplied by the alpha */
+    struct PgColorkeyRLE *rle;  /* colorkey runs cache, see surface.h */
+    struct PgDamage *damage;  /* changed areas, if tracking damage */
+    PgDisplayTwin *twin;        /* display format copy, if any */
+    unsigned long conversions;  /* display format copies made */
+    PgSharedPixels *shared;     /* shared memory of the pixels, if any */
+    PgCowPixels *cow;           /* pixels shared with copies, if any */
+    PgPackedPixels *packed;     /* compressed pixels, if any */
+    int subsurfaces;            /* live subsurfaces made from it */
 } PySurfaceObject;
 #define PySurface_AsSurface(x) (((PySurfaceObject*)x)->surf)
+
+/* The surface module caches the colorkey runs of a Surface for its own
+ * blits, and its display format twin, and drops both whenever the Surface
+ * is locked. Code that changes the pixels of a Surface without
+ * PySurface_Lock must drop them as well. PYGAME_RLE_IN_USE marks runs
+ * taken by a blit in progress.
+ *
+ * Pixels shared with lazy copies must be unshared, and compressed pixels
+ * decoded, before they are changed. PySurface_DropRLE does that too, so
+ * code that drops the cache before the change needs nothing else. Both
+ * go on to the owners of a subsurface, as PySurface_Lock does, since the
+ * pixels changed are theirs.
+ */
+#define PYGAME_RLE_IN_USE ((struct PgColorkeyRLE *) 1)
+#define PySurface_Unshare(x)                                            \
+    do {                                                                \
+        PySurfaceObject *_cowobj = (PySurfaceObject *) (x);             \
+        for (;;) {                                                      \
+            if (_cowobj->packed)                                        \
+                _cowobj->packed->unpack ((PyObject *) _cowobj, 1);      \
+            if (_cowobj->cow)                                           \
+                _cowobj->cow->unshare ((PyObject *) _cowobj);           \
+            if (!_cowobj->subsurface)                                   \
+                break;                                                  \
+            _cowobj = (PySurfaceObject *) _cowobj->subsurface->owner;   \
+        }                                                               \
+    } while (0)
+#define PySurface_DropRLE(x)                                            \
+    do {                                                                \
+        PySurfaceObject *_dropobj = (PySurfaceObject *) (x);            \
+        PySurface_Unshare (_dropobj);                                   \
+        for (;;) {                                                      \
+            if (_dropobj->rle != PYGAME_RLE_IN_USE)                     \
+                PyMem_Free (_dropobj->rle);                             \
+            _dropobj->rle = NULL;                                       \
+            if (_dropobj->twin) {                                       \
+                Py_XDECREF (_dropobj->twin->surface);                   \
+                PyMem_Free (_dropobj->twin);                            \
+                _dropobj->twin = NULL;                                  \
+            }                                                           \
+            if (!_dropobj->subsurface)                                  \
+                break;                                                  \
+            _dropobj = (PySurfaceObject *) _dropobj->subsurface->owner; \
+        }                                                               \
+    } while (0)
+
 #ifndef PYGAMEAPI_SURFACE_INTERNAL
 #define PySurface_Check(x)                                              \
     ((x)->ob_type == (PyTypeObject*)                                    \
@@ -461,6 +642,29 @@ typedef struct {
 #define PySurface_Blit                                                  \
     (*(int(*)(PyObject*,PyObject*,SDL_Rect*,SDL_Rect*,int))             \
      PyGAME_C_API[PYGAMEAPI_SURFACE_FIRSTSLOT + 2])
+#define PySurface_AddDamage                                             \
+    (*(void(*)(PyObject*,SDL_Rect*))                                    \
+     PyGAME_C_API[PYGAMEAPI_SURFACE_FIRSTSLOT + 3])
+#define PySurface_TakeDamage                                            \
+    (*(int(*)(PyObject*,SDL_Rect*,int))                                 \
+     PyGAME_C_API[PYGAMEAPI_SURFACE_FIRSTSLOT + 4])
+/* SDL_CreateRGBSurface and SDL_FreeSurface with the pixel buffer pool of
+ * the surface module. Surfaces made by PySurface_CreateRGBSurface must be
+ * freed by PySurface_FreeSurface, or by the Surface object holding them.
+ */
+#define PySurface_CreateRGBSurface                                      \
+    (*(SDL_Surface*(*)(Uint32,int,int,int,Uint32,Uint32,Uint32,Uint32)) \
+     PyGAME_C_API[PYGAMEAPI_SURFACE_FIRSTSLOT + 5])
+#define PySurface_FreeSurface                                           \
+    (*(void(*)(SDL_Surface*))                                           \
+     PyGAME_C_API[PYGAMEAPI_SURFACE_FIRSTSLOT + 6])
+/* A PyArg_ParseTuple "O&" converter for a source Surface, which also
+ * takes a pygame.SurfaceRegion. It sets a PyObject * to the Surface, or to
+ * a subsurface the region keeps, borrowed from the argument either way.
+ */
+#define PySurface_Source                                                \
+    (*(int(*)(PyObject*,void*))                                         \
+     PyGAME_C_API[PYGAMEAPI_SURFACE_FIRSTSLOT + 7])
 
 #define import_pygame_surface() do {                                   \
     IMPORT_PYGAME_MODULE(surface, SURFACE);                            \
@@ -494,12 +698,12 @@ typedef struct
     ((x)->ob_type == (PyTypeObject*)                    \
         PyGAME_C_API[PYGAMEAPI_SURFLOCK_FIRSTSLOT + 0])
 #define PySurface_Prep(x)                                               \
-    if(((PySurfaceObject*)x)->subsurface)                               \
+    if(((PySurfaceObject*)x)->subsurface || ((PySurfaceObject*)x)->packed) \
         (*(*(void(*)(PyObject*))                                        \
            PyGAME_C_API[PYGAMEAPI_SURFLOCK_FIRSTSLOT + 1]))(x)
 
 #define PySurface_Unprep(x)                                             \
-    if(((PySurfaceObject*)x)->subsurface)                               \
+    if(((PySurfaceObject*)x)->subsurface || ((PySurfaceObject*)x)->packed) \
         (*(*(void(*)(PyObject*))                                        \
            PyGAME_C_API[PYGAMEAPI_SURFLOCK_FIRSTSLOT + 2]))(x)
 
@@ -522,12 +726,13 @@ typedef struct
 /* EVENT */
 #define PYGAMEAPI_EVENT_FIRSTSLOT                                       \
     (PYGAMEAPI_SURFLOCK_FIRSTSLOT + PYGAMEAPI_SURFLOCK_NUMSLOTS)
-#define PYGAMEAPI_EVENT_NUMSLOTS 4
+#define PYGAMEAPI_EVENT_NUMSLOTS 5
 
 typedef struct {
     PyObject_HEAD
     int type;
-    PyObject* dict;
+    PyObject* dict;     /* NULL for an SDL event until first needed */
+    SDL_Event event;    /* the SDL event the dict is made from */
 } PyEventObject;
 
 #ifndef PYGAMEAPI_EVENT_INTERNAL
@@ -542,6 +747,9 @@ typedef struct {
 #define PyEvent_FillUserEvent                           \
     (*(int (*)(PyEventObject*, SDL_Event*))             \
      PyGAME_C_API[PYGAMEAPI_EVENT_FIRSTSLOT + 3])
+#define PyEvent_Coalesce                                \
+    (*(int (*)(SDL_Event*, int))                        \
+     PyGAME_C_API[PYGAMEAPI_EVENT_FIRSTSLOT + 4])
 #define import_pygame_event() IMPORT_PYGAME_MODULE(event, EVENT)
 #endif
 
@@ -550,7 +758,7 @@ typedef struct {
 /*the rwobject are only needed for C side work, not accessable from python*/
 #define PYGAMEAPI_RWOBJECT_FIRSTSLOT                            \
     (PYGAMEAPI_EVENT_FIRSTSLOT + PYGAMEAPI_EVENT_NUMSLOTS)
-#define PYGAMEAPI_RWOBJECT_NUMSLOTS 7
+#define PYGAMEAPI_RWOBJECT_NUMSLOTS 9
 #ifndef PYGAMEAPI_RWOBJECT_INTERNAL
 #define RWopsFromObject \
     (*(SDL_RWops*(*)(PyObject*))PyGAME_C_API[PYGAMEAPI_RWOBJECT_FIRSTSLOT + 0])
@@ -568,6 +776,12 @@ typedef struct {
         PyGAME_C_API[PYGAMEAPI_RWOBJECT_FIRSTSLOT + 5])
 #define RWopsFromFileObject                                         \
     (*(SDL_RWops*(*)(PyObject*))PyGAME_C_API[PYGAMEAPI_RWOBJECT_FIRSTSLOT + 6])
+#define RWopsFromFileName                                           \
+    (*(SDL_RWops*(*)(const char*))                                  \
+        PyGAME_C_API[PYGAMEAPI_RWOBJECT_FIRSTSLOT + 7])
+#define RWopsGetMemory                                              \
+    (*(int(*)(SDL_RWops*, const Uint8**, int*))                     \
+        PyGAME_C_API[PYGAMEAPI_RWOBJECT_FIRSTSLOT + 8])
 #define import_pygame_rwobject() IMPORT_PYGAME_MODULE(rwobject, RWOBJECT)
 
 /* For backward compatibility */
@@ -0,0 +1,1663 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * The drawing loops of the sprite groups in lib/sprite.py. The dirty rects
+ * are worked out on packed rects, and all the blits of a draw are done by
+ * one Surface.blits call, in the order the Python code would do them.
+ */
+#include <math.h>
+#include "pygame.h"
+#include "pgcompat.h"
+#include "doc/sprite_doc.h"
+
+static char _sprite_doc[] = "C speedups for pygame.sprite";
+
+/* Sprite attributes, interned when the module is loaded */
+enum {
+    SPRATTR_IMAGE,
+    SPRATTR_RECT,
+    SPRATTR_SOURCE_RECT,
+    SPRATTR_DIRTY,
+    SPRATTR_VISIBLE,
+    SPRATTR_BLENDMODE,
+    SPRATTR_RADIUS,
+    SPRATTR_COUNT
+};
+static const char *sprite_attr_names[SPRATTR_COUNT] = {
+    "image",
+    "rect",
+    "source_rect",
+    "dirty",
+    "_visible",
+    "blendmode",
+    "radius"
+};
+static PyObject *sprite_attr_strs[SPRATTR_COUNT];
+
+/* A growing array of packed rects */
+typedef struct {
+    GAME_Rect *rects;
+    Py_ssize_t len;
+    Py_ssize_t alloc;
+} RectList;
+
+static int
+rectlist_append (RectList *list, GAME_Rect *r)
+{
+    GAME_Rect *rects = list->rects;
+
+    if (list->len == list->alloc)
+    {
+        if (!PyMem_Resize (rects, GAME_Rect, list->alloc * 2 + 16))
+        {
+            PyErr_NoMemory ();
+            return -1;
+        }
+        list->rects = rects;
+        list->alloc = list->alloc * 2 + 16;
+    }
+    list->rects[list->len++] = *r;
+    return 0;
+}
+
+/* As Rect.colliderect */
+static int
+rects_intersect (GAME_Rect *A, GAME_Rect *B)
+{
+    return (A->x < B->x + B->w && A->y < B->y + B->h &&
+            A->x + A->w > B->x && A->y + A->h > B->y);
+}
+
+/* As Rect.clip: the part of A inside B, or A's position with no size */
+static void
+rect_clip (GAME_Rect *A, GAME_Rect *B, GAME_Rect *C)
+{
+    int x = MAX (A->x, B->x);
+    int y = MAX (A->y, B->y);
+    int r = MIN (A->x + A->w, B->x + B->w);
+    int b = MIN (A->y + A->h, B->y + B->h);
+
+    if (A->x < B->x + B->w && B->x < A->x + A->w &&
+        A->y < B->y + B->h && B->y < A->y + A->h)
+    {
+        C->x = x;
+        C->y = y;
+        C->w = r - x;
+        C->h = b - y;
+    }
+    else
+    {
+        C->x = A->x;
+        C->y = A->y;
+        C->w = 0;
+        C->h = 0;
+    }
+}
+
+static void
+rect_union (GAME_Rect *A, GAME_Rect *B)
+{
+    int x = MIN (A->x, B->x);
+    int y = MIN (A->y, B->y);
+
+    A->w = MAX (A->x + A->w, B->x + B->w) - x;
+    A->h = MAX (A->y + A->h, B->y + B->h) - y;
+    A->x = x;
+    A->y = y;
+}
+
+/* Take every rect of update that r collides with into r, one at a time
+ * from the first, and add r clipped to clip.
+ */
+static int
+dirty_add (RectList *update, GAME_Rect r, GAME_Rect *clip)
+{
+    GAME_Rect clipped;
+    Py_ssize_t i;
+
+    for (;;)
+    {
+        for (i = 0; i < update->len; i++)
+        {
+            if (rects_intersect (&r, update->rects + i))
+                break;
+        }
+        if (i == update->len)
+            break;
+        rect_union (&r, update->rects + i);
+        memmove (update->rects + i, update->rects + i + 1,
+                 (update->len - i - 1) * sizeof (GAME_Rect));
+        update->len--;
+    }
+    rect_clip (&r, clip, &clipped);
+    return rectlist_append (update, &clipped);
+}
+
+static int
+sprite_get_rect (PyObject *obj, GAME_Rect *r)
+{
+    GAME_Rect temp, *rect = GameRect_FromObject (obj, &temp);
+
+    if (!rect)
+    {
+        PyErr_SetString (PyExc_TypeError, "sprite rect must be a rect style "
+                         "object");
+        return -1;
+    }
+    *r = *rect;
+    return 0;
+}
+
+/* Get the sprite's attribute as an int; -1 with an exception set if not */
+static int
+sprite_get_int (PyObject *sprite, int attr, int *value)
+{
+    PyObject *obj = PyObject_GetAttr (sprite, sprite_attr_strs[attr]);
+    int ok;
+
+    if (!obj)
+        return -1;
+    ok = IntFromObj (obj, value);
+    Py_DECREF (obj);
+    if (!ok)
+    {
+        PyErr_Format (PyExc_TypeError, "sprite %s must be an integer",
+                      sprite_attr_names[attr]);
+        return -1;
+    }
+    return 0;
+}
+
+/* The area of the screen a dirty sprite covers: its rect, or the size of
+ * its source_rect at the rect position. Truth of source_rect picks, as
+ * the Python code does.
+ */
+static int
+sprite_screen_rect (PyObject *sprite, GAME_Rect *r, int use_truth)
+{
+    PyObject *rect, *source;
+    GAME_Rect src;
+    int use_source, result = -1;
+
+    rect = PyObject_GetAttr (sprite, sprite_attr_strs[SPRATTR_RECT]);
+    if (!rect)
+        return -1;
+    source = PyObject_GetAttr (sprite, sprite_attr_strs[SPRATTR_SOURCE_RECT]);
+    if (!source)
+        goto done;
+    use_source = use_truth ? PyObject_IsTrue (source) : source != Py_None;
+    if (use_source < 0 || sprite_get_rect (rect, r))
+        goto done;
+    if (use_source)
+    {
+        if (sprite_get_rect (source, &src))
+            goto done;
+        r->w = src.w;
+        r->h = src.h;
+    }
+    result = 0;
+
+done:
+    Py_DECREF (rect);
+    Py_XDECREF (source);
+    return result;
+}
+
+/* Append (image, dest, area, blendmode) of a sprite to items. area is
+ * source_rect when NULL.
+ */
+static int
+blit_item (PyObject *items, PyObject *sprite, PyObject *dest, PyObject *area)
+{
+    PyObject *image, *blendmode, *item;
+    int result = -1;
+
+    image = PyObject_GetAttr (sprite, sprite_attr_strs[SPRATTR_IMAGE]);
+    blendmode = PyObject_GetAttr (sprite, sprite_attr_strs[SPRATTR_BLENDMODE]);
+    if (!image || !blendmode)
+        goto done;
+    if (area)
+    {
+        item = PyTuple_Pack (4, image, dest, area, blendmode);
+    }
+    else
+    {
+        area = PyObject_GetAttr (sprite,
+                                 sprite_attr_strs[SPRATTR_SOURCE_RECT]);
+        if (!area)
+            goto done;
+        item = PyTuple_Pack (4, image, dest, area, blendmode);
+        Py_DECREF (area);
+    }
+    if (!item)
+        goto done;
+    result = PyList_Append (items, item);
+    Py_DECREF (item);
+
+done:
+    Py_XDECREF (image);
+    Py_XDECREF (blendmode);
+    return result;
+}
+
+static PyObject*
+rectlist_as_list (RectList *rects)
+{
+    PyObject *list = PyList_New (rects->len);
+    PyObject *rect;
+    Py_ssize_t i;
+
+    if (!list)
+        return NULL;
+    for (i = 0; i < rects->len; i++)
+    {
+        GAME_Rect *r = rects->rects + i;
+
+        rect = PyRect_New4 (r->x, r->y, r->w, r->h);
+        if (!rect)
+        {
+            Py_DECREF (list);
+            return NULL;
+        }
+        PyList_SET_ITEM (list, i, rect);
+    }
+    return list;
+}
+
+static PyObject*
+sprite_draw (PyObject *self, PyObject *args)
+{
+    PyObject *surface, *sprites, *spritedict, *dirty = Py_None;
+    PyObject *seq, *items = NULL, *newrects = NULL, *result = NULL;
+    PyObject *sprite, *item, *rect, *newrect, *old;
+    GAME_Rect a, b;
+    Py_ssize_t i, n;
+    int has_old;
+
+    if (!PyArg_ParseTuple (args, "OOO!|O", &surface, &sprites,
+                           &PyDict_Type, &spritedict, &dirty))
+        return NULL;
+    if (dirty != Py_None && !PyList_Check (dirty))
+        return RAISE (PyExc_TypeError, "dirty must be a list or None");
+
+    seq = PySequence_Fast (sprites, "sprites must be a sequence");
+    if (!seq)
+        return NULL;
+    n = PySequence_Fast_GET_SIZE (seq);
+    items = PyList_New (n);
+    if (!items)
+        goto done;
+    for (i = 0; i < n; i++)
+    {
+        sprite = PySequence_Fast_GET_ITEM (seq, i);
+        item = PyTuple_New (2);
+        if (!item)
+            goto done;
+        PyList_SET_ITEM (items, i, item);
+        PyTuple_SET_ITEM (item, 0, PyObject_GetAttr (
+                              sprite, sprite_attr_strs[SPRATTR_IMAGE]));
+        PyTuple_SET_ITEM (item, 1, PyObject_GetAttr (
+                              sprite, sprite_attr_strs[SPRATTR_RECT]));
+        if (!PyTuple_GET_ITEM (item, 0) || !PyTuple_GET_ITEM (item, 1))
+            goto done;
+    }
+    newrects = PyObject_CallMethod (surface, "blits", "(O)", items);
+    if (!newrects)
+        goto done;
+    if (!PyList_Check (newrects) || PyList_GET_SIZE (newrects) != n)
+    {
+        PyErr_SetString (PyExc_TypeError,
+                         "blits must return a rect for each sprite");
+        goto done;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        sprite = PySequence_Fast_GET_ITEM (seq, i);
+        newrect = PyList_GET_ITEM (newrects, i);
+        if (dirty != Py_None)
+        {
+            old = PyDict_GetItem (spritedict, sprite);
+            if (!old)
+            {
+                PyErr_SetObject (PyExc_KeyError, sprite);
+                goto done;
+            }
+            has_old = PyObject_IsTrue (old);
+            if (has_old < 0)
+                goto done;
+            if (has_old)
+            {
+                if (sprite_get_rect (newrect, &a) || sprite_get_rect (old, &b))
+                    goto done;
+                if (rects_intersect (&a, &b))
+                {
+                    rect_union (&a, &b);
+                    rect = PyRect_New4 (a.x, a.y, a.w, a.h);
+                    if (!rect || PyList_Append (dirty, rect))
+                    {
+                        Py_XDECREF (rect);
+                        goto done;
+                    }
+                    Py_DECREF (rect);
+                }
+                else if (PyList_Append (dirty, newrect) ||
+                         PyList_Append (dirty, old))
+                    goto done;
+            }
+            else if (PyList_Append (dirty, newrect))
+                goto done;
+        }
+        if (PyDict_SetItem (spritedict, sprite, newrect))
+            goto done;
+    }
+    result = dirty;
+    Py_INCREF (result);
+
+done:
+    Py_DECREF (seq);
+    Py_XDECREF (items);
+    Py_XDECREF (newrects);
+    return result;
+}
+
+/* Read the rect of each sprite to add to the dirty rects of
+ * layered_dirty_draw, and of the rect it was last blitted at.
+ */
+static int
+dirty_add_sprites (PyObject *seq, PyObject *spritedict, PyObject *init_rect,
+                   RectList *update, GAME_Rect *clip)
+{
+    Py_ssize_t i, n = PySequence_Fast_GET_SIZE (seq);
+    PyObject *sprite, *old;
+    GAME_Rect r;
+    int dirty;
+
+    for (i = 0; i < n; i++)
+    {
+        sprite = PySequence_Fast_GET_ITEM (seq, i);
+        if (sprite_get_int (sprite, SPRATTR_DIRTY, &dirty))
+            return -1;
+        if (dirty <= 0)
+            continue;
+        if (sprite_screen_rect (sprite, &r, 1) || dirty_add (update, r, clip))
+            return -1;
+        old = PyDict_GetItem (spritedict, sprite);
+        if (!old)
+        {
+            PyErr_SetObject (PyExc_KeyError, sprite);
+            return -1;
+        }
+        if (old != init_rect)
+        {
+            if (sprite_get_rect (old, &r) || dirty_add (update, r, clip))
+                return -1;
+        }
+    }
+    return 0;
+}
+
+static PyObject*
+sprite_layered_dirty_draw (PyObject *self, PyObject *args)
+{
+    PyObject *surface, *sprites, *spritedict, *updateobj, *clipobj, *bgd;
+    PyObject *init_rect;
+    int use_update;
+    PyObject *seq, *useq = NULL, *items = NULL, *newrects = NULL;
+    PyObject *rects = NULL, *result = NULL;
+    PyObject *sprite, *rect, *dest, *area, *visibleobj;
+    RectList update = {NULL, 0, 0};
+    Py_ssize_t *blitted = NULL;     /* the blit of each sprite, or -1 */
+    GAME_Rect clip, r, c;
+    Py_ssize_t i, j, n, nitems;
+    int dirty, visible, ok;
+
+    if (!PyArg_ParseTuple (args, "OOO!O!OOOi", &surface, &sprites,
+                           &PyDict_Type, &spritedict, &PyList_Type,
+                           &updateobj, &clipobj, &bgd, &init_rect,
+                           &use_update))
+        return NULL;
+    if (sprite_get_rect (clipobj, &clip))
+        return NULL;
+
+    seq = PySequence_Fast (sprites, "sprites must be a sequence");
+    if (!seq)
+        return NULL;
+    n = PySequence_Fast_GET_SIZE (seq);
+    blitted = PyMem_New (Py_ssize_t, n + 1);
+    items = PyList_New (0);
+    if (!blitted || !items)
+    {
+        if (!blitted)
+            PyErr_NoMemory ();
+        goto done;
+    }
+
+    if (use_update)
+    {
+        /* 1. find the dirty areas of the screen */
+        useq = PySequence_Fast (updateobj, "update must be a list");
+        if (!useq)
+            goto done;
+        for (i = 0; i < PySequence_Fast_GET_SIZE (useq); i++)
+        {
+            if (sprite_get_rect (PySequence_Fast_GET_ITEM (useq, i), &r) ||
+                rectlist_append (&update, &r))
+                goto done;
+        }
+        if (dirty_add_sprites (seq, spritedict, init_rect, &update, &clip))
+            goto done;
+        rects = rectlist_as_list (&update);
+        if (!rects)
+            goto done;
+
+        /* clear them to the background */
+        if (bgd != Py_None)
+        {
+            for (i = 0; i < update.len; i++)
+            {
+                rect = PyList_GET_ITEM (rects, i);
+                dest = PyTuple_Pack (3, bgd, rect, rect);
+                if (!dest || PyList_Append (items, dest))
+                {
+                    Py_XDECREF (dest);
+                    goto done;
+                }
+                Py_DECREF (dest);
+            }
+        }
+    }
+    else if (bgd != Py_None)
+    {
+        dest = Py_BuildValue ("(O(ii))", bgd, 0, 0);
+        if (!dest || PyList_Append (items, dest))
+        {
+            Py_XDECREF (dest);
+            goto done;
+        }
+        Py_DECREF (dest);
+    }
+
+    /* 2. draw */
+    for (i = 0; i < n; i++)
+    {
+        sprite = PySequence_Fast_GET_ITEM (seq, i);
+        blitted[i] = -1;
+        if (sprite_get_int (sprite, SPRATTR_DIRTY, &dirty))
+            goto done;
+        visibleobj = PyObject_GetAttr (sprite,
+                                       sprite_attr_strs[SPRATTR_VISIBLE]);
+        if (!visibleobj)
+            goto done;
+        visible = PyObject_IsTrue (visibleobj);
+        Py_DECREF (visibleobj);
+        if (visible < 0)
+            goto done;
+
+        if (use_update && dirty < 1)
+        {
+            /* not dirty: blit only the parts within dirty areas */
+            if (!visible)
+                continue;
+            if (sprite_screen_rect (sprite, &r, 0))
+                goto done;
+            for (j = 0; j < update.len; j++)
+            {
+                if (!rects_intersect (&r, update.rects + j))
+                    continue;
+                rect_clip (&r, update.rects + j, &c);
+                dest = PyRect_New4 (c.x, c.y, c.w, c.h);
+                area = PyRect_New4 (c.x - r.x, c.y - r.y, c.w, c.h);
+                ok = dest && area && !blit_item (items, sprite, dest, area);
+                Py_XDECREF (dest);
+                Py_XDECREF (area);
+                if (!ok)
+                    goto done;
+            }
+            continue;
+        }
+        if (visible)
+        {
+            rect = PyObject_GetAttr (sprite, sprite_attr_strs[SPRATTR_RECT]);
+            if (!rect)
+                goto done;
+            blitted[i] = PyList_GET_SIZE (items);
+            ok = !blit_item (items, sprite, rect, NULL);
+            Py_DECREF (rect);
+            if (!ok)
+                goto done;
+        }
+        if (use_update && dirty == 1)
+        {
+            PyObject *zero = PyInt_FromLong (0);
+
+            ok = zero && !PyObject_SetAttr (sprite,
+                                            sprite_attr_strs[SPRATTR_DIRTY],
+                                            zero);
+            Py_XDECREF (zero);
+            if (!ok)
+                goto done;
+        }
+    }
+
+    nitems = PyList_GET_SIZE (items);
+    newrects = PyObject_CallMethod (surface, "blits", "(O)", items);
+    if (!newrects)
+        goto done;
+    if (!PyList_Check (newrects) || PyList_GET_SIZE (newrects) != nitems)
+    {
+        PyErr_SetString (PyExc_TypeError,
+                         "blits must return a rect for each blit");
+        goto done;
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (blitted[i] >= 0 &&
+            PyDict_SetItem (spritedict, PySequence_Fast_GET_ITEM (seq, i),
+                            PyList_GET_ITEM (newrects, blitted[i])))
+            goto done;
+    }
+
+    if (use_update)
+    {
+        result = rects;
+        rects = NULL;
+    }
+    else
+        result = Py_BuildValue ("[N]",
+                                PyRect_New4 (clip.x, clip.y, clip.w, clip.h));
+
+done:
+    Py_DECREF (seq);
+    Py_XDECREF (useq);
+    Py_XDECREF (items);
+    Py_XDECREF (newrects);
+    Py_XDECREF (rects);
+    PyMem_Free (blitted);
+    PyMem_Free (update.rects);
+    return result;
+}
+
+/* The first index of the layer ordered sprites whose layer is above layer,
+ * or at or above it for below set. -1 with an exception set on error.
+ */
+static Py_ssize_t
+layer_bisect (PyObject *sprites, PyObject *layers, PyObject *layer,
+              int below)
+{
+    Py_ssize_t lo = 0, hi = PyList_GET_SIZE (sprites), mid;
+    PyObject *other;
+    int cmp;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        other = PyDict_GetItem (layers, PyList_GET_ITEM (sprites, mid));
+        if (!other)
+        {
+            PyErr_SetObject (PyExc_KeyError, PyList_GET_ITEM (sprites, mid));
+            return -1;
+        }
+        cmp = PyObject_RichCompareBool (other, layer, below ? Py_LT : Py_LE);
+        if (cmp < 0)
+            return -1;
+        if (cmp)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static PyObject*
+sprite_layer_insert (PyObject *self, PyObject *args)
+{
+    PyObject *sprites, *layers, *sprite, *layer;
+    Py_ssize_t i;
+
+    if (!PyArg_ParseTuple (args, "O!O!OO", &PyList_Type, &sprites,
+                           &PyDict_Type, &layers, &sprite, &layer))
+        return NULL;
+    i = layer_bisect (sprites, layers, layer, 0);
+    if (i < 0 || PyList_Insert (sprites, i, sprite))
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+sprite_layer_remove (PyObject *self, PyObject *args)
+{
+    PyObject *sprites, *layers, *sprite, *layer;
+    Py_ssize_t lo, hi;
+
+    if (!PyArg_ParseTuple (args, "O!O!O", &PyList_Type, &sprites,
+                           &PyDict_Type, &layers, &sprite))
+        return NULL;
+    layer = PyDict_GetItem (layers, sprite);
+    if (!layer)
+    {
+        PyErr_SetObject (PyExc_KeyError, sprite);
+        return NULL;
+    }
+    Py_INCREF (layer);
+    lo = layer_bisect (sprites, layers, layer, 1);
+    hi = lo < 0 ? -1 : layer_bisect (sprites, layers, layer, 0);
+    Py_DECREF (layer);
+    if (hi < 0)
+        return NULL;
+
+    /* only the sprites of its layer need be looked at */
+    for (; lo < hi; lo++)
+    {
+        if (PyList_GET_ITEM (sprites, lo) == sprite)
+        {
+            if (PyList_SetSlice (sprites, lo, lo + 1, NULL))
+                return NULL;
+            Py_RETURN_NONE;
+        }
+    }
+    return RAISE (PyExc_ValueError, "sprite is not in the sprite list");
+}
+
+static PyObject*
+sprite_layer_range (PyObject *self, PyObject *args)
+{
+    PyObject *sprites, *layers, *layer;
+    Py_ssize_t lo, hi;
+
+    if (!PyArg_ParseTuple (args, "O!O!O", &PyList_Type, &sprites,
+                           &PyDict_Type, &layers, &layer))
+        return NULL;
+    lo = layer_bisect (sprites, layers, layer, 1);
+    hi = lo < 0 ? -1 : layer_bisect (sprites, layers, layer, 0);
+    if (hi < 0)
+        return NULL;
+    return Py_BuildValue ("(nn)", lo, hi);
+}
+
+/* An entry of circle_pairs or rect_ratio_pairs: what it covers and its
+ * extent across, for the sweep
+ */
+typedef struct {
+    double lo, hi;
+    double cx, cy, radius;
+    GAME_Rect rect;
+    int index;
+    int set;
+} CollideItem;
+
+static int
+collide_item_cmp (const void *a, const void *b)
+{
+    const CollideItem *ia = (const CollideItem *) a;
+    const CollideItem *ib = (const CollideItem *) b;
+
+    if (ia->lo != ib->lo)
+        return ia->lo < ib->lo ? -1 : 1;
+    if (ia->set != ib->set)
+        return ia->set - ib->set;
+    return ia->index - ib->index;
+}
+
+static int
+collide_pair_cmp (const void *a, const void *b)
+{
+    const int *pa = (const int *) a, *pb = (const int *) b;
+
+    if (pa[0] != pb[0])
+        return pa[0] < pb[0] ? -1 : 1;
+    return pa[1] < pb[1] ? -1 : pa[1] > pb[1];
+}
+
+/* As collide_circle: within the sum of the radii, edges included */
+static int
+collide_circles (const CollideItem *a, const CollideItem *b)
+{
+    double dx = a->cx - b->cx, dy = a->cy - b->cy;
+    double r = a->radius + b->radius;
+
+    return dx * dx + dy * dy <= r * r;
+}
+
+static int
+collide_rects (const CollideItem *a, const CollideItem *b)
+{
+    return rects_intersect ((GAME_Rect *) &a->rect, (GAME_Rect *) &b->rect);
+}
+
+/* Sort and sweep, as mask.collide_pairs does: take the entries of both
+ * sets in order of their left edges, and test each one only against the
+ * entries of the other set still open across it. Touching edges are open
+ * for closed entries. Returns the sorted pairs of index as a list.
+ */
+static PyObject*
+collide_sweep (CollideItem *items, int n, int closed,
+               int (*test) (const CollideItem *, const CollideItem *))
+{
+    int *active[2], nactive[2] = {0, 0};
+    int *pairs = NULL, *more;
+    int i, j, k, npairs = 0, maxpairs = 64;
+    PyObject *result = NULL, *pair;
+
+    active[0] = PyMem_New (int, n + 1);
+    active[1] = PyMem_New (int, n + 1);
+    pairs = PyMem_New (int, 2 * maxpairs);
+    if (!active[0] || !active[1] || !pairs)
+    {
+        PyErr_NoMemory ();
+        goto done;
+    }
+
+    qsort (items, n, sizeof (CollideItem), collide_item_cmp);
+    for (i = 0; i < n; i++)
+    {
+        CollideItem *item = items + i;
+        int other = !item->set;
+        int *open = active[other];
+
+        /* drop the entries of the other set that end before this one */
+        for (j = k = 0; j < nactive[other]; j++)
+        {
+            CollideItem *o = items + open[j];
+
+            if (closed ? o->hi < item->lo : o->hi <= item->lo)
+                continue;
+            open[k++] = open[j];
+            if (!(item->set ? test (o, item) : test (item, o)))
+                continue;
+            if (npairs == maxpairs)
+            {
+                more = pairs;
+                if (!PyMem_Resize (more, int, 4 * maxpairs))
+                {
+                    PyErr_NoMemory ();
+                    goto done;
+                }
+                pairs = more;
+                maxpairs *= 2;
+            }
+            pairs[npairs * 2] = item->set ? o->index : item->index;
+            pairs[npairs * 2 + 1] = item->set ? item->index : o->index;
+            npairs++;
+        }
+        nactive[other] = k;
+        active[item->set][nactive[item->set]++] = i;
+    }
+    qsort (pairs, npairs, sizeof (int) * 2, collide_pair_cmp);
+
+    result = PyList_New (npairs);
+    if (!result)
+        goto done;
+    for (i = 0; i < npairs; i++)
+    {
+        pair = Py_BuildValue ("(ii)", pairs[i * 2], pairs[i * 2 + 1]);
+        if (!pair)
+        {
+            Py_DECREF (result);
+            result = NULL;
+            goto done;
+        }
+        PyList_SET_ITEM (result, i, pair);
+    }
+
+done:
+    PyMem_Free (active[0]);
+    PyMem_Free (active[1]);
+    PyMem_Free (pairs);
+    return result;
+}
+
+/* The rect attribute of a sprite, which must be rect style */
+static int
+sprite_rect (PyObject *sprite, GAME_Rect *r)
+{
+    PyObject *rect = PyObject_GetAttr (sprite, sprite_attr_strs[SPRATTR_RECT]);
+    int result;
+
+    if (!rect)
+        return -1;
+    result = sprite_get_rect (rect, r);
+    Py_DECREF (rect);
+    return result;
+}
+
+/* The circle of a sprite for collide_circle_ratio: around the center of
+ * its rect, with its radius, or first given half the diagonal of the rect
+ * as radius when set is true.
+ */
+static int
+circle_item (PyObject *sprite, double ratio, int set, CollideItem *item)
+{
+    PyObject *radiusobj;
+    GAME_Rect r;
+    double radius, extent;
+
+    if (sprite_rect (sprite, &r))
+        return -1;
+    item->cx = r.x + (r.w >> 1);
+    item->cy = r.y + (r.h >> 1);
+
+    radiusobj = PyObject_GetAttr (sprite, sprite_attr_strs[SPRATTR_RADIUS]);
+    if (radiusobj)
+    {
+        radius = PyFloat_AsDouble (radiusobj);
+        Py_DECREF (radiusobj);
+        if (radius == -1.0 && PyErr_Occurred ())
+            return -1;
+    }
+    else
+    {
+        if (!PyErr_ExceptionMatches (PyExc_AttributeError))
+            return -1;
+        PyErr_Clear ();
+        radius = 0.5 * pow ((double) r.w * r.w + (double) r.h * r.h, 0.5);
+        if (set)
+        {
+            radiusobj = PyFloat_FromDouble (radius);
+            if (!radiusobj ||
+                PyObject_SetAttr (sprite, sprite_attr_strs[SPRATTR_RADIUS],
+                                  radiusobj))
+            {
+                Py_XDECREF (radiusobj);
+                return -1;
+            }
+            Py_DECREF (radiusobj);
+        }
+    }
+    item->radius = radius * ratio;
+
+    /* the extent covers the circle if any sum of radii it takes part in
+     * does, negative ones included */
+    extent = fabs (item->radius);
+    item->lo = item->cx - extent;
+    item->hi = item->cx + extent;
+    return 0;
+}
+
+/* The rect of a sprite inflated by ratio, as collide_rect_ratio does */
+static int
+rect_ratio_item (PyObject *sprite, double ratio, CollideItem *item)
+{
+    GAME_Rect *r = &item->rect;
+    int dx, dy;
+
+    if (sprite_rect (sprite, r))
+        return -1;
+    dx = (int) (r->w * ratio - r->w);
+    dy = (int) (r->h * ratio - r->h);
+    r->x -= dx / 2;
+    r->y -= dy / 2;
+    r->w += dx;
+    r->h += dy;
+    item->lo = MIN (r->x, r->x + r->w);
+    item->hi = MAX (r->x, r->x + r->w);
+    return 0;
+}
+
+static PyObject*
+sprite_collide_pairs (PyObject *args, int circles)
+{
+    PyObject *spritesa, *spritesb, *seq[2] = {NULL, NULL}, *result = NULL;
+    CollideItem *items = NULL, *item;
+    double ratio;
+    Py_ssize_t i, n[2];
+    int set, count = 0;
+
+    if (!PyArg_ParseTuple (args, "OOd", &spritesa, &spritesb, &ratio))
+        return NULL;
+    seq[0] = PySequence_Fast (spritesa, "sprites must be a sequence");
+    seq[1] = PySequence_Fast (spritesb, "sprites must be a sequence");
+    if (!seq[0] || !seq[1])
+        goto done;
+    n[0] = PySequence_Fast_GET_SIZE (seq[0]);
+    n[1] = PySequence_Fast_GET_SIZE (seq[1]);
+    if (n[0] + n[1] > INT_MAX / 2)
+    {
+        PyErr_SetString (PyExc_ValueError, "too many sprites");
+        goto done;
+    }
+    items = PyMem_New (CollideItem, n[0] + n[1] + 1);
+    if (!items)
+    {
+        PyErr_NoMemory ();
+        goto done;
+    }
+
+    for (set = 0; set < 2; set++)
+    {
+        for (i = 0; i < n[set]; i++)
+        {
+            PyObject *sprite = PySequence_Fast_GET_ITEM (seq[set], i);
+
+            item = items + count;
+            /* the Python callbacks give each sprite a radius as soon as
+             * it is tested, which all are when neither set is empty */
+            if (circles ? circle_item (sprite, ratio, n[0] && n[1], item) :
+                rect_ratio_item (sprite, ratio, item))
+                goto done;
+            /* NaN radii collide with nothing, and do not sort */
+            if (item->lo != item->lo || item->hi != item->hi)
+                continue;
+            item->index = (int) i;
+            item->set = set;
+            count++;
+        }
+    }
+    if (circles)
+        result = collide_sweep (items, count, 1, collide_circles);
+    else
+        result = collide_sweep (items, count, 0, collide_rects);
+
+done:
+    Py_XDECREF (seq[0]);
+    Py_XDECREF (seq[1]);
+    PyMem_Free (items);
+    return result;
+}
+
+static PyObject*
+sprite_circle_pairs (PyObject *self, PyObject *args)
+{
+    return sprite_collide_pairs (args, 1);
+}
+
+static PyObject*
+sprite_rect_ratio_pairs (PyObject *self, PyObject *args)
+{
+    return sprite_collide_pairs (args, 0);
+}
+
+/* SpriteBatch: many sprites that are only a position, a velocity, an image
+ * of the atlas, a layer and a visibility, each kept in an array of its own.
+ */
+typedef struct {
+    PyObject *surface;
+    PyObject *area;             /* NULL for the whole surface */
+    int w, h;
+} BatchImage;
+
+typedef struct {
+    PyObject_HEAD
+    BatchImage *images;
+    Py_ssize_t nimages;
+    double *x, *y, *vx, *vy;
+    int *image;
+    int *layer;
+    Uint8 *visible;
+    Py_ssize_t len;
+    Py_ssize_t alloc;
+    Py_ssize_t *order;          /* the draw order, while ordered is set */
+    int ordered;
+} PySpriteBatch;
+
+static PyTypeObject PySpriteBatch_Type;
+
+static void
+batch_free_arrays (PySpriteBatch *self)
+{
+    PyMem_Free (self->x);
+    PyMem_Free (self->y);
+    PyMem_Free (self->vx);
+    PyMem_Free (self->vy);
+    PyMem_Free (self->image);
+    PyMem_Free (self->layer);
+    PyMem_Free (self->visible);
+    PyMem_Free (self->order);
+}
+
+static int
+batch_grow (PySpriteBatch *self)
+{
+    Py_ssize_t alloc = self->alloc * 2 + 16;
+    double *x = self->x, *y = self->y, *vx = self->vx, *vy = self->vy;
+    int *image = self->image, *layer = self->layer;
+    Uint8 *visible = self->visible;
+    Py_ssize_t *order = self->order;
+
+    /* each array is kept as soon as it is moved, so a failure leaves the
+     * batch as it was, with some arrays larger than they need be */
+    if (PyMem_Resize (x, double, alloc))
+        self->x = x;
+    if (PyMem_Resize (y, double, alloc))
+        self->y = y;
+    if (PyMem_Resize (vx, double, alloc))
+        self->vx = vx;
+    if (PyMem_Resize (vy, double, alloc))
+        self->vy = vy;
+    if (PyMem_Resize (image, int, alloc))
+        self->image = image;
+    if (PyMem_Resize (layer, int, alloc))
+        self->layer = layer;
+    if (PyMem_Resize (visible, Uint8, alloc))
+        self->visible = visible;
+    if (PyMem_Resize (order, Py_ssize_t, alloc))
+        self->order = order;
+    if (!x || !y || !vx || !vy || !image || !layer || !visible || !order)
+    {
+        PyErr_NoMemory ();
+        return -1;
+    }
+    self->alloc = alloc;
+    return 0;
+}
+
+static int
+batch_check_index (PySpriteBatch *self, Py_ssize_t index)
+{
+    if (index < 0 || index >= self->len)
+    {
+        PyErr_SetString (PyExc_IndexError, "sprite index out of range");
+        return -1;
+    }
+    return 0;
+}
+
+static int
+batch_check_image (PySpriteBatch *self, int image)
+{
+    if (image < 0 || image >= self->nimages)
+    {
+        PyErr_SetString (PyExc_IndexError, "image index out of range");
+        return -1;
+    }
+    return 0;
+}
+
+static int
+batch_get_pair (PyObject *obj, const char *name, double *a, double *b)
+{
+    PyObject *item;
+    int ok = 0;
+
+    if (PySequence_Check (obj) && PySequence_Size (obj) == 2)
+    {
+        item = PySequence_GetItem (obj, 0);
+        ok = item && ((*a = PyFloat_AsDouble (item)) != -1.0 ||
+                      !PyErr_Occurred ());
+        Py_XDECREF (item);
+        if (ok)
+        {
+            item = PySequence_GetItem (obj, 1);
+            ok = item && ((*b = PyFloat_AsDouble (item)) != -1.0 ||
+                          !PyErr_Occurred ());
+            Py_XDECREF (item);
+        }
+    }
+    if (!ok)
+    {
+        PyErr_Clear ();
+        PyErr_Format (PyExc_TypeError, "%s must be a pair of numbers", name);
+        return -1;
+    }
+    return 0;
+}
+
+/* The rect a sprite covers, at the whole pixel its position is in */
+static void
+batch_rect (PySpriteBatch *self, Py_ssize_t i, GAME_Rect *r)
+{
+    BatchImage *image = self->images + self->image[i];
+
+    r->x = (int) floor (self->x[i]);
+    r->y = (int) floor (self->y[i]);
+    r->w = image->w;
+    r->h = image->h;
+}
+
+static void
+batch_dealloc (PySpriteBatch *self)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < self->nimages; i++)
+    {
+        Py_DECREF (self->images[i].surface);
+        Py_XDECREF (self->images[i].area);
+    }
+    PyMem_Free (self->images);
+    batch_free_arrays (self);
+    Py_TYPE (self)->tp_free ((PyObject *) self);
+}
+
+static PyObject*
+batch_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *imagesobj, *seq, *item, *surface, *area;
+    PySpriteBatch *self;
+    BatchImage *image;
+    GAME_Rect temp, *r;
+    Py_ssize_t i;
+    static char *kwids[] = {"images", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O", kwids, &imagesobj))
+        return NULL;
+    seq = PySequence_Fast (imagesobj, "images must be a sequence");
+    if (!seq)
+        return NULL;
+    self = (PySpriteBatch *) type->tp_alloc (type, 0);
+    if (!self)
+    {
+        Py_DECREF (seq);
+        return NULL;
+    }
+    self->images = PyMem_New (BatchImage,
+                              PySequence_Fast_GET_SIZE (seq) + 1);
+    if (!self->images)
+    {
+        Py_DECREF (seq);
+        Py_DECREF (self);
+        return PyErr_NoMemory ();
+    }
+
+    for (i = 0; i < PySequence_Fast_GET_SIZE (seq); i++)
+    {
+        item = PySequence_Fast_GET_ITEM (seq, i);
+        area = NULL;
+        if (PyTuple_Check (item) && PyTuple_GET_SIZE (item) == 2)
+        {
+            surface = PyTuple_GET_ITEM (item, 0);
+            area = PyTuple_GET_ITEM (item, 1);
+        }
+        else
+            surface = item;
+        if (!PySurface_Check (surface))
+        {
+            Py_DECREF (seq);
+            Py_DECREF (self);
+            return RAISE (PyExc_TypeError, "images must be Surfaces or "
+                          "(Surface, area) pairs");
+        }
+        if (area)
+        {
+            if (!(r = GameRect_FromObject (area, &temp)) ||
+                r->w < 0 || r->h < 0)
+            {
+                Py_DECREF (seq);
+                Py_DECREF (self);
+                return RAISE (PyExc_TypeError, "image area must be a rect "
+                              "style object");
+            }
+        }
+        else if (!PySurface_AsSurface (surface))
+        {
+            Py_DECREF (seq);
+            Py_DECREF (self);
+            return RAISE (PyExc_SDLError, "display Surface quit");
+        }
+        image = self->images + self->nimages++;
+        Py_INCREF (surface);
+        Py_XINCREF (area);
+        image->surface = surface;
+        image->area = area;
+        image->w = area ? r->w : PySurface_AsSurface (surface)->w;
+        image->h = area ? r->h : PySurface_AsSurface (surface)->h;
+    }
+    Py_DECREF (seq);
+    return (PyObject *) self;
+}
+
+static Py_ssize_t
+batch_length (PySpriteBatch *self)
+{
+    return self->len;
+}
+
+static PyObject*
+batch_add (PySpriteBatch *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *posobj, *velobj = NULL;
+    double x, y, vx = 0.0, vy = 0.0;
+    int image = 0, layer = 0, visible = 1;
+    Py_ssize_t i;
+    static char *kwids[] = {"pos", "image", "velocity", "layer", "visible",
+                            NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|iOii", kwids, &posobj,
+                                      &image, &velobj, &layer, &visible))
+        return NULL;
+    if (batch_get_pair (posobj, "pos", &x, &y) ||
+        (velobj && batch_get_pair (velobj, "velocity", &vx, &vy)) ||
+        batch_check_image (self, image))
+        return NULL;
+    if (self->len == self->alloc && batch_grow (self))
+        return NULL;
+
+    i = self->len++;
+    self->x[i] = x;
+    self->y[i] = y;
+    self->vx[i] = vx;
+    self->vy[i] = vy;
+    self->image[i] = image;
+    self->layer[i] = layer;
+    self->visible[i] = visible ? 1 : 0;
+    self->ordered = 0;
+    return PyInt_FromSsize_t (i);
+}
+
+static PyObject*
+batch_remove (PySpriteBatch *self, PyObject *args)
+{
+    Py_ssize_t i, last;
+
+    if (!PyArg_ParseTuple (args, "n", &i) || batch_check_index (self, i))
+        return NULL;
+
+    /* the last sprite takes the place of the removed one */
+    last = --self->len;
+    self->x[i] = self->x[last];
+    self->y[i] = self->y[last];
+    self->vx[i] = self->vx[last];
+    self->vy[i] = self->vy[last];
+    self->image[i] = self->image[last];
+    self->layer[i] = self->layer[last];
+    self->visible[i] = self->visible[last];
+    self->ordered = 0;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+batch_get (PySpriteBatch *self, PyObject *args)
+{
+    Py_ssize_t i;
+
+    if (!PyArg_ParseTuple (args, "n", &i) || batch_check_index (self, i))
+        return NULL;
+    return Py_BuildValue ("(dd)(dd)iiO", self->x[i], self->y[i],
+                          self->vx[i], self->vy[i], self->image[i],
+                          self->layer[i],
+                          self->visible[i] ? Py_True : Py_False);
+}
+
+static PyObject*
+batch_set (PySpriteBatch *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *posobj = NULL, *velobj = NULL, *imageobj = NULL;
+    PyObject *layerobj = NULL, *visibleobj = NULL;
+    double x = 0.0, y = 0.0, vx = 0.0, vy = 0.0;
+    int image = 0, layer = 0, visible = 0;
+    Py_ssize_t i;
+    static char *kwids[] = {"index", "pos", "velocity", "image", "layer",
+                            "visible", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "n|OOOOO", kwids, &i,
+                                      &posobj, &velobj, &imageobj,
+                                      &layerobj, &visibleobj) ||
+        batch_check_index (self, i))
+        return NULL;
+
+    /* check everything before changing anything */
+    if (posobj && posobj != Py_None &&
+        batch_get_pair (posobj, "pos", &x, &y))
+        return NULL;
+    if (velobj && velobj != Py_None &&
+        batch_get_pair (velobj, "velocity", &vx, &vy))
+        return NULL;
+    if (imageobj && imageobj != Py_None)
+    {
+        if (!IntFromObj (imageobj, &image))
+            return RAISE (PyExc_TypeError, "image must be an integer");
+        if (batch_check_image (self, image))
+            return NULL;
+    }
+    if (layerobj && layerobj != Py_None && !IntFromObj (layerobj, &layer))
+        return RAISE (PyExc_TypeError, "layer must be an integer");
+    if (visibleobj && visibleobj != Py_None &&
+        (visible = PyObject_IsTrue (visibleobj)) < 0)
+        return NULL;
+
+    if (posobj && posobj != Py_None)
+    {
+        self->x[i] = x;
+        self->y[i] = y;
+    }
+    if (velobj && velobj != Py_None)
+    {
+        self->vx[i] = vx;
+        self->vy[i] = vy;
+    }
+    if (imageobj && imageobj != Py_None)
+        self->image[i] = image;
+    if (layerobj && layerobj != Py_None && layer != self->layer[i])
+    {
+        self->layer[i] = layer;
+        self->ordered = 0;
+    }
+    if (visibleobj && visibleobj != Py_None)
+        self->visible[i] = (Uint8) visible;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+batch_get_rect (PySpriteBatch *self, PyObject *args)
+{
+    GAME_Rect r;
+    Py_ssize_t i;
+
+    if (!PyArg_ParseTuple (args, "n", &i) || batch_check_index (self, i))
+        return NULL;
+    batch_rect (self, i, &r);
+    return PyRect_New4 (r.x, r.y, r.w, r.h);
+}
+
+static PyObject*
+batch_update (PySpriteBatch *self, PyObject *args)
+{
+    double dt, *x = self->x, *y = self->y, *vx = self->vx, *vy = self->vy;
+    Py_ssize_t i, n = self->len;
+
+    if (!PyArg_ParseTuple (args, "d", &dt))
+        return NULL;
+    for (i = 0; i < n; i++)
+    {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+batch_cull (PySpriteBatch *self, PyObject *args)
+{
+    PyObject *viewobj, *list, *index;
+    GAME_Rect temp, *view, r;
+    Py_ssize_t i;
+
+    if (!PyArg_ParseTuple (args, "O", &viewobj))
+        return NULL;
+    if (!(view = GameRect_FromObject (viewobj, &temp)))
+        return RAISE (PyExc_TypeError, "viewport must be a rect style "
+                      "object");
+    list = PyList_New (0);
+    if (!list)
+        return NULL;
+    for (i = 0; i < self->len; i++)
+    {
+        if (!self->visible[i])
+            continue;
+        batch_rect (self, i, &r);
+        if (!rects_intersect (&r, view))
+            continue;
+        index = PyInt_FromSsize_t (i);
+        if (!index || PyList_Append (list, index))
+        {
+            Py_XDECREF (index);
+            Py_DECREF (list);
+            return NULL;
+        }
+        Py_DECREF (index);
+    }
+    return list;
+}
+
+/* For the draw order: by layer, then by index */
+static PySpriteBatch *sorting_batch;
+
+static int
+batch_compare (const void *a, const void *b)
+{
+    Py_ssize_t i = *(const Py_ssize_t *) a, j = *(const Py_ssize_t *) b;
+    int *layer = sorting_batch->layer;
+
+    if (layer[i] != layer[j])
+        return layer[i] < layer[j] ? -1 : 1;
+    return i < j ? -1 : i > j;
+}
+
+static PyObject*
+batch_draw (PySpriteBatch *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *surface, *viewobj = Py_None, *items, *item, *result;
+    GAME_Rect temp, *view, clip, r;
+    SDL_Surface *surf;
+    BatchImage *image;
+    Py_ssize_t i, k;
+    static char *kwids[] = {"surface", "viewport", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O!|O", kwids,
+                                      &PySurface_Type, &surface, &viewobj))
+        return NULL;
+    surf = PySurface_AsSurface (surface);
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    clip.x = surf->clip_rect.x;
+    clip.y = surf->clip_rect.y;
+    clip.w = surf->clip_rect.w;
+    clip.h = surf->clip_rect.h;
+    temp.x = temp.y = 0;
+    view = &temp;
+    if (viewobj != Py_None)
+    {
+        if (!(view = GameRect_FromObject (viewobj, &temp)))
+            return RAISE (PyExc_TypeError, "viewport must be a rect style "
+                          "object");
+        /* the viewport is shown at the top left of the Surface, so only
+         * what both it and the moved clip rect hold is drawn */
+        r.x = clip.x + view->x;
+        r.y = clip.y + view->y;
+        r.w = clip.w;
+        r.h = clip.h;
+        rect_clip (&r, view, &clip);
+    }
+
+    if (!self->ordered)
+    {
+        for (i = 0; i < self->len; i++)
+            self->order[i] = i;
+        sorting_batch = self;
+        qsort (self->order, self->len, sizeof (Py_ssize_t), batch_compare);
+        self->ordered = 1;
+    }
+
+    items = PyList_New (0);
+    if (!items)
+        return NULL;
+    for (k = 0; k < self->len; k++)
+    {
+        i = self->order[k];
+        if (!self->visible[i])
+            continue;
+        batch_rect (self, i, &r);
+        if (!rects_intersect (&r, &clip))
+            continue;
+        image = self->images + self->image[i];
+        if (image->area)
+            item = Py_BuildValue ("(O(ii)O)", image->surface,
+                                  r.x - view->x, r.y - view->y, image->area);
+        else
+            item = Py_BuildValue ("(O(ii))", image->surface,
+                                  r.x - view->x, r.y - view->y);
+        if (!item || PyList_Append (items, item))
+        {
+            Py_XDECREF (item);
+            Py_DECREF (items);
+            return NULL;
+        }
+        Py_DECREF (item);
+    }
+    result = PyObject_CallMethod (surface, "blits", "(O)", items);
+    Py_DECREF (items);
+    return result;
+}
+
+static PyMethodDef batch_methods[] =
+{
+    { "add", (PyCFunction) batch_add, METH_VARARGS | METH_KEYWORDS,
+      DOC_SPRITEBATCHADD },
+    { "remove", (PyCFunction) batch_remove, METH_VARARGS,
+      DOC_SPRITEBATCHREMOVE },
+    { "get", (PyCFunction) batch_get, METH_VARARGS, DOC_SPRITEBATCHGET },
+    { "set", (PyCFunction) batch_set, METH_VARARGS | METH_KEYWORDS,
+      DOC_SPRITEBATCHSET },
+    { "get_rect", (PyCFunction) batch_get_rect, METH_VARARGS,
+      DOC_SPRITEBATCHGETRECT },
+    { "update", (PyCFunction) batch_update, METH_VARARGS,
+      DOC_SPRITEBATCHUPDATE },
+    { "cull", (PyCFunction) batch_cull, METH_VARARGS, DOC_SPRITEBATCHCULL },
+    { "draw", (PyCFunction) batch_draw, METH_VARARGS | METH_KEYWORDS,
+      DOC_SPRITEBATCHDRAW },
+    { NULL, NULL, 0, NULL }
+};
+
+static PySequenceMethods batch_as_sequence =
+{
+    (lenfunc) batch_length,     /* sq_length */
+};
+
+static PyTypeObject PySpriteBatch_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "pygame.sprite.SpriteBatch",        /* tp_name */
+    sizeof (PySpriteBatch),             /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor) batch_dealloc,         /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_compare */
+    0,                                  /* tp_repr */
+    0,                                  /* tp_as_number */
+    &batch_as_sequence,                 /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash */
+    0,                                  /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* tp_flags */
+    DOC_PYGAMESPRITESPRITEBATCH,        /* Documentation string */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    0,                                  /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    batch_methods,                      /* tp_methods */
+    0,                                  /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    batch_new,                          /* tp_new */
+};
+
+static PyMethodDef _sprite_methods[] =
+{
+    { "draw", sprite_draw, METH_VARARGS,
+      "draw(surface, sprites, spritedict, dirty=None) -> dirty\n"
+      "blit the sprites, keeping their rects in spritedict, and add the "
+      "rects that changed to the dirty list of a RenderUpdates" },
+    { "layered_dirty_draw", sprite_layered_dirty_draw, METH_VARARGS,
+      "layered_dirty_draw(surface, sprites, spritedict, update, clip, bgd, "
+      "init_rect, use_update) -> Rect_list\n"
+      "the drawing of LayeredDirty.draw, in dirty rect or full screen mode" },
+    { "circle_pairs", sprite_circle_pairs, METH_VARARGS,
+      "circle_pairs(spritesa, spritesb, ratio) -> [(i, j), ...]\n"
+      "the pairs of index of the sprites that collide_circle_ratio(ratio) "
+      "finds colliding" },
+    { "rect_ratio_pairs", sprite_rect_ratio_pairs, METH_VARARGS,
+      "rect_ratio_pairs(spritesa, spritesb, ratio) -> [(i, j), ...]\n"
+      "the pairs of index of the sprites that collide_rect_ratio(ratio) "
+      "finds colliding" },
+    { "layer_insert", sprite_layer_insert, METH_VARARGS,
+      "layer_insert(sprites, layers, sprite, layer) -> None\n"
+      "insert sprite after the sprites of its layer in the layer ordered "
+      "list" },
+    { "layer_remove", sprite_layer_remove, METH_VARARGS,
+      "layer_remove(sprites, layers, sprite) -> None\n"
+      "remove sprite from the layer ordered list, looking only in its layer" },
+    { "layer_range", sprite_layer_range, METH_VARARGS,
+      "layer_range(sprites, layers, layer) -> (start, stop)\n"
+      "the slice of the layer ordered list that holds the sprites of layer" },
+    { NULL, NULL, 0, NULL }
+};
+
+MODINIT_DEFINE (_sprite)
+{
+    PyObject *module;
+    int i;
+
+#if PY3
+    static struct PyModuleDef _module = {
+        PyModuleDef_HEAD_INIT,
+        "_sprite",
+        _sprite_doc,
+        -1,
+        _sprite_methods,
+        NULL, NULL, NULL, NULL
+    };
+#endif
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
+    import_pygame_rect ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
+    import_pygame_surface ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
+    if (PyType_Ready (&PySpriteBatch_Type) < 0) {
+        MODINIT_ERROR;
+    }
+
+    for (i = 0; i < SPRATTR_COUNT; ++i) {
+        if (!sprite_attr_strs[i]) {
+#if PY3
+            sprite_attr_strs[i] =
+                PyUnicode_InternFromString (sprite_attr_names[i]);
+#else
+            sprite_attr_strs[i] =
+                PyString_InternFromString (sprite_attr_names[i]);
+#endif
+            if (!sprite_attr_strs[i]) {
+                MODINIT_ERROR;
+            }
+        }
+    }
+
+    /* create the module */
+#if PY3
+    module = PyModule_Create (&_module);
+#else
+    module = Py_InitModule3 (MODPREFIX "_sprite", _sprite_methods,
+                             _sprite_doc);
+#endif
+    if (!module) {
+        MODINIT_ERROR;
+    }
+    Py_INCREF ((PyObject *) &PySpriteBatch_Type);
+    if (PyModule_AddObject (module, "SpriteBatch",
+                            (PyObject *) &PySpriteBatch_Type)) {
+        Py_DECREF ((PyObject *) &PySpriteBatch_Type);
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
+    MODINIT_RETURN (module);
+}
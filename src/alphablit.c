@@ -24,27 +24,22 @@
 
 #define NO_PYGAME_C_API
 #include "_surface.h"
+#include "simd_blitters.h"
 
-/* The structure passed to the low level blit functions */
-typedef struct
-{
-    int              width;
-    int              height;
-    Uint8           *s_pixels;
-    int              s_pxskip;
-    int              s_skip;
-    Uint8           *d_pixels;
-    int              d_pxskip;
-    int              d_skip;
-    SDL_PixelFormat *src;
-    SDL_PixelFormat *dst;
-    Uint32           src_flags;
-    Uint32           dst_flags;
-} SDL_BlitInfo;
+#if defined(PG_ENABLE_SSE2_BLITTERS)
+#include <SDL_cpuinfo.h>
+#endif
+
+/* Most threads a single blit is split across */
+#define PG_BLIT_MAX_THREADS 32
+
+PgBlitters pg_blitters = {0, 0, 0, 0, {0, 0, 0, 0, 0, 0}, 0, 0};
 
 static void alphablit_alpha (SDL_BlitInfo * info);
 static void alphablit_colorkey (SDL_BlitInfo * info);
+static void alphablit_colorkey_rle (SDL_BlitInfo * info);
 static void alphablit_solid (SDL_BlitInfo * info);
+static int alphablit_indexed (SDL_BlitInfo * info, int keyed);
 static void blit_blend_add (SDL_BlitInfo * info);
 static void blit_blend_sub (SDL_BlitInfo * info);
 static void blit_blend_mul (SDL_BlitInfo * info);
@@ -62,17 +57,159 @@ static void blit_blend_premultiplied (SDL_BlitInfo * info);
 
 static int
 SoftBlitPyGame (SDL_Surface * src, SDL_Rect * srcrect,
-                SDL_Surface * dst, SDL_Rect * dstrect, int the_args);
+                SDL_Surface * dst, SDL_Rect * dstrect, int the_args,
+                PgColorkeyRLE * rle);
 extern int  SDL_RLESurface (SDL_Surface * surface);
 extern void SDL_UnRLESurface (SDL_Surface * surface, int recode);
 
+/* Pick the blitter for a blit. Returns NULL if the_args is not a valid
+ * blend mode.
+ */
+static BLIT_FUNC_P
+soft_blit_func (SDL_BlitInfo * info, int the_args)
+{
+    switch (the_args)
+    {
+    case 0:
+        if (info->src_flags & SDL_SRCALPHA && info->src->Amask)
+            return alphablit_alpha;
+        else if (info->src_flags & SDL_SRCCOLORKEY)
+            return alphablit_colorkey;
+        return alphablit_solid;
+    case PYGAME_BLEND_ADD:
+        return blit_blend_add;
+    case PYGAME_BLEND_SUB:
+        return blit_blend_sub;
+    case PYGAME_BLEND_MULT:
+        return blit_blend_mul;
+    case PYGAME_BLEND_MIN:
+        return blit_blend_min;
+    case PYGAME_BLEND_MAX:
+        return blit_blend_max;
+    case PYGAME_BLEND_RGBA_ADD:
+        return blit_blend_rgba_add;
+    case PYGAME_BLEND_RGBA_SUB:
+        return blit_blend_rgba_sub;
+    case PYGAME_BLEND_RGBA_MULT:
+        return blit_blend_rgba_mul;
+    case PYGAME_BLEND_RGBA_MIN:
+        return blit_blend_rgba_min;
+    case PYGAME_BLEND_RGBA_MAX:
+        return blit_blend_rgba_max;
+    case PYGAME_BLEND_PREMULTIPLIED:
+        return blit_blend_premultiplied;
+    }
+    return NULL;
+}
+
+/* --------------------------------------------------------- */
+
+/* Threaded blits. A large blit is cut into bands of rows done on the
+ * pygame worker pool, see pygame_WorkerRun. Every blitter works a row at
+ * a time, so the bands give the same pixels as one blit.
+ */
+
+/* Blits smaller than this stay on the calling thread */
+#define PG_BLIT_THREAD_MIN_PIXELS (256 * 256)
+/* Smallest band given to a thread */
+#define PG_BLIT_THREAD_MIN_ROWS 16
+
+typedef struct
+{
+    BLIT_FUNC_P     func;
+    SDL_BlitInfo    info;
+    int             s_pitch;
+    int             d_pitch;
+} BlitJob;
+
+/* The most pool threads a blit uses, set by pygame_SetBlitThreads */
+static int blit_threads = 0;
+
+/* Worker pool job blitting rows first to first + n - 1 of a BlitJob */
+static int
+blit_rows (void *data, int first, int n)
+{
+    BlitJob *job = (BlitJob *) data;
+    SDL_BlitInfo info = job->info;
+
+    info.height = n;
+    info.s_pixels += first * job->s_pitch;
+    info.d_pixels += first * job->d_pitch;
+    info.s_y += first;
+    job->func (&info);
+    return 0;
+}
+
+/* Do the blit described by info in bands on the worker pool, with the GIL
+ * released. Returns 0, leaving the blit to the caller, if the blit is too
+ * small, reversed, reads and writes the same pixels or the pool has no
+ * workers. With the pool in use by another thread the bands are all done
+ * on this one.
+ */
+static int
+blit_threaded (SDL_BlitInfo * info, BLIT_FUNC_P func)
+{
+    BlitJob job;
+    Uint8 *s_end, *d_end;
+
+    if (info->width * info->height < PG_BLIT_THREAD_MIN_PIXELS ||
+        info->s_pxskip <= 0 || info->d_pxskip <= 0 ||
+        info->height < 2 * PG_BLIT_THREAD_MIN_ROWS ||
+        pygame_WorkerThreads () < 2)
+        return 0;
+    job.func = func;
+    job.info = *info;
+    job.s_pitch = info->width * info->s_pxskip + info->s_skip;
+    job.d_pitch = info->width * info->d_pxskip + info->d_skip;
+    s_end = info->s_pixels + info->height * job.s_pitch;
+    d_end = info->d_pixels + info->height * job.d_pitch;
+    if (info->s_pixels < d_end && info->d_pixels < s_end)
+        return 0;
+
+    Py_BEGIN_ALLOW_THREADS;
+    pygame_WorkerRun (blit_rows, &job, info->height, PG_BLIT_THREAD_MIN_ROWS,
+                      blit_threads > 1 ? blit_threads : PG_BLIT_MAX_THREADS);
+    Py_END_ALLOW_THREADS;
+    return 1;
+}
+
+/* Set the most pool threads used for large blits. 0 or 1 turns threaded
+ * blits off, except for blits with the PYGAME_BLIT_THREADED flag, which
+ * may use all of them.
+ */
+int
+pygame_SetBlitThreads (int threads)
+{
+    if (threads < 0)
+    {
+        SDL_SetError ("thread count must not be negative");
+        return -1;
+    }
+    if (threads > PG_BLIT_MAX_THREADS)
+        threads = PG_BLIT_MAX_THREADS;
+    blit_threads = threads;
+    return 0;
+}
+
+int
+pygame_GetBlitThreads (void)
+{
+    return blit_threads;
+}
+
 static int
 SoftBlitPyGame (SDL_Surface * src, SDL_Rect * srcrect, SDL_Surface * dst,
-                SDL_Rect * dstrect, int the_args)
+                SDL_Rect * dstrect, int the_args, PgColorkeyRLE * rle)
 {
     int okay;
     int src_locked;
     int dst_locked;
+    int threaded;
+    BLIT_FUNC_P func;
+
+    /* A threaded blit is asked for by this call or by set_blit_threads */
+    threaded = (the_args & PYGAME_BLIT_THREADED) || blit_threads > 1;
+    the_args &= ~PYGAME_BLIT_THREADED;
 
     /* Everything is okay at the beginning...  */
     okay = 1;
@@ -118,6 +255,9 @@ SoftBlitPyGame (SDL_Surface * src, SDL_Rect * srcrect, SDL_Surface * dst,
         info.dst = dst->format;
         info.src_flags = src->flags;
         info.dst_flags = dst->flags;
+        info.s_rle = rle;
+        info.s_x = srcrect->x;
+        info.s_y = srcrect->y;
 
         if (info.d_pixels > info.s_pixels)
         {
@@ -142,107 +282,320 @@ SoftBlitPyGame (SDL_Surface * src, SDL_Rect * srcrect, SDL_Surface * dst,
                                      span - info.d_pxskip);
                     info.d_pxskip = -info.d_pxskip;
                     info.d_skip = -info.d_skip;
+                    info.s_rle = NULL;
                 }
             }
         }
 
-        switch (the_args)
-        {
-        case 0:
+        func = soft_blit_func (&info, the_args);
+        if (!func)
         {
-            if (src->flags & SDL_SRCALPHA && src->format->Amask)
-                alphablit_alpha (&info);
-            else if (src->flags & SDL_SRCCOLORKEY)
-                alphablit_colorkey (&info);
-            else
-                alphablit_solid (&info);
-            break;
-        }
-        case PYGAME_BLEND_ADD:
-        {
-            blit_blend_add (&info);
-            break;
-        }
-        case PYGAME_BLEND_SUB:
-        {
-            blit_blend_sub (&info);
-            break;
-        }
-        case PYGAME_BLEND_MULT:
-        {
-            blit_blend_mul (&info);
-            break;
-        }
-        case PYGAME_BLEND_MIN:
-        {
-            blit_blend_min (&info);
-            break;
+            SDL_SetError ("Invalid argument passed to blit.");
+            okay = 0;
         }
-        case PYGAME_BLEND_MAX:
+        else if (!threaded || !blit_threaded (&info, func))
         {
-            blit_blend_max (&info);
-            break;
+            func (&info);
         }
+    }
+    /* We need to unlock the surfaces if they're locked */
+    if (dst_locked)
+        SDL_UnlockSurface (dst);
+    if (src_locked)
+        SDL_UnlockSurface (src);
+    /* Blit is done! */
+    return (okay ? 0 : -1);
+}
 
-        case PYGAME_BLEND_RGBA_ADD:
-        {
-        blit_blend_rgba_add (&info);
-        break;
-        }
-        case PYGAME_BLEND_RGBA_SUB:
-        {
-            blit_blend_rgba_sub (&info);
-            break;
-        }
-        case PYGAME_BLEND_RGBA_MULT:
-        {
-            blit_blend_rgba_mul (&info);
-            break;
-        }
-        case PYGAME_BLEND_RGBA_MIN:
-        {
-            blit_blend_rgba_min (&info);
-            break;
-        }
-        case PYGAME_BLEND_RGBA_MAX:
+
+
+
+
+
+
+
+/* --------------------------------------------------------- */
+
+/* Fill in the PgBlendMasks for a 32 bit blend blit of the same RGB layout,
+ * giving the same result as the generic code below. Returns 0 if the SIMD
+ * blend blitters can not do this blit.
+ */
+static int
+blend_masks_32 (SDL_BlitInfo * info, int rgba, PgBlendMasks * masks)
+{
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    Uint32          rgbmask;
+    Uint32          abyte;
+    int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
+    int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+
+    if (srcfmt->BytesPerPixel != 4 || dstfmt->BytesPerPixel != 4 ||
+        info->s_pxskip != 4 || info->d_pxskip != 4 ||
+        srcfmt->Rmask != dstfmt->Rmask || srcfmt->Gmask != dstfmt->Gmask ||
+        srcfmt->Bmask != dstfmt->Bmask ||
+        dstfmt->Rmask != (Uint32) 0xFF << dstfmt->Rshift ||
+        dstfmt->Gmask != (Uint32) 0xFF << dstfmt->Gshift ||
+        dstfmt->Bmask != (Uint32) 0xFF << dstfmt->Bshift)
+        return 0;
+
+    rgbmask = dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask;
+    abyte = ~rgbmask;
+    if (rgba)
+    {
+        /* Only called with per-pixel alpha on the destination */
+        if (dstfmt->Amask != abyte ||
+            (srcfmt->Amask && srcfmt->Amask != abyte))
+            return 0;
+        masks->sor = srcppa ? 0 : abyte;
+        masks->rmask = 0xFFFFFFFF;
+        masks->dmask = 0;
+        masks->dor = 0;
+    }
+    else
+    {
+        masks->sor = 0;
+        masks->rmask = rgbmask;
+        if (!(info->src_flags & SDL_SRCALPHA) || dstppa)
         {
-            blit_blend_rgba_max (&info);
-            break;
+            masks->dmask = abyte;
+            masks->dor = 0;
         }
-        case PYGAME_BLEND_PREMULTIPLIED:
+        else
         {
-            blit_blend_premultiplied (&info);
-            break;
+            masks->dmask = 0;
+            masks->dor = dstfmt->Amask;
         }
+    }
+    return 1;
+}
 
+/* --------------------------------------------------------- */
 
+/* The 16 bit blends of pygame_Blend16 (). With no alpha and the green
+ * channel in the middle, as in RGB565, BGR565, RGB555 and BGR555, a pixel p
+ * spread over 32 bits as (p | p << 16) & spread has a free guard bit above
+ * each channel, so all three channels are added, subtracted or compared at
+ * once. The 8 bit values of the generic code have the channel bits
+ * replicated into their low bits, which never carry into the stored bits,
+ * so the results are the same.
+ */
+typedef struct
+{
+    Uint32 spread;    /* the channel bits of a spread pixel */
+    Uint32 guard;     /* the bit above each channel */
+    Uint32 low5;      /* the lowest bit of the 5 bit red and blue */
+    Uint32 lowg;      /* the lowest bit of green */
+    Uint32 rgbmask;
+    int    gshift;
+    int    gbits;     /* 5 or 6 */
+    int    hishift;   /* shift of the upper of red and blue */
+} PgBlend16;
+
+/* Multiply tables of the 5 and 6 bit channels, made by pygame_BlitInit */
+static Uint8 blend16_mul5[32 * 32];
+static Uint8 blend16_mul6[64 * 64];
 
+static void
+blend16_init (void)
+{
+    int a, b, a8, b8;
 
-        default:
+    for (a = 0; a < 32; ++a)
+    {
+        for (b = 0; b < 32; ++b)
         {
-            SDL_SetError ("Invalid argument passed to blit.");
-            okay = 0;
-            break;
+            a8 = (a << 3) + (a >> 2);
+            b8 = (b << 3) + (b >> 2);
+            blend16_mul5[(a << 5) | b] = (Uint8) (((a8 * b8) >> 8) >> 3);
         }
+    }
+    for (a = 0; a < 64; ++a)
+    {
+        for (b = 0; b < 64; ++b)
+        {
+            a8 = (a << 2) + (a >> 4);
+            b8 = (b << 2) + (b >> 4);
+            blend16_mul6[(a << 6) | b] = (Uint8) (((a8 * b8) >> 8) >> 2);
         }
     }
-    /* We need to unlock the surfaces if they're locked */
-    if (dst_locked)
-        SDL_UnlockSurface (dst);
-    if (src_locked)
-        SDL_UnlockSurface (src);
-    /* Blit is done! */
-    return (okay ? 0 : -1);
 }
 
+/* Fill in the PgBlend16 for a blend blit or fill between 16 bit pixels of
+ * the same layout. Returns 0 if the layout is not one it handles.
+ */
+static int
+blend16_format (SDL_BlitInfo * info, PgBlend16 * b)
+{
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *fmt = info->dst;
+    Uint32          lomask, himask;
+    int             loloss, hiloss, hishift;
+
+    if (srcfmt->BytesPerPixel != 2 || fmt->BytesPerPixel != 2 ||
+        (info->s_pxskip != 2 && info->s_pxskip != 0) ||
+        info->d_pxskip != 2 ||
+        srcfmt->Rmask != fmt->Rmask || srcfmt->Gmask != fmt->Gmask ||
+        srcfmt->Bmask != fmt->Bmask || srcfmt->Amask || fmt->Amask)
+        return 0;
+
+    if (fmt->Rshift == 0)
+    {
+        lomask = fmt->Rmask;
+        loloss = fmt->Rloss;
+        himask = fmt->Bmask;
+        hiloss = fmt->Bloss;
+        hishift = fmt->Bshift;
+    }
+    else if (fmt->Bshift == 0)
+    {
+        lomask = fmt->Bmask;
+        loloss = fmt->Bloss;
+        himask = fmt->Rmask;
+        hiloss = fmt->Rloss;
+        hishift = fmt->Rshift;
+    }
+    else
+        return 0;
+
+    if (loloss != 3 || hiloss != 3 || (fmt->Gloss != 2 && fmt->Gloss != 3) ||
+        lomask != 0x1F || fmt->Gshift != 5 ||
+        fmt->Gmask != (Uint32) (0xFF >> fmt->Gloss) << 5 ||
+        hishift != 5 + 8 - fmt->Gloss || himask != (Uint32) 0x1F << hishift)
+        return 0;
+
+    b->gshift = 5;
+    b->gbits = 8 - fmt->Gloss;
+    b->hishift = hishift;
+    b->rgbmask = lomask | fmt->Gmask | himask;
+    b->spread = lomask | himask | fmt->Gmask << 16;
+    b->low5 = 1 | (Uint32) 1 << hishift;
+    b->lowg = (Uint32) 1 << (16 + 5);
+    b->guard = b->low5 << 5 | b->lowg << b->gbits;
+    return 1;
+}
 
+/* The spread pixel of the pixel at p */
+#define BLEND16_SPREAD(p, b) \
+    ((*((Uint16 *) (p)) | (Uint32) *((Uint16 *) (p)) << 16) & (b)->spread)
+
+/* The channels of a spread pixel with their guard bit in o set to all ones */
+#define BLEND16_FIELDS(o, b)                           \
+    ((o) - ((((o) >> 5) & (b)->low5) |                 \
+            (((o) >> (b)->gbits) & (b)->lowg)))
+
+#define BLEND16_LOOP(code)                              \
+    while (height--)                                    \
+    {                                                   \
+        LOOP_UNROLLED4(                                 \
+        {                                               \
+            code;                                       \
+            src += srcpxskip;                           \
+            dst += 2;                                   \
+        }, n, width);                                   \
+        src += srcskip;                                 \
+        dst += dstskip;                                 \
+    }
 
+static void
+blit_blend_16 (SDL_BlitInfo * info, PgBlend16 * b, int op)
+{
+    int             n;
+    int             width = info->width;
+    int             height = info->height;
+    Uint8          *src = info->s_pixels;
+    int             srcpxskip = info->s_pxskip;
+    int             srcskip = info->s_skip;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    Uint32          guard = b->guard;
+    Uint32          spread = b->spread;
+    Uint32          rgbmask = b->rgbmask;
+    Uint32          s, d, t, m;
 
+    switch (op)
+    {
+    case PYGAME_BLEND_ADD:
+        BLEND16_LOOP(
+        {
+            t = BLEND16_SPREAD (dst, b) + BLEND16_SPREAD (src, b);
+            m = t & guard;
+            t = (t | BLEND16_FIELDS (m, b)) & spread;
+            *((Uint16 *) dst) = (Uint16) ((t | t >> 16) & rgbmask);
+        });
+        break;
+    case PYGAME_BLEND_SUB:
+        BLEND16_LOOP(
+        {
+            t = (BLEND16_SPREAD (dst, b) | guard) - BLEND16_SPREAD (src, b);
+            m = t & guard;
+            t &= BLEND16_FIELDS (m, b);
+            *((Uint16 *) dst) = (Uint16) ((t | t >> 16) & rgbmask);
+        });
+        break;
+    case PYGAME_BLEND_MIN:
+        BLEND16_LOOP(
+        {
+            d = BLEND16_SPREAD (dst, b);
+            s = BLEND16_SPREAD (src, b);
+            m = ((d | guard) - s) & guard;
+            m = BLEND16_FIELDS (m, b);
+            t = (s & m) | (d & ~m & spread);
+            *((Uint16 *) dst) = (Uint16) ((t | t >> 16) & rgbmask);
+        });
+        break;
+    case PYGAME_BLEND_MAX:
+        BLEND16_LOOP(
+        {
+            d = BLEND16_SPREAD (dst, b);
+            s = BLEND16_SPREAD (src, b);
+            m = ((d | guard) - s) & guard;
+            m = BLEND16_FIELDS (m, b);
+            t = (d & m) | (s & ~m & spread);
+            *((Uint16 *) dst) = (Uint16) ((t | t >> 16) & rgbmask);
+        });
+        break;
+    case PYGAME_BLEND_MULT:
+    {
+        int hishift = b->hishift;
+        Uint32 gmax = ((Uint32) 1 << b->gbits) - 1;
+        const Uint8 *mulg = b->gbits == 6 ? blend16_mul6 : blend16_mul5;
+
+        BLEND16_LOOP(
+        {
+            d = *((Uint16 *) dst);
+            s = *((Uint16 *) src);
+            t = blend16_mul5[(d & 0x1F) << 5 | (s & 0x1F)];
+            t |= (Uint32) mulg[((d >> 5) & gmax) << b->gbits |
+                               ((s >> 5) & gmax)] << 5;
+            t |= (Uint32) blend16_mul5[((d >> hishift) & 0x1F) << 5 |
+                                       ((s >> hishift) & 0x1F)] << hishift;
+            *((Uint16 *) dst) = (Uint16) t;
+        });
+        break;
+    }
+    }
+}
 
+#undef BLEND16_LOOP
 
+/* Does a blend of op, PYGAME_BLEND_ADD .. PYGAME_BLEND_MAX, between 16 bit
+ * pixels of the same RGB565 or RGB555 layout with no alpha, for a blit or,
+ * with a source pixel step of 0, a fill. Returns -1 if it can not.
+ */
+int
+pygame_Blend16 (SDL_BlitInfo * info, int op)
+{
+    PgBlend16 b;
 
+    if (op < PYGAME_BLEND_ADD || op > PYGAME_BLEND_MAX ||
+        !blend16_format (info, &b))
+        return -1;
+    if (info->width > 0 && info->height > 0)
+        blit_blend_16 (info, &b, op);
+    return 0;
+}
 
-/* --------------------------------------------------------- */
 
 
 static void
@@ -266,6 +619,7 @@ blit_blend_rgba_add (SDL_BlitInfo * info)
     Uint32          tmp;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
 
     if (!dstppa)
     {
@@ -273,6 +627,12 @@ blit_blend_rgba_add (SDL_BlitInfo * info)
         return;
     }
 
+    if (pg_blitters.blend[PYGAME_BLEND_ADD] && blend_masks_32 (info, 1, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_ADD] (info, &masks);
+        return;
+    }
+
     if (srcbpp == 4 && dstbpp == 4 &&
         srcfmt->Rmask == dstfmt->Rmask &&
         srcfmt->Gmask == dstfmt->Gmask &&
@@ -406,6 +766,7 @@ blit_blend_rgba_sub (SDL_BlitInfo * info)
     Sint32          tmp2;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
 
     if (!dstppa)
     {
@@ -413,6 +774,12 @@ blit_blend_rgba_sub (SDL_BlitInfo * info)
         return;
     }
 
+    if (pg_blitters.blend[PYGAME_BLEND_SUB] && blend_masks_32 (info, 1, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_SUB] (info, &masks);
+        return;
+    }
+
     if (srcbpp == 4 && dstbpp == 4 &&
         srcfmt->Rmask == dstfmt->Rmask &&
         srcfmt->Gmask == dstfmt->Gmask &&
@@ -546,6 +913,7 @@ blit_blend_rgba_mul (SDL_BlitInfo * info)
     Uint32          tmp;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
 
     if (!dstppa)
     {
@@ -553,6 +921,12 @@ blit_blend_rgba_mul (SDL_BlitInfo * info)
         return;
     }
 
+    if (pg_blitters.blend[PYGAME_BLEND_MULT] && blend_masks_32 (info, 1, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_MULT] (info, &masks);
+        return;
+    }
+
     if (srcbpp == 4 && dstbpp == 4 &&
         srcfmt->Rmask == dstfmt->Rmask &&
         srcfmt->Gmask == dstfmt->Gmask &&
@@ -685,6 +1059,7 @@ blit_blend_rgba_min (SDL_BlitInfo * info)
     Uint32          pixel;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
 
     if (!dstppa)
     {
@@ -692,6 +1067,12 @@ blit_blend_rgba_min (SDL_BlitInfo * info)
     return;
     }
 
+    if (pg_blitters.blend[PYGAME_BLEND_MIN] && blend_masks_32 (info, 1, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_MIN] (info, &masks);
+        return;
+    }
+
     if (srcbpp == 4 && dstbpp == 4 &&
         srcfmt->Rmask == dstfmt->Rmask &&
         srcfmt->Gmask == dstfmt->Gmask &&
@@ -824,6 +1205,7 @@ blit_blend_rgba_max (SDL_BlitInfo * info)
     Uint32          pixel;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
 
     if (!dstppa)
     {
@@ -831,6 +1213,12 @@ blit_blend_rgba_max (SDL_BlitInfo * info)
         return;
     }
 
+    if (pg_blitters.blend[PYGAME_BLEND_MAX] && blend_masks_32 (info, 1, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_MAX] (info, &masks);
+        return;
+    }
+
     if (srcbpp == 4 && dstbpp == 4 &&
         srcfmt->Rmask == dstfmt->Rmask &&
         srcfmt->Gmask == dstfmt->Gmask &&
@@ -969,6 +1357,12 @@ blit_blend_premultiplied (SDL_BlitInfo * info)
     printf ("Premultiplied alpha blit with %d and %d\n", srcbpp, dstbpp);
     */
 
+    if (pg_blitters.premultiplied_argb && srcppa && PG_SIMD_BLIT_OK (info))
+    {
+        pg_blitters.premultiplied_argb (info);
+        return;
+    }
+
     if (srcbpp == 1)
     {
         if (dstbpp == 1)
@@ -1086,6 +1480,16 @@ blit_blend_add (SDL_BlitInfo * info)
     Uint32          tmp;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
+
+    if (pg_blitters.blend[PYGAME_BLEND_ADD] && blend_masks_32 (info, 0, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_ADD] (info, &masks);
+        return;
+    }
+
+    if (!pygame_Blend16 (info, PYGAME_BLEND_ADD))
+        return;
 
     if (srcbpp >= 3 && dstbpp >= 3 && !(info->src_flags & SDL_SRCALPHA))
     {
@@ -1273,6 +1677,16 @@ blit_blend_sub (SDL_BlitInfo * info)
     Sint32          tmp2;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
+
+    if (pg_blitters.blend[PYGAME_BLEND_SUB] && blend_masks_32 (info, 0, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_SUB] (info, &masks);
+        return;
+    }
+
+    if (!pygame_Blend16 (info, PYGAME_BLEND_SUB))
+        return;
 
     if (srcbpp >= 3 && dstbpp >= 3 && !(info->src_flags & SDL_SRCALPHA))
     {
@@ -1460,6 +1874,16 @@ blit_blend_mul (SDL_BlitInfo * info)
     Uint32          tmp;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
+
+    if (pg_blitters.blend[PYGAME_BLEND_MULT] && blend_masks_32 (info, 0, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_MULT] (info, &masks);
+        return;
+    }
+
+    if (!pygame_Blend16 (info, PYGAME_BLEND_MULT))
+        return;
 
     if (srcbpp >= 3 && dstbpp >= 3 && !(info->src_flags & SDL_SRCALPHA))
     {
@@ -1649,6 +2073,16 @@ blit_blend_min (SDL_BlitInfo * info)
     Uint32          pixel;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
+
+    if (pg_blitters.blend[PYGAME_BLEND_MIN] && blend_masks_32 (info, 0, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_MIN] (info, &masks);
+        return;
+    }
+
+    if (!pygame_Blend16 (info, PYGAME_BLEND_MIN))
+        return;
 
     if (srcbpp >= 3 && dstbpp >= 3 && !(info->src_flags & SDL_SRCALPHA))
     {
@@ -1841,6 +2275,16 @@ blit_blend_max (SDL_BlitInfo * info)
     Uint32          pixel;
     int             srcppa = (info->src_flags & SDL_SRCALPHA && srcfmt->Amask);
     int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    PgBlendMasks    masks;
+
+    if (pg_blitters.blend[PYGAME_BLEND_MAX] && blend_masks_32 (info, 0, &masks))
+    {
+        pg_blitters.blend[PYGAME_BLEND_MAX] (info, &masks);
+        return;
+    }
+
+    if (!pygame_Blend16 (info, PYGAME_BLEND_MAX))
+        return;
 
     if (srcbpp >= 3 && dstbpp >= 3 && !(info->src_flags & SDL_SRCALPHA))
     {
@@ -2071,6 +2515,12 @@ alphablit_alpha (SDL_BlitInfo * info)
        printf ("Alpha blit with %d and %d\n", srcbpp, dstbpp);
        */
 
+    if (pg_blitters.alpha_argb && PG_SIMD_BLIT_OK (info))
+    {
+        pg_blitters.alpha_argb (info);
+        return;
+    }
+
     if (srcbpp == 1)
     {
         if (dstbpp == 1)
@@ -2152,6 +2602,223 @@ alphablit_alpha (SDL_BlitInfo * info)
     }
 }
 
+/* Solid and colour key blits of an opaque 8 bit source to a 32 or 8 bit
+ * destination. Blending an opaque pixel gives its palette colour exactly,
+ * so each of the 256 indices is mapped once, into a table of destination
+ * pixels, and the rows are looked up in it. An 8 bit destination with the
+ * same colours copies the rows as they are. A keyed pixel is left alone,
+ * except that over a transparent pixel the blend writes the key colour
+ * with zero alpha, and on 8 bits maps the old colour again. Returns 0 if
+ * the blit is not one of these.
+ */
+static int
+alphablit_indexed (SDL_BlitInfo * info, int keyed)
+{
+    int             width = info->width;
+    int             height = info->height;
+    Uint8          *src = info->s_pixels;
+    int             srcskip = info->s_skip;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    SDL_Color      *colors;
+    int             ncolors;
+    Uint32          colorkey = keyed ? srcfmt->colorkey : 256;
+    Uint32          lut[256];
+    Uint32          keypixel = 0;
+    Uint32          amask = 0;
+    Uint8           lut8[256];
+    Uint8           dstlut8[256];
+    int             identity = 1;
+    int             dstidentity = 1;
+    int             i, x;
+
+    if (srcfmt->BytesPerPixel != 1 || !srcfmt->palette ||
+        srcfmt->alpha != 255 || info->s_pxskip != 1)
+        return 0;
+    colors = srcfmt->palette->colors;
+    ncolors = MIN (srcfmt->palette->ncolors, 256);
+
+    if (dstfmt->BytesPerPixel == 4 && info->d_pxskip == 4)
+    {
+        for (i = 0; i < 256; ++i)
+        {
+            if (i < ncolors)
+            {
+                CREATE_PIXEL ((Uint8 *) (lut + i), colors[i].r, colors[i].g,
+                              colors[i].b, 255, 4, dstfmt);
+            }
+            else
+            {
+                CREATE_PIXEL ((Uint8 *) (lut + i), 0, 0, 0, 255, 4, dstfmt);
+            }
+        }
+        if (colorkey < 256)
+        {
+            /* only a transparent destination pixel takes the key colour */
+            if (info->dst_flags & SDL_SRCALPHA)
+                amask = dstfmt->Amask;
+            keypixel = lut[colorkey] & ~dstfmt->Amask;
+        }
+
+        while (height--)
+        {
+            Uint32 *d = (Uint32 *) dst;
+
+            if (colorkey < 256)
+            {
+                for (x = 0; x < width; ++x)
+                {
+                    if (src[x] != colorkey)
+                        d[x] = lut[src[x]];
+                    else if (amask && !(d[x] & amask))
+                        d[x] = keypixel;
+                }
+            }
+            else
+            {
+                for (x = 0; x < width; ++x)
+                    d[x] = lut[src[x]];
+            }
+            src += width + srcskip;
+            dst += width * 4 + dstskip;
+        }
+        return 1;
+    }
+
+    if (dstfmt->BytesPerPixel == 1 && info->d_pxskip == 1 && dstfmt->palette)
+    {
+        for (i = 0; i < 256; ++i)
+        {
+            lut8[i] = (i < ncolors) ?
+                (Uint8) SDL_MapRGB (dstfmt, colors[i].r, colors[i].g,
+                                    colors[i].b) :
+                (Uint8) SDL_MapRGB (dstfmt, 0, 0, 0);
+            if (lut8[i] != i)
+                identity = 0;
+        }
+        if (colorkey < 256)
+        {
+            SDL_Color *dcolors = dstfmt->palette->colors;
+            int dncolors = MIN (dstfmt->palette->ncolors, 256);
+
+            for (i = 0; i < dncolors; ++i)
+            {
+                dstlut8[i] = (Uint8) SDL_MapRGB (dstfmt, dcolors[i].r,
+                                                 dcolors[i].g, dcolors[i].b);
+                if (dstlut8[i] != i)
+                    dstidentity = 0;
+            }
+            for (; i < 256; ++i)
+                dstlut8[i] = (Uint8) i;
+        }
+
+        while (height--)
+        {
+            if (colorkey < 256)
+            {
+                for (x = 0; x < width; ++x)
+                {
+                    if (src[x] != colorkey)
+                        dst[x] = lut8[src[x]];
+                    else if (!dstidentity)
+                        dst[x] = dstlut8[dst[x]];
+                }
+            }
+            else if (identity)
+            {
+                memmove (dst, src, width);
+            }
+            else
+            {
+                for (x = 0; x < width; ++x)
+                    dst[x] = lut8[src[x]];
+            }
+            src += width + srcskip;
+            dst += width + dstskip;
+        }
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Colour key blit of the unkeyed runs only. A keyed pixel has zero alpha,
+ * which leaves the destination as it is unless the destination alpha is
+ * zero too, so alphablit_colorkey is only called for those pixels of the
+ * keyed runs. Only for destinations with per-pixel alpha of 2 or 4 bytes,
+ * for which putting back an unchanged pixel gives the same bits.
+ */
+static void
+alphablit_colorkey_rle (SDL_BlitInfo * info)
+{
+    PgColorkeyRLE  *rle = info->s_rle;
+    SDL_BlitInfo    span = *info;
+    int             srcpxskip = info->s_pxskip;
+    int             dstpxskip = info->d_pxskip;
+    int             srcpitch = info->width * srcpxskip + info->s_skip;
+    int             dstpitch = info->width * dstpxskip + info->d_skip;
+    Uint32          amask = info->dst->Amask;
+    int             left = info->s_x;
+    int             right = info->s_x + info->width;
+    int             y, x, start, end, keyed, *run, *lastrun;
+    Uint8          *srcrow, *dstrow, *dst;
+    Uint32          pixel;
+
+    span.height = 1;
+    span.s_rle = NULL;
+
+    for (y = 0; y < info->height; ++y)
+    {
+        srcrow = info->s_pixels + y * srcpitch - left * srcpxskip;
+        dstrow = info->d_pixels + y * dstpitch - left * dstpxskip;
+        run = rle->runs + rle->rows[info->s_y + y];
+        lastrun = rle->runs + rle->rows[info->s_y + y + 1];
+        x = 0;
+        keyed = 1;
+        for (; run < lastrun && x < right; ++run, keyed = !keyed)
+        {
+            start = MAX (x, left);
+            end = MIN (x + *run, right);
+            x += *run;
+            if (start >= end)
+                continue;
+            if (!keyed)
+            {
+                span.width = end - start;
+                span.s_pixels = srcrow + start * srcpxskip;
+                span.d_pixels = dstrow + start * dstpxskip;
+                alphablit_colorkey (&span);
+                continue;
+            }
+            /* Find the transparent destination pixels under a keyed run */
+            while (start < end)
+            {
+                dst = dstrow + start * dstpxskip;
+                GET_PIXEL (pixel, dstpxskip, dst);
+                if (pixel & amask)
+                {
+                    ++start;
+                    continue;
+                }
+                span.s_pixels = srcrow + start * srcpxskip;
+                span.d_pixels = dst;
+                span.width = 0;
+                do
+                {
+                    ++span.width;
+                    ++start;
+                    dst += dstpxskip;
+                    if (start < end)
+                        GET_PIXEL (pixel, dstpxskip, dst);
+                } while (start < end && !(pixel & amask));
+                alphablit_colorkey (&span);
+            }
+        }
+    }
+}
+
 static void
 alphablit_colorkey (SDL_BlitInfo * info)
 {
@@ -2179,6 +2846,15 @@ alphablit_colorkey (SDL_BlitInfo * info)
        printf ("Colorkey blit with %d and %d\n", srcbpp, dstbpp);
        */
 
+    if (info->s_rle && info->s_rle->rows && dstppa &&
+        (dstbpp == 2 || dstbpp == 4))
+    {
+        alphablit_colorkey_rle (info);
+        return;
+    }
+    if (alphablit_indexed (info, 1))
+        return;
+
     if (srcbpp == 1)
     {
         if (dstbpp == 1)
@@ -2317,6 +2993,9 @@ alphablit_solid (SDL_BlitInfo * info)
        printf ("Solid blit with %d and %d\n", srcbpp, dstbpp);
        */
 
+    if (alphablit_indexed (info, 0))
+        return;
+
     if (srcbpp == 1)
     {
         if (dstbpp == 1)
@@ -2424,10 +3103,580 @@ alphablit_solid (SDL_BlitInfo * info)
     }
 }
 
+/* A surface with runs shorter than this on average is not worth the
+ * colorkey runs
+ */
+#define PG_RLE_MIN_RUN 8
+
+/* Read pixel x of a row of the colorkey surface surf */
+#define RLE_PIXEL(pxl, bpp, row, x)                     \
+    if (bpp == 1)                                       \
+        pxl = row[x];                                   \
+    else                                                \
+    {                                                   \
+        Uint8 *_pix = row + (x) * bpp;                  \
+        GET_PIXEL (pxl, bpp, _pix);                     \
+    }
+
+/* Count the (keyed, unkeyed) runs of each row of surf, filling in
+ * rows and runs if they are not NULL. Returns the number of runs.
+ */
+static int
+colorkey_runs (SDL_Surface * surf, int *rows, int *runs)
+{
+    int             bpp = surf->format->BytesPerPixel;
+    Uint32          colorkey = surf->format->colorkey;
+    int             nruns = 0;
+    int             x, y, start, keyed;
+    Uint8          *row = (Uint8 *) surf->pixels;
+    Uint32          pixel;
+
+    for (y = 0; y < surf->h; ++y, row += surf->pitch)
+    {
+        if (rows)
+            rows[y] = nruns;
+        x = 0;
+        keyed = 1;
+        while (x < surf->w)
+        {
+            start = x;
+            for (; x < surf->w; ++x)
+            {
+                RLE_PIXEL (pixel, bpp, row, x);
+                if ((pixel == colorkey) != keyed)
+                    break;
+            }
+            if (runs)
+                runs[nruns] = x - start;
+            ++nruns;
+            keyed = !keyed;
+        }
+    }
+    if (rows)
+        rows[surf->h] = nruns;
+    return nruns;
+}
+
+/* Build the colorkey runs of surf, in one block for PyMem_Free. Returns
+ * NULL if out of memory or surf can not be locked.
+ */
+PgColorkeyRLE *
+pygame_MakeColorkeyRLE (SDL_Surface * surf)
+{
+    PgColorkeyRLE  *rle;
+    int             nruns;
+
+    if (SDL_LockSurface (surf) < 0)
+        return NULL;
+    nruns = colorkey_runs (surf, NULL, NULL);
+    if (nruns * PG_RLE_MIN_RUN > surf->w * surf->h)
+    {
+        /* Remember that the surface is not worth it */
+        rle = PyMem_Malloc (sizeof (PgColorkeyRLE));
+        if (rle)
+            rle->rows = rle->runs = NULL;
+    }
+    else
+    {
+        rle = PyMem_Malloc (sizeof (PgColorkeyRLE) +
+                            (surf->h + 1 + nruns) * sizeof (int));
+        if (rle)
+        {
+            rle->rows = (int *) (rle + 1);
+            rle->runs = rle->rows + surf->h + 1;
+            colorkey_runs (surf, rle->rows, rle->runs);
+        }
+    }
+    SDL_UnlockSurface (surf);
+
+    if (rle)
+    {
+        rle->w = surf->w;
+        rle->h = surf->h;
+        rle->bpp = surf->format->BytesPerPixel;
+        rle->colorkey = surf->format->colorkey;
+    }
+    return rle;
+}
+
+/* Returns true if rle still describes the current colour key of surf */
+int
+pygame_ColorkeyRLEValid (PgColorkeyRLE * rle, SDL_Surface * surf)
+{
+    return (rle->w == surf->w && rle->h == surf->h &&
+            rle->bpp == surf->format->BytesPerPixel &&
+            rle->colorkey == surf->format->colorkey);
+}
+
+/* Multiply the colour channels of each pixel of a 16 or 32 bit surface
+ * with per-pixel alpha by its alpha, in place. Returns -1, with the SDL
+ * error set, if the surface can not be locked.
+ */
+int
+pygame_PremulAlpha (SDL_Surface * surf)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    int             bpp = fmt->BytesPerPixel;
+    int             x, y;
+    Uint8          *row, *pix;
+    Uint8           R, G, B, A;
+    Uint32          pixel;
+
+    if (SDL_LockSurface (surf) < 0)
+        return -1;
+    row = (Uint8 *) surf->pixels;
+    for (y = 0; y < surf->h; ++y)
+    {
+        pix = row;
+        for (x = 0; x < surf->w; ++x)
+        {
+            GET_PIXEL (pixel, bpp, pix);
+            GET_PIXELVALS (R, G, B, A, pixel, fmt, 1);
+            R = (Uint8) ((R * (A + 1)) >> 8);
+            G = (Uint8) ((G * (A + 1)) >> 8);
+            B = (Uint8) ((B * (A + 1)) >> 8);
+            CREATE_PIXEL (pix, R, G, B, A, bpp, fmt);
+            pix += bpp;
+        }
+        row += surf->pitch;
+    }
+    SDL_UnlockSurface (surf);
+    return 0;
+}
+
+static int
+alpha_first_32 (const Uint32 *pixels, int n, Uint32 amask, Uint32 threshold)
+{
+    int             i;
+
+    for (i = 0; i < n; ++i)
+    {
+        if ((pixels[i] & amask) >= threshold)
+            return i;
+    }
+    return -1;
+}
+
+static int
+alpha_last_32 (const Uint32 *pixels, int n, Uint32 amask, Uint32 threshold)
+{
+    while (n--)
+    {
+        if ((pixels[n] & amask) >= threshold)
+            return n;
+    }
+    return -1;
+}
+
+/* The bounding rect of the pixels of a locked 32 bit surface with an 8 bit
+ * alpha channel that have an alpha of at least min_alpha, the same rect
+ * Surface.get_bounding_rect finds pixel by pixel. It is empty at 0, 0 if
+ * there are none. Only the rows between the top and bottom ones found are
+ * scanned, and of those only the ends left of and right of the columns
+ * found so far. Returns -1 for any other surface.
+ */
+int
+pygame_AlphaBounds (SDL_Surface * surf, int min_alpha, SDL_Rect * rect)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    ALPHA_SCAN_P    first = pg_blitters.alpha_first_32;
+    ALPHA_SCAN_P    last = pg_blitters.alpha_last_32;
+    Uint8          *pixels = (Uint8 *) surf->pixels;
+    int             pitch = surf->pitch;
+    int             w = surf->w;
+    int             min_x, min_y, max_x, max_y;
+    int             x, y;
+    Uint32          amask = fmt->Amask;
+    Uint32          threshold;
+
+    if (fmt->BytesPerPixel != 4 || surf->flags & SDL_SRCCOLORKEY ||
+        amask != (Uint32) 0xFF << fmt->Ashift || !pixels)
+        return -1;
+    if (!first)
+    {
+        first = alpha_first_32;
+        last = alpha_last_32;
+    }
+
+    rect->x = rect->y = rect->w = rect->h = 0;
+    if (min_alpha > 255 || w <= 0)
+        return 0;
+    threshold = (Uint32) (min_alpha < 0 ? 0 : min_alpha) << fmt->Ashift;
+
+#define ALPHA_ROW(y) ((const Uint32 *) (pixels + (y) * pitch))
+    for (y = surf->h - 1; y >= 0; --y)
+    {
+        if ((x = first (ALPHA_ROW (y), w, amask, threshold)) >= 0)
+            break;
+    }
+    if (y < 0)
+        return 0;
+    max_y = y + 1;
+    for (y = 0; (x = first (ALPHA_ROW (y), w, amask, threshold)) < 0; ++y)
+        ;
+    min_y = y;
+    min_x = x;
+    max_x = last (ALPHA_ROW (y), w, amask, threshold) + 1;
+
+    for (++y; y < max_y && (min_x > 0 || max_x < w); ++y)
+    {
+        if (min_x > 0 &&
+            (x = first (ALPHA_ROW (y), min_x, amask, threshold)) >= 0)
+            min_x = x;
+        if (max_x < w &&
+            (x = last (ALPHA_ROW (y) + max_x, w - max_x, amask,
+                       threshold)) >= 0)
+            max_x += x + 1;
+    }
+#undef ALPHA_ROW
+
+    rect->x = min_x;
+    rect->y = min_y;
+    rect->w = max_x - min_x;
+    rect->h = max_y - min_y;
+    return 0;
+}
+
+static void
+convert_32 (const Uint8 *src, Uint32 *dst, int n, int srcbpp,
+            const PgSwizzle *swizzle)
+{
+    Uint32          p, q;
+    int             i, j;
+
+    for (i = 0; i < n; ++i)
+    {
+        if (srcbpp == 4)
+            p = *(const Uint32 *) (src + i * 4);
+        else
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            p = (Uint32) src[i * 3] | (Uint32) src[i * 3 + 1] << 8 |
+                (Uint32) src[i * 3 + 2] << 16;
+#else
+            p = (Uint32) src[i * 3] << 16 | (Uint32) src[i * 3 + 1] << 8 |
+                (Uint32) src[i * 3 + 2];
+#endif
+        q = swizzle->fill;
+        for (j = 0; j < swizzle->count; ++j)
+        {
+            if (swizzle->shift[j] < 0)
+                q |= (p >> -swizzle->shift[j]) & swizzle->mask[j];
+            else
+                q |= (p << swizzle->shift[j]) & swizzle->mask[j];
+        }
+        dst[i] = q;
+    }
+}
+
+/* The shift of an 8 bit channel mask, -1 for any other mask */
+static int
+convert_shift (Uint32 mask)
+{
+    int             shift;
+
+    for (shift = 0; shift < 32; shift += 8)
+    {
+        if (mask == (Uint32) 0xFF << shift)
+            return shift;
+    }
+    return -1;
+}
+
+/* Set up swizzle to convert the pixels of fmt to 32 bit pixels with the
+ * masks given, as an SDL blit without a colorkey or surface alpha does:
+ * the alpha channel is copied, or filled with the alpha of fmt if it has
+ * none, or dropped. Returns 0 unless fmt is 24 or 32 bit and all the
+ * channels are 8 bits.
+ */
+static int
+convert_swizzle (SDL_PixelFormat * fmt, Uint32 rmask, Uint32 gmask,
+                 Uint32 bmask, Uint32 amask, PgSwizzle * swizzle)
+{
+    Uint32          srcmasks[4];
+    Uint32          dstmasks[4];
+    int             i, j, from, to;
+
+    srcmasks[0] = fmt->Rmask;
+    srcmasks[1] = fmt->Gmask;
+    srcmasks[2] = fmt->Bmask;
+    srcmasks[3] = fmt->Amask;
+    dstmasks[0] = rmask;
+    dstmasks[1] = gmask;
+    dstmasks[2] = bmask;
+    dstmasks[3] = amask;
+    if ((fmt->BytesPerPixel != 3 && fmt->BytesPerPixel != 4) ||
+        fmt->palette || (fmt->BytesPerPixel == 3 &&
+                         (fmt->Rmask | fmt->Gmask | fmt->Bmask) >> 24))
+        return 0;
+    for (i = 0; i < 4; ++i)
+    {
+        for (j = 0; j < i; ++j)
+        {
+            if ((srcmasks[i] & srcmasks[j]) || (dstmasks[i] & dstmasks[j]))
+                return 0;
+        }
+    }
+
+    swizzle->count = 0;
+    swizzle->fill = 0;
+    for (i = 0; i < 4; ++i)
+    {
+        from = srcmasks[i] || i < 3 ? convert_shift (srcmasks[i]) : 0;
+        to = dstmasks[i] || i < 3 ? convert_shift (dstmasks[i]) : 0;
+        if (from < 0 || to < 0)
+            return 0;
+        if (!dstmasks[i])
+            continue;
+        if (!srcmasks[i])
+        {
+            swizzle->fill |= (Uint32) fmt->alpha << to;
+            continue;
+        }
+        for (j = 0; j < swizzle->count && swizzle->shift[j] != to - from; ++j)
+            ;
+        if (j == swizzle->count)
+        {
+            swizzle->shift[j] = to - from;
+            swizzle->mask[j] = 0;
+            swizzle->count++;
+        }
+        swizzle->mask[j] |= dstmasks[i];
+    }
+    return 1;
+}
+
+/* SDL_ConvertSurface of surf to a 32 bit format with the masks given, done
+ * with pg_blitters.convert_32 if the pixels are 24 or 32 bit with 8 bit
+ * channels, and surf is a software surface without a colorkey or surface
+ * alpha. Returns 0 if not, else 1 with the new surface in *convert, NULL
+ * with the SDL error set if it could not be made.
+ */
+static int
+convert_surface (SDL_Surface * surf, Uint32 rmask, Uint32 gmask,
+                 Uint32 bmask, Uint32 amask, Uint32 flags,
+                 SDL_Surface ** convert)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    CONVERT_FUNC_P  kernel = pg_blitters.convert_32;
+    PgSwizzle       swizzle;
+    SDL_Surface    *newsurf;
+    Uint8          *srcrow, *dstrow;
+    int             same, y;
+
+    /* Per pixel alpha is copied as it is, not blended with the surface */
+    if ((flags & SDL_HWSURFACE) ||
+        (surf->flags & (SDL_HWSURFACE | SDL_SRCCOLORKEY | SDL_RLEACCEL)) ||
+        ((surf->flags & SDL_SRCALPHA) && !(fmt->Amask && amask)) ||
+        !convert_swizzle (fmt, rmask, gmask, bmask, amask, &swizzle))
+        return 0;
+    if (!kernel)
+        kernel = convert_32;
+    /* The same format, which SDL copies unused bits and all */
+    same = fmt->BytesPerPixel == 4 && fmt->Rmask == rmask &&
+        fmt->Gmask == gmask && fmt->Bmask == bmask && fmt->Amask == amask;
+
+    newsurf = SDL_CreateRGBSurface (flags, surf->w, surf->h, 32,
+                                    rmask, gmask, bmask, amask);
+    *convert = newsurf;
+    if (!newsurf)
+        return 1;
+
+    srcrow = (Uint8 *) surf->pixels;
+    dstrow = (Uint8 *) newsurf->pixels;
+    for (y = 0; y < surf->h; ++y)
+    {
+        if (same)
+            memcpy (dstrow, srcrow, (size_t) surf->w * 4);
+        else
+            kernel (srcrow, (Uint32 *) dstrow, surf->w, fmt->BytesPerPixel,
+                    &swizzle);
+        srcrow += surf->pitch;
+        dstrow += newsurf->pitch;
+    }
+
+    SDL_SetClipRect (newsurf, &surf->clip_rect);
+    if (surf->flags & SDL_SRCALPHA)
+        SDL_SetAlpha (newsurf, (surf->flags & (SDL_SRCALPHA | SDL_RLEACCELOK))
+                      | (flags & SDL_RLEACCELOK), fmt->alpha);
+    return 1;
+}
+
+/* SDL_ConvertSurface, converting to a 32 bit format with pg_blitters when
+ * it can. Needs no GIL.
+ */
+SDL_Surface *
+pygame_ConvertSurface (SDL_Surface * surf, SDL_PixelFormat * fmt,
+                       Uint32 flags)
+{
+    SDL_Surface    *convert;
+
+    if (fmt->BitsPerPixel == 32 &&
+        convert_surface (surf, fmt->Rmask, fmt->Gmask, fmt->Bmask,
+                         fmt->Amask, flags, &convert))
+        return convert;
+    return SDL_ConvertSurface (surf, fmt, flags);
+}
+
+/* SDL_DisplayFormat, as pygame_ConvertSurface */
+SDL_Surface *
+pygame_DisplayFormat (SDL_Surface * surf)
+{
+    SDL_Surface    *display = SDL_GetVideoSurface ();
+    Uint32          flags;
+
+    if (!display)
+        return SDL_DisplayFormat (surf);
+    flags = display->flags & SDL_HWSURFACE;
+    flags |= surf->flags & (SDL_SRCCOLORKEY | SDL_SRCALPHA | SDL_RLEACCELOK);
+    return pygame_ConvertSurface (surf, display->format, flags);
+}
+
+/* SDL_DisplayFormatAlpha, as pygame_ConvertSurface */
+SDL_Surface *
+pygame_DisplayFormatAlpha (SDL_Surface * surf)
+{
+    SDL_Surface    *display = SDL_GetVideoSurface ();
+    SDL_PixelFormat *vf;
+    SDL_Surface    *convert;
+    Uint32          rmask = 0x00FF0000;
+    Uint32          bmask = 0x000000FF;
+    Uint32          flags;
+
+    if (!display)
+        return SDL_DisplayFormatAlpha (surf);
+
+    /* ARGB, or ABGR if the display is BGR, as SDL chooses */
+    vf = display->format;
+    if ((vf->BytesPerPixel == 2 && vf->Rmask == 0x1F &&
+         (vf->Bmask == 0xF800 || vf->Bmask == 0x7C00)) ||
+        ((vf->BytesPerPixel == 3 || vf->BytesPerPixel == 4) &&
+         vf->Rmask == 0xFF && vf->Bmask == 0xFF0000))
+    {
+        rmask = 0x000000FF;
+        bmask = 0x00FF0000;
+    }
+    flags = display->flags & SDL_HWSURFACE;
+    flags |= surf->flags & (SDL_SRCALPHA | SDL_RLEACCELOK);
+    if (convert_surface (surf, rmask, 0x0000FF00, bmask, 0xFF000000, flags,
+                         &convert))
+        return convert;
+    return SDL_DisplayFormatAlpha (surf);
+}
+
+/* Select a blitter backend: "GENERIC", "SSE2" or "AVX2". Returns -1, with
+ * the SDL error set, if the type is unknown or not supported by the CPU.
+ */
+int
+pygame_SetBlitBackend (const char *type)
+{
+    if (strcmp (type, "GENERIC") == 0)
+    {
+        pg_blitters.blit_type = "GENERIC";
+        pg_blitters.alpha_argb = 0;
+        pg_blitters.premultiplied_argb = 0;
+        pg_blitters.fill_32 = 0;
+        pg_blitters.blend[PYGAME_BLEND_ADD] = 0;
+        pg_blitters.blend[PYGAME_BLEND_SUB] = 0;
+        pg_blitters.blend[PYGAME_BLEND_MULT] = 0;
+        pg_blitters.blend[PYGAME_BLEND_MIN] = 0;
+        pg_blitters.blend[PYGAME_BLEND_MAX] = 0;
+        pg_blitters.alpha_first_32 = 0;
+        pg_blitters.alpha_last_32 = 0;
+        pg_blitters.convert_32 = 0;
+        return 0;
+    }
+#if defined(PG_ENABLE_SSE2_BLITTERS)
+    if (strcmp (type, "SSE2") == 0)
+    {
+        if (!SDL_HasSSE2 ())
+        {
+            SDL_SetError ("SSE2 not supported on this machine");
+            return -1;
+        }
+        pg_blitters.blit_type = "SSE2";
+        pg_blitters.alpha_argb = alphablit_alpha_sse2_argb;
+        pg_blitters.premultiplied_argb = blit_blend_premultiplied_sse2_argb;
+        pg_blitters.fill_32 = blit_fill_sse2;
+        pg_blitters.blend[PYGAME_BLEND_ADD] = blit_blend_add_sse2;
+        pg_blitters.blend[PYGAME_BLEND_SUB] = blit_blend_sub_sse2;
+        pg_blitters.blend[PYGAME_BLEND_MULT] = blit_blend_mul_sse2;
+        pg_blitters.blend[PYGAME_BLEND_MIN] = blit_blend_min_sse2;
+        pg_blitters.blend[PYGAME_BLEND_MAX] = blit_blend_max_sse2;
+        pg_blitters.alpha_first_32 = alpha_first_sse2;
+        pg_blitters.alpha_last_32 = alpha_last_sse2;
+        pg_blitters.convert_32 = convert_32_sse2;
+        return 0;
+    }
+#endif
+#if defined(PG_ENABLE_AVX2_BLITTERS)
+    if (strcmp (type, "AVX2") == 0)
+    {
+        if (!(pygame_CpuFeatures () & PG_CPU_AVX2))
+        {
+            SDL_SetError ("AVX2 not supported on this machine");
+            return -1;
+        }
+        pg_blitters.blit_type = "AVX2";
+        pg_blitters.alpha_argb = alphablit_alpha_avx2_argb;
+        pg_blitters.premultiplied_argb = blit_blend_premultiplied_avx2_argb;
+        pg_blitters.fill_32 = blit_fill_avx2;
+        pg_blitters.blend[PYGAME_BLEND_ADD] = blit_blend_add_avx2;
+        pg_blitters.blend[PYGAME_BLEND_SUB] = blit_blend_sub_avx2;
+        pg_blitters.blend[PYGAME_BLEND_MULT] = blit_blend_mul_avx2;
+        pg_blitters.blend[PYGAME_BLEND_MIN] = blit_blend_min_avx2;
+        pg_blitters.blend[PYGAME_BLEND_MAX] = blit_blend_max_avx2;
+        pg_blitters.alpha_first_32 = alpha_first_avx2;
+        pg_blitters.alpha_last_32 = alpha_last_avx2;
+        /* memory bound, so wider registers gain nothing */
+        pg_blitters.convert_32 = convert_32_sse2;
+        return 0;
+    }
+#endif
+    SDL_SetError ("Unknown blit backend type");
+    return -1;
+}
+
+const char *
+pygame_GetBlitBackend (void)
+{
+    return pg_blitters.blit_type;
+}
+
+void
+pygame_BlitInit (void)
+{
+    if (pg_blitters.blit_type == 0)
+    {
+    blend16_init ();
+#if defined(PG_ENABLE_AVX2_BLITTERS)
+    if (pygame_CpuFeatures () & PG_CPU_AVX2)
+        pygame_SetBlitBackend ("AVX2");
+    else
+#endif
+#if defined(PG_ENABLE_SSE2_BLITTERS)
+    if (SDL_HasSSE2 ())
+        pygame_SetBlitBackend ("SSE2");
+    else
+#endif
+        pygame_SetBlitBackend ("GENERIC");
+    }
+}
+
 /*we assume the "dst" has pixel alpha*/
 int
 pygame_Blit (SDL_Surface * src, SDL_Rect * srcrect,
              SDL_Surface * dst, SDL_Rect * dstrect, int the_args)
+{
+    return pygame_BlitRLE (src, srcrect, dst, dstrect, the_args, NULL);
+}
+
+/* pygame_Blit, with the colorkey runs of src from pygame_MakeColorkeyRLE
+ * to skip its keyed pixels. rle may be NULL.
+ */
+int
+pygame_BlitRLE (SDL_Surface * src, SDL_Rect * srcrect,
+                SDL_Surface * dst, SDL_Rect * dstrect, int the_args,
+                PgColorkeyRLE * rle)
 {
     SDL_Rect        fulldst;
     int             srcx, srcy, w, h;
@@ -2524,7 +3773,7 @@ pygame_Blit (SDL_Surface * src, SDL_Rect * srcrect,
         sr.y = srcy;
         sr.w = dstrect->w = w;
         sr.h = dstrect->h = h;
-        return SoftBlitPyGame (src, &sr, dst, dstrect, the_args);
+        return SoftBlitPyGame (src, &sr, dst, dstrect, the_args, rle);
     }
     dstrect->w = dstrect->h = 0;
     return 0;
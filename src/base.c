@@ -26,6 +26,15 @@
 #include "pgcompat.h"
 #include "doc/pygame_doc.h"
 #include <signal.h>
+#include <ctype.h>
+#include <time.h>
+#if !defined(MS_WIN32)
+#include <sys/time.h>
+#endif
+#include <SDL_thread.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 
 /* This file controls all the initialization of
@@ -41,6 +50,11 @@
 extern int SDL_RegisterApp (char*, Uint32, void*);
 #endif
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
 #if defined(macintosh)
 #if(!defined(__MWERKS__) && !TARGET_API_MAC_CARBON)
 QDGlobals qd;
@@ -79,6 +93,35 @@ typedef struct view_internals_s {
 /* Custom exceptions */
 static PyObject* PgExc_BufferError = NULL;
 
+/* Interned names looked up on every array conversion */
+enum {
+    ARRATTR_INTERFACE,
+    ARRATTR_STRUCT,
+    ARRATTR_SHAPE,
+    ARRATTR_TYPESTR,
+    ARRATTR_DATA,
+    ARRATTR_STRIDES,
+    ARRATTR_COUNT
+};
+static const char *array_attr_names[ARRATTR_COUNT] = {
+    "__array_interface__",
+    "__array_struct__",
+    "shape",
+    "typestr",
+    "data",
+    "strides"
+};
+static PyObject *array_attr_strs[ARRATTR_COUNT];
+
+/* The last typestr parsed by _pytypestr_as_format, as arrays converted
+ * one after another mostly have the same item type.
+ */
+static struct {
+    char typestr[4];
+    char format[4];
+    Py_ssize_t itemsize;
+} typestr_cache;
+
 /* Only one instance of the state per process. */
 static PyObject* quitfunctions = NULL;
 static int sdl_was_init = 0;
@@ -608,7 +651,7 @@ GetArrayStruct (PyObject* obj,
                    PyObject** cobj_p,
                    PyArrayInterface** inter_p)
 {
-    PyObject* cobj = PyObject_GetAttrString (obj, "__array_struct__");
+    PyObject* cobj = PyObject_GetAttr (obj, array_attr_strs[ARRATTR_STRUCT]);
     PyArrayInterface* inter = NULL;
 
     if (cobj == NULL) {
@@ -1162,7 +1205,8 @@ _buffer_is_byteswapped (Py_buffer* view)
 static int
 GetArrayInterface (PyObject **dict, PyObject *obj)
 {
-    PyObject* inter = PyObject_GetAttrString (obj, "__array_interface__");
+    PyObject* inter = PyObject_GetAttr (obj,
+                                        array_attr_strs[ARRATTR_INTERFACE]);
 
     if (inter == NULL) {
         if (PyErr_ExceptionMatches (PyExc_AttributeError)) {
@@ -1174,7 +1218,7 @@ GetArrayInterface (PyObject **dict, PyObject *obj)
     if (!PyDict_Check (inter)) {
         PyErr_Format (PyExc_ValueError,
                       "expected '__array_interface__' to return a dict: got %s",
-                      Py_TYPE (dict)->tp_name);
+                      Py_TYPE (inter)->tp_name);
         Py_DECREF (inter);
         return -1;
     }
@@ -1428,10 +1472,12 @@ static int _arraystruct_to_format (char* format,
 static int
 PgDict_AsBuffer (Pg_buffer* pg_view_p, PyObject* dict, int flags)
 {
-    PyObject* pyshape = PyDict_GetItemString (dict, "shape");
-    PyObject* pytypestr = PyDict_GetItemString (dict, "typestr");
-    PyObject* pydata = PyDict_GetItemString (dict, "data");
-    PyObject* pystrides = PyDict_GetItemString (dict, "strides");
+    PyObject* pyshape = PyDict_GetItem (dict, array_attr_strs[ARRATTR_SHAPE]);
+    PyObject* pytypestr = PyDict_GetItem (dict,
+                                          array_attr_strs[ARRATTR_TYPESTR]);
+    PyObject* pydata = PyDict_GetItem (dict, array_attr_strs[ARRATTR_DATA]);
+    PyObject* pystrides = PyDict_GetItem (dict,
+                                          array_attr_strs[ARRATTR_STRIDES]);
 
     if (_pyshape_check (pyshape)) {
         return -1;
@@ -1707,6 +1753,20 @@ _pytypestr_as_format (PyObject* sp, char* format, Py_ssize_t* itemsize_p)
     int is_swapped = 0;
     Py_ssize_t itemsize = 0;
 
+#if PY_VERSION_HEX >= 0x03030000
+    /* The UTF-8 of a str is kept with it, so needs no new object */
+    if (PyUnicode_Check (sp)) {
+        typestr = PyUnicode_AsUTF8 (sp);
+        if (!typestr) {
+            return -1;
+        }
+        Py_INCREF (sp);
+    }
+    else {
+        Py_INCREF (sp);
+        typestr = Bytes_AsString (sp);
+    }
+#else
     if (PyUnicode_Check (sp)) {
         sp = PyUnicode_AsASCIIString (sp);
         if (!sp) {
@@ -1717,6 +1777,16 @@ _pytypestr_as_format (PyObject* sp, char* format, Py_ssize_t* itemsize_p)
         Py_INCREF (sp);
     }
     typestr = Bytes_AsString (sp);
+#endif
+    if (typestr_cache.itemsize &&
+        /* strncmp stops at a short typestr's nul, and comparing the
+         * cached terminator too rejects a longer one */
+        !strncmp (typestr, typestr_cache.typestr, 4)) {
+        memcpy (format, typestr_cache.format, sizeof (typestr_cache.format));
+        *itemsize_p = typestr_cache.itemsize;
+        Py_DECREF (sp);
+        return 0;
+    }
     switch (typestr[0]) {
 
     case PAI_MY_ENDIAN:
@@ -1869,10 +1939,14 @@ _pytypestr_as_format (PyObject* sp, char* format, Py_ssize_t* itemsize_p)
         Py_DECREF (sp);
         return -1;
     }
-    Py_DECREF (sp);
     ++fchar_p;
     *fchar_p = '\0';
     *itemsize_p = itemsize;
+    memcpy (typestr_cache.typestr, typestr, 3);
+    typestr_cache.typestr[3] = '\0';
+    memcpy (typestr_cache.format, format, sizeof (typestr_cache.format));
+    typestr_cache.itemsize = itemsize;
+    Py_DECREF (sp);
     return 0;
 }
 
@@ -1990,6 +2064,782 @@ uninstall_parachute (void)
 #endif
 }
 
+/* The worker pool shared by the C modules, which run jobs over rows on it
+ * through PgPool_Run. The rows of a job are cut into one range for each
+ * thread taking part, the calling thread included. A thread does its
+ * range grain rows at a time and, when done, steals the back half of what
+ * is left of the fullest range, so the threads given slow rows do not
+ * hold up the others.
+ */
+
+#define PG_POOL_MAX_THREADS 64
+
+#if defined(__linux__) && defined(CPU_SET)
+#define PG_POOL_AFFINITY 1
+#elif defined(MS_WIN32)
+#define PG_POOL_AFFINITY 1
+#else
+#define PG_POOL_AFFINITY 0
+#endif
+
+typedef struct {
+    int lo, hi;             /* the rows of the range not taken yet */
+    int result;             /* the sum of the job results of the thread */
+} PgPoolRange;
+
+static struct {
+    int threads;            /* set by set_pool_threads */
+    int nworkers;
+    int quit;
+    SDL_sem *busy;          /* taken by the run using the workers */
+    SDL_sem *done;
+    SDL_mutex *lock;        /* guards the ranges of the run */
+    SDL_Thread *workers[PG_POOL_MAX_THREADS - 1];
+    SDL_sem *start[PG_POOL_MAX_THREADS - 1];
+    int index[PG_POOL_MAX_THREADS - 1];
+    int cpus[PG_POOL_MAX_THREADS];  /* of the workers, in turn */
+    int ncpus;
+    PgPool_Job job;
+    void *data;
+    int grain;
+    int nranges;
+    PgPoolRange ranges[PG_POOL_MAX_THREADS];
+} pool;
+
+/* Take the next rows for thread t: *first to *first + *n - 1. Returns 0
+ * when no rows are left.
+ */
+static int
+_pool_take (int t, int *first, int *n)
+{
+    PgPoolRange *range = pool.ranges + t, *victim = NULL;
+    int i, left, most = 0, mid;
+
+    SDL_mutexP (pool.lock);
+    if (range->lo >= range->hi)
+    {
+        for (i = 0; i < pool.nranges; ++i)
+        {
+            left = pool.ranges[i].hi - pool.ranges[i].lo;
+            if (left > most)
+            {
+                most = left;
+                victim = pool.ranges + i;
+            }
+        }
+        if (!victim)
+        {
+            SDL_mutexV (pool.lock);
+            return 0;
+        }
+        mid = most > pool.grain ? victim->hi - most / 2 : victim->lo;
+        range->lo = mid;
+        range->hi = victim->hi;
+        victim->hi = mid;
+    }
+    *first = range->lo;
+    *n = MIN (pool.grain, range->hi - range->lo);
+    range->lo += *n;
+    SDL_mutexV (pool.lock);
+    return 1;
+}
+
+static void
+_pool_work (int t)
+{
+    int first, n;
+
+    while (_pool_take (t, &first, &n))
+        pool.ranges[t].result += pool.job (pool.data, first, n);
+}
+
+/* Keep worker n on its CPU, if set_pool_affinity gave any */
+static void
+_pool_pin (int n)
+{
+#if PG_POOL_AFFINITY
+    int cpu;
+
+    if (!pool.ncpus)
+        return;
+    cpu = pool.cpus[n % pool.ncpus];
+#if defined(MS_WIN32)
+    SetThreadAffinityMask (GetCurrentThread (), (DWORD_PTR) 1 << cpu);
+#else
+    {
+        cpu_set_t set;
+
+        CPU_ZERO (&set);
+        CPU_SET (cpu, &set);
+        sched_setaffinity (0, sizeof (set), &set);
+    }
+#endif
+#endif
+}
+
+static int
+_pool_worker (void *data)
+{
+    int n = *(int *) data;
+
+    _pool_pin (n);
+    for (;;)
+    {
+        SDL_SemWait (pool.start[n]);
+        if (pool.quit)
+            break;
+        _pool_work (n + 1);
+        SDL_SemPost (pool.done);
+    }
+    return 0;
+}
+
+/* Stop the workers. The caller must hold pool.busy. */
+static void
+_pool_stop (void)
+{
+    int n;
+
+    pool.quit = 1;
+    for (n = 0; n < pool.nworkers; ++n)
+        SDL_SemPost (pool.start[n]);
+    for (n = 0; n < pool.nworkers; ++n)
+    {
+        SDL_WaitThread (pool.workers[n], NULL);
+        SDL_DestroySemaphore (pool.start[n]);
+    }
+    pool.nworkers = 0;
+    pool.quit = 0;
+}
+
+/* Start nworkers workers. The caller must hold pool.busy. */
+static void
+_pool_start (int nworkers)
+{
+    int n;
+
+    for (n = 0; n < nworkers; ++n)
+    {
+        pool.index[n] = n;
+        pool.start[n] = SDL_CreateSemaphore (0);
+        if (!pool.start[n])
+            break;
+        pool.workers[n] = SDL_CreateThread (_pool_worker, &pool.index[n]);
+        if (!pool.workers[n])
+        {
+            SDL_DestroySemaphore (pool.start[n]);
+            break;
+        }
+        pool.nworkers = n + 1;
+    }
+}
+
+/* Run job over rows 0 to n - 1 of data, at least grain rows at a time, on
+ * up to max_threads threads (all of them for 0). The job runs on the
+ * calling thread alone if the pool has no workers, or if another run is
+ * using them, so a job may run jobs of its own. Returns the sum of the job
+ * results. Needs no GIL; jobs run without it on the workers.
+ */
+static int
+PgPool_Run (PgPool_Job job, void *data, int n, int grain, int max_threads)
+{
+    int nranges, i, pos, size, result;
+
+    if (grain < 1)
+        grain = 1;
+    /* The workers are only read while holding busy, as _pool_restart may
+       stop them and free their semaphores in another thread */
+    if (n / grain < 2 || max_threads == 1 || !pool.busy ||
+        SDL_SemTryWait (pool.busy) != 0)
+        return n > 0 ? job (data, 0, n) : 0;
+    nranges = pool.nworkers + 1;
+    if (max_threads > 0 && nranges > max_threads)
+        nranges = max_threads;
+    if (nranges > n / grain)
+        nranges = n / grain;
+    if (nranges < 2)
+    {
+        SDL_SemPost (pool.busy);
+        return job (data, 0, n);
+    }
+
+    pool.job = job;
+    pool.data = data;
+    pool.grain = grain;
+    pool.nranges = nranges;
+    pos = 0;
+    for (i = 0; i < nranges; ++i)
+    {
+        size = n / nranges + (i < n % nranges);
+        pool.ranges[i].lo = pos;
+        pool.ranges[i].hi = pos + size;
+        pool.ranges[i].result = 0;
+        pos += size;
+    }
+
+    for (i = 1; i < nranges; ++i)
+        SDL_SemPost (pool.start[i - 1]);
+    _pool_work (0);
+    for (i = 1; i < nranges; ++i)
+        SDL_SemWait (pool.done);
+    result = 0;
+    for (i = 0; i < nranges; ++i)
+        result += pool.ranges[i].result;
+    SDL_SemPost (pool.busy);
+    return result;
+}
+
+/* The threads a run may use, the calling one included */
+static int
+PgPool_GetThreads (void)
+{
+    return pool.nworkers + 1;
+}
+
+/* Make the semaphores and lock of the pool, if not made yet */
+static int
+_pool_init (void)
+{
+    if (pool.busy)
+        return 0;
+    pool.busy = SDL_CreateSemaphore (1);
+    pool.done = SDL_CreateSemaphore (0);
+    pool.lock = SDL_CreateMutex ();
+    if (!pool.busy || !pool.done || !pool.lock)
+    {
+        if (pool.busy)
+            SDL_DestroySemaphore (pool.busy);
+        if (pool.done)
+            SDL_DestroySemaphore (pool.done);
+        if (pool.lock)
+            SDL_DestroyMutex (pool.lock);
+        pool.busy = pool.done = NULL;
+        pool.lock = NULL;
+        PyErr_SetString (PyExc_RuntimeError, SDL_GetError ());
+        return -1;
+    }
+    return 0;
+}
+
+/* Restart the workers, threads - 1 of them, for a change of settings */
+static void
+_pool_restart (int threads)
+{
+    /* wait for a run in another thread to finish with the workers */
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_SemWait (pool.busy);
+    Py_END_ALLOW_THREADS;
+    _pool_stop ();
+    if (threads > 1)
+        _pool_start (threads - 1);
+    pool.threads = threads;
+    SDL_SemPost (pool.busy);
+}
+
+static PyObject*
+get_pool_threads (PyObject* self)
+{
+    return PyInt_FromLong (pool.threads);
+}
+
+static PyObject*
+set_pool_threads (PyObject* self, PyObject* args)
+{
+    int threads;
+
+    if (!PyArg_ParseTuple (args, "i:set_pool_threads", &threads))
+        return NULL;
+    if (threads < 0)
+        return RAISE (PyExc_ValueError, "thread count must not be negative");
+    if (threads > PG_POOL_MAX_THREADS)
+        threads = PG_POOL_MAX_THREADS;
+    if (_pool_init ())
+        return NULL;
+    _pool_restart (threads);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+set_pool_affinity (PyObject* self, PyObject* args)
+{
+    PyObject *cpusobj = Py_None, *seq;
+    int cpus[PG_POOL_MAX_THREADS];
+    Py_ssize_t i, ncpus = 0;
+
+    if (!PyArg_ParseTuple (args, "|O:set_pool_affinity", &cpusobj))
+        return NULL;
+    if (cpusobj != Py_None)
+    {
+#if !PG_POOL_AFFINITY
+        return RAISE (PyExc_NotImplementedError,
+                      "thread affinity is not supported on this platform");
+#endif
+        seq = PySequence_Fast (cpusobj, "cpus must be a sequence of ints");
+        if (!seq)
+            return NULL;
+        ncpus = PySequence_Fast_GET_SIZE (seq);
+        if (ncpus > PG_POOL_MAX_THREADS)
+            ncpus = PG_POOL_MAX_THREADS;
+        for (i = 0; i < ncpus; ++i)
+        {
+            if (!IntFromObj (PySequence_Fast_GET_ITEM (seq, i), cpus + i) ||
+                cpus[i] < 0 || cpus[i] >= 8 * (int) sizeof (void *))
+            {
+                Py_DECREF (seq);
+                return RAISE (PyExc_ValueError, "cpus must be CPU numbers");
+            }
+        }
+        Py_DECREF (seq);
+    }
+    if (_pool_init ())
+        return NULL;
+
+    /* the workers pin themselves as they start */
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_SemWait (pool.busy);
+    Py_END_ALLOW_THREADS;
+    memcpy (pool.cpus, cpus, sizeof (int) * ncpus);
+    pool.ncpus = (int) ncpus;
+    SDL_SemPost (pool.busy);
+    _pool_restart (pool.threads);
+    Py_RETURN_NONE;
+}
+
+/* What pool_map calls, for _pool_map_rows */
+typedef struct {
+    PyObject *func;
+    PyObject *items;        /* a fast sequence */
+    PyObject *results;
+    PyObject *type, *value, *traceback;     /* of the first failure */
+} PgPoolMap;
+
+static int
+_pool_map_rows (void *data, int first, int n)
+{
+    PgPoolMap *map = (PgPoolMap *) data;
+    PyGILState_STATE state = PyGILState_Ensure ();
+    PyObject *result;
+    int i;
+
+    for (i = first; i < first + n && !map->type; ++i)
+    {
+        result = PyObject_CallFunctionObjArgs (
+            map->func, PySequence_Fast_GET_ITEM (map->items, i), NULL);
+        if (!result)
+        {
+            /* another row may have failed while we were in func; the
+             * GIL serializes us, so keep only the first error */
+            if (!map->type)
+                PyErr_Fetch (&map->type, &map->value, &map->traceback);
+            else
+                PyErr_Clear ();
+        }
+        else
+            PyList_SET_ITEM (map->results, i, result);
+    }
+    PyGILState_Release (state);
+    return 0;
+}
+
+static PyObject*
+pool_map (PyObject* self, PyObject* args)
+{
+    PyObject *func, *seq;
+    PgPoolMap map;
+    Py_ssize_t n;
+
+    if (!PyArg_ParseTuple (args, "OO:pool_map", &func, &seq))
+        return NULL;
+    if (!PyCallable_Check (func))
+        return RAISE (PyExc_TypeError, "func must be callable");
+    if (_pool_init ())
+        return NULL;
+    map.items = PySequence_Fast (seq, "items must be a sequence");
+    if (!map.items)
+        return NULL;
+    n = PySequence_Fast_GET_SIZE (map.items);
+    if (n > INT_MAX)
+    {
+        Py_DECREF (map.items);
+        return RAISE (PyExc_ValueError, "too many items");
+    }
+    map.results = PyList_New (n);
+    if (!map.results)
+    {
+        Py_DECREF (map.items);
+        return NULL;
+    }
+    map.func = func;
+    map.type = map.value = map.traceback = NULL;
+
+#if PY_VERSION_HEX < 0x03070000
+    PyEval_InitThreads ();
+#endif
+    Py_BEGIN_ALLOW_THREADS;
+    PgPool_Run (_pool_map_rows, &map, (int) n, 1, 0);
+    Py_END_ALLOW_THREADS;
+
+    Py_DECREF (map.items);
+    if (map.type)
+    {
+        Py_DECREF (map.results);
+        PyErr_Restore (map.type, map.value, map.traceback);
+        return NULL;
+    }
+    return map.results;
+}
+
+/* CPU features and SIMD backends. Modules with kernels for more than one
+ * instruction set register the Python functions that get and set their
+ * backend with PgSimd_Register, so pygame.set_simd_backend can switch any
+ * of them, and the PYGAME_SIMD and PYGAME_SIMD_<MODULE> environment
+ * variables can pick one as the module loads.
+ */
+
+static const struct {
+    int flag;
+    const char *name;
+} cpu_feature_names[] = {
+    { PG_CPU_MMX, "MMX" },
+    { PG_CPU_SSE, "SSE" },
+    { PG_CPU_SSE2, "SSE2" },
+    { PG_CPU_AVX2, "AVX2" },
+    { PG_CPU_NEON, "NEON" },
+    { 0, NULL }
+};
+
+/* (get, set) function pairs, by module name */
+static PyObject *simd_modules = NULL;
+
+/* SDL 1.2 has no AVX2 test, so ask the CPU and the OS directly. */
+static int
+_cpu_has_avx2 (void)
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_cpu_init ();
+    return __builtin_cpu_supports ("avx2") != 0;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    int info[4];
+
+    __cpuid (info, 0);
+    if (info[0] < 7)
+        return 0;
+    __cpuid (info, 1);
+    /* The OS must save the YMM registers: OSXSAVE and AVX bits */
+    if ((info[2] & 0x18000000) != 0x18000000 || (_xgetbv (0) & 6) != 6)
+        return 0;
+    __cpuidex (info, 7, 0);
+    return (info[1] & 0x20) != 0;
+#else
+    return 0;
+#endif
+}
+
+/* The PG_CPU_ flags of the instruction sets this CPU has */
+static int
+PgCpu_GetFeatures (void)
+{
+    static int features = -1;
+
+    if (features == -1)
+    {
+        features = 0;
+        if (SDL_HasMMX ())
+            features |= PG_CPU_MMX;
+        if (SDL_HasSSE ())
+            features |= PG_CPU_SSE;
+        if (SDL_HasSSE2 ())
+            features |= PG_CPU_SSE2;
+        if (_cpu_has_avx2 ())
+            features |= PG_CPU_AVX2;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        features |= PG_CPU_NEON;
+#endif
+    }
+    return features;
+}
+
+/* Set the backend of a module from the environment variable var, if set.
+ * A backend the module lacks only warns for PYGAME_SIMD_<MODULE>; it is
+ * skipped quietly for PYGAME_SIMD, which applies to all modules.
+ */
+static int
+_simd_from_env (PyObject *set, const char *var, int warn)
+{
+    const char *type = getenv (var);
+    PyObject *result;
+    char msg[200];
+
+    if (!type || !*type)
+        return 0;
+    result = PyObject_CallFunction (set, "s", type);
+    if (result)
+    {
+        Py_DECREF (result);
+        return 1;
+    }
+    if (!PyErr_ExceptionMatches (PyExc_ValueError))
+        return -1;
+    PyErr_Clear ();
+    if (warn)
+    {
+        PyOS_snprintf (msg, sizeof (msg), "%s: no backend %.50s", var, type);
+        if (PyErr_WarnEx (PyExc_RuntimeWarning, msg, 1))
+            return -1;
+    }
+    return 0;
+}
+
+/* Register the functions getting and setting the backend of module name,
+ * get() -> str and set(str). set must raise ValueError for a backend it
+ * does not have. Picks the backend of the environment variables, if any.
+ * Returns -1 with a Python exception on failure.
+ */
+static int
+PgSimd_Register (const char *name, PyObject *get, PyObject *set)
+{
+    PyObject *pair;
+    char var[64];
+    int i, result;
+
+    if (!simd_modules)
+    {
+        simd_modules = PyDict_New ();
+        if (!simd_modules)
+            return -1;
+    }
+    pair = Py_BuildValue ("(OO)", get, set);
+    if (!pair)
+        return -1;
+    result = PyDict_SetItemString (simd_modules, name, pair);
+    Py_DECREF (pair);
+    if (result)
+        return -1;
+
+    PyOS_snprintf (var, sizeof (var), "PYGAME_SIMD_%.40s", name);
+    for (i = 12; var[i]; ++i)
+        var[i] = toupper ((unsigned char) var[i]);
+    result = _simd_from_env (set, var, 1);
+    if (!result)
+        result = _simd_from_env (set, "PYGAME_SIMD", 0);
+    return result < 0 ? -1 : 0;
+}
+
+static PyObject*
+get_cpu_features (PyObject* self)
+{
+    int features = PgCpu_GetFeatures ();
+    PyObject *list, *tuple, *name;
+    int i;
+
+    list = PyList_New (0);
+    if (!list)
+        return NULL;
+    for (i = 0; cpu_feature_names[i].name; ++i)
+    {
+        if (!(features & cpu_feature_names[i].flag))
+            continue;
+        name = Text_FromUTF8 (cpu_feature_names[i].name);
+        if (!name || PyList_Append (list, name))
+        {
+            Py_XDECREF (name);
+            Py_DECREF (list);
+            return NULL;
+        }
+        Py_DECREF (name);
+    }
+    tuple = PyList_AsTuple (list);
+    Py_DECREF (list);
+    return tuple;
+}
+
+/* The (get, set) pair of a registered module */
+static PyObject*
+_simd_module (const char *name)
+{
+    PyObject *pair = NULL;
+
+    if (simd_modules)
+        pair = PyDict_GetItemString (simd_modules, name);
+    if (!pair)
+        PyErr_Format (PyExc_ValueError,
+                      "no SIMD backends for module %.100s", name);
+    return pair;
+}
+
+static PyObject*
+get_simd_backend (PyObject* self, PyObject* args)
+{
+    const char *name = NULL;
+    PyObject *pair, *dict, *key, *backend;
+    Py_ssize_t pos = 0;
+
+    if (!PyArg_ParseTuple (args, "|s:get_simd_backend", &name))
+        return NULL;
+    if (name)
+    {
+        pair = _simd_module (name);
+        if (!pair)
+            return NULL;
+        return PyObject_CallObject (PyTuple_GET_ITEM (pair, 0), NULL);
+    }
+
+    dict = PyDict_New ();
+    if (!dict || !simd_modules)
+        return dict;
+    while (PyDict_Next (simd_modules, &pos, &key, &pair))
+    {
+        backend = PyObject_CallObject (PyTuple_GET_ITEM (pair, 0), NULL);
+        if (!backend || PyDict_SetItem (dict, key, backend))
+        {
+            Py_XDECREF (backend);
+            Py_DECREF (dict);
+            return NULL;
+        }
+        Py_DECREF (backend);
+    }
+    return dict;
+}
+
+static PyObject*
+set_simd_backend (PyObject* self, PyObject* args)
+{
+    const char *name, *type;
+    PyObject *pair, *result;
+
+    if (!PyArg_ParseTuple (args, "ss:set_simd_backend", &name, &type))
+        return NULL;
+    pair = _simd_module (name);
+    if (!pair)
+        return NULL;
+    result = PyObject_CallFunction (PyTuple_GET_ITEM (pair, 1), "s", type);
+    if (!result)
+        return NULL;
+    Py_DECREF (result);
+    Py_RETURN_NONE;
+}
+
+/* The counters of pygame.perf. Modules count with PG_PERF_ADD and time
+ * with PG_PERF_BEGIN and PG_PERF_END, which only test pg_perf.enabled while
+ * it is off. Counts from threads without the GIL may race and be lost.
+ */
+static PgPerfCounters pg_perf;
+
+static const char *perf_names[PG_PERF_NUMCOUNTERS] = {
+    "blit.calls",
+    "blit.seconds",
+    "blit.pixels.none",
+    "blit.pixels.BLEND_RGB_ADD",
+    "blit.pixels.BLEND_RGB_SUB",
+    "blit.pixels.BLEND_RGB_MULT",
+    "blit.pixels.BLEND_RGB_MIN",
+    "blit.pixels.BLEND_RGB_MAX",
+    "blit.pixels.BLEND_RGBA_ADD",
+    "blit.pixels.BLEND_RGBA_SUB",
+    "blit.pixels.BLEND_RGBA_MULT",
+    "blit.pixels.BLEND_RGBA_MIN",
+    "blit.pixels.BLEND_RGBA_MAX",
+    "blit.pixels.BLEND_PREMULTIPLIED",
+    "fill.calls",
+    "fill.pixels",
+    "fill.seconds",
+    "smoothscale.calls",
+    "smoothscale.pixels",
+    "smoothscale.seconds",
+    "display.calls",
+    "display.pixels",
+    "display.seconds",
+    "event.calls",
+    "event.events",
+    "event.seconds",
+    "freetype.calls",
+    "freetype.glyphs",
+    "freetype.cache_hits",
+    "freetype.cache_misses",
+    "freetype.seconds"
+};
+
+/* Nanoseconds from some fixed time, for PG_PERF_BEGIN */
+static Uint64
+PgPerf_Now (void)
+{
+#if defined(MS_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER now;
+
+    if (!frequency.QuadPart)
+        QueryPerformanceFrequency (&frequency);
+    QueryPerformanceCounter (&now);
+    return (Uint64) (now.QuadPart / frequency.QuadPart * 1000000000 +
+                     now.QuadPart % frequency.QuadPart * 1000000000 /
+                     frequency.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (Uint64) now.tv_sec * 1000000000 + now.tv_nsec;
+#else
+    struct timeval now;
+
+    gettimeofday (&now, NULL);
+    return (Uint64) now.tv_sec * 1000000000 + now.tv_usec * 1000;
+#endif
+}
+
+static PyObject*
+perf_set_enabled (PyObject* self, PyObject* args)
+{
+    int enabled;
+
+    if (!PyArg_ParseTuple (args, "i:_perf_set_enabled", &enabled))
+        return NULL;
+    pg_perf.enabled = enabled != 0;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+perf_get_enabled (PyObject* self)
+{
+    return PyBool_FromLong (pg_perf.enabled);
+}
+
+static PyObject*
+perf_reset (PyObject* self)
+{
+    memset (pg_perf.counts, 0, sizeof (pg_perf.counts));
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+perf_snapshot (PyObject* self)
+{
+    PyObject *dict = PyDict_New (), *value;
+    int i, result;
+
+    if (!dict)
+        return NULL;
+    for (i = 0; i < PG_PERF_NUMCOUNTERS; ++i)
+    {
+        if (strstr (perf_names[i], ".seconds"))
+            value = PyFloat_FromDouble (pg_perf.counts[i] / 1e9);
+        else
+            value = PyLong_FromUnsignedLongLong (pg_perf.counts[i]);
+        if (!value)
+        {
+            Py_DECREF (dict);
+            return NULL;
+        }
+        result = PyDict_SetItemString (dict, perf_names[i], value);
+        Py_DECREF (value);
+        if (result)
+        {
+            Py_DECREF (dict);
+            return NULL;
+        }
+    }
+    return dict;
+}
+
 /* bind functions to python */
 
 static PyObject*
@@ -2016,6 +2866,28 @@ static PyMethodDef _base_methods[] =
     { "get_array_interface", (PyCFunction) get_array_interface, METH_O,
       "return an array struct interface as an interface dictionary" },
 
+    { "get_pool_threads", (PyCFunction) get_pool_threads, METH_NOARGS,
+      DOC_PYGAMEGETPOOLTHREADS },
+    { "set_pool_threads", set_pool_threads, METH_VARARGS,
+      DOC_PYGAMESETPOOLTHREADS },
+    { "set_pool_affinity", set_pool_affinity, METH_VARARGS,
+      DOC_PYGAMESETPOOLAFFINITY },
+    { "pool_map", pool_map, METH_VARARGS, DOC_PYGAMEPOOLMAP },
+    { "get_cpu_features", (PyCFunction) get_cpu_features, METH_NOARGS,
+      DOC_PYGAMEGETCPUFEATURES },
+    { "get_simd_backend", get_simd_backend, METH_VARARGS,
+      DOC_PYGAMEGETSIMDBACKEND },
+    { "set_simd_backend", set_simd_backend, METH_VARARGS,
+      DOC_PYGAMESETSIMDBACKEND },
+    { "_perf_set_enabled", perf_set_enabled, METH_VARARGS,
+      "_perf_set_enabled(on) -> None\nturn the pygame.perf counters on or off" },
+    { "_perf_get_enabled", (PyCFunction) perf_get_enabled, METH_NOARGS,
+      "_perf_get_enabled() -> bool\nare the pygame.perf counters on" },
+    { "_perf_reset", (PyCFunction) perf_reset, METH_NOARGS,
+      "_perf_reset() -> None\nzero the pygame.perf counters" },
+    { "_perf_snapshot", (PyCFunction) perf_snapshot, METH_NOARGS,
+      "_perf_snapshot() -> dict\nthe pygame.perf counters" },
+
     { "segfault", (PyCFunction) do_segfault, METH_NOARGS, "crash" },
     { NULL, NULL, 0, NULL }
 };
@@ -2027,6 +2899,7 @@ MODINIT_DEFINE(base)
     PyObject *atexit, *atexit_register = NULL, *quit, *rval;
     PyObject *PyExc_SDLError;
     int ecode;
+    int i;
     static void* c_api[PYGAMEAPI_BASE_NUMSLOTS];
 
 #if PY3
@@ -2040,6 +2913,21 @@ MODINIT_DEFINE(base)
     };
 #endif
 
+    for (i = 0; i < ARRATTR_COUNT; ++i) {
+        if (!array_attr_strs[i]) {
+#if PY3
+            array_attr_strs[i] =
+                PyUnicode_InternFromString (array_attr_names[i]);
+#else
+            array_attr_strs[i] =
+                PyString_InternFromString (array_attr_names[i]);
+#endif
+            if (!array_attr_strs[i]) {
+                MODINIT_ERROR;
+            }
+        }
+    }
+
     if (!is_loaded) {
         /* import need modules. Do this first so if there is an error
            the module is not loaded.
@@ -2102,8 +2990,12 @@ MODINIT_DEFINE(base)
         MODINIT_ERROR;
     }
 
+    /* PYGAME_PERF=1 turns pygame.perf on from the start */
+    if (getenv ("PYGAME_PERF") && strcmp (getenv ("PYGAME_PERF"), "0"))
+        pg_perf.enabled = 1;
+
     /* export the c api */
-#if PYGAMEAPI_BASE_NUMSLOTS != 19
+#if PYGAMEAPI_BASE_NUMSLOTS != 25
 #error export slot count mismatch
 #endif
     c_api[0] = PyExc_SDLError;
@@ -2125,6 +3017,12 @@ MODINIT_DEFINE(base)
     c_api[16] = PgBuffer_Release;
     c_api[17] = PgDict_AsBuffer;
     c_api[18] = PgExc_BufferError;
+    c_api[19] = PgPool_Run;
+    c_api[20] = PgPool_GetThreads;
+    c_api[21] = PgCpu_GetFeatures;
+    c_api[22] = PgSimd_Register;
+    c_api[23] = &pg_perf;
+    c_api[24] = PgPerf_Now;
     apiobj = encapsulate_api (c_api, "base");
     if (apiobj == NULL) {
         Py_XDECREF (atexit_register);
@@ -32,12 +32,33 @@
 #define MIN(a,b) ((a) <= (b) ? (a) : (b))
 #define MAX(a,b) ((a) >= (b) ? (a) : (b))
 
+/* The word loops of the overlap functions run over the rows of one stripe,
+   which are consecutive words, so SSE2 can do two 64-bit words at once. */
+#if defined(BITMASK_W_64) && (defined(__SSE2__) || defined(_M_X64))
+#define BITMASK_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_WIN64)
+#include <intrin.h>
+#pragma intrinsic(_BitScanForward64)
+#if defined(__AVX__)
+#define BITMASK_POPCNT64 __popcnt64
+#endif
+#elif defined(__GNUC__) && defined(__POPCNT__)
+#define BITMASK_POPCNT64 __builtin_popcountll
+#endif
+
 /* The code by Gillies is slightly (1-3%) faster than the more
    readable code below */
 #define GILLIES
 
 static INLINE unsigned int bitcount(BITMASK_W n)
 {
+#ifdef BITMASK_POPCNT64
+  /* the compiler targets a cpu with the POPCNT instruction */
+  return (unsigned int)BITMASK_POPCNT64(n);
+#else
   if (BITMASK_W_LEN == 32)
   {
 #ifdef GILLIES
@@ -83,6 +104,176 @@ static INLINE unsigned int bitcount(BITMASK_W n)
     }
     return nbits;
   }
+#endif
+}
+
+#ifdef BITMASK_SSE2
+/* bitcount of both 64-bit halves of x, as two 64-bit sums */
+static INLINE __m128i bitcount_sse2(__m128i x)
+{
+  const __m128i m1 = _mm_set1_epi8(0x55);
+  const __m128i m2 = _mm_set1_epi8(0x33);
+  const __m128i m4 = _mm_set1_epi8(0x0f);
+
+  x = _mm_sub_epi64(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+  x = _mm_add_epi64(_mm_and_si128(x, m2),
+                    _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+  x = _mm_and_si128(_mm_add_epi64(x, _mm_srli_epi64(x, 4)), m4);
+  return _mm_sad_epu8(x, _mm_setzero_si128());
+}
+#endif
+
+/* The n words (*a >> shift | *a2 << (BITMASK_W_LEN - shift)) & *b, as are
+   tested in the overlap functions. a2 is NULL for *a >> shift alone, and
+   must be if shift is 0. */
+#define RUN_WORD(a, a2, b, i, shift)                                      \
+  ((a2) ? ((a)[i] >> (shift) | (a2)[i] << (BITMASK_W_LEN - (shift))) & (b)[i] \
+        : ((a)[i] >> (shift)) & (b)[i])
+
+#ifdef BITMASK_SSE2
+#define RUN_VECTOR(a, a2, b, i, s, r)                                     \
+  _mm_and_si128(_mm_loadu_si128((const __m128i*)((b) + (i))),            \
+                (a2) ? _mm_or_si128(                                      \
+                  _mm_srl_epi64(_mm_loadu_si128((const __m128i*)((a) + (i))), s), \
+                  _mm_sll_epi64(_mm_loadu_si128((const __m128i*)((a2) + (i))), r)) \
+                     : _mm_srl_epi64(_mm_loadu_si128((const __m128i*)((a) + (i))), s))
+#endif
+
+/* Nonzero if any of the n run words is set */
+static INLINE int run_overlap(const BITMASK_W *a, const BITMASK_W *a2,
+                              const BITMASK_W *b, int n, unsigned int shift)
+{
+  int i = 0;
+#ifdef BITMASK_SSE2
+  const __m128i s = _mm_cvtsi32_si128(shift);
+  const __m128i r = _mm_cvtsi32_si128(BITMASK_W_LEN - shift);
+  const __m128i zero = _mm_setzero_si128();
+
+  for (; i + 8 <= n; i += 8)
+  {
+    __m128i hits = _mm_or_si128(
+      _mm_or_si128(RUN_VECTOR(a, a2, b, i, s, r),
+                   RUN_VECTOR(a, a2, b, i + 2, s, r)),
+      _mm_or_si128(RUN_VECTOR(a, a2, b, i + 4, s, r),
+                   RUN_VECTOR(a, a2, b, i + 6, s, r)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(hits, zero)) != 0xFFFF)
+      return 1;
+  }
+#endif
+  for (; i < n; i++)
+    if (RUN_WORD(a, a2, b, i, shift))
+      return 1;
+  return 0;
+}
+
+/* The number of bits set in the n run words */
+static INLINE unsigned int run_overlap_area(const BITMASK_W *a,
+                                            const BITMASK_W *a2,
+                                            const BITMASK_W *b, int n,
+                                            unsigned int shift)
+{
+  unsigned int count = 0;
+  int i = 0;
+#ifdef BITMASK_SSE2
+  const __m128i s = _mm_cvtsi32_si128(shift);
+  const __m128i r = _mm_cvtsi32_si128(BITMASK_W_LEN - shift);
+  __m128i sums = _mm_setzero_si128();
+
+  for (; i + 2 <= n; i += 2)
+    sums = _mm_add_epi64(sums, bitcount_sse2(RUN_VECTOR(a, a2, b, i, s, r)));
+  count = _mm_cvtsi128_si32(sums) +
+    _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+#endif
+  for (; i < n; i++)
+    count += bitcount(RUN_WORD(a, a2, b, i, shift));
+  return count;
+}
+
+/* Nonzero if block map m has a block set in stripe s for any of the n rows
+   from y, or if m is NULL */
+static INLINE int blocks_any(const bitmask_t *m, int s, int y, int n)
+{
+  int band, last;
+
+  if (!m)
+    return 1;
+  last = (y + n - 1)/BITMASK_BLOCK_H;
+  for (band = y/BITMASK_BLOCK_H; band <= last; band++)
+    if (bitmask_getbit(m, s, band))
+      return 1;
+  return 0;
+}
+
+/* run_overlap(), or run_overlap_area() if area, of the n rows at a_entry
+   and b_entry, skipping the rows in blocks which are empty in the block
+   maps of a or b.  Either map may be NULL. */
+static unsigned int run_blocks(const bitmask_t *a, const bitmask_t *ablocks,
+                               const bitmask_t *b, const bitmask_t *bblocks,
+                               const BITMASK_W *a_entry, const BITMASK_W *a2,
+                               const BITMASK_W *b_entry, int n,
+                               unsigned int shift, int area)
+{
+  unsigned int count = 0;
+  int as, ay, bs, by, k;
+
+  if (!ablocks && !bblocks)
+    return area ? run_overlap_area(a_entry, a2, b_entry, n, shift)
+                : (unsigned int)run_overlap(a_entry, a2, b_entry, n, shift);
+
+  as = (a_entry - a->bits)/a->h;
+  ay = (a_entry - a->bits)%a->h;
+  bs = (b_entry - b->bits)/b->h;
+  by = (b_entry - b->bits)%b->h;
+  while (n > 0)
+  {
+    k = MIN(n, BITMASK_BLOCK_H - ay%BITMASK_BLOCK_H);
+    if ((blocks_any(ablocks, as, ay, k) ||
+         (a2 && blocks_any(ablocks, as + 1, ay, k))) &&
+        blocks_any(bblocks, bs, by, k))
+    {
+      if (area)
+        count += run_overlap_area(a_entry, a2, b_entry, k, shift);
+      else if (run_overlap(a_entry, a2, b_entry, k, shift))
+        return 1;
+    }
+    a_entry += k;
+    if (a2)
+      a2 += k;
+    b_entry += k;
+    ay += k;
+    by += k;
+    n -= k;
+  }
+  return count;
+}
+
+/* c = a & (b << shift), or a & (b >> shift) if right, for n words. If
+   merge is set the result is ORed into c, which already holds the part
+   of the stripe taken from the neighbouring stripe of b. */
+static INLINE void run_overlap_mask(BITMASK_W *c, const BITMASK_W *a,
+                                    const BITMASK_W *b, int n,
+                                    unsigned int shift, int right, int merge)
+{
+  int i = 0;
+#ifdef BITMASK_SSE2
+  const __m128i s = _mm_cvtsi32_si128(shift);
+
+  for (; i + 2 <= n; i += 2)
+  {
+    __m128i bv = _mm_loadu_si128((const __m128i*)(b + i));
+
+    bv = right ? _mm_srl_epi64(bv, s) : _mm_sll_epi64(bv, s);
+    bv = _mm_and_si128(_mm_loadu_si128((const __m128i*)(a + i)), bv);
+    if (merge)
+      bv = _mm_or_si128(_mm_loadu_si128((const __m128i*)(c + i)), bv);
+    _mm_storeu_si128((__m128i*)(c + i), bv);
+  }
+#endif
+  for (; i < n; i++)
+  {
+    BITMASK_W w = a[i] & (right ? b[i] >> shift : b[i] << shift);
+    c[i] = merge ? c[i] | w : w;
+  }
 }
 
 bitmask_t *bitmask_create(int w, int h)
@@ -158,12 +349,156 @@ unsigned int bitmask_count(bitmask_t *m)
     return tot;
 }
 
+/* The count of the set bits of each byte, and the sums of their indices
+   and of the squares of those, from which bitmask_moments() sums the bits
+   of a word a byte at a time. */
+static unsigned char moment_count[256];
+static unsigned short moment_sum[256], moment_sum2[256];
+
+static void moment_tables(void)
+{
+  int byte, i;
+
+  if (moment_count[255])
+    return;
+  for (byte = 1; byte < 256; byte++)
+  {
+    moment_sum[byte] = moment_sum2[byte] = 0;
+    for (i = 0; i < 8; i++)
+      if (byte & (1 << i))
+      {
+        moment_sum[byte] += i;
+        moment_sum2[byte] += i*i;
+      }
+  }
+  for (byte = 1; byte < 256; byte++)
+    moment_count[byte] = (unsigned char)bitcount(byte);
+}
+
+void bitmask_moments(const bitmask_t *m, int x, int y, int w, int h,
+                     bitmask_moments_t *moments, int sign)
+{
+  BITMASK_W cmask, b;
+  long long m00 = 0, m10 = 0, m01 = 0, m11 = 0, m20 = 0, m02 = 0;
+  long long n, s1, s2, sx, X, P;
+  int x1 = x + w, y1 = y + h, c, c1, yy, byte;
+
+  if (x < 0)
+    x = 0;
+  if (y < 0)
+    y = 0;
+  if (x1 > m->w)
+    x1 = m->w;
+  if (y1 > m->h)
+    y1 = m->h;
+  if (x >= x1 || y >= y1)
+    return;
+  moment_tables();
+
+  c1 = (x1 - 1)/BITMASK_W_LEN;
+  for (c = x/BITMASK_W_LEN; c <= c1; c++)
+  {
+    cmask = ~(BITMASK_W)0;
+    if (c == x/BITMASK_W_LEN)
+      cmask &= ~(BITMASK_W)0 << (x & BITMASK_W_MASK);
+    if (c == c1)
+      cmask &= ~(BITMASK_W)0 >> (BITMASK_W_MASK - ((x1 - 1) & BITMASK_W_MASK));
+    X = (long long)c*BITMASK_W_LEN;
+    for (yy = y; yy < y1; yy++)
+    {
+      b = m->bits[c*m->h + yy] & cmask;
+      if (!b)
+        continue;
+      /* the sums for the word, from its own first bit */
+      n = s1 = s2 = 0;
+      for (P = 0; b; P += 8, b >>= 8)
+      {
+        byte = (int)(b & 0xff);
+        if (!byte)
+          continue;
+        n += moment_count[byte];
+        s1 += moment_count[byte]*P + moment_sum[byte];
+        s2 += moment_count[byte]*P*P + 2*P*moment_sum[byte] +
+              moment_sum2[byte];
+      }
+      sx = n*X + s1;
+      m00 += n;
+      m10 += sx;
+      m01 += yy*n;
+      m11 += yy*sx;
+      m20 += n*X*X + 2*X*s1 + s2;
+      m02 += (long long)yy*yy*n;
+    }
+  }
+  moments->m00 += sign*m00;
+  moments->m10 += sign*m10;
+  moments->m01 += sign*m01;
+  moments->m11 += sign*m11;
+  moments->m20 += sign*m20;
+  moments->m02 += sign*m02;
+}
+
+bitmask_t *bitmask_blocks_create(const bitmask_t *m)
+{
+  bitmask_t *blocks;
+
+  blocks = bitmask_create((m->w - 1)/BITMASK_W_LEN + 1,
+                          (m->h - 1)/BITMASK_BLOCK_H + 1);
+  if (blocks)
+    bitmask_blocks_update(blocks, m, 0, 0, m->w, m->h);
+  return blocks;
+}
+
+void bitmask_blocks_update(bitmask_t *blocks, const bitmask_t *m,
+                           int x, int y, int w, int h)
+{
+  const BITMASK_W *p, *end;
+  BITMASK_W any;
+  int s, slast, band, blast;
+
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  w = MIN(w, m->w - x);
+  h = MIN(h, m->h - y);
+  if (w <= 0 || h <= 0)
+    return;
+
+  slast = (x + w - 1)/BITMASK_W_LEN;
+  blast = (y + h - 1)/BITMASK_BLOCK_H;
+  for (s = x/BITMASK_W_LEN; s <= slast; s++)
+    for (band = y/BITMASK_BLOCK_H; band <= blast; band++)
+    {
+      p = m->bits + s*m->h + band*BITMASK_BLOCK_H;
+      end = m->bits + s*m->h + MIN(m->h, (band + 1)*BITMASK_BLOCK_H);
+      for (any = 0; p < end && !any; p++)
+        any = *p;
+      if (any)
+        bitmask_setbit(blocks, s, band);
+      else
+        bitmask_clearbit(blocks, s, band);
+    }
+}
+
 int bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
+{
+  return bitmask_overlap_blocks(a, NULL, b, NULL, xoffset, yoffset);
+}
+
+int bitmask_overlap_blocks(const bitmask_t *a, const bitmask_t *ablocks,
+                           const bitmask_t *b, const bitmask_t *bblocks,
+                           int xoffset, int yoffset)
 {
   const BITMASK_W *a_entry,*a_end;
   const BITMASK_W *b_entry;
-  const BITMASK_W *ap,*app,*bp;
-  unsigned int shift,rshift,i,astripes,bstripes;
+  unsigned int shift,i,astripes,bstripes;
 
   if ((xoffset >= a->w) || (yoffset >= a->h) || (b->h + yoffset <= 0) || (b->w + xoffset <= 0))
     return 0;
@@ -186,29 +521,29 @@ int bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset, int yof
     shift = xoffset & BITMASK_W_MASK;
     if (shift)
     {
-      rshift = BITMASK_W_LEN - shift;
       astripes = ((unsigned int)(a->w - 1))/BITMASK_W_LEN - (unsigned int)xoffset/BITMASK_W_LEN;
       bstripes = ((unsigned int)(b->w - 1))/BITMASK_W_LEN + 1;
       if (bstripes > astripes) /* zig-zag .. zig*/
       {
         for (i=0;i<astripes;i++)
         {
-          for (ap = a_entry, app = ap + a->h, bp = b_entry;ap < a_end;)
-            if ((*ap++ >> shift) & *bp || (*app++ << rshift) & *bp++) return 1;
+          if (run_blocks(a, ablocks, b, bblocks, a_entry, a_entry + a->h, b_entry,
+                         a_end - a_entry, shift, 0))
+            return 1;
           a_entry += a->h;
           a_end += a->h;
           b_entry += b->h;
         }
-          for (ap = a_entry,bp = b_entry;ap < a_end;)
-          if ((*ap++ >> shift) & *bp++) return 1;
-          return 0;
+        return run_blocks(a, ablocks, b, bblocks, a_entry, NULL, b_entry,
+                          a_end - a_entry, shift, 0);
       }
       else /* zig-zag */
       {
         for (i=0;i<bstripes;i++)
         {
-          for (ap = a_entry, app = ap + a->h, bp = b_entry;ap < a_end;)
-            if ((*ap++ >> shift) & *bp || (*app++ << rshift) & *bp++) return 1;
+          if (run_blocks(a, ablocks, b, bblocks, a_entry, a_entry + a->h, b_entry,
+                         a_end - a_entry, shift, 0))
+            return 1;
           a_entry += a->h;
           a_end += a->h;
           b_entry += b->h;
@@ -221,8 +556,9 @@ int bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset, int yof
       astripes = (MIN(b->w,a->w - xoffset) - 1)/BITMASK_W_LEN + 1;
       for (i=0;i<astripes;i++)
       {
-        for (ap = a_entry,bp = b_entry;ap < a_end;)
-          if (*ap++ & *bp++) return 1;
+        if (run_blocks(a, ablocks, b, bblocks, a_entry, NULL, b_entry,
+                       a_end - a_entry, 0, 0))
+          return 1;
         a_entry += a->h;
         a_end += a->h;
         b_entry += b->h;
@@ -235,6 +571,9 @@ int bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset, int yof
     const bitmask_t *c = a;
     a = b;
     b = c;
+    c = ablocks;
+    ablocks = bblocks;
+    bblocks = c;
     xoffset *= -1;
     yoffset *= -1;
     goto swapentry;
@@ -244,6 +583,13 @@ int bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset, int yof
 /* Will hang if there are no bits set in w! */
 static INLINE int firstsetbit(BITMASK_W w)
 {
+#if defined(__GNUC__)
+  return __builtin_ctzll(w);
+#elif defined(_MSC_VER) && defined(_WIN64)
+  unsigned long i;
+  _BitScanForward64(&i, w);
+  return (int)i;
+#else
   int i = 0;
   while ((w & 1) == 0)
   {
@@ -251,6 +597,7 @@ static INLINE int firstsetbit(BITMASK_W w)
     w/=2;
   }
   return i;
+#endif
 }
 
 /* x and y are given in the coordinates of mask a, and are untouched if there is no overlap */
@@ -259,7 +606,8 @@ int bitmask_overlap_pos(const bitmask_t *a, const bitmask_t *b, int xoffset, int
   const BITMASK_W *a_entry,*a_end, *b_entry, *ap, *bp;
   unsigned int shift,rshift,i,astripes,bstripes,xbase;
 
-  if ((xoffset >= a->w) || (yoffset >= a->h) || (yoffset <= - b->h))
+  if ((xoffset >= a->w) || (yoffset >= a->h) || (xoffset <= - b->w) ||
+      (yoffset <= - b->h))
     return 0;
 
   if (xoffset >= 0)
@@ -378,8 +726,15 @@ int bitmask_overlap_pos(const bitmask_t *a, const bitmask_t *b, int xoffset, int
 
 int bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 {
-  const BITMASK_W *a_entry,*a_end, *b_entry, *ap,*bp;
-  unsigned int shift,rshift,i,astripes,bstripes;
+  return bitmask_overlap_area_blocks(a, NULL, b, NULL, xoffset, yoffset);
+}
+
+int bitmask_overlap_area_blocks(const bitmask_t *a, const bitmask_t *ablocks,
+                                const bitmask_t *b, const bitmask_t *bblocks,
+                                int xoffset, int yoffset)
+{
+  const BITMASK_W *a_entry,*a_end, *b_entry;
+  unsigned int shift,i,astripes,bstripes;
   unsigned int count = 0;
 
   if ((xoffset >= a->w) || (yoffset >= a->h) || (b->h + yoffset <= 0) || (b->w + xoffset <= 0))
@@ -403,29 +758,28 @@ int bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset, in
     shift = xoffset & BITMASK_W_MASK;
     if (shift)
     {
-      rshift = BITMASK_W_LEN - shift;
       astripes = (a->w - 1)/BITMASK_W_LEN - xoffset/BITMASK_W_LEN;
       bstripes = (b->w - 1)/BITMASK_W_LEN + 1;
       if (bstripes > astripes) /* zig-zag .. zig*/
       {
         for (i=0;i<astripes;i++)
         {
-          for (ap = a_entry,bp = b_entry;ap < a_end;ap++,bp++)
-            count += bitcount(((*ap >> shift) | (*(ap + a->h) << rshift)) & *bp);
+          count += run_blocks(a, ablocks, b, bblocks, a_entry, a_entry + a->h, b_entry,
+                              a_end - a_entry, shift, 1);
           a_entry += a->h;
           a_end += a->h;
           b_entry += b->h;
         }
-        for (ap = a_entry,bp = b_entry;ap < a_end;)
-          count += bitcount((*ap++ >> shift) & *bp++);
+        count += run_blocks(a, ablocks, b, bblocks, a_entry, NULL, b_entry,
+                            a_end - a_entry, shift, 1);
         return count;
       }
       else /* zig-zag */
       {
         for (i=0;i<bstripes;i++)
         {
-          for (ap = a_entry,bp = b_entry;ap < a_end;ap++,bp++)
-            count += bitcount(((*ap >> shift) | (*(ap + a->h) << rshift)) & *bp);
+          count += run_blocks(a, ablocks, b, bblocks, a_entry, a_entry + a->h, b_entry,
+                              a_end - a_entry, shift, 1);
           a_entry += a->h;
           a_end += a->h;
           b_entry += b->h;
@@ -438,8 +792,8 @@ int bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset, in
       astripes = (MIN(b->w,a->w - xoffset) - 1)/BITMASK_W_LEN + 1;
       for (i=0;i<astripes;i++)
       {
-        for (ap = a_entry,bp = b_entry;ap < a_end;)
-          count += bitcount(*ap++ & *bp++);
+        count += run_blocks(a, ablocks, b, bblocks, a_entry, NULL, b_entry,
+                            a_end - a_entry, 0, 1);
 
         a_entry += a->h;
         a_end += a->h;
@@ -453,6 +807,9 @@ int bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset, in
     const bitmask_t *c = a;
     a = b;
     b = c;
+    c = ablocks;
+    ablocks = bblocks;
+    bblocks = c;
     xoffset *= -1;
     yoffset *= -1;
     goto swapentry;
@@ -462,12 +819,13 @@ int bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset, in
 /* Makes a mask of the overlap of two other masks */
 void bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c, int xoffset, int yoffset)
 {
-  const BITMASK_W *a_entry,*a_end, *ap;
-  const BITMASK_W *b_entry, *b_end, *bp;
+  const BITMASK_W *a_entry,*a_end;
+  const BITMASK_W *b_entry, *b_end;
   BITMASK_W *c_entry, *c_end, *cp;
   int shift,rshift,i,astripes,bstripes;
 
-  if ((xoffset >= a->w) || (yoffset >= a->h) || (yoffset <= - b->h))
+  if ((xoffset >= a->w) || (yoffset >= a->h) || (xoffset <= - b->w) ||
+      (yoffset <= - b->h))
     return;
 
   if (xoffset >= 0)
@@ -496,29 +854,27 @@ void bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
         {
         for (i=0;i<astripes;i++)
         {
-          for (ap = a_entry,bp = b_entry,cp = c_entry;ap < a_end;ap++,bp++,cp++)
-            *cp = *ap & (*bp << shift);
+          run_overlap_mask(c_entry, a_entry, b_entry, a_end - a_entry, shift, 0,
+                           i > 0);
           a_entry += a->h;
           c_entry += c->h;
           a_end += a->h;
-          for (ap = a_entry,bp = b_entry,cp = c_entry;ap < a_end;ap++,bp++,cp++)
-            *cp = *ap & (*bp >> rshift);
+          run_overlap_mask(c_entry, a_entry, b_entry, a_end - a_entry, rshift, 1, 0);
           b_entry += b->h;
         }
-        for (ap = a_entry,bp = b_entry,cp = c_entry;ap < a_end;ap++,bp++,cp++)
-          *cp = *ap & (*bp << shift);
+        run_overlap_mask(c_entry, a_entry, b_entry, a_end - a_entry, shift, 0,
+                         astripes > 0);
       }
       else /* zig-zag */
       {
         for (i=0;i<bstripes;i++)
         {
-          for (ap = a_entry,bp = b_entry,cp = c_entry;ap < a_end;ap++,bp++,cp++)
-            *cp = *ap & (*bp << shift);
+          run_overlap_mask(c_entry, a_entry, b_entry, a_end - a_entry, shift, 0,
+                           i > 0);
           a_entry += a->h;
           c_entry += c->h;
           a_end += a->h;
-          for (ap = a_entry,bp = b_entry,cp = c_entry;ap < a_end;ap++,bp++,cp++)
-            *cp = *ap & (*bp >> rshift);
+          run_overlap_mask(c_entry, a_entry, b_entry, a_end - a_entry, rshift, 1, 0);
           b_entry += b->h;
         }
       }
@@ -529,10 +885,7 @@ void bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
       astripes = (MIN(b->w,a->w - xoffset) - 1)/BITMASK_W_LEN + 1;
       for (i=0;i<astripes;i++)
       {
-        for (ap = a_entry,bp = b_entry,cp = c_entry;ap < a_end;ap++,bp++,cp++)
-        {
-          *cp = *ap & *bp;
-        }
+        run_overlap_mask(c_entry, a_entry, b_entry, a_end - a_entry, 0, 0, 0);
         a_entry += a->h;
         c_entry += c->h;
         a_end += a->h;
@@ -569,28 +922,23 @@ void bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
       {
         for (i=0;i<astripes;i++)
         {
-          for (bp = b_entry,ap = a_entry,cp = c_entry;bp < b_end;bp++,ap++,cp++)
-            *cp = *ap & (*bp >> shift);
+          run_overlap_mask(c_entry, a_entry, b_entry, b_end - b_entry, shift, 1, 0);
           b_entry += b->h;
           b_end += b->h;
-          for (bp = b_entry,ap = a_entry,cp = c_entry;bp < b_end;bp++,ap++,cp++)
-            *cp = *ap & (*bp <<rshift);
+          run_overlap_mask(c_entry, a_entry, b_entry, b_end - b_entry, rshift, 0, 1);
           a_entry += a->h;
           c_entry += c->h;
         }
-        for (bp = b_entry,ap = a_entry,cp = c_entry;bp < b_end;bp++,ap++,cp++)
-          *cp = *ap & (*bp >> shift);
+        run_overlap_mask(c_entry, a_entry, b_entry, b_end - b_entry, shift, 1, 0);
       }
       else /* zig-zag */
       {
         for (i=0;i<bstripes;i++)
         {
-          for (bp = b_entry,ap = a_entry,cp = c_entry;bp < b_end;bp++,ap++,cp++)
-            *cp = *ap & (*bp >> shift);
+          run_overlap_mask(c_entry, a_entry, b_entry, b_end - b_entry, shift, 1, 0);
           b_entry += b->h;
           b_end += b->h;
-          for (bp = b_entry,ap = a_entry,cp = c_entry;bp < b_end;bp++,ap++,cp++)
-            *cp = *ap & (*bp << rshift);
+          run_overlap_mask(c_entry, a_entry, b_entry, b_end - b_entry, rshift, 0, 1);
           a_entry += a->h;
           c_entry += c->h;
         }
@@ -601,10 +949,7 @@ void bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
       astripes = (MIN(a->w,b->w - xoffset) - 1)/BITMASK_W_LEN + 1;
       for (i=0;i<astripes;i++)
       {
-        for (bp = b_entry,ap = a_entry,cp = c_entry;bp < b_end;bp++,ap++,cp++)
-        {
-          *cp = *ap & *bp;
-        }
+        run_overlap_mask(c_entry, a_entry, b_entry, b_end - b_entry, 0, 0, 0);
         b_entry += b->h;
         b_end += b->h;
         a_entry += a->h;
@@ -616,7 +961,7 @@ void bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
   }
   /* Zero out bits outside the mask rectangle (to the right), if there
    is a chance we were drawing there. */
-  if (xoffset + b->w > c->w)
+  if ((xoffset + b->w > c->w) && (c->w & BITMASK_W_MASK))
   {
     BITMASK_W edgemask;
     int n = c->w/BITMASK_W_LEN;
@@ -635,7 +980,8 @@ void bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
   const BITMASK_W *b_entry, *b_end, *bp;
   int shift,rshift,i,astripes,bstripes;
 
-  if ((xoffset >= a->w) || (yoffset >= a->h) || (yoffset <= - b->h))
+  if ((xoffset >= a->w) || (yoffset >= a->h) || (xoffset <= - b->w) ||
+      (yoffset <= - b->h))
       return;
 
   if (xoffset >= 0)
@@ -773,8 +1119,8 @@ void bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
     yoffset *= -1;
   }
   /* Zero out bits outside the mask rectangle (to the right), if there
-   is a chance we were drawing there. */
-  if (xoffset + b->w > a->w)
+   is a chance we were drawing there, and a has such bits. */
+  if (xoffset + b->w > a->w && a->w % BITMASK_W_LEN)
   {
     BITMASK_W edgemask;
     int n = a->w/BITMASK_W_LEN;
@@ -793,7 +1139,8 @@ void bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
   const BITMASK_W *b_entry, *b_end, *bp;
   int shift,rshift,i,astripes,bstripes;
 
-  if ((xoffset >= a->w) || (yoffset >= a->h) || (yoffset <= - b->h))
+  if ((xoffset >= a->w) || (yoffset >= a->h) || (xoffset <= - b->w) ||
+      (yoffset <= - b->h))
     return;
 
   if (xoffset >= 0)
@@ -930,10 +1277,121 @@ void bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 
 
 
+/* Scaling samples: pixel nx of the new mask is pixel nx*m->w/w of m,
+   rounded down, and the same along y.  Each row of m that is sampled is
+   scaled once into a row of words, which is then stored for every new row
+   sampling it.  A row is scaled by copying its words when the width stays,
+   through a table expanding each byte for small whole factors up, by
+   setting the new range of each set bit, or of whole words, for other
+   sizes up, and by picking the sampled bits for sizes down. */
+
+/* Set bits x0 to x1 - 1 of row, x0 < x1 */
+static INLINE void scale_set_range(BITMASK_W *row, int x0, int x1)
+{
+  int i = x0/BITMASK_W_LEN, last = (x1 - 1)/BITMASK_W_LEN;
+  BITMASK_W lo = ~(BITMASK_W)0 << (x0 & BITMASK_W_MASK);
+  BITMASK_W hi = ~(BITMASK_W)0 >> (BITMASK_W_MASK - ((x1 - 1) & BITMASK_W_MASK));
+
+  if (i == last)
+  {
+    row[i] |= lo & hi;
+    return;
+  }
+  row[i++] |= lo;
+  while (i < last)
+    row[i++] = ~(BITMASK_W)0;
+  row[last] |= hi;
+}
+
+/* The words of row y of m with the bits past m->w clear */
+static INLINE BITMASK_W scale_word(const bitmask_t *m, int c, int y)
+{
+  BITMASK_W word = m->bits[c*m->h + y];
+
+  if ((c + 1)*BITMASK_W_LEN > m->w)
+    word &= ~(BITMASK_W)0 >> (BITMASK_W_LEN - 1 - ((m->w - 1) & BITMASK_W_MASK));
+  return word;
+}
+
+/* Row y of m scaled up by a whole factor, with lut the bits of each byte
+   repeated factor times.  row has n words. */
+static void scale_row_lut(const bitmask_t *m, int y, int factor,
+                          const BITMASK_W *lut, BITMASK_W *row, int n)
+{
+  int c, b, x;
+  BITMASK_W word, bits;
+
+  for (c = 0; c*BITMASK_W_LEN < m->w; c++)
+  {
+    word = scale_word(m, c, y);
+    for (b = 0; word; b += 8, word >>= 8)
+    {
+      bits = lut[word & 0xff];
+      if (!bits)
+        continue;
+      x = (c*BITMASK_W_LEN + b)*factor;
+      row[x/BITMASK_W_LEN] |= bits << (x & BITMASK_W_MASK);
+      if ((x & BITMASK_W_MASK) + 8*factor > BITMASK_W_LEN &&
+          x/BITMASK_W_LEN + 1 < n)
+        row[x/BITMASK_W_LEN + 1] |= bits >> (BITMASK_W_LEN - (x & BITMASK_W_MASK));
+    }
+  }
+}
+
+/* Row y of m scaled up, with starts[x] the first new pixel of pixel x.
+   Words of m that are all set or all clear become one range of the new
+   row, and the set bits of the others a range each. */
+static void scale_row_runs(const bitmask_t *m, int y, const int *starts,
+                           BITMASK_W *row)
+{
+  int c, x0, x1, x;
+  BITMASK_W word, full;
+
+  for (c = 0; c*BITMASK_W_LEN < m->w; c++)
+  {
+    word = scale_word(m, c, y);
+    if (!word)
+      continue;
+    x0 = c*BITMASK_W_LEN;
+    x1 = x0 + BITMASK_W_LEN < m->w ? x0 + BITMASK_W_LEN : m->w;
+    full = ~(BITMASK_W)0 >> (BITMASK_W_LEN - (x1 - x0));
+    if (word == full)
+    {
+      scale_set_range(row, starts[x0], starts[x1]);
+      continue;
+    }
+    while (word)
+    {
+      x = x0 + firstsetbit(word);
+      word &= word - 1;
+      if (starts[x] < starts[x + 1])
+        scale_set_range(row, starts[x], starts[x + 1]);
+    }
+  }
+}
+
+/* Row y of m scaled down to w, with xs[nx] the pixel new pixel nx is */
+static void scale_row_pick(const bitmask_t *m, int y, int w, const int *xs,
+                           BITMASK_W *row)
+{
+  const BITMASK_W *bits = m->bits + y;
+  int nx, x;
+
+  for (nx = 0; nx < w; nx++)
+  {
+    x = xs[nx];
+    if ((bits[x/BITMASK_W_LEN*m->h] >> (x & BITMASK_W_MASK)) & 1)
+      row[nx/BITMASK_W_LEN] |= BITMASK_N(nx & BITMASK_W_MASK);
+  }
+}
+
 bitmask_t *bitmask_scale(const bitmask_t *m, int w, int h)
 {
   bitmask_t *nm;
-  int x,y,nx,ny,dx,dy,dnx,dny;
+  BITMASK_W *row;
+  BITMASK_W lut[256];
+  int *xs = NULL;
+  int x,y,nx,ny,dx,dy,dnx,dny,c,n,factor = 0,scaled;
 
   if (w < 1 || h < 1)
   {
@@ -944,47 +1402,517 @@ bitmask_t *bitmask_scale(const bitmask_t *m, int w, int h)
   nm = bitmask_create(w,h);
   if (!nm)
     return NULL;
+  n = (w - 1)/BITMASK_W_LEN + 1;
+  if (w > m->w && !(w % m->w) && 8*(w/m->w) <= (int)BITMASK_W_LEN)
+    factor = w/m->w;
+  row = malloc(n*sizeof(BITMASK_W));
+  if (w != m->w && !factor)
+    xs = malloc((w > m->w ? m->w + 1 : w)*sizeof(int));
+  if (!row || (w != m->w && !factor && !xs))
+  {
+    free(row);
+    free(xs);
+    bitmask_free(nm);
+    return NULL;
+  }
+
+  if (xs)
+  {
+    /* the same steps as along y below */
+    nx = dnx = 0;
+    for (x=0,dx=w; x < m->w; x++, dx+=w)
+    {
+      if (w > m->w)
+        xs[x] = nx;
+      while (dnx < dx)
+      {
+        if (w < m->w)
+          xs[nx] = x;
+        nx++;
+        dnx += m->w;
+      }
+    }
+    if (w > m->w)
+      xs[m->w] = nx;
+  }
+  else if (factor)
+  {
+    for (x = 0; x < 256; x++)
+    {
+      lut[x] = 0;
+      for (c = 0; c < 8; c++)
+        if (x & (1 << c))
+          lut[x] |= (BITMASK_N(factor) - 1) << (c*factor);
+    }
+  }
+
   ny = dny = 0;
   for (y=0,dy=h; y<m->h; y++,dy+=h)
   {
+    scaled = 0;
     while (dny < dy)
     {
-      nx = dnx = 0;
-      for (x=0,dx=w; x < m->w; x++, dx+=w)
+      if (!scaled)
       {
-        if (bitmask_getbit(m,x,y))
-        {
-          while (dnx < dx)
-          {
-            bitmask_setbit(nm,nx,ny);
-            nx++;
-            dnx += m->w;
-          }
-        }
+        memset(row, 0, n*sizeof(BITMASK_W));
+        if (w == m->w)
+          for (c = 0; c < n; c++)
+            row[c] = scale_word(m, c, y);
+        else if (factor)
+          scale_row_lut(m, y, factor, lut, row, n);
+        else if (w > m->w)
+          scale_row_runs(m, y, xs, row);
         else
-        {
-          while (dnx < dx)
-          {
-            nx++;
-            dnx += m->w;
-          }
-        }
+          scale_row_pick(m, y, w, xs, row);
+        scaled = 1;
       }
+      for (c = 0; c < n; c++)
+        nm->bits[c*h + ny] = row[c];
       ny++;
       dny+=m->h;
     }
   }
+  free(row);
+  free(xs);
   return nm;
 }
 
+/* Convolution draws a into o once for each set bit of b.  The rows of b
+   are taken in groups of equal rows one after another.  For a group,
+   instead of drawing a for each bit, a may be drawn once for each run of
+   set bits in the row, into a mask over the part of o the group can reach,
+   which is widened to the length of the run by drawing it onto itself
+   shifted 1, 2, 4... pixels.  The runs together are then lengthened to the
+   rows of the group the same way, and drawn into o.  That is about
+   4*log2(k) draws for a k*k square instead of k*k, so it is used when it
+   costs fewer words, by the count below.  Anything outside o costs
+   nothing either way. */
+
+/* Widen (dx 1) or lengthen (dy 1) the set bits of m to n pixels, right or
+   down, through copy, a mask of the same size. */
+static void convolve_spread(bitmask_t *m, bitmask_t *copy, int n, int dx,
+                            int dy)
+{
+  size_t size = m->h*((m->w - 1)/BITMASK_W_LEN + 1)*sizeof(BITMASK_W);
+  int done = 1, step;
+
+  while (done < n)
+  {
+    step = done < n - done ? done : n - done;
+    memcpy(copy->bits, m->bits, size);
+    bitmask_draw(m, copy, step*dx, step*dy);
+    done += step;
+  }
+}
+
+/* The number of draws convolve_spread() does for n pixels */
+static int convolve_steps(int n)
+{
+  int steps = 0, done = 1;
+
+  for (; done < n; steps++)
+    done += done < n - done ? done : n - done;
+  return steps;
+}
+
+static double convolve_words(int w, int h)
+{
+  return (double)h*((w - 1)/BITMASK_W_LEN + 1);
+}
+
+/* Draw a for the group of the rows y to y + rows - 1 of b, all equal, by
+   spreading runs.  Returns 0 if that costs more than drawing a for each
+   bit, or if out of memory, with o untouched. */
+static int convolve_group(const bitmask_t *a, const bitmask_t *b,
+                          bitmask_t *o, int y, int rows, int xoffset,
+                          int yoffset)
+{
+  bitmask_t *sum = NULL, *run = NULL, *copy = NULL, *to;
+  double cost, direct, frame;
+  int x, k0, runs = 0, bits = 0, longest = 1, fx, fy, done = 0;
+
+  for (x = 0; x < b->w; x++)
+  {
+    if (!bitmask_getbit(b, x, y))
+      continue;
+    for (k0 = x; x < b->w && bitmask_getbit(b, x, y); x++)
+      ;
+    runs++;
+    bits += x - k0;
+    if (x - k0 > longest)
+      longest = x - k0;
+  }
+  if (!bits)
+    return 1;
+
+  /* the frame: o with room to the left and above for the bits spreading
+     into it */
+  fx = 1 - longest;
+  fy = 1 - rows;
+  frame = convolve_words(o->w - fx, o->h - fy);
+  direct = (double)bits*rows*convolve_words(a->w, a->h);
+  cost = frame*(3 + 2*convolve_steps(rows)) + runs*convolve_words(a->w, a->h);
+  for (x = 0; x < b->w; x++)
+  {
+    if (!bitmask_getbit(b, x, y))
+      continue;
+    for (k0 = x; x < b->w && bitmask_getbit(b, x, y); x++)
+      ;
+    cost += frame*(2*convolve_steps(x - k0) + (runs > 1 ? 2 : 0));
+  }
+  if (cost >= direct)
+    return 0;
+
+  sum = bitmask_create(o->w - fx, o->h - fy);
+  copy = bitmask_create(o->w - fx, o->h - fy);
+  if (runs > 1)
+    run = bitmask_create(o->w - fx, o->h - fy);
+  if (sum && copy && (runs == 1 || run))
+  {
+    /* kernel bit (x, y) draws a at (xoffset - x, yoffset - y), so the run
+       and rows start from their last bit and spread right and down */
+    to = runs > 1 ? run : sum;
+    for (x = 0; x < b->w; x++)
+    {
+      if (!bitmask_getbit(b, x, y))
+        continue;
+      for (k0 = x; x < b->w && bitmask_getbit(b, x, y); x++)
+        ;
+      if (runs > 1)
+        bitmask_clear(run);
+      bitmask_draw(to, a, xoffset - (x - 1) - fx,
+                   yoffset - (y + rows - 1) - fy);
+      convolve_spread(to, copy, x - k0, 1, 0);
+      if (runs > 1)
+        bitmask_draw(sum, run, 0, 0);
+    }
+    convolve_spread(sum, copy, rows, 0, 1);
+    bitmask_draw(o, sum, fx, fy);
+    done = 1;
+  }
+  if (sum)
+    bitmask_free(sum);
+  if (run)
+    bitmask_free(run);
+  if (copy)
+    bitmask_free(copy);
+  return done;
+}
+
+static int convolve_rows_equal(const bitmask_t *b, int y0, int y1)
+{
+  const BITMASK_W *bits;
+
+  for (bits = b->bits; bits < b->bits + b->h*((b->w - 1)/BITMASK_W_LEN + 1);
+       bits += b->h)
+    if (bits[y0] != bits[y1])
+      return 0;
+  return 1;
+}
+
 void bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *o, int xoffset, int yoffset)
 {
-  int x, y;
+  int x, y, y1, rows;
 
   xoffset += b->w - 1;
   yoffset += b->h - 1;
-  for (y = 0; y < b->h; y++)
-    for (x = 0; x < b->w; x++)
-      if (bitmask_getbit(b, x, y))
-        bitmask_draw(o, a, xoffset - x, yoffset - y);
+  for (y = 0; y < b->h; y = y1)
+  {
+    for (y1 = y + 1; y1 < b->h && convolve_rows_equal(b, y, y1); y1++)
+      ;
+    if (convolve_group(a, b, o, y, y1 - y, xoffset, yoffset))
+      continue;
+    for (rows = y; rows < y1; rows++)
+      for (x = 0; x < b->w; x++)
+        if (bitmask_getbit(b, x, rows))
+          bitmask_draw(o, a, xoffset - x, yoffset - rows);
+  }
+}
+
+/* The morphological operations work on whole words.  Along a row a pixel's
+   neighbours are the bits of its word shifted, and of the next words of the
+   row, which are m->h words apart.  Pixels outside the mask change nothing:
+   they count as clear when dilating and as set when eroding. */
+
+/* The word at stripe q of a row, of n stripes, or outside for stripes past
+   the ends.  edge is or'ed into the last stripe, for the bits past the
+   width. */
+#define MORPH_STRIPE(row, h, n, q, outside, edge) \
+  ((q) < 0 || (q) >= (n) ? (outside) : \
+   (row)[(q)*(h)] | ((q) == (n) - 1 ? (edge) : 0))
+
+/* The word at stripe i of a row, moved so that bit j holds the pixel d to
+   the right of bit j of the stripe (to the left when d is negative). */
+static INLINE BITMASK_W morph_word(const BITMASK_W *row, int h, int n,
+                                   int i, int d, BITMASK_W outside,
+                                   BITMASK_W edge)
+{
+  BITMASK_W lo, hi;
+  int q, b;
+
+  if (d >= 0)
+  {
+    q = i + d / BITMASK_W_LEN;
+    b = d % BITMASK_W_LEN;
+    lo = MORPH_STRIPE(row, h, n, q, outside, edge);
+    if (!b)
+      return lo;
+    hi = MORPH_STRIPE(row, h, n, q + 1, outside, edge);
+    return (lo >> b) | (hi << (BITMASK_W_LEN - b));
+  }
+  d = -d;
+  q = i - d / BITMASK_W_LEN;
+  b = d % BITMASK_W_LEN;
+  hi = MORPH_STRIPE(row, h, n, q, outside, edge);
+  if (!b)
+    return hi;
+  lo = MORPH_STRIPE(row, h, n, q - 1, outside, edge);
+  return (hi << b) | (lo >> (BITMASK_W_LEN - b));
+}
+
+/* the bits past the width in the last stripe of m */
+static BITMASK_W morph_edge(const bitmask_t *m)
+{
+  if (!(m->w % BITMASK_W_LEN))
+    return 0;
+  return (~(BITMASK_W)0) << (m->w % BITMASK_W_LEN);
+}
+
+/* The and (or the or) of the pixels 1 to radius to the right of each bit
+   of lo, with hi the next word of the row, for a radius below
+   BITMASK_W_LEN. */
+static INLINE BITMASK_W morph_right(BITMASK_W lo, BITMASK_W hi, int radius,
+                                    int erode)
+{
+  BITMASK_W w = erode ? ~(BITMASK_W)0 : 0;
+  int s;
+
+  if (erode)
+    for (s = 1; s <= radius; s++)
+      w &= (lo >> s) | (hi << (BITMASK_W_LEN - s));
+  else
+    for (s = 1; s <= radius; s++)
+      w |= (lo >> s) | (hi << (BITMASK_W_LEN - s));
+  return w;
+}
+
+/* the same to the left of each bit of hi, with lo the word before it */
+static INLINE BITMASK_W morph_left(BITMASK_W lo, BITMASK_W hi, int radius,
+                                   int erode)
+{
+  BITMASK_W w = erode ? ~(BITMASK_W)0 : 0;
+  int s;
+
+  if (erode)
+    for (s = 1; s <= radius; s++)
+      w &= (hi << s) | (lo >> (BITMASK_W_LEN - s));
+  else
+    for (s = 1; s <= radius; s++)
+      w |= (hi << s) | (lo >> (BITMASK_W_LEN - s));
+  return w;
+}
+
+/* Dilate (or erode) the rows of m in place by the radius.  A window of
+   pixels x to x + radius is done going right, as those words are not written
+   yet, then x - radius to x of that going left, for the whole window.  The
+   rows of each stripe are done together, as they are consecutive words. */
+static void morph_rows(bitmask_t *m, int radius, int erode)
+{
+  BITMASK_W w, *row, *col, outside, edge, e, ne;
+  int i, y, s, n = (m->w - 1)/BITMASK_W_LEN + 1;
+
+  outside = erode ? ~(BITMASK_W)0 : 0;
+  edge = erode ? morph_edge(m) : 0;
+
+  if (radius < (int)BITMASK_W_LEN)
+  {
+    /* the pixels of a window are in the stripe and the one next to it */
+    for (i = 0; i < n; i++)
+    {
+      col = m->bits + i*m->h;
+      e = i == n - 1 ? edge : 0;
+      ne = i + 1 == n - 1 ? edge : 0;
+      for (y = 0; y < m->h; y++)
+      {
+        w = morph_right(col[y] | e, i + 1 < n ? col[y + m->h] | ne : outside,
+                        radius, erode);
+        col[y] = erode ? col[y] & w : col[y] | w;
+      }
+    }
+    for (i = n - 1; i >= 0; i--)
+    {
+      col = m->bits + i*m->h;
+      e = i == n - 1 ? edge : 0;
+      for (y = 0; y < m->h; y++)
+      {
+        w = morph_left(i > 0 ? col[y - m->h] : outside, col[y] | e,
+                       radius, erode);
+        col[y] = erode ? col[y] & w : col[y] | w;
+      }
+    }
+    return;
+  }
+
+  for (i = 0; i < n; i++)
+  {
+    for (y = 0, row = m->bits; y < m->h; y++, row++)
+    {
+      w = row[i*m->h];
+      for (s = 1; s <= radius; s++)
+      {
+        if (erode)
+          w &= morph_word(row, m->h, n, i, s, outside, edge);
+        else
+          w |= morph_word(row, m->h, n, i, s, outside, edge);
+      }
+      row[i*m->h] = w;
+    }
+  }
+  for (i = n - 1; i >= 0; i--)
+  {
+    for (y = 0, row = m->bits; y < m->h; y++, row++)
+    {
+      w = row[i*m->h];
+      for (s = 1; s <= radius; s++)
+      {
+        if (erode)
+          w &= morph_word(row, m->h, n, i, -s, outside, edge);
+        else
+          w |= morph_word(row, m->h, n, i, -s, outside, edge);
+      }
+      row[i*m->h] = w;
+    }
+  }
+}
+
+/* Dilate (or erode) the columns of m in place by the radius, going down
+   then up the same way as morph_rows.  Each stripe of words is done on its
+   own, as its rows are consecutive words. */
+static void morph_columns(bitmask_t *m, int radius, int erode)
+{
+  BITMASK_W w, *col;
+  int i, y, s, n = (m->w - 1)/BITMASK_W_LEN + 1;
+
+  for (i = 0; i < n; i++)
+  {
+    col = m->bits + i*m->h;
+    for (y = 0; y < m->h; y++)
+    {
+      w = col[y];
+      for (s = 1; s <= radius && y + s < m->h; s++)
+      {
+        if (erode)
+          w &= col[y + s];
+        else
+          w |= col[y + s];
+      }
+      col[y] = w;
+    }
+    for (y = m->h - 1; y >= 0; y--)
+    {
+      w = col[y];
+      for (s = 1; s <= radius && y - s >= 0; s++)
+      {
+        if (erode)
+          w &= col[y - s];
+        else
+          w |= col[y - s];
+      }
+      col[y] = w;
+    }
+  }
+}
+
+/* o = the dilation (or erosion) of a by a cross of the radius.  Both arms
+   are read from a, so o must not be a. */
+static void morph_cross(const bitmask_t *a, bitmask_t *o, int radius,
+                        int erode)
+{
+  BITMASK_W w, v, v2, lo, hi, outside, edge, e, ne;
+  const BITMASK_W *row, *col;
+  int i, y, s, n = (a->w - 1)/BITMASK_W_LEN + 1;
+
+  outside = erode ? ~(BITMASK_W)0 : 0;
+  edge = erode ? morph_edge(a) : 0;
+  for (i = 0; i < n; i++)
+  {
+    col = a->bits + i*a->h;
+    e = i == n - 1 ? edge : 0;
+    ne = i + 1 == n - 1 ? edge : 0;
+    for (y = 0; y < a->h; y++)
+    {
+      row = a->bits + y;
+      w = col[y];
+      if (radius < (int)BITMASK_W_LEN)
+      {
+        lo = i > 0 ? col[y - a->h] : outside;
+        hi = i + 1 < n ? col[y + a->h] | ne : outside;
+        v = morph_right(col[y] | e, hi, radius, erode);
+        v2 = morph_left(lo, col[y] | e, radius, erode);
+        w = erode ? w & v & v2 : w | v | v2;
+      }
+      else
+      {
+        for (s = 1; s <= radius; s++)
+        {
+          if (erode)
+            w &= morph_word(row, a->h, n, i, s, outside, edge) &
+                 morph_word(row, a->h, n, i, -s, outside, edge);
+          else
+            w |= morph_word(row, a->h, n, i, s, outside, edge) |
+                 morph_word(row, a->h, n, i, -s, outside, edge);
+        }
+      }
+      for (s = 1; s <= radius; s++)
+      {
+        if (erode)
+          w &= (y + s < a->h ? col[y + s] : outside) &
+               (y - s >= 0 ? col[y - s] : outside);
+        else
+          w |= (y + s < a->h ? col[y + s] : outside) |
+               (y - s >= 0 ? col[y - s] : outside);
+      }
+      o->bits[i*o->h + y] = w;
+    }
+  }
+}
+
+static void morph(const bitmask_t *a, bitmask_t *o, int radius, int cross,
+                  int erode)
+{
+  BITMASK_W *pixels, *end, edge;
+
+  if (radius < 0)
+    radius = 0;
+  if (cross && radius)
+  {
+    morph_cross(a, o, radius, erode);
+  }
+  else
+  {
+    if (o != a)
+      memcpy(o->bits, a->bits,
+             a->h*((a->w - 1)/BITMASK_W_LEN + 1)*sizeof(BITMASK_W));
+    morph_rows(o, radius, erode);
+    morph_columns(o, radius, erode);
+  }
+
+  /* clear the bits past the width, which dilating may set */
+  edge = morph_edge(o);
+  if (edge)
+  {
+    end = o->bits + o->h*((o->w - 1)/BITMASK_W_LEN + 1);
+    for (pixels = end - o->h; pixels < end; pixels++)
+      *pixels &= ~edge;
+  }
+}
+
+void bitmask_dilate(const bitmask_t *a, bitmask_t *o, int radius, int cross)
+{
+  morph(a, o, radius, cross, 0);
+}
+
+void bitmask_erode(const bitmask_t *a, bitmask_t *o, int radius, int cross)
+{
+  morph(a, o, radius, cross, 1);
 }
@@ -42,10 +42,22 @@ extern "C" {
 # endif
 #endif
 
+/* The word type. Words are 64 bits on every 64-bit target, including
+   64-bit Windows where unsigned long is only 32 bits, and BITMASK_W_64 is
+   defined then. */
+#if defined(_WIN64)
+#define BITMASK_W unsigned long long
+#define BITMASK_W_64
+#else
 #define BITMASK_W unsigned long int
+#if ULONG_MAX > 0xFFFFFFFFUL
+#define BITMASK_W_64
+#endif
+#endif
 #define BITMASK_W_LEN (sizeof(BITMASK_W)*CHAR_BIT)
 #define BITMASK_W_MASK (BITMASK_W_LEN - 1)
 #define BITMASK_N(n) ((BITMASK_W)1 << (n))
+#define BITMASK_BLOCK_H BITMASK_W_LEN
 
 typedef struct bitmask
 {
@@ -74,6 +86,18 @@ void bitmask_invert(bitmask_t *m);
 /* Counts the bits in the mask */
 unsigned int bitmask_count(bitmask_t *m);
 
+/* The raw moments of set bits: their count m00, the sums of their x and y
+   m10 and m01, and the sums of x*y, x*x and y*y m11, m20 and m02. */
+typedef struct
+{
+  long long m00, m10, m01, m11, m20, m02;
+} bitmask_moments_t;
+
+/* Adds the moments of the set bits of m in the rectangle at (x,y) of
+   size w*h, clipped to m, times sign to moments. */
+void bitmask_moments(const bitmask_t *m, int x, int y, int w, int h,
+                     bitmask_moments_t *moments, int sign);
+
 /* Returns nonzero if the bit at (x,y) is set.  Coordinates start at
    (0,0) */
 static INLINE int bitmask_getbit(const bitmask_t *m, int x, int y)
@@ -118,6 +142,25 @@ int bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset, in
 /* Fills a mask with the overlap of two other masks. A bitwise AND. */
 void bitmask_overlap_mask (const bitmask_t *a, const bitmask_t *b, bitmask_t *c, int xoffset, int yoffset);
 
+/* A block map of a mask has one bit for each block of BITMASK_W_LEN by
+   BITMASK_BLOCK_H pixels of it, which is set if any bit in the block is.
+   bitmask_blocks_create() returns the map of m, or NULL if out of memory.
+   bitmask_blocks_update() must be called for the rectangle of m which was
+   changed, to keep the map in step. */
+bitmask_t *bitmask_blocks_create(const bitmask_t *m);
+void bitmask_blocks_update(bitmask_t *blocks, const bitmask_t *m,
+                           int x, int y, int w, int h);
+
+/* Like bitmask_overlap() and bitmask_overlap_area(), but the rows of
+   blocks which are clear in the block map of a or of b are skipped.
+   Either map may be NULL. */
+int bitmask_overlap_blocks(const bitmask_t *a, const bitmask_t *ablocks,
+                           const bitmask_t *b, const bitmask_t *bblocks,
+                           int xoffset, int yoffset);
+int bitmask_overlap_area_blocks(const bitmask_t *a, const bitmask_t *ablocks,
+                                const bitmask_t *b, const bitmask_t *bblocks,
+                                int xoffset, int yoffset);
+
 /* Draws mask b onto mask a (bitwise OR). Can be used to compose large
    (game background?) mask from several submasks, which may speed up
    the testing. */
@@ -128,7 +171,8 @@ void bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset);
 
 /* Return a new scaled bitmask, with dimensions w*h. The quality of the
    scaling may not be perfect for all circumstances, but it should
-   be reasonable. If either w or h is 0 a clear 1x1 mask is returned. */
+   be reasonable. If either w or h is 0 a clear 1x1 mask is returned.
+   Returns NULL if out of memory. */
 bitmask_t *bitmask_scale(const bitmask_t *m, int w, int h);
 
 /* Convolve b into a, drawing the output into o, shifted by offset.  If offset
@@ -136,9 +180,20 @@ bitmask_t *bitmask_scale(const bitmask_t *m, int w, int h);
  * bitmask_overlap(a, b, x - b->w - 1, y - b->h - 1) returns true.
  *
  * Modifies bits o[xoffset ... xoffset + a->w + b->w - 1)
- *                [yoffset ... yoffset + a->h + b->h - 1). */
+ *                [yoffset ... yoffset + a->h + b->h - 1).
+ *
+ * Only the bits inside o are worked out, so a small o at an offset costs
+ * less than the whole convolution. */
 void bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *o, int xoffset, int yoffset);
 
+/* Dilate (set each bit near a set bit) or erode (keep each bit with only
+   set bits near it) a into o, which must be the same size.  Near means
+   within radius along x and y, in a square, or in a cross if cross is
+   nonzero.  Bits outside the mask change nothing: they count as clear for
+   dilation and set for erosion.  o may be a, unless cross is nonzero. */
+void bitmask_dilate(const bitmask_t *a, bitmask_t *o, int radius, int cross);
+void bitmask_erode(const bitmask_t *a, bitmask_t *o, int radius, int cross);
+
 #ifdef __cplusplus
 } /* End of extern "C" { */
 #endif
@@ -33,6 +33,8 @@
     #include <sys/stat.h>
     #include <sys/types.h>
     #include <sys/time.h>
+    #include <sys/select.h>
+    #include <poll.h>
     #include <sys/mman.h>
     #include <sys/ioctl.h>
 
@@ -66,6 +68,12 @@
 #ifndef V4L2_PIX_FMT_YUYV
     #define V4L2_PIX_FMT_YUYV 'YUYV'
 #endif
+#ifndef V4L2_PIX_FMT_MJPEG
+    #define V4L2_PIX_FMT_MJPEG 'MJPG'
+#endif
+#ifndef V4L2_PIX_FMT_JPEG
+    #define V4L2_PIX_FMT_JPEG 'JPEG'
+#endif
 
 #define CLEAR(x) memset (&(x), 0, sizeof (x))
 #define SAT(c) if (c & (~255)) { if (c < 0) c = 0; else c = 255; }
@@ -84,6 +92,10 @@ struct buffer {
 };
 
 #if defined(__unix__)
+/* surfaces a capture thread cycles through: one written, one ready, and
+   one being read */
+#define CAMERA_THREAD_FRAMES 3
+
 typedef struct PyCameraObject {
     PyObject_HEAD
     char* device_name;
@@ -99,6 +111,37 @@ typedef struct PyCameraObject {
     int vflip;
     int brightness;
     int fd;
+    /* for start(threaded=True); capture_lock holds all below it */
+    SDL_Thread* capture_thread;
+    SDL_mutex* capture_lock;
+    SDL_cond* capture_cond;     /* signalled for each frame, and errors */
+    SDL_Surface* frames[CAMERA_THREAD_FRAMES];
+    int frame_back;             /* being converted into by the thread */
+    int frame_ready;            /* the newest finished frame */
+    int frame_front;            /* the frame get_image copies from */
+    int frame_fresh;            /* frame_ready not yet taken */
+    int capture_quit;
+    unsigned long frames_captured;
+    unsigned long frames_dropped;   /* replaced before get_image took them */
+    unsigned long frames_repeated;  /* get_image with no new frame */
+    char capture_error[256];
+    /* for get_frame_view; the dequeued buffer the views read */
+    int view_index;             /* -1 if none is held */
+    size_t view_length;         /* bytes of it the driver filled */
+    double view_timestamp;      /* when it was captured, in seconds */
+    int frame_views;            /* views exported and not yet released */
+    /* pixelformat and frame rate asked for, 0 to let start() choose */
+    unsigned long request_format;
+    int request_fps;
+    int fps_num;                /* frame period the driver agreed to, in */
+    int fps_den;                /* seconds, or 0/0 if it did not say */
+    /* for MJPEG: a turbojpeg decompressor, the size frames come in at,
+       before decoding at a reduced scale, and rgb for surfaces which
+       turbojpeg cannot decode into */
+    void* jpeg;
+    int jpeg_width;
+    int jpeg_height;
+    Uint8* jpeg_rgb;
 } PyCameraObject;
 #elif defined(PYGAME_MAC_CAMERA_OLD)
 typedef struct PyCameraObject {
@@ -168,6 +211,16 @@ int v4l2_process_image (PyCameraObject* self, const void *image,
                                unsigned int buffer_size, SDL_Surface* surf);
 int v4l2_query_buffer (PyCameraObject* self);
 int v4l2_read_frame (PyCameraObject* self, SDL_Surface* surf);
+int v4l2_start_thread (PyCameraObject* self);
+void v4l2_stop_thread (PyCameraObject* self);
+int v4l2_take_frame (PyCameraObject* self, SDL_Surface* surf);
+int v4l2_hold_frame (PyCameraObject* self);
+int v4l2_release_frame (PyCameraObject* self);
+int v4l2_capture_set (PyCameraObject** cameras, int count, double timeout,
+                      double max_skew, char* error, size_t size);
+int v4l2_query_thread (PyCameraObject* self);
+PyObject* v4l2_list_formats (PyCameraObject* self);
+PyObject* v4l2_fourcc_string (unsigned long pixelformat);
 int v4l2_stop_capturing (PyCameraObject* self);
 int v4l2_start_capturing (PyCameraObject* self);
 int v4l2_uninit_device (PyCameraObject* self);
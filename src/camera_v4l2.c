@@ -25,6 +25,195 @@
 int v4l2_pixelformat (int fd, struct v4l2_format* fmt,
                              unsigned long pixelformat);
 
+/* MJPEG frames are decoded by libturbojpeg, which is loaded the first time
+   a camera needs it, so the module builds and imports without it. These
+   are the parts of turbojpeg.h used. */
+#define PG_TJPF_RGB 0
+#define PG_TJPF_BGR 1
+#define PG_TJPF_RGBX 2
+#define PG_TJPF_BGRX 3
+#define PG_TJPF_XBGR 4
+#define PG_TJPF_XRGB 5
+#define PG_TJFLAG_FASTUPSAMPLE 256
+#define PG_TJFLAG_FASTDCT 2048
+
+typedef void* (*TJ_tjInitDecompress_Func) (void);
+typedef int (*TJ_tjDecompress2_Func) (void*, const unsigned char*,
+                                      unsigned long, unsigned char*, int,
+                                      int, int, int, int);
+typedef int (*TJ_tjDestroy_Func) (void*);
+typedef char* (*TJ_tjGetErrorStr_Func) (void);
+
+static struct {
+    int tried;
+    void* lib;
+    TJ_tjInitDecompress_Func tjInitDecompress;
+    TJ_tjDecompress2_Func tjDecompress2;
+    TJ_tjDestroy_Func tjDestroy;
+    TJ_tjGetErrorStr_Func tjGetErrorStr;
+} turbojpeg;
+
+/* returns 1 if libturbojpeg could be loaded */
+static int v4l2_load_turbojpeg (void)
+{
+    static const char* names[] = {"libturbojpeg.so.0", "libturbojpeg.so",
+                                  NULL};
+    int i;
+
+    if (turbojpeg.tried)
+        return turbojpeg.lib != NULL;
+    turbojpeg.tried = 1;
+
+    for (i = 0; names[i] && !turbojpeg.lib; i++)
+        turbojpeg.lib = SDL_LoadObject (names[i]);
+    if (!turbojpeg.lib)
+        return 0;
+
+#define TJ_LOAD(name) \
+    turbojpeg.name = (TJ_##name##_Func) SDL_LoadFunction (turbojpeg.lib, \
+                                                          #name)
+    TJ_LOAD (tjInitDecompress);
+    TJ_LOAD (tjDecompress2);
+    TJ_LOAD (tjDestroy);
+    TJ_LOAD (tjGetErrorStr);
+#undef TJ_LOAD
+    if (!turbojpeg.tjInitDecompress || !turbojpeg.tjDecompress2 ||
+        !turbojpeg.tjDestroy || !turbojpeg.tjGetErrorStr) {
+        SDL_UnloadObject (turbojpeg.lib);
+        turbojpeg.lib = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/* the turbojpeg pixel format writing straight into surfaces of format, or
+   -1 if there is none */
+static int v4l2_jpeg_pixelformat (SDL_PixelFormat* format)
+{
+    int bpp = format->BytesPerPixel;
+    int roff, goff, boff;
+
+    if ((bpp != 3 && bpp != 4) || format->Rloss || format->Gloss ||
+        format->Bloss || format->Rshift % 8 || format->Gshift % 8 ||
+        format->Bshift % 8)
+        return -1;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    roff = format->Rshift / 8;
+    goff = format->Gshift / 8;
+    boff = format->Bshift / 8;
+#else
+    roff = bpp - 1 - format->Rshift / 8;
+    goff = bpp - 1 - format->Gshift / 8;
+    boff = bpp - 1 - format->Bshift / 8;
+#endif
+    if (roff == 0 && goff == 1 && boff == 2)
+        return bpp == 3 ? PG_TJPF_RGB : PG_TJPF_RGBX;
+    if (roff == 2 && goff == 1 && boff == 0)
+        return bpp == 3 ? PG_TJPF_BGR : PG_TJPF_BGRX;
+    if (bpp == 4 && roff == 3 && goff == 2 && boff == 1)
+        return PG_TJPF_XBGR;
+    if (bpp == 4 && roff == 1 && goff == 2 && boff == 3)
+        return PG_TJPF_XRGB;
+    return -1;
+}
+
+/* decodes a JPEG frame to rgb in surf, at the camera's width and height */
+static int v4l2_decode_jpeg (PyCameraObject* self, const void *image,
+                             unsigned int buffer_size, SDL_Surface* surf)
+{
+    int pixelformat = v4l2_jpeg_pixelformat (surf->format);
+    int flags = PG_TJFLAG_FASTDCT | PG_TJFLAG_FASTUPSAMPLE;
+
+    if (pixelformat != -1)
+        return turbojpeg.tjDecompress2 (self->jpeg, image, buffer_size,
+                                        surf->pixels, self->width,
+                                        surf->pitch, self->height,
+                                        pixelformat, flags) != -1;
+
+    if (turbojpeg.tjDecompress2 (self->jpeg, image, buffer_size,
+                                 self->jpeg_rgb, self->width,
+                                 self->width * 3, self->height,
+                                 PG_TJPF_RGB, flags) == -1)
+        return 0;
+    rgb24_to_rgb (self->jpeg_rgb, surf->pixels, self->size, surf->format);
+    return 1;
+}
+
+/* returns 1 if v4l2_process_image can convert pixelformat */
+static int v4l2_known_pixelformat (unsigned long pixelformat)
+{
+    switch (pixelformat) {
+        case V4L2_PIX_FMT_RGB24:
+        case V4L2_PIX_FMT_RGB444:
+        case V4L2_PIX_FMT_YUYV:
+        case V4L2_PIX_FMT_SBGGR8:
+        case V4L2_PIX_FMT_YUV420:
+            return 1;
+        case V4L2_PIX_FMT_MJPEG:
+        case V4L2_PIX_FMT_JPEG:
+            return v4l2_load_turbojpeg ();
+    }
+    return 0;
+}
+
+/* sets up MJPEG decoding, at the smallest of the turbojpeg scales 1/2, 1/4
+   and 1/8 still as big as the size asked for, when the driver sends bigger
+   frames */
+static int v4l2_init_jpeg (PyCameraObject* self, int width, int height)
+{
+    int denom = 8;
+
+    while (denom > 1 && ((self->jpeg_width + denom - 1) / denom < width ||
+                         (self->jpeg_height + denom - 1) / denom < height))
+        denom /= 2;
+    self->width = (self->jpeg_width + denom - 1) / denom;
+    self->height = (self->jpeg_height + denom - 1) / denom;
+    self->size = self->width * self->height;
+
+    self->jpeg = turbojpeg.tjInitDecompress ();
+    if (!self->jpeg) {
+        PyErr_Format(PyExc_SystemError, "tjInitDecompress failure: %s",
+                     turbojpeg.tjGetErrorStr ());
+        return 0;
+    }
+    self->jpeg_rgb = (Uint8*) malloc (self->size * 3);
+    if (!self->jpeg_rgb) {
+        turbojpeg.tjDestroy (self->jpeg);
+        self->jpeg = NULL;
+        PyErr_NoMemory ();
+        return 0;
+    }
+    return 1;
+}
+
+/* asks for request_fps frames a second, then reads back what the driver
+   settled on */
+static void v4l2_init_fps (PyCameraObject* self)
+{
+    struct v4l2_streamparm parm;
+
+    self->fps_num = 0;
+    self->fps_den = 0;
+
+    CLEAR (parm);
+    parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (-1 == v4l2_xioctl (self->fd, VIDIOC_G_PARM, &parm))
+        return;
+    if (self->request_fps > 0 &&
+        (parm.parm.capture.capability & V4L2_CAP_TIMEPERFRAME)) {
+        parm.parm.capture.timeperframe.numerator = 1;
+        parm.parm.capture.timeperframe.denominator = self->request_fps;
+        /* a driver refusing leaves the frame rate as it was */
+        v4l2_xioctl (self->fd, VIDIOC_S_PARM, &parm);
+        CLEAR (parm);
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (-1 == v4l2_xioctl (self->fd, VIDIOC_G_PARM, &parm))
+            return;
+    }
+    self->fps_num = parm.parm.capture.timeperframe.numerator;
+    self->fps_den = parm.parm.capture.timeperframe.denominator;
+}
+
 char** v4l2_list_cameras (int* num_devices)
 {
     char** devices;
@@ -121,6 +310,9 @@ PyObject* v4l2_read_raw (PyCameraObject* self)
     struct v4l2_buffer buf;
     PyObject* raw;
 
+    if (!v4l2_release_frame (self))
+        return NULL;
+
     CLEAR (buf);
 
     buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -272,6 +464,21 @@ int v4l2_process_image (PyCameraObject* self, const void *image,
                 return 0;
             }
             break;
+        case V4L2_PIX_FMT_MJPEG:
+        case V4L2_PIX_FMT_JPEG:
+            if (!v4l2_decode_jpeg (self, image, buffer_size, surf)) {
+                SDL_UnlockSurface (surf);
+                return 0;
+            }
+            switch (self->color_out) {
+                case HSV_OUT:
+                    rgb_to_hsv(surf->pixels, surf->pixels, self->size, V4L2_PIX_FMT_MJPEG, surf->format);
+                    break;
+                case YUV_OUT:
+                    rgb_to_yuv(surf->pixels, surf->pixels, self->size, V4L2_PIX_FMT_MJPEG, surf->format);
+                    break;
+            }
+            break;
     }
     SDL_UnlockSurface (surf);
     return 1;
@@ -340,12 +547,507 @@ int v4l2_read_frame (PyCameraObject* self, SDL_Surface* surf)
     return 1;
 }
 
+/* The capture thread of start(threaded=True). It converts each frame into
+   the back surface and swaps that with the ready one, so the camera never
+   waits on get_image and get_image never waits on the camera. */
+static int v4l2_capture_thread (void* data)
+{
+    PyCameraObject* self = (PyCameraObject*) data;
+    struct v4l2_buffer buf;
+    struct timeval tv;
+    fd_set fds;
+    char error[256];
+    int r, swap, quit, processed;
+
+    error[0] = '\0';
+    for (;;) {
+        SDL_LockMutex (self->capture_lock);
+        quit = self->capture_quit;
+        SDL_UnlockMutex (self->capture_lock);
+        if (quit)
+            break;
+
+        /* Wait a little at a time, to see capture_quit */
+        FD_ZERO (&fds);
+        FD_SET (self->fd, &fds);
+        tv.tv_sec = 0;
+        tv.tv_usec = 100000;
+        r = select (self->fd + 1, &fds, NULL, NULL, &tv);
+        if (r == 0 || (r == -1 && errno == EINTR))
+            continue;
+        if (r == -1) {
+            PyOS_snprintf (error, sizeof (error), "select failure : %d, %s",
+                           errno, strerror (errno));
+            break;
+        }
+
+        CLEAR (buf);
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        if (-1 == v4l2_xioctl (self->fd, VIDIOC_DQBUF, &buf)) {
+            if (errno == EAGAIN)
+                continue;
+            PyOS_snprintf (error, sizeof (error),
+                           "ioctl(VIDIOC_DQBUF) failure : %d, %s",
+                           errno, strerror (errno));
+            break;
+        }
+        assert (buf.index < self->n_buffers);
+
+        /* Only this thread touches the back frame */
+        processed = v4l2_process_image (self, self->buffers[buf.index].start,
+                                        self->buffers[buf.index].length,
+                                        self->frames[self->frame_back]);
+        if (-1 == v4l2_xioctl (self->fd, VIDIOC_QBUF, &buf)) {
+            PyOS_snprintf (error, sizeof (error),
+                           "ioctl(VIDIOC_QBUF) failure : %d, %s",
+                           errno, strerror (errno));
+            break;
+        }
+        if (!processed) {
+            PyOS_snprintf (error, sizeof (error), "image processing error");
+            break;
+        }
+
+        SDL_LockMutex (self->capture_lock);
+        if (self->frame_fresh)
+            self->frames_dropped++;
+        swap = self->frame_ready;
+        self->frame_ready = self->frame_back;
+        self->frame_back = swap;
+        self->frame_fresh = 1;
+        self->frames_captured++;
+        SDL_CondSignal (self->capture_cond);
+        SDL_UnlockMutex (self->capture_lock);
+    }
+
+    if (error[0]) {
+        SDL_LockMutex (self->capture_lock);
+        strcpy (self->capture_error, error);
+        SDL_CondSignal (self->capture_cond);
+        SDL_UnlockMutex (self->capture_lock);
+    }
+    return 0;
+}
+
+/* Starts the capture thread; returns 0 with an exception set on failure */
+int v4l2_start_thread (PyCameraObject* self)
+{
+    int i;
+
+    if (!v4l2_release_frame (self))
+        return 0;
+    for (i = 0; i < CAMERA_THREAD_FRAMES; ++i) {
+        self->frames[i] = SDL_CreateRGBSurface (0, self->width, self->height,
+                                                24, 0xFF<<16, 0xFF<<8, 0xFF,
+                                                0);
+        if (!self->frames[i]) {
+            PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+            v4l2_stop_thread (self);
+            return 0;
+        }
+    }
+    self->frame_back = 0;
+    self->frame_ready = 1;
+    self->frame_front = 2;
+    self->frame_fresh = 0;
+    self->capture_quit = 0;
+    self->frames_captured = 0;
+    self->frames_dropped = 0;
+    self->frames_repeated = 0;
+    self->capture_error[0] = '\0';
+
+    self->capture_lock = SDL_CreateMutex ();
+    self->capture_cond = SDL_CreateCond ();
+    if (self->capture_lock && self->capture_cond)
+        self->capture_thread = SDL_CreateThread (v4l2_capture_thread, self);
+    if (!self->capture_thread) {
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+        v4l2_stop_thread (self);
+        return 0;
+    }
+    return 1;
+}
+
+/* Stops the capture thread, if any, and frees what it used */
+void v4l2_stop_thread (PyCameraObject* self)
+{
+    int i;
+
+    if (self->capture_thread) {
+        SDL_LockMutex (self->capture_lock);
+        self->capture_quit = 1;
+        SDL_UnlockMutex (self->capture_lock);
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_WaitThread (self->capture_thread, NULL);
+        Py_END_ALLOW_THREADS;
+        self->capture_thread = NULL;
+    }
+    if (self->capture_cond) {
+        SDL_DestroyCond (self->capture_cond);
+        self->capture_cond = NULL;
+    }
+    if (self->capture_lock) {
+        SDL_DestroyMutex (self->capture_lock);
+        self->capture_lock = NULL;
+    }
+    for (i = 0; i < CAMERA_THREAD_FRAMES; ++i) {
+        if (self->frames[i]) {
+            SDL_FreeSurface (self->frames[i]);
+            self->frames[i] = NULL;
+        }
+    }
+}
+
+/* Copies the newest frame of the capture thread into surf, waiting only
+   for the first frame. Returns 0 with an exception set on failure. */
+int v4l2_take_frame (PyCameraObject* self, SDL_Surface* surf)
+{
+    int swap, result;
+
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex (self->capture_lock);
+    while (!self->frames_captured && !self->capture_error[0])
+        SDL_CondWait (self->capture_cond, self->capture_lock);
+    result = !self->capture_error[0];
+    if (result) {
+        if (self->frame_fresh) {
+            swap = self->frame_front;
+            self->frame_front = self->frame_ready;
+            self->frame_ready = swap;
+            self->frame_fresh = 0;
+        }
+        else
+            self->frames_repeated++;
+        /* Under the lock, so the frame is not swapped out while copied */
+        result = SDL_BlitSurface (self->frames[self->frame_front], NULL,
+                                  surf, NULL) == 0;
+    }
+    SDL_UnlockMutex (self->capture_lock);
+    Py_END_ALLOW_THREADS;
+
+    if (!result) {
+        if (self->capture_error[0])
+            PyErr_SetString (PyExc_SystemError, self->capture_error);
+        else
+            PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+    }
+    return result;
+}
+
+/* Is there a frame the capture thread finished that get_image has not
+   taken */
+int v4l2_query_thread (PyCameraObject* self)
+{
+    int fresh;
+
+    SDL_LockMutex (self->capture_lock);
+    fresh = self->frame_fresh;
+    SDL_UnlockMutex (self->capture_lock);
+    return fresh;
+}
+
+/* appends (pixelformat, (width, height), fps) to list */
+static int v4l2_append_format (PyObject* list, unsigned long pixelformat,
+                               int width, int height, double fps)
+{
+    PyObject* item;
+    int result;
+
+    item = Py_BuildValue ("(N(ii)d)", v4l2_fourcc_string (pixelformat),
+                          width, height, fps);
+    if (!item)
+        return 0;
+    result = PyList_Append (list, item);
+    Py_DECREF (item);
+    return result == 0;
+}
+
+/* the frame rates a size comes in; the fastest one for a range */
+static int v4l2_append_intervals (PyCameraObject* self, PyObject* list,
+                                  unsigned long pixelformat, int width,
+                                  int height)
+{
+    struct v4l2_frmivalenum ival;
+    struct v4l2_fract* period;
+
+    CLEAR (ival);
+    ival.pixel_format = pixelformat;
+    ival.width = width;
+    ival.height = height;
+    for (; v4l2_xioctl (self->fd, VIDIOC_ENUM_FRAMEINTERVALS, &ival) != -1;
+         ival.index++) {
+        period = (ival.type == V4L2_FRMIVAL_TYPE_DISCRETE ?
+                  &ival.discrete : &ival.stepwise.min);
+        if (!v4l2_append_format (list, pixelformat, width, height,
+                                 period->numerator ?
+                                 (double) period->denominator /
+                                 period->numerator : 0.0))
+            return 0;
+        if (ival.type != V4L2_FRMIVAL_TYPE_DISCRETE)
+            return 1;
+    }
+    if (!ival.index)
+        return v4l2_append_format (list, pixelformat, width, height, 0.0);
+    return 1;
+}
+
+/* lists the formats, sizes and frame rates the device offers; a range of
+   sizes is listed as its biggest one */
+PyObject* v4l2_list_formats (PyCameraObject* self)
+{
+    struct v4l2_fmtdesc desc;
+    struct v4l2_frmsizeenum size;
+    PyObject* list;
+    int opened = 0;
+
+    if (self->fd == -1) {
+        if (!v4l2_open_device (self))
+            return NULL;
+        opened = 1;
+    }
+    list = PyList_New (0);
+    if (!list)
+        goto end;
+
+    CLEAR (desc);
+    desc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    for (; v4l2_xioctl (self->fd, VIDIOC_ENUM_FMT, &desc) != -1;
+         desc.index++) {
+        CLEAR (size);
+        size.pixel_format = desc.pixelformat;
+        for (; v4l2_xioctl (self->fd, VIDIOC_ENUM_FRAMESIZES, &size) != -1;
+             size.index++) {
+            if (size.type == V4L2_FRMSIZE_TYPE_DISCRETE) {
+                if (!v4l2_append_intervals (self, list, desc.pixelformat,
+                                            size.discrete.width,
+                                            size.discrete.height))
+                    goto fail;
+            } else {
+                if (!v4l2_append_intervals (self, list, desc.pixelformat,
+                                            size.stepwise.max_width,
+                                            size.stepwise.max_height))
+                    goto fail;
+                break;
+            }
+        }
+    }
+    goto end;
+
+fail:
+    Py_CLEAR (list);
+end:
+    if (opened)
+        v4l2_close_device (self);
+    return list;
+}
+
+/* a pixelformat as its four characters, like "YUYV" */
+PyObject* v4l2_fourcc_string (unsigned long pixelformat)
+{
+    char fourcc[4];
+
+    fourcc[0] = (char) (pixelformat & 0xff);
+    fourcc[1] = (char) ((pixelformat >> 8) & 0xff);
+    fourcc[2] = (char) ((pixelformat >> 16) & 0xff);
+    fourcc[3] = (char) ((pixelformat >> 24) & 0xff);
+    return Text_FromUTF8AndSize (fourcc, 4);
+}
+
+/* gives the held buffer, if any, back to the driver; returns -1, with
+   errno set, on failure. Does not need the GIL. */
+static int v4l2_queue_held (PyCameraObject* self)
+{
+    struct v4l2_buffer buf;
+
+    if (self->view_index < 0)
+        return 0;
+
+    CLEAR (buf);
+
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = self->view_index;
+    self->view_index = -1;
+
+    return v4l2_xioctl (self->fd, VIDIOC_QBUF, &buf);
+}
+
+/* dequeues a buffer in place of the held one, which is only given back
+   once there is a new one; returns -1, with errno set, on failure. Does
+   not need the GIL. */
+static int v4l2_dequeue_held (PyCameraObject* self)
+{
+    struct v4l2_buffer buf;
+
+    CLEAR (buf);
+
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+
+    if (-1 == v4l2_xioctl (self->fd, VIDIOC_DQBUF, &buf))
+        return -1;
+
+    assert (buf.index < self->n_buffers);
+
+    if (-1 == v4l2_queue_held (self)) {
+        v4l2_xioctl (self->fd, VIDIOC_QBUF, &buf);
+        return -1;
+    }
+
+    self->view_index = buf.index;
+    self->view_length = buf.bytesused ? buf.bytesused
+                                      : self->buffers[buf.index].length;
+    self->view_timestamp = buf.timestamp.tv_sec +
+                           buf.timestamp.tv_usec / 1000000.0;
+    return 0;
+}
+
+/* dequeues a buffer and keeps it out of the driver's queue, for
+   get_frame_view, until the next dequeue or v4l2_release_frame */
+int v4l2_hold_frame (PyCameraObject* self)
+{
+    if (-1 == v4l2_dequeue_held (self)) {
+        PyErr_Format(PyExc_SystemError,
+                     "ioctl(VIDIOC_QBUF/DQBUF) failure : %d, %s",
+                     errno, strerror (errno));
+        return 0;
+    }
+
+    return 1;
+}
+
+/* gives the held buffer, if any, back to the driver */
+int v4l2_release_frame (PyCameraObject* self)
+{
+    if (-1 == v4l2_queue_held (self)) {
+        PyErr_Format(PyExc_SystemError, "ioctl(VIDIOC_QBUF) failure : %d, %s",
+                     errno, strerror (errno));
+        return 0;
+    }
+
+    return 1;
+}
+
+static double v4l2_now (void)
+{
+    struct timeval tv;
+
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* takes the newest frame of each camera ready to give one */
+static int v4l2_take_newest (PyCameraObject** cameras, struct pollfd* fds,
+                             int count, char* error, size_t size)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (!(fds[i].revents & POLLIN))
+            continue;
+        /* the driver queues frames oldest first, so drain it */
+        while (v4l2_dequeue_held (cameras[i]) != -1)
+            ;
+        if (errno != EAGAIN) {
+            PyOS_snprintf (error, size, "%s: ioctl(VIDIOC_DQBUF) failure : "
+                           "%d, %s", cameras[i]->device_name, errno,
+                           strerror (errno));
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* holds a frame from each of count started cameras, as close in time as
+   can be: frames are taken from whichever is ready, each camera keeping its
+   newest, until all have one no more than max_skew seconds apart by their
+   v4l2 timestamps. With max_skew below 0 any frames will do; after timeout
+   seconds the newest ones do. Runs without the GIL; returns 0 with a
+   message in error on failure. */
+int v4l2_capture_set (PyCameraObject** cameras, int count, double timeout,
+                      double max_skew, char* error, size_t size)
+{
+    struct pollfd* fds;
+    int* flags;
+    double deadline = v4l2_now () + timeout;
+    double remaining, first, last;
+    int i, r, ready, result = 0;
+
+    fds = (struct pollfd*) malloc (sizeof (struct pollfd) * count);
+    flags = (int*) malloc (sizeof (int) * count);
+    if (!fds || !flags) {
+        free (fds);
+        free (flags);
+        PyOS_snprintf (error, size, "out of memory");
+        return 0;
+    }
+    /* without blocking, to drain each queue */
+    for (i = 0; i < count; i++) {
+        flags[i] = fcntl (cameras[i]->fd, F_GETFL);
+        fcntl (cameras[i]->fd, F_SETFL, flags[i] | O_NONBLOCK);
+        fds[i].fd = cameras[i]->fd;
+        fds[i].events = POLLIN;
+        fds[i].revents = POLLIN;
+    }
+    /* frames already waiting count too */
+    if (!v4l2_take_newest (cameras, fds, count, error, size))
+        goto end;
+
+    for (;;) {
+        ready = 1;
+        first = last = 0.0;
+        for (i = 0; i < count; i++) {
+            if (cameras[i]->view_index < 0) {
+                ready = 0;
+                break;
+            }
+            if (!i || cameras[i]->view_timestamp < first)
+                first = cameras[i]->view_timestamp;
+            if (!i || cameras[i]->view_timestamp > last)
+                last = cameras[i]->view_timestamp;
+        }
+        if (ready && (max_skew < 0 || last - first <= max_skew))
+            break;
+
+        remaining = deadline - v4l2_now ();
+        if (remaining <= 0) {
+            if (ready)
+                break;
+            PyOS_snprintf (error, size, "%s: no frame in time",
+                           cameras[i]->device_name);
+            goto end;
+        }
+        r = poll (fds, count, (int) (remaining * 1000) + 1);
+        if (r == -1 && errno == EINTR)
+            continue;
+        if (r == -1) {
+            PyOS_snprintf (error, size, "poll failure : %d, %s",
+                           errno, strerror (errno));
+            goto end;
+        }
+        if (r && !v4l2_take_newest (cameras, fds, count, error, size))
+            goto end;
+    }
+    result = 1;
+
+end:
+    for (i = 0; i < count; i++)
+        fcntl (cameras[i]->fd, F_SETFL, flags[i]);
+    free (fds);
+    free (flags);
+    return result;
+}
+
 int v4l2_stop_capturing (PyCameraObject* self)
 {
     enum v4l2_buf_type type;
 
     type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
+    /* streaming off takes every buffer back, held or not */
+    self->view_index = -1;
+
     if (-1 == v4l2_xioctl (self->fd, VIDIOC_STREAMOFF, &type)) {
         PyErr_Format(PyExc_SystemError, "ioctl(VIDIOC_STREAMOFF) failure : %d, %s",
                      errno, strerror (errno));
@@ -400,6 +1102,15 @@ int v4l2_uninit_device (PyCameraObject* self)
     }
 
     free (self->buffers);
+    self->buffers = NULL;
+    self->n_buffers = 0;
+
+    if (self->jpeg) {
+        turbojpeg.tjDestroy (self->jpeg);
+        self->jpeg = NULL;
+    }
+    free (self->jpeg_rgb);
+    self->jpeg_rgb = NULL;
 
     return 1;
 }
@@ -481,6 +1192,7 @@ int v4l2_init_device (PyCameraObject* self)
     struct v4l2_capability cap;
     struct v4l2_format fmt;
     unsigned int min;
+    int width = self->width, height = self->height;
 
     if (-1 == v4l2_xioctl (self->fd, VIDIOC_QUERYCAP, &cap)) {
         if (EINVAL == errno) {
@@ -517,8 +1229,24 @@ int v4l2_init_device (PyCameraObject* self)
     /* Find the pixelformat supported by the camera that will take the least
        processing power to convert to the desired output.  Thus, for YUV out,
        YUYVand YUV420 are first, while for RGB and HSV, the packed RGB formats
-       are first. */
-    switch (self->color_out) {
+       are first, and MJPEG, taking decoding, is last. */
+    if (self->request_format) {
+        if (!v4l2_known_pixelformat(self->request_format)) {
+            if (self->request_format == V4L2_PIX_FMT_MJPEG ||
+                self->request_format == V4L2_PIX_FMT_JPEG)
+                PyErr_SetString(PyExc_SystemError,
+                                "MJPEG decoding needs libturbojpeg");
+            else
+                PyErr_SetString(PyExc_ValueError, "unsupported pixelformat");
+            return 0;
+        }
+        if (!v4l2_pixelformat(self->fd, &fmt, self->request_format)) {
+            PyErr_Format(PyExc_SystemError,
+                         "ioctl(VIDIOC_S_FMT) failure: %s does not support "
+                         "the pixelformat", self->device_name);
+            return 0;
+        }
+    } else switch (self->color_out) {
         case YUV_OUT:
             if (v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_YUYV)) {
                 self->pixelformat = V4L2_PIX_FMT_YUYV;
@@ -530,6 +1258,9 @@ int v4l2_init_device (PyCameraObject* self)
                 self->pixelformat = V4L2_PIX_FMT_RGB444;
             } else if (v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_SBGGR8)) {
                 self->pixelformat = V4L2_PIX_FMT_SBGGR8;
+            } else if (v4l2_load_turbojpeg() &&
+                       v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_MJPEG)) {
+                self->pixelformat = V4L2_PIX_FMT_MJPEG;
             } else {
                 PyErr_Format(PyExc_SystemError,
                            "ioctl(VIDIOC_S_FMT) failure: no supported formats");
@@ -547,6 +1278,9 @@ int v4l2_init_device (PyCameraObject* self)
                 self->pixelformat = V4L2_PIX_FMT_SBGGR8;
             } else if (v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_YUV420)) {
                 self->pixelformat = V4L2_PIX_FMT_YUV420;
+            } else if (v4l2_load_turbojpeg() &&
+                       v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_MJPEG)) {
+                self->pixelformat = V4L2_PIX_FMT_MJPEG;
             } else {
                 PyErr_Format(PyExc_SystemError,
                            "ioctl(VIDIOC_S_FMT) failure: no supported formats");
@@ -561,6 +1295,14 @@ int v4l2_init_device (PyCameraObject* self)
     self->size = self->width * self->height;
     self->pixelformat = fmt.fmt.pix.pixelformat;
 
+    if (self->pixelformat == V4L2_PIX_FMT_MJPEG ||
+        self->pixelformat == V4L2_PIX_FMT_JPEG) {
+        self->jpeg_width = self->width;
+        self->jpeg_height = self->height;
+        if (!v4l2_init_jpeg (self, width, height))
+            return 0;
+    }
+
     /* Buggy driver paranoia. */
     min = fmt.fmt.pix.width * 2;
     if (fmt.fmt.pix.bytesperline < min)
@@ -569,6 +1311,7 @@ int v4l2_init_device (PyCameraObject* self)
     if (fmt.fmt.pix.sizeimage < min)
         fmt.fmt.pix.sizeimage = min;
 
+    v4l2_init_fps (self);
     v4l2_init_mmap (self);
 
     return 1;
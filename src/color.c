@@ -40,6 +40,8 @@
 #include "doc/color_doc.h"
 #include "pygame.h"
 #include "pgcompat.h"
+#include "pgfreelist.h"
+#include "pgcolorspace.h"
 #include <ctype.h>
 
 
@@ -59,6 +61,9 @@ typedef enum {
 
 static PyObject *_COLORDICT = NULL;
 
+/* Memory of dead Colors, reused by the next new ones */
+static PgFreeList _color_freelist = PG_FREELIST_INIT (NULL);
+
 static int _get_double (PyObject *obj, double *val);
 static int _get_color (PyObject *val, Uint32 *color);
 static int _hextoint (char *hex, Uint8 *val);
@@ -77,6 +82,7 @@ static PyObject* _color_repr (PyColor *color);
 static PyObject* _color_normalize (PyColor *color);
 static PyObject* _color_correct_gamma (PyColor *color, PyObject *args);
 static PyObject* _color_set_length (PyColor *color, PyObject *args);
+static PyObject* _color_from_int (PyObject *cls, PyObject *value);
 
 /* Getters/setters */
 static PyObject* _color_get_r (PyColor *color, void *closure);
@@ -103,6 +109,11 @@ static PyObject* _color_sub (PyObject *obj1, PyObject *obj2);
 static PyObject* _color_mul (PyObject *obj1, PyObject *obj2);
 static PyObject* _color_div (PyObject *obj1, PyObject *obj2);
 static PyObject* _color_mod (PyObject *obj1, PyObject *obj2);
+static PyObject* _color_iadd (PyObject *obj1, PyObject *obj2);
+static PyObject* _color_isub (PyObject *obj1, PyObject *obj2);
+static PyObject* _color_imul (PyObject *obj1, PyObject *obj2);
+static PyObject* _color_idiv (PyObject *obj1, PyObject *obj2);
+static PyObject* _color_imod (PyObject *obj1, PyObject *obj2);
 static PyObject* _color_inv (PyColor *color);
 static PyObject* _color_int (PyColor *color);
 static PyObject* _color_float (PyColor *color);
@@ -146,6 +157,9 @@ static PyMethodDef _color_methods[] =
       DOC_COLORCORRECTGAMMA },
     { "set_length", (PyCFunction) _color_set_length, METH_VARARGS,
       DOC_COLORSETLENGTH },
+    { "to_int", (PyCFunction) _color_int, METH_NOARGS, DOC_COLORTOINT },
+    { "from_int", (PyCFunction) _color_from_int, METH_CLASS | METH_O,
+      DOC_COLORFROMINT },
     { NULL, NULL, 0, NULL }
 };
 
@@ -207,13 +221,13 @@ static PyNumberMethods _color_as_number =
     (unaryfunc) _color_oct,  /* nb_oct */
     (unaryfunc) _color_hex,  /* nb_hex */
 #endif
-    0,                       /* nb_inplace_add */
-    0,                       /* nb_inplace_subtract */
-    0,                       /* nb_inplace_multiply */
+    (binaryfunc) _color_iadd,/* nb_inplace_add */
+    (binaryfunc) _color_isub,/* nb_inplace_subtract */
+    (binaryfunc) _color_imul,/* nb_inplace_multiply */
 #if !PY3
-    0,                       /* nb_inplace_divide */
+    (binaryfunc) _color_idiv,/* nb_inplace_divide */
 #endif
-    0,                       /* nb_inplace_remainder */
+    (binaryfunc) _color_imod,/* nb_inplace_remainder */
     0,                       /* nb_inplace_power */
     0,                       /* nb_inplace_lshift */
     0,                       /* nb_inplace_rshift */
@@ -222,7 +236,7 @@ static PyNumberMethods _color_as_number =
     0,                       /* nb_inplace_or */
     (binaryfunc) _color_div, /* nb_floor_divide */
     0,                       /* nb_true_divide */
-    0,                       /* nb_inplace_floor_divide */
+    (binaryfunc) _color_idiv,/* nb_inplace_floor_divide */
     0,                       /* nb_inplace_true_divide */
 #if PY_VERSION_HEX >= 0x02050000
     (unaryfunc) _color_int,  /* nb_index */
@@ -631,7 +645,12 @@ static PyColor*
 _color_new_internal_length (PyTypeObject *type,
                             const Uint8 rgba[], Uint8 length)
 {
-    PyColor *color = (PyColor *) type->tp_alloc (type, 0);
+    PyColor *color = NULL;
+
+    if (type == &PyColor_Type)
+        color = (PyColor *) PgFreeList_Pop (&_color_freelist, type);
+    if (!color)
+        color = (PyColor *) type->tp_alloc (type, 0);
     if (!color)
         return NULL;
 
@@ -772,6 +791,9 @@ _color_init (PyColor *self, PyObject *args, PyObject *kwds)
 static void
 _color_dealloc (PyColor *color)
 {
+    if (Py_TYPE(color) == &PyColor_Type &&
+        PgFreeList_Push (&_color_freelist, (PyObject *) color))
+        return;
     Py_TYPE(color)->tp_free ((PyObject *) color);
 }
 
@@ -802,6 +824,13 @@ _color_normalize (PyColor *color)
     return Py_BuildValue ("(ffff)", rgba[0], rgba[1], rgba[2], rgba[3]);
 }
 
+/* The table for the last gamma asked for a second time in a row, so
+   that colors corrected by one gamma over and over skip the pow calls */
+static double _color_gamma_last = 1.0;
+static double _color_gamma_cached = 1.0;
+static int _color_gamma_have_table = 0;
+static Uint8 _color_gamma_table[256];
+
 /**
  * color.correct_gamma (x)
  */
@@ -811,10 +840,26 @@ _color_correct_gamma (PyColor *color, PyObject *args)
     double frgba[4];
     Uint8 rgba[4];
     double _gamma;
+    int i;
 
     if (!PyArg_ParseTuple (args, "d", &_gamma))
         return NULL;
 
+    if (!(_color_gamma_have_table && _gamma == _color_gamma_cached) &&
+        _gamma == _color_gamma_last)
+    {
+        pg_gamma_table (_color_gamma_table, _gamma);
+        _color_gamma_cached = _gamma;
+        _color_gamma_have_table = 1;
+    }
+    _color_gamma_last = _gamma;
+    if (_color_gamma_have_table && _gamma == _color_gamma_cached)
+    {
+        for (i = 0; i < 4; ++i)
+            rgba[i] = _color_gamma_table[color->data[i]];
+        return (PyObject *) _color_new_internal (Py_TYPE (color), rgba);
+    }
+
     frgba[0] = pow (color->data[0] / 255.0, _gamma);
     frgba[1] = pow (color->data[1] / 255.0, _gamma);
     frgba[2] = pow (color->data[2] / 255.0, _gamma);
@@ -1432,46 +1477,101 @@ _color_get_arraystruct(PyColor *color, void *closure)
 
 /* Number protocol methods */
 
-/**
- * color1 + color2
+typedef enum
+{
+    COLOR_ADD,
+    COLOR_SUB,
+    COLOR_MUL,
+    COLOR_DIV,
+    COLOR_MOD
+} ColorOp;
+
+/* out = a op b for n RGBA pixels, clamped to 0-255. A channel divided by 0
+ * gives 0. A step of 0 repeats the one color of a or b for every pixel.
  */
+static void
+_color_op_pixels (ColorOp op, const Uint8 *a, Py_ssize_t a_step,
+                  const Uint8 *b, Py_ssize_t b_step, Uint8 *out,
+                  Py_ssize_t n)
+{
+    Py_ssize_t p;
+    int i;
+
+    for (p = 0; p < n; ++p, a += a_step, b += b_step, out += 4)
+    {
+        switch (op)
+        {
+        case COLOR_ADD:
+            for (i = 0; i < 4; ++i)
+                out[i] = MIN (a[i] + b[i], 255);
+            break;
+        case COLOR_SUB:
+            for (i = 0; i < 4; ++i)
+                out[i] = MAX (a[i] - b[i], 0);
+            break;
+        case COLOR_MUL:
+            for (i = 0; i < 4; ++i)
+                out[i] = MIN (a[i] * b[i], 255);
+            break;
+        case COLOR_DIV:
+            for (i = 0; i < 4; ++i)
+                out[i] = b[i] ? a[i] / b[i] : 0;
+            break;
+        default:
+            for (i = 0; i < 4; ++i)
+                out[i] = b[i] ? a[i] % b[i] : 0;
+            break;
+        }
+    }
+}
+
 static PyObject*
-_color_add (PyObject *obj1, PyObject *obj2)
+_color_binop (PyObject *obj1, PyObject *obj2, ColorOp op)
 {
     Uint8 rgba[4];
-    PyColor *color1 = (PyColor *)obj1;
-    PyColor *color2 = (PyColor *)obj2;
+
     if (!PyObject_IsInstance (obj1, (PyObject *)&PyColor_Type) ||
         !PyObject_IsInstance (obj2, (PyObject *)&PyColor_Type))   {
         Py_INCREF (Py_NotImplemented);
         return Py_NotImplemented;
-    }  
-    rgba[0] = MIN (color1->data[0] + color2->data[0], 255);
-    rgba[1] = MIN (color1->data[1] + color2->data[1], 255);
-    rgba[2] = MIN (color1->data[2] + color2->data[2], 255);
-    rgba[3] = MIN (color1->data[3] + color2->data[3], 255);
+    }
+    _color_op_pixels (op, ((PyColor *)obj1)->data, 0,
+                      ((PyColor *)obj2)->data, 0, rgba, 1);
     return (PyObject*) _color_new_internal (Py_TYPE (obj1), rgba);
 }
 
+/* color1 op= color2 changes color1 rather than making a new Color. */
+static PyObject*
+_color_inplace_op (PyObject *obj1, PyObject *obj2, ColorOp op)
+{
+    PyColor *color = (PyColor *)obj1;
+
+    if (!PyObject_IsInstance (obj2, (PyObject *)&PyColor_Type))   {
+        Py_INCREF (Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    _color_op_pixels (op, color->data, 0, ((PyColor *)obj2)->data, 0,
+                      color->data, 1);
+    Py_INCREF (obj1);
+    return obj1;
+}
+
+/**
+ * color1 + color2
+ */
+static PyObject*
+_color_add (PyObject *obj1, PyObject *obj2)
+{
+    return _color_binop (obj1, obj2, COLOR_ADD);
+}
+
 /**
  * color1 - color2
  */
 static PyObject*
 _color_sub (PyObject *obj1, PyObject *obj2)
 {
-    Uint8 rgba[4];
-    PyColor *color1 = (PyColor *)obj1;
-    PyColor *color2 = (PyColor *)obj2;
-    if (!PyObject_IsInstance (obj1, (PyObject *)&PyColor_Type) ||
-        !PyObject_IsInstance (obj2, (PyObject *)&PyColor_Type))   {
-        Py_INCREF (Py_NotImplemented);
-        return Py_NotImplemented;
-    }  
-    rgba[0] = MAX (color1->data[0] - color2->data[0], 0);
-    rgba[1] = MAX (color1->data[1] - color2->data[1], 0);
-    rgba[2] = MAX (color1->data[2] - color2->data[2], 0);
-    rgba[3] = MAX (color1->data[3] - color2->data[3], 0);
-    return (PyObject*) _color_new_internal (Py_TYPE (obj1), rgba);
+    return _color_binop (obj1, obj2, COLOR_SUB);
 }
 
 /**
@@ -1480,19 +1580,7 @@ _color_sub (PyObject *obj1, PyObject *obj2)
 static PyObject*
 _color_mul (PyObject *obj1, PyObject *obj2)
 {
-    Uint8 rgba[4];
-    PyColor *color1 = (PyColor *)obj1;
-    PyColor *color2 = (PyColor *)obj2;
-    if (!PyObject_IsInstance (obj1, (PyObject *)&PyColor_Type) ||
-        !PyObject_IsInstance (obj2, (PyObject *)&PyColor_Type))   {
-        Py_INCREF (Py_NotImplemented);
-        return Py_NotImplemented;
-    }  
-    rgba[0] = MIN (color1->data[0] * color2->data[0], 255);
-    rgba[1] = MIN (color1->data[1] * color2->data[1], 255);
-    rgba[2] = MIN (color1->data[2] * color2->data[2], 255);
-    rgba[3] = MIN (color1->data[3] * color2->data[3], 255);
-    return (PyObject*) _color_new_internal (Py_TYPE (obj1), rgba);
+    return _color_binop (obj1, obj2, COLOR_MUL);
 }
 
 /**
@@ -1501,23 +1589,7 @@ _color_mul (PyObject *obj1, PyObject *obj2)
 static PyObject*
 _color_div (PyObject *obj1, PyObject *obj2)
 {
-    Uint8 rgba[4] = { 0, 0, 0, 0 };
-    PyColor *color1 = (PyColor *)obj1;
-    PyColor *color2 = (PyColor *)obj2;
-    if (!PyObject_IsInstance (obj1, (PyObject *)&PyColor_Type) ||
-        !PyObject_IsInstance (obj2, (PyObject *)&PyColor_Type))   {
-        Py_INCREF (Py_NotImplemented);
-        return Py_NotImplemented;
-    }  
-    if (color2->data[0] != 0)
-        rgba[0] = color1->data[0] / color2->data[0];
-    if (color2->data[1] != 0)
-        rgba[1] = color1->data[1] / color2->data[1];
-    if (color2->data[2])
-        rgba[2] = color1->data[2] / color2->data[2];
-    if (color2->data[3])
-        rgba[3] = color1->data[3] / color2->data[3];
-    return (PyObject*) _color_new_internal (Py_TYPE (obj1), rgba);
+    return _color_binop (obj1, obj2, COLOR_DIV);
 }
 
 /**
@@ -1526,23 +1598,52 @@ _color_div (PyObject *obj1, PyObject *obj2)
 static PyObject*
 _color_mod (PyObject *obj1, PyObject *obj2)
 {
-    Uint8 rgba[4] = { 0, 0, 0, 0 };
-    PyColor *color1 = (PyColor *)obj1;
-    PyColor *color2 = (PyColor *)obj2;
-    if (!PyObject_IsInstance (obj1, (PyObject *)&PyColor_Type) ||
-        !PyObject_IsInstance (obj2, (PyObject *)&PyColor_Type))   {
-        Py_INCREF (Py_NotImplemented);
-        return Py_NotImplemented;
-    }  
-    if (color2->data[0] != 0)
-        rgba[0] = color1->data[0] % color2->data[0];
-    if (color2->data[1] != 0)
-        rgba[1] = color1->data[1] % color2->data[1];
-    if (color2->data[2])
-        rgba[2] = color1->data[2] % color2->data[2];
-    if (color2->data[3])
-        rgba[3] = color1->data[3] % color2->data[3];
-    return (PyObject*) _color_new_internal (Py_TYPE (obj1), rgba);
+    return _color_binop (obj1, obj2, COLOR_MOD);
+}
+
+/**
+ * color1 += color2
+ */
+static PyObject*
+_color_iadd (PyObject *obj1, PyObject *obj2)
+{
+    return _color_inplace_op (obj1, obj2, COLOR_ADD);
+}
+
+/**
+ * color1 -= color2
+ */
+static PyObject*
+_color_isub (PyObject *obj1, PyObject *obj2)
+{
+    return _color_inplace_op (obj1, obj2, COLOR_SUB);
+}
+
+/**
+ * color1 *= color2
+ */
+static PyObject*
+_color_imul (PyObject *obj1, PyObject *obj2)
+{
+    return _color_inplace_op (obj1, obj2, COLOR_MUL);
+}
+
+/**
+ * color1 //= color2
+ */
+static PyObject*
+_color_idiv (PyObject *obj1, PyObject *obj2)
+{
+    return _color_inplace_op (obj1, obj2, COLOR_DIV);
+}
+
+/**
+ * color1 %= color2
+ */
+static PyObject*
+_color_imod (PyObject *obj1, PyObject *obj2)
+{
+    return _color_inplace_op (obj1, obj2, COLOR_MOD);
 }
 
 /**
@@ -1559,14 +1660,18 @@ _color_inv (PyColor *color)
     return (PyObject*) _color_new_internal (Py_TYPE (color), rgba);
 }
 
+/* The color packed as 0xRRGGBBAA, as int(color) gives it */
+#define COLOR_PACK(data)                                              \
+    (((Uint32)(data)[0] << 24) | ((Uint32)(data)[1] << 16) |          \
+     ((Uint32)(data)[2] << 8) | (Uint32)(data)[3])
+
 /**
  * int(color)
  */
 static PyObject*
 _color_int (PyColor *color)
 {
-    Uint32 tmp = (color->data[0] << 24) + (color->data[1] << 16) +
-                 (color->data[2] << 8) + color->data[3];
+    Uint32 tmp = COLOR_PACK (color->data);
 #if !PY3
     if (tmp < LONG_MAX)
         return PyInt_FromLong ((long) tmp);
@@ -1916,6 +2021,46 @@ Unimplemented:
     return Py_NotImplemented;
 }
 
+/**
+ * Color.from_int(0xRRGGBBAA)
+ */
+static PyObject*
+_color_from_int (PyObject *cls, PyObject *value)
+{
+    Uint8 rgba[4];
+    unsigned long pixel;
+
+#if !PY3
+    if (PyInt_Check (value))
+    {
+        long ivalue = PyInt_AS_LONG (value);
+
+        if (ivalue < 0)
+            return RAISE (PyExc_ValueError, "invalid color argument");
+        pixel = (unsigned long) ivalue;
+    }
+    else
+#endif
+    if (PyLong_Check (value))
+    {
+        pixel = PyLong_AsUnsignedLong (value);
+        if (PyErr_Occurred ())
+        {
+            PyErr_Clear ();
+            return RAISE (PyExc_ValueError, "invalid color argument");
+        }
+    }
+    else
+        return RAISE (PyExc_TypeError, "expected an integer");
+    if (pixel > 0xFFFFFFFFUL)
+        return RAISE (PyExc_ValueError, "invalid color argument");
+
+    rgba[0] = (Uint8) (pixel >> 24);
+    rgba[1] = (Uint8) (pixel >> 16);
+    rgba[2] = (Uint8) (pixel >> 8);
+    rgba[3] = (Uint8) pixel;
+    return (PyObject *) _color_new_internal ((PyTypeObject *) cls, rgba);
+}
 
 static int
 _color_getbuffer (PyColor *color, Py_buffer *view, int flags)
@@ -1993,6 +2138,618 @@ RGBAFromColorObj (PyObject *color, Uint8 rgba[])
         return RGBAFromObj (color, rgba);
 }
 
+static PyObject*
+_color_set_freelist_size (PyObject *self, PyObject *args)
+{
+    Py_ssize_t size;
+
+    if (!PyArg_ParseTuple (args, "n", &size))
+        return NULL;
+    if (PgFreeList_Resize (&_color_freelist, size))
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+_color_get_freelist_stats (PyObject *self)
+{
+    return PgFreeList_Stats (&_color_freelist);
+}
+
+#if PG_ENABLE_NEWBUF
+typedef enum
+{
+    COLORSPACE_TO_HSV,
+    COLORSPACE_TO_RGB,
+    COLORSPACE_GAMMA
+} ColorSpaceOp;
+
+/* Convert the pixels of a writable buffer of 3 or 4 byte pixels in place */
+static PyObject*
+_color_convert_buffer (PyObject *obj, int channels, ColorSpaceOp op,
+                       double gamma)
+{
+    Py_buffer view;
+    Uint8 table[256];
+    Py_ssize_t n;
+
+    if (channels != 3 && channels != 4)
+        return RAISE (PyExc_ValueError, "channels must be 3 or 4");
+    if (PyObject_GetBuffer (obj, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS))
+        return NULL;
+    if (view.len % channels)
+    {
+        PyBuffer_Release (&view);
+        return RAISE (PyExc_ValueError,
+                      "buffer length must be a multiple of channels");
+    }
+    n = view.len / channels;
+    if (op == COLORSPACE_GAMMA)
+        pg_gamma_table (table, gamma);
+
+    Py_BEGIN_ALLOW_THREADS;
+    switch (op)
+    {
+    case COLORSPACE_TO_HSV:
+        pg_rgb_to_hsv_pixels ((Uint8 *) view.buf, n, channels, 0, 1, 2);
+        break;
+    case COLORSPACE_TO_RGB:
+        pg_hsv_to_rgb_pixels ((Uint8 *) view.buf, n, channels, 0, 1, 2);
+        break;
+    default:
+        pg_table_pixels ((Uint8 *) view.buf, n, channels, 0, 1, 2, table);
+        break;
+    }
+    Py_END_ALLOW_THREADS;
+
+    PyBuffer_Release (&view);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+_color_rgb_to_hsv (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwids[] = {"buffer", "channels", NULL};
+    PyObject *obj;
+    int channels = 3;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|i", kwids,
+                                      &obj, &channels))
+        return NULL;
+    return _color_convert_buffer (obj, channels, COLORSPACE_TO_HSV, 0.0);
+}
+
+static PyObject*
+_color_hsv_to_rgb (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwids[] = {"buffer", "channels", NULL};
+    PyObject *obj;
+    int channels = 3;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|i", kwids,
+                                      &obj, &channels))
+        return NULL;
+    return _color_convert_buffer (obj, channels, COLORSPACE_TO_RGB, 0.0);
+}
+
+static PyObject*
+_color_correct_gamma_buffer (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwids[] = {"buffer", "gamma", "channels", NULL};
+    PyObject *obj;
+    double gamma;
+    int channels = 3;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "Od|i", kwids,
+                                      &obj, &gamma, &channels))
+        return NULL;
+    return _color_convert_buffer (obj, channels, COLORSPACE_GAMMA, gamma);
+}
+
+/* The functions pygame.set_simd_backend calls for the conversions */
+static PyObject*
+_color_get_simd_backend (PyObject *self)
+{
+    return Text_FromUTF8 (pg_colorspace_get_backend ());
+}
+
+static PyObject*
+_color_set_simd_backend (PyObject *self, PyObject *args)
+{
+    const char *type;
+
+    if (!PyArg_ParseTuple (args, "s", &type))
+        return NULL;
+    if (pg_colorspace_set_backend (type))
+        return RAISE (PyExc_ValueError, "no such backend on this machine");
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef _color_simd_methods[] =
+{
+    { "get_simd_backend", (PyCFunction) _color_get_simd_backend,
+      METH_NOARGS, NULL },
+    { "set_simd_backend", _color_set_simd_backend, METH_VARARGS, NULL },
+    { NULL, NULL, 0, NULL }
+};
+#endif /* PG_ENABLE_NEWBUF */
+
+/**
+ * ColorArray, a flat array of RGBA colors for bulk palette arithmetic.
+ */
+typedef struct
+{
+    PyObject_HEAD
+    Uint8 *data;            /* 4 bytes, RGBA, a color */
+    Py_ssize_t length;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} PyColorArray;
+
+static PyTypeObject PyColorArray_Type;
+#define PyColorArray_Check(o) PyObject_TypeCheck ((o), &PyColorArray_Type)
+
+static PyColorArray*
+_colorarray_new_internal (PyTypeObject *type, Py_ssize_t length)
+{
+    PyColorArray *array;
+
+    if (length > PY_SSIZE_T_MAX / 4)
+        return (PyColorArray *) PyErr_NoMemory ();
+    array = (PyColorArray *) type->tp_alloc (type, 0);
+    if (!array)
+        return NULL;
+    array->data = (Uint8 *) PyMem_Malloc (length ? length * 4 : 1);
+    if (!array->data)
+    {
+        Py_DECREF (array);
+        return (PyColorArray *) PyErr_NoMemory ();
+    }
+    array->length = length;
+    array->shape[0] = length;
+    array->shape[1] = 4;
+    array->strides[0] = 4;
+    array->strides[1] = 1;
+    return array;
+}
+
+/**
+ * ColorArray(size)
+ * ColorArray(colors)
+ */
+static PyObject*
+_colorarray_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    static char *kwids[] = {"colors", NULL};
+    static const Uint8 DEFAULT_RGBA[4] = {0, 0, 0, 255};
+    PyColorArray *array;
+    PyObject *obj;
+    PyObject *seq;
+    Py_ssize_t i;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O", kwids, &obj))
+        return NULL;
+
+    if (PyInt_Check (obj) || PyLong_Check (obj))
+    {
+        Py_ssize_t length = PyInt_AsSsize_t (obj);
+
+        if (length == -1 && PyErr_Occurred ())
+            return NULL;
+        if (length < 0)
+            return RAISE (PyExc_ValueError, "size must not be negative");
+        array = _colorarray_new_internal (type, length);
+        if (!array)
+            return NULL;
+        for (i = 0; i < length; ++i)
+            memcpy (array->data + i * 4, DEFAULT_RGBA, 4);
+        return (PyObject *) array;
+    }
+
+    seq = PySequence_Fast (obj, "expected a size or a sequence of colors");
+    if (!seq)
+        return NULL;
+    array = _colorarray_new_internal (type, PySequence_Fast_GET_SIZE (seq));
+    if (!array)
+    {
+        Py_DECREF (seq);
+        return NULL;
+    }
+    for (i = 0; i < array->length; ++i)
+    {
+        if (!RGBAFromColorObj (PySequence_Fast_GET_ITEM (seq, i),
+                               array->data + i * 4))
+        {
+            Py_DECREF (seq);
+            Py_DECREF (array);
+            return RAISE (PyExc_ValueError, "invalid color argument");
+        }
+    }
+    Py_DECREF (seq);
+    return (PyObject *) array;
+}
+
+static void
+_colorarray_dealloc (PyColorArray *array)
+{
+    PyMem_Free (array->data);
+    Py_TYPE (array)->tp_free ((PyObject *) array);
+}
+
+static PyObject*
+_colorarray_repr (PyColorArray *array)
+{
+    char buf[64];
+
+    PyOS_snprintf (buf, sizeof (buf), "<ColorArray(%ld)>",
+                   (long) array->length);
+    return Text_FromUTF8 (buf);
+}
+
+static Py_ssize_t
+_colorarray_length (PyColorArray *array)
+{
+    return array->length;
+}
+
+static PyObject*
+_colorarray_item (PyColorArray *array, Py_ssize_t _index)
+{
+    if (_index < 0 || _index >= array->length)
+        return RAISE (PyExc_IndexError, "invalid index");
+    return PyColor_New (array->data + _index * 4);
+}
+
+static int
+_colorarray_ass_item (PyColorArray *array, Py_ssize_t _index,
+                      PyObject *value)
+{
+    if (_index < 0 || _index >= array->length)
+    {
+        RAISE (PyExc_IndexError, "invalid index");
+        return -1;
+    }
+    if (!value)
+    {
+        RAISE (PyExc_TypeError, "ColorArray items cannot be deleted");
+        return -1;
+    }
+    if (!RGBAFromColorObj (value, array->data + _index * 4))
+    {
+        RAISE (PyExc_ValueError, "invalid color argument");
+        return -1;
+    }
+    return 0;
+}
+
+/* The colors of an arithmetic operand: those of a ColorArray, with a
+ * length, or one color, with a length of -1 and a step of 0.
+ * Returns 0 if obj is neither.
+ */
+static int
+_colorarray_operand (PyObject *obj, const Uint8 **data, Py_ssize_t *step,
+                     Py_ssize_t *length, Uint8 rgba[])
+{
+    if (PyColorArray_Check (obj))
+    {
+        *data = ((PyColorArray *) obj)->data;
+        *step = 4;
+        *length = ((PyColorArray *) obj)->length;
+        return 1;
+    }
+    *data = rgba;
+    *step = 0;
+    *length = -1;
+    return _coerce_obj (obj, rgba);
+}
+
+static PyObject*
+_colorarray_binop (PyObject *obj1, PyObject *obj2, ColorOp op)
+{
+    Uint8 rgba1[4], rgba2[4];
+    const Uint8 *a, *b;
+    Py_ssize_t a_step, b_step, length1, length2;
+    PyColorArray *result;
+    int rc;
+
+    rc = _colorarray_operand (obj1, &a, &a_step, &length1, rgba1);
+    if (rc > 0)
+        rc = _colorarray_operand (obj2, &b, &b_step, &length2, rgba2);
+    if (rc < 0)
+        return NULL;
+    if (rc == 0)
+    {
+        Py_INCREF (Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    if (length1 >= 0 && length2 >= 0 && length1 != length2)
+        return RAISE (PyExc_ValueError,
+                      "ColorArrays must have the same length");
+
+    result = _colorarray_new_internal (
+        Py_TYPE (length1 >= 0 ? obj1 : obj2),
+        length1 >= 0 ? length1 : length2);
+    if (!result)
+        return NULL;
+    _color_op_pixels (op, a, a_step, b, b_step, result->data,
+                      result->length);
+    return (PyObject *) result;
+}
+
+static PyObject*
+_colorarray_inplace_op (PyObject *obj1, PyObject *obj2, ColorOp op)
+{
+    PyColorArray *array = (PyColorArray *) obj1;
+    Uint8 rgba[4];
+    const Uint8 *b;
+    Py_ssize_t b_step, length;
+    int rc;
+
+    rc = _colorarray_operand (obj2, &b, &b_step, &length, rgba);
+    if (rc < 0)
+        return NULL;
+    if (rc == 0)
+    {
+        Py_INCREF (Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    if (length >= 0 && length != array->length)
+        return RAISE (PyExc_ValueError,
+                      "ColorArrays must have the same length");
+
+    _color_op_pixels (op, array->data, 4, b, b_step, array->data,
+                      array->length);
+    Py_INCREF (obj1);
+    return obj1;
+}
+
+static PyObject*
+_colorarray_add (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_binop (obj1, obj2, COLOR_ADD);
+}
+
+static PyObject*
+_colorarray_sub (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_binop (obj1, obj2, COLOR_SUB);
+}
+
+static PyObject*
+_colorarray_mul (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_binop (obj1, obj2, COLOR_MUL);
+}
+
+static PyObject*
+_colorarray_div (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_binop (obj1, obj2, COLOR_DIV);
+}
+
+static PyObject*
+_colorarray_mod (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_binop (obj1, obj2, COLOR_MOD);
+}
+
+static PyObject*
+_colorarray_iadd (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_inplace_op (obj1, obj2, COLOR_ADD);
+}
+
+static PyObject*
+_colorarray_isub (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_inplace_op (obj1, obj2, COLOR_SUB);
+}
+
+static PyObject*
+_colorarray_imul (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_inplace_op (obj1, obj2, COLOR_MUL);
+}
+
+static PyObject*
+_colorarray_idiv (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_inplace_op (obj1, obj2, COLOR_DIV);
+}
+
+static PyObject*
+_colorarray_imod (PyObject *obj1, PyObject *obj2)
+{
+    return _colorarray_inplace_op (obj1, obj2, COLOR_MOD);
+}
+
+#if PG_ENABLE_NEWBUF
+static int
+_colorarray_getbuffer (PyColorArray *array, Py_buffer *view, int flags)
+{
+    static char format[] = "B";
+
+    view->buf = array->data;
+    view->len = array->length * 4;
+    view->itemsize = 1;
+    view->readonly = 0;
+    if (PyBUF_HAS_FLAG (flags, PyBUF_ND)) {
+        view->ndim = 2;
+        view->shape = array->shape;
+    }
+    else {
+        view->ndim = 1;
+        view->shape = 0;
+    }
+    view->format = PyBUF_HAS_FLAG (flags, PyBUF_FORMAT) ? format : 0;
+    view->strides = (PyBUF_HAS_FLAG (flags, PyBUF_STRIDES) ?
+                     array->strides : 0);
+    view->suboffsets = 0;
+    view->internal = 0;
+    Py_INCREF (array);
+    view->obj = (PyObject *) array;
+    return 0;
+}
+
+static PyBufferProcs _colorarray_as_buffer = {
+#if HAVE_OLD_BUFPROTO
+    0,
+    0,
+    0,
+    0,
+#endif
+    (getbufferproc) _colorarray_getbuffer,
+    0
+};
+#endif /* PG_ENABLE_NEWBUF */
+
+static PyNumberMethods _colorarray_as_number =
+{
+    (binaryfunc) _colorarray_add,   /* nb_add */
+    (binaryfunc) _colorarray_sub,   /* nb_subtract */
+    (binaryfunc) _colorarray_mul,   /* nb_multiply */
+#if !PY3
+    (binaryfunc) _colorarray_div,   /* nb_divide */
+#endif
+    (binaryfunc) _colorarray_mod,   /* nb_remainder */
+    0,                              /* nb_divmod */
+    0,                              /* nb_power */
+    0,                              /* nb_negative */
+    0,                              /* nb_positive */
+    0,                              /* nb_absolute */
+    0,                              /* nb_nonzero / nb_bool*/
+    0,                              /* nb_invert */
+    0,                              /* nb_lshift */
+    0,                              /* nb_rshift */
+    0,                              /* nb_and */
+    0,                              /* nb_xor */
+    0,                              /* nb_or */
+#if !PY3
+    0,                              /* nb_coerce */
+#endif
+    0,                              /* nb_int */
+    0,                              /* nb_long / nb_reserved */
+    0,                              /* nb_float */
+#if !PY3
+    0,                              /* nb_oct */
+    0,                              /* nb_hex */
+#endif
+    (binaryfunc) _colorarray_iadd,  /* nb_inplace_add */
+    (binaryfunc) _colorarray_isub,  /* nb_inplace_subtract */
+    (binaryfunc) _colorarray_imul,  /* nb_inplace_multiply */
+#if !PY3
+    (binaryfunc) _colorarray_idiv,  /* nb_inplace_divide */
+#endif
+    (binaryfunc) _colorarray_imod,  /* nb_inplace_remainder */
+    0,                              /* nb_inplace_power */
+    0,                              /* nb_inplace_lshift */
+    0,                              /* nb_inplace_rshift */
+    0,                              /* nb_inplace_and */
+    0,                              /* nb_inplace_xor */
+    0,                              /* nb_inplace_or */
+    (binaryfunc) _colorarray_div,   /* nb_floor_divide */
+    0,                              /* nb_true_divide */
+    (binaryfunc) _colorarray_idiv,  /* nb_inplace_floor_divide */
+    0,                              /* nb_inplace_true_divide */
+};
+
+static PySequenceMethods _colorarray_as_sequence =
+{
+    (lenfunc) _colorarray_length,           /* sq_length */
+    NULL,                                   /* sq_concat */
+    NULL,                                   /* sq_repeat */
+    (ssizeargfunc) _colorarray_item,        /* sq_item */
+    NULL,                                   /* sq_slice */
+    (ssizeobjargproc) _colorarray_ass_item, /* sq_ass_item */
+    NULL,                                   /* sq_ass_slice */
+    NULL,                                   /* sq_contains */
+    NULL,                                   /* sq_inplace_concat */
+    NULL,                                   /* sq_inplace_repeat */
+};
+
+static PyTypeObject PyColorArray_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "pygame.ColorArray",        /* tp_name */
+    sizeof (PyColorArray),      /* tp_basicsize */
+    0,                          /* tp_itemsize */
+    (destructor) _colorarray_dealloc, /* tp_dealloc */
+    0,                          /* tp_print */
+    0,                          /* tp_getattr */
+    0,                          /* tp_setattr */
+    0,                          /* tp_compare */
+    (reprfunc) _colorarray_repr, /* tp_repr */
+    &_colorarray_as_number,     /* tp_as_number */
+    &_colorarray_as_sequence,   /* tp_as_sequence */
+    0,                          /* tp_as_mapping */
+    0,                          /* tp_hash */
+    0,                          /* tp_call */
+    0,                          /* tp_str */
+    0,                          /* tp_getattro */
+    0,                          /* tp_setattro */
+#if PG_ENABLE_NEWBUF
+    &_colorarray_as_buffer,     /* tp_as_buffer */
+#else
+    0,                          /* tp_as_buffer */
+#endif
+    COLOR_TPFLAGS,              /* tp_flags */
+    DOC_PYGAMECOLORARRAY,       /* tp_doc */
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    0,                          /* tp_methods */
+    0,                          /* tp_members */
+    0,                          /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                          /* tp_alloc */
+    _colorarray_new,            /* tp_new */
+};
+
+static PyMethodDef _color_module_methods[] =
+{
+    { "set_freelist_size", _color_set_freelist_size, METH_VARARGS,
+      "set_freelist_size(size) -> None\n"
+      "set how many dead Colors are kept for reuse" },
+    { "get_freelist_stats", (PyCFunction) _color_get_freelist_stats,
+      METH_NOARGS,
+      "get_freelist_stats() -> (size, count, hits, misses)\n"
+      "get the state of the free list of Colors" },
+#if PG_ENABLE_NEWBUF
+    { "rgb_to_hsv", (PyCFunction) _color_rgb_to_hsv,
+      METH_VARARGS | METH_KEYWORDS,
+      "rgb_to_hsv(buffer, channels=3) -> None\n"
+      "convert a writable buffer of RGB or RGBA bytes to HSV in place" },
+    { "hsv_to_rgb", (PyCFunction) _color_hsv_to_rgb,
+      METH_VARARGS | METH_KEYWORDS,
+      "hsv_to_rgb(buffer, channels=3) -> None\n"
+      "convert a writable buffer of HSV or HSVA bytes to RGB in place" },
+    { "correct_gamma", (PyCFunction) _color_correct_gamma_buffer,
+      METH_VARARGS | METH_KEYWORDS,
+      "correct_gamma(buffer, gamma, channels=3) -> None\n"
+      "gamma correct a writable buffer of RGB or RGBA bytes in place" },
+#endif
+#if PY3
+    /* Python 3 builds have always had these in the module too */
+    { "normalize", (PyCFunction) _color_normalize, METH_NOARGS,
+      DOC_COLORNORMALIZE },
+#if !PG_ENABLE_NEWBUF
+    { "correct_gamma", (PyCFunction) _color_correct_gamma, METH_VARARGS,
+      DOC_COLORCORRECTGAMMA },
+#endif
+    { "set_length", (PyCFunction) _color_set_length, METH_VARARGS,
+      DOC_COLORSETLENGTH },
+#endif
+    { NULL, NULL, 0, NULL }
+};
+
 /*DOC*/ static char _color_doc[] =
 /*DOC*/    "color module for pygame";
 
@@ -2001,6 +2758,10 @@ MODINIT_DEFINE (color)
     PyObject *colordict;
     PyObject *module;
     PyObject *apiobj;
+#if PG_ENABLE_NEWBUF
+    PyObject *get, *set;
+    int ecode;
+#endif
     static void* c_api[PYGAMEAPI_COLOR_NUMSLOTS];
 
 #if PY3
@@ -2009,7 +2770,7 @@ MODINIT_DEFINE (color)
         "color",
         _color_doc,
         -1,
-        _color_methods,
+        _color_module_methods,
         NULL, NULL, NULL, NULL
     };
 #endif
@@ -2037,7 +2798,8 @@ MODINIT_DEFINE (color)
     }
 
     /* type preparation */
-    if (PyType_Ready (&PyColor_Type) < 0)
+    if (PyType_Ready (&PyColor_Type) < 0 ||
+        PyType_Ready (&PyColorArray_Type) < 0)
     {
         Py_DECREF (_COLORDICT);
         MODINIT_ERROR;
@@ -2047,7 +2809,8 @@ MODINIT_DEFINE (color)
 #if PY3
     module = PyModule_Create (&_module);
 #else
-    module = Py_InitModule3 ( MODPREFIX "color", NULL, _color_doc);
+    module = Py_InitModule3 ( MODPREFIX "color", _color_module_methods,
+                             _color_doc);
 #endif
     if (module == NULL) {
         Py_DECREF (_COLORDICT);
@@ -2061,6 +2824,14 @@ MODINIT_DEFINE (color)
         DECREF_MOD(module);
         MODINIT_ERROR;
     }
+    Py_INCREF (&PyColorArray_Type);
+    if (PyModule_AddObject (module, "ColorArray",
+                            (PyObject *) &PyColorArray_Type)) {
+        Py_DECREF (&PyColorArray_Type);
+        Py_DECREF (_COLORDICT);
+        DECREF_MOD(module);
+        MODINIT_ERROR;
+    }
     Py_INCREF (_COLORDICT);
     if (PyModule_AddObject (module, "THECOLORS", _COLORDICT)) {
         Py_DECREF (_COLORDICT);
@@ -2086,5 +2857,19 @@ MODINIT_DEFINE (color)
         DECREF_MOD(module);
         MODINIT_ERROR;
     }
+
+#if PG_ENABLE_NEWBUF
+    /* let pygame.set_simd_backend switch the buffer conversions */
+    get = PyCFunction_New (_color_simd_methods, NULL);
+    set = PyCFunction_New (_color_simd_methods + 1, NULL);
+    ecode = !get || !set || PgSimd_Register ("color", get, set);
+    Py_XDECREF (get);
+    Py_XDECREF (set);
+    if (ecode) {
+        Py_DECREF (_COLORDICT);
+        DECREF_MOD(module);
+        MODINIT_ERROR;
+    }
+#endif
     MODINIT_RETURN (module);
 }
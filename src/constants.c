@@ -23,6 +23,7 @@
 #include "pygame.h"
 #include "pgcompat.h"
 #include "scrap.h"
+#include "pgopengl.h"
 
 /* macros used to create each constant */
 #define ADD_ERROR { DECREF_MOD (module); MODINIT_ERROR; }
@@ -93,6 +94,7 @@ MODINIT_DEFINE(constants)
     DEC_CONST(ASYNCBLIT);
     DEC_CONST(OPENGL);
     DEC_CONST(OPENGLBLIT);
+    DEC_CONSTS(GLBLIT, PG_GLBLIT);
     DEC_CONST(ANYFORMAT);
     DEC_CONST(HWPALETTE);
     DEC_CONST(DOUBLEBUF);
@@ -201,6 +203,8 @@ MODINIT_DEFINE(constants)
 
 #define PYGAME_BLEND_PREMULTIPLIED  0x11
 
+#define PYGAME_BLIT_THREADED  0x100
+
 
     DEC_CONSTS(BLEND_ADD,  PYGAME_BLEND_ADD);
     DEC_CONSTS(BLEND_SUB,  PYGAME_BLEND_SUB);
@@ -221,6 +225,8 @@ MODINIT_DEFINE(constants)
     DEC_CONSTS(BLEND_RGBA_MAX,  PYGAME_BLEND_RGBA_MAX);
     DEC_CONSTS(BLEND_PREMULTIPLIED,  PYGAME_BLEND_PREMULTIPLIED);
 
+    DEC_CONSTS(BLIT_THREADED,  PYGAME_BLIT_THREADED);
+
 
 
     DEC_CONST(NOEVENT);
@@ -27,6 +27,7 @@
 #include "pygame.h"
 #include "pgcompat.h"
 #include "doc/display_doc.h"
+#include "pgopengl.h"
 #include <SDL_syswm.h>
 
 
@@ -128,10 +129,618 @@ display_resource_end:
 }
 #endif
 
+/* Managed presenting: present() pushes the damage of the display surface,
+ * all of it once it covers more than present_threshold of the display.
+ * A double buffered display keeps a copy of the damaged areas in
+ * present_back, to bring the other buffer up to date after a flip.
+ */
+static int present_managed = 0;
+static double present_threshold = 0.5;
+static SDL_Surface* present_back = NULL;
+/* Most damaged areas present() pushes one by one */
+#define PRESENT_MAX_RECTS 256
+
+static void
+present_end (void)
+{
+    if (present_back)
+    {
+        SDL_FreeSurface (present_back);
+        present_back = NULL;
+    }
+    present_managed = 0;
+}
+
+/* GLBLIT displays: the display surface is a software surface, and flip(),
+ * update() and present() stream it into a texture drawn scaled to fill an
+ * OPENGL window. Whole frames go through two pixel buffer objects in turn,
+ * when the driver has them, so one upload need not wait for the last.
+ */
+/* Uploaded as GL_BGRA words, the same on either byte order */
+#define GLBLIT_MASKS 0x00ff0000, 0x0000ff00, 0x000000ff, 0
+
+static struct
+{
+    SDL_Surface* screen;        /* the software surface drawn to */
+    int integer;                /* scale by whole multiples only */
+    unsigned int texture;
+    int tex_w, tex_h;
+    unsigned int pbos[2];       /* both 0 without pixel buffer objects */
+    int pbo_next;
+    float quad[4];              /* left, top, right, bottom */
+
+    GL_glGetString_Func GetString;
+    GL_glGenTextures_Func GenTextures;
+    GL_glDeleteTextures_Func DeleteTextures;
+    GL_glBindTexture_Func BindTexture;
+    GL_glTexParameteri_Func TexParameteri;
+    GL_glTexImage2D_Func TexImage2D;
+    GL_glTexSubImage2D_Func TexSubImage2D;
+    GL_glPixelStorei_Func PixelStorei;
+    GL_glViewport_Func Viewport;
+    GL_glClearColor_Func ClearColor;
+    GL_glClear_Func Clear;
+    GL_glEnable_Func Enable;
+    GL_glDisable_Func Disable;
+    GL_glMatrixMode_Func MatrixMode;
+    GL_glLoadIdentity_Func LoadIdentity;
+    GL_glBegin_Func Begin;
+    GL_glEnd_Func End;
+    GL_glTexCoord2f_Func TexCoord2f;
+    GL_glVertex2f_Func Vertex2f;
+    GL_glGenBuffers_Func GenBuffers;
+    GL_glDeleteBuffers_Func DeleteBuffers;
+    GL_glBindBuffer_Func BindBuffer;
+    GL_glBufferData_Func BufferData;
+    GL_glMapBuffer_Func MapBuffer;
+    GL_glUnmapBuffer_Func UnmapBuffer;
+} glblit;
+
+/* A GL function, by its core name or else its ARB extension name */
+static void*
+glblit_proc (const char* name)
+{
+    char arbname[64];
+    void* proc = SDL_GL_GetProcAddress (name);
+
+    if (!proc)
+    {
+        PyOS_snprintf (arbname, sizeof (arbname), "%sARB", name);
+        proc = SDL_GL_GetProcAddress (arbname);
+    }
+    return proc;
+}
+
+static int
+glblit_has_pbo (void)
+{
+    const char* version;
+    const char* extensions;
+
+    if (!glblit.GenBuffers || !glblit.DeleteBuffers || !glblit.BindBuffer ||
+        !glblit.BufferData || !glblit.MapBuffer || !glblit.UnmapBuffer)
+        return 0;
+    version = (const char*) glblit.GetString (PG_GL_VERSION);
+    if (version && (version[0] > '2' ||
+                    (version[0] == '2' && version[1] == '.' &&
+                     version[2] >= '1')))
+        return 1;
+    extensions = (const char*) glblit.GetString (PG_GL_EXTENSIONS);
+    return extensions &&
+        (strstr (extensions, "GL_ARB_pixel_buffer_object") ||
+         strstr (extensions, "GL_EXT_pixel_buffer_object"));
+}
+
+/* Returns 0, or -1 with an exception set */
+static int
+glblit_load (void)
+{
+#define GLBLIT_LOAD(name)                                         \
+    glblit.name = (GL_gl##name##_Func) SDL_GL_GetProcAddress ("gl" #name); \
+    if (!glblit.name)                                             \
+    {                                                             \
+        PyErr_SetString (PyExc_SDLError,                          \
+                         "Cannot find gl" #name " for GLBLIT");   \
+        return -1;                                                \
+    }
+    GLBLIT_LOAD (GetString);
+    GLBLIT_LOAD (GenTextures);
+    GLBLIT_LOAD (DeleteTextures);
+    GLBLIT_LOAD (BindTexture);
+    GLBLIT_LOAD (TexParameteri);
+    GLBLIT_LOAD (TexImage2D);
+    GLBLIT_LOAD (TexSubImage2D);
+    GLBLIT_LOAD (PixelStorei);
+    GLBLIT_LOAD (Viewport);
+    GLBLIT_LOAD (ClearColor);
+    GLBLIT_LOAD (Clear);
+    GLBLIT_LOAD (Enable);
+    GLBLIT_LOAD (Disable);
+    GLBLIT_LOAD (MatrixMode);
+    GLBLIT_LOAD (LoadIdentity);
+    GLBLIT_LOAD (Begin);
+    GLBLIT_LOAD (End);
+    GLBLIT_LOAD (TexCoord2f);
+    GLBLIT_LOAD (Vertex2f);
+#undef GLBLIT_LOAD
+
+    glblit.GenBuffers = (GL_glGenBuffers_Func) glblit_proc ("glGenBuffers");
+    glblit.DeleteBuffers =
+        (GL_glDeleteBuffers_Func) glblit_proc ("glDeleteBuffers");
+    glblit.BindBuffer = (GL_glBindBuffer_Func) glblit_proc ("glBindBuffer");
+    glblit.BufferData = (GL_glBufferData_Func) glblit_proc ("glBufferData");
+    glblit.MapBuffer = (GL_glMapBuffer_Func) glblit_proc ("glMapBuffer");
+    glblit.UnmapBuffer =
+        (GL_glUnmapBuffer_Func) glblit_proc ("glUnmapBuffer");
+    return 0;
+}
+
+/* Place the quad the screen is drawn on in the window */
+static void
+glblit_layout (void)
+{
+    SDL_Surface* window = SDL_GetVideoSurface ();
+    int w = glblit.screen->w;
+    int h = glblit.screen->h;
+    double scale = MIN ((double) window->w / w, (double) window->h / h);
+    int qw, qh, left, top;
+
+    /* Whole multiples, unless the window is smaller than the screen */
+    if (glblit.integer && scale >= 1.0)
+        scale = (int) scale;
+    qw = (int) (w * scale + 0.5);
+    qh = (int) (h * scale + 0.5);
+    left = (window->w - qw) / 2;
+    top = (window->h - qh) / 2;
+    glblit.quad[0] = 2.0f * left / window->w - 1.0f;
+    glblit.quad[1] = 1.0f - 2.0f * top / window->h;
+    glblit.quad[2] = 2.0f * (left + qw) / window->w - 1.0f;
+    glblit.quad[3] = 1.0f - 2.0f * (top + qh) / window->h;
+
+    glblit.Viewport (0, 0, window->w, window->h);
+    glblit.BindTexture (PG_GL_TEXTURE_2D, glblit.texture);
+    glblit.TexParameteri (PG_GL_TEXTURE_2D, PG_GL_TEXTURE_MIN_FILTER,
+                          glblit.integer ? PG_GL_NEAREST : PG_GL_LINEAR);
+    glblit.TexParameteri (PG_GL_TEXTURE_2D, PG_GL_TEXTURE_MAG_FILTER,
+                          glblit.integer ? PG_GL_NEAREST : PG_GL_LINEAR);
+}
+
+/* Free the screen, and its texture while the GL context lives on */
+static void
+glblit_free_screen (int with_context)
+{
+    if (!glblit.screen)
+        return;
+    if (with_context)
+    {
+        glblit.DeleteTextures (1, &glblit.texture);
+        if (glblit.pbos[0])
+            glblit.DeleteBuffers (2, glblit.pbos);
+    }
+    if (DisplaySurfaceObject &&
+        PySurface_AsSurface (DisplaySurfaceObject) == glblit.screen)
+        PySurface_AsSurface (DisplaySurfaceObject) = NULL;
+    SDL_FreeSurface (glblit.screen);
+    glblit.screen = NULL;
+    glblit.texture = 0;
+    glblit.pbos[0] = glblit.pbos[1] = 0;
+}
+
+static void
+glblit_end (void)
+{
+    glblit_free_screen (0);
+    glblit.integer = 0;
+}
+
+/* Make a w by h screen, with its texture, for the current GL context.
+ * Returns 0, or -1 with an exception set.
+ */
+static int
+glblit_begin (int w, int h)
+{
+    int tex_w = 1, tex_h = 1;
+
+    glblit.screen = SDL_CreateRGBSurface (SDL_SWSURFACE, w, h, 32,
+                                          GLBLIT_MASKS);
+    if (!glblit.screen)
+    {
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+        return -1;
+    }
+    SDL_FillRect (glblit.screen, NULL, 0);
+
+    /* Power of two sizes, for GL before 2.0 */
+    while (tex_w < w)
+        tex_w <<= 1;
+    while (tex_h < h)
+        tex_h <<= 1;
+    glblit.tex_w = tex_w;
+    glblit.tex_h = tex_h;
+    glblit.GenTextures (1, &glblit.texture);
+    glblit.BindTexture (PG_GL_TEXTURE_2D, glblit.texture);
+    glblit.TexParameteri (PG_GL_TEXTURE_2D, PG_GL_TEXTURE_WRAP_S,
+                          PG_GL_CLAMP_TO_EDGE);
+    glblit.TexParameteri (PG_GL_TEXTURE_2D, PG_GL_TEXTURE_WRAP_T,
+                          PG_GL_CLAMP_TO_EDGE);
+    glblit.TexImage2D (PG_GL_TEXTURE_2D, 0, PG_GL_RGB8, tex_w, tex_h, 0,
+                       PG_GL_BGRA, PG_GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
+    glblit.PixelStorei (PG_GL_UNPACK_ALIGNMENT, 4);
+
+    if (glblit_has_pbo ())
+    {
+        glblit.GenBuffers (2, glblit.pbos);
+        glblit.pbo_next = 0;
+    }
+
+    glblit.Disable (PG_GL_DEPTH_TEST);
+    glblit.Disable (PG_GL_BLEND);
+    glblit.Enable (PG_GL_TEXTURE_2D);
+    glblit.MatrixMode (PG_GL_PROJECTION);
+    glblit.LoadIdentity ();
+    glblit.MatrixMode (PG_GL_MODELVIEW);
+    glblit.LoadIdentity ();
+    glblit.ClearColor (0.0f, 0.0f, 0.0f, 1.0f);
+    glblit_layout ();
+    return 0;
+}
+
+/* Upload the rects of the screen, or all of it for a count of 0, draw it
+ * and swap. Called without the GIL.
+ */
+static void
+glblit_present (SDL_Rect* rects, int count)
+{
+    SDL_Surface* screen = glblit.screen;
+    Uint8* pixels = (Uint8*) screen->pixels;
+    int size = screen->pitch * screen->h;
+    unsigned int pbo;
+    void* mapped = NULL;
+    int loop;
+
+    glblit.BindTexture (PG_GL_TEXTURE_2D, glblit.texture);
+    glblit.PixelStorei (PG_GL_UNPACK_ROW_LENGTH, screen->pitch / 4);
+    if (!count && glblit.pbos[0])
+    {
+        pbo = glblit.pbos[glblit.pbo_next];
+        glblit.pbo_next ^= 1;
+        glblit.BindBuffer (PG_GL_PIXEL_UNPACK_BUFFER, pbo);
+        /* Orphan the old contents, so the map need not wait for them */
+        glblit.BufferData (PG_GL_PIXEL_UNPACK_BUFFER, size, NULL,
+                           PG_GL_STREAM_DRAW);
+        mapped = glblit.MapBuffer (PG_GL_PIXEL_UNPACK_BUFFER,
+                                   PG_GL_WRITE_ONLY);
+        if (mapped)
+        {
+            memcpy (mapped, pixels, size);
+            glblit.UnmapBuffer (PG_GL_PIXEL_UNPACK_BUFFER);
+            glblit.TexSubImage2D (PG_GL_TEXTURE_2D, 0, 0, 0, screen->w,
+                                  screen->h, PG_GL_BGRA,
+                                  PG_GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
+        }
+        glblit.BindBuffer (PG_GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    if (!count && !mapped)
+        glblit.TexSubImage2D (PG_GL_TEXTURE_2D, 0, 0, 0, screen->w,
+                              screen->h, PG_GL_BGRA,
+                              PG_GL_UNSIGNED_INT_8_8_8_8_REV, pixels);
+    for (loop = 0; loop < count; ++loop)
+        glblit.TexSubImage2D (PG_GL_TEXTURE_2D, 0, rects[loop].x,
+                              rects[loop].y, rects[loop].w, rects[loop].h,
+                              PG_GL_BGRA, PG_GL_UNSIGNED_INT_8_8_8_8_REV,
+                              pixels + rects[loop].y * screen->pitch +
+                              rects[loop].x * 4);
+    glblit.PixelStorei (PG_GL_UNPACK_ROW_LENGTH, 0);
+
+    glblit.Clear (PG_GL_COLOR_BUFFER_BIT);
+    glblit.Begin (PG_GL_QUADS);
+    glblit.TexCoord2f (0.0f, 0.0f);
+    glblit.Vertex2f (glblit.quad[0], glblit.quad[1]);
+    glblit.TexCoord2f ((float) screen->w / glblit.tex_w, 0.0f);
+    glblit.Vertex2f (glblit.quad[2], glblit.quad[1]);
+    glblit.TexCoord2f ((float) screen->w / glblit.tex_w,
+                       (float) screen->h / glblit.tex_h);
+    glblit.Vertex2f (glblit.quad[2], glblit.quad[3]);
+    glblit.TexCoord2f (0.0f, (float) screen->h / glblit.tex_h);
+    glblit.Vertex2f (glblit.quad[0], glblit.quad[3]);
+    glblit.End ();
+    SDL_GL_SwapBuffers ();
+}
+
+/* Asynchronous present: the display surface draws to one of two software
+ * buffers in the display format, while a thread copies the other to the
+ * pixels of the display. SDL 1.2 video calls must stay on the main thread,
+ * so the copy is pushed to the screen there, by the next flip(), update()
+ * or wait_present(). Each of those waits for the copy to finish and pushes
+ * it, then flip() and update() hand the buffer drawn to over and draw to
+ * the other.
+ */
+static struct
+{
+    SDL_Surface* back[2];
+    int current;                /* the buffer drawn to */
+    SDL_Thread* thread;
+    SDL_mutex* lock;
+    SDL_cond* changed;          /* signalled for a copy, or one done */
+    SDL_Surface* pending;       /* the buffer being copied, if any */
+    Uint8* pixels;              /* the display pixels it is copied to */
+    int pitch;
+    SDL_Rect* rects;            /* its areas to copy, all of it for 0 */
+    int count;
+    int size;                   /* room in rects */
+    int unpushed;               /* the copy is still to be pushed */
+    int quit;
+} async_present;
+
+/* Copy the rects of src, or all of it for a count of 0, to pixels with
+ * pitch. Both are in the display format.
+ */
+static void
+async_present_copy (SDL_Surface* src, Uint8* pixels, int pitch,
+                    SDL_Rect* rects, int count)
+{
+    SDL_Rect all;
+    int bpp = src->format->BytesPerPixel;
+    int loop, y;
+
+    if (!count)
+    {
+        all.x = all.y = 0;
+        all.w = src->w;
+        all.h = src->h;
+        rects = &all;
+        count = 1;
+    }
+    for (loop = 0; loop < count; ++loop)
+        for (y = rects[loop].y; y < rects[loop].y + rects[loop].h; ++y)
+            memcpy (pixels + y * pitch + rects[loop].x * bpp,
+                    (Uint8*) src->pixels + y * src->pitch +
+                    rects[loop].x * bpp,
+                    rects[loop].w * bpp);
+}
+
+static int
+async_present_worker (void* data)
+{
+    SDL_Surface* back;
+
+    SDL_LockMutex (async_present.lock);
+    for (;;)
+    {
+        while (!async_present.pending && !async_present.quit)
+            SDL_CondWait (async_present.changed, async_present.lock);
+        if (!async_present.pending)
+            break;
+        back = async_present.pending;
+        SDL_UnlockMutex (async_present.lock);
+
+        /* Memory only; no SDL video call is made off the main thread */
+        async_present_copy (back, async_present.pixels, async_present.pitch,
+                            async_present.rects, async_present.count);
+
+        SDL_LockMutex (async_present.lock);
+        async_present.pending = NULL;
+        SDL_CondBroadcast (async_present.changed);
+    }
+    SDL_UnlockMutex (async_present.lock);
+    return 0;
+}
+
+/* Wait with the GIL released for the last copy to finish, then push it to
+ * the screen. Returns 0 with pygame.error set if the push failed.
+ */
+static int
+async_present_wait (void)
+{
+    SDL_Surface* video;
+    int status = 0;
+
+    if (!async_present.thread)
+        return 1;
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex (async_present.lock);
+    while (async_present.pending)
+        SDL_CondWait (async_present.changed, async_present.lock);
+    SDL_UnlockMutex (async_present.lock);
+    Py_END_ALLOW_THREADS;
+
+    if (!async_present.unpushed)
+        return 1;
+    async_present.unpushed = 0;
+    video = SDL_GetVideoSurface ();
+    if (!video)
+        return 1;
+    Py_BEGIN_ALLOW_THREADS;
+    if (!async_present.count)
+        status = SDL_Flip (video);
+    else
+        SDL_UpdateRects (video, async_present.count, async_present.rects);
+    Py_END_ALLOW_THREADS;
+    if (status)
+    {
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+        return 0;
+    }
+    return 1;
+}
+
+/* Stop the thread and free the buffers, so the display surface draws to
+ * the display again. With keep, the display gets the frame drawn so far.
+ */
+static void
+async_present_end (int keep)
+{
+    SDL_Surface* video;
+
+    if (!async_present.thread)
+        return;
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex (async_present.lock);
+    async_present.quit = 1;
+    SDL_CondBroadcast (async_present.changed);
+    SDL_UnlockMutex (async_present.lock);
+    SDL_WaitThread (async_present.thread, NULL);
+    Py_END_ALLOW_THREADS;
+    async_present.thread = NULL;
+    async_present.quit = 0;
+    async_present.unpushed = 0;
+
+    video = SDL_GetVideoSurface ();
+    if (keep && video)
+        SDL_BlitSurface (async_present.back[async_present.current], NULL,
+                         video, NULL);
+    if (DisplaySurfaceObject &&
+        PySurface_AsSurface (DisplaySurfaceObject) ==
+        async_present.back[async_present.current])
+    {
+        PySurface_DropRLE (DisplaySurfaceObject);
+        PySurface_AsSurface (DisplaySurfaceObject) = video;
+    }
+    SDL_FreeSurface (async_present.back[0]);
+    SDL_FreeSurface (async_present.back[1]);
+    async_present.back[0] = async_present.back[1] = NULL;
+    async_present.current = 0;
+    free (async_present.rects);
+    async_present.rects = NULL;
+    async_present.count = async_present.size = 0;
+}
+
+/* Make the buffers, each a copy of the display, and start the thread.
+ * Returns 0, or -1 with an exception set.
+ */
+static int
+async_present_begin (void)
+{
+    SDL_Surface* video = SDL_GetVideoSurface ();
+    SDL_PixelFormat* format = video->format;
+    int loop;
+
+    for (loop = 0; loop < 2; ++loop)
+    {
+        async_present.back[loop] =
+            SDL_CreateRGBSurface (SDL_SWSURFACE, video->w, video->h,
+                                  format->BitsPerPixel, format->Rmask,
+                                  format->Gmask, format->Bmask,
+                                  format->Amask);
+        if (!async_present.back[loop])
+            goto error;
+        /* Copied to the display as they are, never blended */
+        SDL_SetAlpha (async_present.back[loop], 0, 255);
+        if (format->palette)
+            SDL_SetColors (async_present.back[loop], format->palette->colors,
+                           0, format->palette->ncolors);
+        if (SDL_BlitSurface (video, NULL, async_present.back[loop], NULL))
+            goto error;
+    }
+
+    if (!async_present.lock && !(async_present.lock = SDL_CreateMutex ()))
+        goto error;
+    if (!async_present.changed &&
+        !(async_present.changed = SDL_CreateCond ()))
+        goto error;
+    async_present.thread = SDL_CreateThread (async_present_worker, NULL);
+    if (!async_present.thread)
+        goto error;
+
+    async_present.current = 0;
+    PySurface_DropRLE (DisplaySurfaceObject);
+    PySurface_AsSurface (DisplaySurfaceObject) = async_present.back[0];
+    return 0;
+
+error:
+    PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+    SDL_FreeSurface (async_present.back[0]);
+    SDL_FreeSurface (async_present.back[1]);
+    async_present.back[0] = async_present.back[1] = NULL;
+    return -1;
+}
+
+/* Push the last present, then hand the buffer drawn to over to copy the
+ * rects of, or all of it for a count of 0, and draw to the other. The
+ * rects are copied across, so the buffer drawn to next matches the
+ * display in them. Returns 0, or -1 with an exception set.
+ */
+static int
+async_present_swap (SDL_Rect* rects, int count)
+{
+    PySurfaceObject* display = (PySurfaceObject*) DisplaySurfaceObject;
+    SDL_Surface* video = SDL_GetVideoSurface ();
+    SDL_Surface* done;
+    SDL_Surface* next;
+    SDL_Rect* grown;
+
+    /* Pixel views of the display would be left on the presented buffer */
+    if (display->selflocks ||
+        (display->locklist && PyList_GET_SIZE (display->locklist)))
+    {
+        PyErr_SetString (PyExc_SDLError,
+                         "Cannot present a locked display surface");
+        return -1;
+    }
+    if (display->subsurfaces)
+    {
+        PyErr_SetString (PyExc_SDLError,
+                         "Cannot present a display surface with subsurfaces"
+                         " asynchronously");
+        return -1;
+    }
+    if (!async_present_wait ())
+        return -1;
+    if (count > async_present.size)
+    {
+        grown = (SDL_Rect*) realloc (async_present.rects,
+                                     count * sizeof (SDL_Rect));
+        if (!grown)
+        {
+            PyErr_NoMemory ();
+            return -1;
+        }
+        async_present.rects = grown;
+        async_present.size = count;
+    }
+    if (count)
+        memcpy (async_present.rects, rects, count * sizeof (SDL_Rect));
+    async_present.count = count;
+    async_present.pixels = (Uint8*) video->pixels;
+    async_present.pitch = video->pitch;
+    async_present.unpushed = 1;
+
+    done = async_present.back[async_present.current];
+    async_present.current ^= 1;
+    next = async_present.back[async_present.current];
+    SDL_LockMutex (async_present.lock);
+    async_present.pending = done;
+    SDL_CondBroadcast (async_present.changed);
+    SDL_UnlockMutex (async_present.lock);
+
+    /* Both threads only read done until the copy is over */
+    if (count)
+        async_present_copy (done, (Uint8*) next->pixels, next->pitch,
+                            rects, count);
+
+    PySurface_DropRLE (DisplaySurfaceObject);
+    PySurface_AsSurface (DisplaySurfaceObject) = next;
+    return 0;
+}
+
+/* The surface drawn to: the software screen of a GLBLIT display, or the
+ * buffer drawn to of an asynchronously presented one
+ */
+static SDL_Surface*
+display_screen (void)
+{
+    if (async_present.thread)
+        return async_present.back[async_present.current];
+    return glblit.screen ? glblit.screen : SDL_GetVideoSurface ();
+}
+
 /* init routines */
 static void
 display_autoquit (void)
 {
+    async_present_end (0);
+    present_end ();
+    glblit_end ();
     if (DisplaySurfaceObject)
     {
         PySurface_AsSurface (DisplaySurfaceObject) = NULL;
@@ -152,6 +761,8 @@ display_autoinit (PyObject* self, PyObject* arg)
 static PyObject*
 quit (PyObject* self, PyObject* arg)
 {
+    /* The present thread must be done with the display first */
+    async_present_end (0);
     PyGame_Video_AutoQuit ();
     display_autoquit ();
 
@@ -480,12 +1091,17 @@ set_mode (PyObject* self, PyObject* arg)
     int flags = SDL_SWSURFACE;
     int w = 0;
     int h = 0;
-    int hasbuf;
+    int hasbuf, glblit_mode;
     char *title, *icontitle;
 
     if (!PyArg_ParseTuple (arg, "|(ii)ii", &w, &h, &flags, &depth))
         return NULL;
 
+    /* The damage and back buffers are for the old mode */
+    async_present_end (0);
+    present_end ();
+    glblit_end ();
+
     if (w < 0 || h < 0)
         return RAISE (PyExc_SDLError, "Cannot set negative sized display mode");
 
@@ -508,6 +1124,18 @@ set_mode (PyObject* self, PyObject* arg)
             return NULL;
     }
 
+    glblit_mode = flags & PG_GLBLIT;
+    if (glblit_mode)
+    {
+        /* A double buffered GL window, synced to the display refresh */
+        flags &= ~(PG_GLBLIT | SDL_HWSURFACE | SDL_ASYNCBLIT | SDL_HWPALETTE);
+        flags |= SDL_OPENGL | SDL_DOUBLEBUF;
+        depth = 0;
+#if SDL_VERSION_ATLEAST(1, 2, 10)
+        SDL_GL_SetAttribute (SDL_GL_SWAP_CONTROL, 1);
+#endif
+    }
+
     if (flags & SDL_OPENGL)
     {
         if (flags & SDL_DOUBLEBUF)
@@ -526,6 +1154,13 @@ set_mode (PyObject* self, PyObject* arg)
         SDL_GL_GetAttribute (SDL_GL_DOUBLEBUFFER, &hasbuf);
         if (hasbuf)
             surf->flags |= SDL_DOUBLEBUF;
+
+        if (glblit_mode)
+        {
+            if (glblit_load () || glblit_begin (surf->w, surf->h))
+                return NULL;
+            surf = glblit.screen;
+        }
     }
     else
     {
@@ -631,25 +1266,106 @@ flip (PyObject* self)
 {
     SDL_Surface* screen;
     int status = 0;
+    Uint64 start;
 
     VIDEO_INIT_CHECK ();
 
-    screen = SDL_GetVideoSurface ();
+    screen = display_screen ();
     if (!screen)
         return RAISE (PyExc_SDLError, "Display mode not set");
 
-    Py_BEGIN_ALLOW_THREADS;
-    if (screen->flags & SDL_OPENGL)
-        SDL_GL_SwapBuffers ();
+    PG_PERF_BEGIN (start);
+    if (async_present.thread)
+    {
+        if (async_present_swap (NULL, 0))
+            return NULL;
+    }
     else
-        status = SDL_Flip (screen) == -1;
-    Py_END_ALLOW_THREADS;
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        if (glblit.screen)
+            glblit_present (NULL, 0);
+        else if (screen->flags & SDL_OPENGL)
+            SDL_GL_SwapBuffers ();
+        else
+            status = SDL_Flip (screen) == -1;
+        Py_END_ALLOW_THREADS;
+    }
+    PG_PERF_ADD (PG_PERF_DISPLAY_CALLS, 1);
+    PG_PERF_ADD (PG_PERF_DISPLAY_PIXELS, (Uint64) screen->w * screen->h);
+    PG_PERF_END (start, PG_PERF_DISPLAY_NS);
 
     if (status == -1)
         return RAISE (PyExc_SDLError, SDL_GetError ());
     Py_RETURN_NONE;
 }
 
+/* update() merges rects whose union wastes no more than this fraction of
+ * its area on pixels outside both rects. Negative turns merging off.
+ */
+static double update_merge = -1.0;
+/* Rects and pixels pushed by update() */
+static PY_LONG_LONG update_rects = 0;
+static PY_LONG_LONG update_pixels = 0;
+
+static void
+update_count (SDL_Rect* rects, int count)
+{
+    int loop;
+
+    update_rects += count;
+    for (loop = 0; loop < count; ++loop)
+    {
+        update_pixels += (PY_LONG_LONG) rects[loop].w * rects[loop].h;
+        PG_PERF_ADD (PG_PERF_DISPLAY_PIXELS,
+                     (Uint64) rects[loop].w * rects[loop].h);
+    }
+}
+
+/* Merge the rects that are worth pushing as one. Returns the new count. */
+static int
+update_merge_rects (SDL_Rect* rects, int count)
+{
+    int i, j, merged;
+    int left, top, right, bottom, ow, oh;
+    double area, used;
+
+    do
+    {
+        merged = 0;
+        for (i = 0; i < count; ++i)
+        {
+            for (j = i + 1; j < count; ++j)
+            {
+                SDL_Rect* a = rects + i;
+                SDL_Rect* b = rects + j;
+
+                left = MIN (a->x, b->x);
+                top = MIN (a->y, b->y);
+                right = MAX (a->x + a->w, b->x + b->w);
+                bottom = MAX (a->y + a->h, b->y + b->h);
+                ow = MIN (a->x + a->w, b->x + b->w) - MAX (a->x, b->x);
+                oh = MIN (a->y + a->h, b->y + b->h) - MAX (a->y, b->y);
+
+                area = (double) (right - left) * (bottom - top);
+                used = (double) a->w * a->h + (double) b->w * b->h;
+                if (ow > 0 && oh > 0)
+                    used -= (double) ow * oh;
+                if (area - used > update_merge * area)
+                    continue;
+
+                a->x = (Sint16) left;
+                a->y = (Sint16) top;
+                a->w = (Uint16) (right - left);
+                a->h = (Uint16) (bottom - top);
+                rects[j--] = rects[--count];
+                merged = 1;
+            }
+        }
+    } while (merged);
+    return count;
+}
+
 /*BAD things happen when out-of-bound rects go to updaterect*/
 static SDL_Rect*
 screencroprect (GAME_Rect* r, int w, int h, SDL_Rect* cur)
@@ -675,10 +1391,11 @@ update (PyObject* self, PyObject* arg)
     GAME_Rect *gr, temp = { 0 };
     int wide, high;
     PyObject* obj;
+    Uint64 start;
 
     VIDEO_INIT_CHECK ();
 
-    screen = SDL_GetVideoSurface ();
+    screen = display_screen ();
     if (!screen)
         return RAISE (PyExc_SDLError, SDL_GetError ());
     wide = screen->w;
@@ -687,9 +1404,23 @@ update (PyObject* self, PyObject* arg)
         return RAISE (PyExc_SDLError, "Cannot update an OPENGL display");
 
     /*determine type of argument we got*/
+    PG_PERF_BEGIN (start);
+    PG_PERF_ADD (PG_PERF_DISPLAY_CALLS, 1);
     if (PyTuple_Size (arg) == 0)
     {
-        SDL_UpdateRect (screen, 0, 0, 0, 0);
+        if (async_present.thread)
+        {
+            if (async_present_swap (NULL, 0))
+                return NULL;
+        }
+        else if (glblit.screen)
+            glblit_present (NULL, 0);
+        else
+            SDL_UpdateRect (screen, 0, 0, 0, 0);
+        update_rects += 1;
+        update_pixels += (PY_LONG_LONG) wide * high;
+        PG_PERF_ADD (PG_PERF_DISPLAY_PIXELS, (Uint64) wide * high);
+        PG_PERF_END (start, PG_PERF_DISPLAY_NS);
         Py_RETURN_NONE;
     }
     else
@@ -714,7 +1445,18 @@ update (PyObject* self, PyObject* arg)
     {
         SDL_Rect sdlr;
         if (screencroprect (gr, wide, high, &sdlr))
-            SDL_UpdateRect (screen, sdlr.x, sdlr.y, sdlr.w, sdlr.h);
+        {
+            if (async_present.thread)
+            {
+                if (async_present_swap (&sdlr, 1))
+                    return NULL;
+            }
+            else if (glblit.screen)
+                glblit_present (&sdlr, 1);
+            else
+                SDL_UpdateRect (screen, sdlr.x, sdlr.y, sdlr.w, sdlr.h);
+            update_count (&sdlr, 1);
+        }
     }
     else
     {
@@ -767,17 +1509,329 @@ update (PyObject* self, PyObject* arg)
             ++count;
         }
 
-        if (count) {
+        if (count > 1 && update_merge >= 0.0)
+            count = update_merge_rects (rects, count);
+
+        if (count && async_present.thread)
+        {
+            if (async_present_swap (rects, count))
+            {
+                PyMem_Free ((char*)rects);
+                return NULL;
+            }
+            update_count (rects, count);
+        }
+        else if (count) {
+            update_count (rects, count);
             Py_BEGIN_ALLOW_THREADS;
-            SDL_UpdateRects (screen, count, rects);
+            if (glblit.screen)
+                glblit_present (rects, count);
+            else
+                SDL_UpdateRects (screen, count, rects);
             Py_END_ALLOW_THREADS;
         }
 
         PyMem_Free ((char*)rects);
     }
+    PG_PERF_END (start, PG_PERF_DISPLAY_NS);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+set_update_merge (PyObject* self, PyObject* args)
+{
+    PyObject* obj = Py_None;
+    double waste;
+
+    if (!PyArg_ParseTuple (args, "|O", &obj))
+        return NULL;
+
+    if (obj == Py_None)
+        update_merge = -1.0;
+    else
+    {
+        waste = PyFloat_AsDouble (obj);
+        if (waste == -1.0 && PyErr_Occurred ())
+            return NULL;
+        if (waste < 0.0 || waste > 1.0)
+            return RAISE (PyExc_ValueError,
+                          "waste must be between 0.0 and 1.0, or None");
+        update_merge = waste;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+get_update_merge (PyObject* self)
+{
+    if (update_merge < 0.0)
+        Py_RETURN_NONE;
+    return PyFloat_FromDouble (update_merge);
+}
+
+static PyObject*
+get_update_count (PyObject* self, PyObject* args)
+{
+    PyObject* result;
+    int reset = 0;
+
+    if (!PyArg_ParseTuple (args, "|i", &reset))
+        return NULL;
+
+    result = Py_BuildValue ("(LL)", update_rects, update_pixels);
+    if (result && reset)
+        update_rects = update_pixels = 0;
+    return result;
+}
+
+static PyObject*
+set_managed (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    SDL_Surface* screen;
+    SDL_PixelFormat* format;
+    PyObject* result;
+    int enable = 1;
+    double threshold = 0.5;
+    static char *kwids[] = {"enable", "threshold", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|id", kwids, &enable,
+                                      &threshold))
+        return NULL;
+    if (threshold < 0.0 || threshold > 1.0)
+        return RAISE (PyExc_ValueError,
+                      "threshold must be between 0.0 and 1.0");
+
+    VIDEO_INIT_CHECK ();
+    screen = display_screen ();
+    if (!screen || !DisplaySurfaceObject)
+        return RAISE (PyExc_SDLError, "Display mode not set");
+    if (screen->flags & SDL_OPENGL)
+        return RAISE (PyExc_SDLError, "Cannot manage an OPENGL display");
+    if (async_present.thread)
+        return RAISE (PyExc_SDLError,
+                      "Cannot manage an asynchronously presented display");
+
+    present_end ();
+    result = PyObject_CallMethod (DisplaySurfaceObject, "track_damage", "i",
+                                  enable);
+    if (!result)
+        return NULL;
+    Py_DECREF (result);
+    if (!enable)
+        Py_RETURN_NONE;
+
+    if (screen->flags & SDL_DOUBLEBUF)
+    {
+        format = screen->format;
+        present_back = SDL_CreateRGBSurface (SDL_SWSURFACE, screen->w,
+                                             screen->h, format->BitsPerPixel,
+                                             format->Rmask, format->Gmask,
+                                             format->Bmask, format->Amask);
+        if (!present_back)
+            return RAISE (PyExc_SDLError, SDL_GetError ());
+        if (format->palette)
+            SDL_SetColors (present_back, format->palette->colors, 0,
+                           format->palette->ncolors);
+    }
+    present_threshold = threshold;
+    present_managed = 1;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+get_managed (PyObject* self)
+{
+    return PyBool_FromLong (present_managed);
+}
+
+static PyObject*
+present (PyObject* self)
+{
+    SDL_Surface* screen;
+    SDL_Rect rects[PRESENT_MAX_RECTS];
+    PY_LONG_LONG area = 0;
+    int count, loop, status = 0;
+
+    VIDEO_INIT_CHECK ();
+    if (!present_managed)
+        return RAISE (PyExc_SDLError,
+                      "The display is not managed; call set_managed first");
+    screen = display_screen ();
+    if (!screen)
+        return RAISE (PyExc_SDLError, "Display mode not set");
+
+    count = PySurface_TakeDamage (DisplaySurfaceObject, rects,
+                                  PRESENT_MAX_RECTS);
+    if (count > 1 && update_merge >= 0.0)
+        count = update_merge_rects (rects, count);
+    if (count <= 0)
+        Py_RETURN_NONE;
+    for (loop = 0; loop < count; ++loop)
+        area += (PY_LONG_LONG) rects[loop].w * rects[loop].h;
+
+    if (present_back)
+    {
+        /* Flip, then bring the new back buffer up to the frame shown */
+        for (loop = 0; loop < count; ++loop)
+            SDL_LowerBlit (screen, rects + loop, present_back, rects + loop);
+        Py_BEGIN_ALLOW_THREADS;
+        status = SDL_Flip (screen);
+        Py_END_ALLOW_THREADS;
+        for (loop = 0; loop < count; ++loop)
+            SDL_LowerBlit (present_back, rects + loop, screen, rects + loop);
+        update_rects += 1;
+        update_pixels += (PY_LONG_LONG) screen->w * screen->h;
+    }
+    else if (area > present_threshold * screen->w * screen->h)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        if (glblit.screen)
+            glblit_present (NULL, 0);
+        else
+            status = SDL_Flip (screen);
+        Py_END_ALLOW_THREADS;
+        update_rects += 1;
+        update_pixels += (PY_LONG_LONG) screen->w * screen->h;
+    }
+    else
+    {
+        update_count (rects, count);
+        Py_BEGIN_ALLOW_THREADS;
+        if (glblit.screen)
+            glblit_present (rects, count);
+        else
+            SDL_UpdateRects (screen, count, rects);
+        Py_END_ALLOW_THREADS;
+    }
+
+    if (status == -1)
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+set_glblit (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyObject* resolution = Py_None;
+    int integer = 0;
+    int w, h;
+    static char *kwids[] = {"resolution", "integer", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|Oi", kwids, &resolution,
+                                      &integer))
+        return NULL;
+
+    VIDEO_INIT_CHECK ();
+    if (!glblit.screen)
+        return RAISE (PyExc_SDLError, "The display mode is not GLBLIT");
+    if (resolution == Py_None)
+    {
+        w = SDL_GetVideoSurface ()->w;
+        h = SDL_GetVideoSurface ()->h;
+    }
+    else if (!TwoIntsFromObj (resolution, &w, &h))
+        return RAISE (PyExc_TypeError, "resolution must be two numbers");
+    if (w < 1 || h < 1)
+        return RAISE (PyExc_ValueError, "resolution must be positive");
+
+    if (w != glblit.screen->w || h != glblit.screen->h)
+    {
+        /* The damage is for the old screen */
+        present_end ();
+        glblit_free_screen (1);
+        if (glblit_begin (w, h))
+            return NULL;
+        PySurface_AsSurface (DisplaySurfaceObject) = glblit.screen;
+    }
+    glblit.integer = integer;
+    glblit_layout ();
+    Py_INCREF (DisplaySurfaceObject);
+    return DisplaySurfaceObject;
+}
+
+static PyObject*
+get_glblit (PyObject* self)
+{
+    if (!glblit.screen)
+        Py_RETURN_NONE;
+    return Py_BuildValue ("(ii)NN", glblit.screen->w, glblit.screen->h,
+                          PyBool_FromLong (glblit.integer),
+                          PyBool_FromLong (glblit.pbos[0] != 0));
+}
+
+static PyObject*
+set_async_present (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    SDL_Surface* screen;
+    int enable = 1;
+    int ok;
+    static char *kwids[] = {"enable", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|i", kwids, &enable))
+        return NULL;
+
+    VIDEO_INIT_CHECK ();
+    screen = SDL_GetVideoSurface ();
+    if (!screen || !DisplaySurfaceObject)
+        return RAISE (PyExc_SDLError, "Display mode not set");
+    if (!enable)
+    {
+        ok = async_present_wait ();
+        async_present_end (1);
+        if (!ok)
+            return NULL;
+        Py_RETURN_NONE;
+    }
+    if (async_present.thread)
+        Py_RETURN_NONE;
+    if (glblit.screen || (screen->flags & SDL_OPENGL))
+        return RAISE (PyExc_SDLError,
+                      "Cannot present an OPENGL display asynchronously");
+    if (present_managed)
+        return RAISE (PyExc_SDLError,
+                      "Cannot present a managed display asynchronously");
+    /* The thread writes the display pixels without locking them */
+    if (SDL_MUSTLOCK (screen))
+        return RAISE (PyExc_SDLError,
+                      "Cannot present a hardware display asynchronously");
+    /* Subsurfaces would keep pointing into the display, not the buffers */
+    if (((PySurfaceObject*) DisplaySurfaceObject)->subsurfaces)
+        return RAISE (PyExc_SDLError, "Cannot present a display surface with"
+                      " subsurfaces asynchronously");
+    if (async_present_begin ())
+        return NULL;
     Py_RETURN_NONE;
 }
 
+static PyObject*
+get_async_present (PyObject* self)
+{
+    return PyBool_FromLong (async_present.thread != NULL);
+}
+
+static PyObject*
+wait_present (PyObject* self, PyObject* args)
+{
+    int block = 1;
+    int busy;
+
+    if (!PyArg_ParseTuple (args, "|i", &block))
+        return NULL;
+    if (!async_present.thread)
+        Py_RETURN_TRUE;
+    if (!block)
+    {
+        SDL_LockMutex (async_present.lock);
+        busy = async_present.pending != NULL;
+        SDL_UnlockMutex (async_present.lock);
+        if (busy)
+            Py_RETURN_FALSE;
+    }
+    if (!async_present_wait ())
+        return NULL;
+    Py_RETURN_TRUE;
+}
+
 static PyObject*
 set_palette (PyObject* self, PyObject* args)
 {
@@ -794,6 +1848,8 @@ set_palette (PyObject* self, PyObject* args)
     surf = SDL_GetVideoSurface ();
     if (!surf)
         return RAISE (PyExc_SDLError, "No display mode is set");
+    if (!async_present_wait ())
+        return NULL;
     pal = surf->format->palette;
     if (surf->format->BytesPerPixel != 1 || !pal)
         return RAISE (PyExc_SDLError, "Display mode is not colormapped");
@@ -1012,6 +2068,8 @@ toggle_fullscreen (PyObject* self)
     screen = SDL_GetVideoSurface ();
     if (!screen)
         return RAISE (PyExc_SDLError, SDL_GetError ());
+    if (!async_present_wait ())
+        return NULL;
 
     result = SDL_WM_ToggleFullScreen (screen);
     return PyInt_FromLong (result != 0);
@@ -1043,6 +2101,28 @@ static PyMethodDef _display_methods[] =
 
     { "flip", (PyCFunction) flip, METH_NOARGS, DOC_PYGAMEDISPLAYFLIP },
     { "update", update, METH_VARARGS, DOC_PYGAMEDISPLAYUPDATE },
+    { "set_update_merge", set_update_merge, METH_VARARGS,
+      DOC_PYGAMEDISPLAYSETUPDATEMERGE },
+    { "get_update_merge", (PyCFunction) get_update_merge, METH_NOARGS,
+      DOC_PYGAMEDISPLAYGETUPDATEMERGE },
+    { "get_update_count", get_update_count, METH_VARARGS,
+      DOC_PYGAMEDISPLAYGETUPDATECOUNT },
+    { "set_managed", (PyCFunction) set_managed, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEDISPLAYSETMANAGED },
+    { "get_managed", (PyCFunction) get_managed, METH_NOARGS,
+      DOC_PYGAMEDISPLAYGETMANAGED },
+    { "present", (PyCFunction) present, METH_NOARGS,
+      DOC_PYGAMEDISPLAYPRESENT },
+    { "set_glblit", (PyCFunction) set_glblit, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEDISPLAYSETGLBLIT },
+    { "get_glblit", (PyCFunction) get_glblit, METH_NOARGS,
+      DOC_PYGAMEDISPLAYGETGLBLIT },
+    { "set_async_present", (PyCFunction) set_async_present,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEDISPLAYSETASYNCPRESENT },
+    { "get_async_present", (PyCFunction) get_async_present, METH_NOARGS,
+      DOC_PYGAMEDISPLAYGETASYNCPRESENT },
+    { "wait_present", wait_present, METH_VARARGS,
+      DOC_PYGAMEDISPLAYWAITPRESENT },
 
     { "set_palette", set_palette, METH_VARARGS, DOC_PYGAMEDISPLAYSETPALETTE },
     { "set_gamma", set_gamma, METH_VARARGS, DOC_PYGAMEDISPLAYSETGAMMA },
@@ -5,9 +5,11 @@
 
 #define DOC_PYGAMECAMERALISTCAMERAS "list_cameras() -> [cameras]\nreturns a list of available cameras"
 
-#define DOC_PYGAMECAMERACAMERA "Camera(device, (width, height), format) -> Camera\nload a camera"
+#define DOC_PYGAMECAMERACAPTURESET "capture_set(cameras, timeout=1.0, max_skew=-1.0) -> [(Surface, timestamp), ...]\nreads a frame from each camera, taken as close in time as can be"
 
-#define DOC_CAMERASTART "start() -> None\nopens, initializes, and starts capturing"
+#define DOC_PYGAMECAMERACAMERA "Camera(device, (width, height), format, pixelformat=None, fps=0) -> Camera\nload a camera"
+
+#define DOC_CAMERASTART "start(threaded=False) -> None\nopens, initializes, and starts capturing"
 
 #define DOC_CAMERASTOP "stop() -> None\nstops, uninitializes, and closes the camera"
 
@@ -23,6 +25,14 @@
 
 #define DOC_CAMERAGETRAW "get_raw() -> string\nreturns an unmodified image as a string"
 
+#define DOC_CAMERAGETCAPTURESTATS "get_capture_stats() -> (captured, dropped, repeated)\nreturns the frame counts of a threaded camera"
+
+#define DOC_CAMERAGETFRAMEVIEW "get_frame_view() -> BufferProxy\nreturns the next frame as the camera wrote it, without copying"
+
+#define DOC_CAMERAGETFORMAT "get_format() -> (pixelformat, (width, height), fps)\nreturns the pixelformat, size and frame rate being captured"
+
+#define DOC_CAMERALISTFORMATS "list_formats() -> [(pixelformat, (width, height), fps), ...]\nreturns the pixelformats, sizes and frame rates of the device"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -40,12 +50,16 @@ pygame.camera.list_cameras
  list_cameras() -> [cameras]
 returns a list of available cameras
 
+pygame.camera.capture_set
+ capture_set(cameras, timeout=1.0, max_skew=-1.0) -> [(Surface, timestamp), ...]
+reads a frame from each camera, taken as close in time as can be
+
 pygame.camera.Camera
- Camera(device, (width, height), format) -> Camera
+ Camera(device, (width, height), format, pixelformat=None, fps=0) -> Camera
 load a camera
 
 pygame.camera.Camera.start
- start() -> None
+ start(threaded=False) -> None
 opens, initializes, and starts capturing
 
 pygame.camera.Camera.stop
@@ -76,4 +90,20 @@ pygame.camera.Camera.get_raw
  get_raw() -> string
 returns an unmodified image as a string
 
+pygame.camera.Camera.get_capture_stats
+ get_capture_stats() -> (captured, dropped, repeated)
+returns the frame counts of a threaded camera
+
+pygame.camera.Camera.get_frame_view
+ get_frame_view() -> BufferProxy
+returns the next frame as the camera wrote it, without copying
+
+pygame.camera.Camera.get_format
+ get_format() -> (pixelformat, (width, height), fps)
+returns the pixelformat, size and frame rate being captured
+
+pygame.camera.Camera.list_formats
+ list_formats() -> [(pixelformat, (width, height), fps), ...]
+returns the pixelformats, sizes and frame rates of the device
+
 */
\ No newline at end of file
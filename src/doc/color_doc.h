@@ -23,6 +23,12 @@
 
 #define DOC_COLORSETLENGTH "set_length(len) -> None\nSet the number of elements in the Color to 1,2,3, or 4."
 
+#define DOC_COLORTOINT "to_int() -> int\nReturns the Color packed into an integer."
+
+#define DOC_COLORFROMINT "from_int(rgbavalue) -> Color\nMakes a Color from a packed integer."
+
+#define DOC_PYGAMECOLORARRAY "ColorArray(length) -> ColorArray\nColorArray(sequence) -> ColorArray\npygame object for a packed array of colors"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -79,4 +85,17 @@ pygame.Color.set_length
  set_length(len) -> None
 Set the number of elements in the Color to 1,2,3, or 4.
 
+pygame.Color.to_int
+ to_int() -> int
+Returns the Color packed into an integer.
+
+pygame.Color.from_int
+ from_int(rgbavalue) -> Color
+Makes a Color from a packed integer.
+
+pygame.ColorArray
+ ColorArray(length) -> ColorArray
+ ColorArray(sequence) -> ColorArray
+pygame object for a packed array of colors
+
 */
\ No newline at end of file
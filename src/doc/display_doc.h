@@ -15,6 +15,28 @@
 
 #define DOC_PYGAMEDISPLAYUPDATE "update(rectangle=None) -> None\nupdate(rectangle_list) -> None\nUpdate portions of the screen for software displays"
 
+#define DOC_PYGAMEDISPLAYSETUPDATEMERGE "set_update_merge(waste=None) -> None\nMerge the rectangles passed to update"
+
+#define DOC_PYGAMEDISPLAYGETUPDATEMERGE "get_update_merge() -> waste or None\nGet the merge setting of update"
+
+#define DOC_PYGAMEDISPLAYGETUPDATECOUNT "get_update_count(reset=False) -> (rects, pixels)\nGet the number of rectangles and pixels pushed by update"
+
+#define DOC_PYGAMEDISPLAYSETMANAGED "set_managed(enable=True, threshold=0.5) -> None\nLet present push only what changed on the display"
+
+#define DOC_PYGAMEDISPLAYGETMANAGED "get_managed() -> bool\nTest if the display is managed"
+
+#define DOC_PYGAMEDISPLAYPRESENT "present() -> None\nPush the changed areas of a managed display to the screen"
+
+#define DOC_PYGAMEDISPLAYSETGLBLIT "set_glblit(resolution=None, integer=False) -> Surface\nSet how a GLBLIT display is scaled to its window"
+
+#define DOC_PYGAMEDISPLAYGETGLBLIT "get_glblit() -> (resolution, integer, pbo) or None\nGet the scaling of a GLBLIT display"
+
+#define DOC_PYGAMEDISPLAYSETASYNCPRESENT "set_async_present(enable=True) -> None\nPresent the display on a thread while the next frame is drawn"
+
+#define DOC_PYGAMEDISPLAYGETASYNCPRESENT "get_async_present() -> bool\nTest if the display is presented asynchronously"
+
+#define DOC_PYGAMEDISPLAYWAITPRESENT "wait_present(block=True) -> bool\nWait for an asynchronous present to finish"
+
 #define DOC_PYGAMEDISPLAYGETDRIVER "get_driver() -> name\nGet the name of the pygame display backend"
 
 #define DOC_PYGAMEDISPLAYINFO "Info() -> VideoInfo\nCreate a video display information object"
@@ -85,6 +107,50 @@ pygame.display.update
  update(rectangle_list) -> None
 Update portions of the screen for software displays
 
+pygame.display.set_update_merge
+ set_update_merge(waste=None) -> None
+Merge the rectangles passed to update
+
+pygame.display.get_update_merge
+ get_update_merge() -> waste or None
+Get the merge setting of update
+
+pygame.display.get_update_count
+ get_update_count(reset=False) -> (rects, pixels)
+Get the number of rectangles and pixels pushed by update
+
+pygame.display.set_managed
+ set_managed(enable=True, threshold=0.5) -> None
+Let present push only what changed on the display
+
+pygame.display.get_managed
+ get_managed() -> bool
+Test if the display is managed
+
+pygame.display.present
+ present() -> None
+Push the changed areas of a managed display to the screen
+
+pygame.display.set_glblit
+ set_glblit(resolution=None, integer=False) -> Surface
+Set how a GLBLIT display is scaled to its window
+
+pygame.display.get_glblit
+ get_glblit() -> (resolution, integer, pbo) or None
+Get the scaling of a GLBLIT display
+
+pygame.display.set_async_present
+ set_async_present(enable=True) -> None
+Present the display on a thread while the next frame is drawn
+
+pygame.display.get_async_present
+ get_async_present() -> bool
+Test if the display is presented asynchronously
+
+pygame.display.wait_present
+ wait_present(block=True) -> bool
+Wait for an asynchronous present to finish
+
 pygame.display.get_driver
  get_driver() -> name
 Get the name of the pygame display backend
@@ -19,6 +19,18 @@
 
 #define DOC_PYGAMEDRAWAALINES "aalines(Surface, color, closed, pointlist, blend=1) -> Rect\ndraw a connected sequence of antialiased lines"
 
+#define DOC_PYGAMEDRAWAAWIDELINE "aawideline(Surface, color, start_pos, end_pos, width) -> Rect\ndraw a wide antialiased line segment"
+
+#define DOC_PYGAMEDRAWAAWIDELINES "aawidelines(Surface, color, closed, pointlist, width, round=0) -> Rect\ndraw a connected sequence of wide antialiased lines"
+
+#define DOC_PYGAMEDRAWAACAPSULE "aacapsule(Surface, color, start_pos, end_pos, width) -> Rect\ndraw an antialiased line segment with round ends"
+
+#define DOC_PYGAMEDRAWBATCH "batch(Surface, commands) -> Rect\ndraw many shapes with one lock"
+
+#define DOC_PYGAMEDRAWSETBATCHTHREADS "set_batch_threads(count) -> None\nset the number of threads batch draws with"
+
+#define DOC_PYGAMEDRAWGETBATCHTHREADS "get_batch_threads() -> int\nreturn the number of threads batch draws with"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -64,4 +76,28 @@ pygame.draw.aalines
  aalines(Surface, color, closed, pointlist, blend=1) -> Rect
 draw a connected sequence of antialiased lines
 
+pygame.draw.aawideline
+ aawideline(Surface, color, start_pos, end_pos, width) -> Rect
+draw a wide antialiased line segment
+
+pygame.draw.aawidelines
+ aawidelines(Surface, color, closed, pointlist, width, round=0) -> Rect
+draw a connected sequence of wide antialiased lines
+
+pygame.draw.aacapsule
+ aacapsule(Surface, color, start_pos, end_pos, width) -> Rect
+draw an antialiased line segment with round ends
+
+pygame.draw.batch
+ batch(Surface, commands) -> Rect
+draw many shapes with one lock
+
+pygame.draw.set_batch_threads
+ set_batch_threads(count) -> None
+set the number of threads batch draws with
+
+pygame.draw.get_batch_threads
+ get_batch_threads() -> int
+return the number of threads batch draws with
+
 */
\ No newline at end of file
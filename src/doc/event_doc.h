@@ -5,6 +5,8 @@
 
 #define DOC_PYGAMEEVENTGET "get() -> Eventlist\nget(type) -> Eventlist\nget(typelist) -> Eventlist\nget events from the queue"
 
+#define DOC_PYGAMEEVENTGETBUFFER "get_buffer() -> bytearray\nget_buffer(out) -> count\nget events from the queue as packed records"
+
 #define DOC_PYGAMEEVENTPOLL "poll() -> EventType instance\nget a single event from the queue"
 
 #define DOC_PYGAMEEVENTWAIT "wait() -> EventType instance\nwait for a single event from the queue"
@@ -21,12 +23,18 @@
 
 #define DOC_PYGAMEEVENTGETBLOCKED "get_blocked(type) -> bool\ntest if a type of event is blocked from the queue"
 
+#define DOC_PYGAMEEVENTSETCOALESCE "set_coalesce(typelist) -> None\nset_coalesce(None) -> None\nmerge runs of motion events as they are taken"
+
+#define DOC_PYGAMEEVENTGETCOALESCESTATS "get_coalesce_stats() -> dict\ncount the events merged away"
+
 #define DOC_PYGAMEEVENTSETGRAB "set_grab(bool) -> None\ncontrol the sharing of input devices with other applications"
 
 #define DOC_PYGAMEEVENTGETGRAB "get_grab() -> bool\ntest if the program is sharing input devices"
 
 #define DOC_PYGAMEEVENTPOST "post(Event) -> None\nplace a new event on the queue"
 
+#define DOC_PYGAMEEVENTPOSTMANY "post_many(events) -> count\nplace many new events on the queue"
+
 #define DOC_PYGAMEEVENTEVENT "Event(type, dict) -> EventType instance\nEvent(type, **attributes) -> EventType instance\ncreate a new event object"
 
 #define DOC_PYGAMEEVENTEVENTTYPE "pygame object for representing SDL events"
@@ -54,6 +62,11 @@ pygame.event.get
  get(typelist) -> Eventlist
 get events from the queue
 
+pygame.event.get_buffer
+ get_buffer() -> bytearray
+ get_buffer(out) -> count
+get events from the queue as packed records
+
 pygame.event.poll
  poll() -> EventType instance
 get a single event from the queue
@@ -93,6 +106,15 @@ pygame.event.get_blocked
  get_blocked(type) -> bool
 test if a type of event is blocked from the queue
 
+pygame.event.set_coalesce
+ set_coalesce(typelist) -> None
+ set_coalesce(None) -> None
+merge runs of motion events as they are taken
+
+pygame.event.get_coalesce_stats
+ get_coalesce_stats() -> dict
+count the events merged away
+
 pygame.event.set_grab
  set_grab(bool) -> None
 control the sharing of input devices with other applications
@@ -105,6 +127,10 @@ pygame.event.post
  post(Event) -> None
 place a new event on the queue
 
+pygame.event.post_many
+ post_many(events) -> count
+place many new events on the queue
+
 pygame.event.Event
  Event(type, dict) -> EventType instance
  Event(type, **attributes) -> EventType instance
@@ -21,6 +21,10 @@
 
 #define DOC_FONTSIZE "size(text) -> (width, height)\ndetermine the amount of space needed to render text"
 
+#define DOC_FONTSETRENDERCACHE "set_render_cache(size) -> None\nkeep the surfaces of recent renders for reuse"
+
+#define DOC_FONTGETRENDERCACHESTATS "get_render_cache_stats() -> (size, count, hits, misses)\nget use counts of the render cache"
+
 #define DOC_FONTSETUNDERLINE "set_underline(bool) -> None\ncontrol if text is rendered with an underline"
 
 #define DOC_FONTGETUNDERLINE "get_underline() -> bool\ncheck if text will be rendered with an underline"
@@ -93,6 +97,14 @@ pygame.font.Font.size
  size(text) -> (width, height)
 determine the amount of space needed to render text
 
+pygame.font.Font.set_render_cache
+ set_render_cache(size) -> None
+keep the surfaces of recent renders for reuse
+
+pygame.font.Font.get_render_cache_stats
+ get_render_cache_stats() -> (size, count, hits, misses)
+get use counts of the render cache
+
 pygame.font.Font.set_underline
  set_underline(bool) -> None
 control if text is rendered with an underline
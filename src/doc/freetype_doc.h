@@ -21,7 +21,7 @@
 
 #define DOC_PYGAMEFREETYPEGETDEFAULTFONT "get_default_font() -> string\nGet the filename of the default font"
 
-#define DOC_PYGAMEFREETYPEFONT "Font(file, size=0, font_index=0, resolution=0, ucs4=False) -> Font\nCreate a new Font instance from a supported font file."
+#define DOC_PYGAMEFREETYPEFONT "Font(file, size=0, font_index=0, resolution=0, ucs4=False, shared_cache=False) -> Font\nCreate a new Font instance from a supported font file."
 
 #define DOC_FONTNAME "name -> string\nProper font name."
 
@@ -49,10 +49,16 @@
 
 #define DOC_FONTGETSIZES "get_sizes() -> [(int, int, int, float, float), ...]\nget_sizes() -> []\nreturn the available sizes of embedded bitmaps"
 
+#define DOC_FONTPREWARM "prewarm(text, size=0, style=STYLE_DEFAULT) -> int\nrender the glyphs of text ahead of time"
+
 #define DOC_FONTRENDER "render(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> (Surface, Rect)\nReturn rendered text as a surface"
 
+#define DOC_FONTRENDERCACHED "render_cached(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> (Surface, Rect)\nReturn rendered text as a surface kept for reuse"
+
 #define DOC_FONTRENDERTO "render_to(surf, dest, text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> Rect\nRender text onto an existing surface"
 
+#define DOC_FONTRENDERMANYTO "render_many_to(surf, texts, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> [Rect, ...]\nRender many texts onto an existing surface at once"
+
 #define DOC_FONTRENDERRAW "render_raw(text, style=STYLE_DEFAULT, rotation=0, size=0, invert=False) -> (bytes, (int, int))\nReturn rendered text as a string of bytes"
 
 #define DOC_FONTRENDERRAWTO "render_raw_to(array, text, dest=None, style=STYLE_DEFAULT, rotation=0, size=0, invert=False) -> (int, int)\nRender text into an array of ints"
@@ -95,6 +101,12 @@
 
 #define DOC_FONTUCS4 "ucs4 -> bool\nEnable UCS-4 mode"
 
+#define DOC_FONTATLAS "atlas -> bool\nrender to surfaces through a glyph atlas"
+
+#define DOC_FONTGLYPHCACHEBUDGET "glyph_cache_budget -> int\nmost bytes of glyphs kept by the font"
+
+#define DOC_FONTGLYPHCACHESTATS "glyph_cache_stats -> (count, bytes, hits, misses, evictions)\nglyph cache statistics"
+
 #define DOC_FONTRESOLUTION "resolution -> int\nPixel resolution in dots per inch"
 
 
@@ -147,7 +159,7 @@ pygame.freetype.get_default_font
 Get the filename of the default font
 
 pygame.freetype.Font
- Font(file, size=0, font_index=0, resolution=0, ucs4=False) -> Font
+ Font(file, size=0, font_index=0, resolution=0, ucs4=False, shared_cache=False) -> Font
 Create a new Font instance from a supported font file.
 
 pygame.freetype.Font.name
@@ -204,14 +216,26 @@ pygame.freetype.Font.get_sizes
  get_sizes() -> []
 return the available sizes of embedded bitmaps
 
+pygame.freetype.Font.prewarm
+ prewarm(text, size=0, style=STYLE_DEFAULT) -> int
+render the glyphs of text ahead of time
+
 pygame.freetype.Font.render
  render(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> (Surface, Rect)
 Return rendered text as a surface
 
+pygame.freetype.Font.render_cached
+ render_cached(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> (Surface, Rect)
+Return rendered text as a surface kept for reuse
+
 pygame.freetype.Font.render_to
  render_to(surf, dest, text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> Rect
 Render text onto an existing surface
 
+pygame.freetype.Font.render_many_to
+ render_many_to(surf, texts, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> [Rect, ...]
+Render many texts onto an existing surface at once
+
 pygame.freetype.Font.render_raw
  render_raw(text, style=STYLE_DEFAULT, rotation=0, size=0, invert=False) -> (bytes, (int, int))
 Return rendered text as a string of bytes
@@ -296,6 +320,18 @@ pygame.freetype.Font.ucs4
  ucs4 -> bool
 Enable UCS-4 mode
 
+pygame.freetype.Font.atlas
+ atlas -> bool
+render to surfaces through a glyph atlas
+
+pygame.freetype.Font.glyph_cache_budget
+ glyph_cache_budget -> int
+most bytes of glyphs kept by the font
+
+pygame.freetype.Font.glyph_cache_stats
+ glyph_cache_stats -> (count, bytes, hits, misses, evictions)
+glyph cache statistics
+
 pygame.freetype.Font.resolution
  resolution -> int
 Pixel resolution in dots per inch
@@ -43,8 +43,16 @@
 
 #define DOC_PYGAMEGFXDRAWTEXTUREDPOLYGON "textured_polygon(surface, points, texture, tx, ty) -> None\ndraw a textured polygon"
 
+#define DOC_PYGAMEGFXDRAWTEXTUREDPOLYGONUV "textured_polygon_uv(surface, points, texture, texcoords) -> None\ndraw a polygon with a texture coordinate at each point"
+
 #define DOC_PYGAMEGFXDRAWBEZIER "bezier(surface, points, steps, color) -> None\ndraw a bezier curve"
 
+#define DOC_PYGAMEGFXDRAWSETSHAPECACHESIZE "set_shape_cache_size(count) -> None\nset how many circle and ellipse shapes are kept"
+
+#define DOC_PYGAMEGFXDRAWGETSHAPECACHESIZE "get_shape_cache_size() -> count\nget how many circle and ellipse shapes are kept"
+
+#define DOC_PYGAMEGFXDRAWGETSHAPECACHESTATS "get_shape_cache_stats() -> (count, bytes, hits, misses, evictions)\nget shape cache statistics"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -138,8 +146,24 @@ pygame.gfxdraw.textured_polygon
  textured_polygon(surface, points, texture, tx, ty) -> None
 draw a textured polygon
 
+pygame.gfxdraw.textured_polygon_uv
+ textured_polygon_uv(surface, points, texture, texcoords) -> None
+draw a polygon with a texture coordinate at each point
+
 pygame.gfxdraw.bezier
  bezier(surface, points, steps, color) -> None
 draw a bezier curve
 
+pygame.gfxdraw.set_shape_cache_size
+ set_shape_cache_size(count) -> None
+set how many circle and ellipse shapes are kept
+
+pygame.gfxdraw.get_shape_cache_size
+ get_shape_cache_size() -> count
+get how many circle and ellipse shapes are kept
+
+pygame.gfxdraw.get_shape_cache_stats
+ get_shape_cache_stats() -> (count, bytes, hits, misses, evictions)
+get shape cache statistics
+
 */
\ No newline at end of file
@@ -3,16 +3,30 @@
 
 #define DOC_PYGAMEIMAGELOAD "load(filename) -> Surface\nload(fileobj, namehint="") -> Surface\nload new image from a file"
 
-#define DOC_PYGAMEIMAGESAVE "save(Surface, filename) -> None\nsave an image to disk"
+#define DOC_PYGAMEIMAGELOADMANY "load_many(paths, callback=None, convert=False, alpha=False) -> list\nload image files in parallel"
+
+#define DOC_PYGAMEIMAGESAVE "save(Surface, filename, compression=-1, filter=None, quality=-1, dct=None, subsampling=None, namehint=None) -> None\nsave an image to disk"
+
+#define DOC_PYGAMEIMAGELOADJPEG "load_jpeg(filename, scale=1, dct=None) -> Surface\nload a JPEG image, decoded at a reduced size"
+
+#define DOC_PYGAMEIMAGESAVEASYNC "save_async(Surface, filename, compression=-1, filter=None) -> None\nsave a PNG image on a background thread"
+
+#define DOC_PYGAMEIMAGEWAITSAVES "wait_saves() -> None\nwait for the images given to save_async to be written"
 
 #define DOC_PYGAMEIMAGEGETEXTENDED "get_extended() -> bool\ntest if extended image formats can be loaded"
 
 #define DOC_PYGAMEIMAGETOSTRING "tostring(Surface, format, flipped=False) -> string\ntransfer image to string buffer"
 
+#define DOC_PYGAMEIMAGETOBUFFER "tobuffer(Surface, format, buffer, flipped=False) -> None\ntransfer image to a writable buffer"
+
 #define DOC_PYGAMEIMAGEFROMSTRING "fromstring(string, size, format, flipped=False) -> Surface\ncreate new Surface from a string buffer"
 
 #define DOC_PYGAMEIMAGEFROMBUFFER "frombuffer(string, size, format) -> Surface\ncreate a new Surface that shares data inside a string buffer"
 
+#define DOC_PYGAMEIMAGESAVEATLAS "save_atlas(Surface, filename, rects=None) -> None\nsave a surface's pixels as they are, for instant loading"
+
+#define DOC_PYGAMEIMAGELOADATLAS "load_atlas(filename) -> (Surface, rects)\nmap an atlas file into a Surface without decoding it"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -27,10 +41,26 @@ pygame.image.load
  load(fileobj, namehint="") -> Surface
 load new image from a file
 
+pygame.image.load_many
+ load_many(paths, callback=None, convert=False, alpha=False) -> list
+load image files in parallel
+
 pygame.image.save
- save(Surface, filename) -> None
+ save(Surface, filename, compression=-1, filter=None, quality=-1, dct=None, subsampling=None, namehint=None) -> None
 save an image to disk
 
+pygame.image.load_jpeg
+ load_jpeg(filename, scale=1, dct=None) -> Surface
+load a JPEG image, decoded at a reduced size
+
+pygame.image.save_async
+ save_async(Surface, filename, compression=-1, filter=None) -> None
+save a PNG image on a background thread
+
+pygame.image.wait_saves
+ wait_saves() -> None
+wait for the images given to save_async to be written
+
 pygame.image.get_extended
  get_extended() -> bool
 test if extended image formats can be loaded
@@ -39,6 +69,10 @@ pygame.image.tostring
  tostring(Surface, format, flipped=False) -> string
 transfer image to string buffer
 
+pygame.image.tobuffer
+ tobuffer(Surface, format, buffer, flipped=False) -> None
+transfer image to a writable buffer
+
 pygame.image.fromstring
  fromstring(string, size, format, flipped=False) -> Surface
 create new Surface from a string buffer
@@ -47,4 +81,12 @@ pygame.image.frombuffer
  frombuffer(string, size, format) -> Surface
 create a new Surface that shares data inside a string buffer
 
+pygame.image.save_atlas
+ save_atlas(Surface, filename, rects=None) -> None
+save a surface's pixels as they are, for instant loading
+
+pygame.image.load_atlas
+ load_atlas(filename) -> (Surface, rects)
+map an atlas file into a Surface without decoding it
+
 */
\ No newline at end of file
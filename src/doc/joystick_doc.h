@@ -37,6 +37,12 @@
 
 #define DOC_JOYSTICKGETHAT "get_hat(hat_number) -> x, y\nget the position of a joystick hat"
 
+#define DOC_JOYSTICKGETSTATE "get_state(out=None, deadzone=0.0) -> bytearray\nget_state(out, deadzone=0.0) -> size\nget all the axes, buttons, hats and balls as a packed record"
+
+#define DOC_JOYSTICKGETSTATEFORMAT "get_state_format() -> str\nget the struct format of the get_state record"
+
+#define DOC_PYGAMEJOYSTICKGETSTATES "get_states(out=None, deadzone=0.0) -> bytearray\nget_states(out, deadzone=0.0) -> size\nget the states of all the initialized Joysticks at once"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -118,4 +124,18 @@ pygame.joystick.Joystick.get_hat
  get_hat(hat_number) -> x, y
 get the position of a joystick hat
 
+pygame.joystick.Joystick.get_state
+ get_state(out=None, deadzone=0.0) -> bytearray
+ get_state(out, deadzone=0.0) -> size
+get all the axes, buttons, hats and balls as a packed record
+
+pygame.joystick.Joystick.get_state_format
+ get_state_format() -> str
+get the struct format of the get_state record
+
+pygame.joystick.get_states
+ get_states(out=None, deadzone=0.0) -> bytearray
+ get_states(out, deadzone=0.0) -> size
+get the states of all the initialized Joysticks at once
+
 */
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 #define DOC_PYGAMEMASKFROMTHRESHOLD "from_threshold(Surface, color, threshold = (0,0,0,255), othersurface = None, palette_colors = 1) -> Mask\nCreates a mask by thresholding Surfaces"
 
+#define DOC_PYGAMEMASKCOLLIDEPAIRS "collide_pairs(rects1, rects2, masks1 = None, masks2 = None) -> [(index1, index2), ...]\nfind every colliding pair between two sets of rects and masks"
+
 #define DOC_PYGAMEMASKMASK "Mask((width, height)) -> Mask\npygame object for representing 2d bitmasks"
 
 #define DOC_MASKGETSIZE "get_size() -> width,height\nReturns the size of the mask."
@@ -19,6 +21,12 @@
 
 #define DOC_MASKOVERLAPMASK "overlap_mask(othermask, offset) -> Mask\nReturns a mask of the overlapping pixels"
 
+#define DOC_MASKOVERLAPMANY "overlap_many(masks, offsets, area=False) -> array\nTests the mask against many masks at once"
+
+#define DOC_MASKSETOVERLAPCACHE "set_overlap_cache(size) -> None\nKeeps shifted copies of the mask for overlap tests"
+
+#define DOC_MASKSETBLOCKMAP "set_block_map(on=True) -> None\nKeeps a map of the empty blocks of the mask for overlap tests"
+
 #define DOC_MASKFILL "fill() -> None\nSets all bits to 1"
 
 #define DOC_MASKCLEAR "clear() -> None\nSets all bits to 0"
@@ -39,14 +47,28 @@
 
 #define DOC_MASKOUTLINE "outline(every = 1) -> [(x,y), (x,y) ...]\nlist of points outlining an object"
 
+#define DOC_MASKOUTLINEARRAY "outline_array(every = 1) -> array\narray of the points outlining an object"
+
 #define DOC_MASKCONVOLVE "convolve(othermask, outputmask = None, offset = (0,0)) -> Mask\nReturn the convolution of self with another mask."
 
+#define DOC_MASKDILATE "dilate(radius = 1, cross = False, outputmask = None) -> Mask\nSets each pixel near a set pixel."
+
+#define DOC_MASKERODE "erode(radius = 1, cross = False, outputmask = None) -> Mask\nKeeps each set pixel with only set pixels near it."
+
+#define DOC_MASKOPEN "open(radius = 1, cross = False, outputmask = None) -> Mask\nErodes then dilates the mask, to remove small specks."
+
+#define DOC_MASKCLOSE "close(radius = 1, cross = False, outputmask = None) -> Mask\nDilates then erodes the mask, to fill small holes."
+
 #define DOC_MASKCONNECTEDCOMPONENT "connected_component((x,y) = None) -> Mask\nReturns a mask of a connected region of pixels."
 
 #define DOC_MASKCONNECTEDCOMPONENTS "connected_components(min = 0) -> [Masks]\nReturns a list of masks of connected regions of pixels."
 
 #define DOC_MASKGETBOUNDINGRECTS "get_bounding_rects() -> Rects\nReturns a list of bounding rects of regions of set pixels."
 
+#define DOC_MASKGETCOMPONENTSTATS "get_component_stats(min = 0) -> [(area, Rect, (x, y))]\nReturns the area, bounding rect and centroid of connected regions."
+
+#define DOC_MASKTOSURFACE "to_surface(surface=None, setcolor=(255, 255, 255, 255), unsetcolor=(0, 0, 0, 255), dest=(0, 0)) -> Surface\nDraws the mask onto a surface"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -64,6 +86,10 @@ pygame.mask.from_threshold
  from_threshold(Surface, color, threshold = (0,0,0,255), othersurface = None, palette_colors = 1) -> Mask
 Creates a mask by thresholding Surfaces
 
+pygame.mask.collide_pairs
+ collide_pairs(rects1, rects2, masks1 = None, masks2 = None) -> [(index1, index2), ...]
+find every colliding pair between two sets of rects and masks
+
 pygame.mask.Mask
  Mask((width, height)) -> Mask
 pygame object for representing 2d bitmasks
@@ -92,6 +118,18 @@ pygame.mask.Mask.overlap_mask
  overlap_mask(othermask, offset) -> Mask
 Returns a mask of the overlapping pixels
 
+pygame.mask.Mask.overlap_many
+ overlap_many(masks, offsets, area=False) -> array
+Tests the mask against many masks at once
+
+pygame.mask.Mask.set_overlap_cache
+ set_overlap_cache(size) -> None
+Keeps shifted copies of the mask for overlap tests
+
+pygame.mask.Mask.set_block_map
+ set_block_map(on=True) -> None
+Keeps a map of the empty blocks of the mask for overlap tests
+
 pygame.mask.Mask.fill
  fill() -> None
 Sets all bits to 1
@@ -132,10 +170,30 @@ pygame.mask.Mask.outline
  outline(every = 1) -> [(x,y), (x,y) ...]
 list of points outlining an object
 
+pygame.mask.Mask.outline_array
+ outline_array(every = 1) -> array
+array of the points outlining an object
+
 pygame.mask.Mask.convolve
  convolve(othermask, outputmask = None, offset = (0,0)) -> Mask
 Return the convolution of self with another mask.
 
+pygame.mask.Mask.dilate
+ dilate(radius = 1, cross = False, outputmask = None) -> Mask
+Sets each pixel near a set pixel.
+
+pygame.mask.Mask.erode
+ erode(radius = 1, cross = False, outputmask = None) -> Mask
+Keeps each set pixel with only set pixels near it.
+
+pygame.mask.Mask.open
+ open(radius = 1, cross = False, outputmask = None) -> Mask
+Erodes then dilates the mask, to remove small specks.
+
+pygame.mask.Mask.close
+ close(radius = 1, cross = False, outputmask = None) -> Mask
+Dilates then erodes the mask, to fill small holes.
+
 pygame.mask.Mask.connected_component
  connected_component((x,y) = None) -> Mask
 Returns a mask of a connected region of pixels.
@@ -148,4 +206,12 @@ pygame.mask.Mask.get_bounding_rects
  get_bounding_rects() -> Rects
 Returns a list of bounding rects of regions of set pixels.
 
+pygame.mask.Mask.get_component_stats
+ get_component_stats(min = 0) -> [(area, Rect, (x, y))]
+Returns the area, bounding rect and centroid of connected regions.
+
+pygame.mask.Mask.to_surface
+ to_surface(surface=None, setcolor=(255, 255, 255, 255), unsetcolor=(0, 0, 0, 255), dest=(0, 0)) -> Surface
+Draws the mask onto a surface
+
 */
\ No newline at end of file
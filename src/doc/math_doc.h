@@ -5,6 +5,10 @@
 
 #define DOC_PYGAMEMATHDISABLESWIZZLING "disable_swizzling() -> None\nglobally disables swizzling for vectors."
 
+#define DOC_PYGAMEMATHSETFREELISTSIZE "set_freelist_size(size) -> None\nset how many dead vectors are kept for reuse"
+
+#define DOC_PYGAMEMATHGETFREELISTSTATS "get_freelist_stats() -> ((size, count, hits, misses), (size, count, hits, misses))\nget the state of the vector free lists"
+
 #define DOC_PYGAMEMATHVECTOR2 "Vector2() -> Vector2\nVector2(Vector2) -> Vector2\nVector2(x, y) -> Vector2\nVector2((x, y)) -> Vector2\na 2-Dimensional Vector"
 
 #define DOC_VECTOR2DOT "dot(Vector2) -> float\ncalculates the dot- or scalar-product with the other vector"
@@ -41,6 +45,10 @@
 
 #define DOC_VECTOR2ROTATEIP "rotate_ip(float) -> None\nrotates the vector by a given angle in degrees in place."
 
+#define DOC_VECTOR2ROTATERAD "rotate_rad(float) -> Vector2\nrotates a vector by a given angle in radians."
+
+#define DOC_VECTOR2ROTATEIPRAD "rotate_ip_rad(float) -> None\nrotates the vector by a given angle in radians in place."
+
 #define DOC_VECTOR2ANGLETO "angle_to(Vector2) -> float\ncalculates the angle to a given vector in degrees."
 
 #define DOC_VECTOR2ASPOLAR "as_polar() -> (r, phi)\nreturns a tuple with radial distance and azimuthal angle."
@@ -101,7 +109,75 @@
 
 #define DOC_VECTOR3FROMSPHERICAL "from_spherical((r, theta, phi)) -> None\nSets x, y and z from a spherical coordinates 3-tuple."
 
+#define DOC_PYGAMEMATHVECTOR2ARRAY "Vector2Array() -> Vector2Array\nVector2Array(length) -> Vector2Array\nVector2Array(vectors) -> Vector2Array\nmany 2-Dimensional Vectors stored together"
+
+#define DOC_VECTOR2ARRAYAPPEND "append(Vector2) -> None\nadds a vector to the end of the array."
+
+#define DOC_VECTOR2ARRAYLENGTH "length() -> array\nreturns the lengths of the vectors."
+
+#define DOC_VECTOR2ARRAYLENGTHSQUARED "length_squared() -> array\nreturns the squared lengths of the vectors."
+
+#define DOC_VECTOR2ARRAYNORMALIZE "normalize() -> Vector2Array\nreturns the vectors scaled to length 1."
+
+#define DOC_VECTOR2ARRAYNORMALIZEIP "normalize_ip() -> None\nscales the vectors to length 1 in place."
+
+#define DOC_VECTOR2ARRAYROTATE "rotate(float) -> Vector2Array\nrotates the vectors by a given angle in degrees."
+
+#define DOC_VECTOR2ARRAYROTATEIP "rotate_ip(float) -> None\nrotates the vectors by a given angle in degrees in place."
+
+#define DOC_VECTOR2ARRAYLERP "lerp(Vector2Array, float) -> Vector2Array\nreturns a linear interpolation to the given vectors."
+
+#define DOC_VECTOR2ARRAYLERPIP "lerp_ip(Vector2Array, float) -> None\nlinearly interpolates to the given vectors in place."
+
+#define DOC_VECTOR2ARRAYREFLECT "reflect(Vector2) -> Vector2Array\nreturns the vectors reflected of a given normal."
+
+#define DOC_VECTOR2ARRAYREFLECTIP "reflect_ip(Vector2) -> None\nreflects the vectors of a given normal in place."
+
+#define DOC_PYGAMEMATHVECTOR3ARRAY "Vector3Array() -> Vector3Array\nVector3Array(length) -> Vector3Array\nVector3Array(vectors) -> Vector3Array\nmany 3-Dimensional Vectors stored together"
+
+#define DOC_VECTOR3ARRAYAPPEND "append(Vector3) -> None\nadds a vector to the end of the array."
+
+#define DOC_VECTOR3ARRAYLENGTH "length() -> array\nreturns the lengths of the vectors."
+
+#define DOC_VECTOR3ARRAYLENGTHSQUARED "length_squared() -> array\nreturns the squared lengths of the vectors."
+
+#define DOC_VECTOR3ARRAYNORMALIZE "normalize() -> Vector3Array\nreturns the vectors scaled to length 1."
+
+#define DOC_VECTOR3ARRAYNORMALIZEIP "normalize_ip() -> None\nscales the vectors to length 1 in place."
+
+#define DOC_VECTOR3ARRAYROTATE "rotate(float, Vector3) -> Vector3Array\nrotates the vectors by a given angle in degrees."
+
+#define DOC_VECTOR3ARRAYROTATEIP "rotate_ip(float, Vector3) -> None\nrotates the vectors by a given angle in degrees in place."
+
+#define DOC_VECTOR3ARRAYLERP "lerp(Vector3Array, float) -> Vector3Array\nreturns a linear interpolation to the given vectors."
+
+#define DOC_VECTOR3ARRAYLERPIP "lerp_ip(Vector3Array, float) -> None\nlinearly interpolates to the given vectors in place."
+
+#define DOC_VECTOR3ARRAYREFLECT "reflect(Vector3) -> Vector3Array\nreturns the vectors reflected of a given normal."
+
+#define DOC_VECTOR3ARRAYREFLECTIP "reflect_ip(Vector3) -> None\nreflects the vectors of a given normal in place."
+
+#define DOC_PYGAMEMATHROTATION2 "Rotation2(angle, radians=False) -> Rotation2\na 2D rotation by a fixed angle"
+
+#define DOC_ROTATION2APPLY "apply(Vector2) -> Vector2\napply(Vector2Array) -> Vector2Array\nreturns the given vectors rotated."
+
+#define DOC_ROTATION2APPLYIP "apply_ip(Vector2) -> None\napply_ip(Vector2Array) -> None\napply_ip(buffer) -> None\nrotates the given vectors in place."
+
+#define DOC_ROTATION2INVERSE "inverse() -> Rotation2\nreturns the reverse rotation."
+
+#define DOC_ROTATION2ANGLE "angle -> float\nthe angle of the rotation in degrees."
+
+#define DOC_PYGAMEMATHROTATION3 "Rotation3(angle, axis, radians=False) -> Rotation3\na 3D rotation by a fixed angle around an axis"
+
+#define DOC_ROTATION3APPLY "apply(Vector3) -> Vector3\napply(Vector3Array) -> Vector3Array\nreturns the given vectors rotated."
+
+#define DOC_ROTATION3APPLYIP "apply_ip(Vector3) -> None\napply_ip(Vector3Array) -> None\napply_ip(buffer) -> None\nrotates the given vectors in place."
 
+#define DOC_ROTATION3INVERSE "inverse() -> Rotation3\nreturns the reverse rotation."
+
+#define DOC_ROTATION3ANGLE "angle -> float\nthe angle of the rotation in degrees."
+
+#define DOC_ROTATION3AXIS "axis -> Vector3\nthe axis of the rotation."
 
 /* Docs in a comment... slightly easier to read. */
 
@@ -118,6 +194,14 @@ pygame.math.disable_swizzling
  disable_swizzling() -> None
 globally disables swizzling for vectors.
 
+pygame.math.set_freelist_size
+ set_freelist_size(size) -> None
+set how many dead vectors are kept for reuse
+
+pygame.math.get_freelist_stats
+ get_freelist_stats() -> ((size, count, hits, misses), (size, count, hits, misses))
+get the state of the vector free lists
+
 pygame.math.Vector2
  Vector2() -> Vector2
  Vector2(Vector2) -> Vector2
@@ -193,6 +277,14 @@ pygame.math.Vector2.rotate_ip
  rotate_ip(float) -> None
 rotates the vector by a given angle in degrees in place.
 
+pygame.math.Vector2.rotate_rad
+ rotate_rad(float) -> Vector2
+rotates a vector by a given angle in radians.
+
+pygame.math.Vector2.rotate_ip_rad
+ rotate_ip_rad(float) -> None
+rotates the vector by a given angle in radians in place.
+
 pygame.math.Vector2.angle_to
  angle_to(Vector2) -> float
 calculates the angle to a given vector in degrees.
@@ -316,4 +408,154 @@ pygame.math.Vector3.from_spherical
  from_spherical((r, theta, phi)) -> None
 Sets x, y and z from a spherical coordinates 3-tuple.
 
+pygame.math.Vector2Array
+ Vector2Array() -> Vector2Array
+ Vector2Array(length) -> Vector2Array
+ Vector2Array(vectors) -> Vector2Array
+many 2-Dimensional Vectors stored together
+
+pygame.math.Vector2Array.append
+ append(Vector2) -> None
+adds a vector to the end of the array.
+
+pygame.math.Vector2Array.length
+ length() -> array
+returns the lengths of the vectors.
+
+pygame.math.Vector2Array.length_squared
+ length_squared() -> array
+returns the squared lengths of the vectors.
+
+pygame.math.Vector2Array.normalize
+ normalize() -> Vector2Array
+returns the vectors scaled to length 1.
+
+pygame.math.Vector2Array.normalize_ip
+ normalize_ip() -> None
+scales the vectors to length 1 in place.
+
+pygame.math.Vector2Array.rotate
+ rotate(float) -> Vector2Array
+rotates the vectors by a given angle in degrees.
+
+pygame.math.Vector2Array.rotate_ip
+ rotate_ip(float) -> None
+rotates the vectors by a given angle in degrees in place.
+
+pygame.math.Vector2Array.lerp
+ lerp(Vector2Array, float) -> Vector2Array
+returns a linear interpolation to the given vectors.
+
+pygame.math.Vector2Array.lerp_ip
+ lerp_ip(Vector2Array, float) -> None
+linearly interpolates to the given vectors in place.
+
+pygame.math.Vector2Array.reflect
+ reflect(Vector2) -> Vector2Array
+returns the vectors reflected of a given normal.
+
+pygame.math.Vector2Array.reflect_ip
+ reflect_ip(Vector2) -> None
+reflects the vectors of a given normal in place.
+
+pygame.math.Vector3Array
+ Vector3Array() -> Vector3Array
+ Vector3Array(length) -> Vector3Array
+ Vector3Array(vectors) -> Vector3Array
+many 3-Dimensional Vectors stored together
+
+pygame.math.Vector3Array.append
+ append(Vector3) -> None
+adds a vector to the end of the array.
+
+pygame.math.Vector3Array.length
+ length() -> array
+returns the lengths of the vectors.
+
+pygame.math.Vector3Array.length_squared
+ length_squared() -> array
+returns the squared lengths of the vectors.
+
+pygame.math.Vector3Array.normalize
+ normalize() -> Vector3Array
+returns the vectors scaled to length 1.
+
+pygame.math.Vector3Array.normalize_ip
+ normalize_ip() -> None
+scales the vectors to length 1 in place.
+
+pygame.math.Vector3Array.rotate
+ rotate(float, Vector3) -> Vector3Array
+rotates the vectors by a given angle in degrees.
+
+pygame.math.Vector3Array.rotate_ip
+ rotate_ip(float, Vector3) -> None
+rotates the vectors by a given angle in degrees in place.
+
+pygame.math.Vector3Array.lerp
+ lerp(Vector3Array, float) -> Vector3Array
+returns a linear interpolation to the given vectors.
+
+pygame.math.Vector3Array.lerp_ip
+ lerp_ip(Vector3Array, float) -> None
+linearly interpolates to the given vectors in place.
+
+pygame.math.Vector3Array.reflect
+ reflect(Vector3) -> Vector3Array
+returns the vectors reflected of a given normal.
+
+pygame.math.Vector3Array.reflect_ip
+ reflect_ip(Vector3) -> None
+reflects the vectors of a given normal in place.
+
+pygame.math.Rotation2
+ Rotation2(angle, radians=False) -> Rotation2
+a 2D rotation by a fixed angle
+
+pygame.math.Rotation2.apply
+ apply(Vector2) -> Vector2
+ apply(Vector2Array) -> Vector2Array
+returns the given vectors rotated.
+
+pygame.math.Rotation2.apply_ip
+ apply_ip(Vector2) -> None
+ apply_ip(Vector2Array) -> None
+ apply_ip(buffer) -> None
+rotates the given vectors in place.
+
+pygame.math.Rotation2.inverse
+ inverse() -> Rotation2
+returns the reverse rotation.
+
+pygame.math.Rotation2.angle
+ angle -> float
+the angle of the rotation in degrees.
+
+pygame.math.Rotation3
+ Rotation3(angle, axis, radians=False) -> Rotation3
+a 3D rotation by a fixed angle around an axis
+
+pygame.math.Rotation3.apply
+ apply(Vector3) -> Vector3
+ apply(Vector3Array) -> Vector3Array
+returns the given vectors rotated.
+
+pygame.math.Rotation3.apply_ip
+ apply_ip(Vector3) -> None
+ apply_ip(Vector3Array) -> None
+ apply_ip(buffer) -> None
+rotates the given vectors in place.
+
+pygame.math.Rotation3.inverse
+ inverse() -> Rotation3
+returns the reverse rotation.
+
+pygame.math.Rotation3.angle
+ angle -> float
+the angle of the rotation in degrees.
+
+pygame.math.Rotation3.axis
+ axis -> Vector3
+the axis of the rotation.
+
 */
\ No newline at end of file
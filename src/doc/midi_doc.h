@@ -9,6 +9,12 @@
 
 #define DOC_INPUTREAD "read(num_events) -> midi_event_list\nreads num_events midi events from the buffer."
 
+#define DOC_INPUTREADINTO "read_into(buffer) -> num_events\nreads midi events into a buffer."
+
+#define DOC_INPUTSTARTEVENTS "start_events(interval=1) -> None\nposts MIDIIN events from a background thread."
+
+#define DOC_INPUTSTOPEVENTS "stop_events() -> None\nstops posting MIDIIN events."
+
 #define DOC_PYGAMEMIDIMIDIEXCEPTION "MidiException(errno) -> None\nexception that pygame.midi functions and classes can raise"
 
 #define DOC_PYGAMEMIDIOUTPUT "Output(device_id) -> None\nOutput(device_id, latency = 0) -> None\nOutput(device_id, buffer_size = 4096) -> None\nOutput(device_id, latency, buffer_size) -> None\nOutput is used to send midi to an output device"
@@ -25,6 +31,8 @@
 
 #define DOC_OUTPUTWRITE "write(data) -> None\nwrites a list of midi data to the Output"
 
+#define DOC_OUTPUTWRITEBUFFER "write_buffer(buffer) -> num_events\nwrites midi events packed in a buffer to the Output"
+
 #define DOC_OUTPUTWRITESHORT "write_short(status) -> None\nwrite_short(status, data1 = 0, data2 = 0) -> None\nwrite_short(status <, data1><, data2>)"
 
 #define DOC_OUTPUTWRITESYSEX "write_sys_ex(when, msg) -> None\nwrites a timestamped system-exclusive midi message."
@@ -71,6 +79,18 @@ pygame.midi.Input.read
  read(num_events) -> midi_event_list
 reads num_events midi events from the buffer.
 
+pygame.midi.Input.read_into
+ read_into(buffer) -> num_events
+reads midi events into a buffer.
+
+pygame.midi.Input.start_events
+ start_events(interval=1) -> None
+posts MIDIIN events from a background thread.
+
+pygame.midi.Input.stop_events
+ stop_events() -> None
+stops posting MIDIIN events.
+
 pygame.midi.MidiException
  MidiException(errno) -> None
 exception that pygame.midi functions and classes can raise
@@ -106,6 +126,10 @@ pygame.midi.Output.write
  write(data) -> None
 writes a list of midi data to the Output
 
+pygame.midi.Output.write_buffer
+ write_buffer(buffer) -> num_events
+writes midi events packed in a buffer to the Output
+
 pygame.midi.Output.write_short
  write_short(status) -> None
  write_short(status, data1 = 0, data2 = 0) -> None
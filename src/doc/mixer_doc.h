@@ -9,12 +9,20 @@
 
 #define DOC_PYGAMEMIXERGETINIT "get_init() -> (frequency, format, channels)\ntest if the mixer is initialized"
 
+#define DOC_PYGAMEMIXERGETLATENCY "get_latency() -> seconds\nget the time one audio buffer takes to play"
+
+#define DOC_PYGAMEMIXERGETCALLBACKSTATS "get_callback_stats() -> dict\nget timing statistics of the audio callback"
+
+#define DOC_PYGAMEMIXERRESETCALLBACKSTATS "reset_callback_stats() -> None\nstart the audio callback statistics over"
+
 #define DOC_PYGAMEMIXERSTOP "stop() -> None\nstop playback of all sound channels"
 
 #define DOC_PYGAMEMIXERPAUSE "pause() -> None\ntemporarily stop playback of all sound channels"
 
 #define DOC_PYGAMEMIXERUNPAUSE "unpause() -> None\nresume paused playback of sound channels"
 
+#define DOC_PYGAMEMIXERLOADMANY "load_many(paths, callback=None, event=NOEVENT, compressed=False) -> list\nload many sound files on worker threads"
+
 #define DOC_PYGAMEMIXERFADEOUT "fadeout(time) -> None\nfade out the volume on all sounds before stopping"
 
 #define DOC_PYGAMEMIXERSETNUMCHANNELS "set_num_channels(count) -> None\nset the total number of playback channels"
@@ -23,11 +31,15 @@
 
 #define DOC_PYGAMEMIXERSETRESERVED "set_reserved(count) -> None\nreserve channels from being automatically used"
 
+#define DOC_PYGAMEMIXERSETSTEALPOLICY "set_steal_policy(policy) -> None\nchoose which playing channel a Sound takes when none are free"
+
+#define DOC_PYGAMEMIXERGETSTEALPOLICY "get_steal_policy() -> policy\nget the policy for taking over playing channels"
+
 #define DOC_PYGAMEMIXERFINDCHANNEL "find_channel(force=False) -> Channel\nfind an unused channel"
 
 #define DOC_PYGAMEMIXERGETBUSY "get_busy() -> bool\ntest if any sound is being mixed"
 
-#define DOC_PYGAMEMIXERSOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nCreate a new Sound object from a file or buffer object"
+#define DOC_PYGAMEMIXERSOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nSound(file, compressed=True) -> Sound\nSound(file, stream=True) -> Sound\nSound(buffer=buffer, copy=False) -> Sound\nSound(array=object, copy=False) -> Sound\nCreate a new Sound object from a file or buffer object"
 
 #define DOC_SOUNDPLAY "play(loops=0, maxtime=0, fade_ms=0) -> Channel\nbegin sound playback"
 
@@ -41,9 +53,21 @@
 
 #define DOC_SOUNDGETNUMCHANNELS "get_num_channels() -> count\ncount how many times this Sound is playing"
 
+#define DOC_SOUNDSETPRIORITY "set_priority(priority) -> None\nset how important this Sound is to keep playing"
+
+#define DOC_SOUNDGETPRIORITY "get_priority() -> priority\nget the priority of this Sound"
+
+#define DOC_SOUNDSETMAXINSTANCES "set_max_instances(count) -> None\nlimit how many channels this Sound plays on at once"
+
+#define DOC_SOUNDGETMAXINSTANCES "get_max_instances() -> count\nget the limit of channels this Sound plays on at once"
+
 #define DOC_SOUNDGETLENGTH "get_length() -> seconds\nget the length of the Sound"
 
-#define DOC_SOUNDGETRAW "get_raw() -> bytes\nreturn a bytestring copy of the Sound samples."
+#define DOC_SOUNDGETRAW "get_raw() -> bytes\nget_raw(copy=False) -> BufferProxy\nreturn a bytestring copy of the Sound samples."
+
+#define DOC_SOUNDWRITE "write(offset, buffer) -> None\noverwrite samples of the Sound in place"
+
+#define DOC_SOUNDSUBSOUND "subsound(start, length=-1) -> Sound\ncreate a new Sound that shares samples with its parent"
 
 #define DOC_PYGAMEMIXERCHANNEL "Channel(id) -> Channel\nCreate a Channel object for controlling playback"
 
@@ -61,6 +85,16 @@
 
 #define DOC_CHANNELGETVOLUME "get_volume() -> value\nget the volume of the playing channel"
 
+#define DOC_CHANNELSETGAIN "set_gain(gain, time=0.0) -> None\nfade the channel to a gain"
+
+#define DOC_CHANNELSETPAN "set_pan(pan) -> None\nplace the channel between the speakers"
+
+#define DOC_CHANNELSETDISTANCE "set_distance(distance, rolloff=1.0) -> None\nattenuate the channel for a distance"
+
+#define DOC_CHANNELSETFILTER "set_filter(type, frequency=1000.0, q=0.7071) -> None\nfilter the channel"
+
+#define DOC_CHANNELCLEAREFFECTS "clear_effects() -> None\nremove the effects of the channel"
+
 #define DOC_CHANNELGETBUSY "get_busy() -> bool\ncheck if the channel is active"
 
 #define DOC_CHANNELGETSOUND "get_sound() -> Sound\nget the currently playing Sound"
@@ -98,6 +132,18 @@ pygame.mixer.get_init
  get_init() -> (frequency, format, channels)
 test if the mixer is initialized
 
+pygame.mixer.get_latency
+ get_latency() -> seconds
+get the time one audio buffer takes to play
+
+pygame.mixer.get_callback_stats
+ get_callback_stats() -> dict
+get timing statistics of the audio callback
+
+pygame.mixer.reset_callback_stats
+ reset_callback_stats() -> None
+start the audio callback statistics over
+
 pygame.mixer.stop
  stop() -> None
 stop playback of all sound channels
@@ -110,6 +156,10 @@ pygame.mixer.unpause
  unpause() -> None
 resume paused playback of sound channels
 
+pygame.mixer.load_many
+ load_many(paths, callback=None, event=NOEVENT, compressed=False) -> list
+load many sound files on worker threads
+
 pygame.mixer.fadeout
  fadeout(time) -> None
 fade out the volume on all sounds before stopping
@@ -126,6 +176,14 @@ pygame.mixer.set_reserved
  set_reserved(count) -> None
 reserve channels from being automatically used
 
+pygame.mixer.set_steal_policy
+ set_steal_policy(policy) -> None
+choose which playing channel a Sound takes when none are free
+
+pygame.mixer.get_steal_policy
+ get_steal_policy() -> policy
+get the policy for taking over playing channels
+
 pygame.mixer.find_channel
  find_channel(force=False) -> Channel
 find an unused channel
@@ -142,6 +200,10 @@ pygame.mixer.Sound
  Sound(object) -> Sound
  Sound(file=object) -> Sound
  Sound(array=object) -> Sound
+ Sound(file, compressed=True) -> Sound
+ Sound(file, stream=True) -> Sound
+ Sound(buffer=buffer, copy=False) -> Sound
+ Sound(array=object, copy=False) -> Sound
 Create a new Sound object from a file or buffer object
 
 pygame.mixer.Sound.play
@@ -168,14 +230,39 @@ pygame.mixer.Sound.get_num_channels
  get_num_channels() -> count
 count how many times this Sound is playing
 
+pygame.mixer.Sound.set_priority
+ set_priority(priority) -> None
+set how important this Sound is to keep playing
+
+pygame.mixer.Sound.get_priority
+ get_priority() -> priority
+get the priority of this Sound
+
+pygame.mixer.Sound.set_max_instances
+ set_max_instances(count) -> None
+limit how many channels this Sound plays on at once
+
+pygame.mixer.Sound.get_max_instances
+ get_max_instances() -> count
+get the limit of channels this Sound plays on at once
+
 pygame.mixer.Sound.get_length
  get_length() -> seconds
 get the length of the Sound
 
 pygame.mixer.Sound.get_raw
  get_raw() -> bytes
+ get_raw(copy=False) -> BufferProxy
 return a bytestring copy of the Sound samples.
 
+pygame.mixer.Sound.write
+ write(offset, buffer) -> None
+overwrite samples of the Sound in place
+
+pygame.mixer.Sound.subsound
+ subsound(start, length=-1) -> Sound
+create a new Sound that shares samples with its parent
+
 pygame.mixer.Channel
  Channel(id) -> Channel
 Create a Channel object for controlling playback
@@ -209,6 +296,26 @@ pygame.mixer.Channel.get_volume
  get_volume() -> value
 get the volume of the playing channel
 
+pygame.mixer.Channel.set_gain
+ set_gain(gain, time=0.0) -> None
+fade the channel to a gain
+
+pygame.mixer.Channel.set_pan
+ set_pan(pan) -> None
+place the channel between the speakers
+
+pygame.mixer.Channel.set_distance
+ set_distance(distance, rolloff=1.0) -> None
+attenuate the channel for a distance
+
+pygame.mixer.Channel.set_filter
+ set_filter(type, frequency=1000.0, q=0.7071) -> None
+filter the channel
+
+pygame.mixer.Channel.clear_effects
+ clear_effects() -> None
+remove the effects of the channel
+
 pygame.mixer.Channel.get_busy
  get_busy() -> bool
 check if the channel is active
@@ -25,7 +25,7 @@
 
 #define DOC_PYGAMEMIXERMUSICGETPOS "get_pos() -> time\nget the music play time"
 
-#define DOC_PYGAMEMIXERMUSICQUEUE "queue(filename) -> None\nqueue a music file to follow the current"
+#define DOC_PYGAMEMIXERMUSICQUEUE "queue(filename, loops=0) -> None\nqueue a music file to follow the current"
 
 #define DOC_PYGAMEMIXERMUSICSETENDEVENT "set_endevent() -> None\nset_endevent(type) -> None\nhave the music send an event when playback stops"
 
@@ -90,7 +90,7 @@ pygame.mixer.music.get_pos
 get the music play time
 
 pygame.mixer.music.queue
- queue(filename) -> None
+ queue(filename, loops=0) -> None
 queue a music file to follow the current
 
 pygame.mixer.music.set_endevent
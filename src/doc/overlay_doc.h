@@ -1,7 +1,7 @@
 /* Auto generated file: with makeref.py .  Docs go in src/ *.doc . */
 #define DOC_PYGAMEOVERLAY "Overlay(format, (width, height)) -> Overlay\npygame object for video overlay graphics"
 
-#define DOC_OVERLAYDISPLAY "display((y, u, v)) -> None\ndisplay() -> None\nset the overlay pixel data"
+#define DOC_OVERLAYDISPLAY "display((y, u, v)) -> None\ndisplay(yuv) -> None\ndisplay() -> None\nset the overlay pixel data"
 
 #define DOC_OVERLAYSETLOCATION "set_location(rect) -> None\ncontrol where the overlay is displayed"
 
@@ -19,6 +19,7 @@ pygame object for video overlay graphics
 
 pygame.Overlay.display
  display((y, u, v)) -> None
+ display(yuv) -> None
  display() -> None
 set the overlay pixel data
 
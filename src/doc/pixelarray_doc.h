@@ -21,6 +21,14 @@
 
 #define DOC_PIXELARRAYTRANSPOSE "transpose() -> PixelArray\nExchanges the x and y axis."
 
+#define DOC_PIXELARRAYREADRECT "read_rect(buffer, rect=None) -> None\nCopies the pixels of a rect into a buffer of integers."
+
+#define DOC_PIXELARRAYWRITERECT "write_rect(buffer, rect=None) -> None\nCopies a buffer of integers into the pixels of a rect."
+
+#define DOC_PIXELARRAYREADPOINTS "read_points(points, buffer) -> None\nCopies the pixels at a buffer of points into a buffer of integers."
+
+#define DOC_PIXELARRAYWRITEPOINTS "write_points(points, values) -> None\nSets the pixels at a buffer of points."
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -70,5 +78,20 @@ Compares the PixelArray with another one.
 pygame.PixelArray.transpose
  transpose() -> PixelArray
 Exchanges the x and y axis.
+pygame.PixelArray.read_rect
+ read_rect(buffer, rect=None) -> None
+Copies the pixels of a rect into a buffer of integers.
+
+pygame.PixelArray.write_rect
+ write_rect(buffer, rect=None) -> None
+Copies a buffer of integers into the pixels of a rect.
+
+pygame.PixelArray.read_points
+ read_points(points, buffer) -> None
+Copies the pixels at a buffer of points into a buffer of integers.
+
+pygame.PixelArray.write_points
+ write_points(points, values) -> None
+Sets the pixels at a buffer of points.
 
 */
\ No newline at end of file
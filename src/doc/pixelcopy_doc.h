@@ -9,6 +9,10 @@
 
 #define DOC_PYGAMEPIXELCOPYMAKESURFACE "pygame.pixelcopy.make_surface(array) -> Surface\nCopy an array to a new surface"
 
+#define DOC_PYGAMEPIXELCOPYGETCOPYTHREADS "get_copy_threads() -> int\nget the number of threads array copies use"
+
+#define DOC_PYGAMEPIXELCOPYSETCOPYTHREADS "set_copy_threads(count) -> None\nset the number of threads array copies use"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -34,4 +38,12 @@ pygame.pixelcopy.make_surface
  pygame.pixelcopy.make_surface(array) -> Surface
 Copy an array to a new surface
 
+pygame.pixelcopy.get_copy_threads
+ get_copy_threads() -> int
+get the number of threads array copies use
+
+pygame.pixelcopy.set_copy_threads
+ set_copy_threads(count) -> None
+set the number of threads array copies use
+
 */
\ No newline at end of file
@@ -21,6 +21,24 @@
 
 #define DOC_PYGAMEENCODEFILEPATH "encode_file_path([obj [, etype]]) -> bytes or None\nEncode a unicode or bytes object as a file system path"
 
+#define DOC_PYGAMEGETIOBUFFERSIZE "get_io_buffer_size() -> int\nget the size of the buffer for reading and writing file objects"
+
+#define DOC_PYGAMESETIOBUFFERSIZE "set_io_buffer_size(size) -> None\nset the size of the buffer for reading and writing file objects"
+
+#define DOC_PYGAMEGETPOOLTHREADS "get_pool_threads() -> count\nget the number of threads of the pygame worker pool"
+
+#define DOC_PYGAMESETPOOLTHREADS "set_pool_threads(count) -> None\nset the number of threads of the pygame worker pool"
+
+#define DOC_PYGAMESETPOOLAFFINITY "set_pool_affinity(cpus=None) -> None\nkeep the worker pool threads on the given CPUs"
+
+#define DOC_PYGAMEPOOLMAP "pool_map(func, seq) -> list\ncall a function for each item of a sequence on the worker pool"
+
+#define DOC_PYGAMEGETCPUFEATURES "get_cpu_features() -> tuple\nget the SIMD instruction sets of the CPU"
+
+#define DOC_PYGAMEGETSIMDBACKEND "get_simd_backend(module) -> str\nget_simd_backend() -> dict\nget the SIMD backend of a pygame module"
+
+#define DOC_PYGAMESETSIMDBACKEND "set_simd_backend(module, name) -> None\nset the SIMD backend of a pygame module"
+
 #define DOC_PYGAMEVERSION "small module containing version information"
 
 #define DOC_PYGAMEVERSIONVER "ver = '1.2'\nversion number as a string"
@@ -78,6 +96,43 @@ pygame.encode_file_path
  encode_file_path([obj [, etype]]) -> bytes or None
 Encode a unicode or bytes object as a file system path
 
+pygame.get_io_buffer_size
+ get_io_buffer_size() -> int
+get the size of the buffer for reading and writing file objects
+
+pygame.set_io_buffer_size
+ set_io_buffer_size(size) -> None
+set the size of the buffer for reading and writing file objects
+
+pygame.get_pool_threads
+ get_pool_threads() -> count
+get the number of threads of the pygame worker pool
+
+pygame.set_pool_threads
+ set_pool_threads(count) -> None
+set the number of threads of the pygame worker pool
+
+pygame.set_pool_affinity
+ set_pool_affinity(cpus=None) -> None
+keep the worker pool threads on the given CPUs
+
+pygame.pool_map
+ pool_map(func, seq) -> list
+call a function for each item of a sequence on the worker pool
+
+pygame.get_cpu_features
+ get_cpu_features() -> tuple
+get the SIMD instruction sets of the CPU
+
+pygame.get_simd_backend
+ get_simd_backend(module) -> str
+ get_simd_backend() -> dict
+get the SIMD backend of a pygame module
+
+pygame.set_simd_backend
+ set_simd_backend(module, name) -> None
+set the SIMD backend of a pygame module
+
 pygame.version
 small module containing version information
 
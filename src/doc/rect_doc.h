@@ -21,9 +21,9 @@
 
 #define DOC_RECTUNIONIP "union_ip(Rect) -> None\njoins two rectangles into one, in place"
 
-#define DOC_RECTUNIONALL "unionall(Rect_sequence) -> Rect\nthe union of many rectangles"
+#define DOC_RECTUNIONALL "unionall(Rect_sequence) -> Rect\nunionall(sequence, key) -> Rect\nthe union of many rectangles"
 
-#define DOC_RECTUNIONALLIP "unionall_ip(Rect_sequence) -> None\nthe union of many rectangles, in place"
+#define DOC_RECTUNIONALLIP "unionall_ip(Rect_sequence) -> None\nunionall_ip(sequence, key) -> None\nthe union of many rectangles, in place"
 
 #define DOC_RECTFIT "fit(Rect) -> Rect\nresize and move a rectangle with aspect ratio"
 
@@ -35,14 +35,31 @@
 
 #define DOC_RECTCOLLIDERECT "colliderect(Rect) -> bool\ntest if two rectangles overlap"
 
-#define DOC_RECTCOLLIDELIST "collidelist(list) -> index\ntest if one rectangle in a list intersects"
+#define DOC_RECTCOLLIDELIST "collidelist(list) -> index\ncollidelist(list, key) -> index\ntest if one rectangle in a list intersects"
 
-#define DOC_RECTCOLLIDELISTALL "collidelistall(list) -> indices\ntest if all rectangles in a list intersect"
+#define DOC_RECTCOLLIDELISTALL "collidelistall(list) -> indices\ncollidelistall(list, key) -> indices\ntest if all rectangles in a list intersect"
 
 #define DOC_RECTCOLLIDEDICT "collidedict(dict) -> (key, value)\ntest if one rectangle in a dictionary intersects"
 
 #define DOC_RECTCOLLIDEDICTALL "collidedictall(dict) -> [(key, value), ...]\ntest if all rectangles in a dictionary intersect"
 
+#define DOC_PYGAMERECTARRAY "RectArray() -> RectArray\nRectArray(length) -> RectArray\nRectArray(sequence) -> RectArray\npygame object for a packed array of rectangles"
+
+#define DOC_RECTARRAYAPPEND "append(Rect) -> None\nadds a rectangle to the end of the array"
+
+#define DOC_RECTARRAYCOLLIDEPOINT "collidepoint(x, y) -> [index, ...]\ncollidepoint((x,y)) -> [index, ...]\nfind the rectangles containing a point"
+
+#define DOC_RECTARRAYCOLLIDERECT "colliderect(Rect) -> [index, ...]\nfind the rectangles intersecting a rectangle"
+
+#define DOC_RECTARRAYCLIP "clip(Rect) -> RectArray\ncrops each rectangle inside another"
+
+#define DOC_RECTARRAYUNION "union(Rect) -> RectArray\njoins each rectangle with another"
+
+#define DOC_RECTARRAYUNIONALL "unionall() -> Rect\nthe union of all the rectangles"
+
+#define DOC_RECTARRAYMOVEIP "move_ip(x, y) -> None\nmoves all the rectangles, in place"
+
+#define DOC_PYGAMERECTCOLLIDEPAIRS "collide_pairs(rects) -> array\ncollide_pairs(rects, key) -> array\nfind all the intersecting pairs in a list of rectangles"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -97,10 +114,12 @@ joins two rectangles into one, in place
 
 pygame.Rect.unionall
  unionall(Rect_sequence) -> Rect
+ unionall(sequence, key) -> Rect
 the union of many rectangles
 
 pygame.Rect.unionall_ip
  unionall_ip(Rect_sequence) -> None
+ unionall_ip(sequence, key) -> None
 the union of many rectangles, in place
 
 pygame.Rect.fit
@@ -126,10 +145,12 @@ test if two rectangles overlap
 
 pygame.Rect.collidelist
  collidelist(list) -> index
+ collidelist(list, key) -> index
 test if one rectangle in a list intersects
 
 pygame.Rect.collidelistall
  collidelistall(list) -> indices
+ collidelistall(list, key) -> indices
 test if all rectangles in a list intersect
 
 pygame.Rect.collidedict
@@ -140,4 +161,44 @@ pygame.Rect.collidedictall
  collidedictall(dict) -> [(key, value), ...]
 test if all rectangles in a dictionary intersect
 
+pygame.RectArray
+ RectArray() -> RectArray
+ RectArray(length) -> RectArray
+ RectArray(sequence) -> RectArray
+pygame object for a packed array of rectangles
+
+pygame.RectArray.append
+ append(Rect) -> None
+adds a rectangle to the end of the array
+
+pygame.RectArray.collidepoint
+ collidepoint(x, y) -> [index, ...]
+ collidepoint((x,y)) -> [index, ...]
+find the rectangles containing a point
+
+pygame.RectArray.colliderect
+ colliderect(Rect) -> [index, ...]
+find the rectangles intersecting a rectangle
+
+pygame.RectArray.clip
+ clip(Rect) -> RectArray
+crops each rectangle inside another
+
+pygame.RectArray.union
+ union(Rect) -> RectArray
+joins each rectangle with another
+
+pygame.RectArray.unionall
+ unionall() -> Rect
+the union of all the rectangles
+
+pygame.RectArray.move_ip
+ move_ip(x, y) -> None
+moves all the rectangles, in place
+
+pygame.rect.collide_pairs
+ collide_pairs(rects) -> array
+ collide_pairs(rects, key) -> array
+find all the intersecting pairs in a list of rectangles
+
 */
\ No newline at end of file
@@ -15,6 +15,8 @@
 
 #define DOC_PYGAMESCRAPSETMODE "set_mode(mode) -> None\nSets the clipboard access mode."
 
+#define DOC_PYGAMESCRAPREQUEST "request (type, event) -> None\nRequests the data for the specified type without waiting for it."
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -52,4 +54,8 @@ pygame.scrap.set_mode
  set_mode(mode) -> None
 Sets the clipboard access mode.
 
+pygame.scrap.request
+ request (type, event) -> None
+Requests the data for the specified type without waiting for it.
+
 */
\ No newline at end of file
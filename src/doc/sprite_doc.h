@@ -65,6 +65,8 @@
 
 #define DOC_LAYEREDUPDATESCHANGELAYER "change_layer(sprite, new_layer) -> None\nchanges the layer of the sprite"
 
+#define DOC_LAYEREDUPDATESSORTBYKEY "sort_by_key(key) -> None\nchanges the layer of every sprite to key(sprite)"
+
 #define DOC_LAYEREDUPDATESGETLAYEROFSPRITE "get_layer_of_sprite(sprite) -> layer\nreturns the layer that sprite is currently in."
 
 #define DOC_LAYEREDUPDATESGETTOPLAYER "get_top_layer() -> layer\nreturns the top layer"
@@ -99,6 +101,24 @@
 
 #define DOC_PYGAMESPRITEGROUPSINGLE "GroupSingle(sprite=None) -> GroupSingle\nGroup container that holds a single sprite."
 
+#define DOC_PYGAMESPRITESPRITEBATCH "SpriteBatch(images) -> SpriteBatch\nMany simple sprites drawn from an atlas of images, stored in C arrays."
+
+#define DOC_SPRITEBATCHADD "add(pos, image=0, velocity=(0, 0), layer=0, visible=True) -> index\nadd a sprite to the batch"
+
+#define DOC_SPRITEBATCHREMOVE "remove(index) -> None\nremove a sprite from the batch"
+
+#define DOC_SPRITEBATCHGET "get(index) -> (pos, velocity, image, layer, visible)\nget everything about a sprite"
+
+#define DOC_SPRITEBATCHSET "set(index, pos=None, velocity=None, image=None, layer=None, visible=None) -> None\nchange a sprite"
+
+#define DOC_SPRITEBATCHGETRECT "get_rect(index) -> Rect\nthe area a sprite covers"
+
+#define DOC_SPRITEBATCHUPDATE "update(dt) -> None\nmove every sprite by its velocity"
+
+#define DOC_SPRITEBATCHCULL "cull(viewport) -> index_list\nfind the visible sprites within an area"
+
+#define DOC_SPRITEBATCHDRAW "draw(surface, viewport=None) -> Rect_list\ndraw the visible sprites in layer order"
+
 #define DOC_PYGAMESPRITESPRITECOLLIDE "spritecollide(sprite, group, dokill, collided = None) -> Sprite_list\nFind sprites in a group that intersect another sprite."
 
 #define DOC_PYGAMESPRITECOLLIDERECT "collide_rect(left, right) -> bool\nCollision detection between two sprites, using rects."
@@ -250,6 +270,10 @@ pygame.sprite.LayeredUpdates.change_layer
  change_layer(sprite, new_layer) -> None
 changes the layer of the sprite
 
+pygame.sprite.LayeredUpdates.sort_by_key
+ sort_by_key(key) -> None
+changes the layer of every sprite to key(sprite)
+
 pygame.sprite.LayeredUpdates.get_layer_of_sprite
  get_layer_of_sprite(sprite) -> layer
 returns the layer that sprite is currently in.
@@ -318,6 +342,42 @@ pygame.sprite.GroupSingle
  GroupSingle(sprite=None) -> GroupSingle
 Group container that holds a single sprite.
 
+pygame.sprite.SpriteBatch
+ SpriteBatch(images) -> SpriteBatch
+Many simple sprites drawn from an atlas of images, stored in C arrays.
+
+pygame.sprite.SpriteBatch.add
+ add(pos, image=0, velocity=(0, 0), layer=0, visible=True) -> index
+add a sprite to the batch
+
+pygame.sprite.SpriteBatch.remove
+ remove(index) -> None
+remove a sprite from the batch
+
+pygame.sprite.SpriteBatch.get
+ get(index) -> (pos, velocity, image, layer, visible)
+get everything about a sprite
+
+pygame.sprite.SpriteBatch.set
+ set(index, pos=None, velocity=None, image=None, layer=None, visible=None) -> None
+change a sprite
+
+pygame.sprite.SpriteBatch.get_rect
+ get_rect(index) -> Rect
+the area a sprite covers
+
+pygame.sprite.SpriteBatch.update
+ update(dt) -> None
+move every sprite by its velocity
+
+pygame.sprite.SpriteBatch.cull
+ cull(viewport) -> index_list
+find the visible sprites within an area
+
+pygame.sprite.SpriteBatch.draw
+ draw(surface, viewport=None) -> Rect_list
+draw the visible sprites in layer order
+
 pygame.sprite.spritecollide
  spritecollide(sprite, group, dokill, collided = None) -> Sprite_list
 Find sprites in a group that intersect another sprite.
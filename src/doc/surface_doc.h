@@ -1,17 +1,23 @@
 /* Auto generated file: with makeref.py .  Docs go in src/ *.doc . */
-#define DOC_PYGAMESURFACE "Surface((width, height), flags=0, depth=0, masks=None) -> Surface\nSurface((width, height), flags=0, Surface) -> Surface\npygame object for representing images"
+#define DOC_PYGAMESURFACE "Surface((width, height), flags=0, depth=0, masks=None, align=0) -> Surface\nSurface((width, height), flags=0, Surface) -> Surface\npygame object for representing images"
 
 #define DOC_SURFACEBLIT "blit(source, dest, area=None, special_flags = 0) -> Rect\ndraw one image onto another"
 
+#define DOC_SURFACEBLITS "blits(blit_sequence=((source, dest), ...), doreturn=1) -> [Rect, ...] or None\nblits((source, dest, area), ...)) -> [Rect, ...]\nblits((source, dest, area, special_flags), ...)) -> [Rect, ...]\ndraw many images onto another"
+
 #define DOC_SURFACECONVERT "convert(Surface) -> Surface\nconvert(depth, flags=0) -> Surface\nconvert(masks, flags=0) -> Surface\nconvert() -> Surface\nchange the pixel format of an image"
 
 #define DOC_SURFACECONVERTALPHA "convert_alpha(Surface) -> Surface\nconvert_alpha() -> Surface\nchange the pixel format of an image including per pixel alphas"
 
+#define DOC_SURFACEPREMULALPHA "premul_alpha() -> Surface\nreturns a copy of the surface with the RGB channels pre-multiplied by the alpha channel"
+
+#define DOC_SURFACEGETPREMULALPHA "get_premul_alpha() -> bool\ntest if the Surface has premultiplied alpha"
+
 #define DOC_SURFACECOPY "copy() -> Surface\ncreate a new copy of a Surface"
 
 #define DOC_SURFACEFILL "fill(color, rect=None, special_flags=0) -> Rect\nfill Surface with a solid color"
 
-#define DOC_SURFACESCROLL "scroll(dx=0, dy=0) -> None\nShift the surface image in place"
+#define DOC_SURFACESCROLL "scroll(dx=0, dy=0) -> None\nscroll(dx=0, dy=0, exposed=True) -> [Rect, ...]\nShift the surface image in place"
 
 #define DOC_SURFACESETCOLORKEY "set_colorkey(Color, flags=0) -> None\nset_colorkey(None) -> None\nSet the transparent colorkey"
 
@@ -36,6 +42,8 @@
 #define DOC_SURFACESETAT "set_at((x, y), Color) -> None\nset the color value for a single pixel"
 
 #define DOC_SURFACEGETATMAPPED "get_at_mapped((x, y)) -> Color\nget the mapped color value at a single pixel"
+#define DOC_SURFACEGETATMANY "get_at_many(points) -> [int, ...]\nget_at_many(points, mapped) -> mapped\nget the mapped color values of many pixels"
+#define DOC_SURFACESETATMANY "set_at_many(points, colors) -> None\nset the mapped color values of many pixels"
 
 #define DOC_SURFACEGETPALETTE "get_palette() -> [RGB, RGB, RGB, ...]\nget the color index palette for an 8bit Surface"
 
@@ -53,8 +61,16 @@
 
 #define DOC_SURFACEGETCLIP "get_clip() -> Rect\nget the current clipping area of the Surface"
 
+#define DOC_SURFACETRACKDAMAGE "track_damage(enable=True) -> None\nkeep track of the changed areas of the Surface"
+
+#define DOC_SURFACEGETDAMAGE "get_damage(clear=True) -> Rect_list\nget the changed areas of the Surface"
+
+#define DOC_SURFACEGETAUTOCONVERSIONS "get_auto_conversions() -> int\ncount the display format copies made of the Surface"
+
 #define DOC_SURFACESUBSURFACE "subsurface(Rect) -> Surface\ncreate a new surface that references its parent"
 
+#define DOC_SURFACEREGION "region(Rect) -> SurfaceRegion\ncreate a light view of part of the Surface"
+
 #define DOC_SURFACEGETPARENT "get_parent() -> Surface\nfind the parent of a subsurface"
 
 #define DOC_SURFACEGETABSPARENT "get_abs_parent() -> Surface\nfind the top level parent of a subsurface"
@@ -79,6 +95,14 @@
 
 #define DOC_SURFACEGETPITCH "get_pitch() -> int\nget the number of bytes used per Surface row"
 
+#define DOC_SURFACEGETROWALIGNMENT "get_row_alignment() -> int\nget the byte alignment of the Surface rows"
+
+#define DOC_SURFACECOMPRESS "compress() -> size\nkeep the Surface pixels compressed until they are used"
+
+#define DOC_SURFACEDECOMPRESS "decompress() -> None\nkeep the Surface pixels in memory again"
+
+#define DOC_SURFACEGETCOMPRESSED "get_compressed() -> bool\ntest if the Surface is compressed"
+
 #define DOC_SURFACEGETMASKS "get_masks() -> (R, G, B, A)\nthe bitmasks needed to convert between a color and a mapped integer"
 
 #define DOC_SURFACESETMASKS "set_masks((r,g,b,a)) -> None\nset the bitmasks needed to convert between a color and a mapped integer"
@@ -91,12 +115,64 @@
 
 #define DOC_SURFACEGETBOUNDINGRECT "get_bounding_rect(min_alpha = 1) -> Rect\nfind the smallest rect containing data"
 
-#define DOC_SURFACEGETVIEW "get_view(<kind>='2') -> BufferProxy\nreturn a buffer view of the Surface's pixels."
+#define DOC_SURFACEGETVIEW "get_view(<kind>='2', rect=None) -> BufferProxy\nreturn a buffer view of the Surface's pixels."
 
 #define DOC_SURFACEGETBUFFER "get_buffer() -> BufferProxy\nacquires a buffer object for the pixels of the Surface."
 
 #define DOC_SURFACEPIXELSADDRESS "_pixels_address -> int\npixel buffer address"
 
+#define DOC_SURFACEBEGINFRAME "begin_frame() -> None\nmark the pixels of a shared Surface as being changed"
+
+#define DOC_SURFACEENDFRAME "end_frame() -> None\nmark a frame of a shared Surface as complete"
+
+#define DOC_SURFACEGETFRAME "get_frame() -> int\nget the frame counter of a shared Surface"
+
+#define DOC_PYGAMESURFACEREGION "SurfaceRegion(surface, rect) -> SurfaceRegion\npygame object for a part of a Surface"
+
+#define DOC_SURFACEREGIONGETPARENT "get_parent() -> Surface\nget the Surface the region is part of"
+
+#define DOC_SURFACEREGIONGETOFFSET "get_offset() -> (x, y)\nget the position of the region in its parent"
+
+#define DOC_SURFACEREGIONGETSIZE "get_size() -> (width, height)\nget the dimensions of the region"
+
+#define DOC_SURFACEREGIONGETRECT "get_rect(**kwargs) -> Rect\nget the rectangular area of the region"
+
+#define DOC_SURFACEREGIONREGION "region(Rect) -> SurfaceRegion\ncreate a region of part of this region"
+
+#define DOC_SURFACEREGIONSUBSURFACE "subsurface() -> Surface\ncreate a subsurface of the same area"
+
+#define DOC_PYGAMESURFACEGETBLITBACKEND "get_blit_backend() -> String\nreturn the blitter version in use: 'GENERIC', 'SSE2', or 'AVX2'"
+
+#define DOC_PYGAMESURFACESETBLITBACKEND "set_blit_backend(type) -> None\nset the blitter version to one of: 'GENERIC', 'SSE2', or 'AVX2'"
+
+#define DOC_PYGAMESURFACEGETBLITTHREADS "get_blit_threads() -> int\nreturn the number of threads used for large blits"
+
+#define DOC_PYGAMESURFACESETBLITTHREADS "set_blit_threads(threads) -> None\nset the number of threads used for large blits"
+
+#define DOC_PYGAMESURFACESETAUTOCONVERT "set_auto_convert(enable=True) -> None\nblit to the display from display format copies"
+
+#define DOC_PYGAMESURFACEGETAUTOCONVERT "get_auto_convert() -> bool\ntest if blits to the display use display format copies"
+
+#define DOC_PYGAMESURFACEGETAUTOCONVERTSTATS "get_auto_convert_stats(reset=False) -> (conversions, hits)\ncount the display format copies made and used"
+
+#define DOC_PYGAMESURFACECREATESHARED "create_shared(name, (width, height), flags=0, depth=32, masks=None) -> Surface\ncreate a Surface in named shared memory"
+
+#define DOC_PYGAMESURFACEOPENSHARED "open_shared(name) -> Surface\nmap a Surface another process created in shared memory"
+
+#define DOC_PYGAMESURFACEUNLINKSHARED "unlink_shared(name) -> None\nremove the name of shared Surface memory"
+
+#define DOC_PYGAMESURFACESETPOOLLIMIT "set_pool_limit(limit, largest=None) -> None\nset how much pixel memory is kept for new Surfaces"
+
+#define DOC_PYGAMESURFACEGETPOOLLIMIT "get_pool_limit() -> (limit, largest)\nget how much pixel memory is kept for new Surfaces"
+
+#define DOC_PYGAMESURFACEGETPOOLSTATS "get_pool_stats(reset=False) -> (idle, idle_bytes, used, used_bytes, hits, misses, drops)\ncount the pixel buffers kept for new Surfaces"
+
+#define DOC_PYGAMESURFACESETDECOMPRESSEDLIMIT "set_decompressed_limit(limit) -> None\nset how many bytes of compressed Surfaces are kept decoded"
+
+#define DOC_PYGAMESURFACEGETDECOMPRESSEDLIMIT "get_decompressed_limit() -> limit\nget how many bytes of compressed Surfaces are kept decoded"
+
+#define DOC_PYGAMESURFACEGETCOMPRESSSTATS "get_compress_stats(reset=False) -> (compressed, compressed_bytes, decoded, decoded_bytes, decodes, encodes)\ncount the compressed Surfaces"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -104,7 +180,7 @@
 /*
 
 pygame.Surface
- Surface((width, height), flags=0, depth=0, masks=None) -> Surface
+ Surface((width, height), flags=0, depth=0, masks=None, align=0) -> Surface
  Surface((width, height), flags=0, Surface) -> Surface
 pygame object for representing images
 
@@ -112,6 +188,12 @@ pygame.Surface.blit
  blit(source, dest, area=None, special_flags = 0) -> Rect
 draw one image onto another
 
+pygame.Surface.blits
+ blits(blit_sequence=((source, dest), ...), doreturn=1) -> [Rect, ...] or None
+ blits((source, dest, area), ...)) -> [Rect, ...]
+ blits((source, dest, area, special_flags), ...)) -> [Rect, ...]
+draw many images onto another
+
 pygame.Surface.convert
  convert(Surface) -> Surface
  convert(depth, flags=0) -> Surface
@@ -124,6 +206,14 @@ pygame.Surface.convert_alpha
  convert_alpha() -> Surface
 change the pixel format of an image including per pixel alphas
 
+pygame.Surface.premul_alpha
+ premul_alpha() -> Surface
+returns a copy of the surface with the RGB channels pre-multiplied by the alpha channel
+
+pygame.Surface.get_premul_alpha
+ get_premul_alpha() -> bool
+test if the Surface has premultiplied alpha
+
 pygame.Surface.copy
  copy() -> Surface
 create a new copy of a Surface
@@ -134,6 +224,7 @@ fill Surface with a solid color
 
 pygame.Surface.scroll
  scroll(dx=0, dy=0) -> None
+ scroll(dx=0, dy=0, exposed=True) -> [Rect, ...]
 Shift the surface image in place
 
 pygame.Surface.set_colorkey
@@ -186,6 +277,15 @@ pygame.Surface.get_at_mapped
  get_at_mapped((x, y)) -> Color
 get the mapped color value at a single pixel
 
+pygame.Surface.get_at_many
+ get_at_many(points) -> [int, ...]
+ get_at_many(points, mapped) -> mapped
+get the mapped color values of many pixels
+
+pygame.Surface.set_at_many
+ set_at_many(points, colors) -> None
+set the mapped color values of many pixels
+
 pygame.Surface.get_palette
  get_palette() -> [RGB, RGB, RGB, ...]
 get the color index palette for an 8bit Surface
@@ -219,10 +319,26 @@ pygame.Surface.get_clip
  get_clip() -> Rect
 get the current clipping area of the Surface
 
+pygame.Surface.track_damage
+ track_damage(enable=True) -> None
+keep track of the changed areas of the Surface
+
+pygame.Surface.get_damage
+ get_damage(clear=True) -> Rect_list
+get the changed areas of the Surface
+
+pygame.Surface.get_auto_conversions
+ get_auto_conversions() -> int
+count the display format copies made of the Surface
+
 pygame.Surface.subsurface
  subsurface(Rect) -> Surface
 create a new surface that references its parent
 
+pygame.Surface.region
+ region(Rect) -> SurfaceRegion
+create a light view of part of the Surface
+
 pygame.Surface.get_parent
  get_parent() -> Surface
 find the parent of a subsurface
@@ -271,6 +387,22 @@ pygame.Surface.get_pitch
  get_pitch() -> int
 get the number of bytes used per Surface row
 
+pygame.Surface.get_row_alignment
+ get_row_alignment() -> int
+get the byte alignment of the Surface rows
+
+pygame.Surface.compress
+ compress() -> size
+keep the Surface pixels compressed until they are used
+
+pygame.Surface.decompress
+ decompress() -> None
+keep the Surface pixels in memory again
+
+pygame.Surface.get_compressed
+ get_compressed() -> bool
+test if the Surface is compressed
+
 pygame.Surface.get_masks
  get_masks() -> (R, G, B, A)
 the bitmasks needed to convert between a color and a mapped integer
@@ -296,7 +428,7 @@ pygame.Surface.get_bounding_rect
 find the smallest rect containing data
 
 pygame.Surface.get_view
- get_view(<kind>='2') -> BufferProxy
+ get_view(<kind>='2', rect=None) -> BufferProxy
 return a buffer view of the Surface's pixels.
 
 pygame.Surface.get_buffer
@@ -307,4 +439,108 @@ pygame.Surface._pixels_address
  _pixels_address -> int
 pixel buffer address
 
+pygame.Surface.begin_frame
+ begin_frame() -> None
+mark the pixels of a shared Surface as being changed
+
+pygame.Surface.end_frame
+ end_frame() -> None
+mark a frame of a shared Surface as complete
+
+pygame.Surface.get_frame
+ get_frame() -> int
+get the frame counter of a shared Surface
+
+pygame.SurfaceRegion
+ SurfaceRegion(surface, rect) -> SurfaceRegion
+pygame object for a part of a Surface
+
+pygame.SurfaceRegion.get_parent
+ get_parent() -> Surface
+get the Surface the region is part of
+
+pygame.SurfaceRegion.get_offset
+ get_offset() -> (x, y)
+get the position of the region in its parent
+
+pygame.SurfaceRegion.get_size
+ get_size() -> (width, height)
+get the dimensions of the region
+
+pygame.SurfaceRegion.get_rect
+ get_rect(**kwargs) -> Rect
+get the rectangular area of the region
+
+pygame.SurfaceRegion.region
+ region(Rect) -> SurfaceRegion
+create a region of part of this region
+
+pygame.SurfaceRegion.subsurface
+ subsurface() -> Surface
+create a subsurface of the same area
+
+pygame.surface.get_blit_backend
+ get_blit_backend() -> String
+return the blitter version in use: 'GENERIC', 'SSE2', or 'AVX2'
+
+pygame.surface.set_blit_backend
+ set_blit_backend(type) -> None
+set the blitter version to one of: 'GENERIC', 'SSE2', or 'AVX2'
+
+pygame.surface.get_blit_threads
+ get_blit_threads() -> int
+return the number of threads used for large blits
+
+pygame.surface.set_blit_threads
+ set_blit_threads(threads) -> None
+set the number of threads used for large blits
+
+pygame.surface.set_auto_convert
+ set_auto_convert(enable=True) -> None
+blit to the display from display format copies
+
+pygame.surface.get_auto_convert
+ get_auto_convert() -> bool
+test if blits to the display use display format copies
+
+pygame.surface.get_auto_convert_stats
+ get_auto_convert_stats(reset=False) -> (conversions, hits)
+count the display format copies made and used
+
+pygame.surface.create_shared
+ create_shared(name, (width, height), flags=0, depth=32, masks=None) -> Surface
+create a Surface in named shared memory
+
+pygame.surface.open_shared
+ open_shared(name) -> Surface
+map a Surface another process created in shared memory
+
+pygame.surface.unlink_shared
+ unlink_shared(name) -> None
+remove the name of shared Surface memory
+
+pygame.surface.set_pool_limit
+ set_pool_limit(limit, largest=None) -> None
+set how much pixel memory is kept for new Surfaces
+
+pygame.surface.get_pool_limit
+ get_pool_limit() -> (limit, largest)
+get how much pixel memory is kept for new Surfaces
+
+pygame.surface.get_pool_stats
+ get_pool_stats(reset=False) -> (idle, idle_bytes, used, used_bytes, hits, misses, drops)
+count the pixel buffers kept for new Surfaces
+
+pygame.surface.set_decompressed_limit
+ set_decompressed_limit(limit) -> None
+set how many bytes of compressed Surfaces are kept decoded
+
+pygame.surface.get_decompressed_limit
+ get_decompressed_limit() -> limit
+get how many bytes of compressed Surfaces are kept decoded
+
+pygame.surface.get_compress_stats
+ get_compress_stats(reset=False) -> (compressed, compressed_bytes, decoded, decoded_bytes, decodes, encodes)
+count the compressed Surfaces
+
 */
\ No newline at end of file
@@ -0,0 +1,103 @@
+/* Auto generated file: with makeref.py .  Docs go in src/ *.doc . */
+#define DOC_PYGAMETILEMAP "pygame module for drawing maps of tiles"
+
+#define DOC_PYGAMETILEMAPTILEMAP "TileMap(size, tile_size, atlas, layers=1, chunk_size=(16, 16), cache=True) -> TileMap\nlayers of tile ids drawn from an atlas Surface"
+
+#define DOC_TILEMAPDRAW "draw(surface, viewport=None, dest=(0, 0), layer=None) -> Rect\ndraw the map in view"
+
+#define DOC_TILEMAPGETTILE "get_tile(layer, pos) -> id\nget the id of a tile"
+
+#define DOC_TILEMAPSETTILE "set_tile(layer, pos, id) -> None\nchange the id of a tile"
+
+#define DOC_TILEMAPGETLAYER "get_layer(layer) -> list\nget the ids of a layer"
+
+#define DOC_TILEMAPSETLAYER "set_layer(layer, ids) -> None\nchange the ids of a layer"
+
+#define DOC_TILEMAPFILL "fill(layer, id, rect=None) -> None\nset the tiles of an area to one id"
+
+#define DOC_TILEMAPMARKDIRTY "mark_dirty(rect=None) -> None\nrender chunks again on their next draw"
+
+#define DOC_TILEMAPGETATLAS "get_atlas() -> Surface\nget the atlas Surface"
+
+#define DOC_TILEMAPSETATLAS "set_atlas(surface) -> None\ndraw the tiles from another atlas"
+
+#define DOC_TILEMAPGETSIZE "get_size() -> (columns, rows)\nget the size of the map in tiles"
+
+#define DOC_TILEMAPGETTILESIZE "get_tile_size() -> (width, height)\nget the size of a tile in pixels"
+
+#define DOC_TILEMAPGETLAYERS "get_layers() -> int\nget the number of layers"
+
+#define DOC_TILEMAPGETRECT "get_rect() -> Rect\nget the area of the map in pixels"
+
+#define DOC_TILEMAPGETDRAWCOUNT "get_draw_count(reset=False) -> (renders, blits)\nget the number of chunks rendered and blits made"
+
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.tilemap
+pygame module for drawing maps of tiles
+
+pygame.tilemap.TileMap
+ TileMap(size, tile_size, atlas, layers=1, chunk_size=(16, 16), cache=True) -> TileMap
+layers of tile ids drawn from an atlas Surface
+
+pygame.tilemap.TileMap.draw
+ draw(surface, viewport=None, dest=(0, 0), layer=None) -> Rect
+draw the map in view
+
+pygame.tilemap.TileMap.get_tile
+ get_tile(layer, pos) -> id
+get the id of a tile
+
+pygame.tilemap.TileMap.set_tile
+ set_tile(layer, pos, id) -> None
+change the id of a tile
+
+pygame.tilemap.TileMap.get_layer
+ get_layer(layer) -> list
+get the ids of a layer
+
+pygame.tilemap.TileMap.set_layer
+ set_layer(layer, ids) -> None
+change the ids of a layer
+
+pygame.tilemap.TileMap.fill
+ fill(layer, id, rect=None) -> None
+set the tiles of an area to one id
+
+pygame.tilemap.TileMap.mark_dirty
+ mark_dirty(rect=None) -> None
+render chunks again on their next draw
+
+pygame.tilemap.TileMap.get_atlas
+ get_atlas() -> Surface
+get the atlas Surface
+
+pygame.tilemap.TileMap.set_atlas
+ set_atlas(surface) -> None
+draw the tiles from another atlas
+
+pygame.tilemap.TileMap.get_size
+ get_size() -> (columns, rows)
+get the size of the map in tiles
+
+pygame.tilemap.TileMap.get_tile_size
+ get_tile_size() -> (width, height)
+get the size of a tile in pixels
+
+pygame.tilemap.TileMap.get_layers
+ get_layers() -> int
+get the number of layers
+
+pygame.tilemap.TileMap.get_rect
+ get_rect() -> Rect
+get the area of the map in pixels
+
+pygame.tilemap.TileMap.get_draw_count
+ get_draw_count(reset=False) -> (renders, blits)
+get the number of chunks rendered and blits made
+
+*/
@@ -3,24 +3,48 @@
 
 #define DOC_PYGAMETIMEGETTICKS "get_ticks() -> milliseconds\nget the time in milliseconds"
 
+#define DOC_PYGAMETIMEGETTICKSNS "get_ticks_ns() -> nanoseconds\nget a precise time in nanoseconds"
+
 #define DOC_PYGAMETIMEWAIT "wait(milliseconds) -> time\npause the program for an amount of time"
 
 #define DOC_PYGAMETIMEDELAY "delay(milliseconds) -> time\npause the program for an amount of time"
 
 #define DOC_PYGAMETIMESETTIMER "set_timer(eventid, milliseconds) -> None\nrepeatedly create an event on the event queue"
 
+#define DOC_PYGAMETIMEADDTIMER "add_timer(event, millis, loops=0) -> id\nstart a timer posting an event"
+
+#define DOC_PYGAMETIMECANCELTIMER "cancel_timer(id) -> bool\nstop a timer from add_timer"
+
 #define DOC_PYGAMETIMECLOCK "Clock() -> Clock\ncreate an object to help track time"
 
 #define DOC_CLOCKTICK "tick(framerate=0) -> milliseconds\nupdate the clock"
 
 #define DOC_CLOCKTICKBUSYLOOP "tick_busy_loop(framerate=0) -> milliseconds\nupdate the clock"
 
+#define DOC_CLOCKTICKPRECISE "tick_precise(framerate=0) -> milliseconds\nupdate the clock, sleeping and spinning to the frame time"
+
 #define DOC_CLOCKGETTIME "get_time() -> milliseconds\ntime used in the previous tick"
 
 #define DOC_CLOCKGETRAWTIME "get_rawtime() -> milliseconds\nactual time used in the previous tick"
 
 #define DOC_CLOCKGETFPS "get_fps() -> float\ncompute the clock framerate"
 
+#define DOC_CLOCKGETFRAMESTATS "get_frame_stats() -> dict\nsummarize the recent frame times"
+
+#define DOC_PYGAMETIMEPROFILER "Profiler(size=4096) -> Profiler\nrecord timed spans of a program"
+
+#define DOC_PROFILERBEGIN "begin(name) -> None\nstart a span"
+
+#define DOC_PROFILEREND "end(name=None) -> None\nfinish the latest span"
+
+#define DOC_PROFILERCLEAR "clear() -> None\nforget the spans recorded"
+
+#define DOC_PROFILERGETEVENTS "get_events() -> list\nget the spans recorded as trace events"
+
+#define DOC_PROFILERTOJSON "to_json() -> str\nget the spans recorded as a Chrome trace"
+
+#define DOC_PROFILERGETDROPPED "get_dropped() -> int\ncount the spans written over"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -34,6 +58,10 @@ pygame.time.get_ticks
  get_ticks() -> milliseconds
 get the time in milliseconds
 
+pygame.time.get_ticks_ns
+ get_ticks_ns() -> nanoseconds
+get a precise time in nanoseconds
+
 pygame.time.wait
  wait(milliseconds) -> time
 pause the program for an amount of time
@@ -46,6 +74,14 @@ pygame.time.set_timer
  set_timer(eventid, milliseconds) -> None
 repeatedly create an event on the event queue
 
+pygame.time.add_timer
+ add_timer(event, millis, loops=0) -> id
+start a timer posting an event
+
+pygame.time.cancel_timer
+ cancel_timer(id) -> bool
+stop a timer from add_timer
+
 pygame.time.Clock
  Clock() -> Clock
 create an object to help track time
@@ -58,6 +94,10 @@ pygame.time.Clock.tick_busy_loop
  tick_busy_loop(framerate=0) -> milliseconds
 update the clock
 
+pygame.time.Clock.tick_precise
+ tick_precise(framerate=0) -> milliseconds
+update the clock, sleeping and spinning to the frame time
+
 pygame.time.Clock.get_time
  get_time() -> milliseconds
 time used in the previous tick
@@ -70,4 +110,36 @@ pygame.time.Clock.get_fps
  get_fps() -> float
 compute the clock framerate
 
+pygame.time.Clock.get_frame_stats
+ get_frame_stats() -> dict
+summarize the recent frame times
+
+pygame.time.Profiler
+ Profiler(size=4096) -> Profiler
+record timed spans of a program
+
+pygame.time.Profiler.begin
+ begin(name) -> None
+start a span
+
+pygame.time.Profiler.end
+ end(name=None) -> None
+finish the latest span
+
+pygame.time.Profiler.clear
+ clear() -> None
+forget the spans recorded
+
+pygame.time.Profiler.get_events
+ get_events() -> list
+get the spans recorded as trace events
+
+pygame.time.Profiler.to_json
+ to_json() -> str
+get the spans recorded as a Chrome trace
+
+pygame.time.Profiler.get_dropped
+ get_dropped() -> int
+count the spans written over
+
 */
\ No newline at end of file
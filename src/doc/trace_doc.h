@@ -0,0 +1,61 @@
+/* Auto generated file: with makeref.py .  Docs go in src/ *.doc . */
+#define DOC_PYGAMETRACE "pygame module for recording each call into pygame's C code"
+
+#define DOC_PYGAMETRACESTART "start(modules=None, size=4096) -> None\nstart recording calls"
+
+#define DOC_PYGAMETRACESTOP "stop() -> None\nstop recording calls"
+
+#define DOC_PYGAMETRACEGETTRACING "get_tracing() -> bool\nare calls being recorded"
+
+#define DOC_PYGAMETRACEGETRECORDS "get_records() -> list\nthe records kept, oldest first"
+
+#define DOC_PYGAMETRACECLEAR "clear() -> None\ndrop the records kept"
+
+#define DOC_PYGAMETRACESETFRAMEBUDGET "set_frame_budget(seconds, callback=None) -> None\nset the time a frame may take"
+
+#define DOC_PYGAMETRACEFRAME "frame() -> float\nmark the end of a frame"
+
+#define DOC_PYGAMETRACEGETOVERRUN "get_overrun() -> list or None\nthe records of the last frame over budget"
+
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.trace
+pygame module for recording each call into pygame's C code
+
+pygame.trace.start
+ start(modules=None, size=4096) -> None
+start recording calls
+
+pygame.trace.stop
+ stop() -> None
+stop recording calls
+
+pygame.trace.get_tracing
+ get_tracing() -> bool
+are calls being recorded
+
+pygame.trace.get_records
+ get_records() -> list
+the records kept, oldest first
+
+pygame.trace.clear
+ clear() -> None
+drop the records kept
+
+pygame.trace.set_frame_budget
+ set_frame_budget(seconds, callback=None) -> None
+set the time a frame may take
+
+pygame.trace.frame
+ frame() -> float
+mark the end of a frame
+
+pygame.trace.get_overrun
+ get_overrun() -> list or None
+the records of the last frame over budget
+
+*/
@@ -1,32 +1,66 @@
 /* Auto generated file: with makeref.py .  Docs go in src/ *.doc . */
 #define DOC_PYGAMETRANSFORM "pygame module to transform surfaces"
 
-#define DOC_PYGAMETRANSFORMFLIP "flip(Surface, xbool, ybool) -> Surface\nflip vertically and horizontally"
+#define DOC_PYGAMETRANSFORMFLIP "flip(Surface, xbool, ybool, DestSurface = None) -> Surface\nflip vertically and horizontally"
 
 #define DOC_PYGAMETRANSFORMSCALE "scale(Surface, (width, height), DestSurface = None) -> Surface\nresize to new resolution"
 
-#define DOC_PYGAMETRANSFORMROTATE "rotate(Surface, angle) -> Surface\nrotate an image"
+#define DOC_PYGAMETRANSFORMROTATE "rotate(Surface, angle, DestSurface = None) -> Surface\nrotate an image"
 
-#define DOC_PYGAMETRANSFORMROTOZOOM "rotozoom(Surface, angle, scale) -> Surface\nfiltered scale and rotation"
+#define DOC_PYGAMETRANSFORMGETROTATEDSIZE "get_rotated_size((width, height), angle, scale = None) -> (width, height)\nthe size of a rotated or rotozoomed image"
+
+#define DOC_PYGAMETRANSFORMROTOZOOM "rotozoom(Surface, angle, scale, DestSurface = None) -> Surface\nfiltered scale and rotation"
 
 #define DOC_PYGAMETRANSFORMSCALE2X "scale2x(Surface, DestSurface = None) -> Surface\nspecialized image doubler"
 
+#define DOC_PYGAMETRANSFORMSCALE3X "scale3x(Surface, DestSurface = None) -> Surface\nspecialized image tripler"
+
+#define DOC_PYGAMETRANSFORMSCALE4X "scale4x(Surface, DestSurface = None) -> Surface\nspecialized image quadrupler"
+
 #define DOC_PYGAMETRANSFORMSMOOTHSCALE "smoothscale(Surface, (width, height), DestSurface = None) -> Surface\nscale a surface to an arbitrary size smoothly"
 
-#define DOC_PYGAMETRANSFORMGETSMOOTHSCALEBACKEND "get_smoothscale_backend() -> String\nreturn smoothscale filter version in use: 'GENERIC', 'MMX', or 'SSE'"
+#define DOC_PYGAMETRANSFORMMIPCHAIN "MipChain(Surface, max_bytes = 0) -> MipChain\npygame object for smoothly scaling one surface to many sizes"
+
+#define DOC_MIPCHAINSCALE "scale((width, height), DestSurface = None) -> Surface\nsmoothly scale the surface through the nearest level"
+
+#define DOC_MIPCHAININVALIDATE "invalidate() -> None\ndrop the kept levels after the surface changed"
+
+#define DOC_MIPCHAINGETBYTES "get_bytes() -> int\nthe pixel bytes of the kept levels"
+
+#define DOC_MIPCHAINGETSURFACE "get_surface() -> Surface\nthe source surface"
+
+#define DOC_PYGAMETRANSFORMGETSMOOTHSCALEBACKEND "get_smoothscale_backend() -> String\nreturn smoothscale filter version in use: 'GENERIC', 'MMX', 'SSE', 'AVX2', or 'NEON'"
 
-#define DOC_PYGAMETRANSFORMSETSMOOTHSCALEBACKEND "set_smoothscale_backend(type) -> None\nset smoothscale filter version to one of: 'GENERIC', 'MMX', or 'SSE'"
+#define DOC_PYGAMETRANSFORMSETSMOOTHSCALEBACKEND "set_smoothscale_backend(type) -> None\nset smoothscale filter version to one of: 'GENERIC', 'MMX', 'SSE', 'AVX2', or 'NEON'"
 
-#define DOC_PYGAMETRANSFORMCHOP "chop(Surface, rect) -> Surface\ngets a copy of an image with an interior area removed"
+#define DOC_PYGAMETRANSFORMGETSMOOTHSCALETHREADS "get_smoothscale_threads() -> int\nreturn the number of threads smoothscale uses"
+
+#define DOC_PYGAMETRANSFORMSETSMOOTHSCALETHREADS "set_smoothscale_threads(count) -> None\nset the number of threads smoothscale uses"
+
+#define DOC_PYGAMETRANSFORMBOXBLUR "box_blur(Surface, radius, DestSurface = None) -> Surface\nblur a surface with a box filter"
+
+#define DOC_PYGAMETRANSFORMGAUSSIANBLUR "gaussian_blur(Surface, radius, DestSurface = None) -> Surface\nblur a surface with a gaussian filter"
+
+#define DOC_PYGAMETRANSFORMCHOP "chop(Surface, rect, DestSurface = None) -> Surface\ngets a copy of an image with an interior area removed"
 
 #define DOC_PYGAMETRANSFORMLAPLACIAN "laplacian(Surface, DestSurface = None) -> Surface\nfind edges in a surface"
 
+#define DOC_PYGAMETRANSFORMCONVOLVE "convolve(Surface, kernel, DestSurface = None) -> Surface\napply a 3x3 or 5x5 kernel to a surface"
+
 #define DOC_PYGAMETRANSFORMAVERAGESURFACES "average_surfaces(Surfaces, DestSurface = None, palette_colors = 1) -> Surface\nfind the average surface from many surfaces."
 
 #define DOC_PYGAMETRANSFORMAVERAGECOLOR "average_color(Surface, Rect = None) -> Color\nfinds the average color of a surface"
 
 #define DOC_PYGAMETRANSFORMTHRESHOLD "threshold(DestSurface, Surface, color, threshold = (0,0,0,0), diff_color = (0,0,0,0), change_return = 1, Surface = None, inverse = False) -> num_threshold_pixels\nfinds which, and how many pixels in a surface are within a threshold of a color."
 
+#define DOC_PYGAMETRANSFORMRGBTOHSV "rgb_to_hsv(Surface, DestSurface = None) -> Surface\nconvert the pixels of a surface from RGB to HSV"
+
+#define DOC_PYGAMETRANSFORMHSVTORGB "hsv_to_rgb(Surface, DestSurface = None) -> Surface\nconvert the pixels of a surface from HSV to RGB"
+
+#define DOC_PYGAMETRANSFORMCORRECTGAMMA "correct_gamma(Surface, gamma, DestSurface = None) -> Surface\ngamma correct the pixels of a surface"
+
+#define DOC_PYGAMETRANSFORMREMAPCOLORS "remap_colors(Surface, lut, DestSurface = None) -> Surface\nreplace colors by a table in one pass"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -37,7 +71,7 @@ pygame.transform
 pygame module to transform surfaces
 
 pygame.transform.flip
- flip(Surface, xbool, ybool) -> Surface
+ flip(Surface, xbool, ybool, DestSurface = None) -> Surface
 flip vertically and horizontally
 
 pygame.transform.scale
@@ -45,37 +79,89 @@ pygame.transform.scale
 resize to new resolution
 
 pygame.transform.rotate
- rotate(Surface, angle) -> Surface
+ rotate(Surface, angle, DestSurface = None) -> Surface
 rotate an image
 
+pygame.transform.get_rotated_size
+ get_rotated_size((width, height), angle, scale = None) -> (width, height)
+the size of a rotated or rotozoomed image
+
 pygame.transform.rotozoom
- rotozoom(Surface, angle, scale) -> Surface
+ rotozoom(Surface, angle, scale, DestSurface = None) -> Surface
 filtered scale and rotation
 
 pygame.transform.scale2x
  scale2x(Surface, DestSurface = None) -> Surface
 specialized image doubler
 
+pygame.transform.scale3x
+ scale3x(Surface, DestSurface = None) -> Surface
+specialized image tripler
+
+pygame.transform.scale4x
+ scale4x(Surface, DestSurface = None) -> Surface
+specialized image quadrupler
+
 pygame.transform.smoothscale
  smoothscale(Surface, (width, height), DestSurface = None) -> Surface
 scale a surface to an arbitrary size smoothly
 
+pygame.transform.MipChain
+ MipChain(Surface, max_bytes = 0) -> MipChain
+pygame object for smoothly scaling one surface to many sizes
+
+pygame.transform.MipChain.scale
+ scale((width, height), DestSurface = None) -> Surface
+smoothly scale the surface through the nearest level
+
+pygame.transform.MipChain.invalidate
+ invalidate() -> None
+drop the kept levels after the surface changed
+
+pygame.transform.MipChain.get_bytes
+ get_bytes() -> int
+the pixel bytes of the kept levels
+
+pygame.transform.MipChain.get_surface
+ get_surface() -> Surface
+the source surface
+
 pygame.transform.get_smoothscale_backend
  get_smoothscale_backend() -> String
-return smoothscale filter version in use: 'GENERIC', 'MMX', or 'SSE'
+return smoothscale filter version in use: 'GENERIC', 'MMX', 'SSE', 'AVX2', or 'NEON'
 
 pygame.transform.set_smoothscale_backend
  set_smoothscale_backend(type) -> None
-set smoothscale filter version to one of: 'GENERIC', 'MMX', or 'SSE'
+set smoothscale filter version to one of: 'GENERIC', 'MMX', 'SSE', 'AVX2', or 'NEON'
+
+pygame.transform.get_smoothscale_threads
+ get_smoothscale_threads() -> int
+return the number of threads smoothscale uses
+
+pygame.transform.set_smoothscale_threads
+ set_smoothscale_threads(count) -> None
+set the number of threads smoothscale uses
+
+pygame.transform.box_blur
+ box_blur(Surface, radius, DestSurface = None) -> Surface
+blur a surface with a box filter
+
+pygame.transform.gaussian_blur
+ gaussian_blur(Surface, radius, DestSurface = None) -> Surface
+blur a surface with a gaussian filter
 
 pygame.transform.chop
- chop(Surface, rect) -> Surface
+ chop(Surface, rect, DestSurface = None) -> Surface
 gets a copy of an image with an interior area removed
 
 pygame.transform.laplacian
  laplacian(Surface, DestSurface = None) -> Surface
 find edges in a surface
 
+pygame.transform.convolve
+ convolve(Surface, kernel, DestSurface = None) -> Surface
+apply a 3x3 or 5x5 kernel to a surface
+
 pygame.transform.average_surfaces
  average_surfaces(Surfaces, DestSurface = None, palette_colors = 1) -> Surface
 find the average surface from many surfaces.
@@ -87,5 +173,19 @@ finds the average color of a surface
 pygame.transform.threshold
  threshold(DestSurface, Surface, color, threshold = (0,0,0,0), diff_color = (0,0,0,0), change_return = 1, Surface = None, inverse = False) -> num_threshold_pixels
 finds which, and how many pixels in a surface are within a threshold of a color.
+pygame.transform.rgb_to_hsv
+ rgb_to_hsv(Surface, DestSurface = None) -> Surface
+convert the pixels of a surface from RGB to HSV
+
+pygame.transform.hsv_to_rgb
+ hsv_to_rgb(Surface, DestSurface = None) -> Surface
+convert the pixels of a surface from HSV to RGB
+
+pygame.transform.correct_gamma
+ correct_gamma(Surface, gamma, DestSurface = None) -> Surface
+gamma correct the pixels of a surface
+pygame.transform.remap_colors
+ remap_colors(Surface, lut, DestSurface = None) -> Surface
+replace colors by a table in one pass
 
 */
\ No newline at end of file
@@ -25,9 +25,25 @@
  */
 #include "pygame.h"
 #include "pgcompat.h"
+#include "surface.h"
 #include "doc/draw_doc.h"
 #include <math.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DRAW_SSE2
+#include <emmintrin.h>
+#endif
+
+/* draw.batch() draws in tiles this many pixels square, on up to
+ * PG_DRAW_MAX_THREADS threads of the pygame worker pool, if it has at least
+ * PG_DRAW_MIN_COMMANDS commands and the clip rect has PG_DRAW_MIN_PIXELS
+ * pixels */
+#define PG_DRAW_TILE 64
+#define PG_DRAW_MAX_THREADS 32
+#define PG_DRAW_MIN_COMMANDS 16
+#define PG_DRAW_MIN_PIXELS (128 * 128)
+
 /* Many C libraries seem to lack the trunc call (added in C99) */
 #define trunc(d)   (((d) >= 0.0) ? (floor(d)) : (ceil(d)))
 #define FRAC(z)    ((z) - trunc(z))
@@ -48,6 +64,136 @@ static void draw_ellipse(SDL_Surface *dst, int x, int y, int rx, int ry, Uint32
 static void draw_fillellipse(SDL_Surface *dst, int x, int y, int rx, int ry, Uint32 color);
 static void draw_fillpoly(SDL_Surface *dst, int *vx, int *vy, int n, Uint32 color);
 
+/* A segment of a wide antialiased line, from (ax, ay) along (dx, dy), with
+ * (ux, uy) the unit direction. A round segment is a capsule, the points
+ * within the half width of the segment; a flat one ends square at its
+ * end points. A round segment of length 0 is a disc. */
+typedef struct {
+    float ax, ay;
+    float dx, dy;
+    float ux, uy;
+    float len;
+    float inv_len2;
+    int round;
+} AASegment;
+
+static PyObject* draw_result(PyObject* surfobj, int x, int y, int w, int h);
+static void aawide_segment(AASegment *seg, float x1, float y1, float x2, float y2, int round);
+static int draw_aawide(SDL_Surface *surf, Uint8 *rgba, AASegment *segs, int nsegs, float r,
+                       Uint8 *cov);
+
+/* The drawing a batch records to do in tiles, as given to the low level
+ * routines after clipping to the surface clip rect */
+enum {
+    DRAWOP_LINE,
+    DRAWOP_HORZLINE,
+    DRAWOP_VERTLINE,
+    DRAWOP_AALINE,
+    DRAWOP_ELLIPSE,
+    DRAWOP_FILLELLIPSE,
+    DRAWOP_FILLPOLY,
+    DRAWOP_AAWIDE
+};
+
+typedef struct {
+    int type;
+    int left, top, right, bottom;   /* the pixels it may touch */
+    Uint32 color;
+    int x1, y1, x2, y2;             /* line ends, or ellipse centre and radii */
+    float f[4];                     /* aaline ends */
+    int blend;
+    int n;
+    int *pts;                       /* polygon x, then y, n of each */
+    AASegment *segs;                /* n wide line segments of radius r */
+    float r;
+    Uint8 rgba[4];
+} DrawOp;
+
+/* While draw.batch() runs, the surface it draws on, kept locked for all
+ * the commands, and the union of the rects they drew. With workers to
+ * draw in tiles, the drawing on surf is recorded in ops instead. */
+typedef struct {
+    PyObject *surfobj;
+    int any;
+    int left, top, right, bottom;
+    SDL_Surface *surf;
+    int record;
+    int failed;                     /* set if recording ran out of memory */
+    DrawOp *ops;
+    int nops, maxops;
+} DrawBatch;
+
+static DrawBatch *draw_batch = NULL;
+
+static int draw_pool_take(SDL_Surface *surf, int ncommands);
+static int draw_run_tiles(DrawBatch *state);
+static void draw_free_ops(DrawBatch *state);
+
+static int draw_recording(SDL_Surface* surf)
+{
+    return draw_batch && draw_batch->record && draw_batch->surf == surf;
+}
+
+/* Adds an op to the batch being recorded. Returns NULL with an exception
+ * set if out of memory. */
+static DrawOp* draw_record(int type, int left, int top, int right, int bottom)
+{
+    DrawOp *op;
+
+    if(draw_batch->nops == draw_batch->maxops)
+    {
+        int maxops = draw_batch->maxops ? draw_batch->maxops * 2 : 256;
+
+        op = draw_batch->ops;
+        PyMem_Resize(op, DrawOp, maxops);
+        if(!op)
+        {
+            draw_batch->failed = 1;
+            PyErr_NoMemory();
+            return NULL;
+        }
+        draw_batch->ops = op;
+        draw_batch->maxops = maxops;
+    }
+    op = draw_batch->ops + draw_batch->nops++;
+    memset(op, 0, sizeof(DrawOp));
+    op->type = type;
+    op->left = left;
+    op->top = top;
+    op->right = right;
+    op->bottom = bottom;
+    return op;
+}
+
+/* Memory of size bytes for the last op, freed with the batch. On failure
+ * the op is dropped, and NULL returned with an exception set. */
+static void* draw_record_data(DrawOp *op, size_t size)
+{
+    void *data = PyMem_Malloc(size ? size : 1);
+
+    if(!data)
+    {
+        draw_batch->nops--;
+        draw_batch->failed = 1;
+        PyErr_NoMemory();
+    }
+    return data;
+}
+
+static int draw_lock(PyObject* surfobj)
+{
+    if(draw_batch && draw_batch->surfobj == surfobj)
+        return 1;
+    return PySurface_Lock(surfobj);
+}
+
+static int draw_unlock(PyObject* surfobj)
+{
+    if(draw_batch && draw_batch->surfobj == surfobj)
+        return 1;
+    return PySurface_Unlock(surfobj);
+}
+
 
 
 static PyObject* aaline(PyObject* self, PyObject* arg)
@@ -80,17 +226,17 @@ static PyObject* aaline(PyObject* self, PyObject* arg)
     if(!TwoFloatsFromObj(end, &endx, &endy))
         return RAISE(PyExc_TypeError, "Invalid end position argument");
 
-    if(!PySurface_Lock(surfobj)) return NULL;
+    if(!draw_lock(surfobj)) return NULL;
 
     pts[0] = startx; pts[1] = starty;
     pts[2] = endx; pts[3] = endy;
     anydraw = clip_and_draw_aaline(surf, &surf->clip_rect, color, pts, blend);
 
-    if(!PySurface_Unlock(surfobj)) return NULL;
+    if(!draw_unlock(surfobj)) return NULL;
 
     /*compute return rect*/
     if(!anydraw)
-        return PyRect_New4(startx, starty, 0, 0);
+        return draw_result(surfobj, startx, starty, 0, 0);
     if(pts[0] < pts[2])
     {
         left = (int)(pts[0]);
@@ -111,7 +257,7 @@ static PyObject* aaline(PyObject* self, PyObject* arg)
         top = (int)(pts[3]);
         bottom = (int)(pts[1]);
     }
-    return PyRect_New4(left, top, right-left+2, bottom-top+2);
+    return draw_result(surfobj, left, top, right-left+2, bottom-top+2);
 }
 
 
@@ -149,21 +295,21 @@ static PyObject* line(PyObject* self, PyObject* arg)
         return RAISE(PyExc_TypeError, "Invalid end position argument");
 
     if(width < 1)
-        return PyRect_New4(startx, starty, 0, 0);
+        return draw_result(surfobj, startx, starty, 0, 0);
 
 
-    if(!PySurface_Lock(surfobj)) return NULL;
+    if(!draw_lock(surfobj)) return NULL;
 
     pts[0] = startx; pts[1] = starty;
     pts[2] = endx; pts[3] = endy;
     anydraw = clip_and_draw_line_width(surf, &surf->clip_rect, color, width, pts);
 
-    if(!PySurface_Unlock(surfobj)) return NULL;
+    if(!draw_unlock(surfobj)) return NULL;
 
 
     /*compute return rect*/
     if(!anydraw)
-        return PyRect_New4(startx, starty, 0, 0);
+        return draw_result(surfobj, startx, starty, 0, 0);
     rleft = (startx < endx) ? startx : endx;
     rtop = (starty < endy) ? starty : endy;
     dx = abs(startx - endx);
@@ -178,7 +324,7 @@ static PyObject* line(PyObject* self, PyObject* arg)
         rwidth = dx + width;
         rheight = dy + 1;
     }
-    return PyRect_New4(rleft, rtop, rwidth, rheight);
+    return draw_result(surfobj, rleft, rtop, rwidth, rheight);
 }
 
 
@@ -227,7 +373,7 @@ static PyObject* aalines(PyObject* self, PyObject* arg)
     left = right = (int)x;
     top = bottom = (int)y;
 
-    if(!PySurface_Lock(surfobj)) return NULL;
+    if(!draw_lock(surfobj)) return NULL;
 
     drawn = 1;
     for(loop = 1; loop < length; ++loop)
@@ -264,10 +410,159 @@ static PyObject* aalines(PyObject* self, PyObject* arg)
         }
     }
 
-    if(!PySurface_Unlock(surfobj)) return NULL;
+    if(!draw_unlock(surfobj)) return NULL;
 
     /*compute return rect*/
-    return PyRect_New4(left, top, right-left+2, bottom-top+2);
+    return draw_result(surfobj, left, top, right-left+2, bottom-top+2);
+}
+
+/* Draws the points as a wide antialiased line. Round lines are drawn as
+ * capsules, so their joins and ends are round; flat ones end square, with
+ * a disc at each join. */
+static PyObject* draw_aawide_points(PyObject* surfobj, PyObject* colorobj, float* pts,
+                                    int npts, int closed, float width, int round)
+{
+    SDL_Surface* surf = PySurface_AsSurface(surfobj);
+    AASegment local[3];
+    AASegment *segs;
+    Uint8 rgba[4];
+    float minx, miny, maxx, maxy;
+    int loop, next, nsegs, extra, result;
+
+    if(!RGBAFromColorObj(colorobj, rgba))
+        return RAISE(PyExc_TypeError, "invalid color argument");
+    if(width <= 0)
+        return draw_result(surfobj, (int)pts[0], (int)pts[1], 0, 0);
+    if(npts < 3)
+        closed = 0;
+
+    nsegs = closed ? npts : npts - 1;
+    if(nsegs < 1)
+        nsegs = 1;
+    if(round)
+        extra = 0;
+    else
+        extra = closed ? npts : npts - 2;
+    if(nsegs + extra <= 3)
+        segs = local;
+    else
+    {
+        segs = PyMem_New(AASegment, nsegs + extra);
+        if(!segs)
+            return PyErr_NoMemory();
+    }
+    for(loop = 0; loop < nsegs; ++loop)
+    {
+        next = (loop + 1) % npts;
+        aawide_segment(segs + loop, pts[loop*2], pts[loop*2+1], pts[next*2], pts[next*2+1],
+                       round);
+    }
+    for(loop = 0; loop < extra; ++loop)
+    {
+        next = closed ? loop : loop + 1;
+        aawide_segment(segs + nsegs + loop, pts[next*2], pts[next*2+1], pts[next*2],
+                       pts[next*2+1], 1);
+    }
+
+    if(!draw_lock(surfobj))
+    {
+        if(segs != local)
+            PyMem_Free(segs);
+        return NULL;
+    }
+    result = draw_aawide(surf, rgba, segs, nsegs + extra, width / 2, NULL);
+    if(segs != local)
+        PyMem_Free(segs);
+    if(!draw_unlock(surfobj)) return NULL;
+    if(result < 0) return NULL;
+
+    /*compute return rect*/
+    if(!result)
+        return draw_result(surfobj, (int)pts[0], (int)pts[1], 0, 0);
+    minx = maxx = pts[0];
+    miny = maxy = pts[1];
+    for(loop = 1; loop < npts; ++loop)
+    {
+        minx = MIN(minx, pts[loop*2]);
+        maxx = MAX(maxx, pts[loop*2]);
+        miny = MIN(miny, pts[loop*2+1]);
+        maxy = MAX(maxy, pts[loop*2+1]);
+    }
+    minx = (float)floor(minx - width / 2 - 1);
+    miny = (float)floor(miny - width / 2 - 1);
+    maxx = (float)ceil(maxx + width / 2 + 1);
+    maxy = (float)ceil(maxy + width / 2 + 1);
+    return draw_result(surfobj, (int)minx, (int)miny, (int)(maxx - minx), (int)(maxy - miny));
+}
+
+static PyObject* draw_aawide_pair(PyObject* arg, int round)
+{
+    PyObject *surfobj, *colorobj, *start, *end;
+    float pts[4];
+    float width;
+
+    /*get all the arguments*/
+    if(!PyArg_ParseTuple(arg, "O!OOOf", &PySurface_Type, &surfobj, &colorobj, &start, &end,
+                         &width))
+        return NULL;
+
+    if(!TwoFloatsFromObj(start, &pts[0], &pts[1]))
+        return RAISE(PyExc_TypeError, "Invalid start position argument");
+    if(!TwoFloatsFromObj(end, &pts[2], &pts[3]))
+        return RAISE(PyExc_TypeError, "Invalid end position argument");
+
+    return draw_aawide_points(surfobj, colorobj, pts, 2, 0, width, round);
+}
+
+static PyObject* aawideline(PyObject* self, PyObject* arg)
+{
+    return draw_aawide_pair(arg, 0);
+}
+
+static PyObject* aacapsule(PyObject* self, PyObject* arg)
+{
+    return draw_aawide_pair(arg, 1);
+}
+
+static PyObject* aawidelines(PyObject* self, PyObject* arg)
+{
+    PyObject *surfobj, *colorobj, *closedobj, *points, *item, *ret;
+    float *pts;
+    float width;
+    int closed, round = 0;
+    int result, loop, length;
+
+    /*get all the arguments*/
+    if(!PyArg_ParseTuple(arg, "O!OOOf|i", &PySurface_Type, &surfobj, &colorobj, &closedobj,
+                         &points, &width, &round))
+        return NULL;
+
+    closed = PyObject_IsTrue(closedobj);
+
+    if(!PySequence_Check(points))
+        return RAISE(PyExc_TypeError, "points argument must be a sequence of number pairs");
+    length = PySequence_Length(points);
+    if(length < 2)
+        return RAISE(PyExc_ValueError, "points argument must contain more than 1 points");
+
+    pts = PyMem_New(float, length * 2);
+    if(!pts)
+        return PyErr_NoMemory();
+    for(loop = 0; loop < length; ++loop)
+    {
+        item = PySequence_GetItem(points, loop);
+        result = item != NULL && TwoFloatsFromObj(item, &pts[loop*2], &pts[loop*2+1]);
+        Py_XDECREF(item);
+        if(!result)
+        {
+            PyMem_Free(pts);
+            return RAISE(PyExc_TypeError, "points must be number pairs");
+        }
+    }
+
+    ret = draw_aawide_points(surfobj, colorobj, pts, length, closed, width, round);
+    PyMem_Free(pts);
+    return ret;
 }
 
 
@@ -316,9 +611,9 @@ static PyObject* lines(PyObject* self, PyObject* arg)
     starty = pts[1] = top = bottom = y;
 
     if(width < 1)
-        return PyRect_New4(left, top, 0, 0);
+        return draw_result(surfobj, left, top, 0, 0);
 
-    if(!PySurface_Lock(surfobj)) return NULL;
+    if(!draw_lock(surfobj)) return NULL;
 
     drawn = 1;
     for(loop = 1; loop < length; ++loop)
@@ -356,10 +651,10 @@ static PyObject* lines(PyObject* self, PyObject* arg)
     }
 
 
-    if(!PySurface_Unlock(surfobj)) return NULL;
+    if(!draw_unlock(surfobj)) return NULL;
 
     /*compute return rect*/
-    return PyRect_New4(left, top, right-left+1, bottom-top+1);
+    return draw_result(surfobj, left, top, right-left+1, bottom-top+1);
 }
 
 
@@ -399,7 +694,7 @@ static PyObject* arc(PyObject* self, PyObject* arg)
     if ( angle_stop < angle_start )
         angle_stop += 360;
 
-    if(!PySurface_Lock(surfobj)) return NULL;
+    if(!draw_lock(surfobj)) return NULL;
 
     width = MIN(width, MIN(rect->w, rect->h) / 2);
     for(loop=0; loop<width; ++loop)
@@ -409,13 +704,13 @@ static PyObject* arc(PyObject* self, PyObject* arg)
                  angle_start, angle_stop, color);
     }
 
-    if(!PySurface_Unlock(surfobj)) return NULL;
+    if(!draw_unlock(surfobj)) return NULL;
 
     l = MAX(rect->x, surf->clip_rect.x);
     t = MAX(rect->y, surf->clip_rect.y);
     r = MIN(rect->x + rect->w, surf->clip_rect.x + surf->clip_rect.w);
     b = MIN(rect->y + rect->h, surf->clip_rect.y + surf->clip_rect.h);
-    return PyRect_New4(l, t, MAX(r-l, 0), MAX(b-t, 0));
+    return draw_result(surfobj, l, t, MAX(r-l, 0), MAX(b-t, 0));
 }
 
 
@@ -451,7 +746,7 @@ static PyObject* ellipse(PyObject* self, PyObject* arg)
     if ( width > rect->w / 2 || width > rect->h / 2 )
         return RAISE(PyExc_ValueError, "width greater than ellipse radius");
 
-    if(!PySurface_Lock(surfobj)) return NULL;
+    if(!draw_lock(surfobj)) return NULL;
 
     if(!width)
         draw_fillellipse(surf, (Sint16)(rect->x+rect->w/2), (Sint16)(rect->y+rect->h/2),
@@ -466,13 +761,13 @@ static PyObject* ellipse(PyObject* self, PyObject* arg)
         }
     }
 
-    if(!PySurface_Unlock(surfobj)) return NULL;
+    if(!draw_unlock(surfobj)) return NULL;
 
     l = MAX(rect->x, surf->clip_rect.x);
     t = MAX(rect->y, surf->clip_rect.y);
     r = MIN(rect->x + rect->w, surf->clip_rect.x + surf->clip_rect.w);
     b = MIN(rect->y + rect->h, surf->clip_rect.y + surf->clip_rect.h);
-    return PyRect_New4(l, t, MAX(r-l, 0), MAX(b-t, 0));
+    return draw_result(surfobj, l, t, MAX(r-l, 0), MAX(b-t, 0));
 }
 
 
@@ -508,7 +803,7 @@ static PyObject* circle(PyObject* self, PyObject* arg)
         return RAISE(PyExc_ValueError, "width greater than radius");
 
 
-    if(!PySurface_Lock(surfobj)) return NULL;
+    if(!draw_lock(surfobj)) return NULL;
 
     if(!width)
         draw_fillellipse(surf, (Sint16)posx, (Sint16)posy, (Sint16)radius, (Sint16)radius, color);
@@ -516,13 +811,13 @@ static PyObject* circle(PyObject* self, PyObject* arg)
         for(loop=0; loop<width; ++loop)
             draw_ellipse(surf, posx, posy, radius-loop, radius-loop, color);
 
-    if(!PySurface_Unlock(surfobj)) return NULL;
+    if(!draw_unlock(surfobj)) return NULL;
 
     l = MAX(posx - radius, surf->clip_rect.x);
     t = MAX(posy - radius, surf->clip_rect.y);
     r = MIN(posx + radius, surf->clip_rect.x + surf->clip_rect.w);
     b = MIN(posy + radius, surf->clip_rect.y + surf->clip_rect.h);
-    return PyRect_New4(l, t, MAX(r-l, 0), MAX(b-t, 0));
+    return draw_result(surfobj, l, t, MAX(r-l, 0), MAX(b-t, 0));
 }
 
 
@@ -597,7 +892,7 @@ static PyObject* polygon(PyObject* self, PyObject* arg)
         bottom = MAX(y, bottom);
     }
 
-    if(!PySurface_Lock(surfobj))
+    if(!draw_lock(surfobj))
     {
         PyMem_Del(xlist); PyMem_Del(ylist);
         return NULL;
@@ -606,14 +901,14 @@ static PyObject* polygon(PyObject* self, PyObject* arg)
     draw_fillpoly(surf, xlist, ylist, numpoints, color);
 
     PyMem_Del(xlist); PyMem_Del(ylist);
-    if(!PySurface_Unlock(surfobj))
+    if(!draw_unlock(surfobj))
         return NULL;
 
     left = MAX(left, surf->clip_rect.x);
     top = MAX(top, surf->clip_rect.y);
     right = MIN(right, surf->clip_rect.x + surf->clip_rect.w);
     bottom = MIN(bottom, surf->clip_rect.y + surf->clip_rect.h);
-    return PyRect_New4(left, top, right-left+1, bottom-top+1);
+    return draw_result(surfobj, left, top, right-left+1, bottom-top+1);
 }
 
 
@@ -645,9 +940,199 @@ static PyObject* rect(PyObject* self, PyObject* arg)
 
 
 
+/*the draw functions draw.batch() can run, by name*/
+static struct {
+    const char *name;
+    PyCFunction func;
+} batch_commands[] =
+{
+    { "aaline", aaline },
+    { "line", line },
+    { "aalines", aalines },
+    { "lines", lines },
+    { "aawideline", aawideline },
+    { "aawidelines", aawidelines },
+    { "aacapsule", aacapsule },
+    { "ellipse", ellipse },
+    { "arc", arc },
+    { "circle", circle },
+    { "polygon", polygon },
+    { "rect", rect },
+    { NULL, NULL }
+};
+
+static PyObject* batch(PyObject* self, PyObject* arg)
+{
+    PyObject *surfobj, *commands, *command, *args, *ret;
+    PyObject *seq = NULL, *items = NULL;
+    DrawBatch state, *outer;
+    const char *name;
+    int length, loop, size, i, found, error = 1;
+
+    /*get all the arguments*/
+    if(!PyArg_ParseTuple(arg, "O!O", &PySurface_Type, &surfobj, &commands))
+        return NULL;
+
+    seq = PySequence_Fast(commands, "commands argument must be a sequence");
+    if(!seq)
+        return NULL;
+    length = PySequence_Fast_GET_SIZE(seq);
+
+    if(!PySurface_Lock(surfobj))
+    {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    outer = draw_batch;
+    memset(&state, 0, sizeof(state));
+    state.surfobj = surfobj;
+    state.surf = PySurface_AsSurface(surfobj);
+    /* the ops of a batch inside a recording one are drawn in place */
+    state.record = !(outer && outer->record) &&
+        draw_pool_take(state.surf, length);
+    draw_batch = &state;
+
+    for(loop = 0; loop < length; ++loop)
+    {
+        command = PySequence_Fast_GET_ITEM(seq, loop);
+        items = PySequence_Fast(command, "each command must be a sequence");
+        if(!items)
+            goto done;
+        size = PySequence_Fast_GET_SIZE(items);
+        if(size < 1 || !PyArg_Parse(PySequence_Fast_GET_ITEM(items, 0), "s", &name))
+        {
+            PyErr_Clear();
+            RAISE(PyExc_TypeError, "each command must start with a draw function name");
+            goto done;
+        }
+        found = -1;
+        for(i = 0; batch_commands[i].name; ++i)
+        {
+            if(!strcmp(batch_commands[i].name, name))
+            {
+                found = i;
+                break;
+            }
+        }
+        if(found < 0)
+        {
+            PyErr_Format(PyExc_ValueError, "unknown draw command '%s'", name);
+            goto done;
+        }
+
+        /*the command's arguments, after the surface*/
+        args = PyTuple_New(size);
+        if(!args)
+            goto done;
+        Py_INCREF(surfobj);
+        PyTuple_SET_ITEM(args, 0, surfobj);
+        for(i = 1; i < size; ++i)
+        {
+            PyObject *item = PySequence_Fast_GET_ITEM(items, i);
+            Py_INCREF(item);
+            PyTuple_SET_ITEM(args, i, item);
+        }
+        ret = batch_commands[found].func(NULL, args);
+        Py_DECREF(args);
+        if(!ret)
+            goto done;
+        Py_DECREF(ret);
+        Py_DECREF(items);
+        items = NULL;
+        if(state.failed)
+            goto done;
+    }
+    error = 0;
+
+done:
+    Py_XDECREF(items);
+    Py_DECREF(seq);
+    draw_batch = outer;
+    if(state.record)
+    {
+        /*draw what was recorded, even if a later command failed*/
+        if(!state.failed && state.nops)
+        {
+            PyObject *type, *value, *traceback;
+
+            PyErr_Fetch(&type, &value, &traceback);
+            if(draw_run_tiles(&state) < 0)
+            {
+                error = 1;
+                if(type)
+                    PyErr_Clear();
+            }
+            if(type)
+                PyErr_Restore(type, value, traceback);
+        }
+        draw_free_ops(&state);
+    }
+    if(!PySurface_Unlock(surfobj))
+        error = 1;
+    if(error)
+    {
+        /*what was drawn before the error is still damage*/
+        if(state.any)
+        {
+            PyObject *type, *value, *traceback;
+
+            PyErr_Fetch(&type, &value, &traceback);
+            Py_XDECREF(draw_result(surfobj, state.left, state.top,
+                                   state.right - state.left, state.bottom - state.top));
+            PyErr_Restore(type, value, traceback);
+        }
+        return NULL;
+    }
+    if(!state.any)
+        return PyRect_New4(0, 0, 0, 0);
+    return draw_result(surfobj, state.left, state.top,
+                       state.right - state.left, state.bottom - state.top);
+}
+
 
 /*internal drawing tools*/
 
+/*the rect returned by a draw function, added to the surface damage*/
+static PyObject* draw_result(PyObject* surfobj, int x, int y, int w, int h)
+{
+    SDL_Surface* surf;
+    int left, top, right, bottom;
+    SDL_Rect r;
+
+    /*in a batch, the rects are joined and returned once at the end*/
+    if(draw_batch && draw_batch->surfobj == surfobj)
+    {
+        if(w > 0 && h > 0)
+        {
+            if(!draw_batch->any)
+            {
+                draw_batch->left = x; draw_batch->top = y;
+                draw_batch->right = x + w; draw_batch->bottom = y + h;
+                draw_batch->any = 1;
+            }
+            else
+            {
+                draw_batch->left = MIN(draw_batch->left, x);
+                draw_batch->top = MIN(draw_batch->top, y);
+                draw_batch->right = MAX(draw_batch->right, x + w);
+                draw_batch->bottom = MAX(draw_batch->bottom, y + h);
+            }
+        }
+        Py_RETURN_NONE;
+    }
+
+    surf = PySurface_AsSurface(surfobj);
+    left = MAX(x, 0); top = MAX(y, 0);
+    right = MIN(x + w, surf->w); bottom = MIN(y + h, surf->h);
+    if(right > left && bottom > top)
+    {
+        r.x = left; r.y = top;
+        r.w = right - left; r.h = bottom - top;
+        PySurface_AddDamage(surfobj, &r);
+    }
+    return PyRect_New4(x, y, w, h);
+}
+
 static int clip_and_draw_aaline(SDL_Surface* surf, SDL_Rect* rect, Uint32 color, float* pts, int blend)
 {
     if(!clipaaline(pts, rect->x+1, rect->y+1, rect->x+rect->w-2, rect->y+rect->h-2))
@@ -939,6 +1424,15 @@ static int set_at(SDL_Surface* surf, int x, int y, Uint32 color)
         if(hasalpha) pixel[3] = br*255; \
     }
 
+/* Only the pixels in the clip rect are drawn. The line is clipped first,
+ * with a margin, so this only matters when drawing in tiles. */
+#define AAPIX(px, py, br) \
+    if((px) >= clip->x && (px) < clip->x + clip->w && \
+       (py) >= clip->y && (py) < clip->y + clip->h) { \
+        pixel = pm + pixx * (px) + pixy * (py); \
+        DRAWPIX32(pixel, colorptr, br, blend) \
+    }
+
 /* Adapted from http://freespace.virgin.net/hugo.elias/graphics/x_wuline.htm */
 static void drawaaline(SDL_Surface* surf, Uint32 color, float x1, float y1, float x2, float y2, int blend) {
     float grad, xd, yd;
@@ -951,6 +1445,21 @@ static void drawaaline(SDL_Surface* surf, Uint32 color, float x1, float y1, floa
     Uint8* pm = (Uint8*)surf->pixels;
     Uint8* colorptr = (Uint8*)&color;
     const int hasalpha = surf->format->Amask;
+    SDL_Rect *clip = &surf->clip_rect;
+
+    if(draw_recording(surf))
+    {
+        DrawOp *op = draw_record(DRAWOP_AALINE,
+                                 (int)floor(MIN(x1, x2)) - 1, (int)floor(MIN(y1, y2)) - 1,
+                                 (int)ceil(MAX(x1, x2)) + 2, (int)ceil(MAX(y1, y2)) + 2);
+        if(op)
+        {
+            op->color = color;
+            op->f[0] = x1; op->f[1] = y1; op->f[2] = x2; op->f[3] = y2;
+            op->blend = blend;
+        }
+        return;
+    }
 
     pixx = surf->format->BytesPerPixel;
     pixy = surf->pitch;
@@ -982,30 +1491,24 @@ static void drawaaline(SDL_Surface* surf, Uint32 color, float x1, float y1, floa
         yf = yend+grad;
         brightness1 = INVFRAC(yend) * xgap;
         brightness2 =    FRAC(yend) * xgap;
-        pixel = pm + pixx * ix1 + pixy * iy1;
-        DRAWPIX32(pixel, colorptr, brightness1, blend)
-            pixel += pixy;
-        DRAWPIX32(pixel, colorptr, brightness2, blend)
-            xend = trunc(x2)+0.5;
+        AAPIX(ix1, iy1, brightness1)
+        AAPIX(ix1, iy1 + 1, brightness2)
+        xend = trunc(x2)+0.5;
         yend = y2+grad*(xend-x2);
         xgap =    FRAC(x2); /* this also differs from Hugo's description. */
         ix2 = (int)xend;
         iy2 = (int)yend;
         brightness1 = INVFRAC(yend) * xgap;
         brightness2 =    FRAC(yend) * xgap;
-        pixel = pm + pixx * ix2 + pixy * iy2;
-        DRAWPIX32(pixel, colorptr, brightness1, blend)
-            pixel += pixy;
-        DRAWPIX32(pixel, colorptr, brightness2, blend)
-            for(x=ix1+1; x<ix2; ++x) {
-                brightness1=INVFRAC(yf);
-                brightness2=   FRAC(yf);
-                pixel = pm + pixx * x + pixy * (int)yf;
-                DRAWPIX32(pixel, colorptr, brightness1, blend)
-                    pixel += pixy;
-                DRAWPIX32(pixel, colorptr, brightness2, blend)
-                    yf += grad;
-            }
+        AAPIX(ix2, iy2, brightness1)
+        AAPIX(ix2, iy2 + 1, brightness2)
+        for(x=ix1+1; x<ix2; ++x) {
+            brightness1=INVFRAC(yf);
+            brightness2=   FRAC(yf);
+            AAPIX(x, (int)yf, brightness1)
+            AAPIX(x, (int)yf + 1, brightness2)
+            yf += grad;
+        }
     }
     else {
         if(y1>y2) {
@@ -1023,30 +1526,24 @@ static void drawaaline(SDL_Surface* surf, Uint32 color, float x1, float y1, floa
         xf = xend+grad;
         brightness1 = INVFRAC(xend) * ygap;
         brightness2 =    FRAC(xend) * ygap;
-        pixel = pm + pixx * ix1 + pixy * iy1;
-        DRAWPIX32(pixel, colorptr, brightness1, blend)
-            pixel += pixx;
-        DRAWPIX32(pixel, colorptr, brightness2, blend)
-            yend = trunc(y2)+0.5;
+        AAPIX(ix1, iy1, brightness1)
+        AAPIX(ix1 + 1, iy1, brightness2)
+        yend = trunc(y2)+0.5;
         xend = x2+grad*(yend-y2);
         ygap = FRAC(y2);
         iy2 = (int)yend;
         ix2 = (int)xend;
         brightness1 = INVFRAC(xend) * ygap;
         brightness2 =    FRAC(xend) * ygap;
-        pixel = pm + pixx * ix2 + pixy * iy2;
-        DRAWPIX32(pixel, colorptr, brightness1, blend)
-            pixel += pixx;
-        DRAWPIX32(pixel, colorptr, brightness2, blend)
-            for(y=iy1+1; y<iy2; ++y) {
-                brightness1=INVFRAC(xf);
-                brightness2=   FRAC(xf);
-                pixel = pm + pixx * (int)xf + pixy * y;
-                DRAWPIX32(pixel, colorptr, brightness1, blend)
-                    pixel += pixx;
-                DRAWPIX32(pixel, colorptr, brightness2, blend)
-                    xf += grad;
-            }
+        AAPIX(ix2, iy2, brightness1)
+        AAPIX(ix2 + 1, iy2, brightness2)
+        for(y=iy1+1; y<iy2; ++y) {
+            brightness1=INVFRAC(xf);
+            brightness2=   FRAC(xf);
+            AAPIX((int)xf, y, brightness1)
+            AAPIX((int)xf + 1, y, brightness2)
+            xf += grad;
+        }
     }
 }
 
@@ -1061,6 +1558,17 @@ static void drawline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2, in
     Uint8 *pixel;
     Uint8 *colorptr;
 
+    if(draw_recording(surf))
+    {
+        DrawOp *op = draw_record(DRAWOP_LINE, MIN(x1, x2), MIN(y1, y2), MAX(x1, x2) + 1, MAX(y1, y2) + 1);
+        if(op)
+        {
+            op->color = color;
+            op->x1 = x1; op->y1 = y1; op->x2 = x2; op->y2 = y2;
+        }
+        return;
+    }
+
     deltax = x2 - x1;
     deltay = y2 - y1;
     signx = (deltax < 0) ? -1 : 1;
@@ -1111,11 +1619,49 @@ static void drawline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2, in
 
 
 
+/* Fill count 32 bit pixels from pixel on with color */
+static void fill_span32(Uint32* pixel, int count, Uint32 color)
+{
+#if defined(DRAW_SSE2)
+    __m128i colors;
+
+    /* Up to the first 16 byte boundary, then four pixels a store */
+    while(count && ((size_t)pixel & 15)) {
+        *pixel++ = color;
+        --count;
+    }
+    colors = _mm_set1_epi32((int)color);
+    for(; count >= 16; count -= 16, pixel += 16) {
+        _mm_store_si128((__m128i*)pixel, colors);
+        _mm_store_si128((__m128i*)(pixel + 4), colors);
+        _mm_store_si128((__m128i*)(pixel + 8), colors);
+        _mm_store_si128((__m128i*)(pixel + 12), colors);
+    }
+    for(; count >= 4; count -= 4, pixel += 4) {
+        _mm_store_si128((__m128i*)pixel, colors);
+    }
+#endif
+    while(count--) {
+        *pixel++ = color;
+    }
+}
+
 static void drawhorzline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2)
 {
     Uint8 *pixel, *end;
     Uint8 *colorptr;
 
+    if(draw_recording(surf))
+    {
+        DrawOp *op = draw_record(DRAWOP_HORZLINE, MIN(x1, x2), y1, MAX(x1, x2) + 1, y1 + 1);
+        if(op)
+        {
+            op->color = color;
+            op->x1 = x1; op->y1 = y1; op->x2 = x2;
+        }
+        return;
+    }
+
     if(x1 == x2)
     {
         set_at(surf, x1, y1, color);
@@ -1136,9 +1682,8 @@ static void drawhorzline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2
     switch(surf->format->BytesPerPixel)
     {
     case 1:
-        for(; pixel <= end; ++pixel) {
-            *pixel = (Uint8)color;
-        }break;
+        memset(pixel, (Uint8)color, end - pixel + 1);
+        break;
     case 2:
         for(; pixel <= end; pixel+=2) {
             *(Uint16*)pixel = (Uint16)color;
@@ -1152,9 +1697,8 @@ static void drawhorzline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2
             pixel[2] = colorptr[2];
         }break;
     default: /*case 4*/
-        for(; pixel <= end; pixel+=4) {
-            *(Uint32*)pixel = color;
-          }break;
+        fill_span32((Uint32*)pixel, (int)((end - pixel) / 4) + 1, color);
+        break;
     }
 }
 
@@ -1187,6 +1731,17 @@ static void drawvertline(SDL_Surface* surf, Uint32 color, int x1, int y1, int y2
     Uint8   *colorptr;
     Uint32  pitch = surf->pitch;
 
+    if(draw_recording(surf))
+    {
+        DrawOp *op = draw_record(DRAWOP_VERTLINE, x1, MIN(y1, y2), x1 + 1, MAX(y1, y2) + 1);
+        if(op)
+        {
+            op->color = color;
+            op->x1 = x1; op->y1 = y1; op->y2 = y2;
+        }
+        return;
+    }
+
     if(y1 == y2)
     {
         set_at(surf, x1, y1, color);
@@ -1242,6 +1797,8 @@ static void drawvertlineclip(SDL_Surface* surf, Uint32 color, int x1, int y1, in
     }
     y1 = MAX(y1, surf->clip_rect.y);
     y2 = MIN(y2, surf->clip_rect.y + surf->clip_rect.h-1);
+    if(y2 < y1)
+        return;
     if(y2 - y1 < 1)
         set_at( surf, x1, y1, color);
     else
@@ -1298,6 +1855,17 @@ static void draw_ellipse(SDL_Surface *dst, int x, int y, int rx, int ry, Uint32
     int xmj, xpj, ymi, ypi;
     int xmk, xpk, ymh, yph;
 
+    if(draw_recording(dst))
+    {
+        DrawOp *op = draw_record(DRAWOP_ELLIPSE, x - rx - 1, y - ry - 1, x + rx + 2, y + ry + 2);
+        if(op)
+        {
+            op->color = color;
+            op->x1 = x; op->y1 = y; op->x2 = rx; op->y2 = ry;
+        }
+        return;
+    }
+
     if (rx==0 && ry==0) {  /* Special case - draw a single pixel */
         set_at( dst, x, y, color);
         return;
@@ -1406,6 +1974,17 @@ static void draw_fillellipse(SDL_Surface *dst, int x, int y, int rx, int ry, Uin
     int h, i, j, k;
     int oh, oi, oj, ok;
 
+    if(draw_recording(dst))
+    {
+        DrawOp *op = draw_record(DRAWOP_FILLELLIPSE, x - rx - 1, y - ry - 1, x + rx + 2, y + ry + 2);
+        if(op)
+        {
+            op->color = color;
+            op->x1 = x; op->y1 = y; op->x2 = rx; op->y2 = ry;
+        }
+        return;
+    }
+
     if (rx==0 && ry==0) {  /* Special case - draw a single pixel */
         set_at( dst, x, y, color);
         return;
@@ -1475,75 +2054,756 @@ static void draw_fillellipse(SDL_Surface *dst, int x, int y, int rx, int ry, Uin
 }
 
 
-static int compare_int(const void *a, const void *b)
+/* An edge of a filled polygon, from its top end (x1, y1) down to y2 */
+typedef struct {
+    int x1, y1, y2;
+    int dx, dy;
+    int x;      /* where it crosses the scanline being drawn */
+} PolyEdge;
+
+/* Bytes of memory fillpoly_scan needs for n vertices */
+#define FILLPOLY_SCRATCH(n) ((size_t)(n) * (sizeof(PolyEdge) + sizeof(PolyEdge *)))
+
+/* Memory for draw_fillpoly, kept from one call to the next */
+static void *fillpoly_scratch = NULL;
+static size_t fillpoly_scratch_size = 0;
+
+static int compare_edge_top(const void *a, const void *b)
 {
-    return (*(const int *)a) - (*(const int *)b);
+    return ((const PolyEdge *)a)->y1 - ((const PolyEdge *)b)->y1;
 }
 
-static void draw_fillpoly(SDL_Surface *dst, int *vx, int *vy, int n, Uint32 color)
+/* Fills the polygon in scanlines, with each line's spans between pairs of
+ * the x where it crosses the edges. The edges are sorted by their top once;
+ * the active list only holds the edges crossing the line, and stays in x
+ * order from line to line, so an insertion pass keeps it sorted. */
+static void fillpoly_scan(SDL_Surface *dst, int *vx, int *vy, int n, Uint32 color,
+                          void *scratch)
 {
-    int i;
-    int y;
+    int i, j;
+    int y, first, last;
     int miny, maxy;
-    int x1, y1;
-    int x2, y2;
     int ind1, ind2;
-    int ints;
-    int *polyints = PyMem_New(int, n);
-    if (polyints == NULL) {
-        PyErr_NoMemory();
-        return;
-    }
+    int nedges, nactive, next;
+    PolyEdge *edges, *edge;
+    PolyEdge **active;
 
+    edges = (PolyEdge *)scratch;
+    active = (PolyEdge **)(edges + n);
 
-    /* Determine Y maxima */
+    /* The edge table, without the horizontal edges */
     miny = vy[0];
     maxy = vy[0];
-    for (i=1; (i < n); i++)
-    {
+    nedges = 0;
+    for (i = 0; (i < n); i++) {
         miny = MIN(miny, vy[i]);
         maxy = MAX(maxy, vy[i]);
+        ind1 = i ? i - 1 : n - 1;
+        ind2 = i;
+        if (vy[ind1] == vy[ind2]) {
+            continue;
+        }
+        if (vy[ind1] > vy[ind2]) {
+            ind1 = ind2;
+            ind2 = i ? i - 1 : n - 1;
+        }
+        edge = edges + nedges++;
+        edge->x1 = vx[ind1];
+        edge->y1 = vy[ind1];
+        edge->y2 = vy[ind2];
+        edge->dx = vx[ind2] - vx[ind1];
+        edge->dy = vy[ind2] - vy[ind1];
     }
+    qsort(edges, nedges, sizeof(PolyEdge), compare_edge_top);
+
+    /* Draw, scanning y over the clip rect */
+    first = MAX(miny, dst->clip_rect.y);
+    last = MIN(maxy, dst->clip_rect.y + dst->clip_rect.h - 1);
+    nactive = 0;
+    next = 0;
+    for (y = first; (y <= last); y++) {
+        while (next < nedges && edges[next].y1 <= y) {
+            active[nactive++] = edges + next++;
+        }
 
-    /* Draw, scanning y */
-    for(y=miny; (y <= maxy); y++) {
-        ints = 0;
-        for (i=0; (i < n); i++) {
-            if (!i) {
-                ind1 = n-1;
-                ind2 = 0;
-            } else {
-                ind1 = i-1;
-                ind2 = i;
+        /* An edge covers its top line, not its bottom one, except on the
+         * bottom line of the polygon */
+        for (i = 0, j = 0; (i < nactive); i++) {
+            edge = active[i];
+            if (edge->y2 < y || (edge->y2 == y && y != maxy)) {
+                continue;
             }
-            y1 = vy[ind1];
-            y2 = vy[ind2];
-            if (y1 < y2) {
-                x1 = vx[ind1];
-                x2 = vx[ind2];
-            } else if (y1 > y2) {
-                y2 = vy[ind1];
-                y1 = vy[ind2];
-                x2 = vx[ind1];
-                x1 = vx[ind2];
-            } else {
+            edge->x = (y - edge->y1) * edge->dx / edge->dy + edge->x1;
+            active[j++] = edge;
+        }
+        nactive = j;
+
+        for (i = 1; (i < nactive); i++) {
+            edge = active[i];
+            for (j = i; j > 0 && active[j - 1]->x > edge->x; j--) {
+                active[j] = active[j - 1];
+            }
+            active[j] = edge;
+        }
+
+        for (i = 0; (i + 1 < nactive); i += 2) {
+            drawhorzlineclip(dst, color, active[i]->x, y, active[i + 1]->x);
+        }
+    }
+}
+
+
+static void draw_fillpoly(SDL_Surface *dst, int *vx, int *vy, int n, Uint32 color)
+{
+    int i, left, top, right, bottom;
+    size_t size;
+    void *scratch;
+    DrawOp *op;
+
+    if (draw_recording(dst)) {
+        left = right = vx[0];
+        top = bottom = vy[0];
+        for (i = 1; i < n; i++) {
+            left = MIN(left, vx[i]);
+            right = MAX(right, vx[i]);
+            top = MIN(top, vy[i]);
+            bottom = MAX(bottom, vy[i]);
+        }
+        op = draw_record(DRAWOP_FILLPOLY, left, top, right + 1, bottom + 1);
+        if (op == NULL) {
+            return;
+        }
+        op->pts = (int *)draw_record_data(op, n * sizeof(int) * 2);
+        if (op->pts == NULL) {
+            return;
+        }
+        memcpy(op->pts, vx, n * sizeof(int));
+        memcpy(op->pts + n, vy, n * sizeof(int));
+        op->n = n;
+        op->color = color;
+        return;
+    }
+
+    size = FILLPOLY_SCRATCH(n);
+    if (size > fillpoly_scratch_size) {
+        scratch = PyMem_Realloc(fillpoly_scratch, size);
+        if (scratch == NULL) {
+            PyErr_NoMemory();
+            return;
+        }
+        fillpoly_scratch = scratch;
+        fillpoly_scratch_size = size;
+    }
+    fillpoly_scan(dst, vx, vy, n, color, fillpoly_scratch);
+}
+
+/* The rows of coverage worked out at a time */
+#define AAWIDE_BAND 64
+
+/* Memory for draw_aawide, kept from one call to the next */
+static Uint8 *aawide_scratch = NULL;
+static size_t aawide_scratch_size = 0;
+
+static void aawide_segment(AASegment *seg, float x1, float y1, float x2, float y2, int round)
+{
+    double len = sqrt((double)(x2 - x1) * (x2 - x1) + (double)(y2 - y1) * (y2 - y1));
+
+    seg->ax = x1;
+    seg->ay = y1;
+    seg->dx = x2 - x1;
+    seg->dy = y2 - y1;
+    seg->len = (float)len;
+    if (len > 0) {
+        seg->ux = (float)(seg->dx / len);
+        seg->uy = (float)(seg->dy / len);
+        seg->inv_len2 = (float)(1.0 / (len * len));
+        seg->round = round;
+    }
+    else {
+        seg->ux = seg->uy = 0;
+        seg->inv_len2 = 0;
+        seg->round = 1;
+    }
+}
+
+/* The coverage in 0-1 of the pixel centred (px, py) from the segment
+ * start, for a half width r. The edge ramps over one pixel. */
+static float aawide_coverage(const AASegment *seg, float px, float py, float r)
+{
+    float t, qx, qy, across, along, c, c_start, c_end;
+
+    if (seg->round) {
+        t = (px * seg->dx + py * seg->dy) * seg->inv_len2;
+        t = t < 0 ? 0 : (t > 1 ? 1 : t);
+        qx = px - t * seg->dx;
+        qy = py - t * seg->dy;
+        c = r + 0.5f - (float)sqrt(qx * qx + qy * qy);
+        return c < 0 ? 0 : (c > 1 ? 1 : c);
+    }
+    along = px * seg->ux + py * seg->uy;
+    across = (float)fabs(px * seg->uy - py * seg->ux);
+    c = r + 0.5f - across;
+    c_start = along + 0.5f;
+    c_end = seg->len + 0.5f - along;
+    c = c < 0 ? 0 : (c > 1 ? 1 : c);
+    c_start = c_start < 0 ? 0 : (c_start > 1 ? 1 : c_start);
+    c_end = c_end < 0 ? 0 : (c_end > 1 ? 1 : c_end);
+    return c * c_start * c_end;
+}
+
+/* Raises the coverage of pixels x0 to x1 - 1 of row y to that of the
+ * segment, with cov holding the row from pixel x = 0 */
+static void aawide_segment_row(Uint8 *cov, int x0, int x1, int y, const AASegment *seg, float r)
+{
+    float py = y + 0.5f - seg->ay;
+    Uint8 c;
+    int x = x0;
+
+#if defined(DRAW_SSE2)
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 edge = _mm_set1_ps(r + 0.5f);
+    __m128 scale = _mm_set1_ps(255.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128 vpy = _mm_set1_ps(py);
+    __m128 vax = _mm_set1_ps(seg->ax);
+    __m128i vx = _mm_add_epi32(_mm_set1_epi32(x0), _mm_set_epi32(3, 2, 1, 0));
+    __m128i four = _mm_set1_epi32(4);
+    __m128 vpx, vc, t, qx, qy, along, across, c_start, c_end;
+    __m128i vi;
+    int packed, old;
+
+    for (; x + 4 <= x1; x += 4) {
+        vpx = _mm_sub_ps(_mm_add_ps(_mm_cvtepi32_ps(vx), half), vax);
+        if (seg->round) {
+            t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(vpx, _mm_set1_ps(seg->dx)),
+                                      _mm_mul_ps(vpy, _mm_set1_ps(seg->dy))),
+                           _mm_set1_ps(seg->inv_len2));
+            t = _mm_min_ps(_mm_max_ps(t, zero), one);
+            qx = _mm_sub_ps(vpx, _mm_mul_ps(t, _mm_set1_ps(seg->dx)));
+            qy = _mm_sub_ps(vpy, _mm_mul_ps(t, _mm_set1_ps(seg->dy)));
+            vc = _mm_sub_ps(edge, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(qx, qx),
+                                                         _mm_mul_ps(qy, qy))));
+            vc = _mm_min_ps(_mm_max_ps(vc, zero), one);
+        }
+        else {
+            along = _mm_add_ps(_mm_mul_ps(vpx, _mm_set1_ps(seg->ux)),
+                               _mm_mul_ps(vpy, _mm_set1_ps(seg->uy)));
+            across = _mm_sub_ps(_mm_mul_ps(vpx, _mm_set1_ps(seg->uy)),
+                                _mm_mul_ps(vpy, _mm_set1_ps(seg->ux)));
+            across = _mm_andnot_ps(_mm_set1_ps(-0.0f), across);
+            vc = _mm_sub_ps(edge, across);
+            c_start = _mm_add_ps(along, half);
+            c_end = _mm_sub_ps(_mm_set1_ps(seg->len + 0.5f), along);
+            vc = _mm_min_ps(_mm_max_ps(vc, zero), one);
+            c_start = _mm_min_ps(_mm_max_ps(c_start, zero), one);
+            c_end = _mm_min_ps(_mm_max_ps(c_end, zero), one);
+            vc = _mm_mul_ps(_mm_mul_ps(vc, c_start), c_end);
+        }
+        vi = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(vc, scale), half));
+        vi = _mm_packs_epi32(vi, vi);
+        vi = _mm_packus_epi16(vi, vi);
+        memcpy(&old, cov + x, 4);
+        vi = _mm_max_epu8(vi, _mm_cvtsi32_si128(old));
+        packed = _mm_cvtsi128_si32(vi);
+        memcpy(cov + x, &packed, 4);
+        vx = _mm_add_epi32(vx, four);
+    }
+#endif
+    for (; x < x1; x++) {
+        c = (Uint8)(aawide_coverage(seg, x + 0.5f - seg->ax, py, r) * 255.0f + 0.5f);
+        if (c > cov[x]) {
+            cov[x] = c;
+        }
+    }
+}
+
+/* The pixels of row y the segment may cover, as x0 to x1 - 1, kept within
+ * 0 to w. Any pixel with coverage is within rs of the segment. */
+static int aawide_segment_span(const AASegment *seg, float rs, int y, int w, int *x0, int *x1)
+{
+    float yc = y + 0.5f - seg->ay;
+    float t0, t1, lo, hi, tmp;
+
+    if (seg->dy != 0) {
+        t0 = (yc - rs) / seg->dy;
+        t1 = (yc + rs) / seg->dy;
+        if (t0 > t1) {
+            tmp = t0; t0 = t1; t1 = tmp;
+        }
+        t0 = MAX(t0, 0);
+        t1 = MIN(t1, 1);
+        if (t0 > t1) {
+            return 0;
+        }
+    }
+    else {
+        if (yc > rs || yc < -rs) {
+            return 0;
+        }
+        t0 = 0;
+        t1 = 1;
+    }
+    lo = seg->ax + t0 * seg->dx;
+    hi = seg->ax + t1 * seg->dx;
+    if (lo > hi) {
+        tmp = lo; lo = hi; hi = tmp;
+    }
+    lo = MAX(lo - rs, 0);
+    hi = MIN(hi + rs, w);
+    if (lo >= hi) {
+        return 0;
+    }
+    *x0 = (int)floor(lo);
+    *x1 = (int)ceil(hi);
+    return 1;
+}
+
+/* Draws the union of the segments at width 2 * r, antialiased: the
+ * coverage of each pixel is the most any segment gives it, so overlaps at
+ * the joins are not blended twice. The color is blended by its alpha times
+ * the coverage, with the blitter's alpha blend. The coverage is worked out
+ * a band of rows at a time, only over each row's span of the segments,
+ * in cov if given, which must hold AAWIDE_BAND rows as wide as the clip
+ * rect. Returns 0 if nothing is in the clip rect, -1 on a memory error. */
+static int draw_aawide(SDL_Surface *surf, Uint8 *rgba, AASegment *segs, int nsegs, float r,
+                       Uint8 *cov)
+{
+    SDL_PixelFormat *format = surf->format;
+    SDL_Rect *clip = &surf->clip_rect;
+    int bpp = format->BytesPerPixel;
+    int ppa = format->Amask != 0;
+    float rs = r + 1.0f;
+    float minx, miny, maxx, maxy;
+    int left, top, right, bottom, w;
+    int band, rows, y, x, i, x0, x1;
+    int rowlo[AAWIDE_BAND], rowhi[AAWIDE_BAND];
+    size_t size;
+    Uint8 *scratch, *row, *pixel;
+    Uint32 opaque, px;
+    DrawOp *op;
+    int sA, dR, dG, dB, dA;
+    Uint8 drgb[3];
+    AASegment local;
+
+    /* The bounds of the segments, within the clip rect; each segment is
+     * taken from the clip rect's corner */
+    minx = maxx = segs[0].ax;
+    miny = maxy = segs[0].ay;
+    for (i = 0; i < nsegs; i++) {
+        minx = MIN(minx, MIN(segs[i].ax, segs[i].ax + segs[i].dx));
+        maxx = MAX(maxx, MAX(segs[i].ax, segs[i].ax + segs[i].dx));
+        miny = MIN(miny, MIN(segs[i].ay, segs[i].ay + segs[i].dy));
+        maxy = MAX(maxy, MAX(segs[i].ay, segs[i].ay + segs[i].dy));
+    }
+    minx = MAX(minx - rs, clip->x);
+    miny = MAX(miny - rs, clip->y);
+    maxx = MIN(maxx + rs, clip->x + clip->w);
+    maxy = MIN(maxy + rs, clip->y + clip->h);
+    if (minx >= maxx || miny >= maxy) {
+        return 0;
+    }
+    left = (int)floor(minx);
+    top = (int)floor(miny);
+    right = (int)ceil(maxx);
+    bottom = (int)ceil(maxy);
+    w = right - left;
+
+    if (draw_recording(surf)) {
+        op = draw_record(DRAWOP_AAWIDE, left, top, right, bottom);
+        if (op == NULL) {
+            return -1;
+        }
+        op->segs = (AASegment *)draw_record_data(op, nsegs * sizeof(AASegment));
+        if (op->segs == NULL) {
+            return -1;
+        }
+        memcpy(op->segs, segs, nsegs * sizeof(AASegment));
+        op->n = nsegs;
+        op->r = r;
+        memcpy(op->rgba, rgba, 4);
+        return 1;
+    }
+
+    if (cov == NULL) {
+        size = (size_t)w * AAWIDE_BAND;
+        if (size > aawide_scratch_size) {
+            scratch = (Uint8 *)PyMem_Realloc(aawide_scratch, size);
+            if (scratch == NULL) {
+                PyErr_NoMemory();
+                return -1;
+            }
+            aawide_scratch = scratch;
+            aawide_scratch_size = size;
+        }
+        cov = aawide_scratch;
+    }
+
+    opaque = SDL_MapRGBA(format, rgba[0], rgba[1], rgba[2], 255);
+    for (band = top; band < bottom; band += AAWIDE_BAND) {
+        rows = MIN(AAWIDE_BAND, bottom - band);
+        for (y = 0; y < rows; y++) {
+            rowlo[y] = w;
+            rowhi[y] = 0;
+        }
+
+        for (i = 0; i < nsegs; i++) {
+            local = segs[i];
+            local.ax -= left;
+            local.ay -= band;
+            if (MIN(local.ay, local.ay + local.dy) - rs >= rows ||
+                MAX(local.ay, local.ay + local.dy) + rs <= 0) {
                 continue;
             }
-            if ((y >= y1) && (y < y2)) {
-                polyints[ints++] = (y-y1) * (x2-x1) / (y2-y1) + x1;
-            } else if ((y == maxy) && (y > y1) && (y <= y2)) {
-                polyints[ints++] = (y-y1) * (x2-x1) / (y2-y1) + x1;
+            for (y = 0; y < rows; y++) {
+                if (!aawide_segment_span(&local, rs, y, w, &x0, &x1)) {
+                    continue;
+                }
+                /* Each row's buffer is cleared over the hull of its spans */
+                row = cov + y * w;
+                if (rowlo[y] >= rowhi[y]) {
+                    memset(row + x0, 0, x1 - x0);
+                    rowlo[y] = x0;
+                    rowhi[y] = x1;
+                }
+                else {
+                    if (x0 < rowlo[y]) {
+                        memset(row + x0, 0, rowlo[y] - x0);
+                        rowlo[y] = x0;
+                    }
+                    if (x1 > rowhi[y]) {
+                        memset(row + rowhi[y], 0, x1 - rowhi[y]);
+                        rowhi[y] = x1;
+                    }
+                }
+                aawide_segment_row(row, x0, x1, y, &local, r);
             }
         }
-        qsort(polyints, ints, sizeof(int), compare_int);
 
-        for (i=0; (i<ints); i+=2) {
-            drawhorzlineclip(dst, color, polyints[i], y, polyints[i+1]);
+        for (y = 0; y < rows; y++) {
+            row = cov + y * w;
+            pixel = (Uint8 *)surf->pixels + (band + y) * surf->pitch +
+                (left + rowlo[y]) * bpp;
+            for (x = rowlo[y]; x < rowhi[y]; x++, pixel += bpp) {
+                if (!row[x]) {
+                    continue;
+                }
+                sA = (rgba[3] * row[x] + 127) / 255;
+                if (!sA) {
+                    continue;
+                }
+                if (sA == 255 && bpp != 3) {
+                    if (bpp == 1) {
+                        *pixel = (Uint8)opaque;
+                    }
+                    else if (bpp == 2) {
+                        *(Uint16 *)pixel = (Uint16)opaque;
+                    }
+                    else {
+                        *(Uint32 *)pixel = opaque;
+                    }
+                    continue;
+                }
+                if (bpp == 1) {
+                    SDL_GetRGB(*pixel, format, drgb, drgb + 1, drgb + 2);
+                    dR = drgb[0]; dG = drgb[1]; dB = drgb[2]; dA = 255;
+                    ALPHA_BLEND(rgba[0], rgba[1], rgba[2], sA, dR, dG, dB, dA);
+                    *pixel = (Uint8)SDL_MapRGB(format, dR, dG, dB);
+                    continue;
+                }
+                GET_PIXEL(px, bpp, pixel);
+                GET_PIXELVALS(dR, dG, dB, dA, px, format, ppa);
+                ALPHA_BLEND(rgba[0], rgba[1], rgba[2], sA, dR, dG, dB, dA);
+                if (bpp != 3) {
+                    CREATE_PIXEL(pixel, dR, dG, dB, dA, bpp, format);
+                    continue;
+                }
+#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+                pixel[format->Rshift >> 3] = (Uint8)dR;
+                pixel[format->Gshift >> 3] = (Uint8)dG;
+                pixel[format->Bshift >> 3] = (Uint8)dB;
+#else
+                pixel[2 - (format->Rshift >> 3)] = (Uint8)dR;
+                pixel[2 - (format->Gshift >> 3)] = (Uint8)dG;
+                pixel[2 - (format->Bshift >> 3)] = (Uint8)dB;
+#endif
+            }
         }
     }
-    PyMem_Free(polyints);
+    return 1;
+}
+
+
+/* drawline, drawing only the pixels in the clip rect, the same ones
+ * drawline draws there */
+static void drawlineclip(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2, int y2)
+{
+    int deltax, deltay, signx, signy;
+    int stepx, stepy, minorx, minory;
+    int x = 0, y = 0;
+    int swaptmp;
+
+    deltax = x2 - x1;
+    deltay = y2 - y1;
+    signx = (deltax < 0) ? -1 : 1;
+    signy = (deltay < 0) ? -1 : 1;
+    deltax = signx * deltax + 1;
+    deltay = signy * deltay + 1;
+
+    stepx = signx; stepy = 0;
+    minorx = 0; minory = signy;
+    if(deltax < deltay) /*swap axis if rise > run*/
+    {
+        swaptmp = deltax; deltax = deltay; deltay = swaptmp;
+        stepx = 0; stepy = signy;
+        minorx = signx; minory = 0;
+    }
+
+    for(; x < deltax; x++, x1 += stepx, y1 += stepy) {
+        set_at(surf, x1, y1, color);
+        y += deltay; if(y >= deltax) {y -= deltax; x1 += minorx; y1 += minory;}
+    }
+}
+
+/* Runs a recorded op on tile, a copy of the batch surface clipped to one
+ * tile. The scratch memory is the worker's own. */
+static void draw_op_run(SDL_Surface *tile, DrawOp *op, void *polyscratch, Uint8 *cov)
+{
+    switch(op->type)
+    {
+    case DRAWOP_LINE:
+        drawlineclip(tile, op->color, op->x1, op->y1, op->x2, op->y2);
+        break;
+    case DRAWOP_HORZLINE:
+        drawhorzlineclip(tile, op->color, op->x1, op->y1, op->x2);
+        break;
+    case DRAWOP_VERTLINE:
+        drawvertlineclip(tile, op->color, op->x1, op->y1, op->y2);
+        break;
+    case DRAWOP_AALINE:
+        drawaaline(tile, op->color, op->f[0], op->f[1], op->f[2], op->f[3], op->blend);
+        break;
+    case DRAWOP_ELLIPSE:
+        draw_ellipse(tile, op->x1, op->y1, op->x2, op->y2, op->color);
+        break;
+    case DRAWOP_FILLELLIPSE:
+        draw_fillellipse(tile, op->x1, op->y1, op->x2, op->y2, op->color);
+        break;
+    case DRAWOP_FILLPOLY:
+        fillpoly_scan(tile, op->pts, op->pts + op->n, op->n, op->color, polyscratch);
+        break;
+    case DRAWOP_AAWIDE:
+        draw_aawide(tile, op->rgba, op->segs, op->n, op->r, cov);
+        break;
+    }
+}
+
+/* The tiles of a batch: tile t is drawn by the ops list[offsets[t]] to
+ * list[offsets[t + 1] - 1], in the order they were recorded. Band b of
+ * nbands draws tiles b, b + nbands, ... */
+typedef struct {
+    SDL_Surface *surf;
+    DrawOp *ops;
+    int tiles_x, ntiles;
+    size_t *offsets;
+    int *list;
+    int nbands;
+    Uint8 *scratch;
+    size_t bandsize;            /* of scratch, for each band */
+    size_t polysize;            /* of that, for fillpoly_scan */
+} DrawTiles;
+
+/* The threads batch draws on, set by set_batch_threads */
+static int batch_threads = 0;
+
+static void draw_tiles_band(DrawTiles *job, int band)
+{
+    SDL_Surface tile = *job->surf;
+    SDL_Rect *clip = &job->surf->clip_rect;
+    void *polyscratch = job->scratch + band * job->bandsize;
+    Uint8 *cov = (Uint8 *)polyscratch + job->polysize;
+    size_t i;
+    int t;
+
+    for(t = band; t < job->ntiles; t += job->nbands)
+    {
+        if(job->offsets[t] == job->offsets[t + 1])
+            continue;
+        tile.clip_rect.x = clip->x + (t % job->tiles_x) * PG_DRAW_TILE;
+        tile.clip_rect.y = clip->y + (t / job->tiles_x) * PG_DRAW_TILE;
+        tile.clip_rect.w = MIN(PG_DRAW_TILE, clip->x + clip->w - tile.clip_rect.x);
+        tile.clip_rect.h = MIN(PG_DRAW_TILE, clip->y + clip->h - tile.clip_rect.y);
+        for(i = job->offsets[t]; i < job->offsets[t + 1]; ++i)
+            draw_op_run(&tile, job->ops + job->list[i], polyscratch, cov);
+    }
+}
+
+/* PgPool_Run job drawing bands first to first + n - 1 of a DrawTiles */
+static int draw_tiles_job(void *data, int first, int n)
+{
+    int band;
+
+    for(band = first; band < first + n; ++band)
+        draw_tiles_band((DrawTiles *)data, band);
+    return 0;
+}
+
+/* The threads of the pool a batch is drawn on */
+static int draw_pool_threads(void)
+{
+    return MIN(batch_threads, PgPool_GetThreads());
+}
+
+/* Whether a batch of ncommands on surf is drawn in tiles */
+static int draw_pool_take(SDL_Surface *surf, int ncommands)
+{
+    return draw_pool_threads() > 1 && ncommands >= PG_DRAW_MIN_COMMANDS &&
+        surf->clip_rect.w * surf->clip_rect.h >= PG_DRAW_MIN_PIXELS;
+}
+
+/* Bins the ops of a recorded batch into tiles, and draws the tiles on the
+ * worker pool, with the GIL released. Returns -1 on a memory error. */
+static int draw_run_tiles(DrawBatch *state)
+{
+    SDL_Surface *surf = state->surf;
+    SDL_Rect *clip = &surf->clip_rect;
+    DrawTiles job;
+    DrawOp *op;
+    size_t *next = NULL;
+    size_t total;
+    int i, t, tx, ty, tx0, tx1, ty0, ty1;
+    int result = -1;
+
+    memset(&job, 0, sizeof(job));
+    job.surf = surf;
+    job.ops = state->ops;
+    job.tiles_x = (clip->w + PG_DRAW_TILE - 1) / PG_DRAW_TILE;
+    job.ntiles = job.tiles_x * ((clip->h + PG_DRAW_TILE - 1) / PG_DRAW_TILE);
+    if(job.ntiles < 1)
+        return 0;
+
+    /* Count the ops in each tile, keeping their bounds to the clip rect */
+    job.offsets = PyMem_New(size_t, job.ntiles + 1);
+    next = PyMem_New(size_t, job.ntiles);
+    if(!job.offsets || !next)
+        goto done;
+    memset(next, 0, job.ntiles * sizeof(size_t));
+    for(i = 0; i < state->nops; ++i)
+    {
+        op = state->ops + i;
+        op->left = MAX(op->left, clip->x);
+        op->top = MAX(op->top, clip->y);
+        op->right = MIN(op->right, clip->x + clip->w);
+        op->bottom = MIN(op->bottom, clip->y + clip->h);
+        if(op->left >= op->right || op->top >= op->bottom)
+            continue;
+        tx0 = (op->left - clip->x) / PG_DRAW_TILE;
+        tx1 = (op->right - 1 - clip->x) / PG_DRAW_TILE;
+        ty0 = (op->top - clip->y) / PG_DRAW_TILE;
+        ty1 = (op->bottom - 1 - clip->y) / PG_DRAW_TILE;
+        for(ty = ty0; ty <= ty1; ++ty)
+            for(tx = tx0; tx <= tx1; ++tx)
+                next[ty * job.tiles_x + tx]++;
+        if(op->type == DRAWOP_FILLPOLY)
+            job.polysize = MAX(job.polysize, FILLPOLY_SCRATCH(op->n));
+    }
+    total = 0;
+    for(t = 0; t < job.ntiles; ++t)
+    {
+        job.offsets[t] = total;
+        total += next[t];
+        next[t] = job.offsets[t];
+    }
+    job.offsets[job.ntiles] = total;
+
+    /* List the ops of each tile in order */
+    job.list = PyMem_New(int, total ? total : 1);
+    if(!job.list)
+        goto done;
+    for(i = 0; i < state->nops; ++i)
+    {
+        op = state->ops + i;
+        if(op->left >= op->right || op->top >= op->bottom)
+            continue;
+        tx0 = (op->left - clip->x) / PG_DRAW_TILE;
+        tx1 = (op->right - 1 - clip->x) / PG_DRAW_TILE;
+        ty0 = (op->top - clip->y) / PG_DRAW_TILE;
+        ty1 = (op->bottom - 1 - clip->y) / PG_DRAW_TILE;
+        for(ty = ty0; ty <= ty1; ++ty)
+            for(tx = tx0; tx <= tx1; ++tx)
+                job.list[next[ty * job.tiles_x + tx]++] = i;
+    }
+
+    /* Each band has its own scratch memory, and is drawn by one thread */
+    job.nbands = MIN(draw_pool_threads(), job.ntiles);
+    job.polysize = (job.polysize + 15) & ~(size_t)15;
+    job.bandsize = job.polysize + PG_DRAW_TILE * AAWIDE_BAND;
+    job.scratch = (Uint8 *)PyMem_Malloc(job.bandsize * job.nbands);
+    if(!job.scratch)
+        goto done;
+
+    Py_BEGIN_ALLOW_THREADS;
+    PgPool_Run(draw_tiles_job, &job, job.nbands, 1, job.nbands);
+    Py_END_ALLOW_THREADS;
+    result = 0;
+
+done:
+    if(result < 0)
+        PyErr_NoMemory();
+    PyMem_Free(job.scratch);
+    PyMem_Free(job.list);
+    PyMem_Free(job.offsets);
+    PyMem_Free(next);
+    return result;
 }
 
+/* Frees the ops recorded by a batch */
+static void draw_free_ops(DrawBatch *state)
+{
+    int i;
+
+    for(i = 0; i < state->nops; ++i)
+    {
+        PyMem_Free(state->ops[i].pts);
+        PyMem_Free(state->ops[i].segs);
+    }
+    PyMem_Free(state->ops);
+    state->ops = NULL;
+    state->nops = state->maxops = 0;
+}
+
+static PyObject* get_batch_threads(PyObject* self)
+{
+    return PyInt_FromLong(batch_threads);
+}
+
+static PyObject* set_batch_threads(PyObject* self, PyObject* arg)
+{
+    int threads;
+    PyObject *base, *result;
+
+    if(!PyArg_ParseTuple(arg, "i:set_batch_threads", &threads))
+        return NULL;
+    if(threads < 0)
+        return RAISE(PyExc_ValueError, "thread count must not be negative");
+    if(threads > PG_DRAW_MAX_THREADS)
+        threads = PG_DRAW_MAX_THREADS;
+
+    /* Grow the pool to the threads asked for */
+    if(threads > 1 && threads > PgPool_GetThreads())
+    {
+        base = PyImport_ImportModule("pygame.base");
+        if(!base)
+            return NULL;
+        result = PyObject_CallMethod(base, "set_pool_threads", "i", threads);
+        Py_DECREF(base);
+        if(!result)
+            return NULL;
+        Py_DECREF(result);
+    }
+    batch_threads = threads;
+    Py_RETURN_NONE;
+}
 
 
 static PyMethodDef _draw_methods[] =
@@ -1552,11 +2812,19 @@ static PyMethodDef _draw_methods[] =
     { "line", line, METH_VARARGS, DOC_PYGAMEDRAWLINE },
     { "aalines", aalines, METH_VARARGS, DOC_PYGAMEDRAWAALINES },
     { "lines", lines, METH_VARARGS, DOC_PYGAMEDRAWLINES },
+    { "aawideline", aawideline, METH_VARARGS, DOC_PYGAMEDRAWAAWIDELINE },
+    { "aawidelines", aawidelines, METH_VARARGS, DOC_PYGAMEDRAWAAWIDELINES },
+    { "aacapsule", aacapsule, METH_VARARGS, DOC_PYGAMEDRAWAACAPSULE },
     { "ellipse", ellipse, METH_VARARGS, DOC_PYGAMEDRAWELLIPSE },
     { "arc", arc, METH_VARARGS, DOC_PYGAMEDRAWARC },
     { "circle", circle, METH_VARARGS, DOC_PYGAMEDRAWCIRCLE },
     { "polygon", polygon, METH_VARARGS, DOC_PYGAMEDRAWPOLYGON },
     { "rect", rect, METH_VARARGS, DOC_PYGAMEDRAWRECT },
+    { "batch", batch, METH_VARARGS, DOC_PYGAMEDRAWBATCH },
+    { "set_batch_threads", set_batch_threads, METH_VARARGS,
+      DOC_PYGAMEDRAWSETBATCHTHREADS },
+    { "get_batch_threads", (PyCFunction) get_batch_threads, METH_NOARGS,
+      DOC_PYGAMEDRAWGETBATCHTHREADS },
 
     { NULL, NULL, 0, NULL }
 };
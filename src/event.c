@@ -29,6 +29,7 @@
 #include "doc/event_doc.h"
 
 #include "structmember.h"
+#include "pgfreelist.h"
 
 // FIXME: The system message code is only tested on windows, so only
 //          include it there for now.
@@ -41,88 +42,134 @@
 #define USEROBJECT_CHECK1 0xDEADBEEF
 #define USEROBJECT_CHECK2 0xFEEDF00D
 
-typedef struct UserEventObject
-{
-    struct UserEventObject* next;
-    PyObject* object;
-} UserEventObject;
+/* Most events taken from SDL in one call */
+#define EVENT_PEEP_MAX 128
 
-static UserEventObject* user_event_objects = NULL;
+/* The event types merged before events are made, as SDL_EVENTMASKs, and
+ * how many of each were merged away
+ */
+#define COALESCE_TYPES (SDL_EVENTMASK (SDL_MOUSEMOTION) |      \
+                        SDL_EVENTMASK (SDL_JOYAXISMOTION) |    \
+                        SDL_EVENTMASK (SDL_VIDEORESIZE))
+enum {COALESCE_MOTION, COALESCE_AXIS, COALESCE_RESIZE, COALESCE_COUNT};
+static Uint32 coalesce_mask = 0;
+static unsigned long coalesce_merged[COALESCE_COUNT];
+
+/* The dicts of posted events, by the slot number the SDL event carries
+ * in data2. Free slots are kept in a stack, so posting and getting an
+ * event take the same time however many posted events are queued.
+ */
+#define USEROBJECT_PREALLOC 256
+static PyObject** user_event_objects = NULL;
+static int* user_event_free = NULL;
+static int user_event_size = 0;
+static int user_event_numfree = 0;
+
+/* Make sure there are count free slots */
+static int
+user_event_reserve (int count)
+{
+    PyObject** objects;
+    int* freeslots;
+    int size, i;
+
+    if (user_event_numfree >= count)
+        return 0;
+    size = user_event_size ? user_event_size * 2 : USEROBJECT_PREALLOC;
+    while (size - user_event_size + user_event_numfree < count)
+        size *= 2;
+    objects = PyMem_Resize (user_event_objects, PyObject*, size);
+    if (!objects)
+    {
+        PyErr_NoMemory ();
+        return -1;
+    }
+    user_event_objects = objects;
+    freeslots = PyMem_Resize (user_event_free, int, size);
+    if (!freeslots)
+    {
+        PyErr_NoMemory ();
+        return -1;
+    }
+    user_event_free = freeslots;
+    /* Lower slots on top */
+    for (i = size - 1; i >= user_event_size; --i)
+    {
+        objects[i] = NULL;
+        freeslots[user_event_numfree++] = i;
+    }
+    user_event_size = size;
+    return 0;
+}
 
 /*must pass dictionary as this object*/
-static UserEventObject*
+static int
 user_event_addobject (PyObject* obj)
 {
-    UserEventObject* userobj = PyMem_New (UserEventObject, 1);
-    if (!userobj)
-        return NULL;
+    int slot;
 
+    if (user_event_reserve (1))
+        return -1;
+    slot = user_event_free[--user_event_numfree];
     Py_INCREF (obj);
-    userobj->next = user_event_objects;
-    userobj->object = obj;
-    user_event_objects = userobj;
-
-    return userobj;
+    user_event_objects[slot] = obj;
+    return slot;
 }
 
-/*note, we doublecheck to make sure the pointer is in our list,
- *not just some random pointer. this will keep us safe(r).
+/*note, we doublecheck to make sure the slot is one in use,
+ *not just some random number. this will keep us safe(r).
  */
 static PyObject*
-user_event_getobject (UserEventObject* userobj)
+user_event_getobject (void* data)
 {
-    PyObject* obj = NULL;
-    if (!user_event_objects) /*fail in most common case*/
+    intptr_t slot = (intptr_t) data;
+    PyObject* obj;
+
+    if (slot < 0 || slot >= user_event_size)
         return NULL;
-    if (user_event_objects == userobj)
-    {
-        obj = userobj->object;
-        user_event_objects = userobj->next;
-    }
-    else
+    obj = user_event_objects[slot];
+    if (obj)
     {
-        UserEventObject* hunt = user_event_objects;
-        while (hunt && hunt->next != userobj)
-            hunt = hunt->next;
-        if (hunt)
-        {
-            hunt->next = userobj->next;
-            obj = userobj->object;
-        }
+        user_event_objects[slot] = NULL;
+        user_event_free[user_event_numfree++] = (int) slot;
     }
-    if (obj)
-        PyMem_Del (userobj);
     return obj;
 }
 
 static void
 user_event_cleanup (void)
 {
+    int i;
+
     if (user_event_objects)
     {
-        UserEventObject *hunt, *kill;
-        hunt = user_event_objects;
-        while (hunt)
-        {
-            kill = hunt;
-            hunt = hunt->next;
-            Py_DECREF (kill->object);
-            PyMem_Del (kill);
-        }
+        for (i = 0; i < user_event_size; ++i)
+            Py_XDECREF (user_event_objects[i]);
+        PyMem_Del (user_event_objects);
+        PyMem_Del (user_event_free);
         user_event_objects = NULL;
+        user_event_free = NULL;
+        user_event_size = 0;
+        user_event_numfree = 0;
     }
 }
 
+static int event_make_dict (PyEventObject *e);
+
 static int PyEvent_FillUserEvent (PyEventObject *e, SDL_Event *event)
 {
-    UserEventObject *userobj = user_event_addobject (e->dict);
-    if (!userobj)
+    int slot;
+
+    if (event_make_dict (e))
+        return -1;
+    slot = user_event_addobject (e->dict);
+    if (slot < 0)
         return -1;
 
     event->type = e->type;
     event->user.code = USEROBJECT_CHECK1;
     event->user.data1 = (void*)USEROBJECT_CHECK2;
-    event->user.data2 = userobj;
+    event->user.data2 = (void*)(intptr_t)slot;
     return 0;
 }
 
@@ -242,44 +289,106 @@ our_empty_ustr (void)
 
 #endif /* Py_USING_UNICODE */
 
-static PyObject*
-dict_from_event (SDL_Event* event)
-{
-    PyObject *dict=NULL, *tuple, *obj;
-    int hx, hy;
+/* The attributes of SDL events, made from the SDL_Event when asked for */
+enum {
+    EVATTR_GAIN, EVATTR_STATE, EVATTR_UNICODE, EVATTR_KEY, EVATTR_MOD,
+    EVATTR_SCANCODE, EVATTR_POS, EVATTR_REL, EVATTR_BUTTONS, EVATTR_BUTTON,
+    EVATTR_JOY, EVATTR_AXIS, EVATTR_VALUE, EVATTR_BALL, EVATTR_HAT,
+    EVATTR_SIZE, EVATTR_W, EVATTR_H, EVATTR_COUNT
+};
 
-    /*check if it is an event the user posted*/
-    if (event->user.code == USEROBJECT_CHECK1
-        && event->user.data1 == (void*)USEROBJECT_CHECK2)
-    {
-        dict = user_event_getobject ((UserEventObject*)event->user.data2);
-        if (dict)
-            return dict;
-    }
+static char *event_attr_names[EVATTR_COUNT] = {
+    "gain", "state", "unicode", "key", "mod",
+    "scancode", "pos", "rel", "buttons", "button",
+    "joy", "axis", "value", "ball", "hat",
+    "size", "w", "h"
+};
 
-    if (!(dict = PyDict_New ()))
-        return NULL;
-    switch (event->type)
+/* The names above, interned, to match attribute lookups by identity */
+static PyObject *event_attr_strs[EVATTR_COUNT];
+
+/* The attributes of an event of type, ending in -1, or NULL if the dict
+ * of the event has to be made as soon as it arrives.
+ */
+static const int*
+event_attrs (int type)
+{
+    static const int active[] = {EVATTR_GAIN, EVATTR_STATE, -1};
+    static const int keydown[] = {EVATTR_UNICODE, EVATTR_KEY, EVATTR_MOD,
+                                  EVATTR_SCANCODE, -1};
+    static const int motion[] = {EVATTR_POS, EVATTR_REL, EVATTR_BUTTONS, -1};
+    static const int button[] = {EVATTR_POS, EVATTR_BUTTON, -1};
+    static const int jaxis[] = {EVATTR_JOY, EVATTR_AXIS, EVATTR_VALUE, -1};
+    static const int jball[] = {EVATTR_JOY, EVATTR_BALL, EVATTR_REL, -1};
+    static const int jhat[] = {EVATTR_JOY, EVATTR_HAT, EVATTR_VALUE, -1};
+    static const int jbutton[] = {EVATTR_JOY, EVATTR_BUTTON, -1};
+    static const int resize[] = {EVATTR_SIZE, EVATTR_W, EVATTR_H, -1};
+    static const int none[] = {-1};
+
+    switch (type)
     {
     case SDL_ACTIVEEVENT:
-        insobj (dict, "gain", PyInt_FromLong (event->active.gain));
-        insobj (dict, "state", PyInt_FromLong (event->active.state));
-        break;
+        return active;
     case SDL_KEYDOWN:
-        if (event->key.keysym.unicode)
-            insobj (dict, "unicode", our_unichr (event->key.keysym.unicode));
-        else
-            insobj (dict, "unicode", our_empty_ustr ());
+        return keydown;
     case SDL_KEYUP:
-        insobj (dict, "key", PyInt_FromLong (event->key.keysym.sym));
-        insobj (dict, "mod", PyInt_FromLong (event->key.keysym.mod));
-        insobj (dict, "scancode", PyInt_FromLong (event->key.keysym.scancode));
-        break;
+        return keydown + 1;
     case SDL_MOUSEMOTION:
-        obj = Py_BuildValue ("(ii)", event->motion.x, event->motion.y);
-        insobj (dict, "pos", obj);
-        obj = Py_BuildValue ("(ii)", event->motion.xrel, event->motion.yrel);
-        insobj (dict, "rel", obj);
+        return motion;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        return button;
+    case SDL_JOYAXISMOTION:
+        return jaxis;
+    case SDL_JOYBALLMOTION:
+        return jball;
+    case SDL_JOYHATMOTION:
+        return jhat;
+    case SDL_JOYBUTTONUP:
+    case SDL_JOYBUTTONDOWN:
+        return jbutton;
+    case SDL_VIDEORESIZE:
+        return resize;
+    case SDL_VIDEOEXPOSE:
+    case SDL_QUIT:
+        return none;
+    }
+    return NULL;
+}
+
+/* The value of attribute attr of event */
+static PyObject*
+event_attr_value (SDL_Event *event, int attr)
+{
+    PyObject *tuple;
+    int hx, hy;
+
+    switch (attr)
+    {
+    case EVATTR_GAIN:
+        return PyInt_FromLong (event->active.gain);
+    case EVATTR_STATE:
+        return PyInt_FromLong (event->active.state);
+    case EVATTR_UNICODE:
+        if (event->key.keysym.unicode)
+            return our_unichr (event->key.keysym.unicode);
+        return our_empty_ustr ();
+    case EVATTR_KEY:
+        return PyInt_FromLong (event->key.keysym.sym);
+    case EVATTR_MOD:
+        return PyInt_FromLong (event->key.keysym.mod);
+    case EVATTR_SCANCODE:
+        return PyInt_FromLong (event->key.keysym.scancode);
+    case EVATTR_POS:
+        if (event->type == SDL_MOUSEMOTION)
+            return Py_BuildValue ("(ii)", event->motion.x, event->motion.y);
+        return Py_BuildValue ("(ii)", event->button.x, event->button.y);
+    case EVATTR_REL:
+        if (event->type == SDL_MOUSEMOTION)
+            return Py_BuildValue ("(ii)", event->motion.xrel,
+                                  event->motion.yrel);
+        return Py_BuildValue ("(ii)", event->jball.xrel, event->jball.yrel);
+    case EVATTR_BUTTONS:
         if ((tuple = PyTuple_New (3)))
         {
             PyTuple_SET_ITEM
@@ -291,29 +400,28 @@ dict_from_event (SDL_Event* event)
             PyTuple_SET_ITEM
                 (tuple, 2,
                  PyInt_FromLong ((event->motion.state&SDL_BUTTON(3)) != 0));
-            insobj (dict, "buttons", tuple);
         }
-        break;
-    case SDL_MOUSEBUTTONDOWN:
-    case SDL_MOUSEBUTTONUP:
-        obj = Py_BuildValue ("(ii)", event->button.x, event->button.y);
-        insobj (dict, "pos", obj);
-        insobj (dict, "button", PyInt_FromLong (event->button.button));
-        break;
-    case SDL_JOYAXISMOTION:
-        insobj (dict, "joy", PyInt_FromLong (event->jaxis.which));
-        insobj (dict, "axis", PyInt_FromLong (event->jaxis.axis));
-        insobj (dict, "value", PyFloat_FromDouble (event->jaxis.value/32767.0));
-        break;
-    case SDL_JOYBALLMOTION:
-        insobj (dict, "joy", PyInt_FromLong (event->jball.which));
-        insobj (dict, "ball", PyInt_FromLong (event->jball.ball));
-        obj = Py_BuildValue ("(ii)", event->jball.xrel, event->jball.yrel);
-        insobj (dict, "rel", obj);
-        break;
-    case SDL_JOYHATMOTION:
-        insobj (dict, "joy", PyInt_FromLong (event->jhat.which));
-        insobj (dict, "hat", PyInt_FromLong (event->jhat.hat));
+        return tuple;
+    case EVATTR_BUTTON:
+        if (event->type == SDL_JOYBUTTONUP || event->type == SDL_JOYBUTTONDOWN)
+            return PyInt_FromLong (event->jbutton.button);
+        return PyInt_FromLong (event->button.button);
+    case EVATTR_JOY:
+        switch (event->type)
+        {
+        case SDL_JOYAXISMOTION:
+            return PyInt_FromLong (event->jaxis.which);
+        case SDL_JOYBALLMOTION:
+            return PyInt_FromLong (event->jball.which);
+        case SDL_JOYHATMOTION:
+            return PyInt_FromLong (event->jhat.which);
+        }
+        return PyInt_FromLong (event->jbutton.which);
+    case EVATTR_AXIS:
+        return PyInt_FromLong (event->jaxis.axis);
+    case EVATTR_VALUE:
+        if (event->type == SDL_JOYAXISMOTION)
+            return PyFloat_FromDouble (event->jaxis.value/32767.0);
         hx = hy = 0;
         if (event->jhat.value&SDL_HAT_UP)
             hy = 1;
@@ -323,20 +431,52 @@ dict_from_event (SDL_Event* event)
             hx = 1;
         else if (event->jhat.value&SDL_HAT_LEFT)
             hx = -1;
-        insobj (dict, "value", Py_BuildValue ("(ii)", hx, hy));
-        break;
-    case SDL_JOYBUTTONUP:
-    case SDL_JOYBUTTONDOWN:
-        insobj (dict, "joy", PyInt_FromLong (event->jbutton.which));
-        insobj (dict, "button", PyInt_FromLong (event->jbutton.button));
-        break;
-    case SDL_VIDEORESIZE:
-        obj = Py_BuildValue ("(ii)", event->resize.w, event->resize.h);
-        insobj (dict, "size", obj);
-        insobj (dict, "w", PyInt_FromLong (event->resize.w));
-        insobj (dict, "h", PyInt_FromLong (event->resize.h));
-        break;
-    case SDL_SYSWMEVENT:
+        return Py_BuildValue ("(ii)", hx, hy);
+    case EVATTR_BALL:
+        return PyInt_FromLong (event->jball.ball);
+    case EVATTR_HAT:
+        return PyInt_FromLong (event->jhat.hat);
+    case EVATTR_SIZE:
+        return Py_BuildValue ("(ii)", event->resize.w, event->resize.h);
+    case EVATTR_W:
+        return PyInt_FromLong (event->resize.w);
+    case EVATTR_H:
+        return PyInt_FromLong (event->resize.h);
+    }
+    return RAISE (PyExc_SystemError, "unknown event attribute");
+}
+
+static int
+event_is_posted_object (SDL_Event *event)
+{
+    return (event->user.code == USEROBJECT_CHECK1 &&
+            event->user.data1 == (void*)USEROBJECT_CHECK2);
+}
+
+static PyObject*
+dict_from_event (SDL_Event* event)
+{
+    PyObject *dict=NULL;
+    const int *attrs;
+
+    /*check if it is an event the user posted*/
+    if (event_is_posted_object (event))
+    {
+        dict = user_event_getobject (event->user.data2);
+        if (dict)
+            return dict;
+    }
+
+    if (!(dict = PyDict_New ()))
+        return NULL;
+    attrs = event_attrs (event->type);
+    for (; attrs && *attrs >= 0; ++attrs)
+    {
+        insobj (dict, event_attr_names[*attrs],
+                event_attr_value (event, *attrs));
+    }
+    if (event->type == SDL_SYSWMEVENT)
+    {
 #ifdef WIN32
         insobj (dict, "hwnd", PyInt_FromLong ((long)(event-> syswm.msg->hwnd)));
         insobj (dict, "msg", PyInt_FromLong (event-> syswm.msg->msg));
@@ -356,9 +496,6 @@ dict_from_event (SDL_Event* event)
                Bytes_FromStringAndSize
                 ((char*) & (event->syswm.msg->event.xevent), sizeof (XEvent)));
 #endif
-
-        break;
-/* SDL_VIDEOEXPOSE and SDL_QUIT have no attributes */
     }
     if (event->type == SDL_USEREVENT && event->user.code == 0x1000) {
         insobj (dict, "filename", Text_FromUTF8 (event->user.data1));
@@ -373,14 +510,88 @@ dict_from_event (SDL_Event* event)
 
 /* event object internals */
 
+/* Events kept for reuse, as input floods make and drop many */
+static PgFreeList event_freelist = PG_FREELIST_INIT (NULL);
+
+static PyEventObject*
+event_alloc (void)
+{
+    PyEventObject *e;
+
+    e = (PyEventObject *)PgFreeList_Pop (&event_freelist, &PyEvent_Type);
+    if (!e)
+        e = PyObject_NEW (PyEventObject, &PyEvent_Type);
+    return e;
+}
+
 static void
 event_dealloc (PyObject* self)
 {
     PyEventObject* e = (PyEventObject*)self;
-    Py_XDECREF (e->dict);
+    Py_CLEAR (e->dict);
+    if (PgFreeList_Push (&event_freelist, self))
+        return;
     PyObject_DEL (self);
 }
 
+/* Make the dict of an SDL event still without one. Returns 0, or -1 with
+ * an exception set.
+ */
+static int
+event_make_dict (PyEventObject *e)
+{
+    if (!e->dict)
+    {
+        e->dict = dict_from_event (&e->event);
+        if (!e->dict)
+            return -1;
+    }
+    return 0;
+}
+
+static PyObject*
+event_getattro (PyObject *self, PyObject *name)
+{
+    PyEventObject *e = (PyEventObject *)self;
+    PyObject *value;
+    const int *attrs;
+
+    if (!e->dict)
+    {
+        /* Answer the attributes of the SDL event straight from it, and
+           those of the type without them */
+        for (attrs = event_attrs (e->event.type); *attrs >= 0; ++attrs)
+        {
+            if (name == event_attr_strs[*attrs])
+                return event_attr_value (&e->event, *attrs);
+        }
+        value = PyObject_GenericGetAttr (self, name);
+        if (value || !PyErr_ExceptionMatches (PyExc_AttributeError))
+            return value;
+        PyErr_Clear ();
+        if (event_make_dict (e))
+            return NULL;
+    }
+    return PyObject_GenericGetAttr (self, name);
+}
+
+static int
+event_setattro (PyObject *self, PyObject *name, PyObject *value)
+{
+    if (event_make_dict ((PyEventObject *)self))
+        return -1;
+    return PyObject_GenericSetAttr (self, name, value);
+}
+
+static PyObject*
+event_get_dict (PyEventObject *self, void *closure)
+{
+    if (event_make_dict (self))
+        return NULL;
+    Py_INCREF (self->dict);
+    return self->dict;
+}
+
 PyObject*
 event_str (PyObject* self)
 {
@@ -394,6 +605,8 @@ event_str (PyObject* self)
     PyObject *encodedobj;
 #endif
 
+    if (event_make_dict (e))
+        return NULL;
     strobj = PyObject_Str (e->dict);
     if (strobj == NULL) {
         return NULL;
@@ -462,12 +675,16 @@ static PyNumberMethods event_as_number = {
 #define OFF(x) offsetof(PyEventObject, x)
 
 static PyMemberDef event_members[] = {
-    {"__dict__",  T_OBJECT, OFF(dict), READONLY},
     {"type",      T_INT,    OFF(type), READONLY},
-    {"dict",      T_OBJECT, OFF(dict), READONLY},
     {NULL}  /* Sentinel */
 };
 
+static PyGetSetDef event_getsets[] = {
+    {"__dict__", (getter)event_get_dict, NULL, NULL, NULL},
+    {"dict",     (getter)event_get_dict, NULL, NULL, NULL},
+    {NULL, NULL, NULL, NULL, NULL}  /* Sentinel */
+};
+
 /*
  * eventA == eventB
  * eventA != eventB
@@ -484,6 +701,8 @@ event_richcompare(PyObject *o1, PyObject *o2, int opid)
 
     e1 = (PyEventObject *) o1;
     e2 = (PyEventObject *) o2;
+    if (event_make_dict (e1) || event_make_dict (e2))
+        return NULL;
     switch (opid)
     {
     case Py_EQ:
@@ -524,8 +743,8 @@ static PyTypeObject PyEvent_Type =
     (hashfunc)NULL,                  /*hash*/
     (ternaryfunc)NULL,               /*call*/
     (reprfunc)NULL,                  /*str*/
-    PyObject_GenericGetAttr,         /* tp_getattro */
-    PyObject_GenericSetAttr,         /* tp_setattro */
+    event_getattro,                  /* tp_getattro */
+    event_setattro,                  /* tp_setattro */
     0,                               /* tp_as_buffer */
 #if PY3
     0,
@@ -541,7 +760,7 @@ static PyTypeObject PyEvent_Type =
     0,                               /* tp_iternext */
     0,                               /* tp_methods */
     event_members,                   /* tp_members */
-    0,                               /* tp_getset */
+    event_getsets,                   /* tp_getset */
     0,                               /* tp_base */
     0,                               /* tp_dict */
     0,                               /* tp_descr_get */
@@ -556,18 +775,24 @@ static PyObject*
 PyEvent_New (SDL_Event* event)
 {
     PyEventObject* e;
-    e = PyObject_NEW (PyEventObject, &PyEvent_Type);
+    e = event_alloc ();
     if(!e)
         return NULL;
 
     if (event)
     {
         e->type = event->type;
-        e->dict = dict_from_event (event);
+        /* The dict of an SDL event is made when it is first needed */
+        if (event_is_posted_object (event) || !event_attrs (event->type))
+            e->dict = dict_from_event (event);
+        else
+            e->dict = NULL;
+        e->event = *event;
     }
     else
     {
         e->type = SDL_NOEVENT;
+        e->event.type = SDL_NOEVENT;
         e->dict = PyDict_New ();
     }
     return (PyObject*)e;
@@ -577,10 +802,11 @@ static PyObject*
 PyEvent_New2 (int type, PyObject* dict)
 {
     PyEventObject* e;
-    e = PyObject_NEW (PyEventObject, &PyEvent_Type);
+    e = event_alloc ();
     if (e)
     {
         e->type = type;
+        e->event.type = SDL_NOEVENT;
         if (!dict)
             dict = PyDict_New ();
         else
@@ -740,14 +966,73 @@ event_clear (PyObject* self, PyObject* args)
     Py_RETURN_NONE;
 }
 
+/* Merge the motion events coalesce_mask selects, in place. An event
+ * replaces the last one of its kind, joystick and axis for JOYAXISMOTION,
+ * as long as no event of another type came between them; only the
+ * relative motion of MOUSEMOTION adds up. Returns the new count.
+ */
+static int
+PyEvent_Coalesce (SDL_Event *events, int count)
+{
+    SDL_Event *e, *last;
+    int in, out = 0, run = 0, i, rel;
+
+    if (!coalesce_mask)
+        return count;
+    for (in = 0; in < count; ++in)
+    {
+        e = events + in;
+        if (!(SDL_EVENTMASK (e->type) & coalesce_mask) ||
+            event_is_posted_object (e))
+        {
+            events[out++] = *e;
+            run = out;
+            continue;
+        }
+        for (i = run; i < out; ++i)
+        {
+            last = events + i;
+            if (last->type == e->type &&
+                (e->type != SDL_JOYAXISMOTION ||
+                 (last->jaxis.which == e->jaxis.which &&
+                  last->jaxis.axis == e->jaxis.axis)))
+                break;
+        }
+        if (i == out)
+        {
+            events[out++] = *e;
+            continue;
+        }
+        switch (e->type)
+        {
+        case SDL_MOUSEMOTION:
+            rel = last->motion.xrel + e->motion.xrel;
+            e->motion.xrel = (Sint16) MAX (MIN (rel, 32767), -32768);
+            rel = last->motion.yrel + e->motion.yrel;
+            e->motion.yrel = (Sint16) MAX (MIN (rel, 32767), -32768);
+            coalesce_merged[COALESCE_MOTION]++;
+            break;
+        case SDL_JOYAXISMOTION:
+            coalesce_merged[COALESCE_AXIS]++;
+            break;
+        default:
+            coalesce_merged[COALESCE_RESIZE]++;
+            break;
+        }
+        *last = *e;
+    }
+    return out;
+}
+
 static PyObject*
 event_get (PyObject* self, PyObject* args)
 {
-    SDL_Event event;
+    SDL_Event events[EVENT_PEEP_MAX];
     int mask = 0;
-    int loop, num;
+    int loop, num, got, count, i;
     PyObject* type, *list, *e;
     int val;
+    Uint64 start;
 
     if (PyTuple_Size (args) != 0 && PyTuple_Size (args) != 1)
         return RAISE (PyExc_ValueError, "get requires 0 or 1 argument");
@@ -782,21 +1067,224 @@ event_get (PyObject* self, PyObject* args)
     if (!list)
         return NULL;
 
+    PG_PERF_BEGIN (start);
     SDL_PumpEvents ();
 
-    while (SDL_PeepEvents (&event, 1, SDL_GETEVENT, mask) == 1)
+    do
     {
-        e = PyEvent_New (&event);
-        if (!e)
+        got = SDL_PeepEvents (events, EVENT_PEEP_MAX, SDL_GETEVENT, mask);
+        count = PyEvent_Coalesce (events, got > 0 ? got : 0);
+        for (i = 0; i < count; ++i)
         {
-            Py_DECREF (list);
-            return NULL;
+            e = PyEvent_New (events + i);
+            if (!e)
+            {
+                Py_DECREF (list);
+                return NULL;
+            }
+
+            PyList_Append (list, e);
+            Py_DECREF (e);
         }
+        PG_PERF_ADD (PG_PERF_EVENT_EVENTS, count);
+    } while (got == EVENT_PEEP_MAX);
+    PG_PERF_ADD (PG_PERF_EVENT_CALLS, 1);
+    PG_PERF_END (start, PG_PERF_EVENT_NS);
+    return list;
+}
 
-        PyList_Append (list, e);
-        Py_DECREF (e);
+/* One event of event.get_buffer, packed so many are read at once */
+typedef struct
+{
+    Uint32 type;
+    Uint32 ticks;       /* when fetched; SDL events carry no time */
+    Sint32 which;       /* joystick, or key scancode */
+    Sint32 code;        /* key, button, axis, ball, hat, gain, or user code */
+    Sint32 mod;         /* key modifiers, or mouse and active state */
+    Sint32 x;           /* position, hat x, or new width */
+    Sint32 y;           /* position, hat y, or new height */
+    Sint32 xrel;
+    Sint32 yrel;
+    Sint32 value;       /* axis value, hat value, or key unicode */
+} EventRecord;
+
+#define EVENT_RECORD_FORMAT "IIiiiiiiii"
+
+/* Fill rec from event, freeing what event still owns */
+static void
+event_fill_record (SDL_Event *event, Uint32 ticks, EventRecord *rec)
+{
+    memset (rec, 0, sizeof (EventRecord));
+    rec->type = event->type;
+    rec->ticks = ticks;
+    if (event_is_posted_object (event))
+    {
+        /* Its attributes are Python objects; only the type is kept */
+        Py_XDECREF (user_event_getobject (event->user.data2));
+        return;
+    }
+    switch (event->type)
+    {
+    case SDL_ACTIVEEVENT:
+        rec->code = event->active.gain;
+        rec->mod = event->active.state;
+        break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        rec->which = event->key.keysym.scancode;
+        rec->code = event->key.keysym.sym;
+        rec->mod = event->key.keysym.mod;
+        rec->value = event->key.keysym.unicode;
+        break;
+    case SDL_MOUSEMOTION:
+        rec->mod = event->motion.state;
+        rec->x = event->motion.x;
+        rec->y = event->motion.y;
+        rec->xrel = event->motion.xrel;
+        rec->yrel = event->motion.yrel;
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        rec->code = event->button.button;
+        rec->x = event->button.x;
+        rec->y = event->button.y;
+        break;
+    case SDL_JOYAXISMOTION:
+        rec->which = event->jaxis.which;
+        rec->code = event->jaxis.axis;
+        rec->value = event->jaxis.value;
+        break;
+    case SDL_JOYBALLMOTION:
+        rec->which = event->jball.which;
+        rec->code = event->jball.ball;
+        rec->xrel = event->jball.xrel;
+        rec->yrel = event->jball.yrel;
+        break;
+    case SDL_JOYHATMOTION:
+        rec->which = event->jhat.which;
+        rec->code = event->jhat.hat;
+        rec->value = event->jhat.value;
+        if (event->jhat.value&SDL_HAT_UP)
+            rec->y = 1;
+        else if (event->jhat.value&SDL_HAT_DOWN)
+            rec->y = -1;
+        if (event->jhat.value&SDL_HAT_RIGHT)
+            rec->x = 1;
+        else if (event->jhat.value&SDL_HAT_LEFT)
+            rec->x = -1;
+        break;
+    case SDL_JOYBUTTONUP:
+    case SDL_JOYBUTTONDOWN:
+        rec->which = event->jbutton.which;
+        rec->code = event->jbutton.button;
+        break;
+    case SDL_VIDEORESIZE:
+        rec->x = event->resize.w;
+        rec->y = event->resize.h;
+        break;
+    default:
+        if (event->type >= SDL_USEREVENT && event->type < SDL_NUMEVENTS)
+        {
+            rec->code = event->user.code;
+            if (event->type == SDL_USEREVENT && event->user.code == 0x1000)
+            {
+                free (event->user.data1);
+                event->user.data1 = NULL;
+            }
+        }
+        break;
     }
-    return list;
+}
+
+/* Take up to room events off the queue into buf, setting drained if the
+ * queue was emptied. Returns how many.
+ */
+static Py_ssize_t
+event_take_records (char *buf, Py_ssize_t room, int *drained)
+{
+    SDL_Event events[EVENT_PEEP_MAX];
+    EventRecord rec;
+    Uint32 ticks = SDL_GetTicks ();
+    Py_ssize_t count = 0;
+    int n, got, i;
+
+    *drained = 0;
+    while (count < room)
+    {
+        n = room - count > EVENT_PEEP_MAX ?
+            EVENT_PEEP_MAX : (int) (room - count);
+        got = SDL_PeepEvents (events, n, SDL_GETEVENT, SDL_ALLEVENTS);
+        if (got < n)
+            *drained = 1;
+        if (got <= 0)
+            break;
+        got = PyEvent_Coalesce (events, got);
+        for (i = 0; i < got; ++i)
+        {
+            /* buf need not be aligned */
+            event_fill_record (events + i, ticks, &rec);
+            memcpy (buf + (count + i) * sizeof (EventRecord), &rec,
+                    sizeof (EventRecord));
+        }
+        count += got;
+        if (*drained)
+            break;
+    }
+    return count;
+}
+
+static PyObject*
+event_get_buffer (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyObject *out = Py_None;
+    PyObject *records;
+    Pg_buffer pg_view;
+    Py_buffer *view_p = (Py_buffer *)&pg_view;
+    Py_ssize_t count, size;
+    int drained;
+    static char *kwids[] = {"out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|O", kwids, &out))
+        return NULL;
+
+    VIDEO_INIT_CHECK ();
+
+    SDL_PumpEvents ();
+    if (out != Py_None)
+    {
+        if (PgObject_GetBuffer (out, &pg_view, PyBUF_WRITABLE))
+            return NULL;
+        count = event_take_records ((char *)view_p->buf,
+                                    view_p->len / sizeof (EventRecord),
+                                    &drained);
+        PgBuffer_Release (&pg_view);
+        return PyInt_FromSsize_t (count);
+    }
+
+    records = PyByteArray_FromStringAndSize (NULL, 0);
+    if (!records)
+        return NULL;
+    size = 0;
+    do
+    {
+        if (PyByteArray_Resize (records,
+                                (size + EVENT_PEEP_MAX) *
+                                sizeof (EventRecord)))
+        {
+            Py_DECREF (records);
+            return NULL;
+        }
+        count = event_take_records (PyByteArray_AS_STRING (records) +
+                                    size * sizeof (EventRecord),
+                                    EVENT_PEEP_MAX, &drained);
+        size += count;
+    } while (!drained);
+    if (PyByteArray_Resize (records, size * sizeof (EventRecord)))
+    {
+        Py_DECREF (records);
+        return NULL;
+    }
+    return records;
 }
 
 static PyObject*
@@ -874,11 +1362,84 @@ event_post (PyObject* self, PyObject* args)
         return NULL;
 
     if (SDL_PushEvent (&event) == -1)
+    {
+        Py_XDECREF (user_event_getobject (event.user.data2));
         return RAISE (PyExc_SDLError, "Event queue full");
+    }
 
     Py_RETURN_NONE;
 }
 
+static PyObject*
+event_post_many (PyObject* self, PyObject* args)
+{
+    PyObject* seq;
+    PyObject* item;
+    PyEventObject* e;
+    SDL_Event* events;
+    Py_ssize_t len, i;
+    int count = 0, added, j;
+
+    if (!PyArg_ParseTuple (args, "O", &seq))
+        return NULL;
+
+    VIDEO_INIT_CHECK ();
+
+    seq = PySequence_Fast (seq, "post_many needs a sequence of Events");
+    if (!seq)
+        return NULL;
+    len = PySequence_Fast_GET_SIZE (seq);
+    for (i = 0; i < len; ++i)
+    {
+        if (!PyEvent_Check (PySequence_Fast_GET_ITEM (seq, i)))
+        {
+            Py_DECREF (seq);
+            return RAISE (PyExc_TypeError,
+                          "post_many needs a sequence of Events");
+        }
+    }
+    events = PyMem_New (SDL_Event, len ? len : 1);
+    if (!events)
+    {
+        Py_DECREF (seq);
+        return PyErr_NoMemory ();
+    }
+    if (user_event_reserve ((int) len))
+    {
+        PyMem_Del (events);
+        Py_DECREF (seq);
+        return NULL;
+    }
+
+    for (i = 0; i < len; ++i)
+    {
+        item = PySequence_Fast_GET_ITEM (seq, i);
+        e = (PyEventObject*) item;
+        /* blocked events are not posted, as with post() */
+        if (SDL_EventState (e->type, SDL_QUERY) == SDL_IGNORE)
+            continue;
+        if (PyEvent_FillUserEvent (e, events + count))
+        {
+            for (j = 0; j < count; ++j)
+                Py_XDECREF (user_event_getobject (events[j].user.data2));
+            PyMem_Del (events);
+            Py_DECREF (seq);
+            return NULL;
+        }
+        ++count;
+    }
+    Py_DECREF (seq);
+
+    /* One lock of the SDL queue for all of them */
+    added = count ? SDL_PeepEvents (events, count, SDL_ADDEVENT, 0) : 0;
+    if (added < 0)
+        added = 0;
+    for (j = added; j < count; ++j)
+        Py_XDECREF (user_event_getobject (events[j].user.data2));
+    PyMem_Del (events);
+    return PyInt_FromLong (added);
+}
+
 static int
 CheckEventInRange(int evt)
 {
@@ -1004,6 +1565,68 @@ get_blocked (PyObject* self, PyObject* args)
     return PyInt_FromLong (isblocked);
 }
 
+static PyObject*
+set_coalesce (PyObject* self, PyObject* args)
+{
+    PyObject *types = Py_None;
+    Uint32 mask = 0;
+    Py_ssize_t loop, num;
+    int val;
+
+    if (!PyArg_ParseTuple (args, "|O", &types))
+        return NULL;
+
+    if (types != Py_None)
+    {
+        if (!PySequence_Check (types))
+            return RAISE (PyExc_TypeError,
+                          "set_coalesce requires a sequence of event types");
+        num = PySequence_Size (types);
+        for (loop = 0; loop < num; ++loop)
+        {
+            if (!IntFromObjIndex (types, (int)loop, &val))
+                return RAISE (PyExc_TypeError,
+                              "type sequence must contain valid event types");
+            if (val < 0 || val >= SDL_NUMEVENTS ||
+                !(SDL_EVENTMASK (val) & COALESCE_TYPES))
+                return RAISE (PyExc_ValueError,
+                              "only MOUSEMOTION, JOYAXISMOTION and "
+                              "VIDEORESIZE events can be coalesced");
+            mask |= SDL_EVENTMASK (val);
+        }
+    }
+    coalesce_mask = mask;
+    memset (coalesce_merged, 0, sizeof (coalesce_merged));
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+get_coalesce_stats (PyObject* self)
+{
+    return Py_BuildValue ("{i:k,i:k,i:k}",
+                          SDL_MOUSEMOTION, coalesce_merged[COALESCE_MOTION],
+                          SDL_JOYAXISMOTION, coalesce_merged[COALESCE_AXIS],
+                          SDL_VIDEORESIZE, coalesce_merged[COALESCE_RESIZE]);
+}
+
+static PyObject*
+event_set_freelist_size (PyObject* self, PyObject* args)
+{
+    Py_ssize_t size;
+
+    if (!PyArg_ParseTuple (args, "n", &size))
+        return NULL;
+    if (PgFreeList_Resize (&event_freelist, size))
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+event_get_freelist_stats (PyObject* self)
+{
+    return PgFreeList_Stats (&event_freelist);
+}
+
 static PyMethodDef _event_methods[] =
 {
     { "Event", (PyCFunction)Event, 3, DOC_PYGAMEEVENTEVENT },
@@ -1017,20 +1640,36 @@ static PyMethodDef _event_methods[] =
     { "poll", (PyCFunction) pygame_poll, METH_NOARGS, DOC_PYGAMEEVENTPOLL },
     { "clear", event_clear, METH_VARARGS, DOC_PYGAMEEVENTCLEAR },
     { "get", event_get, METH_VARARGS, DOC_PYGAMEEVENTGET },
+    { "get_buffer", (PyCFunction) event_get_buffer,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEEVENTGETBUFFER },
     { "peek", event_peek, METH_VARARGS, DOC_PYGAMEEVENTPEEK },
     { "post", event_post, METH_VARARGS, DOC_PYGAMEEVENTPOST },
+    { "post_many", event_post_many, METH_VARARGS, DOC_PYGAMEEVENTPOSTMANY },
 
     { "set_allowed", set_allowed, METH_VARARGS, DOC_PYGAMEEVENTSETALLOWED },
     { "set_blocked", set_blocked, METH_VARARGS, DOC_PYGAMEEVENTSETBLOCKED },
     { "get_blocked", get_blocked, METH_VARARGS, DOC_PYGAMEEVENTGETBLOCKED },
+    { "set_coalesce", set_coalesce, METH_VARARGS,
+      DOC_PYGAMEEVENTSETCOALESCE },
+    { "get_coalesce_stats", (PyCFunction) get_coalesce_stats, METH_NOARGS,
+      DOC_PYGAMEEVENTGETCOALESCESTATS },
+
+    { "set_freelist_size", event_set_freelist_size, METH_VARARGS,
+      "set_freelist_size(size) -> None\n"
+      "set how many dead Events are kept for reuse" },
+    { "get_freelist_stats", (PyCFunction) event_get_freelist_stats,
+      METH_NOARGS,
+      "get_freelist_stats() -> (size, count, hits, misses)\n"
+      "get the state of the free list of Events" },
 
     { NULL, NULL, 0, NULL }
 };
 
 MODINIT_DEFINE (event)
 {
-    PyObject *module, *dict, *apiobj;
+    PyObject *module, *dict, *apiobj, *formatobj;
     int ecode;
+    int i;
     static void* c_api[PYGAMEAPI_EVENT_NUMSLOTS];
 
 #if PY3
@@ -1052,6 +1691,21 @@ MODINIT_DEFINE (event)
         MODINIT_ERROR;
     }
 
+    for (i = 0; i < EVATTR_COUNT; ++i) {
+        if (!event_attr_strs[i]) {
+#if PY3
+            event_attr_strs[i] =
+                PyUnicode_InternFromString (event_attr_names[i]);
+#else
+            event_attr_strs[i] =
+                PyString_InternFromString (event_attr_names[i]);
+#endif
+            if (!event_attr_strs[i]) {
+                MODINIT_ERROR;
+            }
+        }
+    }
+
     /* type preparation */
     if (PyType_Ready (&PyEvent_Type) < 0) {
         MODINIT_ERROR;
@@ -1070,12 +1724,24 @@ MODINIT_DEFINE (event)
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
+    formatobj = Text_FromUTF8 (EVENT_RECORD_FORMAT);
+    if (formatobj == NULL) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
+    ecode = PyDict_SetItemString (dict, "RECORD_FORMAT", formatobj);
+    Py_DECREF (formatobj);
+    if (ecode) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
 
     /* export the c api */
     c_api[0] = &PyEvent_Type;
     c_api[1] = PyEvent_New;
     c_api[2] = PyEvent_New2;
     c_api[3] = PyEvent_FillUserEvent;
+    c_api[4] = PyEvent_Coalesce;
     apiobj = encapsulate_api (c_api, "event");
     if (apiobj == NULL) {
         DECREF_MOD (module);
@@ -1093,6 +1759,10 @@ MODINIT_DEFINE (event)
      */
     if (user_event_objects == NULL) {
         PyGame_RegisterQuit (user_event_cleanup);
+        if (user_event_reserve (USEROBJECT_PREALLOC)) {
+            DECREF_MOD (module);
+            MODINIT_ERROR;
+        }
     }
     MODINIT_RETURN (module);
 }
@@ -29,6 +29,8 @@
 #include "fastevents.h"
 
 static int FE_WasInit = 0;
+/* Events fastevent.get takes from the queues at a time */
+#define FASTEVENT_GET_COUNT 64
 
 #define FE_INIT_CHECK()                                                 \
     do                                                                  \
@@ -159,13 +161,15 @@ fastevent_poll (PyObject * self)
 /* DOC */ static char doc_get[] =
 /* DOC */ "pygame.fastevent.get() -> list of Events\n"
 /* DOC */ "get all events from the queue\n"
+/* DOC */ "\n"
+/* DOC */ "Events are merged as pygame.event.set_coalesce() asks.\n"
 /* DOC */ ;
 static PyObject *
 fastevent_get (PyObject * self)
 {
-    SDL_Event event;
+    SDL_Event events[FASTEVENT_GET_COUNT];
     PyObject  *list, *e;
-    int       status;
+    int       got, count, i;
 
     FE_INIT_CHECK ();
 
@@ -175,21 +179,23 @@ fastevent_get (PyObject * self)
 
     FE_PumpEvents ();
 
-    while (1)
+    do
     {
-        status = FE_PollEvent (&event);
-        if (status != 1)
-            break;
-        e = PyEvent_New (&event);
-        if (!e)
+        got = FE_PollEvents (events, FASTEVENT_GET_COUNT);
+        count = PyEvent_Coalesce (events, got > 0 ? got : 0);
+        for (i = 0; i < count; i++)
         {
-            Py_DECREF (list);
-            return NULL;
-        }
+            e = PyEvent_New (events + i);
+            if (!e)
+            {
+                Py_DECREF (list);
+                return NULL;
+            }
 
-        PyList_Append (list, e);
-        Py_DECREF (e);
-    }
+            PyList_Append (list, e);
+            Py_DECREF (e);
+        }
+    } while (got == FASTEVENT_GET_COUNT);
 
     return list;
 }
@@ -205,6 +211,10 @@ fastevent_get (PyObject * self)
 /*DOC*/ "the standard MOUSEBUTTONDOWN attributes to be available, like\n"
 /*DOC*/ "'pos' and 'button'.\n"
 /*DOC*/ "\n"
+/*DOC*/ "Posted events go on the same queue as pygame.event.post()\n"
+/*DOC*/ "puts them, and a pygame.fastevent.wait() in another thread\n"
+/*DOC*/ "wakes as soon as one is posted.\n"
+/*DOC*/ "\n"
 /*DOC*/ "Because pygame.fastevent.post() may have to wait for the queue\n"
 /*DOC*/ "to empty, you can get into a dead lock if you try to append an\n"
 /*DOC*/ "event on to a full queue from the thread that processes events.\n"
@@ -302,7 +312,8 @@ MODINIT_DEFINE (fastevent)
     eventmodule = PyImport_ImportModule (IMPPREFIX "event");
     if (eventmodule)
     {
-        char *NAMES[] = {"Event", "event_name", NULL};
+        char *NAMES[] = {"Event", "event_name", "set_coalesce",
+                         "get_coalesce_stats", NULL};
         int  i;
 
         for (i = 0; NAMES[i]; i++)
@@ -53,31 +53,126 @@ FE_GetError ()
 
 //----------------------------------------
 //
-//Threads, mutexs, thread utils, and
-// thread safe wrappers
+//Pushed events go straight onto SDL's queue, so pygame.event sees them
+//too. SDL's queue takes its own lock, and FE_PushEvents adds a whole
+//batch under one taking of it. Instead of a timer waking everybody now
+//and then, a push wakes a waiting reader and a read wakes waiting
+//producers through semaphores.
 //
 
-static SDL_mutex *eventLock = NULL;
-static SDL_cond *eventWait = NULL;
-static SDL_TimerID eventTimer = 0;
+#define FE_WAIT_TICKS 10        // how often a wait looks at SDL's queue
+#define FE_PUSH_COUNT 64        // most events added to SDL's queue at once
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define FE_CAS(p, old, new) \
+    (InterlockedCompareExchange ((volatile LONG *) (p), (LONG) (new), \
+                                 (LONG) (old)) == (LONG) (old))
+#define FE_BARRIER() MemoryBarrier ()
+#elif defined(__GNUC__)
+#define FE_CAS(p, old, new) __sync_bool_compare_and_swap ((p), (old), (new))
+#define FE_BARRIER() __sync_synchronize ()
+#else
+//No atomics known here; a mutex makes the swaps and barriers instead
+static SDL_mutex *casLock = NULL;
+
+static int
+fe_cas (volatile Uint32 *p, Uint32 old, Uint32 new)
+{
+    int swapped;
+
+    SDL_LockMutex (casLock);
+    swapped = *p == old;
+    if (swapped)
+        *p = new;
+    SDL_UnlockMutex (casLock);
+    return swapped;
+}
+
+#define FE_USE_CAS_LOCK 1
+#define FE_CAS(p, old, new) fe_cas ((p), (old), (new))
+#define FE_BARRIER() (SDL_LockMutex (casLock), SDL_UnlockMutex (casLock))
+#endif
+
+//Set by a waiting reader, and cleared by the producer that wakes it
+static volatile Uint32 readerWaiting = 0;
+static SDL_sem *readerWake = NULL;
+//Producers waiting for room, woken as the reader takes events
+static volatile Uint32 writersWaiting = 0;
+static SDL_sem *writerWake = NULL;
+
+static void
+atomicAdd (volatile Uint32 *p, Uint32 delta)
+{
+    Uint32 old;
+
+    do
+        old = *p;
+    while (!FE_CAS (p, old, old + delta));
+}
+
+static void
+wakeReader (void)
+{
+    FE_BARRIER ();
+    if (readerWaiting && FE_CAS (&readerWaiting, 1, 0))
+        SDL_SemPost (readerWake);
+}
+
+static void
+wakeWriters (void)
+{
+    FE_BARRIER ();
+    if (writersWaiting)
+        SDL_SemPost (writerWake);
+}
+
+//Add up to count events to SDL's queue; returns how many went on, or -1
+static int
+queueAdd (SDL_Event * events, int count)
+{
+    if (count > FE_PUSH_COUNT)
+        count = FE_PUSH_COUNT;
+    return SDL_PeepEvents (events, count, SDL_ADDEVENT, 0);
+}
 
 //----------------------------------------
 //
-//
+//Push count events, waiting while SDL's queue is full
 //
 
 int
-FE_PushEvent (SDL_Event * ev)
+FE_PushEvents (SDL_Event * events, int count)
 {
-    SDL_LockMutex (eventLock);
-    while (-1 == SDL_PushEvent (ev))
-        SDL_CondWait (eventWait, eventLock);
-    SDL_CondSignal (eventWait);
-    SDL_UnlockMutex (eventLock);
+    int added;
 
+    while (count > 0)
+    {
+        added = queueAdd (events, count);
+        while (added <= 0)
+        {
+            //Full: wait for the reader to take some, looking again now
+            //and then, since pygame.event takes events without a wakeup
+            atomicAdd (&writersWaiting, 1);
+            wakeReader ();
+            added = queueAdd (events, count);
+            if (added <= 0)
+                SDL_SemWaitTimeout (writerWake, FE_WAIT_TICKS);
+            atomicAdd (&writersWaiting, (Uint32) -1);
+        }
+        events += added;
+        count -= added;
+        wakeReader ();
+    }
     return 1;
 }
 
+int
+FE_PushEvent (SDL_Event * ev)
+{
+    return FE_PushEvents (ev, 1);
+}
+
 //----------------------------------------
 //
 //
@@ -86,61 +181,66 @@ FE_PushEvent (SDL_Event * ev)
 void
 FE_PumpEvents ()
 {
-    SDL_LockMutex (eventLock);
     SDL_PumpEvents ();
-    SDL_UnlockMutex (eventLock);
 }
 
 //----------------------------------------
 //
-//
+//Take up to count events without pumping SDL's queue
 //
 
 int
-FE_PollEvent (SDL_Event * event)
+FE_PollEvents (SDL_Event * events, int count)
 {
-    int val = 0;
-
-    SDL_LockMutex (eventLock);
-    val = SDL_PollEvent (event);
-    if (0 < val)
-        SDL_CondSignal (eventWait);
-    SDL_UnlockMutex (eventLock);
-
-    return val;
+    int taken;
+
+    taken = SDL_PeepEvents (events, count, SDL_GETEVENT, SDL_ALLEVENTS);
+    if (taken < 0)
+        taken = 0;
+    if (taken)
+        wakeWriters ();
+    return taken;
 }
 
 //----------------------------------------
 //
-//Replacement for SDL_WaitEvent
+//
 //
 
 int
-FE_WaitEvent (SDL_Event * event)
+FE_PollEvent (SDL_Event * event)
 {
-    int val = 0;
-
-    SDL_LockMutex (eventLock);
-    while (0 >= (val = SDL_PollEvent (event)))
-        SDL_CondWait (eventWait, eventLock);
-    SDL_CondSignal (eventWait);
-    SDL_UnlockMutex (eventLock);
-
-    return val;
+    if (SDL_PollEvent (event) > 0)
+    {
+        wakeWriters ();
+        return 1;
+    }
+    return 0;
 }
 
 //----------------------------------------
 //
-//
+//Replacement for SDL_WaitEvent. A push wakes the wait at once; SDL's
+//own events, which come with no notice, are looked for every
+//FE_WAIT_TICKS.
 //
 
-static Uint32
-timerCallback (Uint32 interval, void *param)
+int
+FE_WaitEvent (SDL_Event * event)
 {
-    SDL_LockMutex (eventLock);
-    SDL_CondBroadcast (eventWait);
-    SDL_UnlockMutex (eventLock);
-    return interval;
+    while (!FE_PollEvent (event))
+    {
+        readerWaiting = 1;
+        FE_BARRIER ();
+        if (FE_PollEvents (event, 1))
+        {
+            FE_CAS (&readerWaiting, 1, 0);
+            return 1;
+        }
+        SDL_SemWaitTimeout (readerWake, FE_WAIT_TICKS);
+        FE_CAS (&readerWaiting, 1, 0);
+    }
+    return 1;
 }
 
 //----------------------------------------
@@ -154,24 +254,23 @@ FE_Init ()
     if (0 == (SDL_INIT_TIMER & SDL_WasInit (SDL_INIT_TIMER)))
         SDL_InitSubSystem (SDL_INIT_TIMER);
 
-    eventLock = SDL_CreateMutex ();
-    if (NULL == eventLock)
+#if defined(FE_USE_CAS_LOCK)
+    casLock = SDL_CreateMutex ();
+    if (NULL == casLock)
     {
         setError ("FE: can't create a mutex");
         return -1;
     }
+#endif
 
-    eventWait = SDL_CreateCond ();
-    if (NULL == eventWait)
-    {
-        setError ("FE: can't create a condition variable");
-        return -1;
-    }
+    readerWaiting = writersWaiting = 0;
 
-    eventTimer = SDL_AddTimer (10, timerCallback, NULL);
-    if (NULL == eventTimer)
+    readerWake = SDL_CreateSemaphore (0);
+    writerWake = SDL_CreateSemaphore (0);
+    if (NULL == readerWake || NULL == writerWake)
     {
-        setError ("FE: can't add a timer");
+        setError ("FE: can't create a semaphore");
+        FE_Quit ();
         return -1;
     }
 
@@ -186,11 +285,15 @@ FE_Init ()
 void
 FE_Quit ()
 {
-    SDL_DestroyMutex (eventLock);
-    eventLock = NULL;
-
-    SDL_DestroyCond (eventWait);
-    eventWait = NULL;
-
-    SDL_RemoveTimer (eventTimer);
+    if (readerWake)
+        SDL_DestroySemaphore (readerWake);
+    readerWake = NULL;
+    if (writerWake)
+        SDL_DestroySemaphore (writerWake);
+    writerWake = NULL;
+
+#if defined(FE_USE_CAS_LOCK)
+    SDL_DestroyMutex (casLock);
+    casLock = NULL;
+#endif
 }
@@ -39,6 +39,8 @@ extern "C" {
   int FE_PollEvent(SDL_Event *event);    // replacement for SDL_PollEvent
   int FE_WaitEvent(SDL_Event *event);    // replacement for SDL_WaitEvent
   int FE_PushEvent(SDL_Event *event);    // replacement for SDL_PushEvent
+  int FE_PollEvents(SDL_Event *events, int count); // take many at once
+  int FE_PushEvents(SDL_Event *events, int count); // push many at once
 
   char *FE_GetError(void);               // get the last error
 #ifdef __cplusplus
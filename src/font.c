@@ -57,6 +57,27 @@
 #define IS_UCS_2(c) 1
 #endif
 
+/* A TTF_Font is used by one thread at a time. Font.render draws without
+ * the GIL, holding the font lock, so the other methods going through the
+ * glyph cache of the font take the lock too.
+ */
+#define FONT_LOCK(o)                                    \
+    do { if ((o)->lock) SDL_mutexP ((o)->lock); } while (0)
+#define FONT_UNLOCK(o)                                  \
+    do { if ((o)->lock) SDL_mutexV ((o)->lock); } while (0)
+
+/* A surface from Font.render, kept for the same arguments */
+typedef struct fontrenderentry_ {
+    PyObject *text;         /* NULL for an unused entry */
+    long hash;
+    int antialias;
+    SDL_Color foreg;
+    int has_backg;
+    SDL_Color backg;
+    PyObject *surface;
+    unsigned long last_use;
+} FontRenderEntry;
+
 static PyTypeObject PyFont_Type;
 static PyObject* PyFont_New (TTF_Font*);
 #define PyFont_Check(x) ((x)->ob_type == &PyFont_Type)
@@ -203,6 +224,153 @@ get_init (PyObject* self)
 }
 
 /* font object methods */
+static void
+font_clear_render_cache (PyFontObject *self)
+{
+    int i;
+
+    for (i = 0; i < self->render_cache_size; ++i)
+    {
+        Py_CLEAR (self->render_cache[i].text);
+        Py_CLEAR (self->render_cache[i].surface);
+    }
+    self->render_cache_count = 0;
+}
+
+static int
+font_same_color (const SDL_Color *a, const SDL_Color *b)
+{
+    return a->r == b->r && a->g == b->g && a->b == b->b;
+}
+
+/* The surface kept for these render arguments, or NULL */
+static PyObject*
+font_find_render (PyFontObject *self, PyObject *text, long hash, int aa,
+                  const SDL_Color *foreg, int has_backg,
+                  const SDL_Color *backg)
+{
+    FontRenderEntry *entry;
+    int i, same;
+
+    for (i = 0; i < self->render_cache_size; ++i)
+    {
+        entry = self->render_cache + i;
+        if (!entry->text || entry->hash != hash ||
+            Py_TYPE (entry->text) != Py_TYPE (text) ||
+            entry->antialias != aa || entry->has_backg != has_backg ||
+            !font_same_color (&entry->foreg, foreg) ||
+            (has_backg && !font_same_color (&entry->backg, backg)))
+            continue;
+        same = PyObject_RichCompareBool (entry->text, text, Py_EQ);
+        if (same == -1)
+        {
+            PyErr_Clear ();
+            continue;
+        }
+        if (same)
+        {
+            entry->last_use = ++self->render_cache_clock;
+            self->render_cache_hits++;
+            return entry->surface;
+        }
+    }
+    self->render_cache_misses++;
+    return NULL;
+}
+
+/* Keep surface for these render arguments, in place of the entry least
+ * recently used when the cache is full.
+ */
+static void
+font_keep_render (PyFontObject *self, PyObject *text, long hash, int aa,
+                  const SDL_Color *foreg, int has_backg,
+                  const SDL_Color *backg, PyObject *surface)
+{
+    FontRenderEntry *entry = self->render_cache;
+    int i;
+
+    for (i = 0; i < self->render_cache_size; ++i)
+    {
+        if (!self->render_cache[i].text)
+        {
+            entry = self->render_cache + i;
+            self->render_cache_count++;
+            break;
+        }
+        if (self->render_cache[i].last_use < entry->last_use)
+            entry = self->render_cache + i;
+    }
+    Py_XDECREF (entry->text);
+    Py_XDECREF (entry->surface);
+    Py_INCREF (text);
+    Py_INCREF (surface);
+    entry->text = text;
+    entry->hash = hash;
+    entry->antialias = aa;
+    entry->foreg = *foreg;
+    entry->has_backg = has_backg;
+    entry->backg = *backg;
+    entry->surface = surface;
+    entry->last_use = ++self->render_cache_clock;
+}
+
+/* TTF_SetFontStyle, dropping the renders kept in the old style */
+static void
+font_set_style (PyFontObject *self, int style)
+{
+    if (style == TTF_GetFontStyle (self->font))
+        return;
+    font_clear_render_cache (self);
+    FONT_LOCK (self);
+    TTF_SetFontStyle (self->font, style);
+    FONT_UNLOCK (self);
+}
+
+static SDL_Surface*
+font_ttf_render (TTF_Font *font, const char *astring, int utf8, int aa,
+                 int has_backg, SDL_Color foreg, SDL_Color backg)
+{
+    if (utf8)
+    {
+        if (!aa)
+            return TTF_RenderUTF8_Solid (font, astring, foreg);
+        if (has_backg)
+            return TTF_RenderUTF8_Shaded (font, astring, foreg, backg);
+        return TTF_RenderUTF8_Blended (font, astring, foreg);
+    }
+    if (!aa)
+        return TTF_RenderText_Solid (font, astring, foreg);
+    if (has_backg)
+        return TTF_RenderText_Shaded (font, astring, foreg, backg);
+    return TTF_RenderText_Blended (font, astring, foreg);
+}
+
+/* Render astring, UTF-8 or Latin-1, with the GIL released */
+static SDL_Surface*
+font_render_text (PyFontObject *self, const char *astring, int utf8, int aa,
+                  int has_backg, SDL_Color foreg, SDL_Color backg)
+{
+    TTF_Font *font = self->font;
+    SDL_Surface *surf;
+
+    if (!self->lock)
+        self->lock = SDL_CreateMutex ();
+    if (!self->lock)
+    {
+        /* Nothing keeps other threads off the font */
+        return font_ttf_render (font, astring, utf8, aa, has_backg,
+                                foreg, backg);
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_mutexP (self->lock);
+    surf = font_ttf_render (font, astring, utf8, aa, has_backg,
+                            foreg, backg);
+    SDL_mutexV (self->lock);
+    Py_END_ALLOW_THREADS;
+    return surf;
+}
+
 static PyObject*
 font_get_height (PyObject* self)
 {
@@ -252,7 +420,7 @@ font_set_bold (PyObject* self, PyObject* args)
         style |= TTF_STYLE_BOLD;
     else
         style &= ~TTF_STYLE_BOLD;
-    TTF_SetFontStyle (font, style);
+    font_set_style ((PyFontObject*) self, style);
 
     Py_RETURN_NONE;
 }
@@ -278,7 +446,7 @@ font_set_italic (PyObject* self, PyObject* args)
         style |= TTF_STYLE_ITALIC;
     else
         style &= ~TTF_STYLE_ITALIC;
-    TTF_SetFontStyle (font, style);
+    font_set_style ((PyFontObject*) self, style);
 
     Py_RETURN_NONE;
 }
@@ -305,7 +473,7 @@ font_set_underline (PyObject* self, PyObject* args)
         style |= TTF_STYLE_UNDERLINE;
     else
         style &= ~TTF_STYLE_UNDERLINE;
-    TTF_SetFontStyle (font, style);
+    font_set_style ((PyFontObject*) self, style);
 
     Py_RETURN_NONE;
 }
@@ -313,6 +481,7 @@ font_set_underline (PyObject* self, PyObject* args)
 static PyObject*
 font_render(PyObject* self, PyObject* args)
 {
+    PyFontObject *fontobj = (PyFontObject *) self;
     TTF_Font* font = PyFont_AsFont (self);
     int aa;
     PyObject* text, *final;
@@ -321,6 +490,8 @@ font_render(PyObject* self, PyObject* args)
     SDL_Surface* surf;
     SDL_Color foreg, backg;
     int just_return;
+    int cache = 0;
+    long hash = 0;
 
     if (!PyArg_ParseTuple(args, "OiO|O", &text, &aa, &fg_rgba_obj,
                           &bg_rgba_obj)) {
@@ -357,6 +528,21 @@ font_render(PyObject* self, PyObject* args)
         backg.unused = 0;
     }
 
+    if (fontobj->render_cache &&
+        (PyUnicode_Check(text) || Bytes_Check(text))) {
+        hash = PyObject_Hash(text);
+        if (hash == -1) {
+            return NULL;
+        }
+        final = font_find_render(fontobj, text, hash, aa, &foreg,
+                                 bg_rgba_obj != NULL, &backg);
+        if (final) {
+            Py_INCREF(final);
+            return final;
+        }
+        cache = 1;
+    }
+
     just_return = PyObject_Not(text);
     if (just_return) {
         int height = TTF_FontHeight(font);
@@ -398,17 +584,8 @@ font_render(PyObject* self, PyObject* args)
                          "A Unicode character above '\\uFFFF' was found;"
                          " not supported");
         }
-        if (aa) {
-            if (bg_rgba_obj == NULL) {
-                surf = TTF_RenderUTF8_Blended(font, astring, foreg);
-            }
-            else {
-                surf = TTF_RenderUTF8_Shaded(font, astring, foreg, backg);
-            }
-        }
-        else {
-            surf = TTF_RenderUTF8_Solid(font, astring, foreg);
-        }
+        surf = font_render_text(fontobj, astring, 1, aa,
+                                bg_rgba_obj != NULL, foreg, backg);
         Py_DECREF(bytes);
     }
     else if (Bytes_Check(text)) {
@@ -418,17 +595,8 @@ font_render(PyObject* self, PyObject* args)
             return RAISE(PyExc_ValueError,
                          "A null character was found in the text");
         }
-        if (aa) {
-            if (bg_rgba_obj == NULL) {
-                surf = TTF_RenderText_Blended(font, astring, foreg);
-            }
-            else {
-                surf = TTF_RenderText_Shaded(font, astring, foreg, backg);
-            }
-        }
-        else {
-            surf = TTF_RenderText_Solid(font, astring, foreg);
-        }
+        surf = font_render_text(fontobj, astring, 0, aa,
+                                bg_rgba_obj != NULL, foreg, backg);
     }
     else {
         return RAISE_TEXT_TYPE_ERROR();
@@ -447,6 +615,10 @@ font_render(PyObject* self, PyObject* args)
     if (final == NULL) {
         SDL_FreeSurface(surf);
     }
+    else if (cache) {
+        font_keep_render(fontobj, text, hash, aa, &foreg,
+                         bg_rgba_obj != NULL, &backg, final);
+    }
     return final;
 }
 
@@ -471,15 +643,22 @@ font_size(PyObject* self, PyObject* args)
             return NULL;
         }
         string = Bytes_AS_STRING(bytes);
+        FONT_LOCK((PyFontObject *) self);
         ecode = TTF_SizeUTF8(font, string, &w, &h);
+        FONT_UNLOCK((PyFontObject *) self);
         Py_DECREF(bytes);
         if (ecode) {
             return RAISE (PyExc_SDLError, TTF_GetError());
         }
     }
     else if (Bytes_Check(text)) {
+        int ecode;
+
         string = Bytes_AS_STRING(text);
-        if (TTF_SizeText(font, string, &w, &h)) {
+        FONT_LOCK((PyFontObject *) self);
+        ecode = TTF_SizeText(font, string, &w, &h);
+        FONT_UNLOCK((PyFontObject *) self);
+        if (ecode) {
             return RAISE (PyExc_SDLError, TTF_GetError());
         }
     }
@@ -506,6 +685,7 @@ font_metrics(PyObject* self, PyObject* args)
     PyObject *listitem;
     Py_UNICODE *buffer;
     Py_UNICODE ch;
+    int ecode;
 
     if (!PyArg_ParseTuple(args, "O", &textobj)) {
         return NULL;
@@ -538,9 +718,14 @@ font_metrics(PyObject* self, PyObject* args)
          * TTF_GlyphMetrics() seems to return a value for any character,
          * using the default invalid character, if the char is not found.
          */
-        if (IS_UCS_2(ch) &&  /* conditional and */
-            !TTF_GlyphMetrics(font, (Uint16) ch, &minx,
-                              &maxx, &miny, &maxy, &advance)) {
+        ecode = -1;
+        if (IS_UCS_2(ch)) {
+            FONT_LOCK((PyFontObject *) self);
+            ecode = TTF_GlyphMetrics(font, (Uint16) ch, &minx,
+                                     &maxx, &miny, &maxy, &advance);
+            FONT_UNLOCK((PyFontObject *) self);
+        }
+        if (!ecode) {
             listitem = Py_BuildValue("(iiiii)",
                                      minx, maxx, miny, maxy, advance);
             if (!listitem) {
@@ -560,6 +745,45 @@ font_metrics(PyObject* self, PyObject* args)
     return list;
 }
 
+static PyObject*
+font_set_render_cache (PyObject* self, PyObject* args)
+{
+    PyFontObject *fontobj = (PyFontObject *) self;
+    FontRenderEntry *entries = NULL;
+    int size;
+
+    if (!PyArg_ParseTuple (args, "i", &size))
+        return NULL;
+    if (size < 0)
+        return RAISE (PyExc_ValueError,
+                      "render cache size must not be negative");
+
+    if (size > 0)
+    {
+        entries = PyMem_New (FontRenderEntry, size);
+        if (!entries)
+            return PyErr_NoMemory ();
+        memset (entries, 0, sizeof (FontRenderEntry) * size);
+    }
+    font_clear_render_cache (fontobj);
+    PyMem_Del (fontobj->render_cache);
+    fontobj->render_cache = entries;
+    fontobj->render_cache_size = size;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+font_get_render_cache_stats (PyObject* self)
+{
+    PyFontObject *fontobj = (PyFontObject *) self;
+
+    return Py_BuildValue ("(iikk)", fontobj->render_cache_size,
+                          fontobj->render_cache_count,
+                          fontobj->render_cache_hits,
+                          fontobj->render_cache_misses);
+}
+
 static PyMethodDef font_methods[] =
 {
     { "get_height", (PyCFunction) font_get_height, METH_NOARGS,
@@ -584,6 +808,10 @@ static PyMethodDef font_methods[] =
     { "metrics", font_metrics, METH_VARARGS, DOC_FONTMETRICS },
     { "render", font_render, METH_VARARGS, DOC_FONTRENDER },
     { "size", font_size, METH_VARARGS, DOC_FONTSIZE },
+    { "set_render_cache", font_set_render_cache, METH_VARARGS,
+      DOC_FONTSETRENDERCACHE },
+    { "get_render_cache_stats", (PyCFunction) font_get_render_cache_stats,
+      METH_NOARGS, DOC_FONTGETRENDERCACHESTATS },
 
     { NULL, NULL, 0, NULL }
 };
@@ -596,6 +824,10 @@ font_dealloc (PyFontObject* self)
 
     if (font && font_initialized)
         TTF_CloseFont (font);
+    font_clear_render_cache (self);
+    PyMem_Del (self->render_cache);
+    if (self->lock)
+        SDL_DestroyMutex (self->lock);
 
     if (self->weakreflist)
         PyObject_ClearWeakRefs ((PyObject*) self);
@@ -611,6 +843,7 @@ font_init(PyFontObject *self, PyObject *args, PyObject *kwds)
     PyObject *oencoded;
 
     self->font = NULL;
+    font_clear_render_cache(self);
     if (!PyArg_ParseTuple(args, "Oi", &obj, &fontsize)) {
         return -1;
     }
@@ -691,10 +924,22 @@ font_init(PyFontObject *self, PyObject *args, PyObject *kwds)
             }
         }
         if (Bytes_Check(obj)) {
+#if FONT_HAVE_RWOPS
+            SDL_RWops *rw;
+
+            fclose(test);
+            Py_BEGIN_ALLOW_THREADS;
+            rw = RWopsFromFileName(filename);
+            if (rw != NULL) {
+                font = TTF_OpenFontIndexRW(rw, 1, fontsize, 0);
+            }
+            Py_END_ALLOW_THREADS;
+#else
             fclose(test);
             Py_BEGIN_ALLOW_THREADS;
             font = TTF_OpenFont(filename, fontsize);
             Py_END_ALLOW_THREADS;
+#endif
         }
     }
     if (font == NULL)  {
@@ -36,10 +36,19 @@
 
 #define PYGAMEAPI_FONT_FIRSTSLOT 0
 #define PYGAMEAPI_FONT_NUMSLOTS 3
+struct fontrenderentry_;
+
 typedef struct {
   PyObject_HEAD
   TTF_Font* font;
   PyObject* weakreflist;
+  SDL_mutex* lock;      /* held by a thread using font without the GIL */
+  struct fontrenderentry_* render_cache;    /* NULL when not caching */
+  int render_cache_size;
+  int render_cache_count;
+  unsigned long render_cache_clock;
+  unsigned long render_cache_hits;
+  unsigned long render_cache_misses;
 } PyFontObject;
 #define PyFont_AsFont(x) (((PyFontObject*)x)->font)
 
@@ -67,6 +67,7 @@
 #define FT_RFLAG_ORIGIN                (1 << 7)
 #define FT_RFLAG_UCS4                  (1 << 8)
 #define FT_RFLAG_USE_BITMAP_STRIKES    (1 << 9)
+#define FT_RFLAG_ATLAS                 (1 << 10)
 #define FT_RFLAG_DEFAULTS              (FT_RFLAG_HINTED | \
                                         FT_RFLAG_USE_BITMAP_STRIKES | \
                                         FT_RFLAG_ANTIALIAS)
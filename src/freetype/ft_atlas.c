@@ -0,0 +1,298 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/*
+ * Glyph atlases for Font.render_to. Each glyph is rendered once, in the
+ * foreground color, onto a transparent 32 bit surface, and text is drawn
+ * by blitting the glyphs from there. The glyphs are packed in rows; a
+ * full atlas first grows taller, then starts over empty.
+ */
+
+#define PYGAME_FREETYPE_INTERNAL
+
+#include "ft_wrap.h"
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define ATLAS_MASKS 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff
+#else
+#define ATLAS_MASKS 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000
+#endif
+
+/* The render flags deciding the bitmap of a glyph */
+static const FT_UInt16 ATLAS_RENDER_FLAGS = (FT_RFLAG_ANTIALIAS |
+                                             FT_RFLAG_AUTOHINT |
+                                             FT_RFLAG_HINTED |
+                                             FT_RFLAG_TRANSFORM |
+                                             FT_RFLAG_USE_BITMAP_STRIKES);
+
+static int
+same_glyphs(const FontRenderMode *a, const FontRenderMode *b)
+{
+    return (a->face_size.x == b->face_size.x &&
+            a->face_size.y == b->face_size.y &&
+            a->rotation_angle == b->rotation_angle &&
+            a->strength == b->strength &&
+            (a->style & ~FT_STYLE_UNDERLINE) ==
+                (b->style & ~FT_STYLE_UNDERLINE) &&
+            (a->render_flags & ATLAS_RENDER_FLAGS) ==
+                (b->render_flags & ATLAS_RENDER_FLAGS) &&
+            (!(a->render_flags & FT_RFLAG_TRANSFORM) ||
+             (a->transform.xx == b->transform.xx &&
+              a->transform.xy == b->transform.xy &&
+              a->transform.yx == b->transform.yx &&
+              a->transform.yy == b->transform.yy)));
+}
+
+static int
+same_colors(const FontColor *a, const FontColor *b)
+{
+    return a->r == b->r && a->g == b->g && a->b == b->b && a->a == b->a;
+}
+
+/* The entry for id, or the free entry where it goes */
+static AtlasEntry *
+find_entry(AtlasEntry *entries, FT_UInt32 size_mask, GlyphIndex_t id)
+{
+    FT_UInt32 i = ((FT_UInt32)id * 2654435761U) & size_mask;
+
+    while (entries[i].used && entries[i].id != id) {
+        i = (i + 1) & size_mask;
+    }
+    return entries + i;
+}
+
+static void
+clear_atlas(GlyphAtlas *atlas)
+{
+    SDL_FillRect(PySurface_AsSurface(atlas->surface), 0, 0);
+    memset(atlas->entries, 0, sizeof(AtlasEntry) * (atlas->size_mask + 1));
+    atlas->count = 0;
+    atlas->row_x = 0;
+    atlas->row_y = 0;
+    atlas->row_h = 0;
+}
+
+static void
+free_atlas(GlyphAtlas *atlas)
+{
+    Py_XDECREF(atlas->surface);
+    _PGFT_free(atlas->entries);
+    memset(atlas, 0, sizeof(GlyphAtlas));
+}
+
+/* Make the atlas surface at least height rows tall, keeping its glyphs */
+static int
+grow_surface(GlyphAtlas *atlas, int height)
+{
+    SDL_Surface *old = PySurface_AsSurface(atlas->surface);
+    SDL_Surface *surf;
+    PyObject *surfobj;
+    int h = old->h;
+
+    while (h < height) {
+        h *= 2;
+    }
+    if (h > PGFT_ATLAS_MAX_HEIGHT) {
+        h = PGFT_ATLAS_MAX_HEIGHT;
+    }
+    surf = SDL_CreateRGBSurface(SDL_SWSURFACE | SDL_SRCALPHA,
+                                PGFT_ATLAS_WIDTH, h, 32, ATLAS_MASKS);
+    if (!surf) {
+        PyErr_SetString(PyExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    /* Same width and format, so the same pitch */
+    memcpy(surf->pixels, old->pixels, old->pitch * old->h);
+    memset((FT_Byte *)surf->pixels + old->pitch * old->h, 0,
+           surf->pitch * (h - old->h));
+    surfobj = PySurface_New(surf);
+    if (!surfobj) {
+        SDL_FreeSurface(surf);
+        return -1;
+    }
+    Py_DECREF(atlas->surface);
+    atlas->surface = surfobj;
+    return 0;
+}
+
+static int
+grow_entries(GlyphAtlas *atlas)
+{
+    FT_UInt32 size = (atlas->size_mask + 1) * 2;
+    AtlasEntry *entries = _PGFT_malloc(sizeof(AtlasEntry) * size);
+    FT_UInt32 i;
+
+    if (!entries) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(entries, 0, sizeof(AtlasEntry) * size);
+    for (i = 0; i <= atlas->size_mask; ++i) {
+        if (atlas->entries[i].used) {
+            *find_entry(entries, size - 1, atlas->entries[i].id) =
+                atlas->entries[i];
+        }
+    }
+    _PGFT_free(atlas->entries);
+    atlas->entries = entries;
+    atlas->size_mask = size - 1;
+    return 0;
+}
+
+/* The atlas of the glyphs rendered with mode in color, or 0 with an
+ * exception set.
+ */
+GlyphAtlas *
+_PGFT_Atlas_Get(FontInternals *internals, const FontRenderMode *mode,
+                const FontColor *color)
+{
+    GlyphAtlas *atlas;
+    GlyphAtlas *oldest = internals->atlases;
+    SDL_Surface *surf;
+    int i;
+
+    for (i = 0; i < PGFT_ATLAS_COUNT; ++i) {
+        atlas = internals->atlases + i;
+        if (atlas->surface &&
+            same_glyphs(&atlas->mode, mode) &&
+            same_colors(&atlas->color, color)) {
+            atlas->last_use = ++internals->atlas_clock;
+            return atlas;
+        }
+        if (atlas->last_use < oldest->last_use) {
+            oldest = atlas;
+        }
+    }
+
+    atlas = oldest;
+    if (!atlas->surface) {
+        surf = SDL_CreateRGBSurface(SDL_SWSURFACE | SDL_SRCALPHA,
+                                    PGFT_ATLAS_WIDTH, PGFT_ATLAS_MIN_HEIGHT,
+                                    32, ATLAS_MASKS);
+        if (!surf) {
+            PyErr_SetString(PyExc_SDLError, SDL_GetError());
+            return 0;
+        }
+        atlas->surface = PySurface_New(surf);
+        if (!atlas->surface) {
+            SDL_FreeSurface(surf);
+            return 0;
+        }
+        atlas->entries = _PGFT_malloc(sizeof(AtlasEntry) *
+                                      PGFT_ATLAS_MIN_ENTRIES);
+        if (!atlas->entries) {
+            free_atlas(atlas);
+            PyErr_NoMemory();
+            return 0;
+        }
+        atlas->size_mask = PGFT_ATLAS_MIN_ENTRIES - 1;
+    }
+    clear_atlas(atlas);
+    atlas->mode = *mode;
+    atlas->color = *color;
+    atlas->last_use = ++internals->atlas_clock;
+    return atlas;
+}
+
+/* Set area to where the glyph id, of bitmap, is in the atlas, rendering
+ * it there first if it is new. Returns 0, 1 if the glyph is too big for
+ * an atlas, or -1 with an exception set.
+ */
+int
+_PGFT_Atlas_Place(GlyphAtlas *atlas, GlyphIndex_t id,
+                  const FT_Bitmap *bitmap, SDL_Rect *area)
+{
+    int w = (int)bitmap->width;
+    int h = (int)bitmap->rows;
+    AtlasEntry *entry;
+    SDL_Surface *surf;
+    FontSurface font_surf;
+
+    if (w > PGFT_ATLAS_WIDTH || h > PGFT_ATLAS_MAX_HEIGHT) {
+        return 1;
+    }
+    entry = find_entry(atlas->entries, atlas->size_mask, id);
+    if (entry->used) {
+        *area = entry->area;
+        return 0;
+    }
+
+    if (atlas->row_x + w > PGFT_ATLAS_WIDTH) {
+        atlas->row_x = 0;
+        atlas->row_y += atlas->row_h;
+        atlas->row_h = 0;
+    }
+    surf = PySurface_AsSurface(atlas->surface);
+    if (atlas->row_y + h > surf->h) {
+        if (atlas->row_y + h <= PGFT_ATLAS_MAX_HEIGHT) {
+            if (grow_surface(atlas, atlas->row_y + h)) {
+                return -1;
+            }
+            surf = PySurface_AsSurface(atlas->surface);
+        }
+        else {
+            clear_atlas(atlas);
+        }
+        entry = find_entry(atlas->entries, atlas->size_mask, id);
+    }
+    if ((atlas->count + 1) * 2 > atlas->size_mask + 1) {
+        if (grow_entries(atlas)) {
+            return -1;
+        }
+        entry = find_entry(atlas->entries, atlas->size_mask, id);
+    }
+
+    entry->id = id;
+    entry->used = 1;
+    entry->area.x = (Sint16)atlas->row_x;
+    entry->area.y = (Sint16)atlas->row_y;
+    entry->area.w = (Uint16)w;
+    entry->area.h = (Uint16)h;
+    atlas->count++;
+    atlas->row_x += w;
+    if (h > atlas->row_h) {
+        atlas->row_h = h;
+    }
+
+    font_surf.buffer = surf->pixels;
+    font_surf.width = surf->w;
+    font_surf.height = surf->h;
+    font_surf.pitch = surf->pitch;
+    font_surf.format = surf->format;
+    if (bitmap->pixel_mode == FT_PIXEL_MODE_GRAY) {
+        __render_glyph_RGB4(entry->area.x, entry->area.y,
+                            &font_surf, bitmap, &atlas->color);
+    }
+    else {
+        __render_glyph_MONO4(entry->area.x, entry->area.y,
+                             &font_surf, bitmap, &atlas->color);
+    }
+    *area = entry->area;
+    return 0;
+}
+
+void
+_PGFT_Atlas_Free(FontInternals *internals)
+{
+    int i;
+
+    for (i = 0; i < PGFT_ATLAS_COUNT; ++i) {
+        free_atlas(internals->atlases + i);
+    }
+}
@@ -19,7 +19,6 @@
 */
 
 #define PYGAME_FREETYPE_INTERNAL
-#define NO_PYGAME_C_API
 
 #include "ft_wrap.h"
 #include FT_MODULE_H
@@ -41,15 +40,36 @@ typedef union cachenodekey_ {
 typedef struct cachenode_ {
     FontGlyph glyph;
     struct cachenode_ *next;
+    struct cachenode_ *lru_prev;    /* more recently used */
+    struct cachenode_ *lru_next;    /* less recently used */
     NodeKey key;
     FT_UInt32 hash;
+    size_t bytes;
 } CacheNode;
 
+/* A glyph cache shared by the fonts loaded from one file, at one face
+ * index and resolution.
+ */
+typedef struct sharedcache_ {
+    FontCache cache;    /* first, so a FontCache * is a SharedCache * */
+    char *pathname;
+    FT_Long font_index;
+    FT_UInt resolution;
+    int ref_count;
+    struct sharedcache_ *next;
+} SharedCache;
+
 static FT_UInt32 get_hash(const NodeKey *);
 static CacheNode *allocate_node(FontCache *,
                                 const FontRenderMode *,
                                 GlyphIndex_t, void *);
 static void free_node(FontCache *, CacheNode *);
+static void unlink_node(FontCache *, CacheNode *);
+static void lru_unlink(FontCache *, CacheNode *);
+static void lru_push(FontCache *, CacheNode *);
+static void grow_buckets(FontCache *);
+static CacheNode *find_node(FontCache *, const NodeKey *, FT_UInt32);
+static void insert_node(FontCache *, CacheNode *);
 static void set_node_key(NodeKey *, GlyphIndex_t, const FontRenderMode *);
 static int equal_node_keys(const NodeKey *, const NodeKey *);
 
@@ -62,7 +82,8 @@ set_node_key(NodeKey *key, GlyphIndex_t id, const FontRenderMode *mode)
 {
     KeyFields *fields = &key->fields;
     const FT_UInt16 style_mask = ~(FT_STYLE_UNDERLINE);
-    const FT_UInt16 rflag_mask = ~(FT_RFLAG_VERTICAL | FT_RFLAG_KERNING);
+    const FT_UInt16 rflag_mask = ~(FT_RFLAG_VERTICAL | FT_RFLAG_KERNING |
+                                    FT_RFLAG_ATLAS);
     unsigned short rot = (unsigned short)FX6_TRUNC(mode->rotation_angle);
 
     memset(key, 0, sizeof(*key));
@@ -144,139 +165,223 @@ _PGFT_Cache_Init(FreeTypeInstance *ft, FontCache *cache)
 
     cache_size = cache_size + 1;
 
-    cache->nodes = _PGFT_malloc((size_t)cache_size * sizeof(FontGlyph *));
+    cache->nodes = _PGFT_malloc((size_t)cache_size * sizeof(CacheNode *));
     if (!cache->nodes)
         return -1;
     for (i=0; i < cache_size; ++i)
         cache->nodes[i] = 0;
-    cache->depths = _PGFT_malloc((size_t)cache_size);
-    if (!cache->depths) {
-        _PGFT_free(cache->nodes);
-        cache->nodes = 0;
-        return -1;
-    }
-    memset(cache->depths, 0, cache_size);
     cache->free_nodes = 0;
+    cache->lru_first = 0;
+    cache->lru_last = 0;
     cache->size_mask = (FT_UInt32)(cache_size - 1);
-
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_count = 0;
-    cache->_debug_delete_count = 0;
-    cache->_debug_access = 0;
-    cache->_debug_hit = 0;
-    cache->_debug_miss = 0;
-#endif
+    cache->generation = 0;
+
+    cache->count = 0;
+    cache->bytes = 0;
+    cache->budget = PGFT_DEFAULT_CACHE_BUDGET;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
     return 0;
 }
 
 void
 _PGFT_Cache_Destroy(FontCache *cache)
 {
-    FT_UInt i;
     CacheNode *node, *next;
 
     if (!cache) {
         return;
     }
 
-    /* PGFT_DEBUG_CACHE - Here is a good place to set a breakpoint
-     * to examine _debug fields.
-     */
-
-    if (cache->nodes) {
-        for (i = 0; i <= cache->size_mask; ++i) {
-            node = cache->nodes[i];
-
-            while (node) {
-                next = node->next;
-                free_node(cache, node);
-                node = next;
-            }
-        }
-        _PGFT_free(cache->nodes);
-        cache->nodes = 0;
+    node = cache->lru_first;
+    while (node) {
+        next = node->lru_next;
+        free_node(cache, node);
+        node = next;
     }
-    _PGFT_free(cache->depths);
-    cache->depths = 0;
+    cache->lru_first = 0;
+    cache->lru_last = 0;
+    _PGFT_free(cache->nodes);
+    cache->nodes = 0;
 }
 
+/* Free the glyphs least recently used until the cache is within budget.
+ * Called only before a text is laid out, so no layout being rendered
+ * refers to the glyphs freed.
+ */
 void
 _PGFT_Cache_Cleanup(FontCache *cache)
 {
-    const FT_Byte MAX_BUCKET_DEPTH = 2;
-    CacheNode *node, *prev;
-    FT_UInt32 i;
+    CacheNode *node;
 
-    for (i = 0; i <= cache->size_mask; ++i) {
-        while (cache->depths[i] > MAX_BUCKET_DEPTH) {
-            node = cache->nodes[i];
-            prev = 0;
-
-            for (;;) {
-                if (!node->next) {
-#ifdef PGFT_DEBUG_CACHE
-                    cache->_debug_delete_count++;
-#endif
-
-                    prev->next = 0;
-                    free_node(cache, node);
-                    break;
-                }
-
-                prev = node;
-                node = node->next;
+    if (!cache->budget || cache->pins) {
+        return;
+    }
+    while (cache->bytes > cache->budget && cache->lru_last) {
+        node = cache->lru_last;
+        unlink_node(cache, node);
+        free_node(cache, node);
+        cache->evictions++;
+        cache->generation++;
+    }
+}
+
+/* The node for key, moved to the front of its bucket and the LRU list,
+ * or 0.
+ */
+static CacheNode *
+find_node(FontCache *cache, const NodeKey *key, FT_UInt32 hash)
+{
+    CacheNode **nodes = cache->nodes;
+    FT_UInt32 bucket = hash & cache->size_mask;
+    CacheNode *node = nodes[bucket];
+    CacheNode *prev = 0;
+
+    while (node) {
+        if (equal_node_keys(&node->key, key)) {
+            if (prev) {
+                prev->next = node->next;
+                node->next = nodes[bucket];
+                nodes[bucket] = node;
             }
+            if (cache->lru_first != node) {
+                lru_unlink(cache, node);
+                lru_push(cache, node);
+            }
+            return node;
         }
+
+        prev = node;
+        node = node->next;
     }
+    return 0;
 }
 
 FontGlyph *
 _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
                       FontCache *cache, void *internal)
 {
-    CacheNode **nodes = cache->nodes;
-    CacheNode *node, *prev;
+    CacheNode *node;
     NodeKey key;
-
     FT_UInt32 hash;
-    FT_UInt32 bucket;
 
     set_node_key(&key, id, render);
     hash = get_hash(&key);
-    bucket = hash & cache->size_mask;
-    node = nodes[bucket];
-    prev = 0;
+    node = find_node(cache, &key, hash);
+    if (node) {
+        cache->hits++;
+        PG_PERF_ADD(PG_PERF_FONT_CACHE_HITS, 1);
+        return &node->glyph;
+    }
 
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_access++;
-#endif
+    cache->misses++;
+    PG_PERF_ADD(PG_PERF_FONT_CACHE_MISSES, 1);
+    node = allocate_node(cache, render, id, internal);
 
-    while (node) {
-        if (equal_node_keys(&node->key, &key)) {
-            if (prev) {
-                prev->next = node->next;
-                node->next = nodes[bucket];
-                nodes[bucket] = node;
-            }
+    return node ? &node->glyph : 0;
+}
 
-#ifdef PGFT_DEBUG_CACHE
-            cache->_debug_hit++;
-#endif
+int
+_PGFT_Cache_HasGlyph(GlyphIndex_t id, const FontRenderMode *render,
+                     FontCache *cache)
+{
+    NodeKey key;
 
-            return &node->glyph;
-        }
+    set_node_key(&key, id, render);
+    return find_node(cache, &key, get_hash(&key)) != 0;
+}
 
-        prev = node;
-        node = node->next;
+/* Add a glyph loaded elsewhere, as by Font.prewarm. Returns 0, 1 if the
+ * cache already has the glyph, when the caller still owns its image, or
+ * -1 if out of memory.
+ */
+int
+_PGFT_Cache_AddGlyph(GlyphIndex_t id, const FontRenderMode *render,
+                     FontCache *cache, FontGlyph *glyph)
+{
+    CacheNode *node;
+    NodeKey key;
+    FT_UInt32 hash;
+
+    set_node_key(&key, id, render);
+    hash = get_hash(&key);
+    if (find_node(cache, &key, hash)) {
+        return 1;
     }
+    node = _PGFT_malloc(sizeof(CacheNode));
+    if (!node) {
+        return -1;
+    }
+    memset(node, 0, sizeof(CacheNode));
+    node->glyph = *glyph;
+    node->key = key;
+    node->hash = hash;
+    insert_node(cache, node);
+    cache->misses++;
+    return 0;
+}
 
-    node = allocate_node(cache, render, id, internal);
+/* The glyph cache for a font loaded from pathname, created for the first
+ * font, or 0 with a Python exception set.
+ */
+FontCache *
+_PGFT_Cache_GetShared(FreeTypeInstance *ft, const char *pathname,
+                      FT_Long font_index, FT_UInt resolution)
+{
+    SharedCache *shared;
+
+    for (shared = ft->shared_caches; shared; shared = shared->next) {
+        if (shared->font_index == font_index &&
+            shared->resolution == resolution &&
+            strcmp(shared->pathname, pathname) == 0) {
+            shared->ref_count++;
+            return &shared->cache;
+        }
+    }
 
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_miss++;
-#endif
+    shared = _PGFT_malloc(sizeof(SharedCache));
+    if (!shared) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    shared->pathname = _PGFT_malloc(strlen(pathname) + 1);
+    if (!shared->pathname) {
+        _PGFT_free(shared);
+        PyErr_NoMemory();
+        return 0;
+    }
+    if (_PGFT_Cache_Init(ft, &shared->cache)) {
+        _PGFT_free(shared->pathname);
+        _PGFT_free(shared);
+        PyErr_NoMemory();
+        return 0;
+    }
+    strcpy(shared->pathname, pathname);
+    shared->font_index = font_index;
+    shared->resolution = resolution;
+    shared->ref_count = 1;
+    shared->next = ft->shared_caches;
+    ft->shared_caches = shared;
+    return &shared->cache;
+}
 
-    return node ? &node->glyph : 0;
+void
+_PGFT_Cache_ReleaseShared(FreeTypeInstance *ft, FontCache *cache)
+{
+    SharedCache *shared = (SharedCache *)cache;
+    SharedCache **link = &ft->shared_caches;
+
+    if (--shared->ref_count) {
+        return;
+    }
+    while (*link != shared) {
+        link = &(*link)->next;
+    }
+    *link = shared->next;
+    _PGFT_Cache_Destroy(&shared->cache);
+    _PGFT_free(shared->pathname);
+    _PGFT_free(shared);
 }
 
 static void
@@ -286,22 +391,110 @@ free_node(FontCache *cache, CacheNode *node)
         return;
     }
 
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_count--;
-#endif
-
-    cache->depths[node->hash & cache->size_mask]--;
+    cache->count--;
+    cache->bytes -= node->bytes;
 
     FT_Done_Glyph((FT_Glyph)(node->glyph.image));
     _PGFT_free(node);
 }
 
+/* Take node out of its bucket and the LRU list */
+static void
+unlink_node(FontCache *cache, CacheNode *node)
+{
+    CacheNode **link = &cache->nodes[node->hash & cache->size_mask];
+
+    while (*link != node) {
+        link = &(*link)->next;
+    }
+    *link = node->next;
+    lru_unlink(cache, node);
+}
+
+static void
+lru_unlink(FontCache *cache, CacheNode *node)
+{
+    if (node->lru_prev) {
+        node->lru_prev->lru_next = node->lru_next;
+    }
+    else {
+        cache->lru_first = node->lru_next;
+    }
+    if (node->lru_next) {
+        node->lru_next->lru_prev = node->lru_prev;
+    }
+    else {
+        cache->lru_last = node->lru_prev;
+    }
+}
+
+static void
+lru_push(FontCache *cache, CacheNode *node)
+{
+    node->lru_prev = 0;
+    node->lru_next = cache->lru_first;
+    if (cache->lru_first) {
+        cache->lru_first->lru_prev = node;
+    }
+    else {
+        cache->lru_last = node;
+    }
+    cache->lru_first = node;
+}
+
+/* Double the buckets. On failure the cache just stays as it is. */
+static void
+grow_buckets(FontCache *cache)
+{
+    FT_UInt32 size = (cache->size_mask + 1) * 2;
+    CacheNode **nodes = _PGFT_malloc((size_t)size * sizeof(CacheNode *));
+    CacheNode *node, *next;
+    FT_UInt32 i;
+
+    if (!nodes) {
+        return;
+    }
+    for (i = 0; i < size; ++i) {
+        nodes[i] = 0;
+    }
+    for (i = 0; i <= cache->size_mask; ++i) {
+        for (node = cache->nodes[i]; node; node = next) {
+            next = node->next;
+            node->next = nodes[node->hash & (size - 1)];
+            nodes[node->hash & (size - 1)] = node;
+        }
+    }
+    _PGFT_free(cache->nodes);
+    cache->nodes = nodes;
+    cache->size_mask = size - 1;
+}
+
+/* Add a node with its glyph, key and hash set */
+static void
+insert_node(FontCache *cache, CacheNode *node)
+{
+    FT_Bitmap *bitmap = &node->glyph.image->bitmap;
+    FT_UInt32 bucket;
+
+    if (cache->count >= (cache->size_mask + 1) * 2) {
+        grow_buckets(cache);
+    }
+    bucket = node->hash & cache->size_mask;
+    node->next = cache->nodes[bucket];
+    cache->nodes[bucket] = node;
+    lru_push(cache, node);
+
+    node->bytes = (sizeof(CacheNode) + sizeof(FT_BitmapGlyphRec) +
+                   (size_t)abs(bitmap->pitch) * bitmap->rows);
+    cache->count++;
+    cache->bytes += node->bytes;
+}
+
 static CacheNode *
 allocate_node(FontCache *cache, const FontRenderMode *render,
               GlyphIndex_t id, void *internal)
 {
     CacheNode *node = _PGFT_malloc(sizeof(CacheNode));
-    FT_UInt32 bucket;
 
     if (!node) {
         return 0;
@@ -314,15 +507,7 @@ allocate_node(FontCache *cache, const FontRenderMode *render,
 
     set_node_key(&node->key, id, render);
     node->hash = get_hash(&node->key);
-    bucket = node->hash & cache->size_mask;
-    node->next = cache->nodes[bucket];
-    cache->nodes[bucket] = node;
-
-    cache->depths[bucket]++;
-
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_count++;
-#endif
+    insert_node(cache, node);
 
     return node;
 
@@ -104,21 +104,41 @@ static UpdateLevel_t mode_compare(const FontRenderMode *,
 static int same_sizes(const Scale_t *, const Scale_t * );
 static int same_transforms(const FT_Matrix *, const FT_Matrix *);
 static void copy_mode(FontRenderMode *, const FontRenderMode *);
+static FT_UInt32 hash_text(const PGFT_String *);
+static int same_text(const PGFT_String *, const PGFT_String *);
+static LayoutEntry *find_layout(LayoutCache *, const FontRenderMode *,
+                                const PGFT_String *, FT_UInt32);
+static LayoutEntry *reuse_layout(LayoutCache *);
+static void drop_layout(LayoutCache *, LayoutEntry *);
+static void clear_layout(LayoutEntry *);
+
+/* The text of a None string before anything is laid out */
+static PGFT_String empty_text = {0, {0}};
 
 
 int
 _PGFT_LayoutInit(FreeTypeInstance *ft, PgFontObject *fontobj)
 {
-    Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
-
-    ftext->buffer_size = 0;
-    ftext->glyphs = 0;
-
+    LayoutCache *layouts = &fontobj->_internals->layouts;
+    FontCache *cache = fontobj->_internals->glyph_cache;
+
+    layouts->entries = 0;
+    layouts->active = 0;
+    layouts->count = 0;
+    layouts->clock = 0;
+    layouts->hits = 0;
+    layouts->misses = 0;
+
+    if (cache) {
+        /* Shared */
+        return 0;
+    }
+    cache = &fontobj->_internals->own_cache;
     if (_PGFT_Cache_Init(ft, cache)) {
         PyErr_NoMemory();
         return -1;
     }
+    fontobj->_internals->glyph_cache = cache;
 
     return 0;
 }
@@ -126,63 +146,202 @@ _PGFT_LayoutInit(FreeTypeInstance *ft, PgFontObject *fontobj)
 void
 _PGFT_LayoutFree(PgFontObject *fontobj)
 {
-    Layout *ftext = &(fontobj->_internals->active_text);
-    FontCache *cache = &fontobj->_internals->glyph_cache;
-
-    if (ftext->buffer_size > 0) {
-        _PGFT_free(ftext->glyphs);
-        ftext->glyphs = 0;
+    LayoutCache *layouts = &fontobj->_internals->layouts;
+    FontCache *cache = fontobj->_internals->glyph_cache;
+    int i;
+
+    if (layouts->entries) {
+        for (i = 0; i < PGFT_LAYOUT_CACHE_SIZE; ++i) {
+            clear_layout(layouts->entries + i);
+            _PGFT_free(layouts->entries[i].layout.glyphs);
+        }
+        _PGFT_free(layouts->entries);
+        layouts->entries = 0;
+    }
+    layouts->active = 0;
+    layouts->count = 0;
+    if (cache == &fontobj->_internals->own_cache) {
+        _PGFT_Cache_Destroy(cache);
     }
-    _PGFT_Cache_Destroy(cache);
 }
 
 Layout *
 _PGFT_LoadLayout(FreeTypeInstance *ft, PgFontObject *fontobj,
                  const FontRenderMode *mode, PGFT_String *text)
 {
-    Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
-    UpdateLevel_t level = (text ?
-                           UPDATE_GLYPHS : mode_compare(&ftext->mode, mode));
-    FT_Face font = 0;
+    LayoutCache *layouts = &fontobj->_internals->layouts;
+    FontCache *cache = fontobj->_internals->glyph_cache;
+    LayoutEntry *entry;
+    Layout *ftext;
+    PGFT_String *copy;
+    FT_UInt32 hash;
+    FT_Face font;
     TextContext context;
 
-    if (level != UPDATE_NONE) {
-        copy_mode(&ftext->mode, mode);
-        font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
-        if (!font) {
-            PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
+    if (!layouts->entries) {
+        layouts->entries = (LayoutEntry *)
+            _PGFT_malloc(sizeof(LayoutEntry) * PGFT_LAYOUT_CACHE_SIZE);
+        if (!layouts->entries) {
+            PyErr_NoMemory();
             return 0;
         }
+        memset(layouts->entries, 0,
+               sizeof(LayoutEntry) * PGFT_LAYOUT_CACHE_SIZE);
     }
 
-    switch (level) {
-
-    case UPDATE_GLYPHS:
-        _PGFT_Cache_Cleanup(cache);
-        fill_context(&context, ft, fontobj, mode, font);
-        if (text) {
-            if (size_text(ftext, ft, &context, text)) {
+    /* No text means the text last laid out */
+    if (!text) {
+        text = layouts->active ? layouts->active->text : &empty_text;
+    }
+    hash = hash_text(text);
+
+    entry = find_layout(layouts, mode, text, hash);
+    if (entry) {
+        layouts->hits++;
+        ftext = &entry->layout;
+        if (entry->generation != cache->generation) {
+            /* The glyph cache has freed glyphs since; look them up again */
+            font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
+            if (!font) {
+                PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
+                drop_layout(layouts, entry);
+                return 0;
+            }
+            fill_context(&context, ft, fontobj, mode, font);
+            if (load_glyphs(ftext, &context, cache)) {
+                drop_layout(layouts, entry);
                 return 0;
             }
+            entry->generation = cache->generation;
         }
-        if (load_glyphs(ftext, &context, cache)) {
+    }
+    else {
+        layouts->misses++;
+        copy = (PGFT_String *)
+            _PGFT_malloc(sizeof(PGFT_String) +
+                         (size_t)PGFT_String_GET_LENGTH(text) *
+                         sizeof(PGFT_char));
+        if (!copy) {
+            PyErr_NoMemory();
             return 0;
         }
-        /* fall through */
+        memcpy(copy, text, sizeof(PGFT_String) +
+               (size_t)PGFT_String_GET_LENGTH(text) * sizeof(PGFT_char));
+
+        /* May free text, if it is the text of the reused entry */
+        entry = reuse_layout(layouts);
+        entry->text = copy;
+        entry->hash = hash;
+        ftext = &entry->layout;
+        copy_mode(&ftext->mode, mode);
 
-    case UPDATE_LAYOUT:
+        font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
+        if (!font) {
+            PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
+            drop_layout(layouts, entry);
+            return 0;
+        }
+        _PGFT_Cache_Cleanup(cache);
+        fill_context(&context, ft, fontobj, mode, font);
+        if (size_text(ftext, ft, &context, copy) ||
+            load_glyphs(ftext, &context, cache)) {
+            drop_layout(layouts, entry);
+            return 0;
+        }
         position_glyphs(ftext);
-        break;
-
-    default:
-        assert(level == UPDATE_NONE);
-        break;
+        entry->generation = cache->generation;
     }
 
+    entry->last_use = ++layouts->clock;
+    layouts->active = entry;
     return ftext;
 }
 
+/* FNV-1a over the characters */
+static FT_UInt32
+hash_text(const PGFT_String *text)
+{
+    Py_ssize_t length = PGFT_String_GET_LENGTH(text);
+    const PGFT_char *chars = PGFT_String_GET_DATA(text);
+    FT_UInt32 hash = 2166136261U;
+    Py_ssize_t i;
+
+    for (i = 0; i < length; ++i) {
+        hash = (hash ^ chars[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static int
+same_text(const PGFT_String *a, const PGFT_String *b)
+{
+    return (PGFT_String_GET_LENGTH(a) == PGFT_String_GET_LENGTH(b) &&
+            memcmp(PGFT_String_GET_DATA(a), PGFT_String_GET_DATA(b),
+                   (size_t)PGFT_String_GET_LENGTH(a) *
+                   sizeof(PGFT_char)) == 0);
+}
+
+/* The entry laying out text in mode, or 0 */
+static LayoutEntry *
+find_layout(LayoutCache *layouts, const FontRenderMode *mode,
+            const PGFT_String *text, FT_UInt32 hash)
+{
+    LayoutEntry *entry = layouts->entries;
+    int i;
+
+    for (i = 0; i < PGFT_LAYOUT_CACHE_SIZE; ++i, ++entry) {
+        if (entry->text &&
+            entry->hash == hash &&
+            entry->layout.mode.strength == mode->strength &&
+            mode_compare(&entry->layout.mode, mode) == UPDATE_NONE &&
+            same_text(entry->text, text)) {
+            return entry;
+        }
+    }
+    return 0;
+}
+
+/* An unused entry, else the one least recently used, emptied for reuse */
+static LayoutEntry *
+reuse_layout(LayoutCache *layouts)
+{
+    LayoutEntry *entry = layouts->entries;
+    LayoutEntry *oldest = entry;
+    int i;
+
+    for (i = 0; i < PGFT_LAYOUT_CACHE_SIZE; ++i, ++entry) {
+        if (!entry->text) {
+            layouts->count++;
+            return entry;
+        }
+        if (entry->last_use < oldest->last_use) {
+            oldest = entry;
+        }
+    }
+    clear_layout(oldest);
+    return oldest;
+}
+
+/* Forget an entry that could not be laid out */
+static void
+drop_layout(LayoutCache *layouts, LayoutEntry *entry)
+{
+    clear_layout(entry);
+    layouts->count--;
+    if (layouts->active == entry) {
+        layouts->active = 0;
+    }
+}
+
+/* Free what an entry holds, except the glyph slots, kept for reuse */
+static void
+clear_layout(LayoutEntry *entry)
+{
+    _PGFT_FreeString(entry->text);
+    entry->text = 0;
+    Py_CLEAR(entry->surface);
+}
+
 static int
 size_text(Layout *ftext,
           FreeTypeInstance *ft,
@@ -472,7 +631,7 @@ int _PGFT_GetMetrics(FreeTypeInstance *ft, PgFontObject *fontobj,
                     long *miny, long *maxy,
                     double *advance_x, double *advance_y)
 {
-    FontCache *cache = &(fontobj->_internals->glyph_cache);
+    FontCache *cache = fontobj->_internals->glyph_cache;
     FT_UInt32 ch = (FT_UInt32)character;
     GlyphIndex_t id;
     FontGlyph *glyph = 0;
@@ -509,6 +668,179 @@ int _PGFT_GetMetrics(FreeTypeInstance *ft, PgFontObject *fontobj,
     return 0;
 }
 
+static int
+compare_ids(const void *a, const void *b)
+{
+    GlyphIndex_t id_a = *(const GlyphIndex_t *)a;
+    GlyphIndex_t id_b = *(const GlyphIndex_t *)b;
+
+    return id_a < id_b ? -1 : id_a > id_b;
+}
+
+/* Render the glyphs of text in mode into the glyph cache, before any text
+ * needs them. A scalable font opened from a file name renders them with
+ * the GIL released, on a face of its own in a library of its own, as
+ * FreeType faces and libraries are not thread safe. Returns the number
+ * of glyphs added, or -1 with an exception set.
+ */
+int
+_PGFT_Prewarm(FreeTypeInstance *ft, PgFontObject *fontobj,
+              const FontRenderMode *mode, PGFT_String *text)
+{
+    FontInternals *internals = fontobj->_internals;
+    FontCache *cache = internals->glyph_cache;
+    Py_ssize_t length = PGFT_String_GET_LENGTH(text);
+    const PGFT_char *chars = PGFT_String_GET_DATA(text);
+    GlyphIndex_t *ids = 0;
+    FontGlyph *glyphs = 0;
+    Py_ssize_t count = 0;
+    Py_ssize_t i;
+    GlyphIndex_t id;
+    TextContext context;
+    FT_Face font;
+    FT_Face face = 0;
+    FT_Open_Args args;
+    FT_Error error = 0;
+    int threaded;
+    int no_memory = 0;
+    Py_ssize_t failed = -1;
+    int added = -1;
+
+    font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
+    if (!font) {
+        PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
+        return -1;
+    }
+    fill_context(&context, ft, fontobj, mode, font);
+
+    /* The glyphs not cached yet, each once */
+    ids = (GlyphIndex_t *)_PGFT_malloc((size_t)(length ? length : 1) *
+                                       sizeof(GlyphIndex_t));
+    if (!ids) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < length; ++i) {
+        id = FTC_CMapCache_Lookup(context.charmap, context.id, -1, chars[i]);
+        if (!_PGFT_Cache_HasGlyph(id, mode, cache)) {
+            ids[count++] = id;
+        }
+    }
+    qsort(ids, (size_t)count, sizeof(GlyphIndex_t), compare_ids);
+    length = count;
+    count = 0;
+    for (i = 0; i < length; ++i) {
+        if (!count || ids[i] != ids[count - 1]) {
+            ids[count++] = ids[i];
+        }
+    }
+    if (!count) {
+        added = 0;
+        goto end;
+    }
+
+    threaded = (fontobj->is_scalable &&
+                fontobj->id.open_args.flags == FT_OPEN_PATHNAME &&
+                !ft->prewarm_busy);
+    if (threaded && !ft->prewarm_library &&
+        FT_Init_FreeType(&ft->prewarm_library)) {
+        ft->prewarm_library = 0;
+        threaded = 0;
+    }
+    if (!threaded) {
+        for (i = 0; i < count; ++i) {
+            if (!_PGFT_Cache_FindGlyph(ids[i], mode, cache, &context)) {
+                PyErr_Format(PyExc_SDLError,
+                             "Unable to load glyph for id %lu",
+                             (unsigned long)ids[i]);
+                goto end;
+            }
+        }
+        added = (int)count;
+        goto end;
+    }
+
+    glyphs = (FontGlyph *)_PGFT_malloc((size_t)count * sizeof(FontGlyph));
+    if (!glyphs) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    memset(glyphs, 0, (size_t)count * sizeof(FontGlyph));
+    args.flags = FT_OPEN_PATHNAME;
+    args.pathname = fontobj->id.open_args.pathname;
+    context.lib = ft->prewarm_library;
+
+    /* The font cannot be reloaded until this is done */
+    ft->prewarm_busy = 1;
+    internals->busy++;
+    Py_BEGIN_ALLOW_THREADS;
+    error = FT_Open_Face(context.lib, &args, fontobj->id.font_index, &face);
+    if (!error) {
+        error = FT_Set_Char_Size(face, mode->face_size.x,
+                                 (mode->face_size.y ?
+                                  mode->face_size.y : mode->face_size.x),
+                                 fontobj->resolution, fontobj->resolution);
+    }
+    if (!error) {
+        context.font = face;
+        for (i = 0; i < count; ++i) {
+            if (_PGFT_LoadGlyph(glyphs + i, ids[i], mode, &context)) {
+                glyphs[i].image = 0;
+            }
+        }
+    }
+    if (face) {
+        FT_Done_Face(face);
+    }
+    Py_END_ALLOW_THREADS;
+    ft->prewarm_busy = 0;
+    internals->busy--;
+
+    if (error) {
+        _PGFT_SetError(ft, "Loading glyphs", error);
+        PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
+        goto end;
+    }
+    added = 0;
+    for (i = 0; i < count; ++i) {
+        if (!glyphs[i].image) {
+            if (failed < 0) {
+                failed = i;
+            }
+            continue;
+        }
+        switch (_PGFT_Cache_AddGlyph(ids[i], mode, cache, glyphs + i)) {
+
+        case 0:
+            ++added;
+            break;
+
+        case -1:
+            no_memory = 1;
+            /* fall through */
+
+        default:
+            /* Cached by a render meanwhile */
+            FT_Done_Glyph((FT_Glyph)glyphs[i].image);
+            break;
+        }
+    }
+    if (no_memory) {
+        PyErr_NoMemory();
+        added = -1;
+    }
+    else if (failed >= 0) {
+        PyErr_Format(PyExc_SDLError, "Unable to load glyph for id %lu",
+                     (unsigned long)ids[failed]);
+        added = -1;
+    }
+
+  end:
+    _PGFT_free(glyphs);
+    _PGFT_free(ids);
+    return added;
+}
+
 int
 _PGFT_LoadGlyph(FontGlyph *glyph, GlyphIndex_t id,
                 const FontRenderMode *mode, void *internal)
@@ -256,6 +256,140 @@ _PGFT_GetRenderMetrics(const FontRenderMode *mode, Layout *text,
  *
  *********************************************************/
 #ifdef HAVE_PYGAME_SDL_VIDEO
+static const FontRenderPtr __SDLrenderFuncs[] = {
+    0,
+    __render_glyph_RGB1,
+    __render_glyph_RGB2,
+    __render_glyph_RGB3,
+    __render_glyph_RGB4
+};
+
+static const FontRenderPtr __MONOrenderFuncs[] = {
+    0,
+    __render_glyph_MONO1,
+    __render_glyph_MONO2,
+    __render_glyph_MONO3,
+    __render_glyph_MONO4
+};
+
+static const FontFillPtr __RGBfillFuncs[] = {
+    0,
+    __fill_glyph_RGB1,
+    __fill_glyph_RGB2,
+    __fill_glyph_RGB3,
+    __fill_glyph_RGB4
+};
+
+/* Where a layout is drawn on a surface */
+typedef struct placement_ {
+    int x;                  /* top left of the background, in pixels */
+    int y;
+    unsigned width;
+    unsigned height;
+    FT_Vector offset;       /* of the layout origin, 26.6 */
+    FT_Pos underline_top;
+    FT_Fixed underline_size;
+} Placement;
+
+/* A layout of _PGFT_Render_Many, its glyphs copied out of the layout cache */
+typedef struct manytext_ {
+    Layout layout;
+    Placement place;
+    Py_ssize_t first_slot;
+} ManyText;
+
+static void
+init_font_surface(FontSurface *font_surf, SDL_Surface *surface)
+{
+    font_surf->buffer = surface->pixels;
+    font_surf->width = surface->w;
+    font_surf->height = surface->h;
+    font_surf->pitch = surface->pitch;
+    font_surf->format = surface->format;
+    font_surf->render_gray = __SDLrenderFuncs[surface->format->BytesPerPixel];
+    font_surf->render_mono = __MONOrenderFuncs[surface->format->BytesPerPixel];
+    font_surf->fill = __RGBfillFuncs[surface->format->BytesPerPixel];
+}
+
+/* Place font_text for dest x, y, setting r. Returns 0 if there is nothing
+ * to draw.
+ */
+static int
+place_layout(FreeTypeInstance *ft, PgFontObject *fontobj,
+             const FontRenderMode *mode, Layout *font_text,
+             int x, int y, Placement *place, SDL_Rect *r)
+{
+    FT_Vector offset;
+
+    if (font_text->length > 0) {
+        _PGFT_GetRenderMetrics(mode, font_text,
+                               &place->width, &place->height, &offset,
+                               &place->underline_top, &place->underline_size);
+    }
+    if (font_text->length == 0 || place->width == 0 || place->height == 0) {
+        r->x = 0;
+        r->y = 0;
+        r->w = 0;
+        r->h = _PGFT_Font_GetHeightSized(ft, fontobj, mode->face_size);
+        return 0;
+    }
+    place->offset.x = INT_TO_FX6(x);
+    place->offset.y = INT_TO_FX6(y);
+    if (mode->render_flags & FT_RFLAG_ORIGIN) {
+        x -= FX6_TRUNC(FX6_CEIL(offset.x));
+        y -= FX6_TRUNC(FX6_CEIL(offset.y));
+    }
+    else {
+        place->offset.x += offset.x;
+        place->offset.y += offset.y;
+    }
+    place->x = x;
+    place->y = y;
+
+    r->x = -(Sint16)FX6_TRUNC(FX6_FLOOR(offset.x));
+    r->y = (Sint16)FX6_TRUNC(FX6_CEIL(offset.y));
+    r->w = (Uint16)place->width;
+    r->h = (Uint16)place->height;
+    return 1;
+}
+
+/* Paint the background, if any, then the text. Needs no GIL. */
+static void
+draw_layout(FreeTypeInstance *ft, Layout *font_text,
+            const FontRenderMode *mode, const Placement *place,
+            SDL_Surface *surface, FontSurface *font_surf,
+            FontColor *fgcolor, FontColor *bgcolor)
+{
+    FT_Vector surf_offset = place->offset;
+
+    if (bgcolor) {
+        if (bgcolor->a == SDL_ALPHA_OPAQUE) {
+            SDL_Rect    bg_fill;
+            FT_UInt32   fillcolor;
+
+            fillcolor = SDL_MapRGBA(surface->format,
+                    bgcolor->r, bgcolor->g, bgcolor->b, bgcolor->a);
+
+            bg_fill.x = (FT_Int16)place->x;
+            bg_fill.y = (FT_Int16)place->y;
+            bg_fill.w = (FT_UInt16)place->width;
+            bg_fill.h = (FT_UInt16)place->height;
+
+            SDL_FillRect(surface, &bg_fill, fillcolor);
+        }
+        else {
+            font_surf->fill(INT_TO_FX6(place->x), INT_TO_FX6(place->y),
+                            INT_TO_FX6(place->width),
+                            INT_TO_FX6(place->height),
+                            font_surf, bgcolor);
+        }
+    }
+
+    render(ft, font_text, mode, fgcolor, font_surf,
+           place->width, place->height, &surf_offset,
+           place->underline_top, place->underline_size);
+}
+
 int
 _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, PgFontObject *fontobj,
                              const FontRenderMode *mode, PGFT_String *text,
@@ -263,22 +397,158 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, PgFontObject *fontobj,
                              FontColor *fgcolor, FontColor *bgcolor,
                              SDL_Rect *r)
 {
-    static const FontRenderPtr __SDLrenderFuncs[] = {
-        0,
-        __render_glyph_RGB1,
-        __render_glyph_RGB2,
-        __render_glyph_RGB3,
-        __render_glyph_RGB4
-    };
+    int locked = 0;
+    Placement place;
+    FontSurface font_surf;
+    Layout *font_text;
 
-    static const FontRenderPtr __MONOrenderFuncs[] = {
-        0,
-        __render_glyph_MONO1,
-        __render_glyph_MONO2,
-        __render_glyph_MONO3,
-        __render_glyph_MONO4
-    };
+    if (SDL_MUSTLOCK(surface)) {
+        if (SDL_LockSurface(surface) == -1) {
+            SDL_FreeSurface(surface);
+            PyErr_SetString(PyExc_SDLError, SDL_GetError());
+            return -1;
+        }
+        locked = 1;
+    }
+
+    /* build font text */
+    font_text = _PGFT_LoadLayout(ft, fontobj, mode, text);
+    if (!font_text) {
+        if (locked) {
+            SDL_UnlockSurface(surface);
+        }
+        return -1;
+    }
+
+    if (place_layout(ft, fontobj, mode, font_text, x, y, &place, r)) {
+        init_font_surface(&font_surf, surface);
+        draw_layout(ft, font_text, mode, &place, surface, &font_surf,
+                    fgcolor, bgcolor);
+    }
+
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
+
+    return 0;
+}
+
+/* _PGFT_Render_ExistingSurface for count texts, with the surface locked
+ * once. The texts are all laid out first, with the glyph cache pinned so
+ * no glyph is freed, then drawn together with the GIL released.
+ */
+int
+_PGFT_Render_Many(FreeTypeInstance *ft, PgFontObject *fontobj,
+                  const FontRenderMode *mode, RenderManyItem *items,
+                  Py_ssize_t count, SDL_Surface *surface,
+                  FontColor *fgcolor, FontColor *bgcolor)
+{
+    FontInternals *internals = fontobj->_internals;
+    FontCache *cache = internals->glyph_cache;
+    ManyText *texts = 0;
+    GlyphSlot *slots = 0;
+    GlyphSlot *new_slots;
+    Py_ssize_t slot_count = 0;
+    Py_ssize_t slots_size = 0;
+    Py_ssize_t i;
+    Layout *font_text;
+    FontSurface font_surf;
+    int locked = 0;
+    int result = -1;
+
+    if (count == 0) {
+        return 0;
+    }
+    texts = _PGFT_malloc((size_t)count * sizeof(ManyText));
+    if (!texts) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    cache->pins++;
+    for (i = 0; i < count; ++i) {
+        font_text = _PGFT_LoadLayout(ft, fontobj, mode, items[i].text);
+        if (!font_text) {
+            goto end;
+        }
+        if (!place_layout(ft, fontobj, mode, font_text,
+                          items[i].x, items[i].y,
+                          &texts[i].place, &items[i].r)) {
+            texts[i].layout.length = 0;
+            continue;
+        }
+
+        /* The layout cache entry may be reused by a later text */
+        if (slot_count + font_text->length > slots_size) {
+            slots_size = slots_size * 2 + font_text->length;
+            new_slots = _PGFT_malloc((size_t)slots_size * sizeof(GlyphSlot));
+            if (!new_slots) {
+                PyErr_NoMemory();
+                goto end;
+            }
+            if (slots) {
+                memcpy(new_slots, slots,
+                       (size_t)slot_count * sizeof(GlyphSlot));
+                _PGFT_free(slots);
+            }
+            slots = new_slots;
+        }
+        memcpy(slots + slot_count, font_text->glyphs,
+               (size_t)font_text->length * sizeof(GlyphSlot));
+        texts[i].layout = *font_text;
+        texts[i].first_slot = slot_count;
+        slot_count += font_text->length;
+    }
+    for (i = 0; i < count; ++i) {
+        texts[i].layout.glyphs = slots + texts[i].first_slot;
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        if (SDL_LockSurface(surface) == -1) {
+            PyErr_SetString(PyExc_SDLError, SDL_GetError());
+            goto end;
+        }
+        locked = 1;
+    }
+    init_font_surface(&font_surf, surface);
+
+    /* The font cannot be reloaded until this is done */
+    internals->busy++;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i) {
+        if (texts[i].layout.length > 0) {
+            draw_layout(ft, &texts[i].layout, mode, &texts[i].place,
+                        surface, &font_surf, fgcolor, bgcolor);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+    internals->busy--;
+
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
+    result = 0;
+
+  end:
+    cache->pins--;
+    _PGFT_Cache_Cleanup(cache);
+    _PGFT_free(slots);
+    _PGFT_free(texts);
+    return result;
+}
 
+/* _PGFT_Render_ExistingSurface for the atlas mode: the glyphs are blitted
+ * to surfobj from an atlas of the font, through Surface.blit, so the clip
+ * area of the surface is kept. Text with glyphs too big for an atlas, and
+ * 8 bit surfaces, are rendered the ordinary way.
+ */
+int
+_PGFT_Render_AtlasSurface(FreeTypeInstance *ft, PgFontObject *fontobj,
+                          const FontRenderMode *mode, PGFT_String *text,
+                          PyObject *surfobj, int x, int y,
+                          FontColor *fgcolor, FontColor *bgcolor,
+                          SDL_Rect *r)
+{
     static const FontFillPtr __RGBfillFuncs[] = {
         0,
         __fill_glyph_RGB1,
@@ -287,56 +557,61 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, PgFontObject *fontobj,
         __fill_glyph_RGB4
     };
 
-    int locked = 0;
+    SDL_Surface *surface = PySurface_AsSurface(surfobj);
     unsigned width;
     unsigned height;
     FT_Vector offset;
     FT_Vector surf_offset;
     FT_Pos underline_top;
     FT_Fixed underline_size;
+    int is_underline_gray = 0;
 
     FontSurface font_surf;
     Layout *font_text;
+    GlyphSlot *slots;
+    GlyphAtlas *atlas;
+    const FT_Bitmap *bitmap;
+    SDL_Rect area;
+    SDL_Rect dest;
+    int n;
 
-    if (SDL_MUSTLOCK(surface)) {
-        if (SDL_LockSurface(surface) == -1) {
-            SDL_FreeSurface(surface);
-            PyErr_SetString(PyExc_SDLError, SDL_GetError());
-            return -1;
-        }
-        locked = 1;
+    if (surface->format->BytesPerPixel == 1) {
+        return _PGFT_Render_ExistingSurface(ft, fontobj, mode, text, surface,
+                                            x, y, fgcolor, bgcolor, r);
     }
 
-    /* build font text */
     font_text = _PGFT_LoadLayout(ft, fontobj, mode, text);
     if (!font_text) {
-        if (locked) {
-            SDL_UnlockSurface(surface);
-        }
         return -1;
     }
-    if (font_text->length == 0) {
-        /* Nothing to rendering */
+    if (font_text->length > 0) {
+        _PGFT_GetRenderMetrics(mode, font_text, &width, &height, &offset,
+                               &underline_top, &underline_size);
+    }
+    if (font_text->length == 0 || width == 0 || height == 0) {
+        /* Nothing to render */
         r->x = 0;
         r->y = 0;
         r->w = 0;
         r->h = _PGFT_Font_GetHeightSized(ft, fontobj, mode->face_size);
         return 0;
     }
-
-    _PGFT_GetRenderMetrics(mode, font_text, &width, &height, &offset,
-                           &underline_top, &underline_size);
-    if (width == 0 || height == 0) {
-        /* Nothing more to do. */
-        if (locked) {
-            SDL_UnlockSurface(surface);
+    slots = font_text->glyphs;
+    PG_PERF_ADD(PG_PERF_FONT_GLYPHS, font_text->length);
+    for (n = 0; n < font_text->length; ++n) {
+        bitmap = &slots[n].glyph->image->bitmap;
+        if (bitmap->width > PGFT_ATLAS_WIDTH ||
+            bitmap->rows > PGFT_ATLAS_MAX_HEIGHT) {
+            return _PGFT_Render_ExistingSurface(ft, fontobj, mode, text,
+                                                surface, x, y,
+                                                fgcolor, bgcolor, r);
         }
-        r->x = 0;
-        r->y = 0;
-        r->w = 0;
-        r->h = _PGFT_Font_GetHeightSized(ft, fontobj, mode->face_size);
-        return 0;
     }
+    atlas = _PGFT_Atlas_Get(fontobj->_internals, mode, fgcolor);
+    if (!atlas) {
+        return -1;
+    }
+
     surf_offset.x = INT_TO_FX6(x);
     surf_offset.y = INT_TO_FX6(y);
     if (mode->render_flags & FT_RFLAG_ORIGIN) {
@@ -348,58 +623,86 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, PgFontObject *fontobj,
         surf_offset.y += offset.y;
     }
 
-    /*
-     * Setup target surface struct
-     */
-    font_surf.buffer = surface->pixels;
     font_surf.width = surface->w;
     font_surf.height = surface->h;
     font_surf.pitch = surface->pitch;
     font_surf.format = surface->format;
-    font_surf.render_gray = __SDLrenderFuncs[surface->format->BytesPerPixel];
-    font_surf.render_mono = __MONOrenderFuncs[surface->format->BytesPerPixel];
     font_surf.fill = __RGBfillFuncs[surface->format->BytesPerPixel];
 
-    /*
-     * if bg color exists, paint background
-     */
     if (bgcolor) {
         if (bgcolor->a == SDL_ALPHA_OPAQUE) {
-            SDL_Rect    bg_fill;
-            FT_UInt32   fillcolor;
-
-            fillcolor = SDL_MapRGBA(surface->format,
-                    bgcolor->r, bgcolor->g, bgcolor->b, bgcolor->a);
+            SDL_Rect bg_fill;
 
             bg_fill.x = (FT_Int16)x;
             bg_fill.y = (FT_Int16)y;
             bg_fill.w = (FT_UInt16)width;
             bg_fill.h = (FT_UInt16)height;
-
-            SDL_FillRect(surface, &bg_fill, fillcolor);
+            SDL_FillRect(surface, &bg_fill,
+                         SDL_MapRGBA(surface->format, bgcolor->r,
+                                     bgcolor->g, bgcolor->b, bgcolor->a));
         }
         else {
+            if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) == -1) {
+                PyErr_SetString(PyExc_SDLError, SDL_GetError());
+                return -1;
+            }
+            font_surf.buffer = surface->pixels;
             font_surf.fill(INT_TO_FX6(x), INT_TO_FX6(y),
                            INT_TO_FX6(width), INT_TO_FX6(height),
                            &font_surf, bgcolor);
+            if (SDL_MUSTLOCK(surface)) {
+                SDL_UnlockSurface(surface);
+            }
         }
     }
 
-    /*
-     * Render!
-     */
-    render(ft, font_text, mode, fgcolor, &font_surf,
-           width, height, &surf_offset, underline_top, underline_size);
+    for (n = 0; n < font_text->length; ++n) {
+        bitmap = &slots[n].glyph->image->bitmap;
+        if (bitmap->width == 0 || bitmap->rows == 0) {
+            continue;
+        }
+        if (bitmap->pixel_mode == FT_PIXEL_MODE_GRAY) {
+            is_underline_gray = 1;
+        }
+        if (_PGFT_Atlas_Place(atlas, slots[n].id, bitmap, &area)) {
+            return -1;
+        }
+        dest.x = (Sint16)FX6_TRUNC(FX6_CEIL(surf_offset.x + slots[n].posn.x));
+        dest.y = (Sint16)FX6_TRUNC(FX6_CEIL(surf_offset.y + slots[n].posn.y));
+        dest.w = area.w;
+        dest.h = area.h;
+        if (PySurface_Blit(surfobj, atlas->surface, &dest, &area, 0)) {
+            return -1;
+        }
+    }
+
+    if (underline_size > 0) {
+        if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) == -1) {
+            PyErr_SetString(PyExc_SDLError, SDL_GetError());
+            return -1;
+        }
+        font_surf.buffer = surface->pixels;
+        if (is_underline_gray) {
+            font_surf.fill(surf_offset.x + font_text->min_x,
+                           surf_offset.y + underline_top,
+                           INT_TO_FX6(width), underline_size,
+                           &font_surf, fgcolor);
+        }
+        else {
+            font_surf.fill(FX6_CEIL(surf_offset.x + font_text->min_x),
+                           FX6_CEIL(surf_offset.y + underline_top),
+                           INT_TO_FX6(width), FX6_CEIL(underline_size),
+                           &font_surf, fgcolor);
+        }
+        if (SDL_MUSTLOCK(surface)) {
+            SDL_UnlockSurface(surface);
+        }
+    }
 
     r->x = -(Sint16)FX6_TRUNC(FX6_FLOOR(offset.x));
     r->y = (Sint16)FX6_TRUNC(FX6_CEIL(offset.y));
     r->w = (Uint16)width;
     r->h = (Uint16)height;
-
-    if (locked) {
-        SDL_UnlockSurface(surface);
-    }
-
     return 0;
 }
 
@@ -543,6 +846,81 @@ SDL_Surface *_PGFT_Render_NewSurface(FreeTypeInstance *ft,
 
     return surface;
 }
+
+static int
+same_render_modes(const FontRenderMode *a, const FontRenderMode *b)
+{
+    return (a->face_size.x == b->face_size.x &&
+            a->face_size.y == b->face_size.y &&
+            a->rotation_angle == b->rotation_angle &&
+            a->render_flags == b->render_flags &&
+            a->style == b->style &&
+            a->strength == b->strength &&
+            a->underline_adjustment == b->underline_adjustment &&
+            a->transform.xx == b->transform.xx &&
+            a->transform.xy == b->transform.xy &&
+            a->transform.yx == b->transform.yx &&
+            a->transform.yy == b->transform.yy);
+}
+
+static int
+same_colors(const FontColor *a, const FontColor *b)
+{
+    return a->r == b->r && a->g == b->g && a->b == b->b && a->a == b->a;
+}
+
+/* As _PGFT_Render_NewSurface, but returns a new reference to the surface
+ * object kept with the layout of text, which is rendered again only if
+ * the render mode or colors differ from the last time.
+ */
+PyObject *
+_PGFT_Render_Cached(FreeTypeInstance *ft, PgFontObject *fontobj,
+                    const FontRenderMode *mode, PGFT_String *text,
+                    FontColor *fgcolor, FontColor *bgcolor, SDL_Rect *r)
+{
+    LayoutEntry *entry;
+    SDL_Surface *surface;
+    PyObject *surfobj;
+
+    if (!_PGFT_LoadLayout(ft, fontobj, mode, text)) {
+        return 0;
+    }
+    entry = fontobj->_internals->layouts.active;
+    if (entry->surface &&
+        same_render_modes(&entry->surface_mode, mode) &&
+        same_colors(&entry->surface_fg, fgcolor) &&
+        (bgcolor ?
+         entry->surface_has_bg && same_colors(&entry->surface_bg, bgcolor) :
+         !entry->surface_has_bg)) {
+        *r = entry->surface_rect;
+        Py_INCREF(entry->surface);
+        return entry->surface;
+    }
+
+    /* The text just laid out */
+    surface = _PGFT_Render_NewSurface(ft, fontobj, mode, 0,
+                                      fgcolor, bgcolor, r);
+    if (!surface) {
+        return 0;
+    }
+    surfobj = PySurface_New(surface);
+    if (!surfobj) {
+        SDL_FreeSurface(surface);
+        return 0;
+    }
+    entry = fontobj->_internals->layouts.active;
+    Py_XDECREF(entry->surface);
+    Py_INCREF(surfobj);
+    entry->surface = surfobj;
+    entry->surface_mode = *mode;
+    entry->surface_fg = *fgcolor;
+    entry->surface_has_bg = bgcolor != 0;
+    if (bgcolor) {
+        entry->surface_bg = *bgcolor;
+    }
+    entry->surface_rect = *r;
+    return surfobj;
+}
 #endif  /* #ifdef HAVE_PYGAME_SDL_VIDEO */
 
 
@@ -776,6 +1154,7 @@ render(FreeTypeInstance *ft, Layout *text, const FontRenderMode *mode,
     if (length <= 0) {
         return;
     }
+    PG_PERF_ADD(PG_PERF_FONT_GLYPHS, length);
     left = offset->x;
     top = offset->y;
     for (n = 0; n < length; ++n) {
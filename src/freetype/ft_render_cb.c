@@ -497,6 +497,22 @@ void __fill_glyph_INT(FT_Fixed x, FT_Fixed y, FT_Fixed w, FT_Fixed h,
 #define POINTER_ASSERT(p)
 #endif
 
+/* The 32 bit antialiased glyph renderer has an SSE2 kernel on x86 and
+ * x86-64. It is chosen at runtime, so the module is still built for the
+ * baseline instruction set.
+ */
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || \
+    defined(_M_X64) || defined(_M_IX86)
+#define PGFT_ENABLE_SSE2_RENDER
+#include <emmintrin.h>
+#include <SDL_cpuinfo.h>
+#if defined(__GNUC__)
+#define PGFT_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define PGFT_TARGET_SSE2
+#endif
+#endif
+
 #define _CREATE_RGB_FILLER(_bpp, _getp, _setp, _blendp)     \
     void __fill_glyph_RGB##_bpp(FT_Fixed x, FT_Fixed y,     \
                                 FT_Fixed w, FT_Fixed h,     \
@@ -740,6 +756,190 @@ void __fill_glyph_INT(FT_Fixed x, FT_Fixed y, FT_Fixed w, FT_Fixed h,
         }                                                               \
     }
 
+#ifdef PGFT_ENABLE_SSE2_RENDER
+/* Blend 4 pixels of coverage into 4 destination pixels, with the same
+ * arithmetic as ALPHA_BLEND. Each pixel is unpacked into four 16 bit lanes,
+ * one for each byte. For a colour channel at byte k,
+ *
+ *     ((s - d) * a + s) >> 8) + d  ==  (s * (a + 1) + d * (256 - a)) >> 8
+ *
+ * which stays within 16 bits. The lane of the alpha (or unused) byte gets
+ * the blended alpha, or 0 if the surface has no alpha.
+ */
+#define _DIV255_EPI16(t)                                                \
+    _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16((t), one),               \
+                                 _mm_srli_epi16((t), 8)), 8)
+
+static PGFT_TARGET_SSE2 void
+_blend_coverage4_sse2(FT_Byte *dst, const FT_Byte *src,
+                      __m128i fg, __m128i ca, __m128i xmask, __m128i amask,
+                      int Ashift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i c256 = _mm_set1_epi16(256);
+    const __m128i c255 = _mm_set1_epi16(255);
+    __m128i d = _mm_loadu_si128((const __m128i *)dst);
+    __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+    __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+    __m128i a, a_lo, a_hi, da_lo, da_hi, out_lo, out_hi;
+    FT_UInt32 cov;
+
+    memcpy(&cov, src, 4);
+    a = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)cov), zero);
+    a = _DIV255_EPI16(_mm_mullo_epi16(a, ca));
+    a = _mm_unpacklo_epi16(a, a);
+    a_lo = _mm_unpacklo_epi32(a, a);
+    a_hi = _mm_unpackhi_epi32(a, a);
+
+    if (Ashift >= 0) {
+        __m128i da = _mm_and_si128(_mm_srl_epi32(d, _mm_cvtsi32_si128(Ashift)),
+                                   _mm_set1_epi32(0xFF));
+
+        da = _mm_or_si128(da, _mm_slli_epi32(da, 16));
+        da_lo = _mm_unpacklo_epi32(da, da);
+        da_hi = _mm_unpackhi_epi32(da, da);
+    }
+    else {
+        da_lo = da_hi = c255;
+    }
+
+#define _BLEND_HALF(_d, _a, _da, _out)                                  \
+    {                                                                   \
+        __m128i c = _mm_srli_epi16(                                     \
+            _mm_add_epi16(_mm_mullo_epi16(fg, _mm_add_epi16(_a, one)),  \
+                          _mm_mullo_epi16(_d, _mm_sub_epi16(c256, _a))),\
+            8);                                                         \
+        __m128i al = _mm_sub_epi16(_mm_add_epi16(_a, _da),              \
+            _DIV255_EPI16(_mm_mullo_epi16(_a, _da)));                   \
+        __m128i empty = _mm_cmpeq_epi16(_da, zero);                     \
+        __m128i keep = _mm_cmpeq_epi16(_a, zero);                       \
+                                                                        \
+        c = _mm_or_si128(_mm_andnot_si128(empty, c),                    \
+                         _mm_and_si128(empty, fg));                     \
+        al = _mm_or_si128(_mm_andnot_si128(empty, al),                  \
+                          _mm_and_si128(empty, _a));                    \
+        _out = _mm_or_si128(_mm_andnot_si128(xmask, c),                 \
+                            _mm_and_si128(amask, al));                  \
+        _out = _mm_or_si128(_mm_andnot_si128(keep, _out),               \
+                            _mm_and_si128(keep, _d));                   \
+    }
+
+    _BLEND_HALF(d_lo, a_lo, da_lo, out_lo)
+    _BLEND_HALF(d_hi, a_hi, da_hi, out_hi)
+#undef _BLEND_HALF
+
+    _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(out_lo, out_hi));
+}
+
+#undef _DIV255_EPI16
+
+/* Returns true if each channel of a 32 bit surface is a whole byte, which
+ * is what the SSE2 renderer expects. The byte left over from R, G and B
+ * must be either the alpha channel or unused.
+ */
+static int
+_sse2_format_ok(const SDL_PixelFormat *fmt)
+{
+    FT_UInt32 rgb = fmt->Rmask | fmt->Gmask | fmt->Bmask;
+    int xshift = 0;
+
+    if (fmt->BytesPerPixel != 4 ||
+        (fmt->Rshift & 7) || fmt->Rshift > 24 ||
+        (fmt->Gshift & 7) || fmt->Gshift > 24 ||
+        (fmt->Bshift & 7) || fmt->Bshift > 24 ||
+        fmt->Rmask != (FT_UInt32)0xFF << fmt->Rshift ||
+        fmt->Gmask != (FT_UInt32)0xFF << fmt->Gshift ||
+        fmt->Bmask != (FT_UInt32)0xFF << fmt->Bshift ||
+        fmt->Rshift == fmt->Gshift || fmt->Rshift == fmt->Bshift ||
+        fmt->Gshift == fmt->Bshift) {
+        return 0;
+    }
+    while (rgb & ((FT_UInt32)0xFF << xshift)) {
+        xshift += 8;
+    }
+    return (!fmt->Amask ||
+            (fmt->Ashift == xshift &&
+             fmt->Amask == (FT_UInt32)0xFF << fmt->Ashift));
+}
+
+/* Render an antialiased glyph on a 32 bit surface accepted by
+ * _sse2_format_ok. The clipping is done by the caller.
+ */
+static PGFT_TARGET_SSE2 void
+__render_glyph_RGB4_sse2(FT_Byte *dst, const FT_Byte *src,
+                         int width, int rows, int src_pitch,
+                         FontSurface *surface, const FontColor *color)
+{
+    const SDL_PixelFormat *fmt = surface->format;
+    FT_UInt32 rgb = fmt->Rmask | fmt->Gmask | fmt->Bmask;
+    FT_UInt16 fg_lanes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    FT_UInt16 x_lanes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    __m128i fg, ca, xmask, amask;
+    int xshift = 0;
+    int Ashift;
+    int i, j;
+
+    while (rgb & ((FT_UInt32)0xFF << xshift)) {
+        xshift += 8;
+    }
+    Ashift = fmt->Amask ? xshift : -1;
+    for (i = 0; i < 8; i += 4) {
+        fg_lanes[i + fmt->Rshift / 8] = color->r;
+        fg_lanes[i + fmt->Gshift / 8] = color->g;
+        fg_lanes[i + fmt->Bshift / 8] = color->b;
+        x_lanes[i + xshift / 8] = 0xFFFF;
+    }
+    fg = _mm_loadu_si128((const __m128i *)fg_lanes);
+    ca = _mm_set1_epi16(color->a);
+    xmask = _mm_loadu_si128((const __m128i *)x_lanes);
+    amask = fmt->Amask ? xmask : _mm_setzero_si128();
+
+    for (j = 0; j < rows; ++j) {
+        FT_Byte *_dst = dst;
+        const FT_Byte *_src = src;
+
+        for (i = 0; i + 4 <= width; i += 4, _dst += 16, _src += 4) {
+            FT_UInt32 cov;
+
+            memcpy(&cov, _src, 4);
+            if (cov) {
+                _blend_coverage4_sse2(_dst, _src, fg, ca, xmask, amask,
+                                      Ashift);
+            }
+        }
+        if (i < width) {
+            /* The last 1 to 3 pixels go through a zero padded copy. */
+            FT_Byte tail_dst[16] = {0};
+            FT_Byte tail_src[4] = {0, 0, 0, 0};
+            int n = width - i;
+
+            memcpy(tail_dst, _dst, n * 4);
+            memcpy(tail_src, _src, n);
+            _blend_coverage4_sse2(tail_dst, tail_src, fg, ca, xmask, amask,
+                                  Ashift);
+            memcpy(_dst, tail_dst, n * 4);
+        }
+
+        dst += surface->pitch;
+        src += src_pitch;
+    }
+}
+
+#define _RENDER_SIMD4                                                   \
+    if (max_x > rx && max_y > ry && SDL_HasSSE2() &&                    \
+        _sse2_format_ok(surface->format)) {                             \
+        __render_glyph_RGB4_sse2(dst, src, max_x - rx, max_y - ry,      \
+                                 bitmap->pitch, surface, color);        \
+        return;                                                         \
+    }
+#else
+#define _RENDER_SIMD4
+#endif /* #ifdef PGFT_ENABLE_SSE2_RENDER */
+#define _RENDER_SIMD1
+#define _RENDER_SIMD2
+#define _RENDER_SIMD3
+
 #define _CREATE_RGB_RENDER(_bpp, _getp, _setp, _blendp)                 \
     void __render_glyph_RGB##_bpp(int x, int y, FontSurface *surface,   \
                                   const FT_Bitmap *bitmap,              \
@@ -772,6 +972,8 @@ void __fill_glyph_INT(FT_Fixed x, FT_Fixed y, FT_Fixed w, FT_Fixed h,
         FT_UInt32 bgR, bgG, bgB, bgA;                                   \
         int j, i;                                                       \
                                                                         \
+        _RENDER_SIMD##_bpp                                              \
+                                                                        \
         for (j = ry; j < max_y; ++j) {                                  \
             _src = src;                                                 \
             _dst = dst;                                                 \
@@ -830,12 +1032,15 @@ void __fill_glyph_INT(FT_Fixed x, FT_Fixed y, FT_Fixed w, FT_Fixed h,
 #define _SET_PIXEL(T) \
     *(T*)_dst = (T)full_color;
 
-#define _BLEND_PIXEL(T) *((T*)_dst) = (T)(                          \
-    ((bgR >> surface->format->Rloss) << surface->format->Rshift) |  \
-    ((bgG >> surface->format->Gloss) << surface->format->Gshift) |  \
-    ((bgB >> surface->format->Bloss) << surface->format->Bshift) |  \
-    ((bgA >> surface->format->Aloss) << surface->format->Ashift  &  \
-     surface->format->Amask)                                        )
+/* ALPHA_BLEND_COMP can wrap an unsigned channel past 255 when the
+ * destination is brighter than the source, so mask each channel to a byte.
+ */
+#define _BLEND_PIXEL(T) *((T*)_dst) = (T)(                                  \
+    (((bgR & 0xFF) >> surface->format->Rloss) << surface->format->Rshift) | \
+    (((bgG & 0xFF) >> surface->format->Gloss) << surface->format->Gshift) | \
+    (((bgB & 0xFF) >> surface->format->Bloss) << surface->format->Bshift) | \
+    (((bgA & 0xFF) >> surface->format->Aloss) << surface->format->Ashift  & \
+     surface->format->Amask)                                                )
 
 #define _BLEND_PIXEL_GENERIC(T) *(T*)_dst = (T)(    \
     SDL_MapRGB(surface->format,                     \
@@ -25,8 +25,8 @@
 
 static unsigned long RWops_read(FT_Stream, unsigned long,
                                 unsigned char *, unsigned long);
-static int init(FreeTypeInstance *, PgFontObject *);
-static void quit(PgFontObject *);
+static int init(FreeTypeInstance *, PgFontObject *, int);
+static void quit(FreeTypeInstance *, PgFontObject *);
 
 
 /*********************************************************
@@ -378,7 +378,7 @@ _PGFT_font_request(FTC_FaceID font_id, FT_Library library,
 
 
 
-static int init(FreeTypeInstance *ft, PgFontObject *fontobj)
+static int init(FreeTypeInstance *ft, PgFontObject *fontobj, int shared)
 {
     FT_Face font;
     fontobj->_internals = 0;
@@ -397,7 +397,22 @@ static int init(FreeTypeInstance *ft, PgFontObject *fontobj)
     }
     memset(fontobj->_internals, 0x0, sizeof(FontInternals));
 
+    if (shared) {
+        fontobj->_internals->glyph_cache =
+            _PGFT_Cache_GetShared(ft, fontobj->id.open_args.pathname,
+                                  fontobj->id.font_index,
+                                  fontobj->resolution);
+        if (!fontobj->_internals->glyph_cache) {
+            _PGFT_free(fontobj->_internals);
+            fontobj->_internals = 0;
+            return -1;
+        }
+    }
+
     if (_PGFT_LayoutInit(ft, fontobj)) {
+        if (shared) {
+            _PGFT_Cache_ReleaseShared(ft, fontobj->_internals->glyph_cache);
+        }
         _PGFT_free(fontobj->_internals);
         fontobj->_internals = 0;
         return -1;
@@ -407,10 +422,16 @@ static int init(FreeTypeInstance *ft, PgFontObject *fontobj)
 }
 
 static void
-quit(PgFontObject *fontobj)
+quit(FreeTypeInstance *ft, PgFontObject *fontobj)
 {
-    if (fontobj->_internals) {
+    FontInternals *internals = fontobj->_internals;
+
+    if (internals) {
+        _PGFT_Atlas_Free(internals);
         _PGFT_LayoutFree(fontobj);
+        if (internals->glyph_cache != &internals->own_cache) {
+            _PGFT_Cache_ReleaseShared(ft, internals->glyph_cache);
+        }
         _PGFT_free(fontobj->_internals);
         fontobj->_internals = 0;
     }
@@ -420,7 +441,8 @@ int
 _PGFT_TryLoadFont_Filename(FreeTypeInstance *ft,
     PgFontObject *fontobj,
     const char *filename,
-    long font_index)
+    long font_index,
+    int shared)
 {
     char *filename_alloc;
     size_t file_len;
@@ -439,7 +461,7 @@ _PGFT_TryLoadFont_Filename(FreeTypeInstance *ft,
     fontobj->id.open_args.flags = FT_OPEN_PATHNAME;
     fontobj->id.open_args.pathname = filename_alloc;
 
-    return init(ft, fontobj);
+    return init(ft, fontobj, shared);
 }
 
 #ifdef HAVE_PYGAME_SDL_RWOPS
@@ -464,6 +486,8 @@ _PGFT_TryLoadFont_RWops(FreeTypeInstance *ft, PgFontObject *fontobj,
 {
     FT_Stream stream;
     int position;
+    const Uint8 *base;
+    int size;
 
     position = SDL_RWtell(src);
     if (position < 0) {
@@ -477,18 +501,25 @@ _PGFT_TryLoadFont_RWops(FreeTypeInstance *ft, PgFontObject *fontobj,
         return -1;
     }
     memset(stream, 0, sizeof(*stream));
-    stream->read = RWops_read;
     stream->descriptor.pointer = src;
-    stream->pos = (unsigned long)position;
-    SDL_RWseek(src, 0, SEEK_END);
-    stream->size = (unsigned long)(SDL_RWtell(src) - position);
-    SDL_RWseek(src, position, SEEK_SET);
+    if (RWopsGetMemory(src, &base, &size)) {
+        /* A memory stream; FreeType reads the font data in place */
+        stream->base = (unsigned char *)base + position;
+        stream->size = (unsigned long)(size - position);
+    }
+    else {
+        stream->read = RWops_read;
+        stream->pos = (unsigned long)position;
+        SDL_RWseek(src, 0, SEEK_END);
+        stream->size = (unsigned long)(SDL_RWtell(src) - position);
+        SDL_RWseek(src, position, SEEK_SET);
+    }
 
     fontobj->id.font_index = (FT_Long) font_index;
     fontobj->id.open_args.flags = FT_OPEN_STREAM;
     fontobj->id.open_args.stream = stream;
 
-    return init(ft, fontobj);
+    return init(ft, fontobj, 0);
 }
 #endif
 
@@ -500,15 +531,16 @@ _PGFT_UnloadFont(FreeTypeInstance *ft, PgFontObject *fontobj)
 
     if (ft) {
         FTC_Manager_RemoveFaceID(ft->cache_manager, (FTC_FaceID)(&fontobj->id));
-        quit(fontobj);
+        quit(ft, fontobj);
     }
 
     if (fontobj->id.open_args.flags == FT_OPEN_STREAM) {
-        _PGFT_free(fontobj->id.open_args.pathname);
-    fontobj->id.open_args.pathname = 0;
+        _PGFT_free(fontobj->id.open_args.stream);
+        fontobj->id.open_args.stream = 0;
     }
     else if (fontobj->id.open_args.flags == FT_OPEN_PATHNAME) {
-        _PGFT_free(fontobj->id.open_args.stream);
+        _PGFT_free(fontobj->id.open_args.pathname);
+        fontobj->id.open_args.pathname = 0;
     }
     fontobj->id.open_args.flags = 0;
 }
@@ -535,6 +567,9 @@ _PGFT_Init(FreeTypeInstance **_instance, int cache_size)
     inst->ref_count = 1;
     inst->cache_manager = 0;
     inst->library = 0;
+    inst->prewarm_library = 0;
+    inst->prewarm_busy = 0;
+    inst->shared_caches = 0;
     inst->cache_size = cache_size;
 
     error = FT_Init_FreeType(&inst->library);
@@ -584,6 +619,9 @@ _PGFT_Quit(FreeTypeInstance *ft)
     if (ft->library)
         FT_Done_FreeType(ft->library);
 
+    if (ft->prewarm_library)
+        FT_Done_FreeType(ft->prewarm_library);
+
     _PGFT_free(ft);
 }
 
@@ -52,6 +52,7 @@
 /* Internal configuration variables */
 #define PGFT_DEFAULT_CACHE_SIZE 64
 #define PGFT_MIN_CACHE_SIZE 32
+#define PGFT_DEFAULT_CACHE_BUDGET (1024 * 1024) /* bytes per font */
 #if defined(PGFT_DEBUG_CACHE)
 #undef  PGFT_DEBUG_CACHE
 #endif
@@ -92,6 +93,14 @@ typedef struct freetypeinstance_ {
     FTC_Manager cache_manager;
     FTC_CMapCache cache_charmap;
 
+    /* For Font.prewarm, rendering with the GIL released. Its glyphs may
+     * be cached, so it is kept until the instance is freed.
+     */
+    FT_Library prewarm_library;
+    int prewarm_busy;
+
+    struct sharedcache_ *shared_caches;
+
     int cache_size;
     char _error_msg[1024];
 } FreeTypeInstance;
@@ -121,21 +130,28 @@ typedef struct rendermode_ {
 
 struct cachenode_;
 
+/* The glyphs of a font, hashed by glyph index and render mode. Glyphs
+ * are only freed by _PGFT_Cache_Cleanup, between renders, least recently
+ * used first, until the cache is within its byte budget again. While the
+ * cache is pinned nothing is freed, so glyph pointers stay valid.
+ */
 typedef struct fontcache_ {
     struct cachenode_ **nodes;
     struct cachenode_ *free_nodes;
 
-    FT_Byte *depths;
-
-#ifdef PGFT_DEBUG_CACHE
-    FT_UInt32 _debug_count;
-    FT_UInt32 _debug_delete_count;
-    FT_UInt32 _debug_access;
-    FT_UInt32 _debug_hit;
-    FT_UInt32 _debug_miss;
-#endif
+    struct cachenode_ *lru_first;   /* most recently used */
+    struct cachenode_ *lru_last;
 
     FT_UInt32 size_mask;
+    FT_UInt32 generation;   /* changed whenever glyphs are freed */
+
+    FT_UInt32 count;
+    size_t bytes;           /* of the glyphs and their nodes */
+    size_t budget;          /* 0 for no limit */
+    int pins;               /* no cleanup while not 0 */
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
 } FontCache;
 
 typedef struct fontmetrics_ {
@@ -210,18 +226,97 @@ typedef struct fontsurface_ {
 
 } FontSurface;
 
-typedef struct fontinternals_ {
-    Layout active_text;
-    FontCache glyph_cache;
-} FontInternals;
+/* Glyph atlases: the glyphs rendered for one render mode and foreground
+ * color, packed in rows into a 32 bit surface and blitted from there.
+ * A font keeps up to PGFT_ATLAS_COUNT of them, reusing the one least
+ * recently used.
+ */
+#define PGFT_ATLAS_COUNT 4
+#define PGFT_ATLAS_WIDTH 512
+#define PGFT_ATLAS_MIN_HEIGHT 64
+#define PGFT_ATLAS_MAX_HEIGHT 512
+#define PGFT_ATLAS_MIN_ENTRIES 256
+
+typedef struct atlasentry_ {
+    GlyphIndex_t id;
+    int used;
+    SDL_Rect area;
+} AtlasEntry;
+
+typedef struct glyphatlas_ {
+    PyObject *surface;      /* 0 if the atlas is unused */
+    FontRenderMode mode;
+    FontColor color;
+
+    AtlasEntry *entries;    /* open addressed by glyph index */
+    FT_UInt32 size_mask;
+    FT_UInt32 count;
+
+    int row_x;              /* where the next glyph goes in the last row */
+    int row_y;
+    int row_h;
+
+    unsigned long last_use;
+} GlyphAtlas;
 
 typedef struct PGFT_String_ {
     Py_ssize_t length;
     PGFT_char data[1];
 } PGFT_String;
 
+/* One text of _PGFT_Render_Many: drawn at x, y, with r set to the rect
+ * _PGFT_Render_ExistingSurface would return for it.
+ */
+typedef struct rendermanyitem_ {
+    PGFT_String *text;
+    int x;
+    int y;
+    SDL_Rect r;
+} RenderManyItem;
+
+/* Layout cache: the layouts of the strings last rendered, looked up by
+ * text and render mode, so text drawn every frame is not laid out again.
+ * An entry also keeps the surface Font.render_cached last returned for it.
+ * When full, the entry least recently used is reused.
+ */
+#define PGFT_LAYOUT_CACHE_SIZE 64
+
+typedef struct layoutentry_ {
+    Layout layout;
+    PGFT_String *text;      /* 0 if the entry is unused */
+    FT_UInt32 hash;
+    FT_UInt32 generation;   /* of the glyph cache the glyphs came from */
+    unsigned long last_use;
+
+    PyObject *surface;      /* 0, or kept by Font.render_cached */
+    FontRenderMode surface_mode;
+    FontColor surface_fg;
+    FontColor surface_bg;
+    int surface_has_bg;
+    SDL_Rect surface_rect;
+} LayoutEntry;
+
+typedef struct layoutcache_ {
+    LayoutEntry *entries;   /* allocated on first use */
+    LayoutEntry *active;    /* the layout last loaded, or 0 */
+    int count;
+    unsigned long clock;
+    unsigned long hits;
+    unsigned long misses;
+} LayoutCache;
+
+typedef struct fontinternals_ {
+    LayoutCache layouts;
+    FontCache *glyph_cache;     /* own_cache, or one shared with other fonts */
+    FontCache own_cache;
+    int busy;                   /* Font.prewarm or Font.render_many_to
+                                   has released the GIL */
+    GlyphAtlas atlases[PGFT_ATLAS_COUNT];
+    unsigned long atlas_clock;
+} FontInternals;
+
 #if defined(PGFT_DEBUG_CACHE)
-#define PGFT_FONT_CACHE(f) ((f)->_internals->glyph_cache)
+#define PGFT_FONT_CACHE(f) (*(f)->_internals->glyph_cache)
 #endif
 
 /**********************************************************
@@ -280,7 +375,7 @@ int _PGFT_Font_GetAvailableSize(FreeTypeInstance *, PgFontObject *, unsigned,
                                 long *, long *, long *, double *, double *);
 const char *_PGFT_Font_GetName(FreeTypeInstance *, PgFontObject *);
 int _PGFT_TryLoadFont_Filename(FreeTypeInstance *,
-                               PgFontObject *, const char *, long);
+                               PgFontObject *, const char *, long, int);
 #ifdef HAVE_PYGAME_SDL_RWOPS
 int _PGFT_TryLoadFont_RWops(FreeTypeInstance *,
                             PgFontObject *, SDL_RWops *, long);
@@ -312,6 +407,16 @@ int _PGFT_Render_ExistingSurface(FreeTypeInstance *, PgFontObject *,
                                  const FontRenderMode *, PGFT_String *,
                                  SDL_Surface *, int, int,
                                  FontColor *, FontColor *, SDL_Rect *);
+int _PGFT_Render_Many(FreeTypeInstance *, PgFontObject *,
+                      const FontRenderMode *, RenderManyItem *, Py_ssize_t,
+                      SDL_Surface *, FontColor *, FontColor *);
+int _PGFT_Render_AtlasSurface(FreeTypeInstance *, PgFontObject *,
+                              const FontRenderMode *, PGFT_String *,
+                              PyObject *, int, int,
+                              FontColor *, FontColor *, SDL_Rect *);
+PyObject *_PGFT_Render_Cached(FreeTypeInstance *, PgFontObject *,
+                              const FontRenderMode *, PGFT_String *,
+                              FontColor *, FontColor *, SDL_Rect *);
 int _PGFT_Render_Array(FreeTypeInstance *, PgFontObject *,
                        const FontRenderMode *, PyObject *,
                        PGFT_String *, int, int, int, SDL_Rect *);
@@ -373,16 +478,32 @@ void _PGFT_LayoutFree(PgFontObject *);
 Layout *_PGFT_LoadLayout(FreeTypeInstance *, PgFontObject *,
                          const FontRenderMode *, PGFT_String *);
 int _PGFT_LoadGlyph(FontGlyph *, GlyphIndex_t, const FontRenderMode *, void *);
+int _PGFT_Prewarm(FreeTypeInstance *, PgFontObject *,
+                  const FontRenderMode *, PGFT_String *);
 
 
 /**************************************** Glyph cache management *************/
 int _PGFT_Cache_Init(FreeTypeInstance *, FontCache *);
 void _PGFT_Cache_Destroy(FontCache *);
 void _PGFT_Cache_Cleanup(FontCache *);
+FontCache *_PGFT_Cache_GetShared(FreeTypeInstance *, const char *, FT_Long,
+                                 FT_UInt);
+void _PGFT_Cache_ReleaseShared(FreeTypeInstance *, FontCache *);
+int _PGFT_Cache_HasGlyph(GlyphIndex_t, const FontRenderMode *, FontCache *);
+int _PGFT_Cache_AddGlyph(GlyphIndex_t, const FontRenderMode *, FontCache *,
+                         FontGlyph *);
 FontGlyph *_PGFT_Cache_FindGlyph(FT_UInt32, const FontRenderMode *,
                                  FontCache *, void *);
 
 
+/**************************************** Glyph atlases **********************/
+GlyphAtlas *_PGFT_Atlas_Get(FontInternals *, const FontRenderMode *,
+                            const FontColor *);
+int _PGFT_Atlas_Place(GlyphAtlas *, GlyphIndex_t, const FT_Bitmap *,
+                      SDL_Rect *);
+void _PGFT_Atlas_Free(FontInternals *);
+
+
 /**************************************** Unicode ****************************/
 PGFT_String *_PGFT_EncodePyString(PyObject *, int);
 #define PGFT_String_GET_DATA(s) ((s)->data)
@@ -58,7 +58,11 @@ static PyObject* _gfx_polygoncolor (PyObject *self, PyObject* args);
 static PyObject* _gfx_aapolygoncolor (PyObject *self, PyObject* args);
 static PyObject* _gfx_filledpolygoncolor (PyObject *self, PyObject* args);
 static PyObject* _gfx_texturedpolygon (PyObject *self, PyObject* args);
+static PyObject* _gfx_texturedpolygonuv (PyObject *self, PyObject* args);
 static PyObject* _gfx_beziercolor (PyObject *self, PyObject* args);
+static PyObject* _gfx_setshapecachesize (PyObject *self, PyObject* args);
+static PyObject* _gfx_getshapecachesize (PyObject *self);
+static PyObject* _gfx_getshapecachestats (PyObject *self);
 
 static PyMethodDef _gfxdraw_methods[] = {
     { "pixel", _gfx_pixelcolor, METH_VARARGS, DOC_PYGAMEGFXDRAWPIXEL },
@@ -82,7 +86,15 @@ static PyMethodDef _gfxdraw_methods[] = {
     { "aapolygon", _gfx_aapolygoncolor, METH_VARARGS, DOC_PYGAMEGFXDRAWAAPOLYGON },
     { "filled_polygon", _gfx_filledpolygoncolor, METH_VARARGS, DOC_PYGAMEGFXDRAWFILLEDPOLYGON },
     { "textured_polygon", _gfx_texturedpolygon, METH_VARARGS, DOC_PYGAMEGFXDRAWTEXTUREDPOLYGON },
+    { "textured_polygon_uv", _gfx_texturedpolygonuv, METH_VARARGS,
+      DOC_PYGAMEGFXDRAWTEXTUREDPOLYGONUV },
     { "bezier", _gfx_beziercolor, METH_VARARGS, DOC_PYGAMEGFXDRAWBEZIER },
+    { "set_shape_cache_size", _gfx_setshapecachesize, METH_VARARGS,
+      DOC_PYGAMEGFXDRAWSETSHAPECACHESIZE },
+    { "get_shape_cache_size", (PyCFunction) _gfx_getshapecachesize,
+      METH_NOARGS, DOC_PYGAMEGFXDRAWGETSHAPECACHESIZE },
+    { "get_shape_cache_stats", (PyCFunction) _gfx_getshapecachestats,
+      METH_NOARGS, DOC_PYGAMEGFXDRAWGETSHAPECACHESTATS },
     { NULL, NULL, 0, NULL },
 };
 
@@ -122,6 +134,231 @@ Sint16FromSeqIndex (PyObject* obj, Py_ssize_t _index, Sint16* val)
     return result;
 }
 
+/* Add the box with the corners (x1, y1) and (x2, y2) to the damage of
+ * surface, with a pixel more around it for the anti-aliased shapes.
+ */
+static void
+_gfx_damage (PyObject *surface, int x1, int y1, int x2, int y2)
+{
+    SDL_Surface *surf = PySurface_AsSurface (surface);
+    int left = MAX (MIN (x1, x2) - 1, 0);
+    int top = MAX (MIN (y1, y2) - 1, 0);
+    int right = MIN (MAX (x1, x2) + 2, surf->w);
+    int bottom = MIN (MAX (y1, y2) + 2, surf->h);
+    SDL_Rect r;
+
+    if (right <= left || bottom <= top)
+        return;
+    r.x = (Sint16) left;
+    r.y = (Sint16) top;
+    r.w = (Uint16) (right - left);
+    r.h = (Uint16) (bottom - top);
+    PySurface_AddDamage (surface, &r);
+}
+
+static void
+_gfx_damage_points (PyObject *surface, Sint16 *vx, Sint16 *vy, int count)
+{
+    int left = vx[0], right = vx[0], top = vy[0], bottom = vy[0];
+    int i;
+
+    for (i = 1; i < count; i++)
+    {
+        left = MIN (left, vx[i]);
+        right = MAX (right, vx[i]);
+        top = MIN (top, vy[i]);
+        bottom = MAX (bottom, vy[i]);
+    }
+    _gfx_damage (surface, left, top, right, bottom);
+}
+
+/* The shape cache keeps the recorded spans and weighted pixels of filled
+ * circles, filled ellipses and anti-aliased ellipses by radii, so drawing
+ * the same radii again only blends them at the new center. Shapes with a
+ * radius above GFX_SHAPE_MAX_RADIUS are drawn directly, and the least
+ * recently drawn shape makes room when the cache is full.
+ */
+#define GFX_SHAPE_FILLED_CIRCLE 0
+#define GFX_SHAPE_FILLED_ELLIPSE 1
+#define GFX_SHAPE_AAELLIPSE 2
+
+#define GFX_SHAPE_CACHE_SIZE 64
+#define GFX_SHAPE_MAX_CACHE_SIZE 65536
+#define GFX_SHAPE_MAX_RADIUS 512
+
+typedef struct
+{
+    int kind;
+    Sint16 rx, ry;
+    unsigned long used;     /* clock of the last draw */
+    int next;               /* next entry in the same bucket, or -1 */
+    SDL_gfxShape shape;
+} _GfxShapeEntry;
+
+static struct
+{
+    _GfxShapeEntry *entries;
+    int *buckets;           /* first entry of each bucket, or -1 */
+    int size;               /* most shapes kept, 0 for none */
+    int count;
+    unsigned long clock;
+    unsigned long hits, misses, evictions;
+    size_t bytes;
+} _gfx_shapes = { NULL, NULL, GFX_SHAPE_CACHE_SIZE, 0, 0, 0, 0, 0, 0 };
+
+static void
+_gfx_shape_cache_clear (void)
+{
+    int i;
+
+    for (i = 0; i < _gfx_shapes.count; i++)
+        freeShape (&_gfx_shapes.entries[i].shape);
+    PyMem_Del (_gfx_shapes.entries);
+    PyMem_Del (_gfx_shapes.buckets);
+    _gfx_shapes.entries = NULL;
+    _gfx_shapes.buckets = NULL;
+    _gfx_shapes.count = 0;
+    _gfx_shapes.bytes = 0;
+}
+
+static int
+_gfx_shape_bucket (int kind, Sint16 rx, Sint16 ry)
+{
+    Uint32 h = ((Uint32) kind * 0x9e3779b1) ^ ((Uint32) rx * 0x85ebca6b) ^
+        ((Uint32) ry * 0xc2b2ae35);
+
+    return (int) ((h ^ (h >> 15)) % (Uint32) _gfx_shapes.size);
+}
+
+/* Return the cached shape of the radii, recording it on a miss, or NULL
+ * when the shape is not cached and should be drawn directly.
+ */
+static const SDL_gfxShape*
+_gfx_shape_find (int kind, Sint16 rx, Sint16 ry)
+{
+    _GfxShapeEntry *entry;
+    int *link;
+    int b, i, slot;
+
+    if (_gfx_shapes.size == 0 || rx < 0 || ry < 0 ||
+        rx > GFX_SHAPE_MAX_RADIUS || ry > GFX_SHAPE_MAX_RADIUS)
+        return NULL;
+
+    if (!_gfx_shapes.entries)
+    {
+        _gfx_shapes.entries = PyMem_New (_GfxShapeEntry, _gfx_shapes.size);
+        _gfx_shapes.buckets = PyMem_New (int, _gfx_shapes.size);
+        if (!_gfx_shapes.entries || !_gfx_shapes.buckets)
+        {
+            _gfx_shape_cache_clear ();
+            return NULL;
+        }
+        for (b = 0; b < _gfx_shapes.size; b++)
+            _gfx_shapes.buckets[b] = -1;
+    }
+
+    b = _gfx_shape_bucket (kind, rx, ry);
+    for (i = _gfx_shapes.buckets[b]; i >= 0; i = entry->next)
+    {
+        entry = &_gfx_shapes.entries[i];
+        if (entry->kind == kind && entry->rx == rx && entry->ry == ry)
+        {
+            entry->used = ++_gfx_shapes.clock;
+            _gfx_shapes.hits++;
+            return &entry->shape;
+        }
+    }
+    _gfx_shapes.misses++;
+
+    if (_gfx_shapes.count < _gfx_shapes.size)
+        slot = _gfx_shapes.count++;
+    else
+    {
+        /* Evict the least recently drawn shape */
+        slot = 0;
+        for (i = 1; i < _gfx_shapes.count; i++)
+        {
+            if (_gfx_shapes.entries[i].used < _gfx_shapes.entries[slot].used)
+                slot = i;
+        }
+        entry = &_gfx_shapes.entries[slot];
+        link = &_gfx_shapes.buckets[_gfx_shape_bucket (entry->kind,
+                                                       entry->rx, entry->ry)];
+        while (*link != slot)
+            link = &_gfx_shapes.entries[*link].next;
+        *link = entry->next;
+        _gfx_shapes.bytes -= sizeof (SDL_gfxShapeItem) * entry->shape.size;
+        freeShape (&entry->shape);
+        _gfx_shapes.evictions++;
+    }
+
+    entry = &_gfx_shapes.entries[slot];
+    memset (&entry->shape, 0, sizeof (entry->shape));
+    switch (kind)
+    {
+    case GFX_SHAPE_FILLED_CIRCLE:
+        i = filledCircleShape (&entry->shape, rx);
+        break;
+    case GFX_SHAPE_FILLED_ELLIPSE:
+        i = filledEllipseShape (&entry->shape, rx, ry);
+        break;
+    default:
+        i = aaellipseShape (&entry->shape, rx, ry);
+        break;
+    }
+    if (i == -1)
+    {
+        /* Out of memory: give the slot back, moving the last entry into it */
+        freeShape (&entry->shape);
+        _gfx_shapes.count--;
+        if (slot != _gfx_shapes.count)
+        {
+            link = &_gfx_shapes.buckets[_gfx_shape_bucket (
+                _gfx_shapes.entries[_gfx_shapes.count].kind,
+                _gfx_shapes.entries[_gfx_shapes.count].rx,
+                _gfx_shapes.entries[_gfx_shapes.count].ry)];
+            while (*link != _gfx_shapes.count)
+                link = &_gfx_shapes.entries[*link].next;
+            *link = slot;
+            *entry = _gfx_shapes.entries[_gfx_shapes.count];
+        }
+        return NULL;
+    }
+
+    entry->kind = kind;
+    entry->rx = rx;
+    entry->ry = ry;
+    entry->used = ++_gfx_shapes.clock;
+    entry->next = _gfx_shapes.buckets[b];
+    _gfx_shapes.buckets[b] = slot;
+    _gfx_shapes.bytes += sizeof (SDL_gfxShapeItem) * entry->shape.size;
+    return &entry->shape;
+}
+
+/* Draw a filled circle, filled ellipse or anti-aliased ellipse, from the
+ * shape cache when it keeps the radii.
+ */
+static int
+_gfx_shape_draw (SDL_Surface *surf, int kind, Sint16 x, Sint16 y, Sint16 rx,
+                 Sint16 ry, Uint8 *rgba)
+{
+    Uint32 color = ((Uint32) rgba[0] << 24) | ((Uint32) rgba[1] << 16) |
+        ((Uint32) rgba[2] << 8) | (Uint32) rgba[3];
+    const SDL_gfxShape *shape = _gfx_shape_find (kind, rx, ry);
+
+    if (shape)
+        return shapeColor (surf, shape, x, y, color);
+    switch (kind)
+    {
+    case GFX_SHAPE_FILLED_CIRCLE:
+        return filledCircleColor (surf, x, y, rx, color);
+    case GFX_SHAPE_FILLED_ELLIPSE:
+        return filledEllipseColor (surf, x, y, rx, ry, color);
+    default:
+        return aaellipseColor (surf, x, y, rx, ry, color);
+    }
+}
+
 static PyObject*
 _gfx_pixelcolor (PyObject *self, PyObject* args)
 {
@@ -145,12 +382,14 @@ _gfx_pixelcolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (pixelRGBA (PySurface_AsSurface (surface), x, y,
                    rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x, y, x, y);
     Py_RETURN_NONE;
 }
 
@@ -177,12 +416,14 @@ _gfx_hlinecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (hlineRGBA (PySurface_AsSurface (surface), x1, x2, y,
                    rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x1, y, x2, y);
     Py_RETURN_NONE;
 }
 
@@ -210,12 +451,14 @@ _gfx_vlinecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (vlineRGBA (PySurface_AsSurface (surface), x, _y1, y2,
                    rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x, _y1, x, y2);
     Py_RETURN_NONE;
 }
 
@@ -252,12 +495,14 @@ _gfx_rectanglecolor (PyObject *self, PyObject* args)
     x2 = (Sint16) (sdlrect->x + sdlrect->w - 1);
     y2 = (Sint16) (sdlrect->y + sdlrect->h - 1);
 
+    PySurface_DropRLE (surface);
     if (rectangleRGBA (PySurface_AsSurface (surface), x1, _y1, x2, y2,
                        rgba[0], rgba[1], rgba[2], rgba[3]) ==
         -1) {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x1, _y1, x2, y2);
     Py_RETURN_NONE;
 }
 
@@ -293,12 +538,14 @@ _gfx_boxcolor (PyObject *self, PyObject* args)
     x2 = (Sint16) (sdlrect->x + sdlrect->w - 1);
     y2 = (Sint16) (sdlrect->y + sdlrect->h - 1);
 
+    PySurface_DropRLE (surface);
     if (boxRGBA (PySurface_AsSurface (surface), x1, _y1, x2, y2,
                  rgba[0], rgba[1], rgba[2], rgba[3]) ==
         -1) {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x1, _y1, x2, y2);
     Py_RETURN_NONE;
 }
 
@@ -326,12 +573,14 @@ _gfx_linecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (lineRGBA (PySurface_AsSurface (surface), x1, _y1, x2, y2,
                   rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x1, _y1, x2, y2);
     Py_RETURN_NONE;
 }
 
@@ -358,12 +607,14 @@ _gfx_circlecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (circleRGBA (PySurface_AsSurface (surface), x, y, r,
                     rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -391,12 +642,14 @@ _gfx_arccolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (arcRGBA (PySurface_AsSurface (surface), x, y, r, start, end,
                  rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -424,12 +677,14 @@ _gfx_aacirclecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
-    if (aacircleRGBA (PySurface_AsSurface (surface), x, y, r,
-                      rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
+    PySurface_DropRLE (surface);
+    if (_gfx_shape_draw (PySurface_AsSurface (surface), GFX_SHAPE_AAELLIPSE,
+                         x, y, r, r, rgba) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -457,12 +712,14 @@ _gfx_filledcirclecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
-    if (filledCircleRGBA (PySurface_AsSurface (surface), x, y, r,
-                          rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
+    PySurface_DropRLE (surface);
+    if (_gfx_shape_draw (PySurface_AsSurface (surface),
+                         GFX_SHAPE_FILLED_CIRCLE, x, y, r, r, rgba) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -490,12 +747,14 @@ _gfx_ellipsecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (ellipseRGBA (PySurface_AsSurface (surface), x, y, rx, ry,
                      rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - rx, y - ry, x + rx, y + ry);
     Py_RETURN_NONE;
 }
 
@@ -523,12 +782,14 @@ _gfx_aaellipsecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
-    if (aaellipseRGBA (PySurface_AsSurface (surface), x, y, rx, ry,
-                       rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
+    PySurface_DropRLE (surface);
+    if (_gfx_shape_draw (PySurface_AsSurface (surface), GFX_SHAPE_AAELLIPSE,
+                         x, y, rx, ry, rgba) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - rx, y - ry, x + rx, y + ry);
     Py_RETURN_NONE;
 }
 
@@ -556,13 +817,14 @@ _gfx_filledellipsecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
-    if (filledEllipseRGBA (PySurface_AsSurface (surface), x, y, rx, ry,
-                           rgba[0], rgba[1], rgba[2], rgba[3]) ==
-        -1)
+    PySurface_DropRLE (surface);
+    if (_gfx_shape_draw (PySurface_AsSurface (surface),
+                         GFX_SHAPE_FILLED_ELLIPSE, x, y, rx, ry, rgba) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - rx, y - ry, x + rx, y + ry);
     Py_RETURN_NONE;
 }
 
@@ -590,12 +852,14 @@ _gfx_piecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (pieRGBA (PySurface_AsSurface (surface), x, y, r, start, end,
                  rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -623,6 +887,7 @@ _gfx_trigoncolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (trigonRGBA (PySurface_AsSurface (surface), x1, _y1, x2, y2, x3, y3,
                     rgba[0], rgba[1], rgba[2], rgba[3])
         == -1)
@@ -630,6 +895,8 @@ _gfx_trigoncolor (PyObject *self, PyObject* args)
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, MIN (x1, MIN (x2, x3)), MIN (_y1, MIN (y2, y3)),
+                 MAX (x1, MAX (x2, x3)), MAX (_y1, MAX (y2, y3)));
     Py_RETURN_NONE;
 }
 
@@ -657,12 +924,15 @@ _gfx_aatrigoncolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (aatrigonRGBA (PySurface_AsSurface (surface), x1, _y1, x2, y2, x3, y3,
                       rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, MIN (x1, MIN (x2, x3)), MIN (_y1, MIN (y2, y3)),
+                 MAX (x1, MAX (x2, x3)), MAX (_y1, MAX (y2, y3)));
     Py_RETURN_NONE;
 }
 
@@ -690,12 +960,15 @@ _gfx_filledtrigoncolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    PySurface_DropRLE (surface);
     if (filledTrigonRGBA (PySurface_AsSurface (surface), x1, _y1, x2, y2,
                           x3, y3, rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
         PyErr_SetString (PyExc_SDLError, SDL_GetError ());
         return NULL;
     }
+    _gfx_damage (surface, MIN (x1, MIN (x2, x3)), MIN (_y1, MIN (y2, y3)),
+                 MAX (x1, MAX (x2, x3)), MAX (_y1, MAX (y2, y3)));
     Py_RETURN_NONE;
 }
 
@@ -770,11 +1043,13 @@ _gfx_polygoncolor (PyObject *self, PyObject* args)
         vy[i] = y;
     }
 
+    PySurface_DropRLE (surface);
     Py_BEGIN_ALLOW_THREADS;
     ret = polygonRGBA (PySurface_AsSurface (surface), vx, vy, (int)count,
                        rgba[0], rgba[1], rgba[2], rgba[3]);
     Py_END_ALLOW_THREADS;
 
+    _gfx_damage_points (surface, vx, vy, (int)count);
     PyMem_Free (vx);
     PyMem_Free (vy);
 
@@ -857,11 +1132,13 @@ _gfx_aapolygoncolor (PyObject *self, PyObject* args)
         vy[i] = y;
     }
 
+    PySurface_DropRLE (surface);
     Py_BEGIN_ALLOW_THREADS;
     ret = aapolygonRGBA (PySurface_AsSurface (surface), vx, vy, (int)count,
                          rgba[0], rgba[1], rgba[2], rgba[3]);
     Py_END_ALLOW_THREADS;
 
+    _gfx_damage_points (surface, vx, vy, (int)count);
     PyMem_Free (vx);
     PyMem_Free (vy);
 
@@ -945,11 +1222,13 @@ _gfx_filledpolygoncolor (PyObject *self, PyObject* args)
         vy[i] = y;
     }
 
+    PySurface_DropRLE (surface);
     Py_BEGIN_ALLOW_THREADS;
     ret = filledPolygonRGBA (PySurface_AsSurface (surface), vx, vy,
                              (int)count, rgba[0], rgba[1], rgba[2], rgba[3]);
     Py_END_ALLOW_THREADS;
 
+    _gfx_damage_points (surface, vx, vy, (int)count);
     PyMem_Free (vx);
     PyMem_Free (vy);
 
@@ -961,14 +1240,390 @@ _gfx_filledpolygoncolor (PyObject *self, PyObject* args)
     Py_RETURN_NONE;
 }
 
+/* Textured polygons are drawn here span by span, reading the texture
+ * pixels directly and stepping the texture coordinates in 16.16 fixed
+ * point, rather than blitting every scanline through SDL.
+ */
+#define TEXSPAN_NONE    -1  /* leave it to SDL_gfx */
+#define TEXSPAN_COPY    0   /* same pixel format, opaque texture */
+#define TEXSPAN_BLEND32 1   /* 32 bit per-pixel alpha onto 32 bit */
+#define TEXSPAN_ANY     2   /* any formats, through SDL_GetRGBA */
+
+typedef struct
+{
+    int x;                  /* scanline crossing, 16.16 */
+    double cx, u, v;        /* crossing and texture coordinate at the
+                             * middle of the scanline */
+} _TexEdge;
+
+typedef struct
+{
+    SDL_Surface *dst;
+    SDL_Surface *tex;
+    int mode;
+    int blend;              /* per-pixel or surface alpha is used */
+    int key;                /* texture colorkey is used */
+    Uint8 alpha;            /* alpha when the texture has no Amask */
+    Uint32 tw, th;          /* texture size, 16.16 */
+} _TexSpan;
+
+static int
+_tex_span_setup (_TexSpan *ts, SDL_Surface *dst, SDL_Surface *tex)
+{
+    SDL_PixelFormat *df = dst->format, *tf = tex->format;
+    int ppa = (tex->flags & SDL_SRCALPHA) && tf->Amask;
+    int same = df->BytesPerPixel == tf->BytesPerPixel &&
+        df->Rmask == tf->Rmask && df->Gmask == tf->Gmask &&
+        df->Bmask == tf->Bmask && df->Amask == tf->Amask;
+
+    ts->dst = dst;
+    ts->tex = tex;
+    ts->blend = (tex->flags & SDL_SRCALPHA) != 0;
+    ts->key = (tex->flags & SDL_SRCCOLORKEY) && !ppa;
+    ts->alpha = (ts->blend && !tf->Amask) ? tf->alpha : 255;
+    ts->tw = (Uint32) tex->w << 16;
+    ts->th = (Uint32) tex->h << 16;
+
+    /* Coordinates wrap in 16.16, so the texture must fit in 15 bits */
+    if (tex->w < 1 || tex->h < 1 || tex->w > 32767 || tex->h > 32767)
+        ts->mode = TEXSPAN_NONE;
+    else if (same && df->BytesPerPixel > 1 && !ts->blend && !ts->key)
+        ts->mode = TEXSPAN_COPY;
+    else if (same && df->BytesPerPixel == 4 && ppa &&
+             tf->Amask == 0xff000000)
+        ts->mode = TEXSPAN_BLEND32;
+    else
+        ts->mode = TEXSPAN_ANY;
+    return ts->mode;
+}
+
+/* Wrap the texture coordinate t into [0, size) as 16.16 */
+static Uint32
+_tex_wrap (double t, int size)
+{
+    Uint32 limit = (Uint32) size << 16;
+    Uint32 fixed;
+
+    t = fmod (t, (double) size);
+    if (t < 0)
+        t += size;
+    fixed = (Uint32) (t * 65536.0);
+    return fixed >= limit ? fixed - limit : fixed;
+}
+
+static Uint32
+_tex_get (Uint8 *p, int bpp)
+{
+    switch (bpp)
+    {
+    case 1:
+        return *p;
+    case 2:
+        return *((Uint16 *) p);
+    case 3:
+        return GET_PIXEL_24 (p);
+    default:
+        return *((Uint32 *) p);
+    }
+}
+
+static void
+_tex_put (Uint8 *p, int bpp, Uint32 pixel)
+{
+    switch (bpp)
+    {
+    case 1:
+        *p = (Uint8) pixel;
+        break;
+    case 2:
+        *((Uint16 *) p) = (Uint16) pixel;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        p[0] = (Uint8) pixel;
+        p[1] = (Uint8) (pixel >> 8);
+        p[2] = (Uint8) (pixel >> 16);
+#else
+        p[0] = (Uint8) (pixel >> 16);
+        p[1] = (Uint8) (pixel >> 8);
+        p[2] = (Uint8) pixel;
+#endif
+        break;
+    default:
+        *((Uint32 *) p) = pixel;
+        break;
+    }
+}
+
+/* Draw the pixels x1 to x2 of row y, starting at the texture coordinate
+ * (u, v) and stepping it by (du, dv) per pixel, all wrapped 16.16.
+ */
+static void
+_tex_span (_TexSpan *ts, int x1, int x2, int y, Uint32 u, Uint32 v,
+           Uint32 du, Uint32 dv)
+{
+    SDL_Surface *dst = ts->dst, *tex = ts->tex;
+    SDL_PixelFormat *df = dst->format, *tf = tex->format;
+    int bpp = df->BytesPerPixel, tbpp = tf->BytesPerPixel;
+    Uint8 *dp = (Uint8 *) dst->pixels + y * dst->pitch + x1 * bpp;
+    Uint8 *texels = (Uint8 *) tex->pixels;
+    int x, run;
+
+#define TEXEL() (texels + (v >> 16) * tex->pitch + (u >> 16) * tbpp)
+#define TEXSTEP()                               \
+    u += du;                                    \
+    if (u >= ts->tw)                            \
+        u -= ts->tw;                            \
+    v += dv;                                    \
+    if (v >= ts->th)                            \
+        v -= ts->th
+
+    switch (ts->mode)
+    {
+    case TEXSPAN_COPY:
+        if (du == 0x10000 && dv == 0)
+        {
+            /* An unscaled row: copy it in runs up to the texture edge */
+            for (x = x1; x <= x2; x += run)
+            {
+                run = MIN (x2 - x + 1, tex->w - (int) (u >> 16));
+                memcpy (dp, TEXEL (), (size_t) (run * bpp));
+                dp += run * bpp;
+                u = 0;
+            }
+        }
+        else if (bpp == 4)
+        {
+            for (x = x1; x <= x2; x++, dp += 4)
+            {
+                *((Uint32 *) dp) = *((Uint32 *) TEXEL ());
+                TEXSTEP ();
+            }
+        }
+        else
+        {
+            for (x = x1; x <= x2; x++, dp += bpp)
+            {
+                _tex_put (dp, bpp, _tex_get (TEXEL (), bpp));
+                TEXSTEP ();
+            }
+        }
+        break;
+
+    case TEXSPAN_BLEND32:
+        /* The blend of SDL's RGB to RGB per-pixel alpha blitter, which
+         * leaves the destination alpha alone.
+         */
+        for (x = x1; x <= x2; x++, dp += 4)
+        {
+            Uint32 s = *((Uint32 *) TEXEL ());
+            Uint32 d = *((Uint32 *) dp);
+            Uint32 a = s >> 24;
+
+            if (a == 255)
+                *((Uint32 *) dp) = (s & 0x00ffffff) | (d & 0xff000000);
+            else if (a)
+            {
+                Uint32 s1 = s & 0xff00ff, d1 = d & 0xff00ff;
+                Uint32 s2 = s & 0xff00, d2 = d & 0xff00;
+
+                d1 = (d1 + ((s1 - d1) * a >> 8)) & 0xff00ff;
+                d2 = (d2 + ((s2 - d2) * a >> 8)) & 0xff00;
+                *((Uint32 *) dp) = d1 | d2 | (d & 0xff000000);
+            }
+            TEXSTEP ();
+        }
+        break;
+
+    default:
+        for (x = x1; x <= x2; x++, dp += bpp)
+        {
+            Uint32 pixel = _tex_get (TEXEL (), tbpp);
+            Uint8 r, g, b, a, dr, dg, db, da;
+
+            if (!ts->key || pixel != tf->colorkey)
+            {
+                SDL_GetRGBA (pixel, tf, &r, &g, &b, &a);
+                if (!tf->Amask)
+                    a = ts->alpha;
+                if (!ts->blend)
+                    _tex_put (dp, bpp, SDL_MapRGBA (df, r, g, b, a));
+                else if (a)
+                {
+                    SDL_GetRGBA (_tex_get (dp, bpp), df, &dr, &dg, &db, &da);
+                    if (a < 255)
+                    {
+                        r = (Uint8) (dr + (((int) r - dr) * a >> 8));
+                        g = (Uint8) (dg + (((int) g - dg) * a >> 8));
+                        b = (Uint8) (db + (((int) b - db) * a >> 8));
+                    }
+                    _tex_put (dp, bpp, SDL_MapRGBA (df, r, g, b, da));
+                }
+            }
+            TEXSTEP ();
+        }
+        break;
+    }
+#undef TEXEL
+#undef TEXSTEP
+}
+
+static int
+_tex_edge_cmp (const void *a, const void *b)
+{
+    int xa = ((const _TexEdge *) a)->x, xb = ((const _TexEdge *) b)->x;
+
+    return (xa > xb) - (xa < xb);
+}
+
+/* Fill the polygon with the texture. The scanlines are found as
+ * SDL_gfx's texturedPolygon() finds them, so both cover the same
+ * pixels. Without vu and vv the texture is offset by (tdx, tdy) as in
+ * texturedPolygon(), else vu and vv are the texture coordinates of the
+ * vertices, interpolated along the edges and then the spans to the
+ * middle of each pixel. edges must have room for n crossings.
+ */
+static int
+_tex_polygon (_TexSpan *ts, const Sint16 *vx, const Sint16 *vy,
+              const float *vu, const float *vv, int n, int tdx, int tdy,
+              _TexEdge *edges)
+{
+    SDL_Surface *dst = ts->dst, *tex = ts->tex;
+    int left = dst->clip_rect.x, right = left + dst->clip_rect.w - 1;
+    int top = dst->clip_rect.y, bottom = top + dst->clip_rect.h - 1;
+    int miny = vy[0], maxy = vy[0];
+    int i, y, ints, xa, xb, tmp;
+    Uint32 one = _tex_wrap (1.0, tex->w);
+    double dudx = 0, dvdx = 0, area = 0;
+
+    if (dst->clip_rect.w == 0 || dst->clip_rect.h == 0)
+        return 0;
+    for (i = 1; i < n; i++)
+    {
+        miny = MIN (miny, vy[i]);
+        maxy = MAX (maxy, vy[i]);
+    }
+
+    /* Spans too short to step between their edges take the gradient
+     * of the largest triangle fanned from the first vertex.
+     */
+    for (i = 1; vu && i + 1 < n; i++)
+    {
+        double x1 = vx[i] - vx[0], y1 = vy[i] - vy[0];
+        double x2 = vx[i + 1] - vx[0], y2 = vy[i + 1] - vy[0];
+        double det = x1 * y2 - x2 * y1;
+
+        if (fabs (det) > area)
+        {
+            area = fabs (det);
+            dudx = ((vu[i] - vu[0]) * y2 - (vu[i + 1] - vu[0]) * y1) / det;
+            dvdx = ((vv[i] - vv[0]) * y2 - (vv[i + 1] - vv[0]) * y1) / det;
+        }
+    }
+
+    if (SDL_MUSTLOCK (dst) && SDL_LockSurface (dst) < 0)
+        return -1;
+    if (SDL_MUSTLOCK (tex) && SDL_LockSurface (tex) < 0)
+    {
+        if (SDL_MUSTLOCK (dst))
+            SDL_UnlockSurface (dst);
+        return -1;
+    }
+
+    for (y = MAX (miny, top); y <= MIN (maxy, bottom); y++)
+    {
+        ints = 0;
+        for (i = 0; i < n; i++)
+        {
+            int a = i ? i - 1 : n - 1, b = i;
+            int y1, y2;
+
+            if (vy[a] == vy[b])
+                continue;
+            if (vy[a] > vy[b])
+            {
+                a = i;
+                b = i ? i - 1 : n - 1;
+            }
+            y1 = vy[a];
+            y2 = vy[b];
+            if ((y >= y1 && y < y2) || (y == maxy && y > y1 && y <= y2))
+            {
+                _TexEdge *e = edges + ints++;
+
+                e->x = ((65536 * (y - y1)) / (y2 - y1)) * (vx[b] - vx[a]) +
+                    65536 * vx[a];
+                if (vu)
+                {
+                    double t = MIN ((y + 0.5 - y1) / (y2 - y1), 1.0);
+
+                    e->cx = vx[a] + (vx[b] - vx[a]) * t;
+                    e->u = vu[a] + (vu[b] - vu[a]) * t;
+                    e->v = vv[a] + (vv[b] - vv[a]) * t;
+                }
+            }
+        }
+        qsort (edges, (size_t) ints, sizeof (_TexEdge), _tex_edge_cmp);
+
+        for (i = 0; i + 1 < ints; i += 2)
+        {
+            xa = edges[i].x + 1;
+            xa = (xa >> 16) + ((xa & 32768) >> 15);
+            xb = edges[i + 1].x - 1;
+            xb = (xb >> 16) + ((xb & 32768) >> 15);
+            if (xa > xb)
+            {
+                tmp = xa;
+                xa = xb;
+                xb = tmp;
+            }
+            xa = MAX (xa, left);
+            xb = MIN (xb, right);
+            if (xa > xb)
+                continue;
+
+            if (vu)
+            {
+                /* Sample at the middle of the first pixel */
+                double x0 = edges[i].cx - 0.5;
+                double w = edges[i + 1].cx - edges[i].cx;
+                double du = dudx, dv = dvdx;
+
+                if (w >= 1)
+                {
+                    du = (edges[i + 1].u - edges[i].u) / w;
+                    dv = (edges[i + 1].v - edges[i].v) / w;
+                }
+                _tex_span (ts, xa, xb, y,
+                           _tex_wrap (edges[i].u + (xa - x0) * du, tex->w),
+                           _tex_wrap (edges[i].v + (xa - x0) * dv, tex->h),
+                           _tex_wrap (du, tex->w), _tex_wrap (dv, tex->h));
+            }
+            else
+            {
+                _tex_span (ts, xa, xb, y, _tex_wrap (xa - tdx, tex->w),
+                           _tex_wrap (y + tdy, tex->h), one, 0);
+            }
+        }
+    }
+
+    if (SDL_MUSTLOCK (tex))
+        SDL_UnlockSurface (tex);
+    if (SDL_MUSTLOCK (dst))
+        SDL_UnlockSurface (dst);
+    return 0;
+}
+
 static PyObject*
 _gfx_texturedpolygon (PyObject *self, PyObject* args)
 {
     PyObject *surface, *texture, *points, *item;
     SDL_Surface *s_surface, *s_texture;
     Sint16 *vx, *vy, x, y, tdx, tdy;
+    _TexEdge *edges;
+    _TexSpan ts;
     Py_ssize_t count, i;
-    int ret;
+    int ret, minx, maxx, miny, maxy;
 
     ASSERT_VIDEO_INIT (NULL);
 
@@ -981,6 +1636,7 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
         PyErr_SetString (PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    PySurface_DropRLE (surface);
     s_surface = PySurface_AsSurface (surface);
     if (!PySurface_Check (texture))
     {
@@ -1011,12 +1667,15 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
 
     vx = PyMem_New (Sint16, (size_t) count);
     vy = PyMem_New (Sint16, (size_t) count);
-    if (!vx || !vy)
+    edges = PyMem_New (_TexEdge, (size_t) count);
+    if (!vx || !vy || !edges)
     {
         if (vx)
             PyMem_Free (vx);
         if (vy)
             PyMem_Free (vy);
+        if (edges)
+            PyMem_Free (edges);
         return NULL;
     }
 
@@ -1027,6 +1686,7 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
         {
             PyMem_Free (vx);
             PyMem_Free (vy);
+            PyMem_Free (edges);
             Py_XDECREF (item);
             return NULL;
         }
@@ -1034,6 +1694,7 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
         {
             PyMem_Free (vx);
             PyMem_Free (vy);
+            PyMem_Free (edges);
             Py_XDECREF (item);
             return NULL;
         }
@@ -1042,13 +1703,46 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
         vy[i] = y;
     }
 
+    /* Opaque and 32 bit alpha textures are spanned directly, the rest
+     * keeps the conversions of SDL's blitters. The texture is prepared
+     * for reading with the GIL held, since that may decompress it or
+     * lock the Surface it is a subsurface of.
+     */
+    PySurface_Prep (texture);
     Py_BEGIN_ALLOW_THREADS;
-    ret = texturedPolygon (s_surface, vx, vy, (int)count,
-                           s_texture, tdx, tdy);
+    switch (_tex_span_setup (&ts, s_surface, s_texture))
+    {
+    case TEXSPAN_COPY:
+    case TEXSPAN_BLEND32:
+        ret = _tex_polygon (&ts, vx, vy, NULL, NULL, (int)count, tdx, tdy,
+                            edges);
+        break;
+    default:
+        /* texturedPolygon() fails for polygons off the surface */
+        minx = maxx = vx[0];
+        miny = maxy = vy[0];
+        for (i = 1; i < count; i++)
+        {
+            minx = MIN (minx, vx[i]);
+            maxx = MAX (maxx, vx[i]);
+            miny = MIN (miny, vy[i]);
+            maxy = MAX (maxy, vy[i]);
+        }
+        if (maxx < 0 || minx > s_surface->w || maxy < 0 ||
+            miny > s_surface->h)
+            ret = 0;
+        else
+            ret = texturedPolygon (s_surface, vx, vy, (int)count,
+                                   s_texture, tdx, tdy);
+        break;
+    }
     Py_END_ALLOW_THREADS;
+    PySurface_Unprep (texture);
 
+    _gfx_damage_points (surface, vx, vy, (int)count);
     PyMem_Free (vx);
     PyMem_Free (vy);
+    PyMem_Free (edges);
 
     if (ret == -1)
     {
@@ -1058,6 +1752,133 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
     Py_RETURN_NONE;
 }
 
+static PyObject*
+_gfx_texturedpolygonuv (PyObject *self, PyObject* args)
+{
+    PyObject *surface, *texture, *points, *texcoords, *item;
+    SDL_Surface *s_surface, *s_texture;
+    Sint16 *vx, *vy, x, y;
+    float *vu, *vv;
+    _TexEdge *edges;
+    _TexSpan ts;
+    Py_ssize_t count, i;
+    int ret, ok;
+
+    ASSERT_VIDEO_INIT (NULL);
+
+    if (!PyArg_ParseTuple (args, "OOOO:textured_polygon_uv", &surface,
+            &points, &texture, &texcoords))
+        return NULL;
+
+    if (!PySurface_Check (surface))
+    {
+        PyErr_SetString (PyExc_TypeError, "surface must be a Surface");
+        return NULL;
+    }
+    PySurface_DropRLE (surface);
+    s_surface = PySurface_AsSurface (surface);
+    if (!PySurface_Check (texture))
+    {
+        PyErr_SetString (PyExc_TypeError, "texture must be a Surface");
+        return NULL;
+    }
+    s_texture = PySurface_AsSurface (texture);
+    if (!PySequence_Check (points) || !PySequence_Check (texcoords))
+    {
+        PyErr_SetString (PyExc_TypeError,
+            "points and texcoords must be sequences");
+        return NULL;
+    }
+    if (s_surface->format->BytesPerPixel == 1 &&
+        (s_texture->format->Amask || s_texture->flags & SDL_SRCALPHA)) {
+        PyErr_SetString (PyExc_ValueError,
+                           "Per-byte alpha texture unsupported "
+                           "for 8 bit surfaces");
+        return NULL;
+    }
+    if (s_texture->w > 32767 || s_texture->h > 32767)
+    {
+        PyErr_SetString (PyExc_ValueError, "texture is too large");
+        return NULL;
+    }
+
+    count = PySequence_Size (points);
+    if (count < 3)
+    {
+        PyErr_SetString (PyExc_ValueError,
+            "points must contain more than 2 points");
+        return NULL;
+    }
+    if (PySequence_Size (texcoords) != count)
+    {
+        PyErr_SetString (PyExc_ValueError,
+            "texcoords must have a coordinate for each point");
+        return NULL;
+    }
+
+    vx = PyMem_New (Sint16, (size_t) count);
+    vy = PyMem_New (Sint16, (size_t) count);
+    vu = PyMem_New (float, (size_t) count);
+    vv = PyMem_New (float, (size_t) count);
+    edges = PyMem_New (_TexEdge, (size_t) count);
+    if (!vx || !vy || !vu || !vv || !edges)
+    {
+        PyErr_NoMemory ();
+        ret = -1;
+        goto end;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        item = PySequence_ITEM (points, i);
+        ok = item && Sint16FromSeqIndex (item, 0, &x) &&
+            Sint16FromSeqIndex (item, 1, &y);
+        Py_XDECREF (item);
+        if (ok)
+        {
+            item = PySequence_ITEM (texcoords, i);
+            ok = item && TwoFloatsFromObj (item, &vu[i], &vv[i]);
+            Py_XDECREF (item);
+        }
+        if (!ok)
+        {
+            if (!PyErr_Occurred ())
+                PyErr_SetString (PyExc_TypeError,
+                    "points and texcoords must be number pairs");
+            ret = -1;
+            goto end;
+        }
+        vx[i] = x;
+        vy[i] = y;
+    }
+
+    PySurface_Prep (texture);
+    Py_BEGIN_ALLOW_THREADS;
+    _tex_span_setup (&ts, s_surface, s_texture);
+    ret = _tex_polygon (&ts, vx, vy, vu, vv, (int)count, 0, 0, edges);
+    Py_END_ALLOW_THREADS;
+    PySurface_Unprep (texture);
+
+    _gfx_damage_points (surface, vx, vy, (int)count);
+    if (ret == -1)
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+
+end:
+    if (vx)
+        PyMem_Free (vx);
+    if (vy)
+        PyMem_Free (vy);
+    if (vu)
+        PyMem_Free (vu);
+    if (vv)
+        PyMem_Free (vv);
+    if (edges)
+        PyMem_Free (edges);
+    if (ret == -1)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
 
 static PyObject*
 _gfx_beziercolor (PyObject *self, PyObject* args)
@@ -1132,11 +1953,13 @@ _gfx_beziercolor (PyObject *self, PyObject* args)
         vy[i] = y;
     }
 
+    PySurface_DropRLE (surface);
     Py_BEGIN_ALLOW_THREADS;
     ret = bezierRGBA (PySurface_AsSurface (surface), vx, vy, (int)count,
                       steps, rgba[0], rgba[1], rgba[2], rgba[3]);
     Py_END_ALLOW_THREADS;
 
+    _gfx_damage_points (surface, vx, vy, (int)count);
     PyMem_Free (vx);
     PyMem_Free (vy);
 
@@ -1148,6 +1971,41 @@ _gfx_beziercolor (PyObject *self, PyObject* args)
     Py_RETURN_NONE;
 }
 
+static PyObject*
+_gfx_setshapecachesize (PyObject *self, PyObject* args)
+{
+    int size;
+
+    if (!PyArg_ParseTuple (args, "i:set_shape_cache_size", &size))
+        return NULL;
+    if (size < 0)
+    {
+        PyErr_SetString (PyExc_ValueError,
+                         "shape cache size must not be negative");
+        return NULL;
+    }
+    if (size > GFX_SHAPE_MAX_CACHE_SIZE)
+        size = GFX_SHAPE_MAX_CACHE_SIZE;
+
+    _gfx_shape_cache_clear ();
+    _gfx_shapes.size = size;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+_gfx_getshapecachesize (PyObject *self)
+{
+    return PyInt_FromLong (_gfx_shapes.size);
+}
+
+static PyObject*
+_gfx_getshapecachestats (PyObject *self)
+{
+    return Py_BuildValue ("(inkkk)", _gfx_shapes.count,
+                          (Py_ssize_t) _gfx_shapes.bytes, _gfx_shapes.hits,
+                          _gfx_shapes.misses, _gfx_shapes.evictions);
+}
+
 MODINIT_DEFINE(gfxdraw)
 {
     PyObject *module;
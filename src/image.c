@@ -28,6 +28,14 @@
 #include "pgcompat.h"
 #include "doc/image_doc.h"
 #include "pgopengl.h"
+#include "pgloadmany.h"
+#include <ctype.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_SSE2
+#include <emmintrin.h>
+#endif
 
 struct _module_state {
     int is_extended;
@@ -48,6 +56,16 @@ static SDL_Surface* opengltosdl (void);
     ((flipped) ? (((char*) data) + (height - row - 1) * width) : \
      (((char*) data) + row * width))
 
+static SDL_Surface*
+load_bmp (const char *file)
+{
+    SDL_RWops *rw = RWopsFromFileName (file);
+
+    if (!rw)
+        return NULL;
+    return SDL_LoadBMP_RW (rw, 1);
+}
+
 static PyObject*
 image_load_basic(PyObject *self, PyObject *arg)
 {
@@ -68,7 +86,7 @@ image_load_basic(PyObject *self, PyObject *arg)
     }
     if (oencoded != Py_None) {
         Py_BEGIN_ALLOW_THREADS;
-        surf = SDL_LoadBMP(Bytes_AS_STRING(oencoded));
+        surf = load_bmp(Bytes_AS_STRING(oencoded));
         Py_END_ALLOW_THREADS;
         Py_DECREF(oencoded);
     }
@@ -99,6 +117,12 @@ image_load_basic(PyObject *self, PyObject *arg)
     return final;
 }
 
+static PyObject*
+image_load_many_basic (PyObject *self, PyObject *arg, PyObject *kwds)
+{
+    return pg_load_many (arg, kwds, load_bmp);
+}
+
 
 static SDL_Surface*
 opengltosdl ()
@@ -169,18 +193,98 @@ opengltosdl ()
     return surf;
 }
 
+/* Save with imageext's save_extended, which takes the same arguments as
+   save; returns -2 on an error, else 0 */
+static int
+save_extended(PyObject *arg, PyObject *kwds)
+{
+    PyObject *imgext;
+    PyObject *extsave;
+    PyObject *data;
+
+    imgext = PyImport_ImportModule(IMPPREFIX "imageext");
+    if (imgext == NULL) {
+        return -2;
+    }
+    extsave = PyObject_GetAttrString(imgext, "save_extended");
+    Py_DECREF(imgext);
+    if (extsave == NULL) {
+        return -2;
+    }
+    data = PyObject_Call(extsave, arg, kwds);
+    Py_DECREF(extsave);
+    if (data == NULL) {
+        return -2;
+    }
+    Py_DECREF(data);
+    return 0;
+}
+
+/* Whether a file object is to be saved as JPEG, going by namehint or
+   else its name */
+static int
+is_jpeg_file_object(PyObject *obj, const char *namehint)
+{
+    PyObject *oname;
+    PyObject *oencoded = NULL;
+    const char *name = namehint;
+    const char *ext;
+    char lower[6];
+    int i, jpeg = 0;
+
+    if (name == NULL) {
+        oname = PyObject_GetAttrString(obj, "name");
+        if (oname == NULL) {
+            PyErr_Clear();
+            return 0;
+        }
+        oencoded = RWopsEncodeFilePath(oname, NULL);
+        Py_DECREF(oname);
+        if (oencoded == NULL) {
+            PyErr_Clear();
+            return 0;
+        }
+        if (oencoded != Py_None) {
+            name = Bytes_AS_STRING(oencoded);
+        }
+    }
+    ext = name != NULL ? strrchr(name, '.') : NULL;
+    if (ext != NULL && strlen(ext) < sizeof(lower)) {
+        for (i = 0; ext[i]; ++i) {
+            lower[i] = tolower((unsigned char)ext[i]);
+        }
+        lower[i] = '\0';
+        jpeg = !strcmp(lower, ".jpg") || !strcmp(lower, ".jpeg");
+    }
+    Py_XDECREF(oencoded);
+    return jpeg;
+}
+
 PyObject*
-image_save(PyObject *self, PyObject *arg)
+image_save(PyObject *self, PyObject *arg, PyObject *kwds)
 {
     PyObject *surfobj;
     PyObject *obj;
+    PyObject *filter = NULL;
+    PyObject *dct = NULL;
+    PyObject *subsampling = NULL;
     PyObject *oencoded;
-    PyObject *imgext = NULL;
+    const char *namehint = NULL;
     SDL_Surface *surf;
     SDL_Surface *temp = NULL;
+    int compression = -1;
+    int quality = -1;
     int result = 1;
-
-    if (!PyArg_ParseTuple(arg, "O!O", &PySurface_Type, &surfobj, &obj)) {
+    static char *kwids[] = {"surface", "filename", "compression", "filter",
+                            "quality", "dct", "subsampling", "namehint",
+                            NULL};
+
+    /* filter is only used by save_extended, for PNG, and quality, dct and
+       subsampling for JPEG; compression 0 also turns off RLE for TGA */
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "O!O|iOiOOz", kwids,
+                                     &PySurface_Type, &surfobj, &obj,
+                                     &compression, &filter, &quality, &dct,
+                                     &subsampling, &namehint)) {
         return NULL;
     }
 
@@ -196,10 +300,13 @@ image_save(PyObject *self, PyObject *arg)
     }
 
     oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
-    if (oencoded == Py_None) {
+    if (oencoded == Py_None && is_jpeg_file_object(obj, namehint)) {
+        result = save_extended(arg, kwds);
+    }
+    else if (oencoded == Py_None) {
         SDL_RWops *rw = RWopsFromFileObject(obj);
         if (rw != NULL) {
-            result = SaveTGA_RW(surf, rw, 1);
+            result = SaveTGA_RW(surf, rw, compression != 0);
         }
         else {
             result = -2;
@@ -230,40 +337,14 @@ image_save(PyObject *self, PyObject *arg)
                       (name[namelen - 2]=='p' || name[namelen - 2]=='P') &&
                       (name[namelen - 3]=='j' || name[namelen - 3]=='J')))  {
                 /* If it is .png .jpg .jpeg use the extended module. */
-                /* try to get extended formats */
-                imgext = PyImport_ImportModule(IMPPREFIX "imageext");
-                if (imgext != NULL)
-                {
-                    PyObject *extsave =
-                        PyObject_GetAttrString(imgext, "save_extended");
-                    PyObject *data;
-
-                    Py_DECREF(imgext);
-                    if (extsave != NULL) {
-                        data = PyObject_CallObject(extsave, arg);
-                        Py_DECREF(extsave);
-                        if (data == NULL) {
-                            result = -2;
-                        }
-                        else {
-                            Py_DECREF(data);
-                            result = 0;
-                        }
-                    }
-                    else {
-                        result = -2;
-                    }
-                }
-                else {
-                    result = -2;
-                }
+                result = save_extended(arg, kwds);
                 written = 1;
             }
         }
 
         if (!written) {
             Py_BEGIN_ALLOW_THREADS;
-            result = SaveTGA(surf, name, 1);
+            result = SaveTGA(surf, name, compression != 0);
             Py_END_ALLOW_THREADS;
         }
     }
@@ -302,30 +383,200 @@ image_get_extended (PyObject* self, PyObject* arg)
     return PyInt_FromLong (GETSTATE (self)->is_extended);
 }
 
-PyObject*
-image_tostring (PyObject* self, PyObject* arg)
+/* Bytes per pixel tostring writes for format, or 0 with an exception set
+ * if surf cannot be written in format.
+ */
+static int
+tostring_pixel_size (SDL_Surface *surf, const char *format)
 {
-    PyObject *surfobj, *string = NULL;
-    char *format, *data, *pixels;
-    SDL_Surface *surf, *temp = NULL;
-    int w, h, color, flipped = 0;
-    Py_ssize_t len;
+    if (!strcmp (format, "P"))
+    {
+        if (surf->format->BytesPerPixel != 1)
+        {
+            PyErr_SetString
+                (PyExc_ValueError,
+                 "Can only create \"P\" format data with 8bit Surfaces");
+            return 0;
+        }
+        return 1;
+    }
+    if (!strcmp (format, "RGB"))
+        return 3;
+    if (!strcmp (format, "RGBX") || !strcmp (format, "RGBA") ||
+        !strcmp (format, "ARGB"))
+        return 4;
+    if (!strcmp (format, "RGBA_PREMULT") || !strcmp (format, "ARGB_PREMULT"))
+    {
+        if (surf->format->BytesPerPixel == 1 || surf->format->Amask == 0)
+        {
+            PyErr_SetString
+                (PyExc_ValueError,
+                 "Can only create pre-multiplied alpha strings if the surface has per-pixel alpha");
+            return 0;
+        }
+        return 4;
+    }
+    PyErr_SetString (PyExc_ValueError, "Unrecognized type of format");
+    return 0;
+}
+
+/* True if mask is the byte at shift, or no channel if empty is true */
+#define BYTE_CHANNEL(mask, shift, empty) \
+    ((mask) == (Uint32) 0xFF << (shift) || ((empty) && !(mask)))
+
+/* Word shift of the byte at offset i of a 32 bit pixel in memory, and the
+ * masks of a 24 bit surface whose bytes are red, green, blue in memory
+ */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define BYTE_SHIFT(i) ((i) * 8)
+#define RGB24_RMASK 0x0000FF
+#define RGB24_BMASK 0xFF0000
+#else
+#define BYTE_SHIFT(i) ((3 - (i)) * 8)
+#define RGB24_RMASK 0xFF0000
+#define RGB24_BMASK 0x0000FF
+#endif
+
+/* Write the surfaces tostring can do without taking pixels apart: 24 bit
+ * rows already in "RGB" order are copied as they are, and 32 bit pixels
+ * with a byte for each channel become "RGBX", "RGBA" or "ARGB" by moving
+ * bytes, or by copying if they are already in order. The caller holds
+ * the surface lock. Returns 0, leaving the surface to the caller, for
+ * anything else.
+ */
+static int
+tostring_bytes (SDL_Surface *surf, const char *format, char *data,
+                int flipped, int hascolorkey)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    int a_first = !strcmp (format, "ARGB");
+    Uint32 filler = 0;
+    int rshift, gshift, bshift, ashift, h, w;
+    size_t rowsize;
+    Uint32 *src;
+    Uint32 *dst;
+    Uint32 pixel;
+#if defined(IMAGE_SSE2)
+    __m128i pixels, out;
+    __m128i rs, gs, bs, as, rd, gd, bd, ad;
+    __m128i byte = _mm_set1_epi32 (0xFF);
+#endif
+
+    if (!strcmp (format, "RGB"))
+    {
+        if (fmt->BytesPerPixel != 3 || fmt->Rmask != RGB24_RMASK ||
+            fmt->Gmask != 0xFF00 || fmt->Bmask != RGB24_BMASK)
+            return 0;
+        rowsize = (size_t) surf->w * 3;
+        Py_BEGIN_ALLOW_THREADS;
+        if (surf->pitch == rowsize && !flipped)
+            memcpy (data, surf->pixels, rowsize * surf->h);
+        else
+            for (h = 0; h < surf->h; ++h)
+                memcpy (data + h * rowsize,
+                        DATAROW (surf->pixels, h, surf->pitch, surf->h,
+                                 flipped), rowsize);
+        Py_END_ALLOW_THREADS;
+        return 1;
+    }
+    if ((!a_first && strcmp (format, "RGBX") && strcmp (format, "RGBA")) ||
+        (hascolorkey && !strcmp (format, "RGBA")) ||
+        fmt->BytesPerPixel != 4 ||
+        !BYTE_CHANNEL (fmt->Rmask, fmt->Rshift, 0) ||
+        !BYTE_CHANNEL (fmt->Gmask, fmt->Gshift, 0) ||
+        !BYTE_CHANNEL (fmt->Bmask, fmt->Bshift, 0) ||
+        !BYTE_CHANNEL (fmt->Amask, fmt->Ashift, 1))
+        return 0;
+
+    rshift = BYTE_SHIFT (a_first);
+    gshift = BYTE_SHIFT (a_first + 1);
+    bshift = BYTE_SHIFT (a_first + 2);
+    ashift = BYTE_SHIFT (a_first ? 0 : 3);
+    if (!fmt->Amask)
+        filler = (Uint32) 0xFF << ashift;
+    rowsize = (size_t) surf->w * 4;
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (fmt->Rshift == rshift && fmt->Gshift == gshift &&
+        fmt->Bshift == bshift && fmt->Amask && fmt->Ashift == ashift)
+    {
+        if (surf->pitch == rowsize && !flipped)
+            memcpy (data, surf->pixels, rowsize * surf->h);
+        else
+            for (h = 0; h < surf->h; ++h)
+                memcpy (data + h * rowsize,
+                        DATAROW (surf->pixels, h, surf->pitch, surf->h,
+                                 flipped), rowsize);
+    }
+    else
+    {
+#if defined(IMAGE_SSE2)
+        rs = _mm_cvtsi32_si128 (fmt->Rshift);
+        gs = _mm_cvtsi32_si128 (fmt->Gshift);
+        bs = _mm_cvtsi32_si128 (fmt->Bshift);
+        as = _mm_cvtsi32_si128 (fmt->Ashift);
+        rd = _mm_cvtsi32_si128 (rshift);
+        gd = _mm_cvtsi32_si128 (gshift);
+        bd = _mm_cvtsi32_si128 (bshift);
+        ad = _mm_cvtsi32_si128 (ashift);
+#endif
+        for (h = 0; h < surf->h; ++h)
+        {
+            src = (Uint32 *) DATAROW (surf->pixels, h, surf->pitch, surf->h,
+                                      flipped);
+            dst = (Uint32 *) (data + h * rowsize);
+            w = 0;
+#if defined(IMAGE_SSE2)
+            for (; w + 4 <= surf->w; w += 4)
+            {
+                pixels = _mm_loadu_si128 ((__m128i *) (src + w));
+                out = _mm_or_si128 (
+                    _mm_sll_epi32 (_mm_and_si128 (_mm_srl_epi32 (pixels, rs),
+                                                  byte), rd),
+                    _mm_sll_epi32 (_mm_and_si128 (_mm_srl_epi32 (pixels, gs),
+                                                  byte), gd));
+                out = _mm_or_si128 (out,
+                    _mm_sll_epi32 (_mm_and_si128 (_mm_srl_epi32 (pixels, bs),
+                                                  byte), bd));
+                if (fmt->Amask)
+                    out = _mm_or_si128 (out,
+                        _mm_sll_epi32 (_mm_and_si128 (
+                                           _mm_srl_epi32 (pixels, as), byte),
+                                       ad));
+                else
+                    out = _mm_or_si128 (out, _mm_set1_epi32 ((int) filler));
+                _mm_storeu_si128 ((__m128i *) (dst + w), out);
+            }
+#endif
+            for (; w < surf->w; ++w)
+            {
+                pixel = src[w];
+                dst[w] = ((pixel >> fmt->Rshift & 0xFF) << rshift |
+                          (pixel >> fmt->Gshift & 0xFF) << gshift |
+                          (pixel >> fmt->Bshift & 0xFF) << bshift |
+                          (fmt->Amask ?
+                           (pixel >> fmt->Ashift & 0xFF) << ashift : filler));
+            }
+        }
+    }
+    Py_END_ALLOW_THREADS;
+    return 1;
+}
+
+/* Write surf, which is temp if surfobj is an OpenGL display, to data in
+ * format, one of the formats tostring_pixel_size accepts.
+ */
+static void
+tostring_pixels (PyObject *surfobj, SDL_Surface *surf, SDL_Surface *temp,
+                 const char *format, char *data, int flipped)
+{
+    char *pixels;
+    int w, h, color;
     Uint32 Rmask, Gmask, Bmask, Amask, Rshift, Gshift, Bshift, Ashift, Rloss,
         Gloss, Bloss, Aloss;
     int hascolorkey, colorkey;
     Uint32 alpha;
 
-    if (!PyArg_ParseTuple (arg, "O!s|i", &PySurface_Type, &surfobj, &format,
-                           &flipped))
-        return NULL;
-    surf = PySurface_AsSurface (surfobj);
-    if (surf->flags & SDL_OPENGL)
-    {
-        temp = surf = opengltosdl ();
-        if (!surf)
-            return NULL;
-    }
-
     Rmask = surf->format->Rmask;
     Gmask = surf->format->Gmask;
     Bmask = surf->format->Bmask;
@@ -341,17 +592,19 @@ image_tostring (PyObject* self, PyObject* arg)
     hascolorkey = (surf->flags & SDL_SRCCOLORKEY) && !Amask;
     colorkey = surf->format->colorkey;
 
-    if (!strcmp (format, "P"))
+    if (!temp)
+        PySurface_Lock (surfobj);
+    if (tostring_bytes (surf, format, data, flipped, hascolorkey))
     {
-        if (surf->format->BytesPerPixel != 1)
-            return RAISE
-                (PyExc_ValueError,
-                 "Can only create \"P\" format data with 8bit Surfaces");
-        string = Bytes_FromStringAndSize (NULL, surf->w * surf->h);
-        if (!string)
-            return NULL;
-        Bytes_AsStringAndSize (string, &data, &len);
+        if (!temp)
+            PySurface_Unlock (surfobj);
+        return;
+    }
+    if (!temp)
+        PySurface_Unlock (surfobj);
 
+    if (!strcmp (format, "P"))
+    {
         PySurface_Lock (surfobj);
         pixels = (char*) surf->pixels;
         for (h = 0; h < surf->h; ++h)
@@ -361,11 +614,6 @@ image_tostring (PyObject* self, PyObject* arg)
     }
     else if (!strcmp (format, "RGB"))
     {
-        string = Bytes_FromStringAndSize (NULL, surf->w * surf->h * 3);
-        if (!string)
-            return NULL;
-        Bytes_AsStringAndSize (string, &data, &len);
-
         if (!temp)
             PySurface_Lock (surfobj);
         pixels = (char*) surf->pixels;
@@ -445,11 +693,6 @@ image_tostring (PyObject* self, PyObject* arg)
         if (strcmp (format, "RGBA"))
             hascolorkey = 0;
 
-        string = Bytes_FromStringAndSize (NULL, surf->w * surf->h * 4);
-        if (!string)
-            return NULL;
-        Bytes_AsStringAndSize (string, &data, &len);
-
         PySurface_Lock (surfobj);
         pixels = (char*) surf->pixels;
         switch (surf->format->BytesPerPixel)
@@ -537,11 +780,6 @@ image_tostring (PyObject* self, PyObject* arg)
     {
         hascolorkey = 0;
 
-        string = Bytes_FromStringAndSize (NULL, surf->w * surf->h * 4);
-        if (!string)
-            return NULL;
-        Bytes_AsStringAndSize (string, &data, &len);
-
         PySurface_Lock (surfobj);
         pixels = (char*) surf->pixels;
         switch (surf->format->BytesPerPixel)
@@ -627,18 +865,8 @@ image_tostring (PyObject* self, PyObject* arg)
     }
     else if (!strcmp (format, "RGBA_PREMULT"))
     {
-        if (surf->format->BytesPerPixel == 1 || surf->format->Amask == 0)
-            return RAISE
-                (PyExc_ValueError,
-                 "Can only create pre-multiplied alpha strings if the surface has per-pixel alpha");
-
         hascolorkey = 0;
 
-        string = Bytes_FromStringAndSize (NULL, surf->w * surf->h * 4);
-        if (!string)
-            return NULL;
-        Bytes_AsStringAndSize (string, &data, &len);
-
         PySurface_Lock (surfobj);
         pixels = (char*) surf->pixels;
         switch (surf->format->BytesPerPixel)
@@ -711,18 +939,8 @@ image_tostring (PyObject* self, PyObject* arg)
     }
     else if (!strcmp (format, "ARGB_PREMULT"))
     {
-        if (surf->format->BytesPerPixel == 1 || surf->format->Amask == 0)
-            return RAISE
-                (PyExc_ValueError,
-                 "Can only create pre-multiplied alpha strings if the surface has per-pixel alpha");
-
         hascolorkey = 0;
 
-        string = Bytes_FromStringAndSize (NULL, surf->w * surf->h * 4);
-        if (!string)
-            return NULL;
-        Bytes_AsStringAndSize (string, &data, &len);
-
         PySurface_Lock (surfobj);
         pixels = (char*) surf->pixels;
         switch (surf->format->BytesPerPixel)
@@ -793,11 +1011,35 @@ image_tostring (PyObject* self, PyObject* arg)
         }
         PySurface_Unlock (surfobj);
     }
-    else
+}
+
+PyObject*
+image_tostring (PyObject* self, PyObject* arg)
+{
+    PyObject *surfobj, *string = NULL;
+    char *format, *data;
+    SDL_Surface *surf, *temp = NULL;
+    int flipped = 0, size;
+    Py_ssize_t len;
+
+    if (!PyArg_ParseTuple (arg, "O!s|i", &PySurface_Type, &surfobj, &format,
+                           &flipped))
+        return NULL;
+    surf = PySurface_AsSurface (surfobj);
+    if (surf->flags & SDL_OPENGL)
     {
-        if (temp)
-            SDL_FreeSurface (temp);
-        return RAISE (PyExc_ValueError, "Unrecognized type of format");
+        temp = surf = opengltosdl ();
+        if (!surf)
+            return NULL;
+    }
+
+    size = tostring_pixel_size (surf, format);
+    if (size)
+        string = Bytes_FromStringAndSize (NULL, surf->w * surf->h * size);
+    if (string)
+    {
+        Bytes_AsStringAndSize (string, &data, &len);
+        tostring_pixels (surfobj, surf, temp, format, data, flipped);
     }
 
     if (temp)
@@ -805,6 +1047,53 @@ image_tostring (PyObject* self, PyObject* arg)
     return string;
 }
 
+#if PG_ENABLE_NEWBUF
+PyObject*
+image_tobuffer (PyObject* self, PyObject* arg)
+{
+    PyObject *surfobj, *bufobj;
+    char *format;
+    SDL_Surface *surf, *temp = NULL;
+    int flipped = 0, size;
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple (arg, "O!sO|i", &PySurface_Type, &surfobj, &format,
+                           &bufobj, &flipped))
+        return NULL;
+    if (PyObject_GetBuffer (bufobj, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS))
+        return NULL;
+    surf = PySurface_AsSurface (surfobj);
+    if (surf->flags & SDL_OPENGL)
+    {
+        temp = surf = opengltosdl ();
+        if (!surf)
+        {
+            PyBuffer_Release (&view);
+            return NULL;
+        }
+    }
+
+    size = tostring_pixel_size (surf, format);
+    if (size && view.len != (Py_ssize_t) surf->w * surf->h * size)
+    {
+        PyErr_SetString
+            (PyExc_ValueError,
+             "Buffer length does not equal format and resolution size");
+        size = 0;
+    }
+    if (size)
+        tostring_pixels (surfobj, surf, temp, format, (char *) view.buf,
+                         flipped);
+
+    if (temp)
+        SDL_FreeSurface (temp);
+    PyBuffer_Release (&view);
+    if (!size)
+        return NULL;
+    Py_RETURN_NONE;
+}
+#endif /* PG_ENABLE_NEWBUF */
+
 PyObject*
 image_fromstring (PyObject* self, PyObject* arg)
 {
@@ -1028,6 +1317,382 @@ image_frombuffer (PyObject* self, PyObject* arg)
     return surfobj;
 }
 
+/* Atlas files hold a surface's pixels exactly as they are in memory,
+ * after a header with the pixel format, the palette of an 8 bit surface
+ * and a table of rects for the images packed into it. load_atlas maps
+ * the file copy on write and wraps the pixels where they lie, like
+ * frombuffer, so nothing is decoded or converted. The header is in the
+ * byte order of the machine that saved it, like the pixels.
+ */
+#define ATLAS_MAGIC "pgatlas\032"
+#define ATLAS_BYTEORDER 0x01020304
+#define ATLAS_VERSION 1
+#define ATLAS_ALIGN 64                 /* of the pixels in the file */
+#define ATLAS_FLAGS (SDL_SRCALPHA | SDL_SRCCOLORKEY | SDL_RLEACCEL)
+
+typedef struct
+{
+    char   magic[8];
+    Uint32 byteorder;                  /* ATLAS_BYTEORDER */
+    Uint32 version;
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 bits;
+    Uint32 rmask;
+    Uint32 gmask;
+    Uint32 bmask;
+    Uint32 amask;
+    Uint32 flags;                      /* the surface's ATLAS_FLAGS */
+    Uint32 colorkey;
+    Uint32 alpha;
+    Uint32 ncolors;                    /* SDL_Colors after the header */
+    Uint32 nrects;                     /* x, y, w, h Sint32s after those */
+    Uint32 offset;                     /* of the pixels */
+} AtlasHeader;
+
+static int
+atlas_write (SDL_Surface *surf, const Sint32 *rects, Uint32 nrects,
+             SDL_RWops *out)
+{
+    static const Uint8 padding[ATLAS_ALIGN] = { 0 };
+    AtlasHeader h;
+    SDL_PixelFormat *fmt = surf->format;
+    Uint32 size;
+    int y, result = 0;
+    Uint8 *row;
+
+    memset (&h, 0, sizeof (h));
+    memcpy (h.magic, ATLAS_MAGIC, sizeof (h.magic));
+    h.byteorder = ATLAS_BYTEORDER;
+    h.version = ATLAS_VERSION;
+    h.width = surf->w;
+    h.height = surf->h;
+    h.pitch = surf->pitch;
+    h.bits = fmt->BitsPerPixel;
+    h.rmask = fmt->Rmask;
+    h.gmask = fmt->Gmask;
+    h.bmask = fmt->Bmask;
+    h.amask = fmt->Amask;
+    h.flags = surf->flags & ATLAS_FLAGS;
+    h.colorkey = fmt->colorkey;
+    h.alpha = fmt->alpha;
+    h.ncolors = fmt->palette ? fmt->palette->ncolors : 0;
+    h.nrects = nrects;
+    size = sizeof (h) + h.ncolors * sizeof (SDL_Color) +
+        nrects * 4 * sizeof (Sint32);
+    h.offset = (size + ATLAS_ALIGN - 1) / ATLAS_ALIGN * ATLAS_ALIGN;
+
+    if (SDL_RWwrite (out, &h, sizeof (h), 1) != 1 ||
+        (h.ncolors && SDL_RWwrite (out, fmt->palette->colors,
+                                   sizeof (SDL_Color) * h.ncolors, 1) != 1) ||
+        (nrects && SDL_RWwrite (out, rects,
+                                4 * sizeof (Sint32) * nrects, 1) != 1) ||
+        (h.offset > size && SDL_RWwrite (out, padding, h.offset - size,
+                                         1) != 1))
+        return -1;
+
+    if (!surf->h)
+        return 0;
+    if (SDL_LockSurface (surf) == -1)
+        return -1;
+    row = (Uint8 *) surf->pixels;
+    for (y = 0; y < surf->h; ++y, row += surf->pitch)
+    {
+        if (SDL_RWwrite (out, row, surf->pitch, 1) != 1)
+        {
+            result = -1;
+            break;
+        }
+    }
+    SDL_UnlockSurface (surf);
+    return result;
+}
+
+PyObject*
+image_save_atlas (PyObject* self, PyObject* arg, PyObject *kwds)
+{
+    PyObject *surfobj, *obj, *rectsobj = NULL, *seq = NULL, *oencoded;
+    SDL_Surface *surf, *temp = NULL;
+    SDL_RWops *rw;
+    GAME_Rect *r, rtemp;
+    Sint32 *rects = NULL;
+    Py_ssize_t nrects = 0, i;
+    int result = -2;
+    static char *kwids[] = {"surface", "filename", "rects", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (arg, kwds, "O!O|O", kwids,
+                                      &PySurface_Type, &surfobj, &obj,
+                                      &rectsobj))
+        return NULL;
+
+    surf = PySurface_AsSurface (surfobj);
+    if (rectsobj && rectsobj != Py_None)
+    {
+        seq = PySequence_Fast (rectsobj, "rects must be a sequence of rects");
+        if (!seq)
+            return NULL;
+        nrects = PySequence_Fast_GET_SIZE (seq);
+        rects = PyMem_New (Sint32, 4 * (nrects ? nrects : 1));
+        if (!rects)
+        {
+            Py_DECREF (seq);
+            return PyErr_NoMemory ();
+        }
+        for (i = 0; i < nrects; ++i)
+        {
+            r = GameRect_FromObject (PySequence_Fast_GET_ITEM (seq, i),
+                                     &rtemp);
+            if (!r)
+            {
+                PyErr_Format (PyExc_TypeError,
+                              "rects item %d is not a rect", (int) i);
+                goto end;
+            }
+            if (r->x < 0 || r->y < 0 || r->w < 0 || r->h < 0 ||
+                r->x + r->w > surf->w || r->y + r->h > surf->h)
+            {
+                PyErr_Format (PyExc_ValueError,
+                              "rects item %d is outside the surface", (int) i);
+                goto end;
+            }
+            rects[4 * i] = r->x;
+            rects[4 * i + 1] = r->y;
+            rects[4 * i + 2] = r->w;
+            rects[4 * i + 3] = r->h;
+        }
+    }
+
+    if (surf->flags & SDL_OPENGL)
+    {
+        temp = surf = opengltosdl ();
+        if (!surf)
+            goto end;
+    }
+    else
+        PySurface_Prep (surfobj);
+
+    oencoded = RWopsEncodeFilePath (obj, PyExc_SDLError);
+    if (oencoded == Py_None)
+    {
+        rw = RWopsFromFileObject (obj);
+        if (rw)
+        {
+            result = atlas_write (surf, rects, (Uint32) nrects, rw);
+            SDL_RWclose (rw);
+        }
+    }
+    else if (oencoded)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        rw = SDL_RWFromFile (Bytes_AS_STRING (oencoded), "wb");
+        if (rw)
+        {
+            result = atlas_write (surf, rects, (Uint32) nrects, rw);
+            SDL_RWclose (rw);
+        }
+        else
+            result = -1;
+        Py_END_ALLOW_THREADS;
+    }
+    Py_XDECREF (oencoded);
+
+    if (temp)
+        SDL_FreeSurface (temp);
+    else
+        PySurface_Unprep (surfobj);
+    if (result == -1 && !PyErr_Occurred ())
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+
+end:
+    PyMem_Del (rects);
+    Py_XDECREF (seq);
+    if (result)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+/* A new reference to a writable object holding the bytes of the atlas
+   file obj: the file mapped copy on write, or a bytearray of what a file
+   object without a file descriptor reads */
+static PyObject*
+atlas_map (PyObject *obj)
+{
+    PyObject *oencoded, *file = NULL, *fileno = NULL, *module, *data = NULL;
+
+    oencoded = RWopsEncodeFilePath (obj, PyExc_SDLError);
+    if (!oencoded)
+        return NULL;
+    if (oencoded != Py_None)
+    {
+        module = PyImport_ImportModule ("io");
+        if (!module)
+            goto end;
+        file = PyObject_CallMethod (module, "open", "Os", oencoded, "rb");
+        Py_DECREF (module);
+        if (!file)
+            goto end;
+        obj = file;
+    }
+
+    fileno = PyObject_CallMethod (obj, "fileno", NULL);
+    if (fileno)
+    {
+        module = PyImport_ImportModule ("mmap");
+        if (module)
+        {
+            PyObject *mmap = PyObject_GetAttrString (module, "mmap");
+            PyObject *access = PyObject_GetAttrString (module, "ACCESS_COPY");
+
+            if (mmap && access)
+            {
+                PyObject *args = Py_BuildValue ("(Oi)", fileno, 0);
+                PyObject *kw = Py_BuildValue ("{sO}", "access", access);
+
+                if (args && kw)
+                    data = PyObject_Call (mmap, args, kw);
+                Py_XDECREF (args);
+                Py_XDECREF (kw);
+            }
+            Py_XDECREF (mmap);
+            Py_XDECREF (access);
+            Py_DECREF (module);
+        }
+    }
+    else if (!file)
+    {
+        /* A file object like BytesIO; read it all */
+        PyObject *bytes;
+
+        PyErr_Clear ();
+        bytes = PyObject_CallMethod (obj, "read", NULL);
+        if (bytes)
+        {
+            data = PyByteArray_FromObject (bytes);
+            Py_DECREF (bytes);
+        }
+    }
+
+end:
+    if (file)
+    {
+        PyObject *ret = PyObject_CallMethod (file, "close", NULL);
+
+        if (!ret && data)
+            Py_CLEAR (data);
+        Py_XDECREF (ret);
+        Py_DECREF (file);
+    }
+    Py_XDECREF (fileno);
+    Py_DECREF (oencoded);
+    return data;
+}
+
+PyObject*
+image_load_atlas (PyObject* self, PyObject* arg)
+{
+    PyObject *obj, *data, *surfobj, *rectlist, *rect;
+    AtlasHeader h;
+    SDL_Surface *surf;
+    SDL_Color colors[256];
+    Sint32 r[4];
+    Uint8 *bytes;
+    Py_ssize_t len, end, i;
+
+    if (!PyArg_ParseTuple (arg, "O", &obj))
+        return NULL;
+    data = atlas_map (obj);
+    if (!data)
+        return NULL;
+    if (PyObject_AsWriteBuffer (data, (void **) &bytes, &len))
+    {
+        Py_DECREF (data);
+        return NULL;
+    }
+
+    if (len < (Py_ssize_t) sizeof (h))
+        goto bad;
+    memcpy (&h, bytes, sizeof (h));
+    if (memcmp (h.magic, ATLAS_MAGIC, sizeof (h.magic)))
+        goto bad;
+    if (h.byteorder != ATLAS_BYTEORDER)
+    {
+        Py_DECREF (data);
+        return RAISE (PyExc_SDLError,
+                      "Atlas file saved on a machine of another byte order");
+    }
+    if (h.version != ATLAS_VERSION)
+    {
+        Py_DECREF (data);
+        return RAISE (PyExc_SDLError, "Unsupported atlas file version");
+    }
+    /* Bound everything before multiplying, so nothing can overflow */
+    if ((h.bits != 8 && h.bits != 16 && h.bits != 24 && h.bits != 32) ||
+        h.width > 0xFFFF || h.height > 0xFFFF || h.pitch > 0x7FFFF ||
+        h.pitch < h.width * (h.bits >> 3) || h.ncolors > 256 ||
+        h.nrects > (Uint32) len / 16 || (h.bits == 8) != (h.ncolors != 0))
+        goto bad;
+    end = sizeof (h) + h.ncolors * sizeof (SDL_Color) + h.nrects * 16;
+    if (h.offset < end || h.offset > len ||
+        (Py_ssize_t) h.pitch * h.height > len - h.offset)
+        goto bad;
+
+    rectlist = PyList_New (h.nrects);
+    if (!rectlist)
+    {
+        Py_DECREF (data);
+        return NULL;
+    }
+    end = sizeof (h) + h.ncolors * sizeof (SDL_Color);
+    for (i = 0; i < (Py_ssize_t) h.nrects; ++i)
+    {
+        memcpy (r, bytes + end + 16 * i, 16);
+        rect = PyRect_New4 (r[0], r[1], r[2], r[3]);
+        if (!rect)
+        {
+            Py_DECREF (rectlist);
+            Py_DECREF (data);
+            return NULL;
+        }
+        PyList_SET_ITEM (rectlist, i, rect);
+    }
+
+    surf = SDL_CreateRGBSurfaceFrom (bytes + h.offset, h.width, h.height,
+                                     h.bits, h.pitch, h.rmask, h.gmask,
+                                     h.bmask, h.amask);
+    if (!surf)
+    {
+        Py_DECREF (rectlist);
+        Py_DECREF (data);
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    }
+    if (h.ncolors)
+    {
+        memcpy (colors, bytes + sizeof (h), h.ncolors * sizeof (SDL_Color));
+        SDL_SetColors (surf, colors, 0, h.ncolors);
+    }
+    SDL_SetColorKey (surf, h.flags & (SDL_SRCCOLORKEY | SDL_RLEACCEL),
+                     h.colorkey);
+    SDL_SetAlpha (surf, h.flags & (SDL_SRCALPHA | SDL_RLEACCEL),
+                  (Uint8) h.alpha);
+
+    surfobj = PySurface_New (surf);
+    if (!surfobj)
+    {
+        SDL_FreeSurface (surf);
+        Py_DECREF (rectlist);
+        Py_DECREF (data);
+        return NULL;
+    }
+    /* The surface keeps the mapping */
+    ((PySurfaceObject*) surfobj)->dependency = data;
+    return Py_BuildValue ("(NN)", surfobj, rectlist);
+
+bad:
+    Py_DECREF (data);
+    return RAISE (PyExc_SDLError, "Not an atlas file, or a damaged one");
+}
+
 /*******************************************************/
 /* tga code by Mattias Engdegard, in the public domain */
 /*******************************************************/
@@ -1077,6 +1742,42 @@ enum tga_type
 #endif
 
 #define TGA_RLE_MAX 128                /* max length of a TGA RLE chunk */
+#define TGA_BUFFER_SIZE (64 * 1024)    /* bytes gathered for each write */
+
+/* Gathers the small writes of the TGA writer into big ones, which matters
+   most when out is a Python file object and every write is a call */
+typedef struct
+{
+    SDL_RWops *out;
+    Uint8 *buf;
+    size_t used;
+    int failed;
+} TGAWriter;
+
+static int
+tga_flush (TGAWriter *w)
+{
+    if (w->used && !w->failed && !SDL_RWwrite (w->out, w->buf, w->used, 1))
+        w->failed = 1;
+    w->used = 0;
+    return !w->failed;
+}
+
+static int
+tga_write (TGAWriter *w, const void *data, size_t n)
+{
+    if (w->used + n > TGA_BUFFER_SIZE && !tga_flush (w))
+        return 0;
+    if (n >= TGA_BUFFER_SIZE)
+    {
+        if (!SDL_RWwrite (w->out, data, n, 1))
+            w->failed = 1;
+        return !w->failed;
+    }
+    memcpy (w->buf + w->used, data, n);
+    w->used += n;
+    return 1;
+}
 /* return the number of bytes in the resulting buffer after RLE-encoding
    a line of TGA data */
 static int
@@ -1128,7 +1829,8 @@ rle_line (Uint8 *src, Uint8 *dst, int w, int bpp)
  * 15, 16, 24 and 32bpp surfaces are saved as 24bpp RGB images,
  * or as 32bpp RGBA images if alpha channel is used.
  *
- * RLE compression is not used in the output file.
+ * Rows are RLE compressed if rle is true. Writes are gathered into blocks
+ * of TGA_BUFFER_SIZE bytes.
  *
  * Returns -1 upon error, 0 if success
  */
@@ -1145,7 +1847,11 @@ SaveTGA_RW (SDL_Surface *surface, SDL_RWops *out, int rle)
     Uint32 rmask, gmask, bmask, amask;
     SDL_Rect r;
     int bpp;
+    int direct;
+    int result = -1;
     Uint8 *rlebuf = NULL;
+    Uint8 *row;
+    TGAWriter writer;
 
     h.infolen = 0;
     SETLE16 (h.cmap_start, 0);
@@ -1211,8 +1917,17 @@ SaveTGA_RW (SDL_Surface *surface, SDL_RWops *out, int rle)
     SETLE16 (h.height, surface->h);
     h.flags = TGA_ORIGIN_UPPER | (alpha ? 8 : 0);
 
-    if (!SDL_RWwrite (out, &h, sizeof (h), 1))
+    writer.out = out;
+    writer.used = 0;
+    writer.failed = 0;
+    writer.buf = malloc (TGA_BUFFER_SIZE);
+    if (!writer.buf)
+    {
+        SDL_SetError ("out of memory");
         return -1;
+    }
+    if (!tga_write (&writer, &h, sizeof (h)))
+        goto error;
 
     if (h.has_cmap)
     {
@@ -1225,18 +1940,25 @@ SaveTGA_RW (SDL_Surface *surface, SDL_RWops *out, int rle)
             entry[1] = pal->colors[i].g;
             entry[2] = pal->colors[i].r;
             entry[3] = (i == ckey) ? 0 : 0xff;
-            if (!SDL_RWwrite (out, entry, h.cmap_bits >> 3, 1))
-                return -1;
+            if (!tga_write (&writer, entry, h.cmap_bits >> 3))
+                goto error;
         }
     }
 
-    linebuf = SDL_CreateRGBSurface (SDL_SWSURFACE, surface->w, 1, h.pixel_bits,
-                                    rmask, gmask, bmask, amask);
-    if (!linebuf)
-        return -1;
-    if (h.has_cmap)
-        SDL_SetColors (linebuf, surface->format->palette->colors, 0,
-                       surface->format->palette->ncolors);
+    /* Rows already in the order of the file are written as they are */
+    direct = !SDL_MUSTLOCK (surface) &&
+        surface->format->BitsPerPixel == h.pixel_bits &&
+        (h.has_cmap ||
+         (surface->format->Rmask == rmask && surface->format->Gmask == gmask &&
+          surface->format->Bmask == bmask && surface->format->Amask == amask));
+    if (!direct)
+    {
+        linebuf = SDL_CreateRGBSurface (SDL_SWSURFACE, surface->w, 1,
+                                        h.pixel_bits, rmask, gmask, bmask,
+                                        amask);
+        if (!linebuf)
+            goto error;
+    }
     if (rle)
     {
         rlebuf = malloc (bpp * surface->w + 1 + surface->w / TGA_RLE_MAX);
@@ -1263,21 +1985,29 @@ SaveTGA_RW (SDL_Surface *surface, SDL_RWops *out, int rle)
     {
         int n;
         void *buf;
-        if (SDL_BlitSurface (surface, &r, linebuf, NULL) < 0)
-            break;
+        if (direct)
+            row = (Uint8 *) surface->pixels + r.y * surface->pitch;
+        else
+        {
+            if (SDL_BlitSurface (surface, &r, linebuf, NULL) < 0)
+                break;
+            row = linebuf->pixels;
+        }
         if (rle)
         {
             buf = rlebuf;
-            n = rle_line (linebuf->pixels, rlebuf, surface->w, bpp);
+            n = rle_line (row, rlebuf, surface->w, bpp);
         }
         else
         {
-            buf = linebuf->pixels;
+            buf = row;
             n = surface->w * bpp;
         }
-        if (!SDL_RWwrite (out, buf, n, 1))
+        if (!tga_write (&writer, buf, n))
             break;
     }
+    if (r.y == surface->h && tga_flush (&writer))
+        result = 0;
 
     /* restore flags */
     if (surf_flags & SDL_SRCALPHA)
@@ -1286,9 +2016,11 @@ SaveTGA_RW (SDL_Surface *surface, SDL_RWops *out, int rle)
         SDL_SetColorKey (surface, SDL_SRCCOLORKEY, surface->format->colorkey);
 
 error:
+    free (writer.buf);
     free (rlebuf);
-    SDL_FreeSurface (linebuf);
-    return 0;
+    if (linebuf)
+        SDL_FreeSurface (linebuf);
+    return result;
 }
 
 static int
@@ -1306,13 +2038,22 @@ SaveTGA (SDL_Surface *surface, const char *file, int rle)
 static PyMethodDef _image_methods[] =
 {
     { "load_basic", image_load_basic, METH_VARARGS, DOC_PYGAMEIMAGELOAD },
-    { "save", image_save, METH_VARARGS, DOC_PYGAMEIMAGESAVE },
+    { "load_many_basic", (PyCFunction) image_load_many_basic,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGELOADMANY },
+    { "save", (PyCFunction) image_save, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEIMAGESAVE },
     { "get_extended", (PyCFunction) image_get_extended, METH_NOARGS,
       DOC_PYGAMEIMAGEGETEXTENDED },
 
     { "tostring", image_tostring, METH_VARARGS, DOC_PYGAMEIMAGETOSTRING },
+#if PG_ENABLE_NEWBUF
+    { "tobuffer", image_tobuffer, METH_VARARGS, DOC_PYGAMEIMAGETOBUFFER },
+#endif
     { "fromstring", image_fromstring, METH_VARARGS, DOC_PYGAMEIMAGEFROMSTRING },
     { "frombuffer", image_frombuffer, METH_VARARGS, DOC_PYGAMEIMAGEFROMBUFFER },
+    { "save_atlas", (PyCFunction) image_save_atlas,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGESAVEATLAS },
+    { "load_atlas", image_load_atlas, METH_VARARGS, DOC_PYGAMEIMAGELOADATLAS },
 
     { NULL, NULL, 0, NULL }
 };
@@ -1353,6 +2094,11 @@ MODINIT_DEFINE (image)
     {
         MODINIT_ERROR;
     }
+    import_pygame_rect ();
+    if (PyErr_Occurred ())
+    {
+        MODINIT_ERROR;
+    }
 
     /* create the module */
 #if PY3
@@ -1373,6 +2119,14 @@ MODINIT_DEFINE (image)
     {
         PyObject *extload;
         PyObject *extsave;
+        PyObject *extloadmany;
+        PyObject *extfunc;
+        static const char *extnames[] = {"save_async_extended",
+                                         "wait_saves_extended",
+                                         "load_jpeg_extended"};
+        static const char *names[] = {"save_async", "wait_saves",
+                                      "load_jpeg"};
+        int i;
 
         extload = PyObject_GetAttrString (extmodule, "load_extended");
         if (!extload)
@@ -1407,16 +2161,54 @@ MODINIT_DEFINE (image)
             Py_DECREF (extmodule);
             MODINIT_ERROR;
         }
+        extloadmany = PyObject_GetAttrString (extmodule, "load_many_extended");
+        if (!extloadmany)
+        {
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
+        if (PyModule_AddObject (module, "load_many", extloadmany))
+        {
+            Py_DECREF (extloadmany);
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
+        /* Missing if imageext was built without PNG or JPEG */
+        for (i = 0; i < 3; ++i)
+        {
+            extfunc = PyObject_GetAttrString (extmodule, extnames[i]);
+            if (!extfunc)
+            {
+                PyErr_Clear ();
+                Py_INCREF (Py_None);
+                extfunc = Py_None;
+            }
+            if (PyModule_AddObject (module, names[i], extfunc))
+            {
+                Py_DECREF (extfunc);
+                Py_DECREF (extmodule);
+                MODINIT_ERROR;
+            }
+        }
         Py_DECREF (extmodule);
         st->is_extended = 1;
     }
     else
     {
         PyObject* basicload = PyObject_GetAttrString (module, "load_basic");
+        PyObject* basicloadmany = PyObject_GetAttrString (module,
+                                                          "load_many_basic");
         PyErr_Clear ();
         PyModule_AddObject (module, "load_extended", Py_None);
         PyModule_AddObject (module, "save_extended", Py_None);
         PyModule_AddObject (module, "load", basicload);
+        PyModule_AddObject (module, "load_many", basicloadmany);
+        Py_INCREF (Py_None);
+        PyModule_AddObject (module, "save_async", Py_None);
+        Py_INCREF (Py_None);
+        PyModule_AddObject (module, "wait_saves", Py_None);
+        Py_INCREF (Py_None);
+        PyModule_AddObject (module, "load_jpeg", Py_None);
         st->is_extended = 0;
     }
     MODINIT_RETURN (module);
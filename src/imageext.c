@@ -34,6 +34,8 @@
 #endif
 #include <jpeglib.h>
 #include <jerror.h>
+#include <setjmp.h>
+#include <ctype.h>
 
 /* Keep a stray macro from conflicting with python.h */
 #if defined(HAVE_PROTOTYPES)
@@ -51,6 +53,7 @@
 #include "doc/image_doc.h"
 #include "pgopengl.h"
 #include <SDL_image.h>
+#include "pgloadmany.h"
 
 static const char*
 find_extension(const char *fullname)
@@ -68,6 +71,19 @@ find_extension(const char *fullname)
     return dot + 1;
 }
 
+/* IMG_Load, reading the file through RWopsFromFileName */
+static SDL_Surface*
+load_file(const char *file)
+{
+    SDL_RWops *rw = RWopsFromFileName(file);
+    const char *ext = strrchr(file, '.');
+
+    if (rw == NULL) {
+        return NULL;
+    }
+    return IMG_LoadTyped_RW(rw, 1, ext ? (char *)ext + 1 : NULL);
+}
+
 static PyObject*
 image_load_ext(PyObject *self, PyObject *arg)
 {
@@ -91,7 +107,7 @@ image_load_ext(PyObject *self, PyObject *arg)
     }
     if (oencoded != Py_None) {
         Py_BEGIN_ALLOW_THREADS;
-        surf = IMG_Load(Bytes_AS_STRING(oencoded));
+        surf = load_file(Bytes_AS_STRING(oencoded));
         Py_END_ALLOW_THREADS;
         Py_DECREF(oencoded);
     }
@@ -162,6 +178,18 @@ image_load_ext(PyObject *self, PyObject *arg)
     return final;
 }
 
+static PyObject*
+image_load_many_ext(PyObject *self, PyObject *arg, PyObject *kwds)
+{
+#if (SDL_IMAGE_MAJOR_VERSION * 1000 + SDL_IMAGE_MINOR_VERSION * 100 + \
+     SDL_IMAGE_PATCHLEVEL) >= 1208
+    /* The decoder libraries are otherwise loaded on first use, which is
+       not safe from more than one thread at once. */
+    IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG | IMG_INIT_TIF);
+#endif
+    return pg_load_many(arg, kwds, load_file);
+}
+
 #ifdef PNG_H
 
 static void
@@ -184,18 +212,30 @@ png_flush_fn (png_structp png_ptr)
     }
 }
 
+/* zlib level and PNG_FILTER_ flags, or -1 for the libpng default */
+typedef struct
+{
+    int compression;
+    int filters;
+} PngOptions;
+
+static SDL_Surface* opengltosdl (void);
+
 static int
 write_png (const char *file_name,
-           png_bytep *rows,
+           png_bytep pixels,
+           int pitch,
            int w,
            int h,
            int colortype,
-           int bitdepth)
+           int bitdepth,
+           const PngOptions *options)
 {
     png_structp png_ptr = NULL;
     png_infop info_ptr =  NULL;
     FILE *fp = NULL;
     char *doing = "open for writing";
+    int y;
 
     if (!(fp = fopen (file_name, "wb")))
         goto fail;
@@ -213,6 +253,10 @@ write_png (const char *file_name,
 
     doing = "init IO";
     png_set_write_fn (png_ptr, fp, png_write_fn, png_flush_fn);
+    if (options->compression >= 0)
+        png_set_compression_level (png_ptr, options->compression);
+    if (options->filters >= 0)
+        png_set_filter (png_ptr, PNG_FILTER_TYPE_BASE, options->filters);
 
     doing = "write header";
     png_set_IHDR (png_ptr, info_ptr, w, h, bitdepth, colortype,
@@ -222,8 +266,10 @@ write_png (const char *file_name,
     doing = "write info";
     png_write_info (png_ptr, info_ptr);
 
+    /* Row by row, so no table of row pointers is needed */
     doing = "write image";
-    png_write_image (png_ptr, rows);
+    for (y = 0; y < h; ++y)
+        png_write_row (png_ptr, pixels + y * pitch);
 
     doing = "write end";
     png_write_end (png_ptr, NULL);
@@ -249,31 +295,25 @@ fail:
     return -1;
 }
 
-static int
-SavePNG (SDL_Surface *surface, const char *file)
+/* A copy of surface as the RGB or RGBA bytes of PNG rows. Changes the
+ * alpha and colorkey settings of surface while copying, so needs the GIL.
+ */
+static SDL_Surface*
+png_snapshot (SDL_Surface *surface)
 {
-    static unsigned char** ss_rows;
-    static int ss_size;
-    static int ss_w, ss_h;
     SDL_Surface *ss_surface;
     SDL_Rect ss_rect;
-    int r, i;
-    int alpha = 0;
+    int ss_w, ss_h;
 
     unsigned surf_flags;
     unsigned surf_alpha;
     unsigned surf_colorkey;
 
-    ss_rows = 0;
-    ss_size = 0;
-    ss_surface = NULL;
-
     ss_w = surface->w;
     ss_h = surface->h;
 
     if (surface->format->Amask)
     {
-        alpha = 1;
         ss_surface = SDL_CreateRGBSurface (SDL_SWSURFACE|SDL_SRCALPHA,
                                            ss_w, ss_h, 32,
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
@@ -296,7 +336,7 @@ SavePNG (SDL_Surface *surface, const char *file)
     }
 
     if (ss_surface == NULL)
-        return -1;
+        return NULL;
 
     surf_flags = surface->flags & (SDL_SRCALPHA | SDL_SRCCOLORKEY);
     surf_alpha = surface->format->alpha;
@@ -313,39 +353,292 @@ SavePNG (SDL_Surface *surface, const char *file)
     ss_rect.h = ss_h;
     SDL_BlitSurface (surface, &ss_rect, ss_surface, NULL);
 
-    if (ss_size == 0)
-    {
-        ss_size = ss_h;
-        ss_rows = (unsigned char**) malloc (sizeof (unsigned char*) * ss_size);
-        if (ss_rows == NULL)
-            return -1;
-    }
     if (surf_flags & SDL_SRCALPHA)
         SDL_SetAlpha (surface, SDL_SRCALPHA, (Uint8)surf_alpha);
     if (surf_flags & SDL_SRCCOLORKEY)
         SDL_SetColorKey (surface, SDL_SRCCOLORKEY, surf_colorkey);
+    return ss_surface;
+}
 
-    for (i = 0; i < ss_h; i++)
-    {
-        ss_rows[i] = ((unsigned char*)ss_surface->pixels) +
-            i * ss_surface->pitch;
+/* Write a surface made by png_snapshot; needs no GIL */
+static int
+write_png_snapshot (const char *file, SDL_Surface *ss_surface,
+                    const PngOptions *options)
+{
+    return write_png (file, (png_bytep) ss_surface->pixels,
+                      ss_surface->pitch, ss_surface->w, ss_surface->h,
+                      ss_surface->format->Amask ? PNG_COLOR_TYPE_RGB_ALPHA :
+                      PNG_COLOR_TYPE_RGB, 8, options);
+}
+
+/* Parse the compression and filter arguments of save into options */
+static int
+png_options (int compression, PyObject *filter, PngOptions *options)
+{
+    static const char *names[] = {"none", "sub", "up", "avg", "paeth",
+                                  "all", NULL};
+    static const int filters[] = {PNG_FILTER_NONE, PNG_FILTER_SUB,
+                                  PNG_FILTER_UP, PNG_FILTER_AVG,
+                                  PNG_FILTER_PAETH, PNG_ALL_FILTERS};
+    PyObject *oencoded;
+    const char *name;
+    int i;
+
+    if (compression < -1 || compression > 9) {
+        PyErr_SetString(PyExc_ValueError,
+                        "compression must be from 0 to 9, or -1");
+        return 0;
+    }
+    options->compression = compression;
+    options->filters = -1;
+    if (filter == NULL || filter == Py_None) {
+        return 1;
+    }
+    oencoded = RWopsEncodeString(filter, NULL, NULL, NULL);
+    if (oencoded == NULL) {
+        return 0;
     }
+    if (oencoded != Py_None) {
+        name = Bytes_AS_STRING(oencoded);
+        for (i = 0; names[i]; ++i) {
+            if (!strcmp(name, names[i])) {
+                options->filters = filters[i];
+                break;
+            }
+        }
+    }
+    Py_DECREF(oencoded);
+    if (options->filters < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "filter must be None, 'none', 'sub', 'up', 'avg', "
+                        "'paeth' or 'all'");
+        return 0;
+    }
+    return 1;
+}
 
-    if (alpha)
+/* save_async writes on one background thread, taking snapshots from a
+ * queue in the order they were saved.
+ */
+typedef struct PngSaveJob
+{
+    SDL_Surface         *snapshot;
+    char                *file;
+    PngOptions           options;
+    struct PngSaveJob   *next;
+} PngSaveJob;
+
+static struct
+{
+    SDL_Thread  *thread;
+    SDL_mutex   *lock;
+    SDL_cond    *changed;   /* signalled for a new job, or one finished */
+    PngSaveJob  *first;
+    PngSaveJob  *last;
+    int          busy;      /* a job is being written */
+    int          quit;
+    int          failed;    /* error holds the first failure */
+    char         error[512];
+} png_saver;
+
+static int
+png_save_worker (void *data)
+{
+    PngSaveJob *job;
+    int result;
+
+    SDL_LockMutex (png_saver.lock);
+    for (;;)
     {
-        r = write_png (file, ss_rows, surface->w, surface->h,
-                       PNG_COLOR_TYPE_RGB_ALPHA, 8);
+        while (!png_saver.first && !png_saver.quit)
+            SDL_CondWait (png_saver.changed, png_saver.lock);
+        if (!png_saver.first)
+            break;
+        job = png_saver.first;
+        png_saver.first = job->next;
+        if (!png_saver.first)
+            png_saver.last = NULL;
+        png_saver.busy = 1;
+        SDL_UnlockMutex (png_saver.lock);
+
+        result = write_png_snapshot (job->file, job->snapshot, &job->options);
+
+        SDL_LockMutex (png_saver.lock);
+        if (result && !png_saver.failed)
+        {
+            strncpy (png_saver.error, SDL_GetError (),
+                     sizeof (png_saver.error) - 1);
+            png_saver.failed = 1;
+        }
+        png_saver.busy = 0;
+        SDL_CondBroadcast (png_saver.changed);
+        SDL_FreeSurface (job->snapshot);
+        free (job->file);
+        free (job);
     }
-    else
-    {
-        r = write_png (file, ss_rows, surface->w, surface->h,
-                       PNG_COLOR_TYPE_RGB, 8);
+    SDL_UnlockMutex (png_saver.lock);
+    return 0;
+}
+
+/* Wait with the GIL released for every queued save to be written. Returns
+ * 0 with pygame.error set if any failed since the last wait.
+ */
+static int
+png_saver_wait (void)
+{
+    int failed = 0;
+
+    if (!png_saver.lock)
+        return 1;
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex (png_saver.lock);
+    while (png_saver.first || png_saver.busy)
+        SDL_CondWait (png_saver.changed, png_saver.lock);
+    failed = png_saver.failed;
+    png_saver.failed = 0;
+    SDL_UnlockMutex (png_saver.lock);
+    Py_END_ALLOW_THREADS;
+    if (failed) {
+        PyErr_SetString(PyExc_SDLError, png_saver.error);
+        return 0;
     }
+    return 1;
+}
 
-    free (ss_rows);
-    SDL_FreeSurface (ss_surface);
-    ss_surface = NULL;
-    return r;
+/* Finish the queued saves and stop the thread when pygame quits */
+static void
+png_saver_autoquit (void)
+{
+    if (!png_saver.thread)
+        return;
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex (png_saver.lock);
+    png_saver.quit = 1;
+    SDL_CondBroadcast (png_saver.changed);
+    SDL_UnlockMutex (png_saver.lock);
+    SDL_WaitThread (png_saver.thread, NULL);
+    Py_END_ALLOW_THREADS;
+    png_saver.thread = NULL;
+    png_saver.quit = 0;
+    png_saver.failed = 0;
+}
+
+static int
+png_saver_start (void)
+{
+    if (!png_saver.lock) {
+        png_saver.lock = SDL_CreateMutex();
+        if (png_saver.lock == NULL) {
+            return 0;
+        }
+    }
+    if (!png_saver.changed) {
+        png_saver.changed = SDL_CreateCond();
+        if (png_saver.changed == NULL) {
+            return 0;
+        }
+    }
+    if (!png_saver.thread) {
+        png_saver.thread = SDL_CreateThread(png_save_worker, NULL);
+        if (png_saver.thread == NULL) {
+            return 0;
+        }
+        PyGame_RegisterQuit(png_saver_autoquit);
+    }
+    return 1;
+}
+
+static PyObject*
+image_save_async_ext(PyObject *self, PyObject *arg, PyObject *kwds)
+{
+    PyObject *surfobj;
+    PyObject *obj;
+    PyObject *filter = NULL;
+    PyObject *oencoded;
+    SDL_Surface *surf;
+    SDL_Surface *temp = NULL;
+    PngOptions options;
+    PngSaveJob *job;
+    int compression = -1;
+    static char *kwids[] = {"surface", "filename", "compression", "filter",
+                            NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "O!O|iO", kwids,
+                                     &PySurface_Type, &surfobj, &obj,
+                                     &compression, &filter)) {
+        return NULL;
+    }
+    if (!png_options(compression, filter, &options)) {
+        return NULL;
+    }
+    oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
+    if (oencoded == NULL) {
+        return NULL;
+    }
+    if (oencoded == Py_None) {
+        Py_DECREF(oencoded);
+        return RAISE(PyExc_TypeError,
+                     "save_async can only write to a file name");
+    }
+
+    job = (PngSaveJob *)malloc(sizeof(PngSaveJob));
+    if (job == NULL ||
+        (job->file = (char *)malloc(Bytes_GET_SIZE(oencoded) + 1)) == NULL) {
+        free(job);
+        Py_DECREF(oencoded);
+        return PyErr_NoMemory();
+    }
+    strcpy(job->file, Bytes_AS_STRING(oencoded));
+    Py_DECREF(oencoded);
+    job->options = options;
+    job->next = NULL;
+
+    surf = PySurface_AsSurface(surfobj);
+    if (surf->flags & SDL_OPENGL) {
+        temp = surf = opengltosdl();
+    }
+    else {
+        PySurface_Prep(surfobj);
+    }
+    job->snapshot = surf ? png_snapshot(surf) : NULL;
+    if (temp != NULL) {
+        SDL_FreeSurface(temp);
+    }
+    else if (surf != NULL) {
+        PySurface_Unprep(surfobj);
+    }
+    if (job->snapshot == NULL || !png_saver_start()) {
+        if (job->snapshot != NULL) {
+            SDL_FreeSurface(job->snapshot);
+        }
+        free(job->file);
+        free(job);
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_SDLError, SDL_GetError());
+        }
+        return NULL;
+    }
+
+    SDL_LockMutex(png_saver.lock);
+    if (png_saver.last) {
+        png_saver.last->next = job;
+    }
+    else {
+        png_saver.first = job;
+    }
+    png_saver.last = job;
+    SDL_CondBroadcast(png_saver.changed);
+    SDL_UnlockMutex(png_saver.lock);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+image_wait_saves_ext(PyObject *self)
+{
+    if (!png_saver_wait()) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
 }
 
 #endif /* end if PNG_H */
@@ -354,17 +647,60 @@ SavePNG (SDL_Surface *surface, const char *file)
 
 #define NUM_LINES_TO_WRITE 500
 
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define RED_MASK 0xff0000
+#define GREEN_MASK 0xff00
+#define BLUE_MASK 0xff
+#else
+#define RED_MASK 0xff
+#define GREEN_MASK 0xff00
+#define BLUE_MASK 0xff0000
+#endif
+
+/* Options of save and load_jpeg */
+typedef struct {
+    int quality;                /* 0 to 100 */
+    J_DCT_METHOD dct;
+    int h_samp, v_samp;         /* of the luminance, 0 for the default */
+} JpegOptions;
+
+/* The libjpeg default error handler exits the program; this one jumps
+ * back to the caller with the message set as the SDL error.
+ */
+typedef struct {
+    struct jpeg_error_mgr pub;
+    jmp_buf setjmp_buffer;
+} j_error_mgr;
+
+static void
+j_error_exit(j_common_ptr cinfo)
+{
+    j_error_mgr *err = (j_error_mgr *)cinfo->err;
+    char buffer[JMSG_LENGTH_MAX];
+
+    (*cinfo->err->format_message)(cinfo, buffer);
+    SDL_SetError("JPEG: %s", buffer);
+    longjmp(err->setjmp_buffer, 1);
+}
+
+static void
+j_output_message(j_common_ptr cinfo)
+{
+    /* Keep warnings off stderr */
+}
+
 /* Avoid conflicts with the libjpeg libraries C runtime bindings.
- * Adapted from code in the libjpeg file jdatadst.c .
+ * Adapted from code in the libjpeg file jdatadst.c, writing to an
+ * SDL_RWops, which is a file or a Python file object.
  */
- 
-#define OUTPUT_BUF_SIZE  4096	/* choose an efficiently fwrite'able size */
- 
-/* Expanded data destination object for stdio output */
+
+#define OUTPUT_BUF_SIZE  65536	/* few writes to a Python file object */
+
+/* Expanded data destination object for SDL_RWops output */
 typedef struct {
     struct jpeg_destination_mgr pub; /* public fields */
 
-    FILE *outfile;    /* target stream */
+    SDL_RWops *outfile;    /* target stream */
     JOCTET *buffer;   /* start of buffer */
 } j_outfile_mgr;
 
@@ -387,8 +723,8 @@ j_empty_output_buffer (j_compress_ptr cinfo)
 {
     j_outfile_mgr *dest = (j_outfile_mgr *) cinfo->dest;
 
-    if (fwrite(dest->buffer, 1, OUTPUT_BUF_SIZE, dest->outfile) !=
-        (size_t) OUTPUT_BUF_SIZE) {
+    if (SDL_RWwrite(dest->outfile, dest->buffer, 1, OUTPUT_BUF_SIZE) !=
+        OUTPUT_BUF_SIZE) {
         ERREXIT(cinfo, JERR_FILE_WRITE);
     }
     dest->pub.next_output_byte = dest->buffer;
@@ -405,19 +741,15 @@ j_term_destination (j_compress_ptr cinfo)
 
     /* Write any data remaining in the buffer */
     if (datacount > 0) {
-        if (fwrite(dest->buffer, 1, datacount, dest->outfile) != datacount) {
+        if (SDL_RWwrite(dest->outfile, dest->buffer, 1, (int)datacount) !=
+            (int)datacount) {
             ERREXIT(cinfo, JERR_FILE_WRITE);
         }
     }
-    fflush(dest->outfile);
-    /* Make sure we wrote the output file OK */
-    if (ferror(dest->outfile)) {
-        ERREXIT(cinfo, JERR_FILE_WRITE);
-    }
 }
 
 static void
-j_stdio_dest (j_compress_ptr cinfo, FILE *outfile)
+j_rwops_dest (j_compress_ptr cinfo, SDL_RWops *outfile)
 {
     j_outfile_mgr *dest;
 
@@ -443,12 +775,99 @@ j_stdio_dest (j_compress_ptr cinfo, FILE *outfile)
 /* End borrowed code
  */
 
-int write_jpeg (const char *file_name, unsigned char** image_buffer,
-                int image_width, int image_height, int quality) {
+/* The source manager to match, after jdatasrc.c */
+#define INPUT_BUF_SIZE  65536
+
+typedef struct {
+    struct jpeg_source_mgr pub;
+
+    SDL_RWops *infile;
+    JOCTET *buffer;
+    int start_of_file;
+} j_infile_mgr;
+
+static void
+j_init_source(j_decompress_ptr cinfo)
+{
+    ((j_infile_mgr *)cinfo->src)->start_of_file = 1;
+}
+
+static boolean
+j_fill_input_buffer(j_decompress_ptr cinfo)
+{
+    static const JOCTET eoi[2] = {0xFF, JPEG_EOI};
+    j_infile_mgr *src = (j_infile_mgr *)cinfo->src;
+    int nbytes = SDL_RWread(src->infile, src->buffer, 1, INPUT_BUF_SIZE);
+
+    if (nbytes <= 0) {
+        if (src->start_of_file) {
+            ERREXIT(cinfo, JERR_INPUT_EMPTY);
+        }
+        WARNMS(cinfo, JWRN_JPEG_EOF);
+        /* Insert a fake EOI marker, so a cut off file still decodes */
+        src->pub.next_input_byte = eoi;
+        src->pub.bytes_in_buffer = 2;
+        return TRUE;
+    }
+    src->pub.next_input_byte = src->buffer;
+    src->pub.bytes_in_buffer = nbytes;
+    src->start_of_file = 0;
+    return TRUE;
+}
+
+static void
+j_skip_input_data(j_decompress_ptr cinfo, long num_bytes)
+{
+    j_infile_mgr *src = (j_infile_mgr *)cinfo->src;
+
+    if (num_bytes <= 0) {
+        return;
+    }
+    while (num_bytes > (long)src->pub.bytes_in_buffer) {
+        num_bytes -= (long)src->pub.bytes_in_buffer;
+        (void)j_fill_input_buffer(cinfo);
+    }
+    src->pub.next_input_byte += num_bytes;
+    src->pub.bytes_in_buffer -= num_bytes;
+}
+
+static void
+j_term_source(j_decompress_ptr cinfo)
+{
+}
+
+static void
+j_rwops_src(j_decompress_ptr cinfo, SDL_RWops *infile)
+{
+    j_infile_mgr *src;
+
+    if (cinfo->src == NULL) {
+        cinfo->src = (struct jpeg_source_mgr *)
+            (*cinfo->mem->alloc_small)((j_common_ptr)cinfo, JPOOL_PERMANENT,
+                                       sizeof(j_infile_mgr));
+        src = (j_infile_mgr *)cinfo->src;
+        src->buffer = (JOCTET *)
+            (*cinfo->mem->alloc_small)((j_common_ptr)cinfo, JPOOL_PERMANENT,
+                                       INPUT_BUF_SIZE * sizeof(JOCTET));
+    }
+
+    src = (j_infile_mgr *)cinfo->src;
+    src->pub.init_source = j_init_source;
+    src->pub.fill_input_buffer = j_fill_input_buffer;
+    src->pub.skip_input_data = j_skip_input_data;
+    src->pub.resync_to_restart = jpeg_resync_to_restart;
+    src->pub.term_source = j_term_source;
+    src->pub.bytes_in_buffer = 0;
+    src->pub.next_input_byte = NULL;
+    src->infile = infile;
+}
+
+static int
+write_jpeg (SDL_RWops *outfile, unsigned char** image_buffer,
+            int image_width, int image_height, const JpegOptions *options) {
 
     struct jpeg_compress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-    FILE * outfile;
+    j_error_mgr jerr;
     JSAMPROW row_pointer[NUM_LINES_TO_WRITE];
     int num_lines_to_write;
     int i;
@@ -456,15 +875,15 @@ int write_jpeg (const char *file_name, unsigned char** image_buffer,
     num_lines_to_write = NUM_LINES_TO_WRITE;
 
 
-    cinfo.err = jpeg_std_error (&jerr);
-    jpeg_create_compress (&cinfo);
-
-    if ((outfile = fopen (file_name, "wb")) == NULL) {
-
-        SDL_SetError ("SaveJPEG: could not open %s", file_name);
+    cinfo.err = jpeg_std_error (&jerr.pub);
+    jerr.pub.error_exit = j_error_exit;
+    jerr.pub.output_message = j_output_message;
+    if (setjmp(jerr.setjmp_buffer)) {
+        jpeg_destroy_compress(&cinfo);
         return -1;
     }
-    j_stdio_dest (&cinfo, outfile);
+    jpeg_create_compress (&cinfo);
+    j_rwops_dest (&cinfo, outfile);
 
     cinfo.image_width = image_width;
     cinfo.image_height = image_height;
@@ -472,11 +891,15 @@ int write_jpeg (const char *file_name, unsigned char** image_buffer,
     cinfo.in_color_space = JCS_RGB;
     /* cinfo.optimize_coding = FALSE;
      */
-    /* cinfo.optimize_coding = FALSE;
-     */
 
     jpeg_set_defaults (&cinfo);
-    jpeg_set_quality (&cinfo, quality, TRUE);
+    jpeg_set_quality (&cinfo, options->quality, TRUE);
+    cinfo.dct_method = options->dct;
+    if (options->h_samp) {
+        /* The chroma components keep their 1x1 */
+        cinfo.comp_info[0].h_samp_factor = options->h_samp;
+        cinfo.comp_info[0].v_samp_factor = options->v_samp;
+    }
 
     jpeg_start_compress (&cinfo, TRUE);
 
@@ -497,112 +920,202 @@ int write_jpeg (const char *file_name, unsigned char** image_buffer,
     }
 
     jpeg_finish_compress (&cinfo);
-    fclose (outfile);
     jpeg_destroy_compress (&cinfo);
     return 0;
 }
 
-
-
-int SaveJPEG (SDL_Surface *surface, const char *file) {
-
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-#define RED_MASK 0xff0000
-#define GREEN_MASK 0xff00
-#define BLUE_MASK 0xff
-#else
-#define RED_MASK 0xff
-#define GREEN_MASK 0xff00
-#define BLUE_MASK 0xff0000
-#endif
-
-    static unsigned char** ss_rows;
-    static int ss_size;
-    static int ss_w, ss_h;
+/* A 24 bit RGB surface to save surface as JPEG, which is surface itself
+ * if it is suitable for using directly. Copying may change the alpha
+ * and colorkey settings of surface for a while, so needs the GIL.
+ */
+static SDL_Surface*
+jpeg_snapshot(SDL_Surface *surface)
+{
     SDL_Surface *ss_surface;
     SDL_Rect ss_rect;
-    int r, i;
-    int pixel_bits = 32;
-    int free_ss_surface = 1;
-
-
-
-    ss_rows = 0;
-    ss_size = 0;
-    ss_surface = NULL;
-
-    ss_w = surface->w;
-    ss_h = surface->h;
-
-    pixel_bits = 24;
-
-    if(!surface) {
-        return -1;
-    }
 
     /* See if the Surface is suitable for using directly.
        So no conversion is needed.  24bit, RGB
     */
+    if ((surface->format->BytesPerPixel == 3) &&
+        !(surface->flags & SDL_SRCALPHA) &&
+        (surface->format->Rmask == RED_MASK)) {
+        return surface;
+    }
 
-    if((surface->format->BytesPerPixel == 3) && !(surface->flags & SDL_SRCALPHA) && (surface->format->Rmask == RED_MASK)) {
-        /*
-           printf("not creating...\n");
-        */
-        ss_surface = surface;
-
-        free_ss_surface = 0;
-    } else {
-        /*
-        printf("creating...\n");
-        */
-
-        /* If it is not, then we need to make a new surface.
-         */
-
-
-        ss_surface = SDL_CreateRGBSurface (SDL_SWSURFACE,
-                                           ss_w, ss_h, pixel_bits,
-                                           RED_MASK, GREEN_MASK, BLUE_MASK, 0);
-        if (ss_surface == NULL) {
-            return -1;
-        }
-
-        ss_rect.x = 0;
-        ss_rect.y = 0;
-        ss_rect.w = ss_w;
-        ss_rect.h = ss_h;
-        SDL_BlitSurface (surface, &ss_rect, ss_surface, NULL);
-
-        free_ss_surface = 1;
+    /* If it is not, then we need to make a new surface.
+     */
+    ss_surface = SDL_CreateRGBSurface(SDL_SWSURFACE,
+                                      surface->w, surface->h, 24,
+                                      RED_MASK, GREEN_MASK, BLUE_MASK, 0);
+    if (ss_surface == NULL) {
+        return NULL;
     }
 
+    ss_rect.x = 0;
+    ss_rect.y = 0;
+    ss_rect.w = surface->w;
+    ss_rect.h = surface->h;
+    SDL_BlitSurface(surface, &ss_rect, ss_surface, NULL);
+    return ss_surface;
+}
 
-    ss_size = ss_h;
-    ss_rows = (unsigned char**) malloc (sizeof (unsigned char*) * ss_size);
-    if(ss_rows == NULL) {
-        /* clean up the allocated surface too */
-        if(free_ss_surface) {
-            SDL_FreeSurface (ss_surface);
-        }
+/* Write a surface made by jpeg_snapshot; needs the GIL only when outfile
+ * is a Python file object.
+ */
+static int
+write_jpeg_snapshot(SDL_RWops *outfile, SDL_Surface *ss_surface,
+                    const JpegOptions *options)
+{
+    unsigned char **ss_rows;
+    int r, i;
+
+    ss_rows = (unsigned char**)malloc(sizeof(unsigned char*) *
+                                      (ss_surface->h ? ss_surface->h : 1));
+    if (ss_rows == NULL) {
+        SDL_SetError("SaveJPEG: out of memory");
         return -1;
     }
 
     /* copy pointers to the scanlines... since they might not be packed.
      */
-    for (i = 0; i < ss_h; i++) {
+    for (i = 0; i < ss_surface->h; i++) {
         ss_rows[i] = ((unsigned char*)ss_surface->pixels) +
             i * ss_surface->pitch;
     }
-    r = write_jpeg (file, ss_rows, surface->w, surface->h, 85);
+    r = write_jpeg(outfile, ss_rows, ss_surface->w, ss_surface->h, options);
 
+    free(ss_rows);
+    return r;
+}
 
-    free (ss_rows);
+/* Read a JPEG from infile into a new 24 bit surface, decoded at 1/scale
+ * of its size; needs the GIL only when infile is a Python file object.
+ */
+static SDL_Surface*
+read_jpeg(SDL_RWops *infile, int scale, J_DCT_METHOD dct)
+{
+    struct jpeg_decompress_struct cinfo;
+    j_error_mgr jerr;
+    SDL_Surface * volatile surf = NULL;
+    JSAMPROW row;
+
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = j_error_exit;
+    jerr.pub.output_message = j_output_message;
+    if (setjmp(jerr.setjmp_buffer)) {
+        jpeg_destroy_decompress(&cinfo);
+        if (surf != NULL) {
+            SDL_FreeSurface(surf);
+        }
+        return NULL;
+    }
+    jpeg_create_decompress(&cinfo);
+    j_rwops_src(&cinfo, infile);
+    jpeg_read_header(&cinfo, TRUE);
+
+    cinfo.out_color_space = JCS_RGB;
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale;
+    cinfo.dct_method = dct;
+    jpeg_start_decompress(&cinfo);
+
+    surf = SDL_CreateRGBSurface(SDL_SWSURFACE,
+                                cinfo.output_width, cinfo.output_height, 24,
+                                RED_MASK, GREEN_MASK, BLUE_MASK, 0);
+    if (surf == NULL) {
+        jpeg_destroy_decompress(&cinfo);
+        return NULL;
+    }
+    while (cinfo.output_scanline < cinfo.output_height) {
+        row = ((JSAMPROW)surf->pixels) + cinfo.output_scanline * surf->pitch;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return surf;
+}
 
-    if(free_ss_surface) {
-        SDL_FreeSurface (ss_surface);
-        ss_surface = NULL;
+/* Parse a dct argument of save or load_jpeg */
+static int
+jpeg_dct(PyObject *dct, J_DCT_METHOD *method)
+{
+    static const char *names[] = {"islow", "ifast", "float", NULL};
+    static const J_DCT_METHOD methods[] = {JDCT_ISLOW, JDCT_IFAST,
+                                           JDCT_FLOAT};
+    PyObject *oencoded;
+    int i, found = 0;
+
+    *method = JDCT_ISLOW;
+    if (dct == NULL || dct == Py_None) {
+        return 1;
     }
-    return r;
+    oencoded = RWopsEncodeString(dct, NULL, NULL, NULL);
+    if (oencoded == NULL) {
+        return 0;
+    }
+    if (oencoded != Py_None) {
+        for (i = 0; names[i]; ++i) {
+            if (!strcmp(Bytes_AS_STRING(oencoded), names[i])) {
+                *method = methods[i];
+                found = 1;
+                break;
+            }
+        }
+    }
+    Py_DECREF(oencoded);
+    if (!found) {
+        PyErr_SetString(PyExc_ValueError,
+                        "dct must be None, 'islow', 'ifast' or 'float'");
+    }
+    return found;
+}
+
+/* Parse the quality, dct and subsampling arguments of save into options */
+static int
+jpeg_options(int quality, PyObject *dct, PyObject *subsampling,
+             JpegOptions *options)
+{
+    static const char *names[] = {"4:4:4", "4:2:2", "4:2:0", NULL};
+    static const int factors[][2] = {{1, 1}, {2, 1}, {2, 2}};
+    PyObject *oencoded;
+    int i;
+
+    if (quality < -1 || quality > 100) {
+        PyErr_SetString(PyExc_ValueError,
+                        "quality must be from 0 to 100, or -1");
+        return 0;
+    }
+    options->quality = quality < 0 ? 85 : quality;
+    options->h_samp = options->v_samp = 0;
+    if (!jpeg_dct(dct, &options->dct)) {
+        return 0;
+    }
+    if (subsampling == NULL || subsampling == Py_None) {
+        return 1;
+    }
+    oencoded = RWopsEncodeString(subsampling, NULL, NULL, NULL);
+    if (oencoded == NULL) {
+        return 0;
+    }
+    if (oencoded != Py_None) {
+        for (i = 0; names[i]; ++i) {
+            if (!strcmp(Bytes_AS_STRING(oencoded), names[i])) {
+                options->h_samp = factors[i][0];
+                options->v_samp = factors[i][1];
+                break;
+            }
+        }
+    }
+    Py_DECREF(oencoded);
+    if (!options->h_samp) {
+        PyErr_SetString(PyExc_ValueError,
+                        "subsampling must be None, '4:4:4', '4:2:2' or "
+                        "'4:2:0'");
+        return 0;
+    }
+    return 1;
 }
 
 #endif /* end if JPEGLIB_H */
@@ -675,24 +1188,117 @@ opengltosdl (void)
 }
 
 
+/* Whether the extension of name is ext, whatever its case */
+static int
+has_extension(const char *name, const char *ext)
+{
+    const char *cext = find_extension(name);
+
+    if (cext == NULL || cext == name) {
+        return 0;
+    }
+    for (; *cext && *ext; ++cext, ++ext) {
+        if (tolower((unsigned char)*cext) != *ext) {
+            return 0;
+        }
+    }
+    return !*cext && !*ext;
+}
+
 static PyObject*
-image_save_ext(PyObject *self, PyObject *arg)
+image_save_ext(PyObject *self, PyObject *arg, PyObject *kwds)
 {
     PyObject *surfobj;
     PyObject *obj;
+    PyObject *filter = NULL;
+    PyObject *dct = NULL;
+    PyObject *subsampling = NULL;
     PyObject *oencoded = NULL;
+    PyObject *oname;
+    const char *name = NULL;
+    const char *namehint = NULL;
+    int fileobj = 0;
     SDL_Surface *surf;
     SDL_Surface *temp = NULL;
+    int compression = -1;
+    int quality = -1;
     int result = 1;
+    static char *kwids[] = {"surface", "filename", "compression", "filter",
+                            "quality", "dct", "subsampling", "namehint",
+                            NULL};
+#ifdef PNG_H
+    PngOptions options;
+#endif
+#ifdef JPEGLIB_H
+    JpegOptions joptions;
+    SDL_RWops *rw;
+#endif
+#if defined(PNG_H) || defined(JPEGLIB_H)
+    SDL_Surface *snapshot;
+#endif
 
-    if (!PyArg_ParseTuple(arg, "O!O", &PySurface_Type, &surfobj, &obj)) {
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "O!O|iOiOOz", kwids,
+                                     &PySurface_Type, &surfobj, &obj,
+                                     &compression, &filter, &quality, &dct,
+                                     &subsampling, &namehint)) {
         return NULL;
     }
+#ifdef PNG_H
+    if (!png_options(compression, filter, &options)) {
+        return NULL;
+    }
+#endif
+#ifdef JPEGLIB_H
+    if (!jpeg_options(quality, dct, subsampling, &joptions)) {
+        return NULL;
+    }
+#endif
+
+    oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
+    if (oencoded == NULL) {
+        return NULL;
+    }
+    if (oencoded != Py_None) {
+        name = Bytes_AS_STRING(oencoded);
+    }
+    else {
+        /* A file object, which only JPEG is written to; the type is from
+           namehint or the object's name */
+        Py_DECREF(oencoded);
+        oencoded = NULL;
+        fileobj = 1;
+        name = namehint;
+        if (name == NULL) {
+            oname = PyObject_GetAttrString(obj, "name");
+            if (oname != NULL) {
+                oencoded = RWopsEncodeFilePath(oname, NULL);
+                Py_DECREF(oname);
+                if (oencoded == NULL) {
+                    return NULL;
+                }
+                if (oencoded != Py_None) {
+                    name = Bytes_AS_STRING(oencoded);
+                }
+            }
+            else {
+                PyErr_Clear();
+            }
+        }
+        if (name == NULL ||
+            !(has_extension(name, "jpg") || has_extension(name, "jpeg"))) {
+            Py_XDECREF(oencoded);
+            PyErr_Format(PyExc_TypeError,
+                         "Expected a string for the file argument: got %.1024s",
+                         Py_TYPE(obj)->tp_name);
+            return NULL;
+        }
+    }
 
     surf = PySurface_AsSurface(surfobj);
     if (surf->flags & SDL_OPENGL) {
         temp = surf = opengltosdl();
         if (surf == NULL) {
+            Py_XDECREF(oencoded);
             return NULL;
         }
     }
@@ -700,56 +1306,61 @@ image_save_ext(PyObject *self, PyObject *arg)
         PySurface_Prep(surfobj);
     }
 
-    oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
-    if (oencoded == Py_None) {
-        PyErr_Format(PyExc_TypeError,
-                     "Expected a string for the file argument: got %.1024s",
-                     Py_TYPE(obj)->tp_name);
-        result = -2;
-    }
-    else if (oencoded != NULL) {
-        const char *name = Bytes_AS_STRING(oencoded);
-        Py_ssize_t namelen = Bytes_GET_SIZE(oencoded);
-
-        if ((namelen >= 4) &&
-            (((name[namelen - 1]=='g' || name[namelen - 1]=='G') &&
-              (name[namelen - 2]=='e' || name[namelen - 2]=='E') &&
-              (name[namelen - 3]=='p' || name[namelen - 3]=='P') &&
-              (name[namelen - 4]=='j' || name[namelen - 4]=='J')) ||
-             ((name[namelen - 1]=='g' || name[namelen - 1]=='G') &&
-              (name[namelen - 2]=='p' || name[namelen - 2]=='P') &&
-              (name[namelen - 3]=='j' || name[namelen - 3]=='J'))))  {
+    if (has_extension(name, "jpg") || has_extension(name, "jpeg")) {
 #ifdef JPEGLIB_H
-            /* jpg save functions seem *NOT* thread safe at least on windows. */
-            /*
+        /* Only the copy of the pixels needs the GIL, and writing to a
+           Python file object */
+        snapshot = jpeg_snapshot(surf);
+        if (snapshot == NULL) {
+            result = -1;
+        }
+        else if (fileobj) {
+            rw = RWopsFromFileObject(obj);
+            if (rw == NULL) {
+                result = -2;
+            }
+            else {
+                result = write_jpeg_snapshot(rw, snapshot, &joptions);
+                SDL_RWclose(rw);
+            }
+        }
+        else {
             Py_BEGIN_ALLOW_THREADS;
-            */
-            result = SaveJPEG(surf, name);
-            /*
+            rw = SDL_RWFromFile(name, "wb");
+            if (rw == NULL) {
+                result = -1;
+            }
+            else {
+                result = write_jpeg_snapshot(rw, snapshot, &joptions);
+                SDL_RWclose(rw);
+            }
             Py_END_ALLOW_THREADS;
-            */
-#else
-            RAISE(PyExc_SDLError, "No support for jpg compiled in.");
-            result = -2;
-#endif
-
         }
-        else if ((namelen >= 3) &&
-                 ((name[namelen - 1]=='g' || name[namelen - 1]=='G') &&
-                  (name[namelen - 2]=='n' || name[namelen - 2]=='N') &&
-                  (name[namelen - 3]=='p' || name[namelen - 3]=='P')))  {
-#ifdef PNG_H
-            /*Py_BEGIN_ALLOW_THREADS; */
-            result = SavePNG(surf, name);
-            /*Py_END_ALLOW_THREADS; */
+        if (snapshot != NULL && snapshot != surf) {
+            SDL_FreeSurface(snapshot);
+        }
 #else
-            RAISE(PyExc_SDLError, "No support for png compiled in.");
-            result = -2;
+        RAISE(PyExc_SDLError, "No support for jpg compiled in.");
+        result = -2;
 #endif
-        }
     }
-    else {
+    else if (has_extension(name, "png")) {
+#ifdef PNG_H
+        /* Only the copy of the pixels needs the GIL */
+        snapshot = png_snapshot(surf);
+        if (snapshot == NULL) {
+            result = -1;
+        }
+        else {
+            Py_BEGIN_ALLOW_THREADS;
+            result = write_png_snapshot(name, snapshot, &options);
+            Py_END_ALLOW_THREADS;
+            SDL_FreeSurface(snapshot);
+        }
+#else
+        RAISE(PyExc_SDLError, "No support for png compiled in.");
         result = -2;
+#endif
     }
 
     if (temp != NULL) {
@@ -775,10 +1386,73 @@ image_save_ext(PyObject *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+#ifdef JPEGLIB_H
+static PyObject*
+image_load_jpeg_ext(PyObject *self, PyObject *arg, PyObject *kwds)
+{
+    PyObject *obj;
+    PyObject *dct = NULL;
+    PyObject *final;
+    J_DCT_METHOD method;
+    SDL_RWops *rw;
+    SDL_Surface *surf;
+    int scale = 1;
+    static char *kwids[] = {"filename", "scale", "dct", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "O|iO", kwids,
+                                     &obj, &scale, &dct)) {
+        return NULL;
+    }
+    if (scale != 1 && scale != 2 && scale != 4 && scale != 8) {
+        return RAISE(PyExc_ValueError, "scale must be 1, 2, 4 or 8");
+    }
+    if (!jpeg_dct(dct, &method)) {
+        return NULL;
+    }
+
+    rw = RWopsFromObject(obj);
+    if (rw == NULL) {
+        return NULL;
+    }
+    if (RWopsCheckObject(rw)) {
+        surf = read_jpeg(rw, scale, method);
+        SDL_RWclose(rw);
+    }
+    else {
+        Py_BEGIN_ALLOW_THREADS;
+        surf = read_jpeg(rw, scale, method);
+        SDL_RWclose(rw);
+        Py_END_ALLOW_THREADS;
+    }
+
+    if (surf == NULL) {
+        return RAISE(PyExc_SDLError, SDL_GetError());
+    }
+    final = PySurface_New(surf);
+    if (final == NULL) {
+        SDL_FreeSurface(surf);
+    }
+    return final;
+}
+#endif /* JPEGLIB_H */
+
 static PyMethodDef _imageext_methods[] =
 {
     { "load_extended", image_load_ext, METH_VARARGS, DOC_PYGAMEIMAGE },
-    { "save_extended", image_save_ext, METH_VARARGS, DOC_PYGAMEIMAGE },
+    { "save_extended", (PyCFunction)image_save_ext,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGE },
+#ifdef PNG_H
+    { "save_async_extended", (PyCFunction)image_save_async_ext,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGESAVEASYNC },
+    { "wait_saves_extended", (PyCFunction)image_wait_saves_ext, METH_NOARGS,
+      DOC_PYGAMEIMAGEWAITSAVES },
+#endif
+#ifdef JPEGLIB_H
+    { "load_jpeg_extended", (PyCFunction)image_load_jpeg_ext,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGELOADJPEG },
+#endif
+    { "load_many_extended", (PyCFunction)image_load_many_ext,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGELOADMANY },
     { NULL, NULL, 0, NULL }
 };
 
@@ -350,6 +350,183 @@ joy_get_hat (PyObject* self, PyObject* args)
     return Py_BuildValue ("(ii)", px, py);
 }
 
+/* The state of a Joystick written by get_state: JOYSTICK_STATE_HEADER
+ * integers, the id and the number of axes, buttons, hats and balls, then
+ * the axes as floats, the buttons as bits of 32 bit words, hat x, y pairs
+ * and ball dx, dy pairs. All fields are 4 bytes.
+ */
+#define JOYSTICK_STATE_HEADER 5
+
+static Py_ssize_t
+joy_state_size (SDL_Joystick *joy)
+{
+    return 4 * (JOYSTICK_STATE_HEADER + SDL_JoystickNumAxes (joy) +
+                (SDL_JoystickNumButtons (joy) + 31) / 32 +
+                2 * SDL_JoystickNumHats (joy) +
+                2 * SDL_JoystickNumBalls (joy));
+}
+
+/* Write the state of joy to buf, the axes with values within deadzone of
+ * the centre set to 0 and the rest scaled to still reach 1.
+ */
+static void
+joy_fill_state (int id, SDL_Joystick *joy, float deadzone, char *buf)
+{
+    Sint32 *header = (Sint32 *)buf;
+    float *axes = (float *)(header + JOYSTICK_STATE_HEADER);
+    Uint32 *buttons;
+    Sint32 *pairs;
+    int numaxes = SDL_JoystickNumAxes (joy);
+    int numbuttons = SDL_JoystickNumButtons (joy);
+    int numhats = SDL_JoystickNumHats (joy);
+    int numballs = SDL_JoystickNumBalls (joy);
+    float value, scale = deadzone < 1.0f ? 1.0f / (1.0f - deadzone) : 0.0f;
+    Uint8 hat;
+    int i;
+
+    header[0] = id;
+    header[1] = numaxes;
+    header[2] = numbuttons;
+    header[3] = numhats;
+    header[4] = numballs;
+
+    for (i = 0; i < numaxes; ++i) {
+        value = SDL_JoystickGetAxis (joy, i) / 32768.0f;
+        if (deadzone > 0.0f) {
+            if (value > deadzone) {
+                value = (value - deadzone) * scale;
+            }
+            else if (value < -deadzone) {
+                value = (value + deadzone) * scale;
+            }
+            else {
+                value = 0.0f;
+            }
+        }
+        axes[i] = value;
+    }
+
+    buttons = (Uint32 *)(axes + numaxes);
+    memset (buttons, 0, 4 * ((numbuttons + 31) / 32));
+    for (i = 0; i < numbuttons; ++i) {
+        if (SDL_JoystickGetButton (joy, i)) {
+            buttons[i / 32] |= (Uint32)1 << (i % 32);
+        }
+    }
+
+    pairs = (Sint32 *)(buttons + (numbuttons + 31) / 32);
+    for (i = 0; i < numhats; ++i) {
+        hat = SDL_JoystickGetHat (joy, i);
+        pairs[0] = hat & SDL_HAT_RIGHT ? 1 : hat & SDL_HAT_LEFT ? -1 : 0;
+        pairs[1] = hat & SDL_HAT_UP ? 1 : hat & SDL_HAT_DOWN ? -1 : 0;
+        pairs += 2;
+    }
+    for (i = 0; i < numballs; ++i) {
+        int dx, dy;
+
+        SDL_JoystickGetBall (joy, i, &dx, &dy);
+        pairs[0] = dx;
+        pairs[1] = dy;
+        pairs += 2;
+    }
+}
+
+/* The struct format of a state written by joy_fill_state */
+static PyObject*
+joy_state_format (SDL_Joystick *joy)
+{
+    return Text_FromFormat ("=%di%df%dI%di", JOYSTICK_STATE_HEADER,
+                            SDL_JoystickNumAxes (joy),
+                            (SDL_JoystickNumButtons (joy) + 31) / 32,
+                            2 * (SDL_JoystickNumHats (joy) +
+                                 SDL_JoystickNumBalls (joy)));
+}
+
+/* Write the states of the count joysticks in ids to out, or to a new
+ * bytearray if out is None. Returns the bytearray, or the number of
+ * bytes written to out.
+ */
+static PyObject*
+joy_write_states (int *ids, int count, PyObject *out, float deadzone)
+{
+    PyObject *states;
+    Pg_buffer pg_view;
+    Py_buffer *view_p = (Py_buffer *)&pg_view;
+    Py_ssize_t size = 0;
+    char *buf;
+    int i;
+
+    if (deadzone < 0.0f || deadzone > 1.0f) {
+        return RAISE (PyExc_ValueError, "deadzone must be from 0 to 1");
+    }
+    for (i = 0; i < count; ++i) {
+        size += joy_state_size (joystick_stickdata[ids[i]]);
+    }
+
+    if (out == Py_None) {
+        states = PyByteArray_FromStringAndSize (NULL, size);
+        if (!states) {
+            return NULL;
+        }
+        buf = PyByteArray_AS_STRING (states);
+    }
+    else {
+        if (PgObject_GetBuffer (out, &pg_view, PyBUF_WRITABLE)) {
+            return NULL;
+        }
+        if (view_p->len < size) {
+            PgBuffer_Release (&pg_view);
+            return RAISE (PyExc_ValueError,
+                          "out buffer is too small for the state");
+        }
+        states = NULL;
+        buf = (char *)view_p->buf;
+    }
+
+    for (i = 0; i < count; ++i) {
+        joy_fill_state (ids[i], joystick_stickdata[ids[i]], deadzone, buf);
+        buf += joy_state_size (joystick_stickdata[ids[i]]);
+    }
+
+    if (states) {
+        return states;
+    }
+    PgBuffer_Release (&pg_view);
+    return PyInt_FromSsize_t (size);
+}
+
+static PyObject*
+joy_get_state (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    int joy_id = PyJoystick_AsID (self);
+    PyObject *out = Py_None;
+    float deadzone = 0.0f;
+    static char *kwids[] = {"out", "deadzone", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|Of", kwids,
+                                      &out, &deadzone)) {
+        return NULL;
+    }
+
+    JOYSTICK_INIT_CHECK ();
+    if (!joystick_stickdata[joy_id]) {
+        return RAISE (PyExc_SDLError, "Joystick not initialized");
+    }
+    return joy_write_states (&joy_id, 1, out, deadzone);
+}
+
+static PyObject*
+joy_get_state_format (PyObject* self)
+{
+    SDL_Joystick* joy = joystick_stickdata[PyJoystick_AsID (self)];
+
+    JOYSTICK_INIT_CHECK ();
+    if (!joy) {
+        return RAISE (PyExc_SDLError, "Joystick not initialized");
+    }
+    return joy_state_format (joy);
+}
+
 static PyMethodDef joy_methods[] =
 {
     { "init", (PyCFunction) joy_init, METH_NOARGS, DOC_JOYSTICKINIT },
@@ -374,6 +551,11 @@ static PyMethodDef joy_methods[] =
       DOC_JOYSTICKGETNUMHATS },
     { "get_hat", joy_get_hat, METH_VARARGS, DOC_JOYSTICKGETHAT },
 
+    { "get_state", (PyCFunction) joy_get_state,
+      METH_VARARGS | METH_KEYWORDS, DOC_JOYSTICKGETSTATE },
+    { "get_state_format", (PyCFunction) joy_get_state_format, METH_NOARGS,
+      DOC_JOYSTICKGETSTATEFORMAT },
+
     { NULL, NULL, 0, NULL }
 };
 
@@ -438,6 +620,29 @@ PyJoystick_New (int id)
     return (PyObject*)joy;
 }
 
+static PyObject*
+get_states (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyObject *out = Py_None;
+    float deadzone = 0.0f;
+    int ids[JOYSTICK_MAXSTICKS];
+    int loop, count = 0;
+    static char *kwids[] = {"out", "deadzone", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|Of", kwids,
+                                      &out, &deadzone)) {
+        return NULL;
+    }
+
+    JOYSTICK_INIT_CHECK ();
+    for (loop = 0; loop < JOYSTICK_MAXSTICKS; ++loop) {
+        if (joystick_stickdata[loop]) {
+            ids[count++] = loop;
+        }
+    }
+    return joy_write_states (ids, count, out, deadzone);
+}
+
 static PyMethodDef _joystick_methods[] =
 {
     { "__PYGAMEinit__", (PyCFunction) joy_autoinit, METH_NOARGS,
@@ -449,6 +654,8 @@ static PyMethodDef _joystick_methods[] =
     { "get_count", (PyCFunction) get_count, METH_NOARGS,
       DOC_PYGAMEJOYSTICKGETCOUNT },
     { "Joystick", Joystick, METH_VARARGS, DOC_PYGAMEJOYSTICKJOYSTICK },
+    { "get_states", (PyCFunction) get_states, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEJOYSTICKGETSTATES },
     { NULL, NULL, 0, NULL }
 };
 
@@ -41,6 +41,182 @@
 
 static PyTypeObject PyMask_Type;
 
+/* Mask.overlap_many releases the GIL for at least this many tests */
+#define OVERLAP_MANY_NOGIL 64
+
+/* The pre-shifted copies of a mask for overlap tests.  When the mask is the
+   othermask of a test at an xoffset which is not a multiple of the word
+   size, the copy for that remainder is tested at the multiple below it
+   instead, which needs no shifting of words.  The copies are made when
+   first needed, and the least recently used one is dropped to keep at most
+   size of them. */
+typedef struct MaskShiftCache {
+    int size;
+    int count;
+    unsigned int clock;
+    bitmask_t *copies[BITMASK_W_LEN];
+    unsigned int used[BITMASK_W_LEN];
+} MaskShiftCache;
+
+static PyMaskObject* mask_new(void)
+{
+    PyMaskObject *maskobj = PyObject_New(PyMaskObject, &PyMask_Type);
+    if (maskobj) {
+        maskobj->mask = NULL;
+        maskobj->shifts = NULL;
+        maskobj->blocks = NULL;
+        maskobj->moments = NULL;
+    }
+    return maskobj;
+}
+
+/* drop the copies of a mask, when its bits change */
+static void mask_drop_shifts(PyObject *maskobj)
+{
+    MaskShiftCache *cache = ((PyMaskObject*)maskobj)->shifts;
+    int i;
+
+    if (!cache)
+        return;
+    for (i = 0; i < (int)BITMASK_W_LEN; i++) {
+        if (cache->copies[i]) {
+            bitmask_free(cache->copies[i]);
+            cache->copies[i] = NULL;
+        }
+    }
+    cache->count = 0;
+}
+
+/* what has to be done when bits in a rectangle of a mask change */
+static void mask_changed(PyObject *maskobj, int x, int y, int w, int h)
+{
+    bitmask_t *blocks = ((PyMaskObject*)maskobj)->blocks;
+
+    mask_drop_shifts(maskobj);
+    free(((PyMaskObject*)maskobj)->moments);
+    ((PyMaskObject*)maskobj)->moments = NULL;
+    if (blocks)
+        bitmask_blocks_update(blocks, PyMask_AsBitmap(maskobj), x, y, w, h);
+}
+
+/* The moments of a mask, kept until its bits change.  set_at, draw, erase,
+   fill, clear and invert update them instead: they take them from the mask
+   before mask_changed(), and give them back updated with
+   mask_keep_moments(). */
+static bitmask_moments_t* mask_take_moments(PyObject *maskobj)
+{
+    bitmask_moments_t *moments = ((PyMaskObject*)maskobj)->moments;
+
+    ((PyMaskObject*)maskobj)->moments = NULL;
+    return moments;
+}
+
+static void mask_keep_moments(PyObject *maskobj, bitmask_moments_t *moments)
+{
+    free(((PyMaskObject*)maskobj)->moments);
+    ((PyMaskObject*)maskobj)->moments = moments;
+}
+
+/* The moments of a mask, counted in one pass when not known.  Returns NULL
+   on memory allocation error. */
+static bitmask_moments_t* mask_moments(PyObject *maskobj)
+{
+    bitmask_t *mask = PyMask_AsBitmap(maskobj);
+    bitmask_moments_t *moments = ((PyMaskObject*)maskobj)->moments;
+
+    if (moments)
+        return moments;
+    moments = (bitmask_moments_t *) calloc(1, sizeof(bitmask_moments_t));
+    if (!moments)
+        return NULL;
+    bitmask_moments(mask, 0, 0, mask->w, mask->h, moments, 1);
+    ((PyMaskObject*)maskobj)->moments = moments;
+    return moments;
+}
+
+/* The moments of a mask with all w*h bits set */
+static void mask_full_moments(bitmask_t *mask, bitmask_moments_t *moments)
+{
+    long long w = mask->w, h = mask->h;
+    long long sx = w*(w - 1)/2, sy = h*(h - 1)/2;
+
+    moments->m00 = w*h;
+    moments->m10 = h*sx;
+    moments->m01 = w*sy;
+    moments->m11 = sx*sy;
+    moments->m20 = h*(w - 1)*w*(2*w - 1)/6;
+    moments->m02 = w*(h - 1)*h*(2*h - 1)/6;
+}
+
+/* The block map to use with the othermask mask_shifted() gave.  The map is
+   of the mask itself, so it isn't used for a shifted copy. */
+static bitmask_t* mask_other_blocks(PyObject *maskobj, bitmask_t *othermask)
+{
+    if (othermask != PyMask_AsBitmap(maskobj))
+        return NULL;
+    return ((PyMaskObject*)maskobj)->blocks;
+}
+
+/* The mask to test as the othermask at *xoffset, which is changed to the
+   offset to test it at.  That is the mask itself without a cache, or when a
+   copy can't be made. */
+static bitmask_t* mask_shifted(PyObject *maskobj, int *xoffset)
+{
+    bitmask_t *mask = PyMask_AsBitmap(maskobj);
+    MaskShiftCache *cache = ((PyMaskObject*)maskobj)->shifts;
+    bitmask_t *copy;
+    int i, shift, oldest;
+
+    shift = *xoffset & BITMASK_W_MASK;
+    if (!cache || !cache->size || !shift)
+        return mask;
+
+    copy = cache->copies[shift];
+    if (!copy) {
+        if (cache->count >= cache->size) {
+            oldest = -1;
+            for (i = 0; i < (int)BITMASK_W_LEN; i++) {
+                if (cache->copies[i] && (oldest < 0 ||
+                                         cache->used[i] < cache->used[oldest]))
+                    oldest = i;
+            }
+            bitmask_free(cache->copies[oldest]);
+            cache->copies[oldest] = NULL;
+            cache->count--;
+        }
+        copy = bitmask_create(mask->w + shift, mask->h);
+        if (!copy)
+            return mask;
+        bitmask_draw(copy, mask, shift, 0);
+        cache->copies[shift] = copy;
+        cache->count++;
+    }
+    cache->used[shift] = ++cache->clock;
+    *xoffset -= shift;
+    return copy;
+}
+
+/* An array.array('i') of the n ints at values */
+static PyObject* mask_int_array(const int *values, int n)
+{
+    PyObject *arraymodule, *bytes, *array;
+
+    arraymodule = PyImport_ImportModule("array");
+    if (!arraymodule)
+        return NULL;
+
+    /* the values go into the array as one block of C ints */
+    bytes = Bytes_FromStringAndSize((char *) values, sizeof(int) * n);
+    if (!bytes) {
+        Py_DECREF(arraymodule);
+        return NULL;
+    }
+    array = PyObject_CallMethod(arraymodule, "array", "sO", "i", bytes);
+    Py_DECREF(bytes);
+    Py_DECREF(arraymodule);
+    return array;
+}
+
 /* mask object methods */
 
 static PyObject* mask_get_size(PyObject* self, PyObject* args)
@@ -73,16 +249,29 @@ static PyObject* mask_get_at(PyObject* self, PyObject* args)
 static PyObject* mask_set_at(PyObject* self, PyObject* args)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
-    int x, y, value = 1;
+    bitmask_moments_t *moments;
+    int x, y, value = 1, sign;
 
     if(!PyArg_ParseTuple(args, "(ii)|i", &x, &y, &value))
             return NULL;
     if (x >= 0 && x < mask->w && y >= 0 && y < mask->h) {
+        moments = mask_take_moments(self);
+        sign = (value != 0) - bitmask_getbit(mask, x, y);
         if (value) {
             bitmask_setbit(mask, x, y);
         } else {
           bitmask_clearbit(mask, x, y);
         }
+        mask_changed(self, x, y, 1, 1);
+        if (moments) {
+            moments->m00 += sign;
+            moments->m10 += sign * x;
+            moments->m01 += sign * y;
+            moments->m11 += sign * (long long)x * y;
+            moments->m20 += sign * (long long)x * x;
+            moments->m02 += sign * (long long)y * y;
+            mask_keep_moments(self, moments);
+        }
     } else {
         PyErr_Format(PyExc_IndexError, "%d, %d is out of bounds", x, y);
         return NULL;
@@ -95,15 +284,23 @@ static PyObject* mask_overlap(PyObject* self, PyObject* args)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
     bitmask_t *othermask;
+    bitmask_t *blocks, *otherblocks;
     PyObject *maskobj;
     int x, y, val;
     int xp,yp;
 
     if(!PyArg_ParseTuple(args, "O!(ii)", &PyMask_Type, &maskobj, &x, &y))
             return NULL;
-    othermask = PyMask_AsBitmap(maskobj);
-
-    val = bitmask_overlap_pos(mask, othermask, x, y, &xp, &yp);
+    othermask = mask_shifted(maskobj, &x);
+    blocks = ((PyMaskObject*)self)->blocks;
+    otherblocks = mask_other_blocks(maskobj, othermask);
+
+    /* the block maps quickly tell of a miss, which is the usual result */
+    if ((blocks || otherblocks) &&
+        !bitmask_overlap_blocks(mask, blocks, othermask, otherblocks, x, y))
+        val = 0;
+    else
+        val = bitmask_overlap_pos(mask, othermask, x, y, &xp, &yp);
     if (val) {
       return Py_BuildValue("(ii)", xp,yp);
     } else {
@@ -123,9 +320,12 @@ static PyObject* mask_overlap_area(PyObject* self, PyObject* args)
     if(!PyArg_ParseTuple(args, "O!(ii)", &PyMask_Type, &maskobj, &x, &y)) {
         return NULL;
     }
-    othermask = PyMask_AsBitmap(maskobj);
+    othermask = mask_shifted(maskobj, &x);
 
-    val = bitmask_overlap_area(mask, othermask, x, y);
+    val = bitmask_overlap_area_blocks(mask, ((PyMaskObject*)self)->blocks,
+                                      othermask,
+                                      mask_other_blocks(maskobj, othermask),
+                                      x, y);
     return PyInt_FromLong(val);
 }
 
@@ -136,12 +336,12 @@ static PyObject* mask_overlap_mask(PyObject* self, PyObject* args)
     bitmask_t *output = bitmask_create(mask->w, mask->h);
     bitmask_t *othermask;
     PyObject *maskobj;
-    PyMaskObject *maskobj2 = PyObject_New(PyMaskObject, &PyMask_Type);
+    PyMaskObject *maskobj2 = mask_new();
 
     if(!PyArg_ParseTuple(args, "O!(ii)", &PyMask_Type, &maskobj, &x, &y)) {
         return NULL;
     }
-    othermask = PyMask_AsBitmap(maskobj);
+    othermask = mask_shifted(maskobj, &x);
 
     bitmask_overlap_mask(mask, othermask, output, x, y);
 
@@ -151,11 +351,175 @@ static PyObject* mask_overlap_mask(PyObject* self, PyObject* args)
     return (PyObject*)maskobj2;
 }
 
+/* One test of Mask.overlap_many */
+typedef struct {
+    bitmask_t *mask;
+    bitmask_t *blocks;
+    int x, y;
+} OverlapTest;
+
+/* Run the n tests of mask against tests, storing an area or an x, y pair
+   in results for each one. */
+static void overlap_tests(bitmask_t *mask, bitmask_t *blocks,
+                          const OverlapTest *tests, int n, int area,
+                          int *results)
+{
+    const OverlapTest *t;
+    int i;
+
+    for (i = 0, t = tests; i < n; i++, t++) {
+        if (area) {
+            results[i] = bitmask_overlap_area_blocks(mask, blocks, t->mask,
+                                                     t->blocks, t->x, t->y);
+        } else if (((blocks || t->blocks) &&
+                    !bitmask_overlap_blocks(mask, blocks, t->mask, t->blocks,
+                                            t->x, t->y)) ||
+                   !bitmask_overlap_pos(mask, t->mask, t->x, t->y,
+                                        results + 2 * i,
+                                        results + 2 * i + 1)) {
+            results[2 * i] = results[2 * i + 1] = -1;
+        }
+    }
+}
+
+static PyObject* mask_overlap_many(PyObject* self, PyObject* args)
+{
+    bitmask_t *mask = PyMask_AsBitmap(self);
+    PyObject *masksobj, *offsetsobj, *masks, *offsets = NULL, *item;
+    PyObject *result = NULL;
+    OverlapTest *tests = NULL;
+    int *results = NULL;
+    int area = 0, n, i, got = 0;
+
+    if(!PyArg_ParseTuple(args, "OO|i", &masksobj, &offsetsobj, &area)) {
+        return NULL;
+    }
+
+    masks = PySequence_Fast(masksobj, "masks must be a sequence");
+    if (!masks)
+        return NULL;
+    offsets = PySequence_Fast(offsetsobj, "offsets must be a sequence");
+    if (!offsets)
+        goto done;
+    n = PySequence_Fast_GET_SIZE(masks);
+    if (PySequence_Fast_GET_SIZE(offsets) != n) {
+        PyErr_SetString(PyExc_ValueError,
+                        "masks and offsets must be the same length");
+        goto done;
+    }
+
+    tests = (OverlapTest*) malloc(sizeof(OverlapTest) * (n ? n : 1));
+    results = (int*) malloc(sizeof(int) * (area ? 1 : 2) * (n ? n : 1));
+    if (!tests || !results) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    /* the masks are held while the tests run, as the GIL may be released */
+    for (got = 0; got < n; got++) {
+        item = PySequence_Fast_GET_ITEM(masks, got);
+        if (!PyObject_TypeCheck(item, &PyMask_Type)) {
+            PyErr_SetString(PyExc_TypeError, "masks must all be Masks");
+            goto done;
+        }
+        if (!TwoIntsFromObj(PySequence_Fast_GET_ITEM(offsets, got),
+                            &tests[got].x, &tests[got].y)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "offsets must be pairs of integers");
+            goto done;
+        }
+        Py_INCREF(item);
+        tests[got].mask = PyMask_AsBitmap(item);
+        tests[got].blocks = ((PyMaskObject*)item)->blocks;
+    }
+
+    if (n >= OVERLAP_MANY_NOGIL) {
+        Py_BEGIN_ALLOW_THREADS;
+        overlap_tests(mask, ((PyMaskObject*)self)->blocks, tests, n, area,
+                      results);
+        Py_END_ALLOW_THREADS;
+    }
+    else {
+        overlap_tests(mask, ((PyMaskObject*)self)->blocks, tests, n, area,
+                      results);
+    }
+
+    result = mask_int_array(results, (area ? 1 : 2) * n);
+
+  done:
+    for (i = 0; i < got; i++)
+        Py_DECREF(PySequence_Fast_GET_ITEM(masks, i));
+    Py_DECREF(masks);
+    Py_XDECREF(offsets);
+    free(tests);
+    free(results);
+    return result;
+}
+
+static PyObject* mask_set_overlap_cache(PyObject* self, PyObject* args)
+{
+    PyMaskObject *maskobj = (PyMaskObject*)self;
+    int size;
+
+    if(!PyArg_ParseTuple(args, "i", &size)) {
+        return NULL;
+    }
+
+    if (size <= 0) {
+        mask_drop_shifts(self);
+        free(maskobj->shifts);
+        maskobj->shifts = NULL;
+        Py_RETURN_NONE;
+    }
+
+    if (!maskobj->shifts) {
+        maskobj->shifts = (MaskShiftCache*) calloc(1, sizeof(MaskShiftCache));
+        if (!maskobj->shifts)
+            return RAISE (PyExc_MemoryError, "cannot create overlap cache");
+    }
+    /* keep the copies, unless there are more than the new size */
+    if (maskobj->shifts->count > size)
+        mask_drop_shifts(self);
+    maskobj->shifts->size = size;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* mask_set_block_map(PyObject* self, PyObject* args)
+{
+    PyMaskObject *maskobj = (PyMaskObject*)self;
+    int on = 1;
+
+    if(!PyArg_ParseTuple(args, "|i", &on)) {
+        return NULL;
+    }
+
+    if (!on) {
+        if (maskobj->blocks)
+            bitmask_free(maskobj->blocks);
+        maskobj->blocks = NULL;
+    }
+    else if (!maskobj->blocks) {
+        maskobj->blocks = bitmask_blocks_create(maskobj->mask);
+        if (!maskobj->blocks)
+            return RAISE (PyExc_MemoryError, "cannot create block map");
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject* mask_fill(PyObject* self, PyObject* args)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
 
+    bitmask_moments_t *moments = mask_take_moments(self);
+
     bitmask_fill(mask);
+    mask_changed(self, 0, 0, mask->w, mask->h);
+    if (moments) {
+        mask_full_moments(mask, moments);
+        mask_keep_moments(self, moments);
+    }
 
     Py_RETURN_NONE;
 }
@@ -164,7 +528,14 @@ static PyObject* mask_clear(PyObject* self, PyObject* args)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
 
+    bitmask_moments_t *moments = mask_take_moments(self);
+
     bitmask_clear(mask);
+    mask_changed(self, 0, 0, mask->w, mask->h);
+    if (moments) {
+        memset(moments, 0, sizeof(bitmask_moments_t));
+        mask_keep_moments(self, moments);
+    }
 
     Py_RETURN_NONE;
 }
@@ -173,7 +544,21 @@ static PyObject* mask_invert(PyObject* self, PyObject* args)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
 
+    bitmask_moments_t *moments = mask_take_moments(self);
+    bitmask_moments_t full;
+
     bitmask_invert(mask);
+    mask_changed(self, 0, 0, mask->w, mask->h);
+    if (moments) {
+        mask_full_moments(mask, &full);
+        moments->m00 = full.m00 - moments->m00;
+        moments->m10 = full.m10 - moments->m10;
+        moments->m01 = full.m01 - moments->m01;
+        moments->m11 = full.m11 - moments->m11;
+        moments->m20 = full.m20 - moments->m20;
+        moments->m02 = full.m02 - moments->m02;
+        mask_keep_moments(self, moments);
+    }
 
     Py_RETURN_NONE;
 }
@@ -183,16 +568,21 @@ static PyObject* mask_scale(PyObject* self, PyObject* args)
     int x, y;
     bitmask_t *input = PyMask_AsBitmap(self);
     bitmask_t *output;
-    PyMaskObject *maskobj = PyObject_New(PyMaskObject, &PyMask_Type);
+    PyMaskObject *maskobj;
 
     if(!PyArg_ParseTuple(args, "(ii)", &x, &y)) {
         return NULL;
     }
 
     output = bitmask_scale(input, x, y);
-
-    if(maskobj)
-        maskobj->mask = output;
+    if (!output)
+        return PyErr_NoMemory();
+    maskobj = mask_new();
+    if (!maskobj) {
+        bitmask_free(output);
+        return NULL;
+    }
+    maskobj->mask = output;
 
     return (PyObject*)maskobj;
 }
@@ -201,6 +591,7 @@ static PyObject* mask_draw(PyObject* self, PyObject* args)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
     bitmask_t *othermask;
+    bitmask_moments_t *moments;
     PyObject *maskobj;
     int x, y;
 
@@ -208,8 +599,17 @@ static PyObject* mask_draw(PyObject* self, PyObject* args)
         return NULL;
     }
     othermask = PyMask_AsBitmap(maskobj);
+    moments = mask_take_moments(self);
 
+    /* only the bits under othermask change */
+    if (moments)
+        bitmask_moments(mask, x, y, othermask->w, othermask->h, moments, -1);
     bitmask_draw(mask, othermask, x, y);
+    mask_changed(self, x, y, othermask->w, othermask->h);
+    if (moments) {
+        bitmask_moments(mask, x, y, othermask->w, othermask->h, moments, 1);
+        mask_keep_moments(self, moments);
+    }
 
     Py_RETURN_NONE;
 }
@@ -218,6 +618,7 @@ static PyObject* mask_erase(PyObject* self, PyObject* args)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
     bitmask_t *othermask;
+    bitmask_moments_t *moments;
     PyObject *maskobj;
     int x, y;
 
@@ -225,8 +626,17 @@ static PyObject* mask_erase(PyObject* self, PyObject* args)
         return NULL;
     }
     othermask = PyMask_AsBitmap(maskobj);
+    moments = mask_take_moments(self);
 
+    /* only the bits under othermask change */
+    if (moments)
+        bitmask_moments(mask, x, y, othermask->w, othermask->h, moments, -1);
     bitmask_erase(mask, othermask, x, y);
+    mask_changed(self, x, y, othermask->w, othermask->h);
+    if (moments) {
+        bitmask_moments(mask, x, y, othermask->w, othermask->h, moments, 1);
+        mask_keep_moments(self, moments);
+    }
 
     Py_RETURN_NONE;
 }
@@ -234,32 +644,24 @@ static PyObject* mask_erase(PyObject* self, PyObject* args)
 static PyObject* mask_count(PyObject* self, PyObject* args)
 {
     bitmask_t *m = PyMask_AsBitmap(self);
+    bitmask_moments_t *moments = ((PyMaskObject*)self)->moments;
 
+    if (moments)
+        return PyInt_FromLong((long)moments->m00);
     return PyInt_FromLong(bitmask_count(m));
 }
 
 static PyObject* mask_centroid(PyObject* self, PyObject* args)
 {
-    bitmask_t *mask = PyMask_AsBitmap(self);
-    int x, y;
-    long int m10, m01, m00;
+    bitmask_moments_t *moments = mask_moments(self);
     PyObject *xobj, *yobj;
 
-    m10 = m01 = m00 = 0;
-
-    for (x = 0; x < mask->w; x++) {
-        for (y = 0; y < mask->h; y++) {
-            if (bitmask_getbit(mask, x, y)) {
-               m10 += x;
-               m01 += y;
-               m00++;
-            }
-        }
-    }
+    if (!moments)
+        return PyErr_NoMemory();
 
-    if (m00) {
-        xobj = PyInt_FromLong(m10/m00);
-        yobj = PyInt_FromLong(m01/m00);
+    if (moments->m00) {
+        xobj = PyInt_FromLong((long)(moments->m10/moments->m00));
+        yobj = PyInt_FromLong((long)(moments->m01/moments->m00));
     } else {
         xobj = PyInt_FromLong(0);
         yobj = PyInt_FromLong(0);
@@ -270,89 +672,122 @@ static PyObject* mask_centroid(PyObject* self, PyObject* args)
 
 static PyObject* mask_angle(PyObject* self, PyObject* args)
 {
-    bitmask_t *mask = PyMask_AsBitmap(self);
-    int x, y, xc, yc;
-    long int m10, m01, m00, m20, m02, m11;
+    bitmask_moments_t *moments = mask_moments(self);
+    long long m00, xc, yc;
     double theta;
 
-    m10 = m01 = m00 = m20 = m02 = m11 = 0;
-
-    for (x = 0; x < mask->w; x++) {
-        for (y = 0; y < mask->h; y++) {
-            if (bitmask_getbit(mask, x, y)) {
-               m10 += x;
-               m20 += x*x;
-               m11 += x*y;
-               m02 += y*y;
-               m01 += y;
-               m00++;
-            }
-        }
-    }
+    if (!moments)
+        return PyErr_NoMemory();
 
+    m00 = moments->m00;
     if (m00) {
-        xc = m10/m00;
-        yc = m01/m00;
-        theta = -90.0*atan2(2*(m11/m00 - xc*yc),(m20/m00 - xc*xc)-(m02/m00 - yc*yc))/M_PI;
+        xc = moments->m10/m00;
+        yc = moments->m01/m00;
+        theta = -90.0*atan2(2*(moments->m11/m00 - xc*yc),
+                            (moments->m20/m00 - xc*xc) -
+                            (moments->m02/m00 - yc*yc))/M_PI;
         return PyFloat_FromDouble(theta);
     } else {
         return PyFloat_FromDouble(0);
     }
 }
 
-static PyObject* mask_outline(PyObject* self, PyObject* args)
+/* the index of the lowest set bit of a word which is not 0 */
+static INLINE int lowest_bit(BITMASK_W word)
 {
-    bitmask_t* c = PyMask_AsBitmap(self);
-    bitmask_t* m = bitmask_create(c->w + 2, c->h + 2);
-    PyObject *plist, *value;
-    int x, y, every, e, firstx, firsty, secx, secy, currx, curry, nextx, nexty, n;
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int i = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* Append the point (x, y) to the points, num of them so far, growing the
+   buffer of size of them when it is full. Returns -2 and frees the points on
+   memory allocation error. */
+static int outline_add(int **points, int *size, int num, int x, int y)
+{
+    int *temp;
+
+    if (num == *size) {
+        temp = (int *) realloc(*points, sizeof(int) * 2 * *size * 2);
+        if(!temp) {
+            free(*points);
+            return -2;
+        }
+        *points = temp;
+        *size *= 2;
+    }
+    (*points)[num * 2] = x;
+    (*points)[num * 2 + 1] = y;
+    return 0;
+}
+
+/*
+Traces the outline of the first object of c, keeping every everyth point.
+returns the number of points, or -2 on memory allocation error.  Allocates
+memory for points, which holds x and y of each point in turn.
+*/
+static int outline_trace(bitmask_t *c, int every, int **ret_points)
+{
+    bitmask_t* m;
+    BITMASK_W word;
+    int *points;
+    int x, y, i, e, firstx, firsty, secx, secy, currx, curry, nextx, nexty, n;
+    int num, size;
     int a[14], b[14];
     a[0] = a[1] = a[7] = a[8] = a[9] = b[1] = b[2] = b[3] = b[9] = b[10] = b[11]= 1;
     a[2] = a[6] = a[10] = b[4] = b[0] = b[12] = b[8] = 0;
     a[3] = a[4] = a[5] = a[11] = a[12] = a[13] = b[5] = b[6] = b[7] = b[13] = -1;
 
-    plist = NULL;
-    plist = PyList_New (0);
-    if (!plist)
-        return NULL;
-
-    every = 1;
-    n = firstx = firsty = secx = x = 0;
+    num = 0;
+    size = 64;
+    points = (int *) malloc(sizeof(int) * 2 * size);
+    if(!points) { return -2; }
+    *ret_points = points;
+
+    /* find the first set pixel in the mask, a word at a time */
+    firstx = firsty = -1;
+    for (y = 0; y < c->h && firstx < 0; y++) {
+        for (i = 0; i * (int)BITMASK_W_LEN < c->w; i++) {
+            word = c->bits[i * c->h + y];
+            if (word) {
+                firstx = i * BITMASK_W_LEN + lowest_bit(word) + 1;
+                firsty = y + 1;
+                break;
+            }
+        }
+    }
 
-    if(!PyArg_ParseTuple(args, "|i", &every)) {
-        return NULL;
+    /* covers the mask having zero pixels */
+    if (firstx < 0) {
+        return 0;
     }
 
     /* by copying to a new, larger mask, we avoid having to check if we are at
        a border pixel every time.  */
-    bitmask_draw(m, c, 1, 1);
-
-    e = every;
-
-    /* find the first set pixel in the mask */
-    for (y = 1; y < m->h-1; y++) {
-        for (x = 1; x < m->w-1; x++) {
-            if (bitmask_getbit(m, x, y)) {
-                 firstx = x;
-                 firsty = y;
-                 value = Py_BuildValue("(ii)", x-1, y-1);
-                 PyList_Append(plist, value);
-                 Py_DECREF(value);
-                 break;
-            }
-        }
-        if (bitmask_getbit(m, x, y))
-            break;
+    m = bitmask_create(c->w + 2, c->h + 2);
+    if(!m) {
+        free(points);
+        return -2;
     }
+    bitmask_draw(m, c, 1, 1);
 
-
-
-    /* covers the mask having zero pixels or only the final pixel */
-    if ((x == m->w-1) && (y == m->h-1)) {
+    x = firstx;
+    y = firsty;
+    if (outline_add(&points, &size, num++, x-1, y-1)) {
         bitmask_free(m);
-        return plist;
+        return -2;
     }
 
+    e = every;
+    secx = secy = currx = curry = 0;
+
     /* check just the first pixel for neighbors */
     for (n = 0;n < 8;n++) {
         if (bitmask_getbit(m, x+a[n], y+b[n])) {
@@ -361,9 +796,10 @@ static PyObject* mask_outline(PyObject* self, PyObject* args)
             e--;
             if (!e) {
                 e = every;
-                value = Py_BuildValue("(ii)", secx-1, secy-1);
-                PyList_Append(plist, value);
-                Py_DECREF(value);
+                if (outline_add(&points, &size, num++, secx-1, secy-1)) {
+                    bitmask_free(m);
+                    return -2;
+                }
             }
             break;
         }
@@ -372,7 +808,8 @@ static PyObject* mask_outline(PyObject* self, PyObject* args)
     /* if there are no neighbors, return */
     if (!secx) {
         bitmask_free(m);
-        return plist;
+        *ret_points = points;
+        return num;
     }
 
     /* the outline tracing loop */
@@ -388,9 +825,10 @@ static PyObject* mask_outline(PyObject* self, PyObject* args)
                     if ((curry == firsty && currx == firstx) && (secx == nextx && secy == nexty)) {
                         break;
                     }
-                    value = Py_BuildValue("(ii)", nextx-1, nexty-1);
-                    PyList_Append(plist, value);
-                    Py_DECREF(value);
+                    if (outline_add(&points, &size, num++, nextx-1, nexty-1)) {
+                        bitmask_free(m);
+                        return -2;
+                    }
                 }
                 break;
             }
@@ -406,10 +844,75 @@ static PyObject* mask_outline(PyObject* self, PyObject* args)
     }
 
     bitmask_free(m);
+    *ret_points = points;
+    return num;
+}
+
+static PyObject* mask_outline(PyObject* self, PyObject* args)
+{
+    bitmask_t* c = PyMask_AsBitmap(self);
+    PyObject *plist, *value;
+    int *points;
+    int every, i, num;
+
+    every = 1;
+
+    if(!PyArg_ParseTuple(args, "|i", &every)) {
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    num = outline_trace(c, every, &points);
+    Py_END_ALLOW_THREADS;
+
+    if (num == -2)
+        return RAISE (PyExc_MemoryError, "Not enough memory to get outline. \n");
+
+    plist = PyList_New (num);
+    if (!plist) {
+        free(points);
+        return NULL;
+    }
+    for (i = 0; i < num; i++) {
+        value = Py_BuildValue("(ii)", points[i * 2], points[i * 2 + 1]);
+        if (!value) {
+            Py_DECREF(plist);
+            free(points);
+            return NULL;
+        }
+        PyList_SET_ITEM(plist, i, value);
+    }
 
+    free(points);
     return plist;
 }
 
+static PyObject* mask_outline_array(PyObject* self, PyObject* args)
+{
+    bitmask_t* c = PyMask_AsBitmap(self);
+    PyObject *array;
+    int *points;
+    int every, num;
+
+    every = 1;
+
+    if(!PyArg_ParseTuple(args, "|i", &every)) {
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    num = outline_trace(c, every, &points);
+    Py_END_ALLOW_THREADS;
+
+    if (num == -2) {
+        return RAISE (PyExc_MemoryError, "Not enough memory to get outline. \n");
+    }
+
+    array = mask_int_array(points, 2 * num);
+    free(points);
+    return array;
+}
+
 static PyObject* mask_convolve(PyObject* aobj, PyObject* args)
 {
     PyObject *bobj, *oobj = Py_None;
@@ -423,9 +926,17 @@ static PyObject* mask_convolve(PyObject* aobj, PyObject* args)
     b = PyMask_AsBitmap(bobj);
 
     if (oobj == Py_None) {
-        PyMaskObject *result = PyObject_New(PyMaskObject, &PyMask_Type);
-
-        result->mask = bitmask_create(a->w + b->w - 1, a->h + b->h - 1);
+        PyMaskObject *result;
+
+        o = bitmask_create(a->w + b->w - 1, a->h + b->h - 1);
+        if (!o)
+            return RAISE (PyExc_MemoryError, "cannot create bitmask");
+        result = mask_new();
+        if (!result) {
+            bitmask_free(o);
+            return NULL;
+        }
+        result->mask = o;
         oobj = (PyObject*) result;
     }
     else
@@ -433,10 +944,209 @@ static PyObject* mask_convolve(PyObject* aobj, PyObject* args)
 
     o = PyMask_AsBitmap(oobj);
 
+    Py_BEGIN_ALLOW_THREADS;
     bitmask_convolve(a, b, o, xoffset, yoffset);
+    Py_END_ALLOW_THREADS;
+    mask_changed(oobj, 0, 0, o->w, o->h);
+    return oobj;
+}
+
+/* Erode (or dilate) a into o, through a copy of a when a cross is wanted
+   in place.  Returns -2 on memory allocation error. */
+static int morph_into(bitmask_t *a, bitmask_t *o, int radius, int cross,
+                      int erode)
+{
+    bitmask_t *copy = NULL;
+
+    if (cross && a == o) {
+        copy = bitmask_create(a->w, a->h);
+        if(!copy) { return -2; }
+        bitmask_draw(copy, a, 0, 0);
+        a = copy;
+    }
+    if (erode)
+        bitmask_erode(a, o, radius, cross);
+    else
+        bitmask_dilate(a, o, radius, cross);
+    if (copy)
+        bitmask_free(copy);
+    return 0;
+}
+
+/* The morphological operations, as up to two steps of erode (1) or
+   dilate (0).  The first step reads self, the second its output. */
+static PyObject* mask_morph(PyObject* self, PyObject* args, int first,
+                            int second)
+{
+    bitmask_t *a = PyMask_AsBitmap(self);
+    bitmask_t *o;
+    PyObject *oobj = Py_None;
+    int radius = 1, cross = 0, r;
+
+    if (!PyArg_ParseTuple (args, "|iiO", &radius, &cross, &oobj))
+        return NULL;
+
+    if (oobj == Py_None) {
+        o = bitmask_create(a->w, a->h);
+        if(!o)
+            return RAISE (PyExc_MemoryError, "cannot create bitmask");
+        oobj = (PyObject*) mask_new();
+        if(!oobj) {
+            bitmask_free(o);
+            return NULL;
+        }
+        ((PyMaskObject*) oobj)->mask = o;
+    }
+    else if (PyObject_TypeCheck (oobj, &PyMask_Type)) {
+        o = PyMask_AsBitmap(oobj);
+        if (o->w != a->w || o->h != a->h)
+            return RAISE (PyExc_ValueError,
+                          "outputmask must be the same size as the mask");
+        Py_INCREF(oobj);
+    }
+    else
+        return RAISE (PyExc_TypeError, "outputmask must be a Mask or None");
+
+    Py_BEGIN_ALLOW_THREADS;
+    r = morph_into(a, o, radius, cross, first);
+    if (!r && second >= 0)
+        r = morph_into(o, o, radius, cross, second);
+    Py_END_ALLOW_THREADS;
+    mask_changed(oobj, 0, 0, o->w, o->h);
+
+    if (r == -2) {
+        Py_DECREF(oobj);
+        return RAISE (PyExc_MemoryError, "cannot create bitmask");
+    }
     return oobj;
 }
 
+static PyObject* mask_dilate(PyObject* self, PyObject* args)
+{
+    return mask_morph(self, args, 0, -1);
+}
+
+static PyObject* mask_erode(PyObject* self, PyObject* args)
+{
+    return mask_morph(self, args, 1, -1);
+}
+
+static PyObject* mask_open(PyObject* self, PyObject* args)
+{
+    return mask_morph(self, args, 1, 0);
+}
+
+static PyObject* mask_close(PyObject* self, PyObject* args)
+{
+    return mask_morph(self, args, 0, 1);
+}
+
+/* The masks of surfaces are built one word of BITMASK_W_LEN pixels at a
+   time, and each word stored once, instead of setting bit by bit. */
+#if defined(__SSE2__) || defined(_M_X64)
+#define MASK_SSE2
+#include <emmintrin.h>
+#endif
+
+/* the pixel at p, of a surface with bpp bytes per pixel */
+static INLINE Uint32 mask_get_pixel(const Uint8 *p, int bpp)
+{
+    switch (bpp)
+    {
+        case 1:
+            return *p;
+        case 2:
+            return *((const Uint16 *) p);
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            return (p[0]) + (p[1] << 8) + (p[2] << 16);
+#else
+            return (p[2]) + (p[1] << 8) + (p[0] << 16);
+#endif
+        default:                  /* case 4: */
+            return *((const Uint32 *) p);
+    }
+}
+
+/* The word for n pixels from p, with a bit set for each pixel which has
+   (color & amask) > limit, or when usethresh is 0, color != colorkey. */
+static INLINE BITMASK_W surface_word(const Uint8 *p, int n, int bpp,
+                                     int usethresh, Uint32 amask,
+                                     Uint32 limit, Uint32 colorkey)
+{
+    BITMASK_W word = 0;
+    Uint32 color;
+    int i = 0;
+
+#ifdef MASK_SSE2
+    if (bpp == 4) {
+        /* four pixels at once, unsigned compares done with the sign bit
+           flipped */
+        const __m128i bias = _mm_set1_epi32((int)0x80000000);
+        const __m128i vmask = _mm_set1_epi32((int)amask);
+        const __m128i vlimit = _mm_set1_epi32((int)(limit ^ 0x80000000));
+        const __m128i vkey = _mm_set1_epi32((int)colorkey);
+        __m128i v;
+        int bits;
+
+        for (; i + 4 <= n; i += 4) {
+            v = _mm_loadu_si128((const __m128i *)(p + i * 4));
+            if (usethresh) {
+                v = _mm_xor_si128(_mm_and_si128(v, vmask), bias);
+                bits = _mm_movemask_ps(_mm_castsi128_ps(
+                    _mm_cmpgt_epi32(v, vlimit)));
+            } else {
+                bits = _mm_movemask_ps(_mm_castsi128_ps(
+                    _mm_cmpeq_epi32(v, vkey))) ^ 0xf;
+            }
+            word |= (BITMASK_W)bits << i;
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        color = mask_get_pixel(p + i * bpp, bpp);
+        if (usethresh ? (color & amask) > limit : color != colorkey) {
+            word |= BITMASK_N(i);
+        }
+    }
+    return word;
+}
+
+/* Store the words of row y of mask from that row of surf. Each bpp has its
+   own call so surface_word is inlined with its pixel fetch. */
+static void surface_row(bitmask_t *mask, int y, SDL_Surface *surf,
+                        int usethresh, Uint32 amask, Uint32 limit,
+                        Uint32 colorkey)
+{
+    const Uint8 *pixels = (const Uint8 *) surf->pixels + y * surf->pitch;
+    BITMASK_W *bits = mask->bits + y;
+    int x, n, bpp = surf->format->BytesPerPixel;
+
+    for (x = 0; x < surf->w; x += BITMASK_W_LEN, bits += mask->h) {
+        n = MIN(surf->w - x, (int)BITMASK_W_LEN);
+        switch (bpp)
+        {
+            case 1:
+                *bits = surface_word(pixels + x, n, 1, usethresh,
+                                     amask, limit, colorkey);
+                break;
+            case 2:
+                *bits = surface_word(pixels + x * 2, n, 2, usethresh,
+                                     amask, limit, colorkey);
+                break;
+            case 3:
+                *bits = surface_word(pixels + x * 3, n, 3, usethresh,
+                                     amask, limit, colorkey);
+                break;
+            default:                  /* case 4: */
+                *bits = surface_word(pixels + x * 4, n, 4, usethresh,
+                                     amask, limit, colorkey);
+                break;
+        }
+    }
+}
+
 static PyObject* mask_from_surface(PyObject* self, PyObject* args)
 {
     bitmask_t *mask;
@@ -445,13 +1155,10 @@ static PyObject* mask_from_surface(PyObject* self, PyObject* args)
     PyObject* surfobj;
     PyMaskObject *maskobj;
 
-    int x, y, threshold, ashift, aloss, usethresh;
-    Uint8 *pixels;
+    int y, threshold, usethresh, fill;
 
     SDL_PixelFormat *format;
-    Uint32 color, amask;
-    Uint8 *pix;
-    Uint8 a;
+    Uint32 amask, alimit;
 
     /* set threshold as 127 default argument. */
     threshold = 127;
@@ -460,77 +1167,49 @@ static PyObject* mask_from_surface(PyObject* self, PyObject* args)
      *   surface, threshold
      */
 
-    if (!PyArg_ParseTuple (args, "O!|i", &PySurface_Type, &surfobj, &threshold)) {
+    if (!PyArg_ParseTuple (args, "O&|i", PySurface_Source, &surfobj, &threshold)) {
         return NULL;
     }
 
     surf = PySurface_AsSurface(surfobj);
 
-    /* lock the surface, release the GIL. */
-    PySurface_Lock (surfobj);
-
-    Py_BEGIN_ALLOW_THREADS;
-
     /* get the size from the surface, and create the mask. */
     mask = bitmask_create(surf->w, surf->h);
 
-
     if(!mask) {
-        /* Py_END_ALLOW_THREADS;
-         */
-        return NULL; /*RAISE(PyExc_Error, "cannot create bitmask");*/
+        return RAISE (PyExc_MemoryError, "cannot create bitmask");
     }
 
-    pixels = (Uint8 *) surf->pixels;
+    /* lock the surface, release the GIL. */
+    PySurface_Lock (surfobj);
+
+    Py_BEGIN_ALLOW_THREADS;
+
     format = surf->format;
     amask = format->Amask;
-    ashift = format->Ashift;
-    aloss = format->Aloss;
     usethresh = !(surf->flags & SDL_SRCCOLORKEY);
 
-    for(y=0; y < surf->h; y++) {
-        pixels = (Uint8 *) surf->pixels + y*surf->pitch;
-        for(x=0; x < surf->w; x++) {
-            /* Get the color.  TODO: should use an inline helper
-             *   function for this common function. */
-            switch (format->BytesPerPixel)
-            {
-                case 1:
-                    color = (Uint32)*((Uint8 *) pixels);
-                    pixels++;
-                    break;
-                case 2:
-                    color = (Uint32)*((Uint16 *) pixels);
-                    pixels += 2;
-                    break;
-                case 3:
-                    pix = ((Uint8 *) pixels);
-                    pixels += 3;
-                #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    color = (pix[0]) + (pix[1] << 8) + (pix[2] << 16);
-                #else
-                    color = (pix[2]) + (pix[1] << 8) + (pix[0] << 16);
-                #endif
-                    break;
-                default:                  /* case 4: */
-                    color = *((Uint32 *) pixels);
-                    pixels += 4;
-                    break;
-            }
-
+    /* The alpha is ((color & amask) >> Ashift) << Aloss, which is above
+       threshold just when (color & amask) is above alimit. */
+    alimit = 0;
+    fill = 0;
+    if (usethresh) {
+        if (threshold < 0) {
+            fill = 1;             /* every alpha is above threshold */
+        } else if (!amask || (Uint32)(threshold >> format->Aloss) >=
+                             (amask >> format->Ashift)) {
+            fill = -1;            /* no alpha is above threshold */
+        } else {
+            alimit = (Uint32)(threshold >> format->Aloss) << format->Ashift;
+        }
+    }
 
-            if (usethresh) {
-                a = ((color & amask) >> ashift) << aloss;
-                /* no colorkey, so we check the threshold of the alpha */
-                if (a > threshold) {
-                    bitmask_setbit(mask, x, y);
-                }
-            } else {
-                /*  test against the colour key. */
-                if (format->colorkey != color) {
-                    bitmask_setbit(mask, x, y);
-                }
-            }
+    if (fill > 0) {
+        bitmask_fill(mask);
+    } else if (fill == 0) {
+        for(y=0; y < surf->h; y++) {
+            surface_row(mask, y, surf, usethresh, amask, alimit,
+                        format->colorkey);
         }
     }
 
@@ -541,14 +1220,218 @@ static PyObject* mask_from_surface(PyObject* self, PyObject* args)
     PySurface_Unlock (surfobj);
 
     /*create the new python object from mask*/
-    maskobj = PyObject_New(PyMaskObject, &PyMask_Type);
+    maskobj = mask_new();
     if(maskobj)
         maskobj->mask = mask;
+    else
+        bitmask_free(mask);
 
 
     return (PyObject*)maskobj;
 }
 
+/* set the pixel at p, of a surface with bpp bytes per pixel */
+static INLINE void mask_put_pixel(Uint8 *p, int bpp, Uint32 color)
+{
+    switch (bpp)
+    {
+        case 1:
+            *p = (Uint8) color;
+            break;
+        case 2:
+            *((Uint16 *) p) = (Uint16) color;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            p[0] = (Uint8) color;
+            p[1] = (Uint8) (color >> 8);
+            p[2] = (Uint8) (color >> 16);
+#else
+            p[2] = (Uint8) color;
+            p[1] = (Uint8) (color >> 8);
+            p[0] = (Uint8) (color >> 16);
+#endif
+            break;
+        default:                  /* case 4: */
+            *((Uint32 *) p) = color;
+            break;
+    }
+}
+
+/* Write the n pixels from p for the low n bits of word, as setcolor or
+   unsetcolor.  A pixel whose color has drawset or drawunset 0 is left as
+   it is. */
+static INLINE void surface_put_word(Uint8 *p, BITMASK_W word, int n, int bpp,
+                                    Uint32 setcolor, Uint32 unsetcolor,
+                                    int drawset, int drawunset)
+{
+    int i = 0;
+
+#ifdef MASK_SSE2
+    if (bpp == 4) {
+        /* four pixels at once, selected by a nibble of the word */
+        const __m128i sel = _mm_set_epi32(8, 4, 2, 1);
+        const __m128i vset = _mm_set1_epi32((int)setcolor);
+        const __m128i vunset = _mm_set1_epi32((int)unsetcolor);
+        __m128i on, old = vunset;
+
+        for (; i + 4 <= n; i += 4) {
+            on = _mm_and_si128(_mm_set1_epi32((int)(word >> i) & 0xf), sel);
+            on = _mm_cmpeq_epi32(on, sel);
+            if (!drawset || !drawunset)
+                old = _mm_loadu_si128((const __m128i *)(p + i * 4));
+            _mm_storeu_si128((__m128i *)(p + i * 4),
+                             _mm_or_si128(
+                                 _mm_and_si128(on, drawset ? vset : old),
+                                 _mm_andnot_si128(on, drawunset ? vunset
+                                                                : old)));
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        if ((word >> i) & 1) {
+            if (drawset)
+                mask_put_pixel(p + i * bpp, bpp, setcolor);
+        } else if (drawunset) {
+            mask_put_pixel(p + i * bpp, bpp, unsetcolor);
+        }
+    }
+}
+
+/* Draw the row my of mask, from mask x x0 to x1, onto the surface pixels
+   at p.  Each bpp has its own call so surface_put_word is inlined with its
+   pixel store. */
+static void surface_put_row(Uint8 *p, const bitmask_t *mask, int my,
+                            int x0, int x1, int bpp, Uint32 setcolor,
+                            Uint32 unsetcolor, int drawset, int drawunset)
+{
+    BITMASK_W word;
+    int x, n;
+
+    for (x = x0; x < x1; x += n, p += n * bpp) {
+        word = mask->bits[x / BITMASK_W_LEN * mask->h + my] >>
+               (x & BITMASK_W_MASK);
+        n = MIN((int)(BITMASK_W_LEN - (x & BITMASK_W_MASK)), x1 - x);
+        switch (bpp)
+        {
+            case 1:
+                surface_put_word(p, word, n, 1, setcolor, unsetcolor,
+                                 drawset, drawunset);
+                break;
+            case 2:
+                surface_put_word(p, word, n, 2, setcolor, unsetcolor,
+                                 drawset, drawunset);
+                break;
+            case 3:
+                surface_put_word(p, word, n, 3, setcolor, unsetcolor,
+                                 drawset, drawunset);
+                break;
+            default:                  /* case 4: */
+                surface_put_word(p, word, n, 4, setcolor, unsetcolor,
+                                 drawset, drawunset);
+                break;
+        }
+    }
+}
+
+static PyObject* mask_to_surface(PyObject* self, PyObject* args,
+                                 PyObject* kwargs)
+{
+    bitmask_t *mask = PyMask_AsBitmap(self);
+    PyObject *surfobj = Py_None, *setobj = NULL, *unsetobj = NULL;
+    PyObject *destobj = NULL;
+    SDL_Surface *surf;
+    SDL_Rect *clip;
+    Uint8 rgba[4];
+    Uint32 setcolor = 0, unsetcolor = 0;
+    int drawset, drawunset, dx = 0, dy = 0, x0, x1, y0, y1, y, bpp;
+    Uint8 *pixels;
+    static char *kwids[] = {"surface", "setcolor", "unsetcolor", "dest",
+                            NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOO", kwids,
+                                     &surfobj, &setobj, &unsetobj,
+                                     &destobj))
+        return NULL;
+
+    if (destobj && !TwoIntsFromObj(destobj, &dx, &dy))
+        return RAISE (PyExc_TypeError, "dest must be a pair of integers");
+
+    if (surfobj == Py_None) {
+        surf = SDL_CreateRGBSurface(SDL_SWSURFACE | SDL_SRCALPHA,
+                                    mask->w, mask->h, 32, 0xff << 16,
+                                    0xff << 8, 0xff, 0xff000000);
+        if (!surf)
+            return RAISE (PyExc_SDLError, SDL_GetError());
+        surfobj = PySurface_New(surf);
+        if (!surfobj) {
+            SDL_FreeSurface(surf);
+            return NULL;
+        }
+    }
+    else if (PySurface_Check(surfobj)) {
+        surf = PySurface_AsSurface(surfobj);
+        Py_INCREF(surfobj);
+    }
+    else
+        return RAISE (PyExc_TypeError, "surface must be a Surface or None");
+
+    /* a color of None leaves those pixels as they are */
+    drawset = setobj != Py_None;
+    if (!setobj) {
+        setcolor = SDL_MapRGBA(surf->format, 255, 255, 255, 255);
+    } else if (drawset) {
+        if (!RGBAFromColorObj(setobj, rgba)) {
+            Py_DECREF(surfobj);
+            return RAISE (PyExc_TypeError, "invalid setcolor argument");
+        }
+        setcolor = SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2],
+                               rgba[3]);
+    }
+    drawunset = unsetobj != Py_None;
+    if (!unsetobj) {
+        unsetcolor = SDL_MapRGBA(surf->format, 0, 0, 0, 255);
+    } else if (drawunset) {
+        if (!RGBAFromColorObj(unsetobj, rgba)) {
+            Py_DECREF(surfobj);
+            return RAISE (PyExc_TypeError, "invalid unsetcolor argument");
+        }
+        unsetcolor = SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2],
+                                 rgba[3]);
+    }
+
+    /* the part of the mask inside the clip area, in mask coordinates */
+    clip = &surf->clip_rect;
+    x0 = MAX(clip->x - dx, 0);
+    y0 = MAX(clip->y - dy, 0);
+    x1 = MIN(clip->x + clip->w - dx, mask->w);
+    y1 = MIN(clip->y + clip->h - dy, mask->h);
+    if (x0 >= x1 || y0 >= y1 || (!drawset && !drawunset))
+        return surfobj;
+
+    if (!PySurface_Lock(surfobj)) {
+        Py_DECREF(surfobj);
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    bpp = surf->format->BytesPerPixel;
+    for (y = y0; y < y1; y++) {
+        pixels = (Uint8 *) surf->pixels + (y + dy) * surf->pitch +
+                 (x0 + dx) * bpp;
+        surface_put_row(pixels, mask, y, x0, x1, bpp, setcolor, unsetcolor,
+                        drawset, drawunset);
+    }
+    Py_END_ALLOW_THREADS;
+
+    if (!PySurface_Unlock(surfobj)) {
+        Py_DECREF(surfobj);
+        return NULL;
+    }
+    return surfobj;
+}
+
 
 /*
 
@@ -575,6 +1458,11 @@ void bitmask_threshold (bitmask_t *m,
     Uint8 r, g, b, a;
     Uint8 tr, tg, tb, ta;
     int bpp1, bpp2;
+    BITMASK_W word, *bits;
+#ifdef MASK_SSE2
+    int fast;
+    __m128i vcolor, vthresh, vused, v, v2, diff;
+#endif
 
 
     pixels = (Uint8 *) surf->pixels;
@@ -616,12 +1504,60 @@ void bitmask_threshold (bitmask_t *m,
     SDL_GetRGBA (color, format, &r, &g, &b, &a);
     SDL_GetRGBA (threshold, format, &tr, &tg, &tb, &ta);
 
+#ifdef MASK_SSE2
+    /* 32 bit pixels with whole byte channels, and surf2 of the same format,
+       are compared a byte per channel four pixels at a time. */
+    fast = (bpp1 == 4 && rmask == (Uint32)0xff << rshift &&
+            gmask == (Uint32)0xff << gshift &&
+            bmask == (Uint32)0xff << bshift &&
+            !(rshift & 7) && !(gshift & 7) && !(bshift & 7) &&
+            (!surf2 || (bpp2 == 4 && rmask2 == rmask && gmask2 == gmask &&
+                        bmask2 == bmask)));
+    vcolor = _mm_set1_epi32((int)color);
+    vthresh = _mm_set1_epi32((int)(((Uint32)tr << rshift) |
+                                   ((Uint32)tg << gshift) |
+                                   ((Uint32)tb << bshift)));
+    vused = _mm_set1_epi32((int)(rmask | gmask | bmask));
+#endif
+
     for(y=0; y < surf->h; y++) {
         pixels = (Uint8 *) surf->pixels + y*surf->pitch;
         if (surf2) {
             pixels2 = (Uint8 *) surf2->pixels + y*surf2->pitch;
         }
-        for(x=0; x < surf->w; x++) {
+        bits = m->bits + y;
+        word = 0;
+        x = 0;
+#ifdef MASK_SSE2
+        if (fast) {
+            for(; x + 4 <= surf->w; x += 4) {
+                v = _mm_loadu_si128((const __m128i *) pixels);
+                pixels += 16;
+                if (surf2) {
+                    v2 = _mm_loadu_si128((const __m128i *) pixels2);
+                    pixels2 += 16;
+                } else {
+                    v2 = vcolor;
+                }
+                /* a channel fails where its difference is not under its
+                   threshold, and a pixel passes with no channel failing */
+                diff = _mm_or_si128(_mm_subs_epu8(v, v2),
+                                    _mm_subs_epu8(v2, v));
+                diff = _mm_cmpeq_epi8(_mm_subs_epu8(vthresh, diff),
+                                      _mm_setzero_si128());
+                diff = _mm_cmpeq_epi32(_mm_and_si128(diff, vused),
+                                       _mm_setzero_si128());
+                word |= (BITMASK_W)_mm_movemask_ps(_mm_castsi128_ps(diff))
+                        << (x & BITMASK_W_MASK);
+                if ((x & BITMASK_W_MASK) == BITMASK_W_LEN - 4) {
+                    *bits = word;
+                    bits += m->h;
+                    word = 0;
+                }
+            }
+        }
+#endif
+        for(; x < surf->w; x++) {
             /* the_color = surf->get_at(x,y) */
             switch (bpp1)
             {
@@ -682,14 +1618,14 @@ void bitmask_threshold (bitmask_t *m,
                     if (  (abs( (the_color2) - (the_color)) < tr )  ) {
 
                         /* this pixel is within the threshold of othersurface. */
-                        bitmask_setbit(m, x, y);
+                        word |= BITMASK_N(x & BITMASK_W_MASK);
                     }
 
                 } else if ((abs((((the_color2 & rmask2) >> rshift2) << rloss2) - (((the_color & rmask) >> rshift) << rloss)) < tr) &
                     (abs((((the_color2 & gmask2) >> gshift2) << gloss2) - (((the_color & gmask) >> gshift) << gloss)) < tg) &
                     (abs((((the_color2 & bmask2) >> bshift2) << bloss2) - (((the_color & bmask) >> bshift) << bloss)) < tb)) {
                     /* this pixel is within the threshold of othersurface. */
-                    bitmask_setbit(m, x, y);
+                    word |= BITMASK_N(x & BITMASK_W_MASK);
                 }
 
             /* TODO: will need to handle surfaces with palette colors.
@@ -700,9 +1636,18 @@ void bitmask_threshold (bitmask_t *m,
                        (abs((((the_color & gmask) >> gshift) << gloss) - g) < tg) &
                        (abs((((the_color & bmask) >> bshift) << bloss) - b) < tb)) {
                 /* this pixel is within the threshold of the color. */
-                bitmask_setbit(m, x, y);
+                word |= BITMASK_N(x & BITMASK_W_MASK);
+            }
+
+            if ((x & BITMASK_W_MASK) == BITMASK_W_MASK) {
+                *bits = word;
+                bits += m->h;
+                word = 0;
             }
         }
+        if (x & BITMASK_W_MASK) {
+            *bits = word;
+        }
     }
 }
 
@@ -721,7 +1666,7 @@ static PyObject* mask_from_threshold(PyObject* self, PyObject* args)
     int palette_colors = 1;
 
 
-    if (!PyArg_ParseTuple (args, "O!O|OO!i", &PySurface_Type, &surfobj,
+    if (!PyArg_ParseTuple (args, "O&O|OO!i", PySurface_Source, &surfobj,
                            &rgba_obj_color,  &rgba_obj_threshold,
                            &PySurface_Type, &surfobj2, &palette_colors))
         return NULL;
@@ -758,6 +1703,9 @@ static PyObject* mask_from_threshold(PyObject* self, PyObject* args)
 
     bpp = surf->format->BytesPerPixel;
     m = bitmask_create(surf->w, surf->h);
+    if(!m) {
+        return RAISE (PyExc_MemoryError, "cannot create bitmask");
+    }
 
     PySurface_Lock(surfobj);
     if(surfobj2) {
@@ -773,9 +1721,11 @@ static PyObject* mask_from_threshold(PyObject* self, PyObject* args)
         PySurface_Unlock(surfobj2);
     }
 
-    maskobj = PyObject_New(PyMaskObject, &PyMask_Type);
+    maskobj = mask_new();
     if(maskobj)
         maskobj->mask = m;
+    else
+        bitmask_free(m);
 
     return (PyObject*)maskobj;
 }
@@ -783,435 +1733,379 @@ static PyObject* mask_from_threshold(PyObject* self, PyObject* args)
 
 
 
-/* the initial labelling phase of the connected components algorithm
+/* Connected components are found from the runs of set bits in each row.
+   Runs of neighbouring rows are joined in an array based union-find when
+   they touch, including diagonally, which gives 8-connected components.
+   Each run points to a lower numbered run of its component, so the root is
+   the first run of a component in scan order, and the components are
+   numbered in the order of their first pixel.  The memory used is a run
+   per run of bits, rather than a label per pixel of the mask. */
 
-Returns: The highest label in the labelled image
+typedef struct {
+    int x, end, y;        /* the run covers x to end - 1 of row y */
+    int parent;           /* union-find parent, the run itself at a root */
+} CCRun;
 
-input - The input Mask
-image - An array to store labelled pixels
-ufind - The union-find label equivalence array
-largest - An array to store the number of pixels for each label
+typedef struct {
+    int x, y, w, h;       /* the bounding rect */
+    long int area;
+    long int m10, m01;    /* the sums of x and y of the pixels */
+} CCStats;
 
-*/
-unsigned int cc_label(bitmask_t *input, unsigned int* image, unsigned int* ufind, unsigned int* largest) {
-    unsigned int *buf;
-    unsigned int x, y, w, h, root, aroot, croot, temp, label;
-
-    label = 0;
-    w = input->w;
-    h = input->h;
-
-    ufind[0] = 0;
-    buf = image;
-
-    /* special case for first pixel */
-    if(bitmask_getbit(input, 0, 0)) { /* process for a new connected comp: */
-        label++;              /* create a new label */
-        *buf = label;         /* give the pixel the label */
-        ufind[label] = label; /* put the label in the equivalence array */
-        largest[label] = 1;   /* the label has 1 pixel associated with it */
-    } else {
-        *buf = 0;
+/* the root run of run i, halving the path to it */
+static INLINE int cc_find(CCRun *runs, int i)
+{
+    while (runs[i].parent != i) {
+        runs[i].parent = runs[runs[i].parent].parent;
+        i = runs[i].parent;
     }
-    buf++;
+    return i;
+}
 
+static INLINE void cc_union(CCRun *runs, int a, int b)
+{
+    a = cc_find(runs, a);
+    b = cc_find(runs, b);
+    if (a < b)
+        runs[b].parent = a;
+    else if (b < a)
+        runs[a].parent = b;
+}
 
+/* Store run n, growing runs when it is full.  Returns -2 and frees runs on
+   memory allocation error. */
+static int cc_add_run(CCRun **runs, int *size, int n, int x, int end, int y)
+{
+    CCRun *temp;
 
-    /* special case for first row.
-           Go over the first row except the first pixel.
-    */
-    for(x = 1; x < w; x++) {
-        if (bitmask_getbit(input, x, 0)) {
-            if (*(buf-1)) {                    /* d label */
-                *buf = *(buf-1);
-            } else {                           /* create label */
-                label++;
-                *buf = label;
-                ufind[label] = label;
-                largest[label] = 0;
-            }
-            largest[*buf]++;
-        } else {
-            *buf = 0;
+    if (n == *size) {
+        temp = (CCRun *) realloc(*runs, sizeof(CCRun) * *size * 2);
+        if(!temp) {
+            free(*runs);
+            return -2;
         }
-        buf++;
+        *runs = temp;
+        *size *= 2;
     }
+    (*runs)[n].x = x;
+    (*runs)[n].end = end;
+    (*runs)[n].y = y;
+    (*runs)[n].parent = n;
+    return 0;
+}
 
-
-
-    /* the rest of the image */
-    for(y = 1; y < h; y++) {
-        /* first pixel of the row */
-        if (bitmask_getbit(input, 0, y)) {
-            if (*(buf-w)) {                    /* b label */
-                *buf = *(buf-w);
-            } else if (*(buf-w+1)) {           /* c label */
-                *buf = *(buf-w+1);
-            } else {                           /* create label */
-                label++;
-                *buf = label;
-                ufind[label] = label;
-                largest[label] = 0;
+/*
+returns the number of runs of set bits in the mask, or -2 on memory
+allocation error.  Allocates memory for runs, joined into components.
+*/
+static int cc_runs(bitmask_t *mask, CCRun **ret_runs)
+{
+    CCRun *runs;
+    BITMASK_W word, edges;
+    int x, y, i, j, k, bit, start, n, size, prev, prevend;
+
+    n = 0;
+    size = 64;
+    runs = (CCRun *) malloc(sizeof(CCRun) * size);
+    if(!runs) { return -2; }
+
+    prev = prevend = 0;     /* the runs of the previous row */
+    for (y = 0; y < mask->h; y++) {
+        start = -1;
+        for (i = 0; i * (int)BITMASK_W_LEN < mask->w; i++) {
+            word = mask->bits[i * mask->h + y];
+            /* find each bit where a run starts or ends in the word */
+            for (bit = 0; bit < (int)BITMASK_W_LEN; bit++) {
+                edges = ((start < 0) ? word : ~word) & (~(BITMASK_W)0 << bit);
+                if (!edges)
+                    break;
+                bit = lowest_bit(edges);
+                x = i * BITMASK_W_LEN + bit;
+                if (x >= mask->w)
+                    break;
+                if (start < 0) {
+                    start = x;
+                    continue;
+                }
+                if (cc_add_run(&runs, &size, n, start, x, y)) {
+                    return -2;
+                }
+                n++;
+                start = -1;
             }
-            largest[*buf]++;
-        } else {
-            *buf = 0;
         }
-        buf++;
-        /* middle pixels of the row */
-        for(x = 1; x < (w-1); x++) {
-            if (bitmask_getbit(input, x, y)) {
-                if (*(buf-w)) {                /* b label */
-                    *buf = *(buf-w);
-                } else if (*(buf-w+1)) {       /* c branch of tree */
-                    if (*(buf-w-1)) {                      /* union(c, a) */
-                        croot = root = *(buf-w+1);
-                        while (ufind[root] < root) {       /* find root */
-                            root = ufind[root];
-                        }
-                        if (croot != *(buf-w-1)) {
-                            temp = aroot = *(buf-w-1);
-                            while (ufind[aroot] < aroot) { /* find root */
-                                aroot = ufind[aroot];
-                            }
-                            if (root > aroot) {
-                                root = aroot;
-                            }
-                            while (ufind[temp] > root) {   /* set root */
-                                aroot = ufind[temp];
-                                ufind[temp] = root;
-                                temp = aroot;
-                            }
-                        }
-                        while (ufind[croot] > root) {      /* set root */
-                            temp = ufind[croot];
-                            ufind[croot] = root;
-                            croot = temp;
-                        }
-                        *buf = root;
-                    } else if (*(buf-1)) {                 /* union(c, d) */
-                        croot = root = *(buf-w+1);
-                        while (ufind[root] < root) {       /* find root */
-                            root = ufind[root];
-                        }
-                        if (croot != *(buf-1)) {
-                            temp = aroot = *(buf-1);
-                            while (ufind[aroot] < aroot) { /* find root */
-                                aroot = ufind[aroot];
-                            }
-                            if (root > aroot) {
-                                root = aroot;
-                            }
-                            while (ufind[temp] > root) {   /* set root */
-                                aroot = ufind[temp];
-                                ufind[temp] = root;
-                                temp = aroot;
-                            }
-                        }
-                        while (ufind[croot] > root) {      /* set root */
-                            temp = ufind[croot];
-                            ufind[croot] = root;
-                            croot = temp;
-                        }
-                        *buf = root;
-                    } else {                   /* c label */
-                        *buf = *(buf-w+1);
-                    }
-                } else if (*(buf-w-1)) {       /* a label */
-                    *buf = *(buf-w-1);
-                } else if (*(buf-1)) {         /* d label */
-                    *buf = *(buf-1);
-                } else {                       /* create label */
-                    label++;
-                    *buf = label;
-                    ufind[label] = label;
-                    largest[label] = 0;
-                }
-                largest[*buf]++;
-            } else {
-                *buf = 0;
+        if (start >= 0) {
+            if (cc_add_run(&runs, &size, n, start, mask->w, y)) {
+                return -2;
             }
-            buf++;
+            n++;
         }
-        /* last pixel of the row, if its not also the first pixel of the row */
-        if (w > 1) {
-            if (bitmask_getbit(input, x, y)) {
-                if (*(buf-w)) {                /* b label */
-                    *buf = *(buf-w);
-                } else if (*(buf-w-1)) {       /* a label */
-                    *buf = *(buf-w-1);
-                } else if (*(buf-1)) {         /* d label */
-                    *buf = *(buf-1);
-                } else {                       /* create label */
-                    label++;
-                    *buf = label;
-                    ufind[label] = label;
-                    largest[label] = 0;
-                }
-                largest[*buf]++;
-            } else {
-                *buf = 0;
+
+        /* join the runs of this row with the ones they touch above */
+        if (prev < prevend && runs[prev].y == y - 1) {
+            j = prev;
+            for (i = prevend; i < n; i++) {
+                while (j < prevend && runs[j].end < runs[i].x)
+                    j++;
+                for (k = j; k < prevend && runs[k].x <= runs[i].end; k++)
+                    cc_union(runs, k, i);
             }
-            buf++;
         }
+        prev = prevend;
+        prevend = n;
     }
 
-    return label;
+    *ret_runs = runs;
+    return n;
 }
 
-
-
-/* Connected component labeling based on the SAUF algorithm by Kesheng Wu,
-   Ekow Otoo, and Kenji Suzuki.  The algorithm is best explained by their paper,
-   "Two Strategies to Speed up Connected Component Labeling Algorithms", but in
-   summary, it is a very efficient two pass method for 8-connected components.
-   It uses a decision tree to minimize the number of neighbors that need to be
-   checked.  It stores equivalence information in an array based union-find.
-   This implementation also has a final step of finding bounding boxes. */
-
 /*
-returns -2 on memory allocation error, otherwise 0 on success.
-
-input - the input mask.
-num_bounding_boxes - returns the number of bounding rects found.
-rects - returns the rects that are found.  Allocates the memory for the rects.
-
+returns the number of connected components, or -2 on memory allocation
+error.  Allocates memory for stats, with one CCStats for each component.
+When ret_runs is not NULL it is given the runs, each with the number of its
+component as its parent, and nruns the number of them.
 */
-static int get_bounding_rects(bitmask_t *input, int *num_bounding_boxes, GAME_Rect** ret_rects)
+static int cc_stats(bitmask_t *mask, CCStats **ret_stats, CCRun **ret_runs,
+                    int *nruns)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    int x, y, w, h, temp, label, relabel;
-    GAME_Rect* rects;
-
-    rects = NULL;
-    label = 0;
-
-    w = input->w;
-    h = input->h;
-
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *) malloc(sizeof(int)*w*h);
-    if(!image) { return -2; }
-
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *) malloc(sizeof(int)*(w/2 + 1)*(h/2 + 1));
-    if(!ufind) { return -2; }
-
-    largest = (unsigned int *) malloc(sizeof(int)*(w/2 + 1)*(h/2 + 1));
-    if(!largest) { return -2; }
-
-
-    /* do the initial labelling */
-    label = cc_label(input, image, ufind, largest);
-
-    relabel = 0;
-    /* flatten and relabel the union-find equivalence array.  Start at label 1
-       because label 0 indicates an unset pixel.  For this reason, we also use
-       <= label rather than < label. */
-    for (x = 1; x <= label; x++) {
-         if (ufind[x] < x) {             /* is it a union find root? */
-             ufind[x] = ufind[ufind[x]]; /* relabel it to its root */
-         } else {                 /* its a root */
-             relabel++;
-             ufind[x] = relabel;  /* assign the lowest label available */
-         }
+    CCRun *runs = NULL;
+    CCStats *stats, *s;
+    int i, n, num, len;
+    int *label;
+
+    n = cc_runs(mask, &runs);
+    if (n == -2) { return -2; }
+
+    /* number the components by their roots, which come in scan order */
+    label = (int *) malloc(sizeof(int) * (n + 1));
+    if(!label) {
+        free(runs);
+        return -2;
+    }
+    num = 0;
+    for (i = 0; i < n; i++) {
+        label[i] = (cc_find(runs, i) == i) ? num++ : label[runs[i].parent];
     }
 
-    *num_bounding_boxes = relabel;
-
-    if (relabel == 0) {
-    /* early out, as we didn't find anything. */
-        free(image);
-        free(ufind);
-        free(largest);
-        *ret_rects = rects;
-        return 0;
+    stats = (CCStats *) malloc(sizeof(CCStats) * (num + 1));
+    if(!stats) {
+        free(label);
+        free(runs);
+        return -2;
     }
 
-    /* the bounding rects, need enough space for the number of labels */
-    rects = (GAME_Rect *) malloc(sizeof(GAME_Rect) * (relabel +1));
-    if(!rects) { return -2; }
-
-    for (temp = 0; temp <= relabel; temp++) {
-        rects[temp].h = 0;        /* so we know if its a new rect or not */
-    }
-
-    /* find the bounding rect of each connected component */
-    buf = image;
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf]) {         /* if the pixel is part of a component */
-                if (rects[ufind[*buf]].h) {   /* the component has a rect */
-                    temp = rects[ufind[*buf]].x;
-                    rects[ufind[*buf]].x = MIN(x, temp);
-                    rects[ufind[*buf]].y = MIN(y, rects[ufind[*buf]].y);
-                    rects[ufind[*buf]].w = MAX(rects[ufind[*buf]].w + temp, x + 1) - rects[ufind[*buf]].x;
-                    rects[ufind[*buf]].h = MAX(rects[ufind[*buf]].h, y - rects[ufind[*buf]].y + 1);
-                } else {                      /* otherwise, start the rect */
-                    rects[ufind[*buf]].x = x;
-                    rects[ufind[*buf]].y = y;
-                    rects[ufind[*buf]].w = 1;
-                    rects[ufind[*buf]].h = 1;
-                }
+    for (i = 0; i < n; i++) {
+        s = stats + label[i];
+        len = runs[i].end - runs[i].x;
+        if (runs[i].parent == i) {
+            s->x = runs[i].x;
+            s->y = runs[i].y;
+            s->w = len;
+            s->h = 1;
+            s->area = s->m10 = s->m01 = 0;
+        } else {
+            if (runs[i].x < s->x) {
+                s->w += s->x - runs[i].x;
+                s->x = runs[i].x;
             }
-            buf++;
+            s->w = MAX(s->w, runs[i].end - s->x);
+            s->h = runs[i].y - s->y + 1;
+        }
+        s->area += len;
+        s->m10 += (long int)(runs[i].x + runs[i].end - 1) * len / 2;
+        s->m01 += (long int)runs[i].y * len;
+    }
+
+    if (ret_runs) {
+        for (i = 0; i < n; i++) {
+            runs[i].parent = label[i];
         }
+        *ret_runs = runs;
+        *nruns = n;
+    } else {
+        free(runs);
     }
+    free(label);
 
-    free(image);
-    free(ufind);
-    free(largest);
-    *ret_rects = rects;
+    *ret_stats = stats;
+    return num;
+}
 
-    return 0;
+/* set the bits of run in mask */
+static void cc_draw_run(bitmask_t *mask, const CCRun *run)
+{
+    int x;
+    for (x = run->x; x < run->end; x++) {
+        bitmask_setbit(mask, x, run->y);
+    }
 }
 
 static PyObject* mask_get_bounding_rects(PyObject* self, PyObject* args)
 {
-    GAME_Rect *regions;
-    GAME_Rect *aregion;
-    int num_bounding_boxes, i, r;
+    CCStats *stats;
+    int num, i;
     PyObject* ret;
     PyObject* rect;
 
 
     bitmask_t *mask = PyMask_AsBitmap(self);
 
-    ret = NULL;
-    regions = NULL;
-    aregion = NULL;
-
-    num_bounding_boxes = 0;
+    stats = NULL;
 
     Py_BEGIN_ALLOW_THREADS;
 
-    r = get_bounding_rects(mask, &num_bounding_boxes, &regions);
+    num = cc_stats(mask, &stats, NULL, NULL);
 
     Py_END_ALLOW_THREADS;
 
 
-    if(r == -2) {
+    if(num == -2) {
         /* memory out failure */
         return RAISE (PyExc_MemoryError, "Not enough memory to get bounding rects. \n");
     }
 
     ret = PyList_New (0);
-    if (!ret)
+    if (!ret) {
+        free(stats);
         return NULL;
+    }
 
-    /* build a list of rects to return.  Starts at 1 because we never use 0. */
-    for(i=1; i <= num_bounding_boxes; i++) {
-        aregion = regions + i;
-        rect = PyRect_New4 ( aregion->x, aregion->y, aregion->w, aregion->h );
-        PyList_Append (ret, rect);
+    /* build a list of rects to return. */
+    for(i=0; i < num; i++) {
+        rect = PyRect_New4 (stats[i].x, stats[i].y, stats[i].w, stats[i].h);
+        if (!rect || PyList_Append (ret, rect)) {
+            Py_XDECREF (rect);
+            Py_DECREF (ret);
+            free(stats);
+            return NULL;
+        }
         Py_DECREF (rect);
     }
 
-    free(regions);
+    free(stats);
+
+    return ret;
+}
+
+static PyObject* mask_get_component_stats(PyObject* self, PyObject* args)
+{
+    CCStats *stats;
+    int num, i, min;
+    PyObject* ret;
+    PyObject* item;
+
+    bitmask_t *mask = PyMask_AsBitmap(self);
+
+    min = 0;
+    stats = NULL;
+
+    if(!PyArg_ParseTuple(args, "|i", &min)) {
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    num = cc_stats(mask, &stats, NULL, NULL);
+    Py_END_ALLOW_THREADS;
+
+    if (num == -2)
+        return RAISE (PyExc_MemoryError, "Not enough memory to get components. \n");
+
+    ret = PyList_New (0);
+    if (!ret) {
+        free(stats);
+        return NULL;
+    }
+
+    for (i=0; i < num; i++) {
+        if (stats[i].area < min)
+            continue;
+        item = Py_BuildValue ("(lN(ll))", stats[i].area,
+                              PyRect_New4 (stats[i].x, stats[i].y,
+                                           stats[i].w, stats[i].h),
+                              stats[i].m10 / stats[i].area,
+                              stats[i].m01 / stats[i].area);
+        if (!item || PyList_Append (ret, item)) {
+            Py_XDECREF (item);
+            Py_DECREF (ret);
+            free(stats);
+            return NULL;
+        }
+        Py_DECREF (item);
+    }
 
+    free(stats);
     return ret;
 }
 
 
 /*
-returns the number of connected components.
+returns the number of connected components of at least min pixels.
 returns -2 on memory allocation error.
 Allocates memory for components.
 
 */
 static int get_connected_components(bitmask_t *mask, bitmask_t ***components, int min)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    int x, y, w, h, label, relabel;
+    CCStats *stats;
+    CCRun *runs;
+    int i, num, nruns, relabel;
+    int *relabels;
     bitmask_t** comps;
 
-    label = 0;
-
-    w = mask->w;
-    h = mask->h;
-
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *) malloc(sizeof(int)*w*h);
-    if(!image) { return -2; }
-
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *) malloc(sizeof(int)*(w/2 + 1)*(h/2 + 1));
-    if(!ufind) {
-        free(image);
-        return -2;
-    }
+    num = cc_stats(mask, &stats, &runs, &nruns);
+    if (num == -2) { return -2; }
 
-    largest = (unsigned int *) malloc(sizeof(int)*(w/2 + 1)*(h/2 + 1));
-    if(!largest) {
-        free(image);
-        free(ufind);
+    /* the components big enough are numbered from 1 on */
+    relabels = (int *) malloc(sizeof(int) * (num + 1));
+    if(!relabels) {
+        free(stats);
+        free(runs);
         return -2;
     }
-
-    /* do the initial labelling */
-    label = cc_label(mask, image, ufind, largest);
-
-    for (x = 1; x <= label; x++) {
-        if (ufind[x] < x) {
-            largest[ufind[x]] += largest[x];
-        }
-    }
-
     relabel = 0;
-    /* flatten and relabel the union-find equivalence array.  Start at label 1
-       because label 0 indicates an unset pixel.  For this reason, we also use
-       <= label rather than < label. */
-    for (x = 1; x <= label; x++) {
-        if (ufind[x] < x) {             /* is it a union find root? */
-            ufind[x] = ufind[ufind[x]]; /* relabel it to its root */
-        } else {                 /* its a root */
-            if (largest[x] >= min) {
-                relabel++;
-                ufind[x] = relabel;  /* assign the lowest label available */
-            } else {
-                ufind[x] = 0;
-            }
-        }
+    for (i = 0; i < num; i++) {
+        relabels[i] = (stats[i].area >= min) ? ++relabel : 0;
     }
+    free(stats);
 
     if (relabel == 0) {
     /* early out, as we didn't find anything. */
-        free(image);
-        free(ufind);
-        free(largest);
+        free(relabels);
+        free(runs);
         return 0;
     }
 
     /* allocate space for the mask array */
     comps = (bitmask_t **) malloc(sizeof(bitmask_t *) * (relabel +1));
     if(!comps) {
-        free(image);
-        free(ufind);
-        free(largest);
+        free(relabels);
+        free(runs);
         return -2;
     }
 
     /* create the empty masks */
-    for (x = 1; x <= relabel; x++) {
-        comps[x] = bitmask_create(w, h);
+    for (i = 1; i <= relabel; i++) {
+        comps[i] = bitmask_create(mask->w, mask->h);
+        if(!comps[i]) {
+            while (--i > 0) {
+                bitmask_free(comps[i]);
+            }
+            free(comps);
+            free(relabels);
+            free(runs);
+            return -2;
+        }
     }
 
-    /* set the bits in each mask */
-    buf = image;
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf]) {         /* if the pixel is part of a component */
-                bitmask_setbit(comps[ufind[*buf]], x, y);
-            }
-            buf++;
+    /* set the bits in each mask, a run at a time */
+    for (i = 0; i < nruns; i++) {
+        if (relabels[runs[i].parent]) {
+            cc_draw_run(comps[relabels[runs[i].parent]], runs + i);
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    free(relabels);
+    free(runs);
 
     *components = comps;
 
@@ -1245,11 +2139,13 @@ static PyObject* mask_connected_components(PyObject* self, PyObject* args)
         return NULL;
 
     for (i=1; i <= num_components; i++) {
-        maskobj = PyObject_New(PyMaskObject, &PyMask_Type);
+        maskobj = mask_new();
         if(maskobj) {
             maskobj->mask = components[i];
             PyList_Append (ret, (PyObject *) maskobj);
             Py_DECREF((PyObject *) maskobj);
+        } else {
+            bitmask_free(components[i]);
         }
     }
 
@@ -1257,77 +2153,48 @@ static PyObject* mask_connected_components(PyObject* self, PyObject* args)
     return ret;
 }
 
-/* Connected component labeling based on the SAUF algorithm by Kesheng Wu,
-   Ekow Otoo, and Kenji Suzuki.  The algorithm is best explained by their paper,
-   "Two Strategies to Speed up Connected Component Labeling Algorithms", but in
-   summary, it is a very efficient two pass method for 8-connected components.
-   It uses a decision tree to minimize the number of neighbors that need to be
-   checked.  It stores equivalence information in an array based union-find.
-   This implementation also tracks the number of pixels in each label, finding
-   the biggest one while flattening the union-find equivalence array.  It then
-   writes an output mask containing only the largest connected component. */
-
 
 /*
+Writes to output the largest connected component of input, the first one
+in scan order of the largest ones, or when ccx is not negative the one with
+the pixel at (ccx, ccy).
 returns -2 on memory allocation error.
 */
 static int largest_connected_comp(bitmask_t* input, bitmask_t* output, int ccx, int ccy)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    unsigned int max, x, y, w, h, label;
+    CCStats *stats;
+    CCRun *runs;
+    int i, num, nruns, max;
 
-    w = input->w;
-    h = input->h;
+    num = cc_stats(input, &stats, &runs, &nruns);
+    if (num == -2) { return -2; }
 
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *) malloc(sizeof(int)*w*h);
-    if(!image) { return -2; }
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *) malloc(sizeof(int)*(w/2 + 1)*(h/2 + 1));
-    if(!ufind) {
-        free(image);
-        return -2;
-    }
-    /* an array to track the number of pixels associated with each label */
-    largest = (unsigned int *) malloc(sizeof(int)*(w/2 + 1)*(h/2 + 1));
-    if(!largest) {
-        free(image);
-        free(ufind);
-        return -2;
+    max = -1;
+    for (i = 0; i < num; i++) {
+        if (max < 0 || stats[i].area > stats[max].area) {
+            max = i;
+        }
     }
 
-    /* do the initial labelling */
-    label = cc_label(input, image, ufind, largest);
-
-    max = 1;
-    /* flatten the union-find equivalence array */
-    for (x = 2; x <= label; x++) {
-         if (ufind[x] != x) {                 /* is it a union find root? */
-             largest[ufind[x]] += largest[x]; /* add its pixels to its root */
-             ufind[x] = ufind[ufind[x]];      /* relabel it to its root */
-         }
-         if (largest[ufind[x]] > largest[max]) { /* is it the new biggest? */
-             max = ufind[x];
-         }
-    }
-
-    /* write out the final image */
-    buf = image;
-    if (ccx >= 0)
-        max = ufind[*(buf+ccy*w+ccx)];
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf] == max) {         /* if the label is the max one */
-                bitmask_setbit(output, x, y); /* set the bit in the mask */
+    if (ccx >= 0) {
+        max = -1;
+        for (i = 0; i < nruns; i++) {
+            if (runs[i].y == ccy && runs[i].x <= ccx && ccx < runs[i].end) {
+                max = runs[i].parent;
+                break;
             }
-            buf++;
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    /* write out the runs of the component */
+    for (i = 0; i < nruns; i++) {
+        if (runs[i].parent == max) {
+            cc_draw_run(output, runs + i);
+        }
+    }
+
+    free(stats);
+    free(runs);
 
     return 0;
 }
@@ -1335,8 +2202,8 @@ static int largest_connected_comp(bitmask_t* input, bitmask_t* output, int ccx,
 static PyObject* mask_connected_component(PyObject* self, PyObject* args)
 {
     bitmask_t *input = PyMask_AsBitmap(self);
-    bitmask_t *output = bitmask_create(input->w, input->h);
-    PyMaskObject *maskobj = PyObject_New(PyMaskObject, &PyMask_Type);
+    bitmask_t *output;
+    PyMaskObject *maskobj;
     int x, y;
 
     x = -1;
@@ -1345,15 +2212,24 @@ static PyObject* mask_connected_component(PyObject* self, PyObject* args)
         return NULL;
     }
 
+    output = bitmask_create(input->w, input->h);
+    if(!output) {
+        return RAISE (PyExc_MemoryError, "cannot create bitmask");
+    }
+
     /* if a coordinate is specified, make the pixel there is actually set */
     if (x == -1 || bitmask_getbit(input, x, y)) {
         if (largest_connected_comp(input, output, x, y) == -2) {
+            bitmask_free(output);
             return RAISE (PyExc_MemoryError, "Not enough memory to get bounding rects. \n");
         }
     }
 
+    maskobj = mask_new();
     if(maskobj)
         maskobj->mask = output;
+    else
+        bitmask_free(output);
 
     return (PyObject*)maskobj;
 }
@@ -1367,6 +2243,11 @@ static PyMethodDef mask_methods[] =
     { "overlap", mask_overlap, METH_VARARGS, DOC_MASKOVERLAP },
     { "overlap_area", mask_overlap_area, METH_VARARGS, DOC_MASKOVERLAPAREA },
     { "overlap_mask", mask_overlap_mask, METH_VARARGS, DOC_MASKOVERLAPMASK },
+    { "overlap_many", mask_overlap_many, METH_VARARGS, DOC_MASKOVERLAPMANY },
+    { "set_overlap_cache", mask_set_overlap_cache, METH_VARARGS,
+      DOC_MASKSETOVERLAPCACHE },
+    { "set_block_map", mask_set_block_map, METH_VARARGS,
+      DOC_MASKSETBLOCKMAP },
     { "fill", mask_fill, METH_NOARGS, DOC_MASKFILL },
     { "clear", mask_clear, METH_NOARGS, DOC_MASKCLEAR },
     { "invert", mask_invert, METH_NOARGS, DOC_MASKINVERT },
@@ -1377,13 +2258,22 @@ static PyMethodDef mask_methods[] =
     { "centroid", mask_centroid, METH_NOARGS, DOC_MASKCENTROID },
     { "angle", mask_angle, METH_NOARGS, DOC_MASKANGLE },
     { "outline", mask_outline, METH_VARARGS, DOC_MASKOUTLINE },
+    { "outline_array", mask_outline_array, METH_VARARGS, DOC_MASKOUTLINEARRAY },
     { "convolve", mask_convolve, METH_VARARGS, DOC_MASKCONVOLVE },
+    { "dilate", mask_dilate, METH_VARARGS, DOC_MASKDILATE },
+    { "erode", mask_erode, METH_VARARGS, DOC_MASKERODE },
+    { "open", mask_open, METH_VARARGS, DOC_MASKOPEN },
+    { "close", mask_close, METH_VARARGS, DOC_MASKCLOSE },
     { "connected_component", mask_connected_component, METH_VARARGS,
       DOC_MASKCONNECTEDCOMPONENT },
     { "connected_components", mask_connected_components, METH_VARARGS,
       DOC_MASKCONNECTEDCOMPONENTS },
     { "get_bounding_rects", mask_get_bounding_rects, METH_NOARGS,
       DOC_MASKGETBOUNDINGRECTS },
+    { "get_component_stats", mask_get_component_stats, METH_VARARGS,
+      DOC_MASKGETCOMPONENTSTATS },
+    { "to_surface", (PyCFunction) mask_to_surface,
+      METH_VARARGS | METH_KEYWORDS, DOC_MASKTOSURFACE },
 
     { NULL, NULL, 0, NULL }
 };
@@ -1395,6 +2285,11 @@ static PyMethodDef mask_methods[] =
 static void mask_dealloc(PyObject* self)
 {
     bitmask_t *mask = PyMask_AsBitmap(self);
+    mask_drop_shifts(self);
+    free(((PyMaskObject*)self)->shifts);
+    if (((PyMaskObject*)self)->blocks)
+        bitmask_free(((PyMaskObject*)self)->blocks);
+    free(((PyMaskObject*)self)->moments);
     bitmask_free(mask);
     PyObject_DEL(self);
 }
@@ -1456,7 +2351,7 @@ static PyObject* Mask(PyObject* self, PyObject* args)
       return NULL; /*RAISE(PyExc_Error, "cannot create bitmask");*/
 
         /*create the new python object from mask*/
-    maskobj = PyObject_New(PyMaskObject, &PyMask_Type);
+    maskobj = mask_new();
     if(maskobj)
         maskobj->mask = mask;
     return (PyObject*)maskobj;
@@ -1464,6 +2359,224 @@ static PyObject* Mask(PyObject* self, PyObject* args)
 
 
 
+/* An entry of collide_pairs: its box, lo..hi across, and its mask if any */
+typedef struct {
+    GAME_Rect r;
+    int lo, hi;
+    bitmask_t *mask;
+    int index;
+    int set;
+} CollideItem;
+
+static int
+collide_item_cmp(const void *a, const void *b)
+{
+    const CollideItem *ia = (const CollideItem *)a;
+    const CollideItem *ib = (const CollideItem *)b;
+
+    if (ia->lo != ib->lo)
+        return ia->lo < ib->lo ? -1 : 1;
+    if (ia->set != ib->set)
+        return ia->set - ib->set;
+    return ia->index - ib->index;
+}
+
+static int
+collide_pair_cmp(const void *a, const void *b)
+{
+    const int *pa = (const int *)a, *pb = (const int *)b;
+
+    if (pa[0] != pb[0])
+        return pa[0] < pb[0] ? -1 : 1;
+    return pa[1] < pb[1] ? -1 : pa[1] > pb[1];
+}
+
+/* Fill items for the rects, and masks if not NULL, of one set. Returns -1
+   with an exception set on bad arguments. */
+static int
+collide_items(CollideItem *items, PyObject *rects, PyObject *masks, int set)
+{
+    Py_ssize_t i, n = PySequence_Fast_GET_SIZE(rects);
+
+    for (i = 0; i < n; i++) {
+        CollideItem *item = items + i;
+        PyObject *maskobj = masks ? PySequence_Fast_GET_ITEM(masks, i) : NULL;
+        GAME_Rect temp, *r;
+
+        r = GameRect_FromObject(PySequence_Fast_GET_ITEM(rects, i), &temp);
+        if (!r) {
+            PyErr_SetString(PyExc_TypeError, "rects must hold rect style objects");
+            return -1;
+        }
+        item->r = *r;
+        item->mask = NULL;
+        if (maskobj && maskobj != Py_None) {
+            if (!PyObject_TypeCheck(maskobj, &PyMask_Type)) {
+                PyErr_SetString(PyExc_TypeError, "masks must hold Masks or None");
+                return -1;
+            }
+            item->mask = PyMask_AsBitmap(maskobj);
+            /* a mask covers its own size, from the rect topleft */
+            item->r.w = item->mask->w;
+            item->r.h = item->mask->h;
+        }
+        item->lo = MIN(item->r.x, item->r.x + item->r.w);
+        item->hi = MAX(item->r.x, item->r.x + item->r.w);
+        item->index = (int)i;
+        item->set = set;
+    }
+    return 0;
+}
+
+/* True if item a of the first set collides with item b of the second */
+static int
+collide_test(const CollideItem *a, const CollideItem *b)
+{
+    if (!(a->r.x < b->r.x + b->r.w && a->r.y < b->r.y + b->r.h &&
+          a->r.x + a->r.w > b->r.x && a->r.y + a->r.h > b->r.y))
+        return 0;
+    if (a->mask && b->mask)
+        return bitmask_overlap(a->mask, b->mask,
+                               b->r.x - a->r.x, b->r.y - a->r.y);
+    return 1;
+}
+
+/* Sort and sweep: take the entries of both sets in order of their left
+   edges, and test each one only against the entries of the other set
+   still open across it. Pairs are gathered in *pairs, two ints each.
+   Returns the number of pairs, or -1 if out of memory. */
+static int
+collide_sweep(CollideItem *items, int n, int **pairs)
+{
+    int *active[2], nactive[2] = {0, 0};
+    int i, j, k, npairs = 0, maxpairs = 64;
+
+    active[0] = (int *)malloc(sizeof(int) * (n + 1));
+    active[1] = (int *)malloc(sizeof(int) * (n + 1));
+    *pairs = (int *)malloc(sizeof(int) * 2 * maxpairs);
+    if (!active[0] || !active[1] || !*pairs) {
+        npairs = -1;
+        goto done;
+    }
+
+    qsort(items, n, sizeof(CollideItem), collide_item_cmp);
+    for (i = 0; i < n; i++) {
+        CollideItem *item = items + i;
+        int other = !item->set;
+        int *open = active[other];
+
+        /* drop the entries of the other set that end before this one */
+        for (j = k = 0; j < nactive[other]; j++) {
+            CollideItem *o = items + open[j];
+
+            if (o->hi <= item->lo)
+                continue;
+            open[k++] = open[j];
+            if (item->set ? collide_test(o, item) : collide_test(item, o)) {
+                if (npairs == maxpairs) {
+                    int *more = (int *)realloc(*pairs,
+                                               sizeof(int) * 4 * maxpairs);
+                    if (!more) {
+                        npairs = -1;
+                        goto done;
+                    }
+                    *pairs = more;
+                    maxpairs *= 2;
+                }
+                (*pairs)[npairs * 2] = item->set ? o->index : item->index;
+                (*pairs)[npairs * 2 + 1] = item->set ? item->index : o->index;
+                npairs++;
+            }
+        }
+        nactive[other] = k;
+        active[item->set][nactive[item->set]++] = i;
+    }
+    qsort(*pairs, npairs, sizeof(int) * 2, collide_pair_cmp);
+
+done:
+    free(active[0]);
+    free(active[1]);
+    if (npairs < 0) {
+        free(*pairs);
+        *pairs = NULL;
+    }
+    return npairs;
+}
+
+static PyObject* mask_collide_pairs(PyObject* self, PyObject* args)
+{
+    PyObject *rects1, *rects2, *masks1 = Py_None, *masks2 = Py_None;
+    PyObject *seq[4] = {NULL, NULL, NULL, NULL};
+    PyObject *result = NULL;
+    CollideItem *items = NULL;
+    int *pairs = NULL;
+    int n1, n2, npairs, i;
+
+    if (!PyArg_ParseTuple(args, "OO|OO", &rects1, &rects2, &masks1, &masks2))
+        return NULL;
+
+    seq[0] = PySequence_Fast(rects1, "rects must be sequences");
+    seq[1] = PySequence_Fast(rects2, "rects must be sequences");
+    if (!seq[0] || !seq[1])
+        goto done;
+    n1 = (int)PySequence_Fast_GET_SIZE(seq[0]);
+    n2 = (int)PySequence_Fast_GET_SIZE(seq[1]);
+    if (masks1 != Py_None) {
+        seq[2] = PySequence_Fast(masks1, "masks must be sequences");
+        if (!seq[2])
+            goto done;
+        if (PySequence_Fast_GET_SIZE(seq[2]) != n1) {
+            PyErr_SetString(PyExc_ValueError, "masks must be as long as rects");
+            goto done;
+        }
+    }
+    if (masks2 != Py_None) {
+        seq[3] = PySequence_Fast(masks2, "masks must be sequences");
+        if (!seq[3])
+            goto done;
+        if (PySequence_Fast_GET_SIZE(seq[3]) != n2) {
+            PyErr_SetString(PyExc_ValueError, "masks must be as long as rects");
+            goto done;
+        }
+    }
+
+    items = (CollideItem *)malloc(sizeof(CollideItem) * (n1 + n2 + 1));
+    if (!items) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    if (collide_items(items, seq[0], seq[2], 0) ||
+        collide_items(items + n1, seq[1], seq[3], 1))
+        goto done;
+
+    npairs = collide_sweep(items, n1 + n2, &pairs);
+    if (npairs < 0) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    result = PyList_New(npairs);
+    if (!result)
+        goto done;
+    for (i = 0; i < npairs; i++) {
+        PyObject *pair = Py_BuildValue("(ii)", pairs[i * 2], pairs[i * 2 + 1]);
+
+        if (!pair) {
+            Py_DECREF(result);
+            result = NULL;
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, pair);
+    }
+
+done:
+    for (i = 0; i < 4; i++)
+        Py_XDECREF(seq[i]);
+    free(items);
+    free(pairs);
+    return result;
+}
+
 static PyMethodDef _mask_methods[] =
 {
     { "Mask", Mask, METH_VARARGS, DOC_PYGAMEMASKMASK },
@@ -1471,6 +2584,8 @@ static PyMethodDef _mask_methods[] =
       DOC_PYGAMEMASKFROMSURFACE},
     { "from_threshold", mask_from_threshold, METH_VARARGS,
       DOC_PYGAMEMASKFROMTHRESHOLD},
+    { "collide_pairs", mask_collide_pairs, METH_VARARGS,
+      DOC_PYGAMEMASKCOLLIDEPAIRS},
     { NULL, NULL, 0, NULL }
 };
 
@@ -8,6 +8,9 @@
 typedef struct {
   PyObject_HEAD
   bitmask_t *mask;
+  struct MaskShiftCache *shifts; /* copies for overlap tests, or NULL */
+  bitmask_t *blocks; /* block map for overlap tests, or NULL */
+  bitmask_moments_t *moments; /* raw moments of the bits, or NULL */
 } PyMaskObject;
 
 #define PyMask_AsBitmap(x) (((PyMaskObject*)x)->mask)
@@ -33,11 +33,17 @@
 #include "pygame.h"
 #include "structmember.h"
 #include "pgcompat.h"
+#include "pgfreelist.h"
 #include <float.h>
 #include <math.h>
 #include <stddef.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define MATH_SSE2
+#include <emmintrin.h>
+#endif
+
 /* on some windows platforms math.h doesn't define M_PI */
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -72,6 +78,13 @@ static PyTypeObject PyVector3_Type;
 static PyTypeObject PyVectorElementwiseProxy_Type;
 static PyTypeObject PyVectorIter_Type;
 
+static void vector_freelist_clear(PyObject *obj);
+
+/* Memory of dead vectors, reused by the next new ones. Kept vectors
+ * still own their coords. */
+static PgFreeList vector2_freelist = PG_FREELIST_INIT(vector_freelist_clear);
+static PgFreeList vector3_freelist = PG_FREELIST_INIT(vector_freelist_clear);
+
 #define PyVector2_Check(x) (Py_TYPE(x) == &PyVector2_Type)
 #define PyVector3_Check(x) (Py_TYPE(x) == &PyVector3_Type)
 #define PyVector_Check(x) (PyVector2_Check(x) || PyVector3_Check(x))
@@ -89,6 +102,41 @@ typedef struct
     double epsilon;     /* Small value for comparisons */
 } PyVector;
 
+/* Many vectors of one dimension, stored as planes: all the x, then all
+ * the y and, for a Vector3Array, all the z, each plane alloc long */
+typedef struct
+{
+    PyObject_HEAD
+    double *coords;     /* dim planes of alloc coordinates */
+    Py_ssize_t len;     /* Number of vectors */
+    Py_ssize_t alloc;   /* Room in each plane */
+    unsigned int dim;   /* Dimension of the vectors */
+    double epsilon;     /* Small value for comparisons */
+    int exports;        /* Buffers exported, the planes may not move */
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} PyVectorArray;
+
+static PyTypeObject PyVector2Array_Type;
+static PyTypeObject PyVector3Array_Type;
+
+#define PyVectorArray_Check(x) \
+    (PyObject_TypeCheck(x, &PyVector2Array_Type) || \
+     PyObject_TypeCheck(x, &PyVector3Array_Type))
+
+/* A fixed rotation, kept as its matrix */
+typedef struct
+{
+    PyObject_HEAD
+    unsigned int dim;   /* Dimension of the vectors rotated */
+    double angle;       /* Angle in degrees */
+    double axis[3];     /* Axis of a Rotation3, as given */
+    double matrix[9];   /* dim by dim, by rows */
+} PyRotation;
+
+static PyTypeObject PyRotation2_Type;
+static PyTypeObject PyRotation3_Type;
+
 typedef struct {
     PyObject_HEAD
     long it_index;
@@ -230,6 +278,23 @@ static PyObject *vector_elementwise(PyVector *vec);
 
 static int swizzling_enabled = 0;
 
+/* Attribute names already looked at for swizzling. Names mostly come
+ * back as the same interned string, so a repeated swizzle is found by
+ * one pointer compare and skips the failing generic lookup. Names that
+ * are not swizzles are kept too, with len 0. */
+#define SWIZZLE_CACHE_SIZE 64
+#define SWIZZLE_CACHE_MAX_LEN 8
+
+typedef struct {
+    PyObject *name;
+    Py_ssize_t len;         /* 0 if name is no cacheable swizzle */
+    int max_idx;            /* largest coordinate index used */
+    int has_repeats;        /* some coordinate is named twice */
+    unsigned char idx[SWIZZLE_CACHE_MAX_LEN];
+} swizzle_pattern;
+
+static swizzle_pattern swizzle_cache[SWIZZLE_CACHE_SIZE];
+
 
 /********************************
  * Global helper functions
@@ -329,6 +394,51 @@ PyVectorCompatible_Check(PyObject *obj, int dim)
     return 1;
 }
 
+/* Read obj as dim coordinates, like PyVectorCompatible_Check followed
+ * by PySequence_AsVectorCoords. Vectors, tuples and lists are read in
+ * place without taking each item. Returns 1 if obj was read, 0 with no
+ * error set if it is not vector compatible and -1 on an error. */
+static int
+_vector_coords_from_obj(PyObject *obj, double *coords, int dim)
+{
+    PyObject **items, *item;
+    int i;
+
+    if (PyVector_Check(obj)) {
+        if (((PyVector *)obj)->dim != (unsigned)dim)
+            return 0;
+        memcpy(coords, ((PyVector *)obj)->coords, sizeof(double) * dim);
+        return 1;
+    }
+    if (PyTuple_Check(obj) || PyList_Check(obj)) {
+        if (PySequence_Fast_GET_SIZE(obj) != dim)
+            return 0;
+        items = PySequence_Fast_ITEMS(obj);
+        for (i = 0; i < dim; ++i) {
+            item = items[i];
+            if (PyFloat_Check(item))
+                coords[i] = PyFloat_AS_DOUBLE(item);
+#if !PY3
+            else if (PyInt_Check(item))
+                coords[i] = (double)PyInt_AS_LONG(item);
+#endif
+            else if (PyLong_Check(item) || RealNumber_Check(item)) {
+                /* PyLong_AsDouble makes no temporary float */
+                coords[i] = PyLong_Check(item) ? PyLong_AsDouble(item) :
+                                                 PyFloat_AsDouble(item);
+                if (coords[i] == -1 && PyErr_Occurred())
+                    return -1;
+            }
+            else
+                return 0;
+        }
+        return 1;
+    }
+    if (!PyVectorCompatible_Check(obj, dim))
+        return 0;
+    return PySequence_AsVectorCoords(obj, coords, dim) ? 1 : -1;
+}
+
 static double
 _scalar_product(const double *coords1, const double *coords2, int size)
 {
@@ -455,15 +565,41 @@ static PyMemberDef vector_members[] = {
 };
 
 
+static void
+vector_freelist_clear(PyObject *obj)
+{
+    PyMem_Del(((PyVector*)obj)->coords);
+}
+
+/* Take a vector off the free list of type, if type is exactly Vector2
+ * or Vector3. Only its coords are left to set. */
+static PyVector*
+vector_freelist_pop(PyTypeObject *type)
+{
+    PyVector *vec = NULL;
+
+    if (type == &PyVector2_Type)
+        vec = (PyVector*)PgFreeList_Pop(&vector2_freelist, type);
+    else if (type == &PyVector3_Type)
+        vec = (PyVector*)PgFreeList_Pop(&vector3_freelist, type);
+    if (vec != NULL)
+        vec->epsilon = VECTOR_EPSILON;
+    return vec;
+}
+
 static PyObject*
 PyVector_NEW(int dim)
 {
     PyVector *vec;
     switch (dim) {
     case 2:
+        if ((vec = vector_freelist_pop(&PyVector2_Type)) != NULL)
+            return (PyObject *)vec;
         vec = PyObject_New(PyVector, &PyVector2_Type);
         break;
     case 3:
+        if ((vec = vector_freelist_pop(&PyVector3_Type)) != NULL)
+            return (PyObject *)vec;
         vec = PyObject_New(PyVector, &PyVector3_Type);
         break;
 /*
@@ -493,6 +629,12 @@ PyVector_NEW(int dim)
 static void
 vector_dealloc(PyVector* self)
 {
+    if (Py_TYPE(self) == &PyVector2_Type &&
+        PgFreeList_Push(&vector2_freelist, (PyObject*)self))
+        return;
+    if (Py_TYPE(self) == &PyVector3_Type &&
+        PgFreeList_Push(&vector3_freelist, (PyObject*)self))
+        return;
     PyMem_Del(self->coords);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
@@ -532,15 +674,18 @@ vector_generic_math(PyObject *o1, PyObject *o2, int op)
         return NULL;
     }
 
-    if (PyVectorCompatible_Check(other, dim)) {
+    switch (_vector_coords_from_obj(other, other_coords, dim)) {
+    case 1:
         op |= OP_ARG_VECTOR;
-        if (!PySequence_AsVectorCoords(other, other_coords, dim))
-            return NULL;
+        break;
+    case -1:
+        return NULL;
+    default:
+        if (RealNumber_Check(other))
+            op |= OP_ARG_NUMBER;
+        else
+            op |= OP_ARG_UNKNOWN;
     }
-    else if (RealNumber_Check(other))
-        op |= OP_ARG_NUMBER;
-    else
-        op |= OP_ARG_UNKNOWN;
 
     if (op & OP_INPLACE) {
          ret = vec;
@@ -1097,7 +1242,10 @@ vector_richcompare(PyObject *o1, PyObject *o2, int op)
         vec = (PyVector*)o2;
         other = o1;
     }
-    if (!PyVectorCompatible_Check(other, vec->dim)) {
+    switch (_vector_coords_from_obj(other, other_coords, vec->dim)) {
+    case -1:
+        return NULL;
+    case 0:
         if (op == Py_EQ)
             Py_RETURN_FALSE;
         else if (op == Py_NE)
@@ -1108,10 +1256,6 @@ vector_richcompare(PyObject *o1, PyObject *o2, int op)
         }
     }
 
-    if (!PySequence_AsVectorCoords(other, other_coords, vec->dim)) {
-        return NULL;
-    }
-
     switch(op) {
     case Py_EQ:
         for (i = 0; i < vec->dim; i++) {
@@ -1517,6 +1661,150 @@ vector_str(PyVector *self)
  *     original AttributeError
  *  3) swizzling fails due to some internal error. we return this error.
  */
+/* Fill pattern from attr_name, giving it len 0 unless the name is a
+ * swizzle of 2 to SWIZZLE_CACHE_MAX_LEN coordinates. Single letters are
+ * left to the x, y and z attributes. */
+static int
+_swizzle_parse(PyObject *attr_name, swizzle_pattern *pattern)
+{
+    PyObject *attr_unicode;
+    Py_UNICODE *attr;
+    Py_ssize_t i, len;
+    int idx, seen = 0;
+
+    pattern->len = 0;
+    pattern->max_idx = 0;
+    pattern->has_repeats = 0;
+    len = PySequence_Length(attr_name);
+    if (len < 2 || len > SWIZZLE_CACHE_MAX_LEN) {
+        PyErr_Clear();
+        return 1;
+    }
+    attr_unicode = PyUnicode_FromObject(attr_name);
+    if (attr_unicode == NULL)
+        return 0;
+    attr = PyUnicode_AsUnicode(attr_unicode);
+    if (attr == NULL) {
+        Py_DECREF(attr_unicode);
+        return 0;
+    }
+    for (i = 0; i < len; ++i) {
+        switch (attr[i]) {
+        case 'x':
+        case 'y':
+        case 'z':
+            idx = attr[i] - 'x';
+            break;
+        case 'w':
+            idx = 3;
+            break;
+        default:
+            Py_DECREF(attr_unicode);
+            return 1;
+        }
+        if (seen & (1 << idx))
+            pattern->has_repeats = 1;
+        seen |= 1 << idx;
+        if (idx > pattern->max_idx)
+            pattern->max_idx = idx;
+        pattern->idx[i] = (unsigned char)idx;
+    }
+    Py_DECREF(attr_unicode);
+    pattern->len = len;
+    return 1;
+}
+
+/* The cached pattern of attr_name, parsing it on a miss, or NULL */
+static swizzle_pattern *
+_swizzle_cache_lookup(PyObject *attr_name)
+{
+    swizzle_pattern *pattern, parsed;
+    long hash = PyObject_Hash(attr_name);
+
+    if (hash == -1) {
+        PyErr_Clear();
+        return NULL;
+    }
+    pattern = &swizzle_cache[(unsigned long)hash % SWIZZLE_CACHE_SIZE];
+    if (pattern->name == attr_name)
+        return pattern;
+    if (pattern->name != NULL) {
+        switch (PyObject_RichCompareBool(pattern->name, attr_name, Py_EQ)) {
+        case 1:
+            return pattern;
+        case -1:
+            PyErr_Clear();
+            return NULL;
+        }
+    }
+    if (!_swizzle_parse(attr_name, &parsed)) {
+        PyErr_Clear();
+        return NULL;
+    }
+    Py_XDECREF(pattern->name);
+    *pattern = parsed;
+    Py_INCREF(attr_name);
+    pattern->name = attr_name;
+    return pattern;
+}
+
+/* A cached swizzle that applies to self, or NULL. Only Vector2 and
+ * Vector3 themselves qualify: they have no other attributes spelled in
+ * x, y, z and w, which the generic lookup would have to find first. */
+static swizzle_pattern *
+_vector_swizzle_pattern(PyVector *self, PyObject *attr_name)
+{
+    swizzle_pattern *pattern;
+
+    if (!PyVector_Check(self))
+        return NULL;
+    pattern = _swizzle_cache_lookup(attr_name);
+    if (pattern == NULL || pattern->len == 0 ||
+        pattern->max_idx >= (int)self->dim)
+        return NULL;
+    return pattern;
+}
+
+static PyObject *
+_vector_swizzle_get(PyVector *self, swizzle_pattern *pattern)
+{
+    Py_ssize_t i;
+    PyObject *item, *res = PyTuple_New(pattern->len);
+
+    if (res == NULL)
+        return NULL;
+    for (i = 0; i < pattern->len; ++i) {
+        item = PyFloat_FromDouble(self->coords[pattern->idx[i]]);
+        if (item == NULL) {
+            Py_DECREF(res);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(res, i, item);
+    }
+    return res;
+}
+
+static int
+_vector_swizzle_set(PyVector *self, swizzle_pattern *pattern, PyObject *val)
+{
+    double entry[VECTOR_MAX_SIZE];
+    Py_ssize_t i;
+
+    if (pattern->has_repeats) {
+        PyErr_SetString(PyExc_AttributeError,
+                        "Attribute assignment conflicts with swizzling.");
+        return -1;
+    }
+    for (i = 0; i < pattern->len; ++i) {
+        entry[pattern->idx[i]] = PySequence_GetItem_AsDouble(val, i);
+        if (PyErr_Occurred())
+            return -1;
+    }
+    for (i = 0; i < pattern->len; ++i)
+        self->coords[pattern->idx[i]] = entry[pattern->idx[i]];
+    return 0;
+}
+
 static PyObject*
 vector_getAttr_swizzle(PyVector *self, PyObject *attr_name)
 {
@@ -1525,7 +1813,15 @@ vector_getAttr_swizzle(PyVector *self, PyObject *attr_name)
     PyObject *err_type, *err_value, *err_traceback;
     PyObject *attr_unicode = NULL;
     Py_UNICODE *attr = NULL;
-    PyObject *res = PyObject_GenericGetAttr((PyObject*)self, attr_name);
+    PyObject *res;
+    swizzle_pattern *pattern;
+
+    if (swizzling_enabled) {
+        pattern = _vector_swizzle_pattern(self, attr_name);
+        if (pattern != NULL)
+            return _vector_swizzle_get(self, pattern);
+    }
+    res = PyObject_GenericGetAttr((PyObject*)self, attr_name);
     /* if normal lookup failed try to swizzle */
     if (swizzling_enabled &&
         PyErr_Occurred() && PyErr_ExceptionMatches(PyExc_AttributeError)) {
@@ -1591,11 +1887,17 @@ vector_setAttr_swizzle(PyVector *self, PyObject *attr_name, PyObject *val)
     int entry_was_set[VECTOR_MAX_SIZE];
     int swizzle_err = SWIZZLE_ERR_NO_ERR;
     int i;
+    swizzle_pattern *pattern;
 
-    /* if swizzling is disabled always default to generic implementation */
-    if (!swizzling_enabled)
+    /* if swizzling is disabled always default to generic implementation.
+     * single letters are the x, y and z attributes, which take a number */
+    if (!swizzling_enabled || len == 1)
         return PyObject_GenericSetAttr((PyObject*)self, attr_name, val);
 
+    pattern = _vector_swizzle_pattern(self, attr_name);
+    if (pattern != NULL)
+        return _vector_swizzle_set(self, pattern, val);
+
     /* if swizzling is enabled first try swizzle */
     for (i = 0; i < self->dim; ++i)
         entry_was_set[i] = 0;
@@ -1739,8 +2041,11 @@ static PyBufferProcs vector_as_buffer = {
 static PyObject *
 vector2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    PyVector *vec = (PyVector *)type->tp_alloc(type, 0);
+    PyVector *vec = vector_freelist_pop(type);
 
+    if (vec != NULL)
+        return (PyObject *)vec;
+    vec = (PyVector *)type->tp_alloc(type, 0);
     if (vec != NULL) {
         vec->dim = 2;
         vec->epsilon = VECTOR_EPSILON;
@@ -1905,6 +2210,49 @@ vector2_rotate_ip(PyVector *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/* rotation by an angle in radians, without the degree special cases */
+static void
+_vector2_rotate_rad_helper(double *dst_coords, const double *src_coords,
+                           double angle)
+{
+    double sinValue = sin(angle);
+    double cosValue = cos(angle);
+    double x = src_coords[0];
+
+    dst_coords[0] = cosValue * x - sinValue * src_coords[1];
+    dst_coords[1] = sinValue * x + cosValue * src_coords[1];
+}
+
+static PyObject *
+vector2_rotate_rad(PyVector *self, PyObject *args)
+{
+    double angle;
+    PyVector *ret;
+
+    if (!PyArg_ParseTuple(args, "d:rotate_rad", &angle)) {
+        return NULL;
+    }
+
+    ret = (PyVector*)PyVector_NEW(self->dim);
+    if (ret == NULL) {
+        return NULL;
+    }
+    _vector2_rotate_rad_helper(ret->coords, self->coords, angle);
+    return (PyObject*)ret;
+}
+
+static PyObject *
+vector2_rotate_ip_rad(PyVector *self, PyObject *args)
+{
+    double angle;
+
+    if (!PyArg_ParseTuple(args, "d:rotate_ip_rad", &angle)) {
+        return NULL;
+    }
+    _vector2_rotate_rad_helper(self->coords, self->coords, angle);
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 vector2_cross(PyVector *self, PyObject *other)
 {
@@ -1980,6 +2328,12 @@ static PyMethodDef vector2_methods[] = {
     {"rotate_ip", (PyCFunction)vector2_rotate_ip, METH_VARARGS,
      DOC_VECTOR2ROTATEIP
     },
+    {"rotate_rad", (PyCFunction)vector2_rotate_rad, METH_VARARGS,
+     DOC_VECTOR2ROTATERAD
+    },
+    {"rotate_ip_rad", (PyCFunction)vector2_rotate_ip_rad, METH_VARARGS,
+     DOC_VECTOR2ROTATEIPRAD
+    },
     {"slerp", (PyCFunction)vector_slerp, METH_VARARGS,
      DOC_VECTOR2SLERP
     },
@@ -2133,8 +2487,11 @@ static PyTypeObject PyVector2_Type = {
 static PyObject *
 vector3_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    PyVector *vec = (PyVector *)type->tp_alloc(type, 0);
+    PyVector *vec = vector_freelist_pop(type);
 
+    if (vec != NULL)
+        return (PyObject *)vec;
+    vec = (PyVector *)type->tp_alloc(type, 0);
     if (vec != NULL) {
         vec->dim = 3;
         vec->epsilon = VECTOR_EPSILON;
@@ -3589,32 +3946,1705 @@ vector_elementwise(PyVector *vec)
 }
 
 
+/*************************************************************
+ *  VectorArray: many vectors in contiguous planes
+ *************************************************************/
+
+#define VECTORARRAY_PLANE(a, d) ((a)->coords + (d) * (a)->alloc)
+
+/* dst = a * s + b * t for the n coordinates */
+static void
+_vectorarray_lincomb(double *dst, const double *a, double s,
+                     const double *b, double t, Py_ssize_t n)
+{
+    Py_ssize_t i = 0;
+#ifdef MATH_SSE2
+    const __m128d vs = _mm_set1_pd(s), vt = _mm_set1_pd(t);
+
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(dst + i,
+                      _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + i), vs),
+                                 _mm_mul_pd(_mm_loadu_pd(b + i), vt)));
+#endif
+    for (; i < n; ++i)
+        dst[i] = a[i] * s + b[i] * t;
+}
+
+/* dst = a * s + c for the n coordinates, without adding a zero c so
+ * negative zeros stay as plain scaling leaves them */
+static void
+_vectorarray_affine(double *dst, const double *a, double s, double c,
+                    Py_ssize_t n)
+{
+    Py_ssize_t i = 0;
+#ifdef MATH_SSE2
+    const __m128d vs = _mm_set1_pd(s), vc = _mm_set1_pd(c);
+
+    if (c == 0) {
+        for (; i + 2 <= n; i += 2)
+            _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(a + i), vs));
+    }
+    else {
+        for (; i + 2 <= n; i += 2)
+            _mm_storeu_pd(dst + i, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a + i),
+                                                         vs), vc));
+    }
+#endif
+    if (c == 0) {
+        for (; i < n; ++i)
+            dst[i] = a[i] * s;
+    }
+    else {
+        for (; i < n; ++i)
+            dst[i] = a[i] * s + c;
+    }
+}
+
+/* Multiply the n vectors in the planes of src by the dim by dim matrix m,
+ * stored by rows, into the planes of dst, which may be those of src. The
+ * sums run in the same order as the single vector helpers'. */
+static void
+_vectorarray_transform(double **dst, double **src, const double *m,
+                       int dim, Py_ssize_t n)
+{
+    Py_ssize_t i = 0;
+    double x, y, z;
+
+    if (dim == 2) {
+#ifdef MATH_SSE2
+        const __m128d m0 = _mm_set1_pd(m[0]), m1 = _mm_set1_pd(m[1]);
+        const __m128d m2 = _mm_set1_pd(m[2]), m3 = _mm_set1_pd(m[3]);
+        __m128d vx, vy;
+
+        for (; i + 2 <= n; i += 2) {
+            vx = _mm_loadu_pd(src[0] + i);
+            vy = _mm_loadu_pd(src[1] + i);
+            _mm_storeu_pd(dst[0] + i, _mm_add_pd(_mm_mul_pd(m0, vx),
+                                                 _mm_mul_pd(m1, vy)));
+            _mm_storeu_pd(dst[1] + i, _mm_add_pd(_mm_mul_pd(m2, vx),
+                                                 _mm_mul_pd(m3, vy)));
+        }
+#endif
+        for (; i < n; ++i) {
+            x = src[0][i];
+            y = src[1][i];
+            dst[0][i] = m[0] * x + m[1] * y;
+            dst[1][i] = m[2] * x + m[3] * y;
+        }
+        return;
+    }
+
+#ifdef MATH_SSE2
+    {
+        __m128d vm[9], vx, vy, vz;
+        int k;
+
+        for (k = 0; k < 9; ++k)
+            vm[k] = _mm_set1_pd(m[k]);
+        for (; i + 2 <= n; i += 2) {
+            vx = _mm_loadu_pd(src[0] + i);
+            vy = _mm_loadu_pd(src[1] + i);
+            vz = _mm_loadu_pd(src[2] + i);
+            for (k = 0; k < 3; ++k)
+                _mm_storeu_pd(dst[k] + i,
+                              _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vm[3 * k]),
+                                                    _mm_mul_pd(vy, vm[3 * k + 1])),
+                                         _mm_mul_pd(vz, vm[3 * k + 2])));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        x = src[0][i];
+        y = src[1][i];
+        z = src[2][i];
+        dst[0][i] = x * m[0] + y * m[1] + z * m[2];
+        dst[1][i] = x * m[3] + y * m[4] + z * m[5];
+        dst[2][i] = x * m[6] + y * m[7] + z * m[8];
+    }
+}
 
+/* The squared length of vector i of the planes */
+#define VECTORARRAY_LENGTH2(planes, dim, i)                       \
+    ((dim) == 2 ?                                                 \
+     (planes)[0][i] * (planes)[0][i] + (planes)[1][i] * (planes)[1][i] : \
+     (planes)[0][i] * (planes)[0][i] + (planes)[1][i] * (planes)[1][i] + \
+     (planes)[2][i] * (planes)[2][i])
 
+/* Put the (squared) lengths of the n vectors of the planes in out */
+static void
+_vectorarray_lengths(double *out, double **planes, int dim, Py_ssize_t n,
+                     int squared)
+{
+    Py_ssize_t i = 0;
+#ifdef MATH_SSE2
+    __m128d v, c;
+    int k;
+
+    for (; i + 2 <= n; i += 2) {
+        c = _mm_loadu_pd(planes[0] + i);
+        v = _mm_mul_pd(c, c);
+        for (k = 1; k < dim; ++k) {
+            c = _mm_loadu_pd(planes[k] + i);
+            v = _mm_add_pd(v, _mm_mul_pd(c, c));
+        }
+        _mm_storeu_pd(out + i, squared ? v : _mm_sqrt_pd(v));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = VECTORARRAY_LENGTH2(planes, dim, i);
+        if (!squared)
+            out[i] = sqrt(out[i]);
+    }
+}
 
+/* Normalize the n vectors of src into dst, which may be src. Fails if
+ * any has length zero, before anything is written. */
+static int
+_vectorarray_normalize(double **dst, double **src, int dim, Py_ssize_t n)
+{
+    Py_ssize_t i;
+    double length;
+    int k;
 
+    for (i = 0; i < n; ++i) {
+        if (VECTORARRAY_LENGTH2(src, dim, i) == 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Can't normalize Vector of length Zero");
+            return 0;
+        }
+    }
+    i = 0;
+#ifdef MATH_SSE2
+    {
+        __m128d v, c;
+
+        for (; i + 2 <= n; i += 2) {
+            c = _mm_loadu_pd(src[0] + i);
+            v = _mm_mul_pd(c, c);
+            for (k = 1; k < dim; ++k) {
+                c = _mm_loadu_pd(src[k] + i);
+                v = _mm_add_pd(v, _mm_mul_pd(c, c));
+            }
+            v = _mm_sqrt_pd(v);
+            for (k = 0; k < dim; ++k)
+                _mm_storeu_pd(dst[k] + i,
+                              _mm_div_pd(_mm_loadu_pd(src[k] + i), v));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        length = sqrt(VECTORARRAY_LENGTH2(src, dim, i));
+        for (k = 0; k < dim; ++k)
+            dst[k][i] = src[k][i] / length;
+    }
+    return 1;
+}
 
-static PyObject *
-math_enable_swizzling(PyVector *self)
+static int
+_vectorarray_type_dim(PyTypeObject *type)
 {
-    swizzling_enabled = 1;
-    Py_RETURN_NONE;
+    return PyType_IsSubtype(type, &PyVector3Array_Type) ? 3 : 2;
 }
 
-static PyObject *
-math_disable_swizzling(PyVector *self)
+static void
+_vectorarray_planes(PyVectorArray *self, double **planes)
 {
-    swizzling_enabled = 0;
-    Py_RETURN_NONE;
+    unsigned int k;
+
+    for (k = 0; k < self->dim; ++k)
+        planes[k] = VECTORARRAY_PLANE(self, k);
 }
 
-static PyMethodDef _math_methods[] =
+/* Give the array room for alloc vectors, moving the planes apart */
+static int
+_vectorarray_realloc(PyVectorArray *self, Py_ssize_t alloc)
 {
-    {"enable_swizzling", (PyCFunction)math_enable_swizzling, METH_NOARGS,
-     "enables swizzling."
-    },
-    {"disable_swizzling", (PyCFunction)math_disable_swizzling, METH_NOARGS,
-     "disables swizzling."
+    double *coords;
+    unsigned int k;
+
+    if (self->exports) {
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot resize a VectorArray with exported buffers");
+        return 0;
+    }
+    if (alloc < 1)
+        alloc = 1;
+    if (alloc > PY_SSIZE_T_MAX / (Py_ssize_t)(sizeof(double) * self->dim)) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    coords = PyMem_New(double, alloc * self->dim);
+    if (coords == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    for (k = 0; k < self->dim; ++k)
+        memcpy(coords + k * alloc, VECTORARRAY_PLANE(self, k),
+               sizeof(double) * self->len);
+    PyMem_Del(self->coords);
+    self->coords = coords;
+    self->alloc = alloc;
+    return 1;
+}
+
+static PyVectorArray *
+_vectorarray_new_len(PyTypeObject *type, Py_ssize_t len)
+{
+    PyVectorArray *self = (PyVectorArray *)type->tp_alloc(type, 0);
+
+    if (self == NULL)
+        return NULL;
+    self->dim = _vectorarray_type_dim(type);
+    self->epsilon = VECTOR_EPSILON;
+    self->coords = NULL;
+    self->len = 0;
+    self->alloc = 0;
+    self->exports = 0;
+    if (!_vectorarray_realloc(self, len)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    memset(self->coords, 0, sizeof(double) * self->alloc * self->dim);
+    self->len = len;
+    return self;
+}
+
+/* Store the vector compatible obj as vector i */
+static int
+_vectorarray_set(PyVectorArray *self, Py_ssize_t i, PyObject *obj)
+{
+    double coords[VECTOR_MAX_SIZE];
+    unsigned int k;
+
+    if (!PyVectorCompatible_Check(obj, self->dim) ||
+        !PySequence_AsVectorCoords(obj, coords, self->dim)) {
+        if (!PyErr_Occurred() || PyErr_ExceptionMatches(PyExc_ValueError)) {
+            PyErr_Clear();
+            PyErr_Format(PyExc_TypeError, "expected a %dD vector",
+                         self->dim);
+        }
+        return 0;
+    }
+    for (k = 0; k < self->dim; ++k)
+        VECTORARRAY_PLANE(self, k)[i] = coords[k];
+    return 1;
+}
+
+static PyObject *
+vectorarray_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyVectorArray *self;
+    PyObject *obj = NULL, *seq;
+    Py_ssize_t n, i;
+    unsigned int k;
+    static char *kwlist[] = {"vectors", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &obj))
+        return NULL;
+    if (obj == NULL)
+        return (PyObject *)_vectorarray_new_len(type, 0);
+
+    if (PyInt_Check(obj) || PyLong_Check(obj)) {
+        n = PyInt_AsSsize_t(obj);
+        if (n < 0) {
+            if (!PyErr_Occurred())
+                PyErr_SetString(PyExc_ValueError,
+                                "length must not be negative");
+            return NULL;
+        }
+        return (PyObject *)_vectorarray_new_len(type, n);
+    }
+
+    if (PyVectorArray_Check(obj) &&
+        ((PyVectorArray *)obj)->dim == (unsigned)_vectorarray_type_dim(type)) {
+        PyVectorArray *other = (PyVectorArray *)obj;
+
+        self = _vectorarray_new_len(type, other->len);
+        if (self == NULL)
+            return NULL;
+        for (k = 0; k < self->dim; ++k)
+            memcpy(VECTORARRAY_PLANE(self, k), VECTORARRAY_PLANE(other, k),
+                   sizeof(double) * other->len);
+        return (PyObject *)self;
+    }
+
+    seq = PySequence_Fast(obj, "Argument must be a sequence of vectors "
+                          "or a length.");
+    if (seq == NULL)
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(seq);
+    self = _vectorarray_new_len(type, n);
+    for (i = 0; self != NULL && i < n; ++i) {
+        if (!_vectorarray_set(self, i, PySequence_Fast_GET_ITEM(seq, i)))
+            Py_CLEAR(self);
+    }
+    Py_DECREF(seq);
+    return (PyObject *)self;
+}
+
+static void
+vectorarray_dealloc(PyVectorArray *self)
+{
+    PyMem_Del(self->coords);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+vectorarray_repr(PyVectorArray *self)
+{
+    char buffer[STRING_BUF_SIZE];
+
+    PyOS_snprintf(buffer, STRING_BUF_SIZE, "<Vector%dArray(%ld vectors)>",
+                  self->dim, (long)self->len);
+    return Text_FromUTF8(buffer);
+}
+
+/* A new array of the type and length of self */
+static PyVectorArray *
+_vectorarray_like(PyVectorArray *self)
+{
+    PyVectorArray *ret = _vectorarray_new_len(Py_TYPE(self), 0);
+
+    if (ret != NULL && !_vectorarray_realloc(ret, self->len))
+        Py_CLEAR(ret);
+    if (ret != NULL)
+        ret->len = self->len;
+    return ret;
+}
+
+/* An array.array('d') of the n doubles filled in by the lengths of self,
+ * without a copy in between */
+static PyObject *
+_vectorarray_length_array(PyVectorArray *self, int squared)
+{
+    PyObject *arraymodule, *bytes, *array;
+    double *planes[VECTOR_MAX_SIZE];
+
+    arraymodule = PyImport_ImportModule("array");
+    if (arraymodule == NULL)
+        return NULL;
+    bytes = Bytes_FromStringAndSize(NULL, sizeof(double) * self->len);
+    if (bytes == NULL) {
+        Py_DECREF(arraymodule);
+        return NULL;
+    }
+    _vectorarray_planes(self, planes);
+    _vectorarray_lengths((double *)Bytes_AS_STRING(bytes), planes,
+                         self->dim, self->len, squared);
+    array = PyObject_CallMethod(arraymodule, "array", "sO", "d", bytes);
+    Py_DECREF(bytes);
+    Py_DECREF(arraymodule);
+    return array;
+}
+
+static PyObject *
+vectorarray_length(PyVectorArray *self)
+{
+    return _vectorarray_length_array(self, 0);
+}
+
+static PyObject *
+vectorarray_length_squared(PyVectorArray *self)
+{
+    return _vectorarray_length_array(self, 1);
+}
+
+static PyObject *
+vectorarray_append(PyVectorArray *self, PyObject *vector)
+{
+    if (self->len == self->alloc &&
+        !_vectorarray_realloc(self, self->alloc * 2))
+        return NULL;
+    if (!_vectorarray_set(self, self->len, vector))
+        return NULL;
+    self->len++;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+vectorarray_normalize_ip(PyVectorArray *self)
+{
+    double *planes[VECTOR_MAX_SIZE];
+
+    _vectorarray_planes(self, planes);
+    if (!_vectorarray_normalize(planes, planes, self->dim, self->len))
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+vectorarray_normalize(PyVectorArray *self)
+{
+    double *planes[VECTOR_MAX_SIZE], *ret_planes[VECTOR_MAX_SIZE];
+    PyVectorArray *ret = _vectorarray_like(self);
+
+    if (ret == NULL)
+        return NULL;
+    _vectorarray_planes(self, planes);
+    _vectorarray_planes(ret, ret_planes);
+    if (!_vectorarray_normalize(ret_planes, planes, self->dim, self->len)) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return (PyObject *)ret;
+}
+
+/* Transform self by m into dst, a new array when dst is NULL */
+static PyObject *
+_vectorarray_apply(PyVectorArray *self, const double *m, PyVectorArray *dst)
+{
+    double *planes[VECTOR_MAX_SIZE], *dst_planes[VECTOR_MAX_SIZE];
+
+    if (dst == NULL) {
+        dst = _vectorarray_like(self);
+        if (dst == NULL)
+            return NULL;
+    }
+    else {
+        Py_INCREF(dst);
+    }
+    _vectorarray_planes(self, planes);
+    _vectorarray_planes(dst, dst_planes);
+    _vectorarray_transform(dst_planes, planes, m, self->dim, self->len);
+    return (PyObject *)dst;
+}
+
+/* The rotation of a Vector2 by angle as a matrix by rows, taken from the
+ * rotated unit vectors so it has all of Vector2.rotate's special cases */
+static int
+_vector2_rotation_matrix(double *m, double angle, double epsilon)
+{
+    static const double unit[2][2] = {{1, 0}, {0, 1}};
+    double column[2];
+    int i;
+
+    for (i = 0; i < 2; ++i) {
+        if (!_vector2_rotate_helper(column, unit[i], angle, epsilon))
+            return 0;
+        m[i] = column[0];
+        m[2 + i] = column[1];
+    }
+    return 1;
+}
+
+static int
+_vector3_rotation_matrix(double *m, double angle, PyObject *axis,
+                         double epsilon)
+{
+    static const double unit[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    double axis_coords[3], column[3];
+    int i;
+
+    if (!PyVectorCompatible_Check(axis, 3)) {
+        PyErr_SetString(PyExc_TypeError, "axis must be a 3D Vector");
+        return 0;
+    }
+    if (!PySequence_AsVectorCoords(axis, axis_coords, 3))
+        return 0;
+    for (i = 0; i < 3; ++i) {
+        if (!_vector3_rotate_helper(column, unit[i], axis_coords,
+                                    angle, epsilon))
+            return 0;
+        m[i] = column[0];
+        m[3 + i] = column[1];
+        m[6 + i] = column[2];
+    }
+    return 1;
+}
+
+static PyObject *
+vector2array_rotate(PyVectorArray *self, PyObject *args)
+{
+    double angle, m[4];
+
+    if (!PyArg_ParseTuple(args, "d:rotate", &angle) ||
+        !_vector2_rotation_matrix(m, angle, self->epsilon))
+        return NULL;
+    return _vectorarray_apply(self, m, NULL);
+}
+
+static PyObject *
+vector2array_rotate_ip(PyVectorArray *self, PyObject *args)
+{
+    double angle, m[4];
+    PyObject *ret;
+
+    if (!PyArg_ParseTuple(args, "d:rotate_ip", &angle) ||
+        !_vector2_rotation_matrix(m, angle, self->epsilon))
+        return NULL;
+    ret = _vectorarray_apply(self, m, self);
+    Py_XDECREF(ret);
+    if (ret == NULL)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+vector3array_rotate(PyVectorArray *self, PyObject *args)
+{
+    double angle, m[9];
+    PyObject *axis;
+
+    if (!PyArg_ParseTuple(args, "dO:rotate", &angle, &axis) ||
+        !_vector3_rotation_matrix(m, angle, axis, self->epsilon))
+        return NULL;
+    return _vectorarray_apply(self, m, NULL);
+}
+
+static PyObject *
+vector3array_rotate_ip(PyVectorArray *self, PyObject *args)
+{
+    double angle, m[9];
+    PyObject *axis, *ret;
+
+    if (!PyArg_ParseTuple(args, "dO:rotate_ip", &angle, &axis) ||
+        !_vector3_rotation_matrix(m, angle, axis, self->epsilon))
+        return NULL;
+    ret = _vectorarray_apply(self, m, self);
+    Py_XDECREF(ret);
+    if (ret == NULL)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+/* The reflection off normal as a matrix, from the reflected unit vectors */
+static int
+_vectorarray_reflection_matrix(PyVectorArray *self, double *m,
+                               PyObject *normal)
+{
+    static const double unit[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    double column[3];
+    unsigned int i, k;
+
+    for (i = 0; i < self->dim; ++i) {
+        if (!_vector_reflect_helper(column, unit[i], normal, self->dim,
+                                    self->epsilon))
+            return 0;
+        for (k = 0; k < self->dim; ++k)
+            m[k * self->dim + i] = column[k];
+    }
+    return 1;
+}
+
+static PyObject *
+vectorarray_reflect(PyVectorArray *self, PyObject *normal)
+{
+    double m[9];
+
+    if (!_vectorarray_reflection_matrix(self, m, normal))
+        return NULL;
+    return _vectorarray_apply(self, m, NULL);
+}
+
+static PyObject *
+vectorarray_reflect_ip(PyVectorArray *self, PyObject *normal)
+{
+    double m[9];
+    PyObject *ret;
+
+    if (!_vectorarray_reflection_matrix(self, m, normal))
+        return NULL;
+    ret = _vectorarray_apply(self, m, self);
+    Py_XDECREF(ret);
+    if (ret == NULL)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+/* Read the other operand of a bulk operation: another array like self,
+ * whose planes go in planes, or a single vector, which goes in coords.
+ * Returns 1 or 2 for those, 0 with no error set for anything else, and
+ * -1 with an error set for an array of the wrong length. */
+static int
+_vectorarray_operand(PyVectorArray *self, PyObject *other, double **planes,
+                     double *coords)
+{
+    if (PyVectorArray_Check(other) &&
+        ((PyVectorArray *)other)->dim == self->dim) {
+        if (((PyVectorArray *)other)->len != self->len) {
+            PyErr_SetString(PyExc_ValueError,
+                            "VectorArrays must have the same length");
+            return -1;
+        }
+        _vectorarray_planes((PyVectorArray *)other, planes);
+        return 1;
+    }
+    if (PyVectorCompatible_Check(other, self->dim) &&
+        PySequence_AsVectorCoords(other, coords, self->dim))
+        return 2;
+    PyErr_Clear();
+    return 0;
+}
+
+/* self * (1 - t) + other * t for each coordinate into dst */
+static PyObject *
+_vectorarray_lerp(PyVectorArray *self, PyObject *args, PyVectorArray *dst)
+{
+    PyObject *other;
+    double t, coords[VECTOR_MAX_SIZE];
+    double *planes[VECTOR_MAX_SIZE], *other_planes[VECTOR_MAX_SIZE];
+    double *dst_planes[VECTOR_MAX_SIZE];
+    unsigned int k;
+    int kind;
+
+    if (!PyArg_ParseTuple(args, "Od:VectorArray.lerp", &other, &t))
+        return NULL;
+    kind = _vectorarray_operand(self, other, other_planes, coords);
+    if (kind < 0)
+        return NULL;
+    if (kind == 0) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Expected VectorArray or Vector as argument 1");
+        return NULL;
+    }
+    if (t < 0 || t > 1) {
+        PyErr_SetString(PyExc_ValueError, "Argument 2 must be in range [0, 1]");
+        return NULL;
+    }
+    if (dst == NULL) {
+        dst = _vectorarray_like(self);
+        if (dst == NULL)
+            return NULL;
+    }
+    else {
+        Py_INCREF(dst);
+    }
+    _vectorarray_planes(self, planes);
+    _vectorarray_planes(dst, dst_planes);
+    for (k = 0; k < self->dim; ++k) {
+        if (kind == 1)
+            _vectorarray_lincomb(dst_planes[k], planes[k], 1 - t,
+                                 other_planes[k], t, self->len);
+        else
+            _vectorarray_affine(dst_planes[k], planes[k], 1 - t,
+                                coords[k] * t, self->len);
+    }
+    return (PyObject *)dst;
+}
+
+static PyObject *
+vectorarray_lerp(PyVectorArray *self, PyObject *args)
+{
+    return _vectorarray_lerp(self, args, NULL);
+}
+
+static PyObject *
+vectorarray_lerp_ip(PyVectorArray *self, PyObject *args)
+{
+    PyObject *ret = _vectorarray_lerp(self, args, self);
+
+    Py_XDECREF(ret);
+    if (ret == NULL)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+/* +, - and * of an array with another array, a vector or, for *, a
+ * number. The in place forms write into the array itself. */
+static PyObject *
+vectorarray_generic_math(PyObject *o1, PyObject *o2, int op)
+{
+    PyVectorArray *self, *dst;
+    PyObject *other;
+    double coords[VECTOR_MAX_SIZE], scalar = 0;
+    double *planes[VECTOR_MAX_SIZE], *other_planes[VECTOR_MAX_SIZE];
+    double *dst_planes[VECTOR_MAX_SIZE];
+    unsigned int k;
+    int kind;
+
+    if (PyVectorArray_Check(o1)) {
+        self = (PyVectorArray *)o1;
+        other = o2;
+    }
+    else {
+        self = (PyVectorArray *)o2;
+        other = o1;
+        op |= OP_ARG_REVERSE;
+    }
+
+    if ((op & ~(OP_INPLACE | OP_ARG_REVERSE)) == OP_MUL) {
+        if (!RealNumber_Check(other)) {
+            Py_INCREF(Py_NotImplemented);
+            return Py_NotImplemented;
+        }
+        scalar = PyFloat_AsDouble(other);
+        if (scalar == -1 && PyErr_Occurred())
+            return NULL;
+        kind = 3;
+    }
+    else {
+        kind = _vectorarray_operand(self, other, other_planes, coords);
+        if (kind < 0)
+            return NULL;
+        if (kind == 0) {
+            Py_INCREF(Py_NotImplemented);
+            return Py_NotImplemented;
+        }
+    }
+
+    if (op & OP_INPLACE) {
+        dst = self;
+        Py_INCREF(dst);
+    }
+    else {
+        dst = _vectorarray_like(self);
+        if (dst == NULL)
+            return NULL;
+    }
+    _vectorarray_planes(self, planes);
+    _vectorarray_planes(dst, dst_planes);
+
+    for (k = 0; k < self->dim; ++k) {
+        switch (op & ~OP_INPLACE) {
+        case OP_ADD:
+        case OP_ADD | OP_ARG_REVERSE:
+            if (kind == 1)
+                _vectorarray_lincomb(dst_planes[k], planes[k], 1,
+                                     other_planes[k], 1, self->len);
+            else
+                _vectorarray_affine(dst_planes[k], planes[k], 1, coords[k],
+                                    self->len);
+            break;
+        case OP_SUB:
+            if (kind == 1)
+                _vectorarray_lincomb(dst_planes[k], planes[k], 1,
+                                     other_planes[k], -1, self->len);
+            else
+                _vectorarray_affine(dst_planes[k], planes[k], 1, -coords[k],
+                                    self->len);
+            break;
+        case OP_SUB | OP_ARG_REVERSE:
+            /* a vector minus the array */
+            _vectorarray_affine(dst_planes[k], planes[k], -1, coords[k],
+                                self->len);
+            break;
+        default:
+            _vectorarray_affine(dst_planes[k], planes[k], scalar, 0,
+                                self->len);
+            break;
+        }
+    }
+    return (PyObject *)dst;
+}
+
+static PyObject *
+vectorarray_add(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_ADD);
+}
+
+static PyObject *
+vectorarray_sub(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_SUB);
+}
+
+static PyObject *
+vectorarray_mul(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_MUL);
+}
+
+static PyObject *
+vectorarray_inplace_add(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_ADD | OP_INPLACE);
+}
+
+static PyObject *
+vectorarray_inplace_sub(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_SUB | OP_INPLACE);
+}
+
+static PyObject *
+vectorarray_inplace_mul(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_MUL | OP_INPLACE);
+}
+
+static PyObject *
+vectorarray_neg(PyVectorArray *self)
+{
+    double *planes[VECTOR_MAX_SIZE], *dst_planes[VECTOR_MAX_SIZE];
+    PyVectorArray *ret = _vectorarray_like(self);
+    unsigned int k;
+
+    if (ret == NULL)
+        return NULL;
+    _vectorarray_planes(self, planes);
+    _vectorarray_planes(ret, dst_planes);
+    for (k = 0; k < self->dim; ++k)
+        _vectorarray_affine(dst_planes[k], planes[k], -1, 0, self->len);
+    return (PyObject *)ret;
+}
+
+static PyNumberMethods vectorarray_as_number = {
+    (binaryfunc)vectorarray_add,    /* nb_add;       __add__ */
+    (binaryfunc)vectorarray_sub,    /* nb_subtract;  __sub__ */
+    (binaryfunc)vectorarray_mul,    /* nb_multiply;  __mul__ */
+#if !PY3
+    (binaryfunc)0,                  /* nb_divide;    __div__ */
+#endif
+    (binaryfunc)0,                  /* nb_remainder; __mod__ */
+    (binaryfunc)0,                  /* nb_divmod;    __divmod__ */
+    (ternaryfunc)0,                 /* nb_power;     __pow__ */
+    (unaryfunc)vectorarray_neg,     /* nb_negative;  __neg__ */
+    (unaryfunc)0,                   /* nb_positive;  __pos__ */
+    (unaryfunc)0,                   /* nb_absolute;  __abs__ */
+    (inquiry)0,                     /* nb_nonzero;   __nonzero__ */
+    (unaryfunc)0,                   /* nb_invert;    __invert__ */
+    (binaryfunc)0,                  /* nb_lshift;    __lshift__ */
+    (binaryfunc)0,                  /* nb_rshift;    __rshift__ */
+    (binaryfunc)0,                  /* nb_and;       __and__ */
+    (binaryfunc)0,                  /* nb_xor;       __xor__ */
+    (binaryfunc)0,                  /* nb_or;        __or__ */
+#if !PY3
+    (coercion)0,                    /* nb_coerce;    __coerce__ */
+#endif
+    (unaryfunc)0,                   /* nb_int;       __int__ */
+    (unaryfunc)0,                   /* nb_long;      __long__ */
+    (unaryfunc)0,                   /* nb_float;     __float__ */
+#if !PY3
+    (unaryfunc)0,                   /* nb_oct;       __oct__ */
+    (unaryfunc)0,                   /* nb_hex;       __hex__ */
+#endif
+    (binaryfunc)vectorarray_inplace_add, /* nb_inplace_add;  __iadd__ */
+    (binaryfunc)vectorarray_inplace_sub, /* nb_inplace_subtract; __isub__ */
+    (binaryfunc)vectorarray_inplace_mul, /* nb_inplace_multiply; __imul__ */
+};
+
+static Py_ssize_t
+vectorarray_len(PyVectorArray *self)
+{
+    return self->len;
+}
+
+static PyObject *
+vectorarray_GetItem(PyVectorArray *self, Py_ssize_t index)
+{
+    PyVector *ret;
+    unsigned int k;
+
+    if (index < 0 || index >= self->len) {
+        PyErr_SetString(PyExc_IndexError, "subscript out of range.");
+        return NULL;
+    }
+    ret = (PyVector *)PyVector_NEW(self->dim);
+    if (ret == NULL)
+        return NULL;
+    for (k = 0; k < self->dim; ++k)
+        ret->coords[k] = VECTORARRAY_PLANE(self, k)[index];
+    return (PyObject *)ret;
+}
+
+static int
+vectorarray_SetItem(PyVectorArray *self, Py_ssize_t index, PyObject *value)
+{
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError,
+                        "vectors can't be deleted from a VectorArray");
+        return -1;
+    }
+    if (index < 0 || index >= self->len) {
+        PyErr_SetString(PyExc_IndexError, "subscript out of range.");
+        return -1;
+    }
+    return _vectorarray_set(self, index, value) ? 0 : -1;
+}
+
+static PySequenceMethods vectorarray_as_sequence = {
+    (lenfunc)vectorarray_len,             /* sq_length;    __len__ */
+    (binaryfunc)0,                        /* sq_concat;    __add__ */
+    (ssizeargfunc)0,                      /* sq_repeat;    __mul__ */
+    (ssizeargfunc)vectorarray_GetItem,    /* sq_item;      __getitem__ */
+    0,                                    /* sq_slice;     __getslice__ */
+    (ssizeobjargproc)vectorarray_SetItem, /* sq_ass_item;  __setitem__ */
+    0,                                    /* sq_ass_slice; __setslice__ */
+};
+
+#if PG_ENABLE_NEWBUF
+/* The buffer is the planes as a writable dim by len array of doubles.
+ * The planes are packed together first, so it is C contiguous. */
+static int
+vectorarray_getbuffer(PyVectorArray *self, Py_buffer *view, int flags)
+{
+    static char format[] = "d";
+
+    if (!self->exports && self->alloc > self->len &&
+        !_vectorarray_realloc(self, self->len)) {
+        return -1;
+    }
+    view->buf = self->coords;
+    view->len = sizeof(double) * self->dim * self->len;
+    view->itemsize = sizeof(double);
+    view->readonly = 0;
+    self->shape[0] = self->dim;
+    self->shape[1] = self->len;
+    self->strides[0] = sizeof(double) * self->alloc;
+    self->strides[1] = sizeof(double);
+    if (PyBUF_HAS_FLAG(flags, PyBUF_ND)) {
+        view->ndim = 2;
+        view->shape = self->shape;
+    }
+    else {
+        view->ndim = 1;
+        view->shape = 0;
+    }
+    view->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? format : 0;
+    view->strides = PyBUF_HAS_FLAG(flags, PyBUF_STRIDES) ? self->strides : 0;
+    view->suboffsets = 0;
+    view->internal = 0;
+    Py_INCREF(self);
+    view->obj = (PyObject *)self;
+    self->exports++;
+    return 0;
+}
+
+static void
+vectorarray_releasebuffer(PyVectorArray *self, Py_buffer *view)
+{
+    self->exports--;
+}
+
+static PyBufferProcs vectorarray_as_buffer = {
+#if HAVE_OLD_BUFPROTO
+    0,
+    0,
+    0,
+    0,
+#endif
+    (getbufferproc)vectorarray_getbuffer,
+    (releasebufferproc)vectorarray_releasebuffer
+};
+#endif
+
+#if PY2 && PG_ENABLE_NEWBUF
+#define VECTORARRAY_TPFLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | \
+                             Py_TPFLAGS_CHECKTYPES | Py_TPFLAGS_HAVE_NEWBUFFER)
+#elif PY2
+#define VECTORARRAY_TPFLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | \
+                             Py_TPFLAGS_CHECKTYPES)
+#else
+#define VECTORARRAY_TPFLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE)
+#endif
+
+static PyMethodDef vector2array_methods[] = {
+    {"append", (PyCFunction)vectorarray_append, METH_O,
+     DOC_VECTOR2ARRAYAPPEND
+    },
+    {"length", (PyCFunction)vectorarray_length, METH_NOARGS,
+     DOC_VECTOR2ARRAYLENGTH
+    },
+    {"length_squared", (PyCFunction)vectorarray_length_squared, METH_NOARGS,
+     DOC_VECTOR2ARRAYLENGTHSQUARED
+    },
+    {"normalize", (PyCFunction)vectorarray_normalize, METH_NOARGS,
+     DOC_VECTOR2ARRAYNORMALIZE
+    },
+    {"normalize_ip", (PyCFunction)vectorarray_normalize_ip, METH_NOARGS,
+     DOC_VECTOR2ARRAYNORMALIZEIP
+    },
+    {"rotate", (PyCFunction)vector2array_rotate, METH_VARARGS,
+     DOC_VECTOR2ARRAYROTATE
+    },
+    {"rotate_ip", (PyCFunction)vector2array_rotate_ip, METH_VARARGS,
+     DOC_VECTOR2ARRAYROTATEIP
+    },
+    {"lerp", (PyCFunction)vectorarray_lerp, METH_VARARGS,
+     DOC_VECTOR2ARRAYLERP
+    },
+    {"lerp_ip", (PyCFunction)vectorarray_lerp_ip, METH_VARARGS,
+     DOC_VECTOR2ARRAYLERPIP
+    },
+    {"reflect", (PyCFunction)vectorarray_reflect, METH_O,
+     DOC_VECTOR2ARRAYREFLECT
+    },
+    {"reflect_ip", (PyCFunction)vectorarray_reflect_ip, METH_O,
+     DOC_VECTOR2ARRAYREFLECTIP
+    },
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef vector3array_methods[] = {
+    {"append", (PyCFunction)vectorarray_append, METH_O,
+     DOC_VECTOR3ARRAYAPPEND
+    },
+    {"length", (PyCFunction)vectorarray_length, METH_NOARGS,
+     DOC_VECTOR3ARRAYLENGTH
+    },
+    {"length_squared", (PyCFunction)vectorarray_length_squared, METH_NOARGS,
+     DOC_VECTOR3ARRAYLENGTHSQUARED
+    },
+    {"normalize", (PyCFunction)vectorarray_normalize, METH_NOARGS,
+     DOC_VECTOR3ARRAYNORMALIZE
+    },
+    {"normalize_ip", (PyCFunction)vectorarray_normalize_ip, METH_NOARGS,
+     DOC_VECTOR3ARRAYNORMALIZEIP
+    },
+    {"rotate", (PyCFunction)vector3array_rotate, METH_VARARGS,
+     DOC_VECTOR3ARRAYROTATE
+    },
+    {"rotate_ip", (PyCFunction)vector3array_rotate_ip, METH_VARARGS,
+     DOC_VECTOR3ARRAYROTATEIP
+    },
+    {"lerp", (PyCFunction)vectorarray_lerp, METH_VARARGS,
+     DOC_VECTOR3ARRAYLERP
+    },
+    {"lerp_ip", (PyCFunction)vectorarray_lerp_ip, METH_VARARGS,
+     DOC_VECTOR3ARRAYLERPIP
+    },
+    {"reflect", (PyCFunction)vectorarray_reflect, METH_O,
+     DOC_VECTOR3ARRAYREFLECT
+    },
+    {"reflect_ip", (PyCFunction)vectorarray_reflect_ip, METH_O,
+     DOC_VECTOR3ARRAYREFLECTIP
+    },
+    {NULL}  /* Sentinel */
+};
+
+static PyTypeObject PyVector2Array_Type = {
+    TYPE_HEAD(NULL, 0)
+    "pygame.math.Vector2Array", /* tp_name */
+    sizeof(PyVectorArray),     /* tp_basicsize */
+    0,                         /* tp_itemsize */
+    /* Methods to implement standard operations */
+    (destructor)vectorarray_dealloc, /* tp_dealloc */
+    0,                         /* tp_print */
+    0,                         /* tp_getattr */
+    0,                         /* tp_setattr */
+    0,                         /* tp_compare */
+    (reprfunc)vectorarray_repr, /* tp_repr */
+    /* Method suites for standard classes */
+    &vectorarray_as_number,    /* tp_as_number */
+    &vectorarray_as_sequence,  /* tp_as_sequence */
+    0,                         /* tp_as_mapping */
+    /* More standard operations (here for binary compatibility) */
+    0,                         /* tp_hash */
+    0,                         /* tp_call */
+    0,                         /* tp_str */
+    0,                         /* tp_getattro */
+    0,                         /* tp_setattro */
+    /* Functions to access object as input/output buffer */
+#if PG_ENABLE_NEWBUF
+    &vectorarray_as_buffer,    /* tp_as_buffer */
+#else
+    0,                         /* tp_as_buffer */
+#endif
+    /* Flags to define presence of optional/expanded features */
+    VECTORARRAY_TPFLAGS,       /* tp_flags */
+    /* Documentation string */
+    DOC_PYGAMEMATHVECTOR2ARRAY, /* tp_doc */
+
+    /* Assigned meaning in release 2.0 */
+    /* call function for all accessible objects */
+    0,                         /* tp_traverse */
+    /* delete references to contained objects */
+    0,                         /* tp_clear */
+
+    /* Assigned meaning in release 2.1 */
+    /* rich comparisons */
+    0,                         /* tp_richcompare */
+    /* weak reference enabler */
+    0,                         /* tp_weaklistoffset */
+
+    /* Added in release 2.2 */
+    /* Iterators */
+    0,                         /* tp_iter */
+    0,                         /* tp_iternext */
+    /* Attribute descriptor and subclassing stuff */
+    vector2array_methods,      /* tp_methods */
+    0,                         /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    (newfunc)vectorarray_new,  /* tp_new */
+};
+
+static PyTypeObject PyVector3Array_Type = {
+    TYPE_HEAD(NULL, 0)
+    "pygame.math.Vector3Array", /* tp_name */
+    sizeof(PyVectorArray),     /* tp_basicsize */
+    0,                         /* tp_itemsize */
+    /* Methods to implement standard operations */
+    (destructor)vectorarray_dealloc, /* tp_dealloc */
+    0,                         /* tp_print */
+    0,                         /* tp_getattr */
+    0,                         /* tp_setattr */
+    0,                         /* tp_compare */
+    (reprfunc)vectorarray_repr, /* tp_repr */
+    /* Method suites for standard classes */
+    &vectorarray_as_number,    /* tp_as_number */
+    &vectorarray_as_sequence,  /* tp_as_sequence */
+    0,                         /* tp_as_mapping */
+    /* More standard operations (here for binary compatibility) */
+    0,                         /* tp_hash */
+    0,                         /* tp_call */
+    0,                         /* tp_str */
+    0,                         /* tp_getattro */
+    0,                         /* tp_setattro */
+    /* Functions to access object as input/output buffer */
+#if PG_ENABLE_NEWBUF
+    &vectorarray_as_buffer,    /* tp_as_buffer */
+#else
+    0,                         /* tp_as_buffer */
+#endif
+    /* Flags to define presence of optional/expanded features */
+    VECTORARRAY_TPFLAGS,       /* tp_flags */
+    /* Documentation string */
+    DOC_PYGAMEMATHVECTOR3ARRAY, /* tp_doc */
+
+    /* Assigned meaning in release 2.0 */
+    /* call function for all accessible objects */
+    0,                         /* tp_traverse */
+    /* delete references to contained objects */
+    0,                         /* tp_clear */
+
+    /* Assigned meaning in release 2.1 */
+    /* rich comparisons */
+    0,                         /* tp_richcompare */
+    /* weak reference enabler */
+    0,                         /* tp_weaklistoffset */
+
+    /* Added in release 2.2 */
+    /* Iterators */
+    0,                         /* tp_iter */
+    0,                         /* tp_iternext */
+    /* Attribute descriptor and subclassing stuff */
+    vector3array_methods,      /* tp_methods */
+    0,                         /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    (newfunc)vectorarray_new,  /* tp_new */
+};
+
+
+/*************************************************************
+ *  Rotation: a rotation with its trigonometry done once
+ *************************************************************/
+
+/* Interleaved coordinates, dim per point, as a buffer may hold them */
+static void
+_rotation_apply_interleaved_d(double *coords, Py_ssize_t n, const double *m,
+                              int dim)
+{
+    Py_ssize_t i = 0;
+    double x, y, z;
+
+    if (dim == 2) {
+#ifdef MATH_SSE2
+        /* (x, y) -> (m0 x + m1 y, m2 x + m3 y) as one pair */
+        const __m128d cols0 = _mm_set_pd(m[2], m[0]);
+        const __m128d cols1 = _mm_set_pd(m[3], m[1]);
+        __m128d p;
+
+        for (; i < n; ++i) {
+            p = _mm_loadu_pd(coords + 2 * i);
+            _mm_storeu_pd(coords + 2 * i,
+                          _mm_add_pd(_mm_mul_pd(cols0,
+                                                _mm_unpacklo_pd(p, p)),
+                                     _mm_mul_pd(cols1,
+                                                _mm_unpackhi_pd(p, p))));
+        }
+#endif
+        for (; i < n; ++i) {
+            x = coords[2 * i];
+            y = coords[2 * i + 1];
+            coords[2 * i] = m[0] * x + m[1] * y;
+            coords[2 * i + 1] = m[2] * x + m[3] * y;
+        }
+        return;
+    }
+    for (; i < n; ++i, coords += 3) {
+        x = coords[0];
+        y = coords[1];
+        z = coords[2];
+        coords[0] = x * m[0] + y * m[1] + z * m[2];
+        coords[1] = x * m[3] + y * m[4] + z * m[5];
+        coords[2] = x * m[6] + y * m[7] + z * m[8];
+    }
+}
+
+static void
+_rotation_apply_interleaved_f(float *coords, Py_ssize_t n, const double *m,
+                              int dim)
+{
+    Py_ssize_t i;
+    double x, y, z;
+
+    if (dim == 2) {
+        for (i = 0; i < n; ++i, coords += 2) {
+            x = coords[0];
+            y = coords[1];
+            coords[0] = (float)(m[0] * x + m[1] * y);
+            coords[1] = (float)(m[2] * x + m[3] * y);
+        }
+        return;
+    }
+    for (i = 0; i < n; ++i, coords += 3) {
+        x = coords[0];
+        y = coords[1];
+        z = coords[2];
+        coords[0] = (float)(x * m[0] + y * m[1] + z * m[2]);
+        coords[1] = (float)(x * m[3] + y * m[4] + z * m[5]);
+        coords[2] = (float)(x * m[6] + y * m[7] + z * m[8]);
+    }
+}
+
+static PyObject *
+rotation_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyRotation *self;
+    PyObject *axis = NULL;
+    double angle;
+    int radians = 0;
+    static char *kwlist2[] = {"angle", "radians", NULL};
+    static char *kwlist3[] = {"angle", "axis", "radians", NULL};
+
+    if (PyType_IsSubtype(type, &PyRotation3_Type)) {
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "dO|i:Rotation3",
+                                         kwlist3, &angle, &axis, &radians))
+            return NULL;
+    }
+    else if (!PyArg_ParseTupleAndKeywords(args, kwds, "d|i:Rotation2",
+                                          kwlist2, &angle, &radians))
+        return NULL;
+
+    self = (PyRotation *)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+    if (axis == NULL) {
+        self->dim = 2;
+        if (radians) {
+            /* straight from the radians, as Vector2.rotate_rad */
+            self->angle = RAD2DEG(angle);
+            self->matrix[0] = self->matrix[3] = cos(angle);
+            self->matrix[2] = sin(angle);
+            self->matrix[1] = -self->matrix[2];
+        }
+        else {
+            self->angle = angle;
+            if (!_vector2_rotation_matrix(self->matrix, angle,
+                                          VECTOR_EPSILON)) {
+                Py_DECREF(self);
+                return NULL;
+            }
+        }
+        return (PyObject *)self;
+    }
+
+    self->dim = 3;
+    self->angle = radians ? RAD2DEG(angle) : angle;
+    if (!PyVectorCompatible_Check(axis, 3) ||
+        !PySequence_AsVectorCoords(axis, self->axis, 3)) {
+        PyErr_SetString(PyExc_TypeError, "axis must be a 3D Vector");
+        Py_DECREF(self);
+        return NULL;
+    }
+    if (!_vector3_rotation_matrix(self->matrix, self->angle, axis,
+                                  VECTOR_EPSILON)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static void
+rotation_dealloc(PyRotation *self)
+{
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+rotation_repr(PyRotation *self)
+{
+    char buffer[STRING_BUF_SIZE];
+
+    if (self->dim == 2)
+        PyOS_snprintf(buffer, STRING_BUF_SIZE, "<Rotation2(%g)>",
+                      self->angle);
+    else
+        PyOS_snprintf(buffer, STRING_BUF_SIZE, "<Rotation3(%g, (%g, %g, %g))>",
+                      self->angle, self->axis[0], self->axis[1],
+                      self->axis[2]);
+    return Text_FromUTF8(buffer);
+}
+
+/* Rotate the coordinates of one vector, which may be the same */
+static void
+_rotation_apply_vector(PyRotation *self, double *dst, double *src)
+{
+    double *src_planes[3], *dst_planes[3];
+    unsigned int k;
+
+    for (k = 0; k < self->dim; ++k) {
+        src_planes[k] = src + k;
+        dst_planes[k] = dst + k;
+    }
+    _vectorarray_transform(dst_planes, src_planes, self->matrix,
+                           self->dim, 1);
+}
+
+#if PG_ENABLE_NEWBUF
+/* Rotate the points of a writable buffer of doubles or floats in place */
+static int
+_rotation_apply_buffer(PyRotation *self, PyObject *obj)
+{
+    Py_buffer view;
+    const char *format;
+    Py_ssize_t n;
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_WRITABLE | PyBUF_FORMAT |
+                           PyBUF_C_CONTIGUOUS) < 0)
+        return 0;
+    format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=')
+        ++format;
+    if (!((*format == 'd' && view.itemsize == sizeof(double)) ||
+          (*format == 'f' && view.itemsize == sizeof(float))) ||
+        format[1] != '\0') {
+        PyErr_SetString(PyExc_TypeError,
+                        "the buffer must hold doubles or floats");
+        PyBuffer_Release(&view);
+        return 0;
+    }
+    n = view.len / view.itemsize;
+    if (n % self->dim) {
+        PyErr_Format(PyExc_ValueError,
+                     "the buffer must hold a multiple of %d coordinates",
+                     self->dim);
+        PyBuffer_Release(&view);
+        return 0;
+    }
+    if (*format == 'd')
+        _rotation_apply_interleaved_d((double *)view.buf, n / self->dim,
+                                      self->matrix, self->dim);
+    else
+        _rotation_apply_interleaved_f((float *)view.buf, n / self->dim,
+                                      self->matrix, self->dim);
+    PyBuffer_Release(&view);
+    return 1;
+}
+#endif
+
+static PyObject *
+rotation_apply(PyRotation *self, PyObject *obj)
+{
+    PyVector *ret;
+    double coords[3];
+
+    if (PyVectorArray_Check(obj) &&
+        ((PyVectorArray *)obj)->dim == self->dim)
+        return _vectorarray_apply((PyVectorArray *)obj, self->matrix, NULL);
+
+    switch (_vector_coords_from_obj(obj, coords, self->dim)) {
+    case -1:
+        return NULL;
+    case 0:
+        PyErr_Format(PyExc_TypeError,
+                     "expected a %dD vector or Vector%dArray",
+                     self->dim, self->dim);
+        return NULL;
+    }
+    ret = (PyVector *)PyVector_NEW(self->dim);
+    if (ret == NULL)
+        return NULL;
+    _rotation_apply_vector(self, ret->coords, coords);
+    return (PyObject *)ret;
+}
+
+static PyObject *
+rotation_apply_ip(PyRotation *self, PyObject *obj)
+{
+    PyObject *ret;
+
+    if (PyVectorArray_Check(obj) &&
+        ((PyVectorArray *)obj)->dim == self->dim) {
+        ret = _vectorarray_apply((PyVectorArray *)obj, self->matrix,
+                                 (PyVectorArray *)obj);
+        if (ret == NULL)
+            return NULL;
+        Py_DECREF(ret);
+        Py_RETURN_NONE;
+    }
+    if (PyObject_TypeCheck(obj, self->dim == 2 ? &PyVector2_Type :
+                                                 &PyVector3_Type)) {
+        _rotation_apply_vector(self, ((PyVector *)obj)->coords,
+                               ((PyVector *)obj)->coords);
+        Py_RETURN_NONE;
+    }
+#if PG_ENABLE_NEWBUF
+    if (PyObject_CheckBuffer(obj)) {
+        if (!_rotation_apply_buffer(self, obj))
+            return NULL;
+        Py_RETURN_NONE;
+    }
+#endif
+    PyErr_Format(PyExc_TypeError,
+                 "expected a Vector%d, Vector%dArray or buffer of points",
+                 self->dim, self->dim);
+    return NULL;
+}
+
+/* The reverse rotation: the transposed matrix */
+static PyObject *
+rotation_inverse(PyRotation *self)
+{
+    PyRotation *ret;
+    unsigned int i, j;
+
+    ret = (PyRotation *)Py_TYPE(self)->tp_alloc(Py_TYPE(self), 0);
+    if (ret == NULL)
+        return NULL;
+    ret->dim = self->dim;
+    ret->angle = -self->angle;
+    memcpy(ret->axis, self->axis, sizeof(ret->axis));
+    for (i = 0; i < self->dim; ++i)
+        for (j = 0; j < self->dim; ++j)
+            ret->matrix[i * self->dim + j] = self->matrix[j * self->dim + i];
+    return (PyObject *)ret;
+}
+
+static PyObject *
+rotation_get_angle(PyRotation *self, void *closure)
+{
+    return PyFloat_FromDouble(self->angle);
+}
+
+static PyObject *
+rotation_get_axis(PyRotation *self, void *closure)
+{
+    PyVector *ret = (PyVector *)PyVector_NEW(3);
+
+    if (ret != NULL)
+        memcpy(ret->coords, self->axis, sizeof(self->axis));
+    return (PyObject *)ret;
+}
+
+static PyGetSetDef rotation2_getsets[] = {
+    { "angle", (getter)rotation_get_angle, NULL, DOC_ROTATION2ANGLE, NULL },
+    { NULL, 0, NULL, NULL, NULL }  /* Sentinel */
+};
+
+static PyGetSetDef rotation3_getsets[] = {
+    { "angle", (getter)rotation_get_angle, NULL, DOC_ROTATION3ANGLE, NULL },
+    { "axis", (getter)rotation_get_axis, NULL, DOC_ROTATION3AXIS, NULL },
+    { NULL, 0, NULL, NULL, NULL }  /* Sentinel */
+};
+
+static PyMethodDef rotation2_methods[] = {
+    {"apply", (PyCFunction)rotation_apply, METH_O,
+     DOC_ROTATION2APPLY
+    },
+    {"apply_ip", (PyCFunction)rotation_apply_ip, METH_O,
+     DOC_ROTATION2APPLYIP
+    },
+    {"inverse", (PyCFunction)rotation_inverse, METH_NOARGS,
+     DOC_ROTATION2INVERSE
+    },
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef rotation3_methods[] = {
+    {"apply", (PyCFunction)rotation_apply, METH_O,
+     DOC_ROTATION3APPLY
+    },
+    {"apply_ip", (PyCFunction)rotation_apply_ip, METH_O,
+     DOC_ROTATION3APPLYIP
+    },
+    {"inverse", (PyCFunction)rotation_inverse, METH_NOARGS,
+     DOC_ROTATION3INVERSE
+    },
+    {NULL}  /* Sentinel */
+};
+
+static PyTypeObject PyRotation2_Type = {
+    TYPE_HEAD(NULL, 0)
+    "pygame.math.Rotation2",   /* tp_name */
+    sizeof(PyRotation),        /* tp_basicsize */
+    0,                         /* tp_itemsize */
+    /* Methods to implement standard operations */
+    (destructor)rotation_dealloc, /* tp_dealloc */
+    0,                         /* tp_print */
+    0,                         /* tp_getattr */
+    0,                         /* tp_setattr */
+    0,                         /* tp_compare */
+    (reprfunc)rotation_repr,   /* tp_repr */
+    /* Method suites for standard classes */
+    0,                         /* tp_as_number */
+    0,                         /* tp_as_sequence */
+    0,                         /* tp_as_mapping */
+    /* More standard operations (here for binary compatibility) */
+    0,                         /* tp_hash */
+    0,                         /* tp_call */
+    0,                         /* tp_str */
+    0,                         /* tp_getattro */
+    0,                         /* tp_setattro */
+    /* Functions to access object as input/output buffer */
+    0,                         /* tp_as_buffer */
+    /* Flags to define presence of optional/expanded features */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* tp_flags */
+    /* Documentation string */
+    DOC_PYGAMEMATHROTATION2,   /* tp_doc */
+
+    /* Assigned meaning in release 2.0 */
+    /* call function for all accessible objects */
+    0,                         /* tp_traverse */
+    /* delete references to contained objects */
+    0,                         /* tp_clear */
+
+    /* Assigned meaning in release 2.1 */
+    /* rich comparisons */
+    0,                         /* tp_richcompare */
+    /* weak reference enabler */
+    0,                         /* tp_weaklistoffset */
+
+    /* Added in release 2.2 */
+    /* Iterators */
+    0,                         /* tp_iter */
+    0,                         /* tp_iternext */
+    /* Attribute descriptor and subclassing stuff */
+    rotation2_methods,         /* tp_methods */
+    0,                         /* tp_members */
+    rotation2_getsets,         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    (newfunc)rotation_new,     /* tp_new */
+};
+
+static PyTypeObject PyRotation3_Type = {
+    TYPE_HEAD(NULL, 0)
+    "pygame.math.Rotation3",   /* tp_name */
+    sizeof(PyRotation),        /* tp_basicsize */
+    0,                         /* tp_itemsize */
+    /* Methods to implement standard operations */
+    (destructor)rotation_dealloc, /* tp_dealloc */
+    0,                         /* tp_print */
+    0,                         /* tp_getattr */
+    0,                         /* tp_setattr */
+    0,                         /* tp_compare */
+    (reprfunc)rotation_repr,   /* tp_repr */
+    /* Method suites for standard classes */
+    0,                         /* tp_as_number */
+    0,                         /* tp_as_sequence */
+    0,                         /* tp_as_mapping */
+    /* More standard operations (here for binary compatibility) */
+    0,                         /* tp_hash */
+    0,                         /* tp_call */
+    0,                         /* tp_str */
+    0,                         /* tp_getattro */
+    0,                         /* tp_setattro */
+    /* Functions to access object as input/output buffer */
+    0,                         /* tp_as_buffer */
+    /* Flags to define presence of optional/expanded features */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* tp_flags */
+    /* Documentation string */
+    DOC_PYGAMEMATHROTATION3,   /* tp_doc */
+
+    /* Assigned meaning in release 2.0 */
+    /* call function for all accessible objects */
+    0,                         /* tp_traverse */
+    /* delete references to contained objects */
+    0,                         /* tp_clear */
+
+    /* Assigned meaning in release 2.1 */
+    /* rich comparisons */
+    0,                         /* tp_richcompare */
+    /* weak reference enabler */
+    0,                         /* tp_weaklistoffset */
+
+    /* Added in release 2.2 */
+    /* Iterators */
+    0,                         /* tp_iter */
+    0,                         /* tp_iternext */
+    /* Attribute descriptor and subclassing stuff */
+    rotation3_methods,         /* tp_methods */
+    0,                         /* tp_members */
+    rotation3_getsets,         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    (newfunc)rotation_new,     /* tp_new */
+};
+
+
+
+static PyObject *
+math_enable_swizzling(PyVector *self)
+{
+    swizzling_enabled = 1;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+math_disable_swizzling(PyVector *self)
+{
+    swizzling_enabled = 0;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+math_set_freelist_size(PyObject *self, PyObject *args)
+{
+    Py_ssize_t size;
+
+    if (!PyArg_ParseTuple(args, "n", &size))
+        return NULL;
+    if (PgFreeList_Resize(&vector2_freelist, size) ||
+        PgFreeList_Resize(&vector3_freelist, size))
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+math_get_freelist_stats(PyObject *self)
+{
+    PyObject *stats2, *stats3;
+
+    stats2 = PgFreeList_Stats(&vector2_freelist);
+    if (stats2 == NULL)
+        return NULL;
+    stats3 = PgFreeList_Stats(&vector3_freelist);
+    if (stats3 == NULL) {
+        Py_DECREF(stats2);
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", stats2, stats3);
+}
+
+static PyMethodDef _math_methods[] =
+{
+    {"enable_swizzling", (PyCFunction)math_enable_swizzling, METH_NOARGS,
+     "enables swizzling."
+    },
+    {"disable_swizzling", (PyCFunction)math_disable_swizzling, METH_NOARGS,
+     "disables swizzling."
+    },
+    {"set_freelist_size", math_set_freelist_size, METH_VARARGS,
+     DOC_PYGAMEMATHSETFREELISTSIZE
+    },
+    {"get_freelist_stats", (PyCFunction)math_get_freelist_stats, METH_NOARGS,
+     DOC_PYGAMEMATHGETFREELISTSTATS
     },
     {NULL, NULL, 0, NULL}
 };
@@ -3644,7 +5674,11 @@ MODINIT_DEFINE (math)
     if ((PyType_Ready(&PyVector2_Type) < 0) ||
         (PyType_Ready(&PyVector3_Type) < 0) ||
         (PyType_Ready(&PyVectorIter_Type) < 0) ||
-        (PyType_Ready(&PyVectorElementwiseProxy_Type) < 0) /*||
+        (PyType_Ready(&PyVectorElementwiseProxy_Type) < 0) ||
+        (PyType_Ready(&PyVector2Array_Type) < 0) ||
+        (PyType_Ready(&PyVector3Array_Type) < 0) ||
+        (PyType_Ready(&PyRotation2_Type) < 0) ||
+        (PyType_Ready(&PyRotation3_Type) < 0) /*||
         (PyType_Ready(&PyVector4_Type) < 0)*/) {
         MODINIT_ERROR;
     }
@@ -3665,18 +5699,30 @@ MODINIT_DEFINE (math)
     Py_INCREF(&PyVector3_Type);
     Py_INCREF(&PyVectorIter_Type);
     Py_INCREF(&PyVectorElementwiseProxy_Type);
+    Py_INCREF(&PyVector2Array_Type);
+    Py_INCREF(&PyVector3Array_Type);
+    Py_INCREF(&PyRotation2_Type);
+    Py_INCREF(&PyRotation3_Type);
     /*
     Py_INCREF(&PyVector4_Type);
     */
     if ((PyModule_AddObject(module, "Vector2", (PyObject *)&PyVector2_Type) != 0) ||
         (PyModule_AddObject(module, "Vector3", (PyObject *)&PyVector3_Type) != 0) ||
         (PyModule_AddObject(module, "VectorElementwiseProxy", (PyObject *)&PyVectorElementwiseProxy_Type) != 0) ||
-        (PyModule_AddObject(module, "VectorIterator", (PyObject *)&PyVectorIter_Type) != 0) /*||
+        (PyModule_AddObject(module, "VectorIterator", (PyObject *)&PyVectorIter_Type) != 0) ||
+        (PyModule_AddObject(module, "Vector2Array", (PyObject *)&PyVector2Array_Type) != 0) ||
+        (PyModule_AddObject(module, "Vector3Array", (PyObject *)&PyVector3Array_Type) != 0) ||
+        (PyModule_AddObject(module, "Rotation2", (PyObject *)&PyRotation2_Type) != 0) ||
+        (PyModule_AddObject(module, "Rotation3", (PyObject *)&PyRotation3_Type) != 0) /*||
         (PyModule_AddObject(module, "Vector4", (PyObject *)&PyVector4_Type) != 0)*/) {
         Py_DECREF(&PyVector2_Type);
         Py_DECREF(&PyVector3_Type);
         Py_DECREF(&PyVectorElementwiseProxy_Type);
         Py_DECREF(&PyVectorIter_Type);
+        Py_DECREF(&PyVector2Array_Type);
+        Py_DECREF(&PyVector3Array_Type);
+        Py_DECREF(&PyRotation2_Type);
+        Py_DECREF(&PyRotation3_Type);
         /*
         Py_DECREF(&PyVector4_Type);
         */
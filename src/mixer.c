@@ -28,6 +28,26 @@
 #include "pgcompat.h"
 #include "doc/mixer_doc.h"
 #include "mixer.h"
+#include "pgbufferproxy.h"
+#include <SDL_thread.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#include <time.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIXER_SSE2
+#include <emmintrin.h>
+#endif
+
+/* on some windows platforms math.h doesn't define M_PI */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
 
 #define PyBUF_HAS_FLAG(f, F) (((f) & (F)) == (F))
 
@@ -72,6 +92,7 @@ static PyObject* PyChannel_New (int);
 
 static int snd_getbuffer (PyObject*, Py_buffer*, int);
 static void snd_releasebuffer (PyObject*, Py_buffer*);
+static int _sound_readonly (PyObject*);
 
 static int request_frequency = PYGAME_MIXER_DEFAULT_FREQUENCY;
 static int request_size = PYGAME_MIXER_DEFAULT_SIZE;
@@ -79,18 +100,112 @@ static int request_stereo = PYGAME_MIXER_DEFAULT_CHANNELS;
 static int request_chunksize = PYGAME_MIXER_DEFAULT_CHUNKSIZE;
 
 static int sound_init (PyObject* self, PyObject* arg, PyObject* kwarg);
+static void _dsp_free (int channelnum);
+static void _stream_quit_thread (void);
+
+/* Orders memory accesses to state shared with the audio and stream
+   threads without a lock */
+#if defined(_MSC_VER)
+#define MIXER_BARRIER() MemoryBarrier ()
+#elif defined(__GNUC__)
+#define MIXER_BARRIER() __sync_synchronize ()
+#else
+#define MIXER_BARRIER()
+#endif
+
+/* The effect chain of a Channel: an optional biquad filter, then a gain
+   per output channel made of the set gain, distance attenuation and pan.
+   Python writes params, bumping seq to odd before and even after, and the
+   audio thread takes a copy at the start of a buffer when seq is even and
+   changed, so neither side ever waits on the other. */
+#define CHANNEL_DSP_LOWPASS 1
+#define CHANNEL_DSP_HIGHPASS 2
+#define CHANNEL_DSP_MAX_GAIN 16.0f
+
+typedef struct
+{
+    int filter;                 /* 0 or CHANNEL_DSP_LOWPASS or _HIGHPASS */
+    float b0, b1, b2, a1, a2;   /* biquad coefficients over a0 */
+    float gain[2];              /* for left and right, or mono */
+    int ramp_frames;            /* sample frames to reach gain in */
+    long gains;                 /* bumped when gain and ramp_frames change */
+} ChannelDSPParams;
+
+struct ChannelDSP
+{
+    /* Python side, with the GIL */
+    float gain;
+    float pan;
+    float attenuation;          /* from the distance */
+    Uint32 ramp_end;            /* SDL_GetTicks when a gain ramp ends */
+    volatile long seq;
+    ChannelDSPParams params;
+
+    /* Audio thread side */
+    long seen;
+    ChannelDSPParams active;
+    float current[2];
+    float step[2];
+    int ramp_left;
+    float z[2][2];              /* filter state for each output channel */
+
+    int registered;             /* as an effect; under the audio lock */
+};
 
 struct ChannelData
 {
     PyObject* sound;
     PyObject* queue;
     int endevent;
+    struct ChannelDSP *dsp;     /* the effect chain, or NULL */
+    Uint32 start;               /* SDL_GetTicks when sound started */
+    int free_pos;               /* index in free_channels, or -1 */
 };
 static struct ChannelData *channeldata = NULL;
 static int numchanneldata = 0;
 
-Mix_Music** current_music;
-Mix_Music** queue_music;
+/* The unreserved channels not playing, as a stack, so Sound.play takes
+   one without looking at every channel. A channel knows its place in the
+   stack, so one played through a Channel object comes out just as fast.
+   Changed with the audio locked, as channels end on the audio thread. */
+static int *free_channels = NULL;   /* numchanneldata long */
+static int numfree = 0;
+static int mixer_numchans = 0;      /* allocated in SDL_mixer */
+static int mixer_reserved = 0;
+
+/* Which playing channel Sound.play takes when none are free */
+#define STEAL_NONE 0
+#define STEAL_OLDEST 1
+#define STEAL_QUIETEST 2
+#define STEAL_PRIORITY 3
+static const char *steal_policies[] =
+{
+    "none", "oldest", "quietest", "priority", NULL
+};
+static int steal_policy = STEAL_NONE;
+
+/* music.c's function stopping and freeing all music */
+static void (*music_quit) (void) = NULL;
+
+/* Timing of the audio callback, kept by a post mix effect on the audio
+   thread. Read and reset with the audio locked. */
+#define MIXER_STATS_BUCKETS 12
+static struct
+{
+    double last;            /* when the last callback ran, or 0 */
+    unsigned long callbacks;
+    unsigned long underruns; /* intervals over 1.5 buffer periods */
+    double total_interval;
+    double max_interval;
+    int frames;             /* sample frames in the last callback */
+    unsigned long histogram[MIXER_STATS_BUCKETS];
+} mixer_stats;
+static int mixer_freq = 0;
+static int mixer_frame_size = 0;
+static int mixer_chunksize = 0;
+static Uint16 mixer_format = 0;
+static int mixer_channels = 0;
+static int dsp_count = 0;           /* channels with an effect chain */
 
 static int
 _format_itemsize(Uint16 format)
@@ -234,6 +349,68 @@ _format_view_to_audio(Py_buffer *view)
     return format;
 }
 
+static void
+_channel_free (int channel)
+{
+    if (channel < mixer_reserved || channel >= mixer_numchans ||
+        channeldata[channel].free_pos >= 0)
+        return;
+    channeldata[channel].free_pos = numfree;
+    free_channels[numfree++] = channel;
+}
+
+static void
+_channel_take (int channel)
+{
+    int pos, last;
+
+    if (channel < 0 || channel >= numchanneldata)
+        return;
+    pos = channeldata[channel].free_pos;
+    if (pos < 0)
+        return;
+    last = free_channels[--numfree];
+    free_channels[pos] = last;
+    channeldata[last].free_pos = pos;
+    channeldata[channel].free_pos = -1;
+}
+
+/* Fills free_channels again after the channel counts change. Lower
+   channels go on top, so they are used first, as SDL_mixer does. */
+static void
+_channel_pool_reset (void)
+{
+    int i;
+
+    numfree = 0;
+    for (i = 0; i < numchanneldata; ++i)
+        channeldata[i].free_pos = -1;
+    for (i = mixer_numchans - 1; i >= mixer_reserved; --i)
+    {
+        if (!Mix_Playing (i))
+            _channel_free (i);
+    }
+}
+
+/* Puts a Sound on a channel, keeping the count of channels each Sound
+   plays on. With the audio locked; the old Sound is returned for the
+   caller to release. */
+static PyObject*
+_channel_set_sound (int channel, PyObject *sound)
+{
+    PyObject *old = channeldata[channel].sound;
+
+    if (old)
+        --((PySoundObject*) old)->playing;
+    if (sound)
+    {
+        ++((PySoundObject*) sound)->playing;
+        channeldata[channel].start = SDL_GetTicks ();
+    }
+    channeldata[channel].sound = sound;
+    return old;
+}
+
 static void
 endsound_callback (int channel)
 {
@@ -252,17 +429,21 @@ endsound_callback (int channel)
     {
         int channelnum;
         Mix_Chunk* sound = PySound_AsChunk (channeldata[channel].queue);
-        Py_XDECREF (channeldata[channel].sound);
-        channeldata[channel].sound = channeldata[channel].queue;
+        PyObject* old = _channel_set_sound (channel,
+                                            channeldata[channel].queue);
+        Py_XDECREF (old);
         channeldata[channel].queue = NULL;
         channelnum = Mix_PlayChannelTimed (channel, sound, 0, -1);
         if (channelnum != -1)
             Mix_GroupChannel (channelnum, (intptr_t)sound);
+        else
+            _channel_free (channel);
     }
     else
     {
-        Py_XDECREF (channeldata[channel].sound);
-        channeldata[channel].sound = NULL;
+        PyObject* old = _channel_set_sound (channel, NULL);
+        Py_XDECREF (old);
+        _channel_free (channel);
     }
     }
 }
@@ -270,6 +451,7 @@ endsound_callback (int channel)
 static void
 autoquit(void)
 {
+    PyObject* old;
     int i;
     if (SDL_WasInit (SDL_INIT_AUDIO))
     {
@@ -277,40 +459,269 @@ autoquit(void)
 
         if (channeldata)
         {
+            SDL_LockAudio ();
             for (i = 0; i < numchanneldata; ++i)
             {
-                Py_XDECREF (channeldata[i].sound);
+                old = _channel_set_sound (i, NULL);
+                Py_XDECREF (old);
                 Py_XDECREF (channeldata[i].queue);
+                _dsp_free (i);
             }
             free (channeldata);
             channeldata = NULL;
             numchanneldata = 0;
+            free (free_channels);
+            free_channels = NULL;
+            numfree = 0;
+            SDL_UnlockAudio ();
         }
 
-        if (current_music)
+        if (music_quit)
+            music_quit ();
+
+        Mix_CloseAudio ();
+        _stream_quit_thread ();
+        SDL_QuitSubSystem (SDL_INIT_AUDIO);
+    }
+}
+
+/* Seconds from an arbitrary start, as precise as the platform allows */
+static double
+_stats_clock (void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER now;
+
+    if (!frequency.QuadPart)
+        QueryPerformanceFrequency (&frequency);
+    QueryPerformanceCounter (&now);
+    return (double) now.QuadPart / (double) frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#else
+    return SDL_GetTicks () / 1000.0;
+#endif
+}
+
+static void
+_stats_reset (void)
+{
+    memset (&mixer_stats, 0, sizeof (mixer_stats));
+}
+
+/* Runs last in every audio callback, on the audio thread */
+static void
+_stats_effect (int chan, void *stream, int len, void *udata)
+{
+    double now = _stats_clock ();
+    double interval;
+    int bucket = 0;
+    long ms;
+
+    mixer_stats.frames = len / mixer_frame_size;
+    if (mixer_stats.callbacks)
+    {
+        interval = now - mixer_stats.last;
+        mixer_stats.total_interval += interval;
+        if (interval > mixer_stats.max_interval)
+            mixer_stats.max_interval = interval;
+        if (interval * mixer_freq > 1.5 * mixer_stats.frames)
+            ++mixer_stats.underruns;
+        /* Bucket 0 is under 1 ms, bucket n from 2**(n-1) ms */
+        for (ms = (long) (interval * 1000.0);
+             ms && bucket < MIXER_STATS_BUCKETS - 1; ms >>= 1)
+            ++bucket;
+        ++mixer_stats.histogram[bucket];
+    }
+    mixer_stats.last = now;
+    ++mixer_stats.callbacks;
+}
+
+/* Multiply frames of 16 bit samples by a gain for each output channel,
+   which moves by step every frame */
+static void
+_dsp_gain_run (Sint16 *samples, int frames, int channels,
+               const float *gain, const float *step)
+{
+    int count = frames * channels;
+    int i = 0, c, frame;
+    float value;
+#if defined(MIXER_SSE2)
+    float lanes[4], steps[4];
+    __m128 g0, g1, d2;
+    __m128i x, lo, hi;
+
+    /* Lane k holds sample k of a group of 4; groups of 8 go at once */
+    for (c = 0; c < 4; ++c)
+    {
+        lanes[c] = gain[c % channels] + step[c % channels] * (c / channels);
+        steps[c] = step[c % channels] * (4 / channels);
+    }
+    g0 = _mm_loadu_ps (lanes);
+    g1 = _mm_add_ps (g0, _mm_loadu_ps (steps));
+    d2 = _mm_add_ps (_mm_loadu_ps (steps), _mm_loadu_ps (steps));
+    for (; i + 8 <= count; i += 8)
+    {
+        x = _mm_loadu_si128 ((__m128i *) (samples + i));
+        lo = _mm_srai_epi32 (_mm_unpacklo_epi16 (x, x), 16);
+        hi = _mm_srai_epi32 (_mm_unpackhi_epi16 (x, x), 16);
+        lo = _mm_cvtps_epi32 (_mm_mul_ps (_mm_cvtepi32_ps (lo), g0));
+        hi = _mm_cvtps_epi32 (_mm_mul_ps (_mm_cvtepi32_ps (hi), g1));
+        _mm_storeu_si128 ((__m128i *) (samples + i),
+                          _mm_packs_epi32 (lo, hi));
+        g0 = _mm_add_ps (g0, d2);
+        g1 = _mm_add_ps (g1, d2);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        c = i % channels;
+        frame = i / channels;
+        value = samples[i] * (gain[c] + step[c] * frame);
+        value += value < 0.0f ? -0.5f : 0.5f;
+        samples[i] = (Sint16) (value > 32767.0f ? 32767 :
+                               value < -32768.0f ? -32768 : value);
+    }
+}
+
+static void
+_dsp_filter_run (struct ChannelDSP *dsp, Sint16 *samples, int frames,
+                 int channels)
+{
+    const ChannelDSPParams *p = &dsp->active;
+    int i, c;
+    float x, y;
+
+    /* Each output depends on the one before, so this stays scalar */
+    for (i = 0; i < frames; ++i)
+    {
+        for (c = 0; c < channels; ++c)
         {
-            if (*current_music)
-            {
-                Mix_FreeMusic (*current_music);
-                *current_music = NULL;
-            }
-            current_music = NULL;
+            x = *samples;
+            y = p->b0 * x + dsp->z[c][0];
+            dsp->z[c][0] = p->b1 * x - p->a1 * y + dsp->z[c][1];
+            dsp->z[c][1] = p->b2 * x - p->a2 * y;
+            y += y < 0.0f ? -0.5f : 0.5f;
+            *samples++ = (Sint16) (y > 32767.0f ? 32767 :
+                                   y < -32768.0f ? -32768 : y);
         }
-        if (queue_music)
+    }
+    /* Keep a decaying state out of the slow denormal range */
+    for (c = 0; c < channels; ++c)
+    {
+        if (fabs (dsp->z[c][0]) < 1e-15)
+            dsp->z[c][0] = 0.0f;
+        if (fabs (dsp->z[c][1]) < 1e-15)
+            dsp->z[c][1] = 0.0f;
+    }
+}
+
+/* Take the params Python last set, if they changed and are not half
+   written */
+static void
+_dsp_update (struct ChannelDSP *dsp)
+{
+    ChannelDSPParams params;
+    long seq = dsp->seq;
+    int c;
+
+    if ((seq & 1) || seq == dsp->seen)
+        return;
+    MIXER_BARRIER ();
+    params = dsp->params;
+    MIXER_BARRIER ();
+    if (dsp->seq != seq)
+        return;
+    dsp->seen = seq;
+    if (params.filter != dsp->active.filter)
+        memset (dsp->z, 0, sizeof (dsp->z));
+    if (params.gains != dsp->active.gains)
+    {
+        dsp->ramp_left = params.ramp_frames;
+        for (c = 0; c < 2; ++c)
         {
-            if (*queue_music)
-            {
-                Mix_FreeMusic (*queue_music);
-                *queue_music = NULL;
-            }
-            queue_music = NULL;
+            if (dsp->ramp_left)
+                dsp->step[c] = (params.gain[c] - dsp->current[c]) /
+                               dsp->ramp_left;
+            else
+                dsp->current[c] = params.gain[c];
         }
+    }
+    dsp->active = params;
+}
 
-        Mix_CloseAudio ();
-        SDL_QuitSubSystem (SDL_INIT_AUDIO);
+static void
+_dsp_effect (int chan, void *stream, int len, void *udata)
+{
+    static const float still[2] = {0.0f, 0.0f};
+    struct ChannelDSP *dsp = (struct ChannelDSP *) udata;
+    Sint16 *samples = (Sint16 *) stream;
+    int channels = mixer_channels;
+    int frames = len / (2 * channels);
+    int n, c;
+
+    _dsp_update (dsp);
+    if (dsp->active.filter)
+        _dsp_filter_run (dsp, samples, frames, channels);
+    if (!dsp->ramp_left &&
+        dsp->current[0] == 1.0f && dsp->current[1] == 1.0f)
+        return;
+    while (frames)
+    {
+        if (!dsp->ramp_left)
+        {
+            _dsp_gain_run (samples, frames, channels, dsp->current, still);
+            break;
+        }
+        n = MIN (frames, dsp->ramp_left);
+        _dsp_gain_run (samples, n, channels, dsp->current, dsp->step);
+        dsp->ramp_left -= n;
+        for (c = 0; c < 2; ++c)
+            dsp->current[c] = dsp->ramp_left ?
+                dsp->current[c] + dsp->step[c] * n : dsp->active.gain[c];
+        samples += n * channels;
+        frames -= n;
     }
 }
 
+static void
+_dsp_done (int chan, void *udata)
+{
+    ((struct ChannelDSP *) udata)->registered = 0;
+}
+
+/* SDL_mixer drops the effects of a channel when it stops; put the chain
+   back on a channel that plays again. Call with the audio locked. */
+static void
+_dsp_attach (int channelnum)
+{
+    struct ChannelDSP *dsp;
+
+    if (channelnum < 0 || channelnum >= numchanneldata)
+        return;
+    dsp = channeldata[channelnum].dsp;
+    if (dsp && !dsp->registered && Mix_Playing (channelnum) &&
+        Mix_RegisterEffect (channelnum, _dsp_effect, _dsp_done, dsp))
+        dsp->registered = 1;
+}
+
+/* A post mix effect catching channels started from the audio thread, by
+   a queued Sound, which lose their effects as soon as they start */
+static void
+_dsp_attach_effect (int chan, void *stream, int len, void *udata)
+{
+    int i;
+
+    if (!dsp_count || !channeldata)
+        return;
+    for (i = 0; i < numchanneldata; ++i)
+        _dsp_attach (i);
+}
+
 static PyObject*
 _init (int freq, int size, int stereo, int chunk)
 {
@@ -371,11 +782,15 @@ _init (int freq, int size, int stereo, int chunk)
             numchanneldata = MIX_CHANNELS;
             channeldata = (struct ChannelData*)
                 malloc (sizeof (struct ChannelData) *numchanneldata);
+            free_channels = (int*) malloc (sizeof (int) * numchanneldata);
             for (i = 0; i < numchanneldata; ++i)
             {
                 channeldata[i].sound = NULL;
                 channeldata[i].queue = NULL;
                 channeldata[i].endevent = 0;
+                channeldata[i].dsp = NULL;
+                channeldata[i].start = 0;
+                channeldata[i].free_pos = -1;
             }
         }
 
@@ -387,6 +802,18 @@ _init (int freq, int size, int stereo, int chunk)
             SDL_QuitSubSystem (SDL_INIT_AUDIO);
             return PyInt_FromLong (0);
         }
+        mixer_numchans = Mix_AllocateChannels (-1);
+        mixer_reserved = 0;
+        _channel_pool_reset ();
+        Mix_QuerySpec (&mixer_freq, &fmt, &stereo);
+        mixer_format = fmt;
+        mixer_channels = stereo;
+        mixer_frame_size = (fmt & 0xff) / 8 * stereo;
+        mixer_chunksize = chunk;
+        _stats_reset ();
+        /* music.c has the one post mix hook, so this is an effect */
+        Mix_RegisterEffect (MIX_CHANNEL_POST, _dsp_attach_effect, NULL, NULL);
+        Mix_RegisterEffect (MIX_CHANNEL_POST, _stats_effect, NULL, NULL);
 #if MIX_MAJOR_VERSION>=1 && MIX_MINOR_VERSION>=2 && MIX_PATCHLEVEL>=3
         Mix_ChannelFinished (endsound_callback);
 #endif
@@ -473,6 +900,75 @@ get_init (PyObject* self)
     return Py_BuildValue ("(iii)", freq, realform, channels);
 }
 
+static PyObject*
+get_latency (PyObject* self)
+{
+    int frames;
+
+    MIXER_INIT_CHECK ();
+
+    SDL_LockAudio ();
+    frames = mixer_stats.frames;
+    SDL_UnlockAudio ();
+    if (!frames)
+        frames = mixer_chunksize;
+    return PyFloat_FromDouble ((double) frames / mixer_freq);
+}
+
+static PyObject*
+get_callback_stats (PyObject* self)
+{
+    PyObject *histogram, *item;
+    unsigned long callbacks, underruns;
+    unsigned long counts[MIXER_STATS_BUCKETS];
+    double total, longest;
+    int frames, i;
+
+    MIXER_INIT_CHECK ();
+
+    SDL_LockAudio ();
+    callbacks = mixer_stats.callbacks;
+    underruns = mixer_stats.underruns;
+    total = mixer_stats.total_interval;
+    longest = mixer_stats.max_interval;
+    frames = mixer_stats.frames;
+    memcpy (counts, mixer_stats.histogram, sizeof (counts));
+    SDL_UnlockAudio ();
+
+    histogram = PyList_New (MIXER_STATS_BUCKETS);
+    if (!histogram)
+        return NULL;
+    for (i = 0; i < MIXER_STATS_BUCKETS; ++i)
+    {
+        item = PyLong_FromUnsignedLong (counts[i]);
+        if (!item)
+        {
+            Py_DECREF (histogram);
+            return NULL;
+        }
+        PyList_SET_ITEM (histogram, i, item);
+    }
+    return Py_BuildValue ("{sksksisdsdsN}",
+                          "callbacks", callbacks,
+                          "underruns", underruns,
+                          "frames", frames,
+                          "mean_interval",
+                          callbacks > 1 ? total / (callbacks - 1) : 0.0,
+                          "max_interval", longest,
+                          "histogram", histogram);
+}
+
+static PyObject*
+reset_callback_stats (PyObject* self)
+{
+    MIXER_INIT_CHECK ();
+
+    SDL_LockAudio ();
+    _stats_reset ();
+    SDL_UnlockAudio ();
+    Py_RETURN_NONE;
+}
+
 static PyObject*
 pre_init (PyObject* self, PyObject* args, PyObject* keywds)
 {
@@ -492,44 +988,781 @@ pre_init (PyObject* self, PyObject* args, PyObject* keywds)
     if (!request_size) {
     request_size = PYGAME_MIXER_DEFAULT_SIZE;
     }
-    if (!request_stereo) {
-    request_stereo = PYGAME_MIXER_DEFAULT_CHANNELS;
+    if (!request_stereo) {
+    request_stereo = PYGAME_MIXER_DEFAULT_CHANNELS;
+    }
+    if (!request_chunksize) {
+    request_chunksize = PYGAME_MIXER_DEFAULT_CHUNKSIZE;
+    }
+    Py_RETURN_NONE;
+}
+
+/* The chunk of a Sound, decoding a compressed sound first. Returns NULL
+   with an exception set on failure. */
+static Mix_Chunk*
+_sound_chunk (PyObject* self)
+{
+    PySoundObject* soundobj = (PySoundObject*) self;
+    PyObject* encoded = soundobj->encoded;
+    SDL_RWops* rw;
+    Mix_Chunk* chunk;
+
+    if (soundobj->chunk)
+        return soundobj->chunk;
+    if (!encoded)
+    {
+        RAISE (PyExc_SDLError, "Sound is not initialized");
+        return NULL;
+    }
+    if (!SDL_WasInit (SDL_INIT_AUDIO))
+    {
+        RAISE (PyExc_SDLError, "mixer system not initialized");
+        return NULL;
+    }
+    rw = SDL_RWFromConstMem (Bytes_AS_STRING (encoded),
+                             (int) Bytes_GET_SIZE (encoded));
+    if (!rw)
+    {
+        RAISE (PyExc_SDLError, SDL_GetError ());
+        return NULL;
+    }
+
+    /* Another thread can decode the sound meanwhile */
+    Py_INCREF (encoded);
+    Py_BEGIN_ALLOW_THREADS;
+    chunk = Mix_LoadWAV_RW (rw, 1);
+    Py_END_ALLOW_THREADS;
+    Py_DECREF (encoded);
+    if (!chunk)
+    {
+        RAISE (PyExc_SDLError, Mix_GetError ());
+        return NULL;
+    }
+    if (soundobj->chunk)
+        Mix_FreeChunk (chunk);
+    else
+    {
+        soundobj->chunk = chunk;
+        Py_CLEAR (soundobj->encoded);
+    }
+    return soundobj->chunk;
+}
+
+/* Streamed Sounds. The chunk of a streamed Sound is a ring of about half
+   a second of audio, played looping forever, which one mixer thread keeps
+   filling from the WAV file ahead of the channel. A channel effect counts
+   the bytes played, silences those not written yet, and ends the channel
+   once the file has played out. Only the filling thread changes written,
+   and only the audio thread changes played. */
+#define STREAM_BLOCK_FRAMES 2048
+#define STREAM_POLL_MS 10
+
+typedef struct SoundStream
+{
+    SDL_RWops *rw;
+    int data_start;             /* file offset of the samples */
+    int data_len;
+    int data_left;              /* bytes to read before starting over */
+    int loops;                  /* times left to start over, -1 forever */
+    int src_frame;              /* bytes of a sample frame in the file */
+    int src_rate;
+    int freq, channels;         /* of the mixer, which cvt converts to */
+    Uint16 format;
+    int frame;
+    SDL_AudioCVT cvt;
+    Uint8 *block;               /* a block of the file, converted in place */
+    int block_len;
+    Uint32 block_room;          /* the most a block converts to */
+    Uint8 *ring;
+    Uint32 size;
+    int channel;
+    volatile Uint32 written;
+    volatile Uint32 played;
+    volatile Uint32 end;
+    volatile int ended;         /* end is set */
+    volatile int playing;       /* with the effect on channel */
+    int expiring;
+
+    /* Under stream_lock */
+    int busy;                   /* being filled outside the lock */
+    int orphaned;               /* the Sound is gone; free when not busy */
+    struct SoundStream *prev, *next;
+} SoundStream;
+
+static SoundStream *stream_list = NULL;
+static SDL_mutex *stream_lock = NULL;
+static SDL_sem *stream_wake = NULL;
+static SDL_Thread *stream_thread = NULL;
+static volatile int stream_quit = 0;
+
+static void
+_stream_silence (Uint8 *buf, Uint32 len, Uint16 format)
+{
+    Uint32 i;
+
+    if (format == AUDIO_U8)
+        memset (buf, 0x80, len);
+    else if (format == AUDIO_U16SYS)
+        for (i = 0; i + 1 < len; i += 2)
+            *(Uint16 *) (buf + i) = 0x8000;
+    else
+        memset (buf, 0, len);
+}
+
+/* Read the next block of the file into the ring, if there is room.
+   Returns 1 if more may follow, else 0. */
+static int
+_stream_fill_block (SoundStream *stream)
+{
+    Uint32 pos, first;
+    int n;
+
+    if (stream->ended)
+        return 0;
+    /* Skip what played as silence after running dry */
+    if ((Sint32) (stream->played - stream->written) > 0)
+        stream->written = stream->played;
+    if (stream->size - (stream->written - stream->played) <
+        stream->block_room)
+        return 0;
+
+    while (!stream->data_left)
+    {
+        if (!stream->loops || !stream->data_len ||
+            SDL_RWseek (stream->rw, stream->data_start, RW_SEEK_SET) < 0)
+        {
+            stream->end = stream->written;
+            MIXER_BARRIER ();
+            stream->ended = 1;
+            return 0;
+        }
+        if (stream->loops > 0)
+            --stream->loops;
+        stream->data_left = stream->data_len;
+    }
+    n = SDL_RWread (stream->rw, stream->block, 1,
+                    MIN (stream->block_len, stream->data_left));
+    if (n <= 0)
+    {
+        /* The file is shorter than its header says, or unreadable */
+        stream->data_left = 0;
+        stream->loops = 0;
+        return 1;
+    }
+    stream->data_left -= n;
+    n -= n % stream->src_frame;
+    if (stream->cvt.needed)
+    {
+        stream->cvt.buf = stream->block;
+        stream->cvt.len = n;
+        SDL_ConvertAudio (&stream->cvt);
+        n = stream->cvt.len_cvt;
+    }
+    n -= n % stream->frame;
+
+    pos = stream->written % stream->size;
+    first = MIN ((Uint32) n, stream->size - pos);
+    memcpy (stream->ring + pos, stream->block, first);
+    memcpy (stream->ring, stream->block + first, n - first);
+    MIXER_BARRIER ();
+    stream->written += n;
+    return 1;
+}
+
+static void
+_stream_effect (int chan, void *samples, int len, void *udata)
+{
+    SoundStream *stream = (SoundStream *) udata;
+    Uint32 played = stream->played;
+    Uint32 avail = stream->written - played;
+
+    MIXER_BARRIER ();
+    if ((Sint32) avail < 0)
+        avail = 0;
+    if (avail < (Uint32) len)
+        _stream_silence ((Uint8 *) samples + avail, len - avail,
+                         stream->format);
+    stream->played = played + len;
+    if (stream->ended && !stream->expiring &&
+        (Sint32) (stream->played - stream->end) >= 0)
+    {
+        /* Halting the channel here would free the effects being run */
+        Mix_ExpireChannel (chan, 1);
+        stream->expiring = 1;
+    }
+}
+
+static void
+_stream_done (int chan, void *udata)
+{
+    ((SoundStream *) udata)->playing = 0;
+}
+
+/* With stream_lock */
+static void
+_stream_unlink (SoundStream *stream)
+{
+    if (stream->prev)
+        stream->prev->next = stream->next;
+    else
+        stream_list = stream->next;
+    if (stream->next)
+        stream->next->prev = stream->prev;
+}
+
+static void
+_stream_free (SoundStream *stream)
+{
+    if (stream->rw)
+        SDL_RWclose (stream->rw);
+    free (stream->ring);
+    free (stream->block);
+    free (stream);
+}
+
+/* The stream thread. Only it frees streams while it runs, and it never
+   waits on the GIL or the audio lock while holding stream_lock. */
+static int
+_stream_run (void *unused)
+{
+    SoundStream *stream, *next;
+
+    while (!stream_quit)
+    {
+        SDL_LockMutex (stream_lock);
+        for (stream = stream_list; stream; stream = next)
+        {
+            if (stream->playing && !stream->busy && !stream->orphaned)
+            {
+                stream->busy = 1;
+                SDL_UnlockMutex (stream_lock);
+                while (stream->playing && _stream_fill_block (stream));
+                SDL_LockMutex (stream_lock);
+                stream->busy = 0;
+            }
+            next = stream->next;
+            if (stream->orphaned && !stream->busy)
+            {
+                _stream_unlink (stream);
+                SDL_UnlockMutex (stream_lock);
+                _stream_free (stream);
+                SDL_LockMutex (stream_lock);
+            }
+        }
+        SDL_UnlockMutex (stream_lock);
+        SDL_SemWaitTimeout (stream_wake, STREAM_POLL_MS);
+    }
+    return 0;
+}
+
+static int
+_stream_start_thread (void)
+{
+    if (stream_thread)
+        return 0;
+    stream_quit = 0;
+    stream_thread = SDL_CreateThread (_stream_run, NULL);
+    if (!stream_thread)
+    {
+        RAISE (PyExc_SDLError, SDL_GetError ());
+        return -1;
+    }
+    return 0;
+}
+
+static void
+_stream_quit_thread (void)
+{
+    SoundStream *stream, *next;
+
+    if (!stream_thread)
+        return;
+    stream_quit = 1;
+    SDL_SemPost (stream_wake);
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_WaitThread (stream_thread, NULL);
+    Py_END_ALLOW_THREADS;
+    stream_thread = NULL;
+
+    SDL_LockMutex (stream_lock);
+    for (stream = stream_list; stream; stream = next)
+    {
+        next = stream->next;
+        if (stream->orphaned)
+        {
+            _stream_unlink (stream);
+            _stream_free (stream);
+        }
+    }
+    SDL_UnlockMutex (stream_lock);
+}
+
+/* For Sound dealloc, after its chunk stopped playing */
+static void
+_stream_release (SoundStream *stream)
+{
+    SDL_LockMutex (stream_lock);
+    if (stream_thread)
+    {
+        /* It may be filling the stream right now */
+        stream->orphaned = 1;
+        SDL_UnlockMutex (stream_lock);
+        SDL_SemPost (stream_wake);
+        return;
+    }
+    _stream_unlink (stream);
+    SDL_UnlockMutex (stream_lock);
+    _stream_free (stream);
+}
+
+static Uint32
+_stream_le (const Uint8 *bytes, int n)
+{
+    Uint32 value = 0;
+
+    while (n--)
+        value = (value << 8) | bytes[n];
+    return value;
+}
+
+/* Read the WAV header of rw, leaving it at the samples. Returns 0, or -1
+   if rw is not a PCM WAV file SDL can convert. */
+static int
+_stream_read_header (SoundStream *stream, SDL_RWops *rw)
+{
+    Uint8 header[40];
+    Uint32 size, n;
+    int tag = 0, channels = 0, bits = 0;
+
+    if (SDL_RWread (rw, header, 12, 1) != 1 ||
+        memcmp (header, "RIFF", 4) || memcmp (header + 8, "WAVE", 4))
+        return -1;
+    for (;;)
+    {
+        if (SDL_RWread (rw, header, 8, 1) != 1)
+            return -1;
+        size = _stream_le (header + 4, 4);
+        if (!memcmp (header, "data", 4))
+            break;
+        n = 0;
+        if (!memcmp (header, "fmt ", 4))
+        {
+            n = MIN (size, sizeof (header));
+            if (n < 16 || SDL_RWread (rw, header, n, 1) != 1)
+                return -1;
+            tag = _stream_le (header, 2);
+            /* WAVE_FORMAT_EXTENSIBLE keeps the real tag further on */
+            if (tag == 0xfffe && n >= 26)
+                tag = _stream_le (header + 24, 2);
+            channels = _stream_le (header + 2, 2);
+            stream->src_rate = _stream_le (header + 4, 4);
+            bits = _stream_le (header + 14, 2);
+        }
+        /* Chunks are padded to an even size */
+        if (SDL_RWseek (rw, size - n + (size & 1), RW_SEEK_CUR) < 0)
+            return -1;
+    }
+    if (tag != 1 || (bits != 8 && bits != 16) ||
+        (channels != 1 && channels != 2) || stream->src_rate <= 0)
+        return -1;
+
+    stream->data_start = SDL_RWtell (rw);
+    stream->data_len = size > 0x7fffffff ? 0x7fffffff : (int) size;
+    stream->src_frame = bits / 8 * channels;
+    if (stream->data_start < 0 ||
+        SDL_BuildAudioCVT (&stream->cvt,
+                           bits == 8 ? AUDIO_U8 : AUDIO_S16LSB,
+                           (Uint8) channels, stream->src_rate,
+                           stream->format, (Uint8) stream->channels,
+                           stream->freq) < 0)
+        return -1;
+    return 0;
+}
+
+/* Make soundobj a Sound streaming file. Returns 0, or -1 with an
+   exception set. */
+static int
+_stream_init (PySoundObject *soundobj, PyObject *file)
+{
+    SoundStream *stream;
+    PyObject *oencoded;
+    SDL_RWops *rw;
+    Mix_Chunk *chunk;
+    Uint32 size;
+
+    if (!SDL_WasInit (SDL_INIT_AUDIO))
+    {
+        RAISE (PyExc_SDLError, "mixer system not initialized");
+        return -1;
+    }
+    if (!stream_lock)
+    {
+        stream_lock = SDL_CreateMutex ();
+        stream_wake = SDL_CreateSemaphore (0);
+        if (!stream_lock || !stream_wake)
+        {
+            RAISE (PyExc_SDLError, SDL_GetError ());
+            return -1;
+        }
+    }
+
+    /* A file name is read by the stream thread without the GIL */
+    oencoded = RWopsEncodeFilePath (file, PyExc_SDLError);
+    if (!oencoded)
+        return -1;
+    if (oencoded == Py_None)
+        rw = RWopsFromFileObjectThreaded (file);
+    else
+    {
+        rw = RWopsFromFileName (Bytes_AS_STRING (oencoded));
+        if (!rw)
+            PyErr_Format (PyExc_SDLError, "Unable to open file '%s'",
+                          Bytes_AS_STRING (oencoded));
+    }
+    Py_DECREF (oencoded);
+    if (!rw)
+        return -1;
+
+    stream = (SoundStream *) calloc (1, sizeof (SoundStream));
+    if (!stream)
+    {
+        SDL_RWclose (rw);
+        PyErr_NoMemory ();
+        return -1;
+    }
+    stream->rw = rw;
+    Mix_QuerySpec (&stream->freq, &stream->format, &stream->channels);
+    stream->frame = (stream->format & 0xff) / 8 * stream->channels;
+    if (_stream_read_header (stream, rw))
+    {
+        _stream_free (stream);
+        if (!PyErr_Occurred ())
+            RAISE (PyExc_SDLError,
+                   "a streamed Sound must be an uncompressed WAV file");
+        return -1;
+    }
+
+    stream->block_len = STREAM_BLOCK_FRAMES * stream->src_frame;
+    stream->block_room = stream->block_len * stream->cvt.len_mult;
+    size = stream->freq * stream->frame / 2;
+    size = MAX (size, 4 * stream->block_room);
+    size = MAX (size, (Uint32) (4 * mixer_chunksize * stream->frame));
+    size -= size % stream->frame;
+    stream->size = size;
+    stream->block = (Uint8 *) malloc (stream->block_room);
+    stream->ring = (Uint8 *) malloc (size);
+    chunk = (Mix_Chunk *) malloc (sizeof (Mix_Chunk));
+    if (!stream->block || !stream->ring || !chunk)
+    {
+        free (chunk);
+        _stream_free (stream);
+        PyErr_NoMemory ();
+        return -1;
+    }
+    _stream_silence (stream->ring, size, stream->format);
+    chunk->allocated = 0;
+    chunk->abuf = stream->ring;
+    chunk->alen = size;
+    chunk->volume = MIX_MAX_VOLUME;
+
+    SDL_LockMutex (stream_lock);
+    stream->next = stream_list;
+    if (stream_list)
+        stream_list->prev = stream;
+    stream_list = stream;
+    SDL_UnlockMutex (stream_lock);
+    soundobj->stream = stream;
+    soundobj->chunk = chunk;
+    return 0;
+}
+
+/* Play the stream of soundobj from the start on channelnum, or a free
+   channel for -1. Returns the channel, -1 if none was free, or -2 with
+   an exception set. */
+static int
+_stream_play (PySoundObject *soundobj, int channelnum, int loops,
+              int playtime, int fade_ms)
+{
+    SoundStream *stream = soundobj->stream;
+    int freq, channels, release, ok;
+    Uint16 format;
+
+    if (!Mix_QuerySpec (&freq, &format, &channels))
+    {
+        RAISE (PyExc_SDLError, "mixer system not initialized");
+        return -2;
+    }
+    if (freq != stream->freq || format != stream->format ||
+        channels != stream->channels)
+    {
+        RAISE (PyExc_SDLError,
+               "the mixer format changed since the Sound was made");
+        return -2;
+    }
+    if (_stream_start_thread ())
+        return -2;
+
+    /* A stream plays on one channel at a time */
+    SDL_LockAudio ();
+    if (stream->playing)
+        Mix_HaltChannel (stream->channel);
+    SDL_UnlockAudio ();
+
+    /* Take the stream from the stream thread to start it over */
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex (stream_lock);
+    while (stream->busy)
+    {
+        SDL_UnlockMutex (stream_lock);
+        SDL_Delay (1);
+        SDL_LockMutex (stream_lock);
+    }
+    stream->busy = 1;
+    SDL_UnlockMutex (stream_lock);
+    Py_END_ALLOW_THREADS;
+
+    stream->data_left = stream->data_len;
+    stream->loops = loops;
+    stream->written = 0;
+    stream->played = 0;
+    stream->ended = 0;
+    stream->expiring = 0;
+    _stream_silence (stream->ring, stream->size, stream->format);
+    release = !RWopsCheckObjectThreaded (stream->rw);
+    if (release)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        ok = SDL_RWseek (stream->rw, stream->data_start, RW_SEEK_SET) >= 0;
+        while (ok && _stream_fill_block (stream));
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        ok = SDL_RWseek (stream->rw, stream->data_start, RW_SEEK_SET) >= 0;
+        while (ok && _stream_fill_block (stream));
+    }
+
+    if (ok)
+    {
+        SDL_LockAudio ();
+        if (fade_ms > 0)
+            channelnum = Mix_FadeInChannelTimed (channelnum, soundobj->chunk,
+                                                 -1, fade_ms, playtime);
+        else
+            channelnum = Mix_PlayChannelTimed (channelnum, soundobj->chunk,
+                                               -1, playtime);
+        if (channelnum != -1)
+        {
+            if (Mix_RegisterEffect (channelnum, _stream_effect, _stream_done,
+                                    stream))
+            {
+                stream->channel = channelnum;
+                stream->playing = 1;
+                _dsp_attach (channelnum);
+            }
+            else
+            {
+                Mix_HaltChannel (channelnum);
+                ok = 0;
+            }
+        }
+        SDL_UnlockAudio ();
+    }
+
+    SDL_LockMutex (stream_lock);
+    stream->busy = 0;
+    SDL_UnlockMutex (stream_lock);
+    SDL_SemPost (stream_wake);
+    if (!ok)
+    {
+        if (!PyErr_Occurred ())
+            RAISE (PyExc_SDLError, SDL_GetError ());
+        return -2;
+    }
+    return channelnum;
+}
+
+/* How loud a channel plays, for the 'quietest' steal policy */
+static float
+_channel_loudness (int channel)
+{
+    struct ChannelDSP *dsp = channeldata[channel].dsp;
+    PyObject *sound = channeldata[channel].sound;
+    float loudness = (float) Mix_Volume (channel, -1);
+
+    if (sound && PySound_AsChunk (sound))
+        loudness *= Mix_VolumeChunk (PySound_AsChunk (sound), -1);
+    if (dsp)
+        loudness *= MAX (dsp->params.gain[0], dsp->params.gain[1]);
+    return loudness;
+}
+
+/* If the playing channel a is a better one to take over than b, by the
+   policy; the older wins a tie */
+static int
+_channel_steal_before (int policy, int a, int b)
+{
+    Uint32 now = SDL_GetTicks ();
+    int pa, pb;
+    float la, lb;
+
+    if (policy == STEAL_QUIETEST)
+    {
+        la = _channel_loudness (a);
+        lb = _channel_loudness (b);
+        if (la != lb)
+            return la < lb;
+    }
+    else if (policy == STEAL_PRIORITY)
+    {
+        pa = channeldata[a].sound ?
+            ((PySoundObject*) channeldata[a].sound)->priority : 0;
+        pb = channeldata[b].sound ?
+            ((PySoundObject*) channeldata[b].sound)->priority : 0;
+        if (pa != pb)
+            return pa < pb;
+    }
+    return now - channeldata[a].start > now - channeldata[b].start;
+}
+
+/* The channel to take over for a sound of the given priority, with the
+   audio locked: any channel not playing first, then the one the policy
+   picks, or -1. With owner, only the channels playing that Sound. This
+   looks at every channel, so is only used when free_channels is empty. */
+static int
+_channel_steal (int policy, int priority, PyObject *owner)
+{
+    int i, best = -1;
+    PyObject *sound;
+
+    for (i = mixer_reserved; i < mixer_numchans; ++i)
+    {
+        sound = channeldata[i].sound;
+        if (owner)
+        {
+            if (sound != owner)
+                continue;
+        }
+        else if (!Mix_Playing (i))
+        {
+            _channel_take (i);
+            return i;
+        }
+        if (policy == STEAL_NONE)
+            continue;
+        if (policy == STEAL_PRIORITY && !owner && sound &&
+            ((PySoundObject*) sound)->priority > priority)
+            continue;
+        if (best == -1 || _channel_steal_before (policy, i, best))
+            best = i;
+    }
+    return best;
+}
+
+/* The channel a Sound plays on next, with the audio locked: one of its
+   own when it plays max_instances times already, else a free one, else
+   one taken from another Sound by the steal policy. -1 for none. */
+static int
+_channel_for_sound (PySoundObject *soundobj)
+{
+    int channel;
+
+    if (soundobj->max_instances > 0 &&
+        soundobj->playing >= soundobj->max_instances)
+    {
+        return _channel_steal (steal_policy == STEAL_NONE ?
+                               STEAL_OLDEST : steal_policy,
+                               soundobj->priority, (PyObject*) soundobj);
     }
-    if (!request_chunksize) {
-    request_chunksize = PYGAME_MIXER_DEFAULT_CHUNKSIZE;
+    while (numfree > 0)
+    {
+        channel = free_channels[numfree - 1];
+        _channel_take (channel);
+        if (!Mix_Playing (channel))
+            return channel;
     }
-    Py_RETURN_NONE;
+    return _channel_steal (steal_policy, soundobj->priority, NULL);
+}
+
+/* Makes a channel about to play another Sound stop what it plays now,
+   without starting its queue or counting it against max_instances */
+static void
+_channel_clear (int channel)
+{
+    PyObject *queue = channeldata[channel].queue;
+
+    channeldata[channel].queue = NULL;
+    if (Mix_Playing (channel))
+        Mix_HaltChannel (channel);
+    Py_XDECREF (queue);
+    _channel_take (channel);
 }
 
+
 /* sound object methods */
 
 static PyObject*
 snd_play (PyObject* self, PyObject* args, PyObject* kwargs)
 {
-    Mix_Chunk* chunk = PySound_AsChunk (self);
-    int channelnum = -1;
+    Mix_Chunk* chunk;
+    PyObject* old = NULL;
+    int channelnum = -1, freechannel;
     int loops = 0, playtime = -1, fade_ms = 0;
 
     char *kwids[] = { "loops", "maxtime", "fade_ms", NULL };
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iii", kwids, &loops, &playtime, &fade_ms))
        return NULL;
+    chunk = _sound_chunk (self);
+    if (!chunk)
+        return NULL;
+
+    /* The Sound goes on the channel before it plays, so a short one
+       ending at once finds it there */
+    SDL_LockAudio ();
+    channelnum = _channel_for_sound ((PySoundObject*) self);
+    if (channelnum != -1)
+    {
+        _channel_clear (channelnum);
+        Py_INCREF (self);
+        old = _channel_set_sound (channelnum, self);
+    }
+    SDL_UnlockAudio ();
+    if (channelnum == -1)
+        Py_RETURN_NONE;
+    Py_XDECREF (old);
+    freechannel = channelnum;
 
-    if (fade_ms > 0)
+    if (((PySoundObject*) self)->stream)
     {
-        channelnum = Mix_FadeInChannelTimed (-1, chunk, loops, fade_ms, playtime);
+        channelnum = _stream_play ((PySoundObject*) self, channelnum, loops,
+                                   playtime, fade_ms);
     }
     else
     {
-        channelnum = Mix_PlayChannelTimed (-1, chunk, loops, playtime);
+        /* Locked so the first buffer already goes through any effects */
+        SDL_LockAudio ();
+        if (fade_ms > 0)
+        {
+            channelnum = Mix_FadeInChannelTimed (channelnum, chunk, loops, fade_ms, playtime);
+        }
+        else
+        {
+            channelnum = Mix_PlayChannelTimed (channelnum, chunk, loops, playtime);
+        }
+        _dsp_attach (channelnum);
+        SDL_UnlockAudio ();
     }
-    if (channelnum == -1)
+    if (channelnum < 0)
+    {
+        SDL_LockAudio ();
+        old = _channel_set_sound (freechannel, NULL);
+        _channel_free (freechannel);
+        SDL_UnlockAudio ();
+        Py_XDECREF (old);
+        if (channelnum == -2)
+            return NULL;
         Py_RETURN_NONE;
-
-    Py_XDECREF (channeldata[channelnum].sound);
-    Py_XDECREF (channeldata[channelnum].queue);
-    channeldata[channelnum].queue = NULL;
-    channeldata[channelnum].sound = self;
-    Py_INCREF (self);
+    }
 
     //make sure volume on this arbitrary channel is set to full
     Mix_Volume (channelnum, 128);
@@ -546,6 +1779,42 @@ snd_get_num_channels (PyObject* self)
     return PyInt_FromLong (Mix_GroupCount ((intptr_t)chunk));
 }
 
+static PyObject*
+snd_set_priority (PyObject* self, PyObject* args)
+{
+    int priority;
+    if (!PyArg_ParseTuple (args, "i", &priority))
+        return NULL;
+
+    ((PySoundObject*) self)->priority = priority;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+snd_get_priority (PyObject* self)
+{
+    return PyInt_FromLong (((PySoundObject*) self)->priority);
+}
+
+static PyObject*
+snd_set_max_instances (PyObject* self, PyObject* args)
+{
+    int count;
+    if (!PyArg_ParseTuple (args, "i", &count))
+        return NULL;
+    if (count < 0)
+        return RAISE (PyExc_ValueError, "count must not be negative");
+
+    ((PySoundObject*) self)->max_instances = count;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+snd_get_max_instances (PyObject* self)
+{
+    return PyInt_FromLong (((PySoundObject*) self)->max_instances);
+}
+
 static PyObject*
 snd_fadeout (PyObject* self, PyObject* args)
 {
@@ -572,13 +1841,16 @@ snd_stop (PyObject* self)
 static PyObject*
 snd_set_volume (PyObject* self, PyObject* args)
 {
-    Mix_Chunk* chunk = PySound_AsChunk (self);
+    Mix_Chunk* chunk;
     float volume;
 
     if (!PyArg_ParseTuple (args, "f", &volume))
         return NULL;
 
     MIXER_INIT_CHECK ();
+    chunk = _sound_chunk (self);
+    if (!chunk)
+        return NULL;
 
     Mix_VolumeChunk (chunk, (int)(volume*128));
     Py_RETURN_NONE;
@@ -587,9 +1859,12 @@ snd_set_volume (PyObject* self, PyObject* args)
 static PyObject*
 snd_get_volume (PyObject* self)
 {
-    Mix_Chunk* chunk = PySound_AsChunk (self);
+    Mix_Chunk* chunk;
     int volume;
     MIXER_INIT_CHECK ();
+    chunk = _sound_chunk (self);
+    if (!chunk)
+        return NULL;
 
     volume = Mix_VolumeChunk (chunk, -1);
     return PyFloat_FromDouble (volume / 128.0);
@@ -598,10 +1873,17 @@ snd_get_volume (PyObject* self)
 static PyObject*
 snd_get_length (PyObject* self)
 {
-    Mix_Chunk* chunk = PySound_AsChunk (self);
+    Mix_Chunk* chunk;
+    SoundStream* stream = ((PySoundObject*) self)->stream;
     int freq, channels, mixerbytes, numsamples;
     Uint16 format;
     MIXER_INIT_CHECK ();
+    if (stream)
+        return PyFloat_FromDouble ((double) stream->data_len /
+                                   stream->src_frame / stream->src_rate);
+    chunk = _sound_chunk (self);
+    if (!chunk)
+        return NULL;
 
     Mix_QuerySpec (&freq, &format, &channels);
     if (format==AUDIO_S8 || format==AUDIO_U8)
@@ -613,17 +1895,126 @@ snd_get_length (PyObject* self)
     return PyFloat_FromDouble ((float)numsamples / (float)freq);
 }
 
+static void
+snd_release_raw_buffer (Py_buffer* view_p)
+{
+    PyObject* obj = view_p->obj;
+
+    PyMem_Free (view_p->internal);
+    view_p->internal = NULL;
+    view_p->obj = NULL;
+    Py_DECREF (obj);
+}
+
+/* exports the samples as read-only bytes, for get_raw(copy=False) */
+static int
+snd_get_raw_buffer (PyObject* obj, Py_buffer* view_p, int flags)
+{
+    static char format[] = "B";
+    Mix_Chunk* chunk;
+    Py_ssize_t* internal;
+
+    view_p->obj = NULL;
+    if (PyBUF_HAS_FLAG (flags, PyBUF_WRITABLE))
+    {
+        PyErr_SetString (PgExc_BufferError,
+                         "the raw samples view is read-only");
+        return -1;
+    }
+    chunk = _sound_chunk (obj);
+    if (!chunk)
+        return -1;
+    internal = PyMem_New (Py_ssize_t, 2);
+    if (!internal)
+    {
+        PyErr_NoMemory ();
+        return -1;
+    }
+    view_p->buf = chunk->abuf;
+    view_p->len = (Py_ssize_t) chunk->alen;
+    view_p->readonly = 1;
+    view_p->itemsize = 1;
+    view_p->format = PyBUF_HAS_FLAG (flags, PyBUF_FORMAT) ? format : NULL;
+    view_p->ndim = 1;
+    internal[0] = view_p->len;
+    internal[1] = 1;
+    view_p->shape = PyBUF_HAS_FLAG (flags, PyBUF_ND) ? internal : NULL;
+    view_p->strides = PyBUF_HAS_FLAG (flags, PyBUF_STRIDES) ? internal + 1
+                                                            : NULL;
+    view_p->suboffsets = NULL;
+    view_p->internal = internal;
+    ((Pg_buffer*) view_p)->release_buffer = snd_release_raw_buffer;
+    Py_INCREF (obj);
+    view_p->obj = obj;
+    return 0;
+}
+
 static PyObject*
-snd_get_raw (PyObject* self)
+snd_get_raw (PyObject* self, PyObject* args, PyObject* kwargs)
 {
-    Mix_Chunk* chunk = PySound_AsChunk (self);
+    Mix_Chunk* chunk;
+    int copy = 1;
+
+    char *kwids[] = { "copy", NULL };
+    if (!PyArg_ParseTupleAndKeywords (args, kwargs, "|i", kwids, &copy))
+        return NULL;
 
     MIXER_INIT_CHECK ();
+    if (((PySoundObject*) self)->stream)
+        return RAISE (PyExc_SDLError, "a streamed Sound has no samples");
+    chunk = _sound_chunk (self);
+    if (!chunk)
+        return NULL;
 
+    if (!copy)
+        return PgBufproxy_New (self, snd_get_raw_buffer);
     return Bytes_FromStringAndSize ((const char *)chunk->abuf,
                                     (Py_ssize_t)chunk->alen);
 }
 
+static PyObject*
+snd_write (PyObject* self, PyObject* args)
+{
+    PySoundObject* soundobj = (PySoundObject*) self;
+    PySoundObject* baseobj;
+    PyObject* obj;
+    Pg_buffer pg_view;
+    Py_buffer* view = (Py_buffer*) &pg_view;
+    Mix_Chunk* chunk;
+    Py_ssize_t offset;
+
+    if (!PyArg_ParseTuple (args, "nO", &offset, &obj))
+        return NULL;
+
+    MIXER_INIT_CHECK ();
+    if (soundobj->stream)
+        return RAISE (PyExc_SDLError, "a streamed Sound has no samples");
+    if (_sound_readonly (self))
+        return RAISE (PyExc_SDLError, "the Sound samples are read-only");
+    chunk = _sound_chunk (self);
+    if (!chunk)
+        return NULL;
+
+    /* The audio thread must not be reading what changes */
+    baseobj = soundobj->base ? (PySoundObject*) soundobj->base : soundobj;
+    if (soundobj->playing || baseobj->playing)
+        return RAISE (PyExc_SDLError, "cannot write to a playing Sound");
+
+    view->obj = NULL;
+    if (PgObject_GetBuffer (obj, &pg_view, PyBUF_SIMPLE))
+        return NULL;
+    if (offset < 0 || view->len > (Py_ssize_t) chunk->alen - offset)
+    {
+        PgBuffer_Release (&pg_view);
+        return RAISE (PyExc_ValueError, "write outside of the Sound");
+    }
+    Py_BEGIN_ALLOW_THREADS;
+    memcpy (chunk->abuf + offset, view->buf, view->len);
+    Py_END_ALLOW_THREADS;
+    PgBuffer_Release (&pg_view);
+    Py_RETURN_NONE;
+}
+
 static PyObject*
 snd_get_arraystruct (PyObject* self, void* closure)
 {
@@ -657,9 +2048,16 @@ snd_get_arrayinterface (PyObject* self, void* closure)
 static PyObject *
 snd_get_samples_address(PyObject *self, PyObject *closure)
 {
-    Mix_Chunk *chunk = PySound_AsChunk(self);
+    Mix_Chunk *chunk;
 
     MIXER_INIT_CHECK();
+    if (((PySoundObject *)self)->stream) {
+        return RAISE(PyExc_SDLError, "a streamed Sound has no samples");
+    }
+    chunk = _sound_chunk(self);
+    if (!chunk) {
+        return NULL;
+    }
 
 #if SIZEOF_VOID_P > SIZEOF_LONG
     return PyLong_FromUnsignedLongLong((unsigned PY_LONG_LONG)chunk->abuf);
@@ -668,12 +2066,77 @@ snd_get_samples_address(PyObject *self, PyObject *closure)
 #endif
 }
 
+static PyObject*
+snd_subsound (PyObject* self, PyObject* args)
+{
+    PySoundObject* soundobj = (PySoundObject*) self;
+    PySoundObject* sub;
+    Mix_Chunk* chunk;
+    Mix_Chunk* subchunk;
+    int freq, channels, itemsize;
+    Uint16 format;
+    Py_ssize_t start, length = -1, frames;
+
+    if (!PyArg_ParseTuple (args, "n|n", &start, &length))
+        return NULL;
+
+    MIXER_INIT_CHECK ();
+    if (soundobj->stream)
+        return RAISE (PyExc_SDLError, "a streamed Sound has no samples");
+    chunk = _sound_chunk (self);
+    if (!chunk)
+        return NULL;
+    Mix_QuerySpec (&freq, &format, &channels);
+    itemsize = _format_itemsize (format);
+    if (itemsize < 0)
+        return NULL;
+
+    frames = chunk->alen / (itemsize * channels);
+    if (length < 0)
+        length = frames - start;
+    if (start < 0 || start > frames || length < 0 || length > frames - start)
+        return RAISE (PyExc_ValueError, "subsound outside of the Sound");
+    subchunk = Mix_QuickLoad_RAW (chunk->abuf + start * itemsize * channels,
+                                  (Uint32) (length * itemsize * channels));
+    if (!subchunk)
+        return PyErr_NoMemory ();
+    sub = (PySoundObject*) PySound_New (subchunk);
+    if (!sub)
+    {
+        Mix_FreeChunk (subchunk);
+        return NULL;
+    }
+    /* The Sound owning the samples */
+    sub->base = soundobj->base ? soundobj->base : self;
+    Py_INCREF (sub->base);
+    return (PyObject*) sub;
+}
+
+/* If the samples of a Sound are lent read only by the object exporting
+   them */
+static int
+_sound_readonly (PyObject* self)
+{
+    PySoundObject* soundobj = (PySoundObject*) self;
+
+    if (soundobj->base)
+        soundobj = (PySoundObject*) soundobj->base;
+    return soundobj->view && ((Py_buffer*) soundobj->view)->readonly;
+}
+
 PyMethodDef sound_methods[] =
 {
     { "play", (PyCFunction) snd_play, METH_VARARGS | METH_KEYWORDS,
       DOC_SOUNDPLAY },
     { "get_num_channels", (PyCFunction) snd_get_num_channels, METH_NOARGS,
       DOC_SOUNDGETNUMCHANNELS },
+    { "set_priority", snd_set_priority, METH_VARARGS, DOC_SOUNDSETPRIORITY },
+    { "get_priority", (PyCFunction) snd_get_priority, METH_NOARGS,
+      DOC_SOUNDGETPRIORITY },
+    { "set_max_instances", snd_set_max_instances, METH_VARARGS,
+      DOC_SOUNDSETMAXINSTANCES },
+    { "get_max_instances", (PyCFunction) snd_get_max_instances, METH_NOARGS,
+      DOC_SOUNDGETMAXINSTANCES },
     { "fadeout", snd_fadeout, METH_VARARGS, DOC_SOUNDFADEOUT },
     { "stop", (PyCFunction) snd_stop, METH_NOARGS, DOC_SOUNDSTOP },
     { "set_volume", snd_set_volume, METH_VARARGS, DOC_SOUNDSETVOLUME },
@@ -681,8 +2144,10 @@ PyMethodDef sound_methods[] =
       DOC_SOUNDGETVOLUME },
     { "get_length", (PyCFunction) snd_get_length, METH_NOARGS,
       DOC_SOUNDGETLENGTH },
-    { "get_raw", (PyCFunction) snd_get_raw, METH_NOARGS,
+    { "get_raw", (PyCFunction) snd_get_raw, METH_VARARGS | METH_KEYWORDS,
       DOC_SOUNDGETRAW },
+    { "write", snd_write, METH_VARARGS, DOC_SOUNDWRITE },
+    { "subsound", snd_subsound, METH_VARARGS, DOC_SOUNDSUBSOUND },
     { NULL, NULL, 0, NULL }
 };
 
@@ -741,7 +2206,7 @@ snd_buffer_iteminfo(char **format, Py_ssize_t *itemsize, int *channels)
 static int
 snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
 {
-    Mix_Chunk *chunk = PySound_AsChunk(obj);
+    Mix_Chunk *chunk;
     int channels;
     char *format;
     int ndim = 0;
@@ -751,6 +2216,14 @@ snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
     Py_ssize_t samples;
 
     view->obj = 0;
+    if (((PySoundObject *)obj)->stream) {
+        PyErr_SetString(PgExc_BufferError, "a streamed Sound has no samples");
+        return -1;
+    }
+    chunk = _sound_chunk(obj);
+    if (!chunk) {
+        return -1;
+    }
     if (snd_buffer_iteminfo(&format, &itemsize, &channels)) {
         return -1;
     }
@@ -780,7 +2253,7 @@ snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
     view->obj = obj;
     view->buf = chunk->abuf;
     view->len = (Py_ssize_t)chunk->alen;
-    view->readonly = 0;
+    view->readonly = _sound_readonly(obj);
     view->itemsize = itemsize;
     view->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? format : 0;
     view->ndim = ndim;
@@ -827,8 +2300,17 @@ sound_dealloc (PySoundObject* self)
     Mix_Chunk* chunk = PySound_AsChunk ((PyObject*)self);
     if (chunk)
         Mix_FreeChunk (chunk);
+    if (self->stream)
+        _stream_release (self->stream);
     if (self->mem)
         PyMem_Free (self->mem);
+    if (self->view)
+    {
+        PgBuffer_Release (self->view);
+        PyMem_Del (self->view);
+    }
+    Py_XDECREF (self->base);
+    Py_XDECREF (self->encoded);
     if (self->weakreflist)
         PyObject_ClearWeakRefs ((PyObject*)self);
     Py_TYPE(self)->tp_free ((PyObject*)self);
@@ -886,6 +2368,7 @@ chan_play (PyObject* self, PyObject* args, PyObject* kwargs)
 {
     int channelnum = PyChannel_AsInt (self);
     PyObject* sound;
+    PyObject* old;
     Mix_Chunk* chunk;
     int loops = 0, playtime = -1, fade_ms = 0;
 
@@ -893,24 +2376,48 @@ chan_play (PyObject* self, PyObject* args, PyObject* kwargs)
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|iii", kwids, &PySound_Type, &sound,
                                      &loops, &playtime, &fade_ms))
        return NULL;
-    chunk = PySound_AsChunk (sound);
+    chunk = _sound_chunk (sound);
+    if (!chunk)
+        return NULL;
+
+    SDL_LockAudio ();
+    _channel_clear (channelnum);
+    Py_INCREF (sound);
+    old = _channel_set_sound (channelnum, sound);
+    SDL_UnlockAudio ();
+    Py_XDECREF (old);
 
-    if (fade_ms > 0)
+    if (((PySoundObject*) sound)->stream)
     {
-        channelnum = Mix_FadeInChannelTimed (channelnum, chunk, loops, fade_ms, playtime);
+        channelnum = _stream_play ((PySoundObject*) sound, channelnum, loops,
+                                   playtime, fade_ms);
     }
     else
     {
-        channelnum = Mix_PlayChannelTimed (channelnum, chunk, loops, playtime);
+        SDL_LockAudio ();
+        if (fade_ms > 0)
+        {
+            channelnum = Mix_FadeInChannelTimed (channelnum, chunk, loops, fade_ms, playtime);
+        }
+        else
+        {
+            channelnum = Mix_PlayChannelTimed (channelnum, chunk, loops, playtime);
+        }
+        _dsp_attach (channelnum);
+        SDL_UnlockAudio ();
+    }
+    if (channelnum < 0)
+    {
+        SDL_LockAudio ();
+        old = _channel_set_sound (PyChannel_AsInt (self), NULL);
+        _channel_free (PyChannel_AsInt (self));
+        SDL_UnlockAudio ();
+        Py_XDECREF (old);
+        if (channelnum == -2)
+            return NULL;
+        Py_RETURN_NONE;
     }
-    if (channelnum != -1)
-        Mix_GroupChannel (channelnum, (intptr_t)chunk);
-
-    Py_XDECREF (channeldata[channelnum].sound);
-    Py_XDECREF (channeldata[channelnum].queue);
-    channeldata[channelnum].sound = sound;
-    channeldata[channelnum].queue = NULL;
-    Py_INCREF (sound);
+    Mix_GroupChannel (channelnum, (intptr_t)chunk);
     Py_RETURN_NONE;
 }
 
@@ -923,16 +2430,28 @@ chan_queue (PyObject* self, PyObject* args)
 
     if (!PyArg_ParseTuple (args, "O!", &PySound_Type, &sound))
         return NULL;
-    chunk = PySound_AsChunk (sound);
+    if (((PySoundObject*) sound)->stream)
+        return RAISE (PyExc_SDLError, "a streamed Sound cannot be queued");
+    chunk = _sound_chunk (sound);
+    if (!chunk)
+        return NULL;
 
     if (!channeldata[channelnum].sound) /*nothing playing*/
     {
-        channelnum = Mix_PlayChannelTimed (channelnum, chunk, 0, -1);
-        if (channelnum != -1)
-            Mix_GroupChannel (channelnum, (intptr_t)chunk);
-
-        channeldata[channelnum].sound = sound;
+        SDL_LockAudio ();
         Py_INCREF (sound);
+        _channel_set_sound (channelnum, sound);
+        if (Mix_PlayChannelTimed (channelnum, chunk, 0, -1) != -1)
+        {
+            _channel_take (channelnum);
+            _dsp_attach (channelnum);
+            Mix_GroupChannel (channelnum, (intptr_t)chunk);
+            sound = NULL;
+        }
+        else
+            _channel_set_sound (channelnum, NULL);
+        SDL_UnlockAudio ();
+        Py_XDECREF (sound);
     }
     else
     {
@@ -1063,56 +2582,284 @@ chan_get_volume (PyObject* self)
 
     volume = Mix_Volume (channelnum, -1);
 
-    return PyFloat_FromDouble (volume / 128.0);
+    return PyFloat_FromDouble (volume / 128.0);
+}
+
+static PyObject*
+chan_get_sound (PyObject* self)
+{
+    int channelnum = PyChannel_AsInt (self);
+    PyObject* sound;
+
+    sound = channeldata[channelnum].sound;
+    if (!sound)
+        Py_RETURN_NONE;
+
+    Py_INCREF (sound);
+    return sound;
+}
+
+static PyObject*
+chan_get_queue(PyObject* self)
+{
+    int channelnum = PyChannel_AsInt (self);
+    PyObject* sound;
+
+    sound = channeldata[channelnum].queue;
+    if (!sound)
+        Py_RETURN_NONE;
+
+    Py_INCREF (sound);
+    return sound;
+}
+
+static PyObject*
+chan_set_endevent (PyObject* self, PyObject* args)
+{
+    int channelnum = PyChannel_AsInt (self);
+    int event = SDL_NOEVENT;
+
+    if (!PyArg_ParseTuple (args, "|i", &event))
+        return NULL;
+
+    channeldata[channelnum].endevent = event;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+chan_get_endevent (PyObject* self)
+{
+    int channelnum = PyChannel_AsInt (self);
+
+    return PyInt_FromLong (channeldata[channelnum].endevent);
+}
+
+/* The effect chain of a channel, made on first use; NULL with an
+   exception set if it cannot be */
+static struct ChannelDSP*
+_dsp_get (int channelnum)
+{
+    struct ChannelDSP *dsp;
+
+    if (!SDL_WasInit (SDL_INIT_AUDIO))
+        return (struct ChannelDSP*) RAISE (PyExc_SDLError,
+                                           "mixer system not initialized");
+    if (mixer_format != AUDIO_S16SYS)
+        return (struct ChannelDSP*)
+            RAISE (PyExc_SDLError,
+                   "Channel effects need a mixer of signed 16 bit samples");
+    if (channelnum < 0 || channelnum >= numchanneldata)
+        return (struct ChannelDSP*) RAISE (PyExc_IndexError,
+                                           "invalid channel index");
+    dsp = channeldata[channelnum].dsp;
+    if (dsp)
+        return dsp;
+    dsp = (struct ChannelDSP*) calloc (1, sizeof (struct ChannelDSP));
+    if (!dsp)
+        return (struct ChannelDSP*) PyErr_NoMemory ();
+    dsp->gain = 1.0f;
+    dsp->attenuation = 1.0f;
+    dsp->params.gain[0] = dsp->params.gain[1] = 1.0f;
+    dsp->active = dsp->params;
+    dsp->current[0] = dsp->current[1] = 1.0f;
+    SDL_LockAudio ();
+    channeldata[channelnum].dsp = dsp;
+    ++dsp_count;
+    _dsp_attach (channelnum);
+    SDL_UnlockAudio ();
+    return dsp;
+}
+
+static void
+_dsp_free (int channelnum)
+{
+    struct ChannelDSP *dsp = channeldata[channelnum].dsp;
+
+    if (!dsp)
+        return;
+    SDL_LockAudio ();
+    if (dsp->registered)
+        Mix_UnregisterEffect (channelnum, _dsp_effect);
+    channeldata[channelnum].dsp = NULL;
+    --dsp_count;
+    SDL_UnlockAudio ();
+    free (dsp);
+}
+
+/* Hand the audio thread new gains, reached over ramp_frames, and filter */
+static void
+_dsp_post (struct ChannelDSP *dsp, int ramp_frames)
+{
+    float left = dsp->gain * dsp->attenuation;
+    float right = left;
+
+    /* The far side fades out along a cosine */
+    if (mixer_channels == 2)
+    {
+        if (dsp->pan > 0.0f)
+            left *= (float) cos (dsp->pan * M_PI / 2.0);
+        else if (dsp->pan < 0.0f)
+            right *= (float) cos (dsp->pan * M_PI / 2.0);
+    }
+    ++dsp->seq;
+    MIXER_BARRIER ();
+    dsp->params.gain[0] = left;
+    dsp->params.gain[1] = right;
+    dsp->params.ramp_frames = ramp_frames;
+    ++dsp->params.gains;
+    MIXER_BARRIER ();
+    ++dsp->seq;
+}
+
+/* Pan and distance changes glide over 5 ms, or what is left of a gain
+   ramp if that is longer */
+static int
+_dsp_smooth_frames (struct ChannelDSP *dsp)
+{
+    Uint32 now = SDL_GetTicks ();
+    int frames = mixer_freq / 200;
+    int left;
+
+    if ((Sint32) (dsp->ramp_end - now) > 0)
+    {
+        left = (int) ((double) (dsp->ramp_end - now) * mixer_freq / 1000.0);
+        if (left > frames)
+            frames = left;
+    }
+    return frames;
+}
+
+static PyObject*
+chan_set_gain (PyObject* self, PyObject* args)
+{
+    struct ChannelDSP *dsp;
+    float gain, time = 0.0f;
+
+    if (!PyArg_ParseTuple (args, "f|f", &gain, &time))
+        return NULL;
+    if (gain < 0.0f)
+        return RAISE (PyExc_ValueError, "gain must not be negative");
+    if (time < 0.0f)
+        return RAISE (PyExc_ValueError, "time must not be negative");
+    dsp = _dsp_get (PyChannel_AsInt (self));
+    if (!dsp)
+        return NULL;
+
+    dsp->gain = MIN (gain, CHANNEL_DSP_MAX_GAIN);
+    dsp->ramp_end = SDL_GetTicks () + (Uint32) (time * 1000.0f);
+    _dsp_post (dsp, (int) (time * mixer_freq));
+    Py_RETURN_NONE;
 }
 
 static PyObject*
-chan_get_sound (PyObject* self)
+chan_set_pan (PyObject* self, PyObject* args)
 {
-    int channelnum = PyChannel_AsInt (self);
-    PyObject* sound;
+    struct ChannelDSP *dsp;
+    float pan;
 
-    sound = channeldata[channelnum].sound;
-    if (!sound)
-        Py_RETURN_NONE;
+    if (!PyArg_ParseTuple (args, "f", &pan))
+        return NULL;
+    dsp = _dsp_get (PyChannel_AsInt (self));
+    if (!dsp)
+        return NULL;
 
-    Py_INCREF (sound);
-    return sound;
+    dsp->pan = pan < -1.0f ? -1.0f : pan > 1.0f ? 1.0f : pan;
+    _dsp_post (dsp, _dsp_smooth_frames (dsp));
+    Py_RETURN_NONE;
 }
 
 static PyObject*
-chan_get_queue(PyObject* self)
+chan_set_distance (PyObject* self, PyObject* args)
 {
-    int channelnum = PyChannel_AsInt (self);
-    PyObject* sound;
+    struct ChannelDSP *dsp;
+    float distance, rolloff = 1.0f;
 
-    sound = channeldata[channelnum].queue;
-    if (!sound)
-        Py_RETURN_NONE;
+    if (!PyArg_ParseTuple (args, "f|f", &distance, &rolloff))
+        return NULL;
+    if (distance < 0.0f || rolloff < 0.0f)
+        return RAISE (PyExc_ValueError,
+                      "distance and rolloff must not be negative");
+    dsp = _dsp_get (PyChannel_AsInt (self));
+    if (!dsp)
+        return NULL;
 
-    Py_INCREF (sound);
-    return sound;
+    dsp->attenuation = 1.0f / (1.0f + rolloff * distance);
+    _dsp_post (dsp, _dsp_smooth_frames (dsp));
+    Py_RETURN_NONE;
 }
 
 static PyObject*
-chan_set_endevent (PyObject* self, PyObject* args)
+chan_set_filter (PyObject* self, PyObject* args, PyObject* kwargs)
 {
-    int channelnum = PyChannel_AsInt (self);
-    int event = SDL_NOEVENT;
-
-    if (!PyArg_ParseTuple (args, "|i", &event))
+    struct ChannelDSP *dsp;
+    const char *type = NULL;
+    double frequency = 1000.0, q = 0.7071067811865476;
+    double w0, cosw, alpha, a0;
+    float b0, b1, b2;
+    int filter;
+
+    static char *kwids[] = {"type", "frequency", "q", NULL};
+    if (!PyArg_ParseTupleAndKeywords (args, kwargs, "z|dd", kwids,
+                                      &type, &frequency, &q))
         return NULL;
-
-    channeldata[channelnum].endevent = event;
+    if (!type)
+        filter = 0;
+    else if (!strcmp (type, "lowpass"))
+        filter = CHANNEL_DSP_LOWPASS;
+    else if (!strcmp (type, "highpass"))
+        filter = CHANNEL_DSP_HIGHPASS;
+    else
+        return RAISE (PyExc_ValueError,
+                      "filter type must be 'lowpass', 'highpass' or None");
+    if (q <= 0.0)
+        return RAISE (PyExc_ValueError, "q must be positive");
+    dsp = _dsp_get (PyChannel_AsInt (self));
+    if (!dsp)
+        return NULL;
+    if (filter && (frequency <= 0.0 || frequency >= mixer_freq / 2.0))
+        return RAISE (PyExc_ValueError,
+                      "frequency must be between 0 and half the mixer "
+                      "frequency");
+
+    /* The lowpass and highpass of the Audio EQ Cookbook */
+    w0 = 2.0 * M_PI * frequency / mixer_freq;
+    cosw = cos (w0);
+    alpha = sin (w0) / (2.0 * q);
+    a0 = 1.0 + alpha;
+    if (filter == CHANNEL_DSP_HIGHPASS)
+    {
+        b0 = (float) ((1.0 + cosw) / 2.0 / a0);
+        b1 = (float) (-(1.0 + cosw) / a0);
+    }
+    else
+    {
+        b0 = (float) ((1.0 - cosw) / 2.0 / a0);
+        b1 = (float) ((1.0 - cosw) / a0);
+    }
+    b2 = b0;
+
+    ++dsp->seq;
+    MIXER_BARRIER ();
+    dsp->params.filter = filter;
+    dsp->params.b0 = b0;
+    dsp->params.b1 = b1;
+    dsp->params.b2 = b2;
+    dsp->params.a1 = (float) (-2.0 * cosw / a0);
+    dsp->params.a2 = (float) ((1.0 - alpha) / a0);
+    MIXER_BARRIER ();
+    ++dsp->seq;
     Py_RETURN_NONE;
 }
 
 static PyObject*
-chan_get_endevent (PyObject* self)
+chan_clear_effects (PyObject* self)
 {
     int channelnum = PyChannel_AsInt (self);
 
-    return PyInt_FromLong (channeldata[channelnum].endevent);
+    MIXER_INIT_CHECK ();
+    if (channelnum >= 0 && channelnum < numchanneldata)
+        _dsp_free (channelnum);
+    Py_RETURN_NONE;
 }
 
 static PyMethodDef channel_methods[] =
@@ -1129,6 +2876,14 @@ static PyMethodDef channel_methods[] =
     { "set_volume", chan_set_volume, METH_VARARGS, DOC_CHANNELSETVOLUME },
     { "get_volume", (PyCFunction) chan_get_volume, METH_NOARGS,
       DOC_CHANNELGETVOLUME },
+    { "set_gain", chan_set_gain, METH_VARARGS, DOC_CHANNELSETGAIN },
+    { "set_pan", chan_set_pan, METH_VARARGS, DOC_CHANNELSETPAN },
+    { "set_distance", chan_set_distance, METH_VARARGS,
+      DOC_CHANNELSETDISTANCE },
+    { "set_filter", (PyCFunction) chan_set_filter,
+      METH_VARARGS | METH_KEYWORDS, DOC_CHANNELSETFILTER },
+    { "clear_effects", (PyCFunction) chan_clear_effects, METH_NOARGS,
+      DOC_CHANNELCLEAREFFECTS },
 
     { "get_sound", (PyCFunction) chan_get_sound, METH_NOARGS,
       DOC_CHANNELGETSOUND },
@@ -1212,18 +2967,29 @@ set_num_channels (PyObject* self, PyObject* args)
     MIXER_INIT_CHECK ();
     if (numchans > numchanneldata)
     {
+        /* The audio thread reads channeldata too */
+        SDL_LockAudio ();
         channeldata = (struct ChannelData*)
             realloc (channeldata, sizeof (struct ChannelData) * numchans);
+        free_channels = (int*)
+            realloc (free_channels, sizeof (int) * numchans);
         for (i = numchanneldata; i < numchans; ++i)
         {
             channeldata[i].sound = NULL;
             channeldata[i].queue = NULL;
             channeldata[i].endevent = 0;
+            channeldata[i].dsp = NULL;
+            channeldata[i].start = 0;
+            channeldata[i].free_pos = -1;
         }
         numchanneldata = numchans;
+        SDL_UnlockAudio ();
     }
 
-    Mix_AllocateChannels (numchans);
+    SDL_LockAudio ();
+    mixer_numchans = Mix_AllocateChannels (numchans);
+    _channel_pool_reset ();
+    SDL_UnlockAudio ();
     Py_RETURN_NONE;
 }
 
@@ -1236,7 +3002,10 @@ set_reserved (PyObject* self, PyObject* args)
 
     MIXER_INIT_CHECK ();
 
-    Mix_ReserveChannels (numchans);
+    SDL_LockAudio ();
+    mixer_reserved = Mix_ReserveChannels (numchans);
+    _channel_pool_reset ();
+    SDL_UnlockAudio ();
     Py_RETURN_NONE;
 }
 
@@ -1270,16 +3039,58 @@ mixer_find_channel (PyObject* self, PyObject* args)
 
     MIXER_INIT_CHECK ();
 
-    chan = Mix_GroupAvailable (-1);
+    /* A free channel stays in free_channels until it plays */
+    SDL_LockAudio ();
+    chan = -1;
+    while (numfree > 0 && chan == -1)
+    {
+        chan = free_channels[numfree - 1];
+        if (Mix_Playing (chan))
+        {
+            _channel_take (chan);
+            chan = -1;
+        }
+    }
     if (chan == -1)
     {
-        if (!force)
-            Py_RETURN_NONE;
-        chan = Mix_GroupOldest (-1);
+        chan = _channel_steal (!force ? STEAL_NONE :
+                               steal_policy == STEAL_NONE ?
+                               STEAL_OLDEST : steal_policy, INT_MAX, NULL);
+        if (chan != -1 && !Mix_Playing (chan))
+            _channel_free (chan);
     }
+    SDL_UnlockAudio ();
+    if (chan == -1)
+        Py_RETURN_NONE;
     return PyChannel_New (chan);
 }
 
+static PyObject*
+set_steal_policy (PyObject* self, PyObject* args)
+{
+    char *name;
+    int i;
+
+    if (!PyArg_ParseTuple (args, "s", &name))
+        return NULL;
+
+    for (i = 0; steal_policies[i]; ++i)
+    {
+        if (!strcmp (name, steal_policies[i]))
+        {
+            steal_policy = i;
+            Py_RETURN_NONE;
+        }
+    }
+    return RAISE (PyExc_ValueError, "unknown steal policy");
+}
+
+static PyObject*
+get_steal_policy (PyObject* self)
+{
+    return Text_FromUTF8 (steal_policies[steal_policy]);
+}
+
 static PyObject*
 mixer_fadeout (PyObject* self, PyObject* args)
 {
@@ -1341,6 +3152,67 @@ _chunk_from_buf(const void *buf, Py_ssize_t len, Mix_Chunk **chunk, Uint8 **mem)
     return 0;
 }
 
+/* For copy=False: a chunk playing the memory of obj in place, with the
+   view of obj kept in *pview until the Sound goes. */
+static int
+_chunk_share(PyObject *obj, int is_array, Mix_Chunk **chunk,
+             Pg_buffer **pview)
+{
+    Pg_buffer *pg_view = PyMem_New(Pg_buffer, 1);
+    PG_sample_format_t view_format;
+    Py_buffer *view;
+    int freq;
+    Uint16 format;
+    int channels;
+
+    if (!pg_view) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    view = (Py_buffer *)pg_view;
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        PyMem_Del(pg_view);
+        RAISE(PyExc_SDLError, "Mixer not initialized");
+        return -1;
+    }
+    view->obj = 0;
+    if (PgObject_GetBuffer(obj, pg_view,
+                           is_array ? PyBUF_FORMAT | PyBUF_C_CONTIGUOUS :
+                                      PyBUF_SIMPLE)) {
+        PyMem_Del(pg_view);
+        return -1;
+    }
+    if (is_array) {
+        view_format = _format_view_to_audio(view);
+        if (!view_format) {
+            goto fail;
+        }
+        if (view->ndim != (channels == 1 ? 1 : 2) ||
+            (view->ndim == 2 && view->shape[1] != channels)) {
+            RAISE(PyExc_ValueError,
+                  "Array shape must match the mixer channels to share it");
+            goto fail;
+        }
+        if ((int)PG_SAMPLE_SIZE(view_format) != _format_itemsize(format)) {
+            RAISE(PyExc_ValueError,
+                  "Array items must be the mixer sample size to share them");
+            goto fail;
+        }
+    }
+    *chunk = Mix_QuickLoad_RAW((Uint8 *)view->buf, (Uint32)view->len);
+    if (!*chunk) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    *pview = pg_view;
+    return 0;
+
+fail:
+    PgBuffer_Release(pg_view);
+    PyMem_Del(pg_view);
+    return -1;
+}
+
 static int
 _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
                   Py_ssize_t *shape, Py_ssize_t *strides,
@@ -1489,6 +3361,52 @@ _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
     return 0;
 }
 
+/* The rest of the data of rw as bytes, read with the GIL released unless
+   rw calls into Python. Closes rw. */
+static PyObject*
+_read_encoded(SDL_RWops *rw)
+{
+    int release = !RWopsCheckObject(rw);
+    int start, end;
+    size_t nread = 1;
+    PyObject *bytes;
+
+    start = SDL_RWtell(rw);
+    end = SDL_RWseek(rw, 0, RW_SEEK_END);
+    if (start < 0 || end < start ||
+        SDL_RWseek(rw, start, RW_SEEK_SET) < 0) {
+        SDL_RWclose(rw);
+        if (!PyErr_Occurred()) {
+            RAISE(PyExc_SDLError, "Unable to seek in the sound file");
+        }
+        return NULL;
+    }
+    bytes = Bytes_FromStringAndSize(NULL, end - start);
+    if (bytes == NULL) {
+        SDL_RWclose(rw);
+        return NULL;
+    }
+    if (end > start) {
+        if (release) {
+            Py_BEGIN_ALLOW_THREADS;
+            nread = SDL_RWread(rw, Bytes_AS_STRING(bytes), end - start, 1);
+            Py_END_ALLOW_THREADS;
+        }
+        else {
+            nread = SDL_RWread(rw, Bytes_AS_STRING(bytes), end - start, 1);
+        }
+    }
+    SDL_RWclose(rw);
+    if (nread != 1) {
+        Py_DECREF(bytes);
+        if (!PyErr_Occurred()) {
+            RAISE(PyExc_SDLError, "Unable to read the sound file");
+        }
+        return NULL;
+    }
+    return bytes;
+}
+
 static int
 sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
 {
@@ -1500,18 +3418,57 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     PyObject *array = NULL;
     PyObject *keys;
     PyObject *kencoded;
+    PyObject *value;
     SDL_RWops *rw;
     Mix_Chunk *chunk = NULL;
     Uint8 *mem = NULL;
+    Py_ssize_t nkwargs = 0;
+    Py_ssize_t i;
+    int compressed = 0;
+    int stream = 0;
+    int copy = 1;
 
     ((PySoundObject *)self)->chunk = NULL;
     ((PySoundObject *)self)->mem = NULL;
+    ((PySoundObject *)self)->encoded = NULL;
+    ((PySoundObject *)self)->stream = NULL;
+    ((PySoundObject *)self)->view = NULL;
+    ((PySoundObject *)self)->base = NULL;
+
+    /* compressed, stream and copy go with any of the other arguments */
+    if (kwarg != NULL) {
+        nkwargs = PyDict_Size(kwarg);
+        value = PyDict_GetItemString(kwarg, "compressed");
+        if (value != NULL) {
+            compressed = PyObject_IsTrue(value);
+            if (compressed == -1) {
+                return -1;
+            }
+            --nkwargs;
+        }
+        value = PyDict_GetItemString(kwarg, "stream");
+        if (value != NULL) {
+            stream = PyObject_IsTrue(value);
+            if (stream == -1) {
+                return -1;
+            }
+            --nkwargs;
+        }
+        value = PyDict_GetItemString(kwarg, "copy");
+        if (value != NULL) {
+            copy = PyObject_IsTrue(value);
+            if (copy == -1) {
+                return -1;
+            }
+            --nkwargs;
+        }
+    }
 
     /* Process arguments, returning cleaner error messages than
        PyArg_ParseTupleAndKeywords would.
     */
     if (arg != NULL && PyTuple_GET_SIZE(arg)) {
-        if ((kwarg != NULL && PyDict_Size(kwarg)) || /* conditional and */
+        if (nkwargs || /* conditional and */
             PyTuple_GET_SIZE(arg) != 1)              {
             RAISE(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
@@ -1527,8 +3484,8 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             buffer = obj;
         }
     }
-    else if (kwarg != NULL) {
-        if (PyDict_Size(kwarg) != 1) {
+    else if (nkwargs) {
+        if (nkwargs != 1) {
             RAISE(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
         }
@@ -1539,16 +3496,25 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             if (keys == NULL) {
                 return -1;
             }
-            kencoded = RWopsEncodeString(PyList_GET_ITEM(keys, 0),
-                                         NULL, NULL, NULL);
-            Py_DECREF(keys);
-            if (kencoded == NULL) {
-                return -1;
+            for (i = 0; i < PyList_GET_SIZE(keys); ++i) {
+                kencoded = RWopsEncodeString(PyList_GET_ITEM(keys, i),
+                                             NULL, NULL, NULL);
+                if (kencoded == NULL) {
+                    Py_DECREF(keys);
+                    return -1;
+                }
+                if (strcmp(Bytes_AS_STRING(kencoded), "compressed") &&
+                    strcmp(Bytes_AS_STRING(kencoded), "stream") &&
+                    strcmp(Bytes_AS_STRING(kencoded), "copy")) {
+                    PyErr_Format(PyExc_TypeError,
+                                 "Unrecognized keyword argument '%.1024s'",
+                                 Bytes_AS_STRING(kencoded));
+                    Py_DECREF(kencoded);
+                    break;
+                }
+                Py_DECREF(kencoded);
             }
-            PyErr_Format(PyExc_TypeError,
-                         "Unrecognized keyword argument '%.1024s'",
-                         Bytes_AS_STRING(kencoded));
-            Py_DECREF(kencoded);
+            Py_DECREF(keys);
             return -1;
         }
         if (buffer != NULL && PyUnicode_Check(buffer)) { /* conditional and */
@@ -1562,6 +3528,46 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
         return -1;
     }
 
+    if (!copy) {
+        if (compressed || stream || (buffer == NULL && array == NULL)) {
+            RAISE(PyExc_TypeError,
+                  "only a buffer or array can be shared without a copy");
+            return -1;
+        }
+        if (_chunk_share(array ? array : buffer, array != NULL, &chunk,
+                         &((PySoundObject *)self)->view)) {
+            return -1;
+        }
+        ((PySoundObject *)self)->chunk = chunk;
+        return 0;
+    }
+
+    if (stream) {
+        if (compressed) {
+            RAISE(PyExc_TypeError,
+                  "a Sound cannot be both compressed and streamed");
+            return -1;
+        }
+        if (file == NULL) {
+            RAISE(PyExc_TypeError, "only a sound file can be streamed");
+            return -1;
+        }
+        return _stream_init((PySoundObject *)self, file);
+    }
+
+    if (compressed) {
+        if (file == NULL) {
+            RAISE(PyExc_TypeError, "only a sound file can be kept compressed");
+            return -1;
+        }
+        rw = RWopsFromObject(file);
+        if (rw == NULL) {
+            return -1;
+        }
+        ((PySoundObject *)self)->encoded = _read_encoded(rw);
+        return ((PySoundObject *)self)->encoded ? 0 : -1;
+    }
+
     if (file != NULL) {
         rw = RWopsFromObject(file);
         if (rw == NULL) {
@@ -1692,6 +3698,349 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     return 0;
 }
 
+/* mixer.load_many: the sound files are read, and unless kept compressed
+   decoded to the format of the mixer, by worker threads taking the next
+   file from a shared counter. The calling thread waits with the GIL
+   released and makes each Sound as its file is finished. */
+#define MIXER_LOAD_MANY_MAX_THREADS 16
+#define MIXER_LOAD_MANY_ERROR_SIZE 512
+
+typedef struct
+{
+    int             compressed; /* read the files without decoding them */
+    Py_ssize_t      count;
+    const char    **names;
+    Mix_Chunk     **chunks;     /* NULL where a file failed */
+    Uint8         **data;       /* compressed file contents, malloc'ed */
+    int            *sizes;
+    Py_ssize_t     *order;      /* indices of the files finished so far */
+    Py_ssize_t      nfinished;
+    Py_ssize_t      next;       /* next file a worker takes */
+    int             quit;       /* no more files are taken */
+    int             failed;     /* error holds the first loading error */
+    char            error[MIXER_LOAD_MANY_ERROR_SIZE];
+    SDL_mutex      *lock;       /* held for all of the above from next */
+    SDL_sem        *finished;   /* posted for each file finished */
+} MixerLoadMany;
+
+static int
+_load_many_cpu_count (void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO sysinfo;
+
+    GetSystemInfo (&sysinfo);
+    return (int) sysinfo.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf (_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (int) count : 1;
+#else
+    return 1;
+#endif
+}
+
+/* The whole of file name in malloc'ed memory, or NULL with the SDL error
+   set */
+static Uint8*
+_load_many_read (const char *name, int *size)
+{
+    SDL_RWops *rw = RWopsFromFileName (name);
+    Uint8 *data = NULL;
+    int end;
+
+    if (!rw)
+        return NULL;
+    end = SDL_RWseek (rw, 0, RW_SEEK_END);
+    if (end >= 0 && SDL_RWseek (rw, 0, RW_SEEK_SET) == 0)
+    {
+        data = (Uint8*) malloc (end ? end : 1);
+        if (!data)
+            SDL_SetError ("Out of memory");
+        else if (end && SDL_RWread (rw, data, end, 1) != 1)
+        {
+            free (data);
+            data = NULL;
+            SDL_SetError ("Unable to read file '%s'", name);
+        }
+    }
+    else
+        SDL_SetError ("Unable to seek in file '%s'", name);
+    SDL_RWclose (rw);
+    *size = end;
+    return data;
+}
+
+static int
+_load_many_worker (void *data)
+{
+    MixerLoadMany *job = (MixerLoadMany*) data;
+    Mix_Chunk *chunk = NULL;
+    Uint8 *contents = NULL;
+    SDL_RWops *rw;
+    Py_ssize_t i;
+    int size = 0, ok;
+
+    for (;;)
+    {
+        SDL_LockMutex (job->lock);
+        if (job->quit || job->next == job->count)
+        {
+            SDL_UnlockMutex (job->lock);
+            break;
+        }
+        i = job->next++;
+        SDL_UnlockMutex (job->lock);
+
+        if (job->compressed)
+        {
+            contents = _load_many_read (job->names[i], &size);
+            ok = contents != NULL;
+        }
+        else
+        {
+            rw = RWopsFromFileName (job->names[i]);
+            chunk = rw ? Mix_LoadWAV_RW (rw, 1) : NULL;
+            ok = chunk != NULL;
+        }
+
+        SDL_LockMutex (job->lock);
+        if (!ok && !job->failed)
+        {
+            /* SDL keeps an error message for each thread */
+            strncpy (job->error, SDL_GetError (),
+                     MIXER_LOAD_MANY_ERROR_SIZE - 1);
+            job->failed = 1;
+        }
+        job->chunks[i] = chunk;
+        job->data[i] = contents;
+        job->sizes[i] = size;
+        job->order[job->nfinished++] = i;
+        SDL_UnlockMutex (job->lock);
+        SDL_SemPost (job->finished);
+    }
+    return 0;
+}
+
+/* Stop the workers taking files; returns how many they took */
+static Py_ssize_t
+_load_many_quit (MixerLoadMany *job)
+{
+    Py_ssize_t taken;
+
+    SDL_LockMutex (job->lock);
+    job->quit = 1;
+    taken = job->next;
+    SDL_UnlockMutex (job->lock);
+    return taken;
+}
+
+/* A Sound keeping the bytes of a sound file, decoded on first use */
+static PyObject*
+_sound_new_encoded (PyObject *encoded)
+{
+    PySoundObject *soundobj;
+
+    soundobj = (PySoundObject *)PySound_Type.tp_new (&PySound_Type, NULL, NULL);
+    if (soundobj)
+    {
+        soundobj->chunk = NULL;
+        soundobj->mem = NULL;
+        soundobj->encoded = encoded;
+        Py_INCREF (encoded);
+    }
+    return (PyObject*)soundobj;
+}
+
+static PyObject*
+load_many (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyObject *paths, *seq = NULL, *encoded = NULL, *result = NULL;
+    PyObject *callback = Py_None, *soundobj, *bytes, *ret;
+    PyObject *item, *oencoded;
+    int event = SDL_NOEVENT, compressed = 0;
+    SDL_Thread *workers[MIXER_LOAD_MANY_MAX_THREADS];
+    int nworkers = 0, nthreads, n;
+    Py_ssize_t i, index, nread = 0, expected;
+    Mix_Chunk *chunk;
+    Uint8 *contents;
+    SDL_Event e;
+    MixerLoadMany job;
+    static char *kwids[] = {"paths", "callback", "event", "compressed",
+                            NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|Oii", kwids, &paths,
+                                      &callback, &event, &compressed))
+        return NULL;
+    if (callback != Py_None && !PyCallable_Check (callback))
+        return RAISE (PyExc_TypeError, "callback must be callable or None");
+    MIXER_INIT_CHECK ();
+
+    memset (&job, 0, sizeof (job));
+    job.compressed = compressed;
+    seq = PySequence_Fast (paths, "paths must be a sequence of file names");
+    if (!seq)
+        return NULL;
+    job.count = PySequence_Fast_GET_SIZE (seq);
+    encoded = PyList_New (job.count);
+    if (!encoded)
+        goto end;
+    for (i = 0; i < job.count; ++i)
+    {
+        item = PySequence_Fast_GET_ITEM (seq, i);
+        oencoded = RWopsEncodeFilePath (item, PyExc_SDLError);
+        if (!oencoded)
+            goto end;
+        if (oencoded == Py_None)
+        {
+            Py_DECREF (oencoded);
+            PyErr_Format (PyExc_TypeError,
+                          "Expected a file name: got %.1024s",
+                          Py_TYPE (item)->tp_name);
+            goto end;
+        }
+        PyList_SET_ITEM (encoded, i, oencoded);
+    }
+
+    result = PyList_New (job.count);
+    if (!result)
+        goto end;
+    n = job.count ? (int) job.count : 1;
+    job.names = PyMem_New (const char *, n);
+    job.chunks = PyMem_New (Mix_Chunk *, n);
+    job.data = PyMem_New (Uint8 *, n);
+    job.sizes = PyMem_New (int, n);
+    job.order = PyMem_New (Py_ssize_t, n);
+    if (!job.names || !job.chunks || !job.data || !job.sizes || !job.order)
+    {
+        PyErr_NoMemory ();
+        goto fail;
+    }
+    for (i = 0; i < job.count; ++i)
+    {
+        job.names[i] = Bytes_AS_STRING (PyList_GET_ITEM (encoded, i));
+        job.chunks[i] = NULL;
+        job.data[i] = NULL;
+    }
+    job.lock = SDL_CreateMutex ();
+    job.finished = SDL_CreateSemaphore (0);
+    if (!job.lock || !job.finished)
+    {
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+        goto fail;
+    }
+
+    nthreads = _load_many_cpu_count ();
+    if (nthreads > MIXER_LOAD_MANY_MAX_THREADS)
+        nthreads = MIXER_LOAD_MANY_MAX_THREADS;
+    if (nthreads > job.count)
+        nthreads = (int) job.count;
+    Py_BEGIN_ALLOW_THREADS;
+    for (n = 0; n < nthreads; ++n)
+    {
+        workers[n] = SDL_CreateThread (_load_many_worker, &job);
+        if (!workers[n])
+            break;
+        nworkers = n + 1;
+    }
+    if (!nworkers)
+        _load_many_worker (&job);
+    Py_END_ALLOW_THREADS;
+
+    /* Make the Sounds as they come in, until every file taken is done */
+    expected = job.count;
+    while (nread < expected)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_SemWait (job.finished);
+        Py_END_ALLOW_THREADS;
+        SDL_LockMutex (job.lock);
+        index = job.order[nread++];
+        chunk = job.chunks[index];
+        contents = job.data[index];
+        job.chunks[index] = NULL;
+        job.data[index] = NULL;
+        SDL_UnlockMutex (job.lock);
+
+        if (PyErr_Occurred () || job.quit)
+        {
+            /* Already failing; just drain */
+            if (chunk)
+                Mix_FreeChunk (chunk);
+            free (contents);
+            continue;
+        }
+        if (!chunk && !contents)
+        {
+            SDL_LockMutex (job.lock);
+            PyErr_SetString (PyExc_SDLError,
+                             job.failed ? job.error : SDL_GetError ());
+            SDL_UnlockMutex (job.lock);
+            expected = _load_many_quit (&job);
+            continue;
+        }
+        if (chunk)
+        {
+            soundobj = PySound_New (chunk);
+            if (!soundobj)
+                Mix_FreeChunk (chunk);
+        }
+        else
+        {
+            bytes = Bytes_FromStringAndSize ((const char *) contents,
+                                             job.sizes[index]);
+            free (contents);
+            soundobj = bytes ? _sound_new_encoded (bytes) : NULL;
+            Py_XDECREF (bytes);
+        }
+        if (!soundobj)
+        {
+            expected = _load_many_quit (&job);
+            continue;
+        }
+        PyList_SET_ITEM (result, index, soundobj);
+        if (event != SDL_NOEVENT && SDL_WasInit (SDL_INIT_VIDEO))
+        {
+            memset (&e, 0, sizeof (e));
+            e.type = event;
+            if (e.type >= SDL_USEREVENT && e.type < SDL_NUMEVENTS)
+                e.user.code = (int) index;
+            SDL_PushEvent (&e);
+        }
+        if (callback != Py_None)
+        {
+            ret = PyObject_CallFunction (callback, "nO", index, soundobj);
+            if (!ret)
+                expected = _load_many_quit (&job);
+            Py_XDECREF (ret);
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (n = 0; n < nworkers; ++n)
+        SDL_WaitThread (workers[n], NULL);
+    Py_END_ALLOW_THREADS;
+    if (PyErr_Occurred ())
+        goto fail;
+    goto end;
+
+fail:
+    Py_CLEAR (result);
+end:
+    if (job.finished)
+        SDL_DestroySemaphore (job.finished);
+    if (job.lock)
+        SDL_DestroyMutex (job.lock);
+    PyMem_Del (job.names);
+    PyMem_Del (job.chunks);
+    PyMem_Del (job.data);
+    PyMem_Del (job.sizes);
+    PyMem_Del (job.order);
+    Py_XDECREF (encoded);
+    Py_DECREF (seq);
+    return result;
+}
+
 static PyMethodDef _mixer_methods[] =
 {
     { "__PYGAMEinit__", autoinit, METH_VARARGS, "auto initialize for mixer" },
@@ -1701,6 +4050,12 @@ static PyMethodDef _mixer_methods[] =
     { "get_init", (PyCFunction) get_init, METH_NOARGS, DOC_PYGAMEMIXERGETINIT },
     { "pre_init", (PyCFunction) pre_init, METH_VARARGS | METH_KEYWORDS,
       DOC_PYGAMEMIXERPREINIT },
+    { "get_latency", (PyCFunction) get_latency, METH_NOARGS,
+      DOC_PYGAMEMIXERGETLATENCY },
+    { "get_callback_stats", (PyCFunction) get_callback_stats, METH_NOARGS,
+      DOC_PYGAMEMIXERGETCALLBACKSTATS },
+    { "reset_callback_stats", (PyCFunction) reset_callback_stats,
+      METH_NOARGS, DOC_PYGAMEMIXERRESETCALLBACKSTATS },
     { "get_num_channels", (PyCFunction) get_num_channels, METH_NOARGS,
       DOC_PYGAMEMIXERGETNUMCHANNELS },
     { "set_num_channels", set_num_channels, METH_VARARGS,
@@ -1709,6 +4064,10 @@ static PyMethodDef _mixer_methods[] =
 
     { "get_busy", (PyCFunction) get_busy, METH_NOARGS, DOC_PYGAMEMIXERGETBUSY },
     { "Channel", Channel, METH_VARARGS, DOC_PYGAMEMIXERCHANNEL },
+    { "set_steal_policy", set_steal_policy, METH_VARARGS,
+      DOC_PYGAMEMIXERSETSTEALPOLICY },
+    { "get_steal_policy", (PyCFunction) get_steal_policy, METH_NOARGS,
+      DOC_PYGAMEMIXERGETSTEALPOLICY },
     { "find_channel", mixer_find_channel, METH_VARARGS,
       DOC_PYGAMEMIXERFINDCHANNEL },
     { "fadeout", mixer_fadeout, METH_VARARGS, DOC_PYGAMEMIXERFADEOUT },
@@ -1716,6 +4075,8 @@ static PyMethodDef _mixer_methods[] =
     { "pause", (PyCFunction) mixer_pause, METH_NOARGS, DOC_PYGAMEMIXERPAUSE },
     { "unpause", (PyCFunction) mixer_unpause, METH_NOARGS,
       DOC_PYGAMEMIXERUNPAUSE },
+    { "load_many", (PyCFunction) load_many, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEMIXERLOADMANY },
 /*  { "lookup_frequency", lookup_frequency, 1, doc_lookup_frequency },*/
 
     { NULL, NULL, 0, NULL }
@@ -1785,6 +4146,10 @@ MODINIT_DEFINE (mixer)
     if (PyErr_Occurred ()) {
         MODINIT_ERROR;
     }
+    import_pygame_bufferproxy ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
 
     /* type preparation */
     if (PyType_Ready (&PySound_Type) < 0) {
@@ -1865,18 +4230,14 @@ MODINIT_DEFINE (mixer)
             MODINIT_ERROR;
         }
         _dict = PyModule_GetDict (music);
-        ptr = PyDict_GetItemString (_dict, "_MUSIC_POINTER");
-        current_music =
-            (Mix_Music**)PyCapsule_GetPointer (ptr, "pygame.music_mixer."
-                                                    "_MUSIC_POINTER");
-        ptr = PyDict_GetItemString (_dict, "_QUEUE_POINTER");
-        queue_music =
-            (Mix_Music**)PyCapsule_GetPointer (ptr, "pygame.music_mixer."
-                                                    "_QUEUE_POINTER");
+        ptr = PyDict_GetItemString (_dict, "_MUSIC_QUIT");
+        music_quit =
+            (void (*) (void))PyCapsule_GetPointer (ptr, "pygame.music_mixer."
+                                                        "_MUSIC_QUIT");
     }
     else /*music module not compiled? cleanly ignore*/
     {
-        current_music = NULL;
+        music_quit = NULL;
         PyErr_Clear ();
     }
     MODINIT_RETURN (module);
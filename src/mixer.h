@@ -39,6 +39,13 @@ typedef struct {
   Mix_Chunk *chunk;
   Uint8 *mem;
   PyObject *weakreflist;
+  PyObject *encoded;    /* file contents decoded on first use, or NULL */
+  struct SoundStream *stream; /* for a Sound streamed from a file, or NULL */
+  struct pg_bufferinfo_s *view; /* of the memory abuf plays in place */
+  PyObject *base;       /* the Sound a subsound shares samples with */
+  int priority;         /* for the 'priority' steal policy */
+  int max_instances;    /* channels it may play on at once, 0 for any */
+  int playing;          /* channels it plays on; with the audio locked */
 } PySoundObject;
 typedef struct {
   PyObject_HEAD
@@ -50,21 +50,42 @@
 #undef ver
 #undef _version_
 
+/* A music file waiting to play. It is loaded when queued, so the audio
+   thread only has to start it. */
+typedef struct _MusicTrack
+{
+    Mix_Music *music;
+    int loops;
+    struct _MusicTrack *next;
+} MusicTrack;
+
 static Mix_Music* current_music = NULL;
-static Mix_Music* queue_music = NULL;
+/* The queue, and the tracks that have finished playing. The audio thread
+   moves a track from one to the other; the files finished are freed later,
+   by the Python thread. Both are guarded by the audio lock. */
+static MusicTrack *queue_head = NULL;
+static MusicTrack *queue_tail = NULL;
+static MusicTrack *finished_tracks = NULL;
 static int endmusic_event = SDL_NOEVENT;
+/* Frames mixed since the track started, those heard before the last
+   buffer mixed, and the frames in that buffer */
 static Uint64 music_pos = 0;
+static Uint64 music_pos_played = 0;
+static int music_pos_last = 0;
 static long music_pos_time = -1;
 static int music_frequency = 0;
 static Uint16 music_format = 0;
 static int music_channels = 0;
+static int music_frame_size = 1;
 
 static void
 mixmusic_callback (void *udata, Uint8 *stream, int len)
 {
     if (!Mix_PausedMusic ())
     {
-        music_pos += len;
+        music_pos_played = music_pos;
+        music_pos_last = len / music_frame_size;
+        music_pos += music_pos_last;
         music_pos_time = SDL_GetTicks ();
     }
 }
@@ -72,6 +93,30 @@ mixmusic_callback (void *udata, Uint8 *stream, int len)
 static void
 endmusic_callback (void)
 {
+    MusicTrack *track = queue_head;
+    Mix_Music *finished = current_music;
+
+    if (track)
+    {
+        /* Start the next track first; SDL_mixer then mixes it into the
+           rest of the buffer the last one ended in */
+        queue_head = track->next;
+        if (!queue_head)
+            queue_tail = NULL;
+        current_music = track->music;
+        music_pos = 0;
+        Mix_PlayMusic (current_music, track->loops);
+
+        /* The Python thread frees the finished file, away from here */
+        track->music = finished;
+        track->next = finished_tracks;
+        finished_tracks = track;
+    }
+    else
+    {
+        music_pos_time = -1;
+        Mix_SetPostMix (NULL, NULL);
+    }
     if (endmusic_event && SDL_WasInit (SDL_INIT_VIDEO))
     {
         SDL_Event e;
@@ -79,23 +124,73 @@ endmusic_callback (void)
         e.type = endmusic_event;
         SDL_PushEvent (&e);
     }
-    if (queue_music)
+}
+
+/* Free a list of tracks taken from the audio thread */
+static void
+_free_tracks (MusicTrack *tracks)
+{
+    MusicTrack *track;
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (track = tracks; track; track = track->next)
     {
-        if (current_music)
-            Mix_FreeMusic (current_music);
-        current_music = queue_music;
-        queue_music = NULL;
-        Mix_HookMusicFinished (endmusic_callback);
-        music_pos = 0;
-        Mix_PlayMusic (current_music, 0);
+        if (track->music)
+            Mix_FreeMusic (track->music);
     }
-    else
+    Py_END_ALLOW_THREADS;
+    while (tracks)
     {
-        music_pos_time = -1;
-        Mix_SetPostMix (NULL, NULL);
+        track = tracks->next;
+        PyMem_Del (tracks);
+        tracks = track;
     }
 }
 
+/* Take the queue away from the audio thread, adding the tracks finished */
+static MusicTrack*
+_take_queue (void)
+{
+    MusicTrack *tracks;
+
+    SDL_LockAudio ();
+    tracks = queue_head;
+    if (queue_tail)
+        queue_tail->next = finished_tracks;
+    else
+        tracks = finished_tracks;
+    queue_head = queue_tail = finished_tracks = NULL;
+    SDL_UnlockAudio ();
+    return tracks;
+}
+
+static void
+_free_finished (void)
+{
+    MusicTrack *tracks;
+
+    SDL_LockAudio ();
+    tracks = finished_tracks;
+    finished_tracks = NULL;
+    SDL_UnlockAudio ();
+    _free_tracks (tracks);
+}
+
+/* Stop and free all music, for mixer.quit */
+static void
+_music_quit (void)
+{
+    Mix_Music *music;
+
+    _free_tracks (_take_queue ());
+    SDL_LockAudio ();
+    music = current_music;
+    current_music = NULL;
+    SDL_UnlockAudio ();
+    if (music)
+        Mix_FreeMusic (music);
+}
+
 /*music module methods*/
 static PyObject*
 music_play (PyObject* self, PyObject* args, PyObject *keywds)
@@ -113,11 +208,16 @@ music_play (PyObject* self, PyObject* args, PyObject *keywds)
     if (!current_music)
         return RAISE (PyExc_SDLError, "music not loaded");
 
+    _free_finished ();
     Mix_HookMusicFinished (endmusic_callback);
-    Mix_SetPostMix (mixmusic_callback, NULL);
+    SDL_LockAudio ();
     Mix_QuerySpec (&music_frequency, &music_format, &music_channels);
-    music_pos = 0;
+    music_frame_size = music_channels * ((music_format & 0xff) >> 3);
+    music_pos = music_pos_played = 0;
+    music_pos_last = 0;
     music_pos_time = SDL_GetTicks ();
+    SDL_UnlockAudio ();
+    Mix_SetPostMix (mixmusic_callback, NULL);
 
 #if MIXMUSIC_HAVE_STARTPOSN
     Py_BEGIN_ALLOW_THREADS
@@ -155,12 +255,9 @@ music_fadeout (PyObject* self, PyObject* args)
 
     MIXER_INIT_CHECK ();
 
+    /* Empty the queue first, so nothing follows the fade */
+    _free_tracks (_take_queue ());
     Mix_FadeOutMusic (_time);
-    if (queue_music)
-    {
-        Mix_FreeMusic (queue_music);
-        queue_music = NULL;
-    }
     Py_RETURN_NONE;
 }
 
@@ -169,12 +266,8 @@ music_stop (PyObject* self)
 {
     MIXER_INIT_CHECK ();
 
+    _free_tracks (_take_queue ());
     Mix_HaltMusic ();
-    if (queue_music)
-    {
-        Mix_FreeMusic (queue_music);
-        queue_music = NULL;
-    }
     Py_RETURN_NONE;
 }
 
@@ -251,20 +344,28 @@ music_set_pos (PyObject* self, PyObject* arg)
 static PyObject*
 music_get_pos (PyObject* self)
 {
-    long ticks;
+    long ticks, elapsed, last;
 
     MIXER_INIT_CHECK ();
 
+    SDL_LockAudio ();
     if (music_pos_time < 0)
+    {
+        SDL_UnlockAudio ();
         return PyLong_FromLong (-1);
-
-    ticks = (long) (1000 * music_pos /
-                    (music_channels * music_frequency *
-                     ((music_format & 0xff) >> 3)));
-    if (!Mix_PausedMusic ())
-        ticks += SDL_GetTicks () - music_pos_time;
-
-    return PyInt_FromLong ((long)ticks);
+    }
+    /* The frames heard, and as much of the last buffer as has had time to
+       play; paused music still plays that out */
+    ticks = (long) (1000 * music_pos_played / music_frequency);
+    last = (long) (1000 * (Uint64) music_pos_last / music_frequency);
+    elapsed = (long) (SDL_GetTicks () - music_pos_time);
+    SDL_UnlockAudio ();
+    if (elapsed > last)
+        elapsed = last;
+    if (elapsed > 0)
+        ticks += elapsed;
+
+    return PyInt_FromLong (ticks);
 }
 
 static PyObject*
@@ -284,21 +385,15 @@ music_get_endevent (PyObject* self)
     return PyInt_FromLong (endmusic_event);
 }
 
-static PyObject*
-music_load(PyObject *self, PyObject *args)
+/* Open the music file obj names or is, or return NULL with an exception */
+static Mix_Music*
+_load_music(PyObject *obj)
 {
-    PyObject *obj;
     PyObject *oencoded;
     Mix_Music *new_music = NULL;
     const char *name;
     SDL_RWops *rw;
 
-    if(!PyArg_ParseTuple(args, "O", &obj)) {
-        return NULL;
-    }
-
-    MIXER_INIT_CHECK();
-
     oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
     if (oencoded == Py_None) {
         Py_DECREF(oencoded);
@@ -311,9 +406,10 @@ music_load(PyObject *self, PyObject *args)
         new_music = Mix_LoadMUS_RW(rw);
         Py_END_ALLOW_THREADS
 #else
-        return RAISE (PyExc_NotImplementedError,
-                      "music file-like-object support requires"
-                      " SDL_mixer-1.2.8");
+        RAISE (PyExc_NotImplementedError,
+               "music file-like-object support requires"
+               " SDL_mixer-1.2.8");
+        return NULL;
 #endif
     }
     else if (oencoded != NULL) {
@@ -328,34 +424,17 @@ music_load(PyObject *self, PyObject *args)
     }
 
     if (new_music == NULL) {
-        return RAISE(PyExc_SDLError, SDL_GetError());
-    }
-
-    Py_BEGIN_ALLOW_THREADS
-    if (current_music != NULL)
-    {
-        Mix_FreeMusic(current_music);
-        current_music = NULL;
-    }
-    if (queue_music != NULL)
-    {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
+        RAISE(PyExc_SDLError, SDL_GetError());
     }
-    Py_END_ALLOW_THREADS
-
-    current_music = new_music;
-    Py_RETURN_NONE;
+    return new_music;
 }
 
 static PyObject*
-music_queue(PyObject *self, PyObject *args)
+music_load(PyObject *self, PyObject *args)
 {
     PyObject *obj;
-    PyObject *oencoded;
-    Mix_Music *queue_music = NULL;
-    const char *name;
-    SDL_RWops *rw;
+    Mix_Music *new_music;
+    Mix_Music *old_music;
 
     if(!PyArg_ParseTuple(args, "O", &obj)) {
         return NULL;
@@ -363,47 +442,63 @@ music_queue(PyObject *self, PyObject *args)
 
     MIXER_INIT_CHECK();
 
-    oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
-    if (oencoded == Py_None) {
-        Py_DECREF(oencoded);
-#if MIXMUSIC_HAVE_RWOPS
-        rw = RWopsFromFileObjectThreaded(obj);
-        if(rw == NULL) {
-            return NULL;
-        }
-        Py_BEGIN_ALLOW_THREADS
-        queue_music = Mix_LoadMUS_RW(rw);
-        Py_END_ALLOW_THREADS
-#else
-        return RAISE (PyExc_NotImplementedError,
-                      "music file-like-object support requires"
-                      " SDL_mixer-1.2.8");
-#endif
+    new_music = _load_music(obj);
+    if (new_music == NULL) {
+        return NULL;
     }
-    else if (oencoded != NULL) {
-        name = Bytes_AS_STRING(oencoded);
+
+    _free_tracks(_take_queue());
+    SDL_LockAudio();
+    old_music = current_music;
+    current_music = new_music;
+    SDL_UnlockAudio();
+    if (old_music != NULL) {
         Py_BEGIN_ALLOW_THREADS
-        queue_music = Mix_LoadMUS(name);
+        Mix_FreeMusic(old_music);
         Py_END_ALLOW_THREADS
-        Py_DECREF(oencoded);
     }
-    else {
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+music_queue(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *obj;
+    int loops = 0;
+    Mix_Music *new_music;
+    MusicTrack *track;
+    static char *kwids[] = {"filename", "loops", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwids,
+                                     &obj, &loops)) {
         return NULL;
     }
 
-    if (queue_music == NULL) {
-        return RAISE(PyExc_SDLError, SDL_GetError());
-    }
+    MIXER_INIT_CHECK();
 
-    Py_BEGIN_ALLOW_THREADS
-    if (queue_music == NULL)
-    {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
+    _free_finished();
+    new_music = _load_music(obj);
+    if (new_music == NULL) {
+        return NULL;
     }
-    Py_END_ALLOW_THREADS
+    track = PyMem_New(MusicTrack, 1);
+    if (track == NULL) {
+        Mix_FreeMusic(new_music);
+        return PyErr_NoMemory();
+    }
+    track->music = new_music;
+    track->loops = loops;
+    track->next = NULL;
 
-    queue_music = queue_music;
+    SDL_LockAudio();
+    if (queue_tail != NULL) {
+        queue_tail->next = track;
+    }
+    else {
+        queue_head = track;
+    }
+    queue_tail = track;
+    SDL_UnlockAudio();
     Py_RETURN_NONE;
 }
 
@@ -436,7 +531,8 @@ static PyMethodDef _music_methods[] =
       DOC_PYGAMEMIXERMUSICGETPOS },
 
     { "load", music_load, METH_VARARGS, DOC_PYGAMEMIXERMUSICLOAD },
-    { "queue", music_queue, METH_VARARGS, DOC_PYGAMEMIXERMUSICQUEUE },
+    { "queue", (PyCFunction) music_queue, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEMIXERMUSICQUEUE },
 
     { NULL, NULL, 0, NULL }
 };
@@ -493,13 +589,13 @@ MODINIT_DEFINE (mixer_music)
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
-    cobj = PyCapsule_New (&queue_music,
-                          "pygame.music_mixer._QUEUE_POINTER", NULL);
+    cobj = PyCapsule_New ((void *) _music_quit,
+                          "pygame.music_mixer._MUSIC_QUIT", NULL);
     if (cobj == NULL) {
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
-    if (PyModule_AddObject(module, "_QUEUE_POINTER", cobj) < 0) {
+    if (PyModule_AddObject(module, "_MUSIC_QUIT", cobj) < 0) {
         Py_DECREF (cobj);
         DECREF_MOD (module);
         MODINIT_ERROR;
@@ -61,61 +61,178 @@ Overlay_SetLocation (PyGameOverlay *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
-static PyObject*
-Overlay_Display (PyGameOverlay *self, PyObject *args)
+/* A plane of Overlay.display () data: rows of bytes, stride bytes apart. */
+typedef struct
 {
-    SDL_Rect cRect;
-    // Parse data params for frame
-    int ls_y, ls_u, ls_v, y;
-    unsigned char *src_y=0, *src_u=0, *src_v=0;
-
-    if (PyTuple_Size (args))
+    Pg_buffer view;
+    Uint8 *rows;
+    Py_ssize_t stride;
+    Py_ssize_t count;
+    Py_ssize_t width;
+} OverlayPlane;
+
+/* Finds the rows of a plane in a buffer object. A 1 dimensional buffer
+ * holds count rows of equal length; otherwise the first dimension is the
+ * rows, each of which must be contiguous.
+ */
+static int
+_get_plane (PyObject *obj, OverlayPlane *plane, int index, Py_ssize_t width,
+            Py_ssize_t count)
+{
+    Py_buffer *view_p = (Py_buffer *)&plane->view;
+    Py_ssize_t rows;
+    Py_ssize_t rowlen;
+    int i;
+
+    if (PgObject_GetBuffer (obj, &plane->view, PyBUF_RECORDS_RO))
+        return -1;
+
+    plane->rows = (Uint8 *)view_p->buf;
+    plane->width = width;
+    plane->count = count;
+    if (view_p->ndim < 2)
     {
-        if (!PyArg_ParseTuple (args, "(s#s#s#)", &src_y, &ls_y, &src_u, &ls_u,
-                               &src_v, &ls_v))
-            return NULL;
+        rows = count;
+        plane->stride = view_p->len / count;
+        rowlen = plane->stride;
     }
-
-    if (src_y)
+    else
     {
-        Uint8 *dst_y=0, *dst_u=0, *dst_v=0;
-        SDL_LockYUVOverlay (self->cOverlay);
+        rows = view_p->shape[0];
+        plane->stride = view_p->strides[0];
+        rowlen = view_p->itemsize;
+        for (i = view_p->ndim - 1; i > 0; --i)
+        {
+            if (view_p->strides[i] != rowlen)
+            {
+                PgBuffer_Release (&plane->view);
+                PyErr_Format (PyExc_ValueError,
+                              "the rows of plane %d are not contiguous",
+                              index);
+                return -1;
+            }
+            rowlen *= view_p->shape[i];
+        }
+    }
 
-        // No clipping at this time( only support for YUV420 )
+    if (rows < count || rowlen < width)
+    {
+        PgBuffer_Release (&plane->view);
+        PyErr_Format (PyExc_ValueError,
+                      "plane %d needs %d rows of %d bytes", index,
+                      (int)count, (int)width);
+        return -1;
+    }
+    return 0;
+}
 
-        dst_y = self->cOverlay->pixels[0];
-        dst_v = self->cOverlay->pixels[1];
-        dst_u = self->cOverlay->pixels[2];
+static void
+_copy_plane (OverlayPlane *plane, Uint8 *dst, Uint16 pitch)
+{
+    Uint8 *src = plane->rows;
+    Py_ssize_t width = MIN (plane->width, (Py_ssize_t)pitch);
+    Py_ssize_t y;
 
-        for (y = 0; y < self->cOverlay->h; y++)
-        {
-            memcpy (dst_y, src_y, self->cOverlay->w);
+    if (plane->stride == pitch && plane->stride == width)
+    {
+        memcpy (dst, src, width * plane->count);
+        return;
+    }
+    for (y = 0; y < plane->count; y++)
+    {
+        memcpy (dst, src, width);
+        src += plane->stride;
+        dst += pitch;
+    }
+}
 
-            src_y += ls_y / self->cOverlay->h;
-            dst_y += self->cOverlay->pitches[0];
+static PyObject*
+Overlay_Display (PyGameOverlay *self, PyObject *args)
+{
+    SDL_Overlay *overlay = self->cOverlay;
+    SDL_Rect cRect;
+    PyObject *data = NULL;
+    PyObject *item;
+    OverlayPlane planes[3];
+    Py_ssize_t count = 0;
+    Py_ssize_t i;
+    int sequence;
+    int result;
+    int w = overlay->w;
+    int h = overlay->h;
+
+    if (!PyArg_ParseTuple (args, "|O", &data))
+        return NULL;
 
-            if (!(y & 1))
-            {
-                src_u += (ls_u * 2)/self->cOverlay->h;
-                src_v += (ls_v * 2)/self->cOverlay->h;
-                dst_u += self->cOverlay->pitches[ 1 ];
-                dst_v += self->cOverlay->pitches[ 2 ];
-            }
+    if (data)
+    {
+        /* A tuple or list of the planes, or the one plane of a packed
+         * format, such as a YUY2 camera frame.
+         */
+        sequence = PyTuple_Check (data) || PyList_Check (data);
+        count = sequence ? PySequence_Size (data) : 1;
+        if (count != overlay->planes)
+            return RAISE (PyExc_ValueError,
+                          overlay->planes == 1 ?
+                          "the overlay format takes one plane" :
+                          "the overlay format takes (y, u, v) planes");
+
+        for (i = 0; i < count; i++)
+        {
+            item = sequence ? PySequence_GetItem (data, i) : data;
+            if (!item)
+                break;
+
+            if (count == 1)
+                /* Packed, 2 bytes a pixel. */
+                result = _get_plane (item, &planes[i], i, ((w + 1) / 2) * 4,
+                                     h);
+            else if (i == 0)
+                result = _get_plane (item, &planes[i], i, w, h);
             else
-            {
-                memcpy (dst_u, src_u, (ls_u * 2) / self->cOverlay->h);
-                memcpy (dst_v, src_v, (ls_v * 2) / self->cOverlay->h);
-            }
+                result = _get_plane (item, &planes[i], i, (w + 1) / 2,
+                                     (h + 1) / 2);
+            if (sequence)
+                Py_DECREF (item);
+            if (result)
+                break;
+        }
+        if (i < count)
+        {
+            while (i--)
+                PgBuffer_Release (&planes[i].view);
+            return NULL;
         }
-
-        SDL_UnlockYUVOverlay (self->cOverlay);
     }
 
     cRect.x = self->cRect.x;
     cRect.y = self->cRect.y;
     cRect.w = self->cRect.w;
     cRect.h = self->cRect.h;
-    SDL_DisplayYUVOverlay (self->cOverlay, &cRect);
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (count)
+    {
+        SDL_LockYUVOverlay (overlay);
+        if (count == 1)
+            _copy_plane (&planes[0], overlay->pixels[0], overlay->pitches[0]);
+        else
+        {
+            /* YV12 stores V before U, IYUV U before V. */
+            int u = (overlay->format == SDL_IYUV_OVERLAY) ? 1 : 2;
+
+            _copy_plane (&planes[0], overlay->pixels[0], overlay->pitches[0]);
+            _copy_plane (&planes[1], overlay->pixels[u], overlay->pitches[u]);
+            _copy_plane (&planes[2], overlay->pixels[3 - u],
+                         overlay->pitches[3 - u]);
+        }
+        SDL_UnlockYUVOverlay (overlay);
+    }
+    SDL_DisplayYUVOverlay (overlay, &cRect);
+    Py_END_ALLOW_THREADS;
+
+    for (i = 0; i < count; i++)
+        PgBuffer_Release (&planes[i].view);
 
     Py_RETURN_NONE;
 }
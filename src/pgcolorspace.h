@@ -0,0 +1,623 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* Colour space conversion of pixels held as bytes, shared by the color,
+   transform and camera modules. HSV is packed the way the camera module
+   has always made it: h runs 0 to 255 around the hue circle with red,
+   green and blue at 0, 85 and 170, and s and v run 0 to 255. The pixel runs take pixels of size
+   bytes with their red, green and blue bytes at roff, goff and boff and
+   put h, s and v in those places, leaving any other bytes alone.
+   The YUV runs make 32 bit pixels with 8 bit channels at the shifts given,
+   by the integer formulas of libv4l, and use SSE2, AVX2 when the CPU has
+   it, or NEON. Depends on pygame.h being included first.
+ */
+#if !defined(PGCOLORSPACE_H)
+#define PGCOLORSPACE_H
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PG_COLORSPACE_SSE2
+#include <emmintrin.h>
+#endif
+
+/* AVX2 is enabled per function, as the modules are not built with -mavx2,
+   and only used after asking the CPU */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || \
+     defined(__clang__))
+#define PG_COLORSPACE_AVX2
+#include <immintrin.h>
+#define PG_COLORSPACE_TARGET_AVX2 __attribute__ ((target ("avx2")))
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define PG_COLORSPACE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__)
+#define PG_COLORSPACE_UNUSED __attribute__ ((unused))
+#else
+#define PG_COLORSPACE_UNUSED
+#endif
+
+#define PG_COLORSPACE_SAT(c) ((c) & (~255) ? ((c) < 0 ? 0 : 255) : (c))
+
+/* The kernels the runs use: plain C, SSE2 or NEON, or those and the
+   AVX2 YUV runs. Each module including this has its own, starting at the
+   widest the CPU has as told by PgCpu_GetFeatures, and registers
+   pg_colorspace_get_backend and pg_colorspace_set_backend with
+   PgSimd_Register. */
+#define PG_COLORSPACE_GENERIC 0
+#define PG_COLORSPACE_SIMD 1
+#define PG_COLORSPACE_WIDE 2
+
+static int pg_colorspace_level = -1;
+
+static PG_COLORSPACE_UNUSED int
+pg_colorspace_get_level (void)
+{
+    if (pg_colorspace_level < 0)
+    {
+        pg_colorspace_level = PG_COLORSPACE_GENERIC;
+#if defined(PG_COLORSPACE_SSE2) || defined(PG_COLORSPACE_NEON)
+        pg_colorspace_level = PG_COLORSPACE_SIMD;
+#endif
+#if defined(PG_COLORSPACE_AVX2)
+        if (PgCpu_GetFeatures () & PG_CPU_AVX2)
+            pg_colorspace_level = PG_COLORSPACE_WIDE;
+#endif
+    }
+    return pg_colorspace_level;
+}
+
+static PG_COLORSPACE_UNUSED const char*
+pg_colorspace_get_backend (void)
+{
+    switch (pg_colorspace_get_level ())
+    {
+    case PG_COLORSPACE_WIDE:
+        return "AVX2";
+#if defined(PG_COLORSPACE_NEON)
+    case PG_COLORSPACE_SIMD:
+        return "NEON";
+#elif defined(PG_COLORSPACE_SSE2)
+    case PG_COLORSPACE_SIMD:
+        return "SSE2";
+#endif
+    default:
+        return "GENERIC";
+    }
+}
+
+/* Switch to the kernels of backend type, or to the widest the CPU has
+   for NULL. Returns -1 for a backend this build or CPU lacks. */
+static PG_COLORSPACE_UNUSED int
+pg_colorspace_set_backend (const char *type)
+{
+    int old = pg_colorspace_get_level (), level;
+
+    pg_colorspace_level = -1;
+    level = pg_colorspace_get_level ();
+    if (!type)
+        return 0;
+    for (; level >= PG_COLORSPACE_GENERIC; --level)
+    {
+        pg_colorspace_level = level;
+        if (strcmp (type, pg_colorspace_get_backend ()) == 0)
+            return 0;
+    }
+    pg_colorspace_level = old;
+    return -1;
+}
+
+static void
+pg_rgb_to_hsv (Uint8 r, Uint8 g, Uint8 b, Uint8 *h, Uint8 *s, Uint8 *v)
+{
+    Uint8 max = MAX (MAX (r, g), b);
+    Uint8 delta = max - MIN (MIN (r, g), b);
+
+    *v = max; /* value (similar to luminosity) */
+    if (!delta)
+    {
+        /* grey, zero hue and saturation */
+        *s = 0;
+        *h = 0;
+        return;
+    }
+    *s = 255 * delta / max;
+    /* set hue based on max color, negative hues wrap round */
+    if (r == max)
+        *h = (Uint8) (43 * (g - b) / delta);
+    else if (g == max)
+        *h = (Uint8) (85 + 43 * (b - r) / delta);
+    else
+        *h = (Uint8) (170 + 43 * (r - g) / delta);
+}
+
+/* The reverse of pg_rgb_to_hsv, rounded to the nearest byte */
+static PG_COLORSPACE_UNUSED void
+pg_hsv_to_rgb (Uint8 h, Uint8 s, Uint8 v, Uint8 *r, Uint8 *g, Uint8 *b)
+{
+    int sector, f, p, q, t;
+
+    if (!s)
+    {
+        *r = *g = *b = v;
+        return;
+    }
+    /* red, green and blue are at 0, 85 and 170, so a sixth is 256 / 6 */
+    sector = h * 6 >> 8;
+    f = h * 6 & 255;            /* 256ths of the way through it */
+    p = (v * (255 - s) + 127) / 255;
+    q = (v * (255 * 256 - s * f) + 255 * 128) / (255 * 256);
+    t = (v * (255 * 256 - s * (256 - f)) + 255 * 128) / (255 * 256);
+
+    switch (sector)
+    {
+    case 0:
+        *r = v; *g = t; *b = p;
+        break;
+    case 1:
+        *r = q; *g = v; *b = p;
+        break;
+    case 2:
+        *r = p; *g = v; *b = t;
+        break;
+    case 3:
+        *r = p; *g = q; *b = v;
+        break;
+    case 4:
+        *r = t; *g = p; *b = v;
+        break;
+    default:
+        *r = v; *g = p; *b = q;
+        break;
+    }
+}
+
+static PG_COLORSPACE_UNUSED void
+pg_rgb_to_hsv_pixels (Uint8 *pixels, Py_ssize_t n, int size,
+                      int roff, int goff, int boff)
+{
+    Py_ssize_t i = 0;
+    Uint8 *p;
+#if defined(PG_COLORSPACE_SSE2)
+    /* Four pixels at a time in floats. The quotients are of integers
+     * below 2^16 by divisors below 256, so they are never close enough
+     * to a whole number for rounding to move them across it, and
+     * truncating them is the integer division of pg_rgb_to_hsv. */
+    const __m128 c43 = _mm_set1_ps (43.f), c255 = _mm_set1_ps (255.f);
+    const __m128i c85 = _mm_set1_epi32 (85), c170 = _mm_set1_epi32 (170);
+    __m128 r, g, b, maxv, delta, is_r, is_g, is_b, num, grey;
+    __m128i h, s, base;
+    int hs[4], ss[4], vs[4], k;
+
+    for (; pg_colorspace_get_level () >= PG_COLORSPACE_SIMD &&
+           i + 4 <= n; i += 4)
+    {
+        p = pixels + i * size;
+        r = _mm_cvtepi32_ps (_mm_set_epi32 (p[3 * size + roff],
+                                            p[2 * size + roff],
+                                            p[size + roff], p[roff]));
+        g = _mm_cvtepi32_ps (_mm_set_epi32 (p[3 * size + goff],
+                                            p[2 * size + goff],
+                                            p[size + goff], p[goff]));
+        b = _mm_cvtepi32_ps (_mm_set_epi32 (p[3 * size + boff],
+                                            p[2 * size + boff],
+                                            p[size + boff], p[boff]));
+        maxv = _mm_max_ps (_mm_max_ps (r, g), b);
+        delta = _mm_sub_ps (maxv, _mm_min_ps (_mm_min_ps (r, g), b));
+        grey = _mm_cmpeq_ps (delta, _mm_setzero_ps ());
+
+        is_r = _mm_cmpeq_ps (r, maxv);
+        is_g = _mm_andnot_ps (is_r, _mm_cmpeq_ps (g, maxv));
+        is_b = _mm_andnot_ps (_mm_or_ps (is_r, is_g), _mm_cmpeq_ps (b, maxv));
+        num = _mm_or_ps (_mm_or_ps (_mm_and_ps (is_r, _mm_sub_ps (g, b)),
+                                    _mm_and_ps (is_g, _mm_sub_ps (b, r))),
+                         _mm_and_ps (is_b, _mm_sub_ps (r, g)));
+        base = _mm_or_si128 (_mm_and_si128 (_mm_castps_si128 (is_g), c85),
+                             _mm_and_si128 (_mm_castps_si128 (is_b), c170));
+
+        h = _mm_add_epi32 (base, _mm_cvttps_epi32 (
+                               _mm_div_ps (_mm_mul_ps (c43, num), delta)));
+        s = _mm_cvttps_epi32 (_mm_div_ps (_mm_mul_ps (c255, delta), maxv));
+        h = _mm_andnot_si128 (_mm_castps_si128 (grey), h);
+        s = _mm_andnot_si128 (_mm_castps_si128 (grey), s);
+        _mm_storeu_si128 ((__m128i *) hs, h);
+        _mm_storeu_si128 ((__m128i *) ss, s);
+        _mm_storeu_si128 ((__m128i *) vs, _mm_cvttps_epi32 (maxv));
+        for (k = 0; k < 4; ++k, p += size)
+        {
+            p[roff] = (Uint8) hs[k];
+            p[goff] = (Uint8) ss[k];
+            p[boff] = (Uint8) vs[k];
+        }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        p = pixels + i * size;
+        pg_rgb_to_hsv (p[roff], p[goff], p[boff],
+                       &p[roff], &p[goff], &p[boff]);
+    }
+}
+
+static PG_COLORSPACE_UNUSED void
+pg_hsv_to_rgb_pixels (Uint8 *pixels, Py_ssize_t n, int size,
+                      int roff, int goff, int boff)
+{
+    Py_ssize_t i;
+    Uint8 *p;
+
+    for (i = 0, p = pixels; i < n; ++i, p += size)
+        pg_hsv_to_rgb (p[roff], p[goff], p[boff],
+                       &p[roff], &p[goff], &p[boff]);
+}
+
+/* Two pixels sharing u and v, by the formulas of libv4l */
+static PG_COLORSPACE_UNUSED void
+pg_yuv_to_rgb32_pair (int y1, int y2, int u, int v, Uint32 *dst,
+                      int rshift, int gshift, int bshift)
+{
+    int u1 = (((u - 128) << 7) + (u - 128)) >> 6;
+    int rg = (((u - 128) << 1) + (u - 128) +
+              ((v - 128) << 2) + ((v - 128) << 1)) >> 3;
+    int v1 = (((v - 128) << 1) + (v - 128)) >> 1;
+
+    dst[0] = ((Uint32) PG_COLORSPACE_SAT (y1 + v1) << rshift) |
+        ((Uint32) PG_COLORSPACE_SAT (y1 - rg) << gshift) |
+        ((Uint32) PG_COLORSPACE_SAT (y1 + u1) << bshift);
+    dst[1] = ((Uint32) PG_COLORSPACE_SAT (y2 + v1) << rshift) |
+        ((Uint32) PG_COLORSPACE_SAT (y2 - rg) << gshift) |
+        ((Uint32) PG_COLORSPACE_SAT (y2 + u1) << bshift);
+}
+
+#if defined(PG_COLORSPACE_SSE2)
+/* Eight 32 bit pixels from 16 bit lanes of r, g and b, all below 256 */
+static PG_COLORSPACE_UNUSED void
+pg_store_rgb32_sse2 (__m128i r, __m128i g, __m128i b, Uint32 *dst,
+                     __m128i rs, __m128i gs, __m128i bs)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+
+    _mm_storeu_si128 ((__m128i *) dst, _mm_or_si128 (
+        _mm_or_si128 (_mm_sll_epi32 (_mm_unpacklo_epi16 (r, zero), rs),
+                      _mm_sll_epi32 (_mm_unpacklo_epi16 (g, zero), gs)),
+        _mm_sll_epi32 (_mm_unpacklo_epi16 (b, zero), bs)));
+    _mm_storeu_si128 ((__m128i *) (dst + 4), _mm_or_si128 (
+        _mm_or_si128 (_mm_sll_epi32 (_mm_unpackhi_epi16 (r, zero), rs),
+                      _mm_sll_epi32 (_mm_unpackhi_epi16 (g, zero), gs)),
+        _mm_sll_epi32 (_mm_unpackhi_epi16 (b, zero), bs)));
+}
+
+/* Eight pixels from 16 bit lanes of y, and of u and v less 128. The sums
+ * stay well inside 16 bits, and the shifts are arithmetic like C's. */
+static PG_COLORSPACE_UNUSED void
+pg_yuv8_to_rgb32_sse2 (__m128i y, __m128i du, __m128i dv, Uint32 *dst,
+                       __m128i rs, __m128i gs, __m128i bs)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    const __m128i c255 = _mm_set1_epi16 (255);
+    __m128i u1, rg, v1, r, g, b;
+
+    u1 = _mm_srai_epi16 (_mm_mullo_epi16 (du, _mm_set1_epi16 (129)), 6);
+    rg = _mm_srai_epi16 (_mm_add_epi16 (
+                             _mm_mullo_epi16 (du, _mm_set1_epi16 (3)),
+                             _mm_mullo_epi16 (dv, _mm_set1_epi16 (6))), 3);
+    v1 = _mm_srai_epi16 (_mm_mullo_epi16 (dv, _mm_set1_epi16 (3)), 1);
+    r = _mm_min_epi16 (_mm_max_epi16 (_mm_add_epi16 (y, v1), zero), c255);
+    g = _mm_min_epi16 (_mm_max_epi16 (_mm_sub_epi16 (y, rg), zero), c255);
+    b = _mm_min_epi16 (_mm_max_epi16 (_mm_add_epi16 (y, u1), zero), c255);
+    pg_store_rgb32_sse2 (r, g, b, dst, rs, gs, bs);
+}
+#endif
+
+#if defined(PG_COLORSPACE_AVX2)
+/* As pg_yuv8_to_rgb32_sse2, for sixteen pixels */
+static PG_COLORSPACE_TARGET_AVX2 PG_COLORSPACE_UNUSED void
+pg_yuv16_to_rgb32_avx2 (__m256i y, __m256i du, __m256i dv, Uint32 *dst,
+                        __m128i rs, __m128i gs, __m128i bs)
+{
+    const __m256i zero = _mm256_setzero_si256 ();
+    const __m256i c255 = _mm256_set1_epi16 (255);
+    __m256i u1, rg, v1, r, g, b, lo, hi;
+
+    u1 = _mm256_srai_epi16 (_mm256_mullo_epi16 (du, _mm256_set1_epi16 (129)),
+                            6);
+    rg = _mm256_srai_epi16 (_mm256_add_epi16 (
+                                _mm256_mullo_epi16 (du, _mm256_set1_epi16 (3)),
+                                _mm256_mullo_epi16 (dv, _mm256_set1_epi16 (6))),
+                            3);
+    v1 = _mm256_srai_epi16 (_mm256_mullo_epi16 (dv, _mm256_set1_epi16 (3)), 1);
+    r = _mm256_min_epi16 (_mm256_max_epi16 (_mm256_add_epi16 (y, v1), zero),
+                          c255);
+    g = _mm256_min_epi16 (_mm256_max_epi16 (_mm256_sub_epi16 (y, rg), zero),
+                          c255);
+    b = _mm256_min_epi16 (_mm256_max_epi16 (_mm256_add_epi16 (y, u1), zero),
+                          c255);
+    /* The unpacks work within each half: lo has pixels 0-3 and 8-11 */
+    lo = _mm256_or_si256 (
+        _mm256_or_si256 (_mm256_sll_epi32 (_mm256_unpacklo_epi16 (r, zero), rs),
+                         _mm256_sll_epi32 (_mm256_unpacklo_epi16 (g, zero), gs)),
+        _mm256_sll_epi32 (_mm256_unpacklo_epi16 (b, zero), bs));
+    hi = _mm256_or_si256 (
+        _mm256_or_si256 (_mm256_sll_epi32 (_mm256_unpackhi_epi16 (r, zero), rs),
+                         _mm256_sll_epi32 (_mm256_unpackhi_epi16 (g, zero), gs)),
+        _mm256_sll_epi32 (_mm256_unpackhi_epi16 (b, zero), bs));
+    _mm256_storeu_si256 ((__m256i *) dst,
+                         _mm256_permute2x128_si256 (lo, hi, 0x20));
+    _mm256_storeu_si256 ((__m256i *) (dst + 8),
+                         _mm256_permute2x128_si256 (lo, hi, 0x31));
+}
+
+/* Returns the pairs done, a multiple of 8 */
+static PG_COLORSPACE_TARGET_AVX2 PG_COLORSPACE_UNUSED Py_ssize_t
+pg_yuyv_to_rgb32_avx2 (const Uint8 *src, Uint32 *dst, Py_ssize_t npairs,
+                       int rshift, int gshift, int bshift)
+{
+    const __m256i low = _mm256_set1_epi16 (0xff);
+    const __m256i c128 = _mm256_set1_epi16 (128);
+    __m128i rs = _mm_cvtsi32_si128 (rshift), gs = _mm_cvtsi32_si128 (gshift);
+    __m128i bs = _mm_cvtsi32_si128 (bshift);
+    __m256i x, c, du, dv;
+    Py_ssize_t i;
+
+    for (i = 0; i + 8 <= npairs; i += 8)
+    {
+        x = _mm256_loadu_si256 ((const __m256i *) (src + i * 4));
+        c = _mm256_srli_epi16 (x, 8);
+        du = _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (
+                                         c, _MM_SHUFFLE (2, 2, 0, 0)),
+                                     _MM_SHUFFLE (2, 2, 0, 0));
+        dv = _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (
+                                         c, _MM_SHUFFLE (3, 3, 1, 1)),
+                                     _MM_SHUFFLE (3, 3, 1, 1));
+        pg_yuv16_to_rgb32_avx2 (_mm256_and_si256 (x, low),
+                                _mm256_sub_epi16 (du, c128),
+                                _mm256_sub_epi16 (dv, c128),
+                                dst + i * 2, rs, gs, bs);
+    }
+    return i;
+}
+
+static PG_COLORSPACE_TARGET_AVX2 PG_COLORSPACE_UNUSED Py_ssize_t
+pg_yuv_planes_to_rgb32_avx2 (const Uint8 *y, const Uint8 *u, const Uint8 *v,
+                             Uint32 *dst, Py_ssize_t npairs,
+                             int rshift, int gshift, int bshift)
+{
+    const __m256i c128 = _mm256_set1_epi16 (128);
+    __m128i rs = _mm_cvtsi32_si128 (rshift), gs = _mm_cvtsi32_si128 (gshift);
+    __m128i bs = _mm_cvtsi32_si128 (bshift);
+    __m256i du, dv;
+    Py_ssize_t i;
+
+    for (i = 0; i + 8 <= npairs; i += 8)
+    {
+        /* Each chroma byte in both halves of a 32 bit lane */
+        du = _mm256_cvtepu8_epi32 (_mm_loadl_epi64 ((const __m128i *) (u + i)));
+        dv = _mm256_cvtepu8_epi32 (_mm_loadl_epi64 ((const __m128i *) (v + i)));
+        du = _mm256_or_si256 (du, _mm256_slli_epi32 (du, 16));
+        dv = _mm256_or_si256 (dv, _mm256_slli_epi32 (dv, 16));
+        pg_yuv16_to_rgb32_avx2 (
+            _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *)
+                                                   (y + i * 2))),
+            _mm256_sub_epi16 (du, c128), _mm256_sub_epi16 (dv, c128),
+            dst + i * 2, rs, gs, bs);
+    }
+    return i;
+}
+#endif
+
+#if defined(PG_COLORSPACE_NEON)
+static PG_COLORSPACE_UNUSED int16x8_t
+pg_neon_sat (int16x8_t x)
+{
+    return vminq_s16 (vmaxq_s16 (x, vdupq_n_s16 (0)), vdupq_n_s16 (255));
+}
+
+/* Eight 32 bit pixels from 16 bit lanes of r, g and b, all below 256 */
+static PG_COLORSPACE_UNUSED void
+pg_neon_store_rgb32 (uint16x8_t r, uint16x8_t g, uint16x8_t b, Uint32 *dst,
+                     int32x4_t rs, int32x4_t gs, int32x4_t bs)
+{
+    vst1q_u32 (dst, vorrq_u32 (
+        vorrq_u32 (vshlq_u32 (vmovl_u16 (vget_low_u16 (r)), rs),
+                   vshlq_u32 (vmovl_u16 (vget_low_u16 (g)), gs)),
+        vshlq_u32 (vmovl_u16 (vget_low_u16 (b)), bs)));
+    vst1q_u32 (dst + 4, vorrq_u32 (
+        vorrq_u32 (vshlq_u32 (vmovl_u16 (vget_high_u16 (r)), rs),
+                   vshlq_u32 (vmovl_u16 (vget_high_u16 (g)), gs)),
+        vshlq_u32 (vmovl_u16 (vget_high_u16 (b)), bs)));
+}
+
+/* Sixteen pixels from the eight pixels at even and odd places and the
+ * eight u and v they share */
+static PG_COLORSPACE_UNUSED void
+pg_yuv16_to_rgb32_neon (uint8x8_t yeven, uint8x8_t yodd, uint8x8_t u,
+                        uint8x8_t v, Uint32 *dst,
+                        int rshift, int gshift, int bshift)
+{
+    int16x8_t du = vsubq_s16 (vreinterpretq_s16_u16 (vmovl_u8 (u)),
+                              vdupq_n_s16 (128));
+    int16x8_t dv = vsubq_s16 (vreinterpretq_s16_u16 (vmovl_u8 (v)),
+                              vdupq_n_s16 (128));
+    int16x8_t u1 = vshrq_n_s16 (vmulq_n_s16 (du, 129), 6);
+    int16x8_t rg = vshrq_n_s16 (vaddq_s16 (vmulq_n_s16 (du, 3),
+                                           vmulq_n_s16 (dv, 6)), 3);
+    int16x8_t v1 = vshrq_n_s16 (vmulq_n_s16 (dv, 3), 1);
+    int16x8_t ye = vreinterpretq_s16_u16 (vmovl_u8 (yeven));
+    int16x8_t yo = vreinterpretq_s16_u16 (vmovl_u8 (yodd));
+    int32x4_t rs = vdupq_n_s32 (rshift), gs = vdupq_n_s32 (gshift);
+    int32x4_t bs = vdupq_n_s32 (bshift);
+    uint8x8x2_t r, g, b;
+
+    /* Saturate the even and odd pixels, then put them back in turn */
+    r = vzip_u8 (vmovn_u16 (vreinterpretq_u16_s16 (pg_neon_sat (vaddq_s16 (ye, v1)))),
+                 vmovn_u16 (vreinterpretq_u16_s16 (pg_neon_sat (vaddq_s16 (yo, v1)))));
+    g = vzip_u8 (vmovn_u16 (vreinterpretq_u16_s16 (pg_neon_sat (vsubq_s16 (ye, rg)))),
+                 vmovn_u16 (vreinterpretq_u16_s16 (pg_neon_sat (vsubq_s16 (yo, rg)))));
+    b = vzip_u8 (vmovn_u16 (vreinterpretq_u16_s16 (pg_neon_sat (vaddq_s16 (ye, u1)))),
+                 vmovn_u16 (vreinterpretq_u16_s16 (pg_neon_sat (vaddq_s16 (yo, u1)))));
+    pg_neon_store_rgb32 (vmovl_u8 (r.val[0]), vmovl_u8 (g.val[0]),
+                         vmovl_u8 (b.val[0]), dst, rs, gs, bs);
+    pg_neon_store_rgb32 (vmovl_u8 (r.val[1]), vmovl_u8 (g.val[1]),
+                         vmovl_u8 (b.val[1]), dst + 8, rs, gs, bs);
+}
+#endif
+
+/* npairs pairs of packed y1 u y2 v bytes to 32 bit pixels */
+static PG_COLORSPACE_UNUSED void
+pg_yuyv_to_rgb32 (const Uint8 *src, Uint32 *dst, Py_ssize_t npairs,
+                  int rshift, int gshift, int bshift)
+{
+    Py_ssize_t i = 0;
+#if defined(PG_COLORSPACE_NEON)
+    uint8x8x4_t x;
+#elif defined(PG_COLORSPACE_SSE2)
+    const __m128i low = _mm_set1_epi16 (0xff), c128 = _mm_set1_epi16 (128);
+    __m128i rs = _mm_cvtsi32_si128 (rshift), gs = _mm_cvtsi32_si128 (gshift);
+    __m128i bs = _mm_cvtsi32_si128 (bshift);
+    __m128i x, c, du, dv;
+#endif
+
+#if defined(PG_COLORSPACE_AVX2)
+    if (pg_colorspace_get_level () >= PG_COLORSPACE_WIDE)
+        i = pg_yuyv_to_rgb32_avx2 (src, dst, npairs, rshift, gshift, bshift);
+#endif
+#if defined(PG_COLORSPACE_NEON)
+    for (; pg_colorspace_get_level () >= PG_COLORSPACE_SIMD &&
+           i + 8 <= npairs; i += 8)
+    {
+        /* y1, u, y2 and v of eight pairs */
+        x = vld4_u8 (src + i * 4);
+        pg_yuv16_to_rgb32_neon (x.val[0], x.val[2], x.val[1], x.val[3],
+                                dst + i * 2, rshift, gshift, bshift);
+    }
+#elif defined(PG_COLORSPACE_SSE2)
+    for (; pg_colorspace_get_level () >= PG_COLORSPACE_SIMD &&
+           i + 4 <= npairs; i += 4)
+    {
+        /* 16 bit lanes of y and of u or v, each pair's u and v twice */
+        x = _mm_loadu_si128 ((const __m128i *) (src + i * 4));
+        c = _mm_srli_epi16 (x, 8);
+        du = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (
+                                      c, _MM_SHUFFLE (2, 2, 0, 0)),
+                                  _MM_SHUFFLE (2, 2, 0, 0));
+        dv = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (
+                                      c, _MM_SHUFFLE (3, 3, 1, 1)),
+                                  _MM_SHUFFLE (3, 3, 1, 1));
+        pg_yuv8_to_rgb32_sse2 (_mm_and_si128 (x, low),
+                               _mm_sub_epi16 (du, c128),
+                               _mm_sub_epi16 (dv, c128),
+                               dst + i * 2, rs, gs, bs);
+    }
+#endif
+    for (; i < npairs; ++i)
+        pg_yuv_to_rgb32_pair (src[i * 4], src[i * 4 + 2], src[i * 4 + 1],
+                              src[i * 4 + 3], dst + i * 2,
+                              rshift, gshift, bshift);
+}
+
+/* A row of 2 * npairs y bytes, with a u and v byte for each pair, to 32 bit
+   pixels */
+static PG_COLORSPACE_UNUSED void
+pg_yuv_planes_to_rgb32 (const Uint8 *y, const Uint8 *u, const Uint8 *v,
+                        Uint32 *dst, Py_ssize_t npairs,
+                        int rshift, int gshift, int bshift)
+{
+    Py_ssize_t i = 0;
+#if defined(PG_COLORSPACE_NEON)
+    uint8x8x2_t yy;
+#elif defined(PG_COLORSPACE_SSE2)
+    const __m128i zero = _mm_setzero_si128 (), c128 = _mm_set1_epi16 (128);
+    __m128i rs = _mm_cvtsi32_si128 (rshift), gs = _mm_cvtsi32_si128 (gshift);
+    __m128i bs = _mm_cvtsi32_si128 (bshift);
+    __m128i du, dv;
+    int uu, vv;
+#endif
+
+#if defined(PG_COLORSPACE_AVX2)
+    if (pg_colorspace_get_level () >= PG_COLORSPACE_WIDE)
+        i = pg_yuv_planes_to_rgb32_avx2 (y, u, v, dst, npairs,
+                                         rshift, gshift, bshift);
+#endif
+#if defined(PG_COLORSPACE_NEON)
+    for (; pg_colorspace_get_level () >= PG_COLORSPACE_SIMD &&
+           i + 8 <= npairs; i += 8)
+    {
+        yy = vld2_u8 (y + i * 2);
+        pg_yuv16_to_rgb32_neon (yy.val[0], yy.val[1], vld1_u8 (u + i),
+                                vld1_u8 (v + i), dst + i * 2,
+                                rshift, gshift, bshift);
+    }
+#elif defined(PG_COLORSPACE_SSE2)
+    for (; pg_colorspace_get_level () >= PG_COLORSPACE_SIMD &&
+           i + 4 <= npairs; i += 4)
+    {
+        memcpy (&uu, u + i, 4);
+        memcpy (&vv, v + i, 4);
+        du = _mm_unpacklo_epi8 (_mm_cvtsi32_si128 (uu), zero);
+        dv = _mm_unpacklo_epi8 (_mm_cvtsi32_si128 (vv), zero);
+        pg_yuv8_to_rgb32_sse2 (
+            _mm_unpacklo_epi8 (_mm_loadl_epi64 ((const __m128i *) (y + i * 2)),
+                               zero),
+            _mm_sub_epi16 (_mm_unpacklo_epi16 (du, du), c128),
+            _mm_sub_epi16 (_mm_unpacklo_epi16 (dv, dv), c128),
+            dst + i * 2, rs, gs, bs);
+    }
+#endif
+    for (; i < npairs; ++i)
+        pg_yuv_to_rgb32_pair (y[i * 2], y[i * 2 + 1], u[i], v[i], dst + i * 2,
+                              rshift, gshift, bshift);
+}
+
+/* Fill table with what Color.correct_gamma makes of each byte */
+static PG_COLORSPACE_UNUSED void
+pg_gamma_table (Uint8 table[256], double gamma)
+{
+    int i;
+    double frac;
+
+    for (i = 0; i < 256; ++i)
+    {
+        frac = pow (i / 255.0, gamma);
+        table[i] = (frac > 1.0) ? 255 : ((frac < 0.0) ? 0 :
+                                         (Uint8) (frac * 255 + .5));
+    }
+}
+
+/* Look up the red, green and blue bytes in table; alpha is never
+   gamma corrected */
+static PG_COLORSPACE_UNUSED void
+pg_table_pixels (Uint8 *pixels, Py_ssize_t n, int size,
+                 int roff, int goff, int boff, const Uint8 table[256])
+{
+    Py_ssize_t i;
+    Uint8 *p;
+
+    for (i = 0, p = pixels; i < n; ++i, p += size)
+    {
+        p[roff] = table[p[roff]];
+        p[goff] = table[p[goff]];
+        p[boff] = table[p[boff]];
+    }
+}
+
+#endif /* #if !defined(PGCOLORSPACE_H) */
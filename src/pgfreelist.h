@@ -0,0 +1,136 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* Free lists for small, short lived objects, like the ones CPython
+   keeps for floats and tuples. A dealloc hands the memory of an object
+   of exactly the list's type back instead of freeing it, and the next
+   new object of that type reuses it. Subclass instances are never kept.
+   Each module including this keeps its own static lists. A list made
+   with PG_FREELIST_INIT_GC holds objects of a garbage collected type.
+   Depends on pygame.h being included first.
+ */
+#if !defined(PGFREELIST_H)
+#define PGFREELIST_H
+
+#define PG_FREELIST_SIZE 1024
+
+typedef struct
+{
+    PyObject **items;
+    Py_ssize_t count;   /* objects in items */
+    Py_ssize_t size;    /* most objects kept */
+    unsigned long hits;
+    unsigned long misses;
+    void (*clear) (PyObject *); /* frees what a kept object still owns */
+    int gc;             /* objects are garbage collected */
+} PgFreeList;
+
+#define PG_FREELIST_INIT(clear) {NULL, 0, PG_FREELIST_SIZE, 0, 0, clear, 0}
+#define PG_FREELIST_INIT_GC(clear) \
+    {NULL, 0, PG_FREELIST_SIZE, 0, 0, clear, 1}
+
+/* Return a kept object made over as a new reference of type, or NULL
+   if there is none and the caller must use tp_alloc. Only the object
+   header is set; every other field keeps its old value. A garbage
+   collected object is not tracked until the caller has set its fields
+   and calls PyObject_GC_Track. */
+static PyObject*
+PgFreeList_Pop (PgFreeList *list, PyTypeObject *type)
+{
+    PyObject *obj;
+
+    if (!list->count)
+    {
+        if (list->size)
+            list->misses++;
+        return NULL;
+    }
+    obj = list->items[--list->count];
+    list->hits++;
+    return PyObject_INIT (obj, type);
+}
+
+/* Keep obj, whose refcount has dropped to zero, and return 1, or return
+   0 if the list is full and the caller must free it. A garbage collected
+   object must already be untracked. */
+static int
+PgFreeList_Push (PgFreeList *list, PyObject *obj)
+{
+    if (list->count >= list->size)
+        return 0;
+    if (!list->items)
+    {
+        list->items = PyMem_New (PyObject *, list->size);
+        if (!list->items)
+            return 0;
+    }
+    list->items[list->count++] = obj;
+    return 1;
+}
+
+/* Change how many objects are kept, freeing any over the new size */
+static int
+PgFreeList_Resize (PgFreeList *list, Py_ssize_t size)
+{
+    PyObject **items = NULL;
+    PyObject *obj;
+
+    if (size < 0)
+    {
+        PyErr_SetString (PyExc_ValueError, "size must not be negative");
+        return -1;
+    }
+    while (list->count > size)
+    {
+        obj = list->items[--list->count];
+        if (list->clear)
+            list->clear (obj);
+        if (list->gc)
+            PyObject_GC_Del (obj);
+        else
+            PyObject_Del (obj);
+    }
+    if (list->items && size)
+    {
+        /* Resize into a temporary, so a failure keeps the old block */
+        if ((size_t)size <= PY_SSIZE_T_MAX / sizeof (PyObject *))
+            items = (PyObject **)PyMem_Realloc (list->items,
+                                                size * sizeof (PyObject *));
+        if (!items)
+        {
+            PyErr_NoMemory ();
+            return -1;
+        }
+    }
+    else
+        PyMem_Del (list->items);
+    list->items = items;
+    list->size = size;
+    return 0;
+}
+
+/* (size, count, hits, misses) */
+static PyObject*
+PgFreeList_Stats (PgFreeList *list)
+{
+    return Py_BuildValue ("(nnkk)", list->size, list->count,
+                          list->hits, list->misses);
+}
+
+#endif /* #if !defined(PGFREELIST_H) */
@@ -0,0 +1,319 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* image.load_many, shared by the image and imageext modules, which each
+   pass in their own loader. The files are decoded on worker threads that
+   take the next file name from a shared counter, and, for a software
+   display, convert the decoded surface too. The calling thread waits
+   with the GIL released and wraps each surface as it is finished, so the
+   callback sees files in the order they finish. Depends on pygame.h
+   being included first and the rwobject C api being imported.
+ */
+#if !defined(PGLOADMANY_H)
+#define PGLOADMANY_H
+
+#include <SDL_thread.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/* Most worker threads decoding at once */
+#define PG_LOAD_MANY_MAX_THREADS 16
+#define PG_LOAD_MANY_ERROR_SIZE 512
+
+/* Returns a new surface for file, or NULL with the SDL error set */
+typedef SDL_Surface* (*PG_LOAD_FUNC_P) (const char *file);
+
+typedef struct
+{
+    PG_LOAD_FUNC_P  load;
+    int             convert;    /* 0, or 1 for convert, 2 for convert_alpha */
+    int             convert_here; /* done by the workers */
+    Py_ssize_t      count;
+    const char    **names;
+    SDL_Surface   **surfs;      /* NULL where a file failed */
+    Py_ssize_t     *order;      /* indices of the files finished so far */
+    Py_ssize_t      nfinished;
+    Py_ssize_t      next;       /* next file a worker takes */
+    int             quit;       /* no more files are taken */
+    int             failed;     /* error holds the first loading error */
+    char            error[PG_LOAD_MANY_ERROR_SIZE];
+    SDL_mutex      *lock;       /* held for all of the above from next */
+    SDL_sem        *finished;   /* posted for each file finished */
+} PgLoadMany;
+
+static int
+pg_load_many_cpu_count (void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO sysinfo;
+
+    GetSystemInfo (&sysinfo);
+    return (int) sysinfo.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf (_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (int) count : 1;
+#else
+    return 1;
+#endif
+}
+
+/* Surface.convert or convert_alpha of surf to the display format; frees
+   surf. Returns NULL with the SDL error set on failure. */
+static SDL_Surface*
+pg_load_many_convert (SDL_Surface *surf, int convert)
+{
+    SDL_Surface *converted;
+
+    if (convert == 2)
+        converted = SDL_DisplayFormatAlpha (surf);
+    else
+        converted = SDL_DisplayFormat (surf);
+    SDL_FreeSurface (surf);
+    return converted;
+}
+
+static int
+pg_load_many_worker (void *data)
+{
+    PgLoadMany *job = (PgLoadMany *) data;
+    SDL_Surface *surf;
+    Py_ssize_t i;
+
+    for (;;)
+    {
+        SDL_LockMutex (job->lock);
+        if (job->quit || job->next == job->count)
+        {
+            SDL_UnlockMutex (job->lock);
+            break;
+        }
+        i = job->next++;
+        SDL_UnlockMutex (job->lock);
+
+        surf = job->load (job->names[i]);
+        if (surf && job->convert_here)
+            surf = pg_load_many_convert (surf, job->convert);
+
+        SDL_LockMutex (job->lock);
+        if (!surf && !job->failed)
+        {
+            /* SDL keeps an error message for each thread */
+            strncpy (job->error, SDL_GetError (),
+                     PG_LOAD_MANY_ERROR_SIZE - 1);
+            job->failed = 1;
+        }
+        job->surfs[i] = surf;
+        job->order[job->nfinished++] = i;
+        SDL_UnlockMutex (job->lock);
+        SDL_SemPost (job->finished);
+    }
+    return 0;
+}
+
+/* Stop the workers taking files; returns how many they took */
+static Py_ssize_t
+pg_load_many_quit (PgLoadMany *job)
+{
+    Py_ssize_t taken;
+
+    SDL_LockMutex (job->lock);
+    job->quit = 1;
+    taken = job->next;
+    SDL_UnlockMutex (job->lock);
+    return taken;
+}
+
+/* load_many(paths, callback=None, convert=False, alpha=False) for load */
+static PyObject*
+pg_load_many (PyObject *args, PyObject *kwds, PG_LOAD_FUNC_P load)
+{
+    PyObject *paths, *seq = NULL, *encoded = NULL, *result = NULL;
+    PyObject *callback = Py_None, *surfobj, *ret;
+    PyObject *item, *oencoded;
+    int convert = 0, alpha = 0;
+    SDL_Surface *video, *surf;
+    SDL_Thread *workers[PG_LOAD_MANY_MAX_THREADS];
+    int nworkers = 0, nthreads, n;
+    Py_ssize_t i, index, nread = 0, expected;
+    PgLoadMany job;
+    static char *kwids[] = {"paths", "callback", "convert", "alpha", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|Oii", kwids, &paths,
+                                      &callback, &convert, &alpha))
+        return NULL;
+    if (callback != Py_None && !PyCallable_Check (callback))
+        return RAISE (PyExc_TypeError, "callback must be callable or None");
+
+    memset (&job, 0, sizeof (job));
+    job.load = load;
+    if (convert || alpha)
+    {
+        if (!SDL_WasInit (SDL_INIT_VIDEO))
+            return RAISE (PyExc_SDLError,
+                          "cannot convert without pygame.display initialized");
+        video = SDL_GetVideoSurface ();
+        if (!video)
+            return RAISE (PyExc_SDLError, "No video mode has been set");
+        job.convert = alpha ? 2 : 1;
+        /* Conversion to a hardware display format has to stay with the
+           display, on the calling thread */
+        job.convert_here = !(video->flags & (SDL_HWSURFACE | SDL_OPENGL));
+    }
+
+    seq = PySequence_Fast (paths, "paths must be a sequence of file names");
+    if (!seq)
+        return NULL;
+    job.count = PySequence_Fast_GET_SIZE (seq);
+    encoded = PyList_New (job.count);
+    if (!encoded)
+        goto end;
+    for (i = 0; i < job.count; ++i)
+    {
+        item = PySequence_Fast_GET_ITEM (seq, i);
+        oencoded = RWopsEncodeFilePath (item, PyExc_SDLError);
+        if (!oencoded)
+            goto end;
+        if (oencoded == Py_None)
+        {
+            Py_DECREF (oencoded);
+            PyErr_Format (PyExc_TypeError,
+                          "Expected a file name: got %.1024s",
+                          Py_TYPE (item)->tp_name);
+            goto end;
+        }
+        PyList_SET_ITEM (encoded, i, oencoded);
+    }
+
+    result = PyList_New (job.count);
+    if (!result)
+        goto end;
+    job.names = PyMem_New (const char *, job.count ? job.count : 1);
+    job.surfs = PyMem_New (SDL_Surface *, job.count ? job.count : 1);
+    job.order = PyMem_New (Py_ssize_t, job.count ? job.count : 1);
+    if (!job.names || !job.surfs || !job.order)
+    {
+        PyErr_NoMemory ();
+        goto fail;
+    }
+    for (i = 0; i < job.count; ++i)
+    {
+        job.names[i] = Bytes_AS_STRING (PyList_GET_ITEM (encoded, i));
+        job.surfs[i] = NULL;
+    }
+    job.lock = SDL_CreateMutex ();
+    job.finished = SDL_CreateSemaphore (0);
+    if (!job.lock || !job.finished)
+    {
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+        goto fail;
+    }
+
+    nthreads = pg_load_many_cpu_count ();
+    if (nthreads > PG_LOAD_MANY_MAX_THREADS)
+        nthreads = PG_LOAD_MANY_MAX_THREADS;
+    if (nthreads > job.count)
+        nthreads = (int) job.count;
+    Py_BEGIN_ALLOW_THREADS;
+    for (n = 0; n < nthreads; ++n)
+    {
+        workers[n] = SDL_CreateThread (pg_load_many_worker, &job);
+        if (!workers[n])
+            break;
+        nworkers = n + 1;
+    }
+    if (!nworkers)
+        pg_load_many_worker (&job);
+    Py_END_ALLOW_THREADS;
+
+    /* Wrap the surfaces as they come in, until every file taken is done */
+    expected = job.count;
+    while (nread < expected)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_SemWait (job.finished);
+        Py_END_ALLOW_THREADS;
+        SDL_LockMutex (job.lock);
+        index = job.order[nread++];
+        surf = job.surfs[index];
+        job.surfs[index] = NULL;
+        SDL_UnlockMutex (job.lock);
+
+        if (PyErr_Occurred () || job.quit)
+        {
+            /* Already failing; just drain */
+            if (surf)
+                SDL_FreeSurface (surf);
+            continue;
+        }
+        if (surf && job.convert && !job.convert_here)
+            surf = pg_load_many_convert (surf, job.convert);
+        if (!surf)
+        {
+            SDL_LockMutex (job.lock);
+            PyErr_SetString (PyExc_SDLError,
+                             job.failed ? job.error : SDL_GetError ());
+            SDL_UnlockMutex (job.lock);
+            expected = pg_load_many_quit (&job);
+            continue;
+        }
+        surfobj = PySurface_New (surf);
+        if (!surfobj)
+        {
+            SDL_FreeSurface (surf);
+            expected = pg_load_many_quit (&job);
+            continue;
+        }
+        PyList_SET_ITEM (result, index, surfobj);
+        if (callback != Py_None)
+        {
+            ret = PyObject_CallFunction (callback, "nO", index, surfobj);
+            if (!ret)
+                expected = pg_load_many_quit (&job);
+            Py_XDECREF (ret);
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (n = 0; n < nworkers; ++n)
+        SDL_WaitThread (workers[n], NULL);
+    Py_END_ALLOW_THREADS;
+    if (PyErr_Occurred ())
+        goto fail;
+    goto end;
+
+fail:
+    Py_CLEAR (result);
+end:
+    if (job.finished)
+        SDL_DestroySemaphore (job.finished);
+    if (job.lock)
+        SDL_DestroyMutex (job.lock);
+    PyMem_Del (job.names);
+    PyMem_Del (job.surfs);
+    PyMem_Del (job.order);
+    Py_XDECREF (encoded);
+    Py_DECREF (seq);
+    return result;
+}
+
+#endif /* #if !defined(PGLOADMANY_H) */
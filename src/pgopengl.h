@@ -11,6 +11,64 @@
 #define GL_APIENTRY
 #endif
 
+#include <stddef.h>
+
 typedef void (GL_APIENTRY *GL_glReadPixels_Func)(int, int, int, int, unsigned int, unsigned int, void*);
 
+/* For the GLBLIT display presenter */
+typedef const unsigned char* (GL_APIENTRY *GL_glGetString_Func)(unsigned int);
+typedef void (GL_APIENTRY *GL_glGenTextures_Func)(int, unsigned int*);
+typedef void (GL_APIENTRY *GL_glDeleteTextures_Func)(int, const unsigned int*);
+typedef void (GL_APIENTRY *GL_glBindTexture_Func)(unsigned int, unsigned int);
+typedef void (GL_APIENTRY *GL_glTexParameteri_Func)(unsigned int, unsigned int, int);
+typedef void (GL_APIENTRY *GL_glTexImage2D_Func)(unsigned int, int, int, int, int, int, unsigned int, unsigned int, const void*);
+typedef void (GL_APIENTRY *GL_glTexSubImage2D_Func)(unsigned int, int, int, int, int, int, unsigned int, unsigned int, const void*);
+typedef void (GL_APIENTRY *GL_glPixelStorei_Func)(unsigned int, int);
+typedef void (GL_APIENTRY *GL_glViewport_Func)(int, int, int, int);
+typedef void (GL_APIENTRY *GL_glClearColor_Func)(float, float, float, float);
+typedef void (GL_APIENTRY *GL_glClear_Func)(unsigned int);
+typedef void (GL_APIENTRY *GL_glEnable_Func)(unsigned int);
+typedef void (GL_APIENTRY *GL_glDisable_Func)(unsigned int);
+typedef void (GL_APIENTRY *GL_glMatrixMode_Func)(unsigned int);
+typedef void (GL_APIENTRY *GL_glLoadIdentity_Func)(void);
+typedef void (GL_APIENTRY *GL_glBegin_Func)(unsigned int);
+typedef void (GL_APIENTRY *GL_glEnd_Func)(void);
+typedef void (GL_APIENTRY *GL_glTexCoord2f_Func)(float, float);
+typedef void (GL_APIENTRY *GL_glVertex2f_Func)(float, float);
+typedef void (GL_APIENTRY *GL_glGenBuffers_Func)(int, unsigned int*);
+typedef void (GL_APIENTRY *GL_glDeleteBuffers_Func)(int, const unsigned int*);
+typedef void (GL_APIENTRY *GL_glBindBuffer_Func)(unsigned int, unsigned int);
+typedef void (GL_APIENTRY *GL_glBufferData_Func)(unsigned int, ptrdiff_t, const void*, unsigned int);
+typedef void* (GL_APIENTRY *GL_glMapBuffer_Func)(unsigned int, unsigned int);
+typedef unsigned char (GL_APIENTRY *GL_glUnmapBuffer_Func)(unsigned int);
+
+#define PG_GL_QUADS 0x0007
+#define PG_GL_DEPTH_TEST 0x0B71
+#define PG_GL_BLEND 0x0BE2
+#define PG_GL_UNPACK_ROW_LENGTH 0x0CF2
+#define PG_GL_UNPACK_ALIGNMENT 0x0CF5
+#define PG_GL_TEXTURE_2D 0x0DE1
+#define PG_GL_MODELVIEW 0x1700
+#define PG_GL_PROJECTION 0x1701
+#define PG_GL_VERSION 0x1F02
+#define PG_GL_EXTENSIONS 0x1F03
+#define PG_GL_NEAREST 0x2600
+#define PG_GL_LINEAR 0x2601
+#define PG_GL_TEXTURE_MAG_FILTER 0x2800
+#define PG_GL_TEXTURE_MIN_FILTER 0x2801
+#define PG_GL_TEXTURE_WRAP_S 0x2802
+#define PG_GL_TEXTURE_WRAP_T 0x2803
+#define PG_GL_COLOR_BUFFER_BIT 0x4000
+#define PG_GL_RGB8 0x8051
+#define PG_GL_BGRA 0x80E1
+#define PG_GL_CLAMP_TO_EDGE 0x812F
+#define PG_GL_UNSIGNED_INT_8_8_8_8_REV 0x8367
+#define PG_GL_STREAM_DRAW 0x88E0
+#define PG_GL_WRITE_ONLY 0x88B9
+#define PG_GL_PIXEL_UNPACK_BUFFER 0x88EC
+
+/* set_mode flag for a software display presented through OpenGL; a bit
+ * SDL 1.2 does not use */
+#define PG_GLBLIT 0x00800000
+
 #endif
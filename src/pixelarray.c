@@ -24,6 +24,7 @@
 #include "pgcompat.h"
 #include "doc/pixelarray_doc.h"
 #include "surface.h"
+#include "pgfreelist.h"
 
 #if PY_VERSION_HEX < 0x02050000
 #define PyIndex_Check(op) 0
@@ -54,6 +55,9 @@ typedef struct _pixelarray_t {
                            /* Parent pixel array: NULL if no parent */
 } PyPixelArray;
 
+/* Kept arrays for the views slicing makes, many of them short lived */
+static PgFreeList _pxarray_freelist = PG_FREELIST_INIT_GC(NULL);
+
 static int array_is_contiguous(PyPixelArray *ap, char fortran);
 
 static PyPixelArray *_pxarray_new_internal(
@@ -156,6 +160,16 @@ static PyMethodDef _pxarray_methods[] =
       DOC_PIXELARRAYREPLACE },
     { "transpose", (PyCFunction)_transpose, METH_NOARGS,
       DOC_PIXELARRAYTRANSPOSE },
+#if PG_ENABLE_NEWBUF
+    { "read_rect", (PyCFunction)_read_rect, METH_VARARGS | METH_KEYWORDS,
+      DOC_PIXELARRAYREADRECT },
+    { "write_rect", (PyCFunction)_write_rect, METH_VARARGS | METH_KEYWORDS,
+      DOC_PIXELARRAYWRITERECT },
+    { "read_points", (PyCFunction)_read_points, METH_VARARGS | METH_KEYWORDS,
+      DOC_PIXELARRAYREADPOINTS },
+    { "write_points", (PyCFunction)_write_points,
+      METH_VARARGS | METH_KEYWORDS, DOC_PIXELARRAYWRITEPOINTS },
+#endif
     { NULL, NULL, 0, NULL }
 };
 
@@ -314,11 +328,18 @@ _pxarray_new_internal(PyTypeObject *type,
                       Py_ssize_t dim0, Py_ssize_t dim1,
                       Py_ssize_t stride0, Py_ssize_t stride1)
 {
-    PyPixelArray *self;
+    PyPixelArray *self = 0;
+    int tracked = 1;
 
-    self = (PyPixelArray *)type->tp_alloc(type, 0);
+    if (type == &PyPixelArray_Type) {
+        self = (PyPixelArray *)PgFreeList_Pop(&_pxarray_freelist, type);
+        tracked = !self;
+    }
     if (!self) {
-        return 0;
+        self = (PyPixelArray *)type->tp_alloc(type, 0);
+        if (!self) {
+            return 0;
+        }
     }
 
     self->weakrefs = 0;
@@ -352,6 +373,9 @@ _pxarray_new_internal(PyTypeObject *type,
     self->strides[0] = stride0;
     self->strides[1] = stride1;
     self->pixels = pixels;
+    if (!tracked) {
+        PyObject_GC_Track(self);
+    }
 
     return self;
 }
@@ -407,6 +431,10 @@ _pxarray_dealloc(PyPixelArray *self)
     }
     Py_DECREF(self->surface);
     Py_XDECREF(self->dict);
+    if (Py_TYPE(self) == &PyPixelArray_Type &&
+        PgFreeList_Push(&_pxarray_freelist, (PyObject *)self)) {
+        return;
+    }
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
@@ -1897,6 +1925,41 @@ _pxarray_ass_subscript(PyPixelArray *array, PyObject* op, PyObject* value)
 }
 
 
+/**** Module functions ****/
+
+static PyObject *
+_pxarray_set_freelist_size(PyObject *self, PyObject *args)
+{
+    Py_ssize_t size;
+
+    if (!PyArg_ParseTuple(args, "n", &size)) {
+        return 0;
+    }
+    if (PgFreeList_Resize(&_pxarray_freelist, size)) {
+        return 0;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_pxarray_get_freelist_stats(PyObject *self)
+{
+    return PgFreeList_Stats(&_pxarray_freelist);
+}
+
+static PyMethodDef _pxarray_module_methods[] =
+{
+    { "set_freelist_size", _pxarray_set_freelist_size, METH_VARARGS,
+      "set_freelist_size(size) -> None\n"
+      "set how many dead PixelArrays are kept for reuse" },
+    { "get_freelist_stats", (PyCFunction)_pxarray_get_freelist_stats,
+      METH_NOARGS,
+      "get_freelist_stats() -> (size, count, hits, misses)\n"
+      "get the state of the free list of PixelArrays" },
+    { NULL, NULL, 0, NULL }
+};
+
+
 /**** C API interfaces ****/
 static PyObject* PyPixelArray_New(PyObject *surfobj)
 {
@@ -1940,7 +2003,7 @@ MODINIT_DEFINE(pixelarray)
         "pixelarray",
         NULL,
         -1,
-        NULL,
+        _pxarray_module_methods,
         NULL, NULL, NULL, NULL
     };
 #endif
@@ -1960,6 +2023,10 @@ MODINIT_DEFINE(pixelarray)
     if (PyErr_Occurred()) {
         MODINIT_ERROR;
     }
+    import_pygame_rect();
+    if (PyErr_Occurred()) {
+        MODINIT_ERROR;
+    }
 
     /* type preparation */
     if (PyType_Ready(&PyPixelArray_Type)) {
@@ -1970,7 +2037,8 @@ MODINIT_DEFINE(pixelarray)
 #if PY3
     module = PyModule_Create(&_module);
 #else
-    module = Py_InitModule3(MODPREFIX "pixelarray", 0, 0);
+    module = Py_InitModule3(MODPREFIX "pixelarray",
+                            _pxarray_module_methods, 0);
 #endif
     if (!module) {
         MODINIT_ERROR;
@@ -32,6 +32,12 @@
 #define WG_NTSC 0.587
 #define WB_NTSC 0.114
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PXARRAY_SSE2
+#include <emmintrin.h>
+#endif
+
 /* Modified RGBAFromColorObj that only accepts pygame.Color or tuple objects.
  */
 static int
@@ -85,47 +91,78 @@ _get_color_from_object(PyObject *val, SDL_PixelFormat *format, Uint32 *color)
 
 
 /**
- * Retrieves a single pixel located at index from the surface pixel
- * array.
+ * The value of the bpp byte pixel at pixel_p.
  */
-static PyObject *
-_get_single_pixel(PyPixelArray *array, Uint32 x, Uint32 y)
+static Uint32
+_pixel_load(Uint8 *pixel_p, int bpp)
 {
-    Uint8 *pixel_p = (array->pixels +
-                      x * array->strides[0] +
-                      y * array->strides[1]);
-    SDL_Surface *surf = PySurface_AsSurface(array->surface);
-    int bpp;
-    Uint32 pixel;
+    switch (bpp) {
 
-    bpp = surf->format->BytesPerPixel;
+    case 1:
+        return (Uint32)*pixel_p;
+    case 2:
+        return (Uint32)*((Uint16 *)pixel_p);
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        return ((Uint32)pixel_p[0] +
+                ((Uint32)pixel_p[1] << 8) +
+                ((Uint32)pixel_p[2] << 16));
+#else
+        return ((Uint32)pixel_p[2] +
+                ((Uint32)pixel_p[1] << 8) +
+                ((Uint32)pixel_p[0] << 16));
+#endif
+    default:  /* 4 */
+        assert(bpp == 4);
+        return *((Uint32 *)pixel_p);
+    }
+}
 
-    /* Find the start of the pixel */
+/**
+ * Sets the bpp byte pixel at pixel_p to pixel.
+ */
+static void
+_pixel_store(Uint8 *pixel_p, int bpp, Uint32 pixel)
+{
     switch (bpp) {
 
     case 1:
-        pixel = (Uint32)*pixel_p;
+        *pixel_p = (Uint8)pixel;
         break;
     case 2:
-        pixel = (Uint32)*((Uint16 *)pixel_p);
+        *((Uint16 *)pixel_p) = (Uint16)pixel;
         break;
     case 3:
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-        pixel = ((Uint32)pixel_p[0] +
-      	         ((Uint32)pixel_p[1] << 8) +
-                 ((Uint32)pixel_p[2] << 16));
+        pixel_p[0] = (Uint8)pixel;
+        pixel_p[1] = (Uint8)(pixel >> 8);
+        pixel_p[2] = (Uint8)(pixel >> 16);
 #else
-        pixel = ((Uint32)pixel_p[2] +
-                 ((Uint32)pixel_p[1] << 8) +
-                 ((Uint32)pixel_p[0] << 16));
+        pixel_p[2] = (Uint8)pixel;
+        pixel_p[1] = (Uint8)(pixel >> 8);
+        pixel_p[0] = (Uint8)(pixel >> 16);
 #endif
         break;
     default:  /* 4 */
         assert(bpp == 4);
-        pixel = *((Uint32 *)pixel_p);
+        *((Uint32 *)pixel_p) = pixel;
     }
+}
+
+/**
+ * Retrieves a single pixel located at index from the surface pixel
+ * array.
+ */
+static PyObject *
+_get_single_pixel(PyPixelArray *array, Uint32 x, Uint32 y)
+{
+    Uint8 *pixel_p = (array->pixels +
+                      x * array->strides[0] +
+                      y * array->strides[1]);
+    SDL_Surface *surf = PySurface_AsSurface(array->surface);
 
-    return PyInt_FromLong((long)pixel);
+    return PyInt_FromLong(
+        (long)_pixel_load(pixel_p, surf->format->BytesPerPixel));
 }
 
 /**
@@ -350,6 +387,276 @@ _get_weights(PyObject *weights, float *wr, float *wg, float *wb)
     return 0;
 }
 
+/* The test of replace, extract and compare for whether two colors are
+ * within distance of each other: the weighted square sum of their channel
+ * differences, wr * dr * dr + wg * dg * dg + wb * db * db, is at most
+ * limit. limit is the largest float for which the sqrt of the sum over
+ * 255 is within distance, so the test matches COLOR_DIFF_RGB without
+ * taking a sqrt for each pixel.
+ */
+typedef struct {
+    float wr, wg, wb;
+    float limit;
+    int exact;           /* distance 0: compare pixel values */
+    float r, g, b;       /* the color to match, if not another array */
+} PixelDistance;
+
+typedef union {
+    float f;
+    Uint32 u;
+} _FloatBits;
+
+static int
+_sum_within(float sum, float distance)
+{
+    return sqrt((double)sum) / 255.0 <= distance;
+}
+
+static void
+_set_pixel_distance(PixelDistance *test, float distance,
+                    float wr, float wg, float wb)
+{
+    _FloatBits limit, next;
+
+    test->wr = wr;
+    test->wg = wg;
+    test->wb = wb;
+    test->exact = distance == 0.0;
+    test->r = test->g = test->b = 0;
+
+    /* Step from the exact square to the last float passing the test;
+     * positive floats are in the order of their bits. */
+    limit.f = (float)((distance * 255.0) * (distance * 255.0));
+    while (limit.u && !_sum_within(limit.f, distance)) {
+        --limit.u;
+    }
+    next.u = limit.u + 1;
+    while (_sum_within(next.f, distance)) {
+        limit.u = next.u++;
+    }
+    test->limit = limit.f;
+}
+
+#define PIXEL_DISTANCE_WITHIN(test, dr, dg, db)          \
+    ((test)->wr * (dr) * (dr) + (test)->wg * (dg) * (dg) + \
+     (test)->wb * (db) * (db) <= (test)->limit)
+
+/**
+ * The RGB of the pixel value pixel, the palette index for 8 bit pixels.
+ */
+static void
+_pixel_rgb(Uint32 pixel, SDL_PixelFormat *format, Uint8 *r, Uint8 *g, Uint8 *b)
+{
+    Uint8 a;
+
+    if (format->BytesPerPixel == 1) {
+        Uint8 index = (Uint8)pixel;
+
+        GET_PIXELVALS_1(*r, *g, *b, a, &index, format);
+    }
+    else {
+        GET_PIXELVALS(*r, *g, *b, a, pixel, format, 0);
+    }
+}
+
+/* True if the RGB channels of a 32 bit format are each a whole byte */
+#define PXARRAY_RGB_BYTES_32(format)                             \
+    ((format)->BytesPerPixel == 4 &&                             \
+     (format)->Rmask == (Uint32)0xFF << (format)->Rshift &&      \
+     (format)->Gmask == (Uint32)0xFF << (format)->Gshift &&      \
+     (format)->Bmask == (Uint32)0xFF << (format)->Bshift)
+
+#define PXARRAY_SAME_MASKS(f1, f2)                                  \
+    ((f1)->Rmask == (f2)->Rmask && (f1)->Gmask == (f2)->Gmask &&    \
+     (f1)->Bmask == (f2)->Bmask && (f1)->Amask == (f2)->Amask)
+
+#if defined(PXARRAY_SSE2)
+/* Four 32 bit pixels from p, stride bytes apart */
+static __m128i
+_load_pixels_32(const Uint8 *p, Py_ssize_t stride)
+{
+    if (stride == 4) {
+        return _mm_loadu_si128((const __m128i *)p);
+    }
+    return _mm_set_epi32(*(const Sint32 *)(p + 3 * stride),
+                         *(const Sint32 *)(p + 2 * stride),
+                         *(const Sint32 *)(p + stride),
+                         *(const Sint32 *)p);
+}
+
+/* The channel at shift of four 32 bit pixels as floats */
+static __m128
+_channel_32(__m128i pixels, int shift)
+{
+    return _mm_cvtepi32_ps(
+        _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(shift)),
+                      _mm_set1_epi32(0xFF)));
+}
+
+/* The test of PIXEL_DISTANCE_WITHIN on four pixels at once: the same float
+ * operations in the same order, so the results match.  */
+static int
+_within_32(const PixelDistance *test, __m128i pixels, SDL_PixelFormat *format,
+           __m128 r, __m128 g, __m128 b)
+{
+    __m128 dr = _mm_sub_ps(r, _channel_32(pixels, format->Rshift));
+    __m128 dg = _mm_sub_ps(g, _channel_32(pixels, format->Gshift));
+    __m128 db = _mm_sub_ps(b, _channel_32(pixels, format->Bshift));
+    __m128 sum;
+
+    sum = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(test->wr), dr), dr),
+                   _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(test->wg), dg), dg)),
+        _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(test->wb), db), db));
+    return _mm_movemask_ps(_mm_cmple_ps(sum, _mm_set1_ps(test->limit)));
+}
+#endif /* PXARRAY_SSE2 */
+
+/**
+ * Sets match[x] for the n bpp byte pixels from pixel_p, stride0 bytes
+ * apart, to whether they are within test of color, or, if other_p is
+ * not NULL, of the pixels from it, other_stride0 bytes apart.
+ */
+static void
+_match_row(const PixelDistance *test, Uint32 color,
+           Uint8 *pixel_p, Py_ssize_t stride0, SDL_PixelFormat *format,
+           Uint8 *other_p, Py_ssize_t other_stride0,
+           SDL_PixelFormat *other_format, Py_ssize_t n, Uint8 *match)
+{
+    int bpp = format->BytesPerPixel;
+    int raw = !other_p || PXARRAY_SAME_MASKS(format, other_format);
+    Uint8 r1, g1, b1, r2, g2, b2;
+    Uint32 pixel, other;
+    Py_ssize_t x = 0;
+
+#if defined(PXARRAY_SSE2)
+    if (bpp == 4 && (test->exact ? raw :
+                     PXARRAY_RGB_BYTES_32(format) &&
+                     (!other_p || PXARRAY_RGB_BYTES_32(other_format)))) {
+        __m128i pixels, others = _mm_set1_epi32((int)color);
+        __m128 r = _mm_set1_ps(test->r);
+        __m128 g = _mm_set1_ps(test->g);
+        __m128 b = _mm_set1_ps(test->b);
+        int bits, i;
+
+        for (; x + 4 <= n; x += 4) {
+            pixels = _load_pixels_32(pixel_p, stride0);
+            if (other_p) {
+                others = _load_pixels_32(other_p, other_stride0);
+                other_p += 4 * other_stride0;
+            }
+            if (test->exact) {
+                bits = _mm_movemask_ps(
+                    _mm_castsi128_ps(_mm_cmpeq_epi32(pixels, others)));
+            }
+            else {
+                if (other_p) {
+                    r = _channel_32(others, other_format->Rshift);
+                    g = _channel_32(others, other_format->Gshift);
+                    b = _channel_32(others, other_format->Bshift);
+                }
+                bits = _within_32(test, pixels, format, r, g, b);
+            }
+            for (i = 0; i < 4; ++i) {
+                match[x + i] = (bits >> i) & 1;
+            }
+            pixel_p += 4 * stride0;
+        }
+    }
+#endif
+
+    for (; x < n; ++x) {
+        pixel = _pixel_load(pixel_p, bpp);
+        other = other_p ? _pixel_load(other_p, bpp) : color;
+        if (test->exact && raw) {
+            match[x] = pixel == other;
+        }
+        else {
+            _pixel_rgb(pixel, format, &r1, &g1, &b1);
+            if (other_p) {
+                _pixel_rgb(other, other_format, &r2, &g2, &b2);
+            }
+            else {
+                r2 = (Uint8)test->r;
+                g2 = (Uint8)test->g;
+                b2 = (Uint8)test->b;
+            }
+            if (test->exact) {
+                match[x] = r1 == r2 && g1 == g2 && b1 == b2;
+            }
+            else {
+                match[x] = PIXEL_DISTANCE_WITHIN(test, (float)r2 - r1,
+                                                 (float)g2 - g1,
+                                                 (float)b2 - b1);
+            }
+        }
+        pixel_p += stride0;
+        if (other_p) {
+            other_p += other_stride0;
+        }
+    }
+}
+
+/**
+ * The common loop of replace, extract and compare: for each pixel of
+ * array within test of color, or of the pixel of other, if not NULL, set
+ * it to hit, else to miss unless keep_miss is true.
+ */
+static int
+_match_pixels(PyPixelArray *array, PyPixelArray *other,
+              const PixelDistance *test, Uint32 color,
+              Uint32 hit, Uint32 miss, int keep_miss)
+{
+    SDL_Surface *surf = PySurface_AsSurface(array->surface);
+    SDL_PixelFormat *format = surf->format;
+    SDL_PixelFormat *other_format = 0;
+    int bpp = format->BytesPerPixel;
+    Py_ssize_t dim0 = array->shape[0];
+    Py_ssize_t dim1 = array->shape[1] ? array->shape[1] : 1;
+    Py_ssize_t stride0 = array->strides[0];
+    Py_ssize_t stride1 = array->strides[1];
+    Uint8 *row_p = array->pixels;
+    Uint8 *other_row_p = 0;
+    Uint8 *pixel_p;
+    Uint8 *match;
+    Py_ssize_t x;
+    Py_ssize_t y;
+
+    if (other) {
+        other_format = PySurface_AsSurface(other->surface)->format;
+        other_row_p = other->pixels;
+    }
+    match = (Uint8 *)PyMem_Malloc(dim0 ? dim0 : 1);
+    if (!match) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (y = 0; y < dim1; ++y) {
+        _match_row(test, color, row_p, stride0, format, other_row_p,
+                   other ? other->strides[0] : 0, other_format, dim0, match);
+        pixel_p = row_p;
+        for (x = 0; x < dim0; ++x) {
+            if (match[x]) {
+                _pixel_store(pixel_p, bpp, hit);
+            }
+            else if (!keep_miss) {
+                _pixel_store(pixel_p, bpp, miss);
+            }
+            pixel_p += stride0;
+        }
+        row_p += stride1;
+        if (other) {
+            other_row_p += other->strides[1];
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    PyMem_Free(match);
+    return 1;
+}
+
 static PyObject *
 _replace_color(PyPixelArray *array, PyObject *args, PyObject *kwds)
 {
@@ -358,21 +665,12 @@ _replace_color(PyPixelArray *array, PyObject *args, PyObject *kwds)
     PyObject *replcolor = 0;
     SDL_Surface *surf = PySurface_AsSurface(array->surface);
     SDL_PixelFormat *format;
-    Py_ssize_t dim0 = array->shape[0];
-    Py_ssize_t dim1 = array->shape[1];
-    Py_ssize_t stride0 = array->strides[0];
-    Py_ssize_t stride1 = array->strides[1];
-    Uint8 *pixels = array->pixels;
-    int bpp;
     Uint32 dcolor;
     Uint32 rcolor;
-    Uint8 r1, g1, b1, r2, g2, b2, a2;
-    Uint8 *pixelrow;
-    Uint8 *pixel_p;
+    Uint8 r, g, b;
     float distance = 0;
     float wr, wg, wb;
-    Py_ssize_t x;
-    Py_ssize_t y;
+    PixelDistance test;
     static char *keys[] = { "color", "repcolor", "distance", "weights", NULL };
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|fO", keys, &delcolor,
@@ -386,7 +684,6 @@ _replace_color(PyPixelArray *array, PyObject *args, PyObject *kwds)
     }
 
     format = surf->format;
-    bpp = surf->format->BytesPerPixel;
 
     if (!_get_color_from_object(delcolor, format, &dcolor) ||
         !_get_color_from_object(replcolor, format, &rcolor)   ) {
@@ -397,135 +694,17 @@ _replace_color(PyPixelArray *array, PyObject *args, PyObject *kwds)
         return 0;
     }
 
+    _set_pixel_distance(&test, distance, wr, wg, wb);
     if (distance != 0.0) {
-        SDL_GetRGB(dcolor, format, &r1, &g1, &b1);
-    }
-
-    if (!dim1) {
-        dim1 = 1;
-    }
-    pixelrow = pixels;
-
-    Py_BEGIN_ALLOW_THREADS;
-    switch (bpp) {
-
-    case 1:
-    {
-        Uint8 *px_p;
-
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                px_p = pixel_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS_1(r2, g2, b2, a2, px_p, format);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *px_p = (Uint8)rcolor;
-                    }
-                }
-                else if (*px_p == dcolor) {
-                    *px_p = (Uint8)rcolor;
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
-    }
-        break;
-    case 2:
-    {
-        Uint16 *px_p;
-        int ppa = (surf->flags & SDL_SRCALPHA && format->Amask);
-
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                px_p = (Uint16 *)pixel_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r2, g2, b2, a2, (Uint32)*px_p, format, ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *px_p = (Uint16)rcolor;
-                    }
-                }
-                else if (*px_p == dcolor) {
-                    *px_p = (Uint16)rcolor;
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
-    }
-        break;
-    case 3:
-    {
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-        Uint32 Roffset = format->Rshift >> 3;
-        Uint32 Goffset = format->Gshift >> 3;
-        Uint32 Boffset = format->Bshift >> 3;
-#else
-        Uint32 Roffset = 2 - (format->Rshift >> 3);
-        Uint32 Goffset = 2 - (format->Gshift >> 3);
-        Uint32 Boffset = 2 - (format->Bshift >> 3);
-#endif
-        Uint32 pxcolor;
-        int ppa = (surf->flags & SDL_SRCALPHA && format->Amask);
-
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                pxcolor = (((Uint32)pixel_p[Roffset] << 16) +
-                           ((Uint32)pixel_p[Goffset] << 8)  +
-                           ((Uint32)pixel_p[Boffset])         );
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r2, g2, b2, a2, pxcolor, format, ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        pixel_p[Roffset] = (Uint8)(rcolor >> 16);
-                        pixel_p[Goffset] = (Uint8)(rcolor >> 8);
-                        pixel_p[Boffset] = (Uint8)rcolor;
-                    }
-                }
-                else if (pxcolor == dcolor) {
-                    pixel_p[Roffset] = (Uint8)(rcolor >> 16);
-                    pixel_p[Goffset] = (Uint8)(rcolor >> 8);
-                    pixel_p[Boffset] = (Uint8)rcolor;
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
+        SDL_GetRGB(dcolor, format, &r, &g, &b);
+        test.r = r;
+        test.g = g;
+        test.b = b;
     }
-        break;
-    default: /* case 4: */
-    {
-        Uint32 *px_p;
-        int ppa = (surf->flags & SDL_SRCALPHA && surf->format->Amask);
 
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                px_p = (Uint32 *)pixel_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *px_p = rcolor;
-                    }
-                }
-                else if (*px_p == dcolor) {
-                    *px_p = rcolor;
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
-    }
-        break;
+    if (!_match_pixels(array, 0, &test, dcolor, rcolor, 0, 1)) {
+        return 0;
     }
-    Py_END_ALLOW_THREADS;
-
     Py_RETURN_NONE;
 }
 
@@ -534,26 +713,16 @@ _extract_color (PyPixelArray *array, PyObject *args, PyObject *kwds)
 {
     PyObject *weights = 0;
     PyObject *excolor = 0;
-    int bpp;
     Uint32 black;
     Uint32 white;
     Uint32 color;
-    Uint8 r1, g1, b1, r2, g2, b2, a2;
-    Uint8 *pixelrow;
-    Uint8 *pixel_p;
+    Uint8 r, g, b;
     float distance = 0;
     float wr, wg, wb;
-    Py_ssize_t x;
-    Py_ssize_t y;
+    PixelDistance test;
     PyObject *surface;
-    SDL_Surface *surf;
     SDL_PixelFormat *format;
     PyPixelArray *new_array;
-    Py_ssize_t dim0;
-    Py_ssize_t dim1;
-    Py_ssize_t stride0;
-    Py_ssize_t stride1;
-    Uint8 *pixels;
     static char *keys[] = { "color", "distance", "weights", NULL };
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|fO", keys, &excolor,
@@ -582,15 +751,7 @@ _extract_color (PyPixelArray *array, PyObject *args, PyObject *kwds)
         return 0;
     }
 
-    surf = PySurface_AsSurface(surface);
-    format = surf->format;
-    bpp = surf->format->BytesPerPixel;
-    dim0 = new_array->shape[0];
-    dim1 = new_array->shape[1];
-    stride0 = new_array->strides[0];
-    stride1 = new_array->strides[1];
-    pixels = new_array->pixels;
-
+    format = PySurface_AsSurface(surface)->format;
     black = SDL_MapRGBA(format, 0, 0, 0, 255);
     white = SDL_MapRGBA(format, 255, 255, 255, 255);
 
@@ -599,160 +760,18 @@ _extract_color (PyPixelArray *array, PyObject *args, PyObject *kwds)
         return 0;
     }
 
+    _set_pixel_distance(&test, distance, wr, wg, wb);
     if (distance != 0.0) {
-        SDL_GetRGB(color, format, &r1, &g1, &b1);
-    }
-
-    if (!dim1) {
-        dim1 = 1;
-    }
-    pixelrow = pixels;
-
-    Py_BEGIN_ALLOW_THREADS;
-    switch (bpp) {
-
-    case 1:
-    {
-        Uint8 *px_p;
-
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                px_p = pixel_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS_1(r2, g2, b2, a2, px_p, format);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *px_p = (Uint8)white;
-                    }
-                    else {
-                        *px_p = (Uint8)black;
-                    }
-                }
-                else {
-                    *px_p = (Uint8)(*px_p == color ? white : black);
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
+        SDL_GetRGB(color, format, &r, &g, &b);
+        test.r = r;
+        test.g = g;
+        test.b = b;
     }
-        break;
-    case 2:
-    {
-        Uint16 *px_p;
-    int ppa = (surf->flags & SDL_SRCALPHA && format->Amask);
 
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                px_p = (Uint16 *)pixel_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r2, g2, b2, a2, (Uint32)*px_p, format, ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *px_p = (Uint16)white;
-                    }
-                    else {
-                        *px_p = (Uint16)black;
-                    }
-                }
-                else {
-                    *px_p = (Uint16)(*px_p == color ? white : black);
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
-    }
-        break;
-    case 3:
-    {
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-        Uint32 Roffset = format->Rshift >> 3;
-        Uint32 Goffset = format->Gshift >> 3;
-        Uint32 Boffset = format->Bshift >> 3;
-#else
-        Uint32 Roffset = 2 - (format->Rshift >> 3);
-        Uint32 Goffset = 2 - (format->Gshift >> 3);
-        Uint32 Boffset = 2 - (format->Bshift >> 3);
-#endif
-        Uint8 white_r = (Uint8)(white >> 16);
-        Uint8 white_g = (Uint8)(white >> 8);
-        Uint8 white_b = (Uint8)white;
-        Uint8 black_r = (Uint8)(black >> 16);
-        Uint8 black_g = (Uint8)(black >> 8);
-        Uint8 black_b = (Uint8)black;
-        Uint32 pxcolor;
-    int ppa = (surf->flags & SDL_SRCALPHA && format->Amask);
-
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                pxcolor = (((Uint32)pixel_p[Roffset] << 16) +
-                           ((Uint32)pixel_p[Goffset] << 8)  +
-                           ((Uint32)pixel_p[Boffset])         );
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r2, g2, b2, a2, pxcolor, format, ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        pixel_p[Roffset] = white_r;
-                        pixel_p[Goffset] = white_g;
-                        pixel_p[Boffset] = white_b;
-                    }
-                    else {
-                        pixel_p[Roffset] = black_r;
-                        pixel_p[Goffset] = black_g;
-                        pixel_p[Boffset] = black_b;
-                    }
-                }
-                else if (pxcolor == color) {
-                    pixel_p[Roffset] = white_r;
-                    pixel_p[Goffset] = white_g;
-                    pixel_p[Boffset] = white_b;
-                }
-                else {
-                    pixel_p[Roffset] = black_r;
-                    pixel_p[Goffset] = black_g;
-                    pixel_p[Boffset] = black_b;
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
-    }
-        break;
-    default: /* case 4: */
-    {
-        Uint32 *px_p;
-    int ppa = (surf->flags & SDL_SRCALPHA && surf->format->Amask);
-
-        for (y = 0; y < dim1; ++y) {
-            pixel_p = pixelrow;
-            for (x = 0; x < dim0; ++x) {
-                px_p = (Uint32 *)pixel_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *px_p = white;
-                    }
-                    else {
-                        *px_p = black;
-                    }
-                }
-                else {
-                    *px_p = *px_p == color ? white : black;
-                }
-                pixel_p += stride0;
-            }
-            pixelrow += stride1;
-        }
-    }
-        break;
+    if (!_match_pixels(new_array, 0, &test, color, white, black, 0)) {
+        Py_DECREF(new_array);
+        return 0;
     }
-    Py_END_ALLOW_THREADS;
-
     return (PyObject *)new_array;
 }
 
@@ -767,27 +786,13 @@ _compare(PyPixelArray *array, PyObject *args, PyObject *kwds)
     PyObject *weights = 0;
     SDL_Surface *other_surf;
     SDL_PixelFormat *other_format;
-    Py_ssize_t other_stride0;
-    Py_ssize_t other_stride1;
-    Uint8 *other_pixels;
-    int bpp;
     Uint32 black;
     Uint32 white;
-    Uint8 r1, g1, b1, a1, r2, g2, b2, a2;
-    Uint8 *row_p;
-    Uint8 *byte_p;
-    Uint8 *other_row_p;
-    Uint8 *other_byte_p;
     float distance = 0;
     float wr, wg, wb;
-    Py_ssize_t x;
-    Py_ssize_t y;
+    PixelDistance test;
     PyPixelArray *new_array;
     PyObject *new_surface;
-    SDL_PixelFormat *new_format;
-    Py_ssize_t stride0;
-    Py_ssize_t stride1;
-    Uint8 *pixels;
 
     static char *keys[] = { "array", "distance", "weights", NULL };
 
@@ -814,21 +819,16 @@ _compare(PyPixelArray *array, PyObject *args, PyObject *kwds)
     }
 
     format = surf->format;
-    bpp = surf->format->BytesPerPixel;
     other_surf = PySurface_AsSurface(other_array->surface);
     other_format = other_surf->format;
 
-    if (other_format->BytesPerPixel != bpp) {
+    if (other_format->BytesPerPixel != format->BytesPerPixel) {
         /* bpp do not match. We cannot guarantee that the padding and co
          * would be set correctly. */
         PyErr_SetString(PyExc_ValueError, "bit depths do not match");
         return 0;
     }
 
-    other_stride0 = other_array->strides[0];
-    other_stride1 = other_array->strides[1];
-    other_pixels = other_array->pixels;
-
     /* Create the b/w mask surface. */
     new_surface = _make_surface(array);
     if (!new_surface) {
@@ -841,219 +841,351 @@ _compare(PyPixelArray *array, PyObject *args, PyObject *kwds)
         return 0;
     }
 
-    new_format = surf->format;
-    stride0 = new_array->strides[0];
-    stride1 = new_array->strides[1];
-    pixels = new_array->pixels;
-
     black = SDL_MapRGBA(format, 0, 0, 0, 255);
     white = SDL_MapRGBA(format, 255, 255, 255, 255);
 
-    Py_BEGIN_ALLOW_THREADS;
-    if (!dim1) {
-        dim1 = 1;
+    _set_pixel_distance(&test, distance, wr, wg, wb);
+    if (!_match_pixels(new_array, other_array, &test, 0, white, black, 0)) {
+        Py_DECREF(new_array);
+        return 0;
     }
-    row_p = pixels;
-    other_row_p = other_pixels;
+    return (PyObject *)new_array;
+}
 
-    switch (bpp) {
+static PyObject *
+_transpose(PyPixelArray *array)
+{
+    SDL_Surface *surf = PySurface_AsSurface(array->surface);
+    Py_ssize_t dim0 = array->shape[1] ? array->shape[1] : 1;
+    Py_ssize_t dim1 = array->shape[0];
+    Py_ssize_t stride0;
+    Py_ssize_t stride1 = array->strides[0];
 
-    case 1:
-    {
-        Uint8 *pixel_p;
-        Uint8 *other_pixel_p;
+    stride0 = array->shape[1] ?
+        array->strides[1] : array->shape[0] * surf->format->BytesPerPixel;
 
-        for (y = 0; y < dim1; ++y) {
-            byte_p = row_p;
-            other_byte_p = other_row_p;
-            for (x = 0; x < dim0; ++x) {
-                pixel_p = byte_p;
-                other_pixel_p = other_byte_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS_1(r1, g1, b1, a1, pixel_p, new_format);
-                    GET_PIXELVALS_1(r2, g2, b2, a2, other_pixel_p,
-                                    other_format);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *pixel_p = (Uint8)white;
-                    }
-                    else {
-                        *pixel_p = (Uint8)black;
-                    }
-                }
-                else {
-                    *pixel_p = (Uint8)(*pixel_p == *other_pixel_p ?
-                                       white : black);
-                }
-                byte_p += stride0;
-                other_byte_p += other_stride0;
-            }
-            row_p += stride1;
-            other_row_p += other_stride1;
-        }
+    return (PyObject *)_pxarray_new_internal(&PyPixelArray_Type,
+                                             0, array, array->pixels,
+                                             dim0, dim1, stride0, stride1);
+}
+
+/**
+ * Gets a C contiguous buffer of at least count 32 bit integers from obj,
+ * writable if writable is true.
+ */
+static int
+_get_int32_buffer(PyObject *obj, Py_buffer *view_p, Py_ssize_t count,
+                  int writable, const char *name)
+{
+    const char *format;
+
+    if (PyObject_GetBuffer(obj, view_p, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS |
+                           (writable ? PyBUF_WRITABLE : 0))) {
+        return 0;
     }
-        break;
-    case 2:
-    {
-        Uint16 *pixel_p;
-        Uint16 *other_pixel_p;
-        int ppa = (surf->flags & SDL_SRCALPHA && format->Amask);
-        int other_ppa = (other_surf->flags & SDL_SRCALPHA &&
-                         other_format->Amask);
+    format = view_p->format ? view_p->format : "B";
+    if (*format == '@' || *format == '=' || *format == '<' ||
+        *format == '>' || *format == '!') {
+        ++format;
+    }
+    if (view_p->itemsize != 4 || format[1] != '\0' ||
+        !strchr("iIlL", format[0])) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s must be a buffer of 32 bit integers", name);
+        PyBuffer_Release(view_p);
+        return 0;
+    }
+    if (count >= 0 && view_p->len / 4 < count) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s holds %zd items, %zd are needed", name,
+                     view_p->len / 4, count);
+        PyBuffer_Release(view_p);
+        return 0;
+    }
+    return 1;
+}
 
-        for (y = 0; y < dim1; ++y) {
-            byte_p = row_p;
-            other_byte_p = other_row_p;
-            for (x = 0; x < dim0; ++x) {
-                pixel_p = (Uint16 *)byte_p;
-                other_pixel_p = (Uint16 *)other_byte_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r1, g1, b1, a1,
-                                  (Uint32)*pixel_p, format, ppa);
-                    GET_PIXELVALS(r2, g2, b2, a2,
-                                  (Uint32)*pixel_p, other_format, other_ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *pixel_p = (Uint16)white;
-                    }
-                    else {
-                        *pixel_p = (Uint16)black;
-                    }
-                }
-                else {
-                    *pixel_p = (Uint16)(*pixel_p == *other_pixel_p ?
-                                        white : black);
-                }
-                byte_p += stride0;
-                other_byte_p += other_stride0;
+/**
+ * Gets the rect argument of read_rect and write_rect, all of the array if
+ * rectobj is NULL or None. Returns 0 with an exception set if it is not a
+ * rect within the array.
+ */
+static int
+_get_array_rect(PyPixelArray *array, PyObject *rectobj, GAME_Rect *rect)
+{
+    Py_ssize_t dim1 = array->shape[1] ? array->shape[1] : 1;
+    GAME_Rect temp;
+    GAME_Rect *argrect;
+
+    if (!rectobj || rectobj == Py_None) {
+        rect->x = rect->y = 0;
+        rect->w = (int)array->shape[0];
+        rect->h = (int)dim1;
+        return 1;
+    }
+    argrect = GameRect_FromObject(rectobj, &temp);
+    if (!argrect) {
+        PyErr_SetString(PyExc_TypeError, "invalid rect argument");
+        return 0;
+    }
+    if (argrect->x < 0 || argrect->y < 0 || argrect->w < 0 ||
+        argrect->h < 0 || argrect->x + argrect->w > array->shape[0] ||
+        argrect->y + argrect->h > dim1) {
+        PyErr_SetString(PyExc_IndexError, "rect outside the array");
+        return 0;
+    }
+    *rect = *argrect;
+    return 1;
+}
+
+/**
+ * array.read_rect(buffer, rect=None): copies the pixels of rect, row by
+ * row, into a buffer of 32 bit integers.
+ */
+static PyObject *
+_read_rect(PyPixelArray *array, PyObject *args, PyObject *kwds)
+{
+    PyObject *bufobj;
+    PyObject *rectobj = 0;
+    SDL_Surface *surf = PySurface_AsSurface(array->surface);
+    int bpp = surf->format->BytesPerPixel;
+    Py_ssize_t stride0 = array->strides[0];
+    Py_ssize_t stride1 = array->strides[1];
+    GAME_Rect rect;
+    Py_buffer view;
+    Uint32 *out;
+    Uint8 *pixelrow;
+    Uint8 *pixel_p;
+    int x;
+    int y;
+    static char *keys[] = { "buffer", "rect", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", keys,
+                                     &bufobj, &rectobj)) {
+        return 0;
+    }
+    if (!_get_array_rect(array, rectobj, &rect) ||
+        !_get_int32_buffer(bufobj, &view, (Py_ssize_t)rect.w * rect.h, 1,
+                           "buffer")) {
+        return 0;
+    }
+
+    out = (Uint32 *)view.buf;
+    pixelrow = array->pixels + rect.x * stride0 + rect.y * stride1;
+    Py_BEGIN_ALLOW_THREADS;
+    for (y = 0; y < rect.h; ++y) {
+        pixel_p = pixelrow;
+        if (bpp == 4 && stride0 == 4) {
+            memcpy(out, pixel_p, (size_t)rect.w * 4);
+            out += rect.w;
+        }
+        else {
+            for (x = 0; x < rect.w; ++x) {
+                *out++ = _pixel_load(pixel_p, bpp);
+                pixel_p += stride0;
             }
-            row_p += stride1;
-            other_row_p += other_stride1;
         }
+        pixelrow += stride1;
     }
-        break;
-    case 3:
-    {
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-        Uint32 Roffset = format->Rshift >> 3;
-        Uint32 Goffset = format->Gshift >> 3;
-        Uint32 Boffset = format->Bshift >> 3;
-        Uint32 oRoffset = other_format->Rshift >> 3;
-        Uint32 oGoffset = other_format->Gshift >> 3;
-        Uint32 oBoffset = other_format->Bshift >> 3;
-#else
-        Uint32 Roffset = 2 - (format->Rshift >> 3);
-        Uint32 Goffset = 2 - (format->Gshift >> 3);
-        Uint32 Boffset = 2 - (format->Bshift >> 3);
-        Uint32 oRoffset = 2 - (other_format->Rshift >> 3);
-        Uint32 oGoffset = 2 - (other_format->Gshift >> 3);
-        Uint32 oBoffset = 2 - (other_format->Bshift >> 3);
-#endif
-        Uint8 white_r = (Uint8)(white >> 16);
-        Uint8 white_g = (Uint8)(white >> 8);
-        Uint8 white_b = (Uint8)white;
-        Uint8 black_r = (Uint8)(black >> 16);
-        Uint8 black_g = (Uint8)(black >> 8);
-        Uint8 black_b = (Uint8)black;
+    Py_END_ALLOW_THREADS;
 
-        for (y = 0; y < dim1; ++y) {
-            byte_p = row_p;
-            other_byte_p = other_row_p;
-            for (x = 0; x < dim0; ++x) {
-                r1 = byte_p[Roffset];
-                g1 = byte_p[Goffset];
-                b1 = byte_p[Boffset];
-                r2 = other_byte_p[oRoffset];
-                g2 = other_byte_p[oGoffset];
-                b2 = other_byte_p[oBoffset];
-                if (distance != 0.0) {
-                    if (COLOR_DIFF_RGB(wr, wg, wb,
-                                       r1, g1, b1,
-                                       r2, g2, b2) <= distance) {
-                        byte_p[Roffset] = white_r;
-                        byte_p[Goffset] = white_g;
-                        byte_p[Boffset] = white_b;
-                    }
-                    else {
-                        byte_p[Roffset] = black_r;
-                        byte_p[Goffset] = black_g;
-                        byte_p[Boffset] = black_b;
-                    }
-                }
-                else if (r1 == r2 && g1 == g2 && b1 == b2) {
-                    byte_p[Roffset] = white_r;
-                    byte_p[Goffset] = white_g;
-                    byte_p[Boffset] = white_b;
-                }
-                else {
-                    byte_p[Roffset] = black_r;
-                    byte_p[Goffset] = black_g;
-                    byte_p[Boffset] = black_b;
-                }
-                byte_p += stride0;
-                other_byte_p += other_stride0;
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+/**
+ * array.write_rect(buffer, rect=None): the reverse of read_rect.
+ */
+static PyObject *
+_write_rect(PyPixelArray *array, PyObject *args, PyObject *kwds)
+{
+    PyObject *bufobj;
+    PyObject *rectobj = 0;
+    SDL_Surface *surf = PySurface_AsSurface(array->surface);
+    int bpp = surf->format->BytesPerPixel;
+    Py_ssize_t stride0 = array->strides[0];
+    Py_ssize_t stride1 = array->strides[1];
+    GAME_Rect rect;
+    Py_buffer view;
+    const Uint32 *in;
+    Uint8 *pixelrow;
+    Uint8 *pixel_p;
+    int x;
+    int y;
+    static char *keys[] = { "buffer", "rect", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", keys,
+                                     &bufobj, &rectobj)) {
+        return 0;
+    }
+    if (!_get_array_rect(array, rectobj, &rect) ||
+        !_get_int32_buffer(bufobj, &view, (Py_ssize_t)rect.w * rect.h, 0,
+                           "buffer")) {
+        return 0;
+    }
+
+    in = (const Uint32 *)view.buf;
+    pixelrow = array->pixels + rect.x * stride0 + rect.y * stride1;
+    Py_BEGIN_ALLOW_THREADS;
+    for (y = 0; y < rect.h; ++y) {
+        pixel_p = pixelrow;
+        if (bpp == 4 && stride0 == 4) {
+            memcpy(pixel_p, in, (size_t)rect.w * 4);
+            in += rect.w;
+        }
+        else {
+            for (x = 0; x < rect.w; ++x) {
+                _pixel_store(pixel_p, bpp, *in++);
+                pixel_p += stride0;
             }
-            row_p += stride1;
-            other_row_p += other_stride1;
         }
+        pixelrow += stride1;
     }
-        break;
-    default: /* case 4: */
-    {
-        Uint32 *pixel_p;
-        Uint32 *other_pixel_p;
-        int ppa = (surf->flags & SDL_SRCALPHA && surf->format->Amask);
-        int other_ppa = (other_surf->flags & SDL_SRCALPHA &&
-                         other_format->Amask);
+    Py_END_ALLOW_THREADS;
 
-        for (y = 0; y < dim1; ++y) {
-            byte_p = row_p;
-            other_byte_p = other_row_p;
-            for (x = 0; x < dim0; ++x) {
-                pixel_p = (Uint32 *)byte_p;
-                other_pixel_p = (Uint32 *)other_byte_p;
-                if (distance != 0.0) {
-                    GET_PIXELVALS(r1, g1, b1, a1, *pixel_p, format, ppa);
-                    GET_PIXELVALS(r2, g2, b2, a2,
-                                  *pixel_p, other_format, other_ppa);
-                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
-                        distance) {
-                        *pixel_p = white;
-                    }
-                    else {
-                        *pixel_p = black;
-                    }
-                }
-                else {
-                    *pixel_p = *pixel_p == *other_pixel_p ? white : black;
-                }
-                byte_p += stride0;
-                other_byte_p += other_stride0;
-            }
-            row_p += stride1;
-            other_row_p += other_stride1;
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+/**
+ * Gets the points argument of read_points and write_points, a buffer of
+ * x, y pairs of 32 bit integers, checking each is within the array.
+ */
+static int
+_get_array_points(PyPixelArray *array, PyObject *pointsobj, Py_buffer *view_p,
+                  Py_ssize_t *count)
+{
+    Py_ssize_t dim1 = array->shape[1] ? array->shape[1] : 1;
+    const Sint32 *points;
+    Py_ssize_t i;
+
+    if (!_get_int32_buffer(pointsobj, view_p, -1, 0, "points")) {
+        return 0;
+    }
+    if (view_p->len % 8) {
+        PyErr_SetString(PyExc_ValueError,
+                        "points must hold x, y pairs");
+        PyBuffer_Release(view_p);
+        return 0;
+    }
+    *count = view_p->len / 8;
+    points = (const Sint32 *)view_p->buf;
+    for (i = 0; i < *count; ++i, points += 2) {
+        if (points[0] < 0 || points[0] >= array->shape[0] ||
+            points[1] < 0 || points[1] >= dim1) {
+            PyErr_Format(PyExc_IndexError,
+                         "point %zd, (%d, %d), is outside the array",
+                         i, (int)points[0], (int)points[1]);
+            PyBuffer_Release(view_p);
+            return 0;
         }
     }
-        break;
+    return 1;
+}
+
+/**
+ * array.read_points(points, buffer): copies the pixels at the x, y pairs
+ * of points into a buffer of 32 bit integers.
+ */
+static PyObject *
+_read_points(PyPixelArray *array, PyObject *args, PyObject *kwds)
+{
+    PyObject *pointsobj;
+    PyObject *bufobj;
+    SDL_Surface *surf = PySurface_AsSurface(array->surface);
+    int bpp = surf->format->BytesPerPixel;
+    Py_ssize_t stride0 = array->strides[0];
+    Py_ssize_t stride1 = array->strides[1];
+    Py_buffer pointsview;
+    Py_buffer view;
+    const Sint32 *points;
+    Uint32 *out;
+    Py_ssize_t count;
+    Py_ssize_t i;
+    static char *keys[] = { "points", "buffer", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", keys,
+                                     &pointsobj, &bufobj)) {
+        return 0;
+    }
+    if (!_get_array_points(array, pointsobj, &pointsview, &count)) {
+        return 0;
+    }
+    if (!_get_int32_buffer(bufobj, &view, count, 1, "buffer")) {
+        PyBuffer_Release(&pointsview);
+        return 0;
+    }
+
+    points = (const Sint32 *)pointsview.buf;
+    out = (Uint32 *)view.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i, points += 2) {
+        out[i] = _pixel_load(array->pixels + points[0] * stride0 +
+                             points[1] * stride1, bpp);
     }
     Py_END_ALLOW_THREADS;
 
-    return (PyObject *)new_array;
+    PyBuffer_Release(&view);
+    PyBuffer_Release(&pointsview);
+    Py_RETURN_NONE;
 }
 
+/**
+ * array.write_points(points, values): sets the pixels at the x, y pairs
+ * of points to the 32 bit integers of values, or all to one color.
+ */
 static PyObject *
-_transpose(PyPixelArray *array)
+_write_points(PyPixelArray *array, PyObject *args, PyObject *kwds)
 {
+    PyObject *pointsobj;
+    PyObject *valuesobj;
     SDL_Surface *surf = PySurface_AsSurface(array->surface);
-    Py_ssize_t dim0 = array->shape[1] ? array->shape[1] : 1;
-    Py_ssize_t dim1 = array->shape[0];
-    Py_ssize_t stride0;
-    Py_ssize_t stride1 = array->strides[0];
+    int bpp = surf->format->BytesPerPixel;
+    Py_ssize_t stride0 = array->strides[0];
+    Py_ssize_t stride1 = array->strides[1];
+    Py_buffer pointsview;
+    Py_buffer view;
+    const Sint32 *points;
+    const Uint32 *in = 0;
+    Uint32 color = 0;
+    Py_ssize_t count;
+    Py_ssize_t i;
+    static char *keys[] = { "points", "values", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", keys,
+                                     &pointsobj, &valuesobj)) {
+        return 0;
+    }
+    if (!_get_array_points(array, pointsobj, &pointsview, &count)) {
+        return 0;
+    }
+    if (PyInt_Check(valuesobj) || PyLong_Check(valuesobj) ||
+        PyTuple_Check(valuesobj) ||
+        PyObject_IsInstance(valuesobj, (PyObject *)&PyColor_Type)) {
+        if (!_get_color_from_object(valuesobj, surf->format, &color)) {
+            PyBuffer_Release(&pointsview);
+            return 0;
+        }
+    }
+    else if (_get_int32_buffer(valuesobj, &view, count, 0, "values")) {
+        in = (const Uint32 *)view.buf;
+    }
+    else {
+        PyBuffer_Release(&pointsview);
+        return 0;
+    }
 
-    stride0 = array->shape[1] ?
-        array->strides[1] : array->shape[0] * surf->format->BytesPerPixel;
+    points = (const Sint32 *)pointsview.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i, points += 2) {
+        _pixel_store(array->pixels + points[0] * stride0 +
+                     points[1] * stride1, bpp, in ? in[i] : color);
+    }
+    Py_END_ALLOW_THREADS;
 
-    return (PyObject *)_pxarray_new_internal(&PyPixelArray_Type,
-                                             0, array, array->pixels,
-                                             dim0, dim1, stride0, stride1);
+    if (in) {
+        PyBuffer_Release(&view);
+    }
+    PyBuffer_Release(&pointsview);
+    Py_RETURN_NONE;
 }
@@ -25,6 +25,7 @@
 #include "pgcompat.h"
 #include "doc/pixelcopy_doc.h"
 #include <SDL_byteorder.h>
+#include <SDL_thread.h>
 
 typedef enum {
     VIEWKIND_RED,
@@ -228,6 +229,15 @@ _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
         dz_dst = -1;
     }
 #endif
+    Py_BEGIN_ALLOW_THREADS;
+    if (intsize == pixelsize && dz_dst == dz_src && dx_dst == pixelsize) {
+        /* The target rows are laid out as the surface rows */
+        for (y = 0; y < h; ++y) {
+            memcpy((char *)view_p->buf + dy_dst * y,
+                   (char *)surf->pixels + dy_src * y, w * pixelsize);
+        }
+    }
+    else {
     for (x = 0; x < w; ++x) {
         for (y = 0; y < h; ++y) {
             for (z = 0; z < pixelsize; ++z) {
@@ -240,6 +250,8 @@ _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
             }
         }
     }
+    }
+    Py_END_ALLOW_THREADS;
 
     return 0;
 }
@@ -313,6 +325,7 @@ _copy_colorplane(Py_buffer *view_p,
         dz_dst = -1;
     }
 #endif
+    Py_BEGIN_ALLOW_THREADS;
     if (view_kind == VIEWKIND_COLORKEY && flags & SDL_SRCCOLORKEY) {
         colorkey = format->colorkey;
         for (x = 0; x < w; ++x) {
@@ -354,6 +367,8 @@ _copy_colorplane(Py_buffer *view_p,
         }
     }
 
+    Py_END_ALLOW_THREADS;
+
     return 0;
 }
 
@@ -408,6 +423,29 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
         dz_dst = -1;
     }
 #endif
+    Py_BEGIN_ALLOW_THREADS;
+    if (pixelsize == 4 && intsize == 1 && !format->Rloss &&
+        !format->Gloss && !format->Bloss) {
+        /* 8 bit channels need no scaling, only a shift each */
+        int Rshift = format->Rshift;
+        int Gshift = format->Gshift;
+        int Bshift = format->Bshift;
+
+        for (y = 0; y < h; ++y) {
+            const Uint32 *row = (const Uint32 *)(src + dy_src * y);
+            char *pix = dst + dy_dst * y;
+
+            for (x = 0; x < w; ++x) {
+                Uint32 value = row[x];
+
+                pix[0] = (char)(value >> Rshift);
+                pix[dp_dst] = (char)(value >> Gshift);
+                pix[2 * dp_dst] = (char)(value >> Bshift);
+                pix += dx_dst;
+            }
+        }
+    }
+    else {
     for (x = 0; x < w; ++x) {
         for (y = 0; y < h; ++y) {
             for (z = 0; z < pixelsize; ++z) {
@@ -428,22 +466,93 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
             }
         }
     }
+    }
+    Py_END_ALLOW_THREADS;
 
     return 0;
 }
 
+/* Threaded copies. A large copy is cut into bands of rows done on the
+ * pygame worker pool, see PgPool_Run. The copies run without the GIL; the
+ * caller holds the array and the surface.
+ */
+
+#define PG_PIXELCOPY_MAX_THREADS 32
+/* Copies of fewer pixels than this stay on the calling thread */
+#define PG_PIXELCOPY_MIN_PIXELS (256 * 256)
+/* Fewest rows a thread takes at a time */
+#define PG_PIXELCOPY_MIN_BAND 16
+
+/* The most pool threads a copy uses, set by set_copy_threads */
+static int copy_threads = 0;
+
+/* Run job over all n rows of data, on the pool if the copy is big enough.
+ * Called without the GIL.
+ */
+static void
+copy_run(PgPool_Job job, void *data, int n, double pixels)
+{
+    if (copy_threads < 2 || pixels < PG_PIXELCOPY_MIN_PIXELS) {
+        job(data, 0, n);
+        return;
+    }
+    PgPool_Run(job, data, n, PG_PIXELCOPY_MIN_BAND, copy_threads);
+}
+
+/* What array_to_surface copies, for _copy_array_rows */
+typedef struct {
+    SDL_Surface *surf;
+    char *array_data;
+    int ndim;
+    int itemsize;
+    int stridex, stridey, stridez, stridez2, sizex;
+    size_t stridez_0, stridez_1, stridez_2;     /* 24 bit pixel bytes */
+    Uint32 alpha;
+} _pc_array_copy_t;
+
 /*macros used to blit arrays*/
+
+/* Items the size of the pixels that follow each other along x are
+ * copied a row at a time.
+ */
 #define COPYMACRO_2D(DST, SRC)                                            \
-    for (loopy = 0; loopy < sizey; ++loopy)                               \
+    if (sizeof (DST) == sizeof (SRC) && stridex == sizeof (SRC)) {        \
+        for (loopy = first; loopy < last; ++loopy)                        \
+            memcpy(((char*)surf->pixels)+loopy*surf->pitch,               \
+                   (char*)array_data + stridey * loopy,                   \
+                   sizex * sizeof (DST));                                 \
+    }                                                                     \
+    else {                                                                \
+    for (loopy = first; loopy < last; ++loopy)                            \
     {                                                                     \
         DST* imgrow = (DST*)(((char*)surf->pixels)+loopy*surf->pitch);    \
         Uint8* datarow = (Uint8*)array_data + stridey * loopy;            \
         for (loopx = 0; loopx < sizex; ++loopx)                           \
             *(imgrow + loopx) = (DST)*(SRC*)(datarow + stridex * loopx);  \
+    }                                                                     \
     }
 
+/* Byte RGB triplets packed along x, as from pixels3d or a (w, h, 3) view
+ * of image data with x fastest, get a loop with constant strides that the
+ * compiler can vectorize.
+ */
 #define COPYMACRO_3D(DST, SRC)                                            \
-    for (loopy = 0; loopy < sizey; ++loopy)                               \
+    if (sizeof (SRC) == 1 && stridez == 1 && stridex == 3) {              \
+    for (loopy = first; loopy < last; ++loopy)                            \
+    {                                                                     \
+        DST *pix = (DST *)(((char *)surf->pixels) + surf->pitch * loopy); \
+        const Uint8 *data = (Uint8 *)array_data + stridey * loopy;        \
+        for (loopx = 0; loopx < sizex; ++loopx) {                         \
+            pix[loopx] = (DST)((data[0] >> Rloss << Rshift) |             \
+                (data[1] >> Gloss << Gshift) |                            \
+                (data[2] >> Bloss << Bshift) |                            \
+                alpha);                                                   \
+            data += 3;                                                    \
+        }                                                                 \
+    }                                                                     \
+    }                                                                     \
+    else {                                                                \
+    for (loopy = first; loopy < last; ++loopy)                            \
     {                                                                     \
         DST *pix = (DST *)(((char *)surf->pixels) + surf->pitch * loopy); \
         char *data = array_data + stridey * loopy;                        \
@@ -454,115 +563,69 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
                 alpha);                                                   \
             data += stridex;                                              \
         }                                                                 \
+    }                                                                     \
     }
 
-static PyObject*
-array_to_surface(PyObject *self, PyObject *arg)
+/* Whether array_to_surface can copy items of itemsize in an ndim array to
+ * pixels of bpp bytes.
+ */
+static int
+_array_copy_supported(int bpp, int ndim, int itemsize)
 {
-    PyObject *surfobj, *arrayobj;
-    Pg_buffer pg_view;
-    Py_buffer *view_p = (Py_buffer *)&pg_view;
-    char *array_data;
-    SDL_Surface* surf;
-    SDL_PixelFormat* format;
-    int loopx, loopy;
-    int stridex, stridey, stridez=0, stridez2=0, sizex, sizey;
-    int Rloss, Gloss, Bloss, Rshift, Gshift, Bshift;
+    int is_int = (itemsize == 1 || itemsize == 2 ||
+                  itemsize == 4 || itemsize == 8);
 
-    if (!PyArg_ParseTuple(arg, "O!O", &PySurface_Type, &surfobj, &arrayobj)) {
-        return NULL;
-    }
-    surf = PySurface_AsSurface(surfobj);
-    format = surf->format;
-
-    if (PgObject_GetBuffer(arrayobj, &pg_view, PyBUF_RECORDS_RO)) {
-        return 0;
-    }
-
-    if (_validate_view_format(view_p->format)) {
-        return 0;
-    }
-
-    if (!(view_p->ndim == 2 || (view_p->ndim == 3 && view_p->shape[2] == 3))) {
-        return RAISE(PyExc_ValueError, "must be a valid 2d or 3d array\n");
-    }
-
-    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4)
-        return RAISE(PyExc_ValueError, "unsupport bit depth for surface");
-
-    stridex = view_p->strides[0];
-    stridey = view_p->strides[1];
-    if (view_p->ndim == 3) {
-        stridez = view_p->strides[2];
-        stridez2 = stridez*2;
-    }
-    else {
-        stridez = 1;
-        stridez2 = 2;
-    }
-    sizex = view_p->shape[0];
-    sizey = view_p->shape[1];
-    Rloss = format->Rloss; Gloss = format->Gloss; Bloss = format->Bloss;
-    Rshift = format->Rshift; Gshift = format->Gshift; Bshift = format->Bshift;
-
-    /* Do any required broadcasting. */
-    if (sizex == 1) {
-        sizex = surf->w;
-        stridex = 0;
-    }
-    if (sizey == 1) {
-        sizey = surf->h;
-        stridey = 0;
-    }
+    switch (bpp) {
 
-    if (sizex != surf->w || sizey != surf->h) {
-        PgBuffer_Release(&pg_view);
-        return RAISE(PyExc_ValueError, "array must match surface dimensions");
-    }
-    if (!PySurface_LockBy(surfobj, arrayobj)) {
-        PgBuffer_Release(&pg_view);
-        return NULL;
+    case 1:
+        return ndim == 2 && is_int;
+    case 2:
+        return is_int && (ndim == 3 || itemsize >= 2);
+    case 3:
+        return itemsize >= (ndim == 2 ? 3 : 1) && itemsize <= 9;
+    case 4:
+        return is_int && (ndim == 3 || itemsize >= 4);
     }
+    return 0;
+}
 
-    array_data = (char *)view_p->buf;
+/* Copy rows first to first + n - 1 of an array_to_surface copy */
+static int
+_copy_array_rows(void *data, int first, int n)
+{
+    _pc_array_copy_t *copy = (_pc_array_copy_t *)data;
+    SDL_Surface *surf = copy->surf;
+    SDL_PixelFormat *format = surf->format;
+    char *array_data = copy->array_data;
+    int stridex = copy->stridex, stridey = copy->stridey;
+    int stridez = copy->stridez, stridez2 = copy->stridez2;
+    int sizex = copy->sizex;
+    int Rloss = format->Rloss, Gloss = format->Gloss, Bloss = format->Bloss;
+    int Rshift = format->Rshift, Gshift = format->Gshift;
+    int Bshift = format->Bshift;
+    int last = first + n;
+    int loopx, loopy;
 
-    switch (surf->format->BytesPerPixel) {
+    switch (format->BytesPerPixel) {
     case 1:
-        if (view_p->ndim == 2) {
-            switch (view_p->itemsize) {
-            case sizeof (Uint8):
-                COPYMACRO_2D(Uint8, Uint8);
-                break;
-            case sizeof (Uint16):
-                COPYMACRO_2D(Uint8, Uint16);
-                break;
-            case sizeof (Uint32):
-                COPYMACRO_2D(Uint8, Uint32);
-                break;
-            case sizeof (Uint64):
-                COPYMACRO_2D(Uint8, Uint64);
-                break;
-            default:
-                PgBuffer_Release(&pg_view);
-                if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-                    return NULL;
-                }
-                return RAISE(PyExc_ValueError,
-                             "unsupported datatype for array\n");
-            }
-        }
-        else {
-            PgBuffer_Release(&pg_view);
-            if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-                return NULL;
-            }
-            return RAISE(PyExc_ValueError,
-                         "unsupported datatype for array\n");
+        switch (copy->itemsize) {
+        case sizeof (Uint8):
+            COPYMACRO_2D(Uint8, Uint8);
+            break;
+        case sizeof (Uint16):
+            COPYMACRO_2D(Uint8, Uint16);
+            break;
+        case sizeof (Uint32):
+            COPYMACRO_2D(Uint8, Uint32);
+            break;
+        case sizeof (Uint64):
+            COPYMACRO_2D(Uint8, Uint64);
+            break;
         }
         break;
     case 2:
-        if (view_p->ndim == 2) {
-            switch (view_p->itemsize) {
+        if (copy->ndim == 2) {
+            switch (copy->itemsize) {
             case sizeof (Uint16):
                 COPYMACRO_2D(Uint16, Uint16);
                 break;
@@ -572,21 +635,12 @@ array_to_surface(PyObject *self, PyObject *arg)
             case sizeof (Uint64):
                 COPYMACRO_2D(Uint16, Uint64);
                 break;
-            default:
-                PgBuffer_Release(&pg_view);
-                if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-                    return NULL;
-                }
-                return RAISE(PyExc_ValueError,
-                             "unsupported datatype for array\n");
             }
         }
         else {
-            Uint16 alpha = 0;
-            if (format->Amask) {
-                alpha = 255 >> format->Aloss << format->Ashift;
-            }
-            switch (view_p->itemsize) {
+            Uint16 alpha = (Uint16)copy->alpha;
+
+            switch (copy->itemsize) {
             case sizeof (Uint8):
                 COPYMACRO_3D(Uint16, Uint8);
                 break;
@@ -599,62 +653,23 @@ array_to_surface(PyObject *self, PyObject *arg)
             case sizeof (Uint64):
                 COPYMACRO_3D(Uint16, Uint64);
                 break;
-            default:
-                PgBuffer_Release(&pg_view);
-                if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-                    return NULL;
-                }
-                return RAISE(PyExc_ValueError,
-                             "unsupported datatype for array\n");
             }
         }
         break;
     case 3:
-        /* Assumption: The rgb components of a 24 bit pixel are in
-           separate bytes.
-        */
-        if (view_p->itemsize >= (view_p->ndim == 2 ? 3 : 1) &&
-            view_p->itemsize <= 9) {
-            size_t stridez_0 = 0;
-            size_t stridez_1 = 0;
-            size_t stridez_2 = 0;
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (view_p->ndim == 2) {
-                stridez_1 = 1;
-                stridez_2 = 2;
-            }
-            else {
-                size_t offset = _is_swapped(view_p) ? view_p->itemsize - 1 : 0;
-                stridez_0 = ((Rshift ==  0 ?
-                              0 : (Gshift ==  0 ? stridez : stridez2)) +
-                             offset);
-                stridez_1 = ((Rshift ==  8 ?
-                              0 : (Gshift ==  8 ? stridez : stridez2)) +
-                             offset);
-                stridez_2 = ((Rshift == 16 ?
-                              0 : (Gshift == 16 ? stridez : stridez2)) +
-                             offset);
-            }
-#else
-            if (view_p->ndim == 2) {
-                stridez_0 = view_p->itemsize - 3;
-                stridez_1 = stridez_0 + 1;
-                stridez_2 = stridez_1 + 1;
-            }
-            else {
-                size_t offset = _is_swapped(view_p) ? 0 : view_p->itemsize - 1;
-                stridez_2 = ((Rshift ==  0 ?
-                              0 : (Gshift ==  0 ? stridez : stridez2)) +
-                             offset);
-                stridez_1 = ((Rshift ==  8 ?
-                              0 : (Gshift ==  8 ? stridez : stridez2)) +
-                             offset);
-                stridez_0 = ((Rshift == 16 ?
-                              0 : (Gshift == 16 ? stridez : stridez2)) +
-                             offset);
-            }
-#endif
-            for (loopy = 0; loopy < sizey; ++loopy)
+        if (stridex == 3 && copy->stridez_0 == 0 &&
+            copy->stridez_1 == 1 && copy->stridez_2 == 2) {
+            /* the bytes of the pixels, in order */
+            for (loopy = first; loopy < last; ++loopy)
+                memcpy(((Uint8*)surf->pixels) + surf->pitch * loopy,
+                       (Uint8*)array_data + stridey * loopy, 3 * sizex);
+        }
+        else {
+            size_t stridez_0 = copy->stridez_0;
+            size_t stridez_1 = copy->stridez_1;
+            size_t stridez_2 = copy->stridez_2;
+
+            for (loopy = first; loopy < last; ++loopy)
             {
                 Uint8 *pix = ((Uint8*)surf->pixels) + surf->pitch * loopy;
                 Uint8 *data = (Uint8*)array_data + stridey * loopy;
@@ -667,39 +682,22 @@ array_to_surface(PyObject *self, PyObject *arg)
                 }
             }
         }
-        else {
-            PgBuffer_Release(&pg_view);
-            if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-                return NULL;
-            }
-            return RAISE(PyExc_ValueError,
-                         "unsupported datatype for array\n");
-        }
         break;
-    case 4:
-        if (view_p->ndim == 2) {
-            switch (view_p->itemsize) {
+    default: /* case 4: */
+        if (copy->ndim == 2) {
+            switch (copy->itemsize) {
             case sizeof (Uint32):
                 COPYMACRO_2D(Uint32, Uint32);
                 break;
             case sizeof (Uint64):
                 COPYMACRO_2D(Uint32, Uint64);
                 break;
-            default:
-                PgBuffer_Release(&pg_view);
-                if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-                    return NULL;
-                }
-                return RAISE(PyExc_ValueError,
-                            "unsupported datatype for array\n");
             }
         }
         else {
-            Uint32 alpha = 0;
-            if (format->Amask) {
-                alpha = 255 >> format->Aloss << format->Ashift;
-            }
-            switch (view_p->itemsize) {
+            Uint32 alpha = copy->alpha;
+
+            switch (copy->itemsize) {
             case sizeof (Uint8):
                 COPYMACRO_3D(Uint32, Uint8);
                 break;
@@ -712,24 +710,146 @@ array_to_surface(PyObject *self, PyObject *arg)
             case sizeof (Uint64):
                 COPYMACRO_3D(Uint32, Uint64);
                 break;
-            default:
-                PgBuffer_Release(&pg_view);
-                if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-                    return NULL;
-                }
-                return RAISE(PyExc_ValueError,
-                             "unsupported datatype for array\n");
             }
         }
         break;
-    default:
+    }
+    return 0;
+}
+
+static PyObject*
+array_to_surface(PyObject *self, PyObject *arg)
+{
+    PyObject *surfobj, *arrayobj;
+    Pg_buffer pg_view;
+    Py_buffer *view_p = (Py_buffer *)&pg_view;
+    SDL_Surface* surf;
+    SDL_PixelFormat* format;
+    _pc_array_copy_t copy;
+    int stridez, stridez2, sizex, sizey;
+    int Rshift, Gshift;
+
+    if (!PyArg_ParseTuple(arg, "O!O", &PySurface_Type, &surfobj, &arrayobj)) {
+        return NULL;
+    }
+    surf = PySurface_AsSurface(surfobj);
+    format = surf->format;
+
+    if (PgObject_GetBuffer(arrayobj, &pg_view, PyBUF_RECORDS_RO)) {
+        return 0;
+    }
+
+    if (_validate_view_format(view_p->format)) {
+        return 0;
+    }
+
+    if (!(view_p->ndim == 2 || (view_p->ndim == 3 && view_p->shape[2] == 3))) {
+        return RAISE(PyExc_ValueError, "must be a valid 2d or 3d array\n");
+    }
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4)
+        return RAISE(PyExc_ValueError, "unsupport bit depth for surface");
+
+    copy.surf = surf;
+    copy.array_data = (char *)view_p->buf;
+    copy.ndim = view_p->ndim;
+    copy.itemsize = view_p->itemsize;
+    copy.stridex = view_p->strides[0];
+    copy.stridey = view_p->strides[1];
+    if (view_p->ndim == 3) {
+        stridez = view_p->strides[2];
+        stridez2 = stridez*2;
+    }
+    else {
+        stridez = 1;
+        stridez2 = 2;
+    }
+    copy.stridez = stridez;
+    copy.stridez2 = stridez2;
+    sizex = view_p->shape[0];
+    sizey = view_p->shape[1];
+    Rshift = format->Rshift; Gshift = format->Gshift;
+
+    /* Do any required broadcasting. */
+    if (sizex == 1) {
+        sizex = surf->w;
+        copy.stridex = 0;
+    }
+    if (sizey == 1) {
+        sizey = surf->h;
+        copy.stridey = 0;
+    }
+    copy.sizex = sizex;
+
+    if (sizex != surf->w || sizey != surf->h) {
         PgBuffer_Release(&pg_view);
-        if (!PySurface_UnlockBy(surfobj, arrayobj)) {
-            return NULL;
+        return RAISE(PyExc_ValueError, "array must match surface dimensions");
+    }
+    if (!_array_copy_supported(format->BytesPerPixel,
+                               view_p->ndim, view_p->itemsize)) {
+        PgBuffer_Release(&pg_view);
+        return RAISE(PyExc_ValueError, "unsupported datatype for array\n");
+    }
+
+    copy.alpha = 0;
+    if (format->Amask) {
+        copy.alpha = 255 >> format->Aloss << format->Ashift;
+    }
+
+    /* Assumption: The rgb components of a 24 bit pixel are in
+       separate bytes.
+    */
+    copy.stridez_0 = 0;
+    copy.stridez_1 = 0;
+    copy.stridez_2 = 0;
+    if (format->BytesPerPixel == 3) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        if (view_p->ndim == 2) {
+            copy.stridez_1 = 1;
+            copy.stridez_2 = 2;
+        }
+        else {
+            size_t offset = _is_swapped(view_p) ? view_p->itemsize - 1 : 0;
+            copy.stridez_0 = ((Rshift ==  0 ?
+                               0 : (Gshift ==  0 ? stridez : stridez2)) +
+                              offset);
+            copy.stridez_1 = ((Rshift ==  8 ?
+                               0 : (Gshift ==  8 ? stridez : stridez2)) +
+                              offset);
+            copy.stridez_2 = ((Rshift == 16 ?
+                               0 : (Gshift == 16 ? stridez : stridez2)) +
+                              offset);
+        }
+#else
+        if (view_p->ndim == 2) {
+            copy.stridez_0 = view_p->itemsize - 3;
+            copy.stridez_1 = copy.stridez_0 + 1;
+            copy.stridez_2 = copy.stridez_1 + 1;
+        }
+        else {
+            size_t offset = _is_swapped(view_p) ? 0 : view_p->itemsize - 1;
+            copy.stridez_2 = ((Rshift ==  0 ?
+                               0 : (Gshift ==  0 ? stridez : stridez2)) +
+                              offset);
+            copy.stridez_1 = ((Rshift ==  8 ?
+                               0 : (Gshift ==  8 ? stridez : stridez2)) +
+                              offset);
+            copy.stridez_0 = ((Rshift == 16 ?
+                               0 : (Gshift == 16 ? stridez : stridez2)) +
+                              offset);
         }
-        return RAISE(PyExc_RuntimeError, "unsupported bit depth for image");
+#endif
+    }
+
+    if (!PySurface_LockBy(surfobj, arrayobj)) {
+        PgBuffer_Release(&pg_view);
+        return NULL;
     }
 
+    Py_BEGIN_ALLOW_THREADS;
+    copy_run(_copy_array_rows, &copy, sizey, (double)sizex * sizey);
+    Py_END_ALLOW_THREADS;
+
     PgBuffer_Release(&pg_view);
     if (!PySurface_UnlockBy(surfobj, arrayobj)) {
         return NULL;
@@ -817,10 +937,167 @@ surface_to_array(PyObject *self, PyObject *args, PyObject *kwds)
     Py_RETURN_NONE;
 }
 
+#define PIXELCOPY_MAX_DIM 10
+
+/* What map_array maps, for _map_array_rows */
+typedef struct {
+    SDL_PixelFormat *format;
+    Uint8 *src;
+    Uint8 *tar;
+    int ndim;
+    Py_intptr_t *shape;
+    Py_intptr_t *src_strides;
+    Py_intptr_t *tar_strides;
+    int *src_advances;
+    int *tar_advances;
+    int src_green;
+    int src_blue;
+    int tar_itemsize;
+    int tar_native;     /* whether the target items are native integers */
+    int tar_byte0, tar_byte1, tar_byte2, tar_byte3;
+    int tar_padding_start;
+    int tar_padding_end;
+} _pc_map_array_t;
+
+/* Map the RGB of src, as SDL_MapRGB does for formats without a palette */
+#define MAPMACRO_RGB(src)                                                 \
+    ((Uint32)(src)[0] >> Rloss << Rshift |                                \
+     (Uint32)(src)[src_green] >> Gloss << Gshift |                        \
+     (Uint32)(src)[src_blue] >> Bloss << Bshift |                         \
+     Amask)
+
+#define MAPMACRO_ROW(TYPE)                                                \
+    for (i = 0; i < count; ++i) {                                         \
+        TYPE value = (TYPE)MAPMACRO_RGB(src);                             \
+        memcpy(tar, &value, sizeof (TYPE));                               \
+        tar += tar_stride;                                                \
+        src += src_stride;                                                \
+    }
+
+/* Map count pixels of a row, tar_stride and src_stride bytes apart */
+static void
+_map_row(_pc_map_array_t *map, Uint8 *tar, Uint8 *src, Py_intptr_t count,
+         Py_intptr_t tar_stride, Py_intptr_t src_stride)
+{
+    SDL_PixelFormat *format = map->format;
+    Uint32 Rloss = format->Rloss, Gloss = format->Gloss;
+    Uint32 Bloss = format->Bloss;
+    Uint32 Rshift = format->Rshift, Gshift = format->Gshift;
+    Uint32 Bshift = format->Bshift;
+    Uint32 Amask = format->Amask;
+    int src_green = map->src_green;
+    int src_blue = map->src_blue;
+    _pc_pixel_t pixel;
+    Py_intptr_t i;
+    int j;
+
+    if (map->tar_native && !format->palette) {
+        switch (map->tar_itemsize) {
+
+        case sizeof (Uint8):
+            MAPMACRO_ROW(Uint8);
+            return;
+        case sizeof (Uint16):
+            MAPMACRO_ROW(Uint16);
+            return;
+        case sizeof (Uint32):
+            MAPMACRO_ROW(Uint32);
+            return;
+        case sizeof (Uint64):
+            MAPMACRO_ROW(Uint64);
+            return;
+        }
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (format->palette) {
+            pixel.value = SDL_MapRGB(format, src[0], src[src_green],
+                                     src[src_blue]);
+        }
+        else {
+            pixel.value = MAPMACRO_RGB(src);
+        }
+        /* Bytes are copied from the pixel in most to least significant
+         * byte order. If destination bytes get overwritten, when the
+         * destination size is less than 4 bytes, only zero pad bytes
+         * of a pixel get clobbered in the destination write.
+         */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        tar[map->tar_byte3] = pixel.bytes[3];
+        tar[map->tar_byte2] = pixel.bytes[2];
+        tar[map->tar_byte1] = pixel.bytes[1];
+        tar[map->tar_byte0] = pixel.bytes[0];
+#else
+        tar[map->tar_byte0] = pixel.bytes[0];
+        tar[map->tar_byte1] = pixel.bytes[1];
+        tar[map->tar_byte2] = pixel.bytes[2];
+        tar[map->tar_byte3] = pixel.bytes[3];
+#endif
+        for (j = map->tar_padding_start; j < map->tar_padding_end; ++j) {
+            tar[j] = 0;
+        }
+        tar += tar_stride;
+        src += src_stride;
+    }
+}
+
+/* Map indices first to first + n - 1 of the first dimension of a
+ * map_array target.
+ */
+static int
+_map_array_rows(void *data, int first, int n)
+{
+    _pc_map_array_t *map = (_pc_map_array_t *)data;
+    Py_intptr_t *shape = map->shape;
+    Py_intptr_t *tar_strides = map->tar_strides;
+    Py_intptr_t *src_strides = map->src_strides;
+    Py_intptr_t counters[PIXELCOPY_MAX_DIM];
+    Uint8 *tar = map->tar + tar_strides[0] * first;
+    Uint8 *src = map->src + src_strides[0] * first;
+    int topdim = map->ndim - 1;
+    int dim;
+
+    if (!topdim) {
+        _map_row(map, tar, src, n, tar_strides[0], src_strides[0]);
+        return 0;
+    }
+
+    /* Iterate over arrays, left index varying slowest, mapping a row of
+     * the right index at a time
+     */
+    dim = 0;
+    counters[0] = n;
+    while (counters[0]) {
+        if (!counters[dim]) {
+            /* Leave loop, moving left one index
+             */
+            --dim;
+            tar += map->tar_advances[dim];
+            src += map->src_advances[dim];
+            --counters[dim];
+        }
+        else if (dim == topdim) {
+            /* The inner most loop: map a row
+             */
+            _map_row(map, tar, src, shape[dim],
+                     tar_strides[dim], src_strides[dim]);
+            tar += shape[dim] * tar_strides[dim];
+            src += shape[dim] * src_strides[dim];
+            counters[dim] = 0;
+        }
+        else {
+            /* Enter loop for next index to the right
+             */
+            dim += 1;
+            counters[dim] = shape[dim];
+        }
+    }
+    return 0;
+}
+
 static PyObject *
 map_array(PyObject *self, PyObject *args)
 {
-#   define PIXELCOPY_MAX_DIM 10
     PyObject *src_array;
     PyObject *tar_array;
     PyObject *format_surf;
@@ -830,7 +1107,6 @@ map_array(PyObject *self, PyObject *args)
     Uint8 *src;
     int src_ndim;
     Py_intptr_t src_strides[PIXELCOPY_MAX_DIM];
-    const int src_red = 0;
     int src_green;
     int src_blue;
     Pg_buffer tar_pg_view;
@@ -846,15 +1122,13 @@ map_array(PyObject *self, PyObject *args)
     int tar_byte3 = 0;
     int tar_padding_start;
     int tar_padding_end;
-    Py_intptr_t counters[PIXELCOPY_MAX_DIM];
     int src_advances[PIXELCOPY_MAX_DIM];
     int tar_advances[PIXELCOPY_MAX_DIM];
     int dim_diff;
     int dim;
-    int topdim;
-    _pc_pixel_t pixel = { 0 };
+    _pc_map_array_t map;
+    double pixels;
     int pix_bytesize;
-    int i;
 
     if (!PyArg_ParseTuple(args, "OOO!",
                           &tar_array, &src_array,
@@ -1038,56 +1312,36 @@ map_array(PyObject *self, PyObject *args)
     }
 #endif
 
-    /* Iterate over arrays, left index varying slowest, copying pixels
-     */
-    dim = 0;
-    topdim = ndim - 1;
-    counters[0] = shape[0];
-    while (counters[0]) {
-        if (!counters[dim]) {
-            /* Leave loop, moving left one index
-             */
-            --dim;
-            tar += tar_advances[dim];
-            src += src_advances[dim];
-            --counters[dim];
-        }
-        else if (dim == topdim) {
-            /* Next iteration of inner most loop: copy pixel
-             */
-            pixel.value =
-                SDL_MapRGB(format, src[src_red], src[src_green], src[src_blue]);
-            /* Bytes are copied from the pixel in most to least significant
-             * byte order. If destination bytes get overwritten, when the
-             * destination size is less than 4 bytes, only zero pad bytes
-             * of a pixel get clobbered in the destination write.
-             */
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            tar[tar_byte3] = pixel.bytes[3];
-            tar[tar_byte2] = pixel.bytes[2];
-            tar[tar_byte1] = pixel.bytes[1];
-            tar[tar_byte0] = pixel.bytes[0];
-#else
-            tar[tar_byte0] = pixel.bytes[0];
-            tar[tar_byte1] = pixel.bytes[1];
-            tar[tar_byte2] = pixel.bytes[2];
-            tar[tar_byte3] = pixel.bytes[3];
-#endif
-            for (i = tar_padding_start; i < tar_padding_end; ++i) {
-                tar[i] = 0;
-            }
-            tar += tar_strides[dim];
-            src += src_strides[dim];
-            --counters[dim];
-        }
-        else {
-            /* Enter loop for next index to the right
-             */
-            dim += 1;
-            counters[dim] = shape[dim];
-        }
+    map.format = format;
+    map.src = src;
+    map.tar = tar;
+    map.ndim = ndim;
+    map.shape = shape;
+    map.src_strides = src_strides;
+    map.tar_strides = tar_strides;
+    map.src_advances = src_advances;
+    map.tar_advances = tar_advances;
+    map.src_green = src_green;
+    map.src_blue = src_blue;
+    map.tar_itemsize = tar_itemsize;
+    map.tar_native = (!_is_swapped(tar_view_p) &&
+                      (tar_itemsize == 1 || tar_itemsize == 2 ||
+                       tar_itemsize == 4 || tar_itemsize == 8));
+    map.tar_byte0 = tar_byte0;
+    map.tar_byte1 = tar_byte1;
+    map.tar_byte2 = tar_byte2;
+    map.tar_byte3 = tar_byte3;
+    map.tar_padding_start = tar_padding_start;
+    map.tar_padding_end = tar_padding_end;
+    pixels = 1.0;
+    for (dim = 0; dim != ndim; ++dim) {
+        pixels *= shape[dim];
     }
 
+    Py_BEGIN_ALLOW_THREADS;
+    copy_run(_map_array_rows, &map, (int)shape[0], pixels);
+    Py_END_ALLOW_THREADS;
+
     /* Cleanup
      */
     PgBuffer_Release(&src_pg_view);
@@ -1181,6 +1435,45 @@ make_surface (PyObject* self, PyObject* arg)
     return surfobj;
 }
 
+static PyObject *
+get_copy_threads(PyObject *self)
+{
+    return PyInt_FromLong(copy_threads);
+}
+
+static PyObject *
+set_copy_threads(PyObject *self, PyObject *args)
+{
+    int threads;
+    PyObject *base, *result;
+
+    if (!PyArg_ParseTuple(args, "i:set_copy_threads", &threads)) {
+        return NULL;
+    }
+    if (threads < 0) {
+        return RAISE(PyExc_ValueError, "thread count must not be negative");
+    }
+    if (threads > PG_PIXELCOPY_MAX_THREADS) {
+        threads = PG_PIXELCOPY_MAX_THREADS;
+    }
+
+    /* Grow the pool to the threads asked for */
+    if (threads > 1 && threads > PgPool_GetThreads()) {
+        base = PyImport_ImportModule("pygame.base");
+        if (!base) {
+            return NULL;
+        }
+        result = PyObject_CallMethod(base, "set_pool_threads", "i", threads);
+        Py_DECREF(base);
+        if (!result) {
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+    copy_threads = threads;
+    Py_RETURN_NONE;
+}
+
 static PyMethodDef _pixelcopy_methods[] =
 {
     { "array_to_surface", array_to_surface,
@@ -1190,6 +1483,10 @@ static PyMethodDef _pixelcopy_methods[] =
     { "map_array", map_array,
       METH_VARARGS, DOC_PYGAMEPIXELCOPYMAPARRAY },
     { "make_surface", make_surface, METH_O, DOC_PYGAMEPIXELCOPYMAKESURFACE },
+    { "get_copy_threads", (PyCFunction)get_copy_threads,
+      METH_NOARGS, DOC_PYGAMEPIXELCOPYGETCOPYTHREADS },
+    { "set_copy_threads", set_copy_threads,
+      METH_VARARGS, DOC_PYGAMEPIXELCOPYSETCOPYTHREADS },
     { 0, 0, 0, 0}
 };
 
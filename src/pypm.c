@@ -134,6 +134,12 @@
 #define __PYX_HAVE_API__pypm
 #include "portmidi.h"
 #include "porttime.h"
+#include "Python.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
+#ifndef __PYX_FORCE_INIT_THREADS
+#define __PYX_FORCE_INIT_THREADS 1
+#endif
 #define __PYX_USE_C99_COMPLEX defined(_Complex_I)
 
 
@@ -413,11 +419,26 @@ static INLINE signed PY_LONG_LONG __Pyx_PyInt_AsSignedLongLong(PyObject *);
 
 static void __Pyx_AddTraceback(const char *funcname); /*proto*/
 
+static void __Pyx_WriteUnraisable(const char *name); /*proto*/
+
 static int __Pyx_InitStrings(__Pyx_StringTabEntry *t); /*proto*/
 
 /* Type declarations */
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":248
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":173
+ * # An event of ReadInto and WriteBuffer: the message bytes, status first from
+ * # the low byte, then the timestamp, as "=Ii" in struct notation.
+ * cdef struct MidiRecord:             # <<<<<<<<<<<<<<
+ *     unsigned int message
+ *     int timestamp
+ */
+
+struct __pyx_t_4pypm_MidiRecord {
+  unsigned int message;
+  int timestamp;
+};
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":411
  *
  *
  * cdef class Output:             # <<<<<<<<<<<<<<
@@ -433,7 +454,7 @@ struct __pyx_obj_4pypm_Output {
   int _aborted;
 };
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":509
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":717
  *
  *
  * cdef class Input:             # <<<<<<<<<<<<<<
@@ -451,11 +472,23 @@ struct __pyx_obj_4pypm_Input {
 
 static PyTypeObject *__pyx_ptype_4pypm_Output = 0;
 static PyTypeObject *__pyx_ptype_4pypm_Input = 0;
+static PmStream *__pyx_v_4pypm__poll_streams[32];
+static int __pyx_v_4pypm__poll_devices[32];
+static int __pyx_v_4pypm__poll_count;
+static int __pyx_v_4pypm__poll_running;
+static int __pyx_v_4pypm__poll_interval;
+static SDL_mutex *__pyx_v_4pypm__poll_lock;
+static SDL_Thread *__pyx_v_4pypm__poll_thread;
+static void __pyx_f_4pypm__poll_read(int); /*proto*/
+static int __pyx_f_4pypm__poll_run(void *); /*proto*/
+static PyObject *__pyx_f_4pypm__poll_stop(void); /*proto*/
+static PyObject *__pyx_f_4pypm__poll_add(PmStream *, int); /*proto*/
+static PyObject *__pyx_f_4pypm__poll_remove(PmStream *); /*proto*/
 #define __Pyx_MODULE_NAME "pypm"
 int __pyx_module_is_main_pypm = 0;
 
 /* Implementation of pypm */
-static char __pyx_k_3[] = "0.0.6";
+static char __pyx_k_3[] = "0.0.7";
 static PyObject *__pyx_int_0x1;
 static PyObject *__pyx_int_0x2;
 static PyObject *__pyx_int_0x4;
@@ -485,6 +518,7 @@ static PyObject *__pyx_int_0xFF0000;
 static PyObject *__pyx_int_8;
 static PyObject *__pyx_int_0xFF00;
 static PyObject *__pyx_int_1024;
+static PyObject *__pyx_int_32;
 static char __pyx_k___main__[] = "__main__";
 static PyObject *__pyx_kp___main__;
 static char __pyx_k___init__[] = "__init__";
@@ -609,12 +643,31 @@ static char __pyx_k_tostring[] = "tostring";
 static PyObject *__pyx_kp_tostring;
 static char __pyx_k_append[] = "append";
 static PyObject *__pyx_kp_append;
+static char __pyx_k__poll_callback[] = "_poll_callback";
+static PyObject *__pyx_kp__poll_callback;
+static char __pyx_k_RECORD_FORMAT[] = "RECORD_FORMAT";
+static PyObject *__pyx_kp_RECORD_FORMAT;
+static char __pyx_k_MemoryError[] = "MemoryError";
+static PyObject *__pyx_kp_MemoryError;
+static char __pyx_k_callback[] = "callback";
+static PyObject *__pyx_kp_callback;
+static char __pyx_k_interval[] = "interval";
+static PyObject *__pyx_kp_interval;
+static char __pyx_k_WriteBuffer[] = "WriteBuffer";
+static PyObject *__pyx_kp_WriteBuffer;
+static char __pyx_k_ReadInto[] = "ReadInto";
+static PyObject *__pyx_kp_ReadInto;
+static char __pyx_k_StartPolling[] = "StartPolling";
+static PyObject *__pyx_kp_StartPolling;
+static char __pyx_k_StopPolling[] = "StopPolling";
+static PyObject *__pyx_kp_StopPolling;
 static PyObject *__pyx_kp_3;
 static PyObject *__pyx_builtin_Exception;
 static PyObject *__pyx_builtin_IndexError;
 static PyObject *__pyx_builtin_enumerate;
 static PyObject *__pyx_builtin_ValueError;
 static PyObject *__pyx_builtin_range;
+static PyObject *__pyx_builtin_MemoryError;
 static PyObject *__pyx_kp_7;
 static PyObject *__pyx_kp_8;
 static char __pyx_k_7[] = "Opening Midi Output";
@@ -647,8 +700,920 @@ static PyObject *__pyx_kp_22;
 static PyObject *__pyx_kp_23;
 static char __pyx_k_22[] = "Maximum buffer length is 1024.";
 static char __pyx_k_23[] = "Minimum buffer length is 1.";
+static PyObject *__pyx_kp_24;
+static char __pyx_k_24[] = "=Ii";
+static PyObject *__pyx_kp_25;
+static PyObject *__pyx_kp_26;
+static char __pyx_k_25[] = "Maximum number of polled inputs is %i.";
+static char __pyx_k_26[] = "Could not start the MIDI poll thread.";
+static PyObject *__pyx_kp_27;
+static char __pyx_k_27[] = "Minimum poll interval is 1 ms.";
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":202
+ * _poll_callback = None
+ *
+ * cdef void _poll_read(int index) with gil:             # <<<<<<<<<<<<<<
+ *     cdef PmEvent buffer[1024]
+ *     cdef int num_events
+ */
+
+static void __pyx_f_4pypm__poll_read(int __pyx_v_index) {
+  PmEvent __pyx_v_buffer[1024];
+  int __pyx_v_num_events;
+  int __pyx_v_ev_no;
+  PyObject *__pyx_v_events;
+  int __pyx_t_1;
+  PyObject *__pyx_t_2 = NULL;
+  int __pyx_t_3;
+  int __pyx_t_4;
+  int __pyx_t_5;
+  int __pyx_t_6;
+  PyObject *__pyx_t_7 = NULL;
+  PyObject *__pyx_t_8 = NULL;
+  PyObject *__pyx_t_9 = NULL;
+  PyObject *__pyx_t_10 = NULL;
+  #ifdef WITH_THREAD
+  PyGILState_STATE _save = PyGILState_Ensure();
+  #endif
+  __Pyx_SetupRefcountContext("_poll_read");
+  __pyx_v_events = Py_None; __Pyx_INCREF(Py_None);
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":207
+   *     cdef int ev_no
+   *
+   *     num_events = Pm_Read(_poll_streams[index], buffer, 1024)             # <<<<<<<<<<<<<<
+   *     if num_events <= 0 or _poll_callback is None:
+   *         return
+   */
+  __pyx_v_num_events = Pm_Read((__pyx_v_4pypm__poll_streams[__pyx_v_index]), __pyx_v_buffer, 1024);
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":208
+   *
+   *     num_events = Pm_Read(_poll_streams[index], buffer, 1024)
+   *     if num_events <= 0 or _poll_callback is None:             # <<<<<<<<<<<<<<
+   *         return
+   *     events = []
+   */
+  __pyx_t_1 = (__pyx_v_num_events <= 0);
+  if (!__pyx_t_1) {
+    __pyx_t_2 = __Pyx_GetName(__pyx_m, __pyx_kp__poll_callback); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 208; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_2);
+    __pyx_t_3 = (__pyx_t_2 == Py_None);
+    __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+    __pyx_t_4 = __pyx_t_3;
+  } else {
+    __pyx_t_4 = __pyx_t_1;
+  }
+  if (__pyx_t_4) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":209
+     *     num_events = Pm_Read(_poll_streams[index], buffer, 1024)
+     *     if num_events <= 0 or _poll_callback is None:
+     *         return             # <<<<<<<<<<<<<<
+     *     events = []
+     *     for ev_no in range(num_events):
+     */
+    goto __pyx_L0;
+    goto __pyx_L3;
+  }
+  __pyx_L3:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":210
+   *     if num_events <= 0 or _poll_callback is None:
+   *         return
+   *     events = []             # <<<<<<<<<<<<<<
+   *     for ev_no in range(num_events):
+   *         events.append([[buffer[ev_no].message & 0xFF,
+   */
+  __pyx_t_2 = PyList_New(0); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 210; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(((PyObject *)__pyx_t_2));
+  __Pyx_DECREF(__pyx_v_events);
+  __pyx_v_events = ((PyObject *)__pyx_t_2);
+  __pyx_t_2 = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":211
+   *         return
+   *     events = []
+   *     for ev_no in range(num_events):             # <<<<<<<<<<<<<<
+   *         events.append([[buffer[ev_no].message & 0xFF,
+   *                         (buffer[ev_no].message >> 8) & 0xFF,
+   */
+  __pyx_t_5 = __pyx_v_num_events;
+  for (__pyx_t_6 = 0; __pyx_t_6 < __pyx_t_5; __pyx_t_6+=1) {
+    __pyx_v_ev_no = __pyx_t_6;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":212
+     *     events = []
+     *     for ev_no in range(num_events):
+     *         events.append([[buffer[ev_no].message & 0xFF,             # <<<<<<<<<<<<<<
+     *                         (buffer[ev_no].message >> 8) & 0xFF,
+     *                         (buffer[ev_no].message >> 16) & 0xFF,
+     */
+    __pyx_t_2 = PyInt_FromLong(((__pyx_v_buffer[__pyx_v_ev_no]).message & 0xFF)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 212; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_2);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":213
+     *     for ev_no in range(num_events):
+     *         events.append([[buffer[ev_no].message & 0xFF,
+     *                         (buffer[ev_no].message >> 8) & 0xFF,             # <<<<<<<<<<<<<<
+     *                         (buffer[ev_no].message >> 16) & 0xFF,
+     *                         (buffer[ev_no].message >> 24) & 0xFF],
+     */
+    __pyx_t_7 = PyInt_FromLong((((__pyx_v_buffer[__pyx_v_ev_no]).message >> 8) & 0xFF)); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 213; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_7);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":214
+     *         events.append([[buffer[ev_no].message & 0xFF,
+     *                         (buffer[ev_no].message >> 8) & 0xFF,
+     *                         (buffer[ev_no].message >> 16) & 0xFF,             # <<<<<<<<<<<<<<
+     *                         (buffer[ev_no].message >> 24) & 0xFF],
+     *                        buffer[ev_no].timestamp])
+     */
+    __pyx_t_8 = PyInt_FromLong((((__pyx_v_buffer[__pyx_v_ev_no]).message >> 16) & 0xFF)); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 214; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_8);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":215
+     *                         (buffer[ev_no].message >> 8) & 0xFF,
+     *                         (buffer[ev_no].message >> 16) & 0xFF,
+     *                         (buffer[ev_no].message >> 24) & 0xFF],             # <<<<<<<<<<<<<<
+     *                        buffer[ev_no].timestamp])
+     *     _poll_callback(_poll_devices[index], events)
+     */
+    __pyx_t_9 = PyInt_FromLong((((__pyx_v_buffer[__pyx_v_ev_no]).message >> 24) & 0xFF)); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 215; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_9);
+    __pyx_t_10 = PyList_New(4); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 212; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(((PyObject *)__pyx_t_10));
+    PyList_SET_ITEM(__pyx_t_10, 0, __pyx_t_2);
+    __Pyx_GIVEREF(__pyx_t_2);
+    PyList_SET_ITEM(__pyx_t_10, 1, __pyx_t_7);
+    __Pyx_GIVEREF(__pyx_t_7);
+    PyList_SET_ITEM(__pyx_t_10, 2, __pyx_t_8);
+    __Pyx_GIVEREF(__pyx_t_8);
+    PyList_SET_ITEM(__pyx_t_10, 3, __pyx_t_9);
+    __Pyx_GIVEREF(__pyx_t_9);
+    __pyx_t_2 = 0;
+    __pyx_t_7 = 0;
+    __pyx_t_8 = 0;
+    __pyx_t_9 = 0;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":216
+     *                         (buffer[ev_no].message >> 16) & 0xFF,
+     *                         (buffer[ev_no].message >> 24) & 0xFF],
+     *                        buffer[ev_no].timestamp])             # <<<<<<<<<<<<<<
+     *     _poll_callback(_poll_devices[index], events)
+     *
+     */
+    __pyx_t_9 = PyInt_FromLong((__pyx_v_buffer[__pyx_v_ev_no]).timestamp); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 216; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_9);
+    __pyx_t_8 = PyList_New(2); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 212; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(((PyObject *)__pyx_t_8));
+    PyList_SET_ITEM(__pyx_t_8, 0, ((PyObject *)__pyx_t_10));
+    __Pyx_GIVEREF(((PyObject *)__pyx_t_10));
+    PyList_SET_ITEM(__pyx_t_8, 1, __pyx_t_9);
+    __Pyx_GIVEREF(__pyx_t_9);
+    __pyx_t_10 = 0;
+    __pyx_t_9 = 0;
+    __pyx_t_9 = __Pyx_PyObject_Append(__pyx_v_events, ((PyObject *)__pyx_t_8)); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 212; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_9);
+    __Pyx_DECREF(((PyObject *)__pyx_t_8)); __pyx_t_8 = 0;
+    __Pyx_DECREF(__pyx_t_9); __pyx_t_9 = 0;
+  }
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":217
+   *                         (buffer[ev_no].message >> 24) & 0xFF],
+   *                        buffer[ev_no].timestamp])
+   *     _poll_callback(_poll_devices[index], events)             # <<<<<<<<<<<<<<
+   *
+   * cdef int _poll_run(void *data) nogil:
+   */
+  __pyx_t_9 = __Pyx_GetName(__pyx_m, __pyx_kp__poll_callback); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 217; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_9);
+  __pyx_t_8 = PyInt_FromLong((__pyx_v_4pypm__poll_devices[__pyx_v_index])); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 217; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_8);
+  __pyx_t_10 = PyTuple_New(2); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 217; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(((PyObject *)__pyx_t_10));
+  PyTuple_SET_ITEM(__pyx_t_10, 0, __pyx_t_8);
+  __Pyx_GIVEREF(__pyx_t_8);
+  __Pyx_INCREF(__pyx_v_events);
+  PyTuple_SET_ITEM(__pyx_t_10, 1, __pyx_v_events);
+  __Pyx_GIVEREF(__pyx_v_events);
+  __pyx_t_8 = 0;
+  __pyx_t_8 = PyObject_Call(__pyx_t_9, ((PyObject *)__pyx_t_10), NULL); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 217; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_8);
+  __Pyx_DECREF(__pyx_t_9); __pyx_t_9 = 0;
+  __Pyx_DECREF(((PyObject *)__pyx_t_10)); __pyx_t_10 = 0;
+  __Pyx_DECREF(__pyx_t_8); __pyx_t_8 = 0;
+
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_2);
+  __Pyx_XDECREF(__pyx_t_7);
+  __Pyx_XDECREF(__pyx_t_8);
+  __Pyx_XDECREF(__pyx_t_9);
+  __Pyx_XDECREF(__pyx_t_10);
+  __Pyx_WriteUnraisable("pypm._poll_read");
+  __pyx_L0:;
+  __Pyx_DECREF(__pyx_v_events);
+  __Pyx_FinishRefcountContext();
+  #ifdef WITH_THREAD
+  PyGILState_Release(_save);
+  #endif
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":219
+ *     _poll_callback(_poll_devices[index], events)
+ *
+ * cdef int _poll_run(void *data) nogil:             # <<<<<<<<<<<<<<
+ *     global _poll_running
+ *     cdef int i
+ */
+
+static int __pyx_f_4pypm__poll_run(void *__pyx_v_data) {
+  int __pyx_v_i;
+  int __pyx_r;
+  int __pyx_t_1;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":223
+   *     cdef int i
+   *
+   *     while _poll_running:             # <<<<<<<<<<<<<<
+   *         SDL_mutexP(_poll_lock)
+   *         # the callback may stop the polling of an Input, so the count is
+   */
+  while (1) {
+    if (!__pyx_v_4pypm__poll_running) break;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":224
+     *
+     *     while _poll_running:
+     *         SDL_mutexP(_poll_lock)             # <<<<<<<<<<<<<<
+     *         # the callback may stop the polling of an Input, so the count is
+     *         # read again each time
+     */
+    SDL_mutexP(__pyx_v_4pypm__poll_lock);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":227
+     *         # the callback may stop the polling of an Input, so the count is
+     *         # read again each time
+     *         i = 0             # <<<<<<<<<<<<<<
+     *         while i < _poll_count:
+     *             if Pm_Poll(_poll_streams[i]) > 0:
+     */
+    __pyx_v_i = 0;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":228
+     *         # read again each time
+     *         i = 0
+     *         while i < _poll_count:             # <<<<<<<<<<<<<<
+     *             if Pm_Poll(_poll_streams[i]) > 0:
+     *                 _poll_read(i)
+     */
+    while (1) {
+      __pyx_t_1 = (__pyx_v_i < __pyx_v_4pypm__poll_count);
+      if (!__pyx_t_1) break;
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":229
+       *         i = 0
+       *         while i < _poll_count:
+       *             if Pm_Poll(_poll_streams[i]) > 0:             # <<<<<<<<<<<<<<
+       *                 _poll_read(i)
+       *             i = i + 1
+       */
+      __pyx_t_1 = (Pm_Poll((__pyx_v_4pypm__poll_streams[__pyx_v_i])) > 0);
+      if (__pyx_t_1) {
+
+        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":230
+         *         while i < _poll_count:
+         *             if Pm_Poll(_poll_streams[i]) > 0:
+         *                 _poll_read(i)             # <<<<<<<<<<<<<<
+         *             i = i + 1
+         *         # the thread ends with the last Input; _poll_add starts another
+         */
+        __pyx_f_4pypm__poll_read(__pyx_v_i);
+        goto __pyx_L7;
+      }
+      __pyx_L7:;
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":231
+       *             if Pm_Poll(_poll_streams[i]) > 0:
+       *                 _poll_read(i)
+       *             i = i + 1             # <<<<<<<<<<<<<<
+       *         # the thread ends with the last Input; _poll_add starts another
+       *         if _poll_count == 0:
+       */
+      __pyx_v_i = (__pyx_v_i + 1);
+    }
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":233
+     *             i = i + 1
+     *         # the thread ends with the last Input; _poll_add starts another
+     *         if _poll_count == 0:             # <<<<<<<<<<<<<<
+     *             _poll_running = 0
+     *         SDL_mutexV(_poll_lock)
+     */
+    __pyx_t_1 = (__pyx_v_4pypm__poll_count == 0);
+    if (__pyx_t_1) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":234
+       *         # the thread ends with the last Input; _poll_add starts another
+       *         if _poll_count == 0:
+       *             _poll_running = 0             # <<<<<<<<<<<<<<
+       *         SDL_mutexV(_poll_lock)
+       *         if _poll_running:
+       */
+      __pyx_v_4pypm__poll_running = 0;
+      goto __pyx_L8;
+    }
+    __pyx_L8:;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":235
+     *         if _poll_count == 0:
+     *             _poll_running = 0
+     *         SDL_mutexV(_poll_lock)             # <<<<<<<<<<<<<<
+     *         if _poll_running:
+     *             SDL_Delay(_poll_interval)
+     */
+    SDL_mutexV(__pyx_v_4pypm__poll_lock);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":236
+     *             _poll_running = 0
+     *         SDL_mutexV(_poll_lock)
+     *         if _poll_running:             # <<<<<<<<<<<<<<
+     *             SDL_Delay(_poll_interval)
+     *     return 0
+     */
+    if (__pyx_v_4pypm__poll_running) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":237
+       *         SDL_mutexV(_poll_lock)
+       *         if _poll_running:
+       *             SDL_Delay(_poll_interval)             # <<<<<<<<<<<<<<
+       *     return 0
+       *
+       */
+      SDL_Delay(__pyx_v_4pypm__poll_interval);
+      goto __pyx_L9;
+    }
+    __pyx_L9:;
+  }
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":238
+   *         if _poll_running:
+   *             SDL_Delay(_poll_interval)
+   *     return 0             # <<<<<<<<<<<<<<
+   *
+   * cdef _poll_stop():
+   */
+  __pyx_r = 0;
+  goto __pyx_L0;
+
+  __pyx_r = 0;
+  __pyx_L0:;
+  return __pyx_r;
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":240
+ *     return 0
+ *
+ * cdef _poll_stop():             # <<<<<<<<<<<<<<
+ *     global _poll_running, _poll_thread
+ *     _poll_running = 0
+ */
+
+static PyObject *__pyx_f_4pypm__poll_stop(void) {
+  PyObject *__pyx_r = NULL;
+  int __pyx_t_1;
+  __Pyx_SetupRefcountContext("_poll_stop");
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":242
+   * cdef _poll_stop():
+   *     global _poll_running, _poll_thread
+   *     _poll_running = 0             # <<<<<<<<<<<<<<
+   *     if _poll_thread != NULL:
+   *         with nogil:
+   */
+  __pyx_v_4pypm__poll_running = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":243
+   *     global _poll_running, _poll_thread
+   *     _poll_running = 0
+   *     if _poll_thread != NULL:             # <<<<<<<<<<<<<<
+   *         with nogil:
+   *             SDL_WaitThread(_poll_thread, NULL)
+   */
+  __pyx_t_1 = (__pyx_v_4pypm__poll_thread != NULL);
+  if (__pyx_t_1) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":244
+     *     _poll_running = 0
+     *     if _poll_thread != NULL:
+     *         with nogil:             # <<<<<<<<<<<<<<
+     *             SDL_WaitThread(_poll_thread, NULL)
+     *         _poll_thread = NULL
+     */
+    {
+      #ifdef WITH_THREAD
+      PyThreadState *_save;
+      #endif
+      Py_UNBLOCK_THREADS
+      /*try:*/ {
+
+        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":245
+         *     if _poll_thread != NULL:
+         *         with nogil:
+         *             SDL_WaitThread(_poll_thread, NULL)             # <<<<<<<<<<<<<<
+         *         _poll_thread = NULL
+         *
+         */
+        SDL_WaitThread(__pyx_v_4pypm__poll_thread, NULL);
+      }
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":244
+       *     _poll_running = 0
+       *     if _poll_thread != NULL:
+       *         with nogil:             # <<<<<<<<<<<<<<
+       *             SDL_WaitThread(_poll_thread, NULL)
+       *         _poll_thread = NULL
+       */
+      /*finally:*/ {
+        Py_BLOCK_THREADS
+      }
+    }
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":246
+     *         with nogil:
+     *             SDL_WaitThread(_poll_thread, NULL)
+     *         _poll_thread = NULL             # <<<<<<<<<<<<<<
+     *
+     * cdef _poll_add(PmStream *midi, int device):
+     */
+    __pyx_v_4pypm__poll_thread = NULL;
+    goto __pyx_L3;
+  }
+  __pyx_L3:;
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":248
+ *         _poll_thread = NULL
+ *
+ * cdef _poll_add(PmStream *midi, int device):             # <<<<<<<<<<<<<<
+ *     global _poll_count, _poll_running, _poll_lock, _poll_thread
+ *     cdef int restart
+ */
+
+static PyObject *__pyx_f_4pypm__poll_add(PmStream *__pyx_v_midi, int __pyx_v_device) {
+  int __pyx_v_restart;
+  PyObject *__pyx_r = NULL;
+  int __pyx_t_1;
+  PyObject *__pyx_t_2 = NULL;
+  PyObject *__pyx_t_3 = NULL;
+  int __pyx_t_4;
+  int __pyx_t_5;
+  __Pyx_SetupRefcountContext("_poll_add");
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":251
+   *     global _poll_count, _poll_running, _poll_lock, _poll_thread
+   *     cdef int restart
+   *     if _poll_lock == NULL:             # <<<<<<<<<<<<<<
+   *         _poll_lock = SDL_CreateMutex()
+   *         if _poll_lock == NULL:
+   */
+  __pyx_t_1 = (__pyx_v_4pypm__poll_lock == NULL);
+  if (__pyx_t_1) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":252
+     *     cdef int restart
+     *     if _poll_lock == NULL:
+     *         _poll_lock = SDL_CreateMutex()             # <<<<<<<<<<<<<<
+     *         if _poll_lock == NULL:
+     *             raise MemoryError()
+     */
+    __pyx_v_4pypm__poll_lock = SDL_CreateMutex();
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":253
+     *     if _poll_lock == NULL:
+     *         _poll_lock = SDL_CreateMutex()
+     *         if _poll_lock == NULL:             # <<<<<<<<<<<<<<
+     *             raise MemoryError()
+     *     with nogil:
+     */
+    __pyx_t_1 = (__pyx_v_4pypm__poll_lock == NULL);
+    if (__pyx_t_1) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":254
+       *         _poll_lock = SDL_CreateMutex()
+       *         if _poll_lock == NULL:
+       *             raise MemoryError()             # <<<<<<<<<<<<<<
+       *     with nogil:
+       *         SDL_mutexP(_poll_lock)
+       */
+      __pyx_t_2 = PyObject_Call(__pyx_builtin_MemoryError, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 254; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(__pyx_t_2);
+      __Pyx_Raise(__pyx_t_2, 0, 0);
+      __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 254; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      goto __pyx_L4;
+    }
+    __pyx_L4:;
+    goto __pyx_L3;
+  }
+  __pyx_L3:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":255
+   *         if _poll_lock == NULL:
+   *             raise MemoryError()
+   *     with nogil:             # <<<<<<<<<<<<<<
+   *         SDL_mutexP(_poll_lock)
+   *     if _poll_count == MAX_POLLED:
+   */
+  {
+    #ifdef WITH_THREAD
+    PyThreadState *_save;
+    #endif
+    Py_UNBLOCK_THREADS
+    /*try:*/ {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":256
+       *             raise MemoryError()
+       *     with nogil:
+       *         SDL_mutexP(_poll_lock)             # <<<<<<<<<<<<<<
+       *     if _poll_count == MAX_POLLED:
+       *         SDL_mutexV(_poll_lock)
+       */
+      SDL_mutexP(__pyx_v_4pypm__poll_lock);
+    }
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":255
+     *         if _poll_lock == NULL:
+     *             raise MemoryError()
+     *     with nogil:             # <<<<<<<<<<<<<<
+     *         SDL_mutexP(_poll_lock)
+     *     if _poll_count == MAX_POLLED:
+     */
+    /*finally:*/ {
+      Py_BLOCK_THREADS
+    }
+  }
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":257
+   *     with nogil:
+   *         SDL_mutexP(_poll_lock)
+   *     if _poll_count == MAX_POLLED:             # <<<<<<<<<<<<<<
+   *         SDL_mutexV(_poll_lock)
+   *         raise IndexError('Maximum number of polled inputs is %i.'
+   */
+  __pyx_t_1 = (__pyx_v_4pypm__poll_count == 32);
+  if (__pyx_t_1) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":258
+     *         SDL_mutexP(_poll_lock)
+     *     if _poll_count == MAX_POLLED:
+     *         SDL_mutexV(_poll_lock)             # <<<<<<<<<<<<<<
+     *         raise IndexError('Maximum number of polled inputs is %i.'
+     *                          % MAX_POLLED)
+     */
+    SDL_mutexV(__pyx_v_4pypm__poll_lock);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":259
+     *     if _poll_count == MAX_POLLED:
+     *         SDL_mutexV(_poll_lock)
+     *         raise IndexError('Maximum number of polled inputs is %i.'             # <<<<<<<<<<<<<<
+     *                          % MAX_POLLED)
+     *     _poll_streams[_poll_count] = midi
+     */
+    __pyx_t_2 = PyNumber_Remainder(__pyx_kp_25, __pyx_int_32); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 259; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_2);
+    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 259; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(((PyObject *)__pyx_t_3));
+    PyTuple_SET_ITEM(__pyx_t_3, 0, __pyx_t_2);
+    __Pyx_GIVEREF(__pyx_t_2);
+    __pyx_t_2 = 0;
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_IndexError, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 259; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_2);
+    __Pyx_DECREF(((PyObject *)__pyx_t_3)); __pyx_t_3 = 0;
+    __Pyx_Raise(__pyx_t_2, 0, 0);
+    __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 259; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    goto __pyx_L8;
+  }
+  __pyx_L8:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":261
+   *         raise IndexError('Maximum number of polled inputs is %i.'
+   *                          % MAX_POLLED)
+   *     _poll_streams[_poll_count] = midi             # <<<<<<<<<<<<<<
+   *     _poll_devices[_poll_count] = device
+   *     _poll_count = _poll_count + 1
+   */
+  (__pyx_v_4pypm__poll_streams[__pyx_v_4pypm__poll_count]) = __pyx_v_midi;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":262
+   *                          % MAX_POLLED)
+   *     _poll_streams[_poll_count] = midi
+   *     _poll_devices[_poll_count] = device             # <<<<<<<<<<<<<<
+   *     _poll_count = _poll_count + 1
+   *     restart = _poll_thread == NULL or not _poll_running
+   */
+  (__pyx_v_4pypm__poll_devices[__pyx_v_4pypm__poll_count]) = __pyx_v_device;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":263
+   *     _poll_streams[_poll_count] = midi
+   *     _poll_devices[_poll_count] = device
+   *     _poll_count = _poll_count + 1             # <<<<<<<<<<<<<<
+   *     restart = _poll_thread == NULL or not _poll_running
+   *     SDL_mutexV(_poll_lock)
+   */
+  __pyx_v_4pypm__poll_count = (__pyx_v_4pypm__poll_count + 1);
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":264
+   *     _poll_devices[_poll_count] = device
+   *     _poll_count = _poll_count + 1
+   *     restart = _poll_thread == NULL or not _poll_running             # <<<<<<<<<<<<<<
+   *     SDL_mutexV(_poll_lock)
+   *     if restart:
+   */
+  __pyx_t_1 = (__pyx_v_4pypm__poll_thread == NULL);
+  if (!__pyx_t_1) {
+    __pyx_t_4 = (!__pyx_v_4pypm__poll_running);
+    __pyx_t_5 = __pyx_t_4;
+  } else {
+    __pyx_t_5 = __pyx_t_1;
+  }
+  __pyx_v_restart = __pyx_t_5;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":265
+   *     _poll_count = _poll_count + 1
+   *     restart = _poll_thread == NULL or not _poll_running
+   *     SDL_mutexV(_poll_lock)             # <<<<<<<<<<<<<<
+   *     if restart:
+   *         _poll_stop()
+   */
+  SDL_mutexV(__pyx_v_4pypm__poll_lock);
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":266
+   *     restart = _poll_thread == NULL or not _poll_running
+   *     SDL_mutexV(_poll_lock)
+   *     if restart:             # <<<<<<<<<<<<<<
+   *         _poll_stop()
+   *         _poll_running = 1
+   */
+  if (__pyx_v_restart) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":267
+     *     SDL_mutexV(_poll_lock)
+     *     if restart:
+     *         _poll_stop()             # <<<<<<<<<<<<<<
+     *         _poll_running = 1
+     *         _poll_thread = SDL_CreateThread(_poll_run, NULL)
+     */
+    __pyx_t_2 = __pyx_f_4pypm__poll_stop(); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 267; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_2);
+    __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":268
+     *     if restart:
+     *         _poll_stop()
+     *         _poll_running = 1             # <<<<<<<<<<<<<<
+     *         _poll_thread = SDL_CreateThread(_poll_run, NULL)
+     *         if _poll_thread == NULL:
+     */
+    __pyx_v_4pypm__poll_running = 1;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":269
+     *         _poll_stop()
+     *         _poll_running = 1
+     *         _poll_thread = SDL_CreateThread(_poll_run, NULL)             # <<<<<<<<<<<<<<
+     *         if _poll_thread == NULL:
+     *             _poll_running = 0
+     */
+    __pyx_v_4pypm__poll_thread = SDL_CreateThread(__pyx_f_4pypm__poll_run, NULL);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":270
+     *         _poll_running = 1
+     *         _poll_thread = SDL_CreateThread(_poll_run, NULL)
+     *         if _poll_thread == NULL:             # <<<<<<<<<<<<<<
+     *             _poll_running = 0
+     *             raise Exception("Could not start the MIDI poll thread.")
+     */
+    __pyx_t_5 = (__pyx_v_4pypm__poll_thread == NULL);
+    if (__pyx_t_5) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":271
+       *         _poll_thread = SDL_CreateThread(_poll_run, NULL)
+       *         if _poll_thread == NULL:
+       *             _poll_running = 0             # <<<<<<<<<<<<<<
+       *             raise Exception("Could not start the MIDI poll thread.")
+       *
+       */
+      __pyx_v_4pypm__poll_running = 0;
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":272
+       *         if _poll_thread == NULL:
+       *             _poll_running = 0
+       *             raise Exception("Could not start the MIDI poll thread.")             # <<<<<<<<<<<<<<
+       *
+       * cdef _poll_remove(PmStream *midi):
+       */
+      __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 272; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(((PyObject *)__pyx_t_2));
+      __Pyx_INCREF(__pyx_kp_26);
+      PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_kp_26);
+      __Pyx_GIVEREF(__pyx_kp_26);
+      __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 272; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(__pyx_t_3);
+      __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
+      __Pyx_Raise(__pyx_t_3, 0, 0);
+      __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 272; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      goto __pyx_L10;
+    }
+    __pyx_L10:;
+    goto __pyx_L9;
+  }
+  __pyx_L9:;
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_2);
+  __Pyx_XDECREF(__pyx_t_3);
+  __Pyx_AddTraceback("pypm._poll_add");
+  __pyx_r = 0;
+  __pyx_L0:;
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":274
+ *             raise Exception("Could not start the MIDI poll thread.")
+ *
+ * cdef _poll_remove(PmStream *midi):             # <<<<<<<<<<<<<<
+ *     global _poll_count
+ *     cdef int i
+ */
+
+static PyObject *__pyx_f_4pypm__poll_remove(PmStream *__pyx_v_midi) {
+  int __pyx_v_i;
+  PyObject *__pyx_r = NULL;
+  int __pyx_t_1;
+  __Pyx_SetupRefcountContext("_poll_remove");
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":277
+   *     global _poll_count
+   *     cdef int i
+   *     if _poll_lock == NULL:             # <<<<<<<<<<<<<<
+   *         return
+   *     with nogil:
+   */
+  __pyx_t_1 = (__pyx_v_4pypm__poll_lock == NULL);
+  if (__pyx_t_1) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":278
+     *     cdef int i
+     *     if _poll_lock == NULL:
+     *         return             # <<<<<<<<<<<<<<
+     *     with nogil:
+     *         SDL_mutexP(_poll_lock)
+     */
+    __Pyx_XDECREF(__pyx_r);
+    __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+    goto __pyx_L0;
+    goto __pyx_L3;
+  }
+  __pyx_L3:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":279
+   *     if _poll_lock == NULL:
+   *         return
+   *     with nogil:             # <<<<<<<<<<<<<<
+   *         SDL_mutexP(_poll_lock)
+   *     i = 0
+   */
+  {
+    #ifdef WITH_THREAD
+    PyThreadState *_save;
+    #endif
+    Py_UNBLOCK_THREADS
+    /*try:*/ {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":280
+       *         return
+       *     with nogil:
+       *         SDL_mutexP(_poll_lock)             # <<<<<<<<<<<<<<
+       *     i = 0
+       *     while i < _poll_count:
+       */
+      SDL_mutexP(__pyx_v_4pypm__poll_lock);
+    }
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":279
+     *     if _poll_lock == NULL:
+     *         return
+     *     with nogil:             # <<<<<<<<<<<<<<
+     *         SDL_mutexP(_poll_lock)
+     *     i = 0
+     */
+    /*finally:*/ {
+      Py_BLOCK_THREADS
+    }
+  }
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":281
+   *     with nogil:
+   *         SDL_mutexP(_poll_lock)
+   *     i = 0             # <<<<<<<<<<<<<<
+   *     while i < _poll_count:
+   *         if _poll_streams[i] == midi:
+   */
+  __pyx_v_i = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":282
+   *         SDL_mutexP(_poll_lock)
+   *     i = 0
+   *     while i < _poll_count:             # <<<<<<<<<<<<<<
+   *         if _poll_streams[i] == midi:
+   *             _poll_count = _poll_count - 1
+   */
+  while (1) {
+    __pyx_t_1 = (__pyx_v_i < __pyx_v_4pypm__poll_count);
+    if (!__pyx_t_1) break;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":283
+     *     i = 0
+     *     while i < _poll_count:
+     *         if _poll_streams[i] == midi:             # <<<<<<<<<<<<<<
+     *             _poll_count = _poll_count - 1
+     *             _poll_streams[i] = _poll_streams[_poll_count]
+     */
+    __pyx_t_1 = ((__pyx_v_4pypm__poll_streams[__pyx_v_i]) == __pyx_v_midi);
+    if (__pyx_t_1) {
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":149
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":284
+       *     while i < _poll_count:
+       *         if _poll_streams[i] == midi:
+       *             _poll_count = _poll_count - 1             # <<<<<<<<<<<<<<
+       *             _poll_streams[i] = _poll_streams[_poll_count]
+       *             _poll_devices[i] = _poll_devices[_poll_count]
+       */
+      __pyx_v_4pypm__poll_count = (__pyx_v_4pypm__poll_count - 1);
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":285
+       *         if _poll_streams[i] == midi:
+       *             _poll_count = _poll_count - 1
+       *             _poll_streams[i] = _poll_streams[_poll_count]             # <<<<<<<<<<<<<<
+       *             _poll_devices[i] = _poll_devices[_poll_count]
+       *         else:
+       */
+      (__pyx_v_4pypm__poll_streams[__pyx_v_i]) = (__pyx_v_4pypm__poll_streams[__pyx_v_4pypm__poll_count]);
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":286
+       *             _poll_count = _poll_count - 1
+       *             _poll_streams[i] = _poll_streams[_poll_count]
+       *             _poll_devices[i] = _poll_devices[_poll_count]             # <<<<<<<<<<<<<<
+       *         else:
+       *             i = i + 1
+       */
+      (__pyx_v_4pypm__poll_devices[__pyx_v_i]) = (__pyx_v_4pypm__poll_devices[__pyx_v_4pypm__poll_count]);
+      goto __pyx_L9;
+    }
+    /*else*/ {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":288
+       *             _poll_devices[i] = _poll_devices[_poll_count]
+       *         else:
+       *             i = i + 1             # <<<<<<<<<<<<<<
+       *     SDL_mutexV(_poll_lock)
+       *
+       */
+      __pyx_v_i = (__pyx_v_i + 1);
+    }
+    __pyx_L9:;
+  }
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":289
+   *         else:
+   *             i = i + 1
+   *     SDL_mutexV(_poll_lock)             # <<<<<<<<<<<<<<
+   *
+   *
+   */
+  SDL_mutexV(__pyx_v_4pypm__poll_lock);
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  __pyx_L0:;
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":292
  *
  *
  * def Initialize():             # <<<<<<<<<<<<<<
@@ -663,7 +1628,7 @@ static PyObject *__pyx_pf_4pypm_Initialize(PyObject *__pyx_self, PyObject *unuse
   __Pyx_SetupRefcountContext("Initialize");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":156
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":299
  *
  *     """
  *     Pm_Initialize()             # <<<<<<<<<<<<<<
@@ -672,7 +1637,7 @@ static PyObject *__pyx_pf_4pypm_Initialize(PyObject *__pyx_self, PyObject *unuse
  */
   Pm_Initialize();
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":158
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":301
  *     Pm_Initialize()
  *     # equiv to TIME_START: start timer w/ ms accuracy
  *     Pt_Start(1, NULL, NULL)             # <<<<<<<<<<<<<<
@@ -687,7 +1652,7 @@ static PyObject *__pyx_pf_4pypm_Initialize(PyObject *__pyx_self, PyObject *unuse
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":160
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":303
  *     Pt_Start(1, NULL, NULL)
  *
  * def Terminate():             # <<<<<<<<<<<<<<
@@ -699,26 +1664,175 @@ static PyObject *__pyx_pf_4pypm_Terminate(PyObject *__pyx_self, PyObject *unused
 static char __pyx_doc_4pypm_Terminate[] = "Terminate use of PortMidi library.\n\n    Call this to clean up Midi streams when done.\n\n    If you do not call this on Windows machines when you are done with MIDI,\n    your system may crash.\n\n    ";
 static PyObject *__pyx_pf_4pypm_Terminate(PyObject *__pyx_self, PyObject *unused) {
   PyObject *__pyx_r = NULL;
+  PyObject *__pyx_t_1 = NULL;
   __Pyx_SetupRefcountContext("Terminate");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":169
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":312
+   *
+   *     """
+   *     _poll_stop()             # <<<<<<<<<<<<<<
+   *     Pm_Terminate()
+   *
+   */
+  __pyx_t_1 = __pyx_f_4pypm__poll_stop(); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 312; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_1);
+  __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":313
+   *     """
+   *     _poll_stop()
+   *     Pm_Terminate()             # <<<<<<<<<<<<<<
+   *
+   * def SetPollCallback(callback, interval=1):
+   */
+  Pm_Terminate();
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_1);
+  __Pyx_AddTraceback("pypm.Terminate");
+  __pyx_r = NULL;
+  __pyx_L0:;
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":315
+ *     Pm_Terminate()
  *
- *     """
- *     Pm_Terminate()             # <<<<<<<<<<<<<<
+ * def SetPollCallback(callback, interval=1):             # <<<<<<<<<<<<<<
+ *     """Set the function the poll thread hands input to.
  *
- * def GetDefaultInputDeviceID():
  */
-  Pm_Terminate();
+
+static PyObject *__pyx_pf_4pypm_SetPollCallback(PyObject *__pyx_self, PyObject *__pyx_args, PyObject *__pyx_kwds); /*proto*/
+static char __pyx_doc_4pypm_SetPollCallback[] = "Set the function the poll thread hands input to.\n\n    Usage::\n\n        SetPollCallback(callback, interval)\n\n    While any Input is polled, see Input.StartPolling, a native thread polls\n    them every interval ms and calls callback(device, events) for each with\n    input, with events a list as Input.Read returns. The callback is called\n    from the poll thread. Exceptions it raises are printed and ignored.\n\n    ";
+static PyObject *__pyx_pf_4pypm_SetPollCallback(PyObject *__pyx_self, PyObject *__pyx_args, PyObject *__pyx_kwds) {
+  PyObject *__pyx_v_callback = 0;
+  PyObject *__pyx_v_interval = 0;
+  PyObject *__pyx_r = NULL;
+  PyObject *__pyx_t_1 = NULL;
+  int __pyx_t_2;
+  PyObject *__pyx_t_3 = NULL;
+  int __pyx_t_4;
+  static PyObject **__pyx_pyargnames[] = {&__pyx_kp_callback,&__pyx_kp_interval,0};
+  __Pyx_SetupRefcountContext("SetPollCallback");
+  __pyx_self = __pyx_self;
+  if (unlikely(__pyx_kwds)) {
+    Py_ssize_t kw_args = PyDict_Size(__pyx_kwds);
+    PyObject* values[2] = {0,0};
+    values[1] = __pyx_int_1;
+    switch (PyTuple_GET_SIZE(__pyx_args)) {
+      case  2: values[1] = PyTuple_GET_ITEM(__pyx_args, 1);
+      case  1: values[0] = PyTuple_GET_ITEM(__pyx_args, 0);
+      case  0: break;
+      default: goto __pyx_L5_argtuple_error;
+    }
+    switch (PyTuple_GET_SIZE(__pyx_args)) {
+      case  0:
+      values[0] = PyDict_GetItem(__pyx_kwds, __pyx_kp_callback);
+      if (likely(values[0])) kw_args--;
+      else goto __pyx_L5_argtuple_error;
+      case  1:
+      if (kw_args > 1) {
+        PyObject* value = PyDict_GetItem(__pyx_kwds, __pyx_kp_interval);
+        if (unlikely(value)) { values[1] = value; kw_args--; }
+      }
+    }
+    if (unlikely(kw_args > 0)) {
+      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "SetPollCallback") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 315; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+    }
+    __pyx_v_callback = values[0];
+    __pyx_v_interval = values[1];
+  } else {
+    __pyx_v_interval = __pyx_int_1;
+    switch (PyTuple_GET_SIZE(__pyx_args)) {
+      case  2: __pyx_v_interval = PyTuple_GET_ITEM(__pyx_args, 1);
+      case  1: __pyx_v_callback = PyTuple_GET_ITEM(__pyx_args, 0);
+      break;
+      default: goto __pyx_L5_argtuple_error;
+    }
+  }
+  goto __pyx_L4_argument_unpacking_done;
+  __pyx_L5_argtuple_error:;
+  __Pyx_RaiseArgtupleInvalid("SetPollCallback", 0, 1, 2, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 315; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+  __pyx_L3_error:;
+  __Pyx_AddTraceback("pypm.SetPollCallback");
+  return NULL;
+  __pyx_L4_argument_unpacking_done:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":329
+   *     """
+   *     global _poll_callback, _poll_interval
+   *     if interval < 1:             # <<<<<<<<<<<<<<
+   *         raise ValueError('Minimum poll interval is 1 ms.')
+   *     _poll_callback = callback
+   */
+  __pyx_t_1 = PyObject_RichCompare(__pyx_v_interval, __pyx_int_1, Py_LT); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 329; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_1);
+  __pyx_t_2 = __Pyx_PyObject_IsTrue(__pyx_t_1); if (unlikely(__pyx_t_2 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 329; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
+  if (__pyx_t_2) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":330
+     *     global _poll_callback, _poll_interval
+     *     if interval < 1:
+     *         raise ValueError('Minimum poll interval is 1 ms.')             # <<<<<<<<<<<<<<
+     *     _poll_callback = callback
+     *     _poll_interval = interval
+     */
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 330; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(((PyObject *)__pyx_t_1));
+    __Pyx_INCREF(__pyx_kp_27);
+    PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_kp_27);
+    __Pyx_GIVEREF(__pyx_kp_27);
+    __pyx_t_3 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 330; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_3);
+    __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
+    __Pyx_Raise(__pyx_t_3, 0, 0);
+    __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 330; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    goto __pyx_L6;
+  }
+  __pyx_L6:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":331
+   *     if interval < 1:
+   *         raise ValueError('Minimum poll interval is 1 ms.')
+   *     _poll_callback = callback             # <<<<<<<<<<<<<<
+   *     _poll_interval = interval
+   *
+   */
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp__poll_callback, __pyx_v_callback) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 331; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":332
+   *         raise ValueError('Minimum poll interval is 1 ms.')
+   *     _poll_callback = callback
+   *     _poll_interval = interval             # <<<<<<<<<<<<<<
+   *
+   * def GetDefaultInputDeviceID():
+   */
+  __pyx_t_4 = __Pyx_PyInt_AsInt(__pyx_v_interval); if (unlikely((__pyx_t_4 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 332; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_v_4pypm__poll_interval = __pyx_t_4;
 
   __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_1);
+  __Pyx_XDECREF(__pyx_t_3);
+  __Pyx_AddTraceback("pypm.SetPollCallback");
+  __pyx_r = NULL;
+  __pyx_L0:;
   __Pyx_XGIVEREF(__pyx_r);
   __Pyx_FinishRefcountContext();
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":171
- *     Pm_Terminate()
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":334
+ *     _poll_interval = interval
  *
  * def GetDefaultInputDeviceID():             # <<<<<<<<<<<<<<
  *     """Return the number of the default MIDI input device.
@@ -733,7 +1847,7 @@ static PyObject *__pyx_pf_4pypm_GetDefaultInputDeviceID(PyObject *__pyx_self, Py
   __Pyx_SetupRefcountContext("GetDefaultInputDeviceID");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":178
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":341
  *
  *     """
  *     return Pm_GetDefaultInputDeviceID()             # <<<<<<<<<<<<<<
@@ -741,7 +1855,7 @@ static PyObject *__pyx_pf_4pypm_GetDefaultInputDeviceID(PyObject *__pyx_self, Py
  * def GetDefaultOutputDeviceID():
  */
   __Pyx_XDECREF(__pyx_r);
-  __pyx_t_1 = PyInt_FromLong(Pm_GetDefaultInputDeviceID()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 178; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyInt_FromLong(Pm_GetDefaultInputDeviceID()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 341; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __pyx_r = __pyx_t_1;
   __pyx_t_1 = 0;
@@ -759,7 +1873,7 @@ static PyObject *__pyx_pf_4pypm_GetDefaultInputDeviceID(PyObject *__pyx_self, Py
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":180
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":343
  *     return Pm_GetDefaultInputDeviceID()
  *
  * def GetDefaultOutputDeviceID():             # <<<<<<<<<<<<<<
@@ -775,7 +1889,7 @@ static PyObject *__pyx_pf_4pypm_GetDefaultOutputDeviceID(PyObject *__pyx_self, P
   __Pyx_SetupRefcountContext("GetDefaultOutputDeviceID");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":187
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":350
  *
  *     """
  *     return Pm_GetDefaultOutputDeviceID()             # <<<<<<<<<<<<<<
@@ -783,7 +1897,7 @@ static PyObject *__pyx_pf_4pypm_GetDefaultOutputDeviceID(PyObject *__pyx_self, P
  * def CountDevices():
  */
   __Pyx_XDECREF(__pyx_r);
-  __pyx_t_1 = PyInt_FromLong(Pm_GetDefaultOutputDeviceID()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 187; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyInt_FromLong(Pm_GetDefaultOutputDeviceID()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 350; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __pyx_r = __pyx_t_1;
   __pyx_t_1 = 0;
@@ -801,7 +1915,7 @@ static PyObject *__pyx_pf_4pypm_GetDefaultOutputDeviceID(PyObject *__pyx_self, P
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":189
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":352
  *     return Pm_GetDefaultOutputDeviceID()
  *
  * def CountDevices():             # <<<<<<<<<<<<<<
@@ -817,7 +1931,7 @@ static PyObject *__pyx_pf_4pypm_CountDevices(PyObject *__pyx_self, PyObject *unu
   __Pyx_SetupRefcountContext("CountDevices");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":192
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":355
  *     """Return number of available MIDI (input and output) devices."""
  *
  *     return Pm_CountDevices()             # <<<<<<<<<<<<<<
@@ -825,7 +1939,7 @@ static PyObject *__pyx_pf_4pypm_CountDevices(PyObject *__pyx_self, PyObject *unu
  * def GetDeviceInfo(device_no):
  */
   __Pyx_XDECREF(__pyx_r);
-  __pyx_t_1 = PyInt_FromLong(Pm_CountDevices()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 192; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyInt_FromLong(Pm_CountDevices()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 355; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __pyx_r = __pyx_t_1;
   __pyx_t_1 = 0;
@@ -843,7 +1957,7 @@ static PyObject *__pyx_pf_4pypm_CountDevices(PyObject *__pyx_self, PyObject *unu
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":194
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":357
  *     return Pm_CountDevices()
  *
  * def GetDeviceInfo(device_no):             # <<<<<<<<<<<<<<
@@ -867,17 +1981,17 @@ static PyObject *__pyx_pf_4pypm_GetDeviceInfo(PyObject *__pyx_self, PyObject *__
   __Pyx_SetupRefcountContext("GetDeviceInfo");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":210
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":373
  *     # disregarding the constness from Pm_GetDeviceInfo,
  *     # since pyrex doesn't do const.
  *     info = <PmDeviceInfo *>Pm_GetDeviceInfo(device_no)             # <<<<<<<<<<<<<<
  *
  *     if info != NULL:
  */
-  __pyx_t_1 = __Pyx_PyInt_AsInt(__pyx_v_device_no); if (unlikely((__pyx_t_1 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 210; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = __Pyx_PyInt_AsInt(__pyx_v_device_no); if (unlikely((__pyx_t_1 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 373; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_info = ((PmDeviceInfo *)Pm_GetDeviceInfo(__pyx_t_1));
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":212
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":375
  *     info = <PmDeviceInfo *>Pm_GetDeviceInfo(device_no)
  *
  *     if info != NULL:             # <<<<<<<<<<<<<<
@@ -887,7 +2001,7 @@ static PyObject *__pyx_pf_4pypm_GetDeviceInfo(PyObject *__pyx_self, PyObject *__
   __pyx_t_2 = (__pyx_v_info != NULL);
   if (__pyx_t_2) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":213
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":376
  *
  *     if info != NULL:
  *         return info.interf, info.name, info.input, info.output, info.opened             # <<<<<<<<<<<<<<
@@ -895,17 +2009,17 @@ static PyObject *__pyx_pf_4pypm_GetDeviceInfo(PyObject *__pyx_self, PyObject *__
  *
  */
     __Pyx_XDECREF(__pyx_r);
-    __pyx_t_3 = __Pyx_PyBytes_FromString(__pyx_v_info->interf); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 213; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_3 = __Pyx_PyBytes_FromString(__pyx_v_info->interf); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 376; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_3);
-    __pyx_t_4 = __Pyx_PyBytes_FromString(__pyx_v_info->name); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 213; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_4 = __Pyx_PyBytes_FromString(__pyx_v_info->name); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 376; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_4);
-    __pyx_t_5 = PyInt_FromLong(__pyx_v_info->input); if (unlikely(!__pyx_t_5)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 213; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_5 = PyInt_FromLong(__pyx_v_info->input); if (unlikely(!__pyx_t_5)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 376; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_5);
-    __pyx_t_6 = PyInt_FromLong(__pyx_v_info->output); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 213; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_6 = PyInt_FromLong(__pyx_v_info->output); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 376; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_6);
-    __pyx_t_7 = PyInt_FromLong(__pyx_v_info->opened); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 213; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_7 = PyInt_FromLong(__pyx_v_info->opened); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 376; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_7);
-    __pyx_t_8 = PyTuple_New(5); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 213; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_8 = PyTuple_New(5); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 376; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_8));
     PyTuple_SET_ITEM(__pyx_t_8, 0, __pyx_t_3);
     __Pyx_GIVEREF(__pyx_t_3);
@@ -946,7 +2060,7 @@ static PyObject *__pyx_pf_4pypm_GetDeviceInfo(PyObject *__pyx_self, PyObject *__
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":216
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":379
  *     # return None
  *
  * def Time():             # <<<<<<<<<<<<<<
@@ -962,7 +2076,7 @@ static PyObject *__pyx_pf_4pypm_Time(PyObject *__pyx_self, PyObject *unused) {
   __Pyx_SetupRefcountContext("Time");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":219
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":382
  *     """Return the current time in ms of the PortMidi timer."""
  *
  *     return Pt_Time()             # <<<<<<<<<<<<<<
@@ -970,7 +2084,7 @@ static PyObject *__pyx_pf_4pypm_Time(PyObject *__pyx_self, PyObject *unused) {
  * def GetErrorText(err):
  */
   __Pyx_XDECREF(__pyx_r);
-  __pyx_t_1 = PyInt_FromLong(Pt_Time()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 219; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyInt_FromLong(Pt_Time()); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 382; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __pyx_r = __pyx_t_1;
   __pyx_t_1 = 0;
@@ -988,7 +2102,7 @@ static PyObject *__pyx_pf_4pypm_Time(PyObject *__pyx_self, PyObject *unused) {
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":221
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":384
  *     return Pt_Time()
  *
  * def GetErrorText(err):             # <<<<<<<<<<<<<<
@@ -1005,7 +2119,7 @@ static PyObject *__pyx_pf_4pypm_GetErrorText(PyObject *__pyx_self, PyObject *__p
   __Pyx_SetupRefcountContext("GetErrorText");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":224
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":387
  *     """Return human-readable error message translated from error number."""
  *
  *     return Pm_GetErrorText(err)             # <<<<<<<<<<<<<<
@@ -1013,8 +2127,8 @@ static PyObject *__pyx_pf_4pypm_GetErrorText(PyObject *__pyx_self, PyObject *__p
  * def Channel(chan):
  */
   __Pyx_XDECREF(__pyx_r);
-  __pyx_t_1 = ((PmError)PyInt_AsLong(__pyx_v_err)); if (unlikely(PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 224; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_t_1)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 224; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = ((PmError)PyInt_AsLong(__pyx_v_err)); if (unlikely(PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 387; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_t_1)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 387; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __pyx_r = __pyx_t_2;
   __pyx_t_2 = 0;
@@ -1032,7 +2146,7 @@ static PyObject *__pyx_pf_4pypm_GetErrorText(PyObject *__pyx_self, PyObject *__p
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":226
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":389
  *     return Pm_GetErrorText(err)
  *
  * def Channel(chan):             # <<<<<<<<<<<<<<
@@ -1049,7 +2163,7 @@ static PyObject *__pyx_pf_4pypm_Channel(PyObject *__pyx_self, PyObject *__pyx_v_
   __Pyx_SetupRefcountContext("Channel");
   __pyx_self = __pyx_self;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":245
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":408
  *
  *     """
  *     return Pm_Channel(chan - 1)             # <<<<<<<<<<<<<<
@@ -1057,11 +2171,11 @@ static PyObject *__pyx_pf_4pypm_Channel(PyObject *__pyx_self, PyObject *__pyx_v_
  *
  */
   __Pyx_XDECREF(__pyx_r);
-  __pyx_t_1 = PyNumber_Subtract(__pyx_v_chan, __pyx_int_1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 245; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyNumber_Subtract(__pyx_v_chan, __pyx_int_1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = __Pyx_PyInt_AsInt(__pyx_t_1); if (unlikely((__pyx_t_2 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 245; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = __Pyx_PyInt_AsInt(__pyx_t_1); if (unlikely((__pyx_t_2 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
-  __pyx_t_1 = PyInt_FromLong(Pm_Channel(__pyx_t_2)); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 245; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyInt_FromLong(Pm_Channel(__pyx_t_2)); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __pyx_r = __pyx_t_1;
   __pyx_t_1 = 0;
@@ -1079,7 +2193,7 @@ static PyObject *__pyx_pf_4pypm_Channel(PyObject *__pyx_self, PyObject *__pyx_v_
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":263
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":426
  *     cdef int _aborted
  *
  *     def __init__(self, output_device, latency=0):             # <<<<<<<<<<<<<<
@@ -1126,7 +2240,7 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
       }
     }
     if (unlikely(kw_args > 0)) {
-      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "__init__") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 263; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "__init__") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 426; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
     }
     __pyx_v_output_device = values[0];
     __pyx_v_latency = values[1];
@@ -1141,24 +2255,24 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
   }
   goto __pyx_L4_argument_unpacking_done;
   __pyx_L5_argtuple_error:;
-  __Pyx_RaiseArgtupleInvalid("__init__", 0, 1, 2, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 263; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+  __Pyx_RaiseArgtupleInvalid("__init__", 0, 1, 2, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 426; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
   __pyx_L3_error:;
   __Pyx_AddTraceback("pypm.Output.__init__");
   return -1;
   __pyx_L4_argument_unpacking_done:;
   __pyx_v_errmsg = Py_None; __Pyx_INCREF(Py_None);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":270
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":433
  *         cdef PmTimeProcPtr PmPtr
  *
  *         self.device = output_device             # <<<<<<<<<<<<<<
  *         self.debug = 0
  *         self._aborted = 0
  */
-  __pyx_t_1 = __Pyx_PyInt_AsInt(__pyx_v_output_device); if (unlikely((__pyx_t_1 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 270; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = __Pyx_PyInt_AsInt(__pyx_v_output_device); if (unlikely((__pyx_t_1 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 433; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->device = __pyx_t_1;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":271
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":434
  *
  *         self.device = output_device
  *         self.debug = 0             # <<<<<<<<<<<<<<
@@ -1167,7 +2281,7 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
  */
   ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->debug = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":272
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":435
  *         self.device = output_device
  *         self.debug = 0
  *         self._aborted = 0             # <<<<<<<<<<<<<<
@@ -1176,20 +2290,20 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
  */
   ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->_aborted = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":274
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":437
  *         self._aborted = 0
  *
  *         if latency == 0:             # <<<<<<<<<<<<<<
  *             PmPtr = NULL
  *         else:
  */
-  __pyx_t_2 = PyObject_RichCompare(__pyx_v_latency, __pyx_int_0, Py_EQ); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 274; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_RichCompare(__pyx_v_latency, __pyx_int_0, Py_EQ); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 437; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
-  __pyx_t_3 = __Pyx_PyObject_IsTrue(__pyx_t_2); if (unlikely(__pyx_t_3 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 274; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = __Pyx_PyObject_IsTrue(__pyx_t_2); if (unlikely(__pyx_t_3 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 437; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
   if (__pyx_t_3) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":275
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":438
  *
  *         if latency == 0:
  *             PmPtr = NULL             # <<<<<<<<<<<<<<
@@ -1201,7 +2315,7 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
   }
   /*else*/ {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":277
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":440
  *             PmPtr = NULL
  *         else:
  *             PmPtr = <PmTimeProcPtr>&Pt_Time             # <<<<<<<<<<<<<<
@@ -1212,7 +2326,7 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":279
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":442
  *             PmPtr = <PmTimeProcPtr>&Pt_Time
  *
  *         if self.debug:             # <<<<<<<<<<<<<<
@@ -1222,38 +2336,38 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
   __pyx_t_1 = ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->debug;
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":280
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":443
  *
  *         if self.debug:
  *             print "Opening Midi Output"             # <<<<<<<<<<<<<<
  *
  *         # Why is buffer size 0 here?
  */
-    if (__Pyx_PrintOne(__pyx_kp_7) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 280; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    if (__Pyx_PrintOne(__pyx_kp_7) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 443; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L7;
   }
   __pyx_L7:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":283
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":446
  *
  *         # Why is buffer size 0 here?
  *         err = Pm_OpenOutput(&(self.midi), output_device, NULL, 0, PmPtr, NULL,             # <<<<<<<<<<<<<<
  *                             latency)
  *         if err < 0:
  */
-  __pyx_t_4 = __Pyx_PyInt_AsInt(__pyx_v_output_device); if (unlikely((__pyx_t_4 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 283; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_4 = __Pyx_PyInt_AsInt(__pyx_v_output_device); if (unlikely((__pyx_t_4 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 446; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":284
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":447
  *         # Why is buffer size 0 here?
  *         err = Pm_OpenOutput(&(self.midi), output_device, NULL, 0, PmPtr, NULL,
  *                             latency)             # <<<<<<<<<<<<<<
  *         if err < 0:
  *             errmsg = Pm_GetErrorText(err)
  */
-  __pyx_t_5 = __Pyx_PyInt_AsLong(__pyx_v_latency); if (unlikely((__pyx_t_5 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 284; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_5 = __Pyx_PyInt_AsLong(__pyx_v_latency); if (unlikely((__pyx_t_5 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 447; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_err = Pm_OpenOutput((&((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi), __pyx_t_4, NULL, 0, __pyx_v_PmPtr, NULL, __pyx_t_5);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":285
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":448
  *         err = Pm_OpenOutput(&(self.midi), output_device, NULL, 0, PmPtr, NULL,
  *                             latency)
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -1263,20 +2377,20 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
   __pyx_t_3 = (__pyx_v_err < 0);
   if (__pyx_t_3) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":286
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":449
  *                             latency)
  *         if err < 0:
  *             errmsg = Pm_GetErrorText(err)             # <<<<<<<<<<<<<<
  *             # Something's amiss here - if we try to throw an Exception
  *             # here, we crash.
  */
-    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 286; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 449; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(__pyx_v_errmsg);
     __pyx_v_errmsg = __pyx_t_2;
     __pyx_t_2 = 0;
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":289
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":452
  *             # Something's amiss here - if we try to throw an Exception
  *             # here, we crash.
  *             if not err == -10000:             # <<<<<<<<<<<<<<
@@ -1286,36 +2400,36 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
     __pyx_t_3 = (!(__pyx_v_err == -10000));
     if (__pyx_t_3) {
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":290
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":453
  *             # here, we crash.
  *             if not err == -10000:
  *                 raise Exception(errmsg)             # <<<<<<<<<<<<<<
  *             else:
  *                 print "Unable to open Midi OutputDevice=%i: %s" % (
  */
-      __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 290; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 453; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_2));
       __Pyx_INCREF(__pyx_v_errmsg);
       PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_v_errmsg);
       __Pyx_GIVEREF(__pyx_v_errmsg);
-      __pyx_t_6 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 290; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_6 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 453; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_6);
       __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
       __Pyx_Raise(__pyx_t_6, 0, 0);
       __Pyx_DECREF(__pyx_t_6); __pyx_t_6 = 0;
-      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 290; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 453; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       goto __pyx_L9;
     }
     /*else*/ {
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":293
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":456
  *             else:
  *                 print "Unable to open Midi OutputDevice=%i: %s" % (
  *                     output_device, errmsg)             # <<<<<<<<<<<<<<
  *
  *     def __dealloc__(self):
  */
-      __pyx_t_6 = PyTuple_New(2); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 293; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_6 = PyTuple_New(2); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 456; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_6));
       __Pyx_INCREF(__pyx_v_output_device);
       PyTuple_SET_ITEM(__pyx_t_6, 0, __pyx_v_output_device);
@@ -1323,10 +2437,10 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
       __Pyx_INCREF(__pyx_v_errmsg);
       PyTuple_SET_ITEM(__pyx_t_6, 1, __pyx_v_errmsg);
       __Pyx_GIVEREF(__pyx_v_errmsg);
-      __pyx_t_2 = PyNumber_Remainder(__pyx_kp_8, ((PyObject *)__pyx_t_6)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 292; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_2 = PyNumber_Remainder(__pyx_kp_8, ((PyObject *)__pyx_t_6)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 455; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_2);
       __Pyx_DECREF(((PyObject *)__pyx_t_6)); __pyx_t_6 = 0;
-      if (__Pyx_PrintOne(__pyx_t_2) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 292; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      if (__Pyx_PrintOne(__pyx_t_2) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 455; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
     }
     __pyx_L9:;
@@ -1347,7 +2461,7 @@ static int __pyx_pf_4pypm_6Output___init__(PyObject *__pyx_v_self, PyObject *__p
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":295
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":458
  *                     output_device, errmsg)
  *
  *     def __dealloc__(self):             # <<<<<<<<<<<<<<
@@ -1365,7 +2479,7 @@ static void __pyx_pf_4pypm_6Output___dealloc__(PyObject *__pyx_v_self) {
   PyObject *__pyx_t_4 = NULL;
   __Pyx_SetupRefcountContext("__dealloc__");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":300
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":463
  *         cdef PmError err
  *
  *         if self.debug:             # <<<<<<<<<<<<<<
@@ -1375,19 +2489,19 @@ static void __pyx_pf_4pypm_6Output___dealloc__(PyObject *__pyx_v_self) {
   __pyx_t_1 = ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->debug;
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":301
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":464
  *
  *         if self.debug:
  *             print "Closing MIDI output stream and destroying instance."             # <<<<<<<<<<<<<<
  *
  *         if self.midi:
  */
-    if (__Pyx_PrintOne(__pyx_kp_9) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 301; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    if (__Pyx_PrintOne(__pyx_kp_9) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 464; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":303
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":466
  *             print "Closing MIDI output stream and destroying instance."
  *
  *         if self.midi:             # <<<<<<<<<<<<<<
@@ -1397,7 +2511,7 @@ static void __pyx_pf_4pypm_6Output___dealloc__(PyObject *__pyx_v_self) {
   __pyx_t_2 = (((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi != 0);
   if (__pyx_t_2) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":304
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":467
  *
  *         if self.midi:
  *             err = Pm_Close(self.midi)             # <<<<<<<<<<<<<<
@@ -1406,7 +2520,7 @@ static void __pyx_pf_4pypm_6Output___dealloc__(PyObject *__pyx_v_self) {
  */
     __pyx_v_err = Pm_Close(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi);
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":305
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":468
  *         if self.midi:
  *             err = Pm_Close(self.midi)
  *             if err < 0:             # <<<<<<<<<<<<<<
@@ -1416,26 +2530,26 @@ static void __pyx_pf_4pypm_6Output___dealloc__(PyObject *__pyx_v_self) {
     __pyx_t_2 = (__pyx_v_err < 0);
     if (__pyx_t_2) {
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":306
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":469
  *             err = Pm_Close(self.midi)
  *             if err < 0:
  *                 raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *     def _check_open(self):
  */
-      __pyx_t_3 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 306; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_3 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 469; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_3);
-      __pyx_t_4 = PyTuple_New(1); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 306; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_4 = PyTuple_New(1); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 469; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_4));
       PyTuple_SET_ITEM(__pyx_t_4, 0, __pyx_t_3);
       __Pyx_GIVEREF(__pyx_t_3);
       __pyx_t_3 = 0;
-      __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_4), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 306; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_4), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 469; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_3);
       __Pyx_DECREF(((PyObject *)__pyx_t_4)); __pyx_t_4 = 0;
       __Pyx_Raise(__pyx_t_3, 0, 0);
       __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
-      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 306; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 469; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       goto __pyx_L7;
     }
     __pyx_L7:;
@@ -1452,7 +2566,7 @@ static void __pyx_pf_4pypm_6Output___dealloc__(PyObject *__pyx_v_self) {
   __Pyx_FinishRefcountContext();
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":308
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":471
  *                 raise Exception(Pm_GetErrorText(err))
  *
  *     def _check_open(self):             # <<<<<<<<<<<<<<
@@ -1470,7 +2584,7 @@ static PyObject *__pyx_pf_4pypm_6Output__check_open(PyObject *__pyx_v_self, PyOb
   int __pyx_t_4;
   __Pyx_SetupRefcountContext("_check_open");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":314
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":477
  *
  *         """
  *         if self.midi == NULL:             # <<<<<<<<<<<<<<
@@ -1480,29 +2594,29 @@ static PyObject *__pyx_pf_4pypm_6Output__check_open(PyObject *__pyx_v_self, PyOb
   __pyx_t_1 = (((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi == NULL);
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":315
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":478
  *         """
  *         if self.midi == NULL:
  *             raise Exception("midi Output not open.")             # <<<<<<<<<<<<<<
  *
  *         if self._aborted:
  */
-    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 315; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 478; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_2));
     __Pyx_INCREF(__pyx_kp_10);
     PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_kp_10);
     __Pyx_GIVEREF(__pyx_kp_10);
-    __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 315; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 478; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_3);
     __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
     __Pyx_Raise(__pyx_t_3, 0, 0);
     __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 315; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 478; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":317
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":480
  *             raise Exception("midi Output not open.")
  *
  *         if self._aborted:             # <<<<<<<<<<<<<<
@@ -1512,24 +2626,24 @@ static PyObject *__pyx_pf_4pypm_6Output__check_open(PyObject *__pyx_v_self, PyOb
   __pyx_t_4 = ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->_aborted;
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":319
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":482
  *         if self._aborted:
  *             raise Exception(
  *                 "midi Output aborted. Need to call Close after Abort.")             # <<<<<<<<<<<<<<
  *
  *     def Close(self):
  */
-    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 318; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 481; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_3));
     __Pyx_INCREF(__pyx_kp_11);
     PyTuple_SET_ITEM(__pyx_t_3, 0, __pyx_kp_11);
     __Pyx_GIVEREF(__pyx_kp_11);
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 318; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 481; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_3)); __pyx_t_3 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 318; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 481; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L6;
   }
   __pyx_L6:;
@@ -1547,7 +2661,7 @@ static PyObject *__pyx_pf_4pypm_6Output__check_open(PyObject *__pyx_v_self, PyOb
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":321
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":484
  *                 "midi Output aborted. Need to call Close after Abort.")
  *
  *     def Close(self):             # <<<<<<<<<<<<<<
@@ -1565,7 +2679,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Close(PyObject *__pyx_v_self, PyObject *
   PyObject *__pyx_t_3 = NULL;
   __Pyx_SetupRefcountContext("Close");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":331
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":494
  *         cdef PmError err
  *
  *         if not self.midi:             # <<<<<<<<<<<<<<
@@ -1575,7 +2689,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Close(PyObject *__pyx_v_self, PyObject *
   __pyx_t_1 = (!(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi != 0));
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":332
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":495
  *
  *         if not self.midi:
  *             return             # <<<<<<<<<<<<<<
@@ -1589,7 +2703,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Close(PyObject *__pyx_v_self, PyObject *
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":334
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":497
  *             return
  *
  *         err = Pm_Close(self.midi)             # <<<<<<<<<<<<<<
@@ -1598,7 +2712,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Close(PyObject *__pyx_v_self, PyObject *
  */
   __pyx_v_err = Pm_Close(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":335
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":498
  *
  *         err = Pm_Close(self.midi)
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -1608,31 +2722,31 @@ static PyObject *__pyx_pf_4pypm_6Output_Close(PyObject *__pyx_v_self, PyObject *
   __pyx_t_1 = (__pyx_v_err < 0);
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":336
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":499
  *         err = Pm_Close(self.midi)
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *         self.midi = NULL
  */
-    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 336; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 499; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
-    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 336; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 499; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_3));
     PyTuple_SET_ITEM(__pyx_t_3, 0, __pyx_t_2);
     __Pyx_GIVEREF(__pyx_t_2);
     __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 336; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 499; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_3)); __pyx_t_3 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 336; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 499; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L6;
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":338
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":501
  *             raise Exception(Pm_GetErrorText(err))
  *
  *         self.midi = NULL             # <<<<<<<<<<<<<<
@@ -1654,7 +2768,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Close(PyObject *__pyx_v_self, PyObject *
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":340
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":503
  *         self.midi = NULL
  *
  *     def Abort(self):             # <<<<<<<<<<<<<<
@@ -1672,7 +2786,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Abort(PyObject *__pyx_v_self, PyObject *
   PyObject *__pyx_t_3 = NULL;
   __Pyx_SetupRefcountContext("Abort");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":351
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":514
  *         cdef PmError err
  *
  *         if not self.midi:             # <<<<<<<<<<<<<<
@@ -1682,7 +2796,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Abort(PyObject *__pyx_v_self, PyObject *
   __pyx_t_1 = (!(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi != 0));
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":352
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":515
  *
  *         if not self.midi:
  *             return             # <<<<<<<<<<<<<<
@@ -1696,7 +2810,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Abort(PyObject *__pyx_v_self, PyObject *
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":354
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":517
  *             return
  *
  *         err = Pm_Abort(self.midi)             # <<<<<<<<<<<<<<
@@ -1705,7 +2819,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Abort(PyObject *__pyx_v_self, PyObject *
  */
   __pyx_v_err = Pm_Abort(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":355
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":518
  *
  *         err = Pm_Abort(self.midi)
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -1715,31 +2829,31 @@ static PyObject *__pyx_pf_4pypm_6Output_Abort(PyObject *__pyx_v_self, PyObject *
   __pyx_t_1 = (__pyx_v_err < 0);
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":356
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":519
  *         err = Pm_Abort(self.midi)
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *         self._aborted = 1
  */
-    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 356; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 519; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
-    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 356; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 519; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_3));
     PyTuple_SET_ITEM(__pyx_t_3, 0, __pyx_t_2);
     __Pyx_GIVEREF(__pyx_t_2);
     __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 356; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 519; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_3)); __pyx_t_3 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 356; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 519; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L6;
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":358
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":521
  *             raise Exception(Pm_GetErrorText(err))
  *
  *         self._aborted = 1             # <<<<<<<<<<<<<<
@@ -1761,7 +2875,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Abort(PyObject *__pyx_v_self, PyObject *
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":360
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":523
  *         self._aborted = 1
  *
  *     def Write(self, data):             # <<<<<<<<<<<<<<
@@ -1795,72 +2909,72 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
   __Pyx_SetupRefcountContext("Write");
   __pyx_v_event = Py_None; __Pyx_INCREF(Py_None);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":398
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":561
  *         cdef int ev_no
  *
  *         self._check_open()             # <<<<<<<<<<<<<<
  *
  *         if len(data) > 1024:
  */
-  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 398; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 561; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 398; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 561; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":400
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":563
  *         self._check_open()
  *
  *         if len(data) > 1024:             # <<<<<<<<<<<<<<
  *             raise IndexError('Maximum event list length is 1024.')
  *         else:
  */
-  __pyx_t_3 = PyObject_Length(__pyx_v_data); if (unlikely(__pyx_t_3 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 400; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = PyObject_Length(__pyx_v_data); if (unlikely(__pyx_t_3 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 563; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_t_4 = (__pyx_t_3 > 1024);
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":401
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":564
  *
  *         if len(data) > 1024:
  *             raise IndexError('Maximum event list length is 1024.')             # <<<<<<<<<<<<<<
  *         else:
  *             for ev_no, event in enumerate(data):
  */
-    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 401; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 564; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_2));
     __Pyx_INCREF(__pyx_kp_12);
     PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_kp_12);
     __Pyx_GIVEREF(__pyx_kp_12);
-    __pyx_t_1 = PyObject_Call(__pyx_builtin_IndexError, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 401; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyObject_Call(__pyx_builtin_IndexError, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 564; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_1);
     __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
     __Pyx_Raise(__pyx_t_1, 0, 0);
     __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 401; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 564; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   /*else*/ {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":403
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":566
  *             raise IndexError('Maximum event list length is 1024.')
  *         else:
  *             for ev_no, event in enumerate(data):             # <<<<<<<<<<<<<<
  *                 if not event[0]:
  *                     raise ValueError('No data in event no. %i.' % ev_no)
  */
-    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_1));
     __Pyx_INCREF(__pyx_v_data);
     PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_v_data);
     __Pyx_GIVEREF(__pyx_v_data);
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_enumerate, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_enumerate, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
     if (PyList_CheckExact(__pyx_t_2) || PyTuple_CheckExact(__pyx_t_2)) {
       __pyx_t_3 = 0; __pyx_t_1 = __pyx_t_2; __Pyx_INCREF(__pyx_t_1);
     } else {
-      __pyx_t_3 = -1; __pyx_t_1 = PyObject_GetIter(__pyx_t_2); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_3 = -1; __pyx_t_1 = PyObject_GetIter(__pyx_t_2); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_1);
     }
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
@@ -1874,7 +2988,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
       } else {
         __pyx_t_2 = PyIter_Next(__pyx_t_1);
         if (!__pyx_t_2) {
-          if (unlikely(PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+          if (unlikely(PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
           break;
         }
         __Pyx_GOTREF(__pyx_t_2);
@@ -1882,7 +2996,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
       if (PyTuple_CheckExact(__pyx_t_2) && likely(PyTuple_GET_SIZE(__pyx_t_2) == 2)) {
         PyObject* tuple = __pyx_t_2;
         __pyx_2 = PyTuple_GET_ITEM(tuple, 0); __Pyx_INCREF(__pyx_2);
-        __pyx_t_5 = __Pyx_PyInt_AsInt(__pyx_2); if (unlikely((__pyx_t_5 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_5 = __Pyx_PyInt_AsInt(__pyx_2); if (unlikely((__pyx_t_5 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_DECREF(__pyx_2); __pyx_2 = 0;
         __pyx_2 = PyTuple_GET_ITEM(tuple, 1); __Pyx_INCREF(__pyx_2);
         __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
@@ -1891,16 +3005,16 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
         __pyx_v_event = __pyx_2;
         __pyx_2 = 0;
       } else {
-        __pyx_1 = PyObject_GetIter(__pyx_t_2); if (unlikely(!__pyx_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_1 = PyObject_GetIter(__pyx_t_2); if (unlikely(!__pyx_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_1);
         __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-        __pyx_2 = __Pyx_UnpackItem(__pyx_1, 0); if (unlikely(!__pyx_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_2 = __Pyx_UnpackItem(__pyx_1, 0); if (unlikely(!__pyx_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_2);
-        __pyx_t_5 = __Pyx_PyInt_AsInt(__pyx_2); if (unlikely((__pyx_t_5 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_5 = __Pyx_PyInt_AsInt(__pyx_2); if (unlikely((__pyx_t_5 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_DECREF(__pyx_2); __pyx_2 = 0;
-        __pyx_2 = __Pyx_UnpackItem(__pyx_1, 1); if (unlikely(!__pyx_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_2 = __Pyx_UnpackItem(__pyx_1, 1); if (unlikely(!__pyx_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_2);
-        if (__Pyx_EndUnpack(__pyx_1) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        if (__Pyx_EndUnpack(__pyx_1) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_DECREF(__pyx_1); __pyx_1 = 0;
         __pyx_v_ev_no = __pyx_t_5;
         __Pyx_DECREF(__pyx_v_event);
@@ -1908,77 +3022,77 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
         __pyx_2 = 0;
       }
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":404
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":567
  *         else:
  *             for ev_no, event in enumerate(data):
  *                 if not event[0]:             # <<<<<<<<<<<<<<
  *                     raise ValueError('No data in event no. %i.' % ev_no)
  *                 if len(event[0]) > 4:
  */
-      __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 404; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 567; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_1);
-      __pyx_t_4 = __Pyx_PyObject_IsTrue(__pyx_1); if (unlikely(__pyx_t_4 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 404; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_4 = __Pyx_PyObject_IsTrue(__pyx_1); if (unlikely(__pyx_t_4 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 567; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_DECREF(__pyx_1); __pyx_1 = 0;
       __pyx_t_6 = (!__pyx_t_4);
       if (__pyx_t_6) {
 
-        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":405
+        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":568
  *             for ev_no, event in enumerate(data):
  *                 if not event[0]:
  *                     raise ValueError('No data in event no. %i.' % ev_no)             # <<<<<<<<<<<<<<
  *                 if len(event[0]) > 4:
  *                     raise ValueError('Too many data bytes (%i) in event no. %i.'
  */
-        __pyx_t_2 = PyInt_FromLong(__pyx_v_ev_no); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 405; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyInt_FromLong(__pyx_v_ev_no); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 568; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_2);
-        __pyx_t_7 = PyNumber_Remainder(__pyx_kp_13, __pyx_t_2); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 405; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_7 = PyNumber_Remainder(__pyx_kp_13, __pyx_t_2); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 568; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_7);
         __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-        __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 405; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 568; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(((PyObject *)__pyx_t_2));
         PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_t_7);
         __Pyx_GIVEREF(__pyx_t_7);
         __pyx_t_7 = 0;
-        __pyx_t_7 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 405; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_7 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 568; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_7);
         __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
         __Pyx_Raise(__pyx_t_7, 0, 0);
         __Pyx_DECREF(__pyx_t_7); __pyx_t_7 = 0;
-        {__pyx_filename = __pyx_f[0]; __pyx_lineno = 405; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        {__pyx_filename = __pyx_f[0]; __pyx_lineno = 568; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         goto __pyx_L8;
       }
       __pyx_L8:;
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":406
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":569
  *                 if not event[0]:
  *                     raise ValueError('No data in event no. %i.' % ev_no)
  *                 if len(event[0]) > 4:             # <<<<<<<<<<<<<<
  *                     raise ValueError('Too many data bytes (%i) in event no. %i.'
  *                         % (len(event[0]), ev_no))
  */
-      __pyx_2 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_2) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 406; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_2 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_2) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 569; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_2);
-      __pyx_t_8 = PyObject_Length(__pyx_2); if (unlikely(__pyx_t_8 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 406; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_8 = PyObject_Length(__pyx_2); if (unlikely(__pyx_t_8 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 569; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_DECREF(__pyx_2); __pyx_2 = 0;
       __pyx_t_6 = (__pyx_t_8 > 4);
       if (__pyx_t_6) {
 
-        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":408
+        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":571
  *                 if len(event[0]) > 4:
  *                     raise ValueError('Too many data bytes (%i) in event no. %i.'
  *                         % (len(event[0]), ev_no))             # <<<<<<<<<<<<<<
  *
  *                 buffer[ev_no].message = 0
  */
-        __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 571; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_1);
-        __pyx_t_8 = PyObject_Length(__pyx_1); if (unlikely(__pyx_t_8 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_8 = PyObject_Length(__pyx_1); if (unlikely(__pyx_t_8 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 571; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_DECREF(__pyx_1); __pyx_1 = 0;
-        __pyx_t_7 = PyInt_FromSsize_t(__pyx_t_8); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_7 = PyInt_FromSsize_t(__pyx_t_8); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 571; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_7);
-        __pyx_t_2 = PyInt_FromLong(__pyx_v_ev_no); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyInt_FromLong(__pyx_v_ev_no); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 571; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_2);
-        __pyx_t_9 = PyTuple_New(2); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_9 = PyTuple_New(2); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 571; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(((PyObject *)__pyx_t_9));
         PyTuple_SET_ITEM(__pyx_t_9, 0, __pyx_t_7);
         __Pyx_GIVEREF(__pyx_t_7);
@@ -1986,25 +3100,25 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
         __Pyx_GIVEREF(__pyx_t_2);
         __pyx_t_7 = 0;
         __pyx_t_2 = 0;
-        __pyx_t_2 = PyNumber_Remainder(__pyx_kp_14, ((PyObject *)__pyx_t_9)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 408; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyNumber_Remainder(__pyx_kp_14, ((PyObject *)__pyx_t_9)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 571; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_2);
         __Pyx_DECREF(((PyObject *)__pyx_t_9)); __pyx_t_9 = 0;
-        __pyx_t_9 = PyTuple_New(1); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 407; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_9 = PyTuple_New(1); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 570; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(((PyObject *)__pyx_t_9));
         PyTuple_SET_ITEM(__pyx_t_9, 0, __pyx_t_2);
         __Pyx_GIVEREF(__pyx_t_2);
         __pyx_t_2 = 0;
-        __pyx_t_2 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_9), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 407; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_9), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 570; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_2);
         __Pyx_DECREF(((PyObject *)__pyx_t_9)); __pyx_t_9 = 0;
         __Pyx_Raise(__pyx_t_2, 0, 0);
         __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-        {__pyx_filename = __pyx_f[0]; __pyx_lineno = 407; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        {__pyx_filename = __pyx_f[0]; __pyx_lineno = 570; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         goto __pyx_L9;
       }
       __pyx_L9:;
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":410
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":573
  *                         % (len(event[0]), ev_no))
  *
  *                 buffer[ev_no].message = 0             # <<<<<<<<<<<<<<
@@ -2013,45 +3127,45 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
  */
       (__pyx_v_buffer[__pyx_v_ev_no]).message = 0;
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":412
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":575
  *                 buffer[ev_no].message = 0
  *
  *                 for item in range(len(event[0])):             # <<<<<<<<<<<<<<
  *                     buffer[ev_no].message += (
  *                         (event[0][item] & 0xFF) << (8 * item))
  */
-      __pyx_2 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_2) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 412; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_2 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_2) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 575; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_2);
-      __pyx_t_8 = PyObject_Length(__pyx_2); if (unlikely(__pyx_t_8 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 412; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_8 = PyObject_Length(__pyx_2); if (unlikely(__pyx_t_8 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 575; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_DECREF(__pyx_2); __pyx_2 = 0;
       for (__pyx_t_5 = 0; __pyx_t_5 < __pyx_t_8; __pyx_t_5+=1) {
         __pyx_v_item = __pyx_t_5;
 
-        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":414
+        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":577
  *                 for item in range(len(event[0])):
  *                     buffer[ev_no].message += (
  *                         (event[0][item] & 0xFF) << (8 * item))             # <<<<<<<<<<<<<<
  *
  *                 buffer[ev_no].timestamp = event[1]
  */
-        __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 414; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 0, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 577; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_1);
-        __pyx_2 = __Pyx_GetItemInt(__pyx_1, __pyx_v_item, sizeof(int), PyInt_FromLong); if (!__pyx_2) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 414; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_2 = __Pyx_GetItemInt(__pyx_1, __pyx_v_item, sizeof(int), PyInt_FromLong); if (!__pyx_2) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 577; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_2);
         __Pyx_DECREF(__pyx_1); __pyx_1 = 0;
-        __pyx_t_2 = PyNumber_And(__pyx_2, __pyx_int_0xFF); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 414; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyNumber_And(__pyx_2, __pyx_int_0xFF); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 577; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_2);
         __Pyx_DECREF(__pyx_2); __pyx_2 = 0;
-        __pyx_t_9 = PyInt_FromLong((8 * __pyx_v_item)); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 414; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_9 = PyInt_FromLong((8 * __pyx_v_item)); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 577; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_9);
-        __pyx_t_7 = PyNumber_Lshift(__pyx_t_2, __pyx_t_9); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 414; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_7 = PyNumber_Lshift(__pyx_t_2, __pyx_t_9); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 577; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_7);
         __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
         __Pyx_DECREF(__pyx_t_9); __pyx_t_9 = 0;
-        __pyx_t_10 = __Pyx_PyInt_AsLong(__pyx_t_7); if (unlikely((__pyx_t_10 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 414; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_10 = __Pyx_PyInt_AsLong(__pyx_t_7); if (unlikely((__pyx_t_10 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 577; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_DECREF(__pyx_t_7); __pyx_t_7 = 0;
 
-        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":413
+        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":576
  *
  *                 for item in range(len(event[0])):
  *                     buffer[ev_no].message += (             # <<<<<<<<<<<<<<
@@ -2061,20 +3175,20 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
         (__pyx_v_buffer[__pyx_v_ev_no]).message += __pyx_t_10;
       }
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":416
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":579
  *                         (event[0][item] & 0xFF) << (8 * item))
  *
  *                 buffer[ev_no].timestamp = event[1]             # <<<<<<<<<<<<<<
  *
  *                 if self.debug:
  */
-      __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 1, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 416; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_1 = __Pyx_GetItemInt(__pyx_v_event, 1, sizeof(long), PyInt_FromLong); if (!__pyx_1) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 579; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_1);
-      __pyx_t_11 = __Pyx_PyInt_AsLong(__pyx_1); if (unlikely((__pyx_t_11 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 416; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_11 = __Pyx_PyInt_AsLong(__pyx_1); if (unlikely((__pyx_t_11 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 579; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_DECREF(__pyx_1); __pyx_1 = 0;
       (__pyx_v_buffer[__pyx_v_ev_no]).timestamp = __pyx_t_11;
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":418
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":581
  *                 buffer[ev_no].timestamp = event[1]
  *
  *                 if self.debug:             # <<<<<<<<<<<<<<
@@ -2084,20 +3198,20 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
       __pyx_t_5 = ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->debug;
       if (__pyx_t_5) {
 
-        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":420
+        /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":583
  *                 if self.debug:
  *                     print "%i : %r : %s" % (
  *                         ev_no, buffer[ev_no].message, buffer[ev_no].timestamp)             # <<<<<<<<<<<<<<
  *
  *         if self.debug:
  */
-        __pyx_t_7 = PyInt_FromLong(__pyx_v_ev_no); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 420; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_7 = PyInt_FromLong(__pyx_v_ev_no); if (unlikely(!__pyx_t_7)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 583; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_7);
-        __pyx_t_9 = PyInt_FromLong((__pyx_v_buffer[__pyx_v_ev_no]).message); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 420; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_9 = PyInt_FromLong((__pyx_v_buffer[__pyx_v_ev_no]).message); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 583; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_9);
-        __pyx_t_2 = PyInt_FromLong((__pyx_v_buffer[__pyx_v_ev_no]).timestamp); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 420; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyInt_FromLong((__pyx_v_buffer[__pyx_v_ev_no]).timestamp); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 583; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_2);
-        __pyx_t_12 = PyTuple_New(3); if (unlikely(!__pyx_t_12)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 420; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_12 = PyTuple_New(3); if (unlikely(!__pyx_t_12)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 583; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(((PyObject *)__pyx_t_12));
         PyTuple_SET_ITEM(__pyx_t_12, 0, __pyx_t_7);
         __Pyx_GIVEREF(__pyx_t_7);
@@ -2108,10 +3222,10 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
         __pyx_t_7 = 0;
         __pyx_t_9 = 0;
         __pyx_t_2 = 0;
-        __pyx_t_2 = PyNumber_Remainder(__pyx_kp_15, ((PyObject *)__pyx_t_12)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 419; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        __pyx_t_2 = PyNumber_Remainder(__pyx_kp_15, ((PyObject *)__pyx_t_12)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 582; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_GOTREF(__pyx_t_2);
         __Pyx_DECREF(((PyObject *)__pyx_t_12)); __pyx_t_12 = 0;
-        if (__Pyx_PrintOne(__pyx_t_2) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 419; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+        if (__Pyx_PrintOne(__pyx_t_2) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 582; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
         __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
         goto __pyx_L12;
       }
@@ -2121,7 +3235,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":422
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":585
  *                         ev_no, buffer[ev_no].message, buffer[ev_no].timestamp)
  *
  *         if self.debug:             # <<<<<<<<<<<<<<
@@ -2131,29 +3245,29 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
   __pyx_t_5 = ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->debug;
   if (__pyx_t_5) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":423
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":586
  *
  *         if self.debug:
  *             print "Writing to midi buffer."             # <<<<<<<<<<<<<<
  *         err = Pm_Write(self.midi, buffer, len(data))
  *         if err < 0:
  */
-    if (__Pyx_PrintOne(__pyx_kp_16) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 423; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    if (__Pyx_PrintOne(__pyx_kp_16) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 586; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L13;
   }
   __pyx_L13:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":424
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":587
  *         if self.debug:
  *             print "Writing to midi buffer."
  *         err = Pm_Write(self.midi, buffer, len(data))             # <<<<<<<<<<<<<<
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))
  */
-  __pyx_t_3 = PyObject_Length(__pyx_v_data); if (unlikely(__pyx_t_3 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 424; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = PyObject_Length(__pyx_v_data); if (unlikely(__pyx_t_3 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 587; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_err = Pm_Write(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi, __pyx_v_buffer, __pyx_t_3);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":425
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":588
  *             print "Writing to midi buffer."
  *         err = Pm_Write(self.midi, buffer, len(data))
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -2163,26 +3277,26 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
   __pyx_t_6 = (__pyx_v_err < 0);
   if (__pyx_t_6) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":426
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":589
  *         err = Pm_Write(self.midi, buffer, len(data))
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *     def WriteShort(self, status, data1=0, data2=0):
  */
-    __pyx_t_1 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 426; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 589; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_1);
-    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 426; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 589; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_2));
     PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_t_1);
     __Pyx_GIVEREF(__pyx_t_1);
     __pyx_t_1 = 0;
-    __pyx_t_1 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 426; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 589; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_1);
     __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
     __Pyx_Raise(__pyx_t_1, 0, 0);
     __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 426; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 589; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L14;
   }
   __pyx_L14:;
@@ -2206,7 +3320,7 @@ static PyObject *__pyx_pf_4pypm_6Output_Write(PyObject *__pyx_v_self, PyObject *
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":428
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":591
  *             raise Exception(Pm_GetErrorText(err))
  *
  *     def WriteShort(self, status, data1=0, data2=0):             # <<<<<<<<<<<<<<
@@ -2260,7 +3374,7 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteShort(PyObject *__pyx_v_self, PyObj
       }
     }
     if (unlikely(kw_args > 0)) {
-      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "WriteShort") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 428; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "WriteShort") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 591; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
     }
     __pyx_v_status = values[0];
     __pyx_v_data1 = values[1];
@@ -2278,27 +3392,27 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteShort(PyObject *__pyx_v_self, PyObj
   }
   goto __pyx_L4_argument_unpacking_done;
   __pyx_L5_argtuple_error:;
-  __Pyx_RaiseArgtupleInvalid("WriteShort", 0, 1, 3, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 428; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+  __Pyx_RaiseArgtupleInvalid("WriteShort", 0, 1, 3, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 591; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
   __pyx_L3_error:;
   __Pyx_AddTraceback("pypm.Output.WriteShort");
   return NULL;
   __pyx_L4_argument_unpacking_done:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":456
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":619
  *         cdef PmError err
  *
  *         self._check_open()             # <<<<<<<<<<<<<<
  *
  *         buffer[0].timestamp = Pt_Time()
  */
-  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 456; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 619; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 456; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 619; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":458
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":621
  *         self._check_open()
  *
  *         buffer[0].timestamp = Pt_Time()             # <<<<<<<<<<<<<<
@@ -2307,45 +3421,45 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteShort(PyObject *__pyx_v_self, PyObj
  */
   (__pyx_v_buffer[0]).timestamp = Pt_Time();
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":459
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":622
  *
  *         buffer[0].timestamp = Pt_Time()
  *         buffer[0].message = (((data2 << 16) & 0xFF0000) |             # <<<<<<<<<<<<<<
  *             ((data1 << 8) & 0xFF00) | (status & 0xFF))
  *
  */
-  __pyx_t_2 = PyNumber_Lshift(__pyx_v_data2, __pyx_int_16); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 459; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyNumber_Lshift(__pyx_v_data2, __pyx_int_16); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 622; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
-  __pyx_t_1 = PyNumber_And(__pyx_t_2, __pyx_int_0xFF0000); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 459; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyNumber_And(__pyx_t_2, __pyx_int_0xFF0000); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 622; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":460
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":623
  *         buffer[0].timestamp = Pt_Time()
  *         buffer[0].message = (((data2 << 16) & 0xFF0000) |
  *             ((data1 << 8) & 0xFF00) | (status & 0xFF))             # <<<<<<<<<<<<<<
  *
  *         if self.debug:
  */
-  __pyx_t_2 = PyNumber_Lshift(__pyx_v_data1, __pyx_int_8); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 460; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyNumber_Lshift(__pyx_v_data1, __pyx_int_8); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 623; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
-  __pyx_t_3 = PyNumber_And(__pyx_t_2, __pyx_int_0xFF00); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 460; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = PyNumber_And(__pyx_t_2, __pyx_int_0xFF00); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 623; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_3);
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-  __pyx_t_2 = PyNumber_Or(__pyx_t_1, __pyx_t_3); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 459; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyNumber_Or(__pyx_t_1, __pyx_t_3); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 622; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
-  __pyx_t_3 = PyNumber_And(__pyx_v_status, __pyx_int_0xFF); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 460; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = PyNumber_And(__pyx_v_status, __pyx_int_0xFF); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 623; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_3);
-  __pyx_t_1 = PyNumber_Or(__pyx_t_2, __pyx_t_3); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 460; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyNumber_Or(__pyx_t_2, __pyx_t_3); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 623; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
   __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
-  __pyx_t_4 = __Pyx_PyInt_AsLong(__pyx_t_1); if (unlikely((__pyx_t_4 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 460; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_4 = __Pyx_PyInt_AsLong(__pyx_t_1); if (unlikely((__pyx_t_4 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 623; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":459
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":622
  *
  *         buffer[0].timestamp = Pt_Time()
  *         buffer[0].message = (((data2 << 16) & 0xFF0000) |             # <<<<<<<<<<<<<<
@@ -2354,7 +3468,7 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteShort(PyObject *__pyx_v_self, PyObj
  */
   (__pyx_v_buffer[0]).message = __pyx_t_4;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":462
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":625
  *             ((data1 << 8) & 0xFF00) | (status & 0xFF))
  *
  *         if self.debug:             # <<<<<<<<<<<<<<
@@ -2364,68 +3478,299 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteShort(PyObject *__pyx_v_self, PyObj
   __pyx_t_5 = ((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->debug;
   if (__pyx_t_5) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":463
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":626
  *
  *         if self.debug:
  *             print "Writing to MIDI buffer."             # <<<<<<<<<<<<<<
  *         err = Pm_Write(self.midi, buffer, 1) # stream, buffer, length
  *         if err < 0:
  */
-    if (__Pyx_PrintOne(__pyx_kp_17) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 463; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    if (__Pyx_PrintOne(__pyx_kp_17) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 626; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L6;
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":464
- *         if self.debug:
- *             print "Writing to MIDI buffer."
- *         err = Pm_Write(self.midi, buffer, 1) # stream, buffer, length             # <<<<<<<<<<<<<<
- *         if err < 0:
- *             raise Exception(Pm_GetErrorText(err))
- */
-  __pyx_v_err = Pm_Write(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi, __pyx_v_buffer, 1);
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":627
+ *         if self.debug:
+ *             print "Writing to MIDI buffer."
+ *         err = Pm_Write(self.midi, buffer, 1) # stream, buffer, length             # <<<<<<<<<<<<<<
+ *         if err < 0:
+ *             raise Exception(Pm_GetErrorText(err))
+ */
+  __pyx_v_err = Pm_Write(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi, __pyx_v_buffer, 1);
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":628
+ *             print "Writing to MIDI buffer."
+ *         err = Pm_Write(self.midi, buffer, 1) # stream, buffer, length
+ *         if err < 0:             # <<<<<<<<<<<<<<
+ *             raise Exception(Pm_GetErrorText(err))
+ *
+ */
+  __pyx_t_6 = (__pyx_v_err < 0);
+  if (__pyx_t_6) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":629
+ *         err = Pm_Write(self.midi, buffer, 1) # stream, buffer, length
+ *         if err < 0:
+ *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
+ *
+ *     def WriteBuffer(self, data):
+ */
+    __pyx_t_1 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 629; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_1);
+    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 629; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(((PyObject *)__pyx_t_3));
+    PyTuple_SET_ITEM(__pyx_t_3, 0, __pyx_t_1);
+    __Pyx_GIVEREF(__pyx_t_1);
+    __pyx_t_1 = 0;
+    __pyx_t_1 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 629; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_1);
+    __Pyx_DECREF(((PyObject *)__pyx_t_3)); __pyx_t_3 = 0;
+    __Pyx_Raise(__pyx_t_1, 0, 0);
+    __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 629; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    goto __pyx_L7;
+  }
+  __pyx_L7:;
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_1);
+  __Pyx_XDECREF(__pyx_t_2);
+  __Pyx_XDECREF(__pyx_t_3);
+  __Pyx_AddTraceback("pypm.Output.WriteShort");
+  __pyx_r = NULL;
+  __pyx_L0:;
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":631
+ *             raise Exception(Pm_GetErrorText(err))
+ *
+ *     def WriteBuffer(self, data):             # <<<<<<<<<<<<<<
+ *         """Output the MIDI events packed in a buffer object on this device.
+ *
+ */
+
+static PyObject *__pyx_pf_4pypm_6Output_WriteBuffer(PyObject *__pyx_v_self, PyObject *__pyx_v_data); /*proto*/
+static char __pyx_doc_4pypm_6Output_WriteBuffer[] = "Output the MIDI events packed in a buffer object on this device.\n\n        Usage::\n\n            WriteBuffer(data)\n\n        data is an object with the buffer interface, such as a bytearray,\n        array or string, holding events as RECORD_FORMAT structs: the\n        message as an unsigned 32 bit integer, status in the low byte,\n        and the timestamp as a 32 bit integer. Any bytes after the last\n        whole event are ignored. There is no limit on the number of events.\n        Returns the number of events written.\n\n        ";
+static PyObject *__pyx_pf_4pypm_6Output_WriteBuffer(PyObject *__pyx_v_self, PyObject *__pyx_v_data) {
+  void *__pyx_v_buf;
+  Py_ssize_t __pyx_v_size;
+  struct __pyx_t_4pypm_MidiRecord *__pyx_v_records;
+  PmEvent __pyx_v_buffer[1024];
+  PmError __pyx_v_err;
+  int __pyx_v_count;
+  int __pyx_v_done;
+  int __pyx_v_num;
+  int __pyx_v_ev_no;
+  PyObject *__pyx_r = NULL;
+  PyObject *__pyx_t_1 = NULL;
+  PyObject *__pyx_t_2 = NULL;
+  int __pyx_t_3;
+  int __pyx_t_4;
+  int __pyx_t_5;
+  int __pyx_t_6;
+  __Pyx_SetupRefcountContext("WriteBuffer");
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":656
+   *         cdef int ev_no
+   *
+   *         self._check_open()             # <<<<<<<<<<<<<<
+   *
+   *         PyObject_AsReadBuffer(data, &buf, &size)
+   */
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 656; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_1);
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 656; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_2);
+  __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
+  __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":658
+   *         self._check_open()
+   *
+   *         PyObject_AsReadBuffer(data, &buf, &size)             # <<<<<<<<<<<<<<
+   *         records = <MidiRecord *> buf
+   *         count = size / sizeof(MidiRecord)
+   */
+  __pyx_t_3 = PyObject_AsReadBuffer(__pyx_v_data, (&__pyx_v_buf), (&__pyx_v_size)); if (unlikely(__pyx_t_3 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 658; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":659
+   *
+   *         PyObject_AsReadBuffer(data, &buf, &size)
+   *         records = <MidiRecord *> buf             # <<<<<<<<<<<<<<
+   *         count = size / sizeof(MidiRecord)
+   *         done = 0
+   */
+  __pyx_v_records = ((struct __pyx_t_4pypm_MidiRecord *)__pyx_v_buf);
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":660
+   *         PyObject_AsReadBuffer(data, &buf, &size)
+   *         records = <MidiRecord *> buf
+   *         count = size / sizeof(MidiRecord)             # <<<<<<<<<<<<<<
+   *         done = 0
+   *         while done < count:
+   */
+  __pyx_v_count = (__pyx_v_size / (sizeof(struct __pyx_t_4pypm_MidiRecord)));
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":661
+   *         records = <MidiRecord *> buf
+   *         count = size / sizeof(MidiRecord)
+   *         done = 0             # <<<<<<<<<<<<<<
+   *         while done < count:
+   *             num = count - done
+   */
+  __pyx_v_done = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":662
+   *         count = size / sizeof(MidiRecord)
+   *         done = 0
+   *         while done < count:             # <<<<<<<<<<<<<<
+   *             num = count - done
+   *             if num > 1024:
+   */
+  while (1) {
+    __pyx_t_4 = (__pyx_v_done < __pyx_v_count);
+    if (!__pyx_t_4) break;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":663
+     *         done = 0
+     *         while done < count:
+     *             num = count - done             # <<<<<<<<<<<<<<
+     *             if num > 1024:
+     *                 num = 1024
+     */
+    __pyx_v_num = (__pyx_v_count - __pyx_v_done);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":664
+     *         while done < count:
+     *             num = count - done
+     *             if num > 1024:             # <<<<<<<<<<<<<<
+     *                 num = 1024
+     *             for ev_no in range(num):
+     */
+    __pyx_t_4 = (__pyx_v_num > 1024);
+    if (__pyx_t_4) {
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":465
- *             print "Writing to MIDI buffer."
- *         err = Pm_Write(self.midi, buffer, 1) # stream, buffer, length
- *         if err < 0:             # <<<<<<<<<<<<<<
- *             raise Exception(Pm_GetErrorText(err))
- *
- */
-  __pyx_t_6 = (__pyx_v_err < 0);
-  if (__pyx_t_6) {
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":665
+       *             num = count - done
+       *             if num > 1024:
+       *                 num = 1024             # <<<<<<<<<<<<<<
+       *             for ev_no in range(num):
+       *                 buffer[ev_no].message = records[done + ev_no].message
+       */
+      __pyx_v_num = 1024;
+      goto __pyx_L7;
+    }
+    __pyx_L7:;
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":466
- *         err = Pm_Write(self.midi, buffer, 1) # stream, buffer, length
- *         if err < 0:
- *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
- *
- *     def WriteSysEx(self, when, msg):
- */
-    __pyx_t_1 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 466; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-    __Pyx_GOTREF(__pyx_t_1);
-    __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 466; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-    __Pyx_GOTREF(((PyObject *)__pyx_t_3));
-    PyTuple_SET_ITEM(__pyx_t_3, 0, __pyx_t_1);
-    __Pyx_GIVEREF(__pyx_t_1);
-    __pyx_t_1 = 0;
-    __pyx_t_1 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 466; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-    __Pyx_GOTREF(__pyx_t_1);
-    __Pyx_DECREF(((PyObject *)__pyx_t_3)); __pyx_t_3 = 0;
-    __Pyx_Raise(__pyx_t_1, 0, 0);
-    __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 466; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-    goto __pyx_L7;
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":666
+     *             if num > 1024:
+     *                 num = 1024
+     *             for ev_no in range(num):             # <<<<<<<<<<<<<<
+     *                 buffer[ev_no].message = records[done + ev_no].message
+     *                 buffer[ev_no].timestamp = records[done + ev_no].timestamp
+     */
+    __pyx_t_5 = __pyx_v_num;
+    for (__pyx_t_6 = 0; __pyx_t_6 < __pyx_t_5; __pyx_t_6+=1) {
+      __pyx_v_ev_no = __pyx_t_6;
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":667
+       *                 num = 1024
+       *             for ev_no in range(num):
+       *                 buffer[ev_no].message = records[done + ev_no].message             # <<<<<<<<<<<<<<
+       *                 buffer[ev_no].timestamp = records[done + ev_no].timestamp
+       *             err = Pm_Write(self.midi, buffer, num)
+       */
+      (__pyx_v_buffer[__pyx_v_ev_no]).message = (__pyx_v_records[(__pyx_v_done + __pyx_v_ev_no)]).message;
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":668
+       *             for ev_no in range(num):
+       *                 buffer[ev_no].message = records[done + ev_no].message
+       *                 buffer[ev_no].timestamp = records[done + ev_no].timestamp             # <<<<<<<<<<<<<<
+       *             err = Pm_Write(self.midi, buffer, num)
+       *             if err < 0:
+       */
+      (__pyx_v_buffer[__pyx_v_ev_no]).timestamp = (__pyx_v_records[(__pyx_v_done + __pyx_v_ev_no)]).timestamp;
+    }
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":669
+     *                 buffer[ev_no].message = records[done + ev_no].message
+     *                 buffer[ev_no].timestamp = records[done + ev_no].timestamp
+     *             err = Pm_Write(self.midi, buffer, num)             # <<<<<<<<<<<<<<
+     *             if err < 0:
+     *                 raise Exception(Pm_GetErrorText(err))
+     */
+    __pyx_v_err = Pm_Write(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi, __pyx_v_buffer, __pyx_v_num);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":670
+     *                 buffer[ev_no].timestamp = records[done + ev_no].timestamp
+     *             err = Pm_Write(self.midi, buffer, num)
+     *             if err < 0:             # <<<<<<<<<<<<<<
+     *                 raise Exception(Pm_GetErrorText(err))
+     *             done = done + num
+     */
+    __pyx_t_4 = (__pyx_v_err < 0);
+    if (__pyx_t_4) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":671
+       *             err = Pm_Write(self.midi, buffer, num)
+       *             if err < 0:
+       *                 raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
+       *             done = done + num
+       *
+       */
+      __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 671; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(__pyx_t_2);
+      __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 671; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(((PyObject *)__pyx_t_1));
+      PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
+      __Pyx_GIVEREF(__pyx_t_2);
+      __pyx_t_2 = 0;
+      __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 671; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(__pyx_t_2);
+      __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
+      __Pyx_Raise(__pyx_t_2, 0, 0);
+      __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 671; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      goto __pyx_L10;
+    }
+    __pyx_L10:;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":672
+     *             if err < 0:
+     *                 raise Exception(Pm_GetErrorText(err))
+     *             done = done + num             # <<<<<<<<<<<<<<
+     *
+     *         return count
+     */
+    __pyx_v_done = (__pyx_v_done + __pyx_v_num);
   }
-  __pyx_L7:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":674
+   *             done = done + num
+   *
+   *         return count             # <<<<<<<<<<<<<<
+   *
+   *     def WriteSysEx(self, when, msg):
+   */
+  __Pyx_XDECREF(__pyx_r);
+  __pyx_t_2 = PyInt_FromLong(__pyx_v_count); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 674; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_2);
+  __pyx_r = __pyx_t_2;
+  __pyx_t_2 = 0;
+  goto __pyx_L0;
 
   __pyx_r = Py_None; __Pyx_INCREF(Py_None);
   goto __pyx_L0;
   __pyx_L1_error:;
   __Pyx_XDECREF(__pyx_t_1);
   __Pyx_XDECREF(__pyx_t_2);
-  __Pyx_XDECREF(__pyx_t_3);
-  __Pyx_AddTraceback("pypm.Output.WriteShort");
+  __Pyx_AddTraceback("pypm.Output.WriteBuffer");
   __pyx_r = NULL;
   __pyx_L0:;
   __Pyx_XGIVEREF(__pyx_r);
@@ -2433,8 +3778,8 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteShort(PyObject *__pyx_v_self, PyObj
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":468
- *             raise Exception(Pm_GetErrorText(err))
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":676
+ *         return count
  *
  *     def WriteSysEx(self, when, msg):             # <<<<<<<<<<<<<<
  *         """Output a timestamped system-exclusive MIDI message on this device.
@@ -2477,11 +3822,11 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteSysEx(PyObject *__pyx_v_self, PyObj
       values[1] = PyDict_GetItem(__pyx_kwds, __pyx_kp_msg);
       if (likely(values[1])) kw_args--;
       else {
-        __Pyx_RaiseArgtupleInvalid("WriteSysEx", 1, 2, 2, 1); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 468; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+        __Pyx_RaiseArgtupleInvalid("WriteSysEx", 1, 2, 2, 1); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 676; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
       }
     }
     if (unlikely(kw_args > 0)) {
-      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "WriteSysEx") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 468; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "WriteSysEx") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 676; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
     }
     __pyx_v_when = values[0];
     __pyx_v_msg = values[1];
@@ -2493,59 +3838,59 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteSysEx(PyObject *__pyx_v_self, PyObj
   }
   goto __pyx_L4_argument_unpacking_done;
   __pyx_L5_argtuple_error:;
-  __Pyx_RaiseArgtupleInvalid("WriteSysEx", 1, 2, 2, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 468; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+  __Pyx_RaiseArgtupleInvalid("WriteSysEx", 1, 2, 2, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 676; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
   __pyx_L3_error:;
   __Pyx_AddTraceback("pypm.Output.WriteSysEx");
   return NULL;
   __pyx_L4_argument_unpacking_done:;
   __Pyx_INCREF(__pyx_v_msg);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":491
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":699
  *         cdef PtTimestamp cur_time
  *
  *         self._check_open()             # <<<<<<<<<<<<<<
  *
  *         if type(msg) is list:
  */
-  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 491; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 699; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 491; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 699; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":493
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":701
  *         self._check_open()
  *
  *         if type(msg) is list:             # <<<<<<<<<<<<<<
  *              # Markus Pfaff contribution
  *             msg = array.array('B', msg).tostring()
  */
-  __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 493; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 701; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(((PyObject *)__pyx_t_2));
   __Pyx_INCREF(__pyx_v_msg);
   PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_v_msg);
   __Pyx_GIVEREF(__pyx_v_msg);
-  __pyx_t_1 = PyObject_Call(((PyObject *)((PyObject*)&PyType_Type)), ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 493; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_Call(((PyObject *)((PyObject*)&PyType_Type)), ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 701; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
   __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
   __pyx_t_3 = (__pyx_t_1 == ((PyObject *)((PyObject*)&PyList_Type)));
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   if (__pyx_t_3) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":495
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":703
  *         if type(msg) is list:
  *              # Markus Pfaff contribution
  *             msg = array.array('B', msg).tostring()             # <<<<<<<<<<<<<<
  *         cmsg = msg
  *
  */
-    __pyx_1 = __Pyx_GetName(__pyx_m, __pyx_kp_array); if (unlikely(!__pyx_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 495; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_1 = __Pyx_GetName(__pyx_m, __pyx_kp_array); if (unlikely(!__pyx_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 703; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_1);
-    __pyx_t_1 = PyObject_GetAttr(__pyx_1, __pyx_kp_array); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 495; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyObject_GetAttr(__pyx_1, __pyx_kp_array); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 703; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_1);
     __Pyx_DECREF(__pyx_1); __pyx_1 = 0;
-    __pyx_t_2 = PyTuple_New(2); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 495; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyTuple_New(2); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 703; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_2));
     __Pyx_INCREF(__pyx_kp_18);
     PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_kp_18);
@@ -2553,14 +3898,14 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteSysEx(PyObject *__pyx_v_self, PyObj
     __Pyx_INCREF(__pyx_v_msg);
     PyTuple_SET_ITEM(__pyx_t_2, 1, __pyx_v_msg);
     __Pyx_GIVEREF(__pyx_v_msg);
-    __pyx_t_4 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 495; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_4 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 703; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_4);
     __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
     __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_GetAttr(__pyx_t_4, __pyx_kp_tostring); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 495; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_GetAttr(__pyx_t_4, __pyx_kp_tostring); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 703; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(__pyx_t_4); __pyx_t_4 = 0;
-    __pyx_t_4 = PyObject_Call(__pyx_t_2, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 495; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_4 = PyObject_Call(__pyx_t_2, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 703; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_4);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
     __Pyx_DECREF(__pyx_v_msg);
@@ -2570,17 +3915,17 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteSysEx(PyObject *__pyx_v_self, PyObj
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":496
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":704
  *              # Markus Pfaff contribution
  *             msg = array.array('B', msg).tostring()
  *         cmsg = msg             # <<<<<<<<<<<<<<
  *
  *         cur_time = Pt_Time()
  */
-  __pyx_t_5 = __Pyx_PyBytes_AsString(__pyx_v_msg); if (unlikely((!__pyx_t_5) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 496; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_5 = __Pyx_PyBytes_AsString(__pyx_v_msg); if (unlikely((!__pyx_t_5) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 704; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_cmsg = __pyx_t_5;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":498
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":706
  *         cmsg = msg
  *
  *         cur_time = Pt_Time()             # <<<<<<<<<<<<<<
@@ -2589,17 +3934,17 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteSysEx(PyObject *__pyx_v_self, PyObj
  */
   __pyx_v_cur_time = Pt_Time();
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":499
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":707
  *
  *         cur_time = Pt_Time()
  *         err = Pm_WriteSysEx(self.midi, when, <unsigned char *> cmsg)             # <<<<<<<<<<<<<<
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))
  */
-  __pyx_t_6 = __Pyx_PyInt_AsLong(__pyx_v_when); if (unlikely((__pyx_t_6 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 499; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_6 = __Pyx_PyInt_AsLong(__pyx_v_when); if (unlikely((__pyx_t_6 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 707; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_err = Pm_WriteSysEx(((struct __pyx_obj_4pypm_Output *)__pyx_v_self)->midi, __pyx_t_6, ((unsigned char *)__pyx_v_cmsg));
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":500
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":708
  *         cur_time = Pt_Time()
  *         err = Pm_WriteSysEx(self.midi, when, <unsigned char *> cmsg)
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -2609,31 +3954,31 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteSysEx(PyObject *__pyx_v_self, PyObj
   __pyx_t_3 = (__pyx_v_err < 0);
   if (__pyx_t_3) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":501
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":709
  *         err = Pm_WriteSysEx(self.midi, when, <unsigned char *> cmsg)
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *         # wait for SysEx to go thru or...
  */
-    __pyx_t_4 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 501; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_4 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 709; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_4);
-    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 501; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 709; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_2));
     PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_t_4);
     __Pyx_GIVEREF(__pyx_t_4);
     __pyx_t_4 = 0;
-    __pyx_t_4 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 501; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_4 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 709; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_4);
     __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
     __Pyx_Raise(__pyx_t_4, 0, 0);
     __Pyx_DECREF(__pyx_t_4); __pyx_t_4 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 501; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 709; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L7;
   }
   __pyx_L7:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":505
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":713
  *         # wait for SysEx to go thru or...
  *         # my win32 machine crashes w/ multiple SysEx
  *         while Pt_Time() == cur_time:             # <<<<<<<<<<<<<<
@@ -2661,7 +4006,7 @@ static PyObject *__pyx_pf_4pypm_6Output_WriteSysEx(PyObject *__pyx_v_self, PyObj
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":521
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":729
  *     cdef int debug
  *
  *     def __init__(self, input_device, buffersize=4096):             # <<<<<<<<<<<<<<
@@ -2706,7 +4051,7 @@ static int __pyx_pf_4pypm_5Input___init__(PyObject *__pyx_v_self, PyObject *__py
       }
     }
     if (unlikely(kw_args > 0)) {
-      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "__init__") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 521; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+      if (unlikely(__Pyx_ParseOptionalKeywords(__pyx_kwds, __pyx_pyargnames, 0, values, PyTuple_GET_SIZE(__pyx_args), "__init__") < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 729; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
     }
     __pyx_v_input_device = values[0];
     __pyx_v_buffersize = values[1];
@@ -2721,23 +4066,23 @@ static int __pyx_pf_4pypm_5Input___init__(PyObject *__pyx_v_self, PyObject *__py
   }
   goto __pyx_L4_argument_unpacking_done;
   __pyx_L5_argtuple_error:;
-  __Pyx_RaiseArgtupleInvalid("__init__", 0, 1, 2, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 521; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
+  __Pyx_RaiseArgtupleInvalid("__init__", 0, 1, 2, PyTuple_GET_SIZE(__pyx_args)); {__pyx_filename = __pyx_f[0]; __pyx_lineno = 729; __pyx_clineno = __LINE__; goto __pyx_L3_error;}
   __pyx_L3_error:;
   __Pyx_AddTraceback("pypm.Input.__init__");
   return -1;
   __pyx_L4_argument_unpacking_done:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":525
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":733
  *
  *         cdef PmError err
  *         self.device = input_device             # <<<<<<<<<<<<<<
  *         self.debug = 0
  *
  */
-  __pyx_t_1 = __Pyx_PyInt_AsInt(__pyx_v_input_device); if (unlikely((__pyx_t_1 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 525; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = __Pyx_PyInt_AsInt(__pyx_v_input_device); if (unlikely((__pyx_t_1 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 733; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   ((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->device = __pyx_t_1;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":526
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":734
  *         cdef PmError err
  *         self.device = input_device
  *         self.debug = 0             # <<<<<<<<<<<<<<
@@ -2746,17 +4091,17 @@ static int __pyx_pf_4pypm_5Input___init__(PyObject *__pyx_v_self, PyObject *__py
  */
   ((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->debug = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":528
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":736
  *         self.debug = 0
  *
  *         err = Pm_OpenInput(&(self.midi), input_device, NULL, buffersize,             # <<<<<<<<<<<<<<
  *                            &Pt_Time, NULL)
  *         if err < 0:
  */
-  __pyx_t_2 = __Pyx_PyInt_AsInt(__pyx_v_input_device); if (unlikely((__pyx_t_2 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 528; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  __pyx_t_3 = __Pyx_PyInt_AsLong(__pyx_v_buffersize); if (unlikely((__pyx_t_3 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 528; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = __Pyx_PyInt_AsInt(__pyx_v_input_device); if (unlikely((__pyx_t_2 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 736; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = __Pyx_PyInt_AsLong(__pyx_v_buffersize); if (unlikely((__pyx_t_3 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 736; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":529
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":737
  *
  *         err = Pm_OpenInput(&(self.midi), input_device, NULL, buffersize,
  *                            &Pt_Time, NULL)             # <<<<<<<<<<<<<<
@@ -2765,7 +4110,7 @@ static int __pyx_pf_4pypm_5Input___init__(PyObject *__pyx_v_self, PyObject *__py
  */
   __pyx_v_err = Pm_OpenInput((&((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi), __pyx_t_2, NULL, __pyx_t_3, (&Pt_Time), NULL);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":530
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":738
  *         err = Pm_OpenInput(&(self.midi), input_device, NULL, buffersize,
  *                            &Pt_Time, NULL)
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -2775,31 +4120,31 @@ static int __pyx_pf_4pypm_5Input___init__(PyObject *__pyx_v_self, PyObject *__py
   __pyx_t_4 = (__pyx_v_err < 0);
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":531
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":739
  *                            &Pt_Time, NULL)
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *         if self.debug:
  */
-    __pyx_t_5 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_5)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 531; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_5 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_5)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 739; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_5);
-    __pyx_t_6 = PyTuple_New(1); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 531; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_6 = PyTuple_New(1); if (unlikely(!__pyx_t_6)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 739; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_6));
     PyTuple_SET_ITEM(__pyx_t_6, 0, __pyx_t_5);
     __Pyx_GIVEREF(__pyx_t_5);
     __pyx_t_5 = 0;
-    __pyx_t_5 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_6), NULL); if (unlikely(!__pyx_t_5)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 531; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_5 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_6), NULL); if (unlikely(!__pyx_t_5)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 739; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_5);
     __Pyx_DECREF(((PyObject *)__pyx_t_6)); __pyx_t_6 = 0;
     __Pyx_Raise(__pyx_t_5, 0, 0);
     __Pyx_DECREF(__pyx_t_5); __pyx_t_5 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 531; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 739; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L6;
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":533
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":741
  *             raise Exception(Pm_GetErrorText(err))
  *
  *         if self.debug:             # <<<<<<<<<<<<<<
@@ -2809,14 +4154,14 @@ static int __pyx_pf_4pypm_5Input___init__(PyObject *__pyx_v_self, PyObject *__py
   __pyx_t_1 = ((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->debug;
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":534
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":742
  *
  *         if self.debug:
  *             print "MIDI input opened."             # <<<<<<<<<<<<<<
  *
  *     def __dealloc__(self):
  */
-    if (__Pyx_PrintOne(__pyx_kp_19) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 534; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    if (__Pyx_PrintOne(__pyx_kp_19) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 742; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L7;
   }
   __pyx_L7:;
@@ -2833,7 +4178,7 @@ static int __pyx_pf_4pypm_5Input___init__(PyObject *__pyx_v_self, PyObject *__py
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":536
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":744
  *             print "MIDI input opened."
  *
  *     def __dealloc__(self):             # <<<<<<<<<<<<<<
@@ -2851,7 +4196,7 @@ static void __pyx_pf_4pypm_5Input___dealloc__(PyObject *__pyx_v_self) {
   PyObject *__pyx_t_4 = NULL;
   __Pyx_SetupRefcountContext("__dealloc__");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":541
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":749
  *         cdef PmError err
  *
  *         if self.debug:             # <<<<<<<<<<<<<<
@@ -2861,39 +4206,51 @@ static void __pyx_pf_4pypm_5Input___dealloc__(PyObject *__pyx_v_self) {
   __pyx_t_1 = ((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->debug;
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":542
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":750
  *
  *         if self.debug:
  *             print "Closing MIDI input stream and destroying instance"             # <<<<<<<<<<<<<<
  *
  *         if self.midi:
  */
-    if (__Pyx_PrintOne(__pyx_kp_20) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 542; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    if (__Pyx_PrintOne(__pyx_kp_20) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 750; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":544
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":752
  *             print "Closing MIDI input stream and destroying instance"
  *
  *         if self.midi:             # <<<<<<<<<<<<<<
+ *             _poll_remove(self.midi)
  *             err = Pm_Close(self.midi)
- *             if err < 0:
  */
   __pyx_t_2 = (((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi != 0);
   if (__pyx_t_2) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":545
- *
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":753
+     *
+     *         if self.midi:
+     *             _poll_remove(self.midi)             # <<<<<<<<<<<<<<
+     *             err = Pm_Close(self.midi)
+     *             if err < 0:
+     */
+    __pyx_t_3 = __pyx_f_4pypm__poll_remove(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 753; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_3);
+    __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
+
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":754
  *         if self.midi:
+ *             _poll_remove(self.midi)
  *             err = Pm_Close(self.midi)             # <<<<<<<<<<<<<<
  *             if err < 0:
  *                 raise Exception(Pm_GetErrorText(err))
  */
     __pyx_v_err = Pm_Close(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi);
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":546
- *         if self.midi:
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":755
+ *             _poll_remove(self.midi)
  *             err = Pm_Close(self.midi)
  *             if err < 0:             # <<<<<<<<<<<<<<
  *                 raise Exception(Pm_GetErrorText(err))
@@ -2902,26 +4259,26 @@ static void __pyx_pf_4pypm_5Input___dealloc__(PyObject *__pyx_v_self) {
     __pyx_t_2 = (__pyx_v_err < 0);
     if (__pyx_t_2) {
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":547
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":756
  *             err = Pm_Close(self.midi)
  *             if err < 0:
  *                 raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *     def _check_open(self):
  */
-      __pyx_t_3 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 547; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_3 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 756; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_3);
-      __pyx_t_4 = PyTuple_New(1); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 547; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_4 = PyTuple_New(1); if (unlikely(!__pyx_t_4)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 756; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_4));
       PyTuple_SET_ITEM(__pyx_t_4, 0, __pyx_t_3);
       __Pyx_GIVEREF(__pyx_t_3);
       __pyx_t_3 = 0;
-      __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_4), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 547; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_4), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 756; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_3);
       __Pyx_DECREF(((PyObject *)__pyx_t_4)); __pyx_t_4 = 0;
       __Pyx_Raise(__pyx_t_3, 0, 0);
       __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
-      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 547; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 756; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       goto __pyx_L7;
     }
     __pyx_L7:;
@@ -2938,7 +4295,7 @@ static void __pyx_pf_4pypm_5Input___dealloc__(PyObject *__pyx_v_self) {
   __Pyx_FinishRefcountContext();
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":549
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":758
  *                 raise Exception(Pm_GetErrorText(err))
  *
  *     def _check_open(self):             # <<<<<<<<<<<<<<
@@ -2955,7 +4312,7 @@ static PyObject *__pyx_pf_4pypm_5Input__check_open(PyObject *__pyx_v_self, PyObj
   PyObject *__pyx_t_3 = NULL;
   __Pyx_SetupRefcountContext("_check_open");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":555
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":764
  *
  *         """
  *         if self.midi == NULL:             # <<<<<<<<<<<<<<
@@ -2965,24 +4322,24 @@ static PyObject *__pyx_pf_4pypm_5Input__check_open(PyObject *__pyx_v_self, PyObj
   __pyx_t_1 = (((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi == NULL);
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":556
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":765
  *         """
  *         if self.midi == NULL:
  *             raise Exception("midi Input not open.")             # <<<<<<<<<<<<<<
  *
  *     def Close(self):
  */
-    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 556; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 765; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_2));
     __Pyx_INCREF(__pyx_kp_21);
     PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_kp_21);
     __Pyx_GIVEREF(__pyx_kp_21);
-    __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 556; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_3 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 765; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_3);
     __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
     __Pyx_Raise(__pyx_t_3, 0, 0);
     __Pyx_DECREF(__pyx_t_3); __pyx_t_3 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 556; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 765; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
@@ -3000,7 +4357,7 @@ static PyObject *__pyx_pf_4pypm_5Input__check_open(PyObject *__pyx_v_self, PyObj
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":558
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":767
  *             raise Exception("midi Input not open.")
  *
  *     def Close(self):             # <<<<<<<<<<<<<<
@@ -3018,7 +4375,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Close(PyObject *__pyx_v_self, PyObject *u
   PyObject *__pyx_t_3 = NULL;
   __Pyx_SetupRefcountContext("Close");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":568
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":777
  *         cdef PmError err
  *
  *         if not self.midi:             # <<<<<<<<<<<<<<
@@ -3028,7 +4385,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Close(PyObject *__pyx_v_self, PyObject *u
   __pyx_t_1 = (!(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi != 0));
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":569
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":778
  *
  *         if not self.midi:
  *             return             # <<<<<<<<<<<<<<
@@ -3042,27 +4399,39 @@ static PyObject *__pyx_pf_4pypm_5Input_Close(PyObject *__pyx_v_self, PyObject *u
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":571
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":780
  *             return
  *
  *         if self.midi:             # <<<<<<<<<<<<<<
+ *             _poll_remove(self.midi)
  *             err = Pm_Close(self.midi)
- *             if err < 0:
  */
   __pyx_t_1 = (((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi != 0);
   if (__pyx_t_1) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":572
- *
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":781
+     *
+     *         if self.midi:
+     *             _poll_remove(self.midi)             # <<<<<<<<<<<<<<
+     *             err = Pm_Close(self.midi)
+     *             if err < 0:
+     */
+    __pyx_t_2 = __pyx_f_4pypm__poll_remove(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 781; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_2);
+    __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":782
  *         if self.midi:
+ *             _poll_remove(self.midi)
  *             err = Pm_Close(self.midi)             # <<<<<<<<<<<<<<
  *             if err < 0:
  *                 raise Exception(Pm_GetErrorText(err))
  */
     __pyx_v_err = Pm_Close(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi);
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":573
- *         if self.midi:
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":783
+ *             _poll_remove(self.midi)
  *             err = Pm_Close(self.midi)
  *             if err < 0:             # <<<<<<<<<<<<<<
  *                 raise Exception(Pm_GetErrorText(err))
@@ -3071,26 +4440,26 @@ static PyObject *__pyx_pf_4pypm_5Input_Close(PyObject *__pyx_v_self, PyObject *u
     __pyx_t_1 = (__pyx_v_err < 0);
     if (__pyx_t_1) {
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":574
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":784
  *             err = Pm_Close(self.midi)
  *             if err < 0:
  *                 raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *         self.midi = NULL
  */
-      __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 574; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 784; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_2);
-      __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 574; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_3 = PyTuple_New(1); if (unlikely(!__pyx_t_3)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 784; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_3));
       PyTuple_SET_ITEM(__pyx_t_3, 0, __pyx_t_2);
       __Pyx_GIVEREF(__pyx_t_2);
       __pyx_t_2 = 0;
-      __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 574; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_3), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 784; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_2);
       __Pyx_DECREF(((PyObject *)__pyx_t_3)); __pyx_t_3 = 0;
       __Pyx_Raise(__pyx_t_2, 0, 0);
       __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 574; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 784; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       goto __pyx_L7;
     }
     __pyx_L7:;
@@ -3098,7 +4467,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Close(PyObject *__pyx_v_self, PyObject *u
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":576
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":786
  *                 raise Exception(Pm_GetErrorText(err))
  *
  *         self.midi = NULL             # <<<<<<<<<<<<<<
@@ -3120,7 +4489,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Close(PyObject *__pyx_v_self, PyObject *u
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":579
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":789
  *
  *
  *     def SetFilter(self, filters):             # <<<<<<<<<<<<<<
@@ -3140,31 +4509,31 @@ static PyObject *__pyx_pf_4pypm_5Input_SetFilter(PyObject *__pyx_v_self, PyObjec
   int __pyx_t_4;
   __Pyx_SetupRefcountContext("SetFilter");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":609
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":819
  *         cdef PmError err
  *
  *         self._check_open()             # <<<<<<<<<<<<<<
  *
  *         err = Pm_SetFilter(self.midi, filters)
  */
-  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 609; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 819; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 609; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 819; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":611
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":821
  *         self._check_open()
  *
  *         err = Pm_SetFilter(self.midi, filters)             # <<<<<<<<<<<<<<
  *
  *         if err < 0:
  */
-  __pyx_t_3 = __Pyx_PyInt_AsLong(__pyx_v_filters); if (unlikely((__pyx_t_3 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 611; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = __Pyx_PyInt_AsLong(__pyx_v_filters); if (unlikely((__pyx_t_3 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 821; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_err = Pm_SetFilter(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi, __pyx_t_3);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":613
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":823
  *         err = Pm_SetFilter(self.midi, filters)
  *
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -3174,31 +4543,31 @@ static PyObject *__pyx_pf_4pypm_5Input_SetFilter(PyObject *__pyx_v_self, PyObjec
   __pyx_t_4 = (__pyx_v_err < 0);
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":614
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":824
  *
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *         while(Pm_Poll(self.midi) != pmNoError):
  */
-    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 614; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 824; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
-    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 614; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 824; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_1));
     PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
     __Pyx_GIVEREF(__pyx_t_2);
     __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 614; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 824; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 614; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 824; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":616
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":826
  *             raise Exception(Pm_GetErrorText(err))
  *
  *         while(Pm_Poll(self.midi) != pmNoError):             # <<<<<<<<<<<<<<
@@ -3209,7 +4578,7 @@ static PyObject *__pyx_pf_4pypm_5Input_SetFilter(PyObject *__pyx_v_self, PyObjec
     __pyx_t_4 = (Pm_Poll(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi) != pmNoError);
     if (!__pyx_t_4) break;
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":617
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":827
  *
  *         while(Pm_Poll(self.midi) != pmNoError):
  *             err = Pm_Read(self.midi, buffer, 1)             # <<<<<<<<<<<<<<
@@ -3218,7 +4587,7 @@ static PyObject *__pyx_pf_4pypm_5Input_SetFilter(PyObject *__pyx_v_self, PyObjec
  */
     __pyx_v_err = Pm_Read(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi, __pyx_v_buffer, 1);
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":618
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":828
  *         while(Pm_Poll(self.midi) != pmNoError):
  *             err = Pm_Read(self.midi, buffer, 1)
  *             if err < 0:             # <<<<<<<<<<<<<<
@@ -3228,26 +4597,26 @@ static PyObject *__pyx_pf_4pypm_5Input_SetFilter(PyObject *__pyx_v_self, PyObjec
     __pyx_t_4 = (__pyx_v_err < 0);
     if (__pyx_t_4) {
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":619
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":829
  *             err = Pm_Read(self.midi, buffer, 1)
  *             if err < 0:
  *                 raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *     def SetChannelMask(self, mask):
  */
-      __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 619; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 829; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_2);
-      __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 619; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 829; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_1));
       PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
       __Pyx_GIVEREF(__pyx_t_2);
       __pyx_t_2 = 0;
-      __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 619; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 829; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_2);
       __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
       __Pyx_Raise(__pyx_t_2, 0, 0);
       __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 619; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 829; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       goto __pyx_L8;
     }
     __pyx_L8:;
@@ -3266,7 +4635,7 @@ static PyObject *__pyx_pf_4pypm_5Input_SetFilter(PyObject *__pyx_v_self, PyObjec
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":621
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":831
  *                 raise Exception(Pm_GetErrorText(err))
  *
  *     def SetChannelMask(self, mask):             # <<<<<<<<<<<<<<
@@ -3285,31 +4654,31 @@ static PyObject *__pyx_pf_4pypm_5Input_SetChannelMask(PyObject *__pyx_v_self, Py
   int __pyx_t_4;
   __Pyx_SetupRefcountContext("SetChannelMask");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":642
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":852
  *         cdef PmError err
  *
  *         self._check_open()             # <<<<<<<<<<<<<<
  *
  *         err = Pm_SetChannelMask(self.midi, mask)
  */
-  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 642; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 852; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 642; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 852; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":644
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":854
  *         self._check_open()
  *
  *         err = Pm_SetChannelMask(self.midi, mask)             # <<<<<<<<<<<<<<
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))
  */
-  __pyx_t_3 = __Pyx_PyInt_AsInt(__pyx_v_mask); if (unlikely((__pyx_t_3 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 644; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = __Pyx_PyInt_AsInt(__pyx_v_mask); if (unlikely((__pyx_t_3 == (int)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 854; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_err = Pm_SetChannelMask(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi, __pyx_t_3);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":645
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":855
  *
  *         err = Pm_SetChannelMask(self.midi, mask)
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -3319,26 +4688,26 @@ static PyObject *__pyx_pf_4pypm_5Input_SetChannelMask(PyObject *__pyx_v_self, Py
   __pyx_t_4 = (__pyx_v_err < 0);
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":646
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":856
  *         err = Pm_SetChannelMask(self.midi, mask)
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *     def Poll(self):
  */
-    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 646; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 856; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
-    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 646; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 856; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_1));
     PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
     __Pyx_GIVEREF(__pyx_t_2);
     __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 646; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 856; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 646; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 856; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
@@ -3356,7 +4725,7 @@ static PyObject *__pyx_pf_4pypm_5Input_SetChannelMask(PyObject *__pyx_v_self, Py
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":648
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":858
  *             raise Exception(Pm_GetErrorText(err))
  *
  *     def Poll(self):             # <<<<<<<<<<<<<<
@@ -3374,21 +4743,21 @@ static PyObject *__pyx_pf_4pypm_5Input_Poll(PyObject *__pyx_v_self, PyObject *un
   int __pyx_t_3;
   __Pyx_SetupRefcountContext("Poll");
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":656
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":866
  *         cdef PmError err
  *
  *         self._check_open()             # <<<<<<<<<<<<<<
  *
  *         err = Pm_Poll(self.midi)
  */
-  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 656; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 866; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 656; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 866; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":658
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":868
  *         self._check_open()
  *
  *         err = Pm_Poll(self.midi)             # <<<<<<<<<<<<<<
@@ -3397,7 +4766,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Poll(PyObject *__pyx_v_self, PyObject *un
  */
   __pyx_v_err = Pm_Poll(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":659
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":869
  *
  *         err = Pm_Poll(self.midi)
  *         if err < 0:             # <<<<<<<<<<<<<<
@@ -3407,31 +4776,31 @@ static PyObject *__pyx_pf_4pypm_5Input_Poll(PyObject *__pyx_v_self, PyObject *un
   __pyx_t_3 = (__pyx_v_err < 0);
   if (__pyx_t_3) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":660
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":870
  *         err = Pm_Poll(self.midi)
  *         if err < 0:
  *             raise Exception(Pm_GetErrorText(err))             # <<<<<<<<<<<<<<
  *
  *         return err
  */
-    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 660; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_err)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 870; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
-    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 660; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 870; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_1));
     PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
     __Pyx_GIVEREF(__pyx_t_2);
     __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 660; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 870; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 660; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 870; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":662
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":872
  *             raise Exception(Pm_GetErrorText(err))
  *
  *         return err             # <<<<<<<<<<<<<<
@@ -3439,7 +4808,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Poll(PyObject *__pyx_v_self, PyObject *un
  *     def Read(self, max_events):
  */
   __Pyx_XDECREF(__pyx_r);
-  __pyx_t_2 = PyInt_FromLong(__pyx_v_err); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 662; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyInt_FromLong(__pyx_v_err); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 872; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __pyx_r = __pyx_t_2;
   __pyx_t_2 = 0;
@@ -3458,7 +4827,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Poll(PyObject *__pyx_v_self, PyObject *un
   return __pyx_r;
 }
 
-/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":664
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":874
  *         return err
  *
  *     def Read(self, max_events):             # <<<<<<<<<<<<<<
@@ -3489,99 +4858,99 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
   __pyx_v_events = Py_None; __Pyx_INCREF(Py_None);
   __pyx_v_ev_no = Py_None; __Pyx_INCREF(Py_None);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":680
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":890
  *         cdef PmError num_events
  *
  *         self._check_open()             # <<<<<<<<<<<<<<
  *
  *         if max_events > 1024:
  */
-  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 680; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 890; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_1);
-  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 680; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 890; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
   __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":682
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":892
  *         self._check_open()
  *
  *         if max_events > 1024:             # <<<<<<<<<<<<<<
  *             raise ValueError('Maximum buffer length is 1024.')
  *         if not max_events:
  */
-  __pyx_t_2 = PyObject_RichCompare(__pyx_v_max_events, __pyx_int_1024, Py_GT); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 682; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyObject_RichCompare(__pyx_v_max_events, __pyx_int_1024, Py_GT); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 892; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(__pyx_t_2);
-  __pyx_t_3 = __Pyx_PyObject_IsTrue(__pyx_t_2); if (unlikely(__pyx_t_3 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 682; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = __Pyx_PyObject_IsTrue(__pyx_t_2); if (unlikely(__pyx_t_3 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 892; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
   if (__pyx_t_3) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":683
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":893
  *
  *         if max_events > 1024:
  *             raise ValueError('Maximum buffer length is 1024.')             # <<<<<<<<<<<<<<
  *         if not max_events:
  *             raise ValueError('Minimum buffer length is 1.')
  */
-    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 683; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyTuple_New(1); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 893; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_2));
     __Pyx_INCREF(__pyx_kp_22);
     PyTuple_SET_ITEM(__pyx_t_2, 0, __pyx_kp_22);
     __Pyx_GIVEREF(__pyx_kp_22);
-    __pyx_t_1 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 683; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_2), NULL); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 893; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_1);
     __Pyx_DECREF(((PyObject *)__pyx_t_2)); __pyx_t_2 = 0;
     __Pyx_Raise(__pyx_t_1, 0, 0);
     __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 683; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 893; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L5;
   }
   __pyx_L5:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":684
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":894
  *         if max_events > 1024:
  *             raise ValueError('Maximum buffer length is 1024.')
  *         if not max_events:             # <<<<<<<<<<<<<<
  *             raise ValueError('Minimum buffer length is 1.')
  *
  */
-  __pyx_t_3 = __Pyx_PyObject_IsTrue(__pyx_v_max_events); if (unlikely(__pyx_t_3 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 684; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_3 = __Pyx_PyObject_IsTrue(__pyx_v_max_events); if (unlikely(__pyx_t_3 < 0)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 894; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_t_4 = (!__pyx_t_3);
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":685
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":895
  *             raise ValueError('Maximum buffer length is 1024.')
  *         if not max_events:
  *             raise ValueError('Minimum buffer length is 1.')             # <<<<<<<<<<<<<<
  *
  *         num_events = Pm_Read(self.midi, buffer, max_events)
  */
-    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 685; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 895; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_1));
     __Pyx_INCREF(__pyx_kp_23);
     PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_kp_23);
     __Pyx_GIVEREF(__pyx_kp_23);
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 685; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_ValueError, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 895; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 685; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 895; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L6;
   }
   __pyx_L6:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":687
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":897
  *             raise ValueError('Minimum buffer length is 1.')
  *
  *         num_events = Pm_Read(self.midi, buffer, max_events)             # <<<<<<<<<<<<<<
  *         if num_events < 0:
  *             raise Exception(Pm_GetErrorText(num_events))
  */
-  __pyx_t_5 = __Pyx_PyInt_AsLong(__pyx_v_max_events); if (unlikely((__pyx_t_5 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 687; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_5 = __Pyx_PyInt_AsLong(__pyx_v_max_events); if (unlikely((__pyx_t_5 == (long)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 897; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_v_num_events = Pm_Read(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi, __pyx_v_buffer, __pyx_t_5);
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":688
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":898
  *
  *         num_events = Pm_Read(self.midi, buffer, max_events)
  *         if num_events < 0:             # <<<<<<<<<<<<<<
@@ -3591,44 +4960,44 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
   __pyx_t_4 = (__pyx_v_num_events < 0);
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":689
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":899
  *         num_events = Pm_Read(self.midi, buffer, max_events)
  *         if num_events < 0:
  *             raise Exception(Pm_GetErrorText(num_events))             # <<<<<<<<<<<<<<
  *
  *         events = []
  */
-    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_num_events)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 689; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_num_events)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 899; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
-    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 689; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 899; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_1));
     PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
     __Pyx_GIVEREF(__pyx_t_2);
     __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 689; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 899; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
     __Pyx_Raise(__pyx_t_2, 0, 0);
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
-    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 689; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    {__pyx_filename = __pyx_f[0]; __pyx_lineno = 899; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     goto __pyx_L7;
   }
   __pyx_L7:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":691
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":901
  *             raise Exception(Pm_GetErrorText(num_events))
  *
  *         events = []             # <<<<<<<<<<<<<<
  *         if num_events >= 1:
  *             for ev_no in range(num_events):
  */
-  __pyx_t_2 = PyList_New(0); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 691; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_t_2 = PyList_New(0); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 901; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_GOTREF(((PyObject *)__pyx_t_2));
   __Pyx_DECREF(__pyx_v_events);
   __pyx_v_events = ((PyObject *)__pyx_t_2);
   __pyx_t_2 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":692
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":902
  *
  *         events = []
  *         if num_events >= 1:             # <<<<<<<<<<<<<<
@@ -3638,27 +5007,27 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
   __pyx_t_4 = (__pyx_v_num_events >= 1);
   if (__pyx_t_4) {
 
-    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":693
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":903
  *         events = []
  *         if num_events >= 1:
  *             for ev_no in range(num_events):             # <<<<<<<<<<<<<<
  *                 events.append(
  *                     [
  */
-    __pyx_t_2 = PyInt_FromLong(__pyx_v_num_events); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 693; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyInt_FromLong(__pyx_v_num_events); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 903; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
-    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 693; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 903; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(((PyObject *)__pyx_t_1));
     PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
     __Pyx_GIVEREF(__pyx_t_2);
     __pyx_t_2 = 0;
-    __pyx_t_2 = PyObject_Call(__pyx_builtin_range, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 693; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __pyx_t_2 = PyObject_Call(__pyx_builtin_range, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 903; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
     __Pyx_GOTREF(__pyx_t_2);
     __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
     if (PyList_CheckExact(__pyx_t_2) || PyTuple_CheckExact(__pyx_t_2)) {
       __pyx_t_6 = 0; __pyx_t_1 = __pyx_t_2; __Pyx_INCREF(__pyx_t_1);
     } else {
-      __pyx_t_6 = -1; __pyx_t_1 = PyObject_GetIter(__pyx_t_2); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 693; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_6 = -1; __pyx_t_1 = PyObject_GetIter(__pyx_t_2); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 903; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_1);
     }
     __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
@@ -3672,7 +5041,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
       } else {
         __pyx_t_2 = PyIter_Next(__pyx_t_1);
         if (!__pyx_t_2) {
-          if (unlikely(PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 693; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+          if (unlikely(PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 903; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
           break;
         }
         __Pyx_GOTREF(__pyx_t_2);
@@ -3681,50 +5050,50 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
       __pyx_v_ev_no = __pyx_t_2;
       __pyx_t_2 = 0;
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":697
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":907
  *                     [
  *                         [
  *                             buffer[ev_no].message & 0xFF,             # <<<<<<<<<<<<<<
  *                             (buffer[ev_no].message >> 8) & 0xFF,
  *                             (buffer[ev_no].message >> 16) & 0xFF,
  */
-      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 697; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-      __pyx_t_2 = PyInt_FromLong(((__pyx_v_buffer[__pyx_t_7]).message & 0xFF)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 697; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 907; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_2 = PyInt_FromLong(((__pyx_v_buffer[__pyx_t_7]).message & 0xFF)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 907; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_2);
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":698
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":908
  *                         [
  *                             buffer[ev_no].message & 0xFF,
  *                             (buffer[ev_no].message >> 8) & 0xFF,             # <<<<<<<<<<<<<<
  *                             (buffer[ev_no].message >> 16) & 0xFF,
  *                             (buffer[ev_no].message >> 24) & 0xFF
  */
-      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 698; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-      __pyx_t_8 = PyInt_FromLong((((__pyx_v_buffer[__pyx_t_7]).message >> 8) & 0xFF)); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 698; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 908; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_8 = PyInt_FromLong((((__pyx_v_buffer[__pyx_t_7]).message >> 8) & 0xFF)); if (unlikely(!__pyx_t_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 908; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_8);
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":699
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":909
  *                             buffer[ev_no].message & 0xFF,
  *                             (buffer[ev_no].message >> 8) & 0xFF,
  *                             (buffer[ev_no].message >> 16) & 0xFF,             # <<<<<<<<<<<<<<
  *                             (buffer[ev_no].message >> 24) & 0xFF
  *                         ],
  */
-      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 699; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-      __pyx_t_9 = PyInt_FromLong((((__pyx_v_buffer[__pyx_t_7]).message >> 16) & 0xFF)); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 699; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 909; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_9 = PyInt_FromLong((((__pyx_v_buffer[__pyx_t_7]).message >> 16) & 0xFF)); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 909; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_9);
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":700
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":910
  *                             (buffer[ev_no].message >> 8) & 0xFF,
  *                             (buffer[ev_no].message >> 16) & 0xFF,
  *                             (buffer[ev_no].message >> 24) & 0xFF             # <<<<<<<<<<<<<<
  *                         ],
  *                         buffer[ev_no].timestamp
  */
-      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 700; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-      __pyx_t_10 = PyInt_FromLong((((__pyx_v_buffer[__pyx_t_7]).message >> 24) & 0xFF)); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 700; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 910; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_10 = PyInt_FromLong((((__pyx_v_buffer[__pyx_t_7]).message >> 24) & 0xFF)); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 910; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_10);
-      __pyx_t_11 = PyList_New(4); if (unlikely(!__pyx_t_11)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 696; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_11 = PyList_New(4); if (unlikely(!__pyx_t_11)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 906; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_11));
       PyList_SET_ITEM(__pyx_t_11, 0, __pyx_t_2);
       __Pyx_GIVEREF(__pyx_t_2);
@@ -3739,17 +5108,17 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
       __pyx_t_9 = 0;
       __pyx_t_10 = 0;
 
-      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":702
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":912
  *                             (buffer[ev_no].message >> 24) & 0xFF
  *                         ],
  *                         buffer[ev_no].timestamp             # <<<<<<<<<<<<<<
  *                     ]
  *                 )
  */
-      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 702; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-      __pyx_t_10 = PyInt_FromLong((__pyx_v_buffer[__pyx_t_7]).timestamp); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 702; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_7 = __Pyx_PyIndex_AsSsize_t(__pyx_v_ev_no); if (unlikely((__pyx_t_7 == (Py_ssize_t)-1) && PyErr_Occurred())) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 912; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_10 = PyInt_FromLong((__pyx_v_buffer[__pyx_t_7]).timestamp); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 912; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_10);
-      __pyx_t_9 = PyList_New(2); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 695; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_9 = PyList_New(2); if (unlikely(!__pyx_t_9)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 905; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(((PyObject *)__pyx_t_9));
       PyList_SET_ITEM(__pyx_t_9, 0, ((PyObject *)__pyx_t_11));
       __Pyx_GIVEREF(((PyObject *)__pyx_t_11));
@@ -3757,7 +5126,7 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
       __Pyx_GIVEREF(__pyx_t_10);
       __pyx_t_11 = 0;
       __pyx_t_10 = 0;
-      __pyx_t_10 = __Pyx_PyObject_Append(__pyx_v_events, ((PyObject *)__pyx_t_9)); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 694; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __pyx_t_10 = __Pyx_PyObject_Append(__pyx_v_events, ((PyObject *)__pyx_t_9)); if (unlikely(!__pyx_t_10)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 904; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
       __Pyx_GOTREF(__pyx_t_10);
       __Pyx_DECREF(((PyObject *)__pyx_t_9)); __pyx_t_9 = 0;
       __Pyx_DECREF(__pyx_t_10); __pyx_t_10 = 0;
@@ -3767,10 +5136,12 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
   }
   __pyx_L8:;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":706
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":916
  *                 )
  *
  *         return events             # <<<<<<<<<<<<<<
+ *
+ *     def ReadInto(self, data):
  */
   __Pyx_XDECREF(__pyx_r);
   __Pyx_INCREF(__pyx_v_events);
@@ -3796,6 +5167,374 @@ static PyObject *__pyx_pf_4pypm_5Input_Read(PyObject *__pyx_v_self, PyObject *__
   return __pyx_r;
 }
 
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":918
+ *         return events
+ *
+ *     def ReadInto(self, data):             # <<<<<<<<<<<<<<
+ *         """Read events from input into a writable buffer object.
+ *
+ */
+
+static PyObject *__pyx_pf_4pypm_5Input_ReadInto(PyObject *__pyx_v_self, PyObject *__pyx_v_data); /*proto*/
+static char __pyx_doc_4pypm_5Input_ReadInto[] = "Read events from input into a writable buffer object.\n\n        Usage::\n\n            ReadInto(data)\n\n        Reads as many events as fit in data, a writable object with the\n        buffer interface such as a bytearray or array, as RECORD_FORMAT\n        structs: the message as an unsigned 32 bit integer, status in the\n        low byte, and the timestamp as a 32 bit integer. Returns the number\n        of events read. Reading into the same buffer each time makes no\n        Python objects for the events.\n\n        ";
+static PyObject *__pyx_pf_4pypm_5Input_ReadInto(PyObject *__pyx_v_self, PyObject *__pyx_v_data) {
+  void *__pyx_v_buf;
+  Py_ssize_t __pyx_v_size;
+  struct __pyx_t_4pypm_MidiRecord *__pyx_v_records;
+  PmEvent __pyx_v_buffer[1024];
+  PmError __pyx_v_num_events;
+  int __pyx_v_count;
+  int __pyx_v_done;
+  int __pyx_v_num;
+  int __pyx_v_ev_no;
+  PyObject *__pyx_r = NULL;
+  PyObject *__pyx_t_1 = NULL;
+  PyObject *__pyx_t_2 = NULL;
+  int __pyx_t_3;
+  int __pyx_t_4;
+  PmError __pyx_t_5;
+  int __pyx_t_6;
+  __Pyx_SetupRefcountContext("ReadInto");
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":943
+   *         cdef int ev_no
+   *
+   *         self._check_open()             # <<<<<<<<<<<<<<
+   *
+   *         PyObject_AsWriteBuffer(data, &buf, &size)
+   */
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 943; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_1);
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 943; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_2);
+  __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
+  __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":945
+   *         self._check_open()
+   *
+   *         PyObject_AsWriteBuffer(data, &buf, &size)             # <<<<<<<<<<<<<<
+   *         records = <MidiRecord *> buf
+   *         count = size / sizeof(MidiRecord)
+   */
+  __pyx_t_3 = PyObject_AsWriteBuffer(__pyx_v_data, (&__pyx_v_buf), (&__pyx_v_size)); if (unlikely(__pyx_t_3 == -1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 945; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":946
+   *
+   *         PyObject_AsWriteBuffer(data, &buf, &size)
+   *         records = <MidiRecord *> buf             # <<<<<<<<<<<<<<
+   *         count = size / sizeof(MidiRecord)
+   *         done = 0
+   */
+  __pyx_v_records = ((struct __pyx_t_4pypm_MidiRecord *)__pyx_v_buf);
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":947
+   *         PyObject_AsWriteBuffer(data, &buf, &size)
+   *         records = <MidiRecord *> buf
+   *         count = size / sizeof(MidiRecord)             # <<<<<<<<<<<<<<
+   *         done = 0
+   *         while done < count:
+   */
+  __pyx_v_count = (__pyx_v_size / (sizeof(struct __pyx_t_4pypm_MidiRecord)));
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":948
+   *         records = <MidiRecord *> buf
+   *         count = size / sizeof(MidiRecord)
+   *         done = 0             # <<<<<<<<<<<<<<
+   *         while done < count:
+   *             num = count - done
+   */
+  __pyx_v_done = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":949
+   *         count = size / sizeof(MidiRecord)
+   *         done = 0
+   *         while done < count:             # <<<<<<<<<<<<<<
+   *             num = count - done
+   *             if num > 1024:
+   */
+  while (1) {
+    __pyx_t_4 = (__pyx_v_done < __pyx_v_count);
+    if (!__pyx_t_4) break;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":950
+     *         done = 0
+     *         while done < count:
+     *             num = count - done             # <<<<<<<<<<<<<<
+     *             if num > 1024:
+     *                 num = 1024
+     */
+    __pyx_v_num = (__pyx_v_count - __pyx_v_done);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":951
+     *         while done < count:
+     *             num = count - done
+     *             if num > 1024:             # <<<<<<<<<<<<<<
+     *                 num = 1024
+     *             num_events = Pm_Read(self.midi, buffer, num)
+     */
+    __pyx_t_4 = (__pyx_v_num > 1024);
+    if (__pyx_t_4) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":952
+       *             num = count - done
+       *             if num > 1024:
+       *                 num = 1024             # <<<<<<<<<<<<<<
+       *             num_events = Pm_Read(self.midi, buffer, num)
+       *             if num_events < 0:
+       */
+      __pyx_v_num = 1024;
+      goto __pyx_L7;
+    }
+    __pyx_L7:;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":953
+     *             if num > 1024:
+     *                 num = 1024
+     *             num_events = Pm_Read(self.midi, buffer, num)             # <<<<<<<<<<<<<<
+     *             if num_events < 0:
+     *                 raise Exception(Pm_GetErrorText(num_events))
+     */
+    __pyx_v_num_events = Pm_Read(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi, __pyx_v_buffer, __pyx_v_num);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":954
+     *                 num = 1024
+     *             num_events = Pm_Read(self.midi, buffer, num)
+     *             if num_events < 0:             # <<<<<<<<<<<<<<
+     *                 raise Exception(Pm_GetErrorText(num_events))
+     *             for ev_no in range(num_events):
+     */
+    __pyx_t_4 = (__pyx_v_num_events < 0);
+    if (__pyx_t_4) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":955
+       *             num_events = Pm_Read(self.midi, buffer, num)
+       *             if num_events < 0:
+       *                 raise Exception(Pm_GetErrorText(num_events))             # <<<<<<<<<<<<<<
+       *             for ev_no in range(num_events):
+       *                 records[done + ev_no].message = buffer[ev_no].message
+       */
+      __pyx_t_2 = __Pyx_PyBytes_FromString(Pm_GetErrorText(__pyx_v_num_events)); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 955; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(__pyx_t_2);
+      __pyx_t_1 = PyTuple_New(1); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 955; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(((PyObject *)__pyx_t_1));
+      PyTuple_SET_ITEM(__pyx_t_1, 0, __pyx_t_2);
+      __Pyx_GIVEREF(__pyx_t_2);
+      __pyx_t_2 = 0;
+      __pyx_t_2 = PyObject_Call(__pyx_builtin_Exception, ((PyObject *)__pyx_t_1), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 955; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      __Pyx_GOTREF(__pyx_t_2);
+      __Pyx_DECREF(((PyObject *)__pyx_t_1)); __pyx_t_1 = 0;
+      __Pyx_Raise(__pyx_t_2, 0, 0);
+      __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+      {__pyx_filename = __pyx_f[0]; __pyx_lineno = 955; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+      goto __pyx_L8;
+    }
+    __pyx_L8:;
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":956
+     *             if num_events < 0:
+     *                 raise Exception(Pm_GetErrorText(num_events))
+     *             for ev_no in range(num_events):             # <<<<<<<<<<<<<<
+     *                 records[done + ev_no].message = buffer[ev_no].message
+     *                 records[done + ev_no].timestamp = buffer[ev_no].timestamp
+     */
+    __pyx_t_5 = __pyx_v_num_events;
+    for (__pyx_t_6 = 0; __pyx_t_6 < __pyx_t_5; __pyx_t_6+=1) {
+      __pyx_v_ev_no = __pyx_t_6;
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":957
+       *                 raise Exception(Pm_GetErrorText(num_events))
+       *             for ev_no in range(num_events):
+       *                 records[done + ev_no].message = buffer[ev_no].message             # <<<<<<<<<<<<<<
+       *                 records[done + ev_no].timestamp = buffer[ev_no].timestamp
+       *             done = done + num_events
+       */
+      (__pyx_v_records[(__pyx_v_done + __pyx_v_ev_no)]).message = (__pyx_v_buffer[__pyx_v_ev_no]).message;
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":958
+       *             for ev_no in range(num_events):
+       *                 records[done + ev_no].message = buffer[ev_no].message
+       *                 records[done + ev_no].timestamp = buffer[ev_no].timestamp             # <<<<<<<<<<<<<<
+       *             done = done + num_events
+       *             if num_events < num:
+       */
+      (__pyx_v_records[(__pyx_v_done + __pyx_v_ev_no)]).timestamp = (__pyx_v_buffer[__pyx_v_ev_no]).timestamp;
+    }
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":959
+     *                 records[done + ev_no].message = buffer[ev_no].message
+     *                 records[done + ev_no].timestamp = buffer[ev_no].timestamp
+     *             done = done + num_events             # <<<<<<<<<<<<<<
+     *             if num_events < num:
+     *                 break
+     */
+    __pyx_v_done = (__pyx_v_done + __pyx_v_num_events);
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":960
+     *                 records[done + ev_no].timestamp = buffer[ev_no].timestamp
+     *             done = done + num_events
+     *             if num_events < num:             # <<<<<<<<<<<<<<
+     *                 break
+     *
+     */
+    __pyx_t_4 = (__pyx_v_num_events < __pyx_v_num);
+    if (__pyx_t_4) {
+
+      /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":961
+       *             done = done + num_events
+       *             if num_events < num:
+       *                 break             # <<<<<<<<<<<<<<
+       *
+       *         return done
+       */
+      goto __pyx_L6_break;
+      goto __pyx_L11;
+    }
+    __pyx_L11:;
+  }
+  __pyx_L6_break:;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":963
+   *                 break
+   *
+   *         return done             # <<<<<<<<<<<<<<
+   *
+   *     def StartPolling(self):
+   */
+  __Pyx_XDECREF(__pyx_r);
+  __pyx_t_2 = PyInt_FromLong(__pyx_v_done); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 963; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_2);
+  __pyx_r = __pyx_t_2;
+  __pyx_t_2 = 0;
+  goto __pyx_L0;
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_1);
+  __Pyx_XDECREF(__pyx_t_2);
+  __Pyx_AddTraceback("pypm.Input.ReadInto");
+  __pyx_r = NULL;
+  __pyx_L0:;
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":965
+ *         return done
+ *
+ *     def StartPolling(self):             # <<<<<<<<<<<<<<
+ *         """Have the poll thread read this input.
+ *
+ */
+
+static PyObject *__pyx_pf_4pypm_5Input_StartPolling(PyObject *__pyx_v_self, PyObject *unused); /*proto*/
+static char __pyx_doc_4pypm_5Input_StartPolling[] = "Have the poll thread read this input.\n\n        The events are handed to the function given to SetPollCallback,\n        from the poll thread, which starts with the first input polled.\n        Do not Read from the input while it is polled.\n\n        ";
+static PyObject *__pyx_pf_4pypm_5Input_StartPolling(PyObject *__pyx_v_self, PyObject *unused) {
+  PyObject *__pyx_r = NULL;
+  PyObject *__pyx_t_1 = NULL;
+  PyObject *__pyx_t_2 = NULL;
+  __Pyx_SetupRefcountContext("StartPolling");
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":973
+   *
+   *         """
+   *         self._check_open()             # <<<<<<<<<<<<<<
+   *         _poll_remove(self.midi)
+   *         _poll_add(self.midi, self.device)
+   */
+  __pyx_t_1 = PyObject_GetAttr(__pyx_v_self, __pyx_kp__check_open); if (unlikely(!__pyx_t_1)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 973; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_1);
+  __pyx_t_2 = PyObject_Call(__pyx_t_1, ((PyObject *)__pyx_empty_tuple), NULL); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 973; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_2);
+  __Pyx_DECREF(__pyx_t_1); __pyx_t_1 = 0;
+  __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":974
+   *         """
+   *         self._check_open()
+   *         _poll_remove(self.midi)             # <<<<<<<<<<<<<<
+   *         _poll_add(self.midi, self.device)
+   *
+   */
+  __pyx_t_2 = __pyx_f_4pypm__poll_remove(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 974; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_2);
+  __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":975
+   *         self._check_open()
+   *         _poll_remove(self.midi)
+   *         _poll_add(self.midi, self.device)             # <<<<<<<<<<<<<<
+   *
+   *     def StopPolling(self):
+   */
+  __pyx_t_2 = __pyx_f_4pypm__poll_add(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi, ((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->device); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 975; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __Pyx_GOTREF(__pyx_t_2);
+  __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_1);
+  __Pyx_XDECREF(__pyx_t_2);
+  __Pyx_AddTraceback("pypm.Input.StartPolling");
+  __pyx_r = NULL;
+  __pyx_L0:;
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
+/* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":977
+ *         _poll_add(self.midi, self.device)
+ *
+ *     def StopPolling(self):             # <<<<<<<<<<<<<<
+ *         """Stop the poll thread reading this input."""
+ *
+ */
+
+static PyObject *__pyx_pf_4pypm_5Input_StopPolling(PyObject *__pyx_v_self, PyObject *unused); /*proto*/
+static char __pyx_doc_4pypm_5Input_StopPolling[] = "Stop the poll thread reading this input.";
+static PyObject *__pyx_pf_4pypm_5Input_StopPolling(PyObject *__pyx_v_self, PyObject *unused) {
+  PyObject *__pyx_r = NULL;
+  int __pyx_t_1;
+  PyObject *__pyx_t_2 = NULL;
+  __Pyx_SetupRefcountContext("StopPolling");
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":980
+   *         """Stop the poll thread reading this input."""
+   *
+   *         if self.midi:             # <<<<<<<<<<<<<<
+   *             _poll_remove(self.midi)
+   */
+  __pyx_t_1 = (((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi != 0);
+  if (__pyx_t_1) {
+
+    /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":981
+     *
+     *         if self.midi:
+     *             _poll_remove(self.midi)             # <<<<<<<<<<<<<<
+     */
+    __pyx_t_2 = __pyx_f_4pypm__poll_remove(((struct __pyx_obj_4pypm_Input *)__pyx_v_self)->midi); if (unlikely(!__pyx_t_2)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 981; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+    __Pyx_GOTREF(__pyx_t_2);
+    __Pyx_DECREF(__pyx_t_2); __pyx_t_2 = 0;
+    goto __pyx_L5;
+  }
+  __pyx_L5:;
+
+  __pyx_r = Py_None; __Pyx_INCREF(Py_None);
+  goto __pyx_L0;
+  __pyx_L1_error:;
+  __Pyx_XDECREF(__pyx_t_2);
+  __Pyx_AddTraceback("pypm.Input.StopPolling");
+  __pyx_r = NULL;
+  __pyx_L0:;
+  __Pyx_XGIVEREF(__pyx_r);
+  __Pyx_FinishRefcountContext();
+  return __pyx_r;
+}
+
 static PyObject *__pyx_tp_new_4pypm_Output(PyTypeObject *t, PyObject *a, PyObject *k) {
   PyObject *o = (*t->tp_alloc)(t, 0);
   if (!o) return 0;
@@ -3821,6 +5560,7 @@ static struct PyMethodDef __pyx_methods_4pypm_Output[] = {
   {__Pyx_NAMESTR("Abort"), (PyCFunction)__pyx_pf_4pypm_6Output_Abort, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_6Output_Abort)},
   {__Pyx_NAMESTR("Write"), (PyCFunction)__pyx_pf_4pypm_6Output_Write, METH_O, __Pyx_DOCSTR(__pyx_doc_4pypm_6Output_Write)},
   {__Pyx_NAMESTR("WriteShort"), (PyCFunction)__pyx_pf_4pypm_6Output_WriteShort, METH_VARARGS|METH_KEYWORDS, __Pyx_DOCSTR(__pyx_doc_4pypm_6Output_WriteShort)},
+  {__Pyx_NAMESTR("WriteBuffer"), (PyCFunction)__pyx_pf_4pypm_6Output_WriteBuffer, METH_O, __Pyx_DOCSTR(__pyx_doc_4pypm_6Output_WriteBuffer)},
   {__Pyx_NAMESTR("WriteSysEx"), (PyCFunction)__pyx_pf_4pypm_6Output_WriteSysEx, METH_VARARGS|METH_KEYWORDS, __Pyx_DOCSTR(__pyx_doc_4pypm_6Output_WriteSysEx)},
   {0, 0, 0, 0}
 };
@@ -3997,6 +5737,9 @@ static struct PyMethodDef __pyx_methods_4pypm_Input[] = {
   {__Pyx_NAMESTR("SetChannelMask"), (PyCFunction)__pyx_pf_4pypm_5Input_SetChannelMask, METH_O, __Pyx_DOCSTR(__pyx_doc_4pypm_5Input_SetChannelMask)},
   {__Pyx_NAMESTR("Poll"), (PyCFunction)__pyx_pf_4pypm_5Input_Poll, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_5Input_Poll)},
   {__Pyx_NAMESTR("Read"), (PyCFunction)__pyx_pf_4pypm_5Input_Read, METH_O, __Pyx_DOCSTR(__pyx_doc_4pypm_5Input_Read)},
+  {__Pyx_NAMESTR("ReadInto"), (PyCFunction)__pyx_pf_4pypm_5Input_ReadInto, METH_O, __Pyx_DOCSTR(__pyx_doc_4pypm_5Input_ReadInto)},
+  {__Pyx_NAMESTR("StartPolling"), (PyCFunction)__pyx_pf_4pypm_5Input_StartPolling, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_5Input_StartPolling)},
+  {__Pyx_NAMESTR("StopPolling"), (PyCFunction)__pyx_pf_4pypm_5Input_StopPolling, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_5Input_StopPolling)},
   {0, 0, 0, 0}
 };
 
@@ -4149,6 +5892,7 @@ PyTypeObject __pyx_type_4pypm_Input = {
 static struct PyMethodDef __pyx_methods[] = {
   {__Pyx_NAMESTR("Initialize"), (PyCFunction)__pyx_pf_4pypm_Initialize, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_Initialize)},
   {__Pyx_NAMESTR("Terminate"), (PyCFunction)__pyx_pf_4pypm_Terminate, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_Terminate)},
+  {__Pyx_NAMESTR("SetPollCallback"), (PyCFunction)__pyx_pf_4pypm_SetPollCallback, METH_VARARGS|METH_KEYWORDS, __Pyx_DOCSTR(__pyx_doc_4pypm_SetPollCallback)},
   {__Pyx_NAMESTR("GetDefaultInputDeviceID"), (PyCFunction)__pyx_pf_4pypm_GetDefaultInputDeviceID, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_GetDefaultInputDeviceID)},
   {__Pyx_NAMESTR("GetDefaultOutputDeviceID"), (PyCFunction)__pyx_pf_4pypm_GetDefaultOutputDeviceID, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_GetDefaultOutputDeviceID)},
   {__Pyx_NAMESTR("CountDevices"), (PyCFunction)__pyx_pf_4pypm_CountDevices, METH_NOARGS, __Pyx_DOCSTR(__pyx_doc_4pypm_CountDevices)},
@@ -4238,6 +5982,15 @@ static __Pyx_StringTabEntry __pyx_string_tab[] = {
   {&__pyx_kp_18, __pyx_k_18, sizeof(__pyx_k_18), 0, 1, 0},
   {&__pyx_kp_tostring, __pyx_k_tostring, sizeof(__pyx_k_tostring), 1, 1, 1},
   {&__pyx_kp_append, __pyx_k_append, sizeof(__pyx_k_append), 1, 1, 1},
+  {&__pyx_kp__poll_callback, __pyx_k__poll_callback, sizeof(__pyx_k__poll_callback), 1, 1, 1},
+  {&__pyx_kp_RECORD_FORMAT, __pyx_k_RECORD_FORMAT, sizeof(__pyx_k_RECORD_FORMAT), 1, 1, 1},
+  {&__pyx_kp_MemoryError, __pyx_k_MemoryError, sizeof(__pyx_k_MemoryError), 1, 1, 1},
+  {&__pyx_kp_callback, __pyx_k_callback, sizeof(__pyx_k_callback), 1, 1, 1},
+  {&__pyx_kp_interval, __pyx_k_interval, sizeof(__pyx_k_interval), 1, 1, 1},
+  {&__pyx_kp_WriteBuffer, __pyx_k_WriteBuffer, sizeof(__pyx_k_WriteBuffer), 1, 1, 1},
+  {&__pyx_kp_ReadInto, __pyx_k_ReadInto, sizeof(__pyx_k_ReadInto), 1, 1, 1},
+  {&__pyx_kp_StartPolling, __pyx_k_StartPolling, sizeof(__pyx_k_StartPolling), 1, 1, 1},
+  {&__pyx_kp_StopPolling, __pyx_k_StopPolling, sizeof(__pyx_k_StopPolling), 1, 1, 1},
   {&__pyx_kp_3, __pyx_k_3, sizeof(__pyx_k_3), 0, 0, 0},
   {&__pyx_kp_7, __pyx_k_7, sizeof(__pyx_k_7), 0, 0, 0},
   {&__pyx_kp_8, __pyx_k_8, sizeof(__pyx_k_8), 0, 0, 0},
@@ -4255,14 +6008,19 @@ static __Pyx_StringTabEntry __pyx_string_tab[] = {
   {&__pyx_kp_21, __pyx_k_21, sizeof(__pyx_k_21), 0, 0, 0},
   {&__pyx_kp_22, __pyx_k_22, sizeof(__pyx_k_22), 0, 0, 0},
   {&__pyx_kp_23, __pyx_k_23, sizeof(__pyx_k_23), 0, 0, 0},
+  {&__pyx_kp_24, __pyx_k_24, sizeof(__pyx_k_24), 0, 0, 0},
+  {&__pyx_kp_25, __pyx_k_25, sizeof(__pyx_k_25), 0, 0, 0},
+  {&__pyx_kp_26, __pyx_k_26, sizeof(__pyx_k_26), 0, 0, 0},
+  {&__pyx_kp_27, __pyx_k_27, sizeof(__pyx_k_27), 0, 0, 0},
   {0, 0, 0, 0, 0, 0}
 };
 static int __Pyx_InitCachedBuiltins(void) {
-  __pyx_builtin_Exception = __Pyx_GetName(__pyx_b, __pyx_kp_Exception); if (!__pyx_builtin_Exception) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 290; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  __pyx_builtin_IndexError = __Pyx_GetName(__pyx_b, __pyx_kp_IndexError); if (!__pyx_builtin_IndexError) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 401; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  __pyx_builtin_enumerate = __Pyx_GetName(__pyx_b, __pyx_kp_enumerate); if (!__pyx_builtin_enumerate) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 403; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  __pyx_builtin_ValueError = __Pyx_GetName(__pyx_b, __pyx_kp_ValueError); if (!__pyx_builtin_ValueError) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 405; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  __pyx_builtin_range = __Pyx_GetName(__pyx_b, __pyx_kp_range); if (!__pyx_builtin_range) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 412; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_builtin_Exception = __Pyx_GetName(__pyx_b, __pyx_kp_Exception); if (!__pyx_builtin_Exception) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 453; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_builtin_IndexError = __Pyx_GetName(__pyx_b, __pyx_kp_IndexError); if (!__pyx_builtin_IndexError) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 564; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_builtin_enumerate = __Pyx_GetName(__pyx_b, __pyx_kp_enumerate); if (!__pyx_builtin_enumerate) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 566; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_builtin_ValueError = __Pyx_GetName(__pyx_b, __pyx_kp_ValueError); if (!__pyx_builtin_ValueError) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 568; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_builtin_range = __Pyx_GetName(__pyx_b, __pyx_kp_range); if (!__pyx_builtin_range) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 575; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  __pyx_builtin_MemoryError = __Pyx_GetName(__pyx_b, __pyx_kp_MemoryError); if (!__pyx_builtin_MemoryError) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 254; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   return 0;
   __pyx_L1_error:;
   return -1;
@@ -4298,6 +6056,7 @@ static int __Pyx_InitGlobals(void) {
   __pyx_int_8 = PyInt_FromLong(8); if (unlikely(!__pyx_int_8)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 1; __pyx_clineno = __LINE__; goto __pyx_L1_error;};
   __pyx_int_0xFF00 = PyInt_FromLong(0xFF00); if (unlikely(!__pyx_int_0xFF00)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 1; __pyx_clineno = __LINE__; goto __pyx_L1_error;};
   __pyx_int_1024 = PyInt_FromLong(1024); if (unlikely(!__pyx_int_1024)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 1; __pyx_clineno = __LINE__; goto __pyx_L1_error;};
+  __pyx_int_32 = PyInt_FromLong(32); if (unlikely(!__pyx_int_32)) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 1; __pyx_clineno = __LINE__; goto __pyx_L1_error;};
   if (__Pyx_InitStrings(__pyx_string_tab) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 1; __pyx_clineno = __LINE__; goto __pyx_L1_error;};
   return 0;
   __pyx_L1_error:;
@@ -4357,11 +6116,11 @@ PyMODINIT_FUNC PyInit_pypm(void)
   /*--- Global init code ---*/
   /*--- Function export code ---*/
   /*--- Type init code ---*/
-  if (PyType_Ready(&__pyx_type_4pypm_Output) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 248; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  if (__Pyx_SetAttrString(__pyx_m, "Output", (PyObject *)&__pyx_type_4pypm_Output) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 248; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyType_Ready(&__pyx_type_4pypm_Output) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 411; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (__Pyx_SetAttrString(__pyx_m, "Output", (PyObject *)&__pyx_type_4pypm_Output) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 411; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_ptype_4pypm_Output = &__pyx_type_4pypm_Output;
-  if (PyType_Ready(&__pyx_type_4pypm_Input) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 509; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-  if (__Pyx_SetAttrString(__pyx_m, "Input", (PyObject *)&__pyx_type_4pypm_Input) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 509; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyType_Ready(&__pyx_type_4pypm_Input) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 717; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (__Pyx_SetAttrString(__pyx_m, "Input", (PyObject *)&__pyx_type_4pypm_Input) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 717; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __pyx_ptype_4pypm_Input = &__pyx_type_4pypm_Input;
   /*--- Type import code ---*/
   /*--- Function import code ---*/
@@ -4370,14 +6129,14 @@ PyMODINIT_FUNC PyInit_pypm(void)
   /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":8
  * # written in Pyrex
  *
- * __version__ = "0.0.6"             # <<<<<<<<<<<<<<
+ * __version__ = "0.0.7"             # <<<<<<<<<<<<<<
  *
  * import array
  */
   if (PyObject_SetAttr(__pyx_m, __pyx_kp___version__, __pyx_kp_3) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 8; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
   /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":10
- * __version__ = "0.0.6"
+ * __version__ = "0.0.7"
  *
  * import array             # <<<<<<<<<<<<<<
  *
@@ -4388,214 +6147,277 @@ PyMODINIT_FUNC PyInit_pypm(void)
   if (PyObject_SetAttr(__pyx_m, __pyx_kp_array, __pyx_1) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 10; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
   __Pyx_DECREF(__pyx_1); __pyx_1 = 0;
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":40
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":44
  *
  *
  * FILT_ACTIVE = 0x1             # <<<<<<<<<<<<<<
  * FILT_SYSEX = 0x2
  * FILT_CLOCK = 0x4
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_ACTIVE, __pyx_int_0x1) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 40; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_ACTIVE, __pyx_int_0x1) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 44; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":41
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":45
  *
  * FILT_ACTIVE = 0x1
  * FILT_SYSEX = 0x2             # <<<<<<<<<<<<<<
  * FILT_CLOCK = 0x4
  * FILT_PLAY = 0x8
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_SYSEX, __pyx_int_0x2) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 41; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_SYSEX, __pyx_int_0x2) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 45; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":42
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":46
  * FILT_ACTIVE = 0x1
  * FILT_SYSEX = 0x2
  * FILT_CLOCK = 0x4             # <<<<<<<<<<<<<<
  * FILT_PLAY = 0x8
  * FILT_F9 = 0x10
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_CLOCK, __pyx_int_0x4) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 42; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_CLOCK, __pyx_int_0x4) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 46; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":43
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":47
  * FILT_SYSEX = 0x2
  * FILT_CLOCK = 0x4
  * FILT_PLAY = 0x8             # <<<<<<<<<<<<<<
  * FILT_F9 = 0x10
  * FILT_TICK = 0x10
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_PLAY, __pyx_int_0x8) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 43; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_PLAY, __pyx_int_0x8) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 47; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":44
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":48
  * FILT_CLOCK = 0x4
  * FILT_PLAY = 0x8
  * FILT_F9 = 0x10             # <<<<<<<<<<<<<<
  * FILT_TICK = 0x10
  * FILT_FD = 0x20
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_4, __pyx_int_0x10) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 44; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_4, __pyx_int_0x10) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 48; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":45
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":49
  * FILT_PLAY = 0x8
  * FILT_F9 = 0x10
  * FILT_TICK = 0x10             # <<<<<<<<<<<<<<
  * FILT_FD = 0x20
  * FILT_UNDEFINED = 0x30
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_TICK, __pyx_int_0x10) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 45; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_TICK, __pyx_int_0x10) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 49; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":46
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":50
  * FILT_F9 = 0x10
  * FILT_TICK = 0x10
  * FILT_FD = 0x20             # <<<<<<<<<<<<<<
  * FILT_UNDEFINED = 0x30
  * FILT_RESET = 0x40
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_FD, __pyx_int_0x20) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 46; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_FD, __pyx_int_0x20) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 50; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":47
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":51
  * FILT_TICK = 0x10
  * FILT_FD = 0x20
  * FILT_UNDEFINED = 0x30             # <<<<<<<<<<<<<<
  * FILT_RESET = 0x40
  * FILT_REALTIME = 0x7F
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_UNDEFINED, __pyx_int_0x30) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 47; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_UNDEFINED, __pyx_int_0x30) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 51; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":48
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":52
  * FILT_FD = 0x20
  * FILT_UNDEFINED = 0x30
  * FILT_RESET = 0x40             # <<<<<<<<<<<<<<
  * FILT_REALTIME = 0x7F
  * FILT_NOTE = 0x80
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_RESET, __pyx_int_0x40) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 48; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_RESET, __pyx_int_0x40) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 52; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":49
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":53
  * FILT_UNDEFINED = 0x30
  * FILT_RESET = 0x40
  * FILT_REALTIME = 0x7F             # <<<<<<<<<<<<<<
  * FILT_NOTE = 0x80
  * FILT_CHANNEL_AFTERTOUCH = 0x100
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_REALTIME, __pyx_int_0x7F) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 49; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_REALTIME, __pyx_int_0x7F) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 53; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":50
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":54
  * FILT_RESET = 0x40
  * FILT_REALTIME = 0x7F
  * FILT_NOTE = 0x80             # <<<<<<<<<<<<<<
  * FILT_CHANNEL_AFTERTOUCH = 0x100
  * FILT_POLY_AFTERTOUCH = 0x200
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_NOTE, __pyx_int_0x80) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 50; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_NOTE, __pyx_int_0x80) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 54; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":51
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":55
  * FILT_REALTIME = 0x7F
  * FILT_NOTE = 0x80
  * FILT_CHANNEL_AFTERTOUCH = 0x100             # <<<<<<<<<<<<<<
  * FILT_POLY_AFTERTOUCH = 0x200
  * FILT_AFTERTOUCH = 0x300
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_5, __pyx_int_0x100) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 51; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_5, __pyx_int_0x100) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 55; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":52
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":56
  * FILT_NOTE = 0x80
  * FILT_CHANNEL_AFTERTOUCH = 0x100
  * FILT_POLY_AFTERTOUCH = 0x200             # <<<<<<<<<<<<<<
  * FILT_AFTERTOUCH = 0x300
  * FILT_PROGRAM = 0x400
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_6, __pyx_int_0x200) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 52; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_6, __pyx_int_0x200) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 56; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":53
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":57
  * FILT_CHANNEL_AFTERTOUCH = 0x100
  * FILT_POLY_AFTERTOUCH = 0x200
  * FILT_AFTERTOUCH = 0x300             # <<<<<<<<<<<<<<
  * FILT_PROGRAM = 0x400
  * FILT_CONTROL = 0x800
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_AFTERTOUCH, __pyx_int_0x300) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 53; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_AFTERTOUCH, __pyx_int_0x300) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 57; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":54
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":58
  * FILT_POLY_AFTERTOUCH = 0x200
  * FILT_AFTERTOUCH = 0x300
  * FILT_PROGRAM = 0x400             # <<<<<<<<<<<<<<
  * FILT_CONTROL = 0x800
  * FILT_PITCHBEND = 0x1000
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_PROGRAM, __pyx_int_0x400) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 54; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_PROGRAM, __pyx_int_0x400) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 58; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":55
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":59
  * FILT_AFTERTOUCH = 0x300
  * FILT_PROGRAM = 0x400
  * FILT_CONTROL = 0x800             # <<<<<<<<<<<<<<
  * FILT_PITCHBEND = 0x1000
  * FILT_MTC = 0x2000
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_CONTROL, __pyx_int_0x800) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 55; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_CONTROL, __pyx_int_0x800) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 59; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":56
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":60
  * FILT_PROGRAM = 0x400
  * FILT_CONTROL = 0x800
  * FILT_PITCHBEND = 0x1000             # <<<<<<<<<<<<<<
  * FILT_MTC = 0x2000
  * FILT_SONG_POSITION = 0x4000
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_PITCHBEND, __pyx_int_0x1000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 56; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_PITCHBEND, __pyx_int_0x1000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 60; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":57
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":61
  * FILT_CONTROL = 0x800
  * FILT_PITCHBEND = 0x1000
  * FILT_MTC = 0x2000             # <<<<<<<<<<<<<<
  * FILT_SONG_POSITION = 0x4000
  * FILT_SONG_SELECT = 0x8000
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_MTC, __pyx_int_0x2000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 57; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_MTC, __pyx_int_0x2000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 61; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":58
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":62
  * FILT_PITCHBEND = 0x1000
  * FILT_MTC = 0x2000
  * FILT_SONG_POSITION = 0x4000             # <<<<<<<<<<<<<<
  * FILT_SONG_SELECT = 0x8000
  * FILT_TUNE = 0x10000
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_SONG_POSITION, __pyx_int_0x4000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 58; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_SONG_POSITION, __pyx_int_0x4000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 62; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":59
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":63
  * FILT_MTC = 0x2000
  * FILT_SONG_POSITION = 0x4000
  * FILT_SONG_SELECT = 0x8000             # <<<<<<<<<<<<<<
  * FILT_TUNE = 0x10000
  * FALSE = 0
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_SONG_SELECT, __pyx_int_0x8000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 59; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_SONG_SELECT, __pyx_int_0x8000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 63; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":60
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":64
  * FILT_SONG_POSITION = 0x4000
  * FILT_SONG_SELECT = 0x8000
  * FILT_TUNE = 0x10000             # <<<<<<<<<<<<<<
  * FALSE = 0
  * TRUE = 1
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_TUNE, __pyx_int_0x10000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 60; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FILT_TUNE, __pyx_int_0x10000) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 64; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":61
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":65
  * FILT_SONG_SELECT = 0x8000
  * FILT_TUNE = 0x10000
  * FALSE = 0             # <<<<<<<<<<<<<<
  * TRUE = 1
  *
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FALSE, __pyx_int_0) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 61; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_FALSE, __pyx_int_0) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 65; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
 
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":62
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":66
  * FILT_TUNE = 0x10000
  * FALSE = 0
  * TRUE = 1             # <<<<<<<<<<<<<<
  *
  * cdef extern from "portmidi.h":
  */
-  if (PyObject_SetAttr(__pyx_m, __pyx_kp_TRUE, __pyx_int_1) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 62; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
-
-  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":664
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_TRUE, __pyx_int_1) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 66; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":177
+   *     int timestamp
+   *
+   * RECORD_FORMAT = "=Ii"             # <<<<<<<<<<<<<<
+   *
+   *
+   */
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp_RECORD_FORMAT, __pyx_kp_24) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 177; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":195
+   * cdef SDL_mutex *_poll_lock
+   * cdef SDL_Thread *_poll_thread
+   * _poll_count = 0             # <<<<<<<<<<<<<<
+   * _poll_running = 0
+   * _poll_interval = 1
+   */
+  __pyx_v_4pypm__poll_count = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":196
+   * cdef SDL_Thread *_poll_thread
+   * _poll_count = 0
+   * _poll_running = 0             # <<<<<<<<<<<<<<
+   * _poll_interval = 1
+   * _poll_lock = NULL
+   */
+  __pyx_v_4pypm__poll_running = 0;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":197
+   * _poll_count = 0
+   * _poll_running = 0
+   * _poll_interval = 1             # <<<<<<<<<<<<<<
+   * _poll_lock = NULL
+   * _poll_thread = NULL
+   */
+  __pyx_v_4pypm__poll_interval = 1;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":198
+   * _poll_running = 0
+   * _poll_interval = 1
+   * _poll_lock = NULL             # <<<<<<<<<<<<<<
+   * _poll_thread = NULL
+   * _poll_callback = None
+   */
+  __pyx_v_4pypm__poll_lock = NULL;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":199
+   * _poll_interval = 1
+   * _poll_lock = NULL
+   * _poll_thread = NULL             # <<<<<<<<<<<<<<
+   * _poll_callback = None
+   *
+   */
+  __pyx_v_4pypm__poll_thread = NULL;
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":200
+   * _poll_lock = NULL
+   * _poll_thread = NULL
+   * _poll_callback = None             # <<<<<<<<<<<<<<
+   *
+   * cdef void _poll_read(int index) with gil:
+   */
+  if (PyObject_SetAttr(__pyx_m, __pyx_kp__poll_callback, Py_None) < 0) {__pyx_filename = __pyx_f[0]; __pyx_lineno = 200; __pyx_clineno = __LINE__; goto __pyx_L1_error;}
+
+  /* "/home/rene/dev/pygame/pygame/trunk/src/pypm.pyx":874
  *         return err
  *
  *     def Read(self, max_events):             # <<<<<<<<<<<<<<
@@ -5341,6 +7163,24 @@ static INLINE signed PY_LONG_LONG __Pyx_PyInt_AsSignedLongLong(PyObject* x) {
 #include "frameobject.h"
 #include "traceback.h"
 
+static void __Pyx_WriteUnraisable(const char *name) {
+    PyObject *old_exc, *old_val, *old_tb;
+    PyObject *ctx;
+    __Pyx_ErrFetch(&old_exc, &old_val, &old_tb);
+    #if PY_MAJOR_VERSION < 3
+    ctx = PyString_FromString(name);
+    #else
+    ctx = PyUnicode_FromString(name);
+    #endif
+    __Pyx_ErrRestore(old_exc, old_val, old_tb);
+    if (!ctx) {
+        PyErr_WriteUnraisable(Py_None);
+    } else {
+        PyErr_WriteUnraisable(ctx);
+        Py_DECREF(ctx);
+    }
+}
+
 static void __Pyx_AddTraceback(const char *funcname) {
     PyObject *py_srcfile = 0;
     PyObject *py_funcname = 0;
@@ -5,12 +5,16 @@
 # harrison@media.mit.edu
 # written in Pyrex
 
-__version__ = "0.0.6"
+__version__ = "0.0.7"
 
 import array
 
 # CHANGES:
 
+# 0.0.7:
+#   Added Input.ReadInto and Output.WriteBuffer for packed event buffers
+#   Added a poll thread handing input to a callback, Input.StartPolling
+
 # 0.0.6: (Feb 25, 2011) christopher arndt <chris@chrisarndt.de>
 #   Do not try to close device in Input/Output.__dealloc__ if not open
 #   Major code layout clean up
@@ -125,7 +129,7 @@ cdef extern from "portmidi.h":
         PmTimestamp timestamp
 
     PmError Pm_Read(PortMidiStream *stream, PmEvent *buffer, long length)
-    PmError Pm_Poll(PortMidiStream *stream)
+    PmError Pm_Poll(PortMidiStream *stream) nogil
     int Pm_Channel(int channel)
     PmError Pm_SetChannelMask(PortMidiStream *stream, int mask)
     PmError Pm_Write(PortMidiStream *stream, PmEvent *buffer, long length)
@@ -145,6 +149,145 @@ cdef extern from "porttime.h":
     PtError Pt_Start(int resolution, PtCallback *callback, void *userData)
     PtTimestamp Pt_Time()
 
+cdef extern from "Python.h":
+    int PyObject_AsReadBuffer(object obj, void **buffer,
+                              Py_ssize_t *buffer_len) except -1
+    int PyObject_AsWriteBuffer(object obj, void **buffer,
+                               Py_ssize_t *buffer_len) except -1
+
+cdef extern from "SDL_thread.h":
+    ctypedef struct SDL_Thread
+    ctypedef struct SDL_mutex
+    SDL_Thread *SDL_CreateThread(int (*fn)(void *), void *data)
+    void SDL_WaitThread(SDL_Thread *thread, int *status) nogil
+    SDL_mutex *SDL_CreateMutex()
+    int SDL_mutexP(SDL_mutex *mutex) nogil
+    int SDL_mutexV(SDL_mutex *mutex) nogil
+
+cdef extern from "SDL_timer.h":
+    void SDL_Delay(unsigned int ms) nogil
+
+
+# An event of ReadInto and WriteBuffer: the message bytes, status first from
+# the low byte, then the timestamp, as "=Ii" in struct notation.
+cdef struct MidiRecord:
+    unsigned int message
+    int timestamp
+
+RECORD_FORMAT = "=Ii"
+
+
+# The poll thread: every _poll_interval ms it polls the Inputs that called
+# StartPolling, and hands the events of each that has any to
+# _poll_callback(device, events), with the events as Read gives them. The
+# lock guards the list of streams; it is taken with the GIL released, as
+# the thread takes the GIL to call back while holding it. SDL mutexes are
+# recursive, so the callback may stop polling an Input.
+DEF MAX_POLLED = 32
+
+cdef PmStream *_poll_streams[MAX_POLLED]
+cdef int _poll_devices[MAX_POLLED]
+cdef int _poll_count
+cdef int _poll_running
+cdef int _poll_interval
+cdef SDL_mutex *_poll_lock
+cdef SDL_Thread *_poll_thread
+_poll_count = 0
+_poll_running = 0
+_poll_interval = 1
+_poll_lock = NULL
+_poll_thread = NULL
+_poll_callback = None
+
+cdef void _poll_read(int index) with gil:
+    cdef PmEvent buffer[1024]
+    cdef int num_events
+    cdef int ev_no
+
+    num_events = Pm_Read(_poll_streams[index], buffer, 1024)
+    if num_events <= 0 or _poll_callback is None:
+        return
+    events = []
+    for ev_no in range(num_events):
+        events.append([[buffer[ev_no].message & 0xFF,
+                        (buffer[ev_no].message >> 8) & 0xFF,
+                        (buffer[ev_no].message >> 16) & 0xFF,
+                        (buffer[ev_no].message >> 24) & 0xFF],
+                       buffer[ev_no].timestamp])
+    _poll_callback(_poll_devices[index], events)
+
+cdef int _poll_run(void *data) nogil:
+    global _poll_running
+    cdef int i
+
+    while _poll_running:
+        SDL_mutexP(_poll_lock)
+        # the callback may stop the polling of an Input, so the count is
+        # read again each time
+        i = 0
+        while i < _poll_count:
+            if Pm_Poll(_poll_streams[i]) > 0:
+                _poll_read(i)
+            i = i + 1
+        # the thread ends with the last Input; _poll_add starts another
+        if _poll_count == 0:
+            _poll_running = 0
+        SDL_mutexV(_poll_lock)
+        if _poll_running:
+            SDL_Delay(_poll_interval)
+    return 0
+
+cdef _poll_stop():
+    global _poll_running, _poll_thread
+    _poll_running = 0
+    if _poll_thread != NULL:
+        with nogil:
+            SDL_WaitThread(_poll_thread, NULL)
+        _poll_thread = NULL
+
+cdef _poll_add(PmStream *midi, int device):
+    global _poll_count, _poll_running, _poll_lock, _poll_thread
+    cdef int restart
+    if _poll_lock == NULL:
+        _poll_lock = SDL_CreateMutex()
+        if _poll_lock == NULL:
+            raise MemoryError()
+    with nogil:
+        SDL_mutexP(_poll_lock)
+    if _poll_count == MAX_POLLED:
+        SDL_mutexV(_poll_lock)
+        raise IndexError('Maximum number of polled inputs is %i.'
+                         % MAX_POLLED)
+    _poll_streams[_poll_count] = midi
+    _poll_devices[_poll_count] = device
+    _poll_count = _poll_count + 1
+    restart = _poll_thread == NULL or not _poll_running
+    SDL_mutexV(_poll_lock)
+    if restart:
+        _poll_stop()
+        _poll_running = 1
+        _poll_thread = SDL_CreateThread(_poll_run, NULL)
+        if _poll_thread == NULL:
+            _poll_running = 0
+            raise Exception("Could not start the MIDI poll thread.")
+
+cdef _poll_remove(PmStream *midi):
+    global _poll_count
+    cdef int i
+    if _poll_lock == NULL:
+        return
+    with nogil:
+        SDL_mutexP(_poll_lock)
+    i = 0
+    while i < _poll_count:
+        if _poll_streams[i] == midi:
+            _poll_count = _poll_count - 1
+            _poll_streams[i] = _poll_streams[_poll_count]
+            _poll_devices[i] = _poll_devices[_poll_count]
+        else:
+            i = i + 1
+    SDL_mutexV(_poll_lock)
+
 
 def Initialize():
     """Initialize PortMidi library.
@@ -166,8 +309,28 @@ def Terminate():
     your system may crash.
 
     """
+    _poll_stop()
     Pm_Terminate()
 
+def SetPollCallback(callback, interval=1):
+    """Set the function the poll thread hands input to.
+
+    Usage::
+
+        SetPollCallback(callback, interval)
+
+    While any Input is polled, see Input.StartPolling, a native thread polls
+    them every interval ms and calls callback(device, events) for each with
+    input, with events a list as Input.Read returns. The callback is called
+    from the poll thread. Exceptions it raises are printed and ignored.
+
+    """
+    global _poll_callback, _poll_interval
+    if interval < 1:
+        raise ValueError('Minimum poll interval is 1 ms.')
+    _poll_callback = callback
+    _poll_interval = interval
+
 def GetDefaultInputDeviceID():
     """Return the number of the default MIDI input device.
 
@@ -465,6 +628,51 @@ cdef class Output:
         if err < 0:
             raise Exception(Pm_GetErrorText(err))
 
+    def WriteBuffer(self, data):
+        """Output the MIDI events packed in a buffer object on this device.
+
+        Usage::
+
+            WriteBuffer(data)
+
+        data is an object with the buffer interface, such as a bytearray,
+        array or string, holding events as RECORD_FORMAT structs: the
+        message as an unsigned 32 bit integer, status in the low byte,
+        and the timestamp as a 32 bit integer. Any bytes after the last
+        whole event are ignored. There is no limit on the number of events.
+        Returns the number of events written.
+
+        """
+        cdef void *buf
+        cdef Py_ssize_t size
+        cdef MidiRecord *records
+        cdef PmEvent buffer[1024]
+        cdef PmError err
+        cdef int count
+        cdef int done
+        cdef int num
+        cdef int ev_no
+
+        self._check_open()
+
+        PyObject_AsReadBuffer(data, &buf, &size)
+        records = <MidiRecord *> buf
+        count = size / sizeof(MidiRecord)
+        done = 0
+        while done < count:
+            num = count - done
+            if num > 1024:
+                num = 1024
+            for ev_no in range(num):
+                buffer[ev_no].message = records[done + ev_no].message
+                buffer[ev_no].timestamp = records[done + ev_no].timestamp
+            err = Pm_Write(self.midi, buffer, num)
+            if err < 0:
+                raise Exception(Pm_GetErrorText(err))
+            done = done + num
+
+        return count
+
     def WriteSysEx(self, when, msg):
         """Output a timestamped system-exclusive MIDI message on this device.
 
@@ -542,6 +750,7 @@ cdef class Input:
             print "Closing MIDI input stream and destroying instance"
 
         if self.midi:
+            _poll_remove(self.midi)
             err = Pm_Close(self.midi)
             if err < 0:
                 raise Exception(Pm_GetErrorText(err))
@@ -569,6 +778,7 @@ cdef class Input:
             return
 
         if self.midi:
+            _poll_remove(self.midi)
             err = Pm_Close(self.midi)
             if err < 0:
                 raise Exception(Pm_GetErrorText(err))
@@ -704,3 +914,68 @@ cdef class Input:
                 )
 
         return events
+
+    def ReadInto(self, data):
+        """Read events from input into a writable buffer object.
+
+        Usage::
+
+            ReadInto(data)
+
+        Reads as many events as fit in data, a writable object with the
+        buffer interface such as a bytearray or array, as RECORD_FORMAT
+        structs: the message as an unsigned 32 bit integer, status in the
+        low byte, and the timestamp as a 32 bit integer. Returns the number
+        of events read. Reading into the same buffer each time makes no
+        Python objects for the events.
+
+        """
+        cdef void *buf
+        cdef Py_ssize_t size
+        cdef MidiRecord *records
+        cdef PmEvent buffer[1024]
+        cdef PmError num_events
+        cdef int count
+        cdef int done
+        cdef int num
+        cdef int ev_no
+
+        self._check_open()
+
+        PyObject_AsWriteBuffer(data, &buf, &size)
+        records = <MidiRecord *> buf
+        count = size / sizeof(MidiRecord)
+        done = 0
+        while done < count:
+            num = count - done
+            if num > 1024:
+                num = 1024
+            num_events = Pm_Read(self.midi, buffer, num)
+            if num_events < 0:
+                raise Exception(Pm_GetErrorText(num_events))
+            for ev_no in range(num_events):
+                records[done + ev_no].message = buffer[ev_no].message
+                records[done + ev_no].timestamp = buffer[ev_no].timestamp
+            done = done + num_events
+            if num_events < num:
+                break
+
+        return done
+
+    def StartPolling(self):
+        """Have the poll thread read this input.
+
+        The events are handed to the function given to SetPollCallback,
+        from the poll thread, which starts with the first input polled.
+        Do not Read from the input while it is polled.
+
+        """
+        self._check_open()
+        _poll_remove(self.midi)
+        _poll_add(self.midi, self.device)
+
+    def StopPolling(self):
+        """Stop the poll thread reading this input."""
+
+        if self.midi:
+            _poll_remove(self.midi)
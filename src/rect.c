@@ -28,6 +28,7 @@
 #include "doc/rect_doc.h"
 #include "structmember.h"
 #include "pgcompat.h"
+#include "pgfreelist.h"
 
 static PyTypeObject PyRect_Type;
 #define PyRect_Check(x) ((x)->ob_type == &PyRect_Type)
@@ -35,6 +36,31 @@ static PyTypeObject PyRect_Type;
 static PyObject* rect_new (PyTypeObject *type, PyObject *args, PyObject *kwds);
 static int rect_init (PyRectObject *self, PyObject *args, PyObject *kwds);
 
+/* Memory of dead Rects, reused by the next new ones */
+static PgFreeList rect_freelist = PG_FREELIST_INIT (NULL);
+
+/* A RectArray keeps its rects packed as x, y, w, h ints, so the bulk
+   operations and the Rect methods taking a list of rects can loop over
+   them without converting each one. */
+typedef struct {
+    PyObject_HEAD
+    GAME_Rect *rects;
+    Py_ssize_t len;
+    Py_ssize_t alloc;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    int exports;
+    PyObject *weakreflist;
+} PyRectArrayObject;
+
+static PyTypeObject PyRectArray_Type;
+#define PyRectArray_Check(x) (PyObject_TypeCheck (x, &PyRectArray_Type))
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define RECT_SSE2
+#include <emmintrin.h>
+#endif
+
 PyObject*
 rect_subtype_new4 (PyTypeObject *type, int x, int y, int w, int h)
 {
@@ -167,6 +193,393 @@ DoRectsIntersect (GAME_Rect *A, GAME_Rect *B)
             A->x + A->w > B->x && A->y + A->h > B->y);
 }
 
+/* Store in hits the indices of the first maxhits of the n rects for which
+   x, y, -(x + w) and -(y + h) are all below k[0] to k[3], returning how
+   many there were.  Both the point and the rect tests come down to this,
+   and SSE2 does it with a single compare of the rect. */
+static int
+RectsBelow (const GAME_Rect *rects, int n, const int k[4], int *hits,
+            int maxhits)
+{
+    int i, count = 0;
+#ifdef RECT_SSE2
+    const __m128i vk = _mm_set_epi32 (k[3], k[2], k[1], k[0]);
+    const __m128i neg = _mm_set_epi32 (-1, -1, 0, 0);
+    __m128i v;
+
+    for (i = 0; i < n && count < maxhits; i++)
+    {
+        v = _mm_loadu_si128 ((const __m128i*) (rects + i));
+        v = _mm_add_epi32 (v, _mm_slli_si128 (v, 8));
+        v = _mm_sub_epi32 (_mm_xor_si128 (v, neg), neg);
+        if (_mm_movemask_epi8 (_mm_cmpgt_epi32 (vk, v)) == 0xffff)
+            hits[count++] = i;
+    }
+#else
+    const GAME_Rect *r;
+
+    for (i = 0, r = rects; i < n && count < maxhits; i++, r++)
+    {
+        if (r->x < k[0] && r->y < k[1] &&
+            -(r->x + r->w) < k[2] && -(r->y + r->h) < k[3])
+            hits[count++] = i;
+    }
+#endif
+    return count;
+}
+
+/* The k of RectsBelow for the rects which intersect rect */
+static void
+RectsBelowRect (GAME_Rect *rect, int k[4])
+{
+    k[0] = rect->x + rect->w;
+    k[1] = rect->y + rect->h;
+    k[2] = -rect->x;
+    k[3] = -rect->y;
+}
+
+/* The part of A inside B, or A's position with no size, in C */
+static void
+DoRectClip (GAME_Rect *A, GAME_Rect *B, GAME_Rect *C)
+{
+    int x, y, w, h;
+
+    /* Left */
+    if ((A->x >= B->x) && (A->x < (B->x + B->w)))
+        x = A->x;
+    else if ((B->x >= A->x) && (B->x < (A->x + A->w)))
+        x = B->x;
+    else
+        goto nointersect;
+
+    /* Right */
+    if (((A->x + A->w) > B->x) && ((A->x + A->w) <= (B->x + B->w)))
+        w = (A->x + A->w) - x;
+    else if (((B->x + B->w) > A->x) && ((B->x + B->w) <= (A->x + A->w)))
+        w = (B->x + B->w) - x;
+    else
+        goto nointersect;
+
+    /* Top */
+    if ((A->y >= B->y) && (A->y < (B->y + B->h)))
+        y = A->y;
+    else if ((B->y >= A->y) && (B->y < (A->y + A->h)))
+        y = B->y;
+    else
+        goto nointersect;
+
+    /* Bottom */
+    if (((A->y + A->h) > B->y) && ((A->y + A->h) <= (B->y + B->h)))
+        h = (A->y + A->h) - y;
+    else if (((B->y + B->h) > A->y) && ((B->y + B->h) <= (A->y + A->h)))
+        h = (B->y + B->h) - y;
+    else
+        goto nointersect;
+
+    C->x = x;
+    C->y = y;
+    C->w = w;
+    C->h = h;
+    return;
+
+nointersect:
+    C->x = A->x;
+    C->y = A->y;
+    C->w = 0;
+    C->h = 0;
+}
+
+/* Grow l, t, r and b to take in the n rects */
+static void
+RectsUnion (const GAME_Rect *rects, Py_ssize_t n, int *l, int *t, int *r,
+            int *b)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        *l = MIN (*l, rects[i].x);
+        *t = MIN (*t, rects[i].y);
+        *r = MAX (*r, rects[i].x + rects[i].w);
+        *b = MAX (*b, rects[i].y + rects[i].h);
+    }
+}
+
+/* How many rects of a sequence the list methods read and test at once */
+#define RECT_BATCH 64
+
+/* Put the rects of up to n items of the fast sequence seq, from start,
+   in rects, and return how many were read. A Rect is copied without a
+   conversion. With a key the rect of an item is key(item), or the
+   attribute named by key when it isn't callable. On a bad item an
+   exception is set and the count of the items before it returned. */
+static Py_ssize_t
+RectsFromSeq (PyObject *seq, Py_ssize_t start, Py_ssize_t n, PyObject *key,
+              GAME_Rect *rects)
+{
+    PyObject *item, *obj;
+    GAME_Rect *argrect;
+    Py_ssize_t i;
+
+    for (i = 0; i < n && start + i < PySequence_Fast_GET_SIZE (seq); i++)
+    {
+        item = PySequence_Fast_GET_ITEM (seq, start + i);
+        if (!key && PyRect_Check (item))
+        {
+            rects[i] = ((PyRectObject*) item)->r;
+            continue;
+        }
+
+        /* Converting can run Python code which changes the sequence */
+        Py_INCREF (item);
+        if (!key)
+            obj = item;
+        else
+        {
+            if (PyCallable_Check (key))
+                obj = PyObject_CallFunctionObjArgs (key, item, NULL);
+            else
+                obj = PyObject_GetAttr (item, key);
+            Py_DECREF (item);
+            if (!obj)
+                return i;
+        }
+        argrect = GameRect_FromObject (obj, rects + i);
+        if (argrect)
+            rects[i] = *argrect;
+        Py_DECREF (obj);
+        if (!argrect)
+        {
+            RAISE (PyExc_TypeError,
+                   "Argument must be a sequence of rectstyle objects.");
+            return i;
+        }
+    }
+    return i;
+}
+
+/* A list of the indices of all the n rects RectsBelow finds for k */
+static PyObject*
+RectsBelowList (const GAME_Rect *rects, int n, const int k[4])
+{
+    PyObject *list, *num;
+    int *hits, count, i;
+
+    hits = (int*) malloc (sizeof (int) * (n ? n : 1));
+    if (!hits)
+        return PyErr_NoMemory ();
+    count = RectsBelow (rects, n, k, hits, n);
+
+    list = PyList_New (count);
+    for (i = 0; list && i < count; i++)
+    {
+        num = PyInt_FromLong (hits[i]);
+        if (!num)
+        {
+            Py_DECREF (list);
+            list = NULL;
+            break;
+        }
+        PyList_SET_ITEM (list, i, num);
+    }
+    free (hits);
+    return list;
+}
+
+/* Padding after the rects of a sweep, which no rect collides with */
+#define SWEEP_PAD 4
+
+/* Sort the order of the n rects on x, ties in index order, by radix
+   sorting a byte of x at a time. keys and order have room for 2n, and
+   the sorted order is returned from one of the halves of order. */
+static int*
+SortOnX (const GAME_Rect *rects, int n, unsigned int *keys, int *order)
+{
+    unsigned int *keys2 = keys + n, *swapk;
+    int *order2 = order + n, *swapo;
+    int count[256], shift, i, sum, c;
+
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (unsigned int) rects[i].x ^ 0x80000000u;
+        order[i] = i;
+    }
+    for (shift = 0; n && shift < 32; shift += 8)
+    {
+        memset (count, 0, sizeof (count));
+        for (i = 0; i < n; i++)
+            count[(keys[i] >> shift) & 0xff]++;
+        if (count[(keys[0] >> shift) & 0xff] == n)
+            continue; /* all the keys share this byte */
+        for (i = 0, sum = 0; i < 256; i++)
+        {
+            c = count[i];
+            count[i] = sum;
+            sum += c;
+        }
+        for (i = 0; i < n; i++)
+        {
+            c = count[(keys[i] >> shift) & 0xff]++;
+            keys2[c] = keys[i];
+            order2[c] = order[i];
+        }
+        swapk = keys;
+        keys = keys2;
+        keys2 = swapk;
+        swapo = order;
+        order = order2;
+        order2 = swapo;
+    }
+    return order;
+}
+
+/* Find every pair of the n rects which DoRectsIntersect. They are sorted
+   on x once, and each is then only tested against the rects after it
+   which start before its right edge, four at a time with SSE2. The
+   pairs go in a malloced *pairs as the lower index and then the higher
+   one. Returns how many pairs there are, or -1 when out of memory.
+   Touches no Python objects, so the GIL can be released. */
+static Py_ssize_t
+RectsCollidePairs (const GAME_Rect *rects, Py_ssize_t n, int **pairs)
+{
+    Py_ssize_t count = 0, alloc = n > 8 ? n : 8;
+    int *block, *x, *r, *y, *b, *index, *order, *out, *grown;
+    int i, j, k, m, ax, ar, ay, ab, step = (int) n + SWEEP_PAD;
+
+    if (n > INT_MAX - SWEEP_PAD)
+        return -1;
+    /* the sort keeps its keys and order in the first 4n ints */
+    block = (int*) malloc (sizeof (int) * 5 * (size_t) step);
+    out = (int*) malloc (sizeof (int) * 2 * alloc);
+    if (!block || !out)
+    {
+        free (block);
+        free (out);
+        return -1;
+    }
+    x = block;
+    r = x + step;
+    y = r + step;
+    b = y + step;
+    index = b + step;
+    order = SortOnX (rects, (int) n, (unsigned int*) block + 2 * n,
+                     block);
+    /* order is in the first 2n ints, so it is clear of index */
+    for (i = 0; i < n; i++)
+        index[i] = order[i];
+    for (i = 0; i < n; i++)
+    {
+        k = index[i];
+        x[i] = rects[k].x;
+        r[i] = rects[k].x + rects[k].w;
+        y[i] = rects[k].y;
+        b[i] = rects[k].y + rects[k].h;
+    }
+    for (i = (int) n; i < step; i++)
+    {
+        x[i] = INT_MAX;
+        r[i] = y[i] = b[i] = INT_MIN;
+        index[i] = 0;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        ax = x[i];
+        ar = r[i];
+        ay = y[i];
+        ab = b[i];
+#ifdef RECT_SSE2
+        {
+            const __m128i vax = _mm_set1_epi32 (ax), var = _mm_set1_epi32 (ar);
+            const __m128i vay = _mm_set1_epi32 (ay), vab = _mm_set1_epi32 (ab);
+            __m128i in;
+            int xm;
+
+            for (j = i + 1; ; j += 4)
+            {
+                /* the x order makes c->x >= ax, leaving c->x < ar */
+                in = _mm_cmpgt_epi32 (var,
+                                      _mm_loadu_si128 ((__m128i*) (x + j)));
+                xm = _mm_movemask_ps (_mm_castsi128_ps (in));
+                if (!xm)
+                    break;
+                in = _mm_and_si128 (in, _mm_cmpgt_epi32 (
+                    _mm_loadu_si128 ((__m128i*) (r + j)), vax));
+                in = _mm_and_si128 (in, _mm_cmpgt_epi32 (
+                    _mm_loadu_si128 ((__m128i*) (b + j)), vay));
+                in = _mm_and_si128 (in, _mm_cmpgt_epi32 (
+                    vab, _mm_loadu_si128 ((__m128i*) (y + j))));
+                m = _mm_movemask_ps (_mm_castsi128_ps (in));
+                for (k = 0; m; k++, m >>= 1)
+                {
+                    if (!(m & 1))
+                        continue;
+                    if (count == alloc)
+                    {
+                        alloc *= 2;
+                        grown = (int*) realloc (out, sizeof (int) * 2 * alloc);
+                        if (!grown)
+                            goto nomemory;
+                        out = grown;
+                    }
+                    out[2 * count] = MIN (index[i], index[j + k]);
+                    out[2 * count + 1] = MAX (index[i], index[j + k]);
+                    count++;
+                }
+                if (xm != 0xf)
+                    break;
+            }
+        }
+#else
+        for (j = i + 1; x[j] < ar; j++)
+        {
+            if (ax >= r[j] || ay >= b[j] || y[j] >= ab)
+                continue;
+            if (count == alloc)
+            {
+                alloc *= 2;
+                grown = (int*) realloc (out, sizeof (int) * 2 * alloc);
+                if (!grown)
+                    goto nomemory;
+                out = grown;
+            }
+            out[2 * count] = MIN (index[i], index[j]);
+            out[2 * count + 1] = MAX (index[i], index[j]);
+            count++;
+        }
+#endif
+    }
+    free (block);
+    *pairs = out;
+    return count;
+
+nomemory:
+    free (block);
+    free (out);
+    return -1;
+}
+
+/* An array.array('i') of the n ints at values */
+static PyObject*
+RectIntArray (const int *values, Py_ssize_t n)
+{
+    PyObject *arraymodule, *bytes, *array;
+
+    arraymodule = PyImport_ImportModule ("array");
+    if (!arraymodule)
+        return NULL;
+    bytes = Bytes_FromStringAndSize ((char*) values, sizeof (int) * n);
+    if (!bytes)
+    {
+        Py_DECREF (arraymodule);
+        return NULL;
+    }
+    array = PyObject_CallMethod (arraymodule, "array", "sO", "i", bytes);
+    Py_DECREF (bytes);
+    Py_DECREF (arraymodule);
+    return array;
+}
+
 static PyObject*
 rect_normalize (PyObject* oself)
 {
@@ -280,100 +693,86 @@ rect_union_ip (PyObject* oself, PyObject* args)
     Py_RETURN_NONE;
 }
 
+/* Grow l, t, r and b to take in the rects of list, or of its items
+   through key. Returns 0 with an exception set on failure. */
+static int
+RectsUnionSeq (PyObject *list, PyObject *key, int *l, int *t, int *r, int *b)
+{
+    GAME_Rect rects[RECT_BATCH];
+    PyObject *seq;
+    Py_ssize_t start, n;
+
+    if (!key && PyRectArray_Check (list))
+    {
+        RectsUnion (((PyRectArrayObject*) list)->rects,
+                    ((PyRectArrayObject*) list)->len, l, t, r, b);
+        return 1;
+    }
+    if (!PySequence_Check (list))
+    {
+        RAISE (PyExc_TypeError,
+               "Argument must be a sequence of rectstyle objects.");
+        return 0;
+    }
+    seq = PySequence_Fast (list,
+                           "Argument must be a sequence of rectstyle objects.");
+    if (!seq)
+        return 0;
+    for (start = 0; start < PySequence_Fast_GET_SIZE (seq); start += n)
+    {
+        n = RectsFromSeq (seq, start, RECT_BATCH, key, rects);
+        if (PyErr_Occurred ())
+        {
+            Py_DECREF (seq);
+            return 0;
+        }
+        RectsUnion (rects, n, l, t, r, b);
+    }
+    Py_DECREF (seq);
+    return 1;
+}
+
 static PyObject*
-rect_unionall (PyObject* oself, PyObject* args)
+rect_unionall (PyObject* oself, PyObject* args, PyObject* kwds)
 {
     PyRectObject* self = (PyRectObject*)oself;
-    GAME_Rect *argrect, temp;
-    int loop, size;
-    PyObject* list, *obj;
+    PyObject* list, *key = NULL;
     int t, l, b, r;
+    static char *kwids[] = {"list", "key", NULL};
 
-    if (!PyArg_ParseTuple (args, "O", &list))
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|O", kwids, &list, &key))
         return NULL;
-    if (!PySequence_Check (list))
-        return RAISE (PyExc_TypeError,
-                      "Argument must be a sequence of rectstyle objects.");
+    if (key == Py_None)
+        key = NULL;
 
     l = self->r.x;
     t = self->r.y;
     r = self->r.x + self->r.w;
     b = self->r.y + self->r.h;
-    size = PySequence_Length (list); /*warning, size could be -1 on error?*/
-    if (size < 1) {
-        if (size < 0) {
-            /*Error.*/
-            return NULL;
-        }
-        /*Empty list: nothing to be done.*/
-        return rect_subtype_new4 (Py_TYPE (oself), l, t, r-l, b-t);
-    }
-
-    for (loop = 0; loop < size; ++loop)
-    {
-        obj = PySequence_GetItem (list, loop);
-        if(!obj || !(argrect = GameRect_FromObject (obj, &temp)))
-        {
-            RAISE (PyExc_TypeError,
-                   "Argument must be a sequence of rectstyle objects.");
-            Py_XDECREF (obj);
-            break;
-        }
-        l = MIN (l, argrect->x);
-        t = MIN (t, argrect->y);
-        r = MAX (r, argrect->x + argrect->w);
-        b = MAX (b, argrect->y + argrect->h);
-        Py_DECREF (obj);
-    }
+    if (!RectsUnionSeq (list, key, &l, &t, &r, &b))
+        return NULL;
     return rect_subtype_new4 (Py_TYPE (oself), l, t, r-l, b-t);
 }
 
 static PyObject*
-rect_unionall_ip (PyObject* oself, PyObject* args)
+rect_unionall_ip (PyObject* oself, PyObject* args, PyObject* kwds)
 {
     PyRectObject* self = (PyRectObject*)oself;
-    GAME_Rect *argrect, temp;
-    int loop, size;
-    PyObject* list, *obj;
+    PyObject* list, *key = NULL;
     int t, l, b, r;
+    static char *kwids[] = {"list", "key", NULL};
 
-    if (!PyArg_ParseTuple (args, "O", &list))
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|O", kwids, &list, &key))
         return NULL;
-    if (!PySequence_Check (list))
-        return RAISE (PyExc_TypeError,
-                      "Argument must be a sequence of rectstyle objects.");
+    if (key == Py_None)
+        key = NULL;
 
     l = self->r.x;
     t = self->r.y;
     r = self->r.x + self->r.w;
     b = self->r.y + self->r.h;
-
-    size = PySequence_Length (list); /*warning, size could be -1 on error?*/
-    if (size < 1) {
-        if (size < 0) {
-            /*Error.*/
-            return NULL;
-        }
-        /*Empty list: nothing to be done.*/
-        Py_RETURN_NONE;
-    }
-
-    for (loop = 0; loop < size; ++loop)
-    {
-        obj = PySequence_GetItem (list, loop);
-        if (!obj || !(argrect = GameRect_FromObject (obj, &temp)))
-        {
-            RAISE (PyExc_TypeError,
-                   "Argument must be a sequence of rectstyle objects.");
-            Py_XDECREF (obj);
-            break;
-        }
-        l = MIN (l, argrect->x);
-        t = MIN (t, argrect->y);
-        r = MAX (r, argrect->x + argrect->w);
-        b = MAX (b, argrect->y + argrect->h);
-        Py_DECREF (obj);
-    }
+    if (!RectsUnionSeq (list, key, &l, &t, &r, &b))
+        return NULL;
 
     self->r.x = l;
     self->r.y = t;
@@ -410,93 +809,112 @@ rect_colliderect (PyObject* oself, PyObject* args)
 }
 
 static PyObject*
-rect_collidelist (PyObject* oself, PyObject* args)
+rect_collidelist (PyObject* oself, PyObject* args, PyObject* kwds)
 {
     PyRectObject* self = (PyRectObject*)oself;
-    GAME_Rect *argrect, temp;
-    int loop, size;
-    PyObject* list, *obj;
-    PyObject* ret = NULL;
+    GAME_Rect rects[RECT_BATCH];
+    Py_ssize_t start, n;
+    PyObject* list, *seq, *key = NULL;
+    int k[4], hit;
+    static char *kwids[] = {"list", "key", NULL};
 
-    if (!PyArg_ParseTuple (args, "O", &list))
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|O", kwids, &list, &key))
         return NULL;
+    if (key == Py_None)
+        key = NULL;
 
     if (!PySequence_Check (list))
         return RAISE (PyExc_TypeError,
                       "Argument must be a sequence of rectstyle objects.");
 
-    size = PySequence_Length (list); /*warning, size could be -1 on error?*/
-    for (loop = 0; loop < size; ++loop)
+    RectsBelowRect (&self->r, k);
+    if (!key && PyRectArray_Check (list))
     {
-        obj = PySequence_GetItem (list, loop);
-        if (!obj || !(argrect = GameRect_FromObject (obj, &temp)))
+        PyRectArrayObject *array = (PyRectArrayObject*) list;
+
+        if (RectsBelow (array->rects, (int) array->len, k, &hit, 1))
+            return PyInt_FromLong (hit);
+        return PyInt_FromLong (-1);
+    }
+
+    seq = PySequence_Fast (list,
+                           "Argument must be a sequence of rectstyle objects.");
+    if (!seq)
+        return NULL;
+    for (start = 0; start < PySequence_Fast_GET_SIZE (seq); start += n)
+    {
+        n = RectsFromSeq (seq, start, RECT_BATCH, key, rects);
+        /* A hit before a bad item wins, as when testing one at a time */
+        if (RectsBelow (rects, (int) n, k, &hit, 1))
         {
-            RAISE (PyExc_TypeError,
-                   "Argument must be a sequence of rectstyle objects.");
-            Py_XDECREF (obj);
-            break;
+            PyErr_Clear ();
+            Py_DECREF (seq);
+            return PyInt_FromLong (start + hit);
         }
-        if (DoRectsIntersect (&self->r, argrect))
+        if (PyErr_Occurred ())
         {
-            ret = PyInt_FromLong (loop);
-            Py_DECREF (obj);
-            break;
+            Py_DECREF (seq);
+            return NULL;
         }
-        Py_DECREF (obj);
     }
-    if (loop == size)
-        ret = PyInt_FromLong (-1);
-
-    return ret;
+    Py_DECREF (seq);
+    return PyInt_FromLong (-1);
 }
 
 static PyObject*
-rect_collidelistall (PyObject* oself, PyObject* args)
+rect_collidelistall (PyObject* oself, PyObject* args, PyObject* kwds)
 {
     PyRectObject* self = (PyRectObject*)oself;
-    GAME_Rect *argrect, temp;
-    int loop, size;
-    PyObject* list, *obj;
+    GAME_Rect rects[RECT_BATCH];
+    int hits[RECT_BATCH];
+    Py_ssize_t start, n;
+    PyObject* list, *seq, *key = NULL, *num;
     PyObject* ret = NULL;
+    int k[4], count, i;
+    static char *kwids[] = {"list", "key", NULL};
 
-    if (!PyArg_ParseTuple (args, "O", &list))
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|O", kwids, &list, &key))
         return NULL;
+    if (key == Py_None)
+        key = NULL;
 
     if (!PySequence_Check (list))
         return RAISE (PyExc_TypeError,
                       "Argument must be a sequence of rectstyle objects.");
 
-    ret = PyList_New (0);
-    if (!ret)
-        return NULL;
+    RectsBelowRect (&self->r, k);
+    if (!key && PyRectArray_Check (list))
+        return RectsBelowList (((PyRectArrayObject*) list)->rects,
+                               (int) ((PyRectArrayObject*) list)->len, k);
 
-    size = PySequence_Length (list); /*warning, size could be -1?*/
-    for (loop = 0; loop < size; ++loop)
+    seq = PySequence_Fast (list,
+                           "Argument must be a sequence of rectstyle objects.");
+    if (!seq)
+        return NULL;
+    ret = PyList_New (0);
+    for (start = 0; ret && start < PySequence_Fast_GET_SIZE (seq);
+         start += n)
     {
-        obj = PySequence_GetItem (list, loop);
-
-        if(!obj || !(argrect = GameRect_FromObject (obj, &temp)))
+        n = RectsFromSeq (seq, start, RECT_BATCH, key, rects);
+        if (PyErr_Occurred ())
         {
-            Py_XDECREF (obj);
-            Py_DECREF (ret);
-            return RAISE (PyExc_TypeError,
-                          "Argument must be a sequence of rectstyle objects.");
+            Py_CLEAR (ret);
+            break;
         }
-
-        if (DoRectsIntersect (&self->r, argrect))
+        count = RectsBelow (rects, (int) n, k, hits, RECT_BATCH);
+        for (i = 0; i < count; i++)
         {
-            PyObject* num = PyInt_FromLong (loop);
-            if (!num)
+            num = PyInt_FromSsize_t (start + hits[i]);
+            if (!num || PyList_Append (ret, num))
             {
-                Py_DECREF (obj);
-                return NULL;
+                Py_XDECREF (num);
+                Py_CLEAR (ret);
+                break;
             }
-            PyList_Append (ret, num);
             Py_DECREF (num);
         }
-        Py_DECREF (obj);
     }
-
+    Py_DECREF (seq);
     return ret;
 }
 
@@ -603,49 +1021,14 @@ rect_collidedictall (PyObject* oself, PyObject* args)
 static PyObject*
 rect_clip (PyObject* self, PyObject* args)
 {
-    GAME_Rect *A, *B, temp;
-    int x, y, w, h;
+    GAME_Rect *A, *B, temp, C;
 
     A = &((PyRectObject*) self)->r;
     if (!(B = GameRect_FromObject (args, &temp)))
-        return RAISE (PyExc_TypeError, "Argument must be rect style object");
-
-    /* Left */
-    if ((A->x >= B->x) && (A->x < (B->x + B->w)))
-        x = A->x;
-    else if ((B->x >= A->x) && (B->x < (A->x + A->w)))
-        x = B->x;
-    else
-        goto nointersect;
-
-    /* Right */
-    if (((A->x + A->w) > B->x) && ((A->x + A->w) <= (B->x + B->w)))
-        w = (A->x + A->w) - x;
-    else if (((B->x + B->w) > A->x) && ((B->x + B->w) <= (A->x + A->w)))
-        w = (B->x + B->w) - x;
-    else
-        goto nointersect;
-
-    /* Top */
-    if ((A->y >= B->y) && (A->y < (B->y + B->h)))
-        y = A->y;
-    else if ((B->y >= A->y) && (B->y < (A->y + A->h)))
-        y = B->y;
-    else
-        goto nointersect;
-
-    /* Bottom */
-    if (((A->y + A->h) > B->y) && ((A->y + A->h) <= (B->y + B->h)))
-        h = (A->y + A->h) - y;
-    else if (((B->y + B->h) > A->y) && ((B->y + B->h) <= (A->y + A->h)))
-        h = (B->y + B->h) - y;
-    else
-        goto nointersect;
-
-    return rect_subtype_new4 (Py_TYPE (self), x, y, w, h);
+        return RAISE (PyExc_TypeError, "Argument must be rect style object");
 
-nointersect:
-    return rect_subtype_new4 (Py_TYPE (self), A->x, A->y, 0, 0);
+    DoRectClip (A, B, &C);
+    return rect_subtype_new4 (Py_TYPE (self), C.x, C.y, C.w, C.h);
 }
 
 static PyObject*
@@ -782,16 +1165,19 @@ static struct PyMethodDef rect_methods[] =
     { "move", rect_move, METH_VARARGS, DOC_RECTMOVE},
     { "inflate",  rect_inflate, METH_VARARGS, DOC_RECTINFLATE},
     { "union",  rect_union, METH_VARARGS, DOC_RECTUNION},
-    { "unionall",  rect_unionall, METH_VARARGS, DOC_RECTUNIONALL},
+    { "unionall", (PyCFunction) rect_unionall, METH_VARARGS | METH_KEYWORDS,
+      DOC_RECTUNIONALL},
     { "move_ip",  rect_move_ip, METH_VARARGS, DOC_RECTMOVEIP},
     { "inflate_ip", rect_inflate_ip, METH_VARARGS, DOC_RECTINFLATEIP},
     { "union_ip", rect_union_ip, METH_VARARGS, DOC_RECTUNIONIP},
-    { "unionall_ip", rect_unionall_ip, METH_VARARGS, DOC_RECTUNIONALLIP},
+    { "unionall_ip", (PyCFunction) rect_unionall_ip,
+      METH_VARARGS | METH_KEYWORDS, DOC_RECTUNIONALLIP},
     { "collidepoint", rect_collidepoint, METH_VARARGS, DOC_RECTCOLLIDEPOINT},
     { "colliderect", rect_colliderect, METH_VARARGS, DOC_RECTCOLLIDERECT},
-    { "collidelist", rect_collidelist, METH_VARARGS, DOC_RECTCOLLIDELIST},
-    { "collidelistall", rect_collidelistall, METH_VARARGS,
-      DOC_RECTCOLLIDELISTALL},
+    { "collidelist", (PyCFunction) rect_collidelist,
+      METH_VARARGS | METH_KEYWORDS, DOC_RECTCOLLIDELIST},
+    { "collidelistall", (PyCFunction) rect_collidelistall,
+      METH_VARARGS | METH_KEYWORDS, DOC_RECTCOLLIDELISTALL},
     { "collidedict", rect_collidedict, METH_VARARGS, DOC_RECTCOLLIDEDICT},
     { "collidedictall", rect_collidedictall, METH_VARARGS,
       DOC_RECTCOLLIDEDICTALL},
@@ -1014,6 +1400,9 @@ rect_dealloc (PyRectObject *self)
 {
     if (self->weakreflist)
         PyObject_ClearWeakRefs ((PyObject*)self);
+    if (Py_TYPE(self) == &PyRect_Type &&
+        PgFreeList_Push (&rect_freelist, (PyObject*)self))
+        return;
     Py_TYPE(self)->tp_free ((PyObject*)self);
 }
 
@@ -1542,8 +1931,11 @@ static PyTypeObject PyRect_Type =
 static PyObject*
 rect_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    PyRectObject *self;
-    self = (PyRectObject *)type->tp_alloc (type, 0);
+    PyRectObject *self = NULL;
+    if (type == &PyRect_Type)
+        self = (PyRectObject *)PgFreeList_Pop (&rect_freelist, type);
+    if (!self)
+        self = (PyRectObject *)type->tp_alloc (type, 0);
     if (self)
     {
         self->r.x = self->r.y = 0;
@@ -1570,8 +1962,544 @@ rect_init (PyRectObject *self, PyObject *args, PyObject *kwds)
     return 0;
 }
 
+/* RectArray */
+
+/* Make room for n rects, which can't move while the buffer is exported */
+static int
+rectarray_reserve (PyRectArrayObject *self, Py_ssize_t n)
+{
+    GAME_Rect *rects;
+    Py_ssize_t alloc;
+
+    if (n <= self->alloc)
+        return 0;
+    if (self->exports)
+    {
+        PyErr_SetString (PgExc_BufferError,
+                         "cannot resize a RectArray with exported buffers");
+        return -1;
+    }
+    alloc = MAX (n, self->alloc * 2);
+    rects = (GAME_Rect*) realloc (self->rects, sizeof (GAME_Rect) * alloc);
+    if (!rects)
+    {
+        PyErr_NoMemory ();
+        return -1;
+    }
+    self->rects = rects;
+    self->alloc = alloc;
+    return 0;
+}
+
+static PyRectArrayObject*
+rectarray_new_len (PyTypeObject *type, Py_ssize_t len)
+{
+    PyRectArrayObject *self;
+
+    self = (PyRectArrayObject *)type->tp_alloc (type, 0);
+    if (!self)
+        return NULL;
+    self->len = self->alloc = 0;
+    self->exports = 0;
+    self->weakreflist = NULL;
+    /* never NULL, so there is always a buffer to export */
+    self->rects = (GAME_Rect*) calloc (len ? len : 1, sizeof (GAME_Rect));
+    if (!self->rects)
+    {
+        Py_DECREF (self);
+        return (PyRectArrayObject*) PyErr_NoMemory ();
+    }
+    self->len = len;
+    self->alloc = len ? len : 1;
+    return self;
+}
+
+static PyObject*
+rectarray_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyRectArrayObject *self;
+    PyObject *obj = NULL, *seq;
+    GAME_Rect *argrect, temp;
+    Py_ssize_t n, i;
+
+    if (!PyArg_ParseTuple (args, "|O", &obj))
+        return NULL;
+
+    if (!obj)
+        return (PyObject*) rectarray_new_len (type, 0);
+
+    if (PyInt_Check (obj) || PyLong_Check (obj))
+    {
+        n = PyInt_AsSsize_t (obj);
+        if (n < 0)
+        {
+            if (!PyErr_Occurred ())
+                RAISE (PyExc_ValueError, "length must not be negative");
+            return NULL;
+        }
+        return (PyObject*) rectarray_new_len (type, n);
+    }
+
+    if (PyRectArray_Check (obj))
+    {
+        n = ((PyRectArrayObject*) obj)->len;
+        self = rectarray_new_len (type, n);
+        if (self)
+            memcpy (self->rects, ((PyRectArrayObject*) obj)->rects,
+                    sizeof (GAME_Rect) * n);
+        return (PyObject*) self;
+    }
+
+    seq = PySequence_Fast (obj, "Argument must be a sequence of rectstyle "
+                           "objects or a length.");
+    if (!seq)
+        return NULL;
+    n = PySequence_Fast_GET_SIZE (seq);
+    self = rectarray_new_len (type, n);
+    for (i = 0; self && i < n; i++)
+    {
+        if (!(argrect = GameRect_FromObject (PySequence_Fast_GET_ITEM (seq, i),
+                                             &temp)))
+        {
+            RAISE (PyExc_TypeError,
+                   "Argument must be a sequence of rectstyle objects.");
+            Py_DECREF (self);
+            self = NULL;
+            break;
+        }
+        self->rects[i] = *argrect;
+    }
+    Py_DECREF (seq);
+    return (PyObject*) self;
+}
+
+static PyObject*
+rectarray_append (PyObject* oself, PyObject* args)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)oself;
+    GAME_Rect *argrect, temp;
+
+    if (!(argrect = GameRect_FromObject (args, &temp)))
+        return RAISE (PyExc_TypeError, "Argument must be rect style object");
+    if (rectarray_reserve (self, self->len + 1))
+        return NULL;
+    self->rects[self->len++] = *argrect;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+rectarray_collidepoint (PyObject* oself, PyObject* args)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)oself;
+    int x, y, k[4];
+
+    if (!TwoIntsFromObj (args, &x, &y))
+        return RAISE (PyExc_TypeError, "argument must contain two numbers");
+
+    /* x < r.x + r.w and r.x <= x, which is r.x < x + 1, and the same in y */
+    k[0] = x + 1;
+    k[1] = y + 1;
+    k[2] = -x;
+    k[3] = -y;
+    return RectsBelowList (self->rects, (int) self->len, k);
+}
+
+static PyObject*
+rectarray_colliderect (PyObject* oself, PyObject* args)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)oself;
+    GAME_Rect *argrect, temp;
+    int k[4];
+
+    if (!(argrect = GameRect_FromObject (args, &temp)))
+        return RAISE (PyExc_TypeError, "Argument must be rect style object");
+
+    RectsBelowRect (argrect, k);
+    return RectsBelowList (self->rects, (int) self->len, k);
+}
+
+static PyObject*
+rectarray_clip (PyObject* oself, PyObject* args)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)oself;
+    PyRectArrayObject* result;
+    GAME_Rect *argrect, temp;
+    Py_ssize_t i;
+
+    if (!(argrect = GameRect_FromObject (args, &temp)))
+        return RAISE (PyExc_TypeError, "Argument must be rect style object");
+
+    result = rectarray_new_len (Py_TYPE (oself), self->len);
+    if (!result)
+        return NULL;
+    for (i = 0; i < self->len; i++)
+        DoRectClip (self->rects + i, argrect, result->rects + i);
+    return (PyObject*) result;
+}
+
+static PyObject*
+rectarray_union (PyObject* oself, PyObject* args)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)oself;
+    PyRectArrayObject* result;
+    GAME_Rect *argrect, temp, *a, *o;
+    Py_ssize_t i;
+
+    if (!(argrect = GameRect_FromObject (args, &temp)))
+        return RAISE (PyExc_TypeError, "Argument must be rect style object");
+
+    result = rectarray_new_len (Py_TYPE (oself), self->len);
+    if (!result)
+        return NULL;
+    for (i = 0, a = self->rects, o = result->rects; i < self->len;
+         i++, a++, o++)
+    {
+        o->x = MIN (a->x, argrect->x);
+        o->y = MIN (a->y, argrect->y);
+        o->w = MAX (a->x + a->w, argrect->x + argrect->w) - o->x;
+        o->h = MAX (a->y + a->h, argrect->y + argrect->h) - o->y;
+    }
+    return (PyObject*) result;
+}
+
+static PyObject*
+rectarray_unionall (PyObject* oself)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)oself;
+    int l, t, r, b;
+
+    if (!self->len)
+        return PyRect_New4 (0, 0, 0, 0);
+    l = self->rects[0].x;
+    t = self->rects[0].y;
+    r = l + self->rects[0].w;
+    b = t + self->rects[0].h;
+    RectsUnion (self->rects + 1, self->len - 1, &l, &t, &r, &b);
+    return PyRect_New4 (l, t, r - l, b - t);
+}
+
+static PyObject*
+rectarray_move_ip (PyObject* oself, PyObject* args)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)oself;
+    Py_ssize_t i = 0;
+    int x, y;
+
+    if (!TwoIntsFromObj (args, &x, &y))
+        return RAISE (PyExc_TypeError, "argument must contain two numbers");
+
+#ifdef RECT_SSE2
+    {
+        const __m128i d = _mm_set_epi32 (0, 0, y, x);
+        __m128i *p;
+
+        for (; i < self->len; i++)
+        {
+            p = (__m128i*) (self->rects + i);
+            _mm_storeu_si128 (p, _mm_add_epi32 (_mm_loadu_si128 (p), d));
+        }
+    }
+#endif
+    for (; i < self->len; i++)
+    {
+        self->rects[i].x += x;
+        self->rects[i].y += y;
+    }
+    Py_RETURN_NONE;
+}
+
+static struct PyMethodDef rectarray_methods[] =
+{
+    { "append", rectarray_append, METH_VARARGS, DOC_RECTARRAYAPPEND},
+    { "collidepoint", rectarray_collidepoint, METH_VARARGS,
+      DOC_RECTARRAYCOLLIDEPOINT},
+    { "colliderect", rectarray_colliderect, METH_VARARGS,
+      DOC_RECTARRAYCOLLIDERECT},
+    { "clip", rectarray_clip, METH_VARARGS, DOC_RECTARRAYCLIP},
+    { "union", rectarray_union, METH_VARARGS, DOC_RECTARRAYUNION},
+    { "unionall", (PyCFunction) rectarray_unionall, METH_NOARGS,
+      DOC_RECTARRAYUNIONALL},
+    { "move_ip", rectarray_move_ip, METH_VARARGS, DOC_RECTARRAYMOVEIP},
+    { NULL, NULL, 0, NULL }
+};
+
+static Py_ssize_t
+rectarray_length (PyObject *_self)
+{
+    return ((PyRectArrayObject*)_self)->len;
+}
+
+static PyObject*
+rectarray_item (PyObject *_self, Py_ssize_t i)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)_self;
+    GAME_Rect *r;
+
+    if (i < 0)
+        i += self->len;
+    if (i < 0 || i >= self->len)
+        return RAISE (PyExc_IndexError, "Invalid rect Index");
+    r = self->rects + i;
+    return PyRect_New4 (r->x, r->y, r->w, r->h);
+}
+
+static int
+rectarray_ass_item (PyObject *_self, Py_ssize_t i, PyObject *v)
+{
+    PyRectArrayObject* self = (PyRectArrayObject*)_self;
+    GAME_Rect *argrect, temp;
+
+    if (!v)
+    {
+        RAISE (PyExc_TypeError, "rects can't be deleted from a RectArray");
+        return -1;
+    }
+    if (i < 0)
+        i += self->len;
+    if (i < 0 || i >= self->len)
+    {
+        RAISE (PyExc_IndexError, "Invalid rect Index");
+        return -1;
+    }
+    if (!(argrect = GameRect_FromObject (v, &temp)))
+    {
+        RAISE (PyExc_TypeError, "Argument must be rect style object");
+        return -1;
+    }
+    self->rects[i] = *argrect;
+    return 0;
+}
+
+static PySequenceMethods rectarray_as_sequence =
+{
+    rectarray_length,                   /*length*/
+    NULL,                               /*concat*/
+    NULL,                               /*repeat*/
+    rectarray_item,                     /*item*/
+    NULL,                               /*slice*/
+    rectarray_ass_item,                 /*ass_item*/
+    NULL,                               /*ass_slice*/
+};
+
+#if PG_ENABLE_NEWBUF
+/* The buffer is the rects as a writable len by 4 array of C ints */
+static int
+rectarray_getbuffer (PyRectArrayObject *self, Py_buffer *view, int flags)
+{
+    static char format[] = "i";
+
+    view->buf = self->rects;
+    view->len = self->len * sizeof (GAME_Rect);
+    view->itemsize = sizeof (int);
+    view->readonly = 0;
+    self->shape[0] = self->len;
+    self->shape[1] = 4;
+    self->strides[0] = sizeof (GAME_Rect);
+    self->strides[1] = sizeof (int);
+    if (PyBUF_HAS_FLAG (flags, PyBUF_ND)) {
+        view->ndim = 2;
+        view->shape = self->shape;
+    }
+    else {
+        view->ndim = 1;
+        view->shape = 0;
+    }
+    if (PyBUF_HAS_FLAG (flags, PyBUF_FORMAT)) {
+        view->format = format;
+    }
+    else {
+        view->format = 0;
+    }
+    if (PyBUF_HAS_FLAG (flags, PyBUF_STRIDES)) {
+        view->strides = self->strides;
+    }
+    else {
+        view->strides = 0;
+    }
+    view->suboffsets = 0;
+    view->internal = 0;
+    Py_INCREF (self);
+    view->obj = (PyObject *)self;
+    self->exports++;
+    return 0;
+}
+
+static void
+rectarray_releasebuffer (PyRectArrayObject *self, Py_buffer *view)
+{
+    self->exports--;
+}
+
+static PyBufferProcs rectarray_as_buffer = {
+#if HAVE_OLD_BUFPROTO
+    0,
+    0,
+    0,
+    0,
+#endif
+    (getbufferproc)rectarray_getbuffer,
+    (releasebufferproc)rectarray_releasebuffer
+};
+#endif
+
+#if PY2 && PG_ENABLE_NEWBUF
+#define RECTARRAY_TPFLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | \
+                           Py_TPFLAGS_HAVE_NEWBUFFER)
+#else
+#define RECTARRAY_TPFLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE)
+#endif
+
+static void
+rectarray_dealloc (PyRectArrayObject *self)
+{
+    if (self->weakreflist)
+        PyObject_ClearWeakRefs ((PyObject*)self);
+    free (self->rects);
+    Py_TYPE(self)->tp_free ((PyObject*)self);
+}
+
+static PyObject*
+rectarray_repr (PyRectArrayObject *self)
+{
+    char string[64];
+    sprintf (string, "<RectArray(%ld rects)>", (long) self->len);
+    return Text_FromUTF8 (string);
+}
+
+static PyTypeObject PyRectArray_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "pygame.RectArray",                 /*name*/
+    sizeof(PyRectArrayObject),          /*basicsize*/
+    0,                                  /*itemsize*/
+    /* methods */
+    (destructor)rectarray_dealloc,      /*dealloc*/
+    (printfunc)NULL,                    /*print*/
+    NULL,                               /*getattr*/
+    NULL,                               /*setattr*/
+    NULL,                               /*compare/reserved*/
+    (reprfunc)rectarray_repr,           /*repr*/
+    NULL,                               /*as_number*/
+    &rectarray_as_sequence,             /*as_sequence*/
+    NULL,                               /*as_mapping*/
+    (hashfunc)NULL,                     /*hash*/
+    (ternaryfunc)NULL,                  /*call*/
+    (reprfunc)NULL,                     /*str*/
+    NULL,                               /*getattro*/
+    NULL,                               /*setattro*/
+#if PG_ENABLE_NEWBUF
+    &rectarray_as_buffer,               /*as_buffer*/
+#else
+    NULL,                               /*as_buffer*/
+#endif
+    RECTARRAY_TPFLAGS,                  /* tp_flags */
+    DOC_PYGAMERECTARRAY,                /* Documentation string */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    0,                                  /* tp_richcompare */
+    offsetof(PyRectArrayObject, weakreflist),  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    rectarray_methods,                  /* tp_methods */
+    0,                                  /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    rectarray_new,                      /* tp_new */
+};
+
+static PyObject*
+rect_set_freelist_size (PyObject* self, PyObject* args)
+{
+    Py_ssize_t size;
+
+    if (!PyArg_ParseTuple (args, "n", &size))
+        return NULL;
+    if (PgFreeList_Resize (&rect_freelist, size))
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+rect_get_freelist_stats (PyObject* self)
+{
+    return PgFreeList_Stats (&rect_freelist);
+}
+
+static PyObject*
+rect_collide_pairs (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyObject *list, *seq, *key = NULL, *ret;
+    GAME_Rect *rects;
+    Py_ssize_t n, count;
+    int *pairs = NULL;
+    static char *kwids[] = {"rects", "key", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|O", kwids, &list, &key))
+        return NULL;
+    if (key == Py_None)
+        key = NULL;
+
+    if (!key && PyRectArray_Check (list))
+    {
+        PyRectArrayObject *array = (PyRectArrayObject*) list;
+
+        Py_BEGIN_ALLOW_THREADS;
+        count = RectsCollidePairs (array->rects, array->len, &pairs);
+        Py_END_ALLOW_THREADS;
+    }
+    else
+    {
+        if (!PySequence_Check (list))
+            return RAISE (PyExc_TypeError,
+                          "Argument must be a sequence of rectstyle objects.");
+        seq = PySequence_Fast (list, "Argument must be a sequence of "
+                               "rectstyle objects.");
+        if (!seq)
+            return NULL;
+        n = PySequence_Fast_GET_SIZE (seq);
+        rects = (GAME_Rect*) malloc (sizeof (GAME_Rect) * (n ? n : 1));
+        if (!rects)
+        {
+            Py_DECREF (seq);
+            return PyErr_NoMemory ();
+        }
+        n = RectsFromSeq (seq, 0, n, key, rects);
+        Py_DECREF (seq);
+        if (PyErr_Occurred ())
+        {
+            free (rects);
+            return NULL;
+        }
+        Py_BEGIN_ALLOW_THREADS;
+        count = RectsCollidePairs (rects, n, &pairs);
+        Py_END_ALLOW_THREADS;
+        free (rects);
+    }
+    if (count < 0)
+        return PyErr_NoMemory ();
+
+    ret = RectIntArray (pairs, 2 * count);
+    free (pairs);
+    return ret;
+}
+
 static PyMethodDef _rect_methods[] =
 {
+    { "collide_pairs", (PyCFunction) rect_collide_pairs,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMERECTCOLLIDEPAIRS },
+    { "set_freelist_size", rect_set_freelist_size, METH_VARARGS,
+      "set_freelist_size(size) -> None\n"
+      "set how many dead Rects are kept for reuse" },
+    { "get_freelist_stats", (PyCFunction) rect_get_freelist_stats,
+      METH_NOARGS,
+      "get_freelist_stats() -> (size, count, hits, misses)\n"
+      "get the state of the free list of Rects" },
     {NULL, NULL, 0, NULL}
 };
 
@@ -1607,6 +2535,9 @@ MODINIT_DEFINE (rect)
     if (PyType_Ready (&PyRect_Type) < 0) {
         MODINIT_ERROR;
     }
+    if (PyType_Ready (&PyRectArray_Type) < 0) {
+        MODINIT_ERROR;
+    }
 
 #if PY3
     module = PyModule_Create (&_module);
@@ -1626,6 +2557,11 @@ MODINIT_DEFINE (rect)
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
+    if (PyDict_SetItemString (dict, "RectArray",
+                              (PyObject *)&PyRectArray_Type)) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
 
     /* export the c api */
     c_api[0] = &PyRect_Type;
@@ -15,10 +15,33 @@
 #include "pygame.h"
 #include "math.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ROTOZOOM_SSE2
+#include <emmintrin.h>
+#endif
+
 typedef struct tColorRGBA {
     Uint8 r; Uint8 g; Uint8 b; Uint8 a;
 } tColorRGBA;
 
+/*
+ A rotozoom of 'src' into 'dst', set up by rotozoomSurfaceBegin() so
+ rotozoomSurfaceRows() can do any band of the rows of 'dst', in any thread.
+*/
+typedef struct {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    int smooth;
+    int rotate;
+    /* rotozoom */
+    int cx, cy, isin, icos;
+    /* zoom */
+    int *sax;       /* column increments, dst->w + 1 */
+    int *say;       /* row increments, dst->h + 1 */
+    int *srow;      /* source row of each row of dst */
+} tRotozoomJob;
+
 #define VALUE_LIMIT    0.001
 #ifndef MAX
 #define MAX(a,b)    (((a) > (b)) ? (a) : (b))
@@ -29,78 +52,96 @@ typedef struct tColorRGBA {
 
 /*
 
- 32bit Zoomer with optional anti-aliasing by bilinear interpolation.
-
- Zoomes 32bit RGBA/ABGR 'src' surface to 'dst' surface.
+ Bilinear interpolation of the four channels of c00, c01 (right), c10
+ (below) and c11 by the 16 bit fractions ex and ey.
 
 */
-int zoomSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int smooth)
+#if defined(ROTOZOOM_SSE2)
+
+/* a + ((b - a) * e >> 16) in each 16 bit lane, e a 16 bit unsigned
+   fraction: _mm_mulhi_epi16 takes e as signed, which is e - 65536 when
+   its top bit is set, so then (b - a) is added back */
+#define LERP_16(a, b, e)                                            \
+    _mm_add_epi16 ((a), _mm_add_epi16 (                             \
+        _mm_mulhi_epi16 (_mm_sub_epi16 ((b), (a)), (e)),            \
+        _mm_and_si128 (_mm_sub_epi16 ((b), (a)),                    \
+                       _mm_srai_epi16 ((e), 15))))
+
+static Uint32 interpolateRGBA(Uint32 c00, Uint32 c01, Uint32 c10, Uint32 c11,
+                              int ex, int ey)
 {
-    int x, y, sx, sy, *sax, *say, *csax, *csay, csx, csy, ex, ey, t1, t2, sstep;
-    tColorRGBA *c00, *c01, *c10, *c11;
-    tColorRGBA *sp, *csp, *dp;
-    int sgap, dgap;
+    __m128i zero = _mm_setzero_si128();
+    __m128i left = _mm_unpacklo_epi8(
+        _mm_unpacklo_epi32(_mm_cvtsi32_si128(c00), _mm_cvtsi32_si128(c10)),
+        zero);
+    __m128i right = _mm_unpacklo_epi8(
+        _mm_unpacklo_epi32(_mm_cvtsi32_si128(c01), _mm_cvtsi32_si128(c11)),
+        zero);
+    __m128i vex = _mm_set1_epi16((short) ex);
+    __m128i vey = _mm_set1_epi16((short) ey);
+    __m128i t, t2;
+
+    /* t1 in the low four lanes, t2 in the high four */
+    t = LERP_16(left, right, vex);
+    t2 = _mm_unpackhi_epi64(t, t);
+    t = LERP_16(t, t2, vey);
+    return (Uint32) _mm_cvtsi128_si32(_mm_packus_epi16(t, t));
+}
 
-    /*
-     * Variable setup
-     */
-    if (smooth) {
-        /*
-         * For interpolation: assume source dimension is one pixel
-         */
-        /*
-         * smaller to avoid overflow on right and bottom edge.
-         */
-        sx = (int) (65536.0 * (float) (src->w - 1) / (float) dst->w);
-        sy = (int) (65536.0 * (float) (src->h - 1) / (float) dst->h);
-    } else {
-        sx = (int) (65536.0 * (float) src->w / (float) dst->w);
-        sy = (int) (65536.0 * (float) src->h / (float) dst->h);
-    }
+#else /* !ROTOZOOM_SSE2 */
 
-    /*
-     * Allocate memory for row increments
-     */
-    if ((sax = (int *) malloc((dst->w + 1) * sizeof(Uint32))) == NULL) {
-        return (-1);
-    }
-    if ((say = (int *) malloc((dst->h + 1) * sizeof(Uint32))) == NULL) {
-        free(sax);
-        return (-1);
-    }
+#define LERP_CHANNEL(shift)                                                 \
+    t1 = (((((int) (c01 >> shift & 0xff) - (int) (c00 >> shift & 0xff))   \
+            * ex) >> 16) + (int) (c00 >> shift & 0xff)) & 0xff;            \
+    t2 = (((((int) (c11 >> shift & 0xff) - (int) (c10 >> shift & 0xff))   \
+            * ex) >> 16) + (int) (c10 >> shift & 0xff)) & 0xff;            \
+    pixel |= (Uint32) (((((t2 - t1) * ey) >> 16) + t1) & 0xff) << shift
 
-    /*
-     * Precalculate row increments
-     */
-    csx = 0;
-    csax = sax;
-    for (x = 0; x <= dst->w; x++) {
-        *csax = csx;
-        csax++;
-        csx &= 0xffff;
-        csx += sx;
-    }
-    csy = 0;
-    csay = say;
-    for (y = 0; y <= dst->h; y++) {
-        *csay = csy;
-        csay++;
-        csy &= 0xffff;
-        csy += sy;
-    }
+static Uint32 interpolateRGBA(Uint32 c00, Uint32 c01, Uint32 c10, Uint32 c11,
+                              int ex, int ey)
+{
+    Uint32 pixel = 0;
+    int t1, t2;
+
+    LERP_CHANNEL(0);
+    LERP_CHANNEL(8);
+    LERP_CHANNEL(16);
+    LERP_CHANNEL(24);
+    return pixel;
+}
+
+#undef LERP_CHANNEL
+
+#endif /* !ROTOZOOM_SSE2 */
+
+/*
+
+ 32bit Zoomer with optional anti-aliasing by bilinear interpolation.
+
+ Zoomes rows 'first' to 'first' + 'n' - 1 of the 32bit RGBA/ABGR 'job->dst'
+ surface from 'job->src'.
+
+*/
+static void zoomSurfaceRGBARows(tRotozoomJob * job, int first, int n)
+{
+    SDL_Surface *src = job->src;
+    SDL_Surface *dst = job->dst;
+    int x, y, *csax, *csay, ex, ey, sstep;
+    Uint32 *c00, *c01, *c10, *c11;
+    tColorRGBA *sp, *csp, *dp;
+    int dgap;
 
     /*
      * Pointer setup
      */
-    sp = csp = (tColorRGBA *) src->pixels;
-    dp = (tColorRGBA *) dst->pixels;
-    sgap = src->pitch - src->w * 4;
+    csp = (tColorRGBA *) ((Uint8 *) src->pixels + job->srow[first] * src->pitch);
+    dp = (tColorRGBA *) ((Uint8 *) dst->pixels + first * dst->pitch);
     dgap = dst->pitch - dst->w * 4;
 
     /*
      * Switch between interpolating and non-interpolating code
      */
-    if (smooth) {
+    if (job->smooth) {
 
         /*
          * Interpolating Zoom
@@ -109,37 +150,25 @@ int zoomSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int smooth)
         /*
          * Scan destination
          */
-        csay = say;
-        for (y = 0; y < dst->h; y++) {
+        csay = job->say + first;
+        for (y = 0; y < n; y++) {
             /*
              * Setup color source pointers
              */
-            c00 = csp;
-            c01 = csp;
-            c01++;
-            c10 = (tColorRGBA *) ((Uint8 *) csp + src->pitch);
-            c11 = c10;
-            c11++;
-            csax = sax;
+            c00 = (Uint32 *) csp;
+            c01 = c00 + 1;
+            c10 = (Uint32 *) ((Uint8 *) csp + src->pitch);
+            c11 = c10 + 1;
+            csax = job->sax;
+            ey = (*csay & 0xffff);
             for (x = 0; x < dst->w; x++) {
 
                 /*
                  * Interpolate colors
                  */
                 ex = (*csax & 0xffff);
-                ey = (*csay & 0xffff);
-                t1 = ((((c01->r - c00->r) * ex) >> 16) + c00->r) & 0xff;
-                t2 = ((((c11->r - c10->r) * ex) >> 16) + c10->r) & 0xff;
-                dp->r = (((t2 - t1) * ey) >> 16) + t1;
-                t1 = ((((c01->g - c00->g) * ex) >> 16) + c00->g) & 0xff;
-                t2 = ((((c11->g - c10->g) * ex) >> 16) + c10->g) & 0xff;
-                dp->g = (((t2 - t1) * ey) >> 16) + t1;
-                t1 = ((((c01->b - c00->b) * ex) >> 16) + c00->b) & 0xff;
-                t2 = ((((c11->b - c10->b) * ex) >> 16) + c10->b) & 0xff;
-                dp->b = (((t2 - t1) * ey) >> 16) + t1;
-                t1 = ((((c01->a - c00->a) * ex) >> 16) + c00->a) & 0xff;
-                t2 = ((((c11->a - c10->a) * ex) >> 16) + c10->a) & 0xff;
-                dp->a = (((t2 - t1) * ey) >> 16) + t1;
+                *(Uint32 *) dp = interpolateRGBA(*c00, *c01, *c10, *c11,
+                                                 ex, ey);
 
                 /*
                  * Advance source pointers
@@ -172,10 +201,10 @@ int zoomSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int smooth)
          * Non-Interpolating Zoom
          */
 
-        csay = say;
-        for (y = 0; y < dst->h; y++) {
+        csay = job->say + first;
+        for (y = 0; y < n; y++) {
             sp = csp;
-            csax = sax;
+            csax = job->sax;
             for (x = 0; x < dst->w; x++) {
                 /*
                  * Draw
@@ -203,12 +232,74 @@ int zoomSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int smooth)
         }
 
     }
+}
+
+/*
+
+ Set up the row increments of a zoom for zoomSurfaceRGBARows(). Returns -1
+ if out of memory.
+
+*/
+static int zoomSurfaceRGBABegin(tRotozoomJob * job)
+{
+    SDL_Surface *src = job->src;
+    SDL_Surface *dst = job->dst;
+    int x, y, sx, sy, *csax, *csay, csx, csy;
 
     /*
-     * Remove temp arrays
+     * Variable setup
      */
-    free(sax);
-    free(say);
+    if (job->smooth) {
+        /*
+         * For interpolation: assume source dimension is one pixel
+         */
+        /*
+         * smaller to avoid overflow on right and bottom edge.
+         */
+        sx = (int) (65536.0 * (float) (src->w - 1) / (float) dst->w);
+        sy = (int) (65536.0 * (float) (src->h - 1) / (float) dst->h);
+    } else {
+        sx = (int) (65536.0 * (float) src->w / (float) dst->w);
+        sy = (int) (65536.0 * (float) src->h / (float) dst->h);
+    }
+
+    /*
+     * Allocate memory for row increments
+     */
+    job->sax = (int *) malloc((dst->w + 1) * sizeof(int));
+    job->say = (int *) malloc((dst->h + 1) * sizeof(int));
+    job->srow = (int *) malloc(dst->h * sizeof(int));
+    if (!job->sax || !job->say || !job->srow) {
+        return (-1);
+    }
+
+    /*
+     * Precalculate row increments
+     */
+    csx = 0;
+    csax = job->sax;
+    for (x = 0; x <= dst->w; x++) {
+        *csax = csx;
+        csax++;
+        csx &= 0xffff;
+        csx += sx;
+    }
+    csy = 0;
+    csay = job->say;
+    for (y = 0; y <= dst->h; y++) {
+        *csay = csy;
+        csay++;
+        csy &= 0xffff;
+        csy += sy;
+    }
+
+    /*
+     * The source row of each destination row, where a band starts
+     */
+    job->srow[0] = 0;
+    for (y = 1; y < dst->h; y++) {
+        job->srow[y] = job->srow[y - 1] + (job->say[y] >> 16);
+    }
 
     return (0);
 }
@@ -218,15 +309,24 @@ int zoomSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int smooth)
 
  32bit Rotozoomer with optional anti-aliasing by bilinear interpolation.
 
- Rotates and zoomes 32bit RGBA/ABGR 'src' surface to 'dst' surface.
+ Rotates and zoomes rows 'first' to 'first' + 'n' - 1 of the 32bit RGBA/ABGR
+ 'job->dst' surface from 'job->src'.
 
 */
 
-void transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx,
-                          int cy, int isin, int icos, int smooth)
+#define SRC_PIXEL(px, py) \
+    (*((Uint32 *) ((Uint8 *) src->pixels + src->pitch * (py)) + (px)))
+
+static void transformSurfaceRGBARows(tRotozoomJob * job, int first, int n)
 {
-    int x, y, t1, t2, dx, dy, xd, yd, sdx, sdy, ax, ay, ex, ey, sw, sh;
-    tColorRGBA c00, c01, c10, c11;
+    SDL_Surface *src = job->src;
+    SDL_Surface *dst = job->dst;
+    int cx = job->cx;
+    int cy = job->cy;
+    int isin = job->isin;
+    int icos = job->icos;
+    int x, y, dx, dy, xd, yd, sdx, sdy, ax, ay, sw, sh;
+    Uint32 c00, c01, c10, c11;
     tColorRGBA *pc, *sp;
     int gap;
 
@@ -239,14 +339,14 @@ void transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx,
     ay = (cy << 16) - (isin * cx);
     sw = src->w - 1;
     sh = src->h - 1;
-    pc = dst->pixels;
+    pc = (tColorRGBA *) ((Uint8 *) dst->pixels + first * dst->pitch);
     gap = dst->pitch - dst->w * 4;
 
     /*
      * Switch between interpolating and non-interpolating code
      */
-    if (smooth) {
-        for (y = 0; y < dst->h; y++) {
+    if (job->smooth) {
+        for (y = first; y < first + n; y++) {
             dy = cy - y;
             sdx = (ax + (isin * dy)) + xd;
             sdy = (ay - (icos * dy)) + yd;
@@ -255,101 +355,42 @@ void transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx,
                 dy = (sdy >> 16);
                 if ((dx >= -1) && (dy >= -1) && (dx < src->w) && (dy < src->h)) {
                     if ((dx >= 0) && (dy >= 0) && (dx < sw) && (dy < sh)) {
-                        sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy);
-                        sp += dx;
-                        c00 = *sp;
-                        sp += 1;
-                        c01 = *sp;
-                        sp = (tColorRGBA *) ((Uint8 *) sp + src->pitch);
-                        sp -= 1;
-                        c10 = *sp;
-                        sp += 1;
-                        c11 = *sp;
+                        c00 = SRC_PIXEL(dx, dy);
+                        c01 = SRC_PIXEL(dx + 1, dy);
+                        c10 = SRC_PIXEL(dx, dy + 1);
+                        c11 = SRC_PIXEL(dx + 1, dy + 1);
                     } else if ((dx == sw) && (dy == sh)) {
-                        sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy);
-                        sp += dx;
-                        c00 = *sp;
-                        c01 = *sp;
-                        c10 = *sp;
-                        c11 = *sp;
+                        c00 = c01 = c10 = c11 = SRC_PIXEL(dx, dy);
                     } else if ((dx == -1) && (dy == -1)) {
-                        sp = (tColorRGBA *) (src->pixels);
-                        c00 = *sp;
-                        c01 = *sp;
-                        c10 = *sp;
-                        c11 = *sp;
+                        c00 = c01 = c10 = c11 = SRC_PIXEL(0, 0);
                     } else if ((dx == -1) && (dy == sh)) {
-                        sp = (tColorRGBA *) (src->pixels);
-                        sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy);
-                        c00 = *sp;
-                        c01 = *sp;
-                        c10 = *sp;
-                        c11 = *sp;
+                        c00 = c01 = c10 = c11 = SRC_PIXEL(0, dy);
                     } else if ((dx == sw) && (dy == -1)) {
-                        sp = (tColorRGBA *) (src->pixels);
-                        sp += dx;
-                        c00 = *sp;
-                        c01 = *sp;
-                        c10 = *sp;
-                        c11 = *sp;
+                        c00 = c01 = c10 = c11 = SRC_PIXEL(dx, 0);
                     } else if (dx == -1) {
-                        sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy);
-                        c00 = *sp;
-                        c01 = *sp;
-                        c10 = *sp;
-                        sp = (tColorRGBA *) ((Uint8 *) sp + src->pitch);
-                        c11 = *sp;
+                        c00 = c01 = c10 = SRC_PIXEL(0, dy);
+                        c11 = SRC_PIXEL(0, dy + 1);
                     } else if (dy == -1) {
-                        sp = (tColorRGBA *) (src->pixels);
-                        sp += dx;
-                        c00 = *sp;
-                        c01 = *sp;
-                        c10 = *sp;
-                        sp += 1;
-                        c11 = *sp;
+                        c00 = c01 = c10 = SRC_PIXEL(dx, 0);
+                        c11 = SRC_PIXEL(dx + 1, 0);
                     } else if (dx == sw) {
-                        sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy);
-                        sp += dx;
-                        c00 = *sp;
-                        c01 = *sp;
-                        sp = (tColorRGBA *) ((Uint8 *) sp + src->pitch);
-                        c10 = *sp;
-                        c11 = *sp;
+                        c00 = c01 = SRC_PIXEL(dx, dy);
+                        c10 = c11 = SRC_PIXEL(dx, dy + 1);
                     } else if (dy == sh) {
-                        sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy);
-                        sp += dx;
-                        c00 = *sp;
-                        sp += 1;
-                        c01 = *sp;
-                        c10 = *sp;
-                        c11 = *sp;
+                        c00 = SRC_PIXEL(dx, dy);
+                        c01 = c10 = c11 = SRC_PIXEL(dx + 1, dy);
                     } else {
                         // NOTE: a catchall to appease gcc4 warnings...
                         // Probably should not get here.  we'll see.
                         //  old behaviour would be to use the previous pixel, from the previous loop.
-                        sp = (tColorRGBA *) (src->pixels);
-                        c00 = *sp;
-                        c01 = *sp;
-                        c10 = *sp;
-                        c11 = *sp;
+                        c00 = c01 = c10 = c11 = SRC_PIXEL(0, 0);
                     }
                     /*
                      * Interpolate colors
                      */
-                    ex = (sdx & 0xffff);
-                    ey = (sdy & 0xffff);
-                    t1 = ((((c01.r - c00.r) * ex) >> 16) + c00.r) & 0xff;
-                    t2 = ((((c11.r - c10.r) * ex) >> 16) + c10.r) & 0xff;
-                    pc->r = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.g - c00.g) * ex) >> 16) + c00.g) & 0xff;
-                    t2 = ((((c11.g - c10.g) * ex) >> 16) + c10.g) & 0xff;
-                    pc->g = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.b - c00.b) * ex) >> 16) + c00.b) & 0xff;
-                    t2 = ((((c11.b - c10.b) * ex) >> 16) + c10.b) & 0xff;
-                    pc->b = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.a - c00.a) * ex) >> 16) + c00.a) & 0xff;
-                    t2 = ((((c11.a - c10.a) * ex) >> 16) + c10.a) & 0xff;
-                    pc->a = (((t2 - t1) * ey) >> 16) + t1;
+                    *(Uint32 *) pc = interpolateRGBA(c00, c01, c10, c11,
+                                                     sdx & 0xffff,
+                                                     sdy & 0xffff);
                 }
                 sdx += icos;
                 sdy += isin;
@@ -358,7 +399,7 @@ void transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx,
             pc = (tColorRGBA *) ((Uint8 *) pc + gap);
         }
     } else {
-        for (y = 0; y < dst->h; y++) {
+        for (y = first; y < first + n; y++) {
             dy = cy - y;
             sdx = (ax + (isin * dy)) + xd;
             sdy = (ay - (icos * dy)) + yd;
@@ -379,6 +420,7 @@ void transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx,
     }
 }
 
+#undef SRC_PIXEL
 
 /*
 
@@ -475,45 +517,51 @@ void zoomSurfaceSize(int width, int height, double zoomx, double zoomy,
 }
 
 
-/* Publically available rotozoom function */
+/* Size of the surface rotozoomSurface() makes from a 'width' x 'height' one */
 
-SDL_Surface *rotozoomSurface(SDL_Surface * src, double angle,
-                             double zoom, int smooth)
+void rotozoomSurfaceDstSize(int width, int height, double angle,
+                            double zoom, int *dstwidth, int *dstheight)
 {
-    SDL_Surface *rz_src;
-    SDL_Surface *rz_dst;
+    if (zoom < VALUE_LIMIT) {
+        zoom = VALUE_LIMIT;
+    }
+    if (fabs(angle) > VALUE_LIMIT) {
+        rotozoomSurfaceSize(width, height, angle, zoom, dstwidth, dstheight);
+    } else {
+        zoomSurfaceSize(width, height, zoom, zoom, dstwidth, dstheight);
+    }
+}
+
+
+
+
+/*
+
+ rotozoomSurfaceBegin(), rotozoomSurfaceRows(), rotozoomSurfaceEnd()
+
+ rotozoomSurfaceTo() in three steps, so the rows of 'dst' can be shared out
+ among threads: rotozoomSurfaceBegin() locks 'src' and sets up the job,
+ returning NULL if out of memory; rotozoomSurfaceRows() does rows 'first' to
+ 'first' + 'n' - 1 of 'dst' and can be called for separate rows at the same
+ time; rotozoomSurfaceEnd() unlocks 'src' and frees the job.
+
+*/
+
+void *rotozoomSurfaceBegin(SDL_Surface * src, SDL_Surface * dst, double angle,
+                           double zoom, int smooth)
+{
+    tRotozoomJob *job;
     double zoominv;
-    double sanglezoom, canglezoom, sanglezoominv, canglezoominv;
-    int dstwidthhalf, dstwidth, dstheighthalf, dstheight;
-    int is32bit;
-    int src_converted;
+    double sanglezoom, canglezoom;
+    int dstwidth, dstheight;
 
-    /*
-     * Sanity check
-     */
-    if (src == NULL)
+    job = (tRotozoomJob *) calloc(1, sizeof(tRotozoomJob));
+    if (job == NULL) {
         return (NULL);
-
-    /*
-     * Determine if source surface is 32bit or 8bit
-     */
-    is32bit = (src->format->BitsPerPixel == 32);
-    if ((is32bit) || (src->format->BitsPerPixel == 8)) {
-        /*
-         * Use source surface 'as is'
-         */
-        rz_src = src;
-        src_converted = 0;
-    } else {
-        /*
-         * New source surface is 32bit with a defined RGBA ordering
-         */
-        rz_src =
-            SDL_CreateRGBSurface(SDL_SWSURFACE, src->w, src->h, 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
-        SDL_BlitSurface(src, NULL, rz_src, NULL);
-        src_converted = 1;
-        is32bit = 1;
     }
+    job->src = src;
+    job->dst = dst;
+    job->smooth = smooth;
 
     /*
      * Sanity check zoom factor
@@ -527,107 +575,133 @@ SDL_Surface *rotozoomSurface(SDL_Surface * src, double angle,
      * Check if we have a rotozoom or just a zoom
      */
     if (fabs(angle) > VALUE_LIMIT) {
-
         /*
-         * Angle!=0: full rotozoom
+         * Angle!=0: full rotozoom, using alpha
          */
+        rotozoomSurfaceSizeTrig(src->w, src->h, angle, zoom, &dstwidth, &dstheight, &canglezoom, &sanglezoom);
+        job->rotate = 1;
+        job->cx = dstwidth / 2;
+        job->cy = dstheight / 2;
+        job->isin = (int) (sanglezoom * zoominv);
+        job->icos = (int) (canglezoom * zoominv);
+    } else if (zoomSurfaceRGBABegin(job) < 0) {
         /*
-         * -----------------------
+         * Angle=0: Just a zoom, using alpha
          */
+        free(job->sax);
+        free(job->say);
+        free(job->srow);
+        free(job);
+        return (NULL);
+    }
 
-        /* Determine target size */
-        rotozoomSurfaceSizeTrig(rz_src->w, rz_src->h, angle, zoom, &dstwidth, &dstheight, &canglezoom, &sanglezoom);
+    /*
+     * Lock source surface
+     */
+    SDL_LockSurface(src);
+    return (job);
+}
 
-        /*
-         * Calculate target factors from sin/cos and zoom
-         */
-        sanglezoominv = sanglezoom;
-        canglezoominv = canglezoom;
-        sanglezoominv *= zoominv;
-        canglezoominv *= zoominv;
+void rotozoomSurfaceRows(void *job, int first, int n)
+{
+    if (((tRotozoomJob *) job)->rotate) {
+        transformSurfaceRGBARows((tRotozoomJob *) job, first, n);
+    } else {
+        zoomSurfaceRGBARows((tRotozoomJob *) job, first, n);
+    }
+}
 
-        /* Calculate half size */
-        dstwidthhalf = dstwidth / 2;
-        dstheighthalf = dstheight / 2;
+void rotozoomSurfaceEnd(void *job)
+{
+    tRotozoomJob *rzjob = (tRotozoomJob *) job;
 
-        /*
-         * Alloc space to completely contain the rotated surface
-         */
-        rz_dst = NULL;
-        /*
-         * Target surface is 32bit with source RGBA/ABGR ordering
-         */
-        rz_dst =
-            SDL_CreateRGBSurface(SDL_SWSURFACE, dstwidth, dstheight, 32,
-                                 rz_src->format->Rmask, rz_src->format->Gmask,
-                                 rz_src->format->Bmask, rz_src->format->Amask);
+    /*
+     * Turn on source-alpha support
+     */
+    SDL_SetAlpha(rzjob->dst, SDL_SRCALPHA, 255);
+    /*
+     * Unlock source surface
+     */
+    SDL_UnlockSurface(rzjob->src);
 
-        /*
-         * Lock source surface
-         */
-        SDL_LockSurface(rz_src);
-        /*
-         * Check which kind of surface we have
-         */
-        /*
-         * Call the 32bit transformation routine to do the rotation (using alpha)
-         */
-        transformSurfaceRGBA(rz_src, rz_dst, dstwidthhalf, dstheighthalf,
-                             (int) (sanglezoominv), (int) (canglezoominv), smooth);
-        /*
-         * Turn on source-alpha support
-         */
-        SDL_SetAlpha(rz_dst, SDL_SRCALPHA, 255);
-        /*
-         * Unlock source surface
-         */
-        SDL_UnlockSurface(rz_src);
+    free(rzjob->sax);
+    free(rzjob->say);
+    free(rzjob->srow);
+    free(rzjob);
+}
 
-    } else {
 
-        /*
-         * Angle=0: Just a zoom
-         */
-        /*
-         * --------------------
-         */
+/*
 
-        /*
-         * Calculate target size
-         */
-        zoomSurfaceSize(rz_src->w, rz_src->h, zoom, zoom, &dstwidth, &dstheight);
+ rotozoomSurfaceTo()
 
-        /*
-         * Alloc space to completely contain the zoomed surface
-         */
-        rz_dst = NULL;
-        /*
-         * Target surface is 32bit with source RGBA/ABGR ordering
-         */
-        rz_dst =
-            SDL_CreateRGBSurface(SDL_SWSURFACE, dstwidth, dstheight, 32,
-                                 rz_src->format->Rmask, rz_src->format->Gmask,
-                                 rz_src->format->Bmask, rz_src->format->Amask);
+ Rotates and zoomes a 32bit 'src' surface into 'dst', which must have the size
+ given by rotozoomSurfaceDstSize() and the pixel format of 'src'. Pixels of
+ 'dst' outside the rotated source are left as they are, so a reused 'dst'
+ should be cleared first.
 
+*/
+
+void rotozoomSurfaceTo(SDL_Surface * src, SDL_Surface * dst, double angle,
+                       double zoom, int smooth)
+{
+    void *job = rotozoomSurfaceBegin(src, dst, angle, zoom, smooth);
+
+    if (job != NULL) {
+        rotozoomSurfaceRows(job, 0, dst->h);
+        rotozoomSurfaceEnd(job);
+    }
+}
+
+
+/* Publically available rotozoom function */
+
+SDL_Surface *rotozoomSurface(SDL_Surface * src, double angle,
+                             double zoom, int smooth)
+{
+    SDL_Surface *rz_src;
+    SDL_Surface *rz_dst;
+    int dstwidth, dstheight;
+    int src_converted;
+
+    /*
+     * Sanity check
+     */
+    if (src == NULL)
+        return (NULL);
+
+    /*
+     * Determine if source surface is 32bit or 8bit
+     */
+    if ((src->format->BitsPerPixel == 32) || (src->format->BitsPerPixel == 8)) {
         /*
-         * Lock source surface
-         */
-        SDL_LockSurface(rz_src);
-        /*
-         * Check which kind of surface we have
-         */
-        /*
-         * Call the 32bit transformation routine to do the zooming (using alpha)
-         */
-        zoomSurfaceRGBA(rz_src, rz_dst, smooth);
-        /*
-         * Turn on source-alpha support
+         * Use source surface 'as is'
          */
-        SDL_SetAlpha(rz_dst, SDL_SRCALPHA, 255);
+        rz_src = src;
+        src_converted = 0;
+    } else {
         /*
-         * Unlock source surface
+         * New source surface is 32bit with a defined RGBA ordering
          */
-        SDL_UnlockSurface(rz_src);
+        rz_src =
+            SDL_CreateRGBSurface(SDL_SWSURFACE, src->w, src->h, 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+        SDL_BlitSurface(src, NULL, rz_src, NULL);
+        src_converted = 1;
+    }
+
+    /* Determine target size */
+    rotozoomSurfaceDstSize(rz_src->w, rz_src->h, angle, zoom, &dstwidth, &dstheight);
+
+    /*
+     * Alloc space to completely contain the rotozoomed surface
+     * Target surface is 32bit with source RGBA/ABGR ordering
+     */
+    rz_dst =
+        SDL_CreateRGBSurface(SDL_SWSURFACE, dstwidth, dstheight, 32,
+                             rz_src->format->Rmask, rz_src->format->Gmask,
+                             rz_src->format->Bmask, rz_src->format->Amask);
+    if (rz_dst != NULL) {
+        rotozoomSurfaceTo(rz_src, rz_dst, angle, zoom, smooth);
     }
 
     /*
@@ -29,6 +29,16 @@
 #include "pgcompat.h"
 #include "doc/pygame_doc.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 /* With Python 2.5 exception types became new-style classes and
  * PyExc_BaseException was introduced.
  */
@@ -39,6 +49,14 @@
 #define ExcClassType_Check(o) PyType_Check(o)
 #endif
 
+/* Python file objects are read ahead and written behind through a buffer
+ * of rw_buffer_size bytes, so the many small reads and writes of the SDL
+ * decoders and encoders become a few calls into Python. A buffer is
+ * either a read ahead, of len bytes from which SDL has read up to pos,
+ * or, when writing is set, len bytes not yet written.
+ */
+#define RW_BUFFER_SIZE (64 * 1024)
+
 typedef struct
 {
     PyObject* read;
@@ -46,8 +64,26 @@ typedef struct
     PyObject* seek;
     PyObject* tell;
     PyObject* close;
+    Uint8* buf;         /* NULL if unbuffered */
+    int bufsize;
+    int len;            /* bytes in buf */
+    int pos;            /* next byte SDL reads from buf */
+    int writing;        /* buf holds bytes to write */
+    long base;          /* file position of buf[0], or -1 if not known */
+    int threaded;       /* the GIL is taken for each call into Python */
 } RWHelper;
 
+/* Objects with the buffer protocol are read and written in place */
+typedef struct
+{
+#if PG_ENABLE_NEWBUF
+    Py_buffer view;
+#endif
+    int pos;
+} MemHelper;
+
+static int rw_buffer_size = RW_BUFFER_SIZE;
+
 /*static const char default_encoding[] = "unicode_escape";*/
 /*static const char default_errors[] = "backslashreplace";*/
 static const char default_encoding[] = "unicode_escape";
@@ -59,10 +95,6 @@ static int rw_write (SDL_RWops* context, const void* ptr, int size, int maxnum);
 static int rw_close (SDL_RWops* context);
 
 #ifdef WITH_THREAD
-static int rw_seek_th (SDL_RWops* context, int offset, int whence);
-static int rw_read_th (SDL_RWops* context, void* ptr, int size, int maxnum);
-static int rw_write_th (SDL_RWops* context, const void* ptr, int size,
-                        int maxnum);
 static int rw_close_th (SDL_RWops* context);
 #endif
 
@@ -104,6 +136,10 @@ fetch_object_methods (RWHelper* helper, PyObject* obj)
 {
     helper->read = helper->write = helper->seek = helper->tell =
         helper->close = NULL;
+    helper->buf = NULL;
+    helper->bufsize = helper->len = helper->pos = helper->writing = 0;
+    helper->base = -1;
+    helper->threaded = 0;
 
     if (PyObject_HasAttrString (obj, "read"))
     {
@@ -247,6 +283,293 @@ RWopsEncodeFilePath(PyObject *obj, PyObject *eclass)
     return result;
 }
 
+static int
+alloc_buffer (RWHelper* helper)
+{
+    if (rw_buffer_size <= 0)
+        return 1;
+    helper->buf = (Uint8*) PyMem_Malloc (rw_buffer_size);
+    if (!helper->buf)
+        return 0;
+    helper->bufsize = rw_buffer_size;
+    return 1;
+}
+
+/* Needs the GIL */
+static void
+rw_free_helper (RWHelper* helper)
+{
+    Py_XDECREF (helper->seek);
+    Py_XDECREF (helper->tell);
+    Py_XDECREF (helper->write);
+    Py_XDECREF (helper->read);
+    Py_XDECREF (helper->close);
+    PyMem_Free (helper->buf);
+    PyMem_Del (helper);
+}
+
+#if PG_ENABLE_NEWBUF
+static int
+mem_seek (SDL_RWops* context, int offset, int whence)
+{
+    MemHelper* helper = (MemHelper*) context->hidden.unknown.data1;
+    Py_ssize_t pos;
+
+    switch (whence)
+    {
+    case SEEK_SET:
+        pos = offset;
+        break;
+    case SEEK_CUR:
+        pos = helper->pos + (Py_ssize_t) offset;
+        break;
+    case SEEK_END:
+        pos = helper->view.len + (Py_ssize_t) offset;
+        break;
+    default:
+        SDL_SetError ("Unknown value for 'whence'");
+        return -1;
+    }
+    if (pos < 0)
+        pos = 0;
+    if (pos > helper->view.len)
+        pos = helper->view.len;
+    helper->pos = (int) pos;
+    return helper->pos;
+}
+
+/* Like SDL_RWFromMem, only whole objects are read or written */
+static int
+mem_read (SDL_RWops* context, void* ptr, int size, int maxnum)
+{
+    MemHelper* helper = (MemHelper*) context->hidden.unknown.data1;
+    Py_ssize_t left = helper->view.len - helper->pos;
+
+    if (size <= 0)
+        return 0;
+    if ((Py_ssize_t) size * maxnum > left)
+        maxnum = (int) (left / size);
+    memcpy (ptr, (Uint8*) helper->view.buf + helper->pos, size * maxnum);
+    helper->pos += size * maxnum;
+    return maxnum;
+}
+
+static int
+mem_write (SDL_RWops* context, const void* ptr, int size, int num)
+{
+    MemHelper* helper = (MemHelper*) context->hidden.unknown.data1;
+    Py_ssize_t left = helper->view.len - helper->pos;
+
+    if (helper->view.readonly)
+    {
+        SDL_SetError ("Can't write to a read-only buffer");
+        return -1;
+    }
+    if (size <= 0)
+        return 0;
+    if ((Py_ssize_t) size * num > left)
+        num = (int) (left / size);
+    memcpy ((Uint8*) helper->view.buf + helper->pos, ptr, size * num);
+    helper->pos += size * num;
+    return num;
+}
+
+static int
+mem_close (SDL_RWops* context)
+{
+    MemHelper* helper = (MemHelper*) context->hidden.unknown.data1;
+#ifdef WITH_THREAD
+    PyGILState_STATE state = PyGILState_Ensure ();
+#endif
+
+    PyBuffer_Release (&helper->view);
+    PyMem_Del (helper);
+#ifdef WITH_THREAD
+    PyGILState_Release (state);
+#endif
+    SDL_FreeRW (context);
+    return 0;
+}
+#endif /* PG_ENABLE_NEWBUF */
+
+/* A RWops reading and writing the memory of an object with the buffer
+ * protocol in place, holding a view of it until closed. It never calls
+ * into Python, so the GIL can be released around its use. Returns NULL
+ * without an exception set for objects without the buffer protocol.
+ */
+static SDL_RWops*
+RWopsFromBuffer(PyObject *obj)
+{
+#if PG_ENABLE_NEWBUF
+    SDL_RWops *rw;
+    MemHelper *helper;
+
+    if (!PyObject_CheckBuffer(obj)) {
+        return NULL;
+    }
+    helper = PyMem_New(MemHelper, 1);
+    if (helper == NULL) {
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
+    if (PyObject_GetBuffer(obj, &helper->view,
+                           PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS)) {
+        PyErr_Clear();
+        if (PyObject_GetBuffer(obj, &helper->view, PyBUF_C_CONTIGUOUS)) {
+            /* Not one contiguous block; use the file methods */
+            PyErr_Clear();
+            PyMem_Del(helper);
+            return NULL;
+        }
+    }
+    if (helper->view.len > INT_MAX) {
+        PyBuffer_Release(&helper->view);
+        PyMem_Del(helper);
+        return NULL;
+    }
+    rw = SDL_AllocRW();
+    if (rw == NULL) {
+        PyBuffer_Release(&helper->view);
+        PyMem_Del(helper);
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
+    helper->pos = 0;
+    rw->hidden.unknown.data1 = (void *)helper;
+    rw->seek = mem_seek;
+    rw->read = mem_read;
+    rw->write = mem_write;
+    rw->close = mem_close;
+    return rw;
+#else
+    return NULL;
+#endif
+}
+
+/* A file of at least RW_MAP_MIN_SIZE bytes is mapped into memory and
+ * read in place through a SDL memory RWops, so the many small reads of
+ * the decoders are copies out of memory rather than stdio calls, and
+ * loaders of the same file share its pages. Smaller files, and files
+ * which can't be mapped, are read through stdio as before.
+ */
+#define RW_MAP_MIN_SIZE RW_BUFFER_SIZE
+
+static int
+map_close (SDL_RWops* context)
+{
+#if defined(_WIN32)
+    UnmapViewOfFile (context->hidden.mem.base);
+#else
+    munmap (context->hidden.mem.base,
+            (size_t) (context->hidden.mem.stop - context->hidden.mem.base));
+#endif
+    SDL_FreeRW (context);
+    return 0;
+}
+
+/* Returns NULL, with no error set, if the file isn't mapped */
+static SDL_RWops*
+map_file (const char* name)
+{
+    void* base;
+    int size;
+    SDL_RWops* rw;
+#if defined(_WIN32)
+    HANDLE file, mapping;
+    DWORD low, high;
+
+    file = CreateFileA (name, GENERIC_READ, FILE_SHARE_READ, NULL,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    low = GetFileSize (file, &high);
+    if (GetFileType (file) != FILE_TYPE_DISK ||
+        (low == INVALID_FILE_SIZE && GetLastError () != NO_ERROR) ||
+        high || low < RW_MAP_MIN_SIZE || low > INT_MAX)
+    {
+        CloseHandle (file);
+        return NULL;
+    }
+    size = (int) low;
+    mapping = CreateFileMapping (file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle (file);
+    if (!mapping)
+        return NULL;
+    base = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle (mapping);
+    if (!base)
+        return NULL;
+    rw = SDL_RWFromConstMem (base, size);
+    if (!rw)
+    {
+        UnmapViewOfFile (base);
+        return NULL;
+    }
+#else
+    struct stat st;
+    int fd = open (name, O_RDONLY);
+
+    if (fd == -1)
+        return NULL;
+    if (fstat (fd, &st) == -1 || !S_ISREG (st.st_mode) ||
+        st.st_size < RW_MAP_MIN_SIZE || st.st_size > INT_MAX)
+    {
+        close (fd);
+        return NULL;
+    }
+    size = (int) st.st_size;
+    base = mmap (NULL, (size_t) size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (base == MAP_FAILED)
+        return NULL;
+    rw = SDL_RWFromConstMem (base, size);
+    if (!rw)
+    {
+        munmap (base, (size_t) size);
+        return NULL;
+    }
+#endif
+    rw->close = map_close;
+    return rw;
+}
+
+/* A RWops reading the file name, mapped into memory when it is large
+ * enough. It never calls into Python, so it needs no GIL. Returns NULL
+ * with the SDL error set if the file can't be opened.
+ */
+static SDL_RWops*
+RWopsFromFileName (const char* name)
+{
+    SDL_RWops* rw = map_file (name);
+
+    if (rw)
+        return rw;
+    return SDL_RWFromFile (name, "rb");
+}
+
+/* If rw reads memory in place, through RWopsFromBuffer or a mapped file,
+ * set base and size to all of that memory and return 1, else return 0.
+ */
+static int
+RWopsGetMemory (SDL_RWops* rw, const Uint8** base, int* size)
+{
+    if (rw->close == map_close)
+    {
+        *base = rw->hidden.mem.base;
+        *size = (int) (rw->hidden.mem.stop - rw->hidden.mem.base);
+        return 1;
+    }
+#if PG_ENABLE_NEWBUF
+    if (rw->close == mem_close)
+    {
+        MemHelper* helper = (MemHelper*) rw->hidden.unknown.data1;
+
+        *base = (const Uint8*) helper->view.buf;
+        *size = (int) helper->view.len;
+        return 1;
+    }
+#endif
+    return 0;
+}
+
 static SDL_RWops*
 RWopsFromFileObject(PyObject *obj)
 {
@@ -256,6 +579,10 @@ RWopsFromFileObject(PyObject *obj)
     if (obj == NULL) {
         return (SDL_RWops *)RAISE(PyExc_TypeError, "Invalid filetype object");
     }
+    rw = RWopsFromBuffer(obj);
+    if (rw != NULL || PyErr_Occurred()) {
+        return rw;
+    }
     helper = PyMem_New(RWHelper, 1);
     if (helper == NULL) {
         return (SDL_RWops *)PyErr_NoMemory();
@@ -266,6 +593,11 @@ RWopsFromFileObject(PyObject *obj)
         return (SDL_RWops *)PyErr_NoMemory();
     }
     fetch_object_methods(helper, obj);
+    if (!alloc_buffer(helper)) {
+        rw_free_helper(helper);
+        SDL_FreeRW(rw);
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
     rw->hidden.unknown.data1 = (void *)helper;
     rw->seek = rw_seek;
     rw->read = rw_read;
@@ -287,7 +619,7 @@ RWopsFromObject(PyObject *obj)
             return NULL;
         }
         if (oencoded != Py_None) {
-            rw = SDL_RWFromFile(Bytes_AS_STRING(oencoded), "rb");
+            rw = RWopsFromFileName(Bytes_AS_STRING(oencoded));
         }
         Py_DECREF(oencoded);
         if (rw) {
@@ -305,100 +637,312 @@ RWopsCheckObject (SDL_RWops* rw)
 }
 
 
+/* The calls into Python, taking the GIL when threaded. Returns
+   -1 on an error, which is printed when threaded and else left set. */
+#ifdef WITH_THREAD
+#define RW_ENTER(helper)                                \
+    PyGILState_STATE state = PyGILState_UNLOCKED;       \
+    if ((helper)->threaded)                             \
+        state = PyGILState_Ensure ()
+#define RW_LEAVE(helper, failed)                        \
+    if ((helper)->threaded)                             \
+    {                                                   \
+        if (failed)                                     \
+            PyErr_Print ();                             \
+        PyGILState_Release (state);                     \
+    }
+#else
+#define RW_ENTER(helper)
+#define RW_LEAVE(helper, failed)
+#endif
+
+/* Read up to n bytes into ptr; returns the bytes read, 0 at the end */
 static int
-rw_seek (SDL_RWops* context, int offset, int whence)
+py_read (RWHelper* helper, void* ptr, int n)
 {
-    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
     PyObject* result;
-    int retval;
+    int retval = -1;
+    RW_ENTER (helper);
 
-    if (!helper->seek || !helper->tell)
-        return -1;
+    result = PyObject_CallFunction (helper->read, "i", n);
+    if (result)
+    {
+        if (Bytes_Check (result) && Bytes_GET_SIZE (result) <= n)
+        {
+            retval = (int) Bytes_GET_SIZE (result);
+            memcpy (ptr, Bytes_AS_STRING (result), retval);
+        }
+        Py_DECREF (result);
+    }
+    RW_LEAVE (helper, !result);
+    return retval;
+}
 
-    if (!(offset == 0 && whence == SEEK_CUR)) /*being called only for 'tell'*/
+static int
+py_write (RWHelper* helper, const void* ptr, int n)
+{
+    PyObject* result;
+    RW_ENTER (helper);
+
+    result = PyObject_CallFunction (helper->write, "s#", ptr, n);
+    Py_XDECREF (result);
+    RW_LEAVE (helper, !result);
+    return result ? 0 : -1;
+}
+
+/* Seek if seek is true, then tell */
+static long
+py_seek (RWHelper* helper, long offset, int whence, int seek)
+{
+    PyObject* result = NULL;
+    long retval = -1;
+    RW_ENTER (helper);
+
+    if (seek)
     {
-        result = PyObject_CallFunction (helper->seek, "ii", offset, whence);
+        result = PyObject_CallFunction (helper->seek, "li", offset, whence);
         if (!result)
-            return -1;
+            goto end;
         Py_DECREF (result);
     }
-
     result = PyObject_CallFunction (helper->tell, NULL);
     if (!result)
-        return -1;
-
+        goto end;
     retval = PyInt_AsLong (result);
     Py_DECREF (result);
+    if (retval == -1 && PyErr_Occurred ())
+        result = NULL;
 
+end:
+    RW_LEAVE (helper, !result);
     return retval;
 }
 
+/* Write out what buf holds */
 static int
-rw_read (SDL_RWops* context, void* ptr, int size, int maxnum)
+rw_flush (RWHelper* helper)
 {
-    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
-    int retval;
+    int len = helper->len;
 
-    if (!helper->read)
+    if (!helper->writing || !len)
+        return 0;
+    helper->len = helper->pos = 0;
+    if (helper->base >= 0)
+        helper->base += len;
+    return py_write (helper, helper->buf, len);
+}
+
+/* Empty buf, leaving the Python file where SDL has got to */
+static int
+rw_unbuffer (RWHelper* helper)
+{
+    int ahead = helper->len - helper->pos;
+
+    if (helper->writing)
+        return rw_flush (helper);
+    if (helper->base >= 0)
+        helper->base += helper->pos;
+    helper->len = helper->pos = 0;
+    if (!ahead)
+        return 0;
+    if (!helper->seek || !helper->tell)
         return -1;
+    return py_seek (helper, -ahead, SEEK_CUR, 1) < 0 ? -1 : 0;
+}
 
-    result = PyObject_CallFunction (helper->read, "i", size * maxnum);
-    if (!result)
+static int
+rw_seek (SDL_RWops* context, int offset, int whence)
+{
+    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
+    long cur, target;
+
+    if (!helper->seek || !helper->tell)
         return -1;
 
-    if (!Bytes_Check (result))
+    if (!helper->buf)
+        /* only seek if not being called only for 'tell' */
+        return (int) py_seek (helper, offset, whence,
+                              !(offset == 0 && whence == SEEK_CUR));
+
+    if (helper->base >= 0 && whence != SEEK_END)
     {
-        Py_DECREF (result);
-        return -1;
+        cur = helper->base + (helper->writing ? helper->len : helper->pos);
+        target = whence == SEEK_SET ? offset : cur + offset;
+        if (target == cur)
+            return (int) cur;
+        if (!helper->writing && target >= helper->base &&
+            target <= helper->base + helper->len)
+        {
+            /* Within what was read ahead */
+            helper->pos = (int) (target - helper->base);
+            return (int) target;
+        }
+    }
+    else if (offset == 0 && whence == SEEK_CUR)
+    {
+        /* A tell; the Python file is at the end of a read ahead and at
+           the start of what is to be written */
+        cur = py_seek (helper, 0, SEEK_CUR, 0);
+        if (cur < 0)
+            return -1;
+        if (helper->writing)
+        {
+            helper->base = cur;
+            return (int) (cur + helper->len);
+        }
+        helper->base = cur - helper->len;
+        return (int) (helper->base + helper->pos);
     }
 
-    retval = Bytes_GET_SIZE (result);
-    memcpy (ptr, Bytes_AsString (result), retval);
-    retval /= size;
+    if (whence == SEEK_CUR && !helper->writing)
+        offset -= helper->len - helper->pos;
+    else if (rw_flush (helper))
+        return -1;
+    helper->len = helper->pos = 0;
+    helper->writing = 0;
+    helper->base = py_seek (helper, offset, whence, 1);
+    return (int) helper->base;
+}
 
-    Py_DECREF (result);
-    return retval;
+static int
+rw_read (SDL_RWops* context, void* ptr, int size, int maxnum)
+{
+    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
+    Uint8* dst = (Uint8*) ptr;
+    int total = size * maxnum, done = 0, n;
+
+    if (!helper->read)
+        return -1;
+    if (size <= 0)
+        return 0;
+
+    if (!helper->buf)
+    {
+        n = py_read (helper, ptr, total);
+        return n < 0 ? -1 : n / size;
+    }
+
+    if (helper->writing)
+    {
+        if (rw_flush (helper))
+            return -1;
+        helper->writing = 0;
+    }
+    while (done < total)
+    {
+        if (helper->pos < helper->len)
+        {
+            n = MIN (helper->len - helper->pos, total - done);
+            memcpy (dst + done, helper->buf + helper->pos, n);
+            helper->pos += n;
+            done += n;
+            continue;
+        }
+        if (helper->base >= 0)
+            helper->base += helper->len;
+        helper->len = helper->pos = 0;
+        if (total - done >= helper->bufsize)
+        {
+            /* Big reads go straight through */
+            n = py_read (helper, dst + done, total - done);
+            if (n > 0)
+            {
+                done += n;
+                if (helper->base >= 0)
+                    helper->base += n;
+                continue;
+            }
+        }
+        else
+        {
+            n = py_read (helper, helper->buf, helper->bufsize);
+            if (n > 0)
+            {
+                helper->len = n;
+                continue;
+            }
+        }
+        if (n < 0 && !done)
+            return -1;
+        break;
+    }
+    return done / size;
 }
 
 static int
 rw_write (SDL_RWops* context, const void* ptr, int size, int num)
 {
     RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
+    int total = size * num;
 
     if (!helper->write)
         return -1;
 
-    result = PyObject_CallFunction (helper->write, "s#", ptr, size * num);
-    if(!result)
-        return -1;
+    if (!helper->buf)
+        return py_write (helper, ptr, total) ? -1 : num;
 
-    Py_DECREF (result);
+    if (!helper->writing)
+    {
+        if (rw_unbuffer (helper))
+            return -1;
+        helper->writing = 1;
+    }
+    if (helper->len + total > helper->bufsize && rw_flush (helper))
+        return -1;
+    if (total >= helper->bufsize)
+    {
+        /* Big writes go straight through */
+        if (py_write (helper, ptr, total))
+            return -1;
+        if (helper->base >= 0)
+            helper->base += total;
+        return num;
+    }
+    memcpy (helper->buf + helper->len, ptr, total);
+    helper->len += total;
     return num;
 }
 
+/* Write out what is buffered, or put the Python file back where SDL has
+   read to, and close it */
 static int
-rw_close (SDL_RWops* context)
+rw_close_helper (RWHelper* helper)
 {
-    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
     PyObject* result;
     int retval = 0;
 
+    if (helper->writing)
+        retval = rw_flush (helper);
+    else if (helper->len > helper->pos && helper->seek && helper->tell)
+    {
+        /* Only a courtesy to the caller, as the file is closed next */
+        if (rw_unbuffer (helper))
+            PyErr_Clear ();
+    }
+    if (retval && helper->threaded)
+        PyErr_Print ();
+
     if (helper->close)
     {
         result = PyObject_CallFunction (helper->close, NULL);
-        if (result)
+        if (!result)
+        {
+            if (helper->threaded)
+                PyErr_Print ();
             retval = -1;
+        }
         Py_XDECREF (result);
     }
 
-    Py_XDECREF (helper->seek);
-    Py_XDECREF (helper->tell);
-    Py_XDECREF (helper->write);
-    Py_XDECREF (helper->read);
-    Py_XDECREF (helper->close);
-    PyMem_Del (helper);
+    rw_free_helper (helper);
+    return retval;
+}
+
+static int
+rw_close (SDL_RWops* context)
+{
+    int retval = rw_close_helper ((RWHelper*) context->hidden.unknown.data1);
+
     SDL_FreeRW (context);
     return retval;
 }
@@ -417,6 +961,10 @@ RWopsFromFileObjectThreaded(PyObject *obj)
     return (SDL_RWops *)RAISE(PyExc_NotImplementedError,
                               "Python built without thread support");
 #else
+    rw = RWopsFromBuffer(obj);
+    if (rw != NULL || PyErr_Occurred()) {
+        return rw;
+    }
     helper = PyMem_New(RWHelper, 1);
     if (helper == NULL) {
         return (SDL_RWops *)PyErr_NoMemory();
@@ -427,10 +975,16 @@ RWopsFromFileObjectThreaded(PyObject *obj)
         return (SDL_RWops *)PyErr_NoMemory();
     }
     fetch_object_methods(helper, obj);
+    if (!alloc_buffer(helper)) {
+        rw_free_helper(helper);
+        SDL_FreeRW(rw);
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
+    helper->threaded = 1;
     rw->hidden.unknown.data1 = (void *)helper;
-    rw->seek = rw_seek_th;
-    rw->read = rw_read_th;
-    rw->write = rw_write_th;
+    rw->seek = rw_seek;
+    rw->read = rw_read;
+    rw->write = rw_write;
     rw->close = rw_close_th;
 
     PyEval_InitThreads();
@@ -450,149 +1004,14 @@ RWopsCheckObjectThreaded (SDL_RWops* rw)
 }
 
 #ifdef WITH_THREAD
-static int
-rw_seek_th (SDL_RWops* context, int offset, int whence)
-{
-    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
-    int retval;
-    PyGILState_STATE state;
-
-
-    if (!helper->seek || !helper->tell)
-        return -1;
-
-    state = PyGILState_Ensure();
-
-    if (!(offset == 0 && whence == SEEK_CUR)) /* being seek'd, not just tell'd */
-    {
-        result = PyObject_CallFunction (helper->seek, "ii", offset, whence);
-        if(!result)
-        {
-            PyErr_Print();
-            retval = -1;
-            goto end;
-        }
-        Py_DECREF (result);
-    }
-
-    result = PyObject_CallFunction (helper->tell, NULL);
-    if (!result)
-    {
-        PyErr_Print();
-        retval = -1;
-        goto end;
-    }
-
-    retval = PyInt_AsLong (result);
-    Py_DECREF (result);
-
-end:
-    PyGILState_Release(state);
-
-    return retval;
-}
-
-static int
-rw_read_th (SDL_RWops* context, void* ptr, int size, int maxnum)
-{
-    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
-    int retval;
-    PyGILState_STATE state;
-
-    if (!helper->read)
-        return -1;
-
-    state = PyGILState_Ensure();
-
-    result = PyObject_CallFunction (helper->read, "i", size * maxnum);
-    if (!result)
-    {
-        PyErr_Print();
-        retval = -1;
-        goto end;
-    }
-
-    if (!Bytes_Check (result))
-    {
-        Py_DECREF (result);
-        PyErr_Print();
-        retval = -1;
-        goto end;
-    }
-
-    retval = Bytes_GET_SIZE (result);
-    memcpy (ptr, Bytes_AsString (result), retval);
-    retval /= size;
-
-    Py_DECREF (result);
-
-end:
-    PyGILState_Release(state);
-
-    return retval;
-}
-
-static int
-rw_write_th (SDL_RWops* context, const void* ptr, int size, int num)
-{
-    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
-    int retval;
-    PyGILState_STATE state;
-
-    if (!helper->write)
-        return -1;
-
-    state = PyGILState_Ensure();
-
-    result = PyObject_CallFunction (helper->write, "s#", ptr, size * num);
-    if (!result)
-    {
-        PyErr_Print();
-        retval = -1;
-        goto end;
-    }
-
-    Py_DECREF (result);
-    retval = num;
-
-end:
-    PyGILState_Release(state);
-
-    return retval;
-}
-
 static int
 rw_close_th (SDL_RWops* context)
 {
-    RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
-    int retval = 0;
+    int retval;
     PyGILState_STATE state;
 
     state = PyGILState_Ensure();
-
-    if (helper->close)
-    {
-        result = PyObject_CallFunction (helper->close, NULL);
-        if (!result)
-        {
-            PyErr_Print();
-            retval = -1;
-        }
-        Py_XDECREF (result);
-    }
-
-    Py_XDECREF (helper->seek);
-    Py_XDECREF (helper->tell);
-    Py_XDECREF (helper->write);
-    Py_XDECREF (helper->read);
-    Py_XDECREF (helper->close);
-
-    PyMem_Del (helper);
-
+    retval = rw_close_helper ((RWHelper*) context->hidden.unknown.data1);
     PyGILState_Release(state);
 
     SDL_FreeRW (context);
@@ -639,8 +1058,33 @@ rwobject_encode_file_path(PyObject *self, PyObject *args, PyObject *keywds)
     return RWopsEncodeFilePath(obj, eclass);
 }
 
+static PyObject*
+rwobject_get_io_buffer_size(PyObject *self)
+{
+    return PyInt_FromLong(rw_buffer_size);
+}
+
+static PyObject*
+rwobject_set_io_buffer_size(PyObject *self, PyObject *args)
+{
+    int size;
+
+    if (!PyArg_ParseTuple(args, "i", &size)) {
+        return NULL;
+    }
+    if (size < 0) {
+        return RAISE(PyExc_ValueError, "size must not be negative");
+    }
+    rw_buffer_size = size;
+    Py_RETURN_NONE;
+}
+
 static PyMethodDef _rwobject_methods[] =
 {
+    { "get_io_buffer_size", (PyCFunction)rwobject_get_io_buffer_size,
+      METH_NOARGS, DOC_PYGAMEGETIOBUFFERSIZE },
+    { "set_io_buffer_size", rwobject_set_io_buffer_size, METH_VARARGS,
+      DOC_PYGAMESETIOBUFFERSIZE },
     { "encode_string", (PyCFunction)rwobject_encode_string,
       METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEENCODESTRING },
     { "encode_file_path", (PyCFunction)rwobject_encode_file_path,
@@ -689,6 +1133,8 @@ MODINIT_DEFINE (rwobject)
     c_api[4] = RWopsEncodeFilePath;
     c_api[5] = RWopsEncodeString;
     c_api[6] = RWopsFromFileObject;
+    c_api[7] = RWopsFromFileName;
+    c_api[8] = RWopsGetMemory;
     apiobj = encapsulate_api (c_api, "rwobject");
     if (apiobj == NULL) {
         DECREF_MOD (module);
@@ -70,4 +70,67 @@ void filter_expand_X_SSE_gcc(Uint8 *srcpix, Uint8 *dstpix, int *xidx0, int *xmul
 
 #endif /* #if (defined(__GNUC__) && .....) */
 
+/* The blur filters of the AVX2 and NEON backends convolve rows (X) or
+ * columns (Y) of 32 bit pixels with 2 * radius + 1 weights, 16.16 fixed
+ * point summing to 0x10000, repeating the edge pixels. The convolve filters
+ * take a square of (2 * radius + 1) ** 2 weights, which may be negative, and
+ * a source with radius pixels of border on every side; the results are
+ * clamped to 0 - 255.
+ */
+
+/* AVX2 smoothscale routines, in scale_avx2.c
+ * Available with GCC 4.9, clang or Visual C 2013 and later on x86. They are
+ * selected at runtime and give the same result as the generic C filters.
+ */
+
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+     (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1800 && (defined(_M_X64) || defined(_M_IX86)))
+#define SCALE_AVX2_SUPPORT
+
+void filter_shrink_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth);
+
+void filter_shrink_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight);
+
+void filter_expand_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth);
+
+void filter_expand_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight);
+
+void filter_blur_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius);
+
+void filter_blur_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int height, const int *weights, int radius);
+
+void filter_convolve_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius);
+
+#endif /* #if (defined(__GNUC__) && .....) */
+
+/* ARM NEON smoothscale routines, in scale_neon.c
+ * Available when the compiler targets NEON, which is always the case on
+ * 64 bit ARM. They give the same result as the generic C filters.
+ */
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define SCALE_NEON_SUPPORT
+
+void filter_shrink_X_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth);
+
+void filter_shrink_Y_NEON(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight);
+
+void filter_expand_X_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth);
+
+void filter_expand_Y_NEON(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight);
+
+void filter_blur_X_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius);
+
+void filter_blur_Y_NEON(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int height, const int *weights, int radius);
+
+void filter_convolve_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius);
+
+#endif /* #if defined(__ARM_NEON) || ..... */
+
+#if defined(SCALE_MMX_SUPPORT) || defined(SCALE_AVX2_SUPPORT) || \
+    defined(SCALE_NEON_SUPPORT)
+#define SCALE_SIMD_SUPPORT
+#endif
+
 #endif /* #if !defined(SCALE_HEADER) */
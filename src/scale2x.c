@@ -28,11 +28,19 @@
    an astonishing job of doubling game graphic data while interpolating out
    the jaggies. Congrats to the AdvanceMAME team, I'm very impressed and
    surprised with this code!
+
+   Scale3x is the three times version from the same page, and scale4x is
+   scale2x run twice, done here in one pass through a few rows of scratch.
 */
 
 
 
 #include <SDL.h>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCALE2X_SSE2
+#include <emmintrin.h>
+#endif
 #define MAX(a,b)    (((a) > (b)) ? (a) : (b))
 #define MIN(a,b)    (((a) < (b)) ? (a) : (b))
 
@@ -40,15 +48,215 @@
 #define READINT24(x)      ((x)[0]<<16 | (x)[1]<<8 | (x)[2])
 #define WRITEINT24(x, i)  {(x)[0]=i>>16; (x)[1]=(i>>8)&0xff; x[2]=i&0xff; }
 
+typedef void (*SCALE2X_ROW_P)(const Uint8 *above, const Uint8 *row,
+                              const Uint8 *below, Uint8 *out0, Uint8 *out1,
+                              int width);
+
+#define READINT8(x)       (*(Uint8*)(x))
+#define WRITEINT8(x, i)   {*(Uint8*)(x) = i; }
+#define READINT16(x)      (*(Uint16*)(x))
+#define WRITEINT16(x, i)  {*(Uint16*)(x) = i; }
+#define READINT32(x)      (*(Uint32*)(x))
+#define WRITEINT32(x, i)  {*(Uint32*)(x) = i; }
+
+#ifdef SCALE2X_SSE2
+#define SCALE2X_SELECT(mask, a, b) \
+    _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b))
+
+/*
+  the scale2x rules for the inner pixels of a row, a register at a time.
+  each rule is a compare mask, so whole vectors take the same path. this
+  returns the first pixel it did not do.
+*/
+#define SCALE2X_SSE2_ROW(name, BPP, CMPEQ, UNPACKLO, UNPACKHI)               \
+static int                                                                  \
+name(const Uint8 *above, const Uint8 *row, const Uint8 *below,              \
+     Uint8 *out0, Uint8 *out1, int width)                                   \
+{                                                                           \
+    __m128i B, D, E, F, H, keep, E0, E1, E2, E3;                            \
+    int x;                                                                  \
+                                                                            \
+    for(x = 1; x + 16 / BPP < width; x += 16 / BPP)                         \
+    {                                                                       \
+        B = _mm_loadu_si128((const __m128i*)(above + x * BPP));             \
+        D = _mm_loadu_si128((const __m128i*)(row + (x - 1) * BPP));         \
+        E = _mm_loadu_si128((const __m128i*)(row + x * BPP));               \
+        F = _mm_loadu_si128((const __m128i*)(row + (x + 1) * BPP));         \
+        H = _mm_loadu_si128((const __m128i*)(below + x * BPP));             \
+                                                                            \
+        keep = _mm_or_si128(CMPEQ(B, H), CMPEQ(D, F));                      \
+        E0 = SCALE2X_SELECT(_mm_andnot_si128(keep, CMPEQ(D, B)), D, E);     \
+        E1 = SCALE2X_SELECT(_mm_andnot_si128(keep, CMPEQ(B, F)), F, E);     \
+        E2 = SCALE2X_SELECT(_mm_andnot_si128(keep, CMPEQ(D, H)), D, E);     \
+        E3 = SCALE2X_SELECT(_mm_andnot_si128(keep, CMPEQ(H, F)), F, E);     \
+                                                                            \
+        _mm_storeu_si128((__m128i*)(out0 + x * 2 * BPP), UNPACKLO(E0, E1)); \
+        _mm_storeu_si128((__m128i*)(out0 + x * 2 * BPP + 16),               \
+                         UNPACKHI(E0, E1));                                 \
+        _mm_storeu_si128((__m128i*)(out1 + x * 2 * BPP), UNPACKLO(E2, E3)); \
+        _mm_storeu_si128((__m128i*)(out1 + x * 2 * BPP + 16),               \
+                         UNPACKHI(E2, E3));                                 \
+    }                                                                       \
+    return x;                                                               \
+}
+
+SCALE2X_SSE2_ROW(scale2x_sse2_8, 1, _mm_cmpeq_epi8,
+                 _mm_unpacklo_epi8, _mm_unpackhi_epi8)
+SCALE2X_SSE2_ROW(scale2x_sse2_16, 2, _mm_cmpeq_epi16,
+                 _mm_unpacklo_epi16, _mm_unpackhi_epi16)
+SCALE2X_SSE2_ROW(scale2x_sse2_32, 4, _mm_cmpeq_epi32,
+                 _mm_unpacklo_epi32, _mm_unpackhi_epi32)
+
+#define SCALE2X_VECTOR(name) name(above, row, below, out0, out1, width)
+#else
+#define SCALE2X_VECTOR(name) 1
+#endif
+
+/*
+  one source row, with the rows above and below it (or itself, at the
+  edges), into two destination rows. the edge pixels and whatever the
+  vector loop leaves are done one at a time.
+*/
+#define SCALE2X_ROW(name, TYPE, BPP, READ, WRITE, VECTOR)                     \
+static void                                                                 \
+name(const Uint8 *above, const Uint8 *row, const Uint8 *below,              \
+     Uint8 *out0, Uint8 *out1, int width)                                   \
+{                                                                           \
+    TYPE E0, E1, E2, E3, B, D, E, F, H;                                     \
+    int loopw, skip;                                                        \
+                                                                            \
+    skip = VECTOR;                                                          \
+    for(loopw = 0; loopw < width; loopw = loopw ? loopw + 1 : skip)         \
+    {                                                                       \
+        B = READ(above + BPP*loopw);                                        \
+        D = READ(row + BPP*MAX(0,loopw-1));                                 \
+        E = READ(row + BPP*loopw);                                          \
+        F = READ(row + BPP*MIN(width-1,loopw+1));                           \
+        H = READ(below + BPP*loopw);                                        \
+                                                                            \
+        E0 = D == B && B != F && D != H ? D : E;                            \
+        E1 = B == F && B != D && F != H ? F : E;                            \
+        E2 = D == H && D != B && H != F ? D : E;                            \
+        E3 = H == F && D != H && B != F ? F : E;                            \
+                                                                            \
+        WRITE((out0 + loopw*2*BPP), E0);                                    \
+        WRITE((out0 + (loopw*2+1)*BPP), E1);                                \
+        WRITE((out1 + loopw*2*BPP), E2);                                    \
+        WRITE((out1 + (loopw*2+1)*BPP), E3);                                \
+    }                                                                       \
+}
+
+SCALE2X_ROW(scale2x_row_8, Uint8, 1, READINT8, WRITEINT8,
+            SCALE2X_VECTOR(scale2x_sse2_8))
+SCALE2X_ROW(scale2x_row_16, Uint16, 2, READINT16, WRITEINT16,
+            SCALE2X_VECTOR(scale2x_sse2_16))
+SCALE2X_ROW(scale2x_row_24, int, 3, READINT24, WRITEINT24, 1)
+SCALE2X_ROW(scale2x_row_32, Uint32, 4, READINT32, WRITEINT32,
+            SCALE2X_VECTOR(scale2x_sse2_32))
+
+/*
+  one source row into three destination rows. A B C are the pixels above,
+  G H I the pixels below.
+*/
+#define SCALE3X_ROW(name, TYPE, BPP, READ, WRITE)                             \
+static void                                                                 \
+name(const Uint8 *above, const Uint8 *row, const Uint8 *below,              \
+     Uint8 *out0, Uint8 *out1, Uint8 *out2, int width)                      \
+{                                                                           \
+    TYPE E0, E1, E2, E3, E5, E6, E7, E8, A, B, C, D, E, F, G, H, I;         \
+    int loopw, left, right;                                                 \
+                                                                            \
+    for(loopw = 0; loopw < width; ++loopw)                                  \
+    {                                                                       \
+        left = BPP*MAX(0,loopw-1);                                          \
+        right = BPP*MIN(width-1,loopw+1);                                   \
+        A = READ(above + left);                                             \
+        B = READ(above + BPP*loopw);                                        \
+        C = READ(above + right);                                            \
+        D = READ(row + left);                                               \
+        E = READ(row + BPP*loopw);                                          \
+        F = READ(row + right);                                              \
+        G = READ(below + left);                                             \
+        H = READ(below + BPP*loopw);                                        \
+        I = READ(below + right);                                            \
+                                                                            \
+        if (B != H && D != F)                                               \
+        {                                                                   \
+            E0 = D == B ? D : E;                                            \
+            E1 = (D == B && E != C) || (B == F && E != A) ? B : E;          \
+            E2 = B == F ? F : E;                                            \
+            E3 = (D == B && E != G) || (D == H && E != A) ? D : E;          \
+            E5 = (B == F && E != I) || (H == F && E != C) ? F : E;          \
+            E6 = D == H ? D : E;                                            \
+            E7 = (D == H && E != I) || (H == F && E != G) ? H : E;          \
+            E8 = H == F ? F : E;                                            \
+        }                                                                   \
+        else                                                                \
+            E0 = E1 = E2 = E3 = E5 = E6 = E7 = E8 = E;                      \
+                                                                            \
+        WRITE((out0 + loopw*3*BPP), E0);                                    \
+        WRITE((out0 + (loopw*3+1)*BPP), E1);                                \
+        WRITE((out0 + (loopw*3+2)*BPP), E2);                                \
+        WRITE((out1 + loopw*3*BPP), E3);                                    \
+        WRITE((out1 + (loopw*3+1)*BPP), E);                                 \
+        WRITE((out1 + (loopw*3+2)*BPP), E5);                                \
+        WRITE((out2 + loopw*3*BPP), E6);                                    \
+        WRITE((out2 + (loopw*3+1)*BPP), E7);                                \
+        WRITE((out2 + (loopw*3+2)*BPP), E8);                                \
+    }                                                                       \
+}
+
+SCALE3X_ROW(scale3x_row_8, Uint8, 1, READINT8, WRITEINT8)
+SCALE3X_ROW(scale3x_row_16, Uint16, 2, READINT16, WRITEINT16)
+SCALE3X_ROW(scale3x_row_24, int, 3, READINT24, WRITEINT24)
+SCALE3X_ROW(scale3x_row_32, Uint32, 4, READINT32, WRITEINT32)
+
+static SCALE2X_ROW_P
+scale2x_row(int bpp)
+{
+    switch(bpp)
+    {
+    case 1: return scale2x_row_8;
+    case 2: return scale2x_row_16;
+    case 3: return scale2x_row_24;
+    default: return scale2x_row_32;
+    }
+}
+
 /*
-  this requires a destination surface already setup to be twice as
-  large as the source. oh, and formats must match too. this will just
-  blindly assume you didn't flounder.
+  these require a destination surface already setup to be two, three or
+  four times as large as the source. oh, and formats must match too. this
+  will just blindly assume you didn't flounder.
 */
 
 void scale2x(SDL_Surface *src, SDL_Surface *dst)
 {
-    int looph, loopw;
+    int looph;
+
+    Uint8* srcpix = (Uint8*)src->pixels;
+    Uint8* dstpix = (Uint8*)dst->pixels;
+
+    const int srcpitch = src->pitch;
+    const int dstpitch = dst->pitch;
+    const int width = src->w;
+    const int height = src->h;
+    SCALE2X_ROW_P row = scale2x_row(src->format->BytesPerPixel);
+
+    for(looph = 0; looph < height; ++looph)
+    {
+        row(srcpix + MAX(0,looph-1)*srcpitch,
+            srcpix + looph*srcpitch,
+            srcpix + MIN(height-1,looph+1)*srcpitch,
+            dstpix + looph*2*dstpitch,
+            dstpix + (looph*2+1)*dstpitch, width);
+    }
+}
+
+void scale3x(SDL_Surface *src, SDL_Surface *dst)
+{
+    int looph;
+    void (*row)(const Uint8 *, const Uint8 *, const Uint8 *,
+                Uint8 *, Uint8 *, Uint8 *, int);
 
     Uint8* srcpix = (Uint8*)src->pixels;
     Uint8* dstpix = (Uint8*)dst->pixels;
@@ -60,97 +268,77 @@ void scale2x(SDL_Surface *src, SDL_Surface *dst)
 
     switch(src->format->BytesPerPixel)
     {
-    case 1: {
-        Uint8 E0, E1, E2, E3, B, D, E, F, H;
-        for(looph = 0; looph < height; ++looph)
-        {
-            for(loopw = 0; loopw < width; ++ loopw)
-            {
-                    B = *(Uint8*)(srcpix + (MAX(0,looph-1)*srcpitch) + (1*loopw));
-                    D = *(Uint8*)(srcpix + (looph*srcpitch) + (1*MAX(0,loopw-1)));
-                    E = *(Uint8*)(srcpix + (looph*srcpitch) + (1*loopw));
-                    F = *(Uint8*)(srcpix + (looph*srcpitch) + (1*MIN(width-1,loopw+1)));
-                    H = *(Uint8*)(srcpix + (MIN(height-1,looph+1)*srcpitch) + (1*loopw));
-
-                E0 = D == B && B != F && D != H ? D : E;
-                                E1 = B == F && B != D && F != H ? F : E;
-                E2 = D == H && D != B && H != F ? D : E;
-                E3 = H == F && D != H && B != F ? F : E;
-
-                *(Uint8*)(dstpix + looph*2*dstpitch + loopw*2*1) = E0;
-                *(Uint8*)(dstpix + looph*2*dstpitch + (loopw*2+1)*1) = E1;
-                *(Uint8*)(dstpix + (looph*2+1)*dstpitch + loopw*2*1) = E2;
-                *(Uint8*)(dstpix + (looph*2+1)*dstpitch + (loopw*2+1)*1) = E3;
-            }
-        }break;}
-    case 2: {
-        Uint16 E0, E1, E2, E3, B, D, E, F, H;
-        for(looph = 0; looph < height; ++looph)
-        {
-            for(loopw = 0; loopw < width; ++ loopw)
-            {
-                    B = *(Uint16*)(srcpix + (MAX(0,looph-1)*srcpitch) + (2*loopw));
-                    D = *(Uint16*)(srcpix + (looph*srcpitch) + (2*MAX(0,loopw-1)));
-                    E = *(Uint16*)(srcpix + (looph*srcpitch) + (2*loopw));
-                    F = *(Uint16*)(srcpix + (looph*srcpitch) + (2*MIN(width-1,loopw+1)));
-                    H = *(Uint16*)(srcpix + (MIN(height-1,looph+1)*srcpitch) + (2*loopw));
-
-                E0 = D == B && B != F && D != H ? D : E;
-                                E1 = B == F && B != D && F != H ? F : E;
-                E2 = D == H && D != B && H != F ? D : E;
-                E3 = H == F && D != H && B != F ? F : E;
-
-                *(Uint16*)(dstpix + looph*2*dstpitch + loopw*2*2) = E0;
-                *(Uint16*)(dstpix + looph*2*dstpitch + (loopw*2+1)*2) = E1;
-                *(Uint16*)(dstpix + (looph*2+1)*dstpitch + loopw*2*2) = E2;
-                *(Uint16*)(dstpix + (looph*2+1)*dstpitch + (loopw*2+1)*2) = E3;
-            }
-        }break;}
-    case 3: {
-        int E0, E1, E2, E3, B, D, E, F, H;
-        for(looph = 0; looph < height; ++looph)
-        {
-            for(loopw = 0; loopw < width; ++ loopw)
-            {
-                    B = READINT24(srcpix + (MAX(0,looph-1)*srcpitch) + (3*loopw));
-                    D = READINT24(srcpix + (looph*srcpitch) + (3*MAX(0,loopw-1)));
-                    E = READINT24(srcpix + (looph*srcpitch) + (3*loopw));
-                    F = READINT24(srcpix + (looph*srcpitch) + (3*MIN(width-1,loopw+1)));
-                    H = READINT24(srcpix + (MIN(height-1,looph+1)*srcpitch) + (3*loopw));
-
-                E0 = D == B && B != F && D != H ? D : E;
-                                E1 = B == F && B != D && F != H ? F : E;
-                E2 = D == H && D != B && H != F ? D : E;
-                E3 = H == F && D != H && B != F ? F : E;
-
-                WRITEINT24((dstpix + looph*2*dstpitch + loopw*2*3), E0);
-                WRITEINT24((dstpix + looph*2*dstpitch + (loopw*2+1)*3), E1);
-                WRITEINT24((dstpix + (looph*2+1)*dstpitch + loopw*2*3), E2);
-                WRITEINT24((dstpix + (looph*2+1)*dstpitch + (loopw*2+1)*3), E3);
-            }
-        }break;}
-    default: { /*case 4:*/
-        Uint32 E0, E1, E2, E3, B, D, E, F, H;
-        for(looph = 0; looph < height; ++looph)
+    case 1: row = scale3x_row_8; break;
+    case 2: row = scale3x_row_16; break;
+    case 3: row = scale3x_row_24; break;
+    default: row = scale3x_row_32; break;
+    }
+
+    for(looph = 0; looph < height; ++looph)
+    {
+        row(srcpix + MAX(0,looph-1)*srcpitch,
+            srcpix + looph*srcpitch,
+            srcpix + MIN(height-1,looph+1)*srcpitch,
+            dstpix + looph*3*dstpitch,
+            dstpix + (looph*3+1)*dstpitch,
+            dstpix + (looph*3+2)*dstpitch, width);
+    }
+}
+
+/*
+  scale2x of scale2x, without the double sized surface in between. scratch
+  holds the doubled rows of three source rows, from scale4x_scratch_size.
+*/
+
+size_t scale4x_scratch_size(SDL_Surface *src)
+{
+    return (size_t)src->w * 2 * src->format->BytesPerPixel * 6;
+}
+
+void scale4x(SDL_Surface *src, SDL_Surface *dst, Uint8 *scratch)
+{
+    int looph;
+    Uint8 *pair[3];
+
+    Uint8* srcpix = (Uint8*)src->pixels;
+    Uint8* dstpix = (Uint8*)dst->pixels;
+
+    const int srcpitch = src->pitch;
+    const int dstpitch = dst->pitch;
+    const int width = src->w;
+    const int height = src->h;
+    const int midpitch = width * 2 * src->format->BytesPerPixel;
+    SCALE2X_ROW_P row = scale2x_row(src->format->BytesPerPixel);
+
+    /* pair[n % 3] is source row n doubled, as two rows */
+    for(looph = 0; looph < 3; ++looph)
+        pair[looph] = scratch + looph * 2 * midpitch;
+
+    for(looph = 0; looph <= height; ++looph)
+    {
+        Uint8 *mid, *up, *down;
+
+        /* double the source row below first, when there is one */
+        if (looph < height)
         {
-            for(loopw = 0; loopw < width; ++ loopw)
-            {
-                    B = *(Uint32*)(srcpix + (MAX(0,looph-1)*srcpitch) + (4*loopw));
-                    D = *(Uint32*)(srcpix + (looph*srcpitch) + (4*MAX(0,loopw-1)));
-                    E = *(Uint32*)(srcpix + (looph*srcpitch) + (4*loopw));
-                    F = *(Uint32*)(srcpix + (looph*srcpitch) + (4*MIN(width-1,loopw+1)));
-                    H = *(Uint32*)(srcpix + (MIN(height-1,looph+1)*srcpitch) + (4*loopw));
-
-                E0 = D == B && B != F && D != H ? D : E;
-                                E1 = B == F && B != D && F != H ? F : E;
-                E2 = D == H && D != B && H != F ? D : E;
-                E3 = H == F && D != H && B != F ? F : E;
-
-                *(Uint32*)(dstpix + looph*2*dstpitch + loopw*2*4) = E0;
-                *(Uint32*)(dstpix + looph*2*dstpitch + (loopw*2+1)*4) = E1;
-                *(Uint32*)(dstpix + (looph*2+1)*dstpitch + loopw*2*4) = E2;
-                *(Uint32*)(dstpix + (looph*2+1)*dstpitch + (loopw*2+1)*4) = E3;
-            }
-        }break;}
+            mid = pair[looph % 3];
+            row(srcpix + MAX(0,looph-1)*srcpitch,
+                srcpix + looph*srcpitch,
+                srcpix + MIN(height-1,looph+1)*srcpitch,
+                mid, mid + midpitch, width);
+        }
+        if (looph == 0)
+            continue;
+
+        /* then the rows doubled from the source row above it */
+        mid = pair[(looph - 1) % 3];
+        up = looph > 1 ? pair[(looph - 2) % 3] + midpitch : mid;
+        down = looph < height ? pair[looph % 3] : mid + midpitch;
+        row(up, mid, mid + midpitch,
+            dstpix + (looph-1)*4*dstpitch,
+            dstpix + ((looph-1)*4+1)*dstpitch, width * 2);
+        row(mid, mid + midpitch, down,
+            dstpix + ((looph-1)*4+2)*dstpitch,
+            dstpix + ((looph-1)*4+3)*dstpitch, width * 2);
     }
 }
@@ -0,0 +1,495 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* AVX2 smoothscale routines
+ * These do the integer arithmetic of the generic filters in transform.c,
+ * one 32 bit lane per colour channel, so the results are exactly the same.
+ * The Y filters and expand_X do two pixels per instruction, shrink_X does
+ * one pixel of each of two rows.
+ *
+ * This file should not depend on anything but the C standard library.
+ */
+
+#include <stdint.h>
+typedef uint8_t Uint8;    /* SDL convension */
+typedef uint16_t Uint16;  /* SDL convension */
+#include <stdlib.h>
+#include <string.h>
+#include "scale.h"
+
+#if defined(SCALE_AVX2_SUPPORT)
+
+#include <immintrin.h>
+
+/* GCC and clang need the instruction set enabled per function, since the
+ * module itself is not compiled with -mavx2.
+ */
+#if defined(__GNUC__)
+#define SCALE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SCALE_TARGET_AVX2
+#endif
+
+/* The low byte of each 32 bit lane, packed into the low 8 bytes. This
+ * truncates like the (Uint8) casts of the generic filters.
+ */
+static SCALE_TARGET_AVX2 __m128i
+low_bytes_8(__m256i v)
+{
+    __m256i pick = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1,
+                                    -1, -1, -1, -1, -1, -1, -1, -1,
+                                    0, 4, 8, 12, -1, -1, -1, -1,
+                                    -1, -1, -1, -1, -1, -1, -1, -1);
+
+    v = _mm256_shuffle_epi8(v, pick);
+    v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 1, 1,
+                                                         1, 1, 1, 1));
+    return _mm256_castsi256_si128(v);
+}
+
+/* Two pixels, eight channels, as 32 bit lanes */
+static SCALE_TARGET_AVX2 __m256i
+load_channels_8(const Uint8 *src)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) src));
+}
+
+static SCALE_TARGET_AVX2 void
+store_channels_8(Uint8 *dst, __m256i v)
+{
+    _mm_storel_epi64((__m128i *) dst, low_bytes_8(v));
+}
+
+/* This function implements an area-averaging shrinking filter in the X-dimension.
+ * Every row has the same source pixel weights, so two rows are done at once,
+ * one in each half of the registers.
+ */
+void SCALE_TARGET_AVX2
+filter_shrink_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth)
+{
+    int xspace = 0x10000 * srcwidth / dstwidth; /* must be > 1 */
+    int xrecip = (int) (0x100000000LL / xspace);
+    __m256i recip = _mm256_set1_epi32(xrecip);
+    __m256i mask16 = _mm256_set1_epi32(0xFFFF);
+    int x, y;
+
+    for (y = 0; y < height; y += 2)
+    {
+        Uint8 *src0 = srcpix + y * srcpitch;
+        Uint8 *src1 = y + 1 < height ? src0 + srcpitch : src0;
+        Uint8 *dst0 = dstpix + y * dstpitch;
+        Uint8 *dst1 = dst0 + dstpitch;
+        __m256i accumulate = _mm256_setzero_si256();
+        int xcounter = xspace;
+        int d = 0;
+
+        for (x = 0; x < srcwidth; x++, src0 += 4, src1 += 4)
+        {
+            int p0, p1;
+            __m256i pixels;
+
+            memcpy(&p0, src0, 4);
+            memcpy(&p1, src1, 4);
+            pixels = _mm256_cvtepu8_epi32(
+                _mm_unpacklo_epi32(_mm_cvtsi32_si128(p0),
+                                   _mm_cvtsi32_si128(p1)));
+            if (xcounter > 0x10000)
+            {
+                accumulate = _mm256_add_epi32(accumulate, pixels);
+                xcounter -= 0x10000;
+            }
+            else
+            {
+                int xfrac = 0x10000 - xcounter;
+                __m256i out;
+                __m128i bytes;
+
+                /* write out a destination pixel; the accumulator is 16 bit
+                   in the generic filter, so wrap it the same way */
+                out = _mm256_srli_epi32(
+                    _mm256_mullo_epi32(pixels, _mm256_set1_epi32(xcounter)),
+                    16);
+                out = _mm256_add_epi32(_mm256_and_si256(accumulate, mask16),
+                                       out);
+                out = _mm256_srli_epi32(_mm256_mullo_epi32(out, recip), 16);
+                bytes = low_bytes_8(out);
+                p0 = _mm_cvtsi128_si32(bytes);
+                p1 = _mm_extract_epi32(bytes, 1);
+                memcpy(dst0 + d, &p0, 4);
+                if (y + 1 < height)
+                    memcpy(dst1 + d, &p1, 4);
+                d += 4;
+                /* reload the accumulator with the remainder of this pixel */
+                accumulate = _mm256_srli_epi32(
+                    _mm256_mullo_epi32(pixels, _mm256_set1_epi32(xfrac)), 16);
+                xcounter = xspace - xfrac;
+            }
+        }
+    }
+}
+
+/* This function implements an area-averaging shrinking filter in the Y-dimension.
+ */
+void SCALE_TARGET_AVX2
+filter_shrink_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight)
+{
+    Uint16 *templine;
+    int channels = width * 4;
+    int i, y;
+    int yspace = 0x10000 * srcheight / dstheight; /* must be > 1 */
+    int yrecip = (int) (0x100000000LL / yspace);
+    int ycounter = yspace;
+    __m256i recip = _mm256_set1_epi32(yrecip);
+
+    /* allocate and clear a memory area for storing the accumulator line */
+    templine = (Uint16 *) malloc(channels * 2);
+    if (templine == NULL) return;
+    memset(templine, 0, channels * 2);
+
+    for (y = 0; y < srcheight; y++)
+    {
+        if (ycounter > 0x10000)
+        {
+            for (i = 0; i + 16 <= channels; i += 16)
+            {
+                __m256i acc = _mm256_loadu_si256((__m256i *) (templine + i));
+                __m256i src = _mm256_cvtepu8_epi16(
+                    _mm_loadu_si128((const __m128i *) (srcpix + i)));
+                _mm256_storeu_si256((__m256i *) (templine + i),
+                                    _mm256_add_epi16(acc, src));
+            }
+            for (; i < channels; i++)
+                templine[i] += (Uint16) srcpix[i];
+            ycounter -= 0x10000;
+        }
+        else
+        {
+            int yfrac = 0x10000 - ycounter;
+            __m256i yc = _mm256_set1_epi32(ycounter);
+            __m256i yf = _mm256_set1_epi32(yfrac);
+
+            /* write out a destination line and reload the accumulator with
+               the remainder of this line */
+            for (i = 0; i + 8 <= channels; i += 8)
+            {
+                __m256i acc = _mm256_cvtepu16_epi32(
+                    _mm_loadu_si128((const __m128i *) (templine + i)));
+                __m256i src = load_channels_8(srcpix + i);
+                __m256i out;
+
+                out = _mm256_srli_epi32(_mm256_mullo_epi32(src, yc), 16);
+                out = _mm256_srli_epi32(
+                    _mm256_mullo_epi32(_mm256_add_epi32(acc, out), recip), 16);
+                store_channels_8(dstpix + i, out);
+                out = _mm256_srli_epi32(_mm256_mullo_epi32(src, yf), 16);
+                _mm_storeu_si128((__m128i *) (templine + i),
+                                 _mm_cvtepu8_epi16(low_bytes_8(out)));
+            }
+            for (; i < channels; i++)
+            {
+                dstpix[i] = (Uint8) (((templine[i] + ((srcpix[i] * ycounter) >> 16)) * yrecip) >> 16);
+                templine[i] = (Uint16) ((srcpix[i] * yfrac) >> 16);
+            }
+            dstpix += dstpitch;
+            ycounter = yspace - yfrac;
+        }
+        srcpix += srcpitch;
+    } /* for (int y = 0; y < srcheight; y++) */
+
+    /* free the temporary memory */
+    free(templine);
+}
+
+/* This function implements a bilinear filter in the X-dimension.
+ */
+void SCALE_TARGET_AVX2
+filter_expand_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth)
+{
+    int *xidx0, *xmult0, *xmult1;
+    int x, y;
+    __m128i apick = _mm_setr_epi8(0, 1, 2, 3, 8, 9, 10, 11,
+                                  -1, -1, -1, -1, -1, -1, -1, -1);
+    __m128i bpick = _mm_setr_epi8(4, 5, 6, 7, 12, 13, 14, 15,
+                                  -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i spread = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+
+    /* Allocate memory for factors */
+    xidx0 = (int *) malloc(dstwidth * sizeof (int));
+    xmult0 = (int *) malloc(dstwidth * sizeof (int));
+    xmult1 = (int *) malloc(dstwidth * sizeof (int));
+    if (xidx0 == NULL || xmult0 == NULL || xmult1 == NULL)
+    {
+        free(xidx0);
+        free(xmult0);
+        free(xmult1);
+        return;
+    }
+
+    /* Create multiplier factors and starting indices and put them in arrays */
+    for (x = 0; x < dstwidth; x++)
+    {
+        xidx0[x] = x * (srcwidth - 1) / dstwidth;
+        xmult1[x] = 0x10000 * ((x * (srcwidth - 1)) % dstwidth) / dstwidth;
+        xmult0[x] = 0x10000 - xmult1[x];
+    }
+
+    /* Do the scaling in raster order so we don't trash the cache */
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *srcrow0 = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        for (x = 0; x + 2 <= dstwidth; x += 2, dst += 8)
+        {
+            /* both source pixels of the two destination pixels */
+            __m128i pair = _mm_unpacklo_epi64(
+                _mm_loadl_epi64((const __m128i *) (srcrow0 + xidx0[x] * 4)),
+                _mm_loadl_epi64((const __m128i *) (srcrow0 + xidx0[x + 1] * 4)));
+            __m256i a = _mm256_cvtepu8_epi32(_mm_shuffle_epi8(pair, apick));
+            __m256i b = _mm256_cvtepu8_epi32(_mm_shuffle_epi8(pair, bpick));
+            __m256i xm0 = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(
+                _mm_loadl_epi64((const __m128i *) (xmult0 + x))), spread);
+            __m256i xm1 = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(
+                _mm_loadl_epi64((const __m128i *) (xmult1 + x))), spread);
+
+            store_channels_8(dst, _mm256_srli_epi32(
+                _mm256_add_epi32(_mm256_mullo_epi32(a, xm0),
+                                 _mm256_mullo_epi32(b, xm1)), 16));
+        }
+        if (x < dstwidth)
+        {
+            Uint8 *src = srcrow0 + xidx0[x] * 4;
+            int xm0 = xmult0[x];
+            int xm1 = xmult1[x];
+            *dst++ = (Uint8) (((src[0] * xm0) + (src[4] * xm1)) >> 16);
+            *dst++ = (Uint8) (((src[1] * xm0) + (src[5] * xm1)) >> 16);
+            *dst++ = (Uint8) (((src[2] * xm0) + (src[6] * xm1)) >> 16);
+            *dst++ = (Uint8) (((src[3] * xm0) + (src[7] * xm1)) >> 16);
+        }
+    }
+
+    /* free memory */
+    free(xidx0);
+    free(xmult0);
+    free(xmult1);
+}
+
+/* This function implements a bilinear filter in the Y-dimension.
+ */
+void SCALE_TARGET_AVX2
+filter_expand_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight)
+{
+    int channels = width * 4;
+    int i, y;
+
+    for (y = 0; y < dstheight; y++)
+    {
+        int yidx0 = y * (srcheight - 1) / dstheight;
+        Uint8 *srcrow0 = srcpix + yidx0 * srcpitch;
+        Uint8 *srcrow1 = srcrow0 + srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+        int ymult1 = 0x10000 * ((y * (srcheight - 1)) % dstheight) / dstheight;
+        int ymult0 = 0x10000 - ymult1;
+        __m256i ym0 = _mm256_set1_epi32(ymult0);
+        __m256i ym1 = _mm256_set1_epi32(ymult1);
+
+        for (i = 0; i + 8 <= channels; i += 8)
+        {
+            __m256i a = load_channels_8(srcrow0 + i);
+            __m256i b = load_channels_8(srcrow1 + i);
+
+            store_channels_8(dst + i, _mm256_srli_epi32(
+                _mm256_add_epi32(_mm256_mullo_epi32(a, ym0),
+                                 _mm256_mullo_epi32(b, ym1)), 16));
+        }
+        for (; i < channels; i++)
+            dst[i] = (Uint8) (((srcrow0[i] * ymult0) + (srcrow1[i] * ymult1)) >> 16);
+    }
+}
+
+/* One pixel of the X blur filter, with the edge pixels repeated; these are
+ * the pixels within radius of the ends of a row.
+ */
+static void
+blur_pixel_X(Uint8 *src, Uint8 *dst, int x, int width, const int *weights, int radius)
+{
+    int sum[4] = {0x8000, 0x8000, 0x8000, 0x8000};
+    int k;
+
+    for (k = -radius; k <= radius; k++)
+    {
+        int sx = x + k;
+        Uint8 *p;
+        int w = weights[k + radius];
+
+        if (sx < 0) sx = 0;
+        else if (sx >= width) sx = width - 1;
+        p = src + sx * 4;
+        sum[0] += p[0] * w;
+        sum[1] += p[1] * w;
+        sum[2] += p[2] * w;
+        sum[3] += p[3] * w;
+    }
+    dst[0] = (Uint8) (sum[0] >> 16);
+    dst[1] = (Uint8) (sum[1] >> 16);
+    dst[2] = (Uint8) (sum[2] >> 16);
+    dst[3] = (Uint8) (sum[3] >> 16);
+}
+
+/* This function implements a weighted blur filter in the X-dimension.
+ */
+void SCALE_TARGET_AVX2
+filter_blur_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius)
+{
+    int x, y, k;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *src = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        for (x = 0; x < radius && x < width; x++)
+            blur_pixel_X(src, dst + x * 4, x, width, weights, radius);
+        /* two destination pixels per step: each load has the source pixel
+           of a weight for both of them */
+        for (; x + radius + 2 <= width; x += 2)
+        {
+            Uint8 *p = src + (x - radius) * 4;
+            __m256i sum = _mm256_set1_epi32(0x8000);
+
+            for (k = 0; k <= 2 * radius; k++, p += 4)
+                sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(
+                    load_channels_8(p), _mm256_set1_epi32(weights[k])));
+            store_channels_8(dst + x * 4, _mm256_srli_epi32(sum, 16));
+        }
+        for (; x < width; x++)
+            blur_pixel_X(src, dst + x * 4, x, width, weights, radius);
+    }
+}
+
+/* This function implements a weighted blur filter in the Y-dimension.
+ */
+void SCALE_TARGET_AVX2
+filter_blur_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int height, const int *weights, int radius)
+{
+    Uint8 **rows;
+    int channels = width * 4;
+    int i, k, y;
+
+    /* the source rows of each weight, with the edge rows repeated */
+    rows = (Uint8 **) malloc((2 * radius + 1) * sizeof (Uint8 *));
+    if (rows == NULL) return;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        for (k = 0; k <= 2 * radius; k++)
+        {
+            int sy = y + k - radius;
+
+            if (sy < 0) sy = 0;
+            else if (sy >= height) sy = height - 1;
+            rows[k] = srcpix + sy * srcpitch;
+        }
+        for (i = 0; i + 8 <= channels; i += 8)
+        {
+            __m256i sum = _mm256_set1_epi32(0x8000);
+
+            for (k = 0; k <= 2 * radius; k++)
+                sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(
+                    load_channels_8(rows[k] + i), _mm256_set1_epi32(weights[k])));
+            store_channels_8(dst + i, _mm256_srli_epi32(sum, 16));
+        }
+        for (; i < channels; i++)
+        {
+            int sum = 0x8000;
+
+            for (k = 0; k <= 2 * radius; k++)
+                sum += rows[k][i] * weights[k];
+            dst[i] = (Uint8) (sum >> 16);
+        }
+    }
+
+    free(rows);
+}
+
+/* One pixel of the convolve filter */
+static void
+convolve_pixel(Uint8 *src, Uint8 *dst, int srcpitch, const int *weights, int size)
+{
+    int sum[4] = {0x8000, 0x8000, 0x8000, 0x8000};
+    int i, kx, ky;
+
+    for (ky = 0; ky < size; ky++, src += srcpitch)
+    {
+        for (kx = 0; kx < size; kx++)
+        {
+            Uint8 *p = src + kx * 4;
+            int w = *weights++;
+
+            sum[0] += p[0] * w;
+            sum[1] += p[1] * w;
+            sum[2] += p[2] * w;
+            sum[3] += p[3] * w;
+        }
+    }
+    for (i = 0; i < 4; i++)
+        dst[i] = (Uint8) (sum[i] < 0 ? 0 : sum[i] >= 0x1000000 ? 255 : sum[i] >> 16);
+}
+
+/* This function implements a convolution with a square kernel.
+ */
+void SCALE_TARGET_AVX2
+filter_convolve_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius)
+{
+    int size = 2 * radius + 1;
+    __m256i low = _mm256_setzero_si256();
+    __m256i high = _mm256_set1_epi32(255);
+    int x, y, kx, ky;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *src = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        /* two destination pixels per step, as in filter_blur_X_AVX2 */
+        for (x = 0; x + 2 <= width; x += 2)
+        {
+            const int *w = weights;
+            __m256i sum = _mm256_set1_epi32(0x8000);
+
+            for (ky = 0; ky < size; ky++)
+            {
+                Uint8 *p = src + ky * srcpitch + x * 4;
+
+                for (kx = 0; kx < size; kx++, p += 4)
+                    sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(
+                        load_channels_8(p), _mm256_set1_epi32(*w++)));
+            }
+            sum = _mm256_min_epi32(_mm256_max_epi32(
+                _mm256_srai_epi32(sum, 16), low), high);
+            store_channels_8(dst + x * 4, sum);
+        }
+        if (x < width)
+            convolve_pixel(src + x * 4, dst + x * 4, srcpitch, weights, size);
+    }
+}
+
+#endif /* #if defined(SCALE_AVX2_SUPPORT) */
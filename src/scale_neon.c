@@ -0,0 +1,471 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* ARM NEON smoothscale routines
+ * These are the AVX2 routines of scale_avx2.c for 128 bit registers: the
+ * integer arithmetic of the generic filters in transform.c, one 32 bit lane
+ * per colour channel, so the results are exactly the same.
+ *
+ * This file should not depend on anything but the C standard library.
+ */
+
+#include <stdint.h>
+typedef uint8_t Uint8;    /* SDL convension */
+typedef uint16_t Uint16;  /* SDL convension */
+#include <stdlib.h>
+#include <string.h>
+#include "scale.h"
+
+#if defined(SCALE_NEON_SUPPORT)
+
+#include <arm_neon.h>
+
+/* The low byte of each 32 bit lane of lo and hi. This truncates like the
+ * (Uint8) casts of the generic filters.
+ */
+static uint8x8_t
+low_bytes_8(uint32x4_t lo, uint32x4_t hi)
+{
+    return vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+}
+
+/* One pixel, four channels, as 32 bit lanes */
+static uint32x4_t
+load_pixel(const Uint8 *src)
+{
+    uint32_t pixel;
+
+    memcpy(&pixel, src, 4);
+    return vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(pixel))));
+}
+
+static void
+store_pixel(Uint8 *dst, uint8x8_t bytes)
+{
+    uint32_t pixel = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+
+    memcpy(dst, &pixel, 4);
+}
+
+/* This function implements an area-averaging shrinking filter in the X-dimension.
+ */
+void
+filter_shrink_X_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth)
+{
+    int xspace = 0x10000 * srcwidth / dstwidth; /* must be > 1 */
+    int xrecip = (int) (0x100000000LL / xspace);
+    uint32x4_t mask16 = vdupq_n_u32(0xFFFF);
+    int x, y;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *src = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+        uint32x4_t accumulate = vdupq_n_u32(0);
+        int xcounter = xspace;
+
+        for (x = 0; x < srcwidth; x++, src += 4)
+        {
+            uint32x4_t pixel = load_pixel(src);
+
+            if (xcounter > 0x10000)
+            {
+                accumulate = vaddq_u32(accumulate, pixel);
+                xcounter -= 0x10000;
+            }
+            else
+            {
+                int xfrac = 0x10000 - xcounter;
+                uint32x4_t out;
+
+                /* write out a destination pixel; the accumulator is 16 bit
+                   in the generic filter, so wrap it the same way */
+                out = vshrq_n_u32(vmulq_n_u32(pixel, xcounter), 16);
+                out = vaddq_u32(vandq_u32(accumulate, mask16), out);
+                out = vshrq_n_u32(vmulq_n_u32(out, xrecip), 16);
+                store_pixel(dst, low_bytes_8(out, out));
+                dst += 4;
+                /* reload the accumulator with the remainder of this pixel */
+                accumulate = vshrq_n_u32(vmulq_n_u32(pixel, xfrac), 16);
+                xcounter = xspace - xfrac;
+            }
+        }
+    }
+}
+
+/* This function implements an area-averaging shrinking filter in the Y-dimension.
+ */
+void
+filter_shrink_Y_NEON(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight)
+{
+    Uint16 *templine;
+    int channels = width * 4;
+    int i, y;
+    int yspace = 0x10000 * srcheight / dstheight; /* must be > 1 */
+    int yrecip = (int) (0x100000000LL / yspace);
+    int ycounter = yspace;
+
+    /* allocate and clear a memory area for storing the accumulator line */
+    templine = (Uint16 *) malloc(channels * 2);
+    if (templine == NULL) return;
+    memset(templine, 0, channels * 2);
+
+    for (y = 0; y < srcheight; y++)
+    {
+        if (ycounter > 0x10000)
+        {
+            for (i = 0; i + 8 <= channels; i += 8)
+                vst1q_u16(templine + i, vaddw_u8(vld1q_u16(templine + i),
+                                                 vld1_u8(srcpix + i)));
+            for (; i < channels; i++)
+                templine[i] += (Uint16) srcpix[i];
+            ycounter -= 0x10000;
+        }
+        else
+        {
+            int yfrac = 0x10000 - ycounter;
+
+            /* write out a destination line and reload the accumulator with
+               the remainder of this line */
+            for (i = 0; i + 8 <= channels; i += 8)
+            {
+                uint16x8_t acc = vld1q_u16(templine + i);
+                uint16x8_t src = vmovl_u8(vld1_u8(srcpix + i));
+                uint32x4_t src_lo = vmovl_u16(vget_low_u16(src));
+                uint32x4_t src_hi = vmovl_u16(vget_high_u16(src));
+                uint32x4_t lo, hi;
+
+                lo = vaddq_u32(vmovl_u16(vget_low_u16(acc)),
+                               vshrq_n_u32(vmulq_n_u32(src_lo, ycounter), 16));
+                hi = vaddq_u32(vmovl_u16(vget_high_u16(acc)),
+                               vshrq_n_u32(vmulq_n_u32(src_hi, ycounter), 16));
+                lo = vshrq_n_u32(vmulq_n_u32(lo, yrecip), 16);
+                hi = vshrq_n_u32(vmulq_n_u32(hi, yrecip), 16);
+                vst1_u8(dstpix + i, low_bytes_8(lo, hi));
+                lo = vshrq_n_u32(vmulq_n_u32(src_lo, yfrac), 16);
+                hi = vshrq_n_u32(vmulq_n_u32(src_hi, yfrac), 16);
+                vst1q_u16(templine + i,
+                          vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+            }
+            for (; i < channels; i++)
+            {
+                dstpix[i] = (Uint8) (((templine[i] + ((srcpix[i] * ycounter) >> 16)) * yrecip) >> 16);
+                templine[i] = (Uint16) ((srcpix[i] * yfrac) >> 16);
+            }
+            dstpix += dstpitch;
+            ycounter = yspace - yfrac;
+        }
+        srcpix += srcpitch;
+    } /* for (int y = 0; y < srcheight; y++) */
+
+    /* free the temporary memory */
+    free(templine);
+}
+
+/* This function implements a bilinear filter in the X-dimension.
+ */
+void
+filter_expand_X_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int srcwidth, int dstwidth)
+{
+    int *xidx0, *xmult0, *xmult1;
+    int x, y;
+
+    /* Allocate memory for factors */
+    xidx0 = (int *) malloc(dstwidth * sizeof (int));
+    xmult0 = (int *) malloc(dstwidth * sizeof (int));
+    xmult1 = (int *) malloc(dstwidth * sizeof (int));
+    if (xidx0 == NULL || xmult0 == NULL || xmult1 == NULL)
+    {
+        free(xidx0);
+        free(xmult0);
+        free(xmult1);
+        return;
+    }
+
+    /* Create multiplier factors and starting indices and put them in arrays */
+    for (x = 0; x < dstwidth; x++)
+    {
+        xidx0[x] = x * (srcwidth - 1) / dstwidth;
+        xmult1[x] = 0x10000 * ((x * (srcwidth - 1)) % dstwidth) / dstwidth;
+        xmult0[x] = 0x10000 - xmult1[x];
+    }
+
+    /* Do the scaling in raster order so we don't trash the cache */
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *srcrow0 = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        for (x = 0; x + 2 <= dstwidth; x += 2, dst += 8)
+        {
+            /* each load has both source pixels of a destination pixel */
+            uint16x8_t p0 = vmovl_u8(vld1_u8(srcrow0 + xidx0[x] * 4));
+            uint16x8_t p1 = vmovl_u8(vld1_u8(srcrow0 + xidx0[x + 1] * 4));
+            uint32x4_t lo, hi;
+
+            lo = vmulq_n_u32(vmovl_u16(vget_low_u16(p0)), xmult0[x]);
+            lo = vmlaq_n_u32(lo, vmovl_u16(vget_high_u16(p0)), xmult1[x]);
+            hi = vmulq_n_u32(vmovl_u16(vget_low_u16(p1)), xmult0[x + 1]);
+            hi = vmlaq_n_u32(hi, vmovl_u16(vget_high_u16(p1)), xmult1[x + 1]);
+            vst1_u8(dst, low_bytes_8(vshrq_n_u32(lo, 16),
+                                     vshrq_n_u32(hi, 16)));
+        }
+        if (x < dstwidth)
+        {
+            Uint8 *src = srcrow0 + xidx0[x] * 4;
+            int xm0 = xmult0[x];
+            int xm1 = xmult1[x];
+            *dst++ = (Uint8) (((src[0] * xm0) + (src[4] * xm1)) >> 16);
+            *dst++ = (Uint8) (((src[1] * xm0) + (src[5] * xm1)) >> 16);
+            *dst++ = (Uint8) (((src[2] * xm0) + (src[6] * xm1)) >> 16);
+            *dst++ = (Uint8) (((src[3] * xm0) + (src[7] * xm1)) >> 16);
+        }
+    }
+
+    /* free memory */
+    free(xidx0);
+    free(xmult0);
+    free(xmult1);
+}
+
+/* This function implements a bilinear filter in the Y-dimension.
+ */
+void
+filter_expand_Y_NEON(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight)
+{
+    int channels = width * 4;
+    int i, y;
+
+    for (y = 0; y < dstheight; y++)
+    {
+        int yidx0 = y * (srcheight - 1) / dstheight;
+        Uint8 *srcrow0 = srcpix + yidx0 * srcpitch;
+        Uint8 *srcrow1 = srcrow0 + srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+        int ymult1 = 0x10000 * ((y * (srcheight - 1)) % dstheight) / dstheight;
+        int ymult0 = 0x10000 - ymult1;
+
+        for (i = 0; i + 8 <= channels; i += 8)
+        {
+            uint16x8_t a = vmovl_u8(vld1_u8(srcrow0 + i));
+            uint16x8_t b = vmovl_u8(vld1_u8(srcrow1 + i));
+            uint32x4_t lo, hi;
+
+            lo = vmulq_n_u32(vmovl_u16(vget_low_u16(a)), ymult0);
+            lo = vmlaq_n_u32(lo, vmovl_u16(vget_low_u16(b)), ymult1);
+            hi = vmulq_n_u32(vmovl_u16(vget_high_u16(a)), ymult0);
+            hi = vmlaq_n_u32(hi, vmovl_u16(vget_high_u16(b)), ymult1);
+            vst1_u8(dst + i, low_bytes_8(vshrq_n_u32(lo, 16),
+                                         vshrq_n_u32(hi, 16)));
+        }
+        for (; i < channels; i++)
+            dst[i] = (Uint8) (((srcrow0[i] * ymult0) + (srcrow1[i] * ymult1)) >> 16);
+    }
+}
+
+/* One pixel of the X blur filter, with the edge pixels repeated; these are
+ * the pixels within radius of the ends of a row.
+ */
+static void
+blur_pixel_X(Uint8 *src, Uint8 *dst, int x, int width, const int *weights, int radius)
+{
+    int sum[4] = {0x8000, 0x8000, 0x8000, 0x8000};
+    int k;
+
+    for (k = -radius; k <= radius; k++)
+    {
+        int sx = x + k;
+        Uint8 *p;
+        int w = weights[k + radius];
+
+        if (sx < 0) sx = 0;
+        else if (sx >= width) sx = width - 1;
+        p = src + sx * 4;
+        sum[0] += p[0] * w;
+        sum[1] += p[1] * w;
+        sum[2] += p[2] * w;
+        sum[3] += p[3] * w;
+    }
+    dst[0] = (Uint8) (sum[0] >> 16);
+    dst[1] = (Uint8) (sum[1] >> 16);
+    dst[2] = (Uint8) (sum[2] >> 16);
+    dst[3] = (Uint8) (sum[3] >> 16);
+}
+
+/* This function implements a weighted blur filter in the X-dimension.
+ */
+void
+filter_blur_X_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius)
+{
+    int x, y, k;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *src = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        for (x = 0; x < radius && x < width; x++)
+            blur_pixel_X(src, dst + x * 4, x, width, weights, radius);
+        /* two destination pixels per step: each load has the source pixel
+           of a weight for both of them */
+        for (; x + radius + 2 <= width; x += 2)
+        {
+            Uint8 *p = src + (x - radius) * 4;
+            uint32x4_t lo = vdupq_n_u32(0x8000);
+            uint32x4_t hi = lo;
+
+            for (k = 0; k <= 2 * radius; k++, p += 4)
+            {
+                uint16x8_t pixels = vmovl_u8(vld1_u8(p));
+
+                lo = vmlaq_n_u32(lo, vmovl_u16(vget_low_u16(pixels)), weights[k]);
+                hi = vmlaq_n_u32(hi, vmovl_u16(vget_high_u16(pixels)), weights[k]);
+            }
+            vst1_u8(dst + x * 4, low_bytes_8(vshrq_n_u32(lo, 16),
+                                             vshrq_n_u32(hi, 16)));
+        }
+        for (; x < width; x++)
+            blur_pixel_X(src, dst + x * 4, x, width, weights, radius);
+    }
+}
+
+/* This function implements a weighted blur filter in the Y-dimension.
+ */
+void
+filter_blur_Y_NEON(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int height, const int *weights, int radius)
+{
+    Uint8 **rows;
+    int channels = width * 4;
+    int i, k, y;
+
+    /* the source rows of each weight, with the edge rows repeated */
+    rows = (Uint8 **) malloc((2 * radius + 1) * sizeof (Uint8 *));
+    if (rows == NULL) return;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        for (k = 0; k <= 2 * radius; k++)
+        {
+            int sy = y + k - radius;
+
+            if (sy < 0) sy = 0;
+            else if (sy >= height) sy = height - 1;
+            rows[k] = srcpix + sy * srcpitch;
+        }
+        for (i = 0; i + 8 <= channels; i += 8)
+        {
+            uint32x4_t lo = vdupq_n_u32(0x8000);
+            uint32x4_t hi = lo;
+
+            for (k = 0; k <= 2 * radius; k++)
+            {
+                uint16x8_t src = vmovl_u8(vld1_u8(rows[k] + i));
+
+                lo = vmlaq_n_u32(lo, vmovl_u16(vget_low_u16(src)), weights[k]);
+                hi = vmlaq_n_u32(hi, vmovl_u16(vget_high_u16(src)), weights[k]);
+            }
+            vst1_u8(dst + i, low_bytes_8(vshrq_n_u32(lo, 16),
+                                         vshrq_n_u32(hi, 16)));
+        }
+        for (; i < channels; i++)
+        {
+            int sum = 0x8000;
+
+            for (k = 0; k <= 2 * radius; k++)
+                sum += rows[k][i] * weights[k];
+            dst[i] = (Uint8) (sum >> 16);
+        }
+    }
+
+    free(rows);
+}
+
+/* One pixel of the convolve filter */
+static void
+convolve_pixel(Uint8 *src, Uint8 *dst, int srcpitch, const int *weights, int size)
+{
+    int sum[4] = {0x8000, 0x8000, 0x8000, 0x8000};
+    int i, kx, ky;
+
+    for (ky = 0; ky < size; ky++, src += srcpitch)
+    {
+        for (kx = 0; kx < size; kx++)
+        {
+            Uint8 *p = src + kx * 4;
+            int w = *weights++;
+
+            sum[0] += p[0] * w;
+            sum[1] += p[1] * w;
+            sum[2] += p[2] * w;
+            sum[3] += p[3] * w;
+        }
+    }
+    for (i = 0; i < 4; i++)
+        dst[i] = (Uint8) (sum[i] < 0 ? 0 : sum[i] >= 0x1000000 ? 255 : sum[i] >> 16);
+}
+
+/* This function implements a convolution with a square kernel.
+ */
+void
+filter_convolve_NEON(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius)
+{
+    int size = 2 * radius + 1;
+    int32x4_t low = vdupq_n_s32(0);
+    int32x4_t high = vdupq_n_s32(255);
+    int x, y, kx, ky;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *src = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+
+        /* two destination pixels per step, as in filter_blur_X_NEON */
+        for (x = 0; x + 2 <= width; x += 2)
+        {
+            const int *w = weights;
+            int32x4_t lo = vdupq_n_s32(0x8000);
+            int32x4_t hi = lo;
+
+            for (ky = 0; ky < size; ky++)
+            {
+                Uint8 *p = src + ky * srcpitch + x * 4;
+
+                for (kx = 0; kx < size; kx++, p += 4, w++)
+                {
+                    uint16x8_t pixels = vmovl_u8(vld1_u8(p));
+
+                    lo = vmlaq_n_s32(lo, vreinterpretq_s32_u32(
+                        vmovl_u16(vget_low_u16(pixels))), *w);
+                    hi = vmlaq_n_s32(hi, vreinterpretq_s32_u32(
+                        vmovl_u16(vget_high_u16(pixels))), *w);
+                }
+            }
+            lo = vminq_s32(vmaxq_s32(vshrq_n_s32(lo, 16), low), high);
+            hi = vminq_s32(vmaxq_s32(vshrq_n_s32(hi, 16), low), high);
+            vst1_u8(dst + x * 4, low_bytes_8(vreinterpretq_u32_s32(lo),
+                                             vreinterpretq_u32_s32(hi)));
+        }
+        if (x < width)
+            convolve_pixel(src + x * 4, dst + x * 4, srcpitch, weights, size);
+    }
+}
+
+#endif /* #if defined(SCALE_NEON_SUPPORT) */
@@ -51,6 +51,7 @@ static PyObject* _scrap_get_scrap (PyObject* self, PyObject* args);
 static PyObject* _scrap_put_scrap (PyObject* self, PyObject* args);
 static PyObject* _scrap_lost_scrap (PyObject* self, PyObject* args);
 static PyObject* _scrap_set_mode (PyObject* self, PyObject* args);
+static PyObject* _scrap_request (PyObject* self, PyObject* args);
 
 /* Determine what type of clipboard we are using */
 #if defined(__unix__) && defined(SDL_VIDEO_DRIVER_X11)
@@ -220,6 +221,10 @@ _scrap_get_scrap (PyObject* self, PyObject* args)
         Py_RETURN_NONE;
 
     retval = Bytes_FromStringAndSize (scrap, count);
+#if defined(X11_SCRAP)
+    /* X11 always gives a new buffer. */
+    free (scrap);
+#endif
     return retval;
 }
 #endif
@@ -317,6 +322,44 @@ _scrap_set_mode (PyObject* self, PyObject* args)
 
 #endif /* !defined(MAC_SCRAP) */
 
+#if !defined(MAC_SCRAP)
+/*
+ * Requests the content for a certain type from the active clipboard and
+ * posts an event once it can be taken with get.
+ */
+static PyObject*
+_scrap_request (PyObject* self, PyObject* args)
+{
+    char *scrap_type;
+    int event;
+    SDL_Event e;
+
+    PYGAME_SCRAP_INIT_CHECK ();
+
+    if (!PyArg_ParseTuple (args, "si", &scrap_type, &event))
+        return NULL;
+    if (event <= SDL_NOEVENT || event >= SDL_NUMEVENTS)
+        return RAISE (PyExc_ValueError, "invalid event type");
+
+#if defined(X11_SCRAP)
+    if (pygame_scrap_lost ())
+    {
+        if (!pygame_scrap_request (scrap_type, event))
+            return NULL;
+        Py_RETURN_NONE;
+    }
+#endif
+
+    /* The content is already at hand. */
+    memset (&e, 0, sizeof (e));
+    e.type = event;
+    if (e.type >= SDL_USEREVENT && e.type < SDL_NUMEVENTS)
+        e.user.code = pygame_scrap_contains (scrap_type);
+    SDL_PushEvent (&e);
+    Py_RETURN_NONE;
+}
+#endif /* !defined(MAC_SCRAP) */
+
 static PyMethodDef scrap_builtins[] =
 {
     /*
@@ -334,6 +377,7 @@ static PyMethodDef scrap_builtins[] =
     { "put", _scrap_put_scrap, METH_VARARGS, DOC_PYGAMESCRAPPUT },
     { "lost", _scrap_lost_scrap, METH_NOARGS, DOC_PYGAMESCRAPLOST },
     { "set_mode", _scrap_set_mode, METH_VARARGS, DOC_PYGAMESCRAPSETMODE },
+    { "request", _scrap_request, METH_VARARGS, DOC_PYGAMESCRAPREQUEST },
 
 #endif
     { NULL, NULL, 0, NULL}
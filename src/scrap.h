@@ -123,6 +123,25 @@ pygame_scrap_put (char *type, int srclen, char *src);
 extern char*
 pygame_scrap_get (char *type, unsigned long *count);
 
+/**
+ * \brief Requests the content of the clipboard without waiting for it.
+ *
+ * The content is received while events are pumped, in chunks if it is
+ * large. Once it is there, or the request failed, an event of the passed
+ * type is posted, with a code of 1 or 0 for user events, and
+ * pygame_scrap_get() returns the content. Only one request can be
+ * pending at a time.
+ *
+ * \note Only X11 has to wait for the clipboard; the other systems can use
+ *       pygame_scrap_get() directly.
+ *
+ * \param type The type of the content to receive.
+ * \param event The type of the event to post.
+ * \return 1, if the request was made, 0 in case of an error.
+ */
+extern int
+pygame_scrap_request (char *type, int event);
+
 /**
  * \brief Gets the currently available content types from the clipboard.
  *
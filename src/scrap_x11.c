@@ -37,6 +37,7 @@ static Atom _atom_TIMESTAMP;
 static Atom _atom_SDL;
 static Atom _atom_BMP;
 static Atom _atom_CLIPBOARD;
+static Atom _atom_INCR;
 
 /* Timestamps for the requests. */
 static Time _cliptime = CurrentTime;
@@ -51,6 +52,54 @@ static Time _selectiontime = CurrentTime;
 
 #define GET_CLIPATOM(x) ((x == SCRAP_SELECTION) ? XA_PRIMARY : _atom_CLIPBOARD)
 
+/* The Atoms _convert_format () found for the type names so far. */
+typedef struct
+{
+    char *type;
+    Atom atom;
+} ScrapFormat;
+
+static ScrapFormat *_formats = NULL;
+static int _formatcount = 0;
+
+/* A selection we serve to another window in chunks, using the INCR
+ * protocol, as it is too large for a single property.
+ */
+typedef struct _ScrapOutgoing
+{
+    Window window;
+    Atom property;
+    Atom target;
+    char *data;
+    unsigned long size;
+    unsigned long offset;
+    time_t last;
+    struct _ScrapOutgoing *next;
+} ScrapOutgoing;
+
+static ScrapOutgoing *_outgoing = NULL;
+
+/* The selection requested by pygame_scrap_request (), received into
+ * the SDL_SELECTION property of our window while events are pumped.
+ */
+typedef enum
+{
+    SCRAP_REQUEST_IDLE,
+    SCRAP_REQUEST_WAITING, /* for the SelectionNotify */
+    SCRAP_REQUEST_INCR,    /* for the next chunk */
+    SCRAP_REQUEST_DONE
+} ScrapRequestState;
+
+static struct
+{
+    ScrapRequestState state;
+    Atom format;
+    int event;
+    time_t last;
+    unsigned char *data;
+    unsigned long length;
+} _incoming = { SCRAP_REQUEST_IDLE, None, 0, 0, NULL, 0 };
+
 static Atom _convert_format (char *type);
 static void _init_atom_types (void);
 static char* _atom_to_string (Atom a);
@@ -60,24 +109,72 @@ static void _set_targets (PyObject *data, Display *display, Window window,
                           Atom property);
 static int _set_data (PyObject *dict, Display *display, Window window,
                       Atom property, Atom target);
+static int _send_incr_chunk (ScrapOutgoing *out);
+static void _handle_incr_delete (XPropertyEvent *prop);
 static Window _get_scrap_owner (Atom *selection);
+static long _read_property (Window window, Atom property, Atom *type,
+                            int *format, unsigned char **buf,
+                            unsigned long *length);
+static char* _get_incr_data (Window window, Atom *type, int *format,
+                             unsigned long *length);
+static void _finish_request (int success);
+static void _handle_request_notify (XEvent *xevent);
 static char* _get_data_as (Atom source, Atom format, unsigned long *length);
 
 /**
  * \brief Converts the passed type into a system specific type to use
  *        for the clipboard.
  *
+ * The Atoms are kept, so each type name is only sent to the X server
+ * once.
+ *
  * \param type The type to convert.
  * \return A system specific type.
  */
 static Atom
 _convert_format (char *type)
 {
+    int i;
+    Atom atom;
+    ScrapFormat *formats;
+
     if (strcmp (type, PYGAME_SCRAP_PPM) == 0)
         return XA_PIXMAP;
     if (strcmp (type, PYGAME_SCRAP_PBM) == 0)
         return XA_BITMAP;
-    return XInternAtom (SDL_Display, type, False);
+
+    for (i = 0; i < _formatcount; i++)
+    {
+        if (strcmp (type, _formats[i].type) == 0)
+            return _formats[i].atom;
+    }
+
+    atom = XInternAtom (SDL_Display, type, False);
+    formats = realloc (_formats, sizeof (ScrapFormat) * (_formatcount + 1));
+    if (formats)
+    {
+        _formats = formats;
+        _formats[_formatcount].type = strdup (type);
+        _formats[_formatcount].atom = atom;
+        if (_formats[_formatcount].type)
+            _formatcount++;
+    }
+    return atom;
+}
+
+/**
+ * \brief Forgets the Atoms found by _convert_format ().
+ */
+static void
+_clear_formats (void)
+{
+    int i;
+
+    for (i = 0; i < _formatcount; i++)
+        free (_formats[i].type);
+    free (_formats);
+    _formats = NULL;
+    _formatcount = 0;
 }
 
 /**
@@ -97,6 +194,7 @@ _init_atom_types (void)
     _atom_SDL = XInternAtom (SDL_Display, "SDL_SELECTION", False);
     _atom_BMP = XInternAtom (SDL_Display, PYGAME_SCRAP_BMP, False);
     _atom_CLIPBOARD = XInternAtom (SDL_Display, "CLIPBOARD", False);
+    _atom_INCR = XInternAtom (SDL_Display, "INCR", False);
 }
 
 /**
@@ -168,7 +266,18 @@ _clipboard_filter (const SDL_Event *event)
     {
     case PropertyNotify:
     {
-        /* Handled in pygame_scrap_put(). */
+        /* Our own timestamps are handled in pygame_scrap_put(). Here the
+         * chunks of INCR transfers move: a requestor deleting the
+         * property asks for the next chunk we serve, and a new value of
+         * our SDL_SELECTION property is the next chunk of a request.
+         */
+        XPropertyEvent *prop = &xevent.xproperty;
+
+        if (prop->state == PropertyDelete)
+            _handle_incr_delete (prop);
+        else if (_incoming.state == SCRAP_REQUEST_INCR
+                 && prop->window == SDL_Window && prop->atom == _atom_SDL)
+            _handle_request_notify (&xevent);
         break;
     }
     case SelectionClear:
@@ -198,8 +307,12 @@ _clipboard_filter (const SDL_Event *event)
     }
     case SelectionNotify:
         /* This one will be handled directly in the pygame_scrap_get ()
-         * function.
+         * function, unless it answers pygame_scrap_request ().
          */
+        if (_incoming.state == SCRAP_REQUEST_WAITING
+            && xevent.xselection.requestor == SDL_Window
+            && xevent.xselection.target == _incoming.format)
+            _handle_request_notify (&xevent);
         break;
 
     case SelectionRequest:
@@ -341,22 +454,117 @@ _set_data (PyObject *data, Display *display, Window window, Atom property,
     PyObject *val = PyDict_GetItemString (data, name);
     char *value = NULL;
     int size;
+    ScrapOutgoing *out;
+    long incrsize;
 
     if (!val)
     {
-        XFree (name);
+        free (name);
         return 0;
     }
     size = Bytes_Size (val);
     value = Bytes_AsString (val);
+    free (name);
 
-    /* Send data. */
-    XChangeProperty (display, window, property, target, 8, PropModeReplace,
-                     (unsigned char *) value, size);
-    XFree (name);
+    if ((unsigned long) size <= MAX_CHUNK_SIZE (display))
+    {
+        /* Send data. */
+        XChangeProperty (display, window, property, target, 8,
+                         PropModeReplace, (unsigned char *) value, size);
+        return 1;
+    }
+
+    /* Too large for one property. Announce an INCR transfer and send the
+     * chunks as the requestor deletes the property, see
+     * _handle_incr_delete (). The data is copied, so it stays even if the
+     * clipboard changes meanwhile.
+     */
+    out = malloc (sizeof (ScrapOutgoing));
+    if (!out)
+        return 0;
+    out->data = malloc ((size_t) size);
+    if (!out->data)
+    {
+        free (out);
+        return 0;
+    }
+    memcpy (out->data, value, (size_t) size);
+    out->window = window;
+    out->property = property;
+    out->target = target;
+    out->size = (unsigned long) size;
+    out->offset = 0;
+    out->last = time (0);
+    out->next = _outgoing;
+    _outgoing = out;
+
+    XSelectInput (display, window, PropertyChangeMask);
+    incrsize = size;
+    XChangeProperty (display, window, property, _atom_INCR, 32,
+                     PropModeReplace, (unsigned char *) &incrsize, 1);
     return 1;
 }
 
+/**
+ * Sends the next chunk of an INCR transfer. The last chunk is followed
+ * by an empty one, which ends the transfer.
+ *
+ * \param out The transfer to continue.
+ * \return 1 if the transfer goes on, 0 if it ended.
+ */
+static int
+_send_incr_chunk (ScrapOutgoing *out)
+{
+    unsigned long chunk = MAX_CHUNK_SIZE (SDL_Display);
+
+    if (chunk > out->size - out->offset)
+        chunk = out->size - out->offset;
+    XChangeProperty (SDL_Display, out->window, out->property, out->target, 8,
+                     PropModeReplace,
+                     (unsigned char *) out->data + out->offset, (int) chunk);
+    out->offset += chunk;
+    out->last = time (0);
+    return chunk != 0;
+}
+
+/**
+ * Continues the INCR transfer the deleted property belongs to, if any,
+ * and drops the transfers whose requestors stopped reading.
+ *
+ * \param prop The PropertyNotify event of the deleted property.
+ */
+static void
+_handle_incr_delete (XPropertyEvent *prop)
+{
+    ScrapOutgoing **link = &_outgoing;
+    ScrapOutgoing *out;
+    time_t now = time (0);
+
+    while (*link)
+    {
+        out = *link;
+        if (out->window == prop->window && out->property == prop->atom)
+        {
+            if (_send_incr_chunk (out))
+            {
+                link = &out->next;
+                continue;
+            }
+        }
+        else if (now - out->last < 5)
+        {
+            link = &out->next;
+            continue;
+        }
+
+        /* Finished or timed out. */
+        *link = out->next;
+        XSelectInput (SDL_Display, out->window, NoEventMask);
+        free (out->data);
+        free (out);
+    }
+}
+
 /**
  * \brief Tries to determine the X window with a valid selection.
  *        Default is to check
@@ -404,6 +612,215 @@ _get_scrap_owner (Atom *selection)
     return None;
 }
 
+/**
+ * Reads a whole property of a window and appends its content to a
+ * buffer, deleting the property.
+ *
+ * \param window The window to read the property of.
+ * \param property The property to read.
+ * \param type Out parameter for the type of the property.
+ * \param format Out parameter for the format of the property.
+ * \param buf The buffer to append to, reallocated as needed. It is kept
+ *            NULL terminated.
+ * \param length The length of the buffer, increased by the bytes read.
+ * \return The amount of bytes read or -1, if there is no such property
+ *         or no memory.
+ */
+static long
+_read_property (Window window, Atom property, Atom *type, int *format,
+                unsigned char **buf, unsigned long *length)
+{
+    unsigned long offset = 0;
+    unsigned long nitems;
+    unsigned long overflow;
+    unsigned long nbytes;
+    unsigned char *src;
+    unsigned char *tmp;
+    long total = 0;
+
+    do
+    {
+        if (XGetWindowProperty (SDL_Display, window, property, offset,
+                                MAX_CHUNK_SIZE (SDL_Display), True,
+                                AnyPropertyType, type, format, &nitems,
+                                &overflow, &src) != Success)
+            return -1;
+        if (*type == None)
+            return -1;
+
+        /* 32 bit items are returned as longs. */
+        nbytes = nitems * ((*format == 32) ? sizeof (long) : *format / 8);
+        tmp = realloc (*buf, *length + nbytes + 1);
+        if (!tmp)
+        {
+            XFree (src);
+            return -1;
+        }
+        *buf = tmp;
+        memcpy (*buf + *length, src, nbytes);
+        *length += nbytes;
+        (*buf)[*length] = 0;
+        total += nbytes;
+        offset += nitems * (*format) / 32;
+        XFree (src);
+    }
+    while (overflow);
+
+    return total;
+}
+
+/**
+ * Checks for a new value of the SDL_SELECTION property of our window.
+ */
+static Bool
+_is_selection_chunk (Display *display, XEvent *event, XPointer arg)
+{
+    return event->type == PropertyNotify
+        && event->xproperty.window == SDL_Window
+        && event->xproperty.atom == _atom_SDL
+        && event->xproperty.state == PropertyNewValue;
+}
+
+/**
+ * Receives an INCR transfer into the SDL_SELECTION property, waiting for
+ * each chunk.
+ *
+ * \param window The window with the SDL_SELECTION property.
+ * \param type Out parameter for the type of the data.
+ * \param format Out parameter for the format of the data.
+ * \param length Out parameter that contains the length of the returned
+ * buffer.
+ * \return The data or NULL in case the transfer failed.
+ */
+static char*
+_get_incr_data (Window window, Atom *type, int *format,
+                unsigned long *length)
+{
+    unsigned char *retval = NULL;
+    time_t start;
+    XEvent ev;
+    long nbytes;
+
+    *length = 0;
+
+    /* Deleting the INCR property starts the transfer. */
+    XDeleteProperty (SDL_Display, window, _atom_SDL);
+    XFlush (SDL_Display);
+
+    for (start = time (0);;)
+    {
+        if (!XCheckIfEvent (SDL_Display, &ev, _is_selection_chunk, NULL))
+        {
+            if (time (0) - start >= 5)
+            {
+                /* Timeout, damn. */
+                free (retval);
+                return NULL;
+            }
+            continue;
+        }
+
+        nbytes = _read_property (window, _atom_SDL, type, format, &retval,
+                                 length);
+        XFlush (SDL_Display);
+        if (nbytes < 0)
+        {
+            free (retval);
+            return NULL;
+        }
+        if (nbytes == 0)
+            break;
+        start = time (0);
+    }
+    return (char *) retval;
+}
+
+/**
+ * Ends the transfer of pygame_scrap_request () and posts its event.
+ *
+ * \param success 1, if the data was received, 0 otherwise.
+ */
+static void
+_finish_request (int success)
+{
+    SDL_Event e;
+
+    if (success)
+        _incoming.state = SCRAP_REQUEST_DONE;
+    else
+    {
+        _incoming.state = SCRAP_REQUEST_IDLE;
+        free (_incoming.data);
+        _incoming.data = NULL;
+        _incoming.length = 0;
+    }
+
+    memset (&e, 0, sizeof (e));
+    e.type = _incoming.event;
+    if (e.type >= SDL_USEREVENT && e.type < SDL_NUMEVENTS)
+        e.user.code = success;
+    SDL_PushEvent (&e);
+}
+
+/**
+ * Moves the transfer of pygame_scrap_request () on, once the owner
+ * answered it or sent the next INCR chunk.
+ *
+ * \param xevent The SelectionNotify or PropertyNotify event.
+ */
+static void
+_handle_request_notify (XEvent *xevent)
+{
+    Atom type;
+    int format;
+    unsigned long nitems;
+    unsigned long overflow;
+    unsigned char *src;
+    long nbytes;
+
+    _incoming.last = time (0);
+
+    if (xevent->type == SelectionNotify)
+    {
+        if (xevent->xselection.property == None)
+        {
+            /* The owner could not convert it. */
+            _finish_request (0);
+            return;
+        }
+
+        if (XGetWindowProperty (SDL_Display, SDL_Window, _atom_SDL, 0, 0,
+                                False, AnyPropertyType, &type, &format,
+                                &nitems, &overflow, &src) != Success)
+        {
+            _finish_request (0);
+            return;
+        }
+        XFree (src);
+
+        if (type == _atom_INCR)
+        {
+            /* Deleting the INCR property starts the transfer. */
+            _incoming.state = SCRAP_REQUEST_INCR;
+            XDeleteProperty (SDL_Display, SDL_Window, _atom_SDL);
+            XFlush (SDL_Display);
+            return;
+        }
+
+        nbytes = _read_property (SDL_Window, _atom_SDL, &type, &format,
+                                 &_incoming.data, &_incoming.length);
+        _finish_request (nbytes >= 0);
+        return;
+    }
+
+    /* The next INCR chunk; an empty one ends the transfer. */
+    nbytes = _read_property (SDL_Window, _atom_SDL, &type, &format,
+                             &_incoming.data, &_incoming.length);
+    XFlush (SDL_Display);
+    if (nbytes <= 0)
+        _finish_request (nbytes == 0);
+}
+
 /**
  * Retrieves the data from a certain source Atom using a specific
  * format.
@@ -503,6 +920,21 @@ _get_data_as (Atom source, Atom format, unsigned long *length)
         return NULL;
     }
 
+    /* Large data comes in chunks. */
+    if (sel_type == _atom_INCR)
+    {
+        XFree (src);
+        retval = (unsigned char *) _get_incr_data
+            (ev.xselection.requestor, &sel_type, &sel_format, length);
+        if (!retval)
+        {
+            Unlock_Display ();
+            return NULL;
+        }
+        nbytes = *length;
+        overflow = 0;
+    }
+
     /* In case we requested a SCRAP_TEXT, any property type of
      * XA_STRING, XA_COMPOUND_TEXT, UTF8_STRING and TEXT is valid.
      */
@@ -511,11 +943,18 @@ _get_data_as (Atom source, Atom format, unsigned long *length)
          && sel_type != _atom_COMPOUND && sel_type != XA_STRING))
     {
         /* No matching text type found. Return nothing then. */
-        XFree (src);
+        if (retval)
+            free (retval);
+        else
+            XFree (src);
         Unlock_Display ();
         return NULL;
     }
 
+    /* The chunks of INCR transfers are already read. */
+    if (retval)
+        goto CONVERTTEXT;
+
     /* Anything is fine, so copy the buffer and return it. */
     switch (sel_format)
     {
@@ -565,6 +1004,7 @@ _get_data_as (Atom source, Atom format, unsigned long *length)
         return NULL;
     }
 
+CONVERTTEXT:
     /* In case we've got a COMPOUND_TEXT, convert it to the current
      * multibyte locale.
      */
@@ -672,6 +1112,7 @@ pygame_scrap_init (void)
             SDL_SetEventFilter (_clipboard_filter);
 
             /* Create the atom types we need. */
+            _clear_formats ();
             _init_atom_types ();
 
             retval = 1;
@@ -793,13 +1234,92 @@ SETSELECTIONOWNER:
 char*
 pygame_scrap_get (char *type, unsigned long *count)
 {
+    Atom format;
+    char *retval;
+
     if (!pygame_scrap_initialized ())
     {
         PyErr_SetString (PyExc_SDLError, "scrap system not initialized.");
         return NULL;
     }
-    return _get_data_as (GET_CLIPATOM (_currentmode),
-                         _convert_format (type), count);
+    format = _convert_format (type);
+
+    switch (_incoming.state)
+    {
+    case SCRAP_REQUEST_DONE:
+        /* Hand out what pygame_scrap_request () received. */
+        if (_incoming.format != format)
+            break;
+        retval = (char *) _incoming.data;
+        *count = _incoming.length;
+        _incoming.data = NULL;
+        _incoming.length = 0;
+        _incoming.state = SCRAP_REQUEST_IDLE;
+        return retval;
+    case SCRAP_REQUEST_WAITING:
+    case SCRAP_REQUEST_INCR:
+        /* The request uses the SDL_SELECTION property. */
+        if (time (0) - _incoming.last < 5)
+            return NULL;
+        _finish_request (0);
+        break;
+    default:
+        break;
+    }
+
+    return _get_data_as (GET_CLIPATOM (_currentmode), format, count);
+}
+
+int
+pygame_scrap_request (char *type, int event)
+{
+    Atom source = GET_CLIPATOM (_currentmode);
+    Window owner;
+
+    if (!pygame_scrap_initialized ())
+    {
+        PyErr_SetString (PyExc_SDLError, "scrap system not initialized.");
+        return 0;
+    }
+
+    if (_incoming.state == SCRAP_REQUEST_WAITING
+        || _incoming.state == SCRAP_REQUEST_INCR)
+    {
+        if (time (0) - _incoming.last < 5)
+        {
+            PyErr_SetString (PyExc_SDLError,
+                             "a clipboard request is already pending.");
+            return 0;
+        }
+        /* The owner stopped answering. */
+        _finish_request (0);
+    }
+
+    /* Drop a result nobody fetched. */
+    free (_incoming.data);
+    _incoming.data = NULL;
+    _incoming.length = 0;
+    _incoming.format = _convert_format (type);
+    _incoming.event = event;
+    _incoming.last = time (0);
+
+    Lock_Display ();
+    owner = _get_scrap_owner (&source);
+    if (owner == None)
+    {
+        Unlock_Display ();
+        _finish_request (0);
+        return 1;
+    }
+
+    /* The answer is handled by _clipboard_filter (). */
+    _incoming.state = SCRAP_REQUEST_WAITING;
+    XConvertSelection (SDL_Display, source, _incoming.format, _atom_SDL,
+                       SDL_Window,
+                       (source == XA_PRIMARY) ? _selectiontime : _cliptime);
+    XFlush (SDL_Display);
+    Unlock_Display ();
+    return 1;
 }
 
 int
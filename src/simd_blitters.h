@@ -0,0 +1,173 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* SSE2/AVX2 blitters for the 32 bit paths of alphablit.c and surface_fill.c.
+ * Available on x86 and x86-64 with GCC, clang or Visual C.  The functions
+ * are selected at runtime, so the rest of the module is still built for the
+ * baseline instruction set.
+ */
+
+#if !defined(SIMD_BLITTERS_HEADER)
+#define SIMD_BLITTERS_HEADER
+
+#include "_surface.h"
+
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || \
+    defined(_M_X64) || defined(_M_IX86)
+#define PG_ENABLE_SSE2_BLITTERS
+
+/* GCC and clang need the instruction set enabled per function, since the
+ * module itself is not compiled with -msse2 or -mavx2.
+ */
+#if defined(__GNUC__)
+#define PG_TARGET_SSE2 __attribute__((target("sse2")))
+#define PG_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PG_TARGET_SSE2
+#define PG_TARGET_AVX2
+#endif
+
+#if (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || \
+    defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1800)
+#define PG_ENABLE_AVX2_BLITTERS
+#endif
+
+#endif /* #if (defined(__GNUC__) && .....) */
+
+/* Returns true if the 32 bit formats of a blit have the same 8 bit RGB
+ * channel layout, a source alpha channel and, if the destination has one,
+ * the same alpha channel.  These are the only formats the SIMD blitters
+ * handle; the pixel steps must also be forward (no reversed self blit).
+ */
+#define PG_SIMD_BLIT_OK(info)                                             \
+    ((info)->src->BytesPerPixel == 4 && (info)->dst->BytesPerPixel == 4 && \
+     (info)->s_pxskip == 4 && (info)->d_pxskip == 4 &&                    \
+     (info)->src->Rmask == (info)->dst->Rmask &&                          \
+     (info)->src->Gmask == (info)->dst->Gmask &&                          \
+     (info)->src->Bmask == (info)->dst->Bmask &&                          \
+     (info)->src->Rmask == (Uint32) 0xFF << (info)->src->Rshift &&        \
+     (info)->src->Gmask == (Uint32) 0xFF << (info)->src->Gshift &&        \
+     (info)->src->Bmask == (Uint32) 0xFF << (info)->src->Bshift &&        \
+     (info)->src->Amask == (Uint32) 0xFF << (info)->src->Ashift &&        \
+     ((info)->dst->Amask == 0 || (info)->dst->Amask == (info)->src->Amask))
+
+/* How a 32 bit blend blitter combines a source pixel s with a destination
+ * pixel d. The blend itself, op, works on all four bytes:
+ *
+ *     d = (op (d, s | sor) & rmask) | (d & dmask) | dor
+ *
+ * This covers both the RGB and the RGBA blends of alphablit.c and
+ * surface_fill.c for every combination of per-pixel alpha flags. A source
+ * pixel step of 0 makes the blitter a fill with the colour at s_pixels.
+ */
+typedef struct
+{
+    Uint32 sor;
+    Uint32 rmask;
+    Uint32 dmask;
+    Uint32 dor;
+} PgBlendMasks;
+
+typedef void (* BLIT_FUNC_P)(SDL_BlitInfo *);
+typedef void (* BLEND_FUNC_P)(SDL_BlitInfo *, PgBlendMasks *);
+
+/* Finds the first or the last of n 32 bit pixels with
+ * (pixel & amask) >= threshold, for an 8 bit alpha channel amask and a
+ * minimum alpha shifted to it. Returns its index, or -1 if there is none.
+ */
+typedef int (* ALPHA_SCAN_P)(const Uint32 *, int, Uint32, Uint32);
+
+/* How a pixel conversion makes a 32 bit pixel d from a 24 or 32 bit pixel
+ * s with 8 bit channels, moving each channel by a whole number of bytes:
+ *
+ *     d = fill | (s << shift[i]) & mask[i] for each i < count
+ *
+ * where a negative shift is to the right. Channels moved by the same
+ * shift share a mask.
+ */
+typedef struct
+{
+    int count;
+    int shift[4];
+    Uint32 mask[4];
+    Uint32 fill;
+} PgSwizzle;
+
+/* Converts n pixels of 3 or 4 bytes, srcbpp, at src to 32 bit pixels */
+typedef void (* CONVERT_FUNC_P)(const Uint8 *, Uint32 *, int, int,
+                                const PgSwizzle *);
+
+/* The blitters that have SIMD versions, set by pygame_BlitInit () in
+ * alphablit.c. A NULL entry means the generic C code is used. The blend
+ * blitters are indexed by PYGAME_BLEND_ADD .. PYGAME_BLEND_MAX. The alpha
+ * scans are for pygame_AlphaBounds, the conversion for
+ * pygame_ConvertSurface.
+ */
+typedef struct
+{
+    const char *blit_type;
+    BLIT_FUNC_P alpha_argb;
+    BLIT_FUNC_P premultiplied_argb;
+    BLIT_FUNC_P fill_32;
+    BLEND_FUNC_P blend[PYGAME_BLEND_MAX + 1];
+    ALPHA_SCAN_P alpha_first_32;
+    ALPHA_SCAN_P alpha_last_32;
+    CONVERT_FUNC_P convert_32;
+} PgBlitters;
+
+extern PgBlitters pg_blitters;
+
+/* Fills of more bytes than this, a typical L2 cache, use non-temporal
+ * stores, so clearing a large surface does not evict everything else.
+ */
+#define PG_FILL_STREAM_BYTES (1 << 21)
+
+#if defined(PG_ENABLE_SSE2_BLITTERS)
+void alphablit_alpha_sse2_argb (SDL_BlitInfo *info);
+void blit_blend_premultiplied_sse2_argb (SDL_BlitInfo *info);
+void blit_fill_sse2 (SDL_BlitInfo *info);
+void blit_blend_add_sse2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_sub_sse2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_mul_sse2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_min_sse2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_max_sse2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+int alpha_first_sse2 (const Uint32 *pixels, int n, Uint32 amask,
+                      Uint32 threshold);
+int alpha_last_sse2 (const Uint32 *pixels, int n, Uint32 amask,
+                     Uint32 threshold);
+void convert_32_sse2 (const Uint8 *src, Uint32 *dst, int n, int srcbpp,
+                      const PgSwizzle *swizzle);
+#endif /* #if defined(PG_ENABLE_SSE2_BLITTERS) */
+
+#if defined(PG_ENABLE_AVX2_BLITTERS)
+void alphablit_alpha_avx2_argb (SDL_BlitInfo *info);
+void blit_blend_premultiplied_avx2_argb (SDL_BlitInfo *info);
+void blit_fill_avx2 (SDL_BlitInfo *info);
+void blit_blend_add_avx2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_sub_avx2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_mul_avx2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_min_avx2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+void blit_blend_max_avx2 (SDL_BlitInfo *info, PgBlendMasks *masks);
+int alpha_first_avx2 (const Uint32 *pixels, int n, Uint32 amask,
+                      Uint32 threshold);
+int alpha_last_avx2 (const Uint32 *pixels, int n, Uint32 amask,
+                     Uint32 threshold);
+#endif /* #if defined(PG_ENABLE_AVX2_BLITTERS) */
+
+#endif /* #if !defined(SIMD_BLITTERS_HEADER) */
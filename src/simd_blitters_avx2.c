@@ -0,0 +1,429 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* AVX2 versions of the 32 bit blitters in alphablit.c.  These are the
+ * SSE2 versions in simd_blitters_sse2.c widened to eight pixels.
+ */
+
+#define NO_PYGAME_C_API
+#include "simd_blitters.h"
+
+#if defined(PG_ENABLE_AVX2_BLITTERS)
+
+#include <immintrin.h>
+
+/* Alpha blend eight pixels. See alpha_blend_4_sse2 for the arithmetic.
+ * The unpack and pack instructions work within each 128 bit half, so the
+ * pixel order is kept.
+ */
+static PG_TARGET_AVX2 __m256i
+alpha_blend_8_avx2 (__m256i s, __m256i d, __m256i amask, __m128i ashift)
+{
+    __m256i zero = _mm256_setzero_si256 ();
+    __m256i byte = _mm256_set1_epi16 (0x00FF);
+    __m256i one = _mm256_set1_epi32 (1);
+    __m256i sa, da, a, lo, hi, sw, dw, aw, res, dzero;
+
+    sa = _mm256_and_si256 (_mm256_srl_epi32 (s, ashift),
+                           _mm256_set1_epi32 (0xFF));
+    da = _mm256_and_si256 (_mm256_srl_epi32 (d, ashift),
+                           _mm256_set1_epi32 (0xFF));
+
+    a = _mm256_or_si256 (sa, _mm256_slli_epi32 (sa, 16));
+
+    aw = _mm256_unpacklo_epi32 (a, a);
+    sw = _mm256_unpacklo_epi8 (s, zero);
+    dw = _mm256_unpacklo_epi8 (d, zero);
+    lo = _mm256_mullo_epi16 (_mm256_sub_epi16 (sw, dw), aw);
+    lo = _mm256_srli_epi16 (_mm256_add_epi16 (lo, sw), 8);
+    lo = _mm256_and_si256 (_mm256_add_epi16 (lo, dw), byte);
+
+    aw = _mm256_unpackhi_epi32 (a, a);
+    sw = _mm256_unpackhi_epi8 (s, zero);
+    dw = _mm256_unpackhi_epi8 (d, zero);
+    hi = _mm256_mullo_epi16 (_mm256_sub_epi16 (sw, dw), aw);
+    hi = _mm256_srli_epi16 (_mm256_add_epi16 (hi, sw), 8);
+    hi = _mm256_and_si256 (_mm256_add_epi16 (hi, dw), byte);
+
+    res = _mm256_packus_epi16 (lo, hi);
+
+    a = _mm256_mullo_epi16 (sa, da);
+    a = _mm256_add_epi32 (a, _mm256_add_epi32 (one, _mm256_srli_epi32 (a, 8)));
+    a = _mm256_sub_epi32 (_mm256_add_epi32 (sa, da), _mm256_srli_epi32 (a, 8));
+    res = _mm256_or_si256 (_mm256_andnot_si256 (amask, res),
+                           _mm256_sll_epi32 (a, ashift));
+
+    dzero = _mm256_cmpeq_epi32 (da, zero);
+    return _mm256_or_si256 (_mm256_and_si256 (dzero, s),
+                            _mm256_andnot_si256 (dzero, res));
+}
+
+void PG_TARGET_AVX2
+alphablit_alpha_avx2_argb (SDL_BlitInfo *info)
+{
+    int             n;
+    int             width = info->width;
+    int             height = info->height;
+    Uint8          *src = info->s_pixels;
+    int             srcskip = info->s_skip;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    __m256i         amask = _mm256_set1_epi32 (srcfmt->Amask);
+    __m128i         ashift = _mm_cvtsi32_si128 (srcfmt->Ashift);
+    __m256i         dset = dstppa ? _mm256_setzero_si256 () : amask;
+    __m256i         dkeep = _mm256_set1_epi32 (dstfmt->Amask ? 0xFFFFFFFF :
+                                               ~srcfmt->Amask);
+    __m256i         s, d;
+
+    while (height--)
+    {
+        for (n = width; n >= 8; n -= 8)
+        {
+            s = _mm256_loadu_si256 ((__m256i *) src);
+            d = _mm256_or_si256 (_mm256_loadu_si256 ((__m256i *) dst), dset);
+            d = alpha_blend_8_avx2 (s, d, amask, ashift);
+            _mm256_storeu_si256 ((__m256i *) dst,
+                                 _mm256_and_si256 (d, dkeep));
+            src += 32;
+            dst += 32;
+        }
+        for (; n > 0; --n)
+        {
+            s = _mm256_set1_epi32 ((int) *(Uint32 *) src);
+            d = _mm256_or_si256 (_mm256_set1_epi32 ((int) *(Uint32 *) dst),
+                                 dset);
+            d = alpha_blend_8_avx2 (s, d, amask, ashift);
+            *(Uint32 *) dst = (Uint32) _mm_cvtsi128_si32 (
+                _mm256_castsi256_si128 (_mm256_and_si256 (d, dkeep)));
+            src += 4;
+            dst += 4;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* Blend eight premultiplied pixels. See premul_blend_4_sse2. */
+static PG_TARGET_AVX2 __m256i
+premul_blend_8_avx2 (__m256i s, __m256i d, __m256i amask, __m128i ashift)
+{
+    __m256i zero = _mm256_setzero_si256 ();
+    __m256i one = _mm256_set1_epi32 (1);
+    __m256i sa, da, a, lo, hi, dw, aw, res;
+
+    sa = _mm256_and_si256 (_mm256_srl_epi32 (s, ashift),
+                           _mm256_set1_epi32 (0xFF));
+    da = _mm256_and_si256 (_mm256_srl_epi32 (d, ashift),
+                           _mm256_set1_epi32 (0xFF));
+    a = _mm256_or_si256 (sa, _mm256_slli_epi32 (sa, 16));
+
+    aw = _mm256_unpacklo_epi32 (a, a);
+    dw = _mm256_unpacklo_epi8 (d, zero);
+    lo = _mm256_sub_epi16 (dw, _mm256_srli_epi16 (_mm256_mullo_epi16 (dw, aw),
+                                                  8));
+    lo = _mm256_add_epi16 (lo, _mm256_unpacklo_epi8 (s, zero));
+
+    aw = _mm256_unpackhi_epi32 (a, a);
+    dw = _mm256_unpackhi_epi8 (d, zero);
+    hi = _mm256_sub_epi16 (dw, _mm256_srli_epi16 (_mm256_mullo_epi16 (dw, aw),
+                                                  8));
+    hi = _mm256_add_epi16 (hi, _mm256_unpackhi_epi8 (s, zero));
+
+    res = _mm256_packus_epi16 (lo, hi);
+
+    a = _mm256_mullo_epi16 (sa, da);
+    a = _mm256_add_epi32 (a, _mm256_add_epi32 (one, _mm256_srli_epi32 (a, 8)));
+    a = _mm256_sub_epi32 (_mm256_add_epi32 (sa, da), _mm256_srli_epi32 (a, 8));
+    return _mm256_or_si256 (_mm256_andnot_si256 (amask, res),
+                            _mm256_sll_epi32 (a, ashift));
+}
+
+void PG_TARGET_AVX2
+blit_blend_premultiplied_avx2_argb (SDL_BlitInfo *info)
+{
+    int             n;
+    int             width = info->width;
+    int             height = info->height;
+    Uint8          *src = info->s_pixels;
+    int             srcskip = info->s_skip;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    __m256i         amask = _mm256_set1_epi32 (srcfmt->Amask);
+    __m128i         ashift = _mm_cvtsi32_si128 (srcfmt->Ashift);
+    __m256i         dset = dstppa ? _mm256_setzero_si256 () : amask;
+    __m256i         dkeep = _mm256_set1_epi32 (dstfmt->Amask ? 0xFFFFFFFF :
+                                               ~srcfmt->Amask);
+    __m256i         s, d;
+
+    while (height--)
+    {
+        for (n = width; n >= 8; n -= 8)
+        {
+            s = _mm256_loadu_si256 ((__m256i *) src);
+            d = _mm256_or_si256 (_mm256_loadu_si256 ((__m256i *) dst), dset);
+            d = premul_blend_8_avx2 (s, d, amask, ashift);
+            _mm256_storeu_si256 ((__m256i *) dst,
+                                 _mm256_and_si256 (d, dkeep));
+            src += 32;
+            dst += 32;
+        }
+        for (; n > 0; --n)
+        {
+            s = _mm256_set1_epi32 ((int) *(Uint32 *) src);
+            d = _mm256_or_si256 (_mm256_set1_epi32 ((int) *(Uint32 *) dst),
+                                 dset);
+            d = premul_blend_8_avx2 (s, d, amask, ashift);
+            *(Uint32 *) dst = (Uint32) _mm_cvtsi128_si32 (
+                _mm256_castsi256_si128 (_mm256_and_si256 (d, dkeep)));
+            src += 4;
+            dst += 4;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static PG_TARGET_AVX2 __m256i
+blend_add_avx2 (__m256i d, __m256i s)
+{
+    return _mm256_adds_epu8 (d, s);
+}
+
+static PG_TARGET_AVX2 __m256i
+blend_sub_avx2 (__m256i d, __m256i s)
+{
+    return _mm256_subs_epu8 (d, s);
+}
+
+static PG_TARGET_AVX2 __m256i
+blend_mul_avx2 (__m256i d, __m256i s)
+{
+    __m256i zero = _mm256_setzero_si256 ();
+    __m256i lo, hi;
+
+    lo = _mm256_mullo_epi16 (_mm256_unpacklo_epi8 (d, zero),
+                             _mm256_unpacklo_epi8 (s, zero));
+    hi = _mm256_mullo_epi16 (_mm256_unpackhi_epi8 (d, zero),
+                             _mm256_unpackhi_epi8 (s, zero));
+    return _mm256_packus_epi16 (_mm256_srli_epi16 (lo, 8),
+                                _mm256_srli_epi16 (hi, 8));
+}
+
+static PG_TARGET_AVX2 __m256i
+blend_min_avx2 (__m256i d, __m256i s)
+{
+    return _mm256_min_epu8 (d, s);
+}
+
+static PG_TARGET_AVX2 __m256i
+blend_max_avx2 (__m256i d, __m256i s)
+{
+    return _mm256_max_epu8 (d, s);
+}
+
+/* The blend blitter loop, eight pixels at a time. See PgBlendMasks. */
+#define BLEND_BLITTER_AVX2(name, op)                                    \
+    void PG_TARGET_AVX2                                                 \
+    name (SDL_BlitInfo *info, PgBlendMasks *masks)                      \
+    {                                                                   \
+        int      n;                                                     \
+        int      width = info->width;                                   \
+        int      height = info->height;                                 \
+        Uint8   *src = info->s_pixels;                                  \
+        int      srcpxskip = info->s_pxskip;                            \
+        int      srcskip = info->s_skip;                                \
+        Uint8   *dst = info->d_pixels;                                  \
+        int      dstskip = info->d_skip;                                \
+        __m256i  sor = _mm256_set1_epi32 (masks->sor);                  \
+        __m256i  rmask = _mm256_set1_epi32 (masks->rmask);              \
+        __m256i  dmask = _mm256_set1_epi32 (masks->dmask);              \
+        __m256i  dor = _mm256_set1_epi32 (masks->dor);                  \
+        __m256i  s, d;                                                  \
+                                                                        \
+        s = _mm256_or_si256 (_mm256_set1_epi32 (*(Uint32 *) src), sor); \
+        while (height--)                                                \
+        {                                                               \
+            for (n = width; n >= 8; n -= 8)                             \
+            {                                                           \
+                if (srcpxskip)                                          \
+                {                                                       \
+                    s = _mm256_or_si256 (                               \
+                        _mm256_loadu_si256 ((__m256i *) src), sor);     \
+                    src += 32;                                          \
+                }                                                       \
+                d = _mm256_loadu_si256 ((__m256i *) dst);               \
+                d = _mm256_or_si256 (                                   \
+                    _mm256_or_si256 (_mm256_and_si256 (op (d, s), rmask), \
+                                     _mm256_and_si256 (d, dmask)), dor); \
+                _mm256_storeu_si256 ((__m256i *) dst, d);               \
+                dst += 32;                                              \
+            }                                                           \
+            for (; n > 0; --n)                                          \
+            {                                                           \
+                if (srcpxskip)                                          \
+                {                                                       \
+                    s = _mm256_or_si256 (                               \
+                        _mm256_set1_epi32 ((int) *(Uint32 *) src), sor); \
+                    src += 4;                                           \
+                }                                                       \
+                d = _mm256_set1_epi32 ((int) *(Uint32 *) dst);          \
+                d = _mm256_or_si256 (                                   \
+                    _mm256_or_si256 (_mm256_and_si256 (op (d, s), rmask), \
+                                     _mm256_and_si256 (d, dmask)), dor); \
+                *(Uint32 *) dst = (Uint32) _mm_cvtsi128_si32 (          \
+                    _mm256_castsi256_si128 (d));                        \
+                dst += 4;                                               \
+            }                                                           \
+            src += srcskip;                                             \
+            dst += dstskip;                                             \
+        }                                                               \
+    }
+
+BLEND_BLITTER_AVX2 (blit_blend_add_avx2, blend_add_avx2)
+BLEND_BLITTER_AVX2 (blit_blend_sub_avx2, blend_sub_avx2)
+BLEND_BLITTER_AVX2 (blit_blend_mul_avx2, blend_mul_avx2)
+BLEND_BLITTER_AVX2 (blit_blend_min_avx2, blend_min_avx2)
+BLEND_BLITTER_AVX2 (blit_blend_max_avx2, blend_max_avx2)
+
+/* Fill with the colour at s_pixels. Each row is filled with aligned
+ * stores, non-temporal ones for fills of more than PG_FILL_STREAM_BYTES.
+ */
+void PG_TARGET_AVX2
+blit_fill_avx2 (SDL_BlitInfo *info)
+{
+    int             n;
+    int             width = info->width;
+    int             height = info->height;
+    Uint32          color = *(Uint32 *) info->s_pixels;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    int             stream = (double) width * height * 4 > PG_FILL_STREAM_BYTES;
+    __m256i         c = _mm256_set1_epi32 ((int) color);
+
+    while (height--)
+    {
+        for (n = width; n > 0 && ((size_t) dst & 31); --n)
+        {
+            *(Uint32 *) dst = color;
+            dst += 4;
+        }
+        if (stream)
+        {
+            for (; n >= 8; n -= 8)
+            {
+                _mm256_stream_si256 ((__m256i *) dst, c);
+                dst += 32;
+            }
+        }
+        else
+        {
+            for (; n >= 8; n -= 8)
+            {
+                _mm256_store_si256 ((__m256i *) dst, c);
+                dst += 32;
+            }
+        }
+        for (; n > 0; --n)
+        {
+            *(Uint32 *) dst = color;
+            dst += 4;
+        }
+        dst += dstskip;
+    }
+    if (stream)
+        _mm_sfence ();
+}
+
+/* The lanes of the eight pixels of v with an alpha of at least
+ * threshold, as alpha_hits_sse2.
+ */
+static PG_TARGET_AVX2 int
+alpha_hits_avx2 (const Uint32 *pixels, __m256i amask, __m256i threshold)
+{
+    __m256i v = _mm256_and_si256 (
+        _mm256_loadu_si256 ((const __m256i *) pixels), amask);
+
+    return _mm256_movemask_ps (_mm256_castsi256_ps (
+        _mm256_cmpeq_epi32 (_mm256_max_epu8 (v, threshold), v)));
+}
+
+int PG_TARGET_AVX2
+alpha_first_avx2 (const Uint32 *pixels, int n, Uint32 amask, Uint32 threshold)
+{
+    __m256i         m = _mm256_set1_epi32 ((int) amask);
+    __m256i         t = _mm256_set1_epi32 ((int) threshold);
+    int             i, bits;
+
+    for (i = 0; i + 8 <= n; i += 8)
+    {
+        bits = alpha_hits_avx2 (pixels + i, m, t);
+        if (bits)
+        {
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                ++i;
+            }
+            return i;
+        }
+    }
+    for (; i < n; ++i)
+    {
+        if ((pixels[i] & amask) >= threshold)
+            return i;
+    }
+    return -1;
+}
+
+int PG_TARGET_AVX2
+alpha_last_avx2 (const Uint32 *pixels, int n, Uint32 amask, Uint32 threshold)
+{
+    __m256i         m = _mm256_set1_epi32 ((int) amask);
+    __m256i         t = _mm256_set1_epi32 ((int) threshold);
+    int             i, bits;
+
+    for (i = n; i >= 8; i -= 8)
+    {
+        bits = alpha_hits_avx2 (pixels + i - 8, m, t);
+        if (bits)
+        {
+            --i;
+            while (!(bits & 0x80))
+            {
+                bits <<= 1;
+                --i;
+            }
+            return i;
+        }
+    }
+    while (i--)
+    {
+        if ((pixels[i] & amask) >= threshold)
+            return i;
+    }
+    return -1;
+}
+
+#endif /* #if defined(PG_ENABLE_AVX2_BLITTERS) */
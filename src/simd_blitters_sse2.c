@@ -0,0 +1,502 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/* SSE2 versions of the 32 bit blitters in alphablit.c.  Each one gives
+ * bit for bit the same result as the generic C code it replaces.
+ */
+
+#define NO_PYGAME_C_API
+#include "simd_blitters.h"
+
+#if defined(PG_ENABLE_SSE2_BLITTERS)
+
+#include <emmintrin.h>
+
+/* Alpha blend four pixels, as ALPHA_BLEND in surface.h.
+ *
+ * The colour channels are done as 16 bit words. The intermediate product of
+ * ALPHA_BLEND_COMP can overflow a word, but the low 16 bits are still
+ * correct, so a logical shift and a mask to 8 bits give the exact result.
+ * The new destination alpha, sA + dA - sA * dA / 255, is done in the alpha
+ * byte of each 32 bit lane, where x / 255 is (x + 1 + (x >> 8)) >> 8 for
+ * all products of two bytes.
+ */
+static PG_TARGET_SSE2 __m128i
+alpha_blend_4_sse2 (__m128i s, __m128i d, __m128i amask, __m128i ashift)
+{
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i byte = _mm_set1_epi16 (0x00FF);
+    __m128i one = _mm_set1_epi32 (1);
+    __m128i sa, da, a, lo, hi, sw, dw, aw, res, dzero;
+
+    sa = _mm_and_si128 (_mm_srl_epi32 (s, ashift), _mm_set1_epi32 (0xFF));
+    da = _mm_and_si128 (_mm_srl_epi32 (d, ashift), _mm_set1_epi32 (0xFF));
+
+    /* Broadcast the source alpha to every word of its pixel */
+    a = _mm_or_si128 (sa, _mm_slli_epi32 (sa, 16));
+
+    aw = _mm_unpacklo_epi32 (a, a);
+    sw = _mm_unpacklo_epi8 (s, zero);
+    dw = _mm_unpacklo_epi8 (d, zero);
+    lo = _mm_mullo_epi16 (_mm_sub_epi16 (sw, dw), aw);
+    lo = _mm_srli_epi16 (_mm_add_epi16 (lo, sw), 8);
+    lo = _mm_and_si128 (_mm_add_epi16 (lo, dw), byte);
+
+    aw = _mm_unpackhi_epi32 (a, a);
+    sw = _mm_unpackhi_epi8 (s, zero);
+    dw = _mm_unpackhi_epi8 (d, zero);
+    hi = _mm_mullo_epi16 (_mm_sub_epi16 (sw, dw), aw);
+    hi = _mm_srli_epi16 (_mm_add_epi16 (hi, sw), 8);
+    hi = _mm_and_si128 (_mm_add_epi16 (hi, dw), byte);
+
+    res = _mm_packus_epi16 (lo, hi);
+
+    /* dA = sA + dA - sA * dA / 255 */
+    a = _mm_mullo_epi16 (sa, da);
+    a = _mm_add_epi32 (a, _mm_add_epi32 (one, _mm_srli_epi32 (a, 8)));
+    a = _mm_sub_epi32 (_mm_add_epi32 (sa, da), _mm_srli_epi32 (a, 8));
+    res = _mm_or_si128 (_mm_andnot_si128 (amask, res),
+                        _mm_sll_epi32 (a, ashift));
+
+    /* A fully transparent destination pixel is replaced by the source */
+    dzero = _mm_cmpeq_epi32 (da, zero);
+    return _mm_or_si128 (_mm_and_si128 (dzero, s),
+                         _mm_andnot_si128 (dzero, res));
+}
+
+void PG_TARGET_SSE2
+alphablit_alpha_sse2_argb (SDL_BlitInfo *info)
+{
+    int             n;
+    int             width = info->width;
+    int             height = info->height;
+    Uint8          *src = info->s_pixels;
+    int             srcskip = info->s_skip;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    __m128i         amask = _mm_set1_epi32 (srcfmt->Amask);
+    __m128i         ashift = _mm_cvtsi32_si128 (srcfmt->Ashift);
+    /* Without per-pixel destination alpha dA is taken as 255 */
+    __m128i         dset = dstppa ? _mm_setzero_si128 () : amask;
+    /* An RGB destination gets zero in the unused byte */
+    __m128i         dkeep = _mm_set1_epi32 (dstfmt->Amask ? 0xFFFFFFFF :
+                                            ~srcfmt->Amask);
+    __m128i         s, d;
+
+    while (height--)
+    {
+        for (n = width; n >= 4; n -= 4)
+        {
+            s = _mm_loadu_si128 ((__m128i *) src);
+            d = _mm_or_si128 (_mm_loadu_si128 ((__m128i *) dst), dset);
+            d = alpha_blend_4_sse2 (s, d, amask, ashift);
+            _mm_storeu_si128 ((__m128i *) dst, _mm_and_si128 (d, dkeep));
+            src += 16;
+            dst += 16;
+        }
+        for (; n > 0; --n)
+        {
+            s = _mm_cvtsi32_si128 ((int) *(Uint32 *) src);
+            d = _mm_or_si128 (_mm_cvtsi32_si128 ((int) *(Uint32 *) dst),
+                              dset);
+            d = alpha_blend_4_sse2 (s, d, amask, ashift);
+            *(Uint32 *) dst =
+                (Uint32) _mm_cvtsi128_si32 (_mm_and_si128 (d, dkeep));
+            src += 4;
+            dst += 4;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* Blend four premultiplied pixels, as ALPHA_BLEND_PREMULTIPLIED in
+ * surface.h. dC * sA fits in an unsigned word, and the saturating pack
+ * does the clamp to 255.
+ */
+static PG_TARGET_SSE2 __m128i
+premul_blend_4_sse2 (__m128i s, __m128i d, __m128i amask, __m128i ashift)
+{
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i one = _mm_set1_epi32 (1);
+    __m128i sa, da, a, lo, hi, dw, aw, res;
+
+    sa = _mm_and_si128 (_mm_srl_epi32 (s, ashift), _mm_set1_epi32 (0xFF));
+    da = _mm_and_si128 (_mm_srl_epi32 (d, ashift), _mm_set1_epi32 (0xFF));
+    a = _mm_or_si128 (sa, _mm_slli_epi32 (sa, 16));
+
+    aw = _mm_unpacklo_epi32 (a, a);
+    dw = _mm_unpacklo_epi8 (d, zero);
+    lo = _mm_sub_epi16 (dw, _mm_srli_epi16 (_mm_mullo_epi16 (dw, aw), 8));
+    lo = _mm_add_epi16 (lo, _mm_unpacklo_epi8 (s, zero));
+
+    aw = _mm_unpackhi_epi32 (a, a);
+    dw = _mm_unpackhi_epi8 (d, zero);
+    hi = _mm_sub_epi16 (dw, _mm_srli_epi16 (_mm_mullo_epi16 (dw, aw), 8));
+    hi = _mm_add_epi16 (hi, _mm_unpackhi_epi8 (s, zero));
+
+    res = _mm_packus_epi16 (lo, hi);
+
+    /* dA = sA + dA - sA * dA / 255, as in alpha_blend_4_sse2 */
+    a = _mm_mullo_epi16 (sa, da);
+    a = _mm_add_epi32 (a, _mm_add_epi32 (one, _mm_srli_epi32 (a, 8)));
+    a = _mm_sub_epi32 (_mm_add_epi32 (sa, da), _mm_srli_epi32 (a, 8));
+    return _mm_or_si128 (_mm_andnot_si128 (amask, res),
+                         _mm_sll_epi32 (a, ashift));
+}
+
+void PG_TARGET_SSE2
+blit_blend_premultiplied_sse2_argb (SDL_BlitInfo *info)
+{
+    int             n;
+    int             width = info->width;
+    int             height = info->height;
+    Uint8          *src = info->s_pixels;
+    int             srcskip = info->s_skip;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    int             dstppa = (info->dst_flags & SDL_SRCALPHA && dstfmt->Amask);
+    __m128i         amask = _mm_set1_epi32 (srcfmt->Amask);
+    __m128i         ashift = _mm_cvtsi32_si128 (srcfmt->Ashift);
+    __m128i         dset = dstppa ? _mm_setzero_si128 () : amask;
+    __m128i         dkeep = _mm_set1_epi32 (dstfmt->Amask ? 0xFFFFFFFF :
+                                            ~srcfmt->Amask);
+    __m128i         s, d;
+
+    while (height--)
+    {
+        for (n = width; n >= 4; n -= 4)
+        {
+            s = _mm_loadu_si128 ((__m128i *) src);
+            d = _mm_or_si128 (_mm_loadu_si128 ((__m128i *) dst), dset);
+            d = premul_blend_4_sse2 (s, d, amask, ashift);
+            _mm_storeu_si128 ((__m128i *) dst, _mm_and_si128 (d, dkeep));
+            src += 16;
+            dst += 16;
+        }
+        for (; n > 0; --n)
+        {
+            s = _mm_cvtsi32_si128 ((int) *(Uint32 *) src);
+            d = _mm_or_si128 (_mm_cvtsi32_si128 ((int) *(Uint32 *) dst),
+                              dset);
+            d = premul_blend_4_sse2 (s, d, amask, ashift);
+            *(Uint32 *) dst =
+                (Uint32) _mm_cvtsi128_si32 (_mm_and_si128 (d, dkeep));
+            src += 4;
+            dst += 4;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static PG_TARGET_SSE2 __m128i
+blend_add_sse2 (__m128i d, __m128i s)
+{
+    return _mm_adds_epu8 (d, s);
+}
+
+static PG_TARGET_SSE2 __m128i
+blend_sub_sse2 (__m128i d, __m128i s)
+{
+    return _mm_subs_epu8 (d, s);
+}
+
+/* (d * s) >> 8, which is BLEND_MULT, since a zero byte gives zero anyway */
+static PG_TARGET_SSE2 __m128i
+blend_mul_sse2 (__m128i d, __m128i s)
+{
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i lo, hi;
+
+    lo = _mm_mullo_epi16 (_mm_unpacklo_epi8 (d, zero),
+                          _mm_unpacklo_epi8 (s, zero));
+    hi = _mm_mullo_epi16 (_mm_unpackhi_epi8 (d, zero),
+                          _mm_unpackhi_epi8 (s, zero));
+    return _mm_packus_epi16 (_mm_srli_epi16 (lo, 8), _mm_srli_epi16 (hi, 8));
+}
+
+static PG_TARGET_SSE2 __m128i
+blend_min_sse2 (__m128i d, __m128i s)
+{
+    return _mm_min_epu8 (d, s);
+}
+
+static PG_TARGET_SSE2 __m128i
+blend_max_sse2 (__m128i d, __m128i s)
+{
+    return _mm_max_epu8 (d, s);
+}
+
+/* The blend blitter loop, four pixels at a time. See PgBlendMasks. */
+#define BLEND_BLITTER_SSE2(name, op)                                    \
+    void PG_TARGET_SSE2                                                 \
+    name (SDL_BlitInfo *info, PgBlendMasks *masks)                      \
+    {                                                                   \
+        int      n;                                                     \
+        int      width = info->width;                                   \
+        int      height = info->height;                                 \
+        Uint8   *src = info->s_pixels;                                  \
+        int      srcpxskip = info->s_pxskip;                            \
+        int      srcskip = info->s_skip;                                \
+        Uint8   *dst = info->d_pixels;                                  \
+        int      dstskip = info->d_skip;                                \
+        __m128i  sor = _mm_set1_epi32 (masks->sor);                     \
+        __m128i  rmask = _mm_set1_epi32 (masks->rmask);                 \
+        __m128i  dmask = _mm_set1_epi32 (masks->dmask);                 \
+        __m128i  dor = _mm_set1_epi32 (masks->dor);                     \
+        __m128i  s, d;                                                  \
+                                                                        \
+        s = _mm_or_si128 (_mm_set1_epi32 (*(Uint32 *) src), sor);       \
+        while (height--)                                                \
+        {                                                               \
+            for (n = width; n >= 4; n -= 4)                             \
+            {                                                           \
+                if (srcpxskip)                                          \
+                {                                                       \
+                    s = _mm_or_si128 (_mm_loadu_si128 ((__m128i *) src), \
+                                      sor);                             \
+                    src += 16;                                          \
+                }                                                       \
+                d = _mm_loadu_si128 ((__m128i *) dst);                  \
+                d = _mm_or_si128 (                                      \
+                    _mm_or_si128 (_mm_and_si128 (op (d, s), rmask),     \
+                                  _mm_and_si128 (d, dmask)), dor);      \
+                _mm_storeu_si128 ((__m128i *) dst, d);                  \
+                dst += 16;                                              \
+            }                                                           \
+            for (; n > 0; --n)                                          \
+            {                                                           \
+                if (srcpxskip)                                          \
+                {                                                       \
+                    s = _mm_or_si128 (                                  \
+                        _mm_cvtsi32_si128 ((int) *(Uint32 *) src), sor); \
+                    src += 4;                                           \
+                }                                                       \
+                d = _mm_cvtsi32_si128 ((int) *(Uint32 *) dst);          \
+                d = _mm_or_si128 (                                      \
+                    _mm_or_si128 (_mm_and_si128 (op (d, s), rmask),     \
+                                  _mm_and_si128 (d, dmask)), dor);      \
+                *(Uint32 *) dst = (Uint32) _mm_cvtsi128_si32 (d);       \
+                dst += 4;                                               \
+            }                                                           \
+            src += srcskip;                                             \
+            dst += dstskip;                                             \
+        }                                                               \
+    }
+
+BLEND_BLITTER_SSE2 (blit_blend_add_sse2, blend_add_sse2)
+BLEND_BLITTER_SSE2 (blit_blend_sub_sse2, blend_sub_sse2)
+BLEND_BLITTER_SSE2 (blit_blend_mul_sse2, blend_mul_sse2)
+BLEND_BLITTER_SSE2 (blit_blend_min_sse2, blend_min_sse2)
+BLEND_BLITTER_SSE2 (blit_blend_max_sse2, blend_max_sse2)
+
+/* Fill with the colour at s_pixels. Each row is filled with aligned
+ * stores, non-temporal ones for fills of more than PG_FILL_STREAM_BYTES.
+ */
+void PG_TARGET_SSE2
+blit_fill_sse2 (SDL_BlitInfo *info)
+{
+    int             n;
+    int             width = info->width;
+    int             height = info->height;
+    Uint32          color = *(Uint32 *) info->s_pixels;
+    Uint8          *dst = info->d_pixels;
+    int             dstskip = info->d_skip;
+    int             stream = (double) width * height * 4 > PG_FILL_STREAM_BYTES;
+    __m128i         c = _mm_set1_epi32 ((int) color);
+
+    while (height--)
+    {
+        for (n = width; n > 0 && ((size_t) dst & 15); --n)
+        {
+            *(Uint32 *) dst = color;
+            dst += 4;
+        }
+        if (stream)
+        {
+            for (; n >= 4; n -= 4)
+            {
+                _mm_stream_si128 ((__m128i *) dst, c);
+                dst += 16;
+            }
+        }
+        else
+        {
+            for (; n >= 4; n -= 4)
+            {
+                _mm_store_si128 ((__m128i *) dst, c);
+                dst += 16;
+            }
+        }
+        for (; n > 0; --n)
+        {
+            *(Uint32 *) dst = color;
+            dst += 4;
+        }
+        dst += dstskip;
+    }
+    if (stream)
+        _mm_sfence ();
+}
+
+/* Lane masks of the four pixels of v whose alpha, the bits in amask, is
+ * at least threshold, the minimum alpha shifted into place. With all other
+ * bytes cleared, a lane is unchanged by an unsigned byte max with the
+ * threshold only if its alpha byte is not below it.
+ */
+static PG_TARGET_SSE2 int
+alpha_hits_sse2 (const Uint32 *pixels, __m128i amask, __m128i threshold)
+{
+    __m128i v = _mm_and_si128 (_mm_loadu_si128 ((const __m128i *) pixels),
+                               amask);
+
+    return _mm_movemask_ps (_mm_castsi128_ps (
+        _mm_cmpeq_epi32 (_mm_max_epu8 (v, threshold), v)));
+}
+
+/* The first of n pixels with an alpha of at least threshold, as a pixel
+ * with (pixel & amask) >= threshold, or -1 if there is none.
+ */
+int PG_TARGET_SSE2
+alpha_first_sse2 (const Uint32 *pixels, int n, Uint32 amask, Uint32 threshold)
+{
+    __m128i         m = _mm_set1_epi32 ((int) amask);
+    __m128i         t = _mm_set1_epi32 ((int) threshold);
+    int             i, bits;
+
+    for (i = 0; i + 8 <= n; i += 8)
+    {
+        bits = alpha_hits_sse2 (pixels + i, m, t) |
+            alpha_hits_sse2 (pixels + i + 4, m, t) << 4;
+        if (bits)
+        {
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                ++i;
+            }
+            return i;
+        }
+    }
+    for (; i < n; ++i)
+    {
+        if ((pixels[i] & amask) >= threshold)
+            return i;
+    }
+    return -1;
+}
+
+/* The last of n pixels with an alpha of at least threshold, or -1 */
+int PG_TARGET_SSE2
+alpha_last_sse2 (const Uint32 *pixels, int n, Uint32 amask, Uint32 threshold)
+{
+    __m128i         m = _mm_set1_epi32 ((int) amask);
+    __m128i         t = _mm_set1_epi32 ((int) threshold);
+    int             i, bits;
+
+    for (i = n; i >= 8; i -= 8)
+    {
+        bits = alpha_hits_sse2 (pixels + i - 8, m, t) |
+            alpha_hits_sse2 (pixels + i - 4, m, t) << 4;
+        if (bits)
+        {
+            --i;
+            while (!(bits & 0x80))
+            {
+                bits <<= 1;
+                --i;
+            }
+            return i;
+        }
+    }
+    while (i--)
+    {
+        if ((pixels[i] & amask) >= threshold)
+            return i;
+    }
+    return -1;
+}
+
+/* Convert n pixels of 3 or 4 bytes at src to 32 bit pixels with a
+ * PgSwizzle, four at a time. Three byte pixels are loaded 16 bytes at a
+ * time and spread out to 32 bit lanes with byte shifts, so that is only
+ * done while the 16 bytes are all in the row.
+ */
+void PG_TARGET_SSE2
+convert_32_sse2 (const Uint8 *src, Uint32 *dst, int n, int srcbpp,
+                 const PgSwizzle *swizzle)
+{
+    __m128i         fill = _mm_set1_epi32 ((int) swizzle->fill);
+    __m128i         mask[4], count[4];
+    __m128i         s, d;
+    Uint32          p, q;
+    int             i, j;
+
+    for (j = 0; j < swizzle->count; ++j)
+    {
+        mask[j] = _mm_set1_epi32 ((int) swizzle->mask[j]);
+        count[j] = _mm_cvtsi32_si128 (swizzle->shift[j] < 0 ?
+                                      -swizzle->shift[j] :
+                                      swizzle->shift[j]);
+    }
+
+    for (i = 0; i + (srcbpp == 4 ? 4 : 6) <= n; i += 4)
+    {
+        s = _mm_loadu_si128 ((const __m128i *) (src + i * srcbpp));
+        if (srcbpp == 3)
+            s = _mm_unpacklo_epi64 (
+                _mm_unpacklo_epi32 (s, _mm_srli_si128 (s, 3)),
+                _mm_unpacklo_epi32 (_mm_srli_si128 (s, 6),
+                                    _mm_srli_si128 (s, 9)));
+        d = fill;
+        for (j = 0; j < swizzle->count; ++j)
+        {
+            if (swizzle->shift[j] < 0)
+                d = _mm_or_si128 (d, _mm_and_si128 (
+                    _mm_srl_epi32 (s, count[j]), mask[j]));
+            else
+                d = _mm_or_si128 (d, _mm_and_si128 (
+                    _mm_sll_epi32 (s, count[j]), mask[j]));
+        }
+        _mm_storeu_si128 ((__m128i *) (dst + i), d);
+    }
+    for (; i < n; ++i)
+    {
+        p = srcbpp == 4 ? *(const Uint32 *) (src + i * 4) :
+            (Uint32) src[i * 3] | (Uint32) src[i * 3 + 1] << 8 |
+            (Uint32) src[i * 3 + 2] << 16;
+        q = swizzle->fill;
+        for (j = 0; j < swizzle->count; ++j)
+        {
+            if (swizzle->shift[j] < 0)
+                q |= (p >> -swizzle->shift[j]) & swizzle->mask[j];
+            else
+                q |= (p << swizzle->shift[j]) & swizzle->mask[j];
+        }
+        dst[i] = q;
+    }
+}
+
+#endif /* #if defined(PG_ENABLE_SSE2_BLITTERS) */
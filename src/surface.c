@@ -29,6 +29,15 @@
 #include "pgcompat.h"
 #include "pgbufferproxy.h"
 
+/* Most rects kept as the damage of a surface before they are merged */
+#define PG_DAMAGE_MAX_RECTS 256
+
+typedef struct PgDamage
+{
+    int              n;
+    SDL_Rect         rects[PG_DAMAGE_MAX_RECTS];
+} PgDamage;
+
 typedef enum {
     VIEWKIND_0D = 0,
     VIEWKIND_1D = 1,
@@ -57,6 +66,9 @@ PySurface_Blit (PyObject * dstobj, PyObject * srcobj, SDL_Rect * dstrect,
 
 /* statics */
 static PyObject *PySurface_New (SDL_Surface * info);
+static void PySurface_AddDamage (PyObject *surfobj, SDL_Rect *rect);
+static int PySurface_TakeDamage (PyObject *surfobj, SDL_Rect *rects, int max);
+static int damage_merge (SDL_Rect *rects, int n);
 static PyObject *surface_new (PyTypeObject *type, PyObject *args,
                               PyObject *kwds);
 static intptr_t surface_init (PySurfaceObject *self, PyObject *args,
@@ -67,10 +79,14 @@ static void surface_dealloc (PyObject *self);
 static void surface_cleanup (PySurfaceObject * self);
 static void surface_move (Uint8 *src, Uint8 *dst, int h,
               int span, int srcpitch, int dstpitch);
+static int surface_color_is_premul (SDL_PixelFormat *format, Uint32 color);
+static void surface_unmark_premul (PyObject *surfobj);
 
 static PyObject *surf_get_at (PyObject *self, PyObject *args);
 static PyObject *surf_set_at (PyObject *self, PyObject *args);
 static PyObject *surf_get_at_mapped (PyObject *self, PyObject *args);
+static PyObject *surf_get_at_many (PyObject *self, PyObject *args);
+static PyObject *surf_set_at_many (PyObject *self, PyObject *args);
 static PyObject *surf_map_rgb (PyObject *self, PyObject *args);
 static PyObject *surf_unmap_rgb (PyObject *self, PyObject *arg);
 static PyObject *surf_lock (PyObject *self);
@@ -87,11 +103,18 @@ static PyObject *surf_get_colorkey (PyObject *self);
 static PyObject *surf_set_alpha (PyObject *self, PyObject *args);
 static PyObject *surf_get_alpha (PyObject *self);
 static PyObject *surf_copy (PyObject *self);
+static PyObject *surf_premul_alpha (PyObject *self);
+static PyObject *surf_get_premul_alpha (PyObject *self);
 static PyObject *surf_convert (PyObject *self, PyObject *args);
 static PyObject *surf_convert_alpha (PyObject *self, PyObject *args);
 static PyObject *surf_set_clip (PyObject *self, PyObject *args);
 static PyObject *surf_get_clip (PyObject *self);
+static PyObject *surf_track_damage (PyObject *self, PyObject *args);
+static PyObject *surf_get_auto_conversions (PyObject *self);
+static PyObject *surf_get_damage (PyObject *self, PyObject *args,
+                                  PyObject *keywds);
 static PyObject *surf_blit (PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject *surf_blits (PyObject *self, PyObject *args, PyObject *keywds);
 static PyObject *surf_fill (PyObject *self, PyObject *args, PyObject *keywds);
 static PyObject *surf_scroll (PyObject *self,
                               PyObject *args, PyObject *keywds);
@@ -102,6 +125,10 @@ static PyObject *surf_get_bytesize (PyObject *self);
 static PyObject *surf_get_flags (PyObject *self);
 static PyObject *surf_get_height (PyObject *self);
 static PyObject *surf_get_pitch (PyObject *self);
+static PyObject *surf_get_row_alignment (PyObject *self);
+static PyObject *surf_compress (PyObject *self);
+static PyObject *surf_decompress (PyObject *self);
+static PyObject *surf_get_compressed (PyObject *self);
 static PyObject *surf_get_rect (PyObject *self, PyObject *args,
                                 PyObject *kwargs);
 static PyObject *surf_get_width (PyObject *self);
@@ -114,8 +141,13 @@ static PyObject *surf_set_masks (PyObject *self, PyObject *args);
 static PyObject *surf_get_offset (PyObject *self);
 static PyObject *surf_get_parent (PyObject *self);
 static PyObject *surf_subsurface (PyObject *self, PyObject *args);
-static PyObject *surf_get_view (PyObject *self, PyObject *args);
+static PyObject *surf_region (PyObject *self, PyObject *args);
+static PyObject *surf_get_view (PyObject *self, PyObject *args,
+                                PyObject *kwds);
 static PyObject *surf_get_buffer (PyObject *self);
+static PyObject *surf_begin_frame (PyObject *self);
+static PyObject *surf_end_frame (PyObject *self);
+static PyObject *surf_get_frame (PyObject *self);
 static PyObject *surf_get_bounding_rect (PyObject *self, PyObject *args,
                                          PyObject *kwargs);
 static PyObject *surf_get_pixels_address (PyObject *self,
@@ -134,6 +166,18 @@ static int _get_buffer_colorplane (PyObject *obj,
                                    int flags,
                                    char *name,
                                    Uint32 mask);
+static int _get_buffer_rect (PyObject *obj, Py_buffer *view_p, int flags,
+                             getbufferproc get_buffer);
+static int _get_buffer_rect_2D (PyObject *obj, Py_buffer *view_p, int flags);
+static int _get_buffer_rect_3D (PyObject *obj, Py_buffer *view_p, int flags);
+static int _get_buffer_rect_red (PyObject *obj, Py_buffer *view_p,
+                                 int flags);
+static int _get_buffer_rect_green (PyObject *obj, Py_buffer *view_p,
+                                   int flags);
+static int _get_buffer_rect_blue (PyObject *obj, Py_buffer *view_p,
+                                  int flags);
+static int _get_buffer_rect_alpha (PyObject *obj, Py_buffer *view_p,
+                                   int flags);
 static int _init_buffer(PyObject *surf, Py_buffer *view_p, int flags);
 static void _release_buffer(Py_buffer *view_p);
 static PyObject *_raise_get_view_ndim_error(int bitsize, SurfViewKind kind);
@@ -149,6 +193,8 @@ static struct PyMethodDef surface_methods[] = {
     { "set_at", surf_set_at, METH_VARARGS, DOC_SURFACESETAT },
     { "get_at_mapped", surf_get_at_mapped, METH_VARARGS,
       DOC_SURFACEGETATMAPPED },
+    { "get_at_many", surf_get_at_many, METH_VARARGS, DOC_SURFACEGETATMANY },
+    { "set_at_many", surf_set_at_many, METH_VARARGS, DOC_SURFACESETATMANY },
     { "map_rgb", surf_map_rgb, METH_VARARGS, DOC_SURFACEMAPRGB },
     { "unmap_rgb", surf_unmap_rgb, METH_O, DOC_SURFACEUNMAPRGB },
 
@@ -181,15 +227,27 @@ static struct PyMethodDef surface_methods[] = {
     { "convert", surf_convert, METH_VARARGS, DOC_SURFACECONVERT },
     { "convert_alpha", surf_convert_alpha, METH_VARARGS,
       DOC_SURFACECONVERTALPHA },
+    { "premul_alpha", (PyCFunction) surf_premul_alpha, METH_NOARGS,
+      DOC_SURFACEPREMULALPHA },
+    { "get_premul_alpha", (PyCFunction) surf_get_premul_alpha, METH_NOARGS,
+      DOC_SURFACEGETPREMULALPHA },
 
     { "set_clip", surf_set_clip, METH_VARARGS, DOC_SURFACESETCLIP },
     { "get_clip", (PyCFunction) surf_get_clip, METH_NOARGS,
       DOC_SURFACEGETCLIP },
+    { "track_damage", surf_track_damage, METH_VARARGS,
+      DOC_SURFACETRACKDAMAGE },
+    { "get_auto_conversions", (PyCFunction) surf_get_auto_conversions,
+      METH_NOARGS, DOC_SURFACEGETAUTOCONVERSIONS },
+    { "get_damage", (PyCFunction) surf_get_damage,
+      METH_VARARGS | METH_KEYWORDS, DOC_SURFACEGETDAMAGE },
 
     { "fill", (PyCFunction) surf_fill, METH_VARARGS | METH_KEYWORDS,
       DOC_SURFACEFILL },
     { "blit", (PyCFunction) surf_blit, METH_VARARGS | METH_KEYWORDS,
       DOC_SURFACEBLIT },
+    { "blits", (PyCFunction) surf_blits, METH_VARARGS | METH_KEYWORDS,
+      DOC_SURFACEBLITS },
 
     { "scroll", (PyCFunction) surf_scroll, METH_VARARGS | METH_KEYWORDS,
       DOC_SURFACESCROLL },
@@ -206,6 +264,14 @@ static struct PyMethodDef surface_methods[] = {
       DOC_SURFACEGETRECT },
     { "get_pitch", (PyCFunction) surf_get_pitch, METH_NOARGS,
       DOC_SURFACEGETPITCH },
+    { "get_row_alignment", (PyCFunction) surf_get_row_alignment,
+      METH_NOARGS, DOC_SURFACEGETROWALIGNMENT },
+    { "compress", (PyCFunction) surf_compress, METH_NOARGS,
+      DOC_SURFACECOMPRESS },
+    { "decompress", (PyCFunction) surf_decompress, METH_NOARGS,
+      DOC_SURFACEDECOMPRESS },
+    { "get_compressed", (PyCFunction) surf_get_compressed, METH_NOARGS,
+      DOC_SURFACEGETCOMPRESSED },
     { "get_bitsize", (PyCFunction) surf_get_bitsize, METH_NOARGS,
       DOC_SURFACEGETBITSIZE },
     { "get_bytesize", (PyCFunction) surf_get_bytesize, METH_NOARGS,
@@ -223,6 +289,7 @@ static struct PyMethodDef surface_methods[] = {
       DOC_SURFACEGETLOSSES },
 
     { "subsurface", surf_subsurface, METH_VARARGS, DOC_SURFACESUBSURFACE },
+    { "region", surf_region, METH_VARARGS, DOC_SURFACEREGION },
     { "get_offset", (PyCFunction) surf_get_offset, METH_NOARGS,
       DOC_SURFACEGETOFFSET },
     { "get_abs_offset", (PyCFunction) surf_get_abs_offset, METH_NOARGS,
@@ -234,10 +301,16 @@ static struct PyMethodDef surface_methods[] = {
     { "get_bounding_rect", (PyCFunction) surf_get_bounding_rect,
       METH_VARARGS | METH_KEYWORDS,
       DOC_SURFACEGETBOUNDINGRECT},
-    { "get_view", (PyCFunction) surf_get_view, METH_VARARGS,
+    { "get_view", (PyCFunction) surf_get_view, METH_VARARGS | METH_KEYWORDS,
       DOC_SURFACEGETVIEW},
     { "get_buffer", (PyCFunction) surf_get_buffer, METH_NOARGS,
       DOC_SURFACEGETBUFFER},
+    { "begin_frame", (PyCFunction) surf_begin_frame, METH_NOARGS,
+      DOC_SURFACEBEGINFRAME },
+    { "end_frame", (PyCFunction) surf_end_frame, METH_NOARGS,
+      DOC_SURFACEENDFRAME },
+    { "get_frame", (PyCFunction) surf_get_frame, METH_NOARGS,
+      DOC_SURFACEGETFRAME },
 
     { NULL, NULL, 0, NULL }
 };
@@ -284,6 +357,19 @@ static PyTypeObject PySurface_Type = {
 
 #define PySurface_Check(x) ((x)->ob_type == &PySurface_Type)
 
+/* A part of a Surface, kept as the Surface and a rect. Blits from a region
+ * are blits from its parent, with no SDL surface of its own.
+ */
+typedef struct {
+    PyObject_HEAD
+    PyObject *parent;           /* a Surface, never another region */
+    GAME_Rect rect;             /* the part of the parent */
+    PyObject *subsurface;       /* made by PySurface_Source, if needed */
+} PySurfaceRegionObject;
+
+static PyTypeObject PySurfaceRegion_Type;
+#define PySurfaceRegion_Check(x) (Py_TYPE (x) == &PySurfaceRegion_Type)
+
 static PyObject*
 PySurface_New (SDL_Surface *s)
 {
@@ -319,6 +405,16 @@ surface_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->weakreflist = NULL;
         self->dependency = NULL;
         self->locklist = NULL;
+        self->selflocks = 0;
+        self->premultiplied = 0;
+        self->rle = NULL;
+        self->damage = NULL;
+        self->twin = NULL;
+        self->conversions = 0;
+        self->shared = NULL;
+        self->cow = NULL;
+        self->packed = NULL;
+        self->subsurfaces = 0;
     }
     return (PyObject *) self;
 }
@@ -327,16 +423,24 @@ surface_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
 static void
 surface_cleanup (PySurfaceObject *self)
 {
+    pygame_CowRelease (self);
+    pygame_PackRelease (self);
     if (self->surf) {
         if (!(self->surf->flags & SDL_HWSURFACE) ||
             SDL_WasInit (SDL_INIT_VIDEO)) {
             /* unsafe to free hardware surfaces without video init */
             /* i question SDL's ability to free a locked hardware surface */
-            SDL_FreeSurface (self->surf);
+            pygame_PoolFreeSurface (self->surf);
         }
         self->surf = NULL;
     }
+    if (self->shared) {
+        pygame_SharedClose (self->shared);
+        self->shared = NULL;
+    }
     if (self->subsurface) {
+        if (self->subsurface->owner)
+            ((PySurfaceObject *) self->subsurface->owner)->subsurfaces--;
         Py_XDECREF (self->subsurface->owner);
         PyMem_Del (self->subsurface);
         self->subsurface = NULL;
@@ -350,6 +454,11 @@ surface_cleanup (PySurfaceObject *self)
         Py_DECREF (self->locklist);
         self->locklist = NULL;
     }
+    PySurface_DropRLE (self);
+    if (self->damage) {
+        PyMem_Del (self->damage);
+        self->damage = NULL;
+    }
 }
 
 static void
@@ -391,9 +500,10 @@ surface_init (PySurfaceObject *self, PyObject *args, PyObject *kwds)
     SDL_Surface *surface;
     SDL_PixelFormat default_format, *format;
     int length;
+    int align = 0;
 
-    char *kwids[] = { "size", "flags", "depth", "masks", NULL };
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|iOO", kwids, &size, &flags, &depth, &masks))
+    char *kwids[] = { "size", "flags", "depth", "masks", "align", NULL };
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|iOOi", kwids, &size, &flags, &depth, &masks, &align))
        return -1;
 
     if (PySequence_Check (size) && (length = PySequence_Length (size)) == 2) {
@@ -412,6 +522,16 @@ surface_init (PySurfaceObject *self, PyObject *args, PyObject *kwds)
         return -1;
     }
 
+    if (align && (align < 4 || align > 64 || (align & (align - 1)))) {
+        RAISE (PyExc_ValueError,
+               "align must be 0 or a power of two from 4 to 64");
+        return -1;
+    }
+    if (align && (flags & SDL_HWSURFACE)) {
+        RAISE (PyExc_ValueError, "aligned Surfaces cannot be in video memory");
+        return -1;
+    }
+
     surface_cleanup (self);
 
     if (depth && masks) {      /* all info supplied, most errorchecking
@@ -546,8 +666,12 @@ surface_init (PySurfaceObject *self, PyObject *args, PyObject *kwds)
 
     }
 
-    surface = SDL_CreateRGBSurface (flags, width, height, bpp, Rmask, Gmask,
-                                    Bmask, Amask);
+    if (align)
+        surface = pygame_PoolCreateAligned (width, height, bpp, align, Rmask,
+                                            Gmask, Bmask, Amask);
+    else
+        surface = pygame_PoolCreateSurface (flags, width, height, bpp, Rmask,
+                                            Gmask, Bmask, Amask);
 
     if (!surface) {
         RAISE (PyExc_SDLError, SDL_GetError ());
@@ -572,7 +696,7 @@ surface_init (PySurfaceObject *self, PyObject *args, PyObject *kwds)
              (format->Rloss || format->Gloss || format->Bloss ||
               (surface->flags & SDL_SRCALPHA ?
                format->Aloss : format->Aloss != 8)))) {
-        SDL_FreeSurface (surface);
+        pygame_PoolFreeSurface (surface);
         RAISE (PyExc_ValueError, "Invalid mask values");
         return -1;
         }
@@ -581,6 +705,7 @@ surface_init (PySurfaceObject *self, PyObject *args, PyObject *kwds)
     if (surface) {
         self->surf = surface;
         self->subsurface = NULL;
+        self->premultiplied = 0;
     }
 
     return 0;
@@ -716,6 +841,8 @@ surf_set_at (PyObject *self, PyObject *args)
         *((Uint32 *) (pixels + y * surf->pitch) + x) = color;
         break;
     }
+    if (!surface_color_is_premul (format, color))
+        surface_unmark_premul (self);
 
     if (!PySurface_Unlock (self))
         return NULL;
@@ -777,6 +904,306 @@ surf_get_at_mapped (PyObject *self, PyObject *args)
     return PyInt_FromLong ((long)color);
 }
 
+/* Get a C contiguous view of obj as 4 byte integers, such as an
+ * array.array('i') or a numpy int32 array, in native byte order.
+ */
+static int
+surface_int_view (PyObject *obj, Pg_buffer *pg_view, int flags,
+                  const char *name)
+{
+    Py_buffer *view_p = (Py_buffer *) pg_view;
+    const char *format;
+
+    if (PgObject_GetBuffer (obj, pg_view,
+                            flags | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS))
+        return -1;
+    format = view_p->format ? view_p->format : "B";
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (*format == '@' || *format == '=' || *format == '<')
+#else
+    if (*format == '@' || *format == '=' || *format == '>' || *format == '!')
+#endif
+        ++format;
+    if (view_p->itemsize != 4 || !*format || format[1] ||
+        !strchr ("iIlL", *format)) {
+        PgBuffer_Release (pg_view);
+        PyErr_Format (PyExc_ValueError,
+                      "%s must be a buffer of 4 byte integers", name);
+        return -1;
+    }
+    return 0;
+}
+
+/* Read the mapped colors of n points, stopping at the first outside the
+ * surface. Returns how many were read.
+ */
+static Py_ssize_t
+surface_get_many (SDL_Surface *surf, const Sint32 *points, Uint32 *mapped,
+                  Py_ssize_t n)
+{
+    Uint8 *pixels = (Uint8 *) surf->pixels;
+    Uint8 *row, *pix;
+    int pitch = surf->pitch;
+    unsigned w = (unsigned) surf->w, h = (unsigned) surf->h;
+    Sint32 x, y;
+    Py_ssize_t i;
+
+#define GET_AT_MANY(expr)                                            \
+    for (i = 0; i < n; i++) {                                        \
+        x = points[2 * i];                                           \
+        y = points[2 * i + 1];                                       \
+        if ((unsigned) x >= w || (unsigned) y >= h)                  \
+            break;                                                   \
+        row = pixels + y * pitch;                                    \
+        mapped[i] = (Uint32) (expr);                                 \
+    }
+
+    switch (surf->format->BytesPerPixel) {
+
+    case 1:
+        GET_AT_MANY (row[x]);
+        break;
+    case 2:
+        GET_AT_MANY (((Uint16 *) row)[x]);
+        break;
+    case 3:
+        GET_AT_MANY ((pix = row + x * 3, GET_PIXEL_24 (pix)));
+        break;
+    default:                  /* case 4: */
+        GET_AT_MANY (((Uint32 *) row)[x]);
+        break;
+    }
+#undef GET_AT_MANY
+    return i;
+}
+
+/* Write the mapped colors of n points, or the single color if colors is
+ * NULL, leaving out points outside the clip rect.
+ */
+static void
+surface_set_many (SDL_Surface *surf, const Sint32 *points,
+                  const Uint32 *colors, Uint32 color, Py_ssize_t n)
+{
+    SDL_PixelFormat *format = surf->format;
+    SDL_Rect *clip = &surf->clip_rect;
+    Uint8 *pixels = (Uint8 *) surf->pixels;
+    Uint8 *row, *byte_buf;
+    int pitch = surf->pitch;
+    Sint32 x, y;
+    Py_ssize_t i;
+#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    int r = format->Rshift >> 3, g = format->Gshift >> 3;
+    int b = format->Bshift >> 3;
+#else
+    int r = 2 - (format->Rshift >> 3), g = 2 - (format->Gshift >> 3);
+    int b = 2 - (format->Bshift >> 3);
+#endif
+
+#define SET_AT_MANY(stmt)                                            \
+    for (i = 0; i < n; i++) {                                        \
+        x = points[2 * i];                                           \
+        y = points[2 * i + 1];                                       \
+        if (x < clip->x || x >= clip->x + clip->w ||                 \
+            y < clip->y || y >= clip->y + clip->h)                   \
+            continue;                                                \
+        if (colors)                                                  \
+            color = colors[i];                                       \
+        row = pixels + y * pitch;                                    \
+        stmt;                                                        \
+    }
+
+    switch (format->BytesPerPixel) {
+
+    case 1:
+        SET_AT_MANY (row[x] = (Uint8) color);
+        break;
+    case 2:
+        SET_AT_MANY (((Uint16 *) row)[x] = (Uint16) color);
+        break;
+    case 3:
+        SET_AT_MANY ((byte_buf = row + x * 3,
+                      byte_buf[r] = (Uint8) (color >> 16),
+                      byte_buf[g] = (Uint8) (color >> 8),
+                      byte_buf[b] = (Uint8) color));
+        break;
+    default:                  /* case 4: */
+        SET_AT_MANY (((Uint32 *) row)[x] = color);
+        break;
+    }
+#undef SET_AT_MANY
+}
+
+static PyObject*
+surf_get_at_many (PyObject *self, PyObject *args)
+{
+    SDL_Surface *surf = PySurface_AsSurface (self);
+    PyObject *points_obj, *mapped_obj = Py_None;
+    PyObject *ret = NULL, *value;
+    Pg_buffer points_view, mapped_view;
+    Uint32 *mapped;
+    Py_ssize_t n, i, done;
+
+    if (!PyArg_ParseTuple (args, "O|O", &points_obj, &mapped_obj))
+        return NULL;
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+
+    if (surf->flags & SDL_OPENGL)
+        return RAISE (PyExc_SDLError, "Cannot call on OPENGL Surfaces");
+
+    if (surf->format->BytesPerPixel < 1 || surf->format->BytesPerPixel > 4)
+        return RAISE (PyExc_RuntimeError, "invalid color depth for surface");
+
+    if (surface_int_view (points_obj, &points_view, PyBUF_SIMPLE, "points"))
+        return NULL;
+    n = points_view.view.len / 8;
+    if (points_view.view.len % 8) {
+        PgBuffer_Release (&points_view);
+        return RAISE (PyExc_ValueError, "points must hold x, y pairs");
+    }
+
+    if (mapped_obj != Py_None) {
+        if (surface_int_view (mapped_obj, &mapped_view, PyBUF_WRITABLE,
+                              "mapped")) {
+            PgBuffer_Release (&points_view);
+            return NULL;
+        }
+        if (mapped_view.view.len / 4 < n) {
+            PgBuffer_Release (&mapped_view);
+            PgBuffer_Release (&points_view);
+            return RAISE (PyExc_ValueError,
+                          "mapped has fewer items than there are points");
+        }
+        mapped = (Uint32 *) mapped_view.view.buf;
+    }
+    else {
+        mapped = PyMem_New (Uint32, n ? n : 1);
+        if (!mapped) {
+            PgBuffer_Release (&points_view);
+            return PyErr_NoMemory ();
+        }
+    }
+
+    if (!PySurface_Lock (self))
+        goto end;
+    done = surface_get_many (surf, (Sint32 *) points_view.view.buf, mapped,
+                             n);
+    if (!PySurface_Unlock (self))
+        goto end;
+    if (done < n) {
+        PyErr_Format (PyExc_IndexError, "pixel index out of range: point %ld",
+                      (long) done);
+        goto end;
+    }
+
+    if (mapped_obj != Py_None) {
+        Py_INCREF (mapped_obj);
+        ret = mapped_obj;
+        goto end;
+    }
+    ret = PyList_New (n);
+    if (!ret)
+        goto end;
+    for (i = 0; i < n; i++) {
+        value = PyInt_FromLong ((long) (Sint32) mapped[i]);
+        if (!value) {
+            Py_CLEAR (ret);
+            goto end;
+        }
+        PyList_SET_ITEM (ret, i, value);
+    }
+
+end:
+    if (mapped_obj != Py_None)
+        PgBuffer_Release (&mapped_view);
+    else
+        PyMem_Free (mapped);
+    PgBuffer_Release (&points_view);
+    return ret;
+}
+
+static PyObject*
+surf_set_at_many (PyObject *self, PyObject *args)
+{
+    SDL_Surface *surf = PySurface_AsSurface (self);
+    PyObject *points_obj, *colors_obj;
+    Pg_buffer points_view, colors_view;
+    Uint32 *colors = NULL;
+    Uint32 color = 0;
+    Uint8 rgba[4] = {0, 0, 0, 0 };
+    Py_ssize_t n;
+    int result;
+
+    if (!PyArg_ParseTuple (args, "OO", &points_obj, &colors_obj))
+        return NULL;
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+
+    if (surf->flags & SDL_OPENGL)
+        return RAISE (PyExc_SDLError, "Cannot call on OPENGL Surfaces");
+
+    if (surf->format->BytesPerPixel < 1 || surf->format->BytesPerPixel > 4)
+        return RAISE (PyExc_RuntimeError, "invalid color depth for surface");
+
+    /* one color for all the points, or a buffer of mapped colors */
+    if (PyInt_Check (colors_obj)) {
+        color = (Uint32) PyInt_AsLong (colors_obj);
+        if (PyErr_Occurred () && (Sint32) color == -1)
+            return RAISE (PyExc_TypeError, "invalid color argument");
+    }
+    else if (PyLong_Check (colors_obj)) {
+        color = (Uint32) PyLong_AsUnsignedLong (colors_obj);
+        if (PyErr_Occurred () && (Sint32) color == -1)
+            return RAISE (PyExc_TypeError, "invalid color argument");
+    }
+    else if (PyColor_Check (colors_obj) || PyTuple_Check (colors_obj)) {
+        if (!RGBAFromColorObj (colors_obj, rgba))
+            return RAISE (PyExc_TypeError, "invalid color argument");
+        color = SDL_MapRGBA (surf->format, rgba[0], rgba[1], rgba[2],
+                             rgba[3]);
+    }
+    else if (surface_int_view (colors_obj, &colors_view, PyBUF_SIMPLE,
+                               "colors")) {
+        return NULL;
+    }
+    else {
+        colors = (Uint32 *) colors_view.view.buf;
+    }
+
+    if (surface_int_view (points_obj, &points_view, PyBUF_SIMPLE, "points")) {
+        if (colors)
+            PgBuffer_Release (&colors_view);
+        return NULL;
+    }
+    n = points_view.view.len / 8;
+    if (points_view.view.len % 8) {
+        PyErr_SetString (PyExc_ValueError, "points must hold x, y pairs");
+        result = -1;
+    }
+    else if (colors && colors_view.view.len / 4 < n) {
+        PyErr_SetString (PyExc_ValueError,
+                         "colors has fewer items than there are points");
+        result = -1;
+    }
+    else if (!PySurface_Lock (self)) {
+        result = -1;
+    }
+    else {
+        surface_set_many (surf, (Sint32 *) points_view.view.buf, colors,
+                          color, n);
+        if (colors || !surface_color_is_premul (surf->format, color))
+            surface_unmark_premul (self);
+        result = PySurface_Unlock (self) ? 0 : -1;
+    }
+
+    if (colors)
+        PgBuffer_Release (&colors_view);
+    PgBuffer_Release (&points_view);
+    if (result == -1)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
 static PyObject*
 surf_map_rgb (PyObject *self, PyObject *args)
 {
@@ -841,7 +1268,8 @@ surf_get_locked (PyObject *self)
 {
     PySurfaceObject *surf = (PySurfaceObject *) self;
 
-    if (surf->locklist && PyList_Size (surf->locklist) > 0)
+    if (surf->selflocks > 0 ||
+        (surf->locklist && PyList_Size (surf->locklist) > 0))
         Py_RETURN_TRUE;
     Py_RETURN_FALSE;
 }
@@ -850,20 +1278,24 @@ static PyObject*
 surf_get_locks (PyObject *self)
 {
     PySurfaceObject *surf = (PySurfaceObject *) self;
-    Py_ssize_t len, i = 0;
+    Py_ssize_t len = 0, i = 0;
     PyObject *tuple, *tmp;
-    if (!surf->locklist)
-        return PyTuple_New (0);
 
-    len = PyList_Size (surf->locklist);
-    tuple = PyTuple_New (len);
+    if (surf->locklist)
+        len = PyList_Size (surf->locklist);
+    tuple = PyTuple_New (surf->selflocks + len);
     if (!tuple)
         return NULL;
 
+    /* The locks of the Surface itself are counted, not listed */
+    for (i = 0; i < surf->selflocks; i++) {
+        Py_INCREF (self);
+        PyTuple_SET_ITEM (tuple, i, self);
+    }
     for (i = 0; i < len; i++) {
         tmp = PyWeakref_GetObject (PyList_GetItem (surf->locklist, i));
         Py_INCREF (tmp);
-        PyTuple_SetItem (tuple, i, tmp);
+        PyTuple_SET_ITEM (tuple, surf->selflocks + i, tmp);
     }
     return tuple;
 }
@@ -985,6 +1417,8 @@ surf_set_palette (PyObject *self, PyObject *args)
         colors[i].b = (unsigned char) rgba[2];
     }
 
+    /* The display format twin has the old colors */
+    PySurface_DropRLE (self);
     SDL_SetColors (surf, colors, 0, len);
     free (colors);
     Py_RETURN_NONE;
@@ -1028,6 +1462,7 @@ surf_set_palette_at (PyObject *self, PyObject *args)
     color.g = rgba[1];
     color.b = rgba[2];
 
+    PySurface_DropRLE (self);
     SDL_SetColors (surf, &color, _index, 1);
 
     Py_RETURN_NONE;
@@ -1072,6 +1507,12 @@ surf_set_colorkey (PyObject *self, PyObject *args)
     if (hascolor)
         flags |= SDL_SRCCOLORKEY;
 
+    /* SDL may free the pixels of RLE Surfaces, so they are not shared
+       or compressed */
+    if (flags & SDL_RLEACCEL) {
+        pygame_PackDrop ((PySurfaceObject *) self);
+        PySurface_Unshare (self);
+    }
     PySurface_Prep (self);
     result = SDL_SetColorKey (surf, flags, color);
     PySurface_Unprep (self);
@@ -1142,6 +1583,10 @@ surf_set_alpha (PyObject *self, PyObject *args)
     else
         alpha = (Uint8) alphaval;
 
+    if (flags & SDL_RLEACCEL) {
+        pygame_PackDrop ((PySurfaceObject *) self);
+        PySurface_Unshare (self);
+    }
     PySurface_Prep (self);
     result = SDL_SetAlpha (surf, flags, alpha);
     PySurface_Unprep (self);
@@ -1181,16 +1626,77 @@ surf_copy (PyObject *self)
     if (surf->flags & SDL_OPENGL)
         return RAISE (PyExc_SDLError, "Cannot copy opengl display");
 
+    if (pygame_CowCanShare ((PySurfaceObject *) self)) {
+        /* the copy shares the pixels until either Surface changes */
+        newsurf = pygame_CowSurface (surf);
+        final = surf_subtype_new (Py_TYPE (self), newsurf);
+        if (!final) {
+            pygame_PoolFreeSurface (newsurf);
+            return NULL;
+        }
+        if (pygame_CowShare ((PySurfaceObject *) self,
+                             (PySurfaceObject *) final))
+            memcpy (newsurf->pixels, surf->pixels,
+                    (size_t) surf->pitch * surf->h);
+    }
+    else {
+        PySurface_Prep (self);
+        newsurf = pygame_PoolCopySurface (surf);
+        PySurface_Unprep (self);
+
+        final = surf_subtype_new (Py_TYPE (self), newsurf);
+        if (!final) {
+            pygame_PoolFreeSurface (newsurf);
+            return NULL;
+        }
+    }
+    ((PySurfaceObject *) final)->premultiplied =
+        ((PySurfaceObject *) self)->premultiplied;
+    return final;
+}
+
+static PyObject*
+surf_premul_alpha (PyObject *self)
+{
+    SDL_Surface *surf = PySurface_AsSurface (self);
+    PyObject *final;
+    SDL_Surface *newsurf;
+
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    if (!surf->format->Amask ||
+        (surf->format->BytesPerPixel != 2 && surf->format->BytesPerPixel != 4))
+        return RAISE (PyExc_ValueError,
+                      "Only 16 or 32 bit surfaces with per-pixel alpha can "
+                      "be premultiplied");
+
     PySurface_Prep (self);
-    newsurf = SDL_ConvertSurface (surf, surf->format, surf->flags);
+    newsurf = pygame_PoolCopySurface (surf);
     PySurface_Unprep (self);
+    if (!newsurf)
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+
+    /* Premultiplying twice would darken the colours again */
+    if (!((PySurfaceObject *) self)->premultiplied &&
+        pygame_PremulAlpha (newsurf)) {
+        pygame_PoolFreeSurface (newsurf);
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    }
 
     final = surf_subtype_new (Py_TYPE (self), newsurf);
     if (!final)
-        SDL_FreeSurface (newsurf);
+        pygame_PoolFreeSurface (newsurf);
+    else
+        ((PySurfaceObject *) final)->premultiplied = 1;
     return final;
 }
 
+static PyObject*
+surf_get_premul_alpha (PyObject *self)
+{
+    return PyBool_FromLong (((PySurfaceObject *) self)->premultiplied);
+}
+
 static PyObject*
 surf_convert (PyObject *self, PyObject *args)
 {
@@ -1217,7 +1723,9 @@ surf_convert (PyObject *self, PyObject *args)
             src = PySurface_AsSurface (argobject);
             flags = src->flags |
                 (surf->flags & (SDL_SRCCOLORKEY | SDL_SRCALPHA));
-            newsurf = SDL_ConvertSurface (surf, src->format, flags);
+            Py_BEGIN_ALLOW_THREADS;
+            newsurf = pygame_ConvertSurface (surf, src->format, flags);
+            Py_END_ALLOW_THREADS;
         }
         else {
             int bpp;
@@ -1326,20 +1834,25 @@ surf_convert (PyObject *self, PyObject *args)
                 flags = surf->flags;
             if (format.Amask)
                 flags |= SDL_SRCALPHA;
-            newsurf = SDL_ConvertSurface (surf, &format, flags);
+            Py_BEGIN_ALLOW_THREADS;
+            newsurf = pygame_ConvertSurface (surf, &format, flags);
+            Py_END_ALLOW_THREADS;
         }
     }
     else {
-        if (SDL_WasInit (SDL_INIT_VIDEO))
-            newsurf = SDL_DisplayFormat (surf);
+        if (SDL_WasInit (SDL_INIT_VIDEO)) {
+            Py_BEGIN_ALLOW_THREADS;
+            newsurf = pygame_DisplayFormat (surf);
+            Py_END_ALLOW_THREADS;
+        }
         else
-            newsurf = SDL_ConvertSurface (surf, surf->format, surf->flags);
+            newsurf = pygame_PoolCopySurface (surf);
     }
     PySurface_Unprep (self);
 
     final = surf_subtype_new (Py_TYPE (self), newsurf);
     if (!final)
-        SDL_FreeSurface (newsurf);
+        pygame_PoolFreeSurface (newsurf);
     return final;
 }
 
@@ -1365,15 +1878,18 @@ surf_convert_alpha (PyObject *self, PyObject *args)
          * support for alpha
          */
         src = PySurface_AsSurface (srcsurf);
-        newsurf = SDL_DisplayFormatAlpha (surf);
     }
-    else
-        newsurf = SDL_DisplayFormatAlpha (surf);
+    Py_BEGIN_ALLOW_THREADS;
+    newsurf = pygame_DisplayFormatAlpha (surf);
+    Py_END_ALLOW_THREADS;
     PySurface_Unprep (self);
 
     final = surf_subtype_new (Py_TYPE (self), newsurf);
     if (!final)
         SDL_FreeSurface (newsurf);
+    else
+        ((PySurfaceObject *) final)->premultiplied =
+            ((PySurfaceObject *) self)->premultiplied;
     return final;
 }
 
@@ -1425,6 +1941,66 @@ surf_get_clip (PyObject *self)
     return PyRect_New (&surf->clip_rect);
 }
 
+static PyObject*
+surf_track_damage (PyObject *self, PyObject *args)
+{
+    PySurfaceObject *surfobj = (PySurfaceObject *) self;
+    int enable = 1;
+
+    if (!PyArg_ParseTuple (args, "|i", &enable))
+        return NULL;
+
+    if (enable && !surfobj->damage) {
+        surfobj->damage = PyMem_New (PgDamage, 1);
+        if (!surfobj->damage)
+            return PyErr_NoMemory ();
+        surfobj->damage->n = 0;
+    }
+    else if (!enable && surfobj->damage) {
+        PyMem_Del (surfobj->damage);
+        surfobj->damage = NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+surf_get_auto_conversions (PyObject *self)
+{
+    return PyLong_FromUnsignedLong (((PySurfaceObject *) self)->conversions);
+}
+
+static PyObject*
+surf_get_damage (PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PgDamage *damage = ((PySurfaceObject *) self)->damage;
+    PyObject *list, *rect;
+    int clear = 1;
+    int i;
+    static char *kwids[] = {"clear", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, keywds, "|i", kwids, &clear))
+        return NULL;
+
+    if (!damage)
+        return PyList_New (0);
+
+    damage->n = damage_merge (damage->rects, damage->n);
+    list = PyList_New (damage->n);
+    if (!list)
+        return NULL;
+    for (i = 0; i < damage->n; ++i) {
+        rect = PyRect_New (&damage->rects[i]);
+        if (!rect) {
+            Py_DECREF (list);
+            return NULL;
+        }
+        PyList_SET_ITEM (list, i, rect);
+    }
+    if (clear)
+        damage->n = 0;
+    return list;
+}
+
 
 static PyObject*
 surf_fill (PyObject *self, PyObject *args, PyObject *keywds)
@@ -1438,6 +2014,7 @@ surf_fill (PyObject *self, PyObject *args, PyObject *keywds)
     Uint8 rgba[4];
     SDL_Rect sdlrect;
     int blendargs = 0;
+    Uint64 start;
 
     static char *kwids[] = {"color", "rect", "special_flags", NULL};
     if (!PyArg_ParseTupleAndKeywords (args, keywds, "O|Oi", kwids,
@@ -1445,6 +2022,7 @@ surf_fill (PyObject *self, PyObject *args, PyObject *keywds)
         return NULL;
     if (!surf)
         return RAISE (PyExc_SDLError, "display Surface quit");
+    PySurface_DropRLE (self);
 
     if (surf->flags & SDL_OPENGL)
         return RAISE (PyExc_SDLError, "Cannot call on OPENGL Surfaces");
@@ -1506,49 +2084,167 @@ surf_fill (PyObject *self, PyObject *args, PyObject *keywds)
         /* printf("%d, %d, %d, %d\n", sdlrect.x, sdlrect.y, sdlrect.w, sdlrect.h); */
 
 
+        /* a subsurface fill changes the pixels of its owner too */
+        PG_PERF_BEGIN (start);
+        PySurface_Prep (self);
         if (blendargs != 0) {
 
             /*
             printf ("Using blendargs: %d\n", blendargs);
             */
+            Py_BEGIN_ALLOW_THREADS;
             result = surface_fill_blend (surf, &sdlrect, color, blendargs);
+            Py_END_ALLOW_THREADS;
         }
         else {
-            PySurface_Prep (self);
-            result = SDL_FillRect (surf, &sdlrect, color);
-            PySurface_Unprep (self);
+            Py_BEGIN_ALLOW_THREADS;
+            result = surface_fill_simd (surf, &sdlrect, color);
+            if (result == -1)
+                result = SDL_FillRect (surf, &sdlrect, color);
+            Py_END_ALLOW_THREADS;
         }
+        PySurface_Unprep (self);
+        PG_PERF_ADD (PG_PERF_FILL_CALLS, 1);
         if (result == -1)
             return RAISE (PyExc_SDLError, SDL_GetError ());
+        PG_PERF_ADD (PG_PERF_FILL_PIXELS, sdlrect.w * sdlrect.h);
+        PG_PERF_END (start, PG_PERF_FILL_NS);
+        PySurface_AddDamage (self, &sdlrect);
+        /* blending in a color mixes straight alpha into the pixels */
+        if (blendargs != 0 || !surface_color_is_premul (surf->format, color))
+            surface_unmark_premul (self);
     }
     return PyRect_New (&sdlrect);
 }
 
-static PyObject*
-surf_blit (PyObject *self, PyObject *args, PyObject *keywds)
+/* Blit one source on to the surface self, leaving the affected area in
+ * dest_rect. Returns -1, with an exception set, on an error. The caller
+ * must already have checked the destination surface.
+ */
+/* pygame.surface.set_auto_convert: blits to the display go from a display
+ * format twin of the source, made at the first blit
+ */
+static int auto_convert = 0;
+static unsigned long auto_convert_conversions = 0;
+static unsigned long auto_convert_hits = 0;
+
+/* Does src need converting to blit quickly to the display */
+static int
+surface_needs_twin (SDL_Surface *src, SDL_PixelFormat *display)
 {
-    SDL_Surface *src, *dest = PySurface_AsSurface (self);
-    GAME_Rect *src_rect, temp;
-    PyObject *srcobject, *argpos, *argrect = NULL;
-    int dx, dy, result;
-    SDL_Rect dest_rect, sdlsrc_rect;
-    int sx, sy;
-    int the_args = 0;
+    SDL_PixelFormat *fmt = src->format;
+    Uint32 rmask;
+
+    if (fmt->Amask && src->flags & SDL_SRCALPHA) {
+        /* The format SDL_DisplayFormatAlpha converts to */
+        rmask = (display->BytesPerPixel == 4 && display->Rmask == 0xff) ?
+            0x000000ff : 0x00ff0000;
+        return !(fmt->BytesPerPixel == 4 && fmt->Rmask == rmask &&
+                 fmt->Gmask == 0x0000ff00 && fmt->Amask == 0xff000000);
+    }
+    return !(fmt->BitsPerPixel == display->BitsPerPixel &&
+             fmt->Rmask == display->Rmask && fmt->Gmask == display->Gmask &&
+             fmt->Bmask == display->Bmask);
+}
 
-    static char *kwids[] = {"source", "dest", "area", "special_flags", NULL};
-    if (!PyArg_ParseTupleAndKeywords (args, keywds, "O!O|Oi", kwids,
-                                      &PySurface_Type, &srcobject, &argpos,
-                                      &argrect, &the_args))
+/* The object to blit srcobj to dstobj from: srcobj itself, or for a blit to
+ * the display its display format twin, made now if srcobj has none that is
+ * up to date. Returns NULL with an exception set.
+ */
+static PyObject*
+surface_display_twin (PyObject *dstobj, PyObject *srcobj)
+{
+    PySurfaceObject *obj = (PySurfaceObject *) srcobj;
+    SDL_Surface *src = obj->surf;
+    SDL_Surface *display = SDL_GetVideoSurface ();
+    SDL_Surface *dst = PySurface_AsSurface (dstobj);
+    SDL_Surface *copy;
+    PgDisplayTwin *twin = obj->twin;
+    Uint32 flags = src->flags & (SDL_SRCCOLORKEY | SDL_SRCALPHA);
+
+    /* A subsurface may be changed through its owner unseen */
+    while (((PySurfaceObject *) dstobj)->subsurface) {
+        dstobj = ((PySurfaceObject *) dstobj)->subsurface->owner;
+        dst = PySurface_AsSurface (dstobj);
+    }
+    if (!display || dst != display || obj->subsurface ||
+        display->flags & SDL_OPENGL || srcobj == dstobj)
+        return srcobj;
+
+    if (twin && twin->flags == flags &&
+        twin->colorkey == src->format->colorkey &&
+        twin->alpha == src->format->alpha &&
+        twin->display_bpp == display->format->BitsPerPixel &&
+        twin->display_rmask == display->format->Rmask &&
+        twin->display_gmask == display->format->Gmask &&
+        twin->display_bmask == display->format->Bmask) {
+        auto_convert_hits++;
+        return twin->surface;
+    }
+    if (twin) {
+        Py_DECREF (twin->surface);
+        PyMem_Del (twin);
+        obj->twin = NULL;
+    }
+    if (!surface_needs_twin (src, display->format))
+        return srcobj;
+
+    twin = PyMem_New (PgDisplayTwin, 1);
+    if (!twin) {
+        PyErr_NoMemory ();
+        return NULL;
+    }
+    PySurface_Prep (srcobj);
+    if (src->format->Amask && src->flags & SDL_SRCALPHA)
+        copy = pygame_DisplayFormatAlpha (src);
+    else
+        copy = pygame_DisplayFormat (src);
+    PySurface_Unprep (srcobj);
+    if (!copy) {
+        PyMem_Del (twin);
+        RAISE (PyExc_SDLError, SDL_GetError ());
+        return NULL;
+    }
+    twin->surface = PySurface_New (copy);
+    if (!twin->surface) {
+        SDL_FreeSurface (copy);
+        PyMem_Del (twin);
         return NULL;
+    }
+    ((PySurfaceObject *) twin->surface)->premultiplied = obj->premultiplied;
+    twin->flags = flags;
+    twin->colorkey = src->format->colorkey;
+    twin->alpha = src->format->alpha;
+    twin->display_bpp = display->format->BitsPerPixel;
+    twin->display_rmask = display->format->Rmask;
+    twin->display_gmask = display->format->Gmask;
+    twin->display_bmask = display->format->Bmask;
+    obj->twin = twin;
+    obj->conversions++;
+    auto_convert_conversions++;
+    return twin->surface;
+}
 
-    src = PySurface_AsSurface (srcobject);
-    if (!dest || !src)
-        return RAISE (PyExc_SDLError, "display Surface quit");
+static int
+surf_blit_one (PyObject *self, PyObject *srcobject, PyObject *argpos,
+               PyObject *argrect, int the_args, SDL_Rect *dest_rect)
+{
+    PySurfaceRegionObject *region = NULL;
+    SDL_Surface *src;
+    GAME_Rect *src_rect, temp;
+    int dx, dy;
+    SDL_Rect sdlsrc_rect;
+    int sx, sy, x0, y0, x1, y1;
 
-    if (dest->flags & SDL_OPENGL &&
-        !(dest->flags & (SDL_OPENGLBLIT & ~SDL_OPENGL)))
-        return RAISE (PyExc_SDLError,
-                      "Cannot blit to OPENGL Surfaces (OPENGLBLIT is ok)");
+    if (PySurfaceRegion_Check (srcobject)) {
+        region = (PySurfaceRegionObject *) srcobject;
+        srcobject = region->parent;
+    }
+    src = PySurface_AsSurface (srcobject);
+    if (!src) {
+        RAISE (PyExc_SDLError, "display Surface quit");
+        return -1;
+    }
 
     if ((src_rect = GameRect_FromObject (argpos, &temp))) {
         dx = src_rect->x;
@@ -1558,53 +2254,252 @@ surf_blit (PyObject *self, PyObject *args, PyObject *keywds)
         dx = sx;
         dy = sy;
     }
-    else
-        return RAISE (PyExc_TypeError, "invalid destination position for blit");
+    else {
+        RAISE (PyExc_TypeError, "invalid destination position for blit");
+        return -1;
+    }
 
     if (argrect && argrect != Py_None) {
-        if (!(src_rect = GameRect_FromObject (argrect, &temp)))
-            return RAISE (PyExc_TypeError, "Invalid rectstyle argument");
+        if (!(src_rect = GameRect_FromObject (argrect, &temp))) {
+            RAISE (PyExc_TypeError, "Invalid rectstyle argument");
+            return -1;
+        }
     }
     else {
         temp.x = temp.y = 0;
-        temp.w = src->w;
-        temp.h = src->h;
+        temp.w = region ? region->rect.w : src->w;
+        temp.h = region ? region->rect.h : src->h;
+        src_rect = &temp;
+    }
+
+    if (region) {
+        /* Clip the area to the region the way SDL clips it to a Surface,
+         * moving the destination by what is cut from the top left, then
+         * move it into the parent. src_rect may be a Rect argument, so it
+         * is left as it is.
+         */
+        x0 = MAX (src_rect->x, 0);
+        y0 = MAX (src_rect->y, 0);
+        x1 = MIN (src_rect->x + src_rect->w, region->rect.w);
+        y1 = MIN (src_rect->y + src_rect->h, region->rect.h);
+        dx += x0 - src_rect->x;
+        dy += y0 - src_rect->y;
+        temp.x = region->rect.x + x0;
+        temp.y = region->rect.y + y0;
+        temp.w = MAX (x1 - x0, 0);
+        temp.h = MAX (y1 - y0, 0);
         src_rect = &temp;
     }
 
-    dest_rect.x = (short) dx;
-    dest_rect.y = (short) dy;
-    dest_rect.w = (unsigned short) src_rect->w;
-    dest_rect.h = (unsigned short) src_rect->h;
+    dest_rect->x = (short) dx;
+    dest_rect->y = (short) dy;
+    dest_rect->w = (unsigned short) src_rect->w;
+    dest_rect->h = (unsigned short) src_rect->h;
     sdlsrc_rect.x = (short) src_rect->x;
     sdlsrc_rect.y = (short) src_rect->y;
     sdlsrc_rect.w = (unsigned short) src_rect->w;
     sdlsrc_rect.h = (unsigned short) src_rect->h;
 
-    if (!the_args)
-        the_args = 0;
-
-    result = PySurface_Blit (self, srcobject, &dest_rect, &sdlsrc_rect,
-                             the_args);
-    if (result != 0)
-        return NULL;
+    if (auto_convert && !the_args)
+        srcobject = surface_display_twin (self, srcobject);
+    if (!srcobject ||
+        PySurface_Blit (self, srcobject, dest_rect, &sdlsrc_rect, the_args))
+        return -1;
+    return 0;
+}
+
+/* Returns -1, with an exception set, if self can not be blitted to. */
+static int
+surf_check_blit_dest (SDL_Surface *dest)
+{
+    if (!dest) {
+        RAISE (PyExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    if (dest->flags & SDL_OPENGL &&
+        !(dest->flags & (SDL_OPENGLBLIT & ~SDL_OPENGL))) {
+        RAISE (PyExc_SDLError,
+               "Cannot blit to OPENGL Surfaces (OPENGLBLIT is ok)");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject*
+surf_blit (PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *srcobject, *argpos, *argrect = NULL;
+    SDL_Rect dest_rect;
+    int the_args = 0;
+
+    static char *kwids[] = {"source", "dest", "area", "special_flags", NULL};
+    if (!PyArg_ParseTupleAndKeywords (args, keywds, "OO|Oi", kwids,
+                                      &srcobject, &argpos,
+                                      &argrect, &the_args))
+        return NULL;
+    if (!PyObject_TypeCheck (srcobject, &PySurface_Type) &&
+        !PySurfaceRegion_Check (srcobject))
+        return RAISE (PyExc_TypeError,
+                      "source must be a Surface or SurfaceRegion");
+
+    if (surf_check_blit_dest (PySurface_AsSurface (self)) ||
+        surf_blit_one (self, srcobject, argpos, argrect, the_args,
+                       &dest_rect))
+        return NULL;
 
     return PyRect_New (&dest_rect);
 }
 
+static PyObject*
+surf_blits (PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *blitsequence, *iterator, *item, *fast;
+    PyObject *srcobject, *argrect, *retrect;
+    PyObject *ret = NULL;
+    SDL_Rect dest_rect;
+    Py_ssize_t itemlength;
+    int doreturn = 1;
+    int the_args;
+
+    static char *kwids[] = {"blit_sequence", "doreturn", NULL};
+    if (!PyArg_ParseTupleAndKeywords (args, keywds, "O|i", kwids,
+                                      &blitsequence, &doreturn))
+        return NULL;
+
+    if (surf_check_blit_dest (PySurface_AsSurface (self)))
+        return NULL;
+
+    iterator = PyObject_GetIter (blitsequence);
+    if (!iterator)
+        return NULL;
+    if (doreturn) {
+        ret = PyList_New (0);
+        if (!ret)
+            goto fail;
+    }
+
+    while ((item = PyIter_Next (iterator))) {
+        fast = PySequence_Fast (item, "blits item must be a sequence of "
+                                "(source, dest[, area[, special_flags]])");
+        Py_DECREF (item);
+        if (!fast)
+            goto fail;
+
+        itemlength = PySequence_Fast_GET_SIZE (fast);
+        if (itemlength < 2 || itemlength > 4) {
+            Py_DECREF (fast);
+            RAISE (PyExc_ValueError, "blits item must be a sequence of "
+                   "(source, dest[, area[, special_flags]])");
+            goto fail;
+        }
+        srcobject = PySequence_Fast_GET_ITEM (fast, 0);
+        if (!PyObject_TypeCheck (srcobject, &PySurface_Type) &&
+            !PySurfaceRegion_Check (srcobject)) {
+            Py_DECREF (fast);
+            RAISE (PyExc_TypeError,
+                   "blits source must be a Surface or SurfaceRegion");
+            goto fail;
+        }
+        argrect = itemlength > 2 ? PySequence_Fast_GET_ITEM (fast, 2) : NULL;
+        the_args = 0;
+        if (itemlength > 3 &&
+            !IntFromObj (PySequence_Fast_GET_ITEM (fast, 3), &the_args)) {
+            Py_DECREF (fast);
+            RAISE (PyExc_TypeError, "blits special_flags must be an integer");
+            goto fail;
+        }
+
+        if (surf_blit_one (self, srcobject, PySequence_Fast_GET_ITEM (fast, 1),
+                           argrect, the_args, &dest_rect)) {
+            Py_DECREF (fast);
+            goto fail;
+        }
+        Py_DECREF (fast);
+
+        if (doreturn) {
+            retrect = PyRect_New (&dest_rect);
+            if (!retrect || PyList_Append (ret, retrect)) {
+                Py_XDECREF (retrect);
+                goto fail;
+            }
+            Py_DECREF (retrect);
+        }
+    }
+    if (PyErr_Occurred ())
+        goto fail;
+    Py_DECREF (iterator);
+
+    if (doreturn)
+        return ret;
+    Py_RETURN_NONE;
+
+fail:
+    Py_DECREF (iterator);
+    Py_XDECREF (ret);
+    return NULL;
+}
+
+/* The areas of the clip rect that a scroll by dx, dy leaves behind, which
+ * keep their old pixels. There are none for no scroll, the whole clip
+ * rect for a scroll by as much, and otherwise a strip of rows and a strip
+ * of columns beside it.
+ */
+static PyObject*
+surface_scroll_exposed (SDL_Rect *clip, int dx, int dy)
+{
+    PyObject *list = PyList_New (0);
+    PyObject *rect;
+    SDL_Rect rects[2];
+    int i, count = 0;
+
+    if (!list) {
+        return NULL;
+    }
+    if (dx >= clip->w || dx <= -clip->w || dy >= clip->h || dy <= -clip->h) {
+        rects[count++] = *clip;
+    }
+    else {
+        if (dy) {
+            rects[count].x = clip->x;
+            rects[count].y = dy > 0 ? clip->y : clip->y + clip->h + dy;
+            rects[count].w = clip->w;
+            rects[count++].h = dy > 0 ? dy : -dy;
+        }
+        if (dx) {
+            rects[count].x = dx > 0 ? clip->x : clip->x + clip->w + dx;
+            rects[count].y = dy > 0 ? clip->y + dy : clip->y;
+            rects[count].w = dx > 0 ? dx : -dx;
+            rects[count++].h = clip->h - (dy > 0 ? dy : -dy);
+        }
+    }
+    for (i = 0; i < count; i++) {
+        rect = PyRect_New (&rects[i]);
+        if (!rect || PyList_Append (list, rect)) {
+            Py_XDECREF (rect);
+            Py_DECREF (list);
+            return NULL;
+        }
+        Py_DECREF (rect);
+    }
+    return list;
+}
+
 static PyObject*
 surf_scroll (PyObject *self, PyObject *args, PyObject *keywds)
 {
     int dx = 0, dy = 0;
+    int exposed = 0;
     SDL_Surface *surf;
     int bpp;
     int pitch;
     SDL_Rect *clip_rect;
+    SDL_Rect moved;
     int w, h;
     Uint8 *src, *dst;
 
-    static char *kwids[] = {"dx", "dy", NULL};
-    if (!PyArg_ParseTupleAndKeywords (args, keywds, "|ii", kwids, &dx, &dy)) {
+    static char *kwids[] = {"dx", "dy", "exposed", NULL};
+    if (!PyArg_ParseTupleAndKeywords (args, keywds, "|iii", kwids,
+                                      &dx, &dy, &exposed)) {
         return NULL;
     }
 
@@ -1619,14 +2514,14 @@ surf_scroll (PyObject *self, PyObject *args, PyObject *keywds)
                       "Cannot scroll an OPENGL Surfaces (OPENGLBLIT is ok)");
     }
 
-    if (dx == 0 && dy == 0) {
-        Py_RETURN_NONE;
-    }
-
     clip_rect = &surf->clip_rect;
     w = clip_rect->w;
     h = clip_rect->h;
-    if (dx >= w || dx <= -w || dy >= h || dy <= -h) {
+    if ((dx == 0 && dy == 0) ||
+        dx >= w || dx <= -w || dy >= h || dy <= -h) {
+        if (exposed) {
+            return surface_scroll_exposed (clip_rect, dx, dy);
+        }
         Py_RETURN_NONE;
     }
 
@@ -1667,7 +2562,15 @@ surf_scroll (PyObject *self, PyObject *args, PyObject *keywds)
     if (!PySurface_Unlock (self)) {
         return NULL;
     }
+    moved.x = clip_rect->x + (dx > 0 ? dx : 0);
+    moved.y = clip_rect->y + (dy > 0 ? dy : 0);
+    moved.w = w;
+    moved.h = h;
+    PySurface_AddDamage (self, &moved);
 
+    if (exposed) {
+        return surface_scroll_exposed (clip_rect, dx, dy);
+    }
     Py_RETURN_NONE;
 }
 
@@ -1691,6 +2594,47 @@ surf_get_pitch (PyObject *self)
     return PyInt_FromLong (surf->pitch);
 }
 
+static PyObject*
+surf_get_row_alignment (PyObject *self)
+{
+    SDL_Surface *surf = PySurface_AsSurface (self);
+
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    return PyInt_FromLong (pygame_PoolRowAlign (surf));
+}
+
+static PyObject*
+surf_compress (PyObject *self)
+{
+    size_t size;
+
+    if (!PySurface_AsSurface (self))
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    switch (pygame_PackSurface ((PySurfaceObject *) self, &size)) {
+    case -1:
+        return RAISE (PyExc_ValueError, SDL_GetError ());
+    case -2:
+        return PyErr_NoMemory ();
+    }
+    return PyInt_FromSsize_t ((Py_ssize_t) size);
+}
+
+static PyObject*
+surf_decompress (PyObject *self)
+{
+    if (!PySurface_AsSurface (self))
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    pygame_PackDrop ((PySurfaceObject *) self);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+surf_get_compressed (PyObject *self)
+{
+    return PyBool_FromLong (((PySurfaceObject *) self)->packed != NULL);
+}
+
 static PyObject*
 surf_get_size (PyObject *self)
 {
@@ -1883,6 +2827,9 @@ surf_subsurface (PyObject *self, PyObject *args)
         return RAISE (PyExc_ValueError,
                       "subsurface rectangle outside surface area");
 
+    /* sub points into the pixels, which a lazy copy would move to pixels
+       of its own as it is changed, so it gets them first */
+    PySurface_Unshare (self);
     PySurface_Lock (self);
 
     pixeloffset = rect->x * format->BytesPerPixel + rect->y * surf->pitch;
@@ -1919,10 +2866,14 @@ surf_subsurface (PyObject *self, PyObject *args)
     }
     Py_INCREF (self);
     data->owner = self;
+    /* the pixels of self must stay where they are while sub points there */
+    ((PySurfaceObject *) self)->subsurfaces++;
     data->pixeloffset = pixeloffset;
     data->offsetx = rect->x;
     data->offsety = rect->y;
     ((PySurfaceObject *) subobj)->subsurface = data;
+    ((PySurfaceObject *) subobj)->premultiplied =
+        ((PySurfaceObject *) self)->premultiplied;
 
     return subobj;
 }
@@ -2025,6 +2976,8 @@ surf_get_bounding_rect (PyObject *self, PyObject *args, PyObject *kwargs)
     Uint8 r, g, b, a;
     int has_colorkey = 0;
     Uint8 keyr, keyg, keyb;
+    SDL_Rect bounds;
+    int result;
 
     char *kwids[] = { "min_alpha", NULL };
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwids, &min_alpha))
@@ -2044,11 +2997,23 @@ surf_get_bounding_rect (PyObject *self, PyObject *args, PyObject *kwargs)
                      &keyr, &keyg, &keyb, &a);
     }
 
+    /* 32 bit pixels with an alpha channel are scanned a row at a time */
+    Py_BEGIN_ALLOW_THREADS;
+    result = pygame_AlphaBounds (surf, min_alpha, &bounds);
+    Py_END_ALLOW_THREADS;
+    if (result == 0) {
+        if (!PySurface_Unlock (self))
+            return RAISE (PyExc_SDLError, "could not unlock surface");
+        return PyRect_New (&bounds);
+    }
+
     pixels = (Uint8 *) surf->pixels;
     if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
         pixels += format->BytesPerPixel - sizeof (Uint32);
     }
 
+    Py_BEGIN_ALLOW_THREADS;
+
     min_y = 0;
     min_x = 0;
     max_x = surf->w;
@@ -2186,6 +3151,7 @@ surf_get_bounding_rect (PyObject *self, PyObject *args, PyObject *kwargs)
             break;
         }
     }
+    Py_END_ALLOW_THREADS;
     if (!PySurface_Unlock (self))
         return RAISE (PyExc_SDLError, "could not unlock surface");
 
@@ -2243,15 +3209,20 @@ _raise_get_view_ndim_error(int bitsize, SurfViewKind kind) {
 }
 
 static PyObject*
-surf_get_view (PyObject *self, PyObject *args)
+surf_get_view (PyObject *self, PyObject *args, PyObject *kwds)
 {
     SDL_Surface *surface = PySurface_AsSurface (self);
     SDL_PixelFormat *format;
     Uint32 mask = 0;
     SurfViewKind view_kind = VIEWKIND_2D;
     getbufferproc get_buffer = 0;
+    PyObject *rectobj = Py_None;
+    GAME_Rect *rect = 0, temp;
+    PyObject *proxy_obj;
+    char *kwids[] = {"kind", "rect", NULL};
 
-    if (!PyArg_ParseTuple (args, "|O&", _view_kind, &view_kind)) {
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|O&O", kwids,
+                                      _view_kind, &view_kind, &rectobj)) {
         return 0;
     }
 
@@ -2259,6 +3230,22 @@ surf_get_view (PyObject *self, PyObject *args)
         return RAISE (PyExc_SDLError, "display Surface quit");
     }
 
+    if (rectobj != Py_None) {
+        if (!(rect = GameRect_FromObject (rectobj, &temp))) {
+            return RAISE (PyExc_TypeError, "invalid rect argument");
+        }
+        if (rect->x < 0 || rect->y < 0 || rect->w < 0 || rect->h < 0 ||
+            rect->x + rect->w > surface->w ||
+            rect->y + rect->h > surface->h) {
+            return RAISE (PyExc_ValueError, "rect outside Surface");
+        }
+        if (view_kind == VIEWKIND_0D || view_kind == VIEWKIND_1D) {
+            return RAISE (PyExc_ValueError,
+                          "a rect view must be of kind '2', '3', "
+                          "'r', 'g', 'b' or 'a'");
+        }
+    }
+
     format = surface->format;
     switch (view_kind) {
         /* This switch statement is exhaustive over the SurfViewKind enum */
@@ -2351,7 +3338,43 @@ surf_get_view (PyObject *self, PyObject *args)
 #endif
     }
     assert (get_buffer);
-    return PgBufproxy_New (self, get_buffer);
+    if (!rect) {
+        return PgBufproxy_New (self, get_buffer);
+    }
+
+    /* The rect is kept by the proxy, for _get_buffer_rect to find when it
+     * is the consumer of the view.
+     */
+    if (get_buffer == _get_buffer_2D) {
+        get_buffer = _get_buffer_rect_2D;
+    }
+    else if (get_buffer == _get_buffer_3D) {
+        get_buffer = _get_buffer_rect_3D;
+    }
+    else if (get_buffer == _get_buffer_red) {
+        get_buffer = _get_buffer_rect_red;
+    }
+    else if (get_buffer == _get_buffer_green) {
+        get_buffer = _get_buffer_rect_green;
+    }
+    else if (get_buffer == _get_buffer_blue) {
+        get_buffer = _get_buffer_rect_blue;
+    }
+    else {
+        get_buffer = _get_buffer_rect_alpha;
+    }
+    proxy_obj = PgBufproxy_New (self, get_buffer);
+    if (!proxy_obj) {
+        return 0;
+    }
+    rectobj = PyRect_New4 (rect->x, rect->y, rect->w, rect->h);
+    if (!rectobj || PyObject_SetAttrString (proxy_obj, "rect", rectobj)) {
+        Py_XDECREF (rectobj);
+        Py_DECREF (proxy_obj);
+        return 0;
+    }
+    Py_DECREF (rectobj);
+    return proxy_obj;
 }
 
 static PyObject*
@@ -2374,6 +3397,40 @@ surf_get_buffer (PyObject *self)
     return proxy_obj;
 }
 
+static PyObject *
+surf_begin_frame (PyObject *self)
+{
+    PgSharedPixels *shared = ((PySurfaceObject *) self)->shared;
+
+    if (!shared)
+        return RAISE (PyExc_SDLError, "Surface is not in shared memory");
+    if (pygame_SharedBeginFrame (shared))
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_end_frame (PyObject *self)
+{
+    PgSharedPixels *shared = ((PySurfaceObject *) self)->shared;
+
+    if (!shared)
+        return RAISE (PyExc_SDLError, "Surface is not in shared memory");
+    if (pygame_SharedEndFrame (shared))
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_frame (PyObject *self)
+{
+    PgSharedPixels *shared = ((PySurfaceObject *) self)->shared;
+
+    if (!shared)
+        return RAISE (PyExc_SDLError, "Surface is not in shared memory");
+    return PyLong_FromUnsignedLong (pygame_SharedGetFrame (shared));
+}
+
 static int
 _get_buffer_0D (PyObject *obj, Py_buffer *view_p, int flags)
 {
@@ -2722,6 +3779,99 @@ _get_buffer_colorplane (PyObject *obj,
     return 0;
 }
 
+/* A view of the rect attribute of the consumer, a BufferProxy made by
+ * get_view, taken from the Surface view get_buffer gives. The rect is
+ * checked again here as it can be replaced.
+ */
+static int
+_get_buffer_rect (PyObject *obj, Py_buffer *view_p, int flags,
+                  getbufferproc get_buffer)
+{
+    SDL_Surface *surface = PySurface_AsSurface (obj);
+    PyObject *consumer = ((Pg_buffer *)view_p)->consumer;
+    PyObject *rectobj;
+    GAME_Rect *rect, temp;
+    Py_ssize_t ncomponents;
+
+    view_p->obj = 0;
+    rectobj = PyObject_GetAttrString (consumer, "rect");
+    if (!rectobj) {
+        return -1;
+    }
+    rect = GameRect_FromObject (rectobj, &temp);
+    Py_DECREF (rectobj);
+    if (!rect) {
+        PyErr_SetString (PgExc_BufferError, "invalid surface view rect");
+        return -1;
+    }
+    if (rect->x < 0 || rect->y < 0 || rect->w < 0 || rect->h < 0 ||
+        rect->x + rect->w > surface->w || rect->y + rect->h > surface->h) {
+        PyErr_SetString (PgExc_BufferError,
+                         "surface view rect outside Surface");
+        return -1;
+    }
+    if (!PyBUF_HAS_FLAG (flags, PyBUF_STRIDES)) {
+        PyErr_SetString (PgExc_BufferError,
+                         "A surface rect view is not contiguous: "
+                         "need strides");
+        return -1;
+    }
+    if (PyBUF_HAS_FLAG (flags, PyBUF_C_CONTIGUOUS) ||
+        PyBUF_HAS_FLAG (flags, PyBUF_F_CONTIGUOUS) ||
+        PyBUF_HAS_FLAG (flags, PyBUF_ANY_CONTIGUOUS)) {
+        PyErr_SetString (PgExc_BufferError,
+                         "A surface rect view is not contiguous");
+        return -1;
+    }
+    if (get_buffer (obj, view_p, flags)) {
+        return -1;
+    }
+    ncomponents = view_p->ndim == 3 ? 3 : 1;
+    view_p->buf = ((char *)view_p->buf +
+                   rect->y * view_p->strides[1] +
+                   rect->x * view_p->strides[0]);
+    view_p->shape[0] = rect->w;
+    view_p->shape[1] = rect->h;
+    view_p->len = rect->w * rect->h * ncomponents * view_p->itemsize;
+    return 0;
+}
+
+static int
+_get_buffer_rect_2D (PyObject *obj, Py_buffer *view_p, int flags)
+{
+    return _get_buffer_rect (obj, view_p, flags, _get_buffer_2D);
+}
+
+static int
+_get_buffer_rect_3D (PyObject *obj, Py_buffer *view_p, int flags)
+{
+    return _get_buffer_rect (obj, view_p, flags, _get_buffer_3D);
+}
+
+static int
+_get_buffer_rect_red (PyObject *obj, Py_buffer *view_p, int flags)
+{
+    return _get_buffer_rect (obj, view_p, flags, _get_buffer_red);
+}
+
+static int
+_get_buffer_rect_green (PyObject *obj, Py_buffer *view_p, int flags)
+{
+    return _get_buffer_rect (obj, view_p, flags, _get_buffer_green);
+}
+
+static int
+_get_buffer_rect_blue (PyObject *obj, Py_buffer *view_p, int flags)
+{
+    return _get_buffer_rect (obj, view_p, flags, _get_buffer_blue);
+}
+
+static int
+_get_buffer_rect_alpha (PyObject *obj, Py_buffer *view_p, int flags)
+{
+    return _get_buffer_rect (obj, view_p, flags, _get_buffer_alpha);
+}
+
 static int
 _init_buffer (PyObject *surf, Py_buffer *view_p, int flags)
 {
@@ -2900,20 +4050,21 @@ surface_move (Uint8 *src, Uint8 *dst, int h, int span,
     }
 }
 
+/* Clip a blit of srcrect at dstrect to the source surface and to the
+ * clip rect of the destination, as SDL_BlitSurface does. Returns 0 if
+ * nothing is left to blit.
+ */
 static int
-surface_do_overlap (SDL_Surface *src, SDL_Rect *srcrect,
-            SDL_Surface *dst, SDL_Rect *dstrect)
+surface_clip_blit (SDL_Surface *src, SDL_Rect *srcrect,
+                   SDL_Surface *dst, SDL_Rect *dstrect,
+                   SDL_Rect *srcclip, SDL_Rect *dstclip)
 {
-    Uint8 *srcpixels;
-    Uint8 *dstpixels;
     int srcx = srcrect->x, srcy = srcrect->y;
     int dstx = dstrect->x, dsty = dstrect->y;
     int x, y;
     int w = srcrect-> w, h= srcrect->h;
     int maxw, maxh;
     SDL_Rect *clip = &dst->clip_rect;
-    int span;
-    int dstoffset;
 
     /* clip the source rectangle to the source surface */
     if (srcx < 0) {
@@ -2925,13 +4076,12 @@ surface_do_overlap (SDL_Surface *src, SDL_Rect *srcrect,
     if (maxw < w) {
         w = maxw;
     }
-    srcy = srcrect->y;
     if (srcy < 0) {
         h += srcy;
         dsty -= srcy;
         srcy = 0;
     }
-        maxh = src->h - srcy;
+    maxh = src->h - srcy;
     if (maxh < h) {
         h = maxh;
     }
@@ -2961,21 +4111,43 @@ surface_do_overlap (SDL_Surface *src, SDL_Rect *srcrect,
     if (w <= 0 || h <= 0) {
         return 0;
     }
+    srcclip->x = srcx;
+    srcclip->y = srcy;
+    dstclip->x = dstx;
+    dstclip->y = dsty;
+    srcclip->w = dstclip->w = w;
+    srcclip->h = dstclip->h = h;
+    return 1;
+}
+
+static int
+surface_do_overlap (SDL_Surface *src, SDL_Rect *srcrect,
+            SDL_Surface *dst, SDL_Rect *dstrect)
+{
+    Uint8 *srcpixels;
+    Uint8 *dstpixels;
+    SDL_Rect s, d;
+    int span;
+    int dstoffset;
+
+    if (!surface_clip_blit (src, srcrect, dst, dstrect, &s, &d)) {
+        return 0;
+    }
 
     srcpixels = ((Uint8 *) src->pixels + src->offset +
-          srcy * src->pitch +
-          srcx * src->format->BytesPerPixel);
+          s.y * src->pitch +
+          s.x * src->format->BytesPerPixel);
     dstpixels = ((Uint8 *) dst->pixels + src->offset +
-          dsty * dst->pitch +
-          dstx * dst->format->BytesPerPixel);
+          d.y * dst->pitch +
+          d.x * dst->format->BytesPerPixel);
 
     if (dstpixels <= srcpixels) {
         return 0;
     }
 
-    span = w * src->format->BytesPerPixel;
+    span = s.w * src->format->BytesPerPixel;
 
-    if (dstpixels >= srcpixels + (h - 1) * src->pitch + span) {
+    if (dstpixels >= srcpixels + (s.h - 1) * src->pitch + span) {
         return 0;
     }
 
@@ -2984,41 +4156,290 @@ surface_do_overlap (SDL_Surface *src, SDL_Rect *srcrect,
     return dstoffset < span || dstoffset > src->pitch - span;
 }
 
-/*this internal blit function is accessable through the C api*/
-int
-PySurface_Blit (PyObject * dstobj, PyObject * srcobj, SDL_Rect * dstrect,
-                SDL_Rect * srcrect, int the_args)
+/* Whether a mapped color is already premultiplied, with no colour channel
+ * above its alpha. Writing it keeps a premultiplied Surface valid.
+ */
+static int
+surface_color_is_premul (SDL_PixelFormat *format, Uint32 color)
 {
-    SDL_Surface *src = PySurface_AsSurface (srcobj);
-    SDL_Surface *dst = PySurface_AsSurface (dstobj);
-    SDL_Surface *subsurface = NULL;
-    int result, suboffsetx = 0, suboffsety = 0;
-    SDL_Rect orig_clip, sub_clip;
+    Uint8 r, g, b, a;
 
-    /* passthrough blits to the real surface */
-    if (((PySurfaceObject *) dstobj)->subsurface) {
-        PyObject *owner;
-        struct SubSurface_Data *subdata;
+    SDL_GetRGBA (color, format, &r, &g, &b, &a);
+    return r <= a && g <= a && b <= a;
+}
 
-        subdata = ((PySurfaceObject *) dstobj)->subsurface;
-        owner = subdata->owner;
-        subsurface = PySurface_AsSurface (owner);
-        suboffsetx = subdata->offsetx;
-        suboffsety = subdata->offsety;
+/* Straight alpha pixels were written to surfobj, so neither it nor the
+ * Surfaces owning its pixels are premultiplied any more.
+ */
+static void
+surface_unmark_premul (PyObject *surfobj)
+{
+    while (surfobj) {
+        ((PySurfaceObject *) surfobj)->premultiplied = 0;
+        surfobj = ((PySurfaceObject *) surfobj)->subsurface ?
+            ((PySurfaceObject *) surfobj)->subsurface->owner : NULL;
+    }
+}
 
-        while (((PySurfaceObject *) owner)->subsurface) {
-            subdata = ((PySurfaceObject *) owner)->subsurface;
-            owner = subdata->owner;
-            subsurface = PySurface_AsSurface (owner);
-            suboffsetx += subdata->offsetx;
-            suboffsety += subdata->offsety;
-        }
+/* Whether a blit of src to dst is a plain copy of pixels within the same
+ * buffer, which surface_blit_move can do with memmove: no blend, alpha or
+ * colorkey, and the same pixel format. src is dst or a subsurface of it.
+ */
+static int
+surface_can_move (SDL_Surface *src, SDL_Surface *dst, int the_args)
+{
+    SDL_PixelFormat *sf = src->format, *df = dst->format;
+    Uint8 *pixels = (Uint8 *) dst->pixels;
+
+    return (the_args == 0 && pixels && (Uint8 *) src->pixels >= pixels &&
+            (Uint8 *) src->pixels < pixels + (size_t) dst->pitch * dst->h &&
+            !(src->flags & (SDL_SRCALPHA | SDL_SRCCOLORKEY |
+                            SDL_HWSURFACE | SDL_RLEACCEL)) &&
+            !(dst->flags & (SDL_HWSURFACE | SDL_RLEACCEL)) &&
+            !SDL_MUSTLOCK (dst) &&
+            sf->BitsPerPixel == df->BitsPerPixel && sf->BitsPerPixel >= 8 &&
+            sf->Rmask == df->Rmask && sf->Gmask == df->Gmask &&
+            sf->Bmask == df->Bmask && sf->Amask == df->Amask &&
+            src->pitch == dst->pitch);
+}
 
-        SDL_GetClipRect (subsurface, &orig_clip);
-        SDL_GetClipRect (dst, &sub_clip);
-        sub_clip.x += suboffsetx;
-        sub_clip.y += suboffsety;
-        SDL_SetClipRect (subsurface, &sub_clip);
+/* Copy the rows of a blit within one buffer with memmove, leaving the
+ * blitted area in dstrect like SDL_BlitSurface.
+ */
+static void
+surface_blit_move (SDL_Surface *src, SDL_Rect *srcrect,
+                   SDL_Surface *dst, SDL_Rect *dstrect)
+{
+    int bpp = dst->format->BytesPerPixel;
+    SDL_Rect s, d;
+
+    if (!surface_clip_blit (src, srcrect, dst, dstrect, &s, &d)) {
+        dstrect->w = dstrect->h = 0;
+        return;
+    }
+    surface_move ((Uint8 *) src->pixels + s.y * src->pitch + s.x * bpp,
+                  (Uint8 *) dst->pixels + d.y * dst->pitch + d.x * bpp,
+                  s.h, s.w * bpp, src->pitch, dst->pitch);
+    *dstrect = d;
+}
+
+/* Damage tracking. The damage of a surface is kept as rects that do not
+ * overlap each other once damage_merge has been run.
+ */
+
+static int
+damage_overlap (SDL_Rect *a, SDL_Rect *b)
+{
+    return (a->x < b->x + b->w && b->x < a->x + a->w &&
+            a->y < b->y + b->h && b->y < a->y + a->h);
+}
+
+static int
+damage_contains (SDL_Rect *a, SDL_Rect *b)
+{
+    return (b->x >= a->x && b->y >= a->y &&
+            b->x + b->w <= a->x + a->w && b->y + b->h <= a->y + a->h);
+}
+
+static void
+damage_union (SDL_Rect *a, SDL_Rect *b)
+{
+    int x = MIN (a->x, b->x);
+    int y = MIN (a->y, b->y);
+
+    a->w = MAX (a->x + a->w, b->x + b->w) - x;
+    a->h = MAX (a->y + a->h, b->y + b->h) - y;
+    a->x = x;
+    a->y = y;
+}
+
+/* Union overlapping rects until none overlap. Returns the new count. */
+static int
+damage_merge (SDL_Rect *rects, int n)
+{
+    int i, j, merged;
+
+    do {
+        merged = 0;
+        for (i = 0; i < n; ++i) {
+            for (j = i + 1; j < n; ++j) {
+                if (damage_overlap (&rects[i], &rects[j])) {
+                    damage_union (&rects[i], &rects[j]);
+                    rects[j--] = rects[--n];
+                    merged = 1;
+                }
+            }
+        }
+    } while (merged);
+    return n;
+}
+
+static void
+damage_add (PgDamage *damage, SDL_Rect *rect, SDL_Rect *clip)
+{
+    SDL_Rect r;
+    int i, x2, y2;
+
+    r.x = MAX (rect->x, clip->x);
+    r.y = MAX (rect->y, clip->y);
+    x2 = MIN (rect->x + rect->w, clip->x + clip->w);
+    y2 = MIN (rect->y + rect->h, clip->y + clip->h);
+    if (x2 <= r.x || y2 <= r.y)
+        return;
+    r.w = x2 - r.x;
+    r.h = y2 - r.y;
+
+    for (i = 0; i < damage->n; ++i) {
+        if (damage_contains (&damage->rects[i], &r))
+            return;
+        if (damage_contains (&r, &damage->rects[i]))
+            damage->rects[i--] = damage->rects[--damage->n];
+    }
+    if (damage->n == PG_DAMAGE_MAX_RECTS) {
+        damage->n = damage_merge (damage->rects, damage->n);
+        if (damage->n == PG_DAMAGE_MAX_RECTS) {
+            for (i = 1; i < damage->n; ++i)
+                damage_union (&damage->rects[0], &damage->rects[i]);
+            damage->n = 1;
+        }
+    }
+    damage->rects[damage->n++] = r;
+}
+
+/* Add rect, in the coordinates of surfobj, to the damage of surfobj and of
+ * the surfaces it is a subsurface of that track damage. The damage of each
+ * surface is clipped to its clip area.
+ */
+static void
+PySurface_AddDamage (PyObject *surfobj, SDL_Rect *rect)
+{
+    PySurfaceObject *obj = (PySurfaceObject *) surfobj;
+    SDL_Rect r = *rect;
+
+    while (obj && obj->surf) {
+        if (obj->damage)
+            damage_add (obj->damage, &r, &obj->surf->clip_rect);
+        if (!obj->subsurface)
+            break;
+        r.x += obj->subsurface->offsetx;
+        r.y += obj->subsurface->offsety;
+        obj = (PySurfaceObject *) obj->subsurface->owner;
+    }
+}
+
+/* Move the damage of surfobj, as rects that do not overlap, into rects,
+ * which has room for max, at least 1; more become their bounding rect.
+ * Returns how many, or -1 if surfobj does not track damage.
+ */
+static int
+PySurface_TakeDamage (PyObject *surfobj, SDL_Rect *rects, int max)
+{
+    PgDamage *damage = ((PySurfaceObject *) surfobj)->damage;
+    int i, n;
+
+    if (!damage)
+        return -1;
+    n = damage_merge (damage->rects, damage->n);
+    if (n > max) {
+        for (i = 1; i < n; ++i)
+            damage_union (&damage->rects[0], &damage->rects[i]);
+        n = 1;
+    }
+    memcpy (rects, damage->rects, n * sizeof (SDL_Rect));
+    damage->n = 0;
+    return n;
+}
+
+/* Take the colorkey runs of the source of a blit from srcobj, building
+ * them if needed, while the blit uses them. Returns NULL if the blit can
+ * not use them: a blended or alpha blit, a subsurface, whose pixels may
+ * be changed through its owner, or runs in use by another blit.
+ */
+static PgColorkeyRLE*
+surface_take_rle (PyObject *srcobj, int the_args)
+{
+    PySurfaceObject *obj = (PySurfaceObject *) srcobj;
+    SDL_Surface *src = obj->surf;
+    PgColorkeyRLE *rle = obj->rle;
+
+    if ((the_args & ~PYGAME_BLIT_THREADED) || obj->subsurface ||
+        !(src->flags & SDL_SRCCOLORKEY) ||
+        (src->flags & SDL_SRCALPHA && src->format->Amask) ||
+        rle == PYGAME_RLE_IN_USE)
+        return NULL;
+
+    if (rle && !pygame_ColorkeyRLEValid (rle, src)) {
+        PyMem_Free (rle);
+        rle = NULL;
+    }
+    if (!rle)
+        rle = pygame_MakeColorkeyRLE (src);
+    obj->rle = rle ? PYGAME_RLE_IN_USE : NULL;
+    return rle;
+}
+
+/* Give back runs from surface_take_rle, unless srcobj was dropped by a
+ * change to its pixels during the blit.
+ */
+static void
+surface_give_rle (PyObject *srcobj, PgColorkeyRLE *rle)
+{
+    PySurfaceObject *obj = (PySurfaceObject *) srcobj;
+
+    if (!rle)
+        return;
+    if (obj->rle == PYGAME_RLE_IN_USE)
+        obj->rle = rle;
+    else
+        PyMem_Free (rle);
+}
+
+/*this internal blit function is accessable through the C api*/
+int
+PySurface_Blit (PyObject * dstobj, PyObject * srcobj, SDL_Rect * dstrect,
+                SDL_Rect * srcrect, int the_args)
+{
+    SDL_Surface *src = PySurface_AsSurface (srcobj);
+    SDL_Surface *dst = PySurface_AsSurface (dstobj);
+    SDL_Surface *subsurface = NULL;
+    PyObject *dstowner = dstobj;
+    int result, suboffsetx = 0, suboffsety = 0;
+    int mode = the_args & ~PYGAME_BLIT_THREADED;
+    /* the destination stays premultiplied if the source is, or is opaque */
+    int keep_premul = (((PySurfaceObject *) srcobj)->premultiplied ||
+                       mode == PYGAME_BLEND_PREMULTIPLIED ||
+                       (mode == 0 && !src->format->Amask &&
+                        !(src->flags & SDL_SRCALPHA)));
+    SDL_Rect orig_clip, sub_clip;
+    Uint64 start;
+
+    PG_PERF_BEGIN (start);
+
+    /* passthrough blits to the real surface */
+    if (((PySurfaceObject *) dstobj)->subsurface) {
+        PyObject *owner;
+        struct SubSurface_Data *subdata;
+
+        subdata = ((PySurfaceObject *) dstobj)->subsurface;
+        owner = subdata->owner;
+        subsurface = PySurface_AsSurface (owner);
+        suboffsetx = subdata->offsetx;
+        suboffsety = subdata->offsety;
+
+        while (((PySurfaceObject *) owner)->subsurface) {
+            subdata = ((PySurfaceObject *) owner)->subsurface;
+            owner = subdata->owner;
+            subsurface = PySurface_AsSurface (owner);
+            suboffsetx += subdata->offsetx;
+            suboffsety += subdata->offsety;
+        }
+
+        dstowner = owner;
+        SDL_GetClipRect (subsurface, &orig_clip);
+        SDL_GetClipRect (dst, &sub_clip);
+        sub_clip.x += suboffsetx;
+        sub_clip.y += suboffsety;
+        SDL_SetClipRect (subsurface, &sub_clip);
         dstrect->x += suboffsetx;
         dstrect->y += suboffsety;
         dst = subsurface;
@@ -3027,17 +4448,34 @@ PySurface_Blit (PyObject * dstobj, PyObject * srcobj, SDL_Rect * dstrect,
         PySurface_Prep (dstobj);
         subsurface = NULL;
     }
-
+    /* the source is prepped first, so decoding compressed destination
+       pixels cannot drop those of the source */
     PySurface_Prep (srcobj);
-
+    PySurface_Unshare (dstowner);
+
+    /* a plain copy within one buffer, such as a scroll of the Surface
+       by a blit to itself, only moves rows */
+    if (surface_can_move (src, dst, the_args)) {
+        surface_blit_move (src, srcrect, dst, dstrect);
+        result = 0;
+    }
+    /* a premultiplied source needs the premultiplied blitter, whatever
+       the destination */
+    else if (((PySurfaceObject *) srcobj)->premultiplied &&
+        !(the_args & ~PYGAME_BLIT_THREADED) &&
+        src->format->Amask && (src->flags & SDL_SRCALPHA)) {
+        result = pygame_AlphaBlit (src, srcrect, dst, dstrect,
+                                   the_args | PYGAME_BLEND_PREMULTIPLIED);
+    }
     /* see if we should handle alpha ourselves */
-    if (dst->format->Amask && (dst->flags & SDL_SRCALPHA) &&
+    else if (dst->format->Amask && (dst->flags & SDL_SRCALPHA) &&
         !(src->format->Amask && !(src->flags & SDL_SRCALPHA)) &&
         /* special case, SDL works */
         (dst->format->BytesPerPixel == 2 || dst->format->BytesPerPixel == 4)) {
-        /* Py_BEGIN_ALLOW_THREADS */
-        result = pygame_AlphaBlit (src, srcrect, dst, dstrect, the_args);
-        /* Py_END_ALLOW_THREADS */
+        PgColorkeyRLE *rle = surface_take_rle (srcobj, the_args);
+
+        result = pygame_BlitRLE (src, srcrect, dst, dstrect, the_args, rle);
+        surface_give_rle (srcobj, rle);
     }
     else if (the_args != 0 ||
              (src->flags & (SDL_SRCALPHA | SDL_SRCCOLORKEY) &&
@@ -3097,6 +4535,9 @@ PySurface_Blit (PyObject * dstobj, PyObject * srcobj, SDL_Rect * dstrect,
         /* Py_END_ALLOW_THREADS */
     }
 
+    /* the pixels of the destination have changed */
+    PySurface_DropRLE (dstowner);
+
     if (subsurface) {
         SDL_SetClipRect (subsurface, &orig_clip);
         dstrect->x -= suboffsetx;
@@ -3106,16 +4547,634 @@ PySurface_Blit (PyObject * dstobj, PyObject * srcobj, SDL_Rect * dstrect,
         PySurface_Unprep (dstobj);
     PySurface_Unprep (srcobj);
 
+    if (result == 0) {
+        PySurface_AddDamage (dstobj, dstrect);
+        if (!keep_premul)
+            surface_unmark_premul (dstobj);
+    }
     if (result == -1)
         RAISE (PyExc_SDLError, SDL_GetError ());
     if (result == -2)
         RAISE (PyExc_SDLError, "Surface was lost");
 
+    PG_PERF_ADD (PG_PERF_BLIT_CALLS, 1);
+    if (result == 0 && PG_PERF_BLEND_VALID (mode))
+        PG_PERF_ADD (PG_PERF_BLIT_PIXELS + PG_PERF_BLEND_INDEX (mode),
+                     dstrect->w * dstrect->h);
+    PG_PERF_END (start, PG_PERF_BLIT_NS);
     return result != 0;
 }
 
+static PyObject *
+surf_get_blit_backend (PyObject *self)
+{
+    return Text_FromUTF8 (pygame_GetBlitBackend ());
+}
+
+static PyObject *
+surf_set_blit_backend (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    char *keywords[] = {"type", NULL};
+    const char *type;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "s:set_blit_backend",
+                                      keywords, &type))
+    {
+        return NULL;
+    }
+    if (pygame_SetBlitBackend (type))
+    {
+        return RAISE (PyExc_ValueError, SDL_GetError ());
+    }
+    Py_RETURN_NONE;
+}
+
+int
+pygame_WorkerRun (PgPool_Job job, void *data, int n, int grain,
+                  int max_threads)
+{
+    return PgPool_Run (job, data, n, grain, max_threads);
+}
+
+int
+pygame_WorkerThreads (void)
+{
+    return PgPool_GetThreads ();
+}
+
+int
+pygame_CpuFeatures (void)
+{
+    return PgCpu_GetFeatures ();
+}
+
+static PyObject *
+surf_get_blit_threads (PyObject *self)
+{
+    return PyInt_FromLong (pygame_GetBlitThreads ());
+}
+
+static PyObject *
+surf_set_blit_threads (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    char *keywords[] = {"threads", NULL};
+    int threads;
+    PyObject *base, *result;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "i:set_blit_threads",
+                                      keywords, &threads))
+    {
+        return NULL;
+    }
+    if (pygame_SetBlitThreads (threads))
+    {
+        return RAISE (PyExc_ValueError, SDL_GetError ());
+    }
+    /* Grow the pool to the threads asked for */
+    threads = pygame_GetBlitThreads ();
+    if (threads > 1 && threads > PgPool_GetThreads ())
+    {
+        base = PyImport_ImportModule ("pygame.base");
+        if (!base)
+            return NULL;
+        result = PyObject_CallMethod (base, "set_pool_threads", "i", threads);
+        Py_DECREF (base);
+        if (!result)
+            return NULL;
+        Py_DECREF (result);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_set_auto_convert (PyObject *self, PyObject *args)
+{
+    int enable = 1;
+
+    if (!PyArg_ParseTuple (args, "|i", &enable))
+        return NULL;
+    auto_convert = enable != 0;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_auto_convert (PyObject *self)
+{
+    return PyBool_FromLong (auto_convert);
+}
+
+static PyObject *
+surf_get_auto_convert_stats (PyObject *self, PyObject *args)
+{
+    PyObject *result;
+    int reset = 0;
+
+    if (!PyArg_ParseTuple (args, "|i", &reset))
+        return NULL;
+    result = Py_BuildValue ("(kk)", auto_convert_conversions,
+                            auto_convert_hits);
+    if (result && reset)
+        auto_convert_conversions = auto_convert_hits = 0;
+    return result;
+}
+
+static PyObject *
+surf_set_pool_limit (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    char *keywords[] = {"limit", "largest", NULL};
+    PyObject *largestobj = Py_None;
+    Py_ssize_t limit, largest;
+    size_t oldlimit, oldlargest;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "n|O:set_pool_limit",
+                                      keywords, &limit, &largestobj))
+        return NULL;
+    pygame_PoolGetLimit (&oldlimit, &oldlargest);
+    largest = (Py_ssize_t) oldlargest;
+    if (largestobj != Py_None) {
+        largest = PyNumber_AsSsize_t (largestobj, PyExc_OverflowError);
+        if (largest == -1 && PyErr_Occurred ())
+            return NULL;
+    }
+    if (limit < 0 || largest < 0)
+        return RAISE (PyExc_ValueError, "pool limits cannot be negative");
+    if (pygame_PoolSetLimit ((size_t) limit, (size_t) largest))
+        return RAISE (PyExc_ValueError, SDL_GetError ());
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_pool_limit (PyObject *self)
+{
+    size_t limit, largest;
+
+    pygame_PoolGetLimit (&limit, &largest);
+    return Py_BuildValue ("(nn)", (Py_ssize_t) limit, (Py_ssize_t) largest);
+}
+
+static PyObject *
+surf_get_pool_stats (PyObject *self, PyObject *args)
+{
+    PgPoolStats stats;
+    int reset = 0;
+
+    if (!PyArg_ParseTuple (args, "|i", &reset))
+        return NULL;
+    pygame_PoolGetStats (&stats, reset);
+    return Py_BuildValue ("(knknkkk)", stats.idle, (Py_ssize_t) stats.idle_bytes,
+                          stats.used, (Py_ssize_t) stats.used_bytes,
+                          stats.hits, stats.misses, stats.drops);
+}
+
+static PyObject *
+surf_set_decompressed_limit (PyObject *self, PyObject *args)
+{
+    Py_ssize_t limit;
+
+    if (!PyArg_ParseTuple (args, "n", &limit))
+        return NULL;
+    if (limit < 0)
+        return RAISE (PyExc_ValueError, "limit cannot be negative");
+    pygame_PackSetLimit ((size_t) limit);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_decompressed_limit (PyObject *self)
+{
+    return PyInt_FromSsize_t ((Py_ssize_t) pygame_PackGetLimit ());
+}
+
+static PyObject *
+surf_get_compress_stats (PyObject *self, PyObject *args)
+{
+    PgPackStats stats;
+    int reset = 0;
+
+    if (!PyArg_ParseTuple (args, "|i", &reset))
+        return NULL;
+    pygame_PackGetStats (&stats, reset);
+    return Py_BuildValue ("(knknkk)", stats.packed,
+                          (Py_ssize_t) stats.packed_bytes, stats.decoded,
+                          (Py_ssize_t) stats.decoded_bytes, stats.decodes,
+                          stats.encodes);
+}
+
+/* A Surface over the shared pixels, which it closes when freed */
+static PyObject *
+surface_from_shared (PgSharedPixels *shared)
+{
+    SDL_Surface *surf = pygame_SharedSurface (shared);
+    PyObject *obj;
+
+    if (!surf) {
+        pygame_SharedClose (shared);
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    }
+    obj = PySurface_New (surf);
+    if (!obj) {
+        SDL_FreeSurface (surf);
+        pygame_SharedClose (shared);
+        return NULL;
+    }
+    ((PySurfaceObject *) obj)->shared = shared;
+    return obj;
+}
+
+static PyObject *
+surf_create_shared (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    char *name;
+    int width, height;
+    Uint32 flags = 0;
+    int depth = 32;
+    PyObject *masks = NULL;
+    Uint32 Rmask, Gmask, Bmask, Amask = 0;
+    PgSharedPixels *shared;
+    char *kwids[] = { "name", "size", "flags", "depth", "masks", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "s(ii)|iiO", kwids, &name,
+                                      &width, &height, &flags, &depth,
+                                      &masks))
+        return NULL;
+
+    if (masks && masks != Py_None) {
+        if (!PySequence_Check (masks) || PySequence_Length (masks) != 4)
+            return RAISE (PyExc_ValueError,
+                          "masks argument must be sequence of four numbers");
+        if (!UintFromObjIndex (masks, 0, &Rmask) ||
+            !UintFromObjIndex (masks, 1, &Gmask) ||
+            !UintFromObjIndex (masks, 2, &Bmask) ||
+            !UintFromObjIndex (masks, 3, &Amask))
+            return RAISE (PyExc_ValueError,
+                          "invalid mask values in masks sequence");
+    }
+    else if (depth == 16) {
+        /* The default masks of Surface */
+        if (flags & SDL_SRCALPHA) {
+            Rmask = 0xF << 8;
+            Gmask = 0xF << 4;
+            Bmask = 0xF;
+            Amask = 0xF << 12;
+        }
+        else {
+            Rmask = 0xFF >> 3 << 11;
+            Gmask = 0xFF >> 2 << 5;
+            Bmask = 0xFF >> 3;
+        }
+    }
+    else {
+        Rmask = 0xFF << 16;
+        Gmask = 0xFF << 8;
+        Bmask = 0xFF;
+        if (flags & SDL_SRCALPHA) {
+            if (depth != 32)
+                return RAISE (PyExc_ValueError, "no standard masks exist "
+                              "for given bitdepth with alpha");
+            Amask = 0xFF << 24;
+        }
+    }
+
+    shared = pygame_SharedCreate (name, width, height, depth, Rmask, Gmask,
+                                  Bmask, Amask);
+    if (!shared)
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    return surface_from_shared (shared);
+}
+
+static PyObject *
+surf_open_shared (PyObject *self, PyObject *args)
+{
+    char *name;
+    PgSharedPixels *shared;
+
+    if (!PyArg_ParseTuple (args, "s", &name))
+        return NULL;
+    shared = pygame_SharedOpen (name);
+    if (!shared)
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    return surface_from_shared (shared);
+}
+
+static PyObject *
+surf_unlink_shared (PyObject *self, PyObject *args)
+{
+    char *name;
+
+    if (!PyArg_ParseTuple (args, "s", &name))
+        return NULL;
+    if (pygame_SharedUnlink (name))
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    Py_RETURN_NONE;
+}
+
+/* SurfaceRegion */
+
+static PyObject*
+surface_make_region (PyObject *parent, int x, int y, int w, int h)
+{
+    PySurfaceRegionObject *region;
+
+    region = PyObject_NEW (PySurfaceRegionObject, &PySurfaceRegion_Type);
+    if (!region)
+        return NULL;
+    Py_INCREF (parent);
+    region->parent = parent;
+    region->rect.x = x;
+    region->rect.y = y;
+    region->rect.w = w;
+    region->rect.h = h;
+    region->subsurface = NULL;
+    return (PyObject *) region;
+}
+
+static PyObject*
+surf_region (PyObject *self, PyObject *args)
+{
+    SDL_Surface *surf = PySurface_AsSurface (self);
+    GAME_Rect *rect, temp;
+
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    if (!(rect = GameRect_FromObject (args, &temp)))
+        return RAISE (PyExc_ValueError, "invalid rectstyle argument");
+    if (rect->x < 0 || rect->y < 0 || rect->w < 0 || rect->h < 0 ||
+        rect->x + rect->w > surf->w || rect->y + rect->h > surf->h)
+        return RAISE (PyExc_ValueError,
+                      "region rectangle outside surface area");
+    return surface_make_region (self, rect->x, rect->y, rect->w, rect->h);
+}
+
+/* A region of a region, with rectobj relative to it */
+static PyObject*
+region_inner (PySurfaceRegionObject *region, PyObject *rectobj)
+{
+    GAME_Rect *rect, temp;
+
+    if (!(rect = GameRect_FromObject (rectobj, &temp)))
+        return RAISE (PyExc_ValueError, "invalid rectstyle argument");
+    if (rect->x < 0 || rect->y < 0 || rect->w < 0 || rect->h < 0 ||
+        rect->x + rect->w > region->rect.w ||
+        rect->y + rect->h > region->rect.h)
+        return RAISE (PyExc_ValueError,
+                      "region rectangle outside surface area");
+    return surface_make_region (region->parent, region->rect.x + rect->x,
+                                region->rect.y + rect->y, rect->w, rect->h);
+}
+
+static PyObject*
+region_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *surfobj, *rectobj;
+
+    static char *kwids[] = {"surface", "rect", NULL};
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "OO", kwids,
+                                      &surfobj, &rectobj))
+        return NULL;
+
+    if (PySurfaceRegion_Check (surfobj))
+        return region_inner ((PySurfaceRegionObject *) surfobj, rectobj);
+    if (!PyObject_TypeCheck (surfobj, &PySurface_Type))
+        return RAISE (PyExc_TypeError,
+                      "surface must be a Surface or SurfaceRegion");
+    return surf_region (surfobj, rectobj);
+}
+
+static void
+region_dealloc (PySurfaceRegionObject *self)
+{
+    Py_XDECREF (self->parent);
+    Py_XDECREF (self->subsurface);
+    PyObject_DEL (self);
+}
+
+static PyObject*
+region_repr (PySurfaceRegionObject *self)
+{
+    return Text_FromFormat ("<SurfaceRegion(%dx%d at %d, %d)>",
+                            self->rect.w, self->rect.h,
+                            self->rect.x, self->rect.y);
+}
+
+static PyObject*
+region_get_parent (PySurfaceRegionObject *self)
+{
+    Py_INCREF (self->parent);
+    return self->parent;
+}
+
+static PyObject*
+region_get_offset (PySurfaceRegionObject *self)
+{
+    return Py_BuildValue ("(ii)", self->rect.x, self->rect.y);
+}
+
+static PyObject*
+region_get_size (PySurfaceRegionObject *self)
+{
+    return Py_BuildValue ("(ii)", self->rect.w, self->rect.h);
+}
+
+static PyObject*
+region_get_rect (PySurfaceRegionObject *self, PyObject *args,
+                 PyObject *kwargs)
+{
+    PyObject *rect, *key, *value;
+    Py_ssize_t pos = 0;
+
+    if (PyTuple_GET_SIZE (args) > 0)
+        return RAISE (PyExc_TypeError,
+                      "get_rect only accepts keyword arguments");
+
+    rect = PyRect_New4 (0, 0, self->rect.w, self->rect.h);
+    if (rect && kwargs) {
+        while (PyDict_Next (kwargs, &pos, &key, &value)) {
+            if (PyObject_SetAttr (rect, key, value) == -1) {
+                Py_DECREF (rect);
+                return NULL;
+            }
+        }
+    }
+    return rect;
+}
+
+static PyObject*
+region_region (PySurfaceRegionObject *self, PyObject *args)
+{
+    return region_inner (self, args);
+}
+
+static PyObject*
+region_subsurface (PySurfaceRegionObject *self)
+{
+    PyObject *args, *result;
+
+    args = PyRect_New4 (self->rect.x, self->rect.y,
+                        self->rect.w, self->rect.h);
+    if (!args)
+        return NULL;
+    result = surf_subsurface (self->parent, args);
+    Py_DECREF (args);
+    return result;
+}
+
+/* "O&" converter for Surface arguments that also takes a SurfaceRegion.
+ * The region makes a subsurface of its parent the first time, and keeps
+ * it, so either way the Surface given back is borrowed from the argument.
+ * The subsurface is brought up to date with the palette, alpha and
+ * colorkey of the parent on each call.
+ */
+static int
+PySurface_Source (PyObject *obj, void *surfobj)
+{
+    PySurfaceRegionObject *region;
+    SDL_Surface *surf, *sub;
+    PyObject *subobj;
+
+    if (PyObject_TypeCheck (obj, &PySurface_Type)) {
+        *(PyObject **) surfobj = obj;
+        return 1;
+    }
+    if (!PySurfaceRegion_Check (obj)) {
+        PyErr_Format (PyExc_TypeError,
+                      "argument must be a Surface or SurfaceRegion, not %.50s",
+                      Py_TYPE (obj)->tp_name);
+        return 0;
+    }
+
+    region = (PySurfaceRegionObject *) obj;
+    surf = PySurface_AsSurface (region->parent);
+    if (!surf) {
+        RAISE (PyExc_SDLError, "display Surface quit");
+        return 0;
+    }
+    subobj = region->subsurface;
+    if (subobj) {
+        /* a display Surface may have been set to another mode since */
+        sub = PySurface_AsSurface (subobj);
+        if (!sub || sub->format->BitsPerPixel != surf->format->BitsPerPixel ||
+            sub->pitch != surf->pitch ||
+            (Uint8 *) sub->pixels != (Uint8 *) surf->pixels +
+            region->rect.y * surf->pitch +
+            region->rect.x * surf->format->BytesPerPixel) {
+            region->subsurface = NULL;
+            Py_DECREF (subobj);
+            subobj = NULL;
+        }
+    }
+    if (!subobj) {
+        subobj = region_subsurface (region);
+        if (!subobj)
+            return 0;
+        region->subsurface = subobj;
+    }
+
+    sub = PySurface_AsSurface (subobj);
+    if (surf->format->BytesPerPixel == 1 && surf->format->palette)
+        SDL_SetPalette (sub, SDL_LOGPAL, surf->format->palette->colors, 0,
+                        surf->format->palette->ncolors);
+    SDL_SetAlpha (sub, surf->flags & SDL_SRCALPHA, surf->format->alpha);
+    SDL_SetColorKey (sub, surf->flags & (SDL_SRCCOLORKEY | SDL_RLEACCEL),
+                     surf->format->colorkey);
+    ((PySurfaceObject *) subobj)->premultiplied =
+        ((PySurfaceObject *) region->parent)->premultiplied;
+
+    *(PyObject **) surfobj = subobj;
+    return 1;
+}
+
+static PyMethodDef region_methods[] =
+{
+    { "get_parent", (PyCFunction) region_get_parent, METH_NOARGS,
+      DOC_SURFACEREGIONGETPARENT },
+    { "get_offset", (PyCFunction) region_get_offset, METH_NOARGS,
+      DOC_SURFACEREGIONGETOFFSET },
+    { "get_size", (PyCFunction) region_get_size, METH_NOARGS,
+      DOC_SURFACEREGIONGETSIZE },
+    { "get_rect", (PyCFunction) region_get_rect,
+      METH_VARARGS | METH_KEYWORDS, DOC_SURFACEREGIONGETRECT },
+    { "region", (PyCFunction) region_region, METH_VARARGS,
+      DOC_SURFACEREGIONREGION },
+    { "subsurface", (PyCFunction) region_subsurface, METH_NOARGS,
+      DOC_SURFACEREGIONSUBSURFACE },
+    { NULL, NULL, 0, NULL }
+};
+
+static PyTypeObject PySurfaceRegion_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "pygame.SurfaceRegion",     /* name */
+    sizeof (PySurfaceRegionObject), /* basic size */
+    0,                          /* itemsize */
+    (destructor) region_dealloc, /* dealloc */
+    0,                          /* print */
+    NULL,                       /* getattr */
+    NULL,                       /* setattr */
+    NULL,                       /* compare */
+    (reprfunc) region_repr,     /* repr */
+    NULL,                       /* as_number */
+    NULL,                       /* as_sequence */
+    NULL,                       /* as_mapping */
+    (hashfunc) NULL,            /* hash */
+    (ternaryfunc) NULL,         /* call */
+    (reprfunc) NULL,            /* str */
+    0,
+    0L, 0L,
+    Py_TPFLAGS_DEFAULT,         /* tp_flags */
+    DOC_PYGAMESURFACEREGION,    /* Documentation string */
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    region_methods,             /* tp_methods */
+    0,                          /* tp_members */
+    0,                          /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                          /* tp_alloc */
+    region_new,                 /* tp_new */
+};
+
 static PyMethodDef _surface_methods[] =
 {
+    { "set_auto_convert", surf_set_auto_convert, METH_VARARGS,
+      DOC_PYGAMESURFACESETAUTOCONVERT },
+    { "get_auto_convert", (PyCFunction) surf_get_auto_convert, METH_NOARGS,
+      DOC_PYGAMESURFACEGETAUTOCONVERT },
+    { "get_auto_convert_stats", surf_get_auto_convert_stats, METH_VARARGS,
+      DOC_PYGAMESURFACEGETAUTOCONVERTSTATS },
+    { "set_pool_limit", (PyCFunction) surf_set_pool_limit,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMESURFACESETPOOLLIMIT },
+    { "get_pool_limit", (PyCFunction) surf_get_pool_limit, METH_NOARGS,
+      DOC_PYGAMESURFACEGETPOOLLIMIT },
+    { "get_pool_stats", surf_get_pool_stats, METH_VARARGS,
+      DOC_PYGAMESURFACEGETPOOLSTATS },
+    { "set_decompressed_limit", surf_set_decompressed_limit, METH_VARARGS,
+      DOC_PYGAMESURFACESETDECOMPRESSEDLIMIT },
+    { "get_decompressed_limit", (PyCFunction) surf_get_decompressed_limit,
+      METH_NOARGS, DOC_PYGAMESURFACEGETDECOMPRESSEDLIMIT },
+    { "get_compress_stats", surf_get_compress_stats, METH_VARARGS,
+      DOC_PYGAMESURFACEGETCOMPRESSSTATS },
+    { "create_shared", (PyCFunction) surf_create_shared,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMESURFACECREATESHARED },
+    { "open_shared", surf_open_shared, METH_VARARGS,
+      DOC_PYGAMESURFACEOPENSHARED },
+    { "unlink_shared", surf_unlink_shared, METH_VARARGS,
+      DOC_PYGAMESURFACEUNLINKSHARED },
+    { "get_blit_backend", (PyCFunction) surf_get_blit_backend, METH_NOARGS,
+      DOC_PYGAMESURFACEGETBLITBACKEND },
+    { "set_blit_backend", (PyCFunction) surf_set_blit_backend,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMESURFACESETBLITBACKEND },
+    { "get_blit_threads", (PyCFunction) surf_get_blit_threads, METH_NOARGS,
+      DOC_PYGAMESURFACEGETBLITTHREADS },
+    { "set_blit_threads", (PyCFunction) surf_set_blit_threads,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMESURFACESETBLITTHREADS },
     { NULL, NULL, 0, NULL }
 };
 
@@ -3181,6 +5240,12 @@ MODINIT_DEFINE (surface)
     if (PyType_Ready(&PySurface_Type) < 0) {
         MODINIT_ERROR;
     }
+    if (PyType_Ready(&PySurfaceRegion_Type) < 0) {
+        MODINIT_ERROR;
+    }
+
+    /* pick the blitter backend for this CPU */
+    pygame_BlitInit ();
 
     /* create the module */
 #if PY3
@@ -3201,11 +5266,21 @@ MODINIT_DEFINE (surface)
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
+    if (PyDict_SetItemString (dict, "SurfaceRegion",
+                              (PyObject *) &PySurfaceRegion_Type)) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
 
     /* export the c api */
     c_api[0] = &PySurface_Type;
     c_api[1] = PySurface_New;
     c_api[2] = PySurface_Blit;
+    c_api[3] = PySurface_AddDamage;
+    c_api[4] = PySurface_TakeDamage;
+    c_api[5] = pygame_PoolCreateSurface;
+    c_api[6] = pygame_PoolFreeSurface;
+    c_api[7] = PySurface_Source;
     apiobj = encapsulate_api (c_api, "surface");
     if (apiobj == NULL) {
         DECREF_MOD (module);
@@ -3222,5 +5297,13 @@ MODINIT_DEFINE (surface)
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
+
+    /* let pygame.set_simd_backend switch the blitters */
+    if (PgSimd_Register ("surface",
+                         PyDict_GetItemString (dict, "get_blit_backend"),
+                         PyDict_GetItemString (dict, "set_blit_backend"))) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
     MODINIT_RETURN (module);
 }
@@ -51,6 +51,67 @@
 #define PYGAME_BLEND_RGBA_MAX  0x10
 #define PYGAME_BLEND_PREMULTIPLIED  0x11
 
+/* Or'd with the blend mode to split a large blit across threads */
+#define PYGAME_BLIT_THREADED  0x100
+
+/* The colorkey runs of a surface, for blits that skip the keyed pixels.
+ * runs[rows[y]] to runs[rows[y + 1]] are the (keyed, unkeyed) pixel count
+ * pairs of row y, which add up to the width. rows is NULL if the surface
+ * has too many short runs for this to be worth it.
+ */
+typedef struct PgColorkeyRLE
+{
+    int              w;
+    int              h;
+    int              bpp;
+    Uint32           colorkey;
+    int             *rows;
+    int             *runs;
+} PgColorkeyRLE;
+
+/* The structure passed to the low level blit functions */
+typedef struct
+{
+    int              width;
+    int              height;
+    Uint8           *s_pixels;
+    int              s_pxskip;
+    int              s_skip;
+    Uint8           *d_pixels;
+    int              d_pxskip;
+    int              d_skip;
+    SDL_PixelFormat *src;
+    SDL_PixelFormat *dst;
+    Uint32           src_flags;
+    Uint32           dst_flags;
+    PgColorkeyRLE   *s_rle;     /* source colorkey runs, or NULL */
+    int              s_x;       /* position of s_pixels in the source */
+    int              s_y;
+} SDL_BlitInfo;
+
+/* The state of the pixel buffer pool, see surface_pool.c */
+typedef struct
+{
+    unsigned long    idle;      /* buffers kept for reuse */
+    size_t           idle_bytes;
+    unsigned long    used;      /* buffers of live Surfaces */
+    size_t           used_bytes;
+    unsigned long    hits;      /* Surfaces made with a kept buffer */
+    unsigned long    misses;    /* Surfaces that needed a new buffer */
+    unsigned long    drops;     /* buffers freed to stay in the limits */
+} PgPoolStats;
+
+/* The state of the compressed Surfaces, see surface_pack.c */
+typedef struct
+{
+    unsigned long    packed;    /* compressed Surfaces */
+    size_t           packed_bytes;
+    unsigned long    decoded;   /* of those, with pixels in memory */
+    size_t           decoded_bytes;
+    unsigned long    decodes;
+    unsigned long    encodes;
+} PgPackStats;
+
 
 
 
@@ -348,6 +409,66 @@ surface_fill_blend (SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
 void
 surface_respect_clip_rect (SDL_Surface *surface, SDL_Rect *rect);
 
+int
+surface_fill_simd (SDL_Surface *surface, SDL_Rect *rect, Uint32 color);
+
+void
+pygame_BlitInit (void);
+
+int
+pygame_SetBlitBackend (const char *type);
+
+const char *
+pygame_GetBlitBackend (void);
+
+int
+pygame_SetBlitThreads (int threads);
+
+int
+pygame_GetBlitThreads (void);
+
+/* PgPool_Run, PgPool_GetThreads and PgCpu_GetFeatures, for the files of
+ * the surface module built without the pygame C API
+ */
+int
+pygame_WorkerRun (PgPool_Job job, void *data, int n, int grain,
+                  int max_threads);
+
+int
+pygame_WorkerThreads (void);
+
+int
+pygame_CpuFeatures (void);
+
+int
+pygame_PremulAlpha (SDL_Surface *surf);
+
+int
+pygame_AlphaBounds (SDL_Surface *surf, int min_alpha, SDL_Rect *rect);
+
+SDL_Surface *
+pygame_ConvertSurface (SDL_Surface *surf, SDL_PixelFormat *fmt, Uint32 flags);
+
+SDL_Surface *
+pygame_DisplayFormat (SDL_Surface *surf);
+
+SDL_Surface *
+pygame_DisplayFormatAlpha (SDL_Surface *surf);
+
+int
+pygame_Blend16 (SDL_BlitInfo *info, int op);
+
+PgColorkeyRLE *
+pygame_MakeColorkeyRLE (SDL_Surface *surf);
+
+int
+pygame_ColorkeyRLEValid (PgColorkeyRLE *rle, SDL_Surface *surf);
+
+int
+pygame_BlitRLE (SDL_Surface * src, SDL_Rect * srcrect,
+                SDL_Surface * dst, SDL_Rect * dstrect, int the_args,
+                PgColorkeyRLE *rle);
+
 int
 pygame_AlphaBlit (SDL_Surface * src, SDL_Rect * srcrect,
                   SDL_Surface * dst, SDL_Rect * dstrect, int the_args);
@@ -356,4 +477,95 @@ int
 pygame_Blit (SDL_Surface * src, SDL_Rect * srcrect,
              SDL_Surface * dst, SDL_Rect * dstrect, int the_args);
 
+PgSharedPixels *
+pygame_SharedCreate (const char *name, int width, int height, int depth,
+                     Uint32 rmask, Uint32 gmask, Uint32 bmask, Uint32 amask);
+
+PgSharedPixels *
+pygame_SharedOpen (const char *name);
+
+void
+pygame_SharedClose (PgSharedPixels *shm);
+
+int
+pygame_SharedUnlink (const char *name);
+
+SDL_Surface *
+pygame_SharedSurface (PgSharedPixels *shm);
+
+Uint32
+pygame_SharedGetFrame (PgSharedPixels *shm);
+
+int
+pygame_SharedBeginFrame (PgSharedPixels *shm);
+
+int
+pygame_SharedEndFrame (PgSharedPixels *shm);
+
+SDL_Surface *
+pygame_PoolCreateSurface (Uint32 flags, int width, int height, int depth,
+                          Uint32 rmask, Uint32 gmask, Uint32 bmask,
+                          Uint32 amask);
+
+SDL_Surface *
+pygame_PoolCreateAligned (int width, int height, int depth, int align,
+                          Uint32 rmask, Uint32 gmask, Uint32 bmask,
+                          Uint32 amask);
+
+SDL_Surface *
+pygame_PoolCreatePitch (int width, int height, int depth, int pitch,
+                        Uint32 rmask, Uint32 gmask, Uint32 bmask,
+                        Uint32 amask);
+
+Uint8 *
+pygame_PoolPixels (SDL_Surface *surf);
+
+void
+pygame_PoolFreeSurface (SDL_Surface *surf);
+
+int
+pygame_PoolRowAlign (SDL_Surface *surf);
+
+SDL_Surface *
+pygame_PoolCopySurface (SDL_Surface *surf);
+
+int
+pygame_PoolSetLimit (size_t limit, size_t largest);
+
+void
+pygame_PoolGetLimit (size_t *limit, size_t *largest);
+
+void
+pygame_PoolGetStats (PgPoolStats *stats, int reset);
+
+int
+pygame_CowCanShare (PySurfaceObject *obj);
+
+SDL_Surface *
+pygame_CowSurface (SDL_Surface *surf);
+
+int
+pygame_CowShare (PySurfaceObject *obj, PySurfaceObject *copy);
+
+void
+pygame_CowRelease (PySurfaceObject *obj);
+
+int
+pygame_PackSurface (PySurfaceObject *obj, size_t *size);
+
+void
+pygame_PackDrop (PySurfaceObject *obj);
+
+void
+pygame_PackRelease (PySurfaceObject *obj);
+
+void
+pygame_PackSetLimit (size_t limit);
+
+size_t
+pygame_PackGetLimit (void);
+
+void
+pygame_PackGetStats (PgPackStats *stats, int reset);
+
 #endif /* SURFACE_H */
@@ -0,0 +1,181 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * Lazy Surface.copy. A copy gets a pool buffer of its own that is left
+ * untouched, and its pixels point at those of the source until either of
+ * them is changed. PySurface_Unshare, which PySurface_Lock and
+ * PySurface_DropRLE call, then copies the pixels into the buffer of each
+ * copy that still shares them. All the Surfaces sharing the pixels of one
+ * source point to the same PgCowGroup.
+ */
+#define NO_PYGAME_C_API
+#include "_surface.h"
+
+typedef struct
+{
+    PgCowPixels base;
+    PySurfaceObject *source;    /* whose pixels are shared */
+    PySurfaceObject **copies;   /* the copies sharing them */
+    int count;
+    int size;
+} PgCowGroup;
+
+/* Give a copy its own pixels, which it shared until now */
+static void
+_cow_detach (PgCowGroup *group, PySurfaceObject *copy, int keep)
+{
+    SDL_Surface *surf = copy->surf;
+    Uint8 *pixels = pygame_PoolPixels (surf);
+
+    if (keep)
+        memcpy (pixels, group->source->surf->pixels,
+                (size_t) surf->pitch * surf->h);
+    surf->pixels = pixels;
+    copy->cow = NULL;
+}
+
+static void
+_cow_drop (PgCowGroup *group)
+{
+    group->source->cow = NULL;
+    PyMem_Free (group->copies);
+    PyMem_Free (group);
+}
+
+static void
+_cow_remove (PySurfaceObject *obj, int keep)
+{
+    PgCowGroup *group = (PgCowGroup *) obj->cow;
+    int i;
+
+    if (obj == group->source)
+    {
+        for (i = 0; i < group->count; i++)
+            _cow_detach (group, group->copies[i], keep);
+        _cow_drop (group);
+        return;
+    }
+    for (i = 0; group->copies[i] != obj; i++)
+        ;
+    group->copies[i] = group->copies[--group->count];
+    _cow_detach (group, obj, keep);
+    if (!group->count)
+        _cow_drop (group);
+}
+
+static void
+_cow_unshare (PyObject *surfobj)
+{
+    _cow_remove ((PySurfaceObject *) surfobj, 1);
+}
+
+/* Make copy, a new Surface whose pixels were made by
+ * pygame_CowSurface, share the pixels of obj. Returns -1 if out of memory,
+ * with the pixels of copy left to fill.
+ */
+int
+pygame_CowShare (PySurfaceObject *obj, PySurfaceObject *copy)
+{
+    PgCowGroup *group = (PgCowGroup *) obj->cow;
+    PySurfaceObject **copies;
+
+    if (!group)
+    {
+        group = PyMem_New (PgCowGroup, 1);
+        if (!group)
+            return -1;
+        group->base.unshare = _cow_unshare;
+        group->source = obj;
+        group->copies = NULL;
+        group->count = group->size = 0;
+        obj->cow = (PgCowPixels *) group;
+    }
+    if (group->count == group->size)
+    {
+        copies = group->copies;
+        if (!PyMem_Resize (copies, PySurfaceObject *, group->size * 2 + 4))
+        {
+            if (!group->count)
+                _cow_drop (group);
+            return -1;
+        }
+        group->copies = copies;
+        group->size = group->size * 2 + 4;
+    }
+    group->copies[group->count++] = copy;
+    copy->cow = (PgCowPixels *) group;
+    copy->surf->pixels = group->source->surf->pixels;
+    return 0;
+}
+
+/* Whether obj can share its pixels with a copy. Their pixels must not
+ * move or change without PySurface_Unshare: no display, subsurface, shared
+ * memory or hardware Surfaces, no locks held, and no RLE, which SDL may
+ * free the pixels for.
+ */
+int
+pygame_CowCanShare (PySurfaceObject *obj)
+{
+    SDL_Surface *surf = obj->surf;
+
+    return (surf != SDL_GetVideoSurface () && !obj->subsurface &&
+            !obj->shared && !obj->packed &&
+            !obj->selflocks && !surf->locked &&
+            !(obj->locklist && PyList_GET_SIZE (obj->locklist)) &&
+            !(surf->flags & (SDL_HWSURFACE | SDL_RLEACCEL |
+                             SDL_RLEACCELOK | SDL_OPENGL)) &&
+            surf->format->BitsPerPixel >= 8 && surf->pixels);
+}
+
+/* The SDL Surface of a lazy copy of surf: the same format, palette,
+ * colorkey, alpha and clip rect, and a pool buffer of the same pitch
+ * that pygame_CowShare leaves unfilled.
+ */
+SDL_Surface *
+pygame_CowSurface (SDL_Surface *surf)
+{
+    SDL_PixelFormat *format = surf->format;
+    SDL_Surface *copy;
+
+    copy = pygame_PoolCreatePitch (surf->w, surf->h, format->BitsPerPixel,
+                                   surf->pitch, format->Rmask,
+                                   format->Gmask, format->Bmask,
+                                   format->Amask);
+    if (!copy)
+        return NULL;
+    if (format->palette)
+        SDL_SetColors (copy, format->palette->colors, 0,
+                       format->palette->ncolors);
+    SDL_SetClipRect (copy, &surf->clip_rect);
+    if (surf->flags & SDL_SRCCOLORKEY)
+        SDL_SetColorKey (copy, SDL_SRCCOLORKEY, format->colorkey);
+    if (surf->flags & SDL_SRCALPHA)
+        SDL_SetAlpha (copy, SDL_SRCALPHA, format->alpha);
+    return copy;
+}
+
+/* Stop obj sharing pixels as it is freed. Copies of it get its pixels
+ * first.
+ */
+void
+pygame_CowRelease (PySurfaceObject *obj)
+{
+    if (obj->cow)
+        _cow_remove (obj, obj == ((PgCowGroup *) obj->cow)->source);
+}
@@ -19,6 +19,7 @@
 
 #define NO_PYGAME_C_API
 #include "_surface.h"
+#include "simd_blitters.h"
 
 /*
  * Changes SDL_Rect to respect any clipping rect defined on the surface.
@@ -75,6 +76,170 @@ void surface_respect_clip_rect (SDL_Surface *surface, SDL_Rect *rect)
     rect->h = h;
 }
 
+/*
+ * Makes a SIMD fill of whole rows of a Surface with aligned, padded rows
+ * one run over the rows and their padding, see pygame_PoolRowAlign, so the
+ * fill has no unaligned start or scalar tail in any row.
+ */
+static void
+surface_fill_whole_rows (SDL_Surface *surface, SDL_Rect *rect,
+                         SDL_BlitInfo *info)
+{
+    if (rect->x == 0 && rect->w == surface->w &&
+        (size_t) surface->pitch * rect->h / 4 <= INT_MAX &&
+        pygame_PoolRowAlign (surface) >= 16)
+    {
+        info->width = surface->pitch / 4 * rect->h;
+        info->height = 1;
+        info->d_skip = 0;
+    }
+}
+
+/*
+ * Does a plain fill of a 32 bit software surface with the SIMD fill, with
+ * rect clipped to the clip rect as SDL_FillRect does. Returns -1 if there
+ * is no SIMD fill for the surface, so the caller must use SDL_FillRect.
+ */
+int
+surface_fill_simd (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
+{
+    SDL_Rect *clip = &surface->clip_rect;
+    SDL_BlitInfo info;
+    int x, y, w, h;
+
+    if (!pg_blitters.fill_32 || surface->format->BytesPerPixel != 4 ||
+        surface->flags & SDL_HWSURFACE)
+        return -1;
+
+    x = MAX (rect->x, clip->x);
+    y = MAX (rect->y, clip->y);
+    w = MIN (rect->x + rect->w, clip->x + clip->w) - x;
+    h = MIN (rect->y + rect->h, clip->y + clip->h) - y;
+    rect->x = x;
+    rect->y = y;
+    rect->w = w > 0 ? w : 0;
+    rect->h = h > 0 ? h : 0;
+    if (w <= 0 || h <= 0)
+        return 0;
+
+    if (SDL_MUSTLOCK (surface) && SDL_LockSurface (surface) < 0)
+        return -1;
+
+    info.width = w;
+    info.height = h;
+    info.s_pixels = (Uint8 *) &color;
+    info.s_pxskip = 0;
+    info.s_skip = 0;
+    info.d_pixels = (Uint8 *) surface->pixels + surface->offset +
+        y * surface->pitch + x * 4;
+    info.d_pxskip = 4;
+    info.d_skip = surface->pitch - w * 4;
+    info.src = surface->format;
+    info.dst = surface->format;
+    info.src_flags = surface->flags;
+    info.dst_flags = surface->flags;
+    info.s_rle = NULL;
+    surface_fill_whole_rows (surface, rect, &info);
+    pg_blitters.fill_32 (&info);
+
+    if (SDL_MUSTLOCK (surface))
+        SDL_UnlockSurface (surface);
+    return 0;
+}
+
+/*
+ * Does a 16 bit blend fill with pygame_Blend16, as a blit from a single
+ * source pixel. Returns -1 if the format is not one it handles.
+ */
+static int
+surface_fill_blend_16 (SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
+                       int op)
+{
+    SDL_BlitInfo info;
+    Uint16 color16 = (Uint16) color;
+
+    info.width = rect->w;
+    info.height = rect->h;
+    info.s_pixels = (Uint8 *) &color16;
+    info.s_pxskip = 0;
+    info.s_skip = 0;
+    info.d_pixels = (Uint8 *) surface->pixels + surface->offset +
+        (Uint16) rect->y * surface->pitch + (Uint16) rect->x * 2;
+    info.d_pxskip = 2;
+    info.d_skip = surface->pitch - rect->w * 2;
+    info.src = surface->format;
+    info.dst = surface->format;
+    info.src_flags = surface->flags;
+    info.dst_flags = surface->flags;
+    info.s_rle = NULL;
+    return pygame_Blend16 (&info, op);
+}
+
+/*
+ * Does a 32 bit blend fill with the SIMD blend blitters, as a blit from a
+ * single source pixel; see PgBlendMasks, or a 16 bit one with
+ * surface_fill_blend_16. Returns -1 if the format is not one they handle,
+ * so the caller must do the fill itself.
+ */
+static int
+surface_fill_blend_simd (SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
+                         int op, int rgba)
+{
+    SDL_PixelFormat *fmt = surface->format;
+    SDL_BlitInfo info;
+    PgBlendMasks masks;
+    Uint32 rgbmask = fmt->Rmask | fmt->Gmask | fmt->Bmask;
+    int ppa = (surface->flags & SDL_SRCALPHA && fmt->Amask);
+
+    if (fmt->BytesPerPixel == 2 && !rgba)
+        return surface_fill_blend_16 (surface, rect, color, op);
+
+    if (!pg_blitters.blend[op] || fmt->BytesPerPixel != 4 ||
+        fmt->Rmask != (Uint32) 0xFF << fmt->Rshift ||
+        fmt->Gmask != (Uint32) 0xFF << fmt->Gshift ||
+        fmt->Bmask != (Uint32) 0xFF << fmt->Bshift)
+        return -1;
+
+    if (rgba)
+    {
+        /* Only called with per-pixel alpha */
+        if (fmt->Amask != ~rgbmask)
+            return -1;
+        masks.sor = 0;
+        masks.rmask = 0xFFFFFFFF;
+        masks.dmask = 0;
+        masks.dor = 0;
+    }
+    else
+    {
+        masks.sor = 0;
+        masks.rmask = rgbmask;
+        masks.dmask = ppa ? ~rgbmask : 0;
+        masks.dor = ppa ? 0 : fmt->Amask;
+    }
+
+    if (rect->w <= 0 || rect->h <= 0)
+        return 0;
+
+    info.width = rect->w;
+    info.height = rect->h;
+    info.s_pixels = (Uint8 *) &color;
+    info.s_pxskip = 0;
+    info.s_skip = 0;
+    info.d_pixels = (Uint8 *) surface->pixels + surface->offset +
+        (Uint16) rect->y * surface->pitch + (Uint16) rect->x * 4;
+    info.d_pxskip = 4;
+    info.d_skip = surface->pitch - rect->w * 4;
+    info.src = fmt;
+    info.dst = fmt;
+    info.src_flags = surface->flags;
+    info.dst_flags = surface->flags;
+    info.s_rle = NULL;
+    surface_fill_whole_rows (surface, rect, &info);
+    pg_blitters.blend[op] (&info, &masks);
+    return 0;
+}
+
 static int
 surface_fill_blend_add (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
 {
@@ -91,6 +256,11 @@ surface_fill_blend_add (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
     int result = -1;
     int ppa = (surface->flags & SDL_SRCALPHA && fmt->Amask);
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_ADD, 0))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -177,6 +347,11 @@ surface_fill_blend_sub (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
     int result = -1;
     int ppa = (surface->flags & SDL_SRCALPHA && fmt->Amask);
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_SUB, 0))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -262,6 +437,11 @@ surface_fill_blend_mult (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
     int result = -1;
     int ppa = (surface->flags & SDL_SRCALPHA && fmt->Amask);
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_MULT, 0))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -347,6 +527,11 @@ surface_fill_blend_min (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
     int result = -1;
     int ppa = (surface->flags & SDL_SRCALPHA && fmt->Amask);
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_MIN, 0))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -432,6 +617,11 @@ surface_fill_blend_max (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
     int result = -1;
     int ppa = (surface->flags & SDL_SRCALPHA && fmt->Amask);
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_MAX, 0))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -526,6 +716,11 @@ surface_fill_blend_rgba_add (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
         return surface_fill_blend_add (surface, rect, color);
     }
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_ADD, 1))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -595,6 +790,11 @@ surface_fill_blend_rgba_sub (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
         return surface_fill_blend_sub (surface, rect, color);
     }
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_SUB, 1))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -663,6 +863,11 @@ surface_fill_blend_rgba_mult (SDL_Surface *surface, SDL_Rect *rect, Uint32 color
         return surface_fill_blend_mult (surface, rect, color);
     }
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_MULT, 1))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -731,6 +936,11 @@ surface_fill_blend_rgba_min (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
         return surface_fill_blend_min (surface, rect, color);
     }
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_MIN, 1))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
@@ -799,6 +1009,11 @@ surface_fill_blend_rgba_max (SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
         return surface_fill_blend_max (surface, rect, color);
     }
 
+    if (!surface_fill_blend_simd (surface, rect, color, PYGAME_BLEND_MAX, 1))
+    {
+        return 0;
+    }
+
     pixels = (Uint8 *) surface->pixels + surface->offset +
         (Uint16) rect->y * surface->pitch + (Uint16) rect->x * bpp;
     skip = surface->pitch - width * bpp;
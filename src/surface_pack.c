@@ -0,0 +1,533 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * Surface.compress. The pixels of a compressed Surface are kept in a fast
+ * LZ77 code in the manner of LZ4, and its SDL Surface has no pixels until
+ * they are used. PySurface_Prep decodes them for reading, as for the
+ * source of a blit, and PySurface_Unshare, which PySurface_Lock calls,
+ * decodes them for changing. Decoded Surfaces are kept in a list, most
+ * recently used first, and the least recently used give up their pixels
+ * again to keep the decoded bytes within a limit. Pixels that may have
+ * changed are compressed again first. Surfaces that are locked, or
+ * between PySurface_Prep and PySurface_Unprep, keep theirs. All of it runs
+ * with the GIL held.
+ */
+#define NO_PYGAME_C_API
+#include "_surface.h"
+
+#define PG_PACK_HASH_BITS 14
+#define PG_PACK_MIN_MATCH 4
+#define PG_PACK_LAST_LITERALS 5     /* a match stops this far from the end */
+#define PG_PACK_MAX_OFFSET 0xffff
+
+typedef struct PgPack
+{
+    PgPackedPixels base;
+    PySurfaceObject *obj;
+    Uint8 *data;                /* the compressed pixels */
+    size_t size;
+    int changed;                /* the pixels may differ from data */
+    struct PgPack *prev, *next; /* in the decoded list, if decoded */
+} PgPack;
+
+static PgPack *pack_first, *pack_last;
+static size_t pack_limit = 64 * 1024 * 1024;
+static PgPackStats pack_stats;
+static Uint32 pack_table[1 << PG_PACK_HASH_BITS];
+
+/* The most bytes _pack_encode can write for n bytes */
+static size_t
+_pack_bound (size_t n)
+{
+    return n + n / 255 + 16;
+}
+
+/* A sequence length that did not fit in its 4 bits */
+static Uint8 *
+_pack_put_length (Uint8 *out, size_t length)
+{
+    while (length >= 255)
+    {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = (Uint8) length;
+    return out;
+}
+
+static Uint8 *
+_pack_put_literals (Uint8 *out, Uint8 *token, const Uint8 *src, size_t count)
+{
+    *token = (Uint8) ((count < 15 ? count : 15) << 4);
+    if (count >= 15)
+        out = _pack_put_length (out, count - 15);
+    memcpy (out, src, count);
+    return out + count;
+}
+
+/* Compress n bytes of src into dst, which has room for _pack_bound (n)
+ * bytes, and return the compressed size. Each sequence is a token with
+ * the count of literal bytes in the high 4 bits and the match length less
+ * 4 in the low 4, either continued in bytes of 255 and a last byte below
+ * it when 15, then the literals, then the match offset as 2 bytes, low
+ * byte first. The last sequence is only literals.
+ */
+static size_t
+_pack_encode (const Uint8 *src, size_t n, Uint8 *dst)
+{
+    const Uint8 *ip = src, *anchor = src, *ref;
+    const Uint8 *end = src + n;
+    const Uint8 *matchlimit = end - PG_PACK_LAST_LITERALS;
+    const Uint8 *limit = end - PG_PACK_LAST_LITERALS - PG_PACK_MIN_MATCH;
+    Uint8 *op = dst, *token;
+    size_t length;
+    Uint32 sequence, hash, offset;
+
+    if (n <= PG_PACK_LAST_LITERALS + PG_PACK_MIN_MATCH)
+    {
+        token = op++;
+        return _pack_put_literals (op, token, src, n) - dst;
+    }
+
+    memset (pack_table, 0, sizeof (pack_table));
+    while (ip < limit)
+    {
+        memcpy (&sequence, ip, 4);
+        hash = (sequence * 2654435761U) >> (32 - PG_PACK_HASH_BITS);
+        ref = src + pack_table[hash];
+        pack_table[hash] = (Uint32) (ip - src);
+        offset = (Uint32) (ip - ref);
+        if (!offset || offset > PG_PACK_MAX_OFFSET || memcmp (ref, ip, 4))
+        {
+            /* step faster through bytes that do not compress */
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+        }
+
+        length = PG_PACK_MIN_MATCH;
+        while (ip + length < matchlimit && ref[length] == ip[length])
+            length++;
+
+        token = op++;
+        op = _pack_put_literals (op, token, anchor, ip - anchor);
+        *op++ = (Uint8) offset;
+        *op++ = (Uint8) (offset >> 8);
+        length -= PG_PACK_MIN_MATCH;
+        *token |= (Uint8) (length < 15 ? length : 15);
+        if (length >= 15)
+            op = _pack_put_length (op, length - 15);
+
+        ip += length + PG_PACK_MIN_MATCH;
+        anchor = ip;
+    }
+
+    token = op++;
+    return _pack_put_literals (op, token, anchor, end - anchor) - dst;
+}
+
+/* Decode what _pack_encode made into the n bytes of dst. Returns -1 if the
+ * code does not fill dst exactly.
+ */
+static int
+_pack_decode (const Uint8 *src, size_t size, Uint8 *dst, size_t n)
+{
+    const Uint8 *ip = src, *end = src + size;
+    Uint8 *op = dst, *oend = dst + n, *ref;
+    size_t count, length, offset;
+    Uint8 token, byte;
+
+    while (ip < end)
+    {
+        token = *ip++;
+        count = token >> 4;
+        if (count == 15)
+        {
+            do
+            {
+                if (ip == end)
+                    return -1;
+                byte = *ip++;
+                count += byte;
+            }
+            while (byte == 255);
+        }
+        if (count > (size_t) (end - ip) || count > (size_t) (oend - op))
+            return -1;
+        memcpy (op, ip, count);
+        op += count;
+        ip += count;
+        if (ip == end)
+            break;
+
+        if (end - ip < 2)
+            return -1;
+        offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        length = token & 15;
+        if (length == 15)
+        {
+            do
+            {
+                if (ip == end)
+                    return -1;
+                byte = *ip++;
+                length += byte;
+            }
+            while (byte == 255);
+        }
+        length += PG_PACK_MIN_MATCH;
+        if (!offset || offset > (size_t) (op - dst) ||
+            length > (size_t) (oend - op))
+            return -1;
+
+        ref = op - offset;
+        if (offset >= length)
+        {
+            memcpy (op, ref, length);
+            op += length;
+        }
+        else
+        {
+            /* the match repeats the bytes it is copying */
+            while (length--)
+                *op++ = *ref++;
+        }
+    }
+    return op == oend ? 0 : -1;
+}
+
+static size_t
+_pack_bytes (SDL_Surface *surf)
+{
+    return (size_t) surf->pitch * surf->h;
+}
+
+static void
+_pack_link (PgPack *pack)
+{
+    pack->prev = NULL;
+    pack->next = pack_first;
+    if (pack_first)
+        pack_first->prev = pack;
+    else
+        pack_last = pack;
+    pack_first = pack;
+}
+
+static void
+_pack_unlink (PgPack *pack)
+{
+    if (pack->prev)
+        pack->prev->next = pack->next;
+    else
+        pack_first = pack->next;
+    if (pack->next)
+        pack->next->prev = pack->prev;
+    else
+        pack_last = pack->prev;
+    pack->prev = pack->next = NULL;
+}
+
+/* Compress pixels, with the pitch and height of the Surface, into the
+ * data of pack. Returns -1 if out of memory, with the data left as it was.
+ */
+static int
+_pack_encode_pixels (PgPack *pack, const Uint8 *pixels)
+{
+    size_t bytes = _pack_bytes (pack->obj->surf);
+    size_t size;
+    Uint8 *data, *smaller;
+
+    data = PyMem_Malloc (_pack_bound (bytes));
+    if (!data)
+        return -1;
+    size = _pack_encode (pixels, bytes, data);
+    smaller = PyMem_Realloc (data, size);
+    if (smaller)
+        data = smaller;
+
+    PyMem_Free (pack->data);
+    pack_stats.packed_bytes += size;
+    pack_stats.packed_bytes -= pack->size;
+    pack->data = data;
+    pack->size = size;
+    pack->changed = 0;
+    pack_stats.encodes++;
+    return 0;
+}
+
+static int
+_pack_in_use (PgPack *pack)
+{
+    PySurfaceObject *obj = pack->obj;
+
+    return (pack->base.pins || obj->selflocks || obj->surf->locked ||
+            obj->subsurfaces ||
+            (obj->locklist && PyList_GET_SIZE (obj->locklist)));
+}
+
+/* Give up the decoded pixels of pack, compressing them again first if
+ * they may have changed. Returns -1 if out of memory, with the pixels
+ * kept.
+ */
+static int
+_pack_forget (PgPack *pack)
+{
+    SDL_Surface *surf = pack->obj->surf;
+
+    if (pack->changed && _pack_encode_pixels (pack, surf->pixels))
+        return -1;
+    SDL_free (surf->pixels);
+    surf->pixels = NULL;
+    _pack_unlink (pack);
+    pack_stats.decoded--;
+    pack_stats.decoded_bytes -= _pack_bytes (surf);
+    return 0;
+}
+
+/* Forget the least recently used pixels not in use, other than those of
+ * keep, until at most limit bytes are decoded.
+ */
+static void
+_pack_trim (size_t limit, PgPack *keep)
+{
+    PgPack *pack = pack_last, *prev;
+
+    while (pack && pack_stats.decoded_bytes > limit)
+    {
+        prev = pack->prev;
+        if (pack != keep && !_pack_in_use (pack))
+            _pack_forget (pack);
+        pack = prev;
+    }
+}
+
+/* PgPackedPixels.unpack: decode the pixels if they are not in memory, and
+ * make them the most recently used. There is no way to report a failure
+ * to the callers, which go on to use the pixels.
+ */
+static void
+_pack_unpack (PyObject *surfobj, int write)
+{
+    PgPack *pack = (PgPack *) ((PySurfaceObject *) surfobj)->packed;
+    SDL_Surface *surf = pack->obj->surf;
+    size_t bytes = _pack_bytes (surf);
+    Uint8 *pixels;
+
+    if (write)
+        pack->changed = 1;
+    if (surf->pixels)
+    {
+        if (pack != pack_first)
+        {
+            _pack_unlink (pack);
+            _pack_link (pack);
+        }
+        return;
+    }
+
+    pixels = SDL_malloc (bytes ? bytes : 1);
+    if (!pixels)
+    {
+        _pack_trim (0, pack);
+        pixels = SDL_malloc (bytes ? bytes : 1);
+        if (!pixels)
+            Py_FatalError ("out of memory decoding a compressed Surface");
+    }
+    if (_pack_decode (pack->data, pack->size, pixels, bytes))
+        Py_FatalError ("the pixels of a compressed Surface are corrupt");
+    surf->pixels = pixels;
+    _pack_link (pack);
+    pack_stats.decoded++;
+    pack_stats.decoded_bytes += bytes;
+    pack_stats.decodes++;
+    _pack_trim (pack_limit, pack);
+}
+
+/* A Surface with no pixels in the format and settings of surf */
+static SDL_Surface *
+_pack_header (SDL_Surface *surf)
+{
+    SDL_PixelFormat *format = surf->format;
+    SDL_Surface *header;
+
+    header = SDL_CreateRGBSurfaceFrom (NULL, surf->w, surf->h,
+                                       format->BitsPerPixel, surf->pitch,
+                                       format->Rmask, format->Gmask,
+                                       format->Bmask, format->Amask);
+    if (!header)
+        return NULL;
+    if (format->palette)
+        SDL_SetColors (header, format->palette->colors, 0,
+                       format->palette->ncolors);
+    SDL_SetClipRect (header, &surf->clip_rect);
+    SDL_SetColorKey (header, surf->flags & SDL_SRCCOLORKEY,
+                     format->colorkey);
+    SDL_SetAlpha (header, surf->flags & SDL_SRCALPHA, format->alpha);
+    return header;
+}
+
+/* Compress the pixels of obj, or if it is compressed already, give up its
+ * decoded pixels now. Returns -1, with the SDL error set, if obj cannot be
+ * compressed, and -2 if out of memory. The compressed size is put in size.
+ */
+int
+pygame_PackSurface (PySurfaceObject *obj, size_t *size)
+{
+    SDL_Surface *surf = obj->surf;
+    SDL_Surface *header;
+    PgPack *pack = (PgPack *) obj->packed;
+
+    if (pack)
+    {
+        if (_pack_in_use (pack))
+        {
+            SDL_SetError ("cannot compress a Surface that is in use");
+            return -1;
+        }
+        if (surf->pixels && _pack_forget (pack))
+            return -2;
+        *size = pack->size;
+        return 0;
+    }
+
+    if (surf == SDL_GetVideoSurface () || obj->subsurface || obj->shared ||
+        obj->dependency || !surf->pixels || surf->refcount > 1 ||
+        surf->flags & (SDL_HWSURFACE | SDL_OPENGL | SDL_RLEACCEL |
+                       SDL_RLEACCELOK))
+    {
+        SDL_SetError ("only software Surfaces with pixels of their own, "
+                      "and without RLEACCEL, can be compressed");
+        return -1;
+    }
+    if (obj->selflocks || surf->locked ||
+        (obj->locklist && PyList_GET_SIZE (obj->locklist)))
+    {
+        SDL_SetError ("cannot compress a locked Surface");
+        return -1;
+    }
+    if (obj->subsurfaces)
+    {
+        SDL_SetError ("cannot compress a Surface with subsurfaces");
+        return -1;
+    }
+
+    /* lazy copies sharing the pixels get their own, and the RLE cache
+       of the old SDL Surface goes */
+    PySurface_DropRLE (obj);
+
+    pack = PyMem_New (PgPack, 1);
+    header = _pack_header (surf);
+    if (!pack || !header)
+    {
+        PyMem_Free (pack);
+        if (header)
+            SDL_FreeSurface (header);
+        return -2;
+    }
+    pack->base.unpack = _pack_unpack;
+    pack->base.pins = 0;
+    pack->obj = obj;
+    pack->data = NULL;
+    pack->size = 0;
+    pack->prev = pack->next = NULL;
+    if (_pack_encode_pixels (pack, surf->pixels))
+    {
+        PyMem_Free (pack);
+        SDL_FreeSurface (header);
+        return -2;
+    }
+
+    obj->surf = header;
+    obj->packed = (PgPackedPixels *) pack;
+    pygame_PoolFreeSurface (surf);
+    pack_stats.packed++;
+    *size = pack->size;
+    return 0;
+}
+
+/* Make obj a Surface with pixels of its own in memory again */
+void
+pygame_PackDrop (PySurfaceObject *obj)
+{
+    PgPack *pack = (PgPack *) obj->packed;
+    SDL_Surface *surf = obj->surf;
+
+    if (!pack)
+        return;
+    _pack_unpack ((PyObject *) obj, 0);
+    _pack_unlink (pack);
+    pack_stats.decoded--;
+    pack_stats.decoded_bytes -= _pack_bytes (surf);
+    pack_stats.packed--;
+    pack_stats.packed_bytes -= pack->size;
+    PyMem_Free (pack->data);
+    PyMem_Free (pack);
+    obj->packed = NULL;
+    /* SDL frees the pixels with the Surface from now on */
+    surf->flags &= ~SDL_PREALLOC;
+}
+
+/* Stop obj being compressed as it is freed */
+void
+pygame_PackRelease (PySurfaceObject *obj)
+{
+    PgPack *pack = (PgPack *) obj->packed;
+    SDL_Surface *surf = obj->surf;
+
+    if (!pack)
+        return;
+    if (surf->pixels)
+    {
+        _pack_unlink (pack);
+        pack_stats.decoded--;
+        pack_stats.decoded_bytes -= _pack_bytes (surf);
+        SDL_free (surf->pixels);
+        surf->pixels = NULL;
+    }
+    pack_stats.packed--;
+    pack_stats.packed_bytes -= pack->size;
+    PyMem_Free (pack->data);
+    PyMem_Free (pack);
+    obj->packed = NULL;
+}
+
+/* Keep at most limit bytes of compressed Surfaces decoded, besides those
+ * in use.
+ */
+void
+pygame_PackSetLimit (size_t limit)
+{
+    pack_limit = limit;
+    _pack_trim (limit, NULL);
+}
+
+size_t
+pygame_PackGetLimit (void)
+{
+    return pack_limit;
+}
+
+void
+pygame_PackGetStats (PgPackStats *stats, int reset)
+{
+    *stats = pack_stats;
+    if (reset)
+        pack_stats.decodes = pack_stats.encodes = 0;
+}
@@ -0,0 +1,433 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * A pool of pixel buffers for software Surfaces, so Surfaces made and
+ * dropped every frame reuse the same memory instead of going through
+ * malloc each time. Buffers are kept in size classes, four to each power
+ * of two, and start on a PG_POOL_ALIGN boundary. A pooled Surface is an
+ * SDL_PREALLOC Surface over a buffer, and must be freed with
+ * pygame_PoolFreeSurface to give the buffer back. Surfaces can also be
+ * made with their rows aligned for SIMD code. The pool is only used with
+ * the GIL held.
+ */
+#define NO_PYGAME_C_API
+#include "_surface.h"
+
+#define PG_POOL_ALIGN 64
+#define PG_POOL_SMALLEST 1024
+#define PG_POOL_LARGEST (64 * 1024 * 1024)
+#define PG_POOL_CLASSES 65      /* PG_POOL_SMALLEST to PG_POOL_LARGEST */
+#define PG_POOL_BUCKETS 256
+
+typedef struct PgPoolBlock
+{
+    struct PgPoolBlock *next;   /* in its idle list, or its used bucket */
+    SDL_Surface *surface;       /* while used */
+    size_t size;                /* of the size class */
+    int cls;
+    Uint8 *pixels;
+} PgPoolBlock;
+
+static PgPoolBlock *pool_idle[PG_POOL_CLASSES];
+static PgPoolBlock *pool_used[PG_POOL_BUCKETS];
+static size_t pool_limit = 32 * 1024 * 1024;
+static size_t pool_largest = 8 * 1024 * 1024;
+static PgPoolStats pool_stats;
+
+/* The size class of size bytes, and the buffer size of the class */
+static int
+_pool_class (size_t size, size_t *classsize)
+{
+    size_t step;
+    int bits = 10, steps;
+
+    if (size <= PG_POOL_SMALLEST)
+    {
+        *classsize = PG_POOL_SMALLEST;
+        return 0;
+    }
+    /* 2 ** bits < size <= 2 ** (bits + 1) */
+    while (((size_t) 2 << bits) < size)
+        bits++;
+    step = (size_t) 1 << (bits - 2);
+    steps = (int) ((size + step - 1) / step);   /* 5 to 8 */
+    *classsize = steps * step;
+    return 1 + (bits - 10) * 4 + (steps - 5);
+}
+
+static PgPoolBlock **
+_pool_bucket (SDL_Surface *surf)
+{
+    return &pool_used[((size_t) surf / sizeof (SDL_Surface)) %
+                      PG_POOL_BUCKETS];
+}
+
+static void
+_pool_drop_largest (void)
+{
+    PgPoolBlock *block;
+    int cls;
+
+    for (cls = PG_POOL_CLASSES - 1; !pool_idle[cls]; cls--)
+        ;
+    block = pool_idle[cls];
+    pool_idle[cls] = block->next;
+    pool_stats.idle--;
+    pool_stats.idle_bytes -= block->size;
+    pool_stats.drops++;
+    free (block);
+}
+
+/* Keep a buffer for reuse, dropping the largest idle buffers to stay in
+ * the limit.
+ */
+static void
+_pool_put (PgPoolBlock *block)
+{
+    if (block->cls < 0 || block->size > pool_limit ||
+        block->size > pool_largest)
+    {
+        pool_stats.drops++;
+        free (block);
+        return;
+    }
+    while (pool_stats.idle_bytes + block->size > pool_limit)
+        _pool_drop_largest ();
+    block->surface = NULL;
+    block->next = pool_idle[block->cls];
+    pool_idle[block->cls] = block;
+    pool_stats.idle++;
+    pool_stats.idle_bytes += block->size;
+}
+
+/* The pitch SDL gives a Surface, or 0 if its pixels are not pooled */
+static int
+_pool_pitch (Uint32 flags, int width, int height, int depth)
+{
+    SDL_Surface *video = SDL_GetVideoSurface ();
+    int pitch;
+
+    /* SDL may put Surfaces in video memory with a hardware display, and
+     * checks the size of the Surfaces it makes itself.
+     */
+    if (!pool_limit || (flags & SDL_HWSURFACE) ||
+        (video && (video->flags & SDL_HWSURFACE)) || depth < 8 ||
+        width <= 0 || height <= 0 || width >= 16384 || height >= 65536)
+        return 0;
+    pitch = (width * ((depth + 7) / 8) + 3) & ~3;
+    if ((size_t) pitch * height > pool_largest)
+        return 0;
+    return pitch;
+}
+
+/* A Surface over a buffer of at least pitch * height bytes, from the pool
+ * if it is within the limits. If clear, the pixels are cleared, as SDL
+ * clears them.
+ */
+static SDL_Surface *
+_pool_surface (int width, int height, int depth, int pitch, Uint32 rmask,
+               Uint32 gmask, Uint32 bmask, Uint32 amask, int clear)
+{
+    SDL_Surface *surf;
+    PgPoolBlock *block = NULL;
+    size_t size = (size_t) pitch * height, classsize = size;
+    int cls = -1;
+
+    if (pool_limit && size <= pool_largest)
+    {
+        cls = _pool_class (size, &classsize);
+        block = pool_idle[cls];
+    }
+    if (block)
+    {
+        pool_idle[cls] = block->next;
+        pool_stats.idle--;
+        pool_stats.idle_bytes -= block->size;
+        pool_stats.hits++;
+    }
+    else
+    {
+        block = (PgPoolBlock *) malloc (sizeof (PgPoolBlock) +
+                                        PG_POOL_ALIGN - 1 + classsize);
+        if (!block)
+        {
+            SDL_SetError ("out of memory");
+            return NULL;
+        }
+        block->size = classsize;
+        block->cls = cls;
+        block->pixels = (Uint8 *)
+            (((size_t) (block + 1) + PG_POOL_ALIGN - 1) &
+             ~(size_t) (PG_POOL_ALIGN - 1));
+        pool_stats.misses++;
+    }
+    if (clear)
+        memset (block->pixels, 0, size);
+
+    surf = SDL_CreateRGBSurfaceFrom (block->pixels, width, height, depth,
+                                     pitch, rmask, gmask, bmask, amask);
+    if (!surf)
+    {
+        _pool_put (block);
+        return NULL;
+    }
+    block->surface = surf;
+    block->next = *_pool_bucket (surf);
+    *_pool_bucket (surf) = block;
+    pool_stats.used++;
+    pool_stats.used_bytes += block->size;
+    return surf;
+}
+
+/* SDL_CreateRGBSurface, with the pixels of software Surfaces from the
+ * pool.
+ */
+SDL_Surface *
+pygame_PoolCreateSurface (Uint32 flags, int width, int height, int depth,
+                          Uint32 rmask, Uint32 gmask, Uint32 bmask,
+                          Uint32 amask)
+{
+    int pitch = _pool_pitch (flags, width, height, depth);
+
+    if (!pitch)
+        return SDL_CreateRGBSurface (flags, width, height, depth,
+                                     rmask, gmask, bmask, amask);
+    return _pool_surface (width, height, depth, pitch,
+                          rmask, gmask, bmask, amask, 1);
+}
+
+/* A software Surface whose rows start on an align byte boundary, align
+ * being a power of two up to PG_POOL_ALIGN. The padding at the end of each
+ * row belongs to the Surface, so SIMD code may write whole align byte
+ * blocks up to the end of a row, see pygame_PoolRowAlign. The pixels are
+ * from the pool if they fit its limits, and are still given back with
+ * pygame_PoolFreeSurface otherwise.
+ */
+SDL_Surface *
+pygame_PoolCreateAligned (int width, int height, int depth, int align,
+                          Uint32 rmask, Uint32 gmask, Uint32 bmask,
+                          Uint32 amask)
+{
+    int pitch;
+
+    if (align < 4 || align > PG_POOL_ALIGN || (align & (align - 1)))
+    {
+        SDL_SetError ("row alignment must be a power of two from 4 to %d",
+                      PG_POOL_ALIGN);
+        return NULL;
+    }
+    if (depth < 8)
+    {
+        SDL_SetError ("aligned Surfaces need a depth of at least 8 bits");
+        return NULL;
+    }
+    if (width < 0 || height < 0 || width >= 16384 || height >= 65536)
+    {
+        SDL_SetError ("Width or height is too large");
+        return NULL;
+    }
+    pitch = (width * ((depth + 7) / 8) + align - 1) & ~(align - 1);
+    return _pool_surface (width, height, depth, pitch,
+                          rmask, gmask, bmask, amask, 1);
+}
+
+/* A software Surface with the given pitch, whose pixels are left as they
+ * are for callers that set all of them.
+ */
+SDL_Surface *
+pygame_PoolCreatePitch (int width, int height, int depth, int pitch,
+                        Uint32 rmask, Uint32 gmask, Uint32 bmask,
+                        Uint32 amask)
+{
+    if (depth < 8 || width < 0 || height < 0 || width >= 16384 ||
+        height >= 65536 || pitch < width * ((depth + 7) / 8))
+    {
+        SDL_SetError ("invalid Surface size or pitch");
+        return NULL;
+    }
+    return _pool_surface (width, height, depth, pitch,
+                          rmask, gmask, bmask, amask, 0);
+}
+
+static PgPoolBlock *
+_pool_find (SDL_Surface *surf)
+{
+    PgPoolBlock *block;
+
+    if (!(surf->flags & SDL_PREALLOC) || !pool_stats.used)
+        return NULL;
+    for (block = *_pool_bucket (surf); block; block = block->next)
+    {
+        if (block->surface == surf)
+            break;
+    }
+    return block;
+}
+
+/* The buffer of a Surface made by the pool, even while its pixels are
+ * elsewhere; NULL for other Surfaces.
+ */
+Uint8 *
+pygame_PoolPixels (SDL_Surface *surf)
+{
+    PgPoolBlock *block = _pool_find (surf);
+
+    return block ? block->pixels : NULL;
+}
+
+/* SDL_FreeSurface, giving the pixels of pooled Surfaces back to the pool.
+ * A Surface SDL still holds keeps its buffer.
+ */
+void
+pygame_PoolFreeSurface (SDL_Surface *surf)
+{
+    PgPoolBlock **link, *block;
+
+    if (!surf)
+        return;
+    if (!(surf->flags & SDL_PREALLOC) || surf->refcount > 1 ||
+        !pool_stats.used)
+    {
+        SDL_FreeSurface (surf);
+        return;
+    }
+    for (link = _pool_bucket (surf); *link; link = &(*link)->next)
+    {
+        if ((*link)->surface == surf)
+            break;
+    }
+    block = *link;
+    SDL_FreeSurface (surf);
+    if (block)
+    {
+        *link = block->next;
+        pool_stats.used--;
+        pool_stats.used_bytes -= block->size;
+        _pool_put (block);
+    }
+}
+
+/* The alignment in bytes of the rows of a Surface made by the pool; 0 for
+ * other Surfaces. The rows may be written in blocks of that size up to the
+ * end of each row, over the padding after the last pixel.
+ */
+int
+pygame_PoolRowAlign (SDL_Surface *surf)
+{
+    int align;
+
+    if (!surf->pitch || !_pool_find (surf))
+        return 0;
+    /* the pixels of lazy copies are elsewhere, see surface_cow.c */
+    align = surf->pitch | (int) ((size_t) surf->pixels & 0xffff);
+    align &= -align;
+    return align < PG_POOL_ALIGN ? align : PG_POOL_ALIGN;
+}
+
+/* SDL_ConvertSurface of a Surface to its own format, with the pixels of
+ * software Surfaces from the pool. Copies of aligned Surfaces keep their
+ * row alignment.
+ */
+SDL_Surface *
+pygame_PoolCopySurface (SDL_Surface *surf)
+{
+    SDL_PixelFormat *format = surf->format;
+    SDL_Surface *copy;
+    Uint8 *src, *dst;
+    int y, rowsize = surf->w * format->BytesPerPixel;
+    int align = pygame_PoolRowAlign (surf);
+
+    if (align && surf->pitch != ((rowsize + 3) & ~3))
+        copy = pygame_PoolCreateAligned (surf->w, surf->h,
+                                         format->BitsPerPixel, align,
+                                         format->Rmask, format->Gmask,
+                                         format->Bmask, format->Amask);
+    else if (surf == SDL_GetVideoSurface () ||
+             !_pool_pitch (surf->flags, surf->w, surf->h,
+                           format->BitsPerPixel))
+        return SDL_ConvertSurface (surf, format, surf->flags);
+    else
+        copy = pygame_PoolCreateSurface (SDL_SWSURFACE, surf->w, surf->h,
+                                         format->BitsPerPixel, format->Rmask,
+                                         format->Gmask, format->Bmask,
+                                         format->Amask);
+    if (!copy)
+        return NULL;
+
+    if (format->palette)
+        SDL_SetColors (copy, format->palette->colors, 0,
+                       format->palette->ncolors);
+    if (SDL_LockSurface (surf) == -1)
+    {
+        pygame_PoolFreeSurface (copy);
+        return NULL;
+    }
+    src = (Uint8 *) surf->pixels;
+    dst = (Uint8 *) copy->pixels;
+    for (y = 0; y < surf->h; y++)
+    {
+        memcpy (dst, src, rowsize);
+        src += surf->pitch;
+        dst += copy->pitch;
+    }
+    SDL_UnlockSurface (surf);
+
+    SDL_SetClipRect (copy, &surf->clip_rect);
+    if (surf->flags & SDL_SRCCOLORKEY)
+        SDL_SetColorKey (copy, surf->flags & (SDL_SRCCOLORKEY | SDL_RLEACCELOK),
+                         format->colorkey);
+    if (surf->flags & SDL_SRCALPHA)
+        SDL_SetAlpha (copy, surf->flags & (SDL_SRCALPHA | SDL_RLEACCELOK),
+                      format->alpha);
+    return copy;
+}
+
+/* Keep at most limit bytes of idle buffers, and pool buffers of at most
+ * largest bytes. A limit of 0 stops the pooling.
+ */
+int
+pygame_PoolSetLimit (size_t limit, size_t largest)
+{
+    if (largest > PG_POOL_LARGEST)
+    {
+        SDL_SetError ("pooled buffers can have at most %d bytes",
+                      PG_POOL_LARGEST);
+        return -1;
+    }
+    pool_limit = limit;
+    pool_largest = largest;
+    while (pool_stats.idle_bytes > pool_limit)
+        _pool_drop_largest ();
+    return 0;
+}
+
+void
+pygame_PoolGetLimit (size_t *limit, size_t *largest)
+{
+    *limit = pool_limit;
+    *largest = pool_largest;
+}
+
+void
+pygame_PoolGetStats (PgPoolStats *stats, int reset)
+{
+    *stats = pool_stats;
+    if (reset)
+        pool_stats.hits = pool_stats.misses = pool_stats.drops = 0;
+}
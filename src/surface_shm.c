@@ -0,0 +1,366 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * Surface pixels in named shared memory, for Surfaces that another
+ * process maps as well. The memory starts with a PgSharedHeader that
+ * describes the pixel format and holds the frame counter, followed by the
+ * pixels at PG_SHARED_PIXELS.
+ */
+#define NO_PYGAME_C_API
+#include "_surface.h"
+
+#if defined(WIN32)
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#define PG_SHARED_MAGIC "pgshm01"
+#define PG_SHARED_PIXELS 64
+#define PG_SHARED_NAME_MAX 200
+
+/* Orders the pixel writes of a frame against the frame counter */
+#if defined(WIN32)
+#define PG_SHARED_BARRIER() MemoryBarrier ()
+#elif defined(__GNUC__)
+#define PG_SHARED_BARRIER() __sync_synchronize ()
+#else
+#define PG_SHARED_BARRIER()
+#endif
+
+typedef struct
+{
+    char magic[8];
+    Uint32 width, height, pitch, depth;
+    Uint32 rmask, gmask, bmask, amask;
+    volatile Uint32 frame;      /* odd while a frame is being drawn */
+} PgSharedHeader;
+
+struct PgSharedPixels
+{
+    PgSharedHeader *header;
+    size_t size;
+#if defined(WIN32)
+    HANDLE mapping;
+#endif
+};
+
+/* The name of the memory for the system, "/name" for shm_open. Linux
+ * shm_open opens the name in /dev/shm, but needs librt before glibc 2.34,
+ * so it is done directly there.
+ */
+static int
+_shared_path (const char *name, char *path, size_t size)
+{
+    size_t len = strlen (name);
+
+    if (len == 0 || len > PG_SHARED_NAME_MAX)
+    {
+        SDL_SetError ("shared memory name must have 1 to %d characters",
+                      PG_SHARED_NAME_MAX);
+        return -1;
+    }
+#if defined(WIN32)
+    strcpy (path, name);
+#else
+    if (strchr (name, '/'))
+    {
+        SDL_SetError ("shared memory name must not contain '/'");
+        return -1;
+    }
+#if defined(__linux__)
+    PyOS_snprintf (path, size, "/dev/shm/%s", name);
+#else
+    PyOS_snprintf (path, size, "/%s", name);
+#endif
+#endif
+    return 0;
+}
+
+static PgSharedPixels *
+_shared_map (const char *name, size_t size, int create)
+{
+    char path[PG_SHARED_NAME_MAX + 16];
+    PgSharedPixels *shm;
+
+    if (_shared_path (name, path, sizeof (path)))
+        return NULL;
+    shm = PyMem_New (PgSharedPixels, 1);
+    if (!shm)
+    {
+        SDL_SetError ("out of memory");
+        return NULL;
+    }
+
+#if defined(WIN32)
+    if (create)
+    {
+        shm->mapping = CreateFileMappingA (INVALID_HANDLE_VALUE, NULL,
+                                           PAGE_READWRITE,
+                                           (DWORD) ((Uint64) size >> 32),
+                                           (DWORD) size, path);
+        if (shm->mapping && GetLastError () == ERROR_ALREADY_EXISTS)
+        {
+            CloseHandle (shm->mapping);
+            shm->mapping = NULL;
+            SDL_SetError ("shared memory '%s' already exists", name);
+            PyMem_Del (shm);
+            return NULL;
+        }
+    }
+    else
+        shm->mapping = OpenFileMappingA (FILE_MAP_ALL_ACCESS, FALSE, path);
+    if (!shm->mapping)
+    {
+        SDL_SetError ("cannot open shared memory '%s'", name);
+        PyMem_Del (shm);
+        return NULL;
+    }
+    shm->header = (PgSharedHeader *) MapViewOfFile (shm->mapping,
+                                                    FILE_MAP_ALL_ACCESS,
+                                                    0, 0, size);
+    if (!shm->header)
+    {
+        SDL_SetError ("cannot map shared memory '%s'", name);
+        CloseHandle (shm->mapping);
+        PyMem_Del (shm);
+        return NULL;
+    }
+    if (!create)
+    {
+        MEMORY_BASIC_INFORMATION info;
+
+        VirtualQuery (shm->header, &info, sizeof (info));
+        size = info.RegionSize;
+    }
+#else
+    {
+        struct stat st;
+        void *map;
+        int fd;
+
+#if defined(__linux__)
+        fd = open (path, create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+#else
+        fd = shm_open (path, create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR,
+                       0600);
+#endif
+        if (fd == -1)
+        {
+            SDL_SetError ("cannot open shared memory '%s': %s", name,
+                          strerror (errno));
+            PyMem_Del (shm);
+            return NULL;
+        }
+        if (create && ftruncate (fd, (off_t) size) == -1)
+        {
+            SDL_SetError ("cannot size shared memory '%s': %s", name,
+                          strerror (errno));
+            close (fd);
+            pygame_SharedUnlink (name);
+            PyMem_Del (shm);
+            return NULL;
+        }
+        if (!create)
+        {
+            if (fstat (fd, &st) == -1)
+                st.st_size = 0;
+            size = (size_t) st.st_size;
+        }
+        map = size ? mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                           fd, 0) : MAP_FAILED;
+        close (fd);
+        if (map == MAP_FAILED)
+        {
+            SDL_SetError ("cannot map shared memory '%s'", name);
+            if (create)
+                pygame_SharedUnlink (name);
+            PyMem_Del (shm);
+            return NULL;
+        }
+        shm->header = (PgSharedHeader *) map;
+    }
+#endif
+    shm->size = size;
+    return shm;
+}
+
+/* Create the shared memory name for pixels of the size and format, with a
+ * frame counter of zero.
+ */
+PgSharedPixels *
+pygame_SharedCreate (const char *name, int width, int height, int depth,
+                     Uint32 rmask, Uint32 gmask, Uint32 bmask, Uint32 amask)
+{
+    PgSharedPixels *shm;
+    PgSharedHeader *header;
+    Uint32 pitch;
+
+    if (width < 0 || height < 0 || width > 65535 || height > 65535 ||
+        (depth != 16 && depth != 24 && depth != 32))
+    {
+        SDL_SetError ("shared Surfaces need a size below 65536 and a 16, 24 "
+                      "or 32 bit depth");
+        return NULL;
+    }
+    pitch = ((Uint32) width * (depth / 8) + 3) & ~3;
+
+    shm = _shared_map (name, PG_SHARED_PIXELS + (size_t) pitch * height, 1);
+    if (!shm)
+        return NULL;
+    header = shm->header;
+    header->width = width;
+    header->height = height;
+    header->pitch = pitch;
+    header->depth = depth;
+    header->rmask = rmask;
+    header->gmask = gmask;
+    header->bmask = bmask;
+    header->amask = amask;
+    header->frame = 0;
+    PG_SHARED_BARRIER ();
+    memcpy (header->magic, PG_SHARED_MAGIC, sizeof (header->magic));
+    return shm;
+}
+
+/* Map existing shared memory, checking it holds what pygame_SharedCreate
+ * made.
+ */
+PgSharedPixels *
+pygame_SharedOpen (const char *name)
+{
+    PgSharedPixels *shm = _shared_map (name, 0, 0);
+    PgSharedHeader *header;
+
+    if (!shm)
+        return NULL;
+    header = shm->header;
+    if (shm->size < PG_SHARED_PIXELS ||
+        memcmp (header->magic, PG_SHARED_MAGIC, sizeof (header->magic)) ||
+        (header->depth != 16 && header->depth != 24 &&
+         header->depth != 32) ||
+        header->pitch < header->width * (header->depth / 8) ||
+        PG_SHARED_PIXELS + (size_t) header->pitch * header->height >
+        shm->size)
+    {
+        SDL_SetError ("shared memory '%s' does not hold a Surface", name);
+        pygame_SharedClose (shm);
+        return NULL;
+    }
+    return shm;
+}
+
+void
+pygame_SharedClose (PgSharedPixels *shm)
+{
+#if defined(WIN32)
+    UnmapViewOfFile (shm->header);
+    CloseHandle (shm->mapping);
+#else
+    munmap ((void *) shm->header, shm->size);
+#endif
+    PyMem_Del (shm);
+}
+
+/* Remove the name. The memory stays with the processes that mapped it,
+ * and is freed when the last of them closes it. Windows frees named
+ * memory with its last handle, so there is nothing to remove.
+ */
+int
+pygame_SharedUnlink (const char *name)
+{
+#if !defined(WIN32)
+    char path[PG_SHARED_NAME_MAX + 16];
+    int result;
+
+    if (_shared_path (name, path, sizeof (path)))
+        return -1;
+#if defined(__linux__)
+    result = unlink (path);
+#else
+    result = shm_unlink (path);
+#endif
+    if (result == -1)
+    {
+        SDL_SetError ("cannot remove shared memory '%s': %s", name,
+                      strerror (errno));
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+/* A Surface over the shared pixels; it does not free them */
+SDL_Surface *
+pygame_SharedSurface (PgSharedPixels *shm)
+{
+    PgSharedHeader *header = shm->header;
+
+    return SDL_CreateRGBSurfaceFrom (((Uint8 *) header) + PG_SHARED_PIXELS,
+                                     header->width, header->height,
+                                     header->depth, header->pitch,
+                                     header->rmask, header->gmask,
+                                     header->bmask, header->amask);
+}
+
+Uint32
+pygame_SharedGetFrame (PgSharedPixels *shm)
+{
+    Uint32 frame = shm->header->frame;
+
+    PG_SHARED_BARRIER ();
+    return frame;
+}
+
+/* Make the frame counter odd, for readers to know the pixels are being
+ * changed.
+ */
+int
+pygame_SharedBeginFrame (PgSharedPixels *shm)
+{
+    if (shm->header->frame & 1)
+    {
+        SDL_SetError ("a frame was begun already");
+        return -1;
+    }
+    shm->header->frame++;
+    PG_SHARED_BARRIER ();
+    return 0;
+}
+
+/* Make the frame counter even again, once the pixels of the frame are in
+ * memory.
+ */
+int
+pygame_SharedEndFrame (PgSharedPixels *shm)
+{
+    if (!(shm->header->frame & 1))
+    {
+        SDL_SetError ("no frame was begun");
+        return -1;
+    }
+    PG_SHARED_BARRIER ();
+    shm->header->frame++;
+    return 0;
+}
@@ -39,6 +39,13 @@ static void
 PySurface_Prep (PyObject* surfobj)
 {
     struct SubSurface_Data* data = ((PySurfaceObject*) surfobj)->subsurface;
+    PgPackedPixels* packed = ((PySurfaceObject*) surfobj)->packed;
+    if (packed)
+    {
+        /* Pinned, the pixels stay decoded until PySurface_Unprep */
+        packed->pins++;
+        packed->unpack (surfobj, 0);
+    }
     if (data)
     {
         SDL_Surface* surf = PySurface_AsSurface (surfobj);
@@ -52,6 +59,9 @@ static void
 PySurface_Unprep (PyObject* surfobj)
 {
     struct SubSurface_Data* data = ((PySurfaceObject*) surfobj)->subsurface;
+    PgPackedPixels* packed = ((PySurfaceObject*) surfobj)->packed;
+    if (packed)
+        packed->pins--;
     if (data)
         PySurface_UnlockBy (data->owner, surfobj);
 }
@@ -74,22 +84,36 @@ PySurface_LockBy (PyObject* surfobj, PyObject* lockobj)
     PyObject *ref;
     PySurfaceObject* surf = (PySurfaceObject*) surfobj;
 
-    if (!surf->locklist)
+    /* The pixels may be changed while locked */
+    PySurface_DropRLE (surfobj);
+
+    if (lockobj == surfobj)
     {
-        surf->locklist = PyList_New (0);
-        if (!surf->locklist)
-            return 0;
+        /* The Surface cannot go away while it holds a lock on itself, so
+         * a count does without the weak reference and list of other
+         * holders, like PixelArray and BufferProxy objects.
+         */
+        surf->selflocks++;
     }
-    ref = PyWeakref_NewRef (lockobj, NULL);
-    if (!ref)
-        return 0;
-    if (ref == Py_None)
+    else
     {
+        if (!surf->locklist)
+        {
+            surf->locklist = PyList_New (0);
+            if (!surf->locklist)
+                return 0;
+        }
+        ref = PyWeakref_NewRef (lockobj, NULL);
+        if (!ref)
+            return 0;
+        if (ref == Py_None)
+        {
+            Py_DECREF (ref);
+            return 0;
+        }
+        PyList_Append (surf->locklist, ref);
         Py_DECREF (ref);
-        return 0;
     }
-    PyList_Append (surf->locklist, ref);
-    Py_DECREF (ref);
 
     if (surf->subsurface)
         PySurface_Prep (surfobj);
@@ -108,6 +132,12 @@ PySurface_UnlockBy (PyObject* surfobj, PyObject* lockobj)
     int found = 0;
     int noerror = 1;
 
+    if (lockobj == surfobj && surf->selflocks > 0)
+    {
+        surf->selflocks--;
+        found = 1;
+    }
+
     if (surf->locklist)
     {
         PyObject *item, *ref;
@@ -0,0 +1,864 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * TileMap: layers of tile ids drawn from an atlas Surface. The map is cut
+ * into chunks, each layer of a chunk rendered once to a Surface of its own
+ * and blitted whole while its tiles stay the same, so drawing a frame is a
+ * blit for each layer of each chunk in view.
+ */
+#include "pygame.h"
+#include "pgcompat.h"
+#include "doc/tilemap_doc.h"
+
+#define TILEMAP_MAX_ID 0xFFFF
+/* Chunks must fit the 16 bit sizes of an SDL_Rect */
+#define TILEMAP_MAX_CHUNK 0x4000
+/* The map must fit an int in pixels */
+#define TILEMAP_MAX_PIXELS 0x40000000
+
+/* The rendered state of a layer of a chunk, 0 so new chunks are dirty */
+enum {
+    CHUNK_DIRTY,
+    CHUNK_EMPTY,                /* no tiles to draw */
+    CHUNK_READY
+};
+
+typedef struct {
+    PyObject_HEAD
+    int cols, rows;             /* the size of the map, in tiles */
+    int tile_w, tile_h;
+    int nlayers;
+    Uint16 *tiles;              /* layer by layer, row by row */
+    PyObject *atlas;
+    int atlas_cols, atlas_count;
+    int chunk_cols, chunk_rows; /* the size of a chunk, in tiles */
+    int chunks_x, chunks_y;
+    PyObject **chunks;          /* layer by layer, NULL until rendered */
+    Uint8 *state;
+    int cache;
+    PY_LONG_LONG renders;       /* chunks rendered */
+    PY_LONG_LONG blits;         /* blits to the Surfaces drawn to */
+} PyTileMapObject;
+
+static PyTypeObject PyTileMap_Type;
+
+#define TILEMAP_TILE(self, layer, x, y)                                 \
+    ((self)->tiles[((Py_ssize_t) (layer) * (self)->rows + (y)) *        \
+                   (self)->cols + (x)])
+#define TILEMAP_CHUNK(self, layer, cx, cy)                              \
+    (((Py_ssize_t) (layer) * (self)->chunks_y + (cy)) * (self)->chunks_x \
+     + (cx))
+
+/* Intersect a with b. Returns 0 when nothing is left. */
+static int
+tilemap_clip (GAME_Rect *a, const GAME_Rect *b)
+{
+    int left = MAX (a->x, b->x);
+    int top = MAX (a->y, b->y);
+    int right = MIN (a->x + a->w, b->x + b->w);
+    int bottom = MIN (a->y + a->h, b->y + b->h);
+
+    if (right <= left || bottom <= top)
+    {
+        a->w = a->h = 0;
+        return 0;
+    }
+    a->x = left;
+    a->y = top;
+    a->w = right - left;
+    a->h = bottom - top;
+    return 1;
+}
+
+static int
+tilemap_check_layer (PyTileMapObject *self, int layer)
+{
+    if (layer < 0 || layer >= self->nlayers)
+    {
+        PyErr_SetString (PyExc_IndexError, "layer out of range");
+        return -1;
+    }
+    return 0;
+}
+
+static int
+tilemap_check_id (long id)
+{
+    if (id < 0 || id > TILEMAP_MAX_ID)
+    {
+        PyErr_SetString (PyExc_ValueError,
+                         "tile id must be between 0 and 65535");
+        return -1;
+    }
+    return 0;
+}
+
+/* The area of a rect style object in tiles, cropped to the map. Returns 0
+ * when it is off the map, -1 with an exception set for a bad object.
+ */
+static int
+tilemap_tile_rect (PyTileMapObject *self, PyObject *obj, GAME_Rect *r)
+{
+    GAME_Rect temp, *given, map = { 0, 0, 0, 0 };
+
+    map.w = self->cols;
+    map.h = self->rows;
+    if (!obj || obj == Py_None)
+    {
+        *r = map;
+        return 1;
+    }
+    if (!(given = GameRect_FromObject (obj, &temp)))
+    {
+        PyErr_SetString (PyExc_TypeError, "rect must be a rect style object");
+        return -1;
+    }
+    *r = *given;
+    return tilemap_clip (r, &map);
+}
+
+/* Mark the chunks holding the tiles of r dirty, in layer or in all layers
+ * for -1
+ */
+static void
+tilemap_dirty (PyTileMapObject *self, int layer, const GAME_Rect *r)
+{
+    int l, cx, cy;
+    int first = layer < 0 ? 0 : layer;
+    int last = layer < 0 ? self->nlayers - 1 : layer;
+
+    if (r->w <= 0 || r->h <= 0)
+        return;
+    for (l = first; l <= last; ++l)
+        for (cy = r->y / self->chunk_rows;
+             cy <= (r->y + r->h - 1) / self->chunk_rows; ++cy)
+            for (cx = r->x / self->chunk_cols;
+                 cx <= (r->x + r->w - 1) / self->chunk_cols; ++cx)
+                self->state[TILEMAP_CHUNK (self, l, cx, cy)] = CHUNK_DIRTY;
+}
+
+/* Take the atlas, and the number of tiles it holds */
+static int
+tilemap_set_atlas (PyTileMapObject *self, PyObject *atlas)
+{
+    SDL_Surface *surf;
+
+    if (!PySurface_Check (atlas))
+    {
+        PyErr_SetString (PyExc_TypeError, "atlas must be a Surface");
+        return -1;
+    }
+    surf = PySurface_AsSurface (atlas);
+    if (!surf)
+    {
+        PyErr_SetString (PyExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    if (surf->w < self->tile_w || surf->h < self->tile_h)
+    {
+        PyErr_SetString (PyExc_ValueError,
+                         "atlas is smaller than one tile");
+        return -1;
+    }
+    Py_INCREF (atlas);
+    Py_XDECREF (self->atlas);
+    self->atlas = atlas;
+    self->atlas_cols = surf->w / self->tile_w;
+    self->atlas_count = self->atlas_cols * (surf->h / self->tile_h);
+    return 0;
+}
+
+/* The area of the atlas that tile id is drawn from */
+static void
+tilemap_atlas_rect (PyTileMapObject *self, int id, SDL_Rect *r)
+{
+    r->x = (Sint16) ((id - 1) % self->atlas_cols * self->tile_w);
+    r->y = (Sint16) ((id - 1) / self->atlas_cols * self->tile_h);
+    r->w = (Uint16) self->tile_w;
+    r->h = (Uint16) self->tile_h;
+}
+
+/* Render a layer of a chunk to its Surface. A chunk with every tile drawn
+ * from an opaque atlas is left opaque, so it is copied when drawn; others
+ * start transparent and are blended. Returns -1 with an exception set.
+ */
+static int
+tilemap_render_chunk (PyTileMapObject *self, int layer, int cx, int cy)
+{
+    Py_ssize_t index = TILEMAP_CHUNK (self, layer, cx, cy);
+    int x0 = cx * self->chunk_cols;
+    int y0 = cy * self->chunk_rows;
+    int x1 = MIN (x0 + self->chunk_cols, self->cols);
+    int y1 = MIN (y0 + self->chunk_rows, self->rows);
+    SDL_Surface *atlas = PySurface_AsSurface (self->atlas);
+    SDL_Surface *surf;
+    SDL_Rect src, dst;
+    int x, y, id, any = 0, full = 1;
+
+    if (!atlas)
+    {
+        PyErr_SetString (PyExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    for (y = y0; y < y1; ++y)
+        for (x = x0; x < x1; ++x)
+        {
+            id = TILEMAP_TILE (self, layer, x, y);
+            if (id && id <= self->atlas_count)
+                any = 1;
+            else
+                full = 0;
+        }
+    if (!any)
+    {
+        self->state[index] = CHUNK_EMPTY;
+        return 0;
+    }
+
+    if (!self->chunks[index])
+    {
+        surf = SDL_CreateRGBSurface (SDL_SWSURFACE,
+                                     self->chunk_cols * self->tile_w,
+                                     self->chunk_rows * self->tile_h, 32,
+                                     0x00ff0000, 0x0000ff00, 0x000000ff,
+                                     0xff000000);
+        if (!surf)
+        {
+            PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+            return -1;
+        }
+        self->chunks[index] = PySurface_New (surf);
+        if (!self->chunks[index])
+        {
+            SDL_FreeSurface (surf);
+            return -1;
+        }
+    }
+    surf = PySurface_AsSurface (self->chunks[index]);
+    if (full && !(atlas->flags & (SDL_SRCALPHA | SDL_SRCCOLORKEY)))
+        SDL_SetAlpha (surf, 0, 255);
+    else
+    {
+        SDL_SetAlpha (surf, SDL_SRCALPHA, 255);
+        SDL_FillRect (surf, NULL, 0);
+    }
+
+    for (y = y0; y < y1; ++y)
+        for (x = x0; x < x1; ++x)
+        {
+            id = TILEMAP_TILE (self, layer, x, y);
+            if (!id || id > self->atlas_count)
+                continue;
+            tilemap_atlas_rect (self, id, &src);
+            dst.x = (Sint16) ((x - x0) * self->tile_w);
+            dst.y = (Sint16) ((y - y0) * self->tile_h);
+            if (PySurface_Blit (self->chunks[index], self->atlas, &dst, &src,
+                                0))
+                return -1;
+        }
+    self->state[index] = CHUNK_READY;
+    ++self->renders;
+    return 0;
+}
+
+static void
+tilemap_dealloc (PyTileMapObject *self)
+{
+    Py_ssize_t i, n;
+
+    if (self->chunks)
+    {
+        n = (Py_ssize_t) self->nlayers * self->chunks_y * self->chunks_x;
+        for (i = 0; i < n; ++i)
+            Py_XDECREF (self->chunks[i]);
+    }
+    PyMem_Free (self->chunks);
+    PyMem_Free (self->state);
+    PyMem_Free (self->tiles);
+    Py_XDECREF (self->atlas);
+    Py_TYPE (self)->tp_free ((PyObject *) self);
+}
+
+static PyObject*
+tilemap_new (PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *sizeobj, *tileobj, *atlas, *chunkobj = NULL;
+    PyTileMapObject *self;
+    int cols, rows, tile_w, tile_h, layers = 1, cache = 1;
+    int chunk_cols = 16, chunk_rows = 16;
+    Py_ssize_t ntiles, nchunks;
+    static char *kwids[] = {"size", "tile_size", "atlas", "layers",
+                            "chunk_size", "cache", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "OOO|iOi", kwids,
+                                      &sizeobj, &tileobj, &atlas, &layers,
+                                      &chunkobj, &cache))
+        return NULL;
+    if (!TwoIntsFromObj (sizeobj, &cols, &rows))
+        return RAISE (PyExc_TypeError, "size must be two numbers");
+    if (!TwoIntsFromObj (tileobj, &tile_w, &tile_h))
+        return RAISE (PyExc_TypeError, "tile_size must be two numbers");
+    if (chunkobj && !TwoIntsFromObj (chunkobj, &chunk_cols, &chunk_rows))
+        return RAISE (PyExc_TypeError, "chunk_size must be two numbers");
+    if (cols < 1 || rows < 1 || tile_w < 1 || tile_h < 1 || layers < 1 ||
+        chunk_cols < 1 || chunk_rows < 1)
+        return RAISE (PyExc_ValueError, "sizes must be positive");
+    if (tile_w > TILEMAP_MAX_CHUNK / chunk_cols ||
+        tile_h > TILEMAP_MAX_CHUNK / chunk_rows)
+        return RAISE (PyExc_ValueError, "chunks are too large");
+    if (cols > TILEMAP_MAX_PIXELS / tile_w ||
+        rows > TILEMAP_MAX_PIXELS / tile_h ||
+        (Py_ssize_t) cols * rows > PY_SSIZE_T_MAX / 2 / layers)
+        return RAISE (PyExc_ValueError, "map is too large");
+
+    self = (PyTileMapObject *) type->tp_alloc (type, 0);
+    if (!self)
+        return NULL;
+    self->cols = cols;
+    self->rows = rows;
+    self->tile_w = tile_w;
+    self->tile_h = tile_h;
+    self->nlayers = layers;
+    self->chunk_cols = chunk_cols;
+    self->chunk_rows = chunk_rows;
+    self->chunks_x = (cols + chunk_cols - 1) / chunk_cols;
+    self->chunks_y = (rows + chunk_rows - 1) / chunk_rows;
+    self->cache = cache;
+    if (tilemap_set_atlas (self, atlas))
+    {
+        Py_DECREF (self);
+        return NULL;
+    }
+
+    ntiles = (Py_ssize_t) layers * rows * cols;
+    nchunks = (Py_ssize_t) layers * self->chunks_y * self->chunks_x;
+    self->tiles = PyMem_New (Uint16, ntiles);
+    self->chunks = PyMem_New (PyObject *, nchunks);
+    self->state = PyMem_New (Uint8, nchunks);
+    if (!self->tiles || !self->chunks || !self->state)
+    {
+        Py_DECREF (self);
+        return PyErr_NoMemory ();
+    }
+    memset (self->tiles, 0, ntiles * sizeof (Uint16));
+    memset (self->chunks, 0, nchunks * sizeof (PyObject *));
+    memset (self->state, CHUNK_DIRTY, nchunks);
+    return (PyObject *) self;
+}
+
+static PyObject*
+tilemap_get_size (PyTileMapObject *self)
+{
+    return Py_BuildValue ("(ii)", self->cols, self->rows);
+}
+
+static PyObject*
+tilemap_get_tile_size (PyTileMapObject *self)
+{
+    return Py_BuildValue ("(ii)", self->tile_w, self->tile_h);
+}
+
+static PyObject*
+tilemap_get_layers (PyTileMapObject *self)
+{
+    return PyInt_FromLong (self->nlayers);
+}
+
+static PyObject*
+tilemap_get_rect (PyTileMapObject *self)
+{
+    return PyRect_New4 (0, 0, self->cols * self->tile_w,
+                        self->rows * self->tile_h);
+}
+
+static PyObject*
+tilemap_get_atlas (PyTileMapObject *self)
+{
+    Py_INCREF (self->atlas);
+    return self->atlas;
+}
+
+static PyObject*
+tilemap_set_atlas_meth (PyTileMapObject *self, PyObject *args)
+{
+    PyObject *atlas;
+    GAME_Rect all;
+
+    if (!PyArg_ParseTuple (args, "O", &atlas) ||
+        tilemap_set_atlas (self, atlas))
+        return NULL;
+    tilemap_tile_rect (self, NULL, &all);
+    tilemap_dirty (self, -1, &all);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+tilemap_get_tile (PyTileMapObject *self, PyObject *args)
+{
+    PyObject *posobj;
+    int layer, x, y;
+
+    if (!PyArg_ParseTuple (args, "iO", &layer, &posobj) ||
+        tilemap_check_layer (self, layer))
+        return NULL;
+    if (!TwoIntsFromObj (posobj, &x, &y))
+        return RAISE (PyExc_TypeError, "pos must be two numbers");
+    if (x < 0 || y < 0 || x >= self->cols || y >= self->rows)
+        return RAISE (PyExc_IndexError, "tile position out of range");
+    return PyInt_FromLong (TILEMAP_TILE (self, layer, x, y));
+}
+
+static PyObject*
+tilemap_set_tile (PyTileMapObject *self, PyObject *args)
+{
+    PyObject *posobj;
+    int layer, x, y;
+    long id;
+    GAME_Rect r;
+
+    if (!PyArg_ParseTuple (args, "iOl", &layer, &posobj, &id) ||
+        tilemap_check_layer (self, layer) || tilemap_check_id (id))
+        return NULL;
+    if (!TwoIntsFromObj (posobj, &x, &y))
+        return RAISE (PyExc_TypeError, "pos must be two numbers");
+    if (x < 0 || y < 0 || x >= self->cols || y >= self->rows)
+        return RAISE (PyExc_IndexError, "tile position out of range");
+    if (TILEMAP_TILE (self, layer, x, y) != id)
+    {
+        TILEMAP_TILE (self, layer, x, y) = (Uint16) id;
+        r.x = x;
+        r.y = y;
+        r.w = r.h = 1;
+        tilemap_dirty (self, layer, &r);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+tilemap_get_layer (PyTileMapObject *self, PyObject *args)
+{
+    PyObject *list, *item;
+    Uint16 *tiles;
+    Py_ssize_t i, n = (Py_ssize_t) self->cols * self->rows;
+    int layer;
+
+    if (!PyArg_ParseTuple (args, "i", &layer) ||
+        tilemap_check_layer (self, layer))
+        return NULL;
+    tiles = &TILEMAP_TILE (self, layer, 0, 0);
+    list = PyList_New (n);
+    if (!list)
+        return NULL;
+    for (i = 0; i < n; ++i)
+    {
+        item = PyInt_FromLong (tiles[i]);
+        if (!item)
+        {
+            Py_DECREF (list);
+            return NULL;
+        }
+        PyList_SET_ITEM (list, i, item);
+    }
+    return list;
+}
+
+static PyObject*
+tilemap_set_layer (PyTileMapObject *self, PyObject *args)
+{
+    PyObject *idsobj, *seq;
+    Uint16 *tiles, *ids;
+    Py_ssize_t i, n = (Py_ssize_t) self->cols * self->rows;
+    int layer, x, y;
+    long id;
+    GAME_Rect r;
+
+    if (!PyArg_ParseTuple (args, "iO", &layer, &idsobj) ||
+        tilemap_check_layer (self, layer))
+        return NULL;
+    seq = PySequence_Fast (idsobj, "ids must be a sequence of integers");
+    if (!seq)
+        return NULL;
+    if (PySequence_Fast_GET_SIZE (seq) != n)
+    {
+        Py_DECREF (seq);
+        return RAISE (PyExc_ValueError,
+                      "ids must hold one id for each tile of the map");
+    }
+
+    /* check every id before changing any */
+    ids = PyMem_New (Uint16, n);
+    if (!ids)
+    {
+        Py_DECREF (seq);
+        return PyErr_NoMemory ();
+    }
+    for (i = 0; i < n; ++i)
+    {
+        id = PyInt_AsLong (PySequence_Fast_GET_ITEM (seq, i));
+        if ((id == -1 && PyErr_Occurred ()) || tilemap_check_id (id))
+        {
+            PyMem_Free (ids);
+            Py_DECREF (seq);
+            return NULL;
+        }
+        ids[i] = (Uint16) id;
+    }
+    Py_DECREF (seq);
+
+    /* only the chunks with changed tiles are rendered again */
+    tiles = &TILEMAP_TILE (self, layer, 0, 0);
+    r.w = r.h = 1;
+    for (y = 0; y < self->rows; ++y)
+        for (x = 0; x < self->cols; ++x)
+        {
+            i = (Py_ssize_t) y * self->cols + x;
+            if (tiles[i] == ids[i])
+                continue;
+            tiles[i] = ids[i];
+            r.x = x;
+            r.y = y;
+            tilemap_dirty (self, layer, &r);
+        }
+    PyMem_Free (ids);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+tilemap_fill (PyTileMapObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *rectobj = NULL;
+    GAME_Rect r;
+    int layer, x, y, found;
+    long id;
+    static char *kwids[] = {"layer", "id", "rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "il|O", kwids, &layer,
+                                      &id, &rectobj) ||
+        tilemap_check_layer (self, layer) || tilemap_check_id (id))
+        return NULL;
+    found = tilemap_tile_rect (self, rectobj, &r);
+    if (found < 0)
+        return NULL;
+    if (!found)
+        Py_RETURN_NONE;
+    for (y = r.y; y < r.y + r.h; ++y)
+        for (x = r.x; x < r.x + r.w; ++x)
+            TILEMAP_TILE (self, layer, x, y) = (Uint16) id;
+    tilemap_dirty (self, layer, &r);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+tilemap_mark_dirty (PyTileMapObject *self, PyObject *args)
+{
+    PyObject *rectobj = NULL;
+    GAME_Rect r;
+    int found;
+
+    if (!PyArg_ParseTuple (args, "|O", &rectobj))
+        return NULL;
+    found = tilemap_tile_rect (self, rectobj, &r);
+    if (found < 0)
+        return NULL;
+    if (found)
+        tilemap_dirty (self, -1, &r);
+    Py_RETURN_NONE;
+}
+
+/* Blit the part of the chunks, or of the tiles without the cache, of a
+ * layer in area of the map, each at its place in the map moved by offx and
+ * offy.
+ */
+static int
+tilemap_draw_layer (PyTileMapObject *self, PyObject *surface, int layer,
+                    const GAME_Rect *area, int offx, int offy)
+{
+    GAME_Rect part;
+    SDL_Rect src, dst;
+    PyObject *chunk;
+    Py_ssize_t index;
+    int cx, cy, x, y, id;
+    int cw = self->chunk_cols * self->tile_w;
+    int ch = self->chunk_rows * self->tile_h;
+
+    if (!self->cache)
+    {
+        for (y = area->y / self->tile_h;
+             y <= (area->y + area->h - 1) / self->tile_h; ++y)
+            for (x = area->x / self->tile_w;
+                 x <= (area->x + area->w - 1) / self->tile_w; ++x)
+            {
+                id = TILEMAP_TILE (self, layer, x, y);
+                if (!id || id > self->atlas_count)
+                    continue;
+                part.x = x * self->tile_w;
+                part.y = y * self->tile_h;
+                part.w = self->tile_w;
+                part.h = self->tile_h;
+                tilemap_clip (&part, area);
+                tilemap_atlas_rect (self, id, &src);
+                src.x += (Sint16) (part.x - x * self->tile_w);
+                src.y += (Sint16) (part.y - y * self->tile_h);
+                src.w = (Uint16) part.w;
+                src.h = (Uint16) part.h;
+                dst.x = (Sint16) (part.x + offx);
+                dst.y = (Sint16) (part.y + offy);
+                if (PySurface_Blit (surface, self->atlas, &dst, &src, 0))
+                    return -1;
+                ++self->blits;
+            }
+        return 0;
+    }
+
+    for (cy = area->y / ch; cy <= (area->y + area->h - 1) / ch; ++cy)
+        for (cx = area->x / cw; cx <= (area->x + area->w - 1) / cw; ++cx)
+        {
+            index = TILEMAP_CHUNK (self, layer, cx, cy);
+            if (self->state[index] == CHUNK_DIRTY &&
+                tilemap_render_chunk (self, layer, cx, cy))
+                return -1;
+            if (self->state[index] == CHUNK_EMPTY)
+                continue;
+            chunk = self->chunks[index];
+            part.x = cx * cw;
+            part.y = cy * ch;
+            part.w = cw;
+            part.h = ch;
+            tilemap_clip (&part, area);
+            src.x = (Sint16) (part.x - cx * cw);
+            src.y = (Sint16) (part.y - cy * ch);
+            src.w = (Uint16) part.w;
+            src.h = (Uint16) part.h;
+            dst.x = (Sint16) (part.x + offx);
+            dst.y = (Sint16) (part.y + offy);
+            if (PySurface_Blit (surface, chunk, &dst, &src, 0))
+                return -1;
+            ++self->blits;
+        }
+    return 0;
+}
+
+static PyObject*
+tilemap_draw (PyTileMapObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *surface, *viewobj = Py_None, *destobj = NULL;
+    PyObject *layerobj = Py_None;
+    GAME_Rect temp, *given, view, seen, clip;
+    SDL_Surface *surf;
+    int destx = 0, desty = 0, layer, first, last;
+    static char *kwids[] = {"surface", "viewport", "dest", "layer", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O!|OOO", kwids,
+                                      &PySurface_Type, &surface, &viewobj,
+                                      &destobj, &layerobj))
+        return NULL;
+    surf = PySurface_AsSurface (surface);
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    if (destobj && !TwoIntsFromObj (destobj, &destx, &desty))
+        return RAISE (PyExc_TypeError, "dest must be two numbers");
+    first = 0;
+    last = self->nlayers - 1;
+    if (layerobj != Py_None)
+    {
+        if (!IntFromObj (layerobj, &layer))
+            return RAISE (PyExc_TypeError, "layer must be an integer");
+        if (tilemap_check_layer (self, layer))
+            return NULL;
+        first = last = layer;
+    }
+
+    view.x = view.y = 0;
+    view.w = self->cols * self->tile_w;
+    view.h = self->rows * self->tile_h;
+    if (viewobj != Py_None)
+    {
+        if (!(given = GameRect_FromObject (viewobj, &temp)))
+            return RAISE (PyExc_TypeError, "viewport must be a rect style "
+                          "object");
+        view = *given;
+    }
+
+    /* only what is on the map, in the viewport and in the clip rect of the
+     * Surface, where the viewport is shown from dest, is drawn */
+    seen.x = seen.y = 0;
+    seen.w = self->cols * self->tile_w;
+    seen.h = self->rows * self->tile_h;
+    clip.x = surf->clip_rect.x - destx + view.x;
+    clip.y = surf->clip_rect.y - desty + view.y;
+    clip.w = surf->clip_rect.w;
+    clip.h = surf->clip_rect.h;
+    if (!tilemap_clip (&seen, &view) || !tilemap_clip (&seen, &clip))
+        return PyRect_New4 (destx, desty, 0, 0);
+
+    for (layer = first; layer <= last; ++layer)
+        if (tilemap_draw_layer (self, surface, layer, &seen, destx - view.x,
+                                desty - view.y))
+            return NULL;
+    return PyRect_New4 (destx + seen.x - view.x, desty + seen.y - view.y,
+                        seen.w, seen.h);
+}
+
+static PyObject*
+tilemap_get_draw_count (PyTileMapObject *self, PyObject *args)
+{
+    PyObject *result;
+    int reset = 0;
+
+    if (!PyArg_ParseTuple (args, "|i", &reset))
+        return NULL;
+    result = Py_BuildValue ("(LL)", self->renders, self->blits);
+    if (result && reset)
+        self->renders = self->blits = 0;
+    return result;
+}
+
+static PyMethodDef tilemap_methods[] =
+{
+    { "get_size", (PyCFunction) tilemap_get_size, METH_NOARGS,
+      DOC_TILEMAPGETSIZE },
+    { "get_tile_size", (PyCFunction) tilemap_get_tile_size, METH_NOARGS,
+      DOC_TILEMAPGETTILESIZE },
+    { "get_layers", (PyCFunction) tilemap_get_layers, METH_NOARGS,
+      DOC_TILEMAPGETLAYERS },
+    { "get_rect", (PyCFunction) tilemap_get_rect, METH_NOARGS,
+      DOC_TILEMAPGETRECT },
+    { "get_atlas", (PyCFunction) tilemap_get_atlas, METH_NOARGS,
+      DOC_TILEMAPGETATLAS },
+    { "set_atlas", (PyCFunction) tilemap_set_atlas_meth, METH_VARARGS,
+      DOC_TILEMAPSETATLAS },
+    { "get_tile", (PyCFunction) tilemap_get_tile, METH_VARARGS,
+      DOC_TILEMAPGETTILE },
+    { "set_tile", (PyCFunction) tilemap_set_tile, METH_VARARGS,
+      DOC_TILEMAPSETTILE },
+    { "get_layer", (PyCFunction) tilemap_get_layer, METH_VARARGS,
+      DOC_TILEMAPGETLAYER },
+    { "set_layer", (PyCFunction) tilemap_set_layer, METH_VARARGS,
+      DOC_TILEMAPSETLAYER },
+    { "fill", (PyCFunction) tilemap_fill, METH_VARARGS | METH_KEYWORDS,
+      DOC_TILEMAPFILL },
+    { "mark_dirty", (PyCFunction) tilemap_mark_dirty, METH_VARARGS,
+      DOC_TILEMAPMARKDIRTY },
+    { "draw", (PyCFunction) tilemap_draw, METH_VARARGS | METH_KEYWORDS,
+      DOC_TILEMAPDRAW },
+    { "get_draw_count", (PyCFunction) tilemap_get_draw_count, METH_VARARGS,
+      DOC_TILEMAPGETDRAWCOUNT },
+    { NULL, NULL, 0, NULL }
+};
+
+static PyTypeObject PyTileMap_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "pygame.tilemap.TileMap",           /* tp_name */
+    sizeof (PyTileMapObject),           /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor) tilemap_dealloc,       /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_compare */
+    0,                                  /* tp_repr */
+    0,                                  /* tp_as_number */
+    0,                                  /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash */
+    0,                                  /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* tp_flags */
+    DOC_PYGAMETILEMAPTILEMAP,           /* Documentation string */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    0,                                  /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    tilemap_methods,                    /* tp_methods */
+    0,                                  /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    tilemap_new,                        /* tp_new */
+};
+
+static PyMethodDef _tilemap_methods[] =
+{
+    { NULL, NULL, 0, NULL }
+};
+
+MODINIT_DEFINE (tilemap)
+{
+    PyObject *module;
+
+#if PY3
+    static struct PyModuleDef _module = {
+        PyModuleDef_HEAD_INIT,
+        "tilemap",
+        DOC_PYGAMETILEMAP,
+        -1,
+        _tilemap_methods,
+        NULL, NULL, NULL, NULL
+    };
+#endif
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
+    import_pygame_rect ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
+    import_pygame_surface ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
+    if (PyType_Ready (&PyTileMap_Type) < 0) {
+        MODINIT_ERROR;
+    }
+
+    /* create the module */
+#if PY3
+    module = PyModule_Create (&_module);
+#else
+    module = Py_InitModule3 (MODPREFIX "tilemap", _tilemap_methods,
+                             DOC_PYGAMETILEMAP);
+#endif
+    if (!module) {
+        MODINIT_ERROR;
+    }
+    Py_INCREF ((PyObject *) &PyTileMap_Type);
+    if (PyModule_AddObject (module, "TileMap",
+                            (PyObject *) &PyTileMap_Type)) {
+        Py_DECREF ((PyObject *) &PyTileMap_Type);
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
+    MODINIT_RETURN (module);
+}
@@ -23,19 +23,294 @@
 #include "pygame.h"
 #include "pgcompat.h"
 #include "doc/time_doc.h"
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include <time.h>
+#include <SDL_thread.h>
 
 #define WORST_CLOCK_ACCURACY 12
-static SDL_TimerID event_timers[SDL_NUMEVENTS] = {NULL};
+
+/* Frames Clock.get_frame_stats covers */
+#define CLOCK_STATS_WINDOW 128
+/* Seconds tick_precise first spins for, and the most it ever will */
+#define CLOCK_START_MARGIN 0.002
+#define CLOCK_MAX_MARGIN 0.020
+/* Timers of set_timer and add_timer, in a hierarchical timer wheel that a
+ * single SDL timer drives. Level 0 has a slot for each of the next 256
+ * milliseconds and each level above 64 slots of 64 times the span of the
+ * slots below; a timer moves down a level when the wheel comes round to
+ * its slot. Expired timers are posted in batches of WHEEL_BATCH.
+ */
+#define WHEEL_LEVEL0_BITS 8
+#define WHEEL_LEVEL_BITS 6
+#define WHEEL_LEVELS 5
+#define WHEEL_SLOTS ((1 << WHEEL_LEVEL0_BITS) + \
+                     (WHEEL_LEVELS - 1) * (1 << WHEEL_LEVEL_BITS))
+#define WHEEL_BATCH 64
+/* The low bits of a timer id index the timer */
+#define WHEEL_INDEX_BITS 16
+#define WHEEL_MAX_TIMERS (1 << WHEEL_INDEX_BITS)
+
+typedef struct
+{
+    unsigned long id;           /* 0 when free */
+    Uint32 expires;             /* in wheel milliseconds */
+    Uint32 interval;
+    int loops;                  /* posts left, 0 for no end */
+    int type;
+    PyObject *event;            /* Event posted, or NULL for a bare type */
+    int slot;                   /* -1 when not in the wheel */
+    int prev, next;             /* in a slot, or the dead or free list */
+} WheelTimer;
+
+static struct
+{
+    SDL_mutex *lock;            /* held for all below but driver */
+    SDL_TimerID driver;
+    WheelTimer *timers;
+    int size;
+    int free;                   /* unused timers */
+    int dead;                   /* finished timers still holding an event */
+    int heads[WHEEL_SLOTS];
+    Uint32 now;                 /* milliseconds the wheel has turned */
+    Uint32 last_ticks;          /* SDL_GetTicks () at now */
+    int objects;                /* timers with an event */
+    unsigned long serial;
+} wheel = {NULL, NULL, NULL, 0, -1, -1};
+
+static unsigned long event_timers[SDL_NUMEVENTS] = {0};
+
+static int
+wheel_slot (Uint32 expires)
+{
+    Uint32 delta = expires - wheel.now;
+    int level, shift;
+
+    if (delta < (1U << WHEEL_LEVEL0_BITS))
+        return expires & ((1 << WHEEL_LEVEL0_BITS) - 1);
+    for (level = 1, shift = WHEEL_LEVEL0_BITS;
+         level < WHEEL_LEVELS - 1 &&
+             delta >= (1U << (shift + WHEEL_LEVEL_BITS));
+         ++level, shift += WHEEL_LEVEL_BITS)
+        ;
+    return (1 << WHEEL_LEVEL0_BITS) + (level - 1) * (1 << WHEEL_LEVEL_BITS) +
+        ((expires >> shift) & ((1 << WHEEL_LEVEL_BITS) - 1));
+}
+
+static void
+wheel_insert (int i)
+{
+    WheelTimer *t = wheel.timers + i;
+    int slot = wheel_slot (t->expires);
+
+    t->slot = slot;
+    t->prev = -1;
+    t->next = wheel.heads[slot];
+    if (t->next >= 0)
+        wheel.timers[t->next].prev = i;
+    wheel.heads[slot] = i;
+}
+
+static void
+wheel_unlink (int i)
+{
+    WheelTimer *t = wheel.timers + i;
+
+    if (t->prev >= 0)
+        wheel.timers[t->prev].next = t->next;
+    else
+        wheel.heads[t->slot] = t->next;
+    if (t->next >= 0)
+        wheel.timers[t->next].prev = t->prev;
+    t->slot = -1;
+}
+
+/* Return timer i to the free list, handing back its event */
+static PyObject*
+wheel_release (int i)
+{
+    WheelTimer *t = wheel.timers + i;
+    PyObject *event = t->event;
+
+    if (event)
+        wheel.objects--;
+    t->event = NULL;
+    t->id = 0;
+    t->next = wheel.free;
+    wheel.free = i;
+    return event;
+}
+
+/* Move the timers of a slot above level 0 down to where they now go */
+static void
+wheel_cascade (int slot)
+{
+    int i = wheel.heads[slot], next;
+
+    wheel.heads[slot] = -1;
+    while (i >= 0)
+    {
+        next = wheel.timers[i].next;
+        wheel_insert (i);
+        i = next;
+    }
+}
+
+/* The batch of expired timers the driver is posting, and whether it holds
+ * the GIL to post them
+ */
+static SDL_Event wheel_events[WHEEL_BATCH];
+static PyObject *wheel_objects[WHEEL_BATCH];
+static int wheel_count = 0;
+static int wheel_gil = 0;
+#ifdef WITH_THREAD
+static PyGILState_STATE wheel_gil_state;
+#endif
+
+/* Take the lock, and the GIL before it if timers have events */
+static void
+wheel_lock (void)
+{
+    SDL_LockMutex (wheel.lock);
+#ifdef WITH_THREAD
+    if (wheel.objects && !wheel_gil)
+    {
+        SDL_UnlockMutex (wheel.lock);
+        wheel_gil_state = PyGILState_Ensure ();
+        wheel_gil = 1;
+        SDL_LockMutex (wheel.lock);
+    }
+#endif
+}
+
+/* Post the batch; called without the lock */
+static void
+wheel_flush (void)
+{
+    int i, n = 0;
+
+    for (i = 0; i < wheel_count; ++i)
+    {
+        if (wheel_objects[i])
+        {
+            if (PyEvent_FillUserEvent ((PyEventObject *) wheel_objects[i],
+                                       wheel_events + i))
+                PyErr_Clear ();
+            else
+                wheel_events[n++] = wheel_events[i];
+            Py_DECREF (wheel_objects[i]);
+        }
+        else
+            wheel_events[n++] = wheel_events[i];
+    }
+    if (n && SDL_WasInit (SDL_INIT_VIDEO))
+        SDL_PeepEvents (wheel_events, n, SDL_ADDEVENT, 0);
+    wheel_count = 0;
+}
+
+static void
+wheel_post (WheelTimer *t)
+{
+    SDL_Event *event = wheel_events + wheel_count;
+
+    memset (event, 0, sizeof (SDL_Event));
+    event->type = t->type;
+    /* wheel_lock took the GIL if there are events */
+    Py_XINCREF (t->event);
+    wheel_objects[wheel_count++] = t->event;
+    if (wheel_count == WHEEL_BATCH)
+    {
+        SDL_UnlockMutex (wheel.lock);
+        wheel_flush ();
+        wheel_lock ();
+    }
+}
+
+/* Turn the wheel one millisecond, posting the timers expiring; called
+ * with the lock.
+ */
+static void
+wheel_step (void)
+{
+    WheelTimer *t;
+    Uint32 now = ++wheel.now;
+    int level, shift, index, i;
+
+    for (level = 1, shift = WHEEL_LEVEL0_BITS; level < WHEEL_LEVELS;
+         ++level, shift += WHEEL_LEVEL_BITS)
+    {
+        /* Only when the level below has come round */
+        if (now & ((1U << shift) - 1))
+            break;
+        index = (now >> shift) & ((1 << WHEEL_LEVEL_BITS) - 1);
+        wheel_cascade ((1 << WHEEL_LEVEL0_BITS) +
+                       (level - 1) * (1 << WHEEL_LEVEL_BITS) + index);
+    }
+
+    /* The lock may be let go while posting, so take each timer afresh */
+    index = now & ((1 << WHEEL_LEVEL0_BITS) - 1);
+    while ((i = wheel.heads[index]) >= 0)
+    {
+        t = wheel.timers + i;
+        wheel_unlink (i);
+        if (t->loops != 1)
+        {
+            if (t->loops)
+                t->loops--;
+            t->expires += t->interval;
+            wheel_insert (i);
+        }
+        else if (t->event)
+        {
+            t->next = wheel.dead;
+            wheel.dead = i;
+        }
+        else
+            wheel_release (i);
+        /* Released timers keep their type */
+        wheel_post (wheel.timers + i);
+    }
+}
 
 static Uint32
-timer_callback (Uint32 interval, void* param)
+wheel_callback (Uint32 interval, void* param)
 {
-    if (SDL_WasInit (SDL_INIT_VIDEO))
+    PyObject *event;
+    Uint32 ticks;
+    int i;
+
+    wheel_lock ();
+    ticks = SDL_GetTicks ();
+    while (wheel.last_ticks != ticks)
     {
-        SDL_Event event;
-        memset (&event, 0, sizeof (event));
-        event.type = (intptr_t) param;
-        SDL_PushEvent (&event);
+        wheel.last_ticks++;
+        wheel_step ();
+    }
+    SDL_UnlockMutex (wheel.lock);
+    wheel_flush ();
+
+    /* Drop the events of finished timers outside the lock */
+    if (wheel_gil)
+    {
+        for (;;)
+        {
+            SDL_LockMutex (wheel.lock);
+            i = wheel.dead;
+            if (i >= 0)
+            {
+                wheel.dead = wheel.timers[i].next;
+                event = wheel_release (i);
+            }
+            SDL_UnlockMutex (wheel.lock);
+            if (i < 0)
+                break;
+            Py_DECREF (event);
+        }
+#ifdef WITH_THREAD
+        wheel_gil = 0;
+        PyGILState_Release (wheel_gil_state);
+#endif
     }
     return interval;
 }
@@ -76,6 +351,68 @@ accurate_delay (int ticks)
     return SDL_GetTicks () - funcstart;
 }
 
+/* Nanoseconds from an arbitrary start, as precise as the platform allows */
+static PY_LONG_LONG
+precise_clock_ns (void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER now;
+
+    if (!frequency.QuadPart)
+        QueryPerformanceFrequency (&frequency);
+    QueryPerformanceCounter (&now);
+    /* In two parts, so the counter can not overflow times 10**9 */
+    return (now.QuadPart / frequency.QuadPart) * 1000000000 +
+        (now.QuadPart % frequency.QuadPart) * 1000000000 /
+        frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (PY_LONG_LONG) now.tv_sec * 1000000000 + now.tv_nsec;
+#else
+    return (PY_LONG_LONG) SDL_GetTicks () * 1000000;
+#endif
+}
+
+/* The same in seconds */
+static double
+precise_clock (void)
+{
+    return precise_clock_ns () * 1e-9;
+}
+
+/* Wait until target, sleeping while more than margin seconds are left
+ * and spinning for the rest. margin follows how late SDL_Delay wakes:
+ * straight up to a later wake-up, slowly back down otherwise. Call
+ * without the GIL.
+ */
+static void
+precise_delay (double target, double *margin)
+{
+    double now, late;
+    int ms;
+
+    for (;;)
+    {
+        now = precise_clock ();
+        ms = (int) ((target - now - *margin) * 1000.0);
+        if (ms < 1)
+            break;
+        SDL_Delay ((Uint32) ms);
+        late = precise_clock () - now - ms / 1000.0;
+        if (late < 0.0)
+            late = 0.0;
+        if (late > *margin)
+            *margin = late < CLOCK_MAX_MARGIN ? late : CLOCK_MAX_MARGIN;
+        else
+            *margin += (late - *margin) / 16.0;
+    }
+    while (precise_clock () < target)
+        ;
+}
+
 static PyObject*
 time_get_ticks (PyObject* self)
 {
@@ -84,6 +421,12 @@ time_get_ticks (PyObject* self)
     return PyInt_FromLong (SDL_GetTicks ());
 }
 
+static PyObject*
+time_get_ticks_ns (PyObject* self)
+{
+    return PyLong_FromLongLong (precise_clock_ns ());
+}
+
 static PyObject*
 time_delay (PyObject* self, PyObject* arg)
 {
@@ -142,12 +485,149 @@ time_wait (PyObject* self, PyObject* arg)
     return PyInt_FromLong (SDL_GetTicks () - start);
 }
 
+static void
+wheel_quit (void)
+{
+    WheelTimer *timers = wheel.timers;
+    int size = wheel.size, i;
+
+    if (wheel.driver)
+    {
+        /* The driver may be waiting for the GIL */
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_RemoveTimer (wheel.driver);
+        Py_END_ALLOW_THREADS;
+        wheel.driver = NULL;
+    }
+    memset (event_timers, 0, sizeof (event_timers));
+    wheel.timers = NULL;
+    wheel.size = 0;
+    wheel.free = -1;
+    wheel.dead = -1;
+    wheel.objects = 0;
+    for (i = 0; i < WHEEL_SLOTS; ++i)
+        wheel.heads[i] = -1;
+    for (i = 0; i < size; ++i)
+        Py_XDECREF (timers[i].event);
+    PyMem_Del (timers);
+}
+
+/* Start a timer posting event, or a bare event of type, every millis
+ * milliseconds, loops times or for ever. Returns its id, or 0 with an
+ * exception set.
+ */
+static unsigned long
+wheel_add (int type, PyObject *event, Uint32 millis, int loops)
+{
+    static int registered = 0;
+    WheelTimer *t, *timers;
+    int size, i;
+
+    if (!wheel.lock)
+    {
+        wheel.lock = SDL_CreateMutex ();
+        if (!wheel.lock)
+        {
+            RAISE (PyExc_SDLError, SDL_GetError ());
+            return 0;
+        }
+        for (i = 0; i < WHEEL_SLOTS; ++i)
+            wheel.heads[i] = -1;
+    }
+    if (!registered)
+    {
+        PyGame_RegisterQuit (wheel_quit);
+        registered = 1;
+    }
+    if (!wheel.driver)
+    {
+        wheel.last_ticks = SDL_GetTicks ();
+        wheel.driver = SDL_AddTimer (1, wheel_callback, NULL);
+        if (!wheel.driver)
+        {
+            RAISE (PyExc_SDLError, SDL_GetError ());
+            return 0;
+        }
+    }
+
+    SDL_LockMutex (wheel.lock);
+    if (wheel.free < 0)
+    {
+        size = wheel.size ? wheel.size * 2 : 64;
+        if (wheel.size == WHEEL_MAX_TIMERS)
+        {
+            SDL_UnlockMutex (wheel.lock);
+            RAISE (PyExc_SDLError, "too many timers");
+            return 0;
+        }
+        timers = wheel.timers;
+        if (!PyMem_Resize (timers, WheelTimer, size))
+        {
+            SDL_UnlockMutex (wheel.lock);
+            PyErr_NoMemory ();
+            return 0;
+        }
+        for (i = size - 1; i >= wheel.size; --i)
+        {
+            timers[i].id = 0;
+            timers[i].event = NULL;
+            timers[i].slot = -1;
+            timers[i].next = wheel.free;
+            wheel.free = i;
+        }
+        wheel.timers = timers;
+        wheel.size = size;
+    }
+    i = wheel.free;
+    t = wheel.timers + i;
+    wheel.free = t->next;
+    do
+        t->id = (++wheel.serial << WHEEL_INDEX_BITS) | i;
+    while (!t->id);
+    /* The wheel may be up to a driver period behind */
+    t->expires = wheel.now + (SDL_GetTicks () - wheel.last_ticks) + millis;
+    t->interval = millis;
+    t->loops = loops;
+    t->type = type;
+    t->event = event;
+    if (event)
+    {
+        Py_INCREF (event);
+        wheel.objects++;
+    }
+    wheel_insert (i);
+    SDL_UnlockMutex (wheel.lock);
+    return t->id;
+}
+
+/* Stop timer id; returns 1, or 0 for no such timer */
+static int
+wheel_cancel (unsigned long id)
+{
+    PyObject *event = NULL;
+    int i = (int) (id & (WHEEL_MAX_TIMERS - 1)), found = 0;
+
+    if (!wheel.lock)
+        return 0;
+    SDL_LockMutex (wheel.lock);
+    if (i < wheel.size && wheel.timers[i].id == id &&
+        wheel.timers[i].slot >= 0)
+    {
+        wheel_unlink (i);
+        event = wheel_release (i);
+        found = 1;
+    }
+    SDL_UnlockMutex (wheel.lock);
+    Py_XDECREF (event);
+    return found;
+}
+
 static PyObject*
 time_set_timer (PyObject* self, PyObject* arg)
 {
-    SDL_TimerID newtimer;
+    unsigned long id;
     int ticks = 0;
-    intptr_t event = SDL_NOEVENT;
+    int event = SDL_NOEVENT;
     if (!PyArg_ParseTuple (arg, "ii", &event, &ticks))
         return NULL;
 
@@ -158,8 +638,8 @@ time_set_timer (PyObject* self, PyObject* arg)
     /*stop original timer*/
     if (event_timers[event])
     {
-        SDL_RemoveTimer (event_timers[event]);
-        event_timers[event] = NULL;
+        wheel_cancel (event_timers[event]);
+        event_timers[event] = 0;
     }
 
     if (ticks <= 0)
@@ -172,14 +652,77 @@ time_set_timer (PyObject* self, PyObject* arg)
             return RAISE (PyExc_SDLError, SDL_GetError ());
     }
 
-    newtimer = SDL_AddTimer (ticks, timer_callback, (void*) event);
-    if (!newtimer)
-        return RAISE (PyExc_SDLError, SDL_GetError ());
-    event_timers[event] = newtimer;
+    id = wheel_add (event, NULL, (Uint32) ticks, 0);
+    if (!id)
+        return NULL;
+    event_timers[event] = id;
 
     Py_RETURN_NONE;
 }
 
+static PyObject*
+time_add_timer (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyObject *event;
+    unsigned long id;
+    int millis, loops = 0, type;
+    static char *kwids[] = {"event", "millis", "loops", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "Oi|i", kwids, &event,
+                                      &millis, &loops))
+        return NULL;
+
+    if (PyEvent_Check (event))
+    {
+#ifdef WITH_THREAD
+        type = ((PyEventObject *) event)->type;
+#if PY_VERSION_HEX < 0x03070000
+        PyEval_InitThreads ();
+#endif
+#else
+        return RAISE (PyExc_NotImplementedError,
+                      "timers for Event objects need Python threads");
+#endif
+    }
+    else if (IntFromObj (event, &type))
+    {
+        if (type <= SDL_NOEVENT || type >= SDL_NUMEVENTS)
+            return RAISE (PyExc_ValueError,
+                          "Event id must be between NOEVENT(0) and "
+                          "NUMEVENTS(32)");
+        event = NULL;
+    }
+    else
+        return RAISE (PyExc_TypeError,
+                      "add_timer requires an event id or an Event");
+    if (millis <= 0)
+        return RAISE (PyExc_ValueError, "millis must be positive");
+    if (loops < 0)
+        return RAISE (PyExc_ValueError, "loops must not be negative");
+
+    /*just doublecheck that timer is initialized*/
+    if (!SDL_WasInit (SDL_INIT_TIMER))
+    {
+        if (SDL_InitSubSystem (SDL_INIT_TIMER))
+            return RAISE (PyExc_SDLError, SDL_GetError ());
+    }
+
+    id = wheel_add (type, event, (Uint32) millis, loops);
+    if (!id)
+        return NULL;
+    return PyLong_FromUnsignedLong (id);
+}
+
+static PyObject*
+time_cancel_timer (PyObject* self, PyObject* arg)
+{
+    unsigned long id = PyLong_AsUnsignedLong (arg);
+
+    if (id == (unsigned long) -1 && PyErr_Occurred ())
+        return NULL;
+    return PyBool_FromLong (wheel_cancel (id));
+}
+
 /*clock object interface*/
 typedef struct
 {
@@ -189,20 +732,56 @@ typedef struct
     float fps;
     int timepassed, rawpassed;
     PyObject* rendered;
+    double last_time;           /* precise_clock () at the last tick */
+    double margin;              /* seconds tick_precise spins for */
+    float frame_times[CLOCK_STATS_WINDOW]; /* milliseconds, a ring */
+    int frame_count;            /* frames recorded, at most the window */
+    int frame_next;             /* where the next frame goes */
 } PyClockObject;
 
+/* How the tick functions wait out the rest of a frame */
+enum
+{
+    CLOCK_SDL_DELAY,
+    CLOCK_BUSY_LOOP,
+    CLOCK_PRECISE
+};
+
 // to be called by the other tick functions.
 static PyObject*
-clock_tick_base(PyObject* self, PyObject* arg, int use_accurate_delay)
+clock_tick_base(PyObject* self, PyObject* arg, int pacing)
 {
     PyClockObject* _clock = (PyClockObject*) self;
     float framerate = 0.0f;
     int nowtime;
+    double now, target;
 
     if (!PyArg_ParseTuple (arg, "|f", &framerate))
         return NULL;
 
-    if (framerate)
+    if (framerate && pacing == CLOCK_PRECISE)
+    {
+        /*just doublecheck that timer is initialized*/
+        if (!SDL_WasInit (SDL_INIT_TIMER))
+        {
+            if (SDL_InitSubSystem (SDL_INIT_TIMER))
+            {
+                RAISE (PyExc_SDLError, SDL_GetError ());
+                return NULL;
+            }
+        }
+
+        now = precise_clock ();
+        _clock->rawpassed = (int) ((now - _clock->last_time) * 1000.0);
+        target = _clock->last_time + 1.0 / framerate;
+        if (target > now)
+        {
+            Py_BEGIN_ALLOW_THREADS;
+            precise_delay (target, &_clock->margin);
+            Py_END_ALLOW_THREADS;
+        }
+    }
+    else if (framerate)
     {
         int delay, endtime = (int) ((1.0f / framerate) * 1000.0f);
         _clock->rawpassed = SDL_GetTicks () - _clock->last_tick;
@@ -218,7 +797,7 @@ clock_tick_base(PyObject* self, PyObject* arg, int use_accurate_delay)
             }
         }
 
-        if (use_accurate_delay)
+        if (pacing == CLOCK_BUSY_LOOP)
             delay = accurate_delay (delay);
         else
         {
@@ -235,6 +814,14 @@ clock_tick_base(PyObject* self, PyObject* arg, int use_accurate_delay)
             return NULL;
     }
 
+    now = precise_clock ();
+    _clock->frame_times[_clock->frame_next] =
+        (float) ((now - _clock->last_time) * 1000.0);
+    _clock->frame_next = (_clock->frame_next + 1) % CLOCK_STATS_WINDOW;
+    if (_clock->frame_count < CLOCK_STATS_WINDOW)
+        _clock->frame_count++;
+    _clock->last_time = now;
+
     nowtime = SDL_GetTicks ();
     _clock->timepassed = nowtime - _clock->last_tick;
     _clock->fps_count += 1;
@@ -261,13 +848,57 @@ clock_tick_base(PyObject* self, PyObject* arg, int use_accurate_delay)
 static PyObject*
 clock_tick (PyObject* self, PyObject* arg)
 {
-    return clock_tick_base (self, arg, 0);
+    return clock_tick_base (self, arg, CLOCK_SDL_DELAY);
 }
 
 static PyObject*
 clock_tick_busy_loop (PyObject* self, PyObject* arg)
 {
-    return clock_tick_base (self, arg, 1);
+    return clock_tick_base (self, arg, CLOCK_BUSY_LOOP);
+}
+
+static PyObject*
+clock_tick_precise (PyObject* self, PyObject* arg)
+{
+    return clock_tick_base (self, arg, CLOCK_PRECISE);
+}
+
+static int
+compare_floats (const void *a, const void *b)
+{
+    float x = *(const float *) a, y = *(const float *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+static PyObject*
+clock_get_frame_stats (PyObject* self)
+{
+    PyClockObject* _clock = (PyClockObject*) self;
+    float times[CLOCK_STATS_WINDOW];
+    int n = _clock->frame_count, i;
+    double total = 0.0;
+
+    if (!n)
+        return Py_BuildValue ("{sisdsdsdsdsdsdsd}",
+                              "frames", 0, "min", 0.0, "max", 0.0,
+                              "mean", 0.0, "median", 0.0, "p95", 0.0,
+                              "p99", 0.0, "margin", _clock->margin * 1000.0);
+
+    /* The ring is full, or filled from 0 */
+    memcpy (times, _clock->frame_times, n * sizeof (float));
+    qsort (times, n, sizeof (float), compare_floats);
+    for (i = 0; i < n; ++i)
+        total += times[i];
+    return Py_BuildValue ("{sisdsdsdsdsdsdsd}",
+                          "frames", n,
+                          "min", (double) times[0],
+                          "max", (double) times[n - 1],
+                          "mean", total / n,
+                          "median", (double) times[(n - 1) / 2],
+                          "p95", (double) times[(int) ((n - 1) * 0.95 + 0.5)],
+                          "p99", (double) times[(int) ((n - 1) * 0.99 + 0.5)],
+                          "margin", _clock->margin * 1000.0);
 }
 
 static PyObject*
@@ -303,6 +934,10 @@ static struct PyMethodDef clock_methods[] =
       DOC_CLOCKGETRAWTIME },
     { "tick_busy_loop", clock_tick_busy_loop, METH_VARARGS,
       DOC_CLOCKTICKBUSYLOOP },
+    { "tick_precise", clock_tick_precise, METH_VARARGS,
+      DOC_CLOCKTICKPRECISE },
+    { "get_frame_stats", (PyCFunction) clock_get_frame_stats, METH_NOARGS,
+      DOC_CLOCKGETFRAMESTATS },
     { NULL, NULL, 0, NULL}
 };
 
@@ -390,19 +1025,293 @@ ClockInit (PyObject* self)
     _clock->fps = 0.0f;
     _clock->fps_count = 0;
     _clock->rendered = NULL;
+    _clock->last_time = precise_clock ();
+    _clock->margin = CLOCK_START_MARGIN;
+    _clock->frame_count = 0;
+    _clock->frame_next = 0;
 
     return (PyObject*) _clock;
 }
 
+/*profiler object interface*/
+typedef struct
+{
+    PyObject *name;             /* NULL for an end without a name */
+    PY_LONG_LONG time;          /* precise_clock_ns () */
+    Uint32 thread;
+    char phase;                 /* 'B' or 'E', as in Chrome traces */
+} ProfilerSpan;
+
+typedef struct
+{
+    PyObject_HEAD
+    ProfilerSpan *spans;        /* a ring of size */
+    Py_ssize_t size;
+    Py_ssize_t count;           /* spans recorded, at most size */
+    Py_ssize_t next;            /* where the next span goes */
+    unsigned long dropped;      /* oldest spans written over */
+    PY_LONG_LONG start;         /* time 0 of the trace */
+} PyProfilerObject;
+
+static void
+profiler_clear_spans (PyProfilerObject* prof)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < prof->count; ++i)
+        Py_CLEAR (prof->spans[i].name);
+    prof->count = 0;
+    prof->next = 0;
+    prof->dropped = 0;
+}
+
+static PyObject*
+profiler_record (PyObject* self, PyObject* name, char phase)
+{
+    PyProfilerObject* prof = (PyProfilerObject*) self;
+    ProfilerSpan *span = prof->spans + prof->next;
+    PY_LONG_LONG now = precise_clock_ns ();
+
+    if (prof->count == prof->size)
+    {
+        Py_XDECREF (span->name);
+        prof->dropped++;
+    }
+    else
+        prof->count++;
+    Py_XINCREF (name);
+    span->name = name;
+    span->time = now;
+    span->thread = SDL_ThreadID ();
+    span->phase = phase;
+    prof->next = (prof->next + 1) % prof->size;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+profiler_begin (PyObject* self, PyObject* name)
+{
+    return profiler_record (self, name, 'B');
+}
+
+static PyObject*
+profiler_end (PyObject* self, PyObject* args)
+{
+    PyObject* name = NULL;
+
+    if (!PyArg_ParseTuple (args, "|O", &name))
+        return NULL;
+    return profiler_record (self, name == Py_None ? NULL : name, 'E');
+}
+
+static PyObject*
+profiler_clear (PyObject* self)
+{
+    PyProfilerObject* prof = (PyProfilerObject*) self;
+
+    profiler_clear_spans (prof);
+    prof->start = precise_clock_ns ();
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+profiler_get_events (PyObject* self)
+{
+    PyProfilerObject* prof = (PyProfilerObject*) self;
+    ProfilerSpan *span;
+    PyObject *list, *event;
+    Py_ssize_t i, first;
+
+    list = PyList_New (prof->count);
+    if (!list)
+        return NULL;
+    first = prof->count == prof->size ? prof->next : 0;
+    for (i = 0; i < prof->count; ++i)
+    {
+        span = prof->spans + (first + i) % prof->size;
+        event = Py_BuildValue ("{sssdsisk}",
+                               "ph", span->phase == 'B' ? "B" : "E",
+                               "ts", (span->time - prof->start) / 1000.0,
+                               "pid", 0,
+                               "tid", (unsigned long) span->thread);
+        if (event && span->name &&
+            PyDict_SetItemString (event, "name", span->name))
+            Py_CLEAR (event);
+        if (!event)
+        {
+            Py_DECREF (list);
+            return NULL;
+        }
+        PyList_SET_ITEM (list, i, event);
+    }
+    return list;
+}
+
+static PyObject*
+profiler_to_json (PyObject* self)
+{
+    PyObject *json, *events, *trace, *text = NULL;
+
+    json = PyImport_ImportModule ("json");
+    if (!json)
+        return NULL;
+    events = profiler_get_events (self);
+    if (!events)
+    {
+        Py_DECREF (json);
+        return NULL;
+    }
+    trace = Py_BuildValue ("{sN}", "traceEvents", events);
+    if (trace)
+    {
+        text = PyObject_CallMethod (json, "dumps", "O", trace);
+        Py_DECREF (trace);
+    }
+    Py_DECREF (json);
+    return text;
+}
+
+static PyObject*
+profiler_get_dropped (PyObject* self)
+{
+    PyProfilerObject* prof = (PyProfilerObject*) self;
+    return PyLong_FromUnsignedLong (prof->dropped);
+}
+
+static Py_ssize_t
+profiler_length (PyObject* self)
+{
+    return ((PyProfilerObject*) self)->count;
+}
+
+/* profiler object internals */
+
+static struct PyMethodDef profiler_methods[] =
+{
+    { "begin", profiler_begin, METH_O, DOC_PROFILERBEGIN },
+    { "end", profiler_end, METH_VARARGS, DOC_PROFILEREND },
+    { "clear", (PyCFunction) profiler_clear, METH_NOARGS, DOC_PROFILERCLEAR },
+    { "get_events", (PyCFunction) profiler_get_events, METH_NOARGS,
+      DOC_PROFILERGETEVENTS },
+    { "to_json", (PyCFunction) profiler_to_json, METH_NOARGS,
+      DOC_PROFILERTOJSON },
+    { "get_dropped", (PyCFunction) profiler_get_dropped, METH_NOARGS,
+      DOC_PROFILERGETDROPPED },
+    { NULL, NULL, 0, NULL}
+};
+
+static PySequenceMethods profiler_as_sequence =
+{
+    profiler_length,            /* length */
+    0,                          /* concat */
+    0,                          /* repeat */
+    0,                          /* item */
+    0,                          /* slice */
+    0,                          /* ass_item */
+    0,                          /* ass_slice */
+    0,                          /* contains */
+};
+
+static void
+profiler_dealloc (PyObject* self)
+{
+    PyProfilerObject* prof = (PyProfilerObject*) self;
+
+    if (prof->spans)
+    {
+        profiler_clear_spans (prof);
+        PyMem_Del (prof->spans);
+    }
+    PyObject_DEL (self);
+}
+
+static PyTypeObject PyProfiler_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "Profiler",                 /* name */
+    sizeof(PyProfilerObject),   /* basic size */
+    0,                          /* itemsize */
+    profiler_dealloc,           /* dealloc */
+    0,                          /* print */
+    0,                          /* getattr */
+    0,                          /* setattr */
+    0,                          /* compare */
+    0,                          /* repr */
+    0,                          /* as_number */
+    &profiler_as_sequence,      /* as_sequence */
+    0,                          /* as_mapping */
+    (hashfunc)0,                /* hash */
+    (ternaryfunc)0,             /* call */
+    0,                          /* str */
+    0,                          /* tp_getattro */
+    0,                          /* tp_setattro */
+    0,                          /* tp_as_buffer */
+    0,                          /* flags */
+    DOC_PYGAMETIMEPROFILER,     /* Documentation string */
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    profiler_methods,           /* tp_methods */
+    0,                          /* tp_members */
+    0,                          /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                          /* tp_alloc */
+    0,                          /* tp_new */
+};
+
+static PyObject*
+ProfilerInit (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyProfilerObject* prof;
+    Py_ssize_t size = 4096;
+    static char *kwids[] = {"size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|n", kwids, &size))
+        return NULL;
+    if (size < 1)
+        return RAISE (PyExc_ValueError, "size must be positive");
+
+    prof = PyObject_NEW (PyProfilerObject, &PyProfiler_Type);
+    if (!prof)
+        return NULL;
+    prof->spans = PyMem_New (ProfilerSpan, size);
+    if (!prof->spans)
+    {
+        PyObject_DEL (prof);
+        return PyErr_NoMemory ();
+    }
+    prof->size = size;
+    prof->count = 0;
+    prof->next = 0;
+    prof->dropped = 0;
+    prof->start = precise_clock_ns ();
+    return (PyObject*) prof;
+}
+
 static PyMethodDef _time_methods[] =
 {
     { "get_ticks", (PyCFunction) time_get_ticks, METH_NOARGS,
       DOC_PYGAMETIMEGETTICKS },
+    { "get_ticks_ns", (PyCFunction) time_get_ticks_ns, METH_NOARGS,
+      DOC_PYGAMETIMEGETTICKSNS },
     { "delay", time_delay, METH_VARARGS, DOC_PYGAMETIMEDELAY },
     { "wait", time_wait, METH_VARARGS, DOC_PYGAMETIMEWAIT },
     { "set_timer", time_set_timer, METH_VARARGS, DOC_PYGAMETIMESETTIMER },
+    { "add_timer", (PyCFunction) time_add_timer, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMETIMEADDTIMER },
+    { "cancel_timer", time_cancel_timer, METH_O, DOC_PYGAMETIMECANCELTIMER },
 
     { "Clock", (PyCFunction) ClockInit, METH_NOARGS, DOC_PYGAMETIMECLOCK },
+    { "Profiler", (PyCFunction) ProfilerInit, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMETIMEPROFILER },
 
     { NULL, NULL, 0, NULL }
 };
@@ -432,11 +1341,18 @@ MODINIT_DEFINE (time)
     if (PyErr_Occurred ()) {
         MODINIT_ERROR;
     }
+    import_pygame_event ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
 
     /* type preparation */
     if (PyType_Ready (&PyClock_Type) < 0) {
         MODINIT_ERROR;
     }
+    if (PyType_Ready (&PyProfiler_Type) < 0) {
+        MODINIT_ERROR;
+    }
 
     /* create the module */
 #if PY3
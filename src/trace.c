@@ -0,0 +1,731 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * pygame.trace: a record of each call into the C functions and methods of
+ * chosen pygame modules. start() swaps the functions in the module dicts,
+ * and the methods in the dicts of the types of the modules, for TraceFunc
+ * wrappers, which time each call and keep a PgTraceRecord of it in a ring
+ * of the last calls. stop() puts the originals back, so nothing is left to
+ * cost time while tracing is off. The records are written with the GIL
+ * held, which orders them without a lock; each keeps the thread it came
+ * from.
+ */
+#include "pygame.h"
+#include "pgcompat.h"
+#include "doc/trace_doc.h"
+#include "pythread.h"
+#include <ctype.h>
+
+#define PG_TRACE_DEFAULT_SIZE 4096
+
+typedef struct {
+    int name;                   /* index in trace.names */
+    long thread;
+    Uint64 start;               /* nanoseconds, of PgPerf_Now */
+    Uint64 duration;
+    int surf[2][3];             /* width, height and bits of the first two
+                                   Surface arguments, 0 if absent */
+    int rect[4];                /* x, y, w, h of the Rect or Surface
+                                   returned, w -1 if neither */
+} PgTraceRecord;
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *func;             /* the function or method descriptor */
+    PyObject *self;             /* bound to, for a method, or NULL */
+    int name;
+} PyTraceFuncObject;
+
+static PyTypeObject PyTraceFunc_Type;
+
+/* The type of the method descriptors of C types; Python 2 does not
+   declare PyMethodDescr_Type, so it is taken from list.append */
+static PyTypeObject *method_descr_type;
+
+static struct {
+    PgTraceRecord *ring;
+    Py_ssize_t size;
+    Py_ssize_t count;           /* written since clear(); the last size
+                                   are kept */
+    PyObject *names;            /* of the wrapped functions */
+    PyObject *name_indices;     /* name: index in names */
+    PyObject *swaps;            /* (dict, key, original, type or None) */
+    Uint64 frame_start;
+    Py_ssize_t frame_first;     /* count at frame_start */
+    double budget;              /* seconds per frame; 0 for none */
+    PyObject *callback;
+    PyObject *overrun;          /* the records of the last slow frame */
+} trace;
+
+/* The record for the call started at start of func, with args, that
+ * returned result, which may be NULL.
+ */
+static void
+trace_record(PyTraceFuncObject *func, PyObject *args, PyObject *result,
+             Uint64 start)
+{
+    PgTraceRecord *rec;
+    PyObject *arg;
+    SDL_Surface *surf;
+    Py_ssize_t i, n = PyTuple_GET_SIZE(args);
+    int found = 0;
+
+    rec = trace.ring + trace.count % trace.size;
+    trace.count++;
+    rec->name = func->name;
+    rec->thread = PyThread_get_thread_ident();
+    rec->start = start;
+    rec->duration = PgPerf_Now() - start;
+    memset(rec->surf, 0, sizeof(rec->surf));
+    for (i = func->self ? -1 : 0; i < n && found < 2; ++i) {
+        arg = i < 0 ? func->self : PyTuple_GET_ITEM(args, i);
+        if (!PySurface_Check(arg)) {
+            continue;
+        }
+        surf = PySurface_AsSurface(arg);
+        if (surf) {
+            rec->surf[found][0] = surf->w;
+            rec->surf[found][1] = surf->h;
+            rec->surf[found][2] = surf->format->BitsPerPixel;
+        }
+        ++found;
+    }
+
+    rec->rect[0] = rec->rect[1] = rec->rect[3] = 0;
+    rec->rect[2] = -1;
+    if (result && PyRect_Check(result)) {
+        GAME_Rect *r = &((PyRectObject *)result)->r;
+
+        rec->rect[0] = r->x;
+        rec->rect[1] = r->y;
+        rec->rect[2] = r->w;
+        rec->rect[3] = r->h;
+    }
+    else if (result && PySurface_Check(result) &&
+             (surf = PySurface_AsSurface(result))) {
+        rec->rect[2] = surf->w;
+        rec->rect[3] = surf->h;
+    }
+}
+
+static PyObject *
+tracefunc_call(PyTraceFuncObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *callargs = args, *result;
+    Py_ssize_t i, n;
+    Uint64 start;
+
+    if (self->self) {
+        n = PyTuple_GET_SIZE(args);
+        callargs = PyTuple_New(n + 1);
+        if (!callargs) {
+            return NULL;
+        }
+        Py_INCREF(self->self);
+        PyTuple_SET_ITEM(callargs, 0, self->self);
+        for (i = 0; i < n; ++i) {
+            Py_INCREF(PyTuple_GET_ITEM(args, i));
+            PyTuple_SET_ITEM(callargs, i + 1, PyTuple_GET_ITEM(args, i));
+        }
+    }
+    start = PgPerf_Now();
+    result = PyObject_Call(self->func, callargs, kwds);
+    if (callargs != args) {
+        Py_DECREF(callargs);
+    }
+    if (trace.swaps) {
+        trace_record(self, args, result, start);
+    }
+    return result;
+}
+
+static PyTraceFuncObject *
+tracefunc_new(PyObject *func, PyObject *self, int name)
+{
+    PyTraceFuncObject *obj = PyObject_GC_New(PyTraceFuncObject,
+                                             &PyTraceFunc_Type);
+
+    if (!obj) {
+        return NULL;
+    }
+    Py_INCREF(func);
+    obj->func = func;
+    Py_XINCREF(self);
+    obj->self = self;
+    obj->name = name;
+    PyObject_GC_Track(obj);
+    return obj;
+}
+
+/* Bind a wrapped method to an instance */
+static PyObject *
+tracefunc_descr_get(PyTraceFuncObject *self, PyObject *obj, PyObject *type)
+{
+    if (!obj || self->self) {
+        Py_INCREF(self);
+        return (PyObject *)self;
+    }
+    return (PyObject *)tracefunc_new(self->func, obj, self->name);
+}
+
+static int
+tracefunc_traverse(PyTraceFuncObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(self->func);
+    Py_VISIT(self->self);
+    return 0;
+}
+
+static int
+tracefunc_clear(PyTraceFuncObject *self)
+{
+    Py_CLEAR(self->func);
+    Py_CLEAR(self->self);
+    return 0;
+}
+
+static void
+tracefunc_dealloc(PyTraceFuncObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    tracefunc_clear(self);
+    PyObject_GC_Del(self);
+}
+
+static PyObject *
+tracefunc_repr(PyTraceFuncObject *self)
+{
+    PyObject *name = PyList_GET_ITEM(trace.names, self->name);
+
+#if PY3
+    return PyUnicode_FromFormat("<traced %U>", name);
+#else
+    return PyString_FromFormat("<traced %s>", PyString_AsString(name));
+#endif
+}
+
+static PyTypeObject PyTraceFunc_Type = {
+    TYPE_HEAD(NULL, 0)
+    "pygame.trace.TraceFunc",   /* tp_name */
+    sizeof(PyTraceFuncObject),  /* tp_basicsize */
+    0,                          /* tp_itemsize */
+    (destructor)tracefunc_dealloc, /* tp_dealloc */
+    0,                          /* tp_print */
+    0,                          /* tp_getattr */
+    0,                          /* tp_setattr */
+    0,                          /* tp_compare */
+    (reprfunc)tracefunc_repr,   /* tp_repr */
+    0,                          /* tp_as_number */
+    0,                          /* tp_as_sequence */
+    0,                          /* tp_as_mapping */
+    0,                          /* tp_hash */
+    (ternaryfunc)tracefunc_call, /* tp_call */
+    0,                          /* tp_str */
+    0,                          /* tp_getattro */
+    0,                          /* tp_setattro */
+    0,                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, /* tp_flags */
+    "a pygame function traced by pygame.trace", /* tp_doc */
+    (traverseproc)tracefunc_traverse, /* tp_traverse */
+    (inquiry)tracefunc_clear,   /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    0,                          /* tp_methods */
+    0,                          /* tp_members */
+    0,                          /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    (descrgetfunc)tracefunc_descr_get, /* tp_descr_get */
+};
+
+/* The index of name in trace.names, added if new. Names are never
+ * dropped, as wrappers left bound to objects outlive a trace.
+ */
+static int
+trace_name_index(PyObject *name)
+{
+    PyObject *index = PyDict_GetItem(trace.name_indices, name);
+
+    if (index) {
+        return (int)PyInt_AsLong(index);
+    }
+    index = PyInt_FromLong((long)PyList_GET_SIZE(trace.names));
+    if (!index || PyDict_SetItem(trace.name_indices, name, index) ||
+        PyList_Append(trace.names, name)) {
+        Py_XDECREF(index);
+        return -1;
+    }
+    Py_DECREF(index);
+    return (int)PyList_GET_SIZE(trace.names) - 1;
+}
+
+/* Swap the C functions of dict for wrappers named prefix.key. type is the
+ * type dict belongs to, or NULL for a module.
+ */
+static int
+trace_wrap_dict(PyObject *dict, const char *prefix, PyTypeObject *type)
+{
+    PyObject *items, *key, *value, *name, *wrapper, *swap;
+    Py_ssize_t i;
+    int index, result;
+
+    items = PyDict_Items(dict);
+    if (!items) {
+        return -1;
+    }
+    for (i = 0; i < PyList_GET_SIZE(items); ++i) {
+        key = PyTuple_GET_ITEM(PyList_GET_ITEM(items, i), 0);
+        value = PyTuple_GET_ITEM(PyList_GET_ITEM(items, i), 1);
+        if (type ? Py_TYPE(value) != method_descr_type
+                 : !PyCFunction_Check(value)) {
+            continue;
+        }
+#if PY3
+        name = PyUnicode_FromFormat("%s.%U", prefix, key);
+#else
+        name = PyString_FromFormat("%s.%s", prefix, PyString_AS_STRING(key));
+#endif
+        index = name ? trace_name_index(name) : -1;
+        Py_XDECREF(name);
+        if (index < 0) {
+            Py_DECREF(items);
+            return -1;
+        }
+        wrapper = (PyObject *)tracefunc_new(value, NULL, index);
+        swap = wrapper ? Py_BuildValue("(OOOO)", dict, key, value,
+                                       type ? (PyObject *)type : Py_None)
+                       : NULL;
+        result = swap ? PyList_Append(trace.swaps, swap) : -1;
+        Py_XDECREF(swap);
+        if (!result) {
+            result = PyDict_SetItem(dict, key, wrapper);
+        }
+        Py_XDECREF(wrapper);
+        if (result) {
+            Py_DECREF(items);
+            return -1;
+        }
+    }
+    Py_DECREF(items);
+    if (type) {
+        PyType_Modified(type);
+    }
+    return 0;
+}
+
+/* Whether type belongs to pygame.<name>: pygame.<name>.X, or pygame.X
+ * for the one type of a module named for it, as pygame.Surface.
+ */
+static int
+trace_owns_type(const char *name, PyTypeObject *type)
+{
+    const char *tp_name = type->tp_name, *short_name;
+    size_t len = strlen(name);
+
+    if (type->tp_flags & Py_TPFLAGS_HEAPTYPE ||
+        strncmp(tp_name, "pygame.", 7)) {
+        return 0;
+    }
+    tp_name += 7;
+    if (!strncmp(tp_name, name, len) && tp_name[len] == '.') {
+        return 1;
+    }
+    short_name = tp_name;
+    if (strchr(short_name, '.') || strlen(short_name) != len) {
+        return 0;
+    }
+    for (; *name; ++name, ++short_name) {
+        if (tolower((unsigned char)*name) !=
+            tolower((unsigned char)*short_name)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Wrap the functions of pygame.<name>, and the methods of its types */
+static int
+trace_wrap_module(const char *name)
+{
+    char fullname[100];
+    PyObject *module, *dict, *value;
+    PyTypeObject *type;
+    Py_ssize_t pos = 0;
+    int result;
+
+    PyOS_snprintf(fullname, sizeof(fullname), "pygame.%.80s", name);
+    module = PyImport_ImportModule(fullname);
+    if (!module) {
+        return -1;
+    }
+    dict = PyModule_GetDict(module);
+    result = trace_wrap_dict(dict, name, NULL);
+
+    /* types of the module, not those imported into it */
+    while (!result && PyDict_Next(dict, &pos, NULL, &value)) {
+        if (!PyType_Check(value)) {
+            continue;
+        }
+        type = (PyTypeObject *)value;
+        if (!trace_owns_type(name, type)) {
+            continue;
+        }
+        /* a type under two names is wrapped once;
+           its wrappers are not method descriptors */
+        PyOS_snprintf(fullname, sizeof(fullname), "%.40s.%.50s",
+                      name, strrchr(type->tp_name, '.') + 1);
+        result = trace_wrap_dict(type->tp_dict, fullname, type);
+    }
+    Py_DECREF(module);
+    return result;
+}
+
+/* Put back the functions wrapped by start() */
+static int
+trace_unwrap(void)
+{
+    PyObject *swap, *type;
+    Py_ssize_t i;
+    int result = 0;
+
+    if (!trace.swaps) {
+        return 0;
+    }
+    for (i = PyList_GET_SIZE(trace.swaps) - 1; i >= 0; --i) {
+        swap = PyList_GET_ITEM(trace.swaps, i);
+        if (PyDict_SetItem(PyTuple_GET_ITEM(swap, 0),
+                           PyTuple_GET_ITEM(swap, 1),
+                           PyTuple_GET_ITEM(swap, 2))) {
+            result = -1;
+        }
+        type = PyTuple_GET_ITEM(swap, 3);
+        if (type != Py_None) {
+            PyType_Modified((PyTypeObject *)type);
+        }
+    }
+    Py_CLEAR(trace.swaps);
+    return result;
+}
+
+static PyObject *
+trace_records(Py_ssize_t first)
+{
+    PyObject *list, *item, *surfs[2];
+    PgTraceRecord *rec;
+    Py_ssize_t i, from;
+    int j;
+
+    from = trace.count - trace.size;
+    if (from < first) {
+        from = first;
+    }
+    if (from < 0) {
+        from = 0;
+    }
+    list = PyList_New(0);
+    if (!list || !trace.ring) {
+        return list;
+    }
+    for (i = from; i < trace.count; ++i) {
+        rec = trace.ring + i % trace.size;
+        for (j = 0; j < 2; ++j) {
+            if (rec->surf[j][0] || rec->surf[j][1] || rec->surf[j][2]) {
+                surfs[j] = Py_BuildValue("(iii)", rec->surf[j][0],
+                                         rec->surf[j][1], rec->surf[j][2]);
+            }
+            else {
+                Py_INCREF(Py_None);
+                surfs[j] = Py_None;
+            }
+        }
+        if (!surfs[0] || !surfs[1]) {
+            item = NULL;
+        }
+        else if (rec->rect[2] < 0) {
+            item = Py_BuildValue("(OldNNO)",
+                                 PyList_GET_ITEM(trace.names, rec->name),
+                                 rec->thread, rec->duration / 1e9,
+                                 surfs[0], surfs[1], Py_None);
+            surfs[0] = surfs[1] = NULL;
+        }
+        else {
+            item = Py_BuildValue("(OldNN(iiii))",
+                                 PyList_GET_ITEM(trace.names, rec->name),
+                                 rec->thread, rec->duration / 1e9,
+                                 surfs[0], surfs[1], rec->rect[0],
+                                 rec->rect[1], rec->rect[2], rec->rect[3]);
+            surfs[0] = surfs[1] = NULL;
+        }
+        Py_XDECREF(surfs[0]);
+        Py_XDECREF(surfs[1]);
+        if (!item || PyList_Append(list, item)) {
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return list;
+}
+
+static PyObject *
+start(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *keywords[] = {"modules", "size", NULL};
+    static const char *default_modules[] = {
+        "surface", "transform", "draw", "gfxdraw", "mask", "image", NULL
+    };
+    PyObject *modules = NULL, *seq, *item, *bytes;
+    Py_ssize_t size = PG_TRACE_DEFAULT_SIZE, i;
+    PgTraceRecord *ring;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|On:start", keywords,
+                                     &modules, &size)) {
+        return NULL;
+    }
+    if (size < 1) {
+        return RAISE(PyExc_ValueError, "size must be positive");
+    }
+    if (trace_unwrap()) {
+        return NULL;
+    }
+    ring = PyMem_New(PgTraceRecord, size);
+    if (!ring) {
+        return PyErr_NoMemory();
+    }
+    PyMem_Free(trace.ring);
+    trace.ring = ring;
+    trace.size = size;
+    trace.count = trace.frame_first = 0;
+    trace.frame_start = PgPerf_Now();
+    Py_CLEAR(trace.overrun);
+    trace.swaps = PyList_New(0);
+    if (!trace.swaps) {
+        return NULL;
+    }
+
+    if (!modules || modules == Py_None) {
+        for (i = 0; default_modules[i]; ++i) {
+            if (trace_wrap_module(default_modules[i])) {
+                /* a module may be missing from this build */
+                if (!PyErr_ExceptionMatches(PyExc_ImportError)) {
+                    trace_unwrap();
+                    return NULL;
+                }
+                PyErr_Clear();
+            }
+        }
+        Py_RETURN_NONE;
+    }
+
+    seq = PySequence_Fast(modules, "modules must be a sequence of names");
+    if (!seq) {
+        trace_unwrap();
+        return NULL;
+    }
+    for (i = 0; i < PySequence_Fast_GET_SIZE(seq); ++i) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        bytes = RWopsEncodeString(item, "ascii", NULL, NULL);
+        if (!bytes || bytes == Py_None ||
+            trace_wrap_module(Bytes_AS_STRING(bytes))) {
+            if (bytes == Py_None) {
+                PyErr_SetString(PyExc_TypeError, "module names must be str");
+            }
+            Py_XDECREF(bytes);
+            Py_DECREF(seq);
+            trace_unwrap();
+            return NULL;
+        }
+        Py_DECREF(bytes);
+    }
+    Py_DECREF(seq);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+stop(PyObject *self)
+{
+    if (trace_unwrap()) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+get_tracing(PyObject *self)
+{
+    return PyBool_FromLong(trace.swaps != NULL);
+}
+
+static PyObject *
+get_records(PyObject *self)
+{
+    return trace_records(0);
+}
+
+static PyObject *
+clear(PyObject *self)
+{
+    trace.count = trace.frame_first = 0;
+    trace.frame_start = PgPerf_Now();
+    Py_CLEAR(trace.overrun);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+set_frame_budget(PyObject *self, PyObject *args)
+{
+    double budget;
+    PyObject *callback = Py_None;
+
+    if (!PyArg_ParseTuple(args, "d|O:set_frame_budget", &budget,
+                          &callback)) {
+        return NULL;
+    }
+    if (budget < 0) {
+        return RAISE(PyExc_ValueError, "budget must not be negative");
+    }
+    if (callback != Py_None && !PyCallable_Check(callback)) {
+        return RAISE(PyExc_TypeError, "callback must be callable");
+    }
+    trace.budget = budget;
+    Py_XDECREF(trace.callback);
+    trace.callback = callback == Py_None ? NULL : callback;
+    Py_XINCREF(trace.callback);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+frame(PyObject *self)
+{
+    Uint64 now = PgPerf_Now();
+    double seconds = (now - trace.frame_start) / 1e9;
+    Py_ssize_t first = trace.frame_first;
+    PyObject *records, *result;
+
+    trace.frame_start = now;
+    trace.frame_first = trace.count;
+    if (!trace.ring || trace.budget <= 0 || seconds <= trace.budget) {
+        return PyFloat_FromDouble(seconds);
+    }
+
+    records = trace_records(first);
+    if (!records) {
+        return NULL;
+    }
+    Py_XDECREF(trace.overrun);
+    trace.overrun = records;
+    if (trace.callback) {
+        result = PyObject_CallFunction(trace.callback, "dO", seconds,
+                                       records);
+        if (!result) {
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+    return PyFloat_FromDouble(seconds);
+}
+
+static PyObject *
+get_overrun(PyObject *self)
+{
+    if (!trace.overrun) {
+        Py_RETURN_NONE;
+    }
+    Py_INCREF(trace.overrun);
+    return trace.overrun;
+}
+
+static PyMethodDef _trace_methods[] = {
+    {"start", (PyCFunction)start, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRACESTART},
+    {"stop", (PyCFunction)stop, METH_NOARGS, DOC_PYGAMETRACESTOP},
+    {"get_tracing", (PyCFunction)get_tracing, METH_NOARGS,
+     DOC_PYGAMETRACEGETTRACING},
+    {"get_records", (PyCFunction)get_records, METH_NOARGS,
+     DOC_PYGAMETRACEGETRECORDS},
+    {"clear", (PyCFunction)clear, METH_NOARGS, DOC_PYGAMETRACECLEAR},
+    {"set_frame_budget", set_frame_budget, METH_VARARGS,
+     DOC_PYGAMETRACESETFRAMEBUDGET},
+    {"frame", (PyCFunction)frame, METH_NOARGS, DOC_PYGAMETRACEFRAME},
+    {"get_overrun", (PyCFunction)get_overrun, METH_NOARGS,
+     DOC_PYGAMETRACEGETOVERRUN},
+    {NULL, NULL, 0, NULL}
+};
+
+MODINIT_DEFINE(trace)
+{
+    PyObject *module;
+
+#if PY3
+    static struct PyModuleDef _module = {
+        PyModuleDef_HEAD_INIT,
+        "trace",
+        DOC_PYGAMETRACE,
+        -1,
+        _trace_methods,
+        NULL, NULL, NULL, NULL
+    };
+#endif
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        MODINIT_ERROR;
+    }
+    import_pygame_rect();
+    if (PyErr_Occurred()) {
+        MODINIT_ERROR;
+    }
+    import_pygame_surface();
+    if (PyErr_Occurred()) {
+        MODINIT_ERROR;
+    }
+    import_pygame_rwobject();
+    if (PyErr_Occurred()) {
+        MODINIT_ERROR;
+    }
+    if (PyType_Ready(&PyTraceFunc_Type) < 0) {
+        MODINIT_ERROR;
+    }
+    method_descr_type =
+        Py_TYPE(PyDict_GetItemString(PyList_Type.tp_dict, "append"));
+    if (!trace.names) {
+        trace.names = PyList_New(0);
+        trace.name_indices = PyDict_New();
+        if (!trace.names || !trace.name_indices) {
+            MODINIT_ERROR;
+        }
+    }
+
+#if PY3
+    module = PyModule_Create(&_module);
+#else
+    module = Py_InitModule3(MODPREFIX "trace", _trace_methods,
+                            DOC_PYGAMETRACE);
+#endif
+    if (!module) {
+        MODINIT_ERROR;
+    }
+    MODINIT_RETURN(module);
+}
@@ -27,52 +27,91 @@
 #include "pygame.h"
 #include "pgcompat.h"
 #include "doc/transform_doc.h"
+#include "pgcolorspace.h"
 #include <math.h>
 #include <string.h>
 #include "scale.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PG_TRANSFORM_SSE2
+#include <emmintrin.h>
+#endif
+
 
 typedef void (* SMOOTHSCALE_FILTER_P)(Uint8 *, Uint8 *, int, int, int, int, int);
+typedef void (* BLUR_FILTER_P)(Uint8 *, Uint8 *, int, int, int, int, const int *, int);
 struct _module_state {
     const char *filter_type;
     SMOOTHSCALE_FILTER_P filter_shrink_X;
     SMOOTHSCALE_FILTER_P filter_shrink_Y;
     SMOOTHSCALE_FILTER_P filter_expand_X;
     SMOOTHSCALE_FILTER_P filter_expand_Y;
+    BLUR_FILTER_P filter_blur_X;
+    BLUR_FILTER_P filter_blur_Y;
+    BLUR_FILTER_P filter_convolve;
 };
 
-#if defined(SCALE_MMX_SUPPORT)
+#if defined(SCALE_SIMD_SUPPORT)
 
+#if defined(SCALE_MMX_SUPPORT)
 #include <SDL_cpuinfo.h>
+#endif
+
+static void filter_shrink_X_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
+static void filter_shrink_Y_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
+static void filter_expand_X_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
+static void filter_expand_Y_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
+static void filter_blur_X_ONLYC(Uint8 *, Uint8 *, int, int, int, int, const int *, int);
+static void filter_blur_Y_ONLYC(Uint8 *, Uint8 *, int, int, int, int, const int *, int);
+static void filter_convolve_ONLYC(Uint8 *, Uint8 *, int, int, int, int, const int *, int);
 
 #if PY3
 #define GETSTATE(m) PY3_GETSTATE (_module_state, m)
 #else
-static struct _module_state _state = {0, 0, 0, 0, 0};
+static struct _module_state _state = {0, 0, 0, 0, 0, 0, 0, 0};
 #define GETSTATE(m) PY2_GETSTATE (_state)
 #endif
 
-#else /* if defined(SCALE_MMX_SUPPORT) */
+#else /* if defined(SCALE_SIMD_SUPPORT) */
 
 static void filter_shrink_X_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
 static void filter_shrink_Y_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
 static void filter_expand_X_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
 static void filter_expand_Y_ONLYC(Uint8 *, Uint8 *, int, int, int, int, int);
+static void filter_blur_X_ONLYC(Uint8 *, Uint8 *, int, int, int, int, const int *, int);
+static void filter_blur_Y_ONLYC(Uint8 *, Uint8 *, int, int, int, int, const int *, int);
+static void filter_convolve_ONLYC(Uint8 *, Uint8 *, int, int, int, int, const int *, int);
 
 static struct _module_state _state = {
     "GENERIC",
     filter_shrink_X_ONLYC,
     filter_shrink_Y_ONLYC,
     filter_expand_X_ONLYC,
-    filter_expand_Y_ONLYC};
+    filter_expand_Y_ONLYC,
+    filter_blur_X_ONLYC,
+    filter_blur_Y_ONLYC,
+    filter_convolve_ONLYC};
 #define GETSTATE(m) PY2_GETSTATE (_state)
 #define smoothscale_init(st)
 
-#endif /* if defined(SCALE_MMX_SUPPORT) */
+#endif /* if defined(SCALE_SIMD_SUPPORT) */
 
 void scale2x (SDL_Surface *src, SDL_Surface *dst);
-extern SDL_Surface* rotozoomSurface (SDL_Surface *src, double angle,
-                                     double zoom, int smooth);
+void scale3x (SDL_Surface *src, SDL_Surface *dst);
+size_t scale4x_scratch_size (SDL_Surface *src);
+void scale4x (SDL_Surface *src, SDL_Surface *dst, Uint8 *scratch);
+extern void* rotozoomSurfaceBegin (SDL_Surface *src, SDL_Surface *dst,
+                                   double angle, double zoom, int smooth);
+extern void rotozoomSurfaceRows (void *job, int first, int n);
+extern void rotozoomSurfaceEnd (void *job);
+extern void rotozoomSurfaceDstSize (int width, int height, double angle,
+                                    double zoom, int *dstwidth,
+                                    int *dstheight);
+
+/* A job does rows first to first + n - 1 of data and returns a count */
+typedef int (* SMOOTH_JOB_P)(void *data, int first, int n);
+static int smooth_jobs (SMOOTH_JOB_P job, void *data, int n, int pixels);
 
 static SDL_Surface*
 newsurf_fromsurf (SDL_Surface* surf, int width, int height)
@@ -85,10 +124,12 @@ newsurf_fromsurf (SDL_Surface* surf, int width, int height)
             (RAISE (PyExc_ValueError,
                     "unsupport Surface bit depth for transform"));
 
-    newsurf = SDL_CreateRGBSurface (surf->flags, width, height,
-                                    surf->format->BitsPerPixel,
-                                    surf->format->Rmask, surf->format->Gmask,
-                                    surf->format->Bmask, surf->format->Amask);
+    newsurf = PySurface_CreateRGBSurface (surf->flags, width, height,
+                                          surf->format->BitsPerPixel,
+                                          surf->format->Rmask,
+                                          surf->format->Gmask,
+                                          surf->format->Bmask,
+                                          surf->format->Amask);
     if (!newsurf)
         return (SDL_Surface*) (RAISE (PyExc_SDLError, SDL_GetError ()));
 
@@ -104,131 +145,369 @@ newsurf_fromsurf (SDL_Surface* surf, int width, int height)
     {
         result = SDL_SetAlpha (newsurf, surf->flags, surf->format->alpha);
         if (result == -1)
+        {
+            PySurface_FreeSurface (newsurf);
             return (SDL_Surface*) (RAISE (PyExc_SDLError, SDL_GetError ()));
+        }
     }
     return newsurf;
 }
 
+/* The surface a transform of surf writes to: a new width x height surface
+ * like surf, or the DestSurface argument surfobj2, which must have that size,
+ * the pixel size of surf and not be surf itself.
+ */
 static SDL_Surface*
-rotate90 (SDL_Surface *src, int angle)
+transform_dest (SDL_Surface *surf, PyObject *surfobj2, int width, int height)
 {
-    int numturns = (angle / 90) % 4;
-    int dstwidth, dstheight;
-    SDL_Surface* dst;
-    char *srcpix, *dstpix, *srcrow, *dstrow;
-    int srcstepx, srcstepy, dststepx, dststepy;
-    int loopx, loopy;
+    SDL_Surface *newsurf;
 
-    if (numturns < 0)
-        numturns = 4 + numturns;
-    if (!(numturns % 2))
-    {
-        dstwidth = src->w;
-        dstheight = src->h;
+    if (!surfobj2)
+        return newsurf_fromsurf (surf, width, height);
+
+    newsurf = PySurface_AsSurface (surfobj2);
+    if (newsurf->w != width || newsurf->h != height)
+        return (SDL_Surface*)
+            (RAISE (PyExc_ValueError,
+                    "Destination surface not the required width or height."));
+    if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
+        return (SDL_Surface*)
+            (RAISE (PyExc_ValueError,
+                    "Source and destination surfaces need the same format."));
+    if (newsurf == surf)
+        return (SDL_Surface*)
+            (RAISE (PyExc_ValueError,
+                    "Source and destination surfaces must differ."));
+    PySurface_Unshare (surfobj2);
+    return newsurf;
+}
+
+/* Set every pixel of a locked surface to 0, as in a new one. Unlike
+ * SDL_FillRect this ignores the clip rect.
+ */
+static void
+clear_surface (SDL_Surface *surf)
+{
+    Uint8 *row = (Uint8*) surf->pixels;
+    int y;
+
+    for (y = 0; y < surf->h; y++, row += surf->pitch)
+        memset (row, 0, surf->w * surf->format->BytesPerPixel);
+}
+
+/* The size of the surface rotate makes from a width x height one. For a
+ * multiple of 90 degrees this returns the number of quarter turns, 0 to 3,
+ * otherwise -1 with the sine and cosine of the angle in sangle and cangle.
+ */
+static int
+rotate_size (int width, int height, float angle, int *dstwidth,
+             int *dstheight, double *sangle, double *cangle)
+{
+    double radangle;
+    double x, y, cx, cy, sx, sy;
+
+    if ( !( fmod((double)angle, (double)90.0f) ) ) {
+        int numturns = ((int) angle / 90) % 4;
+
+        if (numturns < 0)
+            numturns = 4 + numturns;
+        if (!(numturns % 2))
+        {
+            *dstwidth = width;
+            *dstheight = height;
+        }
+        else
+        {
+            *dstwidth = height;
+            *dstheight = width;
+        }
+        return numturns;
     }
-    else
+
+    radangle = angle*.01745329251994329;
+    *sangle = sin (radangle);
+    *cangle = cos (radangle);
+
+    x = width;
+    y = height;
+    cx = *cangle*x;
+    cy = *cangle*y;
+    sx = *sangle*x;
+    sy = *sangle*y;
+    *dstwidth = (int) (MAX (MAX (MAX (fabs (cx + sy), fabs (cx - sy)),
+                                 fabs (-cx + sy)), fabs (-cx - sy)));
+    *dstheight = (int) (MAX (MAX (MAX (fabs (sx + cy), fabs (sx - cy)),
+                                  fabs (-sx + cy)), fabs (-sx - cy)));
+    return -1;
+}
+
+/* Copy the width pixels of bpp bytes at srcpix to dstpix in reverse order */
+static void
+reverse_row (Uint8 *srcpix, Uint8 *dstpix, int width, int bpp)
+{
+    int loopx = width;
+
+#if defined(PG_TRANSFORM_SSE2)
+    if (bpp != 3)
     {
-        dstwidth = src->h;
-        dstheight = src->w;
-    }
+        for (; loopx >= 16 / bpp; loopx -= 16 / bpp)
+        {
+            __m128i pixels = _mm_loadu_si128 ((const __m128i*)
+                                              (srcpix + loopx * bpp - 16));
 
-    dst = newsurf_fromsurf (src, dstwidth, dstheight);
-    if (!dst)
-        return NULL;
-    SDL_LockSurface (dst);
-    srcrow = (char*) src->pixels;
-    dstrow = (char*) dst->pixels;
-    srcstepx = dststepx = src->format->BytesPerPixel;
-    srcstepy = src->pitch;
-    dststepy = dst->pitch;
+            if (bpp == 1)
+                pixels = _mm_or_si128 (_mm_slli_epi16 (pixels, 8),
+                                       _mm_srli_epi16 (pixels, 8));
+            if (bpp <= 2)
+            {
+                pixels = _mm_shufflelo_epi16 (pixels, _MM_SHUFFLE (0, 1, 2, 3));
+                pixels = _mm_shufflehi_epi16 (pixels, _MM_SHUFFLE (0, 1, 2, 3));
+                pixels = _mm_shuffle_epi32 (pixels, _MM_SHUFFLE (1, 0, 3, 2));
+            }
+            else
+                pixels = _mm_shuffle_epi32 (pixels, _MM_SHUFFLE (0, 1, 2, 3));
+            _mm_storeu_si128 ((__m128i*)dstpix, pixels);
+            dstpix += 16;
+        }
+    }
+#endif /* PG_TRANSFORM_SSE2 */
 
-    switch (numturns)
+    switch (bpp)
     {
-        /*case 0: we don't need to change anything*/
     case 1:
-        srcrow += ((src->w - 1) * srcstepx);
-        srcstepy = -srcstepx;
-        srcstepx = src->pitch;
+        while (loopx--)
+            *dstpix++ = srcpix[loopx];
         break;
     case 2:
-        srcrow += ((src->h - 1) * srcstepy) + ((src->w - 1) * srcstepx);
-        srcstepx = -srcstepx;
-        srcstepy = -srcstepy;
+        while (loopx--)
+        {
+            *(Uint16*)dstpix = ((Uint16*)srcpix)[loopx];
+            dstpix += 2;
+        }
         break;
     case 3:
-        srcrow += ((src->h - 1) * srcstepy);
-        srcstepx = -srcstepy;
-        srcstepy = src->format->BytesPerPixel;
+        while (loopx--)
+        {
+            dstpix[0] = srcpix[loopx * 3];
+            dstpix[1] = srcpix[loopx * 3 + 1];
+            dstpix[2] = srcpix[loopx * 3 + 2];
+            dstpix += 3;
+        }
+        break;
+    case 4:
+        while (loopx--)
+        {
+            *(Uint32*)dstpix = ((Uint32*)srcpix)[loopx];
+            dstpix += 4;
+        }
         break;
     }
+}
 
-    switch (src->format->BytesPerPixel)
+/* Quarter turns are done in square tiles of this many pixels, so the
+ * source columns read for a tile stay in the cache.
+ */
+#define ROTATE_TILE 32
+
+/* Copy a width by height tile of bpp byte pixels to dstpix, taking pixel
+ * (x, y) of the tile from srcpix + x * srcstepx + y * srcstepy.
+ */
+static void
+rotate_tile (Uint8 *srcpix, Uint8 *dstpix, int width, int height,
+             int srcstepx, int srcstepy, int dstpitch, int bpp)
+{
+    Uint8 *srcrow, *dstrow;
+    int loopx, loopy;
+
+    for (loopy = 0; loopy < height; ++loopy)
     {
-    case 1:
-        for (loopy = 0; loopy < dstheight; ++loopy)
+        srcrow = srcpix + loopy * srcstepy;
+        dstrow = dstpix + loopy * dstpitch;
+        switch (bpp)
         {
-            dstpix = dstrow;
-            srcpix = srcrow;
-            for (loopx = 0; loopx < dstwidth; ++loopx)
+        case 1:
+            for (loopx = 0; loopx < width; ++loopx)
             {
-                *dstpix = *srcpix;
-                srcpix += srcstepx;
-                dstpix += dststepx;
+                *dstrow++ = *srcrow;
+                srcrow += srcstepx;
             }
-            dstrow += dststepy;
-            srcrow += srcstepy;
-        }
-        break;
-    case 2:
-        for (loopy = 0; loopy < dstheight; ++loopy)
-        {
-            dstpix = dstrow;
-            srcpix = srcrow;
-            for (loopx = 0; loopx < dstwidth; ++loopx)
+            break;
+        case 2:
+            for (loopx = 0; loopx < width; ++loopx)
             {
-                *(Uint16*)dstpix = *(Uint16*)srcpix;
-                srcpix += srcstepx;
-                dstpix += dststepx;
+                *(Uint16*)dstrow = *(Uint16*)srcrow;
+                srcrow += srcstepx;
+                dstrow += 2;
             }
-            dstrow += dststepy;
-            srcrow += srcstepy;
+            break;
+        case 3:
+            for (loopx = 0; loopx < width; ++loopx)
+            {
+                dstrow[0] = srcrow[0];
+                dstrow[1] = srcrow[1];
+                dstrow[2] = srcrow[2];
+                srcrow += srcstepx;
+                dstrow += 3;
+            }
+            break;
+        case 4:
+            for (loopx = 0; loopx < width; ++loopx)
+            {
+                *(Uint32*)dstrow = *(Uint32*)srcrow;
+                srcrow += srcstepx;
+                dstrow += 4;
+            }
+            break;
         }
-        break;
-    case 3:
-        for (loopy = 0; loopy < dstheight; ++loopy)
+    }
+}
+
+#if defined(PG_TRANSFORM_SSE2)
+/* rotate_tile for 2 or 4 byte pixels when the source steps by a pitch
+ * along x and by bpp along y, transposing blocks of 8 by 8 or 4 by 4 pixels
+ * in registers. width and height must be multiples of the block size.
+ */
+static void
+rotate_tile_sse2 (Uint8 *srcpix, Uint8 *dstpix, int width, int height,
+                  int srcstepx, int srcstepy, int dstpitch, int bpp)
+{
+    int block = 16 / bpp;
+    int loopx, loopy, i;
+    __m128i r[8], a[8], b[8];
+
+    for (loopy = 0; loopy < height; loopy += block)
+    {
+        for (loopx = 0; loopx < width; loopx += block)
         {
-            dstpix = dstrow;
-            srcpix = srcrow;
-            for (loopx = 0; loopx < dstwidth; ++loopx)
+            Uint8 *src = srcpix + loopx * srcstepx + loopy * srcstepy;
+            Uint8 *dst = dstpix + loopy * dstpitch + loopx * bpp;
+            int dststep = dstpitch;
+
+            /* the source pixels of a block column run backwards, so load
+               from its far end and store the columns bottom up */
+            if (srcstepy < 0)
             {
-                dstpix[0] = srcpix[0];
-                dstpix[1] = srcpix[1];
-                dstpix[2] = srcpix[2];
-                srcpix += srcstepx;
-                dstpix += dststepx;
+                src += (block - 1) * srcstepy;
+                dst += (block - 1) * dstpitch;
+                dststep = -dstpitch;
             }
-            dstrow += dststepy;
-            srcrow += srcstepy;
+            for (i = 0; i < block; ++i)
+                r[i] = _mm_loadu_si128 ((const __m128i*)(src + i * srcstepx));
+            if (bpp == 4)
+            {
+                a[0] = _mm_unpacklo_epi32 (r[0], r[1]);
+                a[1] = _mm_unpacklo_epi32 (r[2], r[3]);
+                a[2] = _mm_unpackhi_epi32 (r[0], r[1]);
+                a[3] = _mm_unpackhi_epi32 (r[2], r[3]);
+                r[0] = _mm_unpacklo_epi64 (a[0], a[1]);
+                r[1] = _mm_unpackhi_epi64 (a[0], a[1]);
+                r[2] = _mm_unpacklo_epi64 (a[2], a[3]);
+                r[3] = _mm_unpackhi_epi64 (a[2], a[3]);
+            }
+            else
+            {
+                for (i = 0; i < 4; ++i)
+                {
+                    a[i] = _mm_unpacklo_epi16 (r[2 * i], r[2 * i + 1]);
+                    a[i + 4] = _mm_unpackhi_epi16 (r[2 * i], r[2 * i + 1]);
+                }
+                for (i = 0; i < 8; i += 4)
+                {
+                    b[i] = _mm_unpacklo_epi32 (a[i], a[i + 1]);
+                    b[i + 1] = _mm_unpackhi_epi32 (a[i], a[i + 1]);
+                    b[i + 2] = _mm_unpacklo_epi32 (a[i + 2], a[i + 3]);
+                    b[i + 3] = _mm_unpackhi_epi32 (a[i + 2], a[i + 3]);
+                }
+                for (i = 0; i < 2; ++i)
+                {
+                    r[2 * i] = _mm_unpacklo_epi64 (b[i], b[i + 2]);
+                    r[2 * i + 1] = _mm_unpackhi_epi64 (b[i], b[i + 2]);
+                    r[2 * i + 4] = _mm_unpacklo_epi64 (b[i + 4], b[i + 6]);
+                    r[2 * i + 5] = _mm_unpackhi_epi64 (b[i + 4], b[i + 6]);
+                }
+            }
+            for (i = 0; i < block; ++i)
+                _mm_storeu_si128 ((__m128i*)(dst + i * dststep), r[i]);
         }
-        break;
-    case 4:
+    }
+}
+#endif /* PG_TRANSFORM_SSE2 */
+
+/* Rotate src by numturns quarter turns into dst, which has the size from
+ * rotate_size. Both surfaces must be locked.
+ */
+static void
+rotate90 (SDL_Surface *src, SDL_Surface *dst, int numturns)
+{
+    int dstwidth = dst->w;
+    int dstheight = dst->h;
+    int bpp = src->format->BytesPerPixel;
+    Uint8 *srcrow, *dstrow;
+    int srcstepx, srcstepy;
+    int loopx, loopy;
+
+    srcrow = (Uint8*) src->pixels;
+    dstrow = (Uint8*) dst->pixels;
+
+    switch (numturns)
+    {
+    case 0:
+        for (loopy = 0; loopy < dstheight; ++loopy)
+            memcpy (dstrow + loopy * dst->pitch, srcrow + loopy * src->pitch,
+                    dstwidth * bpp);
+        return;
+    case 2:
         for (loopy = 0; loopy < dstheight; ++loopy)
+            reverse_row (srcrow + (src->h - 1 - loopy) * src->pitch,
+                         dstrow + loopy * dst->pitch, dstwidth, bpp);
+        return;
+    case 1:
+        srcrow += ((src->w - 1) * bpp);
+        srcstepx = src->pitch;
+        srcstepy = -bpp;
+        break;
+    default:
+        srcrow += ((src->h - 1) * src->pitch);
+        srcstepx = -src->pitch;
+        srcstepy = bpp;
+        break;
+    }
+
+    /* the destination is written a tile at a time rather than a row at a
+       time, as each row reads a whole column of the source */
+    for (loopy = 0; loopy < dstheight; loopy += ROTATE_TILE)
+    {
+        for (loopx = 0; loopx < dstwidth; loopx += ROTATE_TILE)
         {
-            dstpix = dstrow;
-            srcpix = srcrow;
-            for (loopx = 0; loopx < dstwidth; ++loopx)
+            Uint8 *srcpix = srcrow + loopx * srcstepx + loopy * srcstepy;
+            Uint8 *dstpix = dstrow + loopy * dst->pitch + loopx * bpp;
+            int width = MIN (ROTATE_TILE, dstwidth - loopx);
+            int height = MIN (ROTATE_TILE, dstheight - loopy);
+
+#if defined(PG_TRANSFORM_SSE2)
+            if (bpp == 2 || bpp == 4)
             {
-                *(Uint32*)dstpix = *(Uint32*)srcpix;
-                srcpix += srcstepx;
-                dstpix += dststepx;
+                /* blocks in registers, then the strips to the right and
+                   below them a pixel at a time */
+                int block = 16 / bpp;
+                int blockwidth = width - width % block;
+                int blockheight = height - height % block;
+
+                rotate_tile_sse2 (srcpix, dstpix, blockwidth, blockheight,
+                                  srcstepx, srcstepy, dst->pitch, bpp);
+                rotate_tile (srcpix + blockwidth * srcstepx,
+                             dstpix + blockwidth * bpp, width - blockwidth,
+                             blockheight, srcstepx, srcstepy, dst->pitch,
+                             bpp);
+                srcpix += blockheight * srcstepy;
+                dstpix += blockheight * dst->pitch;
+                height -= blockheight;
             }
-            dstrow += dststepy;
-            srcrow += srcstepy;
+#endif /* PG_TRANSFORM_SSE2 */
+            rotate_tile (srcpix, dstpix, width, height, srcstepx, srcstepy,
+                         dst->pitch, bpp);
         }
-        break;
     }
-    SDL_UnlockSurface (dst);
-    return dst;
 }
 
 
@@ -347,172 +626,271 @@ rotate (SDL_Surface *src, SDL_Surface *dst, Uint32 bgcolor, double sangle,
     }
 }
 
+/* One row of stretch: srcwidth pixels to dstwidth, nearest neighbour. */
 static void
-stretch (SDL_Surface *src, SDL_Surface *dst)
+stretch_row (Uint8 *srcpix, Uint8 *dstpix, int srcwidth, int dstwidth,
+             int bpp)
 {
-    int looph, loopw;
-
-    Uint8* srcrow = (Uint8*) src->pixels;
-    Uint8* dstrow = (Uint8*) dst->pixels;
-
-    int srcpitch = src->pitch;
-    int dstpitch = dst->pitch;
-
-    int dstwidth = dst->w;
-    int dstheight = dst->h;
-    int dstwidth2 = dst->w << 1;
-    int dstheight2 = dst->h << 1;
-
-    int srcwidth2 = src->w << 1;
-    int srcheight2 = src->h << 1;
-
-    int w_err, h_err = srcheight2 - dstheight2;
+    int loopw;
+    int dstwidth2 = dstwidth << 1;
+    int srcwidth2 = srcwidth << 1;
+    int w_err = srcwidth2 - dstwidth2;
 
-
-    switch (src->format->BytesPerPixel)
+    switch (bpp)
     {
     case 1:
-        for (looph = 0; looph < dstheight; ++looph)
+        for (loopw = 0; loopw < dstwidth; ++ loopw)
         {
-            Uint8 *srcpix = (Uint8*)srcrow, *dstpix = (Uint8*)dstrow;
-            w_err = srcwidth2 - dstwidth2;
-            for (loopw = 0; loopw < dstwidth; ++ loopw)
-            {
-                *dstpix++ = *srcpix;
-                while (w_err >= 0)
-                {
-                    ++srcpix;
-                    w_err -= dstwidth2;
-                }
-                w_err += srcwidth2;
-            }
-            while (h_err >= 0)
+            *dstpix++ = *srcpix;
+            while (w_err >= 0)
             {
-                srcrow += srcpitch;
-                h_err -= dstheight2;
+                ++srcpix;
+                w_err -= dstwidth2;
             }
-            dstrow += dstpitch;
-            h_err += srcheight2;
+            w_err += srcwidth2;
         }
         break;
     case 2:
-        for (looph = 0; looph < dstheight; ++looph)
+    {
+        Uint16 *src16 = (Uint16*)srcpix, *dst16 = (Uint16*)dstpix;
+        for (loopw = 0; loopw < dstwidth; ++ loopw)
         {
-            Uint16 *srcpix = (Uint16*)srcrow, *dstpix = (Uint16*)dstrow;
-            w_err = srcwidth2 - dstwidth2;
-            for (loopw = 0; loopw < dstwidth; ++ loopw)
+            *dst16++ = *src16;
+            while (w_err >= 0)
             {
-                *dstpix++ = *srcpix;
-                while (w_err >= 0)
-                {
-                    ++srcpix;
-                    w_err -= dstwidth2;
-                }
-                w_err += srcwidth2;
-            }
-            while (h_err >= 0)
-            {
-                srcrow += srcpitch;
-                h_err -= dstheight2;
+                ++src16;
+                w_err -= dstwidth2;
             }
-            dstrow += dstpitch;
-            h_err += srcheight2;
+            w_err += srcwidth2;
         }
         break;
+    }
     case 3:
-        for (looph = 0; looph < dstheight; ++looph)
+        for (loopw = 0; loopw < dstwidth; ++ loopw)
         {
-            Uint8 *srcpix = (Uint8*)srcrow, *dstpix = (Uint8*)dstrow;
-            w_err = srcwidth2 - dstwidth2;
-            for (loopw = 0; loopw < dstwidth; ++ loopw)
-            {
-                dstpix[0] = srcpix[0];
-                dstpix[1] = srcpix[1];
-                dstpix[2] = srcpix[2];
-                dstpix += 3;
-                while (w_err >= 0)
-                {
-                    srcpix+=3;
-                    w_err -= dstwidth2;
-                }
-                w_err += srcwidth2;
-            }
-            while (h_err >= 0)
+            dstpix[0] = srcpix[0];
+            dstpix[1] = srcpix[1];
+            dstpix[2] = srcpix[2];
+            dstpix += 3;
+            while (w_err >= 0)
             {
-                srcrow += srcpitch;
-                h_err -= dstheight2;
+                srcpix+=3;
+                w_err -= dstwidth2;
             }
-            dstrow += dstpitch;
-            h_err += srcheight2;
+            w_err += srcwidth2;
         }
         break;
     default: /*case 4:*/
-        for (looph = 0; looph < dstheight; ++looph)
+    {
+        Uint32 *src32 = (Uint32*)srcpix, *dst32 = (Uint32*)dstpix;
+        for (loopw = 0; loopw < dstwidth; ++ loopw)
         {
-            Uint32 *srcpix = (Uint32*)srcrow, *dstpix = (Uint32*)dstrow;
-            w_err = srcwidth2 - dstwidth2;
-            for (loopw = 0; loopw < dstwidth; ++ loopw)
-            {
-                *dstpix++ = *srcpix;
-                while (w_err >= 0)
-                {
-                    ++srcpix;
-                    w_err -= dstwidth2;
-                }
-                w_err += srcwidth2;
-            }
-            while (h_err >= 0)
+            *dst32++ = *src32;
+            while (w_err >= 0)
             {
-                srcrow += srcpitch;
-                h_err -= dstheight2;
+                ++src32;
+                w_err -= dstwidth2;
             }
-            dstrow += dstpitch;
-            h_err += srcheight2;
+            w_err += srcwidth2;
         }
         break;
     }
+    }
 }
 
-static PyObject*
-surf_scale (PyObject* self, PyObject* arg)
+/* One row of stretch for a whole number factor: each of the srcwidth
+ * pixels repeated factor times. This is what stretch_row gives then.
+ */
+static void
+stretch_row_repeat (Uint8 *srcpix, Uint8 *dstpix, int srcwidth, int factor,
+                    int bpp)
 {
-    PyObject *surfobj, *surfobj2;
-    SDL_Surface* surf, *newsurf;
-    int width, height;
-    surfobj2 = NULL;
-
-    /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!(ii)|O!", &PySurface_Type, &surfobj,
-                           &width, &height, &PySurface_Type, &surfobj2))
-        return NULL;
-
-    if (width < 0 || height < 0)
-        return RAISE (PyExc_ValueError, "Cannot scale to negative size");
+    int loopw = 0, i;
 
-    surf = PySurface_AsSurface (surfobj);
+#if defined(PG_TRANSFORM_SSE2)
+    if (factor == 2 && bpp != 3)
+    {
+        for (; loopw + 16 / bpp <= srcwidth; loopw += 16 / bpp)
+        {
+            __m128i pixels = _mm_loadu_si128 ((const __m128i*)srcpix);
+            __m128i lo, hi;
 
-    if (!surfobj2)
+            if (bpp == 1)
+            {
+                lo = _mm_unpacklo_epi8 (pixels, pixels);
+                hi = _mm_unpackhi_epi8 (pixels, pixels);
+            }
+            else if (bpp == 2)
+            {
+                lo = _mm_unpacklo_epi16 (pixels, pixels);
+                hi = _mm_unpackhi_epi16 (pixels, pixels);
+            }
+            else
+            {
+                lo = _mm_unpacklo_epi32 (pixels, pixels);
+                hi = _mm_unpackhi_epi32 (pixels, pixels);
+            }
+            _mm_storeu_si128 ((__m128i*)dstpix, lo);
+            _mm_storeu_si128 ((__m128i*)(dstpix + 16), hi);
+            srcpix += 16;
+            dstpix += 32;
+        }
+    }
+    else if (factor == 4 && bpp == 4)
     {
-        newsurf = newsurf_fromsurf (surf, width, height);
-        if (!newsurf)
-            return NULL;
+        for (; loopw + 4 <= srcwidth; loopw += 4)
+        {
+            __m128i pixels = _mm_loadu_si128 ((const __m128i*)srcpix);
+
+            _mm_storeu_si128 ((__m128i*)dstpix,
+                              _mm_shuffle_epi32 (pixels, 0x00));
+            _mm_storeu_si128 ((__m128i*)(dstpix + 16),
+                              _mm_shuffle_epi32 (pixels, 0x55));
+            _mm_storeu_si128 ((__m128i*)(dstpix + 32),
+                              _mm_shuffle_epi32 (pixels, 0xAA));
+            _mm_storeu_si128 ((__m128i*)(dstpix + 48),
+                              _mm_shuffle_epi32 (pixels, 0xFF));
+            srcpix += 16;
+            dstpix += 64;
+        }
     }
-    else
-        newsurf = PySurface_AsSurface (surfobj2);
+#endif
 
-    /* check to see if the size is twice as big. */
-    if (newsurf->w != width || newsurf->h != height)
-        return RAISE (PyExc_ValueError,
-                      "Destination surface not the given width or height.");
+    switch (bpp)
+    {
+    case 1:
+        for (; loopw < srcwidth; ++loopw)
+        {
+            memset (dstpix, *srcpix++, factor);
+            dstpix += factor;
+        }
+        break;
+    case 2:
+        for (; loopw < srcwidth; ++loopw, srcpix += 2)
+            for (i = 0; i < factor; ++i, dstpix += 2)
+                *(Uint16*)dstpix = *(Uint16*)srcpix;
+        break;
+    case 3:
+        for (; loopw < srcwidth; ++loopw, srcpix += 3)
+            for (i = 0; i < factor; ++i, dstpix += 3)
+            {
+                dstpix[0] = srcpix[0];
+                dstpix[1] = srcpix[1];
+                dstpix[2] = srcpix[2];
+            }
+        break;
+    default: /*case 4:*/
+        for (; loopw < srcwidth; ++loopw, srcpix += 4)
+            for (i = 0; i < factor; ++i, dstpix += 4)
+                *(Uint32*)dstpix = *(Uint32*)srcpix;
+        break;
+    }
+}
 
-    /* check to see if the format of the surface is the same. */
-    if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
-        return RAISE (PyExc_ValueError,
-                      "Source and destination surfaces need the same format.");
+/* Nearest neighbour scale of src to the size of dst. A destination row
+ * from the same source row as the one before it is copied from that row,
+ * so whole number vertical factors only stretch each source row once.
+ */
+static void
+stretch (SDL_Surface *src, SDL_Surface *dst)
+{
+    int looph;
+
+    Uint8* srcrow = (Uint8*) src->pixels;
+    Uint8* dstrow = (Uint8*) dst->pixels;
+    Uint8* lastrow = NULL;
+
+    int srcpitch = src->pitch;
+    int dstpitch = dst->pitch;
+    int bpp = src->format->BytesPerPixel;
+
+    int dstwidth = dst->w;
+    int dstheight = dst->h;
+    int dstheight2 = dst->h << 1;
+    int srcheight2 = src->h << 1;
+    int factor = src->w && !(dstwidth % src->w) ? dstwidth / src->w : 0;
+
+    int h_err = srcheight2 - dstheight2;
+
+    for (looph = 0; looph < dstheight; ++looph)
+    {
+        if (lastrow)
+            memcpy (dstrow, lastrow, (size_t) dstwidth * bpp);
+        else if (factor)
+            stretch_row_repeat (srcrow, dstrow, src->w, factor, bpp);
+        else
+            stretch_row (srcrow, dstrow, src->w, dstwidth, bpp);
+
+        lastrow = dstrow;
+        while (h_err >= 0)
+        {
+            srcrow += srcpitch;
+            h_err -= dstheight2;
+            lastrow = NULL;
+        }
+        dstrow += dstpitch;
+        h_err += srcheight2;
+    }
+}
+
+/* Return the Surface for the result of a transform of surfobj: surfobj2,
+ * if given, or a new Surface for newsurf. The result keeps the
+ * premultiplied alpha flag of surfobj.
+ */
+static PyObject*
+transform_result (PyObject *surfobj, PyObject *surfobj2, SDL_Surface *newsurf)
+{
+    PyObject *result;
+
+    if (surfobj2)
+    {
+        SDL_Rect all = {0, 0, newsurf->w, newsurf->h};
+
+        PySurface_DropRLE (surfobj2);
+        PySurface_AddDamage (surfobj2, &all);
+        Py_INCREF (surfobj2);
+        result = surfobj2;
+    }
+    else
+    {
+        result = PySurface_New (newsurf);
+        if (!result)
+            return NULL;
+    }
+    ((PySurfaceObject *) result)->premultiplied =
+        ((PySurfaceObject *) surfobj)->premultiplied;
+    return result;
+}
+
+static PyObject*
+surf_scale (PyObject* self, PyObject* arg)
+{
+    PyObject *surfobj, *surfobj2;
+    SDL_Surface* surf, *newsurf;
+    int width, height;
+    surfobj2 = NULL;
+
+    /*get all the arguments*/
+    if (!PyArg_ParseTuple (arg, "O&(ii)|O!", PySurface_Source, &surfobj,
+                           &width, &height, &PySurface_Type, &surfobj2))
+        return NULL;
+
+    if (width < 0 || height < 0)
+        return RAISE (PyExc_ValueError, "Cannot scale to negative size");
+
+    surf = PySurface_AsSurface (surfobj);
+
+    newsurf = transform_dest (surf, surfobj2, width, height);
+    if (!newsurf)
+        return NULL;
 
     if (width && height)
     {
-        SDL_LockSurface (newsurf);
+        /* a subsurface of the display is locked through its parent */
+        if (surfobj2)
+            PySurface_Lock (surfobj2);
+        else
+            SDL_LockSurface (newsurf);
         PySurface_Lock (surfobj);
 
         Py_BEGIN_ALLOW_THREADS;
@@ -520,91 +898,109 @@ surf_scale (PyObject* self, PyObject* arg)
         Py_END_ALLOW_THREADS;
 
         PySurface_Unlock (surfobj);
-        SDL_UnlockSurface (newsurf);
+        if (surfobj2)
+            PySurface_Unlock (surfobj2);
+        else
+            SDL_UnlockSurface (newsurf);
     }
 
-    if (surfobj2)
-    {
-        Py_INCREF (surfobj2);
-        return surfobj2;
-    }
-    else
-        return PySurface_New (newsurf);
+    return transform_result (surfobj, surfobj2, newsurf);
 }
 
+static Uint8* smooth_take_scratch (size_t size);
+static void smooth_give_scratch (Uint8 *scratch, size_t size);
+
+/* scale2x, scale3x and scale4x, for factor 2, 3 or 4 */
 static PyObject*
-surf_scale2x (PyObject* self, PyObject* arg)
+surf_scale_nx (PyObject* arg, int factor)
 {
     PyObject *surfobj, *surfobj2;
     SDL_Surface *surf;
     SDL_Surface *newsurf;
+    Uint8 *scratch = NULL;
+    size_t scratch_size = 0;
     int width, height;
     surfobj2 = NULL;
 
     /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!|O!", &PySurface_Type, &surfobj,
+    if (!PyArg_ParseTuple (arg, "O&|O!", PySurface_Source, &surfobj,
                            &PySurface_Type, &surfobj2))
         return NULL;
 
     surf = PySurface_AsSurface (surfobj);
 
-    /* if the second surface is not there, then make a new one. */
+    /* the destination must be factor times as big */
+    width = surf->w * factor;
+    height = surf->h * factor;
+    newsurf = transform_dest (surf, surfobj2, width, height);
+    if (!newsurf)
+        return NULL;
 
-    if (!surfobj2)
+    if (factor == 4)
     {
-        width = surf->w * 2;
-        height = surf->h * 2;
-
-        newsurf = newsurf_fromsurf (surf, width, height);
-
-        if (!newsurf)
-            return NULL;
+        scratch_size = scale4x_scratch_size (surf);
+        scratch = smooth_take_scratch (scratch_size);
+        if (!scratch)
+        {
+            if (!surfobj2)
+                PySurface_FreeSurface (newsurf);
+            return PyErr_NoMemory ();
+        }
     }
-    else
-        newsurf = PySurface_AsSurface (surfobj2);
-
-    /* check to see if the size is twice as big. */
-    if (newsurf->w != (surf->w * 2) || newsurf->h != (surf->h * 2))
-        return RAISE (PyExc_ValueError, "Destination surface not 2x bigger.");
-
-    /* check to see if the format of the surface is the same. */
-    if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
-        return RAISE (PyExc_ValueError,
-                      "Source and destination surfaces need the same format.");
 
     SDL_LockSurface (newsurf);
     SDL_LockSurface (surf);
 
     Py_BEGIN_ALLOW_THREADS;
-    scale2x (surf, newsurf);
+    if (factor == 2)
+        scale2x (surf, newsurf);
+    else if (factor == 3)
+        scale3x (surf, newsurf);
+    else
+        scale4x (surf, newsurf, scratch);
     Py_END_ALLOW_THREADS;
 
     SDL_UnlockSurface (surf);
     SDL_UnlockSurface (newsurf);
 
-    if (surfobj2)
-    {
-        Py_INCREF (surfobj2);
-        return surfobj2;
-    }
-    else
-        return PySurface_New (newsurf);
+    if (scratch)
+        smooth_give_scratch (scratch, scratch_size);
+    return transform_result (surfobj, surfobj2, newsurf);
+}
+
+static PyObject*
+surf_scale2x (PyObject* self, PyObject* arg)
+{
+    return surf_scale_nx (arg, 2);
+}
+
+static PyObject*
+surf_scale3x (PyObject* self, PyObject* arg)
+{
+    return surf_scale_nx (arg, 3);
+}
+
+static PyObject*
+surf_scale4x (PyObject* self, PyObject* arg)
+{
+    return surf_scale_nx (arg, 4);
 }
 
 static PyObject*
 surf_rotate (PyObject* self, PyObject* arg)
 {
-    PyObject *surfobj;
+    PyObject *surfobj, *surfobj2;
     SDL_Surface* surf, *newsurf;
     float angle;
 
-    double radangle, sangle, cangle;
-    double x, y, cx, cy, sx, sy;
-    int nxmax,nymax;
+    double sangle, cangle;
+    int numturns, width, height;
     Uint32 bgcolor;
+    surfobj2 = NULL;
 
     /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!f", &PySurface_Type, &surfobj, &angle))
+    if (!PyArg_ParseTuple (arg, "O&f|O!", PySurface_Source, &surfobj, &angle,
+                           &PySurface_Type, &surfobj2))
         return NULL;
     surf = PySurface_AsSurface (surfobj);
 
@@ -612,40 +1008,26 @@ surf_rotate (PyObject* self, PyObject* arg)
         return RAISE (PyExc_ValueError,
                       "unsupport Surface bit depth for transform");
 
+    numturns = rotate_size (surf->w, surf->h, angle, &width, &height,
+                            &sangle, &cangle);
 
+    newsurf = transform_dest (surf, surfobj2, width, height);
+    if (!newsurf)
+        return NULL;
 
-    if ( !( fmod((double)angle, (double)90.0f) ) ) {
+    if (numturns >= 0) {
+        SDL_LockSurface (newsurf);
         PySurface_Lock (surfobj);
 
         Py_BEGIN_ALLOW_THREADS;
-        newsurf = rotate90 (surf, (int) angle);
+        rotate90 (surf, newsurf, numturns);
         Py_END_ALLOW_THREADS;
 
         PySurface_Unlock (surfobj);
-        if (!newsurf)
-            return NULL;
-        return PySurface_New (newsurf);
+        SDL_UnlockSurface (newsurf);
+        return transform_result (surfobj, surfobj2, newsurf);
     }
 
-    radangle = angle*.01745329251994329;
-    sangle = sin (radangle);
-    cangle = cos (radangle);
-
-    x = surf->w;
-    y = surf->h;
-    cx = cangle*x;
-    cy = cangle*y;
-    sx = sangle*x;
-    sy = sangle*y;
-    nxmax = (int) (MAX (MAX (MAX (fabs (cx + sy), fabs (cx - sy)),
-                             fabs (-cx + sy)), fabs (-cx - sy)));
-    nymax = (int) (MAX (MAX (MAX (fabs (sx + cy), fabs (sx - cy)),
-                             fabs (-sx + cy)), fabs (-sx - cy)));
-
-    newsurf = newsurf_fromsurf (surf, nxmax, nymax);
-    if (!newsurf)
-        return NULL;
-
     /* get the background color */
     if (surf->flags & SDL_SRCCOLORKEY)
         bgcolor = surf->format->colorkey;
@@ -688,26 +1070,62 @@ surf_rotate (PyObject* self, PyObject* arg)
     PySurface_Unlock (surfobj);
     SDL_UnlockSurface (newsurf);
 
-    return PySurface_New (newsurf);
+    return transform_result (surfobj, surfobj2, newsurf);
+}
+
+static PyObject*
+surf_get_rotated_size (PyObject* self, PyObject* arg)
+{
+    PyObject *scaleobj = NULL;
+    int width, height, dstwidth, dstheight;
+    float angle;
+    double scale, sangle, cangle;
+
+    if (!PyArg_ParseTuple (arg, "(ii)f|O", &width, &height, &angle,
+                           &scaleobj))
+        return NULL;
+    if (width < 0 || height < 0)
+        return RAISE (PyExc_ValueError, "Cannot rotate a negative size");
+
+    if (scaleobj == NULL || scaleobj == Py_None)
+        rotate_size (width, height, angle, &dstwidth, &dstheight,
+                     &sangle, &cangle);
+    else
+    {
+        scale = PyFloat_AsDouble (scaleobj);
+        if (scale == -1.0 && PyErr_Occurred ())
+            return NULL;
+        /* as surf_rotozoom makes them */
+        if ((float) scale == 0.0)
+        {
+            dstwidth = width;
+            dstheight = height;
+        }
+        else
+            rotozoomSurfaceDstSize (width, height, (float) angle,
+                                    (float) scale, &dstwidth, &dstheight);
+    }
+    return Py_BuildValue ("(ii)", dstwidth, dstheight);
 }
 
 static PyObject*
 surf_flip (PyObject* self, PyObject* arg)
 {
-    PyObject *surfobj;
+    PyObject *surfobj, *surfobj2;
     SDL_Surface* surf, *newsurf;
     int xaxis, yaxis;
-    int loopx, loopy;
+    int loopy;
     int pixsize, srcpitch, dstpitch;
     Uint8 *srcpix, *dstpix;
+    surfobj2 = NULL;
 
     /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!ii", &PySurface_Type, &surfobj,
-                           &xaxis, &yaxis))
+    if (!PyArg_ParseTuple (arg, "O&ii|O!", PySurface_Source, &surfobj,
+                           &xaxis, &yaxis, &PySurface_Type, &surfobj2))
         return NULL;
     surf = PySurface_AsSurface (surfobj);
 
-    newsurf = newsurf_fromsurf (surf, surf->w, surf->h);
+    newsurf = transform_dest (surf, surfobj2, surf->w, surf->h);
     if (!newsurf)
         return NULL;
 
@@ -744,134 +1162,81 @@ surf_flip (PyObject* self, PyObject* arg)
     {
         if (yaxis)
         {
-            switch (surf->format->BytesPerPixel)
-            {
-            case 1:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint8* dst = (Uint8*) (dstpix + loopy * dstpitch);
-                    Uint8* src = ((Uint8*) (srcpix + (surf->h - 1 - loopy)
-                                            * srcpitch)) + surf->w - 1;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                        *dst++ = *src--;
-                }
-                break;
-            case 2:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint16* dst = (Uint16*) (dstpix + loopy * dstpitch);
-                    Uint16* src = ((Uint16*)
-                                   (srcpix + (surf->h - 1 - loopy)
-                                    * srcpitch)) + surf->w - 1;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                        *dst++ = *src--;
-                }
-                break;
-            case 4:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint32* dst = (Uint32*) (dstpix + loopy * dstpitch);
-                    Uint32* src = ((Uint32*)
-                                   (srcpix + (surf->h - 1 - loopy)
-                                    * srcpitch)) + surf->w - 1;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                        *dst++ = *src--;
-                }
-                break;
-            case 3:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint8* dst = (Uint8*) (dstpix + loopy * dstpitch);
-                    Uint8* src = ((Uint8*) (srcpix + (surf->h - 1 - loopy)
-                                            * srcpitch)) + surf->w * 3 - 3;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                    {
-                        dst[0] = src[0];
-                        dst[1] = src[1];
-                        dst[2] = src[2];
-                        dst += 3;
-                        src -= 3;
-                    }
-                }
-                break;
-            }
+            for (loopy = 0; loopy < surf->h; ++loopy)
+                reverse_row (srcpix + (surf->h - 1 - loopy) * srcpitch,
+                             dstpix + loopy * dstpitch, surf->w, pixsize);
         }
         else
         {
-            switch (surf->format->BytesPerPixel)
-            {
-            case 1:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint8* dst = (Uint8*) (dstpix + loopy * dstpitch);
-                    Uint8* src = ((Uint8*) (srcpix + loopy * srcpitch)) +
-                        surf->w - 1;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                        *dst++ = *src--;
-                }
-                break;
-            case 2:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint16* dst = (Uint16*) (dstpix + loopy * dstpitch);
-                    Uint16* src = ((Uint16*) (srcpix + loopy * srcpitch))
-                        + surf->w - 1;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                        *dst++ = *src--;
-                }
-                break;
-            case 4:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint32* dst = (Uint32*) (dstpix + loopy * dstpitch);
-                    Uint32* src = ((Uint32*) (srcpix + loopy * srcpitch))
-                        + surf->w - 1;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                        *dst++ = *src--;
-                }
-                break;
-            case 3:
-                for (loopy = 0; loopy < surf->h; ++loopy)
-                {
-                    Uint8* dst = (Uint8*) (dstpix + loopy * dstpitch);
-                    Uint8* src = ((Uint8*) (srcpix + loopy * srcpitch))
-                        + surf->w * 3 - 3;
-                    for (loopx = 0; loopx < surf->w; ++loopx)
-                    {
-                        dst[0] = src[0];
-                        dst[1] = src[1];
-                        dst[2] = src[2];
-                        dst += 3;
-                        src -= 3;
-                    }
-                }
-                break;
-            }
+            for (loopy = 0; loopy < surf->h; ++loopy)
+                reverse_row (srcpix + loopy * srcpitch,
+                             dstpix + loopy * dstpitch, surf->w, pixsize);
         }
     }
     Py_END_ALLOW_THREADS;
 
     PySurface_Unlock (surfobj);
     SDL_UnlockSurface (newsurf);
-    return PySurface_New (newsurf);
+    return transform_result (surfobj, surfobj2, newsurf);
+}
+
+/* rotozoom rows first to first + n - 1 of a rotozoomSurfaceBegin job */
+static int
+rotozoom_rows (void *data, int first, int n)
+{
+    rotozoomSurfaceRows (data, first, n);
+    return 0;
 }
 
 static PyObject*
 surf_rotozoom (PyObject* self, PyObject* arg)
 {
-    PyObject *surfobj;
+    PyObject *surfobj, *surfobj2;
     SDL_Surface *surf, *newsurf, *surf32;
     float scale, angle;
+    int width, height;
+    void *job = NULL;
+    surfobj2 = NULL;
 
     /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!ff", &PySurface_Type, &surfobj, &angle,
-                           &scale))
+    if (!PyArg_ParseTuple (arg, "O&ff|O!", PySurface_Source, &surfobj, &angle,
+                           &scale, &PySurface_Type, &surfobj2))
         return NULL;
     surf = PySurface_AsSurface (surfobj);
     if (scale == 0.0)
     {
-        newsurf = newsurf_fromsurf (surf, surf->w, surf->h);
-        return PySurface_New (newsurf);
+        newsurf = transform_dest (surf, surfobj2, surf->w, surf->h);
+        if (!newsurf)
+            return NULL;
+        if (surfobj2)
+        {
+            SDL_LockSurface (newsurf);
+            clear_surface (newsurf);
+            SDL_UnlockSurface (newsurf);
+        }
+        return transform_result (surfobj, surfobj2, newsurf);
+    }
+
+    if (surfobj2)
+    {
+        /* the format rotozoomSurface gives its result */
+        int is32bit = surf->format->BitsPerPixel == 32;
+
+        newsurf = PySurface_AsSurface (surfobj2);
+        rotozoomSurfaceDstSize (surf->w, surf->h, angle, scale,
+                                &width, &height);
+        if (newsurf->w != width || newsurf->h != height)
+            return RAISE (PyExc_ValueError,
+                          "Destination surface not the required width or height.");
+        if (newsurf->format->BitsPerPixel != 32 ||
+            newsurf->format->Rmask != (is32bit ? surf->format->Rmask : 0x000000ff) ||
+            newsurf->format->Gmask != (is32bit ? surf->format->Gmask : 0x0000ff00) ||
+            newsurf->format->Bmask != (is32bit ? surf->format->Bmask : 0x00ff0000))
+            return RAISE (PyExc_ValueError,
+                          "Destination surface not the format rotozoom returns.");
+        if (newsurf == surf)
+            return RAISE (PyExc_ValueError,
+                          "Source and destination surfaces must differ.");
     }
 
     if (surf->format->BitsPerPixel == 32)
@@ -888,49 +1253,86 @@ surf_rotozoom (PyObject* self, PyObject* arg)
         SDL_BlitSurface (surf, NULL, surf32, NULL);
         Py_END_ALLOW_THREADS;
     }
+    /* After the source is locked, as that may decode compressed pixels */
+    if (surfobj2)
+        PySurface_Unshare (surfobj2);
+    else
+    {
+        /* as rotozoomSurface makes it, from the pool, which needs the GIL */
+        rotozoomSurfaceDstSize (surf32->w, surf32->h, angle, scale,
+                                &width, &height);
+        newsurf = PySurface_CreateRGBSurface (SDL_SWSURFACE, width, height,
+                                              32, surf32->format->Rmask,
+                                              surf32->format->Gmask,
+                                              surf32->format->Bmask,
+                                              surf32->format->Amask);
+    }
 
     Py_BEGIN_ALLOW_THREADS;
-    newsurf = rotozoomSurface (surf32, angle, scale, 1);
+    if (newsurf)
+    {
+        SDL_LockSurface (newsurf);
+        /* pixels outside the rotated surface are left alone, so clear them
+           as in a new surface */
+        if (surfobj2)
+            clear_surface (newsurf);
+        job = rotozoomSurfaceBegin (surf32, newsurf, angle, scale, 1);
+        if (job)
+        {
+            smooth_jobs (rotozoom_rows, job, newsurf->h,
+                         newsurf->w * newsurf->h);
+            rotozoomSurfaceEnd (job);
+        }
+        SDL_UnlockSurface (newsurf);
+    }
     Py_END_ALLOW_THREADS;
+    if (newsurf && !job)
+    {
+        if (!surfobj2)
+            PySurface_FreeSurface (newsurf);
+        newsurf = NULL;
+        SDL_SetError ("Out of memory");
+    }
 
     if (surf32 == surf)
         PySurface_Unlock (surfobj);
     else
         SDL_FreeSurface (surf32);
-    return PySurface_New (newsurf);
+    if (!newsurf)
+        return RAISE (PyExc_SDLError, SDL_GetError ());
+    return transform_result (surfobj, surfobj2, newsurf);
 }
 
-static SDL_Surface*
-chop (SDL_Surface *src, int x, int y, int width, int height)
+/* Clip the area chop removes from src to src */
+static void
+chop_area (SDL_Surface *src, GAME_Rect *area)
 {
-    SDL_Surface* dst;
-    int dstwidth,dstheight;
-    char *srcpix, *dstpix, *srcrow, *dstrow;
-    int srcstepx, srcstepy, dststepx, dststepy;
-    int loopx,loopy;
-
-    if ((x + width) > src->w)
-        width = src->w - x;
-    if ((y + height) > src->h)
-        height=src->h - y;
-    if (x < 0)
+    if ((area->x + area->w) > src->w)
+        area->w = src->w - area->x;
+    if ((area->y + area->h) > src->h)
+        area->h = src->h - area->y;
+    if (area->x < 0)
     {
-        width -= (-x);
-        x = 0;
+        area->w -= (-area->x);
+        area->x = 0;
     }
-    if (y < 0)
+    if (area->y < 0)
     {
-        height -= (-y);
-        y = 0;
+        area->h -= (-area->y);
+        area->y = 0;
     }
+}
 
-    dstwidth = src->w-width;
-    dstheight = src->h-height;
+/* Copy src without the area from chop_area to dst, which is that much
+ * smaller. Both surfaces must be locked.
+ */
+static void
+chop (SDL_Surface *src, SDL_Surface *dst, int x, int y, int width, int height)
+{
+    char *srcpix, *dstpix, *srcrow, *dstrow;
+    int srcstepx, srcstepy, dststepx, dststepy;
+    int loopx,loopy;
 
-    dst = newsurf_fromsurf (src,dstwidth,dstheight);
-    if (!dst)
-        return NULL;
-    SDL_LockSurface (dst);
     srcrow = (char*) src->pixels;
     dstrow = (char*) dst->pixels;
     srcstepx = dststepx = src->format->BytesPerPixel;
@@ -972,28 +1374,40 @@ chop (SDL_Surface *src, int x, int y, int width, int height)
     }
         srcrow += srcstepy;
     }
-    SDL_UnlockSurface (dst);
-    return dst;
 }
 
 static PyObject*
 surf_chop (PyObject* self, PyObject* arg)
 {
-    PyObject *surfobj, *rectobj;
+    PyObject *surfobj, *rectobj, *surfobj2;
     SDL_Surface* surf, *newsurf;
-    GAME_Rect* rect, temp;
+    GAME_Rect* rect, temp, area;
+    surfobj2 = NULL;
 
-    if (!PyArg_ParseTuple (arg, "O!O", &PySurface_Type, &surfobj, &rectobj))
+    if (!PyArg_ParseTuple (arg, "O&O|O!", PySurface_Source, &surfobj, &rectobj,
+                           &PySurface_Type, &surfobj2))
         return NULL;
     if (!(rect = GameRect_FromObject (rectobj, &temp)))
         return RAISE (PyExc_TypeError, "Rect argument is invalid");
 
     surf=PySurface_AsSurface (surfobj);
+    area = *rect;
+    chop_area (surf, &area);
+    newsurf = transform_dest (surf, surfobj2, surf->w - area.w, surf->h - area.h);
+    if (!newsurf)
+        return NULL;
+
+    SDL_LockSurface (newsurf);
+    PySurface_Lock (surfobj);
+
     Py_BEGIN_ALLOW_THREADS;
-    newsurf = chop (surf, rect->x, rect->y, rect->w, rect->h);
+    chop (surf, newsurf, area.x, area.y, area.w, area.h);
     Py_END_ALLOW_THREADS;
 
-    return PySurface_New (newsurf);
+    PySurface_Unlock (surfobj);
+    SDL_UnlockSurface (newsurf);
+
+    return transform_result (surfobj, surfobj2, newsurf);
 }
 
 
@@ -1163,6 +1577,7 @@ static void filter_expand_X_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int height, int
 /* this function implements a bilinear filter in the Y-dimension */
 static void filter_expand_Y_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int srcheight, int dstheight)
 {
+    int dstdiff = dstpitch - (width * 4);
     int x, y;
 
     for (y = 0; y < dstheight; y++)
@@ -1179,15 +1594,139 @@ static void filter_expand_Y_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int width, int s
             *dstpix++ = (Uint8) (((*srcrow0++ * ymult0) + (*srcrow1++ * ymult1)) >> 16);
             *dstpix++ = (Uint8) (((*srcrow0++ * ymult0) + (*srcrow1++ * ymult1)) >> 16);
         }
+        dstpix += dstdiff;
     }
 }
 
-#if defined(SCALE_MMX_SUPPORT)
+/* this function implements a weighted blur filter in the X-dimension. The
+ * 2 * radius + 1 weights are 16.16 fixed point and sum to 0x10000; pixels
+ * past the ends of a row repeat the end pixels. */
+static void filter_blur_X_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius)
+{
+    int x, y, k;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *src = srcpix + y * srcpitch;
+        Uint8 *dst = dstpix + y * dstpitch;
+        for (x = 0; x < width; x++)
+        {
+            int r = 0x8000, g = 0x8000, b = 0x8000, a = 0x8000;
+            for (k = -radius; k <= radius; k++)
+            {
+                int sx = x + k;
+                int w = weights[k + radius];
+                Uint8 *p;
+                if (sx < 0)
+                    sx = 0;
+                else if (sx >= width)
+                    sx = width - 1;
+                p = src + sx * 4;
+                r += p[0] * w;
+                g += p[1] * w;
+                b += p[2] * w;
+                a += p[3] * w;
+            }
+            *dst++ = (Uint8) (r >> 16);
+            *dst++ = (Uint8) (g >> 16);
+            *dst++ = (Uint8) (b >> 16);
+            *dst++ = (Uint8) (a >> 16);
+        }
+    }
+}
+
+/* this function implements a weighted blur filter in the Y-dimension */
+static void filter_blur_Y_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch, int dstpitch, int height, const int *weights, int radius)
+{
+    int channels = width * 4;
+    int i, y, k;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *dst = dstpix + y * dstpitch;
+        for (i = 0; i < channels; i++)
+        {
+            int sum = 0x8000;
+            for (k = -radius; k <= radius; k++)
+            {
+                int sy = y + k;
+                if (sy < 0)
+                    sy = 0;
+                else if (sy >= height)
+                    sy = height - 1;
+                sum += srcpix[sy * srcpitch + i] * weights[k + radius];
+            }
+            dst[i] = (Uint8) (sum >> 16);
+        }
+    }
+}
+
+/* this function implements a convolution with a square kernel of
+ * 2 * radius + 1 rows of 16.16 fixed point weights. srcpix has radius
+ * pixels of border on every side: destination pixel (x, y) is the sum of
+ * source pixels (x, y) to (x + 2 * radius, y + 2 * radius) times the
+ * weights, clamped to 0 - 255. */
+static void filter_convolve_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, const int *weights, int radius)
+{
+    int size = 2 * radius + 1;
+    int x, y, kx, ky, i;
+
+    for (y = 0; y < height; y++)
+    {
+        Uint8 *dst = dstpix + y * dstpitch;
+        for (x = 0; x < width; x++)
+        {
+            const int *w = weights;
+            int sum[4] = {0x8000, 0x8000, 0x8000, 0x8000};
+            for (ky = 0; ky < size; ky++)
+            {
+                Uint8 *p = srcpix + (y + ky) * srcpitch + x * 4;
+                for (kx = 0; kx < size; kx++, p += 4, w++)
+                {
+                    sum[0] += p[0] * *w;
+                    sum[1] += p[1] * *w;
+                    sum[2] += p[2] * *w;
+                    sum[3] += p[3] * *w;
+                }
+            }
+            for (i = 0; i < 4; i++)
+                *dst++ = (Uint8) (sum[i] < 0 ? 0 : sum[i] >= 0x1000000 ? 255 : sum[i] >> 16);
+        }
+    }
+}
+
+#if defined(SCALE_SIMD_SUPPORT)
 static void
 smoothscale_init (struct _module_state *st)
 {
     if (st->filter_shrink_X == 0)
     {
+#if defined(SCALE_AVX2_SUPPORT)
+    if (PgCpu_GetFeatures () & PG_CPU_AVX2)
+    {
+        st->filter_type = "AVX2";
+        st->filter_shrink_X = filter_shrink_X_AVX2;
+        st->filter_shrink_Y = filter_shrink_Y_AVX2;
+        st->filter_expand_X = filter_expand_X_AVX2;
+        st->filter_expand_Y = filter_expand_Y_AVX2;
+        st->filter_blur_X = filter_blur_X_AVX2;
+        st->filter_blur_Y = filter_blur_Y_AVX2;
+        st->filter_convolve = filter_convolve_AVX2;
+        return;
+    }
+#endif
+#if defined(SCALE_NEON_SUPPORT)
+    st->filter_type = "NEON";
+    st->filter_shrink_X = filter_shrink_X_NEON;
+    st->filter_shrink_Y = filter_shrink_Y_NEON;
+    st->filter_expand_X = filter_expand_X_NEON;
+    st->filter_expand_Y = filter_expand_Y_NEON;
+    st->filter_blur_X = filter_blur_X_NEON;
+    st->filter_blur_Y = filter_blur_Y_NEON;
+    st->filter_convolve = filter_convolve_NEON;
+    return;
+#endif
+#if defined(SCALE_MMX_SUPPORT)
     if (SDL_HasSSE ())
     {
         st->filter_type = "SSE";
@@ -1195,6 +1734,9 @@ smoothscale_init (struct _module_state *st)
         st->filter_shrink_Y = filter_shrink_Y_SSE;
         st->filter_expand_X = filter_expand_X_SSE;
         st->filter_expand_Y = filter_expand_Y_SSE;
+        st->filter_blur_X = filter_blur_X_ONLYC;
+        st->filter_blur_Y = filter_blur_Y_ONLYC;
+        st->filter_convolve = filter_convolve_ONLYC;
     }
     else if (SDL_HasMMX ())
     {
@@ -1203,14 +1745,21 @@ smoothscale_init (struct _module_state *st)
         st->filter_shrink_Y = filter_shrink_Y_MMX;
         st->filter_expand_X = filter_expand_X_MMX;
         st->filter_expand_Y = filter_expand_Y_MMX;
+        st->filter_blur_X = filter_blur_X_ONLYC;
+        st->filter_blur_Y = filter_blur_Y_ONLYC;
+        st->filter_convolve = filter_convolve_ONLYC;
     }
     else
+#endif
     {
         st->filter_type = "GENERIC";
         st->filter_shrink_X = filter_shrink_X_ONLYC;
         st->filter_shrink_Y = filter_shrink_Y_ONLYC;
         st->filter_expand_X = filter_expand_X_ONLYC;
         st->filter_expand_Y = filter_expand_Y_ONLYC;
+        st->filter_blur_X = filter_blur_X_ONLYC;
+        st->filter_blur_Y = filter_blur_Y_ONLYC;
+        st->filter_convolve = filter_convolve_ONLYC;
     }
     }
 }
@@ -1256,9 +1805,230 @@ static void convert_32_24(Uint8 *srcpix, int srcpitch, Uint8 *dstpix, int dstpit
     }
 }
 
+/* The convert functions as filters, so they can be run in row bands */
+static void filter_convert_24_32(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, int unused)
+{
+    convert_24_32(srcpix, srcpitch, dstpix, dstpitch, width, height);
+}
+
+static void filter_convert_32_24(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch, int dstpitch, int width, int unused)
+{
+    convert_32_24(srcpix, srcpitch, dstpix, dstpitch, width, height);
+}
+
+/* Threaded smoothscale. Each pass of scalesmooth, and of the blurs, is cut
+ * into bands, rows for the X filters and columns of the Y filters, which
+ * the filters work on independently, and run on the pygame worker pool,
+ * see PgPool_Run. rotozoom, threshold and average_surfaces run jobs over
+ * bands of rows the same way.
+ */
+
+#define PG_SMOOTHSCALE_MAX_THREADS 32
+/* Passes over fewer source pixels than this stay on the calling thread */
+#define PG_SMOOTHSCALE_MIN_PIXELS (128 * 128)
+/* Fewest rows or columns given to a thread */
+#define PG_SMOOTHSCALE_MIN_BAND 8
+/* Largest scratch buffer kept between calls */
+#define PG_SMOOTHSCALE_MAX_SCRATCH (64 * 1024 * 1024)
+
+typedef struct
+{
+    SMOOTHSCALE_FILTER_P filter;
+    BLUR_FILTER_P   blur;       /* used instead of filter if set */
+    SMOOTH_JOB_P    job;        /* used instead of both if set */
+    void           *data;
+    const int      *weights;
+    int             radius;
+    Uint8          *srcpix;
+    Uint8          *dstpix;
+    int             rows;       /* bands of rows, or of columns */
+    int             first;      /* first row or column of the band */
+    int             n;
+    int             srcpitch;
+    int             dstpitch;
+    int             from;
+    int             to;
+    int             result;     /* of job */
+} SmoothBand;
+
+typedef struct
+{
+    int             threads;    /* set by set_smoothscale_threads */
+    Uint8          *scratch;    /* kept for the next call, or NULL */
+    size_t          scratch_size;
+} SmoothPool;
+
+static SmoothPool smooth_pool;
+
+static void
+smooth_band (SmoothBand *band)
+{
+    Uint8 *srcpix, *dstpix;
+
+    if (band->job)
+    {
+        band->result = band->job (band->data, band->first, band->n);
+        return;
+    }
+    srcpix = band->srcpix + band->first * (band->rows ? band->srcpitch : 4);
+    dstpix = band->dstpix + band->first * (band->rows ? band->dstpitch : 4);
+    if (band->blur)
+        band->blur (srcpix, dstpix, band->n, band->srcpitch,
+                    band->dstpitch, band->from, band->weights, band->radius);
+    else
+        band->filter (srcpix, dstpix, band->n, band->srcpitch,
+                      band->dstpitch, band->from, band->to);
+}
+
+/* PgPool_Run job doing rows or columns first to first + n - 1 of the
+ * SmoothBand data
+ */
+static int
+smooth_pool_job (void *data, int first, int n)
+{
+    SmoothBand band = *(SmoothBand *) data;
+
+    band.first = first;
+    band.n = n;
+    band.result = 0;
+    smooth_band (&band);
+    return band.result;
+}
+
+/* Run the whole of pass, over pass->n rows or columns from 0, in bands on
+ * the pool if the pass is big enough. Returns the sum of the job results.
+ */
+static int
+smooth_run (SmoothBand *pass, int pixels)
+{
+    int threads = smooth_pool.threads;
+    int grain;
+
+    pass->first = 0;
+    pass->result = 0;
+    if (threads < 2 || pixels < PG_SMOOTHSCALE_MIN_PIXELS)
+    {
+        smooth_band (pass);
+        return pass->result;
+    }
+    /* a few bands for each thread, which the filters set up once each */
+    grain = pass->n / (threads * 4);
+    if (grain < PG_SMOOTHSCALE_MIN_BAND)
+        grain = PG_SMOOTHSCALE_MIN_BAND;
+    return PgPool_Run (smooth_pool_job, pass, pass->n, grain, threads);
+}
+
+/* Run a scale filter over n rows (rows true) or columns of srcpix */
+static void
+smooth_pass (SMOOTHSCALE_FILTER_P filter, int rows, Uint8 *srcpix,
+             Uint8 *dstpix, int n, int srcpitch, int dstpitch,
+             int from, int to, int pixels)
+{
+    SmoothBand pass;
+
+    memset (&pass, 0, sizeof (pass));
+    pass.filter = filter;
+    pass.srcpix = srcpix;
+    pass.dstpix = dstpix;
+    pass.rows = rows;
+    pass.n = n;
+    pass.srcpitch = srcpitch;
+    pass.dstpitch = dstpitch;
+    pass.from = from;
+    pass.to = to;
+    smooth_run (&pass, pixels);
+}
+
+/* Run a blur or convolve filter over n rows (rows true) or columns of
+ * srcpix, each length pixels long.
+ */
+static void
+blur_pass (BLUR_FILTER_P blur, int rows, Uint8 *srcpix, Uint8 *dstpix,
+           int n, int srcpitch, int dstpitch, int length,
+           const int *weights, int radius, int pixels)
+{
+    SmoothBand pass;
+
+    memset (&pass, 0, sizeof (pass));
+    pass.blur = blur;
+    pass.weights = weights;
+    pass.radius = radius;
+    pass.srcpix = srcpix;
+    pass.dstpix = dstpix;
+    pass.rows = rows;
+    pass.n = n;
+    pass.srcpitch = srcpitch;
+    pass.dstpitch = dstpitch;
+    pass.from = length;
+    smooth_run (&pass, pixels);
+}
+
+/* Run job over n rows of data. Returns the sum of its results. */
+static int
+smooth_jobs (SMOOTH_JOB_P job, void *data, int n, int pixels)
+{
+    SmoothBand pass;
+
+    memset (&pass, 0, sizeof (pass));
+    pass.job = job;
+    pass.data = data;
+    pass.rows = 1;
+    pass.n = n;
+    return smooth_run (&pass, pixels);
+}
+
+/* Bytes of scratch memory scalesmooth needs for src and dst */
+static size_t
+scalesmooth_scratch_size(SDL_Surface *src, SDL_Surface *dst)
+{
+    size_t size = 0;
+
+    if (src->w == dst->w && src->h == dst->h)
+        return 0;
+    if (src->format->BytesPerPixel == 3)
+        size += (size_t) src->w * 4 * src->h + (size_t) dst->w * 4 * dst->h;
+    if (src->w != dst->w && src->h != dst->h)
+        size += (size_t) dst->w * 4 * src->h;
+    return size;
+}
+
+/* Get a scratch buffer of size bytes, the kept one if it is big enough.
+ * Must be called with the GIL held. Returns NULL if out of memory.
+ */
+static Uint8*
+smooth_take_scratch (size_t size)
+{
+    Uint8 *scratch = smooth_pool.scratch;
+
+    if (scratch && smooth_pool.scratch_size >= size)
+    {
+        smooth_pool.scratch = NULL;
+        return scratch;
+    }
+    return (Uint8 *) malloc(size ? size : 1);
+}
+
+/* Keep scratch from smooth_take_scratch for the next call, if it is not
+ * too big and bigger than the one kept. Must be called with the GIL held.
+ */
+static void
+smooth_give_scratch (Uint8 *scratch, size_t size)
+{
+    if (size > PG_SMOOTHSCALE_MAX_SCRATCH ||
+        (smooth_pool.scratch && smooth_pool.scratch_size >= size))
+    {
+        free(scratch);
+        return;
+    }
+    free(smooth_pool.scratch);
+    smooth_pool.scratch = scratch;
+    smooth_pool.scratch_size = size;
+}
+
+/* Scale src into dst. scratch has scalesmooth_scratch_size bytes. */
 static void
 scalesmooth(SDL_Surface *src, SDL_Surface *dst,
-            struct _module_state *st)
+            struct _module_state *st, Uint8 *scratch)
 {
     Uint8* srcpix = (Uint8*)src->pixels;
     Uint8* dstpix = (Uint8*)dst->pixels;
@@ -1274,26 +2044,22 @@ scalesmooth(SDL_Surface *src, SDL_Surface *dst,
     int bpp = src->format->BytesPerPixel;
 
     Uint8 *temppix = NULL;
-    int tempwidth=0, temppitch=0, tempheight=0;
+    int tempwidth=0, temppitch=0;
 
     /* convert to 32-bit if necessary */
     if (bpp == 3)
     {
         int newpitch = srcwidth * 4;
-        Uint8 *newsrc = (Uint8 *) malloc(newpitch * srcheight);
-        if (!newsrc)
-            return;
-        convert_24_32(srcpix, srcpitch, newsrc, newpitch, srcwidth, srcheight);
+        Uint8 *newsrc = scratch;
+        scratch += (size_t) newpitch * srcheight;
+        smooth_pass(filter_convert_24_32, 1, srcpix, newsrc, srcheight,
+                    srcpitch, newpitch, srcwidth, 0, srcwidth * srcheight);
         srcpix = newsrc;
         srcpitch = newpitch;
         /* create a destination buffer for the 32-bit result */
         dstpitch = dstwidth << 2;
-        dst32 = (Uint8 *) malloc(dstpitch * dstheight);
-        if (dst32 == NULL)
-        {
-            free(srcpix);
-            return;
-        }
+        dst32 = scratch;
+        scratch += (size_t) dstpitch * dstheight;
         dstpix = dst32;
     }
 
@@ -1302,66 +2068,86 @@ scalesmooth(SDL_Surface *src, SDL_Surface *dst,
     {
         tempwidth = dstwidth;
         temppitch = tempwidth << 2;
-        tempheight = srcheight;
-        temppix = (Uint8 *) malloc(temppitch * tempheight);
-        if (temppix == NULL)
-        {
-            if (bpp == 3)
-            {
-                free(srcpix);
-                free(dstpix);
-            }
-            return;
-        }
+        temppix = scratch;
     }
 
     /* Start the filter by doing X-scaling */
     if (dstwidth < srcwidth) /* shrink */
     {
         if (srcheight != dstheight)
-            st->filter_shrink_X(srcpix, temppix, srcheight, srcpitch, temppitch, srcwidth, dstwidth);
+            smooth_pass(st->filter_shrink_X, 1, srcpix, temppix, srcheight, srcpitch, temppitch, srcwidth, dstwidth, srcwidth * srcheight);
         else
-            st->filter_shrink_X(srcpix, dstpix, srcheight, srcpitch, dstpitch, srcwidth, dstwidth);
+            smooth_pass(st->filter_shrink_X, 1, srcpix, dstpix, srcheight, srcpitch, dstpitch, srcwidth, dstwidth, srcwidth * srcheight);
     }
     else if (dstwidth > srcwidth) /* expand */
     {
         if (srcheight != dstheight)
-            st->filter_expand_X(srcpix, temppix, srcheight, srcpitch, temppitch, srcwidth, dstwidth);
+            smooth_pass(st->filter_expand_X, 1, srcpix, temppix, srcheight, srcpitch, temppitch, srcwidth, dstwidth, dstwidth * srcheight);
         else
-            st->filter_expand_X(srcpix, dstpix, srcheight, srcpitch, dstpitch, srcwidth, dstwidth);
+            smooth_pass(st->filter_expand_X, 1, srcpix, dstpix, srcheight, srcpitch, dstpitch, srcwidth, dstwidth, dstwidth * srcheight);
     }
     /* Now do the Y scale */
     if (dstheight < srcheight) /* shrink */
     {
         if (srcwidth != dstwidth)
-            st->filter_shrink_Y(temppix, dstpix, tempwidth, temppitch, dstpitch, srcheight, dstheight);
+            smooth_pass(st->filter_shrink_Y, 0, temppix, dstpix, tempwidth, temppitch, dstpitch, srcheight, dstheight, tempwidth * srcheight);
         else
-            st->filter_shrink_Y(srcpix, dstpix, srcwidth, srcpitch, dstpitch, srcheight, dstheight);
+            smooth_pass(st->filter_shrink_Y, 0, srcpix, dstpix, srcwidth, srcpitch, dstpitch, srcheight, dstheight, srcwidth * srcheight);
     }
     else if (dstheight > srcheight)  /* expand */
     {
         if (srcwidth != dstwidth)
-            st->filter_expand_Y(temppix, dstpix, tempwidth, temppitch, dstpitch, srcheight, dstheight);
+            smooth_pass(st->filter_expand_Y, 0, temppix, dstpix, tempwidth, temppitch, dstpitch, srcheight, dstheight, tempwidth * dstheight);
         else
-            st->filter_expand_Y(srcpix, dstpix, srcwidth, srcpitch, dstpitch, srcheight, dstheight);
+            smooth_pass(st->filter_expand_Y, 0, srcpix, dstpix, srcwidth, srcpitch, dstpitch, srcheight, dstheight, srcwidth * dstheight);
     }
 
     /* Convert back to 24-bit if necessary */
     if (bpp == 3)
     {
-        convert_32_24(dst32, dstpitch, (Uint8*)dst->pixels, dst->pitch, dstwidth, dstheight);
-        free(dst32);
-        dst32 = NULL;
-        free(srcpix);
-        srcpix = NULL;
+        smooth_pass(filter_convert_32_24, 1, dst32, (Uint8*)dst->pixels,
+                    dstheight, dstpitch, dst->pitch, dstwidth, 0,
+                    dstwidth * dstheight);
     }
-    /* free temporary buffer if necessary */
-    if (temppix != NULL)
-        free(temppix);
-
 }
 
 
+/* Smoothly scale the locked src into the locked dst, which has the same
+ * pixel size and is not empty. Returns -1 with MemoryError set if there is
+ * no memory for the scratch buffers.
+ */
+static int
+smoothscale_to(SDL_Surface *src, SDL_Surface *dst, struct _module_state *st)
+{
+    size_t scratch_size = scalesmooth_scratch_size(src, dst);
+    Uint8 *scratch = smooth_take_scratch(scratch_size);
+
+    if (!scratch)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+
+    /* handle trivial case */
+    if (src->w == dst->w && src->h == dst->h) {
+        int y;
+        for (y = 0; y < dst->h; y++) {
+            memcpy((Uint8*)dst->pixels + y * dst->pitch,
+                   (Uint8*)src->pixels + y * src->pitch,
+                   dst->w * src->format->BytesPerPixel);
+        }
+    }
+    else {
+        scalesmooth(src, dst, st, scratch);
+    }
+    Py_END_ALLOW_THREADS;
+
+    smooth_give_scratch(scratch, scratch_size);
+    return 0;
+}
+
 static PyObject* surf_scalesmooth(PyObject* self, PyObject* arg)
 {
     PyObject *surfobj, *surfobj2;
@@ -1370,7 +2156,7 @@ static PyObject* surf_scalesmooth(PyObject* self, PyObject* arg)
     surfobj2 = NULL;
 
     /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!(ii)|O!", &PySurface_Type, &surfobj,
+    if (!PyArg_ParseTuple (arg, "O&(ii)|O!", PySurface_Source, &surfobj,
                            &width, &height, &PySurface_Type, &surfobj2))
         return NULL;
 
@@ -1384,20 +2170,9 @@ static PyObject* surf_scalesmooth(PyObject* self, PyObject* arg)
         return RAISE(PyExc_ValueError, "Only 24-bit or 32-bit surfaces can be smoothly scaled");
 
 
-    if (!surfobj2)
-    {
-        newsurf = newsurf_fromsurf (surf, width, height);
-        if (!newsurf)
-            return NULL;
-    }
-    else
-        newsurf = PySurface_AsSurface (surfobj2);
-
-    /* check to see if the size is twice as big. */
-    if (newsurf->w != width || newsurf->h != height)
-        return RAISE (PyExc_ValueError,
-                      "Destination surface not the given width or height.");
-
+    newsurf = transform_dest (surf, surfobj2, width, height);
+    if (!newsurf)
+        return NULL;
 
     if(((width * bpp + 3) >> 2) > newsurf->pitch)
         return RAISE(PyExc_ValueError, "SDL Error: destination surface pitch not 4-byte aligned.");
@@ -1405,122 +2180,808 @@ static PyObject* surf_scalesmooth(PyObject* self, PyObject* arg)
 
     if(width && height)
     {
+        int result;
+        Uint64 start;
+
+        PG_PERF_BEGIN(start);
         SDL_LockSurface(newsurf);
         PySurface_Lock(surfobj);
-        Py_BEGIN_ALLOW_THREADS;
-
-        /* handle trivial case */
-        if (surf->w == width && surf->h == height) {
-            int y;
-            for (y = 0; y < height; y++) {
-                memcpy((Uint8*)newsurf->pixels + y * newsurf->pitch,
-                       (Uint8*)surf->pixels + y * surf->pitch, width * bpp);
-            }
-        }
-        else {
-            scalesmooth(surf, newsurf, GETSTATE (self));
-        }
-        Py_END_ALLOW_THREADS;
-
+        result = smoothscale_to(surf, newsurf, GETSTATE (self));
         PySurface_Unlock(surfobj);
         SDL_UnlockSurface(newsurf);
-    }
+        PG_PERF_ADD(PG_PERF_SMOOTHSCALE_CALLS, 1);
+        PG_PERF_ADD(PG_PERF_SMOOTHSCALE_PIXELS, (Uint64)width * height);
+        PG_PERF_END(start, PG_PERF_SMOOTHSCALE_NS);
 
-    if (surfobj2)
-    {
-        Py_INCREF (surfobj2);
-        return surfobj2;
+        if (result)
+        {
+            if (!surfobj2)
+                PySurface_FreeSurface (newsurf);
+            return NULL;
+        }
     }
-    else
-        return PySurface_New (newsurf);
+
+    return transform_result (surfobj, surfobj2, newsurf);
 
 }
 
-static PyObject *
-surf_get_smoothscale_backend (PyObject *self)
+/* MipChain: smaller copies of a surface, each half the size of the one
+ * before, kept for smoothscale. levels[n] is the source halved n times,
+ * or NULL if it is not kept; levels[0] is always NULL, the source itself
+ * is used for it.
+ */
+#define PG_MIP_MAX_LEVELS 32
+
+typedef struct
 {
-    return Text_FromUTF8 (GETSTATE (self)->filter_type);
+    PyObject_HEAD
+    PyObject *module;       /* the transform module, for the backend */
+    PyObject *surfobj;      /* the source Surface */
+    SDL_Surface *levels[PG_MIP_MAX_LEVELS];
+    unsigned long used[PG_MIP_MAX_LEVELS];  /* when each level was used */
+    unsigned long clock;
+    size_t bytes;           /* pixel bytes of the kept levels */
+    size_t max_bytes;       /* 0 for no limit */
+} PyMipChainObject;
+
+static PyTypeObject PyMipChain_Type;
+
+static int
+mip_level_size (SDL_Surface *surf, int level, int *width, int *height)
+{
+    *width = MAX (surf->w >> level, 1);
+    *height = MAX (surf->h >> level, 1);
+    return level == 0 || (surf->w >> (level - 1)) > 1 ||
+        (surf->h >> (level - 1)) > 1;
 }
 
-static  PyObject *
-surf_set_smoothscale_backend (PyObject *self, PyObject *args, PyObject *kwds)
+static void
+mip_drop (PyMipChainObject *self, int level)
 {
-    struct _module_state *st = GETSTATE (self);
-    char *keywords[] = {"type", NULL};
-    const char *type;
+    SDL_Surface *surf = self->levels[level];
 
-    if (!PyArg_ParseTupleAndKeywords (args, kwds, "s:set_smoothscale_backend",
-                                      keywords, &type))
+    if (surf)
     {
-        return NULL;
+        self->bytes -= (size_t) surf->pitch * surf->h;
+        PySurface_FreeSurface (surf);
+        self->levels[level] = NULL;
     }
+}
 
-#if defined(SCALE_MMX_SUPPORT)
-    if (strcmp (type, "GENERIC") == 0)
+/* Keep the new level surf, dropping the least recently used levels to stay
+ * under max_bytes. Returns 0 if surf is too big to keep at all.
+ */
+static int
+mip_keep (PyMipChainObject *self, int level, SDL_Surface *surf)
+{
+    size_t size = (size_t) surf->pitch * surf->h;
+
+    if (self->max_bytes && size > self->max_bytes)
+        return 0;
+    while (self->max_bytes && self->bytes + size > self->max_bytes)
     {
-        st->filter_type = "GENERIC";
-        st->filter_shrink_X = filter_shrink_X_ONLYC;
-        st->filter_shrink_Y = filter_shrink_Y_ONLYC;
-        st->filter_expand_X = filter_expand_X_ONLYC;
-        st->filter_expand_Y = filter_expand_Y_ONLYC;
+        int n, oldest = 0;
+
+        for (n = 1; n < PG_MIP_MAX_LEVELS; ++n)
+            if (self->levels[n] &&
+                (!oldest || self->used[n] < self->used[oldest]))
+                oldest = n;
+        mip_drop (self, oldest);
     }
-    else if (strcmp (type, "MMX") == 0)
+    self->levels[level] = surf;
+    self->used[level] = self->clock;
+    self->bytes += size;
+    return 1;
+}
+
+/* Get level, making it and any missing levels above it from the nearest
+ * kept one. The caller owns a reference to the result, through the SDL
+ * refcount, so it stays valid if the level is dropped meanwhile.
+ */
+static SDL_Surface*
+mip_get_level (PyMipChainObject *self, int level)
+{
+    SDL_Surface *src = PySurface_AsSurface (self->surfobj);
+    SDL_Surface *from = NULL, *surf;
+    int n, width, height, result;
+
+    ++self->clock;
+    for (n = level; n > 0 && !self->levels[n]; --n)
+        ;
+    if (n > 0)
     {
-        if (!SDL_HasMMX ())
-        {
-            return RAISE (PyExc_ValueError,
-                          "MMX not supported on this machine");
-        }
-        st->filter_type = "MMX";
-        st->filter_shrink_X = filter_shrink_X_MMX;
-        st->filter_shrink_Y = filter_shrink_Y_MMX;
-        st->filter_expand_X = filter_expand_X_MMX;
-        st->filter_expand_Y = filter_expand_Y_MMX;
+        from = self->levels[n];
+        ++from->refcount;
+        self->used[n] = self->clock;
     }
-    else if (strcmp (type, "SSE") == 0)
+
+    for (++n; n <= level; ++n)
     {
-        if (!SDL_HasSSE ())
+        mip_level_size (src, n, &width, &height);
+        surf = newsurf_fromsurf (src, width, height);
+        if (!surf)
+            break;
+
+        SDL_LockSurface (surf);
+        if (from)
         {
-            return RAISE (PyExc_ValueError,
-                          "SSE not supported on this machine");
+            result = smoothscale_to (from, surf, GETSTATE (self->module));
+            PySurface_FreeSurface (from);
         }
-        st->filter_type = "SSE";
-        st->filter_shrink_X = filter_shrink_X_SSE;
-        st->filter_shrink_Y = filter_shrink_Y_SSE;
-        st->filter_expand_X = filter_expand_X_SSE;
-        st->filter_expand_Y = filter_expand_Y_SSE;
-    }
-    else
-    {
-        return PyErr_Format (PyExc_ValueError,
-                             "Unknown backend type %s", type);
-    }
-    Py_RETURN_NONE;
-#else /* Not an x86 processor */
-    if (strcmp (type, "GENERIC") != 0)
-    {
-        if (strcmp (st->filter_type, "MMX") == 0 ||
-            strcmp (st->filter_type, "SSE") == 0    )
+        else
         {
-            return PyErr_Format (PyExc_ValueError,
-                                 "%s not supported on this machine", type);
+            PySurface_Lock (self->surfobj);
+            result = smoothscale_to (src, surf, GETSTATE (self->module));
+            PySurface_Unlock (self->surfobj);
         }
-        return PyErr_Format (PyExc_ValueError,
-                             "Unknown backend type %s", type);
+        SDL_UnlockSurface (surf);
+
+        from = surf;
+        if (result)
+            break;
+        if (mip_keep (self, n, surf))
+            ++surf->refcount;
     }
-    Py_RETURN_NONE;
-#endif /* defined(SCALE_MMX_SUPPORT) */
-}
 
+    if (n <= level)
+    {
+        if (from)
+            PySurface_FreeSurface (from);
+        return NULL;
+    }
+    return from;
+}
 
-static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
-                          SDL_Surface *surf2, Uint32 color,  Uint32 threshold,
-                          Uint32 diff_color, int change_return, int inverse)
+static PyObject*
+mip_scale (PyObject *self, PyObject *args)
+{
+    PyMipChainObject *chain = (PyMipChainObject *) self;
+    PyObject *surfobj2 = NULL;
+    SDL_Surface *src = PySurface_AsSurface (chain->surfobj);
+    SDL_Surface *from, *newsurf;
+    int width, height, levelw, levelh, level, result;
+
+    if (!PyArg_ParseTuple (args, "(ii)|O!", &width, &height,
+                           &PySurface_Type, &surfobj2))
+        return NULL;
+    if (width < 0 || height < 0)
+        return RAISE (PyExc_ValueError, "Cannot scale to negative size");
+
+    newsurf = transform_dest (src, surfobj2, width, height);
+    if (!newsurf)
+        return NULL;
+    if (!width || !height)
+        return transform_result (chain->surfobj, surfobj2, newsurf);
+
+    /* the smallest level still at least as big as the result */
+    for (level = 0; level + 1 < PG_MIP_MAX_LEVELS; ++level)
+    {
+        if (!mip_level_size (src, level + 1, &levelw, &levelh) ||
+            levelw < width || levelh < height)
+            break;
+    }
+
+    from = level ? mip_get_level (chain, level) : src;
+    if (!from)
+    {
+        if (!surfobj2)
+            PySurface_FreeSurface (newsurf);
+        return NULL;
+    }
+
+    SDL_LockSurface (newsurf);
+    if (from == src)
+        PySurface_Lock (chain->surfobj);
+    result = smoothscale_to (from, newsurf, GETSTATE (chain->module));
+    if (from == src)
+        PySurface_Unlock (chain->surfobj);
+    SDL_UnlockSurface (newsurf);
+    if (level)
+        PySurface_FreeSurface (from);
+
+    if (result)
+    {
+        if (!surfobj2)
+            PySurface_FreeSurface (newsurf);
+        return NULL;
+    }
+    return transform_result (chain->surfobj, surfobj2, newsurf);
+}
+
+static PyObject*
+mip_invalidate (PyObject *self)
+{
+    PyMipChainObject *chain = (PyMipChainObject *) self;
+    int n;
+
+    for (n = 1; n < PG_MIP_MAX_LEVELS; ++n)
+        mip_drop (chain, n);
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+mip_get_bytes (PyObject *self)
+{
+    return PyInt_FromLong ((long) ((PyMipChainObject *) self)->bytes);
+}
+
+static PyObject*
+mip_get_surface (PyObject *self)
+{
+    PyObject *surfobj = ((PyMipChainObject *) self)->surfobj;
+
+    Py_INCREF (surfobj);
+    return surfobj;
+}
+
+static void
+mip_dealloc (PyObject *self)
+{
+    PyMipChainObject *chain = (PyMipChainObject *) self;
+    int n;
+
+    for (n = 1; n < PG_MIP_MAX_LEVELS; ++n)
+        mip_drop (chain, n);
+    Py_XDECREF (chain->surfobj);
+    Py_XDECREF (chain->module);
+    PyObject_DEL (self);
+}
+
+static PyMethodDef mip_methods[] =
+{
+    { "scale", mip_scale, METH_VARARGS, DOC_MIPCHAINSCALE },
+    { "invalidate", (PyCFunction) mip_invalidate, METH_NOARGS,
+      DOC_MIPCHAININVALIDATE },
+    { "get_bytes", (PyCFunction) mip_get_bytes, METH_NOARGS,
+      DOC_MIPCHAINGETBYTES },
+    { "get_surface", (PyCFunction) mip_get_surface, METH_NOARGS,
+      DOC_MIPCHAINGETSURFACE },
+    { NULL, NULL, 0, NULL }
+};
+
+static PyTypeObject PyMipChain_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "pygame.transform.MipChain",
+    sizeof (PyMipChainObject),
+    0,
+    mip_dealloc,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    NULL,
+    0,
+    (hashfunc)NULL,
+    (ternaryfunc)NULL,
+    (reprfunc)NULL,
+    0L,0L,0L,0L,
+    DOC_PYGAMETRANSFORMMIPCHAIN,        /* Documentation string */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    0,                                  /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    mip_methods,                        /* tp_methods */
+    0,                                  /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    0,                                  /* tp_new */
+};
+
+static PyObject*
+surf_mip_chain (PyObject *self, PyObject *args)
+{
+    PyObject *surfobj;
+    PyMipChainObject *chain;
+    SDL_Surface *surf;
+    Py_ssize_t max_bytes = 0;
+    int bpp;
+
+    if (!PyArg_ParseTuple (args, "O&|n", PySurface_Source, &surfobj,
+                           &max_bytes))
+        return NULL;
+    if (max_bytes < 0)
+        return RAISE (PyExc_ValueError, "max_bytes must not be negative");
+
+    surf = PySurface_AsSurface (surfobj);
+    bpp = surf->format->BytesPerPixel;
+    if (bpp < 3 || bpp > 4)
+        return RAISE (PyExc_ValueError,
+                      "Only 24-bit or 32-bit surfaces can be smoothly scaled");
+
+    chain = PyObject_New (PyMipChainObject, &PyMipChain_Type);
+    if (!chain)
+        return NULL;
+    memset (chain->levels, 0, sizeof (chain->levels));
+    memset (chain->used, 0, sizeof (chain->used));
+    chain->clock = 0;
+    chain->bytes = 0;
+    chain->max_bytes = (size_t) max_bytes;
+    Py_INCREF (self);
+    chain->module = self;
+    Py_INCREF (surfobj);
+    chain->surfobj = surfobj;
+    return (PyObject *) chain;
+}
+
+static PyObject *
+surf_get_smoothscale_threads (PyObject *self)
+{
+    return PyInt_FromLong (smooth_pool.threads);
+}
+
+static PyObject *
+surf_set_smoothscale_threads (PyObject *self, PyObject *args)
+{
+    int threads;
+    PyObject *base, *result;
+
+    if (!PyArg_ParseTuple (args, "i:set_smoothscale_threads", &threads))
+        return NULL;
+    if (threads < 0)
+        return RAISE (PyExc_ValueError, "thread count must not be negative");
+    if (threads > PG_SMOOTHSCALE_MAX_THREADS)
+        threads = PG_SMOOTHSCALE_MAX_THREADS;
+
+    /* Grow the pool to the threads asked for */
+    if (threads > 1 && threads > PgPool_GetThreads ())
+    {
+        base = PyImport_ImportModule ("pygame.base");
+        if (!base)
+            return NULL;
+        result = PyObject_CallMethod (base, "set_pool_threads", "i", threads);
+        Py_DECREF (base);
+        if (!result)
+            return NULL;
+        Py_DECREF (result);
+    }
+    smooth_pool.threads = threads;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_smoothscale_backend (PyObject *self)
+{
+    return Text_FromUTF8 (GETSTATE (self)->filter_type);
+}
+
+static  PyObject *
+surf_set_smoothscale_backend (PyObject *self, PyObject *args, PyObject *kwds)
+{
+    struct _module_state *st = GETSTATE (self);
+    char *keywords[] = {"type", NULL};
+    const char *type;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "s:set_smoothscale_backend",
+                                      keywords, &type))
+    {
+        return NULL;
+    }
+
+    if (strcmp (type, "GENERIC") == 0)
+    {
+        st->filter_type = "GENERIC";
+        st->filter_shrink_X = filter_shrink_X_ONLYC;
+        st->filter_shrink_Y = filter_shrink_Y_ONLYC;
+        st->filter_expand_X = filter_expand_X_ONLYC;
+        st->filter_expand_Y = filter_expand_Y_ONLYC;
+        st->filter_blur_X = filter_blur_X_ONLYC;
+        st->filter_blur_Y = filter_blur_Y_ONLYC;
+        st->filter_convolve = filter_convolve_ONLYC;
+    }
+#if defined(SCALE_MMX_SUPPORT)
+    else if (strcmp (type, "MMX") == 0)
+    {
+        if (!SDL_HasMMX ())
+        {
+            return RAISE (PyExc_ValueError,
+                          "MMX not supported on this machine");
+        }
+        st->filter_type = "MMX";
+        st->filter_shrink_X = filter_shrink_X_MMX;
+        st->filter_shrink_Y = filter_shrink_Y_MMX;
+        st->filter_expand_X = filter_expand_X_MMX;
+        st->filter_expand_Y = filter_expand_Y_MMX;
+        st->filter_blur_X = filter_blur_X_ONLYC;
+        st->filter_blur_Y = filter_blur_Y_ONLYC;
+        st->filter_convolve = filter_convolve_ONLYC;
+    }
+    else if (strcmp (type, "SSE") == 0)
+    {
+        if (!SDL_HasSSE ())
+        {
+            return RAISE (PyExc_ValueError,
+                          "SSE not supported on this machine");
+        }
+        st->filter_type = "SSE";
+        st->filter_shrink_X = filter_shrink_X_SSE;
+        st->filter_shrink_Y = filter_shrink_Y_SSE;
+        st->filter_expand_X = filter_expand_X_SSE;
+        st->filter_expand_Y = filter_expand_Y_SSE;
+        st->filter_blur_X = filter_blur_X_ONLYC;
+        st->filter_blur_Y = filter_blur_Y_ONLYC;
+        st->filter_convolve = filter_convolve_ONLYC;
+    }
+#endif /* defined(SCALE_MMX_SUPPORT) */
+#if defined(SCALE_AVX2_SUPPORT)
+    else if (strcmp (type, "AVX2") == 0)
+    {
+        if (!(PgCpu_GetFeatures () & PG_CPU_AVX2))
+        {
+            return RAISE (PyExc_ValueError,
+                          "AVX2 not supported on this machine");
+        }
+        st->filter_type = "AVX2";
+        st->filter_shrink_X = filter_shrink_X_AVX2;
+        st->filter_shrink_Y = filter_shrink_Y_AVX2;
+        st->filter_expand_X = filter_expand_X_AVX2;
+        st->filter_expand_Y = filter_expand_Y_AVX2;
+        st->filter_blur_X = filter_blur_X_AVX2;
+        st->filter_blur_Y = filter_blur_Y_AVX2;
+        st->filter_convolve = filter_convolve_AVX2;
+    }
+#endif /* defined(SCALE_AVX2_SUPPORT) */
+#if defined(SCALE_NEON_SUPPORT)
+    else if (strcmp (type, "NEON") == 0)
+    {
+        st->filter_type = "NEON";
+        st->filter_shrink_X = filter_shrink_X_NEON;
+        st->filter_shrink_Y = filter_shrink_Y_NEON;
+        st->filter_expand_X = filter_expand_X_NEON;
+        st->filter_expand_Y = filter_expand_Y_NEON;
+        st->filter_blur_X = filter_blur_X_NEON;
+        st->filter_blur_Y = filter_blur_Y_NEON;
+        st->filter_convolve = filter_convolve_NEON;
+    }
+#endif /* defined(SCALE_NEON_SUPPORT) */
+    else if (strcmp (type, "MMX") == 0 || strcmp (type, "SSE") == 0 ||
+             strcmp (type, "AVX2") == 0 || strcmp (type, "NEON") == 0)
+    {
+        return PyErr_Format (PyExc_ValueError,
+                             "%s not supported on this machine", type);
+    }
+    else
+    {
+        return PyErr_Format (PyExc_ValueError,
+                             "Unknown backend type %s", type);
+    }
+    /* The colour space conversions follow: GENERIC turns their SIMD off,
+       and the other backends give them the widest the CPU has */
+    pg_colorspace_set_backend (strcmp (type, "GENERIC") ? NULL : "GENERIC");
+    Py_RETURN_NONE;
+}
+
+/* Blurs. Both are separable: an X filter along the rows into a 32-bit
+ * scratch buffer, then a Y filter down its columns, with the filters and
+ * threads of smoothscale.
+ */
+
+#define PG_BLUR_MAX_RADIUS 255
+
+/* 2 * radius + 1 equal weights. What the rounding leaves over goes to the
+ * centre weight, so they sum to exactly 0x10000.
+ */
+static void
+box_weights (int *weights, int radius)
+{
+    int size = 2 * radius + 1;
+    int i;
+
+    for (i = 0; i < size; ++i)
+        weights[i] = 0x10000 / size;
+    weights[radius] += 0x10000 - (0x10000 / size) * size;
+}
+
+/* Gaussian weights with a standard deviation of half the radius */
+static void
+gaussian_weights (int *weights, int radius)
+{
+    double kernel[2 * PG_BLUR_MAX_RADIUS + 1];
+    double sigma = radius / 2.0;
+    double total = 0;
+    int size = 2 * radius + 1;
+    int i, sum = 0;
+
+    if (radius == 0)
+    {
+        weights[0] = 0x10000;
+        return;
+    }
+    for (i = 0; i < size; ++i)
+    {
+        double d = i - radius;
+        kernel[i] = exp (-d * d / (2 * sigma * sigma));
+        total += kernel[i];
+    }
+    for (i = 0; i < size; ++i)
+    {
+        weights[i] = (int) (kernel[i] * 0x10000 / total + 0.5);
+        sum += weights[i];
+    }
+    weights[radius] += 0x10000 - sum;
+}
+
+/* Bytes of scratch memory blur needs for src */
+static size_t
+blur_scratch_size (SDL_Surface *src)
+{
+    size_t size = (size_t) src->w * 4 * src->h;
+
+    return src->format->BytesPerPixel == 3 ? size * 2 : size;
+}
+
+/* Blur src into dst. scratch has blur_scratch_size bytes. */
+static void
+blur (SDL_Surface *src, SDL_Surface *dst, struct _module_state *st,
+      Uint8 *scratch, const int *weights, int radius)
+{
+    Uint8 *srcpix = (Uint8 *) src->pixels;
+    Uint8 *dstpix = (Uint8 *) dst->pixels;
+    int srcpitch = src->pitch;
+    int dstpitch = dst->pitch;
+    int width = src->w;
+    int height = src->h;
+    int temppitch = width * 4;
+    Uint8 *temppix = scratch;
+    Uint8 *pix32 = scratch + (size_t) temppitch * height;
+
+    /* a 24-bit surface is blurred as 32-bit from pix32 back into pix32 */
+    if (src->format->BytesPerPixel == 3)
+    {
+        smooth_pass (filter_convert_24_32, 1, srcpix, pix32, height,
+                     srcpitch, temppitch, width, 0, width * height);
+        srcpix = dstpix = pix32;
+        srcpitch = dstpitch = temppitch;
+    }
+
+    blur_pass (st->filter_blur_X, 1, srcpix, temppix, height, srcpitch,
+               temppitch, width, weights, radius, width * height);
+    blur_pass (st->filter_blur_Y, 0, temppix, dstpix, width, temppitch,
+               dstpitch, height, weights, radius, width * height);
+
+    if (src->format->BytesPerPixel == 3)
+    {
+        smooth_pass (filter_convert_32_24, 1, pix32, (Uint8 *) dst->pixels,
+                     height, temppitch, dst->pitch, width, 0,
+                     width * height);
+    }
+}
+
+static PyObject*
+surf_blur (PyObject *self, PyObject *surfobj, PyObject *surfobj2,
+           int radius, int gaussian)
+{
+    SDL_Surface *surf, *newsurf;
+    int weights[2 * PG_BLUR_MAX_RADIUS + 1];
+    int bpp;
+
+    if (radius < 0 || radius > PG_BLUR_MAX_RADIUS)
+        return RAISE (PyExc_ValueError,
+                      "blur radius must be between 0 and 255");
+
+    surf = PySurface_AsSurface (surfobj);
+    bpp = surf->format->BytesPerPixel;
+    if (bpp < 3 || bpp > 4)
+        return RAISE (PyExc_ValueError,
+                      "Only 24-bit or 32-bit surfaces can be blurred");
+
+    newsurf = transform_dest (surf, surfobj2, surf->w, surf->h);
+    if (!newsurf)
+        return NULL;
+
+    if (gaussian)
+        gaussian_weights (weights, radius);
+    else
+        box_weights (weights, radius);
+
+    if (surf->w && surf->h)
+    {
+        size_t scratch_size = blur_scratch_size (surf);
+        Uint8 *scratch = smooth_take_scratch (scratch_size);
+
+        if (!scratch)
+        {
+            if (!surfobj2)
+                PySurface_FreeSurface (newsurf);
+            return PyErr_NoMemory ();
+        }
+
+        SDL_LockSurface (newsurf);
+        PySurface_Lock (surfobj);
+        Py_BEGIN_ALLOW_THREADS;
+        blur (surf, newsurf, GETSTATE (self), scratch, weights, radius);
+        Py_END_ALLOW_THREADS;
+        PySurface_Unlock (surfobj);
+        SDL_UnlockSurface (newsurf);
+        smooth_give_scratch (scratch, scratch_size);
+    }
+
+    return transform_result (surfobj, surfobj2, newsurf);
+}
+
+static PyObject*
+surf_box_blur (PyObject *self, PyObject *arg)
+{
+    PyObject *surfobj, *surfobj2 = NULL;
+    int radius;
+
+    if (!PyArg_ParseTuple (arg, "O&i|O!", PySurface_Source, &surfobj,
+                           &radius, &PySurface_Type, &surfobj2))
+        return NULL;
+    return surf_blur (self, surfobj, surfobj2, radius, 0);
+}
+
+static PyObject*
+surf_gaussian_blur (PyObject *self, PyObject *arg)
+{
+    PyObject *surfobj, *surfobj2 = NULL;
+    int radius;
+
+    if (!PyArg_ParseTuple (arg, "O&i|O!", PySurface_Source, &surfobj,
+                           &radius, &PySurface_Type, &surfobj2))
+        return NULL;
+    return surf_blur (self, surfobj, surfobj2, radius, 1);
+}
+
+
+/* True if the RGB channels of a 32-bit format are each a whole byte */
+#define PG_RGB_BYTES_32(format)                                     \
+    ((format)->BytesPerPixel == 4 &&                                \
+     (format)->Rmask == (Uint32) 0xFF << (format)->Rshift &&        \
+     (format)->Gmask == (Uint32) 0xFF << (format)->Gshift &&        \
+     (format)->Bmask == (Uint32) 0xFF << (format)->Bshift)
+
+/* The arguments of get_threshold, for the row bands */
+typedef struct
+{
+    SDL_Surface *destsurf;
+    SDL_Surface *surf;
+    SDL_Surface *surf2;
+    Uint32 color;
+    Uint32 threshold;
+    Uint32 diff_color;
+    int change_return;
+    int inverse;
+} ThresholdJob;
+
+#if defined(PG_TRANSFORM_SSE2)
+/* Pixels in the threshold, the low bits of a _mm_movemask_ps */
+static const int threshold_bits[16] = {0, 1, 1, 2, 1, 2, 2, 3,
+                                       1, 2, 2, 3, 2, 3, 3, 4};
+#endif
+
+/* threshold for rows first to first + n - 1 of 32-bit surfaces with 8 bit
+ * RGB channels, PG_RGB_BYTES_32. inverse must be 0 or 1. This is the test
+ * of threshold_rows, four pixels at a time with SSE2 when surf2, if given,
+ * has the same RGB layout as surf.
+ */
+static int
+threshold_rows_32 (ThresholdJob *job, int first, int n)
+{
+    SDL_Surface *surf = job->surf, *surf2 = job->surf2;
+    SDL_PixelFormat *format = surf->format;
+    SDL_PixelFormat *format2 = surf2 ? surf2->format : format;
+    int rshift = format->Rshift, gshift = format->Gshift;
+    int bshift = format->Bshift;
+    int rshift2 = format2->Rshift, gshift2 = format2->Gshift;
+    int bshift2 = format2->Bshift;
+    int change_return = job->change_return, inverse = job->inverse;
+    Uint32 color = job->color;
+    Uint8 r, g, b, a, tr, tg, tb, ta;
+    int x, y, similar = 0;
+#if defined(PG_TRANSFORM_SSE2)
+    int vector = (!surf2 || (format2->Rmask == format->Rmask &&
+                             format2->Gmask == format->Gmask &&
+                             format2->Bmask == format->Bmask));
+    __m128i refv, tv, colorv, invv, zero = _mm_setzero_si128 ();
+#endif
+
+    SDL_GetRGBA (color, format, &r, &g, &b, &a);
+    SDL_GetRGBA (job->threshold, format, &tr, &tg, &tb, &ta);
+#if defined(PG_TRANSFORM_SSE2)
+    /* the bytes that are not RGB always pass */
+    refv = _mm_set1_epi32 ((int) (((Uint32) r << rshift) |
+                                  ((Uint32) g << gshift) |
+                                  ((Uint32) b << bshift)));
+    tv = _mm_set1_epi32 ((int) (~(format->Rmask | format->Gmask |
+                                  format->Bmask) |
+                                ((Uint32) tr << rshift) |
+                                ((Uint32) tg << gshift) |
+                                ((Uint32) tb << bshift)));
+    colorv = _mm_set1_epi32 ((int) color);
+    invv = _mm_set1_epi32 (inverse ? -1 : 0);
+#endif
+
+    for (y = first; y < first + n; y++)
+    {
+        Uint32 *pixels = (Uint32 *) ((Uint8 *) surf->pixels + y * surf->pitch);
+        Uint32 *pixels2 = surf2 ?
+            (Uint32 *) ((Uint8 *) surf2->pixels + y * surf2->pitch) : NULL;
+        Uint32 *destpixels = change_return ?
+            (Uint32 *) ((Uint8 *) job->destsurf->pixels +
+                        y * job->destsurf->pitch) : NULL;
+
+        x = 0;
+#if defined(PG_TRANSFORM_SSE2)
+        for (; vector && x + 4 <= surf->w; x += 4)
+        {
+            __m128i pix = _mm_loadu_si128 ((__m128i *) (pixels + x));
+            __m128i ref = pixels2 ?
+                _mm_loadu_si128 ((__m128i *) (pixels2 + x)) : refv;
+            __m128i diff = _mm_or_si128 (_mm_subs_epu8 (pix, ref),
+                                         _mm_subs_epu8 (ref, pix));
+            __m128i in = _mm_xor_si128 (
+                _mm_cmpeq_epi32 (_mm_subs_epu8 (diff, tv), zero), invv);
+
+            similar += threshold_bits[_mm_movemask_ps (_mm_castsi128_ps (in))];
+            if (change_return == 1 || change_return == 2)
+            {
+                __m128i *dst = (__m128i *) (destpixels + x);
+                __m128i set = change_return == 1 ? colorv : pix;
+
+                _mm_storeu_si128 (dst, _mm_or_si128 (
+                    _mm_and_si128 (in, set),
+                    _mm_andnot_si128 (in, _mm_loadu_si128 (dst))));
+            }
+        }
+#endif
+        for (; x < surf->w; x++)
+        {
+            Uint32 the_color = pixels[x];
+            int cr = (the_color >> rshift) & 0xFF;
+            int cg = (the_color >> gshift) & 0xFF;
+            int cb = (the_color >> bshift) & 0xFF;
+            int rr = r, rg = g, rb = b;
+
+            if (pixels2)
+            {
+                Uint32 the_color2 = pixels2[x];
+                rr = (the_color2 >> rshift2) & 0xFF;
+                rg = (the_color2 >> gshift2) & 0xFF;
+                rb = (the_color2 >> bshift2) & 0xFF;
+            }
+            if (((abs (rr - cr) <= tr) & (abs (rg - cg) <= tg) &
+                 (abs (rb - cb) <= tb)) ^ inverse)
+            {
+                if (change_return == 2)
+                    destpixels[x] = the_color;
+                else if (change_return == 1)
+                    destpixels[x] = color;
+                similar++;
+            }
+        }
+    }
+    return similar;
+}
+
+/* threshold for rows first to first + n - 1. destsurf, if changed, is
+ * already filled with diff_color.
+ */
+static int
+threshold_rows (void *data, int first, int n)
 {
-    int x, y, result, similar, rshift, gshift, bshift, rshift2, gshift2, bshift2;
+    ThresholdJob *job = (ThresholdJob *) data;
+    SDL_Surface *destsurf = job->destsurf;
+    SDL_Surface *surf = job->surf;
+    SDL_Surface *surf2 = job->surf2;
+    Uint32 color = job->color;
+    Uint32 threshold = job->threshold;
+    Uint32 diff_color = job->diff_color;
+    int change_return = job->change_return;
+    int inverse = job->inverse;
+    int x, y, similar, rshift, gshift, bshift, rshift2, gshift2, bshift2;
     int rloss, gloss, bloss, rloss2, gloss2, bloss2;
     Uint8 *pixels, *destpixels, *pixels2;
-    SDL_Rect sdlrect;
     SDL_PixelFormat *format, *destformat, *format2;
     Uint32 the_color, the_color2, rmask, gmask, bmask, rmask2, gmask2, bmask2;
     Uint8 *pix, *byte_buf;
@@ -1528,6 +2989,11 @@ static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
     Uint8 dr, dg, db, da;
     Uint8 tr, tg, tb, ta;
 
+    if (PG_RGB_BYTES_32 (surf->format) && (inverse == 0 || inverse == 1) &&
+        (!surf2 || PG_RGB_BYTES_32 (surf2->format)) &&
+        (!change_return || destsurf->format->BytesPerPixel == 4))
+        return threshold_rows_32 (job, first, n);
+
     similar = 0;
     pixels = (Uint8 *) surf->pixels;
     format = surf->format;
@@ -1542,12 +3008,8 @@ static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
     bloss = format->Bloss;
 
     if(change_return) {
-        sdlrect.x = sdlrect.y = 0;
-        sdlrect.w = destsurf->w;
-        sdlrect.h = destsurf->h;
         destpixels = (Uint8 *) destsurf->pixels;
         destformat = destsurf->format;
-        result = SDL_FillRect (destsurf, &sdlrect, diff_color);
     } else { /* make gcc stop complaining */
         destpixels = NULL;
         destformat = NULL;
@@ -1577,7 +3039,7 @@ static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
     SDL_GetRGBA (threshold, format, &tr, &tg, &tb, &ta);
     SDL_GetRGBA (diff_color, format, &dr, &dg, &db, &da);
 
-    for(y=0; y < surf->h; y++) {
+    for(y=first; y < first + n; y++) {
         pixels = (Uint8 *) surf->pixels + y*surf->pitch;
         if (surf2) {
             pixels2 = (Uint8 *) surf2->pixels + y*surf2->pitch;
@@ -1771,6 +3233,31 @@ static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
     return similar;
 }
 
+static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
+                          SDL_Surface *surf2, Uint32 color,  Uint32 threshold,
+                          Uint32 diff_color, int change_return, int inverse)
+{
+    ThresholdJob job;
+    SDL_Rect sdlrect;
+
+    if(change_return) {
+        sdlrect.x = sdlrect.y = 0;
+        sdlrect.w = destsurf->w;
+        sdlrect.h = destsurf->h;
+        SDL_FillRect (destsurf, &sdlrect, diff_color);
+    }
+
+    job.destsurf = destsurf;
+    job.surf = surf;
+    job.surf2 = surf2;
+    job.color = color;
+    job.threshold = threshold;
+    job.diff_color = diff_color;
+    job.change_return = change_return;
+    job.inverse = inverse;
+    return smooth_jobs (threshold_rows, &job, surf->h, surf->w * surf->h);
+}
+
 
 
 
@@ -1995,289 +3482,490 @@ number to use for missing samples
 
 
 
-void laplacian(SDL_Surface *surf, SDL_Surface *destsurf) {
-
-    int ii;
-    int x,y,height,width;
-
-    Uint32 sample[9];
-    //Uint32 total[4];
-    int total[4];
-
-    Uint8 c1r, c1g, c1b, c1a;
-    //Uint32 c1r, c1g, c1b, c1a;
-    Uint8 acolor[4];
-
-    Uint32 the_color;
-
-    int atmp0;
-    int atmp1;
-    int atmp2;
-    int atmp3;
-
-    SDL_PixelFormat *format, *destformat;
-    Uint8 *pixels, *destpixels;
-    Uint8 *pix;
-
-    Uint8 *byte_buf;
-
-
-    height = surf->h;
-    width = surf->w;
-
-
-    pixels = (Uint8 *) surf->pixels;
-    format = surf->format;
-
-    destpixels = (Uint8 *) destsurf->pixels;
-    destformat = destsurf->format;
-
-/*
-    -1 -1 -1
-    -1  8 -1
-    -1 -1 -1
-
-    col = (sample[4] * 8) - (sample[0] + sample[1] + sample[2] +
-                             sample[3] +             sample[5] +
-                             sample[6] + sample[7] + sample[8])
-
-    [(-1,-1), (0,-1), (1,-1),     (-1,0), (0,0), (1,0),     (-1,1), (0,1), (1,1)]
-
-*/
-
-    for(y=0;y<height;y++) {
-        for(x=0;x<width;x++) {
-
-            // Need to bounds check these accesses.
-
-            if(y > 0) {
-                if(x>0) {
-                    SURF_GET_AT(sample[0], surf, x+ -1, y+ -1, pixels, format, pix);
-                }
-
-                SURF_GET_AT(sample[1], surf, x+  0, y+ -1, pixels, format, pix);
-
-                if(x+1<width) {
-                    SURF_GET_AT(sample[2], surf, x+  1, y+ -1, pixels, format, pix);
-                }
-            } else {
-                sample[0] = LAPLACIAN_NUM;
-                sample[1] = LAPLACIAN_NUM;
-                sample[2] = LAPLACIAN_NUM;
-            }
-
-            if(x>0) {
-                SURF_GET_AT(sample[3], surf, x+ -1, y+  0, pixels, format, pix);
-            } else {
-                sample[3] = LAPLACIAN_NUM;
-            }
-
-
-            //SURF_GET_AT(sample[4], surf, x+0 , y+0);
-            sample[4] = 0;
-
-            if(x+1<width) {
-                SURF_GET_AT(sample[5], surf, x+  1, y+  0, pixels, format, pix);
-            } else {
-                sample[5] = LAPLACIAN_NUM;
-            }
-
-            if(y+1 < height) {
-
-                if(x>0) {
-                    SURF_GET_AT(sample[6], surf, x+ -1, y+  1, pixels, format, pix);
-                }
+/* Convolutions. 24 and 32-bit surfaces with byte channels are copied into
+ * a 32-bit scratch buffer with radius pixels of border on every side, and
+ * the convolve filter of the smoothscale backend works on that in bands of
+ * rows. Other surfaces are done a pixel at a time by convolve_rows.
+ */
 
-                SURF_GET_AT(sample[7], surf, x+  0, y+  1, pixels, format, pix);
+/* Most the absolute values of the weights may add up to, in 16.16 */
+#define PG_CONVOLVE_MAX_TOTAL (128 * 0x10000)
 
-                if(x+1<width) {
-                    SURF_GET_AT(sample[8], surf, x+  1, y+  1, pixels, format, pix);
-                }
-            } else {
-                sample[6] = LAPLACIAN_NUM;
-                sample[7] = LAPLACIAN_NUM;
-                sample[8] = LAPLACIAN_NUM;
-            }
+/* The arguments of convolve, for the row bands */
+typedef struct
+{
+    SDL_Surface *surf;
+    SDL_Surface *destsurf;
+    const int *weights;
+    int radius;
+    int repeat;         /* repeat the edge pixels, or use LAPLACIAN_NUM */
+    Uint8 *padded;      /* the fast path copy of surf, with the border */
+    int padpitch;
+} ConvolveJob;
+
+/* True if convolve takes the fast path for format */
+#define PG_CONVOLVE_FAST(format)                                        \
+    (((format)->BytesPerPixel == 3 || (format)->BytesPerPixel == 4) &&  \
+     (format)->Rmask == (Uint32) 0xFF << (format)->Rshift &&            \
+     (format)->Gmask == (Uint32) 0xFF << (format)->Gshift &&            \
+     (format)->Bmask == (Uint32) 0xFF << (format)->Bshift &&            \
+     ((format)->Amask == 0 ||                                           \
+      (format)->Amask == (Uint32) 0xFF << (format)->Ashift))
+
+/* Copy rows first to first + n - 1 of the padded buffer: the source rows
+ * as 32-bit pixels, with the bytes that are not channels cleared, and the
+ * border.
+ */
+static int
+convolve_pad_rows (void *data, int first, int n)
+{
+    ConvolveJob *job = (ConvolveJob *) data;
+    SDL_Surface *surf = job->surf;
+    SDL_PixelFormat *format = surf->format;
+    int radius = job->radius;
+    int width = surf->w;
+    int padwidth = width + 2 * radius;
+    Uint32 keep = 0xFFFFFFFF, border;
+    int x, y;
 
+    if (format->BytesPerPixel == 4)
+        keep = format->Rmask | format->Gmask | format->Bmask | format->Amask;
+    border = LAPLACIAN_NUM & keep;
 
-            total[0] = 0; total[1] = 0; total[2] = 0; total[3] = 0;
+    for (y = first; y < first + n; y++)
+    {
+        Uint32 *row = (Uint32 *) (job->padded + y * job->padpitch);
+        int sy = y - radius;
 
-            for(ii =0; ii<9; ii++) {
-                SDL_GetRGBA (sample[ii], format, &c1r, &c1g, &c1b, &c1a);
-                total[0] += c1r; total[1] += c1g; total[2] += c1b; total[3] += c1a;
+        if (sy < 0 || sy >= surf->h)
+        {
+            if (!job->repeat)
+            {
+                for (x = 0; x < padwidth; x++)
+                    row[x] = border;
+                continue;
             }
+            sy = sy < 0 ? 0 : surf->h - 1;
+        }
 
+        if (format->BytesPerPixel == 3)
+        {
+            convert_24_32 ((Uint8 *) surf->pixels + sy * surf->pitch,
+                           surf->pitch, (Uint8 *) (row + radius),
+                           job->padpitch, width, 1);
+        }
+        else
+        {
+            Uint32 *src = (Uint32 *) ((Uint8 *) surf->pixels +
+                                      sy * surf->pitch);
+            for (x = 0; x < width; x++)
+                row[radius + x] = src[x] & keep;
+        }
+        for (x = 0; x < radius; x++)
+        {
+            row[x] = job->repeat ? row[radius] : border;
+            row[radius + width + x] = job->repeat ?
+                row[radius + width - 1] : border;
+        }
+    }
+    return 0;
+}
 
-            SURF_GET_AT(sample[4], surf, x, y, pixels, format, pix);
-
-            SDL_GetRGBA (sample[4], format, &c1r, &c1g, &c1b, &c1a);
+/* Convolve rows first to first + n - 1 a pixel at a time, for any format */
+static int
+convolve_rows (void *data, int first, int n)
+{
+    ConvolveJob *job = (ConvolveJob *) data;
+    SDL_Surface *surf = job->surf;
+    SDL_Surface *destsurf = job->destsurf;
+    SDL_PixelFormat *format = surf->format;
+    SDL_PixelFormat *destformat = destsurf->format;
+    Uint8 *pixels = (Uint8 *) surf->pixels;
+    Uint8 *destpixels = (Uint8 *) destsurf->pixels;
+    int radius = job->radius;
+    int x, y, kx, ky, i;
+    Uint32 the_color;
+    Uint8 c[4], acolor[4];
+    Uint8 *pix, *byte_buf;
 
-            // cast on the right to a signed int, and then clamp to 0-255.
+    for (y = first; y < first + n; y++)
+    {
+        for (x = 0; x < surf->w; x++)
+        {
+            const int *w = job->weights;
+            int total[4] = {0x8000, 0x8000, 0x8000, 0x8000};
 
-            //atmp = c1r * 8
+            for (ky = -radius; ky <= radius; ky++)
+            {
+                for (kx = -radius; kx <= radius; kx++, w++)
+                {
+                    int sx = x + kx, sy = y + ky;
 
+                    if (sx < 0 || sx >= surf->w || sy < 0 || sy >= surf->h)
+                    {
+                        if (!job->repeat)
+                        {
+                            the_color = LAPLACIAN_NUM;
+                            goto have_color;
+                        }
+                        sx = MIN (MAX (sx, 0), surf->w - 1);
+                        sy = MIN (MAX (sy, 0), surf->h - 1);
+                    }
+                    SURF_GET_AT (the_color, surf, sx, sy, pixels, format, pix);
+                have_color:
+                    SDL_GetRGBA (the_color, format, &c[0], &c[1], &c[2], &c[3]);
+                    for (i = 0; i < 4; i++)
+                        total[i] += c[i] * *w;
+                }
+            }
+            for (i = 0; i < 4; i++)
+                acolor[i] = (Uint8) (total[i] < 0 ? 0 :
+                                     MIN (total[i] >> 16, 255));
+
+            the_color = SDL_MapRGBA (surf->format, acolor[0], acolor[1],
+                                     acolor[2], acolor[3]);
+            SURF_SET_AT (the_color, destsurf, x, y, destpixels, destformat,
+                         byte_buf);
+        }
+    }
+    return 0;
+}
 
-            atmp0 = c1r * 8;
-            acolor[0] = MIN(MAX(atmp0 - total[0], 0), 255);
-            atmp1 = c1g * 8;
-            acolor[1] = MIN(MAX(atmp1 - total[1], 0), 255);
-            atmp2 = c1b * 8;
-            acolor[2] = MIN(MAX(atmp2 - total[2], 0), 255);
-            atmp3 = c1a * 8;
-            acolor[3] = MIN(MAX(atmp3 - total[3], 0), 255);
+/* Bytes of scratch memory convolve needs for src */
+static size_t
+convolve_scratch_size (SDL_Surface *src, int radius)
+{
+    size_t size;
+
+    if (!PG_CONVOLVE_FAST (src->format))
+        return 0;
+    size = (size_t) (src->w + 2 * radius) * 4 * (src->h + 2 * radius);
+    if (src->format->BytesPerPixel == 3)
+        size += (size_t) src->w * 4 * src->h;
+    return size;
+}
 
-            //printf("%d;;%d;;%d;;  ", atmp0, acolor[0],total[0]);
+/* Convolve src into dst. scratch has convolve_scratch_size bytes. */
+static void
+convolve (SDL_Surface *src, SDL_Surface *dst, struct _module_state *st,
+          Uint8 *scratch, const int *weights, int radius, int repeat)
+{
+    ConvolveJob job;
+    int width = src->w;
+    int height = src->h;
+
+    job.surf = src;
+    job.destsurf = dst;
+    job.weights = weights;
+    job.radius = radius;
+    job.repeat = repeat;
+    job.padded = scratch;
+    job.padpitch = (width + 2 * radius) * 4;
+
+    if (!PG_CONVOLVE_FAST (src->format))
+    {
+        smooth_jobs (convolve_rows, &job, height,
+                     width * height * (2 * radius + 1));
+        return;
+    }
 
+    smooth_jobs (convolve_pad_rows, &job, height + 2 * radius,
+                 width * height);
+    if (src->format->BytesPerPixel == 3)
+    {
+        /* a 24-bit surface is convolved into 32-bit, then converted */
+        Uint8 *dst32 = scratch + (size_t) job.padpitch * (height + 2 * radius);
+
+        blur_pass (st->filter_convolve, 1, scratch, dst32, height,
+                   job.padpitch, width * 4, width, weights, radius,
+                   width * height);
+        smooth_pass (filter_convert_32_24, 1, dst32, (Uint8 *) dst->pixels,
+                     height, width * 4, dst->pitch, width, 0,
+                     width * height);
+    }
+    else
+    {
+        blur_pass (st->filter_convolve, 1, scratch, (Uint8 *) dst->pixels,
+                   height, job.padpitch, dst->pitch, width, weights, radius,
+                   width * height);
+    }
+}
 
-            //printf("%d,%d,%d,%d;;  \n", acolor[0], acolor[1], acolor[2], acolor[3]);
+static PyObject*
+surf_convolve_surface (PyObject *self, PyObject *surfobj, PyObject *surfobj2,
+                       const int *weights, int radius, int repeat)
+{
+    SDL_Surface *surf, *newsurf;
 
-            //the_color = (Uint32)acolor;
-            //the_color = 0x00000000;
+    surf = PySurface_AsSurface (surfobj);
 
+    newsurf = transform_dest (surf, surfobj2, surf->w, surf->h);
+    if (!newsurf)
+        return NULL;
 
+    if (surf->w && surf->h)
+    {
+        size_t scratch_size = convolve_scratch_size (surf, radius);
+        Uint8 *scratch = smooth_take_scratch (scratch_size);
 
-            // cast on the right to Uint32, and then clamp to 255.
+        if (!scratch)
+        {
+            if (!surfobj2)
+                PySurface_FreeSurface (newsurf);
+            return PyErr_NoMemory ();
+        }
 
-            the_color = SDL_MapRGBA (surf->format, acolor[0], acolor[1], acolor[2], acolor[3]);
+        SDL_LockSurface (newsurf);
+        PySurface_Lock (surfobj);
+        Py_BEGIN_ALLOW_THREADS;
+        convolve (surf, newsurf, GETSTATE (self), scratch, weights, radius,
+                  repeat);
+        Py_END_ALLOW_THREADS;
+        PySurface_Unlock (surfobj);
+        SDL_UnlockSurface (newsurf);
+        smooth_give_scratch (scratch, scratch_size);
+    }
 
+    return transform_result (surfobj, surfobj2, newsurf);
+}
 
+/* Read a 3x3 or 5x5 kernel, given as rows or flat, into 16.16 weights.
+ * Returns the radius, or -1 with an exception set.
+ */
+static int
+convolve_kernel (PyObject *kernel, int *weights)
+{
+    double values[25];
+    double total = 0;
+    Py_ssize_t len, size, i, j;
+    PyObject *row, *item;
+    int flat;
 
+    if (!PySequence_Check (kernel))
+    {
+        PyErr_SetString (PyExc_TypeError, "kernel must be a sequence");
+        return -1;
+    }
+    len = PySequence_Length (kernel);
+    flat = (len == 9 || len == 25);
+    if (flat)
+        size = len == 9 ? 3 : 5;
+    else if (len == 3 || len == 5)
+        size = len;
+    else
+    {
+        PyErr_SetString (PyExc_ValueError, "kernel must be 3x3 or 5x5");
+        return -1;
+    }
 
-            // set_at(destsurf, color, x,y);
+    for (i = 0; i < size; ++i)
+    {
+        row = flat ? kernel : PySequence_GetItem (kernel, i);
+        if (!row)
+            return -1;
+        if (!flat && (!PySequence_Check (row) ||
+                      PySequence_Length (row) != size))
+        {
+            Py_DECREF (row);
+            PyErr_SetString (PyExc_ValueError, "kernel must be 3x3 or 5x5");
+            return -1;
+        }
+        for (j = 0; j < size; ++j)
+        {
+            double *value = &values[i * size + j];
 
-            switch (destformat->BytesPerPixel)
-            {
-            case 1:
-                *((Uint8 *) destpixels + y * destsurf->pitch + x) = (Uint8) the_color;
-                break;
-            case 2:
-                *((Uint16 *) (destpixels + y * destsurf->pitch) + x) = (Uint16) the_color;
-                break;
-            case 3:
-                byte_buf = (Uint8 *) (destpixels + y * destsurf->pitch) + x * 3;
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-                *(byte_buf + (destformat->Rshift >> 3)) = (Uint8) (the_color >> 16);
-                *(byte_buf + (destformat->Gshift >> 3)) = (Uint8) (the_color >> 8);
-                *(byte_buf + (destformat->Bshift >> 3)) = (Uint8) the_color;
-#else
-                *(byte_buf + 2 - (destformat->Rshift >> 3)) = (Uint8) (the_color >> 16);
-                *(byte_buf + 2 - (destformat->Gshift >> 3)) = (Uint8) (the_color >> 8);
-                *(byte_buf + 2 - (destformat->Bshift >> 3)) = (Uint8) the_color;
-#endif
+            item = PySequence_GetItem (row, flat ? i * size + j : j);
+            if (!item)
                 break;
-            default:
-                *((Uint32 *) (destpixels + y * destsurf->pitch) + x) = the_color;
+            *value = PyFloat_AsDouble (item);
+            Py_DECREF (item);
+            if (*value == -1.0 && PyErr_Occurred ())
                 break;
-            }
-
-
-
+            total += fabs (*value);
         }
+        if (!flat)
+            Py_DECREF (row);
+        if (j < size)
+            return -1;
     }
 
-
-
+    if (!(total * 0x10000 <= PG_CONVOLVE_MAX_TOTAL))
+    {
+        PyErr_SetString (PyExc_ValueError,
+               "the kernel weights must add up to at most 128, ignoring signs");
+        return -1;
+    }
+    for (i = 0; i < size * size; ++i)
+        weights[i] = (int) floor (values[i] * 0x10000 + 0.5);
+    return (int) size / 2;
 }
 
+static PyObject*
+surf_convolve (PyObject* self, PyObject* arg)
+{
+    PyObject *surfobj, *surfobj2 = NULL, *kernel;
+    int weights[25];
+    int radius;
 
+    if (!PyArg_ParseTuple (arg, "O&O|O!", PySurface_Source, &surfobj,
+                           &kernel, &PySurface_Type, &surfobj2))
+        return NULL;
 
+    radius = convolve_kernel (kernel, weights);
+    if (radius < 0)
+        return NULL;
+    return surf_convolve_surface (self, surfobj, surfobj2, weights, radius, 1);
+}
 
+/*
+    -1 -1 -1
+    -1  8 -1
+    -1 -1 -1
 
-
-
-
-
-
+    Missing samples, past the edges, are LAPLACIAN_NUM.
+*/
+static const int laplacian_weights[9] = {
+    -0x10000, -0x10000, -0x10000,
+    -0x10000, 0x80000, -0x10000,
+    -0x10000, -0x10000, -0x10000
+};
 
 static PyObject*
 surf_laplacian (PyObject* self, PyObject* arg)
 {
     PyObject *surfobj, *surfobj2;
-    SDL_Surface *surf;
-    SDL_Surface *newsurf;
-    int width, height;
     surfobj2 = NULL;
 
     /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!|O!", &PySurface_Type, &surfobj,
+    if (!PyArg_ParseTuple (arg, "O&|O!", PySurface_Source, &surfobj,
                            &PySurface_Type, &surfobj2))
         return NULL;
 
-    surf = PySurface_AsSurface (surfobj);
-
-    /* if the second surface is not there, then make a new one. */
+    return surf_convolve_surface (self, surfobj, surfobj2, laplacian_weights,
+                                  1, 0);
+}
 
-    if (!surfobj2)
-    {
-        width = surf->w;
-        height = surf->h;
 
-        newsurf = newsurf_fromsurf (surf, width, height);
 
-        if (!newsurf)
-            return NULL;
-    }
-    else
-        newsurf = PySurface_AsSurface (surfobj2);
 
-    /* check to see if the size is the correct size. */
-    if (newsurf->w != (surf->w) || newsurf->h != (surf->h))
-        return RAISE (PyExc_ValueError, "Destination surface not the same size.");
+/* The arguments of average_surfaces, for the row bands */
+typedef struct
+{
+    SDL_Surface **surfaces;
+    int num_surfaces;
+    SDL_Surface *destsurf;
+    int palette_colors;
+    int num_elements;
+    Uint32 *accumulate;
+    float div_inv;
+} AverageJob;
 
-    /* check to see if the format of the surface is the same. */
-    if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
-        return RAISE (PyExc_ValueError,
-                      "Source and destination surfaces need the same format.");
+/* average_surfaces for rows first to first + n - 1 of 32-bit surfaces with
+ * 8 bit RGB channels, PG_RGB_BYTES_32, into a 32-bit destsurf. Each pixel
+ * has four accumulators, one per byte. The surfaces with the layout of the
+ * first one are added all four bytes at a time, four pixels at a time with
+ * SSE2.
+ */
+static int
+average_rows_32 (AverageJob *job, int first, int n)
+{
+    SDL_Surface *surf0 = job->surfaces[0];
+    SDL_PixelFormat *format0 = surf0->format;
+    SDL_Surface *destsurf = job->destsurf;
+    int width = surf0->w;
+    float div_inv = job->div_inv;
+    int x, y, surf_idx;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    int ridx = format0->Rshift >> 3;
+    int gidx = format0->Gshift >> 3;
+    int bidx = format0->Bshift >> 3;
+#else
+    int ridx = 3 - (format0->Rshift >> 3);
+    int gidx = 3 - (format0->Gshift >> 3);
+    int bidx = 3 - (format0->Bshift >> 3);
+#endif
+#if defined(PG_TRANSFORM_SSE2)
+    __m128i zero = _mm_setzero_si128 ();
+#endif
 
-    SDL_LockSurface (newsurf);
-    SDL_LockSurface (surf);
+    for (y = first; y < first + n; y++)
+    {
+        Uint32 *the_idx = job->accumulate + (size_t) y * width * 4;
+        Uint32 *destpixels = (Uint32 *) ((Uint8 *) destsurf->pixels +
+                                         y * destsurf->pitch);
 
-    Py_BEGIN_ALLOW_THREADS;
-    laplacian (surf, newsurf);
-    Py_END_ALLOW_THREADS;
+        for (surf_idx = 0; surf_idx < job->num_surfaces; surf_idx++)
+        {
+            SDL_Surface *surf = job->surfaces[surf_idx];
+            SDL_PixelFormat *format = surf->format;
+            Uint8 *pixels = (Uint8 *) surf->pixels + y * surf->pitch;
 
-    SDL_UnlockSurface (surf);
-    SDL_UnlockSurface (newsurf);
+            if (format->Rmask == format0->Rmask &&
+                format->Gmask == format0->Gmask &&
+                format->Bmask == format0->Bmask)
+            {
+                x = 0;
+#if defined(PG_TRANSFORM_SSE2)
+                for (; x + 16 <= width * 4; x += 16)
+                {
+                    __m128i pix = _mm_loadu_si128 ((__m128i *) (pixels + x));
+                    __m128i lo = _mm_unpacklo_epi8 (pix, zero);
+                    __m128i hi = _mm_unpackhi_epi8 (pix, zero);
+                    __m128i *acc = (__m128i *) (the_idx + x);
+
+                    _mm_storeu_si128 (acc, _mm_add_epi32 (
+                        _mm_loadu_si128 (acc), _mm_unpacklo_epi16 (lo, zero)));
+                    _mm_storeu_si128 (acc + 1, _mm_add_epi32 (
+                        _mm_loadu_si128 (acc + 1), _mm_unpackhi_epi16 (lo, zero)));
+                    _mm_storeu_si128 (acc + 2, _mm_add_epi32 (
+                        _mm_loadu_si128 (acc + 2), _mm_unpacklo_epi16 (hi, zero)));
+                    _mm_storeu_si128 (acc + 3, _mm_add_epi32 (
+                        _mm_loadu_si128 (acc + 3), _mm_unpackhi_epi16 (hi, zero)));
+                }
+#endif
+                for (; x < width * 4; x++)
+                    the_idx[x] += pixels[x];
+            }
+            else
+            {
+                Uint32 *pix32 = (Uint32 *) pixels;
+                for (x = 0; x < width; x++)
+                {
+                    Uint32 the_color = pix32[x];
+                    the_idx[x * 4 + ridx] += (the_color >> format->Rshift) & 0xFF;
+                    the_idx[x * 4 + gidx] += (the_color >> format->Gshift) & 0xFF;
+                    the_idx[x * 4 + bidx] += (the_color >> format->Bshift) & 0xFF;
+                }
+            }
+        }
 
-    if (surfobj2)
-    {
-        Py_INCREF (surfobj2);
-        return surfobj2;
+        for (x = 0; x < width; x++, the_idx += 4)
+        {
+            destpixels[x] = SDL_MapRGB (destsurf->format,
+                                        (Uint8) (the_idx[ridx] * div_inv + .5f),
+                                        (Uint8) (the_idx[gidx] * div_inv + .5f),
+                                        (Uint8) (the_idx[bidx] * div_inv + .5f));
+        }
     }
-    else
-        return PySurface_New (newsurf);
+    return 0;
 }
 
+/* average_surfaces for rows first to first + n - 1 */
+static int
+average_rows (void *data, int first, int n)
+{
+    AverageJob *job = (AverageJob *) data;
+    SDL_Surface **surfaces = job->surfaces;
+    int num_surfaces = job->num_surfaces;
+    SDL_Surface *destsurf = job->destsurf;
+    int palette_colors = job->palette_colors;
+    int num_elements = job->num_elements;
+    float div_inv = job->div_inv;
 
-
-
-int average_surfaces(SDL_Surface **surfaces,
-                     int num_surfaces,
-                     SDL_Surface *destsurf,
-                     int palette_colors) {
-    /*
-        returns the average surface from the ones given.
-
-        All surfaces need to be the same size.
-
-        palette_colors - if true we average the colors in palette, otherwise we
-            average the pixel values.  This is useful if the surface is
-            actually greyscale colors, and not palette colors.
-
-    */
-
-
-    Uint32 *accumulate;
     Uint32 *the_idx;
     Uint32 the_color;
     SDL_Surface *surf;
-    int height, width, x, y, surf_idx;
-
-    float div_inv;
-
-
-
-
+    int width, x, y, surf_idx;
 
     SDL_PixelFormat *format, *destformat;
     Uint8 *pixels, *destpixels;
@@ -2286,37 +3974,15 @@ int average_surfaces(SDL_Surface **surfaces,
 
     Uint32 rmask, gmask, bmask;
     int rshift, gshift, bshift, rloss, gloss, bloss;
-    int num_elements;
 
-    if(!num_surfaces) { return 0; }
+    if (num_elements == 4)
+        return average_rows_32 (job, first, n);
 
-    height = surfaces[0]->h;
     width = surfaces[0]->w;
 
     destpixels = (Uint8 *) destsurf->pixels;
     destformat = destsurf->format;
 
-
-    /* allocate an array to accumulate them all.
-
-    If we're using 1 byte per pixel, then only need to average on that much.
-    */
-
-    if((destformat->BytesPerPixel == 1) &&
-       (destformat->palette) &&
-       (!palette_colors)) {
-        num_elements = 1;
-    } else {
-        num_elements = 3;
-    }
-
-    accumulate = (Uint32 *) calloc(1, sizeof(Uint32) * height * width * num_elements );
-
-
-
-    if(!accumulate) { return -1; }
-
-
     /* add up the r,g,b from all the surfaces. */
 
     for(surf_idx=0;surf_idx < num_surfaces;surf_idx++) {
@@ -2334,7 +4000,7 @@ int average_surfaces(SDL_Surface **surfaces,
         gloss = format->Gloss;
         bloss = format->Bloss;
 
-        the_idx = accumulate;
+        the_idx = job->accumulate + (size_t) first * width * num_elements;
         /* If palette surface, we use a different code path... */
 
         if((format->BytesPerPixel == 1 && destformat->BytesPerPixel == 1)
@@ -2344,7 +4010,7 @@ int average_surfaces(SDL_Surface **surfaces,
             This is useful if the surface is actually greyscale colors,
             and not palette colors.
             */
-            for(y=0;y<height;y++) {
+            for(y=first;y<first + n;y++) {
                 for(x=0;x<width;x++) {
                     SURF_GET_AT(the_color, surf, x, y, pixels, format, pix);
                     *(the_idx) += the_color;
@@ -2361,7 +4027,7 @@ int average_surfaces(SDL_Surface **surfaces,
 
 
             /* for non palette surfaces, we do this... */
-            for(y=0;y<height;y++) {
+            for(y=first;y<first + n;y++) {
                 for(x=0;x<width;x++) {
                     SURF_GET_AT(the_color, surf, x, y, pixels, format, pix);
 
@@ -2380,53 +4046,113 @@ int average_surfaces(SDL_Surface **surfaces,
 
     /* blit the accumulated array back to the destination surface. */
 
-
-    div_inv = (float) (1.0L / (num_surfaces));
-
-    the_idx = accumulate;
+    the_idx = job->accumulate + (size_t) first * width * num_elements;
 
     if(num_elements == 1 && (!palette_colors)) {
         /* this is where we are using the palette surface without using its
         colors from the palette.
         */
-        for(y=0;y<height;y++) {
+        for(y=first;y<first + n;y++) {
             for(x=0;x<width;x++) {
                 the_color = (*(the_idx) * div_inv + .5f);
                 SURF_SET_AT(the_color, destsurf, x, y, destpixels, destformat, byte_buf);
                 the_idx++;
             }
         }
-    /* TODO: will need to handle palette colors.
-    */
+    /* TODO: will need to handle palette colors.
+    */
+
+    } else if (num_elements == 3) {
+        for(y=first;y<first + n;y++) {
+            for(x=0;x<width;x++) {
+
+                the_color = SDL_MapRGB (destformat,
+                                        (Uint8) (*(the_idx) * div_inv + .5f),
+                                        (Uint8) (*(the_idx + 1) * div_inv + .5f),
+                                        (Uint8) (*(the_idx + 2) * div_inv + .5f));
+
+                /* TODO: should it take into consideration the output
+                    shifts/masks/losses?  Or does SDL_MapRGB do that correctly?
+
+                    *(the_idx) += ((the_color & rmask) >> rshift) << rloss;
+                    *(the_idx + 1) += ((the_color & gmask) >> gshift) << gloss;
+                    *(the_idx + 2) += ((the_color & bmask) >> bshift) << bloss;
+                */
+
+                SURF_SET_AT(the_color, destsurf, x, y, destpixels, destformat, byte_buf);
+
+                the_idx += 3;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int average_surfaces(SDL_Surface **surfaces,
+                     int num_surfaces,
+                     SDL_Surface *destsurf,
+                     int palette_colors) {
+    /*
+        returns the average surface from the ones given.
+
+        All surfaces need to be the same size.
+
+        palette_colors - if true we average the colors in palette, otherwise we
+            average the pixel values.  This is useful if the surface is
+            actually greyscale colors, and not palette colors.
+
+    */
+
+    AverageJob job;
+    SDL_PixelFormat *destformat;
+    int height, width, surf_idx;
+    int num_elements;
+
+    if(!num_surfaces) { return 0; }
+
+    height = surfaces[0]->h;
+    width = surfaces[0]->w;
+
+    destformat = destsurf->format;
+
+
+    /* allocate an array to accumulate them all.
+
+    If we're using 1 byte per pixel, then only need to average on that much.
+    32-bit surfaces with byte channels use four accumulators a pixel.
+    */
+
+    if((destformat->BytesPerPixel == 1) &&
+       (destformat->palette) &&
+       (!palette_colors)) {
+        num_elements = 1;
+    } else {
+        num_elements = destformat->BytesPerPixel == 4 ? 4 : 3;
+        for(surf_idx=0;surf_idx < num_surfaces;surf_idx++) {
+            if (!PG_RGB_BYTES_32 (surfaces[surf_idx]->format)) {
+                num_elements = 3;
+                break;
+            }
+        }
+    }
 
-    } else if (num_elements == 3) {
-        for(y=0;y<height;y++) {
-            for(x=0;x<width;x++) {
+    job.accumulate = (Uint32 *) calloc(1, sizeof(Uint32) * height * width * num_elements );
 
-                the_color = SDL_MapRGB (destformat,
-                                        (Uint8) (*(the_idx) * div_inv + .5f),
-                                        (Uint8) (*(the_idx + 1) * div_inv + .5f),
-                                        (Uint8) (*(the_idx + 2) * div_inv + .5f));
 
-                /* TODO: should it take into consideration the output
-                    shifts/masks/losses?  Or does SDL_MapRGB do that correctly?
 
-                    *(the_idx) += ((the_color & rmask) >> rshift) << rloss;
-                    *(the_idx + 1) += ((the_color & gmask) >> gshift) << gloss;
-                    *(the_idx + 2) += ((the_color & bmask) >> bshift) << bloss;
-                */
+    if(!job.accumulate) { return -1; }
 
-                SURF_SET_AT(the_color, destsurf, x, y, destpixels, destformat, byte_buf);
+    job.surfaces = surfaces;
+    job.num_surfaces = num_surfaces;
+    job.destsurf = destsurf;
+    job.palette_colors = palette_colors;
+    job.num_elements = num_elements;
+    job.div_inv = (float) (1.0L / (num_surfaces));
 
-                the_idx += 3;
-            }
-        }
-    } else {
-        free(accumulate);
-        return -4;
-    }
+    smooth_jobs (average_rows, &job, height, width * height * num_surfaces);
 
-    free(accumulate);
+    free(job.accumulate);
 
     return 1;
 }
@@ -2550,7 +4276,10 @@ surf_average_surfaces (PyObject* self, PyObject* arg)
                 }
             }
             else
+            {
                 newsurf = PySurface_AsSurface (surfobj2);
+                PySurface_DropRLE (surfobj2);
+            }
 
 
             /* check to see if the size is the correct size. */
@@ -2751,7 +4480,7 @@ static PyObject* surf_average_color(PyObject* self, PyObject* arg)
     Uint8 r, g, b, a;
     int x, y, w, h;
 
-    if (!PyArg_ParseTuple (arg, "O!|O", &PySurface_Type, &surfobj, &rectobj))
+    if (!PyArg_ParseTuple (arg, "O&|O", PySurface_Source, &surfobj, &rectobj))
         return NULL;
 
     surf = PySurface_AsSurface (surfobj);
@@ -2779,24 +4508,641 @@ static PyObject* surf_average_color(PyObject* self, PyObject* arg)
     return Py_BuildValue ("(bbbb)", r, g, b, a);
 }
 
+/* Store the pixel value color at pix, bpp bytes. Unlike SURF_SET_AT this
+ * takes the value as is for 24-bit pixels, whatever the channel order.
+ */
+static void
+pixel_store (Uint8 *pix, int bpp, Uint32 color)
+{
+    switch (bpp)
+    {
+    case 1:
+        *pix = (Uint8) color;
+        break;
+    case 2:
+        *(Uint16 *) pix = (Uint16) color;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        pix[0] = (Uint8) color;
+        pix[1] = (Uint8) (color >> 8);
+        pix[2] = (Uint8) (color >> 16);
+#else
+        pix[2] = (Uint8) color;
+        pix[1] = (Uint8) (color >> 8);
+        pix[0] = (Uint8) (color >> 16);
+#endif
+        break;
+    default:
+        *(Uint32 *) pix = color;
+        break;
+    }
+}
+
+/* The colour space conversions of transform.rgb_to_hsv, hsv_to_rgb and
+ * correct_gamma
+ */
+typedef enum
+{
+    COLORSPACE_TO_HSV,
+    COLORSPACE_TO_RGB,
+    COLORSPACE_GAMMA
+} ColorSpaceOp;
+
+/* The arguments of colorspace_rows, for the row bands */
+typedef struct
+{
+    SDL_Surface *surf;
+    SDL_Surface *newsurf;
+    ColorSpaceOp op;
+    int bytes;          /* true for whole byte RGB channels in one format */
+    int roff, goff, boff;
+    Uint8 table[256];
+} ColorSpaceJob;
+
+/* The byte offsets in a pixel of format of the RGB channels, if it has 24
+ * or 32 bits with a whole byte each. Returns 0 if not.
+ */
+static int
+colorspace_offsets (SDL_PixelFormat *format, int *roff, int *goff, int *boff)
+{
+    int bpp = format->BytesPerPixel;
+
+    if ((bpp != 3 && bpp != 4) ||
+        format->Rmask != (Uint32) 0xFF << format->Rshift ||
+        format->Gmask != (Uint32) 0xFF << format->Gshift ||
+        format->Bmask != (Uint32) 0xFF << format->Bshift)
+        return 0;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    *roff = format->Rshift >> 3;
+    *goff = format->Gshift >> 3;
+    *boff = format->Bshift >> 3;
+#else
+    *roff = bpp - 1 - (format->Rshift >> 3);
+    *goff = bpp - 1 - (format->Gshift >> 3);
+    *boff = bpp - 1 - (format->Bshift >> 3);
+#endif
+    return 1;
+}
+
+/* Convert one pixel's channels */
+static void
+colorspace_pixel (ColorSpaceJob *job, Uint8 *r, Uint8 *g, Uint8 *b)
+{
+    switch (job->op)
+    {
+    case COLORSPACE_TO_HSV:
+        pg_rgb_to_hsv (*r, *g, *b, r, g, b);
+        break;
+    case COLORSPACE_TO_RGB:
+        pg_hsv_to_rgb (*r, *g, *b, r, g, b);
+        break;
+    default:
+        *r = job->table[*r];
+        *g = job->table[*g];
+        *b = job->table[*b];
+        break;
+    }
+}
+
+/* Convert rows first to first + n - 1 of surf into newsurf. Byte channels
+ * are copied and converted in place a row at a time, anything else a pixel
+ * at a time through SDL_GetRGBA and SDL_MapRGBA.
+ */
+static int
+colorspace_rows (void *data, int first, int n)
+{
+    ColorSpaceJob *job = (ColorSpaceJob *) data;
+    SDL_Surface *surf = job->surf, *newsurf = job->newsurf;
+    SDL_PixelFormat *format = surf->format, *newformat = newsurf->format;
+    int bpp = format->BytesPerPixel;
+    int width = surf->w;
+    Uint8 *srcrow = (Uint8 *) surf->pixels + first * surf->pitch;
+    Uint8 *dstrow = (Uint8 *) newsurf->pixels + first * newsurf->pitch;
+    Uint8 *pix, r, g, b, a;
+    Uint32 color;
+    int x, y;
+
+    for (y = first; y < first + n;
+         ++y, srcrow += surf->pitch, dstrow += newsurf->pitch)
+    {
+        if (job->bytes)
+        {
+            memcpy (dstrow, srcrow, (size_t) width * bpp);
+            switch (job->op)
+            {
+            case COLORSPACE_TO_HSV:
+                pg_rgb_to_hsv_pixels (dstrow, width, bpp,
+                                      job->roff, job->goff, job->boff);
+                break;
+            case COLORSPACE_TO_RGB:
+                pg_hsv_to_rgb_pixels (dstrow, width, bpp,
+                                      job->roff, job->goff, job->boff);
+                break;
+            default:
+                pg_table_pixels (dstrow, width, bpp, job->roff, job->goff,
+                                 job->boff, job->table);
+                break;
+            }
+            continue;
+        }
+        for (x = 0; x < width; ++x)
+        {
+            SURF_GET_AT (color, surf, x, y, (Uint8 *) surf->pixels, format,
+                         pix);
+            SDL_GetRGBA (color, format, &r, &g, &b, &a);
+            colorspace_pixel (job, &r, &g, &b);
+            color = SDL_MapRGBA (newformat, r, g, b, a);
+            pixel_store (dstrow + x * newformat->BytesPerPixel,
+                         newformat->BytesPerPixel, color);
+        }
+    }
+    return 0;
+}
+
+static PyObject*
+surf_colorspace (PyObject *surfobj, PyObject *surfobj2, ColorSpaceOp op,
+                 double gamma)
+{
+    SDL_Surface *surf, *newsurf;
+    ColorSpaceJob job;
+    int roff, goff, boff;
+
+    surf = PySurface_AsSurface (surfobj);
+    newsurf = transform_dest (surf, surfobj2, surf->w, surf->h);
+    if (!newsurf)
+        return NULL;
+
+    job.surf = surf;
+    job.newsurf = newsurf;
+    job.op = op;
+    job.bytes = 0;
+    if (colorspace_offsets (surf->format, &job.roff, &job.goff, &job.boff) &&
+        colorspace_offsets (newsurf->format, &roff, &goff, &boff) &&
+        roff == job.roff && goff == job.goff && boff == job.boff &&
+        surf->format->Amask == newsurf->format->Amask)
+        job.bytes = 1;
+    if (op == COLORSPACE_GAMMA)
+        pg_gamma_table (job.table, gamma);
+
+    if (surf->w && surf->h)
+    {
+        SDL_LockSurface (newsurf);
+        PySurface_Lock (surfobj);
+        Py_BEGIN_ALLOW_THREADS;
+        smooth_jobs (colorspace_rows, &job, surf->h, surf->w * surf->h);
+        Py_END_ALLOW_THREADS;
+        PySurface_Unlock (surfobj);
+        SDL_UnlockSurface (newsurf);
+    }
+
+    return transform_result (surfobj, surfobj2, newsurf);
+}
+
+static PyObject*
+surf_rgb_to_hsv (PyObject *self, PyObject *arg)
+{
+    PyObject *surfobj, *surfobj2 = NULL;
+
+    if (!PyArg_ParseTuple (arg, "O&|O!", PySurface_Source, &surfobj,
+                           &PySurface_Type, &surfobj2))
+        return NULL;
+    return surf_colorspace (surfobj, surfobj2, COLORSPACE_TO_HSV, 0.0);
+}
+
+static PyObject*
+surf_hsv_to_rgb (PyObject *self, PyObject *arg)
+{
+    PyObject *surfobj, *surfobj2 = NULL;
+
+    if (!PyArg_ParseTuple (arg, "O&|O!", PySurface_Source, &surfobj,
+                           &PySurface_Type, &surfobj2))
+        return NULL;
+    return surf_colorspace (surfobj, surfobj2, COLORSPACE_TO_RGB, 0.0);
+}
+
+static PyObject*
+surf_correct_gamma (PyObject *self, PyObject *arg)
+{
+    PyObject *surfobj, *surfobj2 = NULL;
+    double gamma;
+
+    if (!PyArg_ParseTuple (arg, "O&d|O!", PySurface_Source, &surfobj,
+                           &gamma, &PySurface_Type, &surfobj2))
+        return NULL;
+    return surf_colorspace (surfobj, surfobj2, COLORSPACE_GAMMA, gamma);
+}
+
+/* The arguments of remap_rows, for the row bands. Either hashed, with
+ * size slots of keys and values, or per channel tables.
+ */
+typedef struct
+{
+    SDL_Surface *surf;
+    SDL_Surface *newsurf;
+    int same_format;    /* true if newsurf has the pixel format of surf */
+    int hashed;
+    Uint32 *keys;
+    Uint32 *values;
+    Uint8 *used;
+    Uint32 mask;        /* size - 1, size being a power of 2 */
+    Uint8 tables[4][256];
+    int offsets[4];     /* channel byte offsets, -1 if not whole bytes */
+} RemapJob;
+
+#define REMAP_HASH(key, mask) (((Uint32) (key) * 2654435761u) & (mask))
+
+/* Find key in the table of job. Returns 1 and the value in value if it
+ * is there, 0 if not.
+ */
+static int
+remap_lookup (RemapJob *job, Uint32 key, Uint32 *value)
+{
+    Uint32 i = REMAP_HASH (key, job->mask);
+
+    while (job->used[i])
+    {
+        if (job->keys[i] == key)
+        {
+            *value = job->values[i];
+            return 1;
+        }
+        i = (i + 1) & job->mask;
+    }
+    return 0;
+}
+
+static void
+remap_insert (RemapJob *job, Uint32 key, Uint32 value)
+{
+    Uint32 i = REMAP_HASH (key, job->mask);
+
+    while (job->used[i] && job->keys[i] != key)
+        i = (i + 1) & job->mask;
+    job->used[i] = 1;
+    job->keys[i] = key;
+    job->values[i] = value;
+}
+
+/* Fill the table of job from the color to color dict lut. Keys are the
+ * pixel values of surf, values those of newsurf, or both are packed
+ * 0xRRGGBB for a palette. Returns 0 with an exception set on failure.
+ */
+static int
+remap_hash (RemapJob *job, PyObject *lut, int palette)
+{
+    SDL_PixelFormat *format = job->surf->format;
+    SDL_PixelFormat *newformat = job->newsurf->format;
+    Py_ssize_t pos = 0, n = PyDict_Size (lut);
+    PyObject *key, *value;
+    Uint8 keyrgba[4], valuergba[4];
+    Uint32 size = 8;
+
+    while (size < 2 * n)
+        size <<= 1;
+    job->keys = PyMem_New (Uint32, size);
+    job->values = PyMem_New (Uint32, size);
+    job->used = PyMem_New (Uint8, size);
+    if (!job->keys || !job->values || !job->used)
+    {
+        PyErr_NoMemory ();
+        return 0;
+    }
+    memset (job->used, 0, size);
+    job->mask = size - 1;
+
+    while (PyDict_Next (lut, &pos, &key, &value))
+    {
+        if (!RGBAFromColorObj (key, keyrgba) ||
+            !RGBAFromColorObj (value, valuergba))
+        {
+            PyErr_SetString (PyExc_ValueError,
+                             "remap keys and values must be colors");
+            return 0;
+        }
+        if (palette)
+            remap_insert (job, (keyrgba[0] << 16) | (keyrgba[1] << 8) |
+                          keyrgba[2], (valuergba[0] << 16) |
+                          (valuergba[1] << 8) | valuergba[2]);
+        else
+            remap_insert (job, SDL_MapRGBA (format, keyrgba[0], keyrgba[1],
+                                            keyrgba[2], keyrgba[3]),
+                          SDL_MapRGBA (newformat, valuergba[0], valuergba[1],
+                                       valuergba[2], valuergba[3]));
+    }
+    return 1;
+}
+
+/* Fill the R, G, B and A tables of job from lut: one table of 256 levels
+ * for R, G and B, or a sequence of 3 or 4 of them. An alpha table not
+ * given maps every level to itself. Returns 0 with an exception set on
+ * failure.
+ */
+static int
+remap_tables (RemapJob *job, PyObject *lut)
+{
+    PyObject *tables[4];
+    PyObject *item;
+    Py_ssize_t n;
+    long level;
+    int i, j;
+
+    n = PySequence_Size (lut);
+    if (n < 0)
+        return 0;
+    if (n == 256)
+    {
+        tables[0] = tables[1] = tables[2] = lut;
+        tables[3] = NULL;
+    }
+    else if (n == 3 || n == 4)
+    {
+        for (i = 0; i < 4; ++i)
+            tables[i] = NULL;
+        for (i = 0; i < n; ++i)
+        {
+            tables[i] = PySequence_GetItem (lut, i);
+            if (!tables[i])
+                return 0;
+            Py_DECREF (tables[i]); /* lut keeps it alive */
+        }
+    }
+    else
+    {
+        PyErr_SetString (PyExc_ValueError,
+                         "remap table must be 256 levels or 3 or 4 tables");
+        return 0;
+    }
+
+    for (i = 0; i < 4; ++i)
+    {
+        if (!tables[i])
+        {
+            for (j = 0; j < 256; ++j)
+                job->tables[i][j] = (Uint8) j;
+            continue;
+        }
+        if (PySequence_Size (tables[i]) != 256)
+        {
+            if (!PyErr_Occurred ())
+                PyErr_SetString (PyExc_ValueError,
+                                 "remap tables must have 256 levels");
+            return 0;
+        }
+        for (j = 0; j < 256; ++j)
+        {
+            item = PySequence_GetItem (tables[i], j);
+            if (!item)
+                return 0;
+            level = PyInt_AsLong (item);
+            Py_DECREF (item);
+            if (level == -1 && PyErr_Occurred ())
+                return 0;
+            if (level < 0 || level > 255)
+            {
+                PyErr_SetString (PyExc_ValueError,
+                                 "remap levels must be 0 to 255");
+                return 0;
+            }
+            job->tables[i][j] = (Uint8) level;
+        }
+    }
+    return 1;
+}
+
+/* Remap rows first to first + n - 1 of surf into newsurf */
+static int
+remap_rows (void *data, int first, int n)
+{
+    RemapJob *job = (RemapJob *) data;
+    SDL_Surface *surf = job->surf, *newsurf = job->newsurf;
+    SDL_PixelFormat *format = surf->format, *newformat = newsurf->format;
+    int bpp = format->BytesPerPixel;
+    int width = surf->w;
+    Uint8 *srcrow = (Uint8 *) surf->pixels + first * surf->pitch;
+    Uint8 *dstrow = (Uint8 *) newsurf->pixels + first * newsurf->pitch;
+    Uint8 *pix, r, g, b, a;
+    Uint32 color, last = 0, lastvalue = 0;
+    int havelast = 0, x, y, c;
+
+    for (y = first; y < first + n;
+         ++y, srcrow += surf->pitch, dstrow += newsurf->pitch)
+    {
+        if (!job->hashed && job->offsets[0] >= 0)
+        {
+            if (dstrow != srcrow)
+                memcpy (dstrow, srcrow, (size_t) width * bpp);
+            for (x = 0, pix = dstrow; x < width; ++x, pix += bpp)
+                for (c = 0; c < 4; ++c)
+                    if (job->offsets[c] >= 0)
+                        pix[job->offsets[c]] =
+                            job->tables[c][pix[job->offsets[c]]];
+            continue;
+        }
+        for (x = 0; x < width; ++x)
+        {
+            SURF_GET_AT (color, surf, x, y, (Uint8 *) surf->pixels, format,
+                         pix);
+            if (job->hashed)
+            {
+                /* sprites have runs of one color, so keep the last */
+                if (!havelast || color != last)
+                {
+                    last = color;
+                    havelast = 1;
+                    if (!remap_lookup (job, color, &lastvalue))
+                    {
+                        lastvalue = color;
+                        if (!job->same_format)
+                        {
+                            SDL_GetRGBA (color, format, &r, &g, &b, &a);
+                            lastvalue = SDL_MapRGBA (newformat, r, g, b, a);
+                        }
+                    }
+                }
+                color = lastvalue;
+            }
+            else
+            {
+                SDL_GetRGBA (color, format, &r, &g, &b, &a);
+                color = SDL_MapRGBA (newformat, job->tables[0][r],
+                                     job->tables[1][g], job->tables[2][b],
+                                     job->tables[3][a]);
+            }
+            pixel_store (dstrow + x * bpp, bpp, color);
+        }
+    }
+    return 0;
+}
+
+/* Remap the palette of an 8-bit surf into newsurf, copying the pixels
+ * unless newsurf is surf.
+ */
+static void
+remap_palette (RemapJob *job)
+{
+    SDL_Surface *surf = job->surf, *newsurf = job->newsurf;
+    SDL_Palette *palette = surf->format->palette;
+    SDL_Color colors[256];
+    Uint8 *srcrow, *dstrow;
+    Uint32 rgb;
+    int i, y;
+
+    if (!palette)
+        return;
+    for (i = 0; i < palette->ncolors && i < 256; ++i)
+    {
+        colors[i] = palette->colors[i];
+        if (job->hashed)
+        {
+            rgb = (colors[i].r << 16) | (colors[i].g << 8) | colors[i].b;
+            if (remap_lookup (job, rgb, &rgb))
+            {
+                colors[i].r = (Uint8) (rgb >> 16);
+                colors[i].g = (Uint8) (rgb >> 8);
+                colors[i].b = (Uint8) rgb;
+            }
+        }
+        else
+        {
+            colors[i].r = job->tables[0][colors[i].r];
+            colors[i].g = job->tables[1][colors[i].g];
+            colors[i].b = job->tables[2][colors[i].b];
+        }
+    }
+    if (newsurf != surf)
+    {
+        srcrow = (Uint8 *) surf->pixels;
+        dstrow = (Uint8 *) newsurf->pixels;
+        for (y = 0; y < surf->h;
+             ++y, srcrow += surf->pitch, dstrow += newsurf->pitch)
+            memcpy (dstrow, srcrow, surf->w);
+    }
+    SDL_SetColors (newsurf, colors, 0, i);
+}
+
+static PyObject*
+surf_remap_colors (PyObject *self, PyObject *arg)
+{
+    PyObject *surfobj, *lut, *surfobj2 = NULL;
+    SDL_Surface *surf, *newsurf;
+    RemapJob job;
+    int offsets[4], c, ok;
+
+    if (!PyArg_ParseTuple (arg, "O&O|O!", PySurface_Source, &surfobj, &lut,
+                           &PySurface_Type, &surfobj2))
+        return NULL;
+
+    surf = PySurface_AsSurface (surfobj);
+    if (surfobj2 == surfobj)
+        newsurf = surf;     /* in place */
+    else
+        newsurf = transform_dest (surf, surfobj2, surf->w, surf->h);
+    if (!newsurf)
+        return NULL;
+
+    memset (&job, 0, sizeof (job));
+    job.surf = surf;
+    job.newsurf = newsurf;
+    job.same_format = newsurf == surf ||
+        (surf->format->Rmask == newsurf->format->Rmask &&
+         surf->format->Gmask == newsurf->format->Gmask &&
+         surf->format->Bmask == newsurf->format->Bmask &&
+         surf->format->Amask == newsurf->format->Amask);
+    job.hashed = PyDict_Check (lut);
+    if (job.hashed)
+        ok = remap_hash (&job, lut, surf->format->BytesPerPixel == 1);
+    else
+        ok = remap_tables (&job, lut);
+    if (!ok)
+    {
+        PyMem_Del (job.keys);
+        PyMem_Del (job.values);
+        PyMem_Del (job.used);
+        if (!surfobj2)
+            PySurface_FreeSurface (newsurf);
+        return NULL;
+    }
+
+    /* whole byte channels in the same places take the tables a byte at a
+     * time, alpha too when it is a byte */
+    job.offsets[0] = -1;
+    if (!job.hashed && job.same_format &&
+        colorspace_offsets (surf->format, &offsets[0], &offsets[1],
+                            &offsets[2]))
+    {
+        offsets[3] = -1;
+        if (surf->format->BytesPerPixel == 4 &&
+            surf->format->Amask == (Uint32) 0xFF << surf->format->Ashift)
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            offsets[3] = surf->format->Ashift >> 3;
+#else
+            offsets[3] = 3 - (surf->format->Ashift >> 3);
+#endif
+        for (c = 0; c < 4; ++c)
+            job.offsets[c] = offsets[c];
+    }
+
+    if (newsurf != surf)
+        SDL_LockSurface (newsurf);
+    PySurface_Lock (surfobj);
+    if (surf->format->BytesPerPixel == 1)
+        remap_palette (&job);
+    else if (surf->w && surf->h)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        smooth_jobs (remap_rows, &job, surf->h, surf->w * surf->h);
+        Py_END_ALLOW_THREADS;
+    }
+    PySurface_Unlock (surfobj);
+    if (newsurf != surf)
+        SDL_UnlockSurface (newsurf);
+
+    PyMem_Del (job.keys);
+    PyMem_Del (job.values);
+    PyMem_Del (job.used);
+    return transform_result (surfobj, surfobj2, newsurf);
+}
+
 static PyMethodDef _transform_methods[] =
 {
     { "scale", surf_scale, METH_VARARGS, DOC_PYGAMETRANSFORMSCALE },
     { "rotate", surf_rotate, METH_VARARGS, DOC_PYGAMETRANSFORMROTATE },
+    { "get_rotated_size", surf_get_rotated_size, METH_VARARGS,
+      DOC_PYGAMETRANSFORMGETROTATEDSIZE },
     { "flip", surf_flip, METH_VARARGS, DOC_PYGAMETRANSFORMFLIP },
     { "rotozoom", surf_rotozoom, METH_VARARGS, DOC_PYGAMETRANSFORMROTOZOOM},
     { "chop", surf_chop, METH_VARARGS, DOC_PYGAMETRANSFORMCHOP },
     { "scale2x", surf_scale2x, METH_VARARGS, DOC_PYGAMETRANSFORMSCALE2X },
+    { "scale3x", surf_scale3x, METH_VARARGS, DOC_PYGAMETRANSFORMSCALE3X },
+    { "scale4x", surf_scale4x, METH_VARARGS, DOC_PYGAMETRANSFORMSCALE4X },
     { "smoothscale", surf_scalesmooth, METH_VARARGS, DOC_PYGAMETRANSFORMSMOOTHSCALE },
+    { "MipChain", surf_mip_chain, METH_VARARGS, DOC_PYGAMETRANSFORMMIPCHAIN },
     { "get_smoothscale_backend", (PyCFunction) surf_get_smoothscale_backend, METH_NOARGS,
           DOC_PYGAMETRANSFORMGETSMOOTHSCALEBACKEND },
     { "set_smoothscale_backend", (PyCFunction) surf_set_smoothscale_backend,
           METH_VARARGS | METH_KEYWORDS,
           DOC_PYGAMETRANSFORMSETSMOOTHSCALEBACKEND },
+    { "get_smoothscale_threads", (PyCFunction) surf_get_smoothscale_threads,
+          METH_NOARGS, DOC_PYGAMETRANSFORMGETSMOOTHSCALETHREADS },
+    { "set_smoothscale_threads", surf_set_smoothscale_threads, METH_VARARGS,
+          DOC_PYGAMETRANSFORMSETSMOOTHSCALETHREADS },
+    { "box_blur", surf_box_blur, METH_VARARGS, DOC_PYGAMETRANSFORMBOXBLUR },
+    { "gaussian_blur", surf_gaussian_blur, METH_VARARGS,
+      DOC_PYGAMETRANSFORMGAUSSIANBLUR },
     { "threshold", surf_threshold, METH_VARARGS, DOC_PYGAMETRANSFORMTHRESHOLD },
-    { "laplacian", surf_laplacian, METH_VARARGS, DOC_PYGAMETRANSFORMTHRESHOLD },
+    { "laplacian", surf_laplacian, METH_VARARGS, DOC_PYGAMETRANSFORMLAPLACIAN },
+    { "convolve", surf_convolve, METH_VARARGS, DOC_PYGAMETRANSFORMCONVOLVE },
     { "average_surfaces", surf_average_surfaces, METH_VARARGS, DOC_PYGAMETRANSFORMAVERAGESURFACES },
     { "average_color", surf_average_color, METH_VARARGS, DOC_PYGAMETRANSFORMAVERAGECOLOR },
+    { "rgb_to_hsv", surf_rgb_to_hsv, METH_VARARGS,
+      DOC_PYGAMETRANSFORMRGBTOHSV },
+    { "hsv_to_rgb", surf_hsv_to_rgb, METH_VARARGS,
+      DOC_PYGAMETRANSFORMHSVTORGB },
+    { "correct_gamma", surf_correct_gamma, METH_VARARGS,
+      DOC_PYGAMETRANSFORMCORRECTGAMMA },
+    { "remap_colors", surf_remap_colors, METH_VARARGS,
+      DOC_PYGAMETRANSFORMREMAPCOLORS },
 
     { NULL, NULL, 0, NULL }
 };
@@ -2804,7 +5150,7 @@ static PyMethodDef _transform_methods[] =
 
 MODINIT_DEFINE (transform)
 {
-    PyObject *module;
+    PyObject *module, *dict;
     struct _module_state *st;
 
 #if PY3
@@ -2838,6 +5184,11 @@ MODINIT_DEFINE (transform)
         MODINIT_ERROR;
     }
 
+    /* create the mip chain type */
+    if (PyType_Ready (&PyMipChain_Type) < 0) {
+        MODINIT_ERROR;
+    }
+
     /* create the module */
 #if PY3
     module = PyModule_Create (&_module);
@@ -2850,10 +5201,26 @@ MODINIT_DEFINE (transform)
     if (module == 0) {
         MODINIT_ERROR;
     }
+    dict = PyModule_GetDict (module);
+    if (PyDict_SetItemString (dict, "MipChainType",
+                              (PyObject *) &PyMipChain_Type) == -1) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
 
     st = GETSTATE (module);
     if (st->filter_type == 0) {
         smoothscale_init (st);
     }
+
+    /* let pygame.set_simd_backend switch the filters */
+    if (PgSimd_Register ("transform",
+                         PyDict_GetItemString (dict,
+                                               "get_smoothscale_backend"),
+                         PyDict_GetItemString (dict,
+                                               "set_smoothscale_backend"))) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
     MODINIT_RETURN (module);
 }
@@ -171,6 +171,28 @@ class BaseModuleTest(unittest.TestCase):
         gc.collect()
         self.assertFalse(o.is_dict_alive())
 
+    def test_PgObject_GetBuffer_typestr_repeated(self):
+        # Conversions in a row of the same and of different item types
+        from pygame.bufferproxy import BufferProxy
+
+        class Exporter(self.ExporterBase):
+            def get__array_interface__(self):
+                return {'version': 3,
+                        'typestr': self.typestr,
+                        'shape': self.shape,
+                        'strides': self.strides,
+                        'data': self.data}
+            __array_interface__ = property(get__array_interface__)
+
+        for typechar, itemsize in [('u', 4), ('u', 4), ('i', 4), ('u', 2),
+                                   ('f', 8), ('f', 8), ('u', 1), ('u', 4)]:
+            o = Exporter((3, 5), typechar, itemsize)
+            self.assertSame(BufferProxy(o), o)
+        o = Exporter((3, 5), 'u', 4)
+        self.assertSame(BufferProxy(o), o)
+        o.typestr = o.typestr[0] + 'z4'
+        self.assertRaises(ValueError, lambda: BufferProxy(o).length)
+
     def test_GetView_array_struct(self):
         from pygame.bufferproxy import BufferProxy
 
@@ -575,6 +597,78 @@ class BaseModuleTest(unittest.TestCase):
         pygame.set_error("")
         self.assertEqual(pygame.get_error(), "")
 
+    def test_set_pool_threads(self):
+        threads = pygame.get_pool_threads()
+        self.assertRaises(ValueError, pygame.set_pool_threads, -1)
+        try:
+            for count in [4, 1, 0, 3]:
+                pygame.set_pool_threads(count)
+                self.assertEqual(pygame.get_pool_threads(), count)
+        finally:
+            pygame.set_pool_threads(threads)
+
+    def test_pool_map(self):
+        threads = pygame.get_pool_threads()
+        items = list(range(500))
+        try:
+            for count in [0, 4]:
+                pygame.set_pool_threads(count)
+                self.assertEqual(pygame.pool_map(lambda x: x * 2, items),
+                                 [x * 2 for x in items])
+                self.assertEqual(pygame.pool_map(abs, []), [])
+
+                def fail(x):
+                    if x == 250:
+                        raise KeyError(x)
+                    return x
+                self.assertRaises(KeyError, pygame.pool_map, fail, items)
+                self.assertRaises(TypeError, pygame.pool_map, 1, items)
+        finally:
+            pygame.set_pool_threads(threads)
+
+    def test_get_cpu_features(self):
+        features = pygame.get_cpu_features()
+        self.assertTrue(isinstance(features, tuple))
+        for name in features:
+            self.assertTrue(name in ('MMX', 'SSE', 'SSE2', 'AVX2', 'NEON'))
+
+    def test_set_simd_backend(self):
+        import pygame.transform
+        import pygame.surface
+        backends = pygame.get_simd_backend()
+        self.assertEqual(backends['transform'],
+                         pygame.transform.get_smoothscale_backend())
+        self.assertEqual(backends['surface'],
+                         pygame.surface.get_blit_backend())
+        try:
+            for module in ['transform', 'surface']:
+                pygame.set_simd_backend(module, 'GENERIC')
+                self.assertEqual(pygame.get_simd_backend(module), 'GENERIC')
+                self.assertRaises(ValueError, pygame.set_simd_backend,
+                                  module, 'no such backend')
+        finally:
+            for module in backends:
+                pygame.set_simd_backend(module, backends[module])
+        self.assertEqual(pygame.get_simd_backend(), backends)
+        self.assertRaises(ValueError, pygame.get_simd_backend, 'no module')
+        self.assertRaises(ValueError, pygame.set_simd_backend,
+                          'no module', 'GENERIC')
+
+    def test_set_pool_affinity(self):
+        threads = pygame.get_pool_threads()
+        try:
+            pygame.set_pool_threads(3)
+            try:
+                pygame.set_pool_affinity([0])
+            except NotImplementedError:
+                return
+            self.assertEqual(pygame.get_pool_threads(), 3)
+            self.assertEqual(pygame.pool_map(str, [1, 2]), ['1', '2'])
+            self.assertRaises(ValueError, pygame.set_pool_affinity, [-1])
+            pygame.set_pool_affinity()
+        finally:
+            pygame.set_pool_threads(threads)
+
 
 
     def test_set_error(self):
@@ -634,6 +728,23 @@ class BaseModuleTest(unittest.TestCase):
         self.not_init_assertions()
 
 
+    def test_lazy_submodules(self):
+        import os
+        import subprocess
+        code = ("import sys, pygame\n"
+                "loaded = 'pygame.transform' in sys.modules\n"
+                "pygame.transform.scale\n"
+                "print('%s %s' % (loaded, 'pygame.transform' in sys.modules))")
+        env = dict(os.environ)
+        env.pop('PYGAME_PRELOAD', None)
+        out = subprocess.Popen([sys.executable, '-c', code], env=env,
+                               stdout=subprocess.PIPE).communicate()[0]
+        self.assertEqual(out.split(), [b'False', b'True'])
+        env['PYGAME_PRELOAD'] = '1'
+        out = subprocess.Popen([sys.executable, '-c', code], env=env,
+                               stdout=subprocess.PIPE).communicate()[0]
+        self.assertEqual(out.split(), [b'True', b'True'])
+
     def todo_test_segfault(self):
 
         # __doc__ (as of 2008-08-02) for pygame.base.segfault:
@@ -0,0 +1,352 @@
+"""Time pygame operations on fixed workloads
+
+python -m pygame.tests.bench [options] [name ...]
+
+or
+
+python test/bench.py [options] [name ...]
+
+Runs blits with every blend flag, fills, smoothscale with each backend
+the machine has, rotations, draw and gfxdraw primitives, mask overlaps
+and freetype rendering, each on the same surfaces and data every run.
+Only the benchmarks whose names contain one of the given names run.
+Writes the results as JSON for comparing runs: --compare with the JSON
+of an earlier run exits with status 1 if a benchmark got slower by more
+than --threshold.
+
+setup.py bench runs it with the default options.
+"""
+
+import sys
+import os
+import time
+import random
+import platform
+import json
+from optparse import OptionParser
+
+if __name__ == '__main__':
+    pkg_dir = os.path.split(os.path.abspath(__file__))[0]
+    parent_dir, pkg_name = os.path.split(pkg_dir)
+    is_pygame_pkg = (pkg_name == 'tests' and
+                     os.path.split(parent_dir)[1] == 'pygame')
+    if not is_pygame_pkg:
+        sys.path.insert(0, parent_dir)
+
+import pygame
+from pygame.locals import *
+import pygame.transform
+import pygame.draw
+import pygame.mask
+
+try:
+    import pygame.gfxdraw as gfxdraw
+except ImportError:
+    gfxdraw = None
+
+try:
+    import pygame.freetype as freetype
+except ImportError:
+    freetype = None
+
+
+SIZE = (640, 480)
+SEED = 1
+
+BLEND_FLAGS = [
+    ('BLEND_RGB_ADD', BLEND_RGB_ADD),
+    ('BLEND_RGB_SUB', BLEND_RGB_SUB),
+    ('BLEND_RGB_MULT', BLEND_RGB_MULT),
+    ('BLEND_RGB_MIN', BLEND_RGB_MIN),
+    ('BLEND_RGB_MAX', BLEND_RGB_MAX),
+    ('BLEND_RGBA_ADD', BLEND_RGBA_ADD),
+    ('BLEND_RGBA_SUB', BLEND_RGBA_SUB),
+    ('BLEND_RGBA_MULT', BLEND_RGBA_MULT),
+    ('BLEND_RGBA_MIN', BLEND_RGBA_MIN),
+    ('BLEND_RGBA_MAX', BLEND_RGBA_MAX),
+    ('BLEND_PREMULTIPLIED', BLEND_PREMULTIPLIED),
+]
+
+SMOOTHSCALE_BACKENDS = ['GENERIC', 'MMX', 'SSE', 'AVX2', 'NEON']
+
+
+def noise_surface(size, flags=0, depth=32):
+    """A surface of random pixels, the same for every run"""
+    rand = random.Random(SEED)
+    surf = pygame.Surface(size, flags, depth)
+    w, h = size
+    for y in range(0, h, 4):
+        for x in range(0, w, 4):
+            color = (rand.randrange(256), rand.randrange(256),
+                     rand.randrange(256), rand.randrange(256))
+            surf.fill(color, (x, y, 4, 4))
+    return surf
+
+
+def random_mask(size, density):
+    rand = random.Random(SEED)
+    mask = pygame.mask.Mask(size)
+    w, h = size
+    for i in range(int(w * h * density)):
+        mask.set_at((rand.randrange(w), rand.randrange(h)), 1)
+    return mask
+
+
+def blit_benchmarks():
+    dst = noise_surface(SIZE)
+    src = noise_surface(SIZE)
+    src_alpha = noise_surface(SIZE, SRCALPHA)
+    src_key = noise_surface(SIZE)
+    src_key.set_colorkey(src_key.get_at((0, 0)))
+    src_surface_alpha = noise_surface(SIZE)
+    src_surface_alpha.set_alpha(128)
+
+    yield 'blit', lambda: dst.blit(src, (0, 0))
+    yield 'blit.srcalpha', lambda: dst.blit(src_alpha, (0, 0))
+    yield 'blit.colorkey', lambda: dst.blit(src_key, (0, 0))
+    yield 'blit.surface_alpha', lambda: dst.blit(src_surface_alpha, (0, 0))
+    for name, flag in BLEND_FLAGS:
+        yield ('blit.' + name,
+               lambda flag=flag: dst.blit(src_alpha, (0, 0), None, flag))
+
+
+def fill_benchmarks():
+    dst = noise_surface(SIZE)
+    dst_alpha = noise_surface(SIZE, SRCALPHA)
+    color = (120, 60, 200, 128)
+
+    yield 'fill', lambda: dst.fill(color)
+    yield 'fill.srcalpha', lambda: dst_alpha.fill(color)
+    yield 'fill.rect', lambda: dst.fill(color, (13, 17, 300, 200))
+    for name, flag in BLEND_FLAGS:
+        if flag == BLEND_PREMULTIPLIED:
+            continue
+        yield ('fill.' + name,
+               lambda flag=flag: dst_alpha.fill(color, None, flag))
+
+
+def smoothscale_benchmarks():
+    src = noise_surface(SIZE)
+    small = (SIZE[0] // 3, SIZE[1] // 3)
+    large = (SIZE[0] * 2, SIZE[1] * 2)
+
+    for backend in SMOOTHSCALE_BACKENDS:
+        def run(size, backend=backend):
+            pygame.transform.set_smoothscale_backend(backend)
+            return pygame.transform.smoothscale(src, size)
+        try:
+            pygame.transform.set_smoothscale_backend(backend)
+        except ValueError:
+            continue
+        yield ('smoothscale.%s.shrink' % backend,
+               lambda run=run: run(small))
+        yield ('smoothscale.%s.expand' % backend,
+               lambda run=run: run(large))
+
+
+def transform_benchmarks():
+    src = noise_surface((320, 240))
+    src_alpha = noise_surface((320, 240), SRCALPHA)
+
+    yield 'transform.rotate.30', lambda: pygame.transform.rotate(src, 30)
+    yield 'transform.rotate.90', lambda: pygame.transform.rotate(src, 90)
+    yield ('transform.rotate.srcalpha',
+           lambda: pygame.transform.rotate(src_alpha, 30))
+    yield ('transform.rotozoom',
+           lambda: pygame.transform.rotozoom(src, 30, 1.5))
+    yield 'transform.scale', lambda: pygame.transform.scale(src, SIZE)
+    yield 'transform.flip', lambda: pygame.transform.flip(src, 1, 1)
+
+
+def draw_benchmarks():
+    dst = pygame.Surface(SIZE, 0, 32)
+    rand = random.Random(SEED)
+    points = [(rand.randrange(SIZE[0]), rand.randrange(SIZE[1]))
+              for i in range(64)]
+    color = (200, 100, 50)
+    draw = pygame.draw
+
+    def lines(func):
+        for i in range(0, len(points) - 1):
+            func(dst, color, points[i], points[i + 1])
+
+    yield 'draw.line', lambda: lines(draw.line)
+    yield 'draw.aaline', lambda: lines(draw.aaline)
+    yield 'draw.rect', lambda: draw.rect(dst, color, (20, 20, 400, 300), 3)
+    yield 'draw.circle', lambda: draw.circle(dst, color, (320, 240), 200)
+    yield ('draw.ellipse',
+           lambda: draw.ellipse(dst, color, (20, 20, 500, 300)))
+    yield 'draw.polygon', lambda: draw.polygon(dst, color, points[:16])
+
+    if gfxdraw is None:
+        return
+    yield 'gfxdraw.aacircle', lambda: gfxdraw.aacircle(dst, 320, 240, 200,
+                                                       color)
+    yield ('gfxdraw.filled_circle',
+           lambda: gfxdraw.filled_circle(dst, 320, 240, 200, color))
+    yield ('gfxdraw.aaellipse',
+           lambda: gfxdraw.aaellipse(dst, 320, 240, 250, 150, color))
+    yield ('gfxdraw.filled_polygon',
+           lambda: gfxdraw.filled_polygon(dst, points[:16], color))
+    yield ('gfxdraw.aapolygon',
+           lambda: gfxdraw.aapolygon(dst, points[:16], color))
+    yield ('gfxdraw.bezier',
+           lambda: gfxdraw.bezier(dst, points[:8], 50, color))
+
+
+def mask_benchmarks():
+    big = random_mask(SIZE, 0.3)
+    small = random_mask((160, 200), 0.01)
+    surf = noise_surface((320, 240), SRCALPHA)
+    offsets = [(x, y) for y in range(0, 280, 28) for x in range(-50, 480, 30)]
+
+    def overlaps(func):
+        for offset in offsets:
+            func(small, offset)
+
+    yield 'mask.overlap', lambda: overlaps(big.overlap)
+    yield 'mask.overlap_area', lambda: overlaps(big.overlap_area)
+    yield 'mask.overlap_mask', lambda: overlaps(big.overlap_mask)
+    yield 'mask.from_surface', lambda: pygame.mask.from_surface(surf)
+
+
+def freetype_benchmarks():
+    if freetype is None:
+        return
+    freetype.init()
+    font = freetype.Font(None, 24)
+    text = 'The quick brown fox jumps over the lazy dog 0123456789'
+    dst = pygame.Surface(SIZE, 0, 32)
+
+    yield 'freetype.render', lambda: font.render(text, (255, 255, 255))
+    yield ('freetype.render.antialiased_bg',
+           lambda: font.render(text, (255, 255, 255), (0, 0, 80)))
+    yield ('freetype.render_to',
+           lambda: font.render_to(dst, (10, 10), text, (255, 255, 255)))
+
+
+GROUPS = [blit_benchmarks, fill_benchmarks, smoothscale_benchmarks,
+          transform_benchmarks, draw_benchmarks, mask_benchmarks,
+          freetype_benchmarks]
+
+
+def time_it(func, number, repeats):
+    """The seconds per call of the fastest and median repeat"""
+    times = []
+    for i in range(repeats):
+        start = time.time()
+        for j in range(number):
+            func()
+        times.append((time.time() - start) / number)
+    times.sort()
+    return times[0], times[len(times) // 2]
+
+
+def environment():
+    env = {'pygame': pygame.version.ver,
+           'sdl': '.'.join([str(v) for v in pygame.get_sdl_version()]),
+           'python': platform.python_version(),
+           'platform': platform.platform(),
+           'machine': platform.machine()}
+    if hasattr(pygame, 'get_cpu_features'):
+        env['cpu_features'] = list(pygame.get_cpu_features())
+        env['simd_backends'] = pygame.get_simd_backend()
+    return env
+
+
+def run(names=None, number=10, repeats=5, verbose=True):
+    """Run the benchmarks whose names contain one of names, or all of them.
+    Returns the results, a dict for json.
+    """
+    results = []
+    backend = pygame.transform.get_smoothscale_backend()
+    try:
+        for group in GROUPS:
+            for name, func in group():
+                if names and not [n for n in names if n in name]:
+                    continue
+                best, median = time_it(func, number, repeats)
+                results.append({'name': name,
+                                'seconds': best,
+                                'median_seconds': median,
+                                'number': number,
+                                'repeats': repeats})
+                if verbose:
+                    sys.stderr.write('%-36s %10.3f ms\n' %
+                                     (name, best * 1000.0))
+    finally:
+        pygame.transform.set_smoothscale_backend(backend)
+    return {'environment': environment(), 'results': results}
+
+
+def compare(baseline, current, threshold):
+    """The (name, old, new) of benchmarks of current more than threshold
+    times slower than in baseline
+    """
+    old = dict([(r['name'], r['seconds']) for r in baseline['results']])
+    slower = []
+    for result in current['results']:
+        name = result['name']
+        if name in old and result['seconds'] > old[name] * threshold:
+            slower.append((name, old[name], result['seconds']))
+    return slower
+
+
+opt_parser = OptionParser(usage="%prog [options] [name ...]")
+opt_parser.add_option(
+    "-n", "--number", type="int", default=10,
+    help="calls of each benchmark per repeat (default 10)")
+opt_parser.add_option(
+    "-r", "--repeats", type="int", default=5,
+    help="repeats of each benchmark; the fastest counts (default 5)")
+opt_parser.add_option(
+    "-o", "--output", metavar="FILE",
+    help="write the JSON results to FILE instead of standard output")
+opt_parser.add_option(
+    "-c", "--compare", metavar="FILE",
+    help="exit with status 1 if slower than the JSON results in FILE")
+opt_parser.add_option(
+    "-t", "--threshold", type="float", default=1.1,
+    help="how many times slower counts as slower for --compare "
+         "(default 1.1)")
+opt_parser.add_option(
+    "-q", "--quiet", action="store_true",
+    help="do not print each time to standard error")
+
+
+def main(args=None):
+    options, names = opt_parser.parse_args(args)
+    pygame.init()
+    try:
+        current = run(names, options.number, options.repeats,
+                      not options.quiet)
+    finally:
+        pygame.quit()
+
+    text = json.dumps(current, indent=2, sort_keys=True)
+    if options.output:
+        f = open(options.output, 'w')
+        try:
+            f.write(text + '\n')
+        finally:
+            f.close()
+    else:
+        sys.stdout.write(text + '\n')
+
+    if options.compare:
+        f = open(options.compare)
+        try:
+            baseline = json.load(f)
+        finally:
+            f.close()
+        slower = compare(baseline, current, options.threshold)
+        for name, old, new in slower:
+            sys.stderr.write('slower: %s %.3f ms -> %.3f ms\n' %
+                             (name, old * 1000.0, new * 1000.0))
+        if slower:
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -88,6 +88,152 @@ class BlitTest( unittest.TestCase ):
         self.assertEqual(s.get_at((0,0))[0], 0 )
 
 
+    def test_SRCALPHA_wide( self ):
+        """ SRCALPHA blits wide enough for the SIMD blitters.
+        """
+        def blend(sc, dc):
+            sr, sg, sb, sa = sc
+            dr, dg, db, da = dc
+            if not da:
+                return sc
+            comp = lambda s, d: (((s - d) * sa + s) >> 8) + d
+            return (comp(sr, dr), comp(sg, dg), comp(sb, db),
+                    sa + da - (sa * da) // 255)
+
+        w, h = 19, 3
+        s = pygame.Surface((w, h), SRCALPHA, 32)
+        colors = [((x * 37) % 256, (x * 91) % 256, (x * 13) % 256,
+                   (x * 53) % 256) for x in range(w * h)]
+        for i, c in enumerate(colors):
+            s.set_at((i % w, i // w), c)
+
+        for dflags in [SRCALPHA, 0]:
+            d = pygame.Surface((w, h), dflags, 32)
+            dcolors = [((x * 7) % 256, (x * 29) % 256, (x * 61) % 256,
+                        (x * 17) % 256) for x in range(w * h)]
+            for i, c in enumerate(dcolors):
+                d.set_at((i % w, i // w), c)
+            d.blit(s, (0, 0))
+            for i in range(w * h):
+                dc = dcolors[i] if dflags else dcolors[i][:3] + (255,)
+                expected = blend(colors[i], dc)
+                if not dflags:
+                    expected = expected[:3] + (255,)
+                self.assertEqual(tuple(d.get_at((i % w, i // w))), expected)
+
+    def test_blit_backends( self ):
+        """ Each blit backend gives the same pixels as GENERIC.
+        """
+        import pygame.surface
+
+        backend = pygame.surface.get_blit_backend()
+        self.assertTrue(backend in ('GENERIC', 'SSE2', 'AVX2'))
+        self.assertRaises(ValueError, pygame.surface.set_blit_backend, 'MMX')
+
+        w, h = 23, 4
+        flags = [0, BLEND_ADD, BLEND_SUB, BLEND_MULT, BLEND_MIN, BLEND_MAX,
+                 BLEND_RGBA_ADD, BLEND_RGBA_SUB, BLEND_RGBA_MULT,
+                 BLEND_RGBA_MIN, BLEND_RGBA_MAX]
+
+        def make(sflags, seed):
+            surf = pygame.Surface((w, h), sflags, 32)
+            for i in range(w * h):
+                c = [(i * seed * k + k * 31) % 256 for k in (3, 5, 7, 11)]
+                surf.set_at((i % w, i // w), c)
+            return surf
+
+        def run(type):
+            pygame.surface.set_blit_backend(type)
+            results = []
+            for sflags in (0, SRCALPHA):
+                for dflags in (0, SRCALPHA):
+                    for flag in flags:
+                        s, d = make(sflags, 3), make(dflags, 7)
+                        d.blit(s, (1, 1), None, flag)
+                        if flag:
+                            d.fill((40, 120, 200, 90), None, flag)
+                        else:
+                            d.fill((40, 120, 200, 90), (3, 1, 13, 2))
+                        results.append([tuple(d.get_at((x, y)))
+                                        for x in range(w) for y in range(h)])
+            return results
+
+        try:
+            expected = run('GENERIC')
+            for type in ('SSE2', 'AVX2'):
+                try:
+                    pygame.surface.set_blit_backend(type)
+                except ValueError:
+                    continue
+                self.assertEqual(run(type), expected)
+        finally:
+            pygame.surface.set_blit_backend(backend)
+
+    def test_blit_threads( self ):
+        """ A threaded blit gives the same pixels as an unthreaded one.
+        """
+        import pygame.surface
+
+        threads = pygame.surface.get_blit_threads()
+        self.assertEqual(threads, 0)
+        self.assertRaises(ValueError, pygame.surface.set_blit_threads, -1)
+
+        w, h = 300, 260
+        src = pygame.Surface((w, h), SRCALPHA, 32)
+        for y in range(0, h, 3):
+            src.fill(((y * 7) % 256, (y * 3) % 256, y % 256, (y * 5) % 256),
+                     (0, y, w, 3))
+
+        def run(flags):
+            results = []
+            for flag in (0, BLEND_ADD, BLEND_RGBA_MULT):
+                dst = pygame.Surface((w + 5, h + 9), SRCALPHA, 32)
+                dst.fill((90, 60, 30, 120))
+                dst.blit(src, (2, 7), None, flag | flags)
+                results.append(pygame.image.tostring(dst, 'RGBA'))
+            return results
+
+        try:
+            expected = run(0)
+            self.assertEqual(run(BLIT_THREADED), expected)
+            pygame.surface.set_blit_threads(3)
+            self.assertEqual(pygame.surface.get_blit_threads(), 3)
+            self.assertEqual(run(0), expected)
+        finally:
+            pygame.surface.set_blit_threads(threads)
+
+    def test_colorkey_runs( self ):
+        """ A colorkey blit onto per-pixel alpha follows changes to the
+            source pixels and colour key.
+        """
+        src = pygame.Surface((64, 8), 0, 32)
+        src.fill((255, 0, 255))
+        src.fill((10, 200, 30), (16, 0, 16, 8))
+        src.set_colorkey((255, 0, 255))
+
+        def blit():
+            dst = pygame.Surface((64, 8), SRCALPHA, 32)
+            dst.fill((0, 0, 100, 255), (0, 0, 32, 8))
+            dst.blit(src, (0, 0))
+            return dst
+
+        dst = blit()
+        self.assertEqual(dst.get_at((8, 4)), (0, 0, 100, 255))
+        self.assertEqual(dst.get_at((20, 4)), (10, 200, 30, 255))
+        self.assertEqual(dst.get_at((48, 4)), (255, 0, 255, 0))
+        self.assertEqual(blit().get_at((20, 4)), (10, 200, 30, 255))
+
+        src.fill((50, 60, 70), (0, 0, 8, 8))
+        src.set_at((40, 4), (80, 90, 100))
+        dst = blit()
+        self.assertEqual(dst.get_at((4, 4)), (50, 60, 70, 255))
+        self.assertEqual(dst.get_at((40, 4)), (80, 90, 100, 255))
+
+        src.set_colorkey((10, 200, 30))
+        dst = blit()
+        self.assertEqual(dst.get_at((12, 4)), (255, 0, 255, 255))
+        self.assertEqual(dst.get_at((20, 4)), (0, 0, 100, 255))
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -963,6 +963,234 @@ class ColorTypeTest (unittest.TestCase):
     except ImportError:
         del test_arraystruct
 
+    def test_freelist(self):
+        from pygame import color
+        old_size = color.get_freelist_stats()[0]
+        try:
+            color.set_freelist_size(8)
+            colors = [pygame.Color(i, i, i, i) for i in range(20)]
+            colors[0].set_length(2)
+            del colors
+            size, count, hits, misses = color.get_freelist_stats()
+            self.assertEqual((size, count), (8, 8))
+            c = pygame.Color(1, 2, 3)
+            self.assertEqual(len(c), 4)
+            self.assertEqual(c, pygame.Color(1, 2, 3, 255))
+            self.assertTrue(color.get_freelist_stats()[2] > hits)
+            color.set_freelist_size(0)
+            self.assertEqual(color.get_freelist_stats()[:2], (0, 0))
+        finally:
+            color.set_freelist_size(old_size)
+
+    def test_colorspace_buffers(self):
+        from pygame import color
+
+        def camera_hsv(r, g, b):
+            # The HSV of the camera module, in C integer arithmetic
+            high = max(r, g, b)
+            delta = high - min(r, g, b)
+            if not delta:
+                return 0, 0, high
+            div = lambda n: int(float(n) / delta)
+            if r == high:
+                h = div(43 * (g - b))
+            elif g == high:
+                h = 85 + div(43 * (b - r))
+            else:
+                h = 170 + div(43 * (r - g))
+            return h & 255, 255 * delta // high, high
+
+        pixels = [(r, g, b) for r in range(0, 256, 17)
+                            for g in range(0, 256, 15)
+                            for b in range(0, 256, 51)]
+        rgb = bytearray()
+        rgba = bytearray()
+        for i, p in enumerate(pixels):
+            rgb.extend(p)
+            rgba.extend(p + (i & 255,))
+
+        hsv = bytearray(rgb)
+        color.rgb_to_hsv(hsv)
+        for i, p in enumerate(pixels):
+            self.assertEqual(tuple(hsv[i * 3:i * 3 + 3]), camera_hsv(*p))
+        hsva = bytearray(rgba)
+        color.rgb_to_hsv(hsva, 4)
+        for i in range(len(pixels)):
+            self.assertEqual(hsva[i * 4:i * 4 + 3], hsv[i * 3:i * 3 + 3])
+            self.assertEqual(hsva[i * 4 + 3], i & 255)
+
+        color.hsv_to_rgb(hsv)
+        for a, b in zip(hsv, rgb):
+            self.assertTrue(abs(a - b) <= 10)
+        color.hsv_to_rgb(hsva, channels=4)
+        for i in range(len(pixels)):
+            self.assertEqual(hsva[i * 4:i * 4 + 3], hsv[i * 3:i * 3 + 3])
+
+        for gamma in [0.5, 1.0, 2.2]:
+            corrected = bytearray(rgba)
+            color.correct_gamma(corrected, gamma, 4)
+            for i, p in enumerate(pixels):
+                expected = pygame.Color(*p).correct_gamma(gamma)
+                self.assertEqual(tuple(corrected[i * 4:i * 4 + 3]),
+                                 tuple(expected)[:3])
+                self.assertEqual(corrected[i * 4 + 3], i & 255)
+
+        self.assertRaises(ValueError, color.rgb_to_hsv, bytearray(4))
+        self.assertRaises(ValueError, color.hsv_to_rgb, bytearray(6), 2)
+        self.assertRaises(ValueError, color.correct_gamma, bytearray(5),
+                          2.0, 4)
+        self.assertRaises((TypeError, BufferError), color.rgb_to_hsv,
+                          bytes(bytearray(3)))
+
+    def test_colorspace_buffers__simd_backend(self):
+        from pygame import color
+
+        backend = pygame.get_simd_backend('color')
+        rgb = bytearray(range(256)) * 3
+        simd = bytearray(rgb)
+        color.rgb_to_hsv(simd)
+        try:
+            pygame.set_simd_backend('color', 'GENERIC')
+            self.assertEqual(pygame.get_simd_backend('color'), 'GENERIC')
+            generic = bytearray(rgb)
+            color.rgb_to_hsv(generic)
+            self.assertEqual(generic, simd)
+            self.assertRaises(ValueError, pygame.set_simd_backend,
+                              'color', 'no such backend')
+        finally:
+            pygame.set_simd_backend('color', backend)
+        self.assertEqual(pygame.get_simd_backend('color'), backend)
+
+    def test_correct_gamma__repeated(self):
+        # The same gamma twice in a row switches to a table
+        c = pygame.Color(10, 100, 200, 50)
+        results = [c.correct_gamma(2.2) for i in range(3)]
+        results.append(c.correct_gamma(0.5))
+        self.assertEqual(results[:3], [pygame.Color(0, 33, 149, 7)] * 3)
+        self.assertEqual(results[3], pygame.Color(50, 160, 226, 113))
+
+    def test_hash(self):
+        # Colors change in place, so they can't be keys
+        c = pygame.Color(10, 20, 30, 40)
+        self.assertRaises(TypeError, hash, c)
+        self.assertRaises(TypeError, set, [c])
+        palette = {c.to_int(): 1, tuple(pygame.Color(0, 255, 0)): 2}
+        self.assertEqual(palette[pygame.Color(10, 20, 30, 40).to_int()], 1)
+        self.assertEqual(palette[tuple(pygame.Color('green'))], 2)
+
+    def test_inplace_ops(self):
+        c = pygame.Color(100, 150, 200, 250)
+        c_id = id(c)
+        c += pygame.Color(100, 100, 100, 1)
+        self.assertEqual(c, (200, 250, 255, 251))
+        c -= pygame.Color(210, 50, 5, 1)
+        self.assertEqual(c, (0, 200, 250, 250))
+        c *= pygame.Color(3, 1, 2, 0)
+        self.assertEqual(c, (0, 200, 255, 0))
+        c //= pygame.Color(1, 3, 0, 1)
+        self.assertEqual(c, (0, 66, 0, 0))
+        c %= pygame.Color(1, 7, 1, 0)
+        self.assertEqual(c, (0, 3, 0, 0))
+        self.assertEqual(id(c), c_id)
+
+        # The result of a binary operator is unchanged.
+        c1 = pygame.Color(1, 2, 3, 4)
+        c2 = c1
+        c2 += pygame.Color(1, 1, 1, 1)
+        self.assertTrue(c2 is c1)
+        self.assertEqual(c1, (2, 3, 4, 5))
+
+    def test_from_int__to_int(self):
+        c = pygame.Color.from_int(0x01020304)
+        self.assertEqual(c, (1, 2, 3, 4))
+        self.assertEqual(len(c), 4)
+        self.assertEqual(c.to_int(), 0x01020304)
+        self.assertEqual(c.to_int(), int(c))
+        self.assertEqual(pygame.Color.from_int(long_(0xffffffff)),
+                         (255, 255, 255, 255))
+        self.assertEqual(pygame.Color(9, 8, 7, 6).to_int(),
+                         int(pygame.Color(9, 8, 7, 6)))
+        self.assertRaises(ValueError, pygame.Color.from_int, -1)
+        self.assertRaises(ValueError, pygame.Color.from_int, 0x100000000)
+        self.assertRaises(TypeError, pygame.Color.from_int, '0x01020304')
+        self.assertRaises(TypeError, pygame.Color.from_int, (1, 2, 3))
+
+
+class ColorArrayTest (unittest.TestCase):
+
+    def test_init(self):
+        a = pygame.ColorArray(3)
+        self.assertEqual(len(a), 3)
+        self.assertEqual(list(a), [(0, 0, 0, 255)] * 3)
+        self.assertEqual(len(pygame.ColorArray(0)), 0)
+        a = pygame.ColorArray([pygame.Color(1, 2, 3, 4), (5, 6, 7),
+                               (8, 9, 10, 11)])
+        self.assertEqual(list(a), [(1, 2, 3, 4), (5, 6, 7, 255),
+                                   (8, 9, 10, 11)])
+        self.assertTrue(isinstance(a[0], pygame.Color))
+        self.assertRaises(ValueError, pygame.ColorArray, -1)
+        self.assertRaises(ValueError, pygame.ColorArray, [(1, 2)])
+        self.assertRaises(TypeError, pygame.ColorArray, None)
+
+    def test_items(self):
+        a = pygame.ColorArray(2)
+        a[0] = pygame.Color(1, 2, 3, 4)
+        a[-1] = (5, 6, 7, 8)
+        self.assertEqual(a[0], (1, 2, 3, 4))
+        self.assertEqual(a[1], (5, 6, 7, 8))
+        self.assertEqual(a[-2], (1, 2, 3, 4))
+        self.assertRaises(IndexError, lambda: a[2])
+        self.assertRaises(ValueError, a.__setitem__, 0, (1, 2))
+
+    def test_arithmetic(self):
+        colors = [(1, 2, 3, 4), (100, 150, 200, 250), (255, 0, 64, 8)]
+        other = [(5, 5, 5, 5), (200, 100, 0, 3), (16, 16, 16, 16)]
+        a = pygame.ColorArray(colors)
+        b = pygame.ColorArray(other)
+        ops = (operator.add, operator.sub, operator.mul, operator.floordiv,
+               operator.mod)
+        for op in ops:
+            expected = [op(pygame.Color(*c), pygame.Color(*o))
+                        for c, o in zip(colors, other)]
+            self.assertEqual(list(op(a, b)), expected)
+            c = pygame.Color(3, 0, 7, 255)
+            self.assertEqual(list(op(a, c)),
+                             [op(pygame.Color(*x), c) for x in colors])
+            self.assertEqual(list(op(c, a)),
+                             [op(c, pygame.Color(*x)) for x in colors])
+            self.assertEqual(list(op(a, tuple(c))), list(op(a, c)))
+        self.assertEqual(list(a), colors)
+        self.assertRaises(ValueError, operator.add, a, pygame.ColorArray(2))
+        self.assertRaises(TypeError, operator.add, a, 1)
+
+    def test_inplace_arithmetic(self):
+        a = pygame.ColorArray([(1, 2, 3, 4), (250, 100, 50, 0)])
+        a_id = id(a)
+        a += pygame.Color(10, 10, 10, 10)
+        self.assertEqual(list(a), [(11, 12, 13, 14), (255, 110, 60, 10)])
+        a -= pygame.ColorArray([(1, 1, 1, 1), (255, 0, 0, 0)])
+        self.assertEqual(list(a), [(10, 11, 12, 13), (0, 110, 60, 10)])
+        a *= a
+        self.assertEqual(list(a), [(100, 121, 144, 169), (0, 255, 255, 100)])
+        a //= (10, 11, 0, 13)
+        self.assertEqual(list(a), [(10, 11, 0, 13), (0, 23, 0, 7)])
+        self.assertEqual(id(a), a_id)
+
+    if pygame.HAVE_NEWBUF:
+        def test_newbuf(self):
+            a = pygame.ColorArray([(1, 2, 3, 4), (5, 6, 7, 8)])
+            m = memoryview(a)
+            self.assertEqual(m.shape, (2, 4))
+            self.assertEqual(m.strides, (4, 1))
+            self.assertEqual(m.format, 'B')
+            self.assertFalse(m.readonly)
+            self.assertEqual(m.tolist(), [[1, 2, 3, 4], [5, 6, 7, 8]])
+            m = None
+            b = bytearray([1, 2, 3, 4, 5, 6, 7, 8])
+            pygame.color.correct_gamma(a, 0.5, 4)
+            pygame.color.correct_gamma(b, 0.5, 4)
+            self.assertEqual(list(a), [tuple(b[:4]), tuple(b[4:])])
+
 
 class SubclassTest (unittest.TestCase):
     class MyColor (pygame.Color):
@@ -0,0 +1,98 @@
+#################################### IMPORTS ###################################
+
+if __name__ == '__main__':
+    import sys
+    import os
+    pkg_dir = os.path.split(os.path.abspath(__file__))[0]
+    parent_dir, pkg_name = os.path.split(pkg_dir)
+    is_pygame_pkg = (pkg_name == 'tests' and
+                     os.path.split(parent_dir)[1] == 'pygame')
+    if not is_pygame_pkg:
+        sys.path.insert(0, parent_dir)
+else:
+    is_pygame_pkg = __name__.startswith('pygame.tests.')
+
+import unittest
+import pygame
+from pygame.commandbuffer import CommandBuffer, _cull, _merge
+
+################################################################################
+
+class CommandBufferTest(unittest.TestCase):
+    def test_execute(self):
+        surf = pygame.Surface((20, 20), 0, 32)
+        red = pygame.Surface((5, 5), 0, 32)
+        red.fill((255, 0, 0))
+        buf = CommandBuffer(surf)
+        buf.fill((0, 0, 255))
+        self.assertEqual(buf.blit(red, (2, 3)), pygame.Rect(2, 3, 5, 5))
+        buf.fill((0, 255, 0), (10, 10, 4, 4))
+        buf.draw('line', (255, 255, 255), (0, 19), (19, 19))
+        self.assertEqual(len(buf), 4)
+        self.assertEqual(surf.get_at((0, 0)), (0, 0, 0, 255))
+
+        for i in range(2):
+            surf.fill((0, 0, 0))
+            self.assertEqual(buf.execute(), surf.get_rect())
+            self.assertEqual(surf.get_at((0, 0)), (0, 0, 255, 255))
+            self.assertEqual(surf.get_at((2, 3)), (255, 0, 0, 255))
+            self.assertEqual(surf.get_at((11, 11)), (0, 255, 0, 255))
+            self.assertEqual(surf.get_at((5, 19)), (255, 255, 255, 255))
+
+        buf.clear()
+        self.assertEqual(len(buf), 0)
+        self.assertEqual(buf.execute(), pygame.Rect(0, 0, 0, 0))
+
+    def test_cull(self):
+        surf = pygame.Surface((20, 20), 0, 32)
+        small = pygame.Surface((4, 4), 0, 32)
+        big = pygame.Surface((10, 10), 0, 32)
+        buf = CommandBuffer(surf)
+        buf.blit(small, (2, 2))
+        buf.blit(small, (2, 2), None, pygame.BLEND_ADD)
+        buf.blit(big, (0, 0))
+        buf.blit(small, (8, 8))
+        self.assertEqual([op[1] for op in _cull(buf._ops)],
+                         [pygame.Rect(0, 0, 10, 10), pygame.Rect(8, 8, 4, 4)])
+
+        # not opaque
+        small.set_colorkey((0, 0, 0))
+        buf.clear()
+        buf.blit(big, (0, 0))
+        buf.blit(small, (2, 2))
+        self.assertEqual(len(_cull(buf._ops)), 2)
+
+        buf.fill((0, 0, 0), None, pygame.BLEND_ADD)
+        buf.fill((0, 0, 0))
+        self.assertEqual(len(_cull(buf._ops)), 1)
+
+    def test_merge(self):
+        surf = pygame.Surface((20, 20), 0, 32)
+        sheet = pygame.Surface((16, 8), 0, 32)
+        sheet.fill((1, 2, 3), (0, 0, 8, 8))
+        sheet.fill((4, 5, 6), (8, 0, 8, 8))
+        buf = CommandBuffer(surf)
+        buf.blit(sheet, (2, 2), (0, 0, 8, 8))
+        buf.blit(sheet, (10, 2), (8, 0, 8, 8))
+        buf.blit(sheet, (0, 12), (0, 0, 8, 8))
+        ops = _merge(buf._ops)
+        self.assertEqual(len(ops), 2)
+        self.assertEqual(ops[0][1], pygame.Rect(2, 2, 16, 8))
+        self.assertEqual(ops[0][2][1], pygame.Rect(0, 0, 16, 8))
+
+        buf.execute()
+        self.assertEqual(surf.get_at((3, 3)), (1, 2, 3, 255))
+        self.assertEqual(surf.get_at((11, 3)), (4, 5, 6, 255))
+        self.assertEqual(surf.get_at((1, 13)), (1, 2, 3, 255))
+
+    def test_area_clipped(self):
+        surf = pygame.Surface((20, 20), 0, 32)
+        source = pygame.Surface((4, 4), 0, 32)
+        buf = CommandBuffer(surf)
+        self.assertEqual(buf.blit(source, (5, 5), (-2, -1, 8, 8)),
+                         pygame.Rect(7, 6, 4, 4))
+
+################################################################################
+
+if __name__ == '__main__':
+    unittest.main()
@@ -58,6 +58,135 @@ class DisplayModuleTest( unittest.TestCase ):
 
             """
 
+    def test_update_merge( self ):
+        pygame.init()
+        try:
+            screen = pygame.display.set_mode((100,100))
+            self.assertEqual(pygame.display.get_update_merge(), None)
+            self.assertRaises(ValueError, pygame.display.set_update_merge, 2)
+
+            rects = [pygame.Rect(0,0,10,10), pygame.Rect(0,0,10,10),
+                     pygame.Rect(10,0,10,10), pygame.Rect(50,50,5,5),
+                     pygame.Rect(90,90,20,20)]
+            pygame.display.get_update_count(True)
+            pygame.display.update(rects)
+            self.assertEqual(pygame.display.get_update_count(True),
+                             (5, 100 + 100 + 100 + 25 + 100))
+
+            pygame.display.set_update_merge(0.0)
+            self.assertEqual(pygame.display.get_update_merge(), 0.0)
+            pygame.display.update(rects)
+            self.assertEqual(pygame.display.get_update_count(True),
+                             (3, 200 + 25 + 100))
+
+            pygame.display.set_update_merge(1.0)
+            pygame.display.update(rects)
+            self.assertEqual(pygame.display.get_update_count(), (1, 10000))
+        finally:
+            pygame.display.set_update_merge(None)
+            pygame.quit()
+
+    def test_present( self ):
+        pygame.init()
+        try:
+            screen = pygame.display.set_mode((100,100))
+            self.assertRaises(pygame.error, pygame.display.present)
+            self.assertRaises(ValueError, pygame.display.set_managed, True, 2)
+            pygame.display.set_managed(threshold=0.5)
+            self.assertTrue(pygame.display.get_managed())
+
+            pygame.display.get_update_count(True)
+            pygame.display.present()
+            self.assertEqual(pygame.display.get_update_count(True), (0, 0))
+            screen.fill((255,0,0), (0,0,10,10))
+            screen.fill((0,255,0), (50,50,10,20))
+            pygame.display.present()
+            self.assertEqual(pygame.display.get_update_count(True),
+                             (2, 100 + 200))
+            # Most of the display goes in one
+            screen.fill((0,0,255), (0,0,90,90))
+            pygame.display.present()
+            self.assertEqual(pygame.display.get_update_count(True),
+                             (1, 10000))
+
+            pygame.display.set_mode((50,50))
+            self.assertFalse(pygame.display.get_managed())
+        finally:
+            pygame.quit()
+
+    def test_set_glblit(self):
+        pygame.init()
+        try:
+            pygame.display.set_mode((100,100))
+            self.assertTrue(pygame.display.get_glblit() is None)
+            self.assertRaises(pygame.error, pygame.display.set_glblit)
+            try:
+                screen = pygame.display.set_mode((100,100), pygame.GLBLIT)
+            except pygame.error:
+                # No OpenGL with this video driver
+                return
+            self.assertEqual(screen.get_bitsize(), 32)
+            self.assertFalse(screen.get_flags() & pygame.OPENGL)
+            self.assertEqual(pygame.display.get_glblit()[:2],
+                             ((100, 100), False))
+            screen = pygame.display.set_glblit((40, 30), integer=True)
+            self.assertEqual(screen.get_size(), (40, 30))
+            self.assertTrue(screen is pygame.display.get_surface())
+            screen.fill((255,0,0), (0,0,10,10))
+            pygame.display.update((0,0,10,10))
+            pygame.display.flip()
+            self.assertEqual(pygame.display.get_glblit()[:2],
+                             ((40, 30), True))
+        finally:
+            pygame.quit()
+
+    def test_async_present(self):
+        pygame.init()
+        try:
+            self.assertRaises(pygame.error, pygame.display.set_async_present)
+            screen = pygame.display.set_mode((100,100))
+            screen.fill((255,0,0))
+            self.assertFalse(pygame.display.get_async_present())
+            self.assertTrue(pygame.display.wait_present())
+            pygame.display.set_async_present()
+            self.assertTrue(pygame.display.get_async_present())
+            self.assertRaises(pygame.error, pygame.display.set_managed)
+            # Both buffers start as the display was
+            self.assertEqual(screen.get_at((50,50)), (255,0,0,255))
+
+            screen.fill((0,255,0))
+            pygame.display.flip()
+            self.assertTrue(screen is pygame.display.get_surface())
+            self.assertEqual(screen.get_at((50,50)), (255,0,0,255))
+            self.assertTrue(pygame.display.wait_present())
+
+            # Updated areas are carried over to the next buffer
+            screen.fill((0,0,255), (0,0,10,10))
+            pygame.display.update([(0,0,10,10)])
+            self.assertEqual(screen.get_at((5,5)), (0,0,255,255))
+            pygame.display.update()
+            pygame.display.wait_present(False)
+
+            # Subsurfaces would be left drawing into one buffer
+            sub = screen.subsurface((0,0,10,10))
+            self.assertRaises(pygame.error, pygame.display.flip)
+            del sub
+            pygame.display.flip()
+
+            screen.fill((255,255,0))
+            pygame.display.set_async_present(False)
+            self.assertFalse(pygame.display.get_async_present())
+            self.assertEqual(screen.get_at((50,50)), (255,255,0,255))
+
+            sub = screen.subsurface((0,0,10,10))
+            self.assertRaises(pygame.error, pygame.display.set_async_present)
+            del sub
+            pygame.display.set_async_present()
+            pygame.display.set_mode((50,50))
+            self.assertFalse(pygame.display.get_async_present())
+        finally:
+            pygame.quit()
+
     def todo_test_Info(self):
 
         # __doc__ (as of 2008-08-02) for pygame.display.Info:
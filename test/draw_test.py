@@ -173,6 +173,89 @@ class DrawModuleTest(unittest.TestCase):
 
         self.fail() 
 
+    def test_aawidelines__joints(self):
+        # A translucent color is blended once where the lines overlap
+        self.surf.fill((0, 0, 0, 255))
+        color = (255, 0, 0, 128)
+        points = [(20, 20), (100, 20), (100, 100)]
+        drawn = draw.aawidelines(self.surf, color, False, points, 10)
+
+        for pt in points:
+            self.assert_(drawn.collidepoint(pt))
+        mid = self.surf.get_at((60, 20))
+        self.assertNotEqual(mid, (0, 0, 0, 255))
+        self.assertEqual(self.surf.get_at((100, 20)), mid)
+        self.assertEqual(self.surf.get_at((100, 60)), mid)
+
+        # The ends are square, unless round is asked for
+        self.assertEqual(self.surf.get_at((17, 20)), (0, 0, 0, 255))
+        self.assertEqual(self.surf.get_at((108, 20)), (0, 0, 0, 255))
+        draw.aawidelines(self.surf, color, False, points, 10, True)
+        self.assertNotEqual(self.surf.get_at((17, 20)), (0, 0, 0, 255))
+
+    def test_aacapsule(self):
+        # With the ends the same, a capsule is a disc
+        drawn = draw.aacapsule(self.surf, self.color, (50, 50), (50, 50), 20)
+        self.assert_(drawn.collidepoint((40, 40)))
+        self.assert_(drawn.collidepoint((60, 60)))
+        for pt in ((50, 50), (56, 50), (50, 43)):
+            self.assertEqual(self.surf.get_at(pt), self.color)
+        for pt in ((65, 50), (50, 35), (60, 60)):
+            self.assertEqual(self.surf.get_at(pt), (0, 0, 0, 0))
+
+        # Nothing is drawn outside the clip rect
+        self.surf.set_clip((0, 0, 100, 100))
+        draw.aacapsule(self.surf, self.color, (90, 150), (250, 150), 30)
+        self.surf.set_clip(None)
+        self.assertEqual(self.surf.get_at((200, 150)), (0, 0, 0, 0))
+
+    def test_batch(self):
+        commands = [("line", self.color, (10, 10), (50, 10)),
+                    ("rect", self.color, (60, 60, 20, 10), 0),
+                    ("circle", self.color, (100, 30), 5)]
+        drawn = draw.batch(self.surf, commands)
+
+        # One rect, the union of what each command drew
+        self.assertEqual(drawn, pygame.Rect(10, 10, 95, 60))
+        for pt in ((10, 10), (50, 10), (60, 60), (79, 69), (100, 30)):
+            self.assertEqual(self.surf.get_at(pt), self.color)
+        self.assertFalse(self.surf.get_locked())
+
+        self.assertEqual(draw.batch(self.surf, []), pygame.Rect(0, 0, 0, 0))
+        self.assertRaises(ValueError, draw.batch, self.surf,
+                          [("line", self.color, (0, 0), (1, 1)),
+                           ("no such shape", self.color)])
+        self.assertRaises(TypeError, draw.batch, self.surf, [(self.color,)])
+        self.assertFalse(self.surf.get_locked())
+
+    def test_batch__threads(self):
+        # Drawn in tiles on threads, a batch gives the same pixels
+        commands = []
+        for i in range(40):
+            color = (i * 6, 255 - i * 6, i * 3, 100 + i * 3)
+            x, y = (i * 37) % 300, (i * 53) % 180
+            commands.extend([
+                ("line", color, (x, y), (300 - x, 200 - y), 1 + i % 4),
+                ("aaline", color, (x + 0.5, y), (y, x + 0.25)),
+                ("circle", color, (x, y), 5 + i % 30, i % 2),
+                ("polygon", color, [(x, y), (x + 70, y + 10), (x + 20, y + 60)]),
+                ("aacapsule", color, (x, y), (y, x), 1 + i % 9),
+                ("arc", color, (x, y, 80, 50), 0, 4, 2),
+            ])
+        expected = pygame.Surface(self.surf_size, pygame.SRCALPHA)
+        draw.batch(expected, commands)
+
+        draw.set_batch_threads(4)
+        try:
+            self.assertEqual(draw.get_batch_threads(), 4)
+            drawn = draw.batch(self.surf, commands)
+        finally:
+            draw.set_batch_threads(0)
+        self.assertEqual(draw.get_batch_threads(), 0)
+        self.assertEqual(pygame.image.tostring(self.surf, "RGBA"),
+                         pygame.image.tostring(expected, "RGBA"))
+        self.assertRaises(ValueError, draw.set_batch_threads, -1)
+
     def todo_test_arc(self):
 
         # __doc__ (as of 2008-08-02) for pygame.draw.arc:
@@ -254,6 +337,34 @@ class DrawModuleTest(unittest.TestCase):
 
         self.fail() 
 
+    def test_polygon__fill(self):
+        # A U shape: the spans of each scanline are between pairs of the
+        # edges crossing it, ends included.
+        points = [(10, 10), (20, 10), (20, 20), (30, 20),
+                  (30, 10), (40, 10), (40, 30), (10, 30)]
+        draw.polygon(self.surf, self.color, points)
+
+        for y in range(10, 31):
+            for x in range(10, 41):
+                in_notch = 20 < x < 30 and y < 20
+                self.assertEqual(self.surf.get_at((x, y)) == self.color,
+                                 not in_notch, (x, y))
+        for pt in test_utils.rect_outer_bounds(pygame.Rect(10, 10, 31, 21)):
+            self.assertNotEqual(self.surf.get_at(pt), self.color)
+
+    def test_polygon__fill_clipped(self):
+        # A shape far bigger than the clip rect fills just the clip rect
+        clip = pygame.Rect(50, 40, 100, 80)
+        self.surf.set_clip(clip)
+        draw.polygon(self.surf, self.color,
+                     [(-5000, -4000), (6000, -3000), (5000, 7000)])
+        self.surf.set_clip(None)
+
+        for pt in ((50, 40), (149, 40), (50, 119), (149, 119), (100, 80)):
+            self.assertEqual(self.surf.get_at(pt), self.color)
+        for pt in test_utils.rect_outer_bounds(clip):
+            self.assertNotEqual(self.surf.get_at(pt), self.color)
+
 ################################################################################
 
 if __name__ == '__main__':
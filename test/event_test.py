@@ -63,6 +63,28 @@ class EventTypeTest(unittest.TestCase):
         self.assert_('other_attr' in d)
         self.assert_('new_attr' in d)
 
+    def test_freelist(self):
+        event = pygame.event
+        old_size = event.get_freelist_stats()[0]
+        try:
+            event.set_freelist_size(8)
+            events = [event.Event(pygame.USEREVENT, n=i) for i in range(20)]
+            del events
+            size, count, hits, misses = event.get_freelist_stats()
+            self.assertEqual((size, count), (8, 8))
+            # Events reused keep nothing they had before
+            for i in range(20):
+                e = event.Event(pygame.USEREVENT + 1)
+                self.assertEqual(e.type, pygame.USEREVENT + 1)
+                self.assertEqual(e.dict, {})
+                self.assertFalse(hasattr(e, 'n'))
+            self.assertTrue(event.get_freelist_stats()[2] > hits)
+            event.set_freelist_size(0)
+            self.assertEqual(event.get_freelist_stats()[:2], (0, 0))
+            self.assertRaises(ValueError, event.set_freelist_size, -1)
+        finally:
+            event.set_freelist_size(old_size)
+
     def test_as_str(self):
         # Bug reported on Pygame mailing list July 24, 2011:
         # For Python 3.x str(event) to raises an UnicodeEncodeError when
@@ -137,6 +159,29 @@ class EventModuleTest(unittest.TestCase):
         self.assertEquals(e.type, pygame.USEREVENT)
         self.assertEquals(e.a, "a" * 1024)
 
+    def test_post_many(self):
+        events = [pygame.event.Event(pygame.USEREVENT, n=i) for i in range(20)]
+        events.insert(5, pygame.event.Event(2))
+        pygame.event.set_blocked(2)
+        try:
+            self.assertEquals(pygame.event.post_many(events), 20)
+        finally:
+            pygame.event.set_allowed(2)
+        got = [e for e in pygame.event.get() if e.type == pygame.USEREVENT]
+        self.assertEquals([e.n for e in got], list(range(20)),
+                          race_condition_notification)
+
+        # The queue is full before these are all added
+        events = [pygame.event.Event(pygame.USEREVENT, n=i) for i in range(300)]
+        count = pygame.event.post_many(events)
+        self.assert_(0 < count < 300)
+        got = [e for e in pygame.event.get() if e.type == pygame.USEREVENT]
+        self.assertEquals([e.n for e in got], list(range(count)))
+
+        self.assertEquals(pygame.event.post_many([]), 0)
+        self.assertRaises(TypeError, pygame.event.post_many, [1])
+        self.assertRaises(TypeError, pygame.event.post_many, 1)
+
 
 
     def test_get(self):
@@ -153,6 +198,54 @@ class EventModuleTest(unittest.TestCase):
 
         self.assert_ ( len(pygame.event.get()) >= 10 )
 
+    def test_get_buffer(self):
+        import struct
+        size = struct.calcsize(pygame.event.RECORD_FORMAT)
+        self.assertEqual(size, 40)
+        pygame.event.clear()
+        for i in range(3):
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT + i, a=i))
+
+        out = bytearray(2 * size + 7)
+        self.assertEqual(pygame.event.get_buffer(out), 2,
+                         race_condition_notification)
+        types = [struct.unpack_from(pygame.event.RECORD_FORMAT, out, i)[0]
+                 for i in (0, size)]
+        self.assertEqual(types, [pygame.USEREVENT, pygame.USEREVENT + 1])
+
+        records = pygame.event.get_buffer()
+        self.assertEqual(len(records), size, race_condition_notification)
+        fields = struct.unpack(pygame.event.RECORD_FORMAT, records)
+        self.assertEqual(fields[0], pygame.USEREVENT + 2)
+        self.assertEqual(fields[2:], (0,) * 8)
+        self.assertEqual(len(pygame.event.get_buffer()), 0)
+        self.assertEqual(pygame.event.get_buffer(bytearray(size - 1)), 0)
+        self.assertRaises((TypeError, ValueError, BufferError),
+                          pygame.event.get_buffer, as_unicode('abc'))
+
+    def test_set_coalesce(self):
+        event = pygame.event
+        types = (pygame.MOUSEMOTION, pygame.JOYAXISMOTION, pygame.VIDEORESIZE)
+        try:
+            event.set_coalesce(types)
+            self.assertEqual(event.get_coalesce_stats(),
+                             dict.fromkeys(types, 0))
+            self.assertRaises(ValueError, event.set_coalesce,
+                              [pygame.KEYDOWN])
+            self.assertRaises(TypeError, event.set_coalesce, 1)
+
+            # Events posted from Python keep their attributes, so stay
+            event.clear()
+            for i in range(3):
+                event.post(event.Event(pygame.MOUSEMOTION, rel=(i, 0)))
+            got = event.get()
+            self.assertEqual(len(got), 3, race_condition_notification)
+            self.assertEqual([e.rel for e in got], [(0, 0), (1, 0), (2, 0)])
+            self.assertEqual(event.get_coalesce_stats()[pygame.MOUSEMOTION],
+                             0)
+        finally:
+            event.set_coalesce(None)
+
     def test_clear(self):
 
         # __doc__ (as of 2008-06-25) for pygame.event.clear:
@@ -108,6 +108,26 @@ class FasteventModuleTest(unittest.TestCase):
         else:
             self.fail()
     
+    def test_post__threads(self):
+        import threading
+        count = 2000
+        def post(n):
+            for i in range(count):
+                fastevent.post(event.Event(pygame.USEREVENT, n=n, i=i))
+        threads = [threading.Thread(target=post, args=(n,)) for n in range(4)]
+        for t in threads:
+            t.start()
+        seen = [0] * len(threads)
+        while sum(seen) < count * len(threads):
+            e = fastevent.wait()
+            if e.type == pygame.USEREVENT:
+                # Each thread's events arrive in the order it posted them
+                self.assertEqual(e.i, seen[e.n])
+                seen[e.n] += 1
+        for t in threads:
+            t.join()
+        self.assertEqual(seen, [count] * len(threads))
+
     def todo_test_pump(self):
     
         # __doc__ (as of 2008-08-02) for pygame.fastevent.pump:
@@ -419,6 +419,39 @@ class FontTypeTest( unittest.TestCase ):
         f.set_underline(False)
         self.failIf(f.get_underline())
 
+    def test_render_cache(self):
+        f = pygame_font.Font(None, 20)
+        self.assertEqual(f.get_render_cache_stats(), (0, 0, 0, 0))
+        text = as_unicode("Score")
+        s1 = f.render(text, True, (255, 255, 255))
+        self.failIf(f.render(text, True, (255, 255, 255)) is s1)
+
+        f.set_render_cache(2)
+        s1 = f.render(text, True, (255, 255, 255))
+        self.failUnless(f.render(text, True, (255, 255, 255)) is s1)
+        self.assertEqual(f.get_render_cache_stats(), (2, 1, 1, 1))
+        self.failIf(f.render(text, False, (255, 255, 255)) is s1)
+        self.failIf(f.render(text, True, (255, 255, 0)) is s1)
+        self.failIf(f.render(text, True, (255, 255, 255), (0, 0, 0)) is s1)
+        self.failIf(f.render(text.encode("ascii"), True,
+                             (255, 255, 255)) is s1)
+        size, count, hits, misses = f.get_render_cache_stats()
+        self.assertEqual(count, 2)
+        self.assertEqual(misses, 5)
+
+        # Styles change the rendering
+        s1 = f.render(text, True, (255, 255, 255))
+        f.set_bold(True)
+        self.assertEqual(f.get_render_cache_stats()[1], 0)
+        s2 = f.render(text, True, (255, 255, 255))
+        self.failIf(s2 is s1)
+        self.assertNotEqual(s2.get_size(), s1.get_size())
+
+        f.set_render_cache(0)
+        self.assertEqual(f.get_render_cache_stats()[:2], (0, 0))
+        self.failIf(f.render(text, True, (255, 255, 255)) is s2)
+        self.assertRaises(ValueError, f.set_render_cache, -1)
+
     def test_size(self):
         f = pygame_font.Font(None, 20)
         text = as_unicode("Xg")
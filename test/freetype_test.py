@@ -835,6 +835,156 @@ class FreeTypeFontTest(unittest.TestCase):
         finally:
             font.antialiased = save_antialiased
 
+    def test_freetype_Font_atlas(self):
+        # Rendering through an atlas blends each glyph the way a blit of
+        # its ordinary rendering would, to within rounding.
+        font = self._TEST_FONTS['sans']
+        self.assertFalse(font.atlas)
+        text = 'Hud 42 text, hud'
+        rect = font.get_rect(text, size=24)
+        fg = pygame.Color(200, 100, 30, 180)
+        bg = pygame.Color(20, 90, 200)
+        font.atlas = True
+        try:
+            for flags, bitsize in ((0, 16), (0, 24), (0, 32),
+                                   (pygame.SRCALPHA, 32)):
+                for bgcolor in (None, bg):
+                    surfs = []
+                    for atlas in (False, True):
+                        font.atlas = atlas
+                        surf = pygame.Surface(rect.size, flags, bitsize)
+                        surf.fill((0, 40, 0))
+                        rrect = font.render_to(surf, (0, 0), text, fg,
+                                               bgcolor, size=24)
+                        self.assertEqual(rrect, rect)
+                        surfs.append(surf)
+                    for x in range(rect.width):
+                        for y in range(rect.height):
+                            c1 = surfs[0].get_at((x, y))
+                            c2 = surfs[1].get_at((x, y))
+                            for i in range(4):
+                                self.assertTrue(abs(c1[i] - c2[i]) <= 8,
+                                                (bitsize, x, y, c1, c2))
+
+            # The clip area is kept.
+            surf = pygame.Surface(rect.size, 0, 32)
+            surf.set_clip((0, 0, rect.width // 2, rect.height))
+            font.render_to(surf, (0, 0), text, fg, size=24)
+            for x in range(rect.width // 2, rect.width):
+                for y in range(rect.height):
+                    self.assertEqual(surf.get_at((x, y)), (0, 0, 0, 255))
+
+            # More colors than the font keeps atlases for.
+            for i in range(10):
+                font.render_to(surf, (0, 0), text, (i * 20, 0, 0), size=24)
+                font.render_to(surf, (0, 0), text, (i * 20, 0, 0), size=30)
+        finally:
+            font.atlas = False
+
+    def test_freetype_Font_render_to_32bit(self):
+        # The 32 bit surfaces blend antialiased glyphs the same way
+        # whatever the channel order, and the same as a 24 bit surface.
+        font = self._TEST_FONTS['sans']
+        text = 'Hud 42 text, hud'
+        rect = font.get_rect(text, size=24)
+        fg = pygame.Color(20, 100, 230, 180)
+        for bgcolor in (None, pygame.Color(250, 90, 20),
+                        pygame.Color(250, 90, 20, 100)):
+            for flags, masks in (
+                    (0, (0xff0000, 0xff00, 0xff, 0)),
+                    (0, (0xff, 0xff00, 0xff0000, 0)),
+                    (pygame.SRCALPHA, (0xff0000, 0xff00, 0xff, 0xff000000)),
+                    (pygame.SRCALPHA, (0xff000000, 0xff0000, 0xff00, 0xff))):
+                surf24 = pygame.Surface(rect.size, 0, 24)
+                surf = pygame.Surface(rect.size, flags, 32, masks)
+                for s in (surf24, surf):
+                    s.fill((240, 230, 10))
+                    font.render_to(s, (0, 0), text, fg, bgcolor, size=24)
+                for x in range(rect.width):
+                    for y in range(rect.height):
+                        c = surf.get_at((x, y))
+                        self.assertEqual(c, surf24.get_at((x, y)),
+                                         (masks, bgcolor, x, y))
+
+    def test_freetype_Font_render_many_to(self):
+        font = self._TEST_FONTS['sans']
+        fg = pygame.Color(10, 200, 40)
+        bg = pygame.Color(80, 20, 120)
+        # More texts than the layout cache keeps, with a glyph cache too
+        # small to hold their glyphs
+        texts = [((i % 10 * 30, i // 10 * 20),
+                  'L%d %s' % (i, chr(65 + i % 26)))
+                 for i in range(150)]
+        texts.append(((0, 0), ''))
+        budget = font.glyph_cache_budget
+        font.glyph_cache_budget = 1
+        try:
+            expected = pygame.Surface((300, 300), 0, 32)
+            rects = [font.render_to(expected, dest, text, fg, bg, size=14)
+                     for dest, text in texts]
+            surf = pygame.Surface((300, 300), 0, 32)
+            many = font.render_many_to(surf, texts, fg, bg, size=14)
+        finally:
+            font.glyph_cache_budget = budget
+        self.assertEqual(many, rects)
+        for r in many:
+            self.assertTrue(isinstance(r, pygame.Rect))
+        self.assertEqual(pygame.image.tostring(surf, 'RGBA'),
+                         pygame.image.tostring(expected, 'RGBA'))
+        self.assertEqual(font.render_many_to(surf, []), [])
+
+        self.assertRaises(TypeError, font.render_many_to, surf, 'abc')
+        self.assertRaises(TypeError, font.render_many_to, surf,
+                          [((0, 0), 'a', 'b')])
+        self.assertRaises(TypeError, font.render_many_to, surf,
+                          [(None, 'a')])
+        self.assertRaises(ValueError, font.render_many_to, surf,
+                          [((0, 0), 'a')], style=97)
+
+    def test_freetype_Font_render_cached(self):
+        font = self._TEST_FONTS['sans']
+        text = 'Score: 1200'
+        fg = pygame.Color(200, 100, 30)
+        surf, rect = font.render(text, fg, size=24)
+        csurf, crect = font.render_cached(text, fg, size=24)
+        self.assertEqual(crect, rect)
+        self.assertEqual(csurf.get_size(), surf.get_size())
+        for x in range(rect.width):
+            for y in range(rect.height):
+                self.assertEqual(csurf.get_at((x, y)), surf.get_at((x, y)))
+
+        # The same text, colors and mode give back the same surface.
+        csurf2, crect2 = font.render_cached(text, fg, size=24)
+        self.assertTrue(csurf2 is csurf)
+        self.assertEqual(crect2, crect)
+        csurf2, crect2 = font.render_cached(None, fg, size=24)
+        self.assertTrue(csurf2 is csurf)
+
+        # Anything else renders again.
+        self.assertFalse(font.render_cached('Score: 1300', fg,
+                                            size=24)[0] is csurf)
+        self.assertFalse(font.render_cached(text, fg, (0, 0, 0),
+                                            size=24)[0] is csurf)
+        self.assertFalse(font.render_cached(text, fg, size=30)[0] is csurf)
+        self.assertFalse(font.render_cached(text, fg,
+                                            style=freetype.STYLE_UNDERLINE,
+                                            size=24)[0] is csurf)
+
+        # The layout is found again by the other render methods too.
+        size, count, hits, misses = font._layout_cache_stats
+        self.assertTrue(0 < count <= size)
+        font.render_to(pygame.Surface((100, 100)), (0, 0), text, fg, size=24)
+        stats = font._layout_cache_stats
+        self.assertEqual(stats[2], hits + 1)
+        self.assertEqual(stats[3], misses)
+
+        # Many more strings than are kept
+        for i in range(size * 2):
+            font.render_cached(str(i), fg, size=24)
+        stats = font._layout_cache_stats
+        self.assertEqual(stats[1], size)
+        self.assertFalse(font.render_cached(text, fg, size=24)[0] is csurf)
+
     def test_freetype_Font_render_raw(self):
     
         font = self._TEST_FONTS['sans']
@@ -1174,9 +1324,7 @@ class FreeTypeFontTest(unittest.TestCase):
         miss += glen
         f.render_raw(glyphs, size=12)
         self.assertEqual(f._debug_cache_stats, (count, 0, access, hit, miss))
-        # Underline style does not
-        access += oglen
-        hit += oglen
+        # Underline style does not; the text is still laid out
         f.underline = True
         f.render_raw(other_glyphs)
         f.underline = False
@@ -1218,6 +1366,7 @@ class FreeTypeFontTest(unittest.TestCase):
         self.assertEqual((ccount + cdelete_count, caccess, chit, cmiss),
                          (count, access, hit, miss))
         # Trigger a cleanup for sure.
+        f.glyph_cache_budget = 1
         count += 2 * mglen
         access += 2 * mglen
         miss += 2 * mglen
@@ -1233,6 +1382,90 @@ class FreeTypeFontTest(unittest.TestCase):
     except AttributeError:
         del test_freetype_Font_cache
 
+    def test_freetype_Font_glyph_cache(self):
+        f = ft.Font(None, size=24)
+        self.assertEqual(f.glyph_cache_budget, 1024 * 1024)
+        self.assertEqual(f.glyph_cache_stats, (0, 0, 0, 0, 0))
+
+        glyphs = 'abcdefghij'
+        f.render_raw(glyphs)
+        count, nbytes, hits, misses, evictions = f.glyph_cache_stats
+        self.assertEqual((count, hits, misses, evictions), (10, 0, 10, 0))
+        self.assertTrue(nbytes > 0)
+        f.render_raw(glyphs, size=30)
+        stats = f.glyph_cache_stats
+        self.assertEqual(stats[0], 20)
+        self.assertTrue(stats[1] > nbytes)
+
+        # The glyphs least recently used go first, when the next text is
+        # laid out.
+        f.glyph_cache_budget = stats[1] - nbytes
+        f.render_raw('a', size=40)
+        count, nbytes, hits, misses, evictions = f.glyph_cache_stats
+        self.assertEqual(evictions, 10)
+        self.assertEqual(count, 11)
+        f.render_raw(glyphs, size=24)
+        self.assertEqual(f.glyph_cache_stats[2:4], (hits, misses + 10))
+
+        # No budget keeps everything.
+        f.glyph_cache_budget = 0
+        evictions = f.glyph_cache_stats[4]
+        for size in range(8, 20):
+            f.render_raw(glyphs, size=size)
+        self.assertEqual(f.glyph_cache_stats[4], evictions)
+
+        self.assertRaises(ValueError, setattr, f, 'glyph_cache_budget', -1)
+        self.assertRaises(TypeError, setattr, f, 'glyph_cache_budget', 'x')
+
+    def test_freetype_Font_shared_cache(self):
+        f1 = ft.Font(self._sans_path, size=24, shared_cache=True)
+        f2 = ft.Font(self._sans_path, size=24, shared_cache=True)
+        f3 = ft.Font(self._sans_path, size=24)
+        text = 'shared glyphs'
+        r1 = f1.render_raw(text)
+        stats = f2.glyph_cache_stats
+        self.assertEqual(stats, f1.glyph_cache_stats)
+        r2 = f2.render_raw(text)
+        self.assertEqual(r2, r1)
+        self.assertEqual(f2.glyph_cache_stats[3], stats[3])
+        self.assertEqual(f3.glyph_cache_stats[0], 0)
+        f2.glyph_cache_budget = 1000
+        self.assertEqual(f1.glyph_cache_budget, 1000)
+        del f1
+        self.assertEqual(f2.render_raw(text), r1)
+
+    def test_freetype_Font_prewarm(self):
+        import threading
+
+        f = ft.Font(self._sans_path, size=24)
+        text = 'Prewarmed text, prewarmed'
+        nglyphs = len(set(text))
+        self.assertEqual(f.prewarm(text), nglyphs)
+        self.assertEqual(f.prewarm(text), 0)
+        count, nbytes, hits, misses, evictions = f.glyph_cache_stats
+        self.assertEqual(count, nglyphs)
+
+        # Rendering finds every glyph, and they match rendering without.
+        r = f.render_raw(text)
+        self.assertEqual(f.glyph_cache_stats[3], misses)
+        self.assertEqual(ft.Font(self._sans_path, size=24).render_raw(text),
+                         r)
+
+        # Other sizes and styles are glyphs of their own.
+        self.assertEqual(f.prewarm(text, size=30, style=ft.STYLE_STRONG),
+                         nglyphs)
+
+        # In a background thread
+        results = []
+        thread = threading.Thread(
+            target=lambda: results.append(f.prewarm(text, size=40)))
+        thread.start()
+        f.render_raw(text, size=12)
+        thread.join()
+        self.assertEqual(results, [nglyphs])
+        self.assertEqual(f.render_raw(text, size=40),
+                         ft.Font(self._sans_path).render_raw(text, size=40))
+
     def test_undefined_character_code(self):
         # To be consistent with pygame.font.Font, undefined codes
         # are rendered as the undefined character, and has metrics
@@ -684,6 +684,44 @@ class GfxdrawDefaultTest( unittest.TestCase ):
                               points,
                               texture, 0, 0)
 
+    def test_textured_polygon_uv(self):
+        """textured_polygon_uv(surface, points, texture, texcoords): return None"""
+        fg = self.foreground_color
+        bg = self.background_color
+        other = (10, 200, 30)
+        points = [(10, 10), (50, 10), (50, 50), (10, 50)]
+        # The left half of the texture is fg, the right half other.
+        for texture in [pygame.Surface((4, 4), 0, 24),
+                        pygame.Surface((4, 4), 0, 32)]:
+            texture.fill(fg, (0, 0, 2, 4))
+            texture.fill(other, (2, 0, 2, 4))
+            for surf in self.surfaces[1:]:
+                fg_adjusted = surf.unmap_rgb(surf.map_rgb(fg))
+                bg_adjusted = surf.unmap_rgb(surf.map_rgb(bg))
+                other_adjusted = surf.unmap_rgb(surf.map_rgb(other))
+                # Only the left half stretched over the whole square
+                pygame.gfxdraw.textured_polygon_uv(
+                    surf, points, texture, [(0, 0), (2, 0), (2, 4), (0, 4)])
+                for posn in [(15, 15), (30, 30), (45, 45)]:
+                    self.check_at(surf, posn, fg_adjusted)
+                for posn in [(9, 30), (30, 9), (52, 30), (30, 52)]:
+                    self.check_at(surf, posn, bg_adjusted)
+                # All of it, then twice across
+                pygame.gfxdraw.textured_polygon_uv(
+                    surf, points, texture, [(0, 0), (4, 0), (4, 4), (0, 4)])
+                self.check_at(surf, (15, 30), fg_adjusted)
+                self.check_at(surf, (45, 30), other_adjusted)
+                pygame.gfxdraw.textured_polygon_uv(
+                    surf, points, texture, [(0, 0), (8, 0), (8, 4), (0, 4)])
+                self.check_at(surf, (31, 30), fg_adjusted)
+                self.check_at(surf, (25, 30), other_adjusted)
+                surf.fill(bg)
+
+        self.failUnlessRaises(ValueError,
+                              pygame.gfxdraw.textured_polygon_uv,
+                              self.surfaces[3], points, texture,
+                              [(0, 0), (1, 0)])
+
     def test_bezier(self):
         """bezier(surface, points, steps, color): return None"""
         fg = self.foreground_color
@@ -703,6 +741,37 @@ class GfxdrawDefaultTest( unittest.TestCase ):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_shape_cache(self):
+        """set_shape_cache_size(count), get_shape_cache_stats()"""
+        fg = (200, 120, 40, 150)
+        draw = pygame.gfxdraw
+        size = draw.get_shape_cache_size()
+        self.assertRaises(ValueError, draw.set_shape_cache_size, -1)
+        try:
+            for surf in self.surfaces:
+                expected = surf.copy()
+                for cached, target in ((0, expected), (3, surf)):
+                    draw.set_shape_cache_size(cached)
+                    self.assertEqual(draw.get_shape_cache_size(), cached)
+                    for i in range(20):
+                        r = 5 + i % 4
+                        x = 10 + 4 * i
+                        draw.filled_circle(target, x, 20, r, fg)
+                        draw.aacircle(target, x, 40, r, fg)
+                        draw.filled_ellipse(target, x, 60, r, 3, fg)
+                        draw.aaellipse(target, x, 80, r, 3, fg)
+                self.assertEqual(pygame.image.tostring(surf, 'RGBA'),
+                                 pygame.image.tostring(expected, 'RGBA'))
+                count, nbytes, hits, misses, evictions = \
+                    draw.get_shape_cache_stats()
+                self.assertEqual(count, 3)
+                self.assertTrue(nbytes > 0)
+                self.assertTrue(hits > 0)
+                self.assertTrue(evictions > 0)
+        finally:
+            draw.set_shape_cache_size(size)
+        self.assertEqual(draw.get_shape_cache_stats()[:2], (0, 0))
+
 
 
 if __name__ == '__main__':
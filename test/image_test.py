@@ -16,12 +16,19 @@ if is_pygame_pkg:
 else:
     from test.test_utils import example_path, png
 import pygame, pygame.image, pygame.pkgdata
-from pygame.compat import xrange_, ord_
+from pygame.compat import xrange_, ord_, get_BytesIO, as_bytes
 
 import os
 import array
 import tempfile
 
+BytesIO = get_BytesIO()
+
+class KeepOpenIO(BytesIO):
+    """A BytesIO that stays readable after saving to it closes it"""
+    def close(self):
+        pass
+
 def test_magic(f, magic_hex):
     """ tests a given file to see if the magic hex matches.
     """
@@ -260,6 +267,212 @@ class ImageModuleTest( unittest.TestCase ):
                 pass
 
                 
+    def test_load_many(self):
+        paths = []
+        try:
+            for i in range(20):
+                s = pygame.Surface((i + 1, 3), 0, 32)
+                s.fill((i * 10, 255 - i * 10, 7))
+                handle, path = tempfile.mkstemp('.bmp')
+                os.close(handle)
+                pygame.image.save(s, path)
+                paths.append(path)
+
+            done = []
+            surfs = pygame.image.load_many(paths, lambda i, s: done.append(i))
+            self.assertEqual(len(surfs), 20)
+            self.assertEqual(sorted(done), list(range(20)))
+            for i, s in enumerate(surfs):
+                self.assertEqual(s.get_size(), (i + 1, 3))
+                self.assertEqual(s.get_at((0, 0)),
+                                 (i * 10, 255 - i * 10, 7, 255))
+            self.assertEqual(pygame.image.load_many([]), [])
+
+            missing = paths[:5] + [paths[0] + '.missing'] + paths[5:]
+            self.assertRaises(pygame.error, pygame.image.load_many, missing)
+            self.assertRaises(TypeError, pygame.image.load_many, [1])
+
+            def callback(i, s):
+                raise ValueError(i)
+            self.assertRaises(ValueError,
+                              pygame.image.load_many, paths, callback)
+        finally:
+            for path in paths:
+                os.remove(path)
+
+    def test_load__mapped_file(self):
+        # Files this big are mapped into memory rather than read.
+        s = pygame.Surface((300, 200), 0, 24)
+        for y in range(0, 200, 10):
+            s.fill((y, 255 - y, 9), (0, y, 300, 10))
+        handle, path = tempfile.mkstemp('.bmp')
+        os.close(handle)
+        try:
+            pygame.image.save(s, path)
+            self.assertTrue(os.path.getsize(path) > 64 * 1024)
+            s2 = pygame.image.load(path)
+            self.assertEqual(s2.get_size(), (300, 200))
+            for pos in ((0, 0), (150, 105), (299, 199)):
+                self.assertEqual(s2.get_at(pos), s.get_at(pos))
+            surfs = pygame.image.load_many([path, path])
+            self.assertEqual(surfs[1].get_at((150, 105)), s.get_at((150, 105)))
+        finally:
+            os.remove(path)
+
+    def test_save__tga(self):
+        # Big enough to take several blocks of the writer.
+        for bpp, flags, size in ((32, pygame.SRCALPHA, 4), (24, 0, 3)):
+            s = pygame.Surface((301, 200), flags, bpp)
+            for y in range(0, 200, 10):
+                s.fill((y, 255 - y, 3, 128 + y // 2), (0, y, 150, 10))
+            for compression in (0, -1):
+                f = KeepOpenIO()
+                pygame.image.save(s, f, compression)
+                data = f.getvalue()
+                if compression == 0:
+                    self.assertEqual(len(data), 18 + 301 * 200 * size)
+                    self.assertEqual(bytearray(data[18:18 + size]),
+                                     bytearray((3, 255, 0, 128)[:size]))
+                else:
+                    self.assertTrue(len(data) < 301 * 200)
+                if pygame.image.get_extended():
+                    f.seek(0)
+                    s2 = pygame.image.load(f, 'x.tga')
+                    for pos in ((0, 0), (149, 55), (150, 55), (300, 199)):
+                        self.assertEqual(s2.get_at(pos), s.get_at(pos))
+
+    def test_save_atlas(self):
+        s = pygame.Surface((64, 32), pygame.SRCALPHA, 32)
+        s.fill((10, 20, 30, 40))
+        s.fill((200, 100, 50, 255), (32, 0, 32, 32))
+        rects = [(0, 0, 32, 32), pygame.Rect(32, 0, 32, 32), (5, 6, 0, 0)]
+        path = tempfile.mktemp(suffix='.atlas')
+        try:
+            pygame.image.save_atlas(s, path, rects)
+            s2, rects2 = pygame.image.load_atlas(path)
+            self.assertEqual(s2.get_size(), s.get_size())
+            self.assertEqual(s2.get_masks(), s.get_masks())
+            self.assertEqual(s2.get_flags() & pygame.SRCALPHA,
+                             pygame.SRCALPHA)
+            self.assertEqual(rects2, [pygame.Rect(r) for r in rects])
+            for pos in ((0, 0), (31, 31), (32, 0), (63, 31)):
+                self.assertEqual(s2.get_at(pos), s.get_at(pos))
+
+            # Drawing on the mapped surface leaves the file alone.
+            s2.fill((0, 0, 0, 0))
+            s3 = pygame.image.load_atlas(path)[0]
+            self.assertEqual(s3.get_at((63, 31)), (200, 100, 50, 255))
+            del s2, s3
+        finally:
+            os.remove(path)
+
+        p = pygame.Surface((5, 3), 0, 8)
+        p.set_palette_at(7, (1, 2, 3))
+        p.fill(7)
+        p.set_colorkey(7)
+        f = KeepOpenIO()
+        pygame.image.save_atlas(p, f)
+        f.seek(0)
+        p2, rects2 = pygame.image.load_atlas(f)
+        self.assertEqual(rects2, [])
+        self.assertEqual(p2.get_bitsize(), 8)
+        self.assertEqual(p2.get_palette_at(7), (1, 2, 3, 255))
+        self.assertEqual(p2.get_colorkey(), (1, 2, 3, 255))
+        self.assertEqual(p2.get_at_mapped((4, 2)), 7)
+
+        self.assertRaises(ValueError, pygame.image.save_atlas,
+                          s, KeepOpenIO(), [(40, 0, 32, 32)])
+        self.assertRaises(pygame.error, pygame.image.load_atlas,
+                          BytesIO(b'not an atlas file'))
+
+    def test_save__jpeg_options(self):
+        if not pygame.image.get_extended() or pygame.image.load_jpeg is None:
+            return
+        s = pygame.Surface((101, 67), 0, 32)
+        for x in range(0, 101, 4):
+            s.fill((x * 2, 255 - x, 100), (x, 0, 4, 67))
+        path = tempfile.mktemp(suffix='.jpg')
+        try:
+            sizes = []
+            for quality in (10, 95):
+                pygame.image.save(s, path, quality=quality)
+                sizes.append(os.path.getsize(path))
+            self.assertTrue(sizes[0] < sizes[1])
+            pygame.image.save(s, path, quality=90, dct='ifast',
+                              subsampling='4:4:4')
+            for scale, size in ((1, (101, 67)), (2, (51, 34)),
+                                (8, (13, 9))):
+                s2 = pygame.image.load_jpeg(path, scale)
+                self.assertEqual(s2.get_size(), size)
+            s2 = pygame.image.load_jpeg(path, dct='ifast')
+            r, g, b, a = s2.get_at((49, 30))
+            self.assertTrue(abs(r - 96) < 16 and abs(g - 207) < 16)
+            self.assertRaises(ValueError, pygame.image.load_jpeg, path, 3)
+        finally:
+            os.remove(path)
+
+        for kwds in ({'quality': 101}, {'dct': 'slow'},
+                     {'subsampling': '4:1:1'}):
+            self.assertRaises(ValueError, pygame.image.save, s, path, **kwds)
+
+        f = KeepOpenIO()
+        pygame.image.save(s, f, namehint='shot.JPG')
+        f.seek(0)
+        self.assertEqual(f.read(2), as_bytes('\xff\xd8'))
+        f.seek(0)
+        self.assertEqual(pygame.image.load_jpeg(f, 4).get_size(), (26, 17))
+
+    def test_save__png_options(self):
+        if not pygame.image.get_extended():
+            return
+        s = pygame.Surface((40, 30), pygame.SRCALPHA, 32)
+        for x in range(40):
+            s.fill((x * 6, 255 - x * 6, x % 7, 200), (x, 0, 1, 30))
+        handle, path = tempfile.mkstemp('.png')
+        os.close(handle)
+        try:
+            sizes = {}
+            for compression, filter in ((0, 'none'), (9, 'all'), (-1, None),
+                                        (1, 'sub'), (6, 'paeth')):
+                pygame.image.save(s, path, compression, filter=filter)
+                sizes[compression] = os.path.getsize(path)
+                s2 = pygame.image.load(path)
+                for x in (0, 17, 39):
+                    self.assertEqual(s2.get_at((x, 5)), s.get_at((x, 5)))
+            self.assertTrue(sizes[0] > sizes[9])
+            self.assertRaises(ValueError, pygame.image.save, s, path, 10)
+            self.assertRaises(ValueError, pygame.image.save, s, path,
+                              filter='fast')
+        finally:
+            os.remove(path)
+
+    def test_save_async(self):
+        if pygame.image.save_async is None:
+            return
+        paths = []
+        try:
+            s = pygame.Surface((20, 10), 0, 24)
+            for i in range(6):
+                handle, path = tempfile.mkstemp('.png')
+                os.close(handle)
+                paths.append(path)
+                s.fill((i * 40, 1, 2))
+                pygame.image.save_async(s, path, compression=1)
+            s.fill((0, 0, 0))
+            self.assertEqual(pygame.image.wait_saves(), None)
+            for i, path in enumerate(paths):
+                self.assertEqual(pygame.image.load(path).get_at((3, 3)),
+                                 (i * 40, 1, 2, 255))
+
+            bad = os.path.join(paths[0] + '.missing', 'x.png')
+            pygame.image.save_async(s, bad)
+            self.assertRaises(pygame.error, pygame.image.wait_saves)
+            pygame.image.wait_saves()
+            self.assertRaises(TypeError, pygame.image.save_async, s, None)
+        finally:
+            for path in paths:
+                os.remove(path)
+
     def test_save_colorkey(self):
         """ make sure the color key is not changed when saving.
         """
@@ -330,6 +543,57 @@ class ImageModuleTest( unittest.TestCase ):
         self.assertRaises(ValueError, pygame.image.tostring, no_alpha_surface, "RGBA_PREMULT")
         
 
+    def test_tostring__byte_layouts(self):
+        # Surfaces stored in each byte order give the same strings.
+        masks = [(0xff, 0xff00, 0xff0000, 0xff000000),
+                 (0xff0000, 0xff00, 0xff, 0xff000000),
+                 (0xff000000, 0xff0000, 0xff00, 0xff),
+                 (0xff0000, 0xff00, 0xff, 0)]
+        colors = [(1, 2, 3, 4), (250, 128, 0, 255), (9, 80, 200, 0)]
+        for m in masks:
+            flags = m[3] and pygame.SRCALPHA or 0
+            s = pygame.Surface((7, 3), flags, 32, m)
+            for x in range(7):
+                s.set_at((x, 0), colors[x % 3])
+                s.set_at((x, 2), colors[(x + 1) % 3])
+            for fmt in ('RGBA', 'RGBX', 'ARGB', 'RGB'):
+                for flipped in (False, True):
+                    data = pygame.image.tostring(s, fmt, flipped)
+                    size = len(fmt)
+                    self.assertEqual(len(data), 7 * 3 * size)
+                    for x in range(7):
+                        y = flipped and 2 or 0
+                        c = s.get_at((x, 0))
+                        want = dict(R=c[0], G=c[1], B=c[2], A=c[3], X=c[3])
+                        i = (y * 7 + x) * size
+                        self.assertEqual(list(bytearray(data[i:i + size])),
+                                         [want[ch] for ch in fmt])
+
+    def test_tobuffer(self):
+        s = pygame.Surface((5, 4), pygame.SRCALPHA, 32)
+        for x in range(5):
+            for y in range(4):
+                s.set_at((x, y), (x * 50, y * 60, 7, 100 + x))
+        for fmt in ('P', 'RGB', 'RGBX', 'RGBA', 'ARGB', 'RGBA_PREMULT'):
+            if fmt == 'P':
+                surf = pygame.Surface((5, 4), 0, 8)
+                size = 1
+            else:
+                surf = s
+                size = len(fmt.split('_')[0])
+            for flipped in (False, True):
+                buf = bytearray(5 * 4 * size)
+                self.assertEqual(
+                    pygame.image.tobuffer(surf, fmt, buf, flipped), None)
+                self.assertEqual(bytes(buf),
+                                 pygame.image.tostring(surf, fmt, flipped))
+        self.assertRaises(ValueError, pygame.image.tobuffer,
+                          s, 'RGBA', bytearray(5 * 4 * 4 - 1))
+        self.assertRaises(ValueError, pygame.image.tobuffer,
+                          s, 'XYZ', bytearray(80))
+        self.assertRaises(TypeError, pygame.image.tobuffer,
+                          s, 'RGBA', b'\x00' * 80)
+
     def test_fromstring__and_tostring(self):
         """ see if fromstring, and tostring methods are symmetric.
         """
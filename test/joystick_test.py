@@ -87,6 +87,39 @@ class JoytickModuleTest(unittest.TestCase):
 
         self.fail() 
 
+    def test_get_states(self):
+        import pygame
+        import struct
+        pygame.joystick.init()
+        try:
+            sticks = [pygame.joystick.Joystick(i)
+                      for i in range(pygame.joystick.get_count())]
+            for stick in sticks:
+                stick.init()
+            states = pygame.joystick.get_states()
+            self.assertTrue(isinstance(states, bytearray))
+            offset = 0
+            for stick in sticks:
+                form = stick.get_state_format()
+                size = struct.calcsize(form)
+                self.assertEqual(bytes(states[offset:offset + size]),
+                                 bytes(stick.get_state()))
+                header = struct.unpack_from(form, states, offset)[:5]
+                self.assertEqual(header, (stick.get_id(),
+                                          stick.get_numaxes(),
+                                          stick.get_numbuttons(),
+                                          stick.get_numhats(),
+                                          stick.get_numballs()))
+                offset += size
+            self.assertEqual(offset, len(states))
+
+            out = bytearray(len(states) + 8)
+            self.assertEqual(pygame.joystick.get_states(out), len(states))
+            self.assertRaises(ValueError, pygame.joystick.get_states,
+                              None, 2.0)
+        finally:
+            pygame.joystick.quit()
+
     def todo_test_quit(self):
 
         # __doc__ (as of 2008-08-02) for pygame.joystick.quit:
@@ -15,6 +15,7 @@ import pygame
 import pygame.mask
 from pygame.locals import *
 
+import math
 import random
 
 def random_mask(size = (100,100)):
@@ -112,6 +113,28 @@ class MaskTypeTest( unittest.TestCase ):
 
         self.fail() 
     
+    def test_overlap__word_edges(self):
+        # Offsets on both sides of the 32 and 64 bit word edges.
+        random.seed(7)
+        m1 = random_mask((150, 20))
+        m2 = random_mask((70, 9))
+        for xoffset in [-70, -65, -64, -63, -33, -32, -31, -1, 0, 1,
+                        31, 32, 33, 63, 64, 65, 100, 127, 128, 129]:
+            for yoffset in [-5, 0, 3, 15]:
+                area = 0
+                for x in range(70):
+                    for y in range(9):
+                        if (0 <= x + xoffset < 150 and 0 <= y + yoffset < 20
+                            and m1.get_at((x + xoffset, y + yoffset))
+                            and m2.get_at((x, y))):
+                            area += 1
+                offset = (xoffset, yoffset)
+                self.assertEquals(m1.overlap_area(m2, offset), area)
+                self.assertEquals(m1.overlap(m2, offset) is not None, area > 0)
+                self.assertEquals(m1.overlap_mask(m2, offset).count(), area)
+                self.assertEquals(m2.overlap_area(m1, (-xoffset, -yoffset)),
+                                  area)
+
     def test_mask_access( self ):
         """ do the set_at, and get_at parts work correctly?
         """
@@ -175,6 +198,120 @@ class MaskTypeTest( unittest.TestCase ):
         
         #TODO: Test more corner case outlines.
 
+    def test_outline_array(self):
+        m = pygame.Mask((100,20))
+        self.assertEqual(list(m.outline_array()), [])
+
+        random.seed(17)
+        for x in range(66, 90):
+            for y in range(3, 15):
+                if random.randrange(4):
+                    m.set_at((x, y), 1)
+        for every in [1, 2, 7]:
+            points = m.outline_array(every)
+            self.assertEqual(points.typecode, 'i')
+            self.assertEqual(list(zip(points[::2], points[1::2])),
+                             m.outline(every))
+
+    def test_overlap_many(self):
+        random.seed(37)
+        big = random_mask((200, 100))
+        bullets = [random_mask((1 + i % 9, 1 + i % 7)) for i in range(100)]
+        offsets = [(random.randrange(-20, 220), random.randrange(-20, 120))
+                   for i in range(100)]
+
+        points = big.overlap_many(bullets, offsets)
+        areas = big.overlap_many(bullets, offsets, True)
+        self.assertEqual(points.typecode, 'i')
+        self.assertEqual(len(points), 200)
+        self.assertEqual(len(areas), 100)
+        for i in range(100):
+            point = big.overlap(bullets[i], offsets[i])
+            if point is None:
+                point = (-1, -1)
+            self.assertEqual((points[2 * i], points[2 * i + 1]), point)
+            self.assertEqual(areas[i], big.overlap_area(bullets[i],
+                                                        offsets[i]))
+
+        self.assertEqual(len(big.overlap_many([], [])), 0)
+        self.assertRaises(ValueError, big.overlap_many, bullets, offsets[1:])
+        self.assertRaises(TypeError, big.overlap_many, [1], [(0, 0)])
+        self.assertRaises(TypeError, big.overlap_many, bullets[:1], [0])
+
+    def test_set_overlap_cache(self):
+        random.seed(23)
+        big = random_mask((150, 40))
+        small = random_mask((70, 20))
+        cached = pygame.Mask(small.get_size())
+        cached.draw(small, (0, 0))
+        cached.set_overlap_cache(8)
+
+        for offset in [(-71, 0), (-69, 3), (-33, -5), (0, 0), (5, 7),
+                       (31, -19), (64, 10), (97, 12), (149, 39)]:
+            self.assertEqual(big.overlap_area(cached, offset),
+                             big.overlap_area(small, offset))
+            self.assertEqual(big.overlap(cached, offset) is None,
+                             big.overlap(small, offset) is None)
+            self.assertMaskEquals(big.overlap_mask(cached, offset),
+                                  big.overlap_mask(small, offset))
+
+            o = big.overlap_mask(small, offset)
+            for x in range(150):
+                for y in range(0, 40, 3):
+                    sx, sy = x - offset[0], y - offset[1]
+                    inside = 0 <= sx < 70 and 0 <= sy < 20
+                    self.assertEqual(o.get_at((x, y)),
+                                     int(bool(big.get_at((x, y)) and inside
+                                              and small.get_at((sx, sy)))))
+
+        # changing the mask throws away the shifted copies
+        cached.fill()
+        small.fill()
+        self.assertEqual(big.overlap_area(cached, (5, 7)),
+                         big.overlap_area(small, (5, 7)))
+        cached.set_overlap_cache(0)
+        self.assertEqual(big.overlap_area(cached, (5, 7)),
+                         big.overlap_area(small, (5, 7)))
+
+    def test_set_block_map(self):
+        random.seed(29)
+        terrain = pygame.Mask((300, 270))
+        mapped = pygame.Mask((300, 270))
+        mapped.set_block_map()
+        blob = random_mask((20, 30))
+        for i in range(6):
+            pos = (random.randrange(-10, 300), random.randrange(-10, 270))
+            terrain.draw(blob, pos)
+            mapped.draw(blob, pos)
+        sprite = random_mask((70, 90))
+
+        def check():
+            for offset in [(-69, -89), (-60, 5), (0, 0), (33, 64),
+                           (100, 200), (250, 180), (299, 269)]:
+                self.assertEqual(mapped.overlap(sprite, offset) is None,
+                                 terrain.overlap(sprite, offset) is None)
+                self.assertEqual(mapped.overlap_area(sprite, offset),
+                                 terrain.overlap_area(sprite, offset))
+                other = (-offset[0], -offset[1])
+                self.assertEqual(sprite.overlap_area(mapped, other),
+                                 terrain.overlap_area(sprite, offset))
+        check()
+
+        # the map follows the changes to the mask
+        for m in (terrain, mapped):
+            m.set_at((150, 130))
+            m.erase(blob, (40, 40))
+            m.draw(sprite, (200, 10))
+        check()
+        terrain.fill()
+        mapped.fill()
+        check()
+        terrain.clear()
+        mapped.clear()
+        check()
+        mapped.set_block_map(False)
+        check()
+
     def test_convolve__size(self):
         sizes = [(1,1), (31,31), (32,32), (100,100)]
         for s1 in sizes:
@@ -234,7 +371,148 @@ class MaskTypeTest( unittest.TestCase ):
             for j in range(conv.get_size()[1]):
                 self.assertEquals(conv.get_at((i,j)) == 0, m1.overlap(m2, (i - 99, j - 99)) is None)
 
-        
+    def test_convolve__filled_kernel(self):
+        """Tests kernels with long runs, and an output of part of the result"""
+        random.seed(5)
+        m = random_mask((90, 40))
+        m.clear()
+        for i in range(30):
+            m.set_at((random.randrange(90), random.randrange(40)))
+        k = pygame.Mask((21, 17))
+        k.fill()
+        for x in range(21):
+            for y in range(17):
+                if (x - 10) ** 2 + (y - 8) ** 2 > 80 or y in (3, 4):
+                    k.set_at((x, y), 0)
+        conv = m.convolve(k)
+        w, h = conv.get_size()
+        for i in range(w):
+            for j in range(h):
+                self.assertEqual(conv.get_at((i, j)) == 0,
+                                 m.overlap(k, (i - 20, j - 16)) is None)
+
+        part = pygame.Mask((37, 11))
+        m.convolve(k, part, (-30, -12))
+        for i in range(37):
+            for j in range(11):
+                self.assertEqual(part.get_at((i, j)),
+                                 conv.get_at((i + 30, j + 12)))
+
+
+    def test_scale(self):
+        """Tests scale samples pixel x * w / new_w, and the same along y"""
+        random.seed(11)
+        for size, new_size in [((70, 9), (140, 18)), ((33, 5), (264, 10)),
+                               ((70, 9), (105, 13)), ((130, 7), (65, 7)),
+                               ((130, 7), (43, 3)), ((70, 9), (70, 20)),
+                               ((5, 3), (700, 2))]:
+            m = random_mask(size)
+            w, h = size
+            new_w, new_h = new_size
+            scaled = m.scale(new_size)
+            self.assertEqual(scaled.get_size(), new_size)
+            for x in range(new_w):
+                for y in range(new_h):
+                    self.assertEqual(scaled.get_at((x, y)),
+                                     m.get_at((x * w // new_w,
+                                               y * h // new_h)))
+        self.assertEqual(m.scale((0, 4)).get_size(), (1, 1))
+
+    def test_moments(self):
+        """Tests count, centroid and angle stay right as the mask changes"""
+        def check(m):
+            w, h = m.get_size()
+            points = [(x, y) for x in range(w) for y in range(h)
+                      if m.get_at((x, y))]
+            n = len(points)
+            self.assertEqual(m.count(), n)
+            if not n:
+                self.assertEqual(m.centroid(), (0, 0))
+                self.assertEqual(m.angle(), 0.0)
+                return
+            xc = sum(x for x, y in points) // n
+            yc = sum(y for x, y in points) // n
+            self.assertEqual(m.centroid(), (xc, yc))
+            m11 = sum(x * y for x, y in points) // n
+            m20 = sum(x * x for x, y in points) // n
+            m02 = sum(y * y for x, y in points) // n
+            theta = -90.0 * math.atan2(2 * (m11 - xc * yc),
+                                       (m20 - xc * xc) - (m02 - yc * yc))
+            self.assertAlmostEqual(m.angle(), theta / math.pi)
+
+        random.seed(7)
+        m = random_mask((70, 30))
+        check(m)
+        m.set_at((69, 29))
+        m.set_at((0, 0), 0)
+        check(m)
+        other = random_mask((40, 20))
+        m.draw(other, (50, -5))
+        check(m)
+        m.erase(other, (-10, 15))
+        check(m)
+        m.invert()
+        check(m)
+        m.fill()
+        check(m)
+        m.clear()
+        check(m)
+        m.set_at((3, 4))
+        check(m)
+        other.convolve(other, m)
+        check(m)
+
+    def test_dilate_erode(self):
+        """Tests dilate and erode against each pixel's neighbours"""
+        random.seed(13)
+        for size, radius, cross in [((70, 9), 1, False), ((70, 9), 2, True),
+                                    ((130, 7), 3, False), ((33, 5), 0, False),
+                                    ((150, 6), 66, True)]:
+            m = random_mask(size)
+            w, h = size
+            near = [(dx, dy) for dx in range(-radius, radius + 1)
+                             for dy in range(-radius, radius + 1)
+                    if not (cross and dx and dy)]
+            dilated = m.dilate(radius, cross)
+            eroded = m.erode(radius, cross)
+            for x in range(w):
+                for y in range(h):
+                    bits = [m.get_at((x + dx, y + dy)) for dx, dy in near
+                            if 0 <= x + dx < w and 0 <= y + dy < h]
+                    self.assertEqual(dilated.get_at((x, y)), max(bits))
+                    self.assertEqual(eroded.get_at((x, y)), min(bits))
+
+    def test_open_close(self):
+        m = pygame.Mask((40, 20))
+        for x in range(5, 25):
+            for y in range(3, 15):
+                m.set_at((x, y), 1)
+        m.set_at((1, 1), 1)                     # a speck
+        m.set_at((10, 8), 0)                    # a hole
+
+        opened = m.open()
+        self.assertEqual(opened.get_at((1, 1)), 0)
+        self.assertEqual(opened.get_at((5, 3)), 1)
+        closed = m.close()
+        self.assertEqual(closed.get_at((10, 8)), 1)
+        self.assertEqual(closed.get_at((1, 1)), 1)
+
+        # the output mask is filled and returned, and may be the mask
+        out = pygame.Mask((40, 20))
+        self.assertTrue(m.dilate(1, True, out) is out)
+        self.assertEqual(out.count(), m.dilate(1, True).count())
+        expected = m.close(2, True).count()
+        self.assertTrue(m.close(2, True, m) is m)
+        self.assertEqual(m.count(), expected)
+
+        full = pygame.Mask((70, 4))
+        full.fill()
+        self.assertEqual(full.erode(2).count(), full.count())
+        self.assertEqual(full.close(3).count(), full.count())
+
+        self.assertRaises(ValueError, m.dilate, 1, False, pygame.Mask((3, 3)))
+        self.assertRaises(TypeError, m.erode, 1, False, 5)
+
     def test_connected_components(self):
         """
         """
@@ -383,8 +661,60 @@ class MaskTypeTest( unittest.TestCase ):
         m.set_at((3,1), 1)
  
         r = m.get_bounding_rects()
-        #TODO: this should really make one bounding rect.
-        #self.assertEquals(repr(r), "[<rect(0, 0, 5, 2)>]")
+        self.assertEquals(repr(r), "[<rect(0, 0, 5, 2)>]")
+
+    def test_get_component_stats(self):
+        """ Do the stats match the masks of connected_components()?
+        """
+        random.seed(5)
+        m = pygame.Mask((150, 40))
+        for i in range(900):
+            m.set_at((random.randrange(150), random.randrange(40)), 1)
+
+        for min in [0, 1, 3]:
+            stats = m.get_component_stats(min)
+            comps = m.connected_components(min)
+            self.assertEqual(len(stats), len(comps))
+            for (area, rect, centroid), comp in zip(stats, comps):
+                self.assertEqual(area, comp.count())
+                self.assertEqual(rect, comp.get_bounding_rects()[0])
+                self.assertEqual(centroid, comp.centroid())
+        self.assertEqual([rect for area, rect, centroid in
+                          m.get_component_stats()], m.get_bounding_rects())
+        self.assertEqual(pygame.Mask((10, 10)).get_component_stats(), [])
+
+    def test_to_surface(self):
+        random.seed(31)
+        m = random_mask((70, 9))
+
+        surf = m.to_surface()
+        self.assertEqual(surf.get_size(), (70, 9))
+        self.assertEqual(surf.get_bitsize(), 32)
+        for x in range(70):
+            for y in range(9):
+                if m.get_at((x, y)):
+                    self.assertEqual(surf.get_at((x, y)), (255, 255, 255, 255))
+                else:
+                    self.assertEqual(surf.get_at((x, y)), (0, 0, 0, 255))
+
+        # drawn at dest, clipped, and leaving the pixels of None colors
+        for depth in [8, 16, 24, 32]:
+            surf = pygame.Surface((50, 12), 0, depth)
+            surf.fill((0, 0, 255))
+            background = surf.get_at((0, 0))
+            color = surf.unmap_rgb(surf.map_rgb((255, 0, 0)))
+            returned = m.to_surface(surf, (255, 0, 0), None, (-5, 4))
+            self.assertTrue(returned is surf)
+            for x in range(50):
+                for y in range(12):
+                    mx, my = x + 5, y - 4
+                    if 0 <= my < 9 and m.get_at((mx, my)):
+                        self.assertEqual(surf.get_at((x, y)), color)
+                    else:
+                        self.assertEqual(surf.get_at((x, y)), background)
+
+        self.assertRaises(TypeError, m.to_surface, 1)
+        self.assertRaises(TypeError, m.to_surface, None, 'not a color')
 
 class MaskModuleTest(unittest.TestCase):
     def test_from_surface(self):
@@ -427,6 +757,39 @@ class MaskModuleTest(unittest.TestCase):
 
 
 
+    def test_from_surface__word_edges(self):
+        # Widths on both sides of the 32 and 64 bit word edges, and of the
+        # four pixel steps, must give the same mask as testing each pixel.
+        random.seed(11)
+        for width in [1, 3, 4, 5, 31, 32, 33, 63, 64, 65, 67, 129]:
+            surf = pygame.Surface((width, 3), SRCALPHA, 32)
+            for x in range(width):
+                for y in range(3):
+                    surf.set_at((x, y), (random.randrange(256), 0, 0,
+                                         random.randrange(256)))
+            for threshold in [-1, 0, 127, 254, 255]:
+                amask = pygame.mask.from_surface(surf, threshold)
+                for x in range(width):
+                    for y in range(3):
+                        self.assertEqual(amask.get_at((x, y)),
+                                         surf.get_at((x, y))[3] > threshold)
+
+            key = surf.get_at((0, 0))
+            surf.set_colorkey(key)
+            amask = pygame.mask.from_surface(surf)
+            for x in range(width):
+                for y in range(3):
+                    self.assertEqual(amask.get_at((x, y)),
+                                     surf.get_at((x, y)) != key)
+
+            surf.set_colorkey(None)
+            tmask = pygame.mask.from_threshold(surf, (128, 0, 0, 255),
+                                               (64, 1, 1, 255))
+            for x in range(width):
+                for y in range(3):
+                    self.assertEqual(tmask.get_at((x, y)),
+                                     abs(surf.get_at((x, y))[0] - 128) < 64)
+
     def test_from_threshold(self):
         """ Does mask.from_threshold() work correctly?
         """
@@ -452,6 +815,39 @@ class MaskModuleTest(unittest.TestCase):
             self.assertEqual(mask.count(), 100)
             self.assertEqual(mask.get_bounding_rects(), [pygame.Rect((40,40,10,10))])
 
+    def test_collide_pairs(self):
+        """ Does mask.collide_pairs() find the same pairs as testing each?
+        """
+        random.seed(3)
+        rects1 = [pygame.Rect(random.randrange(-20, 200),
+                              random.randrange(-20, 200),
+                              random.randrange(0, 40),
+                              random.randrange(0, 40)) for i in range(60)]
+        rects2 = [pygame.Rect(random.randrange(-20, 200),
+                              random.randrange(-20, 200),
+                              random.randrange(0, 40),
+                              random.randrange(0, 40)) for i in range(45)]
+
+        pairs = [(i, j) for i, a in enumerate(rects1)
+                        for j, b in enumerate(rects2) if a.colliderect(b)]
+        self.assertEqual(pygame.mask.collide_pairs(rects1, rects2), pairs)
+
+        masks1 = [random_mask((r.w + 1, r.h + 1)) for r in rects1]
+        masks2 = [random_mask((r.w + 1, r.h + 1)) for r in rects2]
+        pairs = [(i, j) for i, a in enumerate(rects1)
+                        for j, b in enumerate(rects2)
+                 if masks1[i].overlap(masks2[j], (b.x - a.x, b.y - a.y))]
+        self.assertEqual(pygame.mask.collide_pairs(rects1, rects2,
+                                                   masks1, masks2), pairs)
+
+        self.assertEqual(pygame.mask.collide_pairs([], rects2), [])
+        self.assertRaises(ValueError, pygame.mask.collide_pairs,
+                          rects1, rects2, masks1[1:], masks2)
+        self.assertRaises(TypeError, pygame.mask.collide_pairs,
+                          rects1, rects2, rects1, masks2)
+        self.assertRaises(TypeError, pygame.mask.collide_pairs,
+                          [1], rects2)
+
 
 
 if __name__ == '__main__':
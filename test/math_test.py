@@ -16,9 +16,10 @@ import unittest
 
 import math
 import pygame.math
-from pygame.math import Vector2, Vector3
+from pygame.math import Vector2, Vector3, Vector2Array, Vector3Array
+from pygame.math import Rotation2, Rotation3
 from time import clock
-from random import random
+from random import random, seed
 import gc
 
 class Vector2TypeTest(unittest.TestCase):
@@ -319,6 +320,16 @@ class Vector2TypeTest(unittest.TestCase):
         self.assertEqual(v.x, -1)
         self.assertEqual(v.y, 1)
 
+    def test_rotate_rad(self):
+        for angle in (0.0, 0.5, -3.0, math.pi):
+            v = self.v1.rotate_rad(angle)
+            w = self.v1.rotate(math.degrees(angle))
+            self.assertAlmostEqual(v.x, w.x)
+            self.assertAlmostEqual(v.y, w.y)
+            w = Vector2(self.v1)
+            self.assertEqual(w.rotate_ip_rad(angle), None)
+            self.assertEqual(tuple(w), tuple(v))
+
     def test_normalize(self):
         v = self.v1.normalize()
         # length is 1
@@ -463,6 +474,37 @@ class Vector2TypeTest(unittest.TestCase):
             getattr(Vector2(), "ä")
         self.assertRaises(AttributeError, unicodeAttribute)
 
+    def testSwizzleRepeated(self):
+        pygame.math.enable_swizzling()
+        try:
+            v = Vector2(1, 2)
+            v.x = 3.5
+            self.assertEqual(v, (3.5, 2))
+            for i in range(3):
+                self.assertEqual(v.yx, (2, 3.5))
+                self.assertEqual(getattr(v, "y" + "x"), (2, 3.5))
+                self.assertRaises(AttributeError, lambda: v.xz)
+                self.assertRaises(AttributeError, setattr, v, "xz", (1, 2))
+            v.yx = (5, 6)
+            self.assertEqual(v, (6, 5))
+            self.assertRaises(AttributeError, setattr, v, "xx", (1, 2))
+            class SubVector(Vector2):
+                yx = "attribute"
+            self.assertEqual(SubVector(1, 2).yx, "attribute")
+            self.assertEqual(SubVector(1, 2).xy, (1, 2))
+        finally:
+            pygame.math.disable_swizzling()
+
+    def testSequenceOperands(self):
+        v = Vector2(1, 2)
+        self.assertEqual(v + [1, 2.5], (2, 4.5))
+        self.assertEqual((True, 3) - v, (0, 1))
+        self.assertEqual(v * (2, 3), 8)
+        self.assertTrue(v == [1, 2])
+        self.assertFalse(v == (1, "a"))
+        self.assertRaises(TypeError, lambda: v + (1, "a"))
+        self.assertRaises(OverflowError, lambda: v + (1, 2 ** 5000))
+
     def test_elementwise(self):
         # behaviour for "elementwise op scalar"
         self.assertEqual(self.v1.elementwise() + self.s1,
@@ -1517,6 +1559,248 @@ class Vector3TypeTest(unittest.TestCase):
         self.assertEqual(v, (4.0,4.0,4.0))
 
 
+class FreeListTest(unittest.TestCase):
+
+    def setUp(self):
+        self.size = pygame.math.get_freelist_stats()[0][0]
+
+    def tearDown(self):
+        pygame.math.set_freelist_size(self.size)
+
+    def test_reuse(self):
+        pygame.math.set_freelist_size(8)
+        vectors = [Vector2(i, i) for i in range(20)]
+        vectors += [Vector3(i, i, i) for i in range(20)]
+        del vectors
+        stats2, stats3 = pygame.math.get_freelist_stats()
+        self.assertEqual(stats2[:2], (8, 8))
+        self.assertEqual(stats3[:2], (8, 8))
+        v = Vector2()
+        self.assertEqual(v, (0, 0))
+        self.assertEqual(v + (1, 2), Vector2(1, 2))
+        self.assertEqual(Vector3(1, 2, 3) * 2, Vector3(2, 4, 6))
+        self.assertTrue(pygame.math.get_freelist_stats()[0][2] > stats2[2])
+        self.assertTrue(pygame.math.get_freelist_stats()[1][2] > stats3[2])
+
+    def test_set_freelist_size(self):
+        pygame.math.set_freelist_size(0)
+        stats2, stats3 = pygame.math.get_freelist_stats()
+        self.assertEqual(stats2[:2], (0, 0))
+        self.assertEqual(stats3[:2], (0, 0))
+        Vector2(1, 1)
+        self.assertEqual(pygame.math.get_freelist_stats()[0][3], stats2[3])
+        self.assertRaises(ValueError, pygame.math.set_freelist_size, -1)
+
+
+class VectorArrayTest(unittest.TestCase):
+
+    def setUp(self):
+        seed(5)
+        self.vectors2 = [Vector2(random() * 20 - 10, random() * 20 - 10)
+                         for i in range(37)]
+        self.vectors3 = [Vector3(random() * 20 - 10, random() * 20 - 10,
+                                 random() * 20 - 10) for i in range(23)]
+
+    def assertVectorsAlmostEqual(self, array, vectors):
+        self.assertEqual(len(array), len(vectors))
+        for i, v in enumerate(vectors):
+            for a, b in zip(array[i], v):
+                self.assertAlmostEqual(a, b)
+
+    def testConstructor(self):
+        self.assertEqual(len(Vector2Array()), 0)
+        self.assertEqual(list(Vector3Array(4)), [Vector3()] * 4)
+        a = Vector2Array(self.vectors2)
+        self.assertEqual(list(a), self.vectors2)
+        self.assertEqual(list(Vector2Array(a)), self.vectors2)
+        self.assertEqual(Vector2Array([(1, 2), [3, 4]])[1], Vector2(3, 4))
+        self.assertRaises(TypeError, Vector2Array, [(1, 2, 3)])
+        self.assertRaises(TypeError, Vector3Array, [Vector2()])
+        self.assertRaises(ValueError, Vector2Array, -1)
+
+    def testSequence(self):
+        a = Vector3Array(self.vectors3)
+        self.assertEqual(a[5], self.vectors3[5])
+        self.assertRaises(IndexError, lambda: a[len(a)])
+        a[2] = (1, 2, 3)
+        self.assertEqual(a[2], Vector3(1, 2, 3))
+        a.append(Vector3(4, 5, 6))
+        self.assertEqual(len(a), len(self.vectors3) + 1)
+        self.assertEqual(a[len(a) - 1], Vector3(4, 5, 6))
+
+    def testArithmetic(self):
+        a = Vector2Array(self.vectors2)
+        b = Vector2Array(reversed(self.vectors2))
+        v = Vector2(1.5, -2.5)
+        vs = list(reversed(self.vectors2))
+        self.assertVectorsAlmostEqual(a + b, [p + q for p, q in
+                                              zip(self.vectors2, vs)])
+        self.assertVectorsAlmostEqual(a - b, [p - q for p, q in
+                                              zip(self.vectors2, vs)])
+        self.assertVectorsAlmostEqual(a + v, [p + v for p in self.vectors2])
+        self.assertVectorsAlmostEqual(a - v, [p - v for p in self.vectors2])
+        self.assertVectorsAlmostEqual(v - a, [v - p for p in self.vectors2])
+        self.assertVectorsAlmostEqual(a * 3, [p * 3 for p in self.vectors2])
+        self.assertVectorsAlmostEqual(3 * a, [p * 3 for p in self.vectors2])
+        self.assertVectorsAlmostEqual(-a, [-p for p in self.vectors2])
+        self.assertRaises(ValueError, lambda: a + Vector2Array(3))
+        self.assertRaises(TypeError, lambda: a + Vector3Array(len(a)))
+        self.assertRaises(TypeError, lambda: a * v)
+        c = a
+        c += v
+        c *= 2
+        self.assertTrue(c is a)
+        self.assertVectorsAlmostEqual(a, [(p + v) * 2 for p in self.vectors2])
+
+    def testLength(self):
+        for a, vectors in ((Vector2Array(self.vectors2), self.vectors2),
+                           (Vector3Array(self.vectors3), self.vectors3)):
+            lengths = a.length()
+            squared = a.length_squared()
+            for i, v in enumerate(vectors):
+                self.assertAlmostEqual(lengths[i], v.length())
+                self.assertAlmostEqual(squared[i], v.length_squared())
+
+    def testNormalize(self):
+        a = Vector3Array(self.vectors3)
+        self.assertVectorsAlmostEqual(a.normalize(),
+                                      [v.normalize() for v in self.vectors3])
+        a.normalize_ip()
+        self.assertVectorsAlmostEqual(a,
+                                      [v.normalize() for v in self.vectors3])
+        a = Vector2Array([(1, 1), (0, 0)])
+        self.assertRaises(ValueError, a.normalize_ip)
+        self.assertEqual(a[0], Vector2(1, 1))
+
+    def testRotate(self):
+        a = Vector2Array(self.vectors2)
+        for angle in (0, 90, 180, -270, 33.3):
+            self.assertVectorsAlmostEqual(
+                a.rotate(angle), [v.rotate(angle) for v in self.vectors2])
+        axis = Vector3(1, -2, 0.5)
+        b = Vector3Array(self.vectors3)
+        b.rotate_ip(71, axis)
+        self.assertVectorsAlmostEqual(
+            b, [v.rotate(71, axis) for v in self.vectors3])
+        self.assertRaises(ValueError, b.rotate, 10, (0, 0, 0))
+
+    def testReflect(self):
+        a = Vector2Array(self.vectors2)
+        self.assertVectorsAlmostEqual(
+            a.reflect((1, 2)), [v.reflect((1, 2)) for v in self.vectors2])
+        b = Vector3Array(self.vectors3)
+        b.reflect_ip((0, 3, 4))
+        self.assertVectorsAlmostEqual(
+            b, [v.reflect((0, 3, 4)) for v in self.vectors3])
+        self.assertRaises(ValueError, a.reflect, (0, 0))
+
+    def testLerp(self):
+        a = Vector2Array(self.vectors2)
+        b = a * -2
+        self.assertVectorsAlmostEqual(
+            a.lerp(b, .25), [v.lerp(v * -2, .25) for v in self.vectors2])
+        target = Vector2(4, 5)
+        a.lerp_ip(target, .75)
+        self.assertVectorsAlmostEqual(
+            a, [v.lerp(target, .75) for v in self.vectors2])
+        self.assertRaises(ValueError, a.lerp, b, 1.5)
+
+    def testBuffer(self):
+        try:
+            view = memoryview(Vector2Array(0))
+        except TypeError:
+            return
+        a = Vector2Array([(1, 2), (3, 4), (5, 6)])
+        view = memoryview(a)
+        self.assertEqual(view.shape, (2, 3))
+        self.assertEqual(view.format, 'd')
+        self.assertEqual(view.tolist(), [[1, 3, 5], [2, 4, 6]])
+        view[1, 2] = 7.0
+        self.assertEqual(a[2], Vector2(5, 7))
+        self.assertRaises(BufferError, a.append, (0, 0))
+        del view
+        a.append((0, 0))
+        self.assertEqual(len(a), 4)
+
+
+
+class RotationTest(unittest.TestCase):
+
+    def setUp(self):
+        seed(7)
+        self.vectors2 = [Vector2(random() * 20 - 10, random() * 20 - 10)
+                         for i in range(21)]
+        self.vectors3 = [Vector3(random() * 20 - 10, random() * 20 - 10,
+                                 random() * 20 - 10) for i in range(21)]
+
+    def testRotation2(self):
+        for angle in (0, 90, 180, -270, 33.3, 725):
+            rotation = Rotation2(angle)
+            self.assertEqual(rotation.angle, angle)
+            for v in self.vectors2:
+                self.assertEqual(tuple(rotation.apply(v)),
+                                 tuple(v.rotate(angle)))
+            self.assertEqual(rotation.apply((1, 2)),
+                             Vector2(1, 2).rotate(angle))
+            array = Vector2Array(self.vectors2)
+            rotation.apply_ip(array)
+            self.assertEqual(list(array),
+                             [v.rotate(angle) for v in self.vectors2])
+            rotated = rotation.apply(Vector2Array(self.vectors2))
+            self.assertEqual(list(rotated), list(array))
+        rotation = Rotation2(math.pi / 3, radians=True)
+        self.assertAlmostEqual(rotation.angle, 60)
+        self.assertEqual(rotation.apply(self.vectors2[0]),
+                         self.vectors2[0].rotate_rad(math.pi / 3))
+        self.assertRaises(TypeError, rotation.apply, "ab")
+        self.assertRaises(TypeError, rotation.apply, Vector3())
+
+    def testRotation3(self):
+        axis = Vector3(1, -2, 0.5)
+        for angle in (0, 90, 180, 270, 71):
+            rotation = Rotation3(angle, axis)
+            self.assertEqual(rotation.axis, axis)
+            for v in self.vectors3:
+                self.assertEqual(tuple(rotation.apply(v)),
+                                 tuple(v.rotate(angle, axis)))
+            v = Vector3(self.vectors3[0])
+            rotation.apply_ip(v)
+            self.assertEqual(v, self.vectors3[0].rotate(angle, axis))
+        self.assertRaises(ValueError, Rotation3, 10, (0, 0, 0))
+        self.assertRaises(TypeError, Rotation3, 10, (0, 0))
+
+    def testInverse(self):
+        rotation = Rotation3(40, (0, 1, 1))
+        v = Vector3(1, 2, 3)
+        rotation.apply_ip(v)
+        rotation.inverse().apply_ip(v)
+        self.assertEqual(v, (1, 2, 3))
+        self.assertEqual(Rotation2(25).inverse().angle, -25)
+
+    def testApplyBuffer(self):
+        import array
+        rotation = Rotation2(33)
+        points = array.array('d', [c for v in self.vectors2 for c in v])
+        try:
+            rotation.apply_ip(points)
+        except TypeError:
+            # no new buffer protocol
+            return
+        for i, v in enumerate(self.vectors2):
+            self.assertEqual((points[2 * i], points[2 * i + 1]),
+                             tuple(v.rotate(33)))
+        points = array.array('f', [c for v in self.vectors3 for c in v])
+        Rotation3(33, (0, 0, 1)).apply_ip(points)
+        for i, v in enumerate(self.vectors3):
+            for a, b in zip(points[3 * i:3 * i + 3], v.rotate(33, (0, 0, 1))):
+                self.assertAlmostEqual(a, b, 4)
+        self.assertRaises(ValueError, rotation.apply_ip,
+                          array.array('d', [1, 2, 3]))
+        self.assertRaises(TypeError, rotation.apply_ip,
+                          array.array('i', [1, 2]))
+
+
+
 
 
 
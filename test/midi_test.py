@@ -167,6 +167,34 @@ class MidiTest( unittest.TestCase ):
             o.write_short(0x90,65,100)
             o.write_short(0x80,65,100)
 
+    def test_write_buffer(self):
+        """|tags: interactive|
+        """
+        import struct
+
+        i = pygame.midi.get_default_output_id()
+        if i != -1:
+            o = pygame.midi.Output(i)
+            # put a note on, then off, packed as two records.
+            records = struct.pack("=" + pygame.midi.RECORD_FORMAT[1:] * 2,
+                                  0x644190, 0, 0x644180, 0)
+            self.assertEqual(o.write_buffer(records), 2)
+            # a partial record at the end is ignored.
+            self.assertEqual(o.write_buffer(records[:-1]), 1)
+            del o
+
+    def test_read_into(self):
+        """|tags: interactive|
+        """
+        i = pygame.midi.get_default_input_id()
+        if i != -1:
+            midi_in = pygame.midi.Input(i)
+            buf = bytearray(8 * 16)
+            n = midi_in.read_into(buf)
+            self.assertTrue(0 <= n <= 16)
+            self.assertRaises(TypeError, midi_in.read_into, b'\0' * 8)
+            del midi_in
+
 
 
 
@@ -51,22 +51,31 @@ class MixerMusicModuleTest(unittest.TestCase):
             #pygame.mixer.music.load(musf)
         pygame.mixer.quit()
 
-    def todo_test_queue(self):
-
-        # __doc__ (as of 2008-08-02) for pygame.mixer_music.queue:
-
-          # This will load a music file and queue it. A queued music file will
-          # begin as soon as the current music naturally ends. If the current
-          # music is ever stopped or changed, the queued song will be lost.
-          # 
-          # The following example will play music by Bach six times, then play
-          # music by Mozart once:
-          # 
-          #     pygame.mixer.music.load('bach.ogg')
-          #     pygame.mixer.music.play(5)        # Plays six times, not five!
-          #     pygame.mixer.music.queue('mozart.ogg')
-
-        self.fail() 
+    def test_queue(self):
+        data_fname = example_path('data')
+        ogg = os.path.join(data_fname, 'house_lo.ogg')
+        wav = os.path.join(data_fname, 'house_lo.wav')
+        pygame.mixer.init()
+        try:
+            pygame.mixer.music.load(ogg)
+            pygame.mixer.music.queue(wav)
+            pygame.mixer.music.queue(ogg, loops=1)
+            pygame.mixer.music.queue(wav)
+            pygame.mixer.music.play()
+            self.assertTrue(pygame.mixer.music.get_busy())
+            self.assertTrue(pygame.mixer.music.get_pos() >= 0)
+
+            # Stopping drops the queue rather than starting the next file
+            pygame.mixer.music.stop()
+            self.assertFalse(pygame.mixer.music.get_busy())
+            self.assertEqual(pygame.mixer.music.get_pos(), -1)
+
+            pygame.mixer.music.queue(wav)
+            pygame.mixer.music.load(ogg)
+            self.assertRaises(pygame.error, pygame.mixer.music.queue,
+                              os.path.join(data_fname, 'not_a_file.ogg'))
+        finally:
+            pygame.mixer.quit()
 
     def todo_test_stop(self):
 
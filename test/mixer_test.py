@@ -160,6 +160,81 @@ class MixerModuleTest(unittest.TestCase):
 
         mixer.quit()
 
+    def test_get_latency(self):
+        mixer.init(22050, -16, 2, 1024)
+        try:
+            latency = mixer.get_latency()
+            # Either the requested buffer or the one the device asked for
+            self.assert_(latency > 0.0)
+            self.assert_(latency < 1.0)
+        finally:
+            mixer.quit()
+        self.assertRaises(pygame.error, mixer.get_latency)
+
+    def test_callback_stats(self):
+        mixer.init()
+        try:
+            stats = mixer.get_callback_stats()
+            self.assertEqual(sorted(stats.keys()),
+                             ['callbacks', 'frames', 'histogram',
+                              'max_interval', 'mean_interval', 'underruns'])
+            self.assertEqual(len(stats['histogram']), 12)
+            self.assert_(sum(stats['histogram']) <= stats['callbacks'])
+            self.assert_(stats['underruns'] <= stats['callbacks'])
+            mixer.reset_callback_stats()
+            stats = mixer.get_callback_stats()
+            self.assert_(stats['max_interval'] >= stats['mean_interval'])
+        finally:
+            mixer.quit()
+        self.assertRaises(pygame.error, mixer.get_callback_stats)
+        self.assertRaises(pygame.error, mixer.reset_callback_stats)
+
+    def test_steal_policy(self):
+        mixer.init(22050, -16, 2)
+        try:
+            self.assertEqual(mixer.get_steal_policy(), 'none')
+            self.assertRaises(ValueError, mixer.set_steal_policy, 'newest')
+            mixer.set_num_channels(4)
+            mixer.set_reserved(1)
+            low = mixer.Sound(buffer=as_bytes('\x00\x10') * 4096)
+            high = mixer.Sound(buffer=as_bytes('\x00\x10') * 4096)
+            high.set_priority(5)
+            self.assertEqual(high.get_priority(), 5)
+            self.assertEqual(low.get_max_instances(), 0)
+            self.assertRaises(ValueError, low.set_max_instances, -1)
+
+            # The reserved channel is left alone
+            for i in range(3):
+                self.failIf(low.play(-1) is None)
+            self.failIf(mixer.Channel(0).get_busy())
+            self.assert_(high.play(-1) is None)
+            self.assert_(mixer.find_channel() is None)
+            self.failIf(mixer.find_channel(True) is None)
+
+            mixer.set_steal_policy('priority')
+            self.assertEqual(mixer.get_steal_policy(), 'priority')
+            self.failIf(high.play(-1) is None)
+            self.assertEqual(low.get_num_channels(), 2)
+            quiet = mixer.Sound(buffer=as_bytes('\x00\x10') * 4096)
+            quiet.set_priority(-1)
+            self.assert_(quiet.play() is None)
+
+            # At the limit a Sound takes one of its own channels
+            high.set_max_instances(1)
+            self.assertEqual(high.get_max_instances(), 1)
+            self.failIf(high.play(-1) is None)
+            self.assertEqual(low.get_num_channels(), 2)
+
+            mixer.set_steal_policy('quietest')
+            mixer.Channel(2).set_volume(0.25)
+            self.failIf(mixer.find_channel(True) is None)
+            mixer.stop()
+            self.failIf(mixer.find_channel() is None)
+            self.failIf(mixer.Channel(0).get_busy())
+        finally:
+            mixer.set_steal_policy('none')
+            mixer.quit()
+
     def test_quit(self):
         """ get_num_channels() Should throw pygame.error if uninitialized
         after mixer.quit() """
@@ -530,6 +605,156 @@ class MixerModuleTest(unittest.TestCase):
         finally:
             mixer.quit()
 
+    def test_get_raw__view(self):
+        mixer.init()
+        try:
+            samples = as_bytes('abcdefgh')
+            snd = mixer.Sound(buffer=samples)
+            view = snd.get_raw(copy=False)
+            self.assertTrue(isinstance(view, pygame.BufferProxy))
+            self.assertEqual(view.length, len(samples))
+            self.assertEqual(view.raw, samples)
+            self.assertTrue(view.parent is snd)
+            inter = view.__array_interface__
+            self.assertEqual(inter['data'], (snd._samples_address, True))
+            self.assertRaises(pygame.BufferError, view.write, as_bytes('x'))
+        finally:
+            mixer.quit()
+
+    def test_write(self):
+        mixer.init(22050, -16, 2)
+        try:
+            snd = mixer.Sound(buffer=as_bytes('abcdefgh'))
+            snd.write(2, as_bytes('XY'))
+            self.assertEqual(snd.get_raw(), as_bytes('abXYefgh'))
+            # A subsound from the second 4 byte frame
+            snd.subsound(1).write(0, as_bytes('12'))
+            self.assertEqual(snd.get_raw(), as_bytes('abXY12gh'))
+            self.assertRaises(ValueError, snd.write, 7, as_bytes('XY'))
+            self.assertRaises(ValueError, snd.write, -1, as_bytes('X'))
+            snd.play(-1)
+            self.assertRaises(pygame.error, snd.write, 0, as_bytes('XY'))
+            snd.stop()
+            snd.write(0, as_bytes('XY'))
+        finally:
+            mixer.quit()
+
+    def test_sound_compressed(self):
+        mixer.init()
+        try:
+            wave_path = example_path(os.path.join('data', 'house_lo.wav'))
+            snd_bytes = mixer.Sound(wave_path).get_raw()
+            snd = mixer.Sound(wave_path, compressed=True)
+            self.assertEqual(snd.get_raw(), snd_bytes)
+            f = open(wave_path, 'rb')
+            try:
+                snd = mixer.Sound(file=f, compressed=True)
+            finally:
+                f.close()
+            self.assertTrue(snd.get_length() > 0.5)
+            self.assertEqual(snd.get_raw(), snd_bytes)
+            self.assertRaises(TypeError, mixer.Sound,
+                              buffer=snd_bytes, compressed=True)
+
+            # Not a sound file, found out when decoded
+            png_path = example_path(os.path.join('data', 'brick.png'))
+            snd = mixer.Sound(png_path, compressed=True)
+            self.assertRaises(pygame.error, snd.play)
+        finally:
+            mixer.quit()
+
+    def test_sound_stream(self):
+        mixer.init()
+        try:
+            wave_path = example_path(os.path.join('data', 'house_lo.wav'))
+            length = mixer.Sound(wave_path).get_length()
+            snd = mixer.Sound(wave_path, stream=True)
+            self.assertAlmostEqual(snd.get_length(), length, places=2)
+            channel = snd.play(loops=1)
+            self.assertTrue(channel is None or channel.get_sound() is snd)
+            snd.set_volume(0.5)
+            self.assertAlmostEqual(snd.get_volume(), 0.5, places=1)
+            snd.play()
+            self.assertRaises(pygame.error, snd.get_raw)
+            self.assertRaises(pygame.error, mixer.Channel(0).queue, snd)
+            snd.stop()
+
+            f = open(wave_path, 'rb')
+            try:
+                snd = mixer.Sound(file=f, stream=True)
+                mixer.Channel(1).play(snd)
+                snd.stop()
+                del snd
+            finally:
+                f.close()
+
+            self.assertRaises(TypeError, mixer.Sound,
+                              buffer=as_bytes('\x00') * 16, stream=True)
+            self.assertRaises(TypeError, mixer.Sound, wave_path,
+                              stream=True, compressed=True)
+            png_path = example_path(os.path.join('data', 'brick.png'))
+            self.assertRaises(pygame.error, mixer.Sound, png_path,
+                              stream=True)
+        finally:
+            mixer.quit()
+
+    def test_sound_shared(self):
+        mixer.init(22050, -16, 2)
+        try:
+            bank = bytearray(4 * 1000)
+            snd = mixer.Sound(buffer=bank, copy=False)
+            self.assertEqual(snd.get_raw(), bytes_(bank))
+            bank[0:4] = as_bytes('\x01\x02\x03\x04')
+            self.assertEqual(snd.get_raw()[:4], as_bytes('\x01\x02\x03\x04'))
+
+            sub = snd.subsound(100, 50)
+            self.assertEqual(len(sub.get_raw()), 4 * 50)
+            bank[400:404] = as_bytes('\x05\x06\x07\x08')
+            self.assertEqual(sub.get_raw()[:4], as_bytes('\x05\x06\x07\x08'))
+            self.assertEqual(len(snd.subsound(990).get_raw()), 4 * 10)
+            self.assertEqual(len(sub.subsound(10).get_raw()), 4 * 40)
+            del snd
+            self.assertEqual(sub.get_raw()[:4], as_bytes('\x05\x06\x07\x08'))
+            self.assertRaises(ValueError, sub.subsound, -1)
+            self.assertRaises(ValueError, sub.subsound, 51)
+            self.assertRaises(ValueError, sub.subsound, 10, 41)
+
+            wave_path = example_path(os.path.join('data', 'house_lo.wav'))
+            self.assertRaises(TypeError, mixer.Sound, wave_path, copy=False)
+            snd = mixer.Sound(wave_path)
+            self.assertEqual(snd.subsound(0).get_raw(), snd.get_raw())
+        finally:
+            mixer.quit()
+
+    def test_load_many(self):
+        names = ['house_lo.wav', 'boom.wav', 'punch.wav', 'whiff.wav']
+        paths = [example_path(os.path.join('data', n)) for n in names]
+        mixer.init()
+        try:
+            expected = [mixer.Sound(p).get_raw() for p in paths]
+            finished = []
+            sounds = mixer.load_many(paths,
+                                     lambda i, s: finished.append((i, s)))
+            self.assertEqual([s.get_raw() for s in sounds], expected)
+            self.assertEqual(sorted(i for i, s in finished),
+                             list(range(len(paths))))
+            for i, s in finished:
+                self.assertTrue(sounds[i] is s)
+
+            sounds = mixer.load_many(paths, compressed=True)
+            self.assertEqual([s.get_raw() for s in sounds], expected)
+            self.assertEqual(mixer.load_many([]), [])
+
+            self.assertRaises(pygame.error, mixer.load_many,
+                              paths + ['no_such_file.wav'])
+            self.assertRaises(TypeError, mixer.load_many, [1])
+            def fail(i, s):
+                raise ValueError(i)
+            self.assertRaises(ValueError, mixer.load_many, paths, fail)
+        finally:
+            mixer.quit()
+        self.assertRaises(pygame.error, mixer.load_many, paths)
+
     def todo_test_fadeout(self):
 
         # __doc__ (as of 2008-08-02) for pygame.mixer.fadeout:
@@ -923,6 +1148,40 @@ class ChannelTypeTest(unittest.TestCase):
 
         self.fail()
 
+    def test_effects(self):
+        mixer.init(22050, -16, 2)
+        try:
+            channel = mixer.Channel(0)
+            channel.set_gain(0.5, 0.1)
+            channel.set_pan(-0.5)
+            channel.set_distance(2.0, rolloff=0.5)
+            channel.set_filter('lowpass', 2000.0)
+            channel.set_filter('highpass', frequency=200.0, q=1.0)
+            sound = mixer.Sound(buffer=as_bytes('\x00\x10') * 4096)
+            channel.play(sound)
+            channel.queue(sound)
+            channel.set_filter(None)
+            channel.stop()
+            self.assertRaises(ValueError, channel.set_gain, -1.0)
+            self.assertRaises(ValueError, channel.set_gain, 1.0, -1.0)
+            self.assertRaises(ValueError, channel.set_distance, -1.0)
+            self.assertRaises(ValueError, channel.set_filter, 'bandpass')
+            self.assertRaises(ValueError, channel.set_filter, 'lowpass', 0.0)
+            self.assertRaises(ValueError, channel.set_filter,
+                              'lowpass', 11025.0)
+            self.assertRaises(ValueError, channel.set_filter,
+                              'lowpass', 1000.0, 0.0)
+            channel.clear_effects()
+            channel.clear_effects()
+        finally:
+            mixer.quit()
+
+        mixer.init(22050, 8, 2)
+        try:
+            self.assertRaises(pygame.error, mixer.Channel(0).set_pan, 0.5)
+        finally:
+            mixer.quit()
+
 ############################### SOUND CLASS TESTS ##############################
 
 class SoundTypeTest(unittest.TestCase):
@@ -13,11 +13,21 @@ else:
     is_pygame_pkg = __name__.startswith('pygame.tests.')
 
 import unittest
+import array
+import pygame
+from pygame.compat import as_bytes
 
 ################################################################################
 
 class OverlayTypeTest(unittest.TestCase):
-    def todo_test_display(self):
+    def setUp(self):
+        pygame.display.init()
+        pygame.display.set_mode((8, 6))
+
+    def tearDown(self):
+        pygame.display.quit()
+
+    def test_display(self):
 
         # __doc__ (as of 2008-08-02) for pygame.overlay.overlay.display:
 
@@ -25,7 +35,22 @@ class OverlayTypeTest(unittest.TestCase):
           # Overlay.display(): return None
           # set the overlay pixel data
 
-        self.fail() 
+        o = pygame.Overlay(pygame.YV12_OVERLAY, (4, 2))
+        o.display((as_bytes('\x10' * 8), as_bytes('\x80' * 2),
+                   bytearray(as_bytes('\x80' * 2))))
+        o.display([array.array('B', [16] * 8), as_bytes('\x80\x80'),
+                   as_bytes('\x80\x80')])
+        o.display()
+        self.assertRaises(ValueError, o.display,
+                          (as_bytes('\x10' * 4), as_bytes('\x80' * 2),
+                           as_bytes('\x80' * 2)))
+        self.assertRaises(ValueError, o.display, as_bytes('\x10' * 12))
+
+        # A packed format, such as the YUYV frames of a camera, has one plane.
+        o = pygame.Overlay(pygame.YUY2_OVERLAY, (4, 2))
+        o.display(as_bytes('\x10\x80' * 8))
+        o.display((bytearray(as_bytes('\x10\x80' * 8)),))
+        self.assertRaises(ValueError, o.display, as_bytes('\x10\x80' * 4))
 
     def todo_test_get_hardware(self):
 
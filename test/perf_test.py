@@ -0,0 +1,81 @@
+#################################### IMPORTS ###################################
+
+if __name__ == '__main__':
+    import sys
+    import os
+    pkg_dir = os.path.split(os.path.abspath(__file__))[0]
+    parent_dir, pkg_name = os.path.split(pkg_dir)
+    is_pygame_pkg = (pkg_name == 'tests' and
+                     os.path.split(parent_dir)[1] == 'pygame')
+    if not is_pygame_pkg:
+        sys.path.insert(0, parent_dir)
+else:
+    is_pygame_pkg = __name__.startswith('pygame.tests.')
+
+import unittest
+import pygame
+from pygame import perf
+
+################################################################################
+
+class PerfModuleTest(unittest.TestCase):
+    def setUp(self):
+        self.was_enabled = perf.get_enabled()
+
+    def tearDown(self):
+        if self.was_enabled:
+            perf.enable()
+        else:
+            perf.disable()
+
+    def test_enable(self):
+        perf.enable()
+        self.assertTrue(perf.get_enabled())
+        perf.disable()
+        self.assertFalse(perf.get_enabled())
+
+    def test_snapshot(self):
+        counts = perf.snapshot()
+        for name in ['blit.calls', 'blit.seconds', 'blit.pixels.none',
+                     'blit.pixels.BLEND_RGBA_MAX', 'fill.pixels',
+                     'smoothscale.calls', 'display.pixels', 'event.events',
+                     'freetype.glyphs', 'freetype.cache_hits']:
+            self.assertTrue(name in counts, name)
+        self.assertTrue(isinstance(counts['blit.seconds'], float))
+        counts['blit.calls'] = -1
+        self.assertNotEqual(perf.snapshot()['blit.calls'], -1)
+
+    def test_counts(self):
+        dst = pygame.Surface((20, 10), 0, 32)
+        src = pygame.Surface((5, 4), 0, 32)
+
+        perf.reset()
+        perf.enable()
+        dst.fill((1, 2, 3))
+        dst.fill((1, 2, 3), (15, 5, 10, 10))
+        dst.blit(src, (0, 0))
+        dst.blit(src, (18, 0), None, pygame.BLEND_RGBA_MAX)
+        pygame.transform.smoothscale(src, (8, 3))
+        perf.disable()
+        dst.fill((1, 2, 3))
+        dst.blit(src, (0, 0))
+
+        counts = perf.snapshot()
+        self.assertEqual(counts['fill.calls'], 2)
+        self.assertEqual(counts['fill.pixels'], 20 * 10 + 5 * 5)
+        self.assertEqual(counts['blit.calls'], 2)
+        self.assertEqual(counts['blit.pixels.none'], 5 * 4)
+        self.assertEqual(counts['blit.pixels.BLEND_RGBA_MAX'], 2 * 4)
+        self.assertEqual(counts['smoothscale.calls'], 1)
+        self.assertEqual(counts['smoothscale.pixels'], 8 * 3)
+        self.assertTrue(counts['fill.seconds'] >= 0.0)
+
+        perf.reset()
+        counts = perf.snapshot()
+        self.assertEqual(counts['fill.calls'], 0)
+        self.assertEqual(counts['blit.seconds'], 0.0)
+
+################################################################################
+
+if __name__ == '__main__':
+    unittest.main()
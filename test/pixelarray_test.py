@@ -69,6 +69,67 @@ class PixelArrayTypeTest (unittest.TestCase, TestMixin):
         # FINISH ME!
         # Test other bit depths, slices, and distance != 0.
 
+    def test_compare__distance(self):
+        # Pixels are the same within distance of the weighted euclidean
+        # distance of their colors, and at distance 0 only when equal.
+        size = 9, 7
+        for bpp in (16, 24, 32):
+            sf = pygame.Surface(size, 0, bpp)
+            sf2 = pygame.Surface(size, 0, bpp)
+            sf.fill((100, 100, 100))
+            sf2.fill((100, 100, 100))
+            sf2.fill((100, 100, 180), (1, 1, 5, 3))
+            sf2.fill((100, 108, 100), (7, 0, 2, 7))
+            white = sf.map_rgb((255, 255, 255))
+            black = sf.map_rgb((0, 0, 0))
+            ar = pygame.PixelArray(sf)
+            ar2 = pygame.PixelArray(sf2)
+
+            for distance in (0.0, 0.1):
+                ar3 = ar.compare(ar2, distance, (1, 1, 1))
+                self.assertEqual(ar3[3, 2], black)
+                self.assertEqual(ar3[0, 0], white)
+                self.assertEqual(ar3[8, 6], distance and white or black)
+                self.assertEqual(ar3[6, 6], white)
+
+            # A slice compares against the same slice of the other.
+            ar3 = ar[1::2, ::3].compare(ar2[1::2, ::3], 0.02)
+            self.assertEqual(ar3.shape, (4, 3))
+            self.assertEqual(ar3[1, 0], white)
+            self.assertEqual(ar3[1, 1], black)
+            self.assertEqual(ar3[3, 1], black)
+            del ar, ar2, ar3
+
+    def test_replace_extract__distance(self):
+        # The distance test is sqrt(sum weight * diff ** 2) / 255 <= distance,
+        # with distance a C float, including on its edge.
+        from math import sqrt
+        from struct import pack, unpack
+
+        distance = unpack('f', pack('f', 80 / 255.0))[0]
+        for bpp in (8, 16, 24, 32):
+            sf = pygame.Surface((12, 3), 0, bpp)
+            sf.fill((0, 0, 0))
+            for x in range(12):
+                sf.set_at((x, 1), (0, x * 16, 0))
+            within = []
+            for x in range(12):
+                r, g, b, a = sf.get_at((x, 1))
+                within.append(sqrt(r * r + g * g + b * b) / 255.0 <= distance)
+            self.assertTrue(True in within and False in within)
+            red = sf.map_rgb((255, 0, 0))
+            ar = pygame.PixelArray(sf)
+            newar = ar.extract((0, 0, 0), distance, (1, 1, 1))
+            white = newar.surface.map_rgb((255, 255, 255))
+            for x in range(12):
+                self.assertEqual(newar[x, 1] == white, within[x])
+                self.assertEqual(newar[x, 0], white)
+            del newar
+            ar.replace((0, 0, 0), (255, 0, 0), distance, (1, 1, 1))
+            for x in range(12):
+                self.assertEqual(ar[x, 1] == red, within[x])
+            del ar
+
     def test_pixel_array (self):
         for bpp in (8, 16, 24, 32):
             sf = pygame.Surface ((10, 20), 0, bpp)
@@ -974,6 +1035,103 @@ class PixelArrayTypeTest (unittest.TestCase, TestMixin):
         self.assertEqual(repr (ar),
                          type (ar).__name__ + "([\n  [42, 42, 42]]\n)")
 
+    def test_read_write_rect (self):
+        from array import array
+        for bpp in (8, 16, 24, 32):
+            sf = pygame.Surface ((7, 5), 0, bpp)
+            ar = pygame.PixelArray (sf)
+            for x in range (7):
+                for y in range (5):
+                    ar[x, y] = (x + y * 7) % 8
+            values = array ('I', [0] * 35)
+            ar.read_rect (values)
+            self.assertEqual (list (values),
+                              [ar[x, y] for y in range (5) for x in range (7)])
+
+            part = array ('I', [0] * 6)
+            ar.read_rect (part, (2, 1, 3, 2))
+            self.assertEqual (list (part),
+                              [ar[x, y] for y in (1, 2) for x in (2, 3, 4)])
+            ar.write_rect (array ('I', [1] * 6), pygame.Rect (4, 3, 3, 2))
+            for x in range (7):
+                for y in range (5):
+                    expected = 1 if x >= 4 and y >= 3 else (x + y * 7) % 8
+                    self.assertEqual (ar[x, y], expected)
+
+            # Strided views read and write their own pixels
+            view = ar[::2, ::-1]
+            values = array ('I', [0] * 20)
+            view.read_rect (values)
+            self.assertEqual (list (values), [view[x, y] for y in range (5)
+                                              for x in range (4)])
+            view.write_rect (array ('I', range (20)))
+            self.assertEqual (ar[0, 4], 0)
+            self.assertEqual (ar[6, 0], 19)
+            del view, ar
+
+        ar = pygame.PixelArray (pygame.Surface ((4, 4), 0, 32))
+        self.assertRaises (IndexError, ar.read_rect, array ('I', [0] * 16),
+                           (1, 1, 4, 4))
+        self.assertRaises (ValueError, ar.read_rect, array ('I', [0] * 15))
+        self.assertRaises (TypeError, ar.read_rect, array ('d', [0] * 16))
+        self.assertRaises (TypeError, ar.read_rect, bytearray (64))
+
+    def test_read_write_points (self):
+        from array import array
+        for bpp in (8, 16, 24, 32):
+            sf = pygame.Surface ((6, 4), 0, bpp)
+            ar = pygame.PixelArray (sf)
+            points = array ('i', [0, 0, 5, 3, 2, 1, 5, 3])
+            ar.write_points (points, array ('I', [1, 2, 3, 4]))
+            self.assertEqual ((ar[0, 0], ar[2, 1], ar[5, 3]), (1, 3, 4))
+            self.assertEqual (ar[1, 1], 0)
+            values = array ('I', [9] * 4)
+            ar.read_points (points, values)
+            self.assertEqual (list (values), [1, 4, 3, 4])
+            ar.write_points (array ('i', [1, 1, 3, 2]), 5)
+            self.assertEqual ((ar[1, 1], ar[3, 2]), (5, 5))
+            if bpp > 8:
+                ar.write_points (array ('i', [4, 0]), (255, 255, 255))
+                self.assertEqual (sf.get_at ((4, 0)), (255, 255, 255, 255))
+            del ar
+
+        ar = pygame.PixelArray (pygame.Surface ((6, 4), 0, 32))
+        self.assertRaises (IndexError, ar.read_points,
+                           array ('i', [6, 0]), array ('I', [0]))
+        self.assertRaises (IndexError, ar.write_points,
+                           array ('i', [0, -1]), 0)
+        self.assertRaises (ValueError, ar.write_points,
+                           array ('i', [0, 0, 1]), 0)
+        self.assertRaises (ValueError, ar.read_points,
+                           array ('i', [0, 0, 1, 1]), array ('I', [0]))
+
+        # one dimensional arrays take y = 0
+        column = ar[2]
+        column.write_points (array ('i', [3, 0]), 7)
+        self.assertEqual (ar[2, 3], 7)
+
+    def test_freelist (self):
+        from pygame import pixelarray
+        old_size = pixelarray.get_freelist_stats ()[0]
+        try:
+            pixelarray.set_freelist_size (4)
+            sf = pygame.Surface ((5, 5), 0, 32)
+            ar = pygame.PixelArray (sf)
+            views = [ar[i] for i in range (5)]
+            del views
+            size, count, hits, misses = pixelarray.get_freelist_stats ()
+            self.assertEqual ((size, count), (4, 4))
+            ar[1, 1] = 3
+            self.assertEqual (ar[1][1], 3)
+            self.assertTrue (pixelarray.get_freelist_stats ()[2] > hits)
+            gc.collect ()
+            pixelarray.set_freelist_size (0)
+            self.assertEqual (pixelarray.get_freelist_stats ()[:2], (0, 0))
+            del ar
+            self.assertFalse (sf.get_locked ())
+        finally:
+            pixelarray.set_freelist_size (old_size)
+
 class PixelArrayArrayInterfaceTest (unittest.TestCase, TestMixin):
     def test_basic (self):
         # Check unchanging fields.
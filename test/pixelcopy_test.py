@@ -270,6 +270,65 @@ class PixelcopyModuleTest (unittest.TestCase):
                 for y in range(h):
                     self.assertEqual(target.get_at_mapped((x, y)), p)
 
+    def test_copy_row_layouts(self):
+        # Arrays laid out like the surface rows are copied a row at a time
+        w, h = self.surf_size
+        for bitsize in [8, 16, 24, 32]:
+            source = self._make_surface(bitsize)
+            for x in range(w):
+                for y in range(h):
+                    source.set_at((x, y), (x * 20, y * 20, x * y))
+            array = pygame.Surface(self.surf_size, 0, bitsize)
+            surface_to_array(array.get_view('2'), source)
+            target = self._make_surface(bitsize)
+            array_to_surface(target, array.get_view('2'))
+            for x in range(w):
+                for y in range(h):
+                    p = source.get_at_mapped((x, y))
+                    self.assertEqual(array.get_at_mapped((x, y)), p)
+                    self.assertEqual(target.get_at_mapped((x, y)), p)
+
+        # Packed RGB bytes to 32 bit pixels, and back
+        source = pygame.Surface(self.surf_size, 0, 24)
+        for x in range(w):
+            for y in range(h):
+                source.set_at((x, y), (x * 20, y * 20, x * y))
+        for flags in [0, SRCALPHA]:
+            target = pygame.Surface(self.surf_size, flags, 32)
+            array_to_surface(target, source.get_view('3'))
+            back = pygame.Surface(self.surf_size, 0, 24)
+            surface_to_array(back.get_view('3'), target)
+            for x in range(w):
+                for y in range(h):
+                    self.assertEqual(target.get_at((x, y)),
+                                     source.get_at((x, y)))
+                    self.assertEqual(back.get_at((x, y)),
+                                     source.get_at((x, y)))
+
+    def test_copy_threads(self):
+        threads = pygame.pixelcopy.get_copy_threads()
+        self.assertRaises(ValueError, pygame.pixelcopy.set_copy_threads, -1)
+        size = (300, 300)
+        source = pygame.Surface(size, 0, 24)
+        for y in range(0, size[1], 7):
+            source.fill((y, 255 - y, y // 2), (0, y, size[0], 3))
+        results = []
+        try:
+            for count in [0, 4]:
+                pygame.pixelcopy.set_copy_threads(count)
+                self.assertEqual(pygame.pixelcopy.get_copy_threads(), count)
+                target = pygame.Surface(size, 0, 32)
+                array_to_surface(target, source.get_view('3'))
+                mapped = pygame.Surface(size, 0, 32)
+                map_array(mapped.get_view('2'), source.get_view('3'), target)
+                results.append((pygame.image.tostring(target, 'RGB'),
+                                pygame.image.tostring(mapped, 'RGB')))
+        finally:
+            pygame.pixelcopy.set_copy_threads(threads)
+        self.assertEqual(results[0], results[1])
+        self.assertEqual(results[0][0], pygame.image.tostring(source, 'RGB'))
+        self.assertEqual(results[0][1], results[0][0])
+
 
 class PixelCopyTestWithArray(unittest.TestCase):
     try:
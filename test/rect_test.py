@@ -11,7 +11,8 @@ else:
     is_pygame_pkg = __name__.startswith('pygame.tests.')
 
 import unittest
-from pygame import Rect
+import random
+from pygame import Rect, RectArray
 
 class RectTypeTest( unittest.TestCase ):
     def testConstructionXYWidthHeight( self ):
@@ -641,6 +642,71 @@ class RectTypeTest( unittest.TestCase ):
         self.assertFalse(r.collidelistall(f))
 
 
+    def test_collidelist__key(self):
+        class Sprite(object):
+            def __init__(self, rect):
+                self.rect = rect
+        random.seed(3)
+        rects = [Rect(random.randrange(100), random.randrange(100),
+                      random.randrange(1, 20), random.randrange(1, 20))
+                 for i in range(300)]
+        sprites = [Sprite(r) for r in rects]
+        tuples = [tuple(r) for r in rects]
+        r = Rect(40, 40, 10, 10)
+        expected = [i for i, s in enumerate(rects) if r.colliderect(s)]
+
+        self.assertEqual(r.collidelistall(rects), expected)
+        self.assertEqual(r.collidelistall(tuples), expected)
+        self.assertEqual(r.collidelistall(sprites), expected)
+        self.assertEqual(r.collidelistall(sprites, key='rect'), expected)
+        self.assertEqual(r.collidelistall(sprites, key=lambda s: s.rect),
+                         expected)
+        self.assertEqual(r.collidelistall(tuples, key=None), expected)
+        self.assertEqual(r.collidelist(sprites, key='rect'), expected[0])
+        self.assertEqual(Rect(-9, -9, 1, 1).collidelist(sprites, key='rect'),
+                         -1)
+        self.assertEqual(r.unionall(sprites, key='rect'), r.unionall(rects))
+        u = Rect(r)
+        u.unionall_ip(sprites, key='rect')
+        self.assertEqual(u, r.unionall(rects))
+
+        self.assertRaises(AttributeError, r.collidelistall, sprites, key='x')
+        self.assertRaises(TypeError, r.collidelistall, sprites, key=len)
+        self.assertRaises(TypeError, r.unionall, [r, 1])
+
+    def test_collidelist__stops_at_hit(self):
+        # Items after the first hit aren't checked
+        r = Rect(0, 0, 10, 10)
+        self.assertEqual(r.collidelist([(20, 20, 1, 1), (1, 1, 1, 1), None]),
+                         1)
+        self.assertRaises(TypeError, r.collidelist, [(20, 20, 1, 1), None])
+
+    def test_collide_pairs(self):
+        from pygame.rect import collide_pairs
+        random.seed(5)
+        rects = [Rect(random.randrange(-50, 50), random.randrange(-50, 50),
+                      random.randrange(-5, 20), random.randrange(-5, 20))
+                 for i in range(200)]
+        expected = [(i, j) for i in range(len(rects))
+                    for j in range(i + 1, len(rects))
+                    if rects[i].colliderect(rects[j])]
+
+        pairs = collide_pairs(rects)
+        self.assertEqual(pairs.typecode, 'i')
+        self.assertEqual(sorted(zip(pairs[::2], pairs[1::2])), expected)
+        self.assertEqual(list(collide_pairs(RectArray(rects))), list(pairs))
+        self.assertEqual(list(collide_pairs([tuple(r) for r in rects])),
+                         list(pairs))
+        class Sprite(object):
+            def __init__(self, rect):
+                self.rect = rect
+        self.assertEqual(list(collide_pairs([Sprite(r) for r in rects],
+                                            key='rect')),
+                         list(pairs))
+        self.assertEqual(len(collide_pairs([])), 0)
+        self.assertEqual(len(collide_pairs([Rect(0, 0, 5, 5)])), 0)
+        self.assertRaises(TypeError, collide_pairs, [Rect(0, 0, 1, 1), 1])
+
     def test_fit(self):
 
         # __doc__ (as of 2008-08-02) for pygame.rect.Rect.fit:
@@ -668,7 +734,122 @@ class RectTypeTest( unittest.TestCase ):
         r = Rect(1, 2, 10, 20)
         c = r.copy()
         self.failUnlessEqual(c, r)
-        
+
+    def test_freelist(self):
+        from pygame import rect
+        old_size = rect.get_freelist_stats()[0]
+        try:
+            rect.set_freelist_size(8)
+            rects = [Rect(i, i, i, i) for i in range(20)]
+            del rects
+            size, count, hits, misses = rect.get_freelist_stats()
+            self.assertEqual((size, count), (8, 8))
+            self.assertEqual(Rect(5, 6, 7, 8), (5, 6, 7, 8))
+            self.assertEqual(Rect(1, 2, 3, 4).move(1, 1), Rect(2, 3, 3, 4))
+            self.assertTrue(rect.get_freelist_stats()[2] > hits)
+            rect.set_freelist_size(0)
+            self.assertEqual(rect.get_freelist_stats()[:2], (0, 0))
+            self.assertRaises(ValueError, rect.set_freelist_size, -1)
+        finally:
+            rect.set_freelist_size(old_size)
+        
+class RectArrayTest(unittest.TestCase):
+    def random_rects(self, n):
+        random.seed(1)
+        return [Rect(random.randrange(-100, 100), random.randrange(-100, 100),
+                     random.randrange(-5, 40), random.randrange(-5, 40))
+                for i in range(n)]
+
+    def test_construction(self):
+        self.assertEqual(len(RectArray()), 0)
+        a = RectArray(5)
+        self.assertEqual(len(a), 5)
+        self.assertEqual(list(a), [Rect(0, 0, 0, 0)] * 5)
+        rects = [Rect(1, 2, 3, 4), (5, 6, 7, 8), [9, 10, 11, 12]]
+        a = RectArray(rects)
+        self.assertEqual(list(a), [Rect(r) for r in rects])
+        b = RectArray(a)
+        self.assertEqual(list(b), list(a))
+        b[0] = (0, 0, 1, 1)
+        self.assertEqual(a[0], Rect(1, 2, 3, 4))
+        self.assertRaises(TypeError, RectArray, [1, 2])
+
+    def test_item(self):
+        a = RectArray([(1, 2, 3, 4), (5, 6, 7, 8)])
+        self.assertEqual(a[1], Rect(5, 6, 7, 8))
+        self.assertEqual(a[-1], Rect(5, 6, 7, 8))
+        self.assertRaises(IndexError, lambda: a[2])
+        a[0] = Rect(10, 20, 30, 40)
+        self.assertEqual(a[0], Rect(10, 20, 30, 40))
+        self.assertRaises(TypeError, a.__setitem__, 0, "x")
+        self.assertRaises(TypeError, a.__delitem__, 0)
+        a.append((0, 1, 2, 3))
+        self.assertEqual(len(a), 3)
+        self.assertEqual(a[2], Rect(0, 1, 2, 3))
+
+    def test_collidepoint(self):
+        rects = self.random_rects(200)
+        a = RectArray(rects)
+        for p in [(0, 0), (10, -10), (50, 50), (-99, 3)]:
+            self.assertEqual(a.collidepoint(p),
+                             [i for i, r in enumerate(rects)
+                              if r.collidepoint(p)])
+        self.assertEqual(a.collidepoint(0, 0), a.collidepoint((0, 0)))
+
+    def test_colliderect(self):
+        rects = self.random_rects(200)
+        a = RectArray(rects)
+        for b in rects[:20] + [Rect(0, 0, 1000, 1000), Rect(0, 0, 0, 0)]:
+            self.assertEqual(a.colliderect(b),
+                             [i for i, r in enumerate(rects)
+                              if r.colliderect(b)])
+            self.assertEqual(a.colliderect(b), b.collidelistall(rects))
+            self.assertEqual(b.collidelistall(a), b.collidelistall(rects))
+            self.assertEqual(b.collidelist(a), b.collidelist(rects))
+
+    def test_clip_union(self):
+        rects = self.random_rects(50)
+        a = RectArray(rects)
+        b = Rect(-20, -10, 60, 70)
+        self.assertEqual(list(a.clip(b)), [r.clip(b) for r in rects])
+        self.assertEqual(list(a.union(b)), [r.union(b) for r in rects])
+
+    def test_unionall(self):
+        self.assertEqual(RectArray().unionall(), Rect(0, 0, 0, 0))
+        rects = self.random_rects(50)
+        a = RectArray(rects)
+        self.assertEqual(a.unionall(), rects[0].unionall(rects[1:]))
+        r = Rect(0, 0, 1, 1)
+        self.assertEqual(r.unionall(a), r.unionall(rects))
+        r.unionall_ip(a)
+        self.assertEqual(r, Rect(0, 0, 1, 1).unionall(rects))
+
+    def test_move_ip(self):
+        rects = self.random_rects(23)
+        a = RectArray(rects)
+        a.move_ip(3, -7)
+        self.assertEqual(list(a), [r.move(3, -7) for r in rects])
+        a.move_ip((-3, 7))
+        self.assertEqual(list(a), rects)
+
+    def test_buffer(self):
+        try:
+            memoryview
+        except NameError:
+            return
+        a = RectArray([(1, 2, 3, 4), (5, 6, 7, 8)])
+        try:
+            m = memoryview(a)
+        except TypeError:
+            return
+        self.assertEqual(m.shape, (2, 4))
+        self.assertEqual(m.format, 'i')
+        self.assertFalse(m.readonly)
+        self.assertRaises(BufferError, a.append, (0, 0, 1, 1))
+        del m
+        a.append((0, 0, 1, 1))
+        self.assertEqual(len(a), 3)
+
 class SubclassTest(unittest.TestCase):
     class MyRect(Rect):
         def __init__(self, *args, **kwds):
@@ -11,9 +11,14 @@ else:
     is_pygame_pkg = __name__.startswith('pygame.tests.')
 
 import unittest
+if is_pygame_pkg:
+    from pygame.tests.test_utils import example_path
+else:
+    from test.test_utils import example_path
 
+import pygame, pygame.image
 from pygame import encode_string, encode_file_path
-from pygame.compat import bytes_, as_bytes, as_unicode
+from pygame.compat import bytes_, as_bytes, as_unicode, get_BytesIO
 
 
 class RWopsEncodeStringTest(unittest.TestCase):
@@ -107,6 +112,36 @@ class RWopsEncodeFilePathTest(unittest.TestCase):
     def test_etype(self):
         b = as_bytes("a\x00b\x00c")
         self.assertRaises(TypeError, encode_file_path, b, TypeError)
-                                   
+
+
+class RWopsBufferTest(unittest.TestCase):
+    def tearDown(self):
+        pygame.set_io_buffer_size(65536)
+
+    def test_io_buffer_size(self):
+        self.assertEqual(pygame.get_io_buffer_size(), 65536)
+        pygame.set_io_buffer_size(0)
+        self.assertEqual(pygame.get_io_buffer_size(), 0)
+        self.assertRaises(ValueError, pygame.set_io_buffer_size, -1)
+
+    def test_load_file_objects(self):
+        # Files read a few bytes at a time through buffers of any size,
+        # and buffer protocol objects with no buffer, give the same image.
+        path = example_path('data/asprite.bmp')
+        expected = pygame.image.load(path)
+        f = open(path, 'rb')
+        try:
+            data = f.read()
+        finally:
+            f.close()
+        BytesIO = get_BytesIO()
+        for size in (0, 1, 7, 4096, 65536):
+            pygame.set_io_buffer_size(size)
+            for obj in (BytesIO(data), bytearray(data)):
+                s = pygame.image.load(obj)
+                self.assertEqual(s.get_size(), expected.get_size())
+                self.assertEqual(pygame.image.tostring(s, 'RGB'),
+                                 pygame.image.tostring(expected, 'RGB'))
+
 if __name__ == '__main__':
     unittest.main()
@@ -149,6 +149,19 @@ class ScrapModuleTest(unittest.TestCase):
         r = scrap.get ("arbitrary buffer")
         self.assertEquals (r, as_bytes("buf"))
 
+    def test_request (self):
+        # Owned data is at hand, so the event comes without waiting.
+        event_type = pygame.USEREVENT + 1
+        scrap.put (pygame.SCRAP_TEXT, as_bytes("Requested"))
+        pygame.event.clear (event_type)
+        scrap.request (pygame.SCRAP_TEXT, event_type)
+        events = pygame.event.get (event_type)
+        self.assertEqual (len (events), 1)
+        self.assertEqual (events[0].code, 1)
+        self.assertEquals (scrap.get (pygame.SCRAP_TEXT),
+                           as_bytes("Requested"))
+        self.assertRaises (ValueError, scrap.request, pygame.SCRAP_TEXT, -1)
+
 class X11InteractiveTest(unittest.TestCase):
     __tags__ = ['ignore', 'subprocess_ignore']
     try:
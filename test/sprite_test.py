@@ -164,6 +164,36 @@ class SpriteCollideTest( unittest.TestCase ):
             )
         )
 
+    def test_collide_circle_ratio__keeps_unscaled_radius(self):
+        # the radius stored on a sprite is not scaled by the ratio
+        sprite.spritecollide(self.s1, self.ag2, dokill = False,
+                             collided = sprite.collide_circle_ratio(2.0))
+        self.assertEqual(self.s1.radius, 0.5 * (50 ** 2 + 10 ** 2) ** 0.5)
+        self.assertEqual(self.s3.radius, 0.5 * (10 ** 2 + 10 ** 2) ** 0.5)
+
+    def test_groupcollide__circle_and_ratio_in_c(self):
+        # pygame._sprite must find the pairs the Python callbacks do
+        if sprite._sprite is None:
+            return
+        ga = sprite.Group()
+        gb = sprite.Group()
+        for i in range(20):
+            s = sprite.Sprite(ga if i % 2 else gb)
+            s.rect = pygame.Rect((i * 37) % 90, (i * 53) % 90,
+                                 5 + i % 7, 3 + i % 5)
+            if i % 3 == 0:
+                s.radius = i % 11
+        callbacks = [sprite.collide_circle, sprite.collide_circle_ratio(0.7),
+                     sprite.collide_rect_ratio(1.5)]
+        for collided in callbacks:
+            expected = {}
+            for a in ga:
+                c = [b for b in gb.sprites() if collided(a, b)]
+                if c:
+                    expected[a] = c
+            self.assertEqual(sprite.groupcollide(ga, gb, False, False,
+                                                 collided), expected)
+
     def test_collide_mask__opaque(self):
         # make some fully opaque sprites that will collide with masks.
         self.s1.image.fill((255,255,255,255))
@@ -777,6 +807,31 @@ class LayeredGroupBase:
         self.LG.change_layer(spr2, 77)
         self.assert_(spr2.layer == 77)
 
+    def test_sort_by_key(self):
+        # test_sort_by_key
+
+        sprites = []
+        for i in range(10):
+            spr = self.sprite()
+            spr.y = (i * 7) % 4
+            self.LG.add(spr, layer=i % 3)
+            sprites.append(spr)
+        before = self.LG.sprites()
+        self.LG.sort_by_key(lambda spr: spr.y)
+        self.assertEqual(self.LG.sprites(),
+                         sorted(before, key=lambda spr: spr.y))
+        for spr in sprites:
+            self.assertEqual(self.LG.get_layer_of_sprite(spr), spr.y)
+        self.assertEqual(self.LG.get_sprites_from_layer(2),
+                         [spr for spr in sprites if spr.y == 2])
+
+        # the layer index must still be right for single changes
+        self.LG.change_layer(sprites[0], 2)
+        self.assertEqual(self.LG.get_sprites_from_layer(2)[-1], sprites[0])
+        self.LG.remove(sprites[5])
+        self.assert_(sprites[5] not in self.LG.sprites())
+        self.assertEqual(len(self.LG.sprites()), 9)
+
     def test_get_top_layer(self):
         # test_get_top_layer
 
@@ -924,6 +979,118 @@ class LayeredDirtyTypeTest__DirtySprite(LayeredGroupBase, unittest.TestCase):
         group.repaint_rect(pygame.Rect(0, 0, 100, 100))
         group.draw(surface)
 
+    def test_draw__c_matches_python(self):
+        # pygame._sprite must draw the same pixels and dirty rects
+        if sprite._sprite is None:
+            return
+
+        def run(speedups):
+            saved = sprite._sprite
+            if not speedups:
+                sprite._sprite = None
+            try:
+                surface = pygame.Surface((60, 60))
+                bgd = pygame.Surface((60, 60))
+                bgd.fill((0, 0, 255))
+                group = sprite.LayeredDirty()
+                updates = sprite.RenderUpdates()
+                sprites = []
+                for i in range(6):
+                    spr = self.sprite()
+                    spr.image = pygame.Surface((12, 8))
+                    spr.image.fill((40 * i, 255 - 40 * i, 100))
+                    spr.rect = spr.image.get_rect(topleft=(7 * i, 5 * i))
+                    if i % 3 == 1:
+                        spr.source_rect = pygame.Rect(2, 1, 6, 5)
+                    if i == 4:
+                        spr.visible = 0
+                    sprites.append(spr)
+                group.add(sprites)
+                updates.add(sprites)
+                results = []
+                for frame in range(4):
+                    for i, spr in enumerate(sprites):
+                        if (frame + i) % 2:
+                            spr.rect.move_ip(3, 1)
+                            spr.dirty = 1
+                    group._use_update = frame != 2
+                    results.append(group.draw(surface, bgd))
+                    results.append([s.dirty for s in sprites])
+                    results.append(updates.draw(surface))
+                pixels = [surface.get_at((x, y))
+                          for x in range(60) for y in range(60)]
+                return results, pixels
+            finally:
+                sprite._sprite = saved
+
+        self.assertEqual(run(True), run(False))
+
+class SpriteBatchTypeTest(unittest.TestCase):
+    def setUp(self):
+        self.batch = None
+        if not hasattr(sprite, 'SpriteBatch'):
+            return
+        self.red = pygame.Surface((10, 10))
+        self.red.fill((255, 0, 0))
+        self.atlas = pygame.Surface((20, 10))
+        self.atlas.fill((0, 255, 0), (10, 0, 10, 10))
+        self.batch = sprite.SpriteBatch([self.red, (self.atlas, (10, 0, 4, 4))])
+
+    def test_add_get_set(self):
+        batch = self.batch
+        if batch is None:
+            return
+        self.assertEqual(batch.add((1.5, 2)), 0)
+        self.assertEqual(batch.add((5, 6), image=1, velocity=(1, -1),
+                                   layer=3, visible=False), 1)
+        self.assertEqual(len(batch), 2)
+        self.assertEqual(batch.get(0), ((1.5, 2.0), (0.0, 0.0), 0, 0, True))
+        self.assertEqual(batch.get(1), ((5.0, 6.0), (1.0, -1.0), 1, 3, False))
+        self.assertEqual(batch.get_rect(0), pygame.Rect(1, 2, 10, 10))
+        self.assertEqual(batch.get_rect(1), pygame.Rect(5, 6, 4, 4))
+        batch.set(0, pos=(-0.5, 0), image=1)
+        self.assertEqual(batch.get_rect(0), pygame.Rect(-1, 0, 4, 4))
+        self.assertRaises(IndexError, batch.get, 2)
+        self.assertRaises(IndexError, batch.add, (0, 0), 2)
+        self.assertRaises(TypeError, batch.set, 0, pos=3, layer=7)
+        self.assertEqual(batch.get(0)[3], 0)
+        batch.remove(0)
+        self.assertEqual(len(batch), 1)
+        self.assertEqual(batch.get(0)[0], (5.0, 6.0))
+
+    def test_update_cull(self):
+        batch = self.batch
+        if batch is None:
+            return
+        batch.add((0, 0), velocity=(10, 0))
+        batch.add((100, 0), velocity=(-10, 5))
+        batch.add((5, 5), visible=False)
+        batch.update(2.5)
+        self.assertEqual(batch.get(0)[0], (25.0, 0.0))
+        self.assertEqual(batch.get(1)[0], (75.0, 12.5))
+        self.assertEqual(batch.cull((0, 0, 30, 30)), [0])
+        self.assertEqual(batch.cull((0, 0, 100, 100)), [0, 1])
+
+    def test_draw(self):
+        batch = self.batch
+        if batch is None:
+            return
+        surface = pygame.Surface((30, 30))
+        batch.add((0, 0), layer=1)
+        batch.add((5, 5), image=1)
+        batch.add((50, 50))
+        rects = batch.draw(surface)
+        self.assertEqual(rects, [pygame.Rect(5, 5, 4, 4),
+                                 pygame.Rect(0, 0, 10, 10)])
+        self.assertEqual(surface.get_at((6, 6)), (255, 0, 0, 255))
+
+        surface.fill((0, 0, 0))
+        rects = batch.draw(surface, pygame.Rect(5, 5, 10, 10))
+        self.assertEqual(rects, [pygame.Rect(0, 0, 4, 4),
+                                 pygame.Rect(0, 0, 5, 5)])
+        self.assertEqual(surface.get_at((1, 1)), (255, 0, 0, 255))
+        self.assertEqual(surface.get_at((6, 6)), (0, 0, 0, 255))
+
 ############################### SPRITE BASE CLASS ##############################
 #
 # tests common between sprite classes
@@ -166,6 +166,35 @@ class SurfaceTypeTest(unittest.TestCase):
         self.assertEqual(bound_rect.width, 31)
         self.assertEqual(bound_rect.height, 31)
 
+    def test_get_bounding_rect_backends(self):
+        """ Each blit backend scans alpha to the same bounding rect.
+        """
+        import pygame.surface
+
+        surf = pygame.Surface((37, 21), SRCALPHA, 32)
+        surf.fill((0, 0, 0, 0))
+        for x, y, a in [(20, 3, 10), (5, 10, 200), (33, 17, 128),
+                        (12, 19, 1), (36, 8, 255)]:
+            surf.set_at((x, y), (255, 255, 255, a))
+        sub = surf.subsurface((3, 2, 31, 17))
+        expected = {-5: Rect(0, 0, 37, 21), 0: Rect(0, 0, 37, 21),
+                    1: Rect(5, 3, 32, 17), 11: Rect(5, 8, 32, 10),
+                    129: Rect(5, 8, 32, 3), 255: Rect(36, 8, 1, 1),
+                    256: Rect(0, 0, 0, 0)}
+
+        backend = pygame.surface.get_blit_backend()
+        try:
+            for type in ('GENERIC', 'SSE2', 'AVX2'):
+                try:
+                    pygame.surface.set_blit_backend(type)
+                except ValueError:
+                    continue
+                for min_alpha, rect in expected.items():
+                    self.assertEqual(surf.get_bounding_rect(min_alpha), rect)
+                self.assertEqual(sub.get_bounding_rect(), Rect(2, 1, 29, 15))
+        finally:
+            pygame.surface.set_blit_backend(backend)
+
         # Issue #180
         pygame.display.init()
         try:
@@ -483,6 +512,44 @@ class SurfaceTypeTest(unittest.TestCase):
         gc.collect()
         self.assertTrue(weak_s() is None)
 
+    def test_get_view_rect(self):
+        s = pygame.Surface((10, 8), pygame.SRCALPHA, 32)
+        s.fill((10, 20, 30, 40))
+        s.fill((1, 2, 3, 4), (2, 3, 4, 2))
+        address = s._pixels_address
+        pitch = s.get_pitch()
+        self.assertEqual(s.get_view('2', (2, 3, 4, 2)).rect, (2, 3, 4, 2))
+
+        v = s.get_view('2', rect=(2, 3, 4, 2))
+        inter = v.__array_interface__
+        self.assertEqual(inter['shape'], (4, 2))
+        self.assertEqual(inter['strides'], (4, pitch))
+        self.assertEqual(inter['data'][0], address + 3 * pitch + 2 * 4)
+        inter = None
+        v = None
+        gc.collect()
+        self.assertFalse(s.get_locked())
+
+        v = s.get_view('3', pygame.Rect(2, 3, 4, 2))
+        self.assertEqual(v.__array_interface__['shape'], (4, 2, 3))
+        v = s.get_view('r', (0, 7, 10, 1))
+        self.assertEqual(v.__array_interface__['shape'], (10, 1))
+
+        # The view holds only the rect's pixels
+        target = pygame.Surface((4, 2), pygame.SRCALPHA, 32)
+        pygame.pixelcopy.array_to_surface(target,
+                                          s.get_view('2', (2, 3, 4, 2)))
+        for x in range(4):
+            for y in range(2):
+                self.assertEqual(target.get_at((x, y)), (1, 2, 3, 4))
+        self.assertFalse(s.get_locked())
+
+        self.assertRaises(ValueError, s.get_view, '2', (8, 0, 3, 1))
+        self.assertRaises(ValueError, s.get_view, '2', (-1, 0, 2, 2))
+        self.assertRaises(ValueError, s.get_view, '0', (0, 0, 2, 2))
+        self.assertRaises(ValueError, s.get_view, '1', (0, 0, 2, 2))
+        self.assertRaises(TypeError, s.get_view, '2', 'rect')
+
     def test_get_buffer(self):
         # Check that get_buffer works for all pixel sizes and for a subsurface.
 
@@ -589,6 +656,380 @@ class SurfaceTypeTest(unittest.TestCase):
         self.assertEqual(s1.get_at((0, 0)), (0, 0, 0, 255))
         self.assertEqual(s1.get_at((1, 1)), color)
 
+    def test_blits(self):
+        dst = pygame.Surface((10, 10), 0, 32)
+        red = pygame.Surface((2, 2), 0, 32)
+        red.fill((255, 0, 0))
+        green = pygame.Surface((3, 3), 0, 32)
+        green.fill((0, 100, 0))
+        blits = [(red, (1, 1)),
+                 (green, pygame.Rect(5, 5, 1, 1), pygame.Rect(0, 0, 2, 2)),
+                 (green, (0, 0), None, BLEND_ADD)]
+        rects = dst.blits(blits)
+        self.assertEqual(rects, [pygame.Rect(1, 1, 2, 2),
+                                 pygame.Rect(5, 5, 2, 2),
+                                 pygame.Rect(0, 0, 3, 3)])
+        self.assertEqual(dst.get_at((2, 2)), (255, 100, 0, 255))
+        self.assertEqual(dst.get_at((6, 6)), (0, 100, 0, 255))
+        self.assertEqual(dst.get_at((7, 7)), (0, 0, 0, 255))
+
+        # Any iterable works, and no rects are made for doreturn=False
+        self.assertEqual(dst.blits(iter(blits), doreturn=False), None)
+        self.assertEqual(dst.blits([]), [])
+
+        self.assertRaises(ValueError, dst.blits, [(red,)])
+        self.assertRaises(ValueError, dst.blits, [(red, (0, 0), None, 0, 1)])
+        self.assertRaises(TypeError, dst.blits, [(None, (0, 0))])
+        self.assertRaises(TypeError, dst.blits, [(red, 'a')])
+        self.assertRaises(TypeError, dst.blits, [1])
+
+    def test_premul_alpha(self):
+        surf = pygame.Surface((4, 4), SRCALPHA, 32)
+        surf.fill((200, 100, 50, 128))
+        surf.set_at((0, 0), (200, 100, 50, 0))
+        self.assertFalse(surf.get_premul_alpha())
+
+        premul = surf.premul_alpha()
+        self.assertTrue(premul.get_premul_alpha())
+        self.assertFalse(surf.get_premul_alpha())
+        self.assertEqual(premul.get_at((1, 1)), (100, 50, 25, 128))
+        self.assertEqual(premul.get_at((0, 0)), (0, 0, 0, 0))
+        self.assertEqual(surf.get_at((1, 1)), (200, 100, 50, 128))
+
+        # Premultiplying again does not change the colours
+        self.assertEqual(premul.premul_alpha().get_at((1, 1)),
+                         (100, 50, 25, 128))
+
+        # The mark stays with copies and transforms
+        self.assertTrue(premul.copy().get_premul_alpha())
+        self.assertTrue(premul.subsurface((1, 1, 2, 2)).get_premul_alpha())
+        self.assertTrue(pygame.transform.smoothscale(premul, (8, 8))
+                        .get_premul_alpha())
+        self.assertTrue(pygame.transform.rotozoom(premul, 30, 1.5)
+                        .get_premul_alpha())
+        self.assertFalse(pygame.transform.smoothscale(surf, (8, 8))
+                         .get_premul_alpha())
+
+        # Blits of a premultiplied surface do the premultiplied blend
+        for flags in (0, SRCALPHA):
+            dst = pygame.Surface((4, 4), flags, 32)
+            dst.fill((40, 80, 120))
+            dst.blit(premul, (0, 0))
+            c = dst.get_at((1, 1))
+            expected = [s + d - ((d * 128) >> 8)
+                        for s, d in zip((100, 50, 25), (40, 80, 120))]
+            self.assertEqual(list(c)[:3], expected)
+            self.assertEqual(dst.get_at((0, 0))[:3], (40, 80, 120))
+
+        self.assertRaises(ValueError, pygame.Surface((4, 4), 0, 24).premul_alpha)
+
+    def test_premul_alpha_straight_writes(self):
+        surf = pygame.Surface((4, 4), SRCALPHA, 32)
+        surf.fill((200, 100, 50, 128))
+
+        # Premultiplied colours and sources keep the mark
+        premul = surf.premul_alpha()
+        premul.fill((0, 0, 0, 0))
+        premul.set_at((0, 0), (100, 50, 25, 128))
+        premul.blit(surf.premul_alpha(), (1, 1))
+        premul.blit(pygame.Surface((2, 2)), (0, 0))
+        self.assertTrue(premul.get_premul_alpha())
+
+        # Straight alpha writes clear it
+        for write in (lambda s: s.fill((200, 100, 50, 128)),
+                      lambda s: s.fill((10, 10, 10), None, BLEND_ADD),
+                      lambda s: s.set_at((0, 0), (200, 100, 50, 128)),
+                      lambda s: s.blit(surf, (0, 0))):
+            premul = surf.premul_alpha()
+            write(premul)
+            self.assertFalse(premul.get_premul_alpha())
+
+        # including those to a subsurface, which change its parent too
+        premul = surf.premul_alpha()
+        sub = premul.subsurface((1, 1, 2, 2))
+        sub.set_at((0, 0), (200, 100, 50, 128))
+        self.assertFalse(sub.get_premul_alpha())
+        self.assertFalse(premul.get_premul_alpha())
+
+    def test_damage(self):
+        surf = pygame.Surface((100, 100))
+        self.assertEqual(surf.get_damage(), [])
+        surf.fill((1, 2, 3), (10, 10, 5, 5))
+        surf.track_damage()
+        self.assertEqual(surf.get_damage(), [])
+
+        src = pygame.Surface((20, 20))
+        surf.blit(src, (90, 90))
+        surf.fill((255, 0, 0), (0, 0, 10, 10))
+        surf.fill((0, 255, 0), (5, 5, 10, 10))
+        pygame.draw.line(surf, (0, 0, 255), (50, 40), (50, 60))
+        damage = sorted(surf.get_damage(clear=False))
+        self.assertEqual(damage, [pygame.Rect(0, 0, 15, 15),
+                                  pygame.Rect(50, 40, 1, 21),
+                                  pygame.Rect(90, 90, 10, 10)])
+        self.assertEqual(sorted(surf.get_damage()), damage)
+        self.assertEqual(surf.get_damage(), [])
+
+        # Changes to a subsurface are damage of its parent
+        sub = surf.subsurface((20, 30, 40, 40))
+        sub.blits([(src, (0, 0)), (src, (10, 0))])
+        self.assertEqual(surf.get_damage(), [pygame.Rect(20, 30, 30, 20)])
+
+        surf.track_damage(False)
+        surf.fill((0, 0, 0))
+        self.assertEqual(surf.get_damage(), [])
+
+    def test_auto_convert(self):
+        from pygame import surface
+        pygame.display.init()
+        try:
+            screen = pygame.display.set_mode((20, 20))
+            depth = 16 if screen.get_bitsize() != 16 else 24
+            src = pygame.Surface((10, 10), 0, depth)
+            src.fill((10, 200, 30))
+            self.assertFalse(surface.get_auto_convert())
+            surface.set_auto_convert(True)
+            surface.get_auto_convert_stats(True)
+
+            screen.blit(src, (0, 0))
+            screen.blits([(src, (10, 0)), (src, (0, 10))])
+            self.assertEqual(surface.get_auto_convert_stats(), (1, 2))
+            self.assertEqual(screen.get_at((15, 5)), screen.get_at((5, 15)))
+
+            # Changing the source makes a new copy
+            src.fill((200, 10, 30))
+            screen.blit(src, (0, 0))
+            self.assertEqual(src.get_auto_conversions(), 2)
+            self.assertEqual(screen.get_at((5, 5)),
+                             screen.map_rgb(screen.unmap_rgb(
+                                 screen.map_rgb((200, 10, 30)))))
+
+            # Blits to other Surfaces, and display format ones, are left be
+            other = pygame.Surface((10, 10), 0, depth)
+            other.blit(src, (0, 0))
+            screen.blit(src.convert(), (0, 0))
+            self.assertEqual(surface.get_auto_convert_stats(True), (2, 2))
+        finally:
+            surface.set_auto_convert(False)
+            pygame.display.quit()
+
+    def test_shared(self):
+        from pygame import surface
+        name = 'pygame-test-%d' % os.getpid()
+        writer = surface.create_shared(name, (20, 10), SRCALPHA)
+        try:
+            self.assertRaises(pygame.error, surface.create_shared,
+                              name, (20, 10))
+            reader = surface.open_shared(name)
+            self.assertEqual(reader.get_size(), (20, 10))
+            self.assertEqual(reader.get_masks(), writer.get_masks())
+
+            self.assertEqual(reader.get_frame(), 0)
+            writer.begin_frame()
+            self.assertEqual(reader.get_frame(), 1)
+            self.assertRaises(pygame.error, writer.begin_frame)
+            writer.fill((10, 20, 30, 40), (5, 5, 2, 2))
+            writer.end_frame()
+            self.assertEqual(reader.get_frame(), 2)
+            self.assertRaises(pygame.error, reader.end_frame)
+            self.assertEqual(reader.get_at((6, 6)), (10, 20, 30, 40))
+            self.assertEqual(reader.get_view('0').raw,
+                             writer.get_view('0').raw)
+        finally:
+            surface.unlink_shared(name)
+        self.assertRaises(pygame.error, surface.open_shared, name)
+        # Mapped Surfaces outlive the name
+        writer.fill((1, 2, 3, 4))
+        self.assertEqual(reader.get_at((0, 0)), (1, 2, 3, 4))
+        self.assertRaises(pygame.error, pygame.Surface((1, 1)).get_frame)
+
+    def test_pool(self):
+        from pygame import surface
+        limit, largest = surface.get_pool_limit()
+        try:
+            surface.set_pool_limit(1 << 20, 1 << 16)
+            self.assertEqual(surface.get_pool_limit(), (1 << 20, 1 << 16))
+            self.assertRaises(ValueError, surface.set_pool_limit, -1)
+            self.assertRaises(ValueError, surface.set_pool_limit, 0, 1 << 30)
+
+            s = pygame.Surface((50, 50), SRCALPHA, 32)
+            s.fill((1, 2, 3, 4))
+            del s
+            idle, idle_bytes, used, used_bytes, hits, misses, drops = \
+                surface.get_pool_stats(True)
+            self.assertTrue(idle >= 1 and idle_bytes >= 50 * 50 * 4)
+            # a reused buffer is cleared as a new Surface is
+            s = pygame.Surface((49, 50), SRCALPHA, 32)
+            self.assertEqual(s.get_at((48, 49)), (0, 0, 0, 0))
+            s.set_colorkey((0, 0, 0))
+            s.set_at((3, 4), (5, 6, 7, 8))
+            c = s.copy()
+            self.assertEqual(c.get_colorkey(), s.get_colorkey())
+            self.assertEqual(c.get_at((3, 4)), (5, 6, 7, 8))
+            t = pygame.transform.flip(c, True, False)
+            self.assertEqual(t.get_at((45, 4)), (5, 6, 7, 8))
+            stats = surface.get_pool_stats()
+            self.assertEqual(stats[2], used + 3)
+            self.assertEqual(stats[4], 1)
+            del s, c, t
+            self.assertEqual(surface.get_pool_stats()[2], used)
+
+            # larger Surfaces are not pooled
+            s = pygame.Surface((200, 200), 0, 32)
+            self.assertEqual(surface.get_pool_stats()[2], used)
+            del s
+            surface.set_pool_limit(0)
+            self.assertEqual(surface.get_pool_stats()[:2], (0, 0))
+        finally:
+            surface.set_pool_limit(limit, largest)
+
+    def test_copy_on_write(self):
+        s = pygame.Surface((30, 20), 0, 32)
+        s.fill((1, 2, 3))
+        copies = [s.copy() for i in range(3)]
+        copies.append(copies[0].copy())
+        for c in copies:
+            self.assertEqual(c.get_at((29, 19)), (1, 2, 3, 255))
+
+        # writing the source leaves the copies as they were
+        s.fill((5, 6, 7), (0, 0, 10, 10))
+        s.set_at((29, 19), (9, 9, 9))
+        for c in copies:
+            self.assertEqual(c.get_at((0, 0)), (1, 2, 3, 255))
+            self.assertEqual(c.get_at((29, 19)), (1, 2, 3, 255))
+
+        # writing a copy leaves the source and the other copies alone
+        a, b = s.copy(), s.copy()
+        pygame.draw.line(a, (0, 0, 0), (0, 0), (29, 0))
+        a.blit(copies[0], (0, 5))
+        self.assertEqual(a.get_at((15, 0)), (0, 0, 0, 255))
+        self.assertEqual(a.get_at((0, 5)), (1, 2, 3, 255))
+        for c in (s, b):
+            self.assertEqual(c.get_at((15, 0)), (1, 2, 3, 255))
+            self.assertEqual(c.get_at((0, 5)), (5, 6, 7, 255))
+
+        # blitting a copy onto its source, then freeing the source
+        c = s.copy()
+        s.blit(c, (1, 0))
+        self.assertEqual(c.get_at((10, 0)), (1, 2, 3, 255))
+        self.assertEqual(s.get_at((10, 0)), (5, 6, 7, 255))
+        c2 = s.copy()
+        del s
+        self.assertEqual(c2.get_at((10, 0)), (5, 6, 7, 255))
+        sub = c2.subsurface((5, 5, 10, 10))
+        c3 = c2.copy()
+        sub.fill((0, 0, 0))
+        self.assertEqual(c2.get_at((5, 5)), (0, 0, 0, 255))
+        self.assertEqual(c3.get_at((5, 5)), (5, 6, 7, 255))
+        view = c3.get_view('2')
+        del view
+        self.assertEqual(c3.get_at((5, 5)), (5, 6, 7, 255))
+
+        # drawing through a subsurface without locking it, as gfxdraw does
+        import pygame.gfxdraw
+        c4 = c2.copy()
+        pygame.gfxdraw.pixel(sub, 9, 9, (9, 9, 9))
+        self.assertEqual(c2.get_at((14, 14)), (9, 9, 9, 255))
+        self.assertEqual(c4.get_at((14, 14)), (0, 0, 0, 255))
+
+        # a subsurface of a copy writes its pixels only
+        c5 = c2.copy()
+        sub5 = c5.subsurface((0, 0, 4, 4))
+        pygame.gfxdraw.pixel(sub5, 1, 1, (8, 8, 8))
+        self.assertEqual(c5.get_at((1, 1)), (8, 8, 8, 255))
+        self.assertEqual(c2.get_at((1, 1)), (5, 6, 7, 255))
+
+    def test_compress(self):
+        from pygame import surface
+        limit = surface.get_decompressed_limit()
+        try:
+            surface.set_decompressed_limit(0)
+            self.assertEqual(surface.get_decompressed_limit(), 0)
+            self.assertRaises(ValueError, surface.set_decompressed_limit, -1)
+
+            s = pygame.Surface((64, 48), SRCALPHA, 32)
+            s.fill((10, 20, 30, 40))
+            s.set_at((63, 47), (1, 2, 3, 4))
+            s.set_clip((1, 1, 10, 10))
+            size = s.compress()
+            self.assertTrue(s.get_compressed())
+            self.assertTrue(0 < size < 64 * 48 * 4)
+            stats = surface.get_compress_stats(True)
+            self.assertTrue(stats[0] >= 1 and stats[1] >= size)
+            self.assertEqual(s.get_size(), (64, 48))
+            self.assertEqual(s.get_clip(), pygame.Rect(1, 1, 10, 10))
+            self.assertEqual(s.get_at((63, 47)), (1, 2, 3, 4))
+
+            # drawn from and to while compressed, decoding for each use
+            d = pygame.Surface((64, 48), SRCALPHA, 32)
+            d.blit(s, (0, 0))
+            self.assertEqual(d.get_at((5, 5)), (10, 20, 30, 40))
+            s.set_clip(None)
+            s.fill((5, 6, 7, 8), (0, 0, 4, 4))
+            s.compress()
+            self.assertEqual(s.get_at((3, 3)), (5, 6, 7, 8))
+            self.assertEqual(s.get_at((4, 4)), (10, 20, 30, 40))
+            c = s.copy()
+            self.assertFalse(c.get_compressed())
+            self.assertEqual(c.get_at((3, 3)), (5, 6, 7, 8))
+            self.assertTrue(surface.get_compress_stats()[4] >= 2)
+
+            # locked pixels are kept
+            s.lock()
+            self.assertRaises(ValueError, s.compress)
+            s.unlock()
+            s.decompress()
+            self.assertFalse(s.get_compressed())
+            self.assertEqual(s.get_at((63, 47)), (1, 2, 3, 4))
+
+            self.assertRaises(ValueError, s.subsurface((0, 0, 2, 2)).compress)
+
+            # subsurfaces point into the pixels, which stay decoded
+            sub = s.subsurface((60, 44, 4, 4))
+            self.assertRaises(ValueError, s.compress)
+            del sub
+            s.compress()
+            sub = s.subsurface((60, 44, 4, 4))
+            self.assertRaises(ValueError, s.compress)
+            t = pygame.Surface((64, 48), 0, 32)
+            t.compress()
+            t.get_at((0, 0))
+            self.assertEqual(sub.get_at((3, 3)), (1, 2, 3, 4))
+            sub.fill((9, 9, 9, 9))
+            del sub
+            s.decompress()
+            self.assertEqual(s.get_at((63, 47)), (9, 9, 9, 9))
+            r = pygame.Surface((4, 4), 0, 32)
+            r.set_colorkey((0, 0, 0), RLEACCEL)
+            self.assertRaises(ValueError, r.compress)
+            r.set_colorkey(None)
+            r.compress()
+            r.set_colorkey((0, 0, 0), RLEACCEL)
+            self.assertFalse(r.get_compressed())
+        finally:
+            surface.set_decompressed_limit(limit)
+
+    def test_row_alignment(self):
+        for align in (4, 16, 32, 64):
+            s = pygame.Surface((13, 7), SRCALPHA, 32, align=align)
+            self.assertEqual(s.get_pitch() % align, 0)
+            self.assertTrue(s.get_row_alignment() >= align)
+            self.assertEqual(s.get_at((12, 6)), (0, 0, 0, 0))
+            s.fill((1, 2, 3, 4))
+            s.fill((10, 20, 30, 40), (0, 2, 13, 3))
+            self.assertEqual(s.get_at((12, 1)), (1, 2, 3, 4))
+            self.assertEqual(s.get_at((12, 2)), (10, 20, 30, 40))
+            self.assertEqual(s.get_at((0, 5)), (1, 2, 3, 4))
+            c = s.copy()
+            self.assertEqual(c.get_pitch(), s.get_pitch())
+            self.assertEqual(c.get_at((12, 4)), (10, 20, 30, 40))
+        s = pygame.Surface((13, 7), 0, 24, align=64)
+        self.assertEqual(s.get_pitch(), 64)
+        self.assertEqual(s.get_bytesize(), 3)
+        self.assertEqual(s.subsurface((1, 1, 4, 4)).get_row_alignment(), 0)
+        self.assertRaises(ValueError, pygame.Surface, (1, 1), align=3)
+        self.assertRaises(ValueError, pygame.Surface, (1, 1), align=128)
+
     def todo_test_blit(self):
         # __doc__ (as of 2008-08-02) for pygame.surface.Surface.blit:
 
@@ -671,6 +1112,46 @@ class SurfaceTypeTest(unittest.TestCase):
         source.set_at((0, 0), color)
         target.blit(source, (0, 0))
 
+    def test_blit__8_to_SRCALPHA32(self):
+        # 8 bit sources are looked up in a table of destination pixels.
+        src = pygame.Surface((4, 2), 0, 8)
+        src.set_palette([(10 * i, 20 * i, 30 * i) for i in range(4)] +
+                        [(i, i, 255) for i in range(4, 256)])
+        for i in range(4):
+            src.set_at((i, 0), i)
+            src.set_at((i, 1), 3 - i)
+        src.set_colorkey(src.get_palette_at(1))
+        dst = pygame.Surface((4, 2), SRCALPHA, 32)
+        dst.fill((1, 2, 3, 200))
+        dst.set_at((2, 1), (1, 2, 3, 0))
+        dst.blit(src, (0, 0))
+
+        self.assertEqual(dst.get_at((0, 0)), (0, 0, 0, 255))
+        self.assertEqual(dst.get_at((1, 0)), (1, 2, 3, 200))
+        self.assertEqual(dst.get_at((3, 0)), (30, 60, 90, 255))
+        # a keyed pixel over a transparent one takes the key colour
+        self.assertEqual(dst.get_at((2, 1)), (10, 20, 30, 0))
+
+        src.set_colorkey(None)
+        dst.blit(src, (0, 0))
+        for i in range(4):
+            self.assertEqual(dst.get_at((i, 1)),
+                             (10 * (3 - i), 20 * (3 - i), 30 * (3 - i), 255))
+
+    def test_blit__8_to_8_same_palette(self):
+        src = pygame.Surface((8, 1), 0, 8)
+        src.set_palette([(i, i, i) for i in range(256)])
+        for i in range(8):
+            src.set_at((i, 0), i)
+        src.set_colorkey(src.get_palette_at(2))
+        dst = pygame.Surface((8, 1), 0, 8)
+        dst.set_palette(src.get_palette())
+        dst.fill(5)
+        src.set_alpha(255)
+        dst.blit(src, (0, 0))
+        self.assertEqual([dst.get_at_mapped((i, 0)) for i in range(8)],
+                         [0, 1, 5, 3, 4, 5, 6, 7])
+
     def test_image_convert_bug_131(self):
         # Bitbucket bug #131: Unable to Surface.convert(32) some 1-bit images.
         # https://bitbucket.org/pygame/pygame/issue/131/unable-to-surfaceconvert-32-some-1-bit
@@ -701,6 +1182,43 @@ class SurfaceTypeTest(unittest.TestCase):
         self.assertRaises(pygame.error, im2.convert, 8)
         self.assertEqual(pygame.get_error(), "Empty destination palette")
 
+    def test_convert__swizzles(self):
+        # 24 and 32 bit surfaces with 8 bit channels are converted to 32 bit
+        # ones without SDL; check every channel lands where it should.
+        pygame.display.init()
+        try:
+            pygame.display.set_mode((1, 1))
+            w, h = 37, 5
+            sources = [pygame.Surface((w, h), 0, 24),
+                       pygame.Surface((w, h), 0, 32),
+                       pygame.Surface((w, h), pygame.SRCALPHA, 32),
+                       pygame.Surface((w, h), pygame.SRCALPHA, 32,
+                                      (0xff, 0xff00, 0xff0000, 0xff000000))]
+            targets = [(0xff0000, 0xff00, 0xff, 0),
+                       (0xff, 0xff00, 0xff0000, 0),
+                       (0xff0000, 0xff00, 0xff, 0xff000000),
+                       (0xff00, 0xff0000, 0xff000000, 0xff)]
+            for s in sources:
+                for y in range(h):
+                    for x in range(w):
+                        s.set_at((x, y), ((x * 7) & 255, (y * 50) & 255,
+                                          (x * y) & 255, (x * 13) & 255))
+                for masks in targets:
+                    d = s.convert(masks)
+                    self.assertEqual(d.get_masks(), masks)
+                    for y in range(h):
+                        for x in range(w):
+                            color = s.get_at((x, y))
+                            if not masks[3]:
+                                color.a = 255
+                            self.assertEqual(d.get_at((x, y)), color)
+                d = s.convert_alpha()
+                for y in range(h):
+                    for x in range(w):
+                        self.assertEqual(d.get_at((x, y)), s.get_at((x, y)))
+        finally:
+            pygame.display.quit()
+
     def todo_test_convert(self):
 
         # __doc__ (as of 2008-08-02) for pygame.surface.Surface.convert:
@@ -804,6 +1322,45 @@ class SurfaceTypeTest(unittest.TestCase):
                                  "%i != %i, bitsize: %i" %
                                  (pixel, surf.map_rgb(color), bitsize))
 
+    def test_get_set_at_many(self):
+        import array
+        points = array.array('i', [0, 0, 3, 1, 1, 2, 2, 2])
+        for bitsize in [8, 16, 24, 32]:
+            surf = pygame.Surface((4, 3), 0, bitsize)
+            colors = [surf.map_rgb(c) for c in
+                      [(255, 0, 0), (0, 255, 0), (0, 0, 255), (255, 255, 0)]]
+            surf.set_at_many(points, array.array('I', colors))
+            self.failUnlessEqual(surf.get_at_many(points), colors)
+            for i, c in enumerate(colors):
+                self.failUnlessEqual(surf.get_at_mapped((points[2 * i],
+                                                         points[2 * i + 1])),
+                                     c)
+            mapped = array.array('I', [0] * 4)
+            self.failUnless(surf.get_at_many(points, mapped) is mapped)
+            self.failUnlessEqual(list(mapped), colors)
+
+            # A single color, and the clip area
+            surf.set_clip((0, 0, 2, 3))
+            surf.set_at_many(points, (1, 2, 3))
+            pixel = surf.map_rgb((1, 2, 3))
+            self.failUnlessEqual(surf.get_at_many(points),
+                                 [pixel, colors[1], pixel, colors[3]])
+
+        surf = pygame.Surface((4, 3), 0, 32)
+        self.failUnlessEqual(surf.get_at_many(array.array('i')), [])
+        self.failUnlessRaises(IndexError, surf.get_at_many,
+                              array.array('i', [0, 0, 4, 0]))
+        self.failUnlessRaises(IndexError, surf.get_at_many,
+                              array.array('i', [0, -1]))
+        self.failUnlessRaises(ValueError, surf.get_at_many,
+                              array.array('i', [0, 0, 1]))
+        self.failUnlessRaises(ValueError, surf.get_at_many,
+                              array.array('d', [0.0, 0.0]))
+        self.failUnlessRaises(ValueError, surf.get_at_many, points,
+                              array.array('I', [0]))
+        self.failUnlessRaises(ValueError, surf.set_at_many, points,
+                              array.array('I', [0, 0]))
+
     def todo_test_get_bitsize(self):
 
         # __doc__ (as of 2008-08-02) for pygame.surface.Surface.get_bitsize:
@@ -1193,6 +1750,56 @@ class SurfaceTypeTest(unittest.TestCase):
 
 
 
+    def test_region(self):
+        sheet = pygame.Surface((32, 16), 0, 32)
+        sheet.fill((255, 0, 0), (0, 0, 16, 16))
+        sheet.fill((0, 255, 0), (16, 0, 16, 16))
+        sheet.fill((0, 0, 255), (24, 8, 8, 8))
+        frame = sheet.region((16, 0, 16, 16))
+        self.assertTrue(isinstance(frame, pygame.SurfaceRegion))
+        self.assertTrue(frame.get_parent() is sheet)
+        self.assertEqual(frame.get_offset(), (16, 0))
+        self.assertEqual(frame.get_size(), (16, 16))
+        self.assertEqual(frame.get_rect(center=(8, 8)), (0, 0, 16, 16))
+        self.assertRaises(ValueError, sheet.region, (20, 0, 16, 16))
+        self.assertRaises(ValueError, frame.region, (8, 8, 9, 8))
+        self.assertRaises(TypeError, pygame.SurfaceRegion, None, (0, 0, 1, 1))
+
+        inner = pygame.SurfaceRegion(frame, (8, 8, 8, 8))
+        self.assertTrue(inner.get_parent() is sheet)
+        self.assertEqual(inner.get_offset(), (24, 8))
+
+        dest = pygame.Surface((20, 20), 0, 32)
+        self.assertEqual(dest.blit(frame, (2, 2)), (2, 2, 16, 16))
+        self.assertEqual(dest.get_at((2, 2)), (0, 255, 0, 255))
+        self.assertEqual(dest.get_at((17, 17)), (0, 0, 255, 255))
+        self.assertEqual(dest.get_at((18, 18)), (0, 0, 0, 255))
+
+        # The area is relative to the region, and clipped to it.
+        dest.fill((0, 0, 0))
+        rect = dest.blit(frame, (0, 0), (-4, 4, 40, 40))
+        self.assertEqual(rect, (4, 0, 16, 12))
+        self.assertEqual(dest.get_at((4, 0)), (0, 255, 0, 255))
+        self.assertEqual(dest.get_at((3, 0)), (0, 0, 0, 255))
+        self.assertEqual(dest.get_at((19, 11)), (0, 0, 255, 255))
+        self.assertEqual(dest.get_at((19, 12)), (0, 0, 0, 255))
+        dest.fill((0, 0, 0))
+        dest.blits([(frame, (0, 0), (8, 0, 8, 8)), (inner, (10, 10))])
+        self.assertEqual(dest.get_at((7, 7)), (0, 255, 0, 255))
+        self.assertEqual(dest.get_at((8, 0)), (0, 0, 0, 255))
+        self.assertEqual(dest.get_at((17, 17)), (0, 0, 255, 255))
+
+        # Transforms and masks see the current pixels and colorkey.
+        flipped = pygame.transform.flip(frame, True, False)
+        self.assertEqual(flipped.get_size(), (16, 16))
+        self.assertEqual(flipped.get_at((0, 15)), (0, 0, 255, 255))
+        self.assertEqual(flipped.get_at((15, 15)), (0, 255, 0, 255))
+        sheet.set_colorkey((0, 0, 255))
+        self.assertEqual(pygame.mask.from_surface(frame).count(), 192)
+        sheet.fill((0, 0, 255), (16, 0, 16, 16))
+        self.assertEqual(pygame.mask.from_surface(frame).count(), 0)
+        self.assertEqual(frame.subsurface().get_abs_offset(), (16, 0))
+
     def todo_test_unlock(self):
 
         # __doc__ (as of 2008-08-02) for pygame.surface.Surface.unlock:
@@ -1304,6 +1911,50 @@ class SurfaceTypeTest(unittest.TestCase):
         surf.scroll(dx=-3, dy=-3)
         self.failUnlessEqual(surf.get_at((0, 0)), spot_color)
 
+    def test_scroll_exposed(self):
+        surf = pygame.Surface((20, 10), 0, 32)
+        surf.set_clip((2, 1, 16, 8))
+        self.failUnlessEqual(surf.scroll(0, 0, exposed=True), [])
+        self.failUnlessEqual(surf.scroll(3, 2, exposed=True),
+                             [Rect(2, 1, 16, 2), Rect(2, 3, 3, 6)])
+        self.failUnlessEqual(surf.scroll(-3, -2, exposed=True),
+                             [Rect(2, 7, 16, 2), Rect(15, 1, 3, 6)])
+        self.failUnlessEqual(surf.scroll(16, 0, exposed=True),
+                             [Rect(2, 1, 16, 8)])
+        self.failUnless(surf.scroll(1, 1) is None)
+
+        # Everything outside the exposed rects came from the scroll
+        surf = pygame.Surface((12, 12), 0, 32)
+        for x in range(12):
+            for y in range(12):
+                surf.set_at((x, y), (x * 20, y * 20, 0))
+        comp = surf.copy()
+        exposed = surf.scroll(-2, 3, exposed=True)
+        for x in range(12):
+            for y in range(12):
+                if not [r for r in exposed if r.collidepoint(x, y)]:
+                    self.failUnlessEqual(surf.get_at((x, y)),
+                                         comp.get_at((x + 2, y - 3)))
+
+    def test_blit_to_self(self):
+        for bitsize in (8, 16, 24, 32):
+            surf = pygame.Surface((16, 16), 0, bitsize)
+            for x in range(16):
+                surf.fill((x * 15, 0, 255 - x * 15), (x, 0, 1, 16))
+            surf.fill((0, 255, 0), (3, 4, 5, 6))
+            comp = surf.copy()
+            expected = comp.copy()
+            expected.blit(comp, (5, 2), (1, 3, 9, 9))
+            surf.blit(surf, (5, 2), (1, 3, 9, 9))
+            sub = comp.subsurface((1, 3, 9, 9))
+            comp.blit(sub, (5, 2))
+            for x in range(16):
+                for y in range(16):
+                    self.failUnlessEqual(surf.get_at((x, y)),
+                                         expected.get_at((x, y)))
+                    self.failUnlessEqual(comp.get_at((x, y)),
+                                         expected.get_at((x, y)))
+
 class SurfaceSubtypeTest (unittest.TestCase):
     """Issue #280: Methods that return a new Surface preserve subclasses"""
 
@@ -2213,6 +2864,75 @@ class SurfaceBlendTest (unittest.TestCase):
                 dst.fill(fill_color, special_flags=getattr(pygame, blend_name))
                 self._assert_surface(dst, p, ", %s" % blend_name)
 
+    def test_blend__16_bit_layouts(self):
+        # The RGB565 and RGB555 blends do all channels of a pixel at once.
+        # They must give the same channels as the 8 bit blends do.
+        def channels(masks):
+            return [(len(bin(m)) - 2 - bin(m).count('1'), bin(m).count('1'))
+                    for m in masks]
+
+        def expand(v, bits):
+            return (v << (8 - bits)) + (v >> (2 * bits - 8))
+
+        def blend(op, d, s, chans):
+            p = 0
+            for shift, bits in chans:
+                a = expand((d >> shift) & ((1 << bits) - 1), bits)
+                b = expand((s >> shift) & ((1 << bits) - 1), bits)
+                p |= (op(a, b) >> (8 - bits)) << shift
+            return p
+
+        blends = [(BLEND_ADD, lambda a, b: min(a + b, 255)),
+                  (BLEND_SUB, lambda a, b: max(a - b, 0)),
+                  (BLEND_MULT, lambda a, b: (a * b) >> 8),
+                  (BLEND_MIN, min),
+                  (BLEND_MAX, max)]
+        layouts = [(0xF800, 0x07E0, 0x001F, 0),
+                   (0x001F, 0x07E0, 0xF800, 0),
+                   (0x7C00, 0x03E0, 0x001F, 0),
+                   (0x001F, 0x03E0, 0x7C00, 0)]
+        w, h = 64, 4
+        for masks in layouts:
+            chans = channels(masks[:3])
+            src = pygame.Surface((w, h), 0, 16, masks)
+            dst = pygame.Surface((w, h), 0, 16, masks)
+            pixels = {}
+            for x in range(w):
+                for y in range(h):
+                    s = 0
+                    d = 0
+                    for i, (shift, bits) in enumerate(chans):
+                        top = (1 << bits) - 1
+                        s |= ((x * (i + 1) + y * 13) & top) << shift
+                        d |= ((top - x + y * 7 * i) & top) << shift
+                    pixels[x, y] = d, s
+                    src.set_at((x, y), src.unmap_rgb(s))
+            for flag, op in blends:
+                for x in range(w):
+                    for y in range(h):
+                        dst.set_at((x, y), dst.unmap_rgb(pixels[x, y][0]))
+                dst.blit(src, (0, 0), special_flags=flag)
+                for x in range(w):
+                    for y in range(h):
+                        d, s = pixels[x, y]
+                        self.assertEqual(dst.get_at_mapped((x, y)),
+                                         blend(op, d, s, chans),
+                                         "masks %s, flag %i, pixel %s" %
+                                         (masks, flag, (x, y)))
+
+                fill = src.get_at_mapped((5, 1))
+                for x in range(w):
+                    for y in range(h):
+                        dst.set_at((x, y), dst.unmap_rgb(pixels[x, y][0]))
+                dst.fill(dst.unmap_rgb(fill), special_flags=flag)
+                for x in range(w):
+                    for y in range(h):
+                        d = pixels[x, y][0]
+                        self.assertEqual(dst.get_at_mapped((x, y)),
+                                         blend(op, d, fill, chans),
+                                         "masks %s, flag %i, fill %s" %
+                                         (masks, flag, (x, y)))
+
 class SurfaceSelfBlitTest(unittest.TestCase):
     """Blit to self tests.
 
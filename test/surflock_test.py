@@ -36,6 +36,28 @@ class SurfaceLockTest (unittest.TestCase):
         self.assertEquals (sf.get_locked (), False)
         self.assertEquals (sf.get_locks (), ())
 
+    def test_lock_mixed (self):
+        sf = pygame.Surface ((5, 5))
+
+        sf.lock ()
+        ar = pygame.PixelArray (sf)
+        sf.lock ()
+        self.assertEquals (sf.get_locked (), True)
+        self.assertEquals (sf.get_locks (), (sf, sf, ar))
+
+        sf.unlock ()
+        sf.unlock ()
+        self.assertEquals (sf.get_locks (), (ar,))
+
+        # Further unlocks by the surface leave the PixelArray lock alone.
+        sf.unlock ()
+        self.assertEquals (sf.get_locked (), True)
+        self.assertEquals (sf.get_locks (), (ar,))
+
+        del ar
+        self.assertEquals (sf.get_locked (), False)
+        self.assertEquals (sf.get_locks (), ())
+
     def test_subsurface_lock (self):
         sf = pygame.Surface ((5, 5))
         subsf = sf.subsurface ((1, 1, 2, 2))
@@ -13,10 +13,88 @@ else:
     is_pygame_pkg = __name__.startswith('pygame.tests.')
 
 import unittest
+import os
+import shutil
+import tempfile
+from pygame import sysfont
 
 ################################################################################
 
 class SysfontModuleTest(unittest.TestCase):
+    def setUp(self):
+        self.tmpdir = tempfile.mkdtemp()
+        self.path = os.path.join(self.tmpdir, 'cache', 'sysfont.json')
+        self.scans = 0
+        self.fonts = {'freesans': {(False, False): '/fonts/freesans.ttf',
+                                   (True, False): '/fonts/freesansb.ttf'}}
+        self.saved = (dict(sysfont.Sysfonts), dict(sysfont.Sysalias),
+                      sysfont._cache_path, sysfont._scan_fonts,
+                      sysfont._cache_key)
+        sysfont._cache_path = lambda: self.path
+        sysfont._scan_fonts = self.scan
+        sysfont._cache_key = lambda: [['/fonts', 1.5]]
+        sysfont.Sysfonts.clear()
+        sysfont.Sysalias.clear()
+
+    def tearDown(self):
+        sysfont.Sysfonts.clear()
+        sysfont.Sysalias.clear()
+        sysfont.Sysfonts.update(self.saved[0])
+        sysfont.Sysalias.update(self.saved[1])
+        (sysfont._cache_path, sysfont._scan_fonts,
+         sysfont._cache_key) = self.saved[2:]
+        shutil.rmtree(self.tmpdir)
+
+    def scan(self):
+        self.scans += 1
+        return self.fonts
+
+    def init(self):
+        sysfont.Sysfonts.clear()
+        sysfont.Sysalias.clear()
+        sysfont._cache_thread = None
+        sysfont.initsysfonts()
+        if sysfont._cache_thread is not None:
+            sysfont._cache_thread.join()
+
+    def test_cache(self):
+        if sysfont.json is None:
+            return
+        self.init()
+        self.assertEqual(self.scans, 1)
+        self.assertTrue(os.path.exists(self.path))
+        self.assertEqual(sysfont.match_font('freesans', bold=True),
+                         '/fonts/freesansb.ttf')
+
+        # A second process only reads the cache
+        self.init()
+        self.assertEqual(self.scans, 1)
+        self.assertEqual(sysfont.get_fonts(), ['freesans'])
+        self.assertEqual(sysfont.match_font('sans'), '/fonts/freesans.ttf')
+        self.assertEqual(sysfont.match_font('freesans', bold=True),
+                         '/fonts/freesansb.ttf')
+
+        # Changed font directories are scanned again, in the background
+        sysfont._cache_key = lambda: [['/fonts', 2.5]]
+        self.fonts = {'freeserif': {(False, False): '/fonts/freeserif.ttf'}}
+        self.init()
+        self.assertEqual(self.scans, 2)
+        self.assertEqual(sysfont.get_fonts(), ['freeserif'])
+        self.assertEqual(sysfont.match_font('sans'), None)
+        self.assertEqual(sysfont.match_font('serif'), '/fonts/freeserif.ttf')
+        self.init()
+        self.assertEqual(self.scans, 2)
+        self.assertEqual(sysfont.get_fonts(), ['freeserif'])
+
+    def test_cache__bad_file(self):
+        os.mkdir(os.path.dirname(self.path))
+        f = open(self.path, 'w')
+        f.write('not a font cache')
+        f.close()
+        self.init()
+        self.assertEqual(self.scans, 1)
+        self.assertEqual(sysfont.get_fonts(), ['freesans'])
+
     def todo_test_create_aliases(self):
 
         # __doc__ (as of 2008-08-02) for pygame.sysfont.create_aliases:
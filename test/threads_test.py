@@ -178,6 +178,17 @@ class ThreadsModuleTest(unittest.TestCase):
         r2 = map(lambda x:x.result, results)
         self.assertEqual(list(r), list(r2))
 
+    def test_native_tmap(self):
+        workers = threads.get_native_workers()
+        func, data = lambda x:x+1, xrange_(100)
+        try:
+            threads.set_native_workers(4)
+            self.assertEqual(threads.get_native_workers(), 4)
+            self.assertEqual(threads.native_tmap(func, data),
+                             list(map(func, data)))
+        finally:
+            threads.set_native_workers(workers)
+
     def test_FuncResult(self):
         # as of 2008-06-28
         # FuncResult(f, callback = None, errback = None)
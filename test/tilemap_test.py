@@ -0,0 +1,160 @@
+#################################### IMPORTS ###################################
+
+if __name__ == '__main__':
+    import sys
+    import os
+    pkg_dir = os.path.split(os.path.abspath(__file__))[0]
+    parent_dir, pkg_name = os.path.split(pkg_dir)
+    is_pygame_pkg = (pkg_name == 'tests' and
+                     os.path.split(parent_dir)[1] == 'pygame')
+    if not is_pygame_pkg:
+        sys.path.insert(0, parent_dir)
+else:
+    is_pygame_pkg = __name__.startswith('pygame.tests.')
+
+import unittest
+import random
+import pygame
+from pygame.tilemap import TileMap
+
+################################################################################
+
+COLORS = [(255, 0, 0, 255), (0, 255, 0, 255),
+          (0, 0, 255, 255), (255, 255, 0, 255)]
+
+def make_atlas(tile_w=4, tile_h=4):
+    """2x2 atlas, tile id n filled with COLORS[n - 1]"""
+    atlas = pygame.Surface((tile_w * 2, tile_h * 2), 0, 32)
+    for i, color in enumerate(COLORS):
+        atlas.fill(color, ((i % 2) * tile_w, (i // 2) * tile_h,
+                           tile_w, tile_h))
+    return atlas
+
+class TileMapTest(unittest.TestCase):
+    def test_construct(self):
+        tmap = TileMap((10, 8), (4, 4), make_atlas(), layers=2)
+        self.assertEqual(tmap.get_size(), (10, 8))
+        self.assertEqual(tmap.get_tile_size(), (4, 4))
+        self.assertEqual(tmap.get_layers(), 2)
+        self.assertEqual(tmap.get_rect(), pygame.Rect(0, 0, 40, 32))
+        self.assertEqual(tmap.get_layer(1), [0] * 80)
+        self.assertRaises(ValueError, TileMap, (0, 8), (4, 4), make_atlas())
+        self.assertRaises(ValueError, TileMap, (10, 8), (16, 16),
+                          make_atlas())
+        self.assertRaises(ValueError, TileMap, (10, 8), (4, 4),
+                          make_atlas(), layers=0)
+
+    def test_tiles(self):
+        tmap = TileMap((10, 8), (4, 4), make_atlas())
+        tmap.set_tile(0, (3, 2), 4)
+        self.assertEqual(tmap.get_tile(0, (3, 2)), 4)
+        self.assertEqual(tmap.get_layer(0)[23], 4)
+        tmap.fill(0, 2, (8, 6, 5, 5))
+        self.assertEqual(tmap.get_tile(0, (9, 7)), 2)
+        self.assertEqual(tmap.get_tile(0, (7, 7)), 0)
+        self.assertRaises(IndexError, tmap.set_tile, 1, (0, 0), 1)
+        self.assertRaises(IndexError, tmap.get_tile, 0, (10, 0))
+        self.assertRaises(ValueError, tmap.set_tile, 0, (0, 0), 0x10000)
+        self.assertRaises(ValueError, tmap.set_layer, 0, [1, 2])
+        ids = [1] * 79 + [-1]
+        self.assertRaises(ValueError, tmap.set_layer, 0, ids)
+        self.assertEqual(tmap.get_tile(0, (0, 0)), 0)
+
+    def test_draw(self):
+        tmap = TileMap((3, 2), (4, 4), make_atlas())
+        tmap.set_layer(0, [1, 2, 0,
+                           3, 4, 9])
+        surf = pygame.Surface((12, 8), 0, 32)
+        surf.fill((9, 9, 9))
+        self.assertEqual(tmap.draw(surf), pygame.Rect(0, 0, 12, 8))
+        self.assertEqual(surf.get_at((1, 1)), COLORS[0])
+        self.assertEqual(surf.get_at((5, 2)), COLORS[1])
+        self.assertEqual(surf.get_at((2, 6)), COLORS[2])
+        self.assertEqual(surf.get_at((7, 7)), COLORS[3])
+        # Empty and out of atlas ids draw nothing.
+        self.assertEqual(surf.get_at((9, 1)), (9, 9, 9, 255))
+        self.assertEqual(surf.get_at((9, 5)), (9, 9, 9, 255))
+
+    def test_viewport(self):
+        tmap = TileMap((3, 2), (4, 4), make_atlas(), chunk_size=(2, 2))
+        tmap.set_layer(0, [1, 2, 3,
+                           3, 4, 1])
+        surf = pygame.Surface((10, 10), 0, 32)
+        surf.fill((9, 9, 9))
+        rect = tmap.draw(surf, (6, 2, 4, 4), (1, 1))
+        self.assertEqual(rect, pygame.Rect(1, 1, 4, 4))
+        self.assertEqual(surf.get_at((1, 1)), COLORS[1])
+        self.assertEqual(surf.get_at((3, 1)), COLORS[2])
+        self.assertEqual(surf.get_at((1, 3)), COLORS[3])
+        self.assertEqual(surf.get_at((3, 3)), COLORS[0])
+        self.assertEqual(surf.get_at((0, 0)), (9, 9, 9, 255))
+        self.assertEqual(surf.get_at((5, 5)), (9, 9, 9, 255))
+        self.assertEqual(tmap.draw(surf, (100, 100, 4, 4)),
+                         pygame.Rect(0, 0, 0, 0))
+
+    def test_cache_matches_tiles(self):
+        rand = random.Random(3)
+        atlas = pygame.Surface((12, 9), pygame.SRCALPHA, 32)
+        for y in range(9):
+            for x in range(12):
+                atlas.set_at((x, y), (rand.randrange(256), rand.randrange(256),
+                                      rand.randrange(256),
+                                      rand.choice([0, 128, 255])))
+        maps = [TileMap((13, 11), (3, 3), atlas, layers=2,
+                        chunk_size=(4, 3), cache=cache)
+                for cache in (True, False)]
+        for layer in range(2):
+            ids = [rand.randrange(14) for i in range(13 * 11)]
+            for tmap in maps:
+                tmap.set_layer(layer, ids)
+        for view in [None, (5, 4, 20, 17), (-4, -2, 50, 50)]:
+            results = []
+            for tmap in maps:
+                surf = pygame.Surface((32, 30), 0, 32)
+                surf.fill((40, 50, 60))
+                surf.set_clip((2, 3, 25, 24))
+                tmap.draw(surf, view, (1, 2))
+                results.append([surf.get_at((x, y))
+                                for y in range(30) for x in range(32)])
+            self.assertEqual(results[0], results[1])
+
+    def test_dirty_chunks(self):
+        tmap = TileMap((40, 30), (4, 4), make_atlas(), chunk_size=(10, 10))
+        tmap.fill(0, 1)
+        surf = pygame.Surface((64, 48), 0, 32)
+        tmap.get_draw_count(True)
+        tmap.draw(surf, (4, 4, 64, 48))
+        self.assertEqual(tmap.get_draw_count(True), (4, 4))
+        tmap.draw(surf, (4, 4, 64, 48))
+        self.assertEqual(tmap.get_draw_count(), (0, 4))
+        tmap.set_tile(0, (1, 1), 2)
+        tmap.draw(surf, (4, 4, 64, 48))
+        self.assertEqual(tmap.get_draw_count(True), (1, 8))
+        self.assertEqual(surf.get_at((1, 1)), COLORS[1])
+
+        # Atlas pixel changes are only seen after mark_dirty.
+        tmap.get_atlas().fill(COLORS[3], (0, 0, 4, 4))
+        tmap.draw(surf, (4, 4, 64, 48))
+        self.assertEqual(surf.get_at((5, 5)), COLORS[0])
+        tmap.mark_dirty()
+        tmap.draw(surf, (4, 4, 64, 48))
+        self.assertEqual(surf.get_at((5, 5)), COLORS[3])
+
+    def test_set_atlas(self):
+        tmap = TileMap((2, 2), (4, 4), make_atlas())
+        tmap.fill(0, 1)
+        surf = pygame.Surface((8, 8), 0, 32)
+        tmap.draw(surf)
+        atlas = pygame.Surface((4, 4), 0, 32)
+        atlas.fill((1, 2, 3))
+        tmap.set_atlas(atlas)
+        self.assertTrue(tmap.get_atlas() is atlas)
+        tmap.draw(surf)
+        self.assertEqual(surf.get_at((6, 6)), (1, 2, 3, 255))
+        self.assertRaises(ValueError, tmap.set_atlas,
+                          pygame.Surface((2, 2), 0, 32))
+
+################################################################################
+
+if __name__ == '__main__':
+    unittest.main()
@@ -23,6 +23,50 @@ class ClockTypeTest(unittest.TestCase):
     def test_construction(self):
         c = Clock()
         self.assert_(c, "Clock can be constructed")
+
+    def test_tick_precise(self):
+        c = Clock()
+        stats = c.get_frame_stats()
+        self.assertEqual(stats['frames'], 0)
+        c.tick()
+        for i in range(5):
+            c.tick_precise(100)
+        stats = c.get_frame_stats()
+        self.assertEqual(stats['frames'], 6)
+        # The five paced frames take at least their 10 ms each
+        self.assertTrue(stats['max'] >= 9.9)
+        self.assertTrue(stats['min'] <= stats['median'] <= stats['p95']
+                        <= stats['p99'] <= stats['max'])
+        self.assertTrue(0.0 < stats['margin'] <= 20.0)
+
+class ProfilerTypeTest(unittest.TestCase):
+    def test_spans(self):
+        import json
+        self.assertRaises(ValueError, pygame.time.Profiler, 0)
+        prof = pygame.time.Profiler(size=4)
+        start = pygame.time.get_ticks_ns()
+        prof.begin("frame")
+        prof.begin("draw")
+        prof.end()
+        prof.end("frame")
+        self.assertTrue(pygame.time.get_ticks_ns() >= start)
+        self.assertEqual(len(prof), 4)
+        events = prof.get_events()
+        self.assertEqual([e['ph'] for e in events], ['B', 'B', 'E', 'E'])
+        self.assertEqual([e.get('name') for e in events],
+                         ['frame', 'draw', None, 'frame'])
+        times = [e['ts'] for e in events]
+        self.assertEqual(times, sorted(times))
+        trace = json.loads(prof.to_json())
+        self.assertEqual(trace['traceEvents'], events)
+
+        # The oldest spans go first
+        prof.begin("next")
+        self.assertEqual(len(prof), 4)
+        self.assertEqual(prof.get_dropped(), 1)
+        self.assertEqual(prof.get_events()[-1]['name'], 'next')
+        prof.clear()
+        self.assertEqual((len(prof), prof.get_dropped()), (0, 0))
     
     def todo_test_get_fps(self):
 
@@ -148,6 +192,30 @@ class ClockTypeTest(unittest.TestCase):
         self.fail() 
 
 class TimeModuleTest(unittest.TestCase):
+    def test_add_timer(self):
+        pygame.display.init()
+        try:
+            pygame.event.clear()
+            self.assertRaises(ValueError, pygame.time.add_timer,
+                              pygame.USEREVENT, 0)
+            self.assertRaises(ValueError, pygame.time.add_timer,
+                              pygame.USEREVENT, 10, -1)
+            self.assertRaises(TypeError, pygame.time.add_timer, "a", 10)
+
+            event = pygame.event.Event(pygame.USEREVENT, a=1)
+            pygame.time.add_timer(event, 5, loops=3)
+            forever = pygame.time.add_timer(pygame.USEREVENT + 1, 5)
+            pygame.time.delay(100)
+            self.assertTrue(pygame.time.cancel_timer(forever))
+            self.assertFalse(pygame.time.cancel_timer(forever))
+            got = pygame.event.get(pygame.USEREVENT)
+            self.assertEqual([e.a for e in got], [1, 1, 1])
+            self.assertTrue(pygame.event.get(pygame.USEREVENT + 1))
+            pygame.time.delay(50)
+            self.assertFalse(pygame.event.get(pygame.USEREVENT + 1))
+        finally:
+            pygame.display.quit()
+
     def todo_test_delay(self):
 
         # __doc__ (as of 2008-08-02) for pygame.time.delay:
@@ -0,0 +1,93 @@
+#################################### IMPORTS ###################################
+
+if __name__ == '__main__':
+    import sys
+    import os
+    pkg_dir = os.path.split(os.path.abspath(__file__))[0]
+    parent_dir, pkg_name = os.path.split(pkg_dir)
+    is_pygame_pkg = (pkg_name == 'tests' and
+                     os.path.split(parent_dir)[1] == 'pygame')
+    if not is_pygame_pkg:
+        sys.path.insert(0, parent_dir)
+else:
+    is_pygame_pkg = __name__.startswith('pygame.tests.')
+
+import unittest
+import pygame
+from pygame import trace
+
+################################################################################
+
+class TraceModuleTest(unittest.TestCase):
+    def tearDown(self):
+        trace.stop()
+        trace.set_frame_budget(0)
+        trace.clear()
+
+    def test_start_stop(self):
+        blit = pygame.Surface.blit
+        trace.start()
+        self.assertTrue(trace.get_tracing())
+        self.assertNotEqual(pygame.Surface.blit, blit)
+        trace.stop()
+        self.assertFalse(trace.get_tracing())
+        self.assertEqual(pygame.Surface.blit, blit)
+
+    def test_records(self):
+        dest = pygame.Surface((20, 10), 0, 32)
+        source = pygame.Surface((4, 3), 0, 32)
+        trace.start(['surface', 'transform'])
+        rect = dest.blit(source, (5, 6))
+        pygame.transform.scale(source, (8, 6))
+        trace.stop()
+        dest.fill((1, 2, 3))
+
+        records = trace.get_records()
+        self.assertEqual(len(records), 2)
+        name, thread, seconds, surface, surface2, rect = records[0]
+        self.assertEqual(name, 'surface.Surface.blit')
+        self.assertTrue(seconds >= 0)
+        self.assertEqual(surface, (20, 10, 32))
+        self.assertEqual(surface2, (4, 3, 32))
+        self.assertEqual(rect, (5, 6, 4, 3))
+        name, thread, seconds, surface, surface2, rect = records[1]
+        self.assertEqual(name, 'transform.scale')
+        self.assertEqual(surface, (4, 3, 32))
+        self.assertEqual(surface2, None)
+        self.assertEqual(rect, (0, 0, 8, 6))
+
+        trace.clear()
+        self.assertEqual(trace.get_records(), [])
+
+    def test_size(self):
+        surf = pygame.Surface((2, 2))
+        trace.start(['surface'], size=3)
+        for i in range(5):
+            surf.get_at((0, 0))
+        self.assertEqual(len(trace.get_records()), 3)
+        self.assertRaises(ValueError, trace.start, size=0)
+
+    def test_frame_budget(self):
+        overruns = []
+        surf = pygame.Surface((2, 2))
+        trace.start(['surface'])
+        trace.frame()
+        trace.set_frame_budget(1e-9, lambda s, r: overruns.append((s, r)))
+        surf.fill((0, 0, 0))
+        seconds = trace.frame()
+        self.assertEqual(len(overruns), 1)
+        self.assertEqual(overruns[0][0], seconds)
+        self.assertEqual([r[0] for r in overruns[0][1]],
+                         ['surface.Surface.fill'])
+        self.assertEqual(trace.get_overrun(), overruns[0][1])
+
+        trace.set_frame_budget(1000)
+        surf.fill((0, 0, 0))
+        trace.frame()
+        self.assertEqual(len(overruns), 1)
+        self.assertRaises(ValueError, trace.set_frame_budget, -1)
+
+################################################################################
+
+if __name__ == '__main__':
+    unittest.main()
@@ -136,6 +136,59 @@ class TransformModuleTest( unittest.TestCase ):
             # the wrong size surface is past in.  Should raise an error.
             self.assertRaises(ValueError, pygame.transform.smoothscale, s, (33,64), s3)
 
+    def test_scale__integer_factors(self):
+        for depth in [8, 16, 24, 32]:
+            s = pygame.Surface((13, 7), 0, depth)
+            for y in range(7):
+                for x in range(13):
+                    s.set_at((x, y), ((x * 40) & 255, (y * 70) & 255, x ^ y))
+            for fx, fy in [(1, 1), (2, 2), (3, 2), (4, 4), (5, 1), (1, 3)]:
+                result = pygame.transform.scale(s, (13 * fx, 7 * fy))
+                for y in range(7 * fy):
+                    for x in range(13 * fx):
+                        self.failUnlessEqual(result.get_at((x, y)),
+                                             s.get_at((x // fx, y // fy)))
+
+            # Straight into part of a bigger surface.
+            big = pygame.Surface((40, 20), 0, s)
+            big.fill((1, 2, 3))
+            part = big.subsurface((5, 3, 26, 14))
+            result = pygame.transform.scale(s, (26, 14), part)
+            self.assert_(result is part)
+            self.failUnlessEqual(big.get_at((4, 3)), big.get_at((0, 0)))
+            self.failUnlessEqual(big.get_at((5, 3)), s.get_at((0, 0)))
+            self.failUnlessEqual(big.get_at((30, 16)), s.get_at((12, 6)))
+
+
+    def test_flip_chop__destination(self):
+        s = pygame.Surface((20, 12), 0, 32)
+        for pt, color in test_utils.gradient(20, 12):
+            s.set_at(pt, color)
+
+        for xbool, ybool in ((0, 0), (1, 0), (0, 1), (1, 1)):
+            expected = pygame.transform.flip(s, xbool, ybool)
+            dest = pygame.Surface((20, 12), 0, 32)
+            result = pygame.transform.flip(s, xbool, ybool, dest)
+            self.assert_(result is dest)
+            self.assertEqual(pygame.image.tostring(dest, 'RGB'),
+                             pygame.image.tostring(expected, 'RGB'))
+
+        expected = pygame.transform.chop(s, (5, 3, 4, 2))
+        self.assertEqual(expected.get_size(), (16, 10))
+        dest = pygame.Surface((16, 10), 0, 32)
+        result = pygame.transform.chop(s, (5, 3, 4, 2), dest)
+        self.assert_(result is dest)
+        self.assertEqual(pygame.image.tostring(dest, 'RGB'),
+                         pygame.image.tostring(expected, 'RGB'))
+
+        self.assertRaises(ValueError, pygame.transform.flip, s, 1, 0,
+                          pygame.Surface((20, 11), 0, 32))
+        self.assertRaises(ValueError, pygame.transform.flip, s, 1, 0,
+                          pygame.Surface((20, 12), 0, 16))
+        self.assertRaises(ValueError, pygame.transform.flip, s, 1, 0, s)
+        self.assertRaises(ValueError, pygame.transform.chop, s,
+                          (5, 3, 4, 2), pygame.Surface((20, 12), 0, 32))
+        self.assertRaises(ValueError, pygame.transform.laplacian, s, s)
 
     def test_threshold__honors_third_surface(self):
         # __doc__ for threshold as of Tue 07/15/2008
@@ -556,6 +609,49 @@ class TransformModuleTest( unittest.TestCase ):
 
         self.assertEqual(sr.get_at((0,0)), (10,53,50,255))
 
+    def test_threshold_average_surfaces__32(self):
+        # The 32 bit paths, on one thread or several, match the 24 bit ones.
+        original_threads = pygame.transform.get_smoothscale_threads()
+        w, h = 203, 131
+        surfaces = []
+        for i in range(3):
+            s = pygame.Surface((w, h), 0, 32)
+            for y in range(h):
+                for x in range(w):
+                    s.set_at((x, y), (((x + i) * 5) & 255, (y * 3) & 255,
+                                      ((x ^ y) + i * 40) & 255))
+            surfaces.append(s)
+        surfaces24 = []
+        for s in surfaces:
+            s24 = pygame.Surface((w, h), 0, 24)
+            s24.blit(s, (0, 0))
+            surfaces24.append(s24)
+
+        def results(surfaces):
+            depth = surfaces[0].get_bitsize()
+            found = []
+            for change_return, inverse, third in [(1, 0, None), (2, 1, None),
+                                                  (1, 0, surfaces[2]),
+                                                  (0, 1, surfaces[1])]:
+                dest = pygame.Surface((w, h), 0, depth)
+                num = pygame.transform.threshold(dest, surfaces[0],
+                                                 (100, 60, 200),
+                                                 (40, 50, 60), (1, 2, 3),
+                                                 change_return, third,
+                                                 inverse)
+                found.append((num, pygame.image.tostring(dest, 'RGB')))
+            average = pygame.transform.average_surfaces(surfaces)
+            found.append(pygame.image.tostring(average, 'RGB'))
+            return found
+
+        pygame.transform.set_smoothscale_threads(0)
+        expected = results(surfaces24)
+        self.failUnlessEqual(results(surfaces), expected)
+        pygame.transform.set_smoothscale_threads(4)
+        self.failUnlessEqual(results(surfaces), expected)
+        self.failUnlessEqual(results(surfaces24), expected)
+        pygame.transform.set_smoothscale_threads(original_threads)
+
 
 
 
@@ -609,6 +705,70 @@ class TransformModuleTest( unittest.TestCase ):
         for pt, color in gradient:
             self.assert_(s.get_at(pt) == color)
 
+    def test_rotate_flip__pixels(self):
+        # quarter turns go a tile at a time, and flips reverse rows in
+        # blocks, so use sizes that are not multiples of either
+        w, h = 77, 45
+        for depth in (8, 16, 24, 32):
+            s = pygame.Surface((w, h), 0, depth)
+            if depth == 8:
+                s.set_palette([(i, 255 - i, (i * 7) & 255)
+                               for i in range(256)])
+            for y in range(h):
+                for x in range(w):
+                    s.set_at((x, y), s.unmap_rgb((x * 37 + y * 101) & 0xffffff))
+            turned = {90: pygame.transform.rotate(s, 90),
+                      180: pygame.transform.rotate(s, 180),
+                      270: pygame.transform.rotate(s, 270)}
+            flipped = {(1, 0): pygame.transform.flip(s, 1, 0),
+                       (1, 1): pygame.transform.flip(s, 1, 1)}
+            self.assertEqual(turned[90].get_size(), (h, w))
+            self.assertEqual(turned[270].get_size(), (h, w))
+            for y in range(h):
+                for x in range(w):
+                    color = s.get_at((x, y))
+                    self.assertEqual(turned[90].get_at((y, w - 1 - x)), color)
+                    self.assertEqual(turned[180].get_at((w - 1 - x,
+                                                         h - 1 - y)), color)
+                    self.assertEqual(turned[270].get_at((h - 1 - y, x)), color)
+                    self.assertEqual(flipped[1, 0].get_at((w - 1 - x, y)),
+                                     color)
+                    self.assertEqual(flipped[1, 1].get_at((w - 1 - x,
+                                                           h - 1 - y)), color)
+
+    def test_rotate__destination(self):
+        s = pygame.Surface((40, 25), pygame.SRCALPHA, 32)
+        for pt, color in test_utils.gradient(40, 25):
+            s.set_at(pt, color)
+
+        for angle in (0, 90, 180, -90, 33.5, 200):
+            size = pygame.transform.get_rotated_size((40, 25), angle)
+            expected = pygame.transform.rotate(s, angle)
+            self.assertEqual(expected.get_size(), size)
+            dest = pygame.Surface(size, pygame.SRCALPHA, 32)
+            dest.fill((1, 2, 3, 4))
+            result = pygame.transform.rotate(s, angle, dest)
+            self.assert_(result is dest)
+            self.assertEqual(pygame.image.tostring(dest, 'RGBA'),
+                             pygame.image.tostring(expected, 'RGBA'))
+
+        for angle, scale in ((0, 1.5), (30, 0.5), (-75, 2.0)):
+            size = pygame.transform.get_rotated_size((40, 25), angle, scale)
+            expected = pygame.transform.rotozoom(s, angle, scale)
+            self.assertEqual(expected.get_size(), size)
+            dest = expected.copy()
+            dest.fill((1, 2, 3, 4))
+            result = pygame.transform.rotozoom(s, angle, scale, dest)
+            self.assert_(result is dest)
+            self.assertEqual(pygame.image.tostring(dest, 'RGBA'),
+                             pygame.image.tostring(expected, 'RGBA'))
+
+        wrong = pygame.Surface((10, 10), pygame.SRCALPHA, 32)
+        self.assertRaises(ValueError, pygame.transform.rotate, s, 33.5, wrong)
+        self.assertRaises(ValueError, pygame.transform.rotozoom, s, 30, 0.5,
+                          wrong)
+        self.assertRaises(ValueError, pygame.transform.rotate, s, 180, s)
+
     def test_scale2x(self):
 
         # __doc__ (as of 2008-06-25) for pygame.transform.scale2x:
@@ -624,9 +784,42 @@ class TransformModuleTest( unittest.TestCase ):
         s2 = pygame.transform.scale2x(s)
         self.assertEquals(s2.get_rect().size, (64, 64))
 
+    def test_scale3x_scale4x(self):
+        for depth in [8, 16, 24, 32]:
+            s = pygame.Surface((37, 11), 0, depth)
+            s.fill((255, 255, 255))
+            pygame.draw.line(s, (0, 0, 0), (0, 0), (36, 10))
+            pygame.draw.line(s, (0, 0, 0), (3, 10), (20, 0))
+
+            # scale4x is scale2x done twice.
+            s4 = pygame.transform.scale4x(s)
+            self.failUnlessEqual(s4.get_size(), (148, 44))
+            twice = pygame.transform.scale2x(pygame.transform.scale2x(s))
+            self.failUnlessEqual(pygame.image.tostring(s4, 'RGB'),
+                                 pygame.image.tostring(twice, 'RGB'))
+
+            dest = pygame.Surface((111, 33), 0, s)
+            result = pygame.transform.scale3x(s, dest)
+            self.assert_(result is dest)
+
+            # A lone pixel is just made bigger.
+            s = pygame.Surface((5, 5), 0, depth)
+            s.set_at((2, 2), (255, 255, 255))
+            s3 = pygame.transform.scale3x(s)
+            for y in range(15):
+                for x in range(15):
+                    self.failUnlessEqual(s3.get_at((x, y)),
+                                         s.get_at((x // 3, y // 3)))
+
+            self.failUnlessRaises(ValueError, pygame.transform.scale3x,
+                                  s, pygame.Surface((14, 15), 0, s))
+            other_depth = depth == 8 and 32 or 8
+            self.failUnlessRaises(ValueError, pygame.transform.scale4x,
+                                  s, pygame.Surface((20, 20), 0, other_depth))
+
     def test_get_smoothscale_backend(self):
         filter_type = pygame.transform.get_smoothscale_backend()
-        self.failUnless(filter_type in ['GENERIC', 'MMX', 'SSE'])
+        self.failUnless(filter_type in ['GENERIC', 'MMX', 'SSE', 'AVX2', 'NEON'])
         # It would be nice to test if a non-generic type corresponds to an x86
         # processor. But there is no simple test for this. platform.machine()
         # returns process version specific information, like 'i686'.
@@ -653,7 +846,7 @@ class TransformModuleTest( unittest.TestCase ):
             pygame.transform.set_smoothscale_backend(1)
         self.failUnlessRaises(TypeError, change)
         # Unsupported type, if possible.
-        if original_type != 'SSE':
+        if original_type in ['GENERIC', 'MMX']:
             def change():
                 pygame.transform.set_smoothscale_backend('SSE')
             self.failUnlessRaises(ValueError, change)
@@ -661,6 +854,348 @@ class TransformModuleTest( unittest.TestCase ):
         filter_type = pygame.transform.get_smoothscale_backend()
         self.failUnlessEqual(filter_type, original_type)
 
+    def test_smoothscale_backends__exact(self):
+        # AVX2 and NEON do the arithmetic of the generic filters.
+        original_type = pygame.transform.get_smoothscale_backend()
+        s = pygame.Surface((97, 61), pygame.SRCALPHA, 32)
+        for y in range(61):
+            for x in range(97):
+                s.set_at((x, y), ((x * 7) & 255, (y * 3) & 255,
+                                  (x + y) & 255, (x ^ y) & 255))
+        sizes = [(30, 20), (250, 140), (30, 140), (97, 20), (250, 61)]
+        pygame.transform.set_smoothscale_backend('GENERIC')
+        expected = [pygame.image.tostring(
+                        pygame.transform.smoothscale(s, size), 'RGBA')
+                    for size in sizes]
+        for backend in ['AVX2', 'NEON']:
+            try:
+                pygame.transform.set_smoothscale_backend(backend)
+            except ValueError:
+                continue
+            for size, pixels in zip(sizes, expected):
+                result = pygame.transform.smoothscale(s, size)
+                self.failUnlessEqual(pygame.image.tostring(result, 'RGBA'),
+                                     pixels)
+        pygame.transform.set_smoothscale_backend(original_type)
+
+    def test_set_smoothscale_threads(self):
+        original_threads = pygame.transform.get_smoothscale_threads()
+        self.failUnlessRaises(ValueError,
+                              pygame.transform.set_smoothscale_threads, -1)
+
+        for depth, flags in [(24, 0), (32, pygame.SRCALPHA)]:
+            s = pygame.Surface((301, 257), flags, depth)
+            for y in range(0, 257, 3):
+                for x in range(0, 301, 5):
+                    s.set_at((x, y), ((x * 7) & 255, (y * 3) & 255,
+                                      (x + y) & 255, (x ^ y) & 255))
+            for size in [(600, 500), (150, 128), (600, 100), (301, 513)]:
+                pygame.transform.set_smoothscale_threads(0)
+                expected = pygame.transform.smoothscale(s, size)
+                pygame.transform.set_smoothscale_threads(4)
+                self.failUnlessEqual(
+                    pygame.transform.get_smoothscale_threads(), 4)
+                result = pygame.transform.smoothscale(s, size)
+                self.failUnlessEqual(pygame.image.tostring(result, 'RGBA'),
+                                     pygame.image.tostring(expected, 'RGBA'))
+
+        pygame.transform.set_smoothscale_threads(original_threads)
+        self.failUnlessEqual(pygame.transform.get_smoothscale_threads(),
+                             original_threads)
+
+    def test_rotozoom_threads(self):
+        # rotozoom does bands of rows on the smoothscale threads
+        original_threads = pygame.transform.get_smoothscale_threads()
+        s = pygame.Surface((301, 257), pygame.SRCALPHA, 32)
+        for y in range(0, 257, 3):
+            for x in range(0, 301, 5):
+                s.set_at((x, y), ((x * 7) & 255, (y * 3) & 255,
+                                  (x + y) & 255, (x ^ y) & 255))
+        for angle, scale in ((0, 1.7), (0, 0.6), (33, 1.2), (-120, 0.8)):
+            pygame.transform.set_smoothscale_threads(0)
+            expected = pygame.transform.rotozoom(s, angle, scale)
+            pygame.transform.set_smoothscale_threads(4)
+            result = pygame.transform.rotozoom(s, angle, scale)
+            self.failUnlessEqual(pygame.image.tostring(result, 'RGBA'),
+                                 pygame.image.tostring(expected, 'RGBA'))
+            result.fill((1, 2, 3, 4))
+            pygame.transform.rotozoom(s, angle, scale, result)
+            self.failUnlessEqual(pygame.image.tostring(result, 'RGBA'),
+                                 pygame.image.tostring(expected, 'RGBA'))
+        pygame.transform.set_smoothscale_threads(original_threads)
+
+    def test_mip_chain(self):
+        s = pygame.Surface((64, 48), pygame.SRCALPHA, 32)
+        for y in range(48):
+            for x in range(64):
+                s.set_at((x, y), ((x * 4) & 255, (y * 5) & 255,
+                                  (x * y) & 255, 200))
+        as_string = lambda surf: pygame.image.tostring(surf, 'RGBA')
+        smoothscale = pygame.transform.smoothscale
+
+        chain = pygame.transform.MipChain(s)
+        self.assert_(isinstance(chain, pygame.transform.MipChainType))
+        self.assert_(chain.get_surface() is s)
+        self.failUnlessEqual(chain.get_bytes(), 0)
+
+        # Scaling starts from the smallest level at least as big.
+        quarter = smoothscale(smoothscale(s, (32, 24)), (16, 12))
+        self.failUnlessEqual(as_string(chain.scale((16, 12))),
+                             as_string(quarter))
+        self.failUnlessEqual(as_string(chain.scale((10, 7))),
+                             as_string(smoothscale(quarter, (10, 7))))
+        self.failUnlessEqual(chain.get_bytes(), 32 * 24 * 4 + 16 * 12 * 4)
+        self.failUnlessEqual(as_string(chain.scale((40, 30))),
+                             as_string(smoothscale(s, (40, 30))))
+        dest = pygame.Surface((10, 7), pygame.SRCALPHA, 32)
+        self.assert_(chain.scale((10, 7), dest) is dest)
+        self.failUnlessEqual(chain.scale((0, 7)).get_size(), (0, 7))
+
+        # The levels are only remade after invalidate.
+        s.fill((255, 0, 0, 255))
+        self.failUnlessEqual(as_string(chain.scale((16, 12))),
+                             as_string(quarter))
+        chain.invalidate()
+        self.failUnlessEqual(chain.get_bytes(), 0)
+        self.failUnlessEqual(chain.scale((16, 12)).get_at((5, 5)),
+                             (255, 0, 0, 255))
+
+        # Levels past max_bytes are made but not kept.
+        chain = pygame.transform.MipChain(s, 100)
+        self.failUnlessEqual(chain.scale((8, 6)).get_at((5, 5)),
+                             (255, 0, 0, 255))
+        self.failUnlessEqual(chain.get_bytes(), 0)
+        chain = pygame.transform.MipChain(s, 32 * 24 * 4)
+        chain.scale((8, 6))
+        self.failUnless(chain.get_bytes() <= 32 * 24 * 4)
+
+        self.failUnlessRaises(ValueError, pygame.transform.MipChain,
+                              pygame.Surface((8, 8), 0, 8))
+        self.failUnlessRaises(ValueError, pygame.transform.MipChain, s, -1)
+        self.failUnlessRaises(ValueError, chain.scale, (-1, 5))
+
+    def test_box_blur_gaussian_blur(self):
+        for blur in [pygame.transform.box_blur,
+                     pygame.transform.gaussian_blur]:
+            # A solid surface stays solid, edges included.
+            for depth, flags in [(24, 0), (32, pygame.SRCALPHA)]:
+                s = pygame.Surface((23, 17), flags, depth)
+                s.fill((10, 200, 30, 40))
+                result = blur(s, 5)
+                self.failUnlessEqual(result.get_size(), (23, 17))
+                self.failUnlessEqual(pygame.image.tostring(result, 'RGB'),
+                                     pygame.image.tostring(s, 'RGB'))
+
+            # One bright pixel spreads to the pixels within the radius.
+            s = pygame.Surface((15, 15), 0, 32)
+            s.set_at((7, 7), (255, 255, 255))
+            self.failUnlessEqual(pygame.image.tostring(blur(s, 0), 'RGB'),
+                                 pygame.image.tostring(s, 'RGB'))
+            dest = pygame.Surface((15, 15), 0, 32)
+            result = blur(s, 2, dest)
+            self.assert_(result is dest)
+            for y in range(15):
+                for x in range(15):
+                    inside = abs(x - 7) <= 2 and abs(y - 7) <= 2
+                    self.failUnlessEqual(dest.get_at((x, y))[0] > 0, inside)
+
+            self.failUnlessRaises(ValueError, blur, s, -1)
+            self.failUnlessRaises(ValueError, blur, s, 256)
+            self.failUnlessRaises(ValueError, blur,
+                                  pygame.Surface((15, 15), 0, 8), 2)
+            self.failUnlessRaises(ValueError, blur, s, 2, s)
+
+        # Every backend gives the same blur.
+        original_type = pygame.transform.get_smoothscale_backend()
+        s = pygame.Surface((97, 61), pygame.SRCALPHA, 32)
+        for y in range(61):
+            for x in range(97):
+                s.set_at((x, y), ((x * 7) & 255, (y * 3) & 255,
+                                  (x + y) & 255, (x ^ y) & 255))
+        pygame.transform.set_smoothscale_backend('GENERIC')
+        expected = [pygame.image.tostring(blur(s, radius), 'RGBA')
+                    for blur in [pygame.transform.box_blur,
+                                 pygame.transform.gaussian_blur]
+                    for radius in [1, 4, 60]]
+        for backend in ['MMX', 'SSE', 'AVX2', 'NEON']:
+            try:
+                pygame.transform.set_smoothscale_backend(backend)
+            except ValueError:
+                continue
+            results = [pygame.image.tostring(blur(s, radius), 'RGBA')
+                       for blur in [pygame.transform.box_blur,
+                                    pygame.transform.gaussian_blur]
+                       for radius in [1, 4, 60]]
+            self.failUnlessEqual(results, expected)
+        pygame.transform.set_smoothscale_backend(original_type)
+
+    def test_rgb_to_hsv_hsv_to_rgb_correct_gamma(self):
+        from pygame import color
+        for depth, flags in [(24, 0), (32, 0), (32, pygame.SRCALPHA),
+                             (16, 0)]:
+            s = pygame.Surface((21, 13), flags, depth)
+            for y in range(13):
+                for x in range(21):
+                    s.set_at((x, y), ((x * 12) & 255, (y * 20) & 255,
+                                      (x * y) & 255, (x + y) & 255))
+            rgba = pygame.image.tostring(s, 'RGBA')
+
+            # The surface functions match the buffer ones
+            hsv = pygame.transform.rgb_to_hsv(s)
+            self.failUnlessEqual(hsv.get_size(), s.get_size())
+            expected = bytearray(rgba)
+            color.rgb_to_hsv(expected, 4)
+            if depth != 16:
+                self.failUnlessEqual(
+                    bytearray(pygame.image.tostring(hsv, 'RGBA')), expected)
+
+            dest = pygame.Surface((21, 13), flags, depth)
+            result = pygame.transform.hsv_to_rgb(hsv, dest)
+            self.assert_(result is dest)
+            for a, b in zip(bytearray(pygame.image.tostring(dest, 'RGB')),
+                            bytearray(pygame.image.tostring(s, 'RGB'))):
+                self.assert_(abs(a - b) <= 16)
+
+            corrected = pygame.transform.correct_gamma(s, 2.2)
+            expected = bytearray(rgba)
+            color.correct_gamma(expected, 2.2, 4)
+            if depth != 16:
+                self.failUnlessEqual(
+                    bytearray(pygame.image.tostring(corrected, 'RGBA')),
+                    expected)
+
+            self.failUnlessRaises(ValueError, pygame.transform.rgb_to_hsv,
+                                  s, s)
+            self.failUnlessRaises(ValueError, pygame.transform.correct_gamma,
+                                  s, 2.2, pygame.Surface((3, 3), 0, depth))
+
+    def test_remap_colors(self):
+        red, blue = (255, 0, 0, 255), (0, 0, 255, 255)
+        green = (0, 255, 0, 255)
+        invert = [255 - i for i in range(256)]
+        for depth, flags in [(16, 0), (24, 0), (32, 0), (32, pygame.SRCALPHA)]:
+            s = pygame.Surface((9, 5), flags, depth)
+            s.fill(red)
+            s.fill(blue, (3, 0, 3, 5))
+            s.set_at((8, 4), green)
+
+            # An exact color to color table
+            result = pygame.transform.remap_colors(s, {red: blue,
+                                                       blue: red})
+            self.failUnlessEqual(result.get_size(), (9, 5))
+            self.failUnlessEqual(result.get_at((0, 0)), blue)
+            self.failUnlessEqual(result.get_at((4, 2)), red)
+            self.failUnlessEqual(result.get_at((8, 4)), green)
+            self.failUnlessEqual(s.get_at((0, 0)), red)
+
+            # Per channel tables, into a DestSurface and in place
+            dest = pygame.Surface((9, 5), flags, depth)
+            result = pygame.transform.remap_colors(s, invert, dest)
+            self.assert_(result is dest)
+            self.failUnlessEqual(dest.get_at((0, 0))[:3], (0, 255, 255))
+            self.failUnlessEqual(dest.get_at((4, 2))[:3], (255, 255, 0))
+            result = pygame.transform.remap_colors(
+                s, [invert, range(256), range(256)], s)
+            self.assert_(result is s)
+            self.failUnlessEqual(s.get_at((0, 0))[:3], (0, 0, 0))
+            self.failUnlessEqual(s.get_at((8, 4))[:3], (255, 255, 0))
+
+        # An alpha table
+        s = pygame.Surface((4, 4), pygame.SRCALPHA, 32)
+        s.fill((10, 20, 30, 40))
+        half = [i // 2 for i in range(256)]
+        result = pygame.transform.remap_colors(
+            s, [range(256), range(256), range(256), half])
+        self.failUnlessEqual(result.get_at((1, 1)), (10, 20, 30, 20))
+
+        # 8-bit surfaces get a new palette and keep their pixels
+        s = pygame.Surface((6, 6), 0, 8)
+        s.set_palette([(i, i, i) for i in range(256)])
+        s.fill((7, 7, 7))
+        s.set_at((2, 2), (9, 9, 9))
+        indices = [s.get_at_mapped((x, y)) for x in range(6) for y in range(6)]
+        result = pygame.transform.remap_colors(s, {(7, 7, 7): (200, 0, 0)})
+        self.failUnlessEqual(result.get_at((0, 0))[:3], (200, 0, 0))
+        self.failUnlessEqual(result.get_at((2, 2))[:3], (9, 9, 9))
+        self.failUnlessEqual([result.get_at_mapped((x, y)) for x in range(6)
+                              for y in range(6)], indices)
+        pygame.transform.remap_colors(s, invert, s)
+        self.failUnlessEqual(s.get_at((0, 0))[:3], (248, 248, 248))
+        self.failUnlessEqual(s.get_palette_at(0), (255, 255, 255, 255))
+
+        s = pygame.Surface((4, 4), 0, 32)
+        self.failUnlessRaises(ValueError, pygame.transform.remap_colors,
+                              s, range(255))
+        self.failUnlessRaises(ValueError, pygame.transform.remap_colors,
+                              s, [invert, invert])
+        self.failUnlessRaises(ValueError, pygame.transform.remap_colors,
+                              s, [256] * 256)
+        self.failUnlessRaises(ValueError, pygame.transform.remap_colors,
+                              s, {(1, 2, 3): 'not a color name'})
+
+    def test_convolve(self):
+        s = pygame.Surface((19, 13), pygame.SRCALPHA, 32)
+        for y in range(13):
+            for x in range(19):
+                s.set_at((x, y), ((x * 13) & 255, (y * 19) & 255,
+                                  (x * y) & 255, (x + y * 5) & 255))
+        as_string = lambda surf: pygame.image.tostring(surf, 'RGBA')
+
+        # The identity kernel copies, in any of the kernel shapes.
+        identity = [[0, 0, 0], [0, 1, 0], [0, 0, 0]]
+        self.failUnlessEqual(as_string(pygame.transform.convolve(s, identity)),
+                             as_string(s))
+        self.failUnlessEqual(
+            as_string(pygame.transform.convolve(s, [0] * 12 + [1] + [0] * 12)),
+            as_string(s))
+
+        # Nested and flat kernels are the same, and negative weights clamp.
+        kernel = [[0, -1, 0], [-1, 5, -1], [0, -1, 0]]
+        flat = [w for row in kernel for w in row]
+        dest = pygame.Surface((19, 13), pygame.SRCALPHA, 32)
+        result = pygame.transform.convolve(s, kernel, dest)
+        self.assert_(result is dest)
+        self.failUnlessEqual(as_string(pygame.transform.convolve(s, flat)),
+                             as_string(dest))
+
+        # 24-bit surfaces give the same colours.
+        s24 = pygame.Surface((19, 13), 0, 24)
+        s24.blit(s, (0, 0))
+        s32 = pygame.Surface((19, 13), 0, 32)
+        s32.blit(s, (0, 0))
+        self.failUnlessEqual(
+            pygame.image.tostring(pygame.transform.convolve(s24, kernel),
+                                  'RGB'),
+            pygame.image.tostring(pygame.transform.convolve(s32, kernel),
+                                  'RGB'))
+
+        self.failUnlessRaises(ValueError, pygame.transform.convolve, s,
+                              [[0, 1], [1, 0]])
+        self.failUnlessRaises(ValueError, pygame.transform.convolve, s,
+                              [1] * 8)
+        self.failUnlessRaises(ValueError, pygame.transform.convolve, s,
+                              [[100, 0, 0], [0, 1, 0], [0, 0, -28]])
+        self.failUnlessRaises(TypeError, pygame.transform.convolve, s, 3)
+        self.failUnlessRaises(ValueError, pygame.transform.convolve, s,
+                              kernel, s)
+
+        # Every backend gives the same result.
+        original_type = pygame.transform.get_smoothscale_backend()
+        kernel5 = [[(x - 2) * (y - 2) * 0.5 for x in range(5)]
+                   for y in range(5)]
+        pygame.transform.set_smoothscale_backend('GENERIC')
+        expected = [as_string(pygame.transform.convolve(s, k))
+                    for k in [kernel, kernel5]]
+        for backend in ['MMX', 'SSE', 'AVX2', 'NEON']:
+            try:
+                pygame.transform.set_smoothscale_backend(backend)
+            except ValueError:
+                continue
+            results = [as_string(pygame.transform.convolve(s, k))
+                       for k in [kernel, kernel5]]
+            self.failUnlessEqual(results, expected)
+        pygame.transform.set_smoothscale_backend(original_type)
+
     def todo_test_chop(self):
 
         # __doc__ (as of 2008-08-02) for pygame.transform.chop: